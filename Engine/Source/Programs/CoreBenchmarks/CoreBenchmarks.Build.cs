@@ -0,0 +1,10 @@
+using UnrealBuildTool;
+public class CoreBenchmarks : ModuleRules
+{
+	public CoreBenchmarks(ReadOnlyTargetRules Target) : base(Target)
+	{
+        bUseUnity = false;
+
+        PrivateDependencyModuleNames.Add("Core");
+    }
+}
@@ -0,0 +1,19 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class CoreBenchmarksTarget : TargetRules
+{
+	public CoreBenchmarksTarget(TargetInfo Target) : base(Target)
+	{
+        Type = TargetType.Program;
+        LinkType = TargetLinkType.Monolithic;
+        BuildEnvironment = TargetBuildEnvironment.Unique;
+        LaunchModuleName = "CoreBenchmarks";
+
+        bCompileICU = false;
+        bCompileAgainstEngine = false;
+
+        bIsBuildingConsoleApplication = true;
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+namespace CoreBenchmarks
+{
+	/** How a benchmark is measured, from the command line */
+	struct FSettings
+	{
+		/** Untimed repetitions run first, to warm caches, allocators and branch predictors */
+		int32 NumWarmups = 3;
+		int32 NumRepetitions = 15;
+		/** The iterations of a repetition are doubled until it lasts at least this long */
+		double MinRepetitionSeconds = 0.01;
+	};
+
+	/**
+	 * Passed to a benchmark, which does its setup and then calls Measure with the code to time. Each sample is the
+	 * time of one repetition divided by its iterations.
+	 */
+	class FState
+	{
+	public:
+		explicit FState(const FSettings& InSettings)
+			: Settings(InSettings)
+		{
+		}
+
+		template <typename BodyType>
+		void Measure(BodyType&& Body)
+		{
+			check(Samples.Num() == 0);
+
+			NumIterations = 1;
+			while (RunRepetition(Body) < Settings.MinRepetitionSeconds && NumIterations < (1ull << 40))
+			{
+				NumIterations *= 2;
+			}
+
+			for (int32 Index = 0; Index < Settings.NumWarmups; ++Index)
+			{
+				RunRepetition(Body);
+			}
+
+			Samples.Reserve(Settings.NumRepetitions);
+			for (int32 Index = 0; Index < Settings.NumRepetitions; ++Index)
+			{
+				Samples.Add(RunRepetition(Body) / double(NumIterations));
+			}
+		}
+
+		/** Seconds per iteration of every repetition */
+		const TArray<double>& GetSamples() const
+		{
+			return Samples;
+		}
+
+		uint64 GetNumIterations() const
+		{
+			return NumIterations;
+		}
+
+	private:
+		template <typename BodyType>
+		double RunRepetition(BodyType& Body)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (uint64 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Body();
+			}
+			return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		}
+
+		const FSettings& Settings;
+		uint64 NumIterations = 0;
+		TArray<double> Samples;
+	};
+
+	typedef void (*FBenchmarkFunction)(FState& State);
+
+	/** Adds a benchmark to the list main() runs, through CORE_BENCHMARK */
+	struct FRegistration
+	{
+		FRegistration(const TCHAR* Suite, const TCHAR* Name, FBenchmarkFunction Function);
+	};
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	extern const volatile void* GSink;
+#endif
+
+	/** Keeps the compiler from optimizing away the computation of Value */
+	template <typename T>
+	FORCEINLINE void DoNotOptimize(const T& Value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		GSink = &Value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "g"(&Value) : "memory");
+#endif
+	}
+}
+
+/**
+ * Defines a benchmark, e.g.
+ *
+ *	CORE_BENCHMARK(String, Atoi)
+ *	{
+ *		const TCHAR* Number = TEXT("12345");
+ *		State.Measure([Number]() { CoreBenchmarks::DoNotOptimize(FCString::Atoi(Number)); });
+ *	}
+ */
+#define CORE_BENCHMARK(Suite, Name) \
+	static void Benchmark_##Suite##_##Name(CoreBenchmarks::FState& State); \
+	static CoreBenchmarks::FRegistration BenchmarkRegistration_##Suite##_##Name(TEXT(#Suite), TEXT(#Name), &Benchmark_##Suite##_##Name); \
+	static void Benchmark_##Suite##_##Name(CoreBenchmarks::FState& State)
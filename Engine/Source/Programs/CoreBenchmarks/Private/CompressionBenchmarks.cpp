@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Math/RandomStream.h"
+#include "Misc/Compression.h"
+
+namespace CoreBenchmarks
+{
+	/** 64 KB of words from a small vocabulary, compressible about as well as typical text and serialized data */
+	static TArray<uint8> MakeCompressionInput()
+	{
+		static const ANSICHAR* Words[] = { "Actor ", "Component ", "Transform ", "0.000000 ", "1.000000 ", "None ", "/Game/Maps/", "Texture2D ", "\n", "true ", "false ", "{ ", "} " };
+		FRandomStream Random(0x9abc);
+		TArray<uint8> Input;
+		while (Input.Num() < 64 * 1024)
+		{
+			const ANSICHAR* Word = Words[Random.RandHelper(UE_ARRAY_COUNT(Words))];
+			Input.Append((const uint8*)Word, FCStringAnsi::Strlen(Word));
+		}
+		Input.SetNum(64 * 1024);
+		return Input;
+	}
+
+	static void MeasureCompress(FState& State, FName Format)
+	{
+		const TArray<uint8> Input = MakeCompressionInput();
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(FCompression::CompressMemoryBound(Format, Input.Num()));
+		State.Measure([&Input, &Compressed, Format]()
+		{
+			int32 CompressedSize = Compressed.Num();
+			verify(FCompression::CompressMemory(Format, Compressed.GetData(), CompressedSize, Input.GetData(), Input.Num()));
+			DoNotOptimize(CompressedSize);
+		});
+	}
+
+	static void MeasureUncompress(FState& State, FName Format)
+	{
+		const TArray<uint8> Input = MakeCompressionInput();
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(FCompression::CompressMemoryBound(Format, Input.Num()));
+		int32 CompressedSize = Compressed.Num();
+		verify(FCompression::CompressMemory(Format, Compressed.GetData(), CompressedSize, Input.GetData(), Input.Num()));
+		TArray<uint8> Uncompressed;
+		Uncompressed.SetNumUninitialized(Input.Num());
+		State.Measure([&Compressed, CompressedSize, &Uncompressed, Format]()
+		{
+			verify(FCompression::UncompressMemory(Format, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), CompressedSize));
+			DoNotOptimize(Uncompressed.GetData());
+		});
+	}
+}
+
+CORE_BENCHMARK(Compression, ZlibCompress64K)
+{
+	CoreBenchmarks::MeasureCompress(State, NAME_Zlib);
+}
+
+CORE_BENCHMARK(Compression, ZlibUncompress64K)
+{
+	CoreBenchmarks::MeasureUncompress(State, NAME_Zlib);
+}
+
+CORE_BENCHMARK(Compression, GzipCompress64K)
+{
+	CoreBenchmarks::MeasureCompress(State, NAME_Gzip);
+}
+
+CORE_BENCHMARK(Compression, GzipUncompress64K)
+{
+	CoreBenchmarks::MeasureUncompress(State, NAME_Gzip);
+}
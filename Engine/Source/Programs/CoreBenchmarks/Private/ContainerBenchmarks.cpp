@@ -0,0 +1,341 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/EytzingerSearch.h"
+#include "Containers/BTreeMap.h"
+#include "Containers/FrozenSortedMap.h"
+#include "Containers/SmallMap.h"
+#include "Containers/SortedMap.h"
+#include "Containers/StringView.h"
+#include "Math/RandomStream.h"
+
+namespace CoreBenchmarks
+{
+	static const int32 NumContainerElements = 1024;
+
+	static TArray<int32> MakeRandomKeys()
+	{
+		FRandomStream Random(0x1234);
+		TArray<int32> Keys;
+		for (int32 Index = 0; Index < NumContainerElements; ++Index)
+		{
+			Keys.Add(Random.RandHelper(MAX_int32));
+		}
+		return Keys;
+	}
+
+	/** Fewer pairs than most maps ever hold, the case TSmallMap is for */
+	static const int32 NumSmallMapElements = 6;
+
+	/** Fills a map, looks up every key and a missing one, the way temporary maps are mostly used */
+	template <typename MapType>
+	static void FillAndFindSmallMap(const TArray<int32>& Keys)
+	{
+		MapType Map;
+		for (int32 Index = 0; Index < NumSmallMapElements; ++Index)
+		{
+			Map.Add(Keys[Index], Index);
+		}
+		int32 Sum = 0;
+		for (int32 Index = 0; Index <= NumSmallMapElements; ++Index)
+		{
+			const int32* Value = Map.Find(Keys[Index]);
+			Sum += Value ? *Value : 0;
+		}
+		DoNotOptimize(Sum);
+	}
+
+	/** Enough keys that a table of them is far larger than the caches */
+	static const int32 NumLargeTableElements = 4 * 1024 * 1024;
+
+	/** The even numbers below twice NumLargeTableElements, sorted */
+	static TArray<int32> MakeLargeSortedTable()
+	{
+		TArray<int32> Table;
+		Table.Reserve(NumLargeTableElements);
+		for (int32 Index = 0; Index < NumLargeTableElements; ++Index)
+		{
+			Table.Add(Index * 2);
+		}
+		return Table;
+	}
+
+	/** Enough lookups that the paths they take don't stay in the cache between two of the same */
+	static const int32 NumLargeTableLookups = 1024 * 1024;
+
+	/** Random values looked up in the large tables */
+	static TArray<int32> MakeLargeTableLookups()
+	{
+		FRandomStream Random(0x5678);
+		TArray<int32> Lookups;
+		Lookups.Reserve(NumLargeTableLookups);
+		for (int32 Index = 0; Index < NumLargeTableLookups; ++Index)
+		{
+			Lookups.Add(Random.RandHelper(NumLargeTableElements * 2));
+		}
+		return Lookups;
+	}
+
+	/** Enough random keys that inserting each of them in the middle of a sorted array moves a lot of memory */
+	static const int32 NumOrderedMapInserts = 64 * 1024;
+
+	/** Adds random keys to an empty ordered map, as an index built from unsorted input would */
+	template <typename MapType>
+	static void AddRandomToOrderedMap()
+	{
+		FRandomStream Random(0x9abc);
+		MapType Map;
+		for (int32 Index = 0; Index < NumOrderedMapInserts; ++Index)
+		{
+			Map.Add(Random.RandHelper(MAX_int32), Index);
+		}
+		DoNotOptimize(Map.Num());
+	}
+
+	static TArray<FString> MakeStringKeys()
+	{
+		TArray<FString> Keys;
+		for (int32 Key : MakeRandomKeys())
+		{
+			Keys.Add(FString::Printf(TEXT("/Game/Maps/Key%d"), Key));
+		}
+		return Keys;
+	}
+
+	static TMap<FString, int32> MakeStringMap(const TArray<FString>& Keys)
+	{
+		TMap<FString, int32> Map;
+		for (int32 Index = 0; Index < Keys.Num(); ++Index)
+		{
+			Map.Add(Keys[Index], Index);
+		}
+		return Map;
+	}
+}
+
+CORE_BENCHMARK(Containers, ArrayAdd1024)
+{
+	TArray<int32> Array;
+	State.Measure([&Array]()
+	{
+		Array.Reset();
+		for (int32 Index = 0; Index < CoreBenchmarks::NumContainerElements; ++Index)
+		{
+			Array.Add(Index);
+		}
+		CoreBenchmarks::DoNotOptimize(Array.GetData());
+	});
+}
+
+CORE_BENCHMARK(Containers, ArraySort1024)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	TArray<int32> Array;
+	State.Measure([&Keys, &Array]()
+	{
+		Array = Keys;
+		Array.Sort();
+		CoreBenchmarks::DoNotOptimize(Array.GetData());
+	});
+}
+
+CORE_BENCHMARK(Containers, MapAdd1024)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	TMap<int32, int32> Map;
+	State.Measure([&Keys, &Map]()
+	{
+		Map.Reset();
+		for (int32 Key : Keys)
+		{
+			Map.Add(Key, Key);
+		}
+		CoreBenchmarks::DoNotOptimize(Map.Num());
+	});
+}
+
+CORE_BENCHMARK(Containers, MapFind)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	TMap<int32, int32> Map;
+	for (int32 Key : Keys)
+	{
+		Map.Add(Key, Key);
+	}
+	int32 Index = 0;
+	State.Measure([&Keys, &Map, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Map.Find(Keys[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumContainerElements;
+	});
+}
+
+CORE_BENCHMARK(Containers, SetContains)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	const TSet<int32> Set(Keys);
+	int32 Index = 0;
+	State.Measure([&Keys, &Set, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Set.Contains(Keys[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumContainerElements;
+	});
+}
+
+CORE_BENCHMARK(Containers, StringMapFindByTemporary)
+{
+	const TArray<FString> Keys = CoreBenchmarks::MakeStringKeys();
+	const TMap<FString, int32> Map = CoreBenchmarks::MakeStringMap(Keys);
+	int32 Index = 0;
+	State.Measure([&Keys, &Map, &Index]()
+	{
+		// What callers holding a view had to do before FindByKey()
+		const FStringView Key = Keys[Index];
+		CoreBenchmarks::DoNotOptimize(Map.Find(FString(Key)));
+		Index = (Index + 1) % CoreBenchmarks::NumContainerElements;
+	});
+}
+
+CORE_BENCHMARK(Containers, StringMapFindByKey)
+{
+	const TArray<FString> Keys = CoreBenchmarks::MakeStringKeys();
+	const TMap<FString, int32> Map = CoreBenchmarks::MakeStringMap(Keys);
+	int32 Index = 0;
+	State.Measure([&Keys, &Map, &Index]()
+	{
+		const FStringView Key = Keys[Index];
+		CoreBenchmarks::DoNotOptimize(Map.FindByKey(Key));
+		Index = (Index + 1) % CoreBenchmarks::NumContainerElements;
+	});
+}
+
+CORE_BENCHMARK(Containers, MapFillAndFindSmall)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	State.Measure([&Keys]()
+	{
+		CoreBenchmarks::FillAndFindSmallMap<TMap<int32, int32>>(Keys);
+	});
+}
+
+CORE_BENCHMARK(Containers, SmallMapFillAndFindSmall)
+{
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	State.Measure([&Keys]()
+	{
+		CoreBenchmarks::FillAndFindSmallMap<TSmallMap<int32, int32>>(Keys);
+	});
+}
+
+CORE_BENCHMARK(Containers, SmallMapFindHashed)
+{
+	// Past the inline elements, lookups go through the TFlatSet the pairs were moved to
+	const TArray<int32> Keys = CoreBenchmarks::MakeRandomKeys();
+	TSmallMap<int32, int32> Map;
+	for (int32 Key : Keys)
+	{
+		Map.Add(Key, Key);
+	}
+	int32 Index = 0;
+	State.Measure([&Keys, &Map, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Map.Find(Keys[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumContainerElements;
+	});
+}
+
+CORE_BENCHMARK(Containers, LowerBoundLarge)
+{
+	const TArray<int32> Table = CoreBenchmarks::MakeLargeSortedTable();
+	const TArray<int32> Lookups = CoreBenchmarks::MakeLargeTableLookups();
+	int32 Index = 0;
+	State.Measure([&Table, &Lookups, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Algo::LowerBound(Table, Lookups[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumLargeTableLookups;
+	});
+}
+
+CORE_BENCHMARK(Containers, EytzingerLowerBoundLarge)
+{
+	TArray<int32> Table = CoreBenchmarks::MakeLargeSortedTable();
+	Algo::EytzingerLayout(Table);
+	const TArray<int32> Lookups = CoreBenchmarks::MakeLargeTableLookups();
+	int32 Index = 0;
+	State.Measure([&Table, &Lookups, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Algo::EytzingerLowerBound(Table, Lookups[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumLargeTableLookups;
+	});
+}
+
+CORE_BENCHMARK(Containers, SortedMapFindLarge)
+{
+	TSortedMap<int32, int32> Map;
+	Map.Reserve(CoreBenchmarks::NumLargeTableElements);
+	for (int32 Key : CoreBenchmarks::MakeLargeSortedTable())
+	{
+		// Added in order, so every pair goes at the end
+		Map.Add(Key, Key);
+	}
+	const TArray<int32> Lookups = CoreBenchmarks::MakeLargeTableLookups();
+	int32 Index = 0;
+	State.Measure([&Map, &Lookups, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Map.Find(Lookups[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumLargeTableLookups;
+	});
+}
+
+CORE_BENCHMARK(Containers, FrozenSortedMapFindLarge)
+{
+	TArray<TPair<int32, int32>> Pairs;
+	Pairs.Reserve(CoreBenchmarks::NumLargeTableElements);
+	for (int32 Key : CoreBenchmarks::MakeLargeSortedTable())
+	{
+		Pairs.Emplace(Key, Key);
+	}
+	const TFrozenSortedMap<int32, int32> Map(MoveTemp(Pairs));
+	const TArray<int32> Lookups = CoreBenchmarks::MakeLargeTableLookups();
+	int32 Index = 0;
+	State.Measure([&Map, &Lookups, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Map.Find(Lookups[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumLargeTableLookups;
+	});
+}
+
+CORE_BENCHMARK(Containers, SortedMapAddRandom)
+{
+	State.Measure([]() { CoreBenchmarks::AddRandomToOrderedMap<TSortedMap<int32, int32>>(); });
+}
+
+CORE_BENCHMARK(Containers, BTreeMapAddRandom)
+{
+	State.Measure([]() { CoreBenchmarks::AddRandomToOrderedMap<TBTreeMap<int32, int32>>(); });
+}
+
+CORE_BENCHMARK(Containers, BTreeMapAddRandomArena)
+{
+	State.Measure([]() { CoreBenchmarks::AddRandomToOrderedMap<TBTreeMap<int32, int32, TLess<int32>, TArenaBTreeAllocator<>>>(); });
+}
+
+CORE_BENCHMARK(Containers, BTreeMapFindLarge)
+{
+	TArray<TPair<int32, int32>> Pairs;
+	Pairs.Reserve(CoreBenchmarks::NumLargeTableElements);
+	for (int32 Key : CoreBenchmarks::MakeLargeSortedTable())
+	{
+		Pairs.Emplace(Key, Key);
+	}
+	TBTreeMap<int32, int32> Map;
+	Map.BulkLoad(MoveTemp(Pairs));
+	const TArray<int32> Lookups = CoreBenchmarks::MakeLargeTableLookups();
+	int32 Index = 0;
+	State.Measure([&Map, &Lookups, &Index]()
+	{
+		CoreBenchmarks::DoNotOptimize(Map.Find(Lookups[Index]));
+		Index = (Index + 1) % CoreBenchmarks::NumLargeTableLookups;
+	});
+}
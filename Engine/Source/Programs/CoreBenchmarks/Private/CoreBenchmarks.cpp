@@ -0,0 +1,221 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	CoreBenchmarks.cpp: Runs the micro-benchmarks registered with CORE_BENCHMARK
+	and reports robust statistics, as text and optionally as JSON.
+=============================================================================*/
+
+#include "Benchmark.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+
+#if IS_PROGRAM
+	#if IS_MONOLITHIC
+		TCHAR GInternalProjectName[64] = TEXT("CoreBenchmarks");
+		const TCHAR* GForeignEngineDir = TEXT(UE_ENGINE_DIRECTORY);
+	#endif
+#endif
+
+#include <stdio.h>
+
+namespace CoreBenchmarks
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	const volatile void* GSink = nullptr;
+#endif
+
+	struct FBenchmark
+	{
+		const TCHAR* Suite;
+		const TCHAR* Name;
+		FBenchmarkFunction Function;
+	};
+
+	static TArray<FBenchmark>& GetBenchmarks()
+	{
+		static TArray<FBenchmark> Benchmarks;
+		return Benchmarks;
+	}
+
+	FRegistration::FRegistration(const TCHAR* Suite, const TCHAR* Name, FBenchmarkFunction Function)
+	{
+		GetBenchmarks().Add({ Suite, Name, Function });
+	}
+
+	/** In nanoseconds per iteration */
+	struct FResult
+	{
+		FString Name;
+		uint64 NumIterations = 0;
+		int32 NumRepetitions = 0;
+		double Median = 0.0;
+		/** Median absolute deviation from the median, unscaled */
+		double MedianAbsoluteDeviation = 0.0;
+		/** 95% confidence interval of the median */
+		double ConfidenceLow = 0.0;
+		double ConfidenceHigh = 0.0;
+		double Min = 0.0;
+		double Mean = 0.0;
+	};
+
+	static double GetMedian(const TArray<double>& Sorted)
+	{
+		const int32 Num = Sorted.Num();
+		return Num % 2 ? Sorted[Num / 2] : 0.5 * (Sorted[Num / 2 - 1] + Sorted[Num / 2]);
+	}
+
+	static FResult ComputeResult(const FString& Name, const FState& State)
+	{
+		FResult Result;
+		Result.Name = Name;
+		Result.NumIterations = State.GetNumIterations();
+
+		TArray<double> Sorted;
+		for (double Sample : State.GetSamples())
+		{
+			Sorted.Add(Sample * 1e9);
+		}
+		Result.NumRepetitions = Sorted.Num();
+		if (Sorted.Num() == 0)
+		{
+			return Result;
+		}
+		Sorted.Sort();
+
+		Result.Median = GetMedian(Sorted);
+		Result.Min = Sorted[0];
+		for (double Sample : Sorted)
+		{
+			Result.Mean += Sample;
+		}
+		Result.Mean /= Sorted.Num();
+
+		TArray<double> Deviations;
+		for (double Sample : Sorted)
+		{
+			Deviations.Add(FMath::Abs(Sample - Result.Median));
+		}
+		Deviations.Sort();
+		Result.MedianAbsoluteDeviation = GetMedian(Deviations);
+
+		// Distribution free interval of the median from order statistics, the ranks n/2 -+ 1.96 * sqrt(n) / 2
+		const double HalfWidth = 0.98 * FMath::Sqrt(double(Sorted.Num()));
+		const int32 LowRank = FMath::Clamp(FMath::FloorToInt(Sorted.Num() / 2.0 - HalfWidth), 0, Sorted.Num() - 1);
+		const int32 HighRank = FMath::Clamp(FMath::CeilToInt(Sorted.Num() / 2.0 + HalfWidth), 0, Sorted.Num() - 1);
+		Result.ConfidenceLow = Sorted[LowRank];
+		Result.ConfidenceHigh = Sorted[HighRank];
+		return Result;
+	}
+
+	static FString ToJsonString(const TArray<FResult>& Results, const FSettings& Settings)
+	{
+		FString Json = FString::Printf(TEXT("{\"platform\":\"%s\",\"cpu\":\"%s\",\"warmups\":%d,\"minRepetitionSeconds\":%g,\"benchmarks\":["),
+			ANSI_TO_TCHAR(FPlatformProperties::PlatformName()), *FPlatformMisc::GetCPUBrand().TrimStartAndEnd(), Settings.NumWarmups, Settings.MinRepetitionSeconds);
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			const FResult& Result = Results[Index];
+			Json += FString::Printf(TEXT("%s{\"name\":\"%s\",\"iterations\":%llu,\"repetitions\":%d,\"medianNs\":%.3f,\"madNs\":%.3f,\"ciLowNs\":%.3f,\"ciHighNs\":%.3f,\"minNs\":%.3f,\"meanNs\":%.3f}"),
+				Index ? TEXT(",") : TEXT(""), *Result.Name, Result.NumIterations, Result.NumRepetitions, Result.Median, Result.MedianAbsoluteDeviation,
+				Result.ConfidenceLow, Result.ConfidenceHigh, Result.Min, Result.Mean);
+		}
+		Json += TEXT("]}");
+		return Json;
+	}
+}
+
+int main(int ArgC, char* ArgV[])
+{
+	using namespace CoreBenchmarks;
+
+	FSettings Settings;
+	FString Filter;
+	FString JsonFilename;
+	bool bList = false;
+	for (int32 Index = 1; Index < ArgC; Index++)
+	{
+		const FString Arg = ANSI_TO_TCHAR(ArgV[Index]);
+		if (Arg.StartsWith(TEXT("-filter=")))
+		{
+			Filter = Arg.Mid(8);
+		}
+		else if (Arg.StartsWith(TEXT("-json=")))
+		{
+			JsonFilename = Arg.Mid(6);
+		}
+		else if (Arg.StartsWith(TEXT("-repetitions=")))
+		{
+			Settings.NumRepetitions = FMath::Max(FCString::Atoi(*Arg.Mid(13)), 1);
+		}
+		else if (Arg.StartsWith(TEXT("-warmups=")))
+		{
+			Settings.NumWarmups = FMath::Max(FCString::Atoi(*Arg.Mid(9)), 0);
+		}
+		else if (Arg.StartsWith(TEXT("-mintime=")))
+		{
+			Settings.MinRepetitionSeconds = FMath::Max(FCString::Atod(*Arg.Mid(9)), 0.0001) / 1000.0;
+		}
+		else if (Arg == TEXT("-list"))
+		{
+			bList = true;
+		}
+		else
+		{
+			printf("Usage: CoreBenchmarks [-filter=<Suite.Name substring>] [-repetitions=15] [-warmups=3] [-mintime=<ms per repetition, 10>] [-json=<file>] [-list]\n");
+			return 1;
+		}
+	}
+
+	FCommandLine::Set(TEXT(""));
+	GGameThreadId = FPlatformTLS::GetCurrentThreadId();
+	GIsGameThreadIdInitialized = true;
+	FTaskGraphInterface::Startup(FPlatformMisc::NumberOfCores());
+	FTaskGraphInterface::Get().AttachToThread(ENamedThreads::GameThread);
+
+	TArray<FBenchmark> Benchmarks = GetBenchmarks();
+	Benchmarks.Sort([](const FBenchmark& A, const FBenchmark& B)
+	{
+		const int32 Compare = FCString::Strcmp(A.Suite, B.Suite);
+		return Compare ? Compare < 0 : FCString::Strcmp(A.Name, B.Name) < 0;
+	});
+
+	TArray<FResult> Results;
+	if (!bList)
+	{
+		printf("%-44s %14s %10s %25s %12s\n", "Benchmark", "Median ns", "MAD ns", "95% CI of median ns", "Iterations");
+	}
+	for (const FBenchmark& Benchmark : Benchmarks)
+	{
+		const FString Name = FString::Printf(TEXT("%s.%s"), Benchmark.Suite, Benchmark.Name);
+		if (!Filter.IsEmpty() && !Name.Contains(Filter))
+		{
+			continue;
+		}
+		if (bList)
+		{
+			printf("%s\n", TCHAR_TO_ANSI(*Name));
+			continue;
+		}
+
+		FState State(Settings);
+		Benchmark.Function(State);
+		const FResult& Result = Results.Add_GetRef(ComputeResult(Name, State));
+
+		char Interval[64];
+		FCStringAnsi::Sprintf(Interval, "%.2f - %.2f", Result.ConfidenceLow, Result.ConfidenceHigh);
+		printf("%-44s %14.2f %10.2f %25s %12llu\n", TCHAR_TO_ANSI(*Name), Result.Median, Result.MedianAbsoluteDeviation, Interval, Result.NumIterations);
+		fflush(stdout);
+	}
+
+	int32 ExitCode = 0;
+	if (!JsonFilename.IsEmpty() && !FFileHelper::SaveStringToFile(ToJsonString(Results, Settings), *JsonFilename))
+	{
+		printf("Could not write %s\n", TCHAR_TO_ANSI(*JsonFilename));
+		ExitCode = 1;
+	}
+
+	FTaskGraphInterface::Shutdown();
+	return ExitCode;
+}
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Async/Async.h"
+#include "HAL/PlatformNamedPipe.h"
+#include "HAL/SharedMemoryRingBuffer.h"
+#include "Misc/Guid.h"
+#include "Templates/UniquePtr.h"
+
+namespace CoreBenchmarks
+{
+	/** Messages of the size that workers stream to the services they report to */
+	static const int32 IpcMessageSize = 4096;
+	static const int32 IpcMessagesPerIteration = 64;
+}
+
+CORE_BENCHMARK(Ipc, SharedMemoryRing4K)
+{
+	// A reader thread drains the ring while the benchmark writes, through two mappings of the region as two processes would
+	const FString Name = FString::Printf(TEXT("CoreBenchmarksRing_%s"), *FGuid::NewGuid().ToString());
+	TUniquePtr<FSharedMemoryRingBuffer> WriteRing(FSharedMemoryRingBuffer::Create(Name, 1024 * 1024));
+	TUniquePtr<FSharedMemoryRingBuffer> ReadRing(WriteRing ? FSharedMemoryRingBuffer::Open(Name, 1024 * 1024) : nullptr);
+	if (!ReadRing)
+	{
+		return;
+	}
+
+	FSharedMemoryRingBuffer* Reader = ReadRing.Get();
+	TFuture<void> ReaderDone = Async(EAsyncExecution::Thread, [Reader]()
+	{
+		TArray<uint8> Message;
+		while (Reader->Read(Message) && Message.Num())
+		{
+			CoreBenchmarks::DoNotOptimize(Message.GetData());
+		}
+	});
+
+	TArray<uint8> Message;
+	Message.SetNumZeroed(CoreBenchmarks::IpcMessageSize);
+	FSharedMemoryRingBuffer* Writer = WriteRing.Get();
+	State.Measure([Writer, &Message]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::IpcMessagesPerIteration; ++Index)
+		{
+			Writer->Write(Message.GetData(), Message.Num());
+		}
+	});
+
+	// An empty message stops the reader
+	Writer->Write(nullptr, 0);
+	ReaderDone.Wait();
+}
+
+#if PLATFORM_SUPPORTS_NAMED_PIPES
+CORE_BENCHMARK(Ipc, NamedPipe4K)
+{
+	const FString Name = FString::Printf(TEXT("\\\\.\\pipe\\CoreBenchmarksPipe_%s"), *FGuid::NewGuid().ToString());
+	FPlatformNamedPipe Server;
+	FPlatformNamedPipe Client;
+	if (!Server.Create(Name, true, false) || !Client.Create(Name, false, false) || !Server.OpenConnection())
+	{
+		return;
+	}
+
+	FPlatformNamedPipe* Reader = &Server;
+	TFuture<void> ReaderDone = Async(EAsyncExecution::Thread, [Reader]()
+	{
+		TArray<uint8> Message;
+		Message.SetNumUninitialized(CoreBenchmarks::IpcMessageSize);
+		while (Reader->ReadBytes(Message.Num(), Message.GetData()) && Message[0] == 0)
+		{
+			CoreBenchmarks::DoNotOptimize(Message.GetData());
+		}
+	});
+
+	TArray<uint8> Message;
+	Message.SetNumZeroed(CoreBenchmarks::IpcMessageSize);
+	FPlatformNamedPipe* Writer = &Client;
+	State.Measure([Writer, &Message]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::IpcMessagesPerIteration; ++Index)
+		{
+			Writer->WriteBytes(Message.Num(), Message.GetData());
+		}
+	});
+
+	// A message starting with a non zero byte stops the reader
+	Message[0] = 1;
+	Writer->WriteBytes(Message.Num(), Message.GetData());
+	ReaderDone.Wait();
+
+	Client.Destroy();
+	Server.Destroy();
+}
+#endif
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+CORE_BENCHMARK(Malloc, SmallAllocFree)
+{
+	State.Measure([]()
+	{
+		void* Ptr = FMemory::Malloc(32);
+		CoreBenchmarks::DoNotOptimize(Ptr);
+		FMemory::Free(Ptr);
+	});
+}
+
+CORE_BENCHMARK(Malloc, MixedSizes)
+{
+	// A window of live blocks of 16 bytes to 32 KB, the oldest is freed when a new one is allocated
+	static const int32 NumLive = 256;
+	FRandomStream Random(0x5678);
+	TArray<SIZE_T> Sizes;
+	for (int32 Index = 0; Index < 4096; ++Index)
+	{
+		Sizes.Add(SIZE_T(16) << Random.RandHelper(12));
+	}
+	TArray<void*> Live;
+	Live.SetNumZeroed(NumLive);
+	int32 Index = 0;
+	State.Measure([&Sizes, &Live, &Index]()
+	{
+		void*& Slot = Live[Index % NumLive];
+		FMemory::Free(Slot);
+		Slot = FMemory::Malloc(Sizes[Index % Sizes.Num()]);
+		++Index;
+	});
+	for (void* Ptr : Live)
+	{
+		FMemory::Free(Ptr);
+	}
+}
+
+CORE_BENCHMARK(Malloc, ReallocGrowth)
+{
+	State.Measure([]()
+	{
+		void* Ptr = nullptr;
+		for (SIZE_T Size = 16; Size <= 64 * 1024; Size *= 2)
+		{
+			Ptr = FMemory::Realloc(Ptr, Size);
+		}
+		CoreBenchmarks::DoNotOptimize(Ptr);
+		FMemory::Free(Ptr);
+	});
+}
+
+CORE_BENCHMARK(Malloc, ParallelSmallAllocFree)
+{
+	// Every worker allocates and frees at once, for the contention on shared allocator state
+	State.Measure([]()
+	{
+		ParallelFor(64, [](int32)
+		{
+			for (int32 Index = 0; Index < 64; ++Index)
+			{
+				void* Ptr = FMemory::Malloc(64);
+				CoreBenchmarks::DoNotOptimize(Ptr);
+				FMemory::Free(Ptr);
+			}
+		});
+	});
+}
@@ -0,0 +1,246 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Math/BakedInterpCurve.h"
+#include "Math/BigInt.h"
+#include "Math/BoundsCulling.h"
+#include "Math/InterpCurve.h"
+#include "Math/RandomStream.h"
+
+namespace CoreBenchmarks
+{
+	/** Bounds per culling pass, a large scene */
+	static const int32 NumCullingBounds = 65536;
+
+	/** Bounds scattered across a large cube, with the planes of a box in its middle that about a quarter of them overlap */
+	static void MakeCullingBounds(TArray<FBoxSphereBounds>& OutBounds, FBoundsSoA& OutSoA, TArray<FPlane>& OutPlanes, FBox& OutBox)
+	{
+		FRandomStream Random(0x5678);
+		OutBounds.Reset(NumCullingBounds);
+		OutSoA.Reset();
+		OutSoA.Reserve(NumCullingBounds);
+		for (int32 Index = 0; Index < NumCullingBounds; ++Index)
+		{
+			const FVector Origin(Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f));
+			const FVector Extent(Random.FRandRange(1.f, 50.f), Random.FRandRange(1.f, 50.f), Random.FRandRange(1.f, 50.f));
+			OutBounds.Add(FBoxSphereBounds(Origin, Extent, Extent.Size()));
+			OutSoA.Add(OutBounds.Last());
+		}
+
+		OutBox = FBox(FVector(-600.f), FVector(600.f));
+		OutPlanes.Reset();
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			FVector Normal(0.f);
+			Normal[Axis] = 1.f;
+			OutPlanes.Add(FPlane(Normal, 600.f));
+			OutPlanes.Add(FPlane(-Normal, 600.f));
+		}
+	}
+
+	/** Inputs per iteration, a tick's worth of curve evaluations */
+	static const int32 NumCurveInputs = 4096;
+
+	/** A curve with a key every unit and times across all of it in increasing order */
+	static void MakeCurveAndTimes(FInterpCurveFloat& OutCurve, TArray<float>& OutTimes)
+	{
+		FRandomStream Random(0x1234);
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			OutCurve.AddPoint(float(Index), Random.FRandRange(-1.f, 1.f));
+			OutCurve.Points.Last().InterpMode = CIM_CurveAuto;
+		}
+		OutCurve.AutoSetTangents();
+
+		OutTimes.SetNumUninitialized(NumCurveInputs);
+		for (int32 Index = 0; Index < NumCurveInputs; ++Index)
+		{
+			OutTimes[Index] = 63.f * float(Index) / float(NumCurveInputs);
+		}
+	}
+}
+
+CORE_BENCHMARK(Math, InterpCurveEval)
+{
+	FInterpCurveFloat Curve;
+	TArray<float> Times;
+	CoreBenchmarks::MakeCurveAndTimes(Curve, Times);
+	State.Measure([&Curve, &Times]()
+	{
+		float Sum = 0.f;
+		for (float Time : Times)
+		{
+			Sum += Curve.Eval(Time);
+		}
+		CoreBenchmarks::DoNotOptimize(Sum);
+	});
+}
+
+CORE_BENCHMARK(Math, InterpCurveEvalMany)
+{
+	FInterpCurveFloat Curve;
+	TArray<float> Times;
+	CoreBenchmarks::MakeCurveAndTimes(Curve, Times);
+	TArray<float> Values;
+	Values.SetNumUninitialized(Times.Num());
+	State.Measure([&Curve, &Times, &Values]()
+	{
+		Curve.EvalMany(Times, Values);
+		CoreBenchmarks::DoNotOptimize(Values.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, BakedInterpCurveEvalMany)
+{
+	FInterpCurveFloat Curve;
+	TArray<float> Times;
+	CoreBenchmarks::MakeCurveAndTimes(Curve, Times);
+	const TBakedInterpCurve<float> Baked(Curve, 1024);
+	TArray<float> Values;
+	Values.SetNumUninitialized(Times.Num());
+	State.Measure([&Baked, &Times, &Values]()
+	{
+		Baked.EvalMany(Times, Values);
+		CoreBenchmarks::DoNotOptimize(Values.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, BigIntModularPowModulo)
+{
+	// A signature check, with a 256-bit modulus and the usual public exponent
+	typedef TBigInt<512, false> FUnsignedInt;
+	const FUnsignedInt Modulus(FString(TEXT("0xC3A5E4D1F0B9287364A1D2E3F4C5B6A79887766554433221FFEEDDCCBBAA9987")));
+	const FUnsignedInt Signature(FString(TEXT("0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF")));
+	const FUnsignedInt Exponent(65537LL);
+	State.Measure([&Modulus, &Signature, &Exponent]()
+	{
+		CoreBenchmarks::DoNotOptimize(FEncryption::ModularPow(Signature, Exponent, Modulus).ToInt());
+	});
+}
+
+CORE_BENCHMARK(Math, BigIntModularPowMontgomery)
+{
+	const TMontgomeryModulus<512> Modulus(TEncryptionInt(FString(TEXT("0xC3A5E4D1F0B9287364A1D2E3F4C5B6A79887766554433221FFEEDDCCBBAA9987"))));
+	const TEncryptionInt Signature(FString(TEXT("0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF")));
+	const TEncryptionInt Exponent(65537LL);
+	State.Measure([&Modulus, &Signature, &Exponent]()
+	{
+		CoreBenchmarks::DoNotOptimize(Modulus.Pow(Signature, Exponent).ToInt());
+	});
+}
+
+CORE_BENCHMARK(Math, CullPlanesScalar)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<int32> Indices;
+	State.Measure([&Bounds, &Planes, &Indices]()
+	{
+		// What FConvexVolume::IntersectBox does for each bounds
+		Indices.Reset();
+		for (int32 Index = 0; Index < Bounds.Num(); ++Index)
+		{
+			const FBoxSphereBounds& Bound = Bounds[Index];
+			bool bInside = true;
+			for (const FPlane& Plane : Planes)
+			{
+				const float PushOut = FMath::Abs(Plane.X * Bound.BoxExtent.X) + FMath::Abs(Plane.Y * Bound.BoxExtent.Y) + FMath::Abs(Plane.Z * Bound.BoxExtent.Z);
+				if (Plane.PlaneDot(Bound.Origin) > PushOut)
+				{
+					bInside = false;
+					break;
+				}
+			}
+			if (bInside)
+			{
+				Indices.Add(Index);
+			}
+		}
+		CoreBenchmarks::DoNotOptimize(Indices.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, CullPlanesBatch)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<int32> Indices;
+	State.Measure([&SoA, &Planes, &Indices]()
+	{
+		FBoundsCulling::CullAgainstPlanes(SoA, Planes, Indices, EParallelForFlags::ForceSingleThread);
+		CoreBenchmarks::DoNotOptimize(Indices.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, CullPlanesBatchParallel)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<int32> Indices;
+	State.Measure([&SoA, &Planes, &Indices]()
+	{
+		FBoundsCulling::CullAgainstPlanes(SoA, Planes, Indices);
+		CoreBenchmarks::DoNotOptimize(Indices.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, CullPlanesBatchMask)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<uint32> Mask;
+	State.Measure([&SoA, &Planes, &Mask]()
+	{
+		FBoundsCulling::CullAgainstPlanes(SoA, Planes, Mask, EParallelForFlags::ForceSingleThread);
+		CoreBenchmarks::DoNotOptimize(Mask.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, OverlapBoxScalar)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<int32> Indices;
+	State.Measure([&Bounds, &Box, &Indices]()
+	{
+		Indices.Reset();
+		for (int32 Index = 0; Index < Bounds.Num(); ++Index)
+		{
+			if (Bounds[Index].GetBox().Intersect(Box))
+			{
+				Indices.Add(Index);
+			}
+		}
+		CoreBenchmarks::DoNotOptimize(Indices.GetData());
+	});
+}
+
+CORE_BENCHMARK(Math, OverlapBoxBatch)
+{
+	TArray<FBoxSphereBounds> Bounds;
+	FBoundsSoA SoA;
+	TArray<FPlane> Planes;
+	FBox Box;
+	CoreBenchmarks::MakeCullingBounds(Bounds, SoA, Planes, Box);
+	TArray<int32> Indices;
+	State.Measure([&SoA, &Box, &Indices]()
+	{
+		FBoundsCulling::OverlapBox(SoA, Box, Indices, EParallelForFlags::ForceSingleThread);
+		CoreBenchmarks::DoNotOptimize(Indices.GetData());
+	});
+}
@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+
+namespace CoreBenchmarks
+{
+	/** Bytes per copy, far more than any cache, so the time per iteration gives the bandwidth of each method */
+	static const SIZE_T LargeCopySize = 256 * 1024 * 1024;
+
+	/** A source and a destination of LargeCopySize bytes, both written once so that their pages are mapped */
+	struct FLargeBlocks
+	{
+		uint8* Src;
+		uint8* Dest;
+
+		FLargeBlocks()
+			: Src((uint8*)FMemory::Malloc(LargeCopySize, 4096))
+			, Dest((uint8*)FMemory::Malloc(LargeCopySize, 4096))
+		{
+			FMemory::Memset(Src, 0x5A, LargeCopySize);
+			FMemory::Memzero(Dest, LargeCopySize);
+		}
+
+		~FLargeBlocks()
+		{
+			FMemory::Free(Src);
+			FMemory::Free(Dest);
+		}
+	};
+}
+
+CORE_BENCHMARK(Memory, Memcpy256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::Memcpy(Blocks.Dest, Blocks.Src, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
+
+CORE_BENCHMARK(Memory, BigBlockMemcpy256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::BigBlockMemcpy(Blocks.Dest, Blocks.Src, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
+
+CORE_BENCHMARK(Memory, NonTemporalMemcpy256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::NonTemporalMemcpy(Blocks.Dest, Blocks.Src, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
+
+CORE_BENCHMARK(Memory, ParallelMemcpy256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::ParallelMemcpy(Blocks.Dest, Blocks.Src, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
+
+CORE_BENCHMARK(Memory, Memset256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::Memset(Blocks.Dest, 0x33, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
+
+CORE_BENCHMARK(Memory, NonTemporalMemset256MB)
+{
+	CoreBenchmarks::FLargeBlocks Blocks;
+	State.Measure([&Blocks]()
+	{
+		FMemory::NonTemporalMemset(Blocks.Dest, 0x33, CoreBenchmarks::LargeCopySize);
+		CoreBenchmarks::DoNotOptimize(Blocks.Dest);
+	});
+}
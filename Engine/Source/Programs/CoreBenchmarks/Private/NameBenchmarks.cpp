@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Containers/StringConv.h"
+#include "Misc/StringBuilder.h"
+
+CORE_BENCHMARK(Name, FindExisting)
+{
+	const FName Existing(TEXT("CoreBenchmarksExistingName"));
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(FName(TEXT("CoreBenchmarksExistingName"), FNAME_Find));
+	});
+}
+
+CORE_BENCHMARK(Name, CreateNumbered)
+{
+	// The same string with a new number each time only adds the number, not a name entry
+	int32 Number = 0;
+	State.Measure([&Number]()
+	{
+		CoreBenchmarks::DoNotOptimize(FName(TEXT("CoreBenchmarksNumberedName"), ++Number));
+	});
+}
+
+CORE_BENCHMARK(Name, Compare)
+{
+	const FName A(TEXT("CoreBenchmarksNameA"));
+	const FName B(TEXT("CoreBenchmarksNameB"));
+	State.Measure([&A, &B]()
+	{
+		CoreBenchmarks::DoNotOptimize(A.Compare(B));
+	});
+}
+
+CORE_BENCHMARK(Name, ToString)
+{
+	const FName Name(TEXT("CoreBenchmarksToStringName"), 7);
+	FString String;
+	State.Measure([&Name, &String]()
+	{
+		Name.ToString(String);
+		CoreBenchmarks::DoNotOptimize(String.Len());
+	});
+}
+
+CORE_BENCHMARK(Name, ToStringNew)
+{
+	const FName Name(TEXT("CoreBenchmarksToStringName"));
+	State.Measure([&Name]()
+	{
+		CoreBenchmarks::DoNotOptimize(Name.ToString().Len());
+	});
+}
+
+CORE_BENCHMARK(Name, AppendStringBuilder)
+{
+	const FName Name(TEXT("CoreBenchmarksToStringName"), 7);
+	State.Measure([&Name]()
+	{
+		TStringBuilder<FName::StringBufferSize> Builder;
+		Name.AppendString(Builder);
+		CoreBenchmarks::DoNotOptimize(Builder.Len());
+	});
+}
+
+CORE_BENCHMARK(Name, ToStringThenUtf8)
+{
+	// How UTF-8 output was written before AppendUtf8String, through a TCHAR string
+	const FName Name(TEXT("CoreBenchmarksToStringName"), 7);
+	State.Measure([&Name]()
+	{
+		const FString String = Name.ToString();
+		FTCHARToUTF8 Utf8(*String, String.Len());
+		CoreBenchmarks::DoNotOptimize(Utf8.Length());
+	});
+}
+
+CORE_BENCHMARK(Name, AppendUtf8String)
+{
+	const FName Name(TEXT("CoreBenchmarksToStringName"), 7);
+	State.Measure([&Name]()
+	{
+		TAnsiStringBuilder<FName::StringBufferSize> Builder;
+		Name.AppendUtf8String(Builder);
+		CoreBenchmarks::DoNotOptimize(Builder.Len());
+	});
+}
+
+CORE_BENCHMARK(Name, FindExistingUtf8)
+{
+	const FName Existing(TEXT("CoreBenchmarksExistingName"));
+	static const char Utf8[] = "CoreBenchmarksExistingName";
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(FName(UE_ARRAY_COUNT(Utf8) - 1, reinterpret_cast<const UTF8CHAR*>(Utf8), FNAME_Find));
+	});
+}
@@ -0,0 +1,260 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Algo/LevenshteinDistance.h"
+#include "Containers/StringConv.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
+#include "String/NumberConversion.h"
+
+namespace CoreBenchmarks
+{
+	static const TCHAR* AsciiText = TEXT("The quick brown fox jumps over the lazy dog, again and again and again.");
+	static const TCHAR* WideText = TEXT("Gr\u00FC\u00DFe aus K\u00F6ln, \u65E5\u672C\u8A9E\u306E\u30C6\u30AD\u30B9\u30C8 and some ASCII to finish.");
+
+	/** As many asset-like names as a search box filters on every keystroke */
+	static TArray<FString> MakeSearchNames()
+	{
+		static const TCHAR* Words[] = { TEXT("Static"), TEXT("Mesh"), TEXT("Rock"), TEXT("Tree"), TEXT("Material"), TEXT("Instance"), TEXT("Cliff"), TEXT("Light") };
+		FRandomStream Random(0x4321);
+		TArray<FString> Names;
+		Names.Reserve(100 * 1000);
+		for (int32 Index = 0; Index < 100 * 1000; ++Index)
+		{
+			Names.Add(FString::Printf(TEXT("SM_%s%s_%d"), Words[Random.RandHelper(8)], Words[Random.RandHelper(8)], Random.RandHelper(1000)));
+		}
+		return Names;
+	}
+
+	static const TCHAR* FloatText = TEXT("-1234.56789e-3");
+
+	/** A typical editor command line, a project, a map, some switches and key=value pairs */
+	static FString MakeCommandLine()
+	{
+		FString CommandLine = TEXT("\"D:/Projects/Game/Game.uproject\" /Game/Maps/Entry -game -log -windowed ResX=1280 ResY=720 -ExecCmds=\"stat fps, stat unit\"");
+		for (int32 Index = 0; Index < 40; ++Index)
+		{
+			CommandLine += FString::Printf(TEXT(" -Switch%d -Setting%d=Value%d"), Index, Index, Index);
+		}
+		return CommandLine;
+	}
+
+	/** The queries startup code makes, mostly for switches that aren't there */
+	static void QueryCommandLine(const TCHAR* CommandLine)
+	{
+		int32 Found = 0;
+		FString Value;
+		Found += FParse::Param(CommandLine, TEXT("nosound"));
+		Found += FParse::Param(CommandLine, TEXT("Switch39"));
+		Found += FParse::Param(CommandLine, TEXT("unattended"));
+		Found += FParse::Value(CommandLine, TEXT("ResX="), Value);
+		Found += FParse::Value(CommandLine, TEXT("-Setting20="), Value);
+		Found += FParse::Value(CommandLine, TEXT("-abslog="), Value);
+		DoNotOptimize(Found);
+	}
+}
+
+CORE_BENCHMARK(String, TCharToUtf8Ascii)
+{
+	State.Measure([]()
+	{
+		FTCHARToUTF8 Converted(CoreBenchmarks::AsciiText);
+		CoreBenchmarks::DoNotOptimize(Converted.Length());
+	});
+}
+
+CORE_BENCHMARK(String, TCharToUtf8Wide)
+{
+	State.Measure([]()
+	{
+		FTCHARToUTF8 Converted(CoreBenchmarks::WideText);
+		CoreBenchmarks::DoNotOptimize(Converted.Length());
+	});
+}
+
+CORE_BENCHMARK(String, Utf8ToTChar)
+{
+	const FTCHARToUTF8 Utf8(CoreBenchmarks::WideText);
+	const ANSICHAR* Text = Utf8.Get();
+	State.Measure([Text]()
+	{
+		FUTF8ToTCHAR Converted(Text);
+		CoreBenchmarks::DoNotOptimize(Converted.Length());
+	});
+}
+
+CORE_BENCHMARK(String, TCharToAnsi)
+{
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(StringCast<ANSICHAR>(CoreBenchmarks::AsciiText).Length());
+	});
+}
+
+CORE_BENCHMARK(String, Printf)
+{
+	int32 Number = 0;
+	State.Measure([&Number]()
+	{
+		CoreBenchmarks::DoNotOptimize(FString::Printf(TEXT("Item %d of %s at %.2f"), ++Number, TEXT("List"), 1.5f).Len());
+	});
+}
+
+CORE_BENCHMARK(String, LexToString)
+{
+	int32 Number = 0;
+	State.Measure([&Number]()
+	{
+		CoreBenchmarks::DoNotOptimize(LexToString(++Number).Len());
+	});
+}
+
+CORE_BENCHMARK(String, LevenshteinDistanceDP)
+{
+	const FString A(TEXT("SM_RockCliff_12"));
+	const FString B(TEXT("SM_CliffRock_21"));
+	State.Measure([&A, &B]()
+	{
+		CoreBenchmarks::DoNotOptimize(AlgoImpl::LevenshteinDistanceDP(A, B));
+	});
+}
+
+CORE_BENCHMARK(String, LevenshteinDistance)
+{
+	const FString A(TEXT("SM_RockCliff_12"));
+	const FString B(TEXT("SM_CliffRock_21"));
+	State.Measure([&A, &B]()
+	{
+		CoreBenchmarks::DoNotOptimize(Algo::LevenshteinDistance(A, B));
+	});
+}
+
+CORE_BENCHMARK(String, ParallelLevenshteinDistance100K)
+{
+	const TArray<FString> Names = CoreBenchmarks::MakeSearchNames();
+	TArray<int32> Distances;
+	Distances.SetNumUninitialized(Names.Num());
+	State.Measure([&Names, &Distances]()
+	{
+		Algo::ParallelLevenshteinDistance(FString(TEXT("SM_TreeRock")), Names, Distances, 4);
+		CoreBenchmarks::DoNotOptimize(Distances.GetData());
+	});
+}
+
+CORE_BENCHMARK(String, AtofDouble)
+{
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(FCString::Atod(CoreBenchmarks::FloatText));
+	});
+}
+
+CORE_BENCHMARK(String, ParseNumberDouble)
+{
+	const FStringView Text(CoreBenchmarks::FloatText);
+	State.Measure([Text]()
+	{
+		double Value = 0.0;
+		UE::String::ParseNumber(Text, Value);
+		CoreBenchmarks::DoNotOptimize(Value);
+	});
+}
+
+CORE_BENCHMARK(String, PrintfDouble)
+{
+	double Value = 0.1;
+	State.Measure([&Value]()
+	{
+		TStringBuilder<64> Builder;
+		Builder.Appendf(TEXT("%.17g"), Value += 1.0 / 3.0);
+		CoreBenchmarks::DoNotOptimize(Builder.Len());
+	});
+}
+
+CORE_BENCHMARK(String, AppendShortestDouble)
+{
+	double Value = 0.1;
+	State.Measure([&Value]()
+	{
+		TStringBuilder<64> Builder;
+		UE::String::AppendShortest(Builder, Value += 1.0 / 3.0);
+		CoreBenchmarks::DoNotOptimize(Builder.Len());
+	});
+}
+
+CORE_BENCHMARK(String, ParseCommandLineScan)
+{
+	const FString CommandLine = CoreBenchmarks::MakeCommandLine();
+	State.Measure([&CommandLine]()
+	{
+		CoreBenchmarks::QueryCommandLine(*CommandLine);
+	});
+}
+
+CORE_BENCHMARK(String, ParseCommandLineIndexed)
+{
+	const FString Original = FCommandLine::Get();
+	FCommandLine::Set(*CoreBenchmarks::MakeCommandLine());
+	State.Measure([]()
+	{
+		CoreBenchmarks::QueryCommandLine(FCommandLine::Get());
+	});
+	FCommandLine::Set(*Original);
+}
+
+namespace CoreBenchmarks
+{
+	static const TCHAR* PathText = TEXT("/Game/Environment/Props/Rocks/SM_RockCliff_Large_01.SM_RockCliff_Large_01");
+	static const TCHAR* PathTextUpper = TEXT("/GAME/ENVIRONMENT/PROPS/ROCKS/SM_ROCKCLIFF_LARGE_01.SM_ROCKCLIFF_LARGE_01");
+
+	/** What Stricmp did before it had a vector path, one character at a time */
+	static int32 StricmpScalar(const TCHAR* String1, const TCHAR* String2)
+	{
+		for (;; ++String1, ++String2)
+		{
+			const TCHAR Char1 = FChar::ToLower(*String1);
+			const TCHAR Char2 = FChar::ToLower(*String2);
+			if (Char1 != Char2 || Char1 == 0)
+			{
+				return FChar::ToUnsigned(Char1) - FChar::ToUnsigned(Char2);
+			}
+		}
+	}
+}
+
+CORE_BENCHMARK(String, StricmpPathScalar)
+{
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(CoreBenchmarks::StricmpScalar(CoreBenchmarks::PathText, CoreBenchmarks::PathTextUpper));
+	});
+}
+
+CORE_BENCHMARK(String, StricmpPath)
+{
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(FCString::Stricmp(CoreBenchmarks::PathText, CoreBenchmarks::PathTextUpper));
+	});
+}
+
+CORE_BENCHMARK(String, StrlenPath)
+{
+	State.Measure([]()
+	{
+		CoreBenchmarks::DoNotOptimize(FCString::Strlen(CoreBenchmarks::PathText));
+	});
+}
+
+CORE_BENCHMARK(String, ToLowerInlinePath)
+{
+	FString Path(CoreBenchmarks::PathTextUpper);
+	State.Measure([&Path]()
+	{
+		Path.ToLowerInline();
+		Path.ToUpperInline();
+		CoreBenchmarks::DoNotOptimize(*Path);
+	});
+}
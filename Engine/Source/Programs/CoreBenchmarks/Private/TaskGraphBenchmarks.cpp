@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+CORE_BENCHMARK(TaskGraph, DispatchAndWait)
+{
+	State.Measure([]()
+	{
+		FGraphEventRef Event = FFunctionGraphTask::CreateAndDispatchWhenReady([]() {}, TStatId());
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Event, ENamedThreads::GameThread);
+	});
+}
+
+CORE_BENCHMARK(TaskGraph, Dispatch100AndWait)
+{
+	FGraphEventArray Events;
+	State.Measure([&Events]()
+	{
+		Events.Reset();
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			Events.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([]() {}, TStatId()));
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(Events, ENamedThreads::GameThread);
+	});
+}
+
+CORE_BENCHMARK(TaskGraph, TaskChain100)
+{
+	// Each task has the one before as prerequisite, for the latency of subsequents
+	State.Measure([]()
+	{
+		FGraphEventRef Event;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			FGraphEventArray Prerequisites;
+			if (Event.GetReference())
+			{
+				Prerequisites.Add(Event);
+			}
+			Event = FFunctionGraphTask::CreateAndDispatchWhenReady([]() {}, TStatId(), &Prerequisites);
+		}
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Event, ENamedThreads::GameThread);
+	});
+}
+
+CORE_BENCHMARK(TaskGraph, ParallelFor1000)
+{
+	TArray<float> Values;
+	Values.SetNumZeroed(1000);
+	State.Measure([&Values]()
+	{
+		ParallelFor(Values.Num(), [&Values](int32 Index)
+		{
+			Values[Index] += 1.0f;
+		});
+		CoreBenchmarks::DoNotOptimize(Values.GetData());
+	});
+}
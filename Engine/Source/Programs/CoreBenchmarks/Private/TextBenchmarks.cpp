@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "Async/ParallelFor.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/TextKey.h"
+
+namespace CoreBenchmarks
+{
+	/** Namespace and key strings like the ones of loaded text properties, one table per benchmark */
+	static TArray<FString> MakeTextKeyStrings(const TCHAR* Prefix, const int32 Num)
+	{
+		TArray<FString> Strings;
+		Strings.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Strings.Add(FString::Printf(TEXT("%s_%08X"), Prefix, Index * 2654435761u));
+		}
+		return Strings;
+	}
+
+	static const int32 NumTextKeyStrings = 4096;
+}
+
+CORE_BENCHMARK(Text, KeyFindContended)
+{
+	// Every worker interns the same existing keys at once, as parallel loading of assets that share namespaces does
+	const TArray<FString> Strings = CoreBenchmarks::MakeTextKeyStrings(TEXT("CoreBenchmarksTextKeyFind"), CoreBenchmarks::NumTextKeyStrings);
+	for (const FString& String : Strings)
+	{
+		FTextKey Key(String);
+	}
+
+	const int32 NumTasks = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	State.Measure([&Strings, NumTasks]()
+	{
+		ParallelFor(NumTasks, [&Strings](int32 TaskIndex)
+		{
+			for (int32 Index = 0; Index < Strings.Num(); ++Index)
+			{
+				// Spread the tasks over the strings so that they don't walk the shards in lockstep
+				const FTextKey Key(*Strings[(Index + TaskIndex * 7919) % Strings.Num()]);
+				CoreBenchmarks::DoNotOptimize(Key);
+			}
+		});
+	});
+}
+
+CORE_BENCHMARK(Text, KeyAddContended)
+{
+	// Half of the workers keep adding new keys while the others find existing ones, the new keys make the tables grow under the readers
+	const TArray<FString> Strings = CoreBenchmarks::MakeTextKeyStrings(TEXT("CoreBenchmarksTextKeyAdd"), CoreBenchmarks::NumTextKeyStrings);
+	for (const FString& String : Strings)
+	{
+		FTextKey Key(String);
+	}
+
+	const int32 NumTasks = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	int32 Repetition = 0;
+	State.Measure([&Strings, NumTasks, &Repetition]()
+	{
+		++Repetition;
+		ParallelFor(NumTasks, [&Strings, Repetition](int32 TaskIndex)
+		{
+			TCHAR NewKey[64];
+			for (int32 Index = 0; Index < Strings.Num(); ++Index)
+			{
+				if ((TaskIndex & 1) && (Index & 15) == 0)
+				{
+					FCString::Sprintf(NewKey, TEXT("CoreBenchmarksTextKeyAdd_%d_%d_%d"), Repetition, TaskIndex, Index);
+					CoreBenchmarks::DoNotOptimize(FTextKey(NewKey));
+				}
+				else
+				{
+					CoreBenchmarks::DoNotOptimize(FTextKey(*Strings[(Index + TaskIndex * 7919) % Strings.Num()]));
+				}
+			}
+		});
+	});
+}
+
+CORE_BENCHMARK(Text, CacheFindContended)
+{
+	// LOCTEXT and NSLOCTEXT go through the text cache, which every worker finds the same entries in at once
+	const TArray<FString> Keys = CoreBenchmarks::MakeTextKeyStrings(TEXT("CoreBenchmarksTextCache"), CoreBenchmarks::NumTextKeyStrings);
+	for (const FString& Key : Keys)
+	{
+		FInternationalization::ForUseOnlyByLocMacroAndGraphNodeTextLiterals_CreateText(*Key, TEXT("CoreBenchmarks"), *Key);
+	}
+
+	const int32 NumTasks = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	State.Measure([&Keys, NumTasks]()
+	{
+		ParallelFor(NumTasks, [&Keys](int32 TaskIndex)
+		{
+			for (int32 Index = 0; Index < Keys.Num(); ++Index)
+			{
+				const TCHAR* Key = *Keys[(Index + TaskIndex * 7919) % Keys.Num()];
+				CoreBenchmarks::DoNotOptimize(FInternationalization::ForUseOnlyByLocMacroAndGraphNodeTextLiterals_CreateText(Key, TEXT("CoreBenchmarks"), Key));
+			}
+		});
+	});
+}
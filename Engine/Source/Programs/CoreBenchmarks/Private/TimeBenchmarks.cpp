@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "HAL/PlatformTime.h"
+
+namespace CoreBenchmarks
+{
+	/** Timestamps per iteration, as many as a few nested profiling scopes take */
+	static const int32 TimestampsPerIteration = 64;
+}
+
+CORE_BENCHMARK(Time, Cycles64)
+{
+	// Reads the timestamp counter where FPlatformTime::IsUsingTimestampCounter, the OS clock otherwise
+	State.Measure([]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::TimestampsPerIteration; ++Index)
+		{
+			CoreBenchmarks::DoNotOptimize(FPlatformTime::Cycles64());
+		}
+	});
+}
+
+CORE_BENCHMARK(Time, Seconds)
+{
+	State.Measure([]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::TimestampsPerIteration; ++Index)
+		{
+			CoreBenchmarks::DoNotOptimize(FPlatformTime::Seconds());
+		}
+	});
+}
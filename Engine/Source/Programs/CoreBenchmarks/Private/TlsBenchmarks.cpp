@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Benchmark.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadSingleton.h"
+
+namespace CoreBenchmarks
+{
+	/** Accesses per iteration, so that the cost of one access shows over the cost of measuring */
+	static const int32 TlsAccessesPerIteration = 64;
+
+	static thread_local void* ThreadLocalValue TLS_INITIAL_EXEC = nullptr;
+
+	class FTlsBenchmarkSingleton : public TThreadSingleton<FTlsBenchmarkSingleton>
+	{
+	public:
+		int32 Value = 0;
+	};
+}
+
+CORE_BENCHMARK(Tls, PlatformTlsValue)
+{
+	const uint32 TlsSlot = FPlatformTLS::AllocTlsSlot();
+	FPlatformTLS::SetTlsValue(TlsSlot, &State);
+	State.Measure([TlsSlot]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::TlsAccessesPerIteration; ++Index)
+		{
+			CoreBenchmarks::DoNotOptimize(FPlatformTLS::GetTlsValue(TlsSlot));
+		}
+	});
+	FPlatformTLS::FreeTlsSlot(TlsSlot);
+}
+
+CORE_BENCHMARK(Tls, ThreadLocal)
+{
+	CoreBenchmarks::ThreadLocalValue = &State;
+	State.Measure([]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::TlsAccessesPerIteration; ++Index)
+		{
+			CoreBenchmarks::DoNotOptimize(CoreBenchmarks::ThreadLocalValue);
+		}
+	});
+}
+
+CORE_BENCHMARK(Tls, ThreadSingleton)
+{
+	// Uses a thread_local cache of the instance where PLATFORM_USES_THREAD_LOCAL_FOR_TLS, the TLS slot otherwise
+	CoreBenchmarks::FTlsBenchmarkSingleton::Get();
+	State.Measure([]()
+	{
+		for (int32 Index = 0; Index < CoreBenchmarks::TlsAccessesPerIteration; ++Index)
+		{
+			CoreBenchmarks::DoNotOptimize(CoreBenchmarks::FTlsBenchmarkSingleton::Get().Value);
+		}
+	});
+}
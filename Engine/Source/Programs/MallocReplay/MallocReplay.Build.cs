@@ -0,0 +1,10 @@
+using UnrealBuildTool;
+public class MallocReplay : ModuleRules
+{
+	public MallocReplay(ReadOnlyTargetRules Target) : base(Target)
+	{
+        bUseUnity = false;
+
+        PrivateDependencyModuleNames.Add("Core");
+    }
+}
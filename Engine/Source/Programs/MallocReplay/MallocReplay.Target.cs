@@ -0,0 +1,22 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class MallocReplayTarget : TargetRules
+{
+	public MallocReplayTarget(TargetInfo Target) : base(Target)
+	{
+        Type = TargetType.Program;
+        LinkType = TargetLinkType.Monolithic;
+        BuildEnvironment = TargetBuildEnvironment.Unique;
+        LaunchModuleName = "MallocReplay";
+
+        bCompileICU = false;
+        bCompileAgainstEngine = false;
+
+        // the tool's own bookkeeping goes to the CRT so that the allocator being replayed owns its global state alone
+        GlobalDefinitions.Add("FORCE_ANSI_ALLOCATOR=1");
+
+        bIsBuildingConsoleApplication = true;
+    }
+}
@@ -0,0 +1,374 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	MallocReplay.cpp: Replays allocation streams written by FMallocReplayProxy
+	(-mallocsavereplay) against an FMalloc of choice and reports how it did.
+=============================================================================*/
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/MallocAnsi.h"
+#include "HAL/MallocBinned2.h"
+#include "HAL/MallocBinned3.h"
+#include "HAL/MallocMimalloc.h"
+#include "HAL/MallocTBB.h"
+#include "HAL/MallocJemalloc.h"
+
+#if IS_PROGRAM
+	#if IS_MONOLITHIC
+		TCHAR GInternalProjectName[64] = TEXT("MallocReplay");
+		const TCHAR* GForeignEngineDir = TEXT(UE_ENGINE_DIRECTORY);
+	#endif
+#endif
+
+#include <stdio.h>
+
+namespace MallocReplay
+{
+	enum class EOperation : uint8
+	{
+		Malloc,
+		Realloc,
+		Free,
+	};
+
+	/** A recorded operation, with pointers resolved to slots so that replaying doesn't need a map lookup. */
+	struct FOperation
+	{
+		EOperation Operation;
+		uint32 Alignment;
+		/** Slot of the block passed in, INDEX_NONE for Malloc or a Realloc of nullptr. */
+		int32 InSlot;
+		/** Slot the returned block goes to, INDEX_NONE for Free or a Realloc to zero. */
+		int32 OutSlot;
+		uint64 Size;
+	};
+
+	/** Requested sizes are grouped in power of two classes, so that the report means the same for every allocator. */
+	static const int32 NumSizeClasses = 40;
+
+	struct FSizeClassStats
+	{
+		uint64 NumAllocs = 0;
+		uint64 NumFrees = 0;
+		int64 NumLive = 0;
+		int64 PeakLive = 0;
+		uint64 RequestedBytes = 0;
+		uint64 QuantizedBytes = 0;
+	};
+
+	static int32 GetSizeClass(uint64 Size)
+	{
+		return Size <= 16 ? 0 : FMath::Min<int32>(int32(FPlatformMath::CeilLogTwo64(Size)) - 4, NumSizeClasses - 1);
+	}
+
+	/** Operations between two samples of the process' memory usage, sampling isn't counted towards the replay time. */
+	static const int32 MemorySampleInterval = 16384;
+
+	struct FStream
+	{
+		TArray<FOperation> Operations;
+		int32 NumSlots = 0;
+		uint32 NumSkipped = 0;
+
+		/** Requested bytes live after the operation preceding each memory sample. */
+		TArray<uint64> LiveBytesAtSample;
+		uint64 PeakLiveBytes = 0;
+
+		FSizeClassStats SizeClasses[NumSizeClasses];
+	};
+
+	static bool LoadStream(const char* Filename, FStream& Stream)
+	{
+		FILE* File = fopen(Filename, "rb");
+		if (!File)
+		{
+			printf("Cannot open %s\n", Filename);
+			return false;
+		}
+
+		// recorded address -> slot of the block currently living there
+		TMap<uint64, int32> LiveSlots;
+		TArray<uint64> SlotSizes;
+		uint64 LiveBytes = 0;
+
+		auto AddBlock = [&Stream, &LiveSlots, &SlotSizes, &LiveBytes](uint64 Ptr, uint64 Size) -> int32
+		{
+			const int32 Slot = Stream.NumSlots++;
+			LiveSlots.Add(Ptr, Slot);
+			SlotSizes.Add(Size);
+			LiveBytes += Size;
+
+			FSizeClassStats& SizeClass = Stream.SizeClasses[GetSizeClass(Size)];
+			SizeClass.NumAllocs++;
+			SizeClass.RequestedBytes += Size;
+			SizeClass.PeakLive = FMath::Max(SizeClass.PeakLive, ++SizeClass.NumLive);
+			return Slot;
+		};
+
+		auto RemoveBlock = [&Stream, &LiveSlots, &SlotSizes, &LiveBytes](uint64 Ptr) -> int32
+		{
+			int32 Slot = INDEX_NONE;
+			if (LiveSlots.RemoveAndCopyValue(Ptr, Slot))
+			{
+				const uint64 Size = SlotSizes[Slot];
+				LiveBytes -= Size;
+
+				FSizeClassStats& SizeClass = Stream.SizeClasses[GetSizeClass(Size)];
+				SizeClass.NumFrees++;
+				SizeClass.NumLive--;
+			}
+			return Slot;
+		};
+
+		char Line[256];
+		while (fgets(Line, sizeof(Line), File))
+		{
+			char Operation[16];
+			unsigned long long PointerOut, PointerIn, Size;
+			unsigned int Alignment;
+			if (sscanf(Line, "%15s %llu %llu %llu %u", Operation, &PointerOut, &PointerIn, &Size, &Alignment) != 5)
+			{
+				// header, trailer or a line cut short by a crash
+				continue;
+			}
+
+			FOperation Op;
+			Op.Alignment = Alignment;
+			Op.Size = Size;
+			Op.InSlot = INDEX_NONE;
+			Op.OutSlot = INDEX_NONE;
+
+			if (FCStringAnsi::Strcmp(Operation, "Malloc") == 0)
+			{
+				Op.Operation = EOperation::Malloc;
+			}
+			else if (FCStringAnsi::Strcmp(Operation, "Realloc") == 0)
+			{
+				Op.Operation = EOperation::Realloc;
+			}
+			else if (FCStringAnsi::Strcmp(Operation, "Free") == 0)
+			{
+				Op.Operation = EOperation::Free;
+			}
+			else
+			{
+				Stream.NumSkipped++;
+				continue;
+			}
+
+			if (PointerIn)
+			{
+				Op.InSlot = RemoveBlock(PointerIn);
+				if (Op.InSlot == INDEX_NONE)
+				{
+					// allocated before recording started, nothing to replay it against
+					Stream.NumSkipped++;
+					continue;
+				}
+			}
+			else if (Op.Operation == EOperation::Free)
+			{
+				continue;
+			}
+
+			if (PointerOut)
+			{
+				Op.OutSlot = AddBlock(PointerOut, Size);
+			}
+
+			if (Stream.Operations.Num() % MemorySampleInterval == 0)
+			{
+				Stream.LiveBytesAtSample.Add(LiveBytes);
+			}
+			Stream.Operations.Add(Op);
+			Stream.PeakLiveBytes = FMath::Max(Stream.PeakLiveBytes, LiveBytes);
+		}
+
+		fclose(File);
+		return true;
+	}
+
+	static FMalloc* CreateAllocator(const char* Name)
+	{
+		if (FCStringAnsi::Stricmp(Name, "ansi") == 0)
+		{
+			return new FMallocAnsi();
+		}
+		if (FCStringAnsi::Stricmp(Name, "binned2") == 0)
+		{
+			return new FMallocBinned2();
+		}
+#if PLATFORM_64BITS && PLATFORM_HAS_FPlatformVirtualMemoryBlock
+		if (FCStringAnsi::Stricmp(Name, "binned3") == 0)
+		{
+			return new FMallocBinned3();
+		}
+#endif
+#if PLATFORM_SUPPORTS_MIMALLOC && MIMALLOC_ALLOCATOR_ALLOWED
+		if (FCStringAnsi::Stricmp(Name, "mimalloc") == 0)
+		{
+			return new FMallocMimalloc();
+		}
+#endif
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+		if (FCStringAnsi::Stricmp(Name, "tbb") == 0)
+		{
+			return new FMallocTBB();
+		}
+#endif
+#if PLATFORM_SUPPORTS_JEMALLOC
+		if (FCStringAnsi::Stricmp(Name, "jemalloc") == 0)
+		{
+			return new FMallocJemalloc();
+		}
+#endif
+		return nullptr;
+	}
+
+	static double ToMB(uint64 Bytes)
+	{
+		return double(Bytes) / (1024.0 * 1024.0);
+	}
+
+	static void Replay(const FStream& Stream, FMalloc* Allocator, bool bTouchMemory)
+	{
+		TArray<void*> Slots;
+		Slots.AddZeroed(Stream.NumSlots);
+
+		const uint64 BaselineUsed = FPlatformMemory::GetStats().UsedPhysical;
+		uint64 PeakUsed = 0;
+		uint64 LiveBytesAtPeak = 0;
+		uint64 ReplayCycles = 0;
+
+		const int32 NumOperations = Stream.Operations.Num();
+		for (int32 SampleIndex = 0; SampleIndex * MemorySampleInterval < NumOperations; SampleIndex++)
+		{
+			const uint64 Used = FPlatformMemory::GetStats().UsedPhysical - BaselineUsed;
+			if (Used > PeakUsed)
+			{
+				PeakUsed = Used;
+				LiveBytesAtPeak = Stream.LiveBytesAtSample[SampleIndex];
+			}
+
+			const int32 FirstOperation = SampleIndex * MemorySampleInterval;
+			const int32 LastOperation = FMath::Min(FirstOperation + MemorySampleInterval, NumOperations);
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Index = FirstOperation; Index < LastOperation; Index++)
+			{
+				const FOperation& Op = Stream.Operations[Index];
+				void* Result = nullptr;
+				switch (Op.Operation)
+				{
+				case EOperation::Malloc:
+					Result = Allocator->Malloc(Op.Size, Op.Alignment);
+					break;
+				case EOperation::Realloc:
+					Result = Allocator->Realloc(Op.InSlot == INDEX_NONE ? nullptr : Slots[Op.InSlot], Op.Size, Op.Alignment);
+					break;
+				case EOperation::Free:
+					Allocator->Free(Slots[Op.InSlot]);
+					break;
+				}
+
+				if (Op.OutSlot != INDEX_NONE)
+				{
+					Slots[Op.OutSlot] = Result;
+					if (bTouchMemory && Result)
+					{
+						// commit the pages like the recorded process would have
+						for (uint64 Offset = 0; Offset < Op.Size; Offset += 4096)
+						{
+							((volatile uint8*)Result)[Offset] = 0;
+						}
+					}
+				}
+			}
+			ReplayCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+
+		const uint64 EndUsed = FPlatformMemory::GetStats().UsedPhysical - BaselineUsed;
+		const double Seconds = FPlatformTime::ToSeconds64(ReplayCycles);
+
+		printf("Allocator:       %s\n", TCHAR_TO_ANSI(Allocator->GetDescriptiveName()));
+		printf("Operations:      %d (%u skipped)\n", NumOperations, Stream.NumSkipped);
+		printf("Replay time:     %.3f s, %.1f Mops/s, %.1f ns/op\n", Seconds, Seconds > 0.0 ? NumOperations / Seconds / 1e6 : 0.0, NumOperations ? Seconds * 1e9 / NumOperations : 0.0);
+		printf("Peak live:       %.2f MB requested\n", ToMB(Stream.PeakLiveBytes));
+		printf("Peak RSS:        %.2f MB over baseline, %.2f MB requested live at that point\n", ToMB(PeakUsed), ToMB(LiveBytesAtPeak));
+		printf("Fragmentation:   %.1f%% of the peak RSS is not live memory\n", PeakUsed ? 100.0 * (1.0 - double(FMath::Min(LiveBytesAtPeak, PeakUsed)) / double(PeakUsed)) : 0.0);
+		printf("End RSS:         %.2f MB over baseline\n", ToMB(EndUsed));
+
+		printf("\n%-22s %12s %12s %12s %12s %10s\n", "Size class", "Allocs", "Frees", "Peak live", "Avg size", "Slack");
+		for (int32 SizeClassIndex = 0; SizeClassIndex < NumSizeClasses; SizeClassIndex++)
+		{
+			const FSizeClassStats& SizeClass = Stream.SizeClasses[SizeClassIndex];
+			if (!SizeClass.NumAllocs)
+			{
+				continue;
+			}
+
+			// internal fragmentation the allocator reports for a request of the average size of the class
+			const uint64 AverageSize = SizeClass.RequestedBytes / SizeClass.NumAllocs;
+			const SIZE_T Quantized = Allocator->QuantizeSize(AverageSize, DEFAULT_ALIGNMENT);
+			const uint64 MinSize = SizeClassIndex == 0 ? 0 : (1ull << (SizeClassIndex + 3)) + 1;
+			const uint64 MaxSize = 1ull << (SizeClassIndex + 4);
+
+			char Range[32];
+			FCStringAnsi::Sprintf(Range, "%llu-%llu", MinSize, MaxSize);
+			printf("%-22s %12llu %12llu %12lld %12llu %9.1f%%\n", Range, SizeClass.NumAllocs, SizeClass.NumFrees, SizeClass.PeakLive, AverageSize,
+				AverageSize ? 100.0 * double(Quantized - FMath::Min<SIZE_T>(Quantized, AverageSize)) / double(AverageSize) : 0.0);
+		}
+
+		for (void* Ptr : Slots)
+		{
+			Allocator->Free(Ptr);
+		}
+	}
+}
+
+int main(int ArgC, char* ArgV[])
+{
+	using namespace MallocReplay;
+
+	const char* Filename = nullptr;
+	const char* AllocatorName = "binned2";
+	bool bTouchMemory = false;
+	for (int32 Index = 1; Index < ArgC; Index++)
+	{
+		const char AllocatorSwitch[] = "-allocator=";
+		if (FCStringAnsi::Strnicmp(ArgV[Index], AllocatorSwitch, sizeof(AllocatorSwitch) - 1) == 0)
+		{
+			AllocatorName = ArgV[Index] + sizeof(AllocatorSwitch) - 1;
+		}
+		else if (FCStringAnsi::Stricmp(ArgV[Index], "-touch") == 0)
+		{
+			bTouchMemory = true;
+		}
+		else
+		{
+			Filename = ArgV[Index];
+		}
+	}
+
+	if (!Filename)
+	{
+		printf("Usage: MallocReplay <mallocreplay-pid-N.txt> [-allocator=binned2|binned3|mimalloc|tbb|jemalloc|ansi] [-touch]\n");
+		return 1;
+	}
+
+	FMalloc* Allocator = CreateAllocator(AllocatorName);
+	if (!Allocator)
+	{
+		printf("Allocator %s is not available on this platform\n", AllocatorName);
+		return 1;
+	}
+
+	FStream Stream;
+	if (!LoadStream(Filename, Stream))
+	{
+		return 1;
+	}
+
+	Replay(Stream, Allocator, bTouchMemory);
+	return 0;
+}
@@ -148,6 +148,14 @@ public class Core : ModuleRules
         }
         PublicDefinitions.Add("UE_ENABLE_ICU=" + (Target.bCompileICU ? "1" : "0")); // Enable/disable (=1/=0) ICU usage in the codebase. NOTE: This flag is for use while integrating ICU and will be removed afterward.
 
+		// Zstd is a built in compression format when its third party module is available, otherwise NAME_Zstd is looked up in the compression format modules
+		bool bWithZstd = File.Exists(Path.Combine(Target.UEThirdPartySourceDirectory, "zstd", "zstd.Build.cs"));
+		if (bWithZstd)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "zstd");
+		}
+		PublicDefinitions.Add("WITH_ZSTD=" + (bWithZstd ? "1" : "0"));
+
         // If we're compiling with the engine, then add Core's engine dependencies
 		if (Target.bCompileAgainstEngine == true)
 		{
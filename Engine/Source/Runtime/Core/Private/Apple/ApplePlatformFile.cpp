@@ -12,6 +12,8 @@
 #include "Templates/Function.h"
 #include "CoreGlobals.h"
 #include <sys/stat.h>
+#include <sys/clonefile.h>
+#include <sys/time.h>
 
 // make an FTimeSpan object that represents the "epoch" for time_t (from a stat struct)
 const FDateTime MacEpoch(1970, 1, 1);
@@ -690,7 +692,28 @@ bool FApplePlatformFile::IterateDirectoryCommon(const TCHAR* Directory, const TF
 
 bool FApplePlatformFile::CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags, EPlatformFileWrite WriteFlags)
 {
-	bool Result = IPlatformFile::CopyFile(To, From, ReadFlags, WriteFlags);
+	bool Result = false;
+
+	// On APFS a clone shares the blocks of the source until either is modified, so it is instant whatever the size
+	FTCHARToUTF8 FromPath(*NormalizeFilename(From));
+	FTCHARToUTF8 ToPath(*NormalizeFilename(To));
+	struct stat ToInfo;
+	const bool bToExists = stat(ToPath.Get(), &ToInfo) == 0;
+	// clonefile doesn't overwrite, the generic copy does unless the destination is read only
+	if (!bToExists || (S_ISREG(ToInfo.st_mode) && (ToInfo.st_mode & S_IWUSR) && unlink(ToPath.Get()) == 0))
+	{
+		if (clonefile(FromPath.Get(), ToPath.Get(), CLONE_NOFOLLOW | CLONE_NOOWNERCOPY) == 0)
+		{
+			// The clone has the times of the source, a copy is modified now
+			utimes(ToPath.Get(), nullptr);
+			Result = true;
+		}
+	}
+
+	if (!Result)
+	{
+		Result = IPlatformFile::CopyFile(To, From, ReadFlags, WriteFlags);
+	}
 	if (Result)
 	{
 		struct stat FileInfo;
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Async/BudgetedTaskScheduler.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/NumericLimits.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/ScopeLock.h"
+#include "Logging/LogMacros.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+static float GBudgetedTasksFrameBudgetFraction = 0.1f;
+static FAutoConsoleVariableRef CVarBudgetedTasksFrameBudgetFraction(
+	TEXT("BudgetedTasks.FrameBudgetFraction"),
+	GBudgetedTasksFrameBudgetFraction,
+	TEXT("Fraction of the last frame's delta time budgeted tasks may run for in a frame. 0 runs them as soon as possible.")
+);
+
+static float GBudgetedTasksMaxFrameBudgetMs = 4.0f;
+static FAutoConsoleVariableRef CVarBudgetedTasksMaxFrameBudgetMs(
+	TEXT("BudgetedTasks.MaxFrameBudgetMs"),
+	GBudgetedTasksMaxFrameBudgetMs,
+	TEXT("Most milliseconds budgeted tasks may run for in a frame, however long the frame is.")
+);
+
+TRACE_DECLARE_FLOAT_COUNTER(BudgetedTasksBudgetMs, TEXT("BudgetedTasks/BudgetMs"));
+TRACE_DECLARE_FLOAT_COUNTER(BudgetedTasksExecutedMs, TEXT("BudgetedTasks/ExecutedMs"));
+TRACE_DECLARE_INT_COUNTER(BudgetedTasksExecuted, TEXT("BudgetedTasks/Executed"));
+TRACE_DECLARE_INT_COUNTER(BudgetedTasksDeferred, TEXT("BudgetedTasks/Deferred"));
+
+static FDelayedAutoRegisterHelper GBudgetedTaskSchedulerRegister(EDelayedRegisterRunPhase::TaskGraphSystemReady, []()
+{
+	FCoreDelegates::OnBeginFrame.AddLambda([]()
+	{
+		FBudgetedTaskScheduler::Get().BeginFrame();
+	});
+});
+
+FBudgetedTaskScheduler& FBudgetedTaskScheduler::Get()
+{
+	static FBudgetedTaskScheduler Scheduler;
+	return Scheduler;
+}
+
+FBudgetedTaskScheduler::FBudgetedTaskScheduler()
+	: NumQueued(0)
+	, bPumpActive(false)
+	, bFramesTicking(false)
+	, FrameBudgetMs(0.0)
+	, FrameSpentMs(0.0)
+	, FrameNumRuns(0)
+{
+}
+
+void FBudgetedTaskScheduler::Launch(FTaskFunction&& Function, float EstimatedCostMs)
+{
+	FScopeLock ScopeLock(&Lock);
+	Queue.Enqueue(FQueuedTask{ MoveTemp(Function), FMath::Max(EstimatedCostMs, 0.0f) });
+	++NumQueued;
+	ConditionalStartPump();
+}
+
+void FBudgetedTaskScheduler::Flush()
+{
+	for (;;)
+	{
+		FQueuedTask Task;
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (!Queue.Dequeue(Task))
+			{
+				return;
+			}
+			--NumQueued;
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const FBudgetedTaskContext Context(MAX_uint64);
+		while (Task.Function(Context) == EBudgetedTaskResult::Yield)
+		{
+		}
+		const double ElapsedMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		FScopeLock ScopeLock(&Lock);
+		++Stats.NumCompleted;
+		Stats.ExecutedMs += ElapsedMs;
+	}
+}
+
+void FBudgetedTaskScheduler::BeginFrame()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// What happened in the frame that just ended, this only runs on the game thread
+	TRACE_COUNTER_SET(BudgetedTasksBudgetMs, FrameBudgetMs);
+	TRACE_COUNTER_SET(BudgetedTasksExecutedMs, FrameSpentMs);
+	TRACE_COUNTER_SET(BudgetedTasksExecuted, FrameNumRuns);
+	TRACE_COUNTER_SET(BudgetedTasksDeferred, NumQueued);
+	Stats.NumDeferred += NumQueued;
+
+	bFramesTicking = true;
+	FrameBudgetMs = FMath::Min(FApp::GetDeltaTime() * 1000.0 * FMath::Max(GBudgetedTasksFrameBudgetFraction, 0.0f), (double)GBudgetedTasksMaxFrameBudgetMs);
+	FrameSpentMs = 0.0;
+	FrameNumRuns = 0;
+	ConditionalStartPump();
+}
+
+int32 FBudgetedTaskScheduler::GetNumQueued() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumQueued;
+}
+
+FBudgetedTaskScheduler::FStats FBudgetedTaskScheduler::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
+
+double FBudgetedTaskScheduler::GetRemainingBudgetMs() const
+{
+	if (!bFramesTicking || GBudgetedTasksFrameBudgetFraction <= 0.0f)
+	{
+		return TNumericLimits<double>::Max();
+	}
+	return FrameBudgetMs - FrameSpentMs;
+}
+
+void FBudgetedTaskScheduler::ConditionalStartPump()
+{
+	const FQueuedTask* Next = Queue.Peek();
+	if (!bPumpActive && Next && (FrameNumRuns == 0 || Next->EstimatedCostMs <= GetRemainingBudgetMs()))
+	{
+		bPumpActive = true;
+		FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+		{
+			Pump();
+		}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+	}
+}
+
+void FBudgetedTaskScheduler::Pump()
+{
+	for (;;)
+	{
+		FQueuedTask Task;
+		uint64 YieldCycles = MAX_uint64;
+		{
+			FScopeLock ScopeLock(&Lock);
+			const FQueuedTask* Next = Queue.Peek();
+			const double RemainingMs = GetRemainingBudgetMs();
+			if (!Next || (FrameNumRuns > 0 && Next->EstimatedCostMs > RemainingMs))
+			{
+				// The next frame starts another pump if there is work left
+				bPumpActive = false;
+				return;
+			}
+			Queue.Dequeue(Task);
+			--NumQueued;
+			++FrameNumRuns;
+
+			if (RemainingMs < TNumericLimits<double>::Max())
+			{
+				const double SliceMs = FMath::Max(RemainingMs, (double)Task.EstimatedCostMs);
+				YieldCycles = FPlatformTime::Cycles64() + uint64(SliceMs / (FPlatformTime::GetSecondsPerCycle64() * 1000.0));
+			}
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const EBudgetedTaskResult Result = Task.Function(FBudgetedTaskContext(YieldCycles));
+		const double ElapsedMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		FScopeLock ScopeLock(&Lock);
+		FrameSpentMs += ElapsedMs;
+		Stats.ExecutedMs += ElapsedMs;
+		if (Result == EBudgetedTaskResult::Yield)
+		{
+			Queue.Enqueue(MoveTemp(Task));
+			++NumQueued;
+			++Stats.NumYields;
+		}
+		else
+		{
+			++Stats.NumCompleted;
+		}
+	}
+}
+
+static void HandlePrintBudgetedTaskStats(const TArray<FString>& Args)
+{
+	const FBudgetedTaskScheduler::FStats Stats = FBudgetedTaskScheduler::Get().GetStats();
+	UE_LOG(LogConsoleResponse, Display, TEXT("Budgeted tasks: %d queued, %lld completed, %lld yields, %lld deferred, %.2fms executed"),
+		FBudgetedTaskScheduler::Get().GetNumQueued(), Stats.NumCompleted, Stats.NumYields, Stats.NumDeferred, Stats.ExecutedMs);
+}
+
+static FAutoConsoleCommand PrintBudgetedTaskStatsCmd(
+	TEXT("BudgetedTasks.PrintStats"),
+	TEXT("Prints how many budgeted tasks are waiting, how many completed, yielded and were deferred, and how long they ran."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandlePrintBudgetedTaskStats)
+	);
@@ -17,6 +17,7 @@
 #include "Misc/NoopCounter.h"
 #include "Misc/ScopeLock.h"
 #include "Containers/LockFreeList.h"
+#include "Containers/WorkStealingQueue.h"
 #include "Templates/Function.h"
 #include "Stats/Stats.h"
 #include "Misc/CoreStats.h"
@@ -25,11 +26,18 @@
 #include "Misc/App.h"
 #include "Containers/LockFreeFixedSizeAllocator.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Async/ParallelFor.h"
 #include "HAL/LowLevelMemTracker.h"
 #include "HAL/ThreadHeartBeat.h"
 #include "ProfilingDebugging/ExternalProfiler.h"
 #include "ProfilingDebugging/MiscTrace.h"
 #include "ProfilingDebugging/ScopedTimers.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Algo/Reverse.h"
+#include "Algo/Sort.h"
+#include "HAL/LightweightEvent.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTaskGraph, Log, All);
 
@@ -38,6 +46,11 @@ DEFINE_STAT(STAT_FTriggerEventGraphTask);
 DEFINE_STAT(STAT_ParallelFor);
 DEFINE_STAT(STAT_ParallelForTask);
 
+namespace ParallelForImpl
+{
+	CORE_API FThreadSafeCounter GAdaptiveUnclaimedSplits;
+}
+
 static int32 GNumWorkerThreadsToIgnore = 0;
 
 #if PLATFORM_USE_FULL_TASK_GRAPH && !IS_PROGRAM && WITH_ENGINE && !UE_SERVER
@@ -81,6 +94,208 @@ static FAutoConsoleVariableRef CVarEnablePowerSavingThreadPriorityReduction(
 	TEXT("If 1, then high pri thread tasks which are marked EPowerSavingEligibility::Eligible can be dropped to normal priority.")
 );
 
+static int32 GTaskGraphUseWorkStealing = 0;
+static FAutoConsoleVariableRef CVarTaskGraphUseWorkStealing(
+	TEXT("TaskGraph.UseWorkStealing"),
+	GTaskGraphUseWorkStealing,
+	TEXT("If 1, normal task priority tasks spawned from a task thread are queued on that thread's own work stealing deque instead of the shared queue, and idle task threads steal from the other deques of their priority set.")
+);
+
+static int32 GTaskGraphQueueLatencySampleRate = 0;
+static FAutoConsoleVariableRef CVarTaskGraphQueueLatencySampleRate(
+	TEXT("TaskGraph.QueueLatencySampleRate"),
+	GTaskGraphQueueLatencySampleRate,
+	TEXT("If > 0, one in this many tasks queued from each thread records the time between being queued and starting. Samples go to the TaskGraph/QueueLatency trace counters and to TaskGraph.PrintSchedulingStats.")
+);
+
+static int32 GTaskGraphUseLightweightWaits = 1;
+static FAutoConsoleVariableRef CVarTaskGraphUseLightweightWaits(
+	TEXT("TaskGraph.UseLightweightWaits"),
+	GTaskGraphUseLightweightWaits,
+	TEXT("If 1, threads that are not named task graph threads block in WaitUntilTasksComplete on a FLightweightEvent, which parks on its address, instead of a pooled FEvent.")
+);
+
+static int32 GTaskGraphTopologyAwareAffinity = 1;
+static FAutoConsoleVariableRef CVarTaskGraphTopologyAwareAffinity(
+	TEXT("TaskGraph.TopologyAwareAffinity"),
+	GTaskGraphTopologyAwareAffinity,
+	TEXT("How task threads are pinned where the platform does not give them an affinity, read when the task graph starts. 0: not pinned. 1: each thread to one L3 cache domain, filled one physical core per thread at a time. 2: each thread to a single physical core. On hybrid CPUs background priority threads go to the slowest cores first, the others to the fastest."),
+	ECVF_ReadOnly
+);
+
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthNormalPri, TEXT("TaskGraph/QueueDepth/NormalPriThreads"));
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthHighPri, TEXT("TaskGraph/QueueDepth/HighPriThreads"));
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthBackgroundPri, TEXT("TaskGraph/QueueDepth/BackgroundPriThreads"));
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthGameThread, TEXT("TaskGraph/QueueDepth/GameThread"));
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthRenderingThread, TEXT("TaskGraph/QueueDepth/RenderingThread"));
+TRACE_DECLARE_INT_COUNTER(TaskGraphQueueDepthOtherNamedThreads, TEXT("TaskGraph/QueueDepth/OtherNamedThreads"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyNormalPri, TEXT("TaskGraph/QueueLatency/NormalPriThreads (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyHighPri, TEXT("TaskGraph/QueueLatency/HighPriThreads (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyBackgroundPri, TEXT("TaskGraph/QueueLatency/BackgroundPriThreads (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyGameThread, TEXT("TaskGraph/QueueLatency/GameThread (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyRenderingThread, TEXT("TaskGraph/QueueLatency/RenderingThread (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(TaskGraphQueueLatencyOtherNamedThreads, TEXT("TaskGraph/QueueLatency/OtherNamedThreads (ms)"));
+
+namespace UE4TaskGraph_Private
+{
+	/** The queues scheduling statistics are kept for. The any thread queues are in thread priority index order. **/
+	enum class ETaskQueue : uint8
+	{
+		NormalPriThreads,
+		HighPriThreads,
+		BackgroundPriThreads,
+		GameThread,
+		RenderingThread,
+		OtherNamedThreads,
+		Count
+	};
+
+	static const TCHAR* GetTaskQueueName(ETaskQueue Queue)
+	{
+		switch (Queue)
+		{
+		case ETaskQueue::NormalPriThreads: return TEXT("NormalPriThreads");
+		case ETaskQueue::HighPriThreads: return TEXT("HighPriThreads");
+		case ETaskQueue::BackgroundPriThreads: return TEXT("BackgroundPriThreads");
+		case ETaskQueue::GameThread: return TEXT("GameThread");
+		case ETaskQueue::RenderingThread: return TEXT("RenderingThread");
+		default: return TEXT("OtherNamedThreads");
+		}
+	}
+
+	static ETaskQueue GetAnyThreadTaskQueue(int32 PriorityIndex)
+	{
+		check(PriorityIndex >= 0 && PriorityIndex < ENamedThreads::NumThreadPriorities);
+		return (ETaskQueue)PriorityIndex;
+	}
+
+	static ETaskQueue GetNamedThreadTaskQueue(ENamedThreads::Type ThreadIndex)
+	{
+		return ThreadIndex == ENamedThreads::GameThread ? ETaskQueue::GameThread : ThreadIndex == ENamedThreads::ActualRenderingThread ? ETaskQueue::RenderingThread : ETaskQueue::OtherNamedThreads;
+	}
+
+	/** Always on counters of one queue, each on its own cache line since every task of the queue touches them **/
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FTaskQueueStats
+	{
+		/** Tasks queued and not started yet **/
+		FThreadSafeCounter Depth;
+		/** Sampled latencies, see TaskGraph.QueueLatencySampleRate **/
+		FThreadSafeCounter64 NumLatencySamples;
+		FThreadSafeCounter64 TotalLatencyCycles;
+		TAtomic<uint64> MaxLatencyCycles;
+
+		FTaskQueueStats()
+			: MaxLatencyCycles(0)
+		{
+		}
+	};
+
+	static FTaskQueueStats GTaskQueueStats[(int32)ETaskQueue::Count];
+
+	static void TraceQueueDepth(ETaskQueue Queue, int32 Depth)
+	{
+		switch (Queue)
+		{
+		case ETaskQueue::NormalPriThreads: TRACE_COUNTER_SET(TaskGraphQueueDepthNormalPri, Depth); break;
+		case ETaskQueue::HighPriThreads: TRACE_COUNTER_SET(TaskGraphQueueDepthHighPri, Depth); break;
+		case ETaskQueue::BackgroundPriThreads: TRACE_COUNTER_SET(TaskGraphQueueDepthBackgroundPri, Depth); break;
+		case ETaskQueue::GameThread: TRACE_COUNTER_SET(TaskGraphQueueDepthGameThread, Depth); break;
+		case ETaskQueue::RenderingThread: TRACE_COUNTER_SET(TaskGraphQueueDepthRenderingThread, Depth); break;
+		default: TRACE_COUNTER_SET(TaskGraphQueueDepthOtherNamedThreads, Depth); break;
+		}
+	}
+
+	static void TraceQueueLatency(ETaskQueue Queue, double LatencyMs)
+	{
+		switch (Queue)
+		{
+		case ETaskQueue::NormalPriThreads: TRACE_COUNTER_SET(TaskGraphQueueLatencyNormalPri, LatencyMs); break;
+		case ETaskQueue::HighPriThreads: TRACE_COUNTER_SET(TaskGraphQueueLatencyHighPri, LatencyMs); break;
+		case ETaskQueue::BackgroundPriThreads: TRACE_COUNTER_SET(TaskGraphQueueLatencyBackgroundPri, LatencyMs); break;
+		case ETaskQueue::GameThread: TRACE_COUNTER_SET(TaskGraphQueueLatencyGameThread, LatencyMs); break;
+		case ETaskQueue::RenderingThread: TRACE_COUNTER_SET(TaskGraphQueueLatencyRenderingThread, LatencyMs); break;
+		default: TRACE_COUNTER_SET(TaskGraphQueueLatencyOtherNamedThreads, LatencyMs); break;
+		}
+	}
+
+	/** Called right before a task is pushed to Queue **/
+	static void OnTaskQueued(ETaskQueue Queue)
+	{
+		const int32 Depth = GTaskQueueStats[(int32)Queue].Depth.Increment();
+		TraceQueueDepth(Queue, Depth);
+	}
+
+	/** Called when a task was taken from Queue, with the cycles it waited for if it was sampled **/
+	static void OnTaskDequeued(ETaskQueue Queue, uint64 QueuedCycles)
+	{
+		FTaskQueueStats& Stats = GTaskQueueStats[(int32)Queue];
+		const int32 Depth = Stats.Depth.Decrement();
+		TraceQueueDepth(Queue, Depth);
+		if (QueuedCycles)
+		{
+			const uint64 LatencyCycles = FPlatformTime::Cycles64() - QueuedCycles;
+			Stats.NumLatencySamples.Increment();
+			Stats.TotalLatencyCycles.Add((int64)LatencyCycles);
+			uint64 MaxLatencyCycles = Stats.MaxLatencyCycles.Load(EMemoryOrder::Relaxed);
+			while (LatencyCycles > MaxLatencyCycles && !Stats.MaxLatencyCycles.CompareExchange(MaxLatencyCycles, LatencyCycles))
+			{
+			}
+			TraceQueueLatency(Queue, FPlatformTime::ToMilliseconds64(LatencyCycles));
+		}
+	}
+
+	/** @return the time to store in a task being queued from this thread, which is 0 unless its latency should be sampled **/
+	static uint64 SampleQueuedCycles()
+	{
+		static thread_local int32 NumTasksSinceSample = 0;
+		const int32 SampleRate = GTaskGraphQueueLatencySampleRate;
+		if (SampleRate > 0 && ++NumTasksSinceSample >= SampleRate)
+		{
+			NumTasksSinceSample = 0;
+			return FPlatformTime::Cycles64();
+		}
+		return 0;
+	}
+
+	/**
+	 *	Finds the affinity for a task thread from the CPU topology, see TaskGraph.TopologyAwareAffinity.
+	 *	@param	PriorityIndex; thread priority set of the thread
+	 *	@param	IndexInSet; index of the thread in its priority set
+	 *	@return	the affinity, or 0 to keep the one the platform gives
+	**/
+	static uint64 GetTopologyAwareAffinity(int32 PriorityIndex, int32 IndexInSet)
+	{
+		const FCPUTopology& Topology = FPlatformMisc::GetCPUTopology();
+		if (!GTaskGraphTopologyAwareAffinity || Topology.NumCores < 2)
+		{
+			return 0;
+		}
+
+		// Threads take one core each before any core gets a second, faster cores first and cores sharing an L3 next to each other
+		const bool bSlowCoresFirst = PriorityIndex == 2 && Topology.IsHybrid();
+		int32 CoreOrder[FCPUTopology::MaxCores];
+		for (int32 Index = 0; Index < Topology.NumCores; ++Index)
+		{
+			CoreOrder[Index] = Index;
+		}
+		Algo::Sort(TArrayView<int32>(CoreOrder, Topology.NumCores), [&Topology, bSlowCoresFirst](int32 A, int32 B)
+		{
+			if (Topology.CorePerformanceClasses[A] != Topology.CorePerformanceClasses[B])
+			{
+				return (Topology.CorePerformanceClasses[A] > Topology.CorePerformanceClasses[B]) != bSlowCoresFirst;
+			}
+			if (Topology.CoreCacheDomains[A] != Topology.CoreCacheDomains[B])
+			{
+				return Topology.CoreCacheDomains[A] < Topology.CoreCacheDomains[B];
+			}
+			return A < B;
+		});
+
+		const int32 Core = CoreOrder[IndexInSet % Topology.NumCores];
+		return GTaskGraphTopologyAwareAffinity == 2 ? Topology.CoreMasks[Core] : Topology.CacheDomainMasks[Topology.CoreCacheDomains[Core]];
+	}
+}
+
 #if CREATE_HIPRI_TASK_THREADS || CREATE_BACKGROUND_TASK_THREADS
 	static void ThreadSwitchForABTest(const TArray<FString>& Args)
 	{
@@ -408,6 +623,9 @@ public:
 		: ThreadId(ENamedThreads::AnyThread)
 		, PerThreadIDTLSSlot(0xffffffff)
 		, OwnerWorker(nullptr)
+		, BusyCycles(0)
+		, StallCycles(0)
+		, NumProcessedTasks(0)
 	{
 		NewTasks.Reset(128);
 	}
@@ -492,6 +710,17 @@ public:
 	 **/
 	virtual bool IsProcessingTasks(int32 QueueIndex) = 0;
 
+	/** 
+	 *	Returns the totals since startup of the time this thread spent processing tasks and stalled waiting for them. Only a snapshot if this is not the current thread.
+	 *	Named threads are neither while they are outside of the task graph.
+	 **/
+	void GetActivity(uint64& OutBusyCycles, uint64& OutStallCycles, uint64& OutNumProcessedTasks) const
+	{
+		OutBusyCycles = BusyCycles.Load(EMemoryOrder::Relaxed);
+		OutStallCycles = StallCycles.Load(EMemoryOrder::Relaxed);
+		OutNumProcessedTasks = NumProcessedTasks.Load(EMemoryOrder::Relaxed);
+	}
+
 	// SingleThreaded API
 
 	/** Tick single-threaded. */
@@ -555,6 +784,22 @@ public:
 
 protected:
 
+	/** Adds the time since ActivityStartCycles to the busy or stall time of this thread and restarts it. Called from this thread only. **/
+	void AccountActivity(uint64& ActivityStartCycles, bool bWasStalled)
+	{
+		const uint64 Cycles = FPlatformTime::Cycles64();
+		TAtomic<uint64>& Counter = bWasStalled ? StallCycles : BusyCycles;
+		Counter.Store(Counter.Load(EMemoryOrder::Relaxed) + (Cycles - ActivityStartCycles), EMemoryOrder::Relaxed);
+		ActivityStartCycles = Cycles;
+	}
+
+	/** Counts a task taken from a queue for execution. Called from this thread only, before the task executes. **/
+	void OnTaskDequeued(UE4TaskGraph_Private::ETaskQueue TaskQueue, FBaseGraphTask* Task)
+	{
+		UE4TaskGraph_Private::OnTaskDequeued(TaskQueue, Task->QueuedCycles);
+		NumProcessedTasks.Store(NumProcessedTasks.Load(EMemoryOrder::Relaxed) + 1, EMemoryOrder::Relaxed);
+	}
+
 	/** Id / Index of this thread. **/
 	ENamedThreads::Type									ThreadId;
 	/** TLS SLot that we store the FTaskThread* this pointer in. **/
@@ -565,6 +810,10 @@ protected:
 	TArray<FBaseGraphTask*> NewTasks;
 	/** back pointer to the owning FWorkerThread **/
 	FWorkerThread* OwnerWorker;
+	/** Activity of this thread for TaskGraph.PrintSchedulingStats, only this thread writes them. **/
+	TAtomic<uint64> BusyCycles;
+	TAtomic<uint64> StallCycles;
+	TAtomic<uint64> NumProcessedTasks;
 };
 
 /** 
@@ -649,6 +898,7 @@ public:
 			ProcessingTasks.Start(StatName);
 		}
 #endif
+		uint64 ActivityStartCycles = FPlatformTime::Cycles64();
 		while (!Queue(QueueIndex).QuitForReturn)
 		{
 			FBaseGraphTask* Task = Queue(QueueIndex).StallQueue.Pop(0, bAllowStall);
@@ -665,8 +915,11 @@ public:
 				if (bAllowStall)
 				{
 					{
+						TRACE_CPUPROFILER_EVENT_SCOPE(TaskGraphStall);
 						FScopeCycleCounter Scope(StallStatId);
+						AccountActivity(ActivityStartCycles, false);
 						Queue(QueueIndex).StallRestartEvent->Wait(MAX_uint32, bCountAsStall);
+						AccountActivity(ActivityStartCycles, true);
 						if (Queue(QueueIndex).QuitForShutdown)
 						{
 							return ProcessedTasks;
@@ -689,11 +942,13 @@ public:
 			}
 			else
 			{
+				OnTaskDequeued(UE4TaskGraph_Private::GetNamedThreadTaskQueue(ThreadId), Task);
 				Task->Execute(NewTasks, ENamedThreads::Type(ThreadId | (QueueIndex << ENamedThreads::QueueIndexShift)));
 				ProcessedTasks++;
 				TestRandomizedThreads();
 			}
 		}
+		AccountActivity(ActivityStartCycles, false);
 #if STATS
 		if (bTasksOpen)
 		{
@@ -992,6 +1247,7 @@ private:
 #endif
 		verify(++Queue.RecursionGuard == 1);
 		bool bDidStall = false;
+		uint64 ActivityStartCycles = FPlatformTime::Cycles64();
 		while (1)
 		{
 			FBaseGraphTask* Task = FindWork();
@@ -1008,8 +1264,11 @@ private:
 				TestRandomizedThreads();
 				if (FPlatformProcess::SupportsMultithreading())
 				{
+					TRACE_CPUPROFILER_EVENT_SCOPE(TaskGraphStall);
 					FScopeCycleCounter Scope(StallStatId);
+					AccountActivity(ActivityStartCycles, false);
 					Queue.StallRestartEvent->Wait(MAX_uint32, bCountAsStall);
+					AccountActivity(ActivityStartCycles, true);
 					bDidStall = true;
 				}
 				if (Queue.QuitForShutdown || !FPlatformProcess::SupportsMultithreading())
@@ -1036,6 +1295,7 @@ private:
 			}
 #endif
 			bDidStall = false;
+			OnTaskDequeued(UE4TaskGraph_Private::GetAnyThreadTaskQueue(PriorityIndex), Task);
 			Task->Execute(NewTasks, ENamedThreads::Type(ThreadId));
 			ProcessedTasks++;
 			TestRandomizedThreads();
@@ -1049,8 +1309,10 @@ private:
 				}
 #endif
 				{
+					AccountActivity(ActivityStartCycles, false);
 					FScopeLock Lock(&Queue.StallForTuning);
 				}
+				AccountActivity(ActivityStartCycles, true);
 #if STATS
 				if (FThreadStats::IsCollectingData(StatName))
 				{
@@ -1060,6 +1322,7 @@ private:
 #endif
 			}
 		}
+		AccountActivity(ActivityStartCycles, false);
 		verify(!--Queue.RecursionGuard);
 		return ProcessedTasks;
 	}
@@ -1102,6 +1365,11 @@ private:
 	FThreadTaskQueue Queue;
 
 	int32 PriorityIndex;
+
+public:
+
+	/** Tasks spawned from this thread when TaskGraph.UseWorkStealing is enabled. Only this thread pushes and pops, other task threads of the same priority set steal. **/
+	TWorkStealingQueue<FBaseGraphTask> LocalQueue;
 };
 
 
@@ -1127,6 +1395,36 @@ struct FWorkerThread
 	}
 };
 
+/** FTriggerEventGraphTask for the FLightweightEvent a thread waits on in WaitUntilTasksComplete */
+class FTriggerLightweightEventGraphTask
+{
+public:
+	FTriggerLightweightEventGraphTask(FLightweightEvent& InEvent)
+		: Event(InEvent)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		return GET_STATID(STAT_FTriggerEventGraphTask);
+	}
+
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyHiPriThreadHiPriTask;
+	}
+
+	static ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::FireAndForget; }
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Event.Trigger();
+	}
+
+private:
+	FLightweightEvent& Event;
+};
+
 /**
 *	FTaskGraphImplementation
 *	Implementation of the centralized part of the task graph system.
@@ -1255,6 +1553,26 @@ public:
 				Name = FString::Printf(TEXT("TaskGraphThreadNP %d"), ThreadIndex - (LastExternalThread + 1));
 				ThreadPri = TPri_BelowNormal; // we want normal tasks below normal threads like the game thread
 			}
+			if (Affinity == 0xFFFFFFFFFFFFFFFF)
+			{
+				const uint64 TopologyAffinity = UE4TaskGraph_Private::GetTopologyAwareAffinity(Priority, (ThreadIndex - NumNamedThreads) % NumTaskThreadsPerSet);
+				if (TopologyAffinity)
+				{
+					Affinity = TopologyAffinity;
+				}
+			}
+#if UE_NUMA_AWARE_ALLOCATION
+			// spread the workers over the NUMA nodes so that each one allocates from, and works on, memory local to its node
+			if (FPlatformMemory::GetNumaNodeCount() > 1)
+			{
+				const int32 NumaNode = (ThreadIndex - (LastExternalThread + 1)) % FPlatformMemory::GetNumaNodeCount();
+				const uint64 NodeAffinity = Affinity & FPlatformMemory::GetNumaNodeProcessorMask(NumaNode);
+				if (NodeAffinity)
+				{
+					Affinity = NodeAffinity;
+				}
+			}
+#endif
 #if WITH_EDITOR
 			uint32 StackSize = 1024 * 1024;
 #elif ( UE_BUILD_SHIPPING || UE_BUILD_TEST )
@@ -1312,25 +1630,20 @@ public:
 	{
 		TASKGRAPH_SCOPE_CYCLE_COUNTER(2, STAT_TaskGraph_QueueTask);
 
+		Task->QueuedCycles = UE4TaskGraph_Private::SampleQueuedCycles();
 		if (ENamedThreads::GetThreadIndex(ThreadToExecuteOn) == ENamedThreads::AnyThread)
 		{
 			TASKGRAPH_SCOPE_CYCLE_COUNTER(3, STAT_TaskGraph_QueueTask_AnyThread);
 			if (FPlatformProcess::SupportsMultithreading())
 			{
-				uint32 TaskPriority = ENamedThreads::GetTaskPriority(Task->ThreadToExecuteOn);
-				int32 Priority = ENamedThreads::GetThreadPriorityIndex(Task->ThreadToExecuteOn);
-				if (Priority == (ENamedThreads::BackgroundThreadPriority >> ENamedThreads::ThreadPriorityShift) && (!bCreatedBackgroundPriorityThreads || !ENamedThreads::bHasBackgroundThreads))
+				int32 Priority;
+				uint32 PriIndex;
+				GetAnyThreadQueue(Task, Priority, PriIndex);
+				UE4TaskGraph_Private::OnTaskQueued(UE4TaskGraph_Private::GetAnyThreadTaskQueue(Priority));
+				if (GTaskGraphUseWorkStealing && PriIndex && QueueToLocalWorker(Task, Priority))
 				{
-					Priority = ENamedThreads::NormalThreadPriority >> ENamedThreads::ThreadPriorityShift; // we don't have background threads, promote to normal
-					TaskPriority = ENamedThreads::NormalTaskPriority >> ENamedThreads::TaskPriorityShift; // demote to normal task pri
-				}
-				else if (Priority == (ENamedThreads::HighThreadPriority >> ENamedThreads::ThreadPriorityShift) && (!bCreatedHiPriorityThreads || !ENamedThreads::bHasHighPriorityThreads))
-				{
-					Priority = ENamedThreads::NormalThreadPriority >> ENamedThreads::ThreadPriorityShift; // we don't have hi priority threads, demote to normal
-					TaskPriority = ENamedThreads::HighTaskPriority >> ENamedThreads::TaskPriorityShift; // promote to hi task pri
+					return;
 				}
-				uint32 PriIndex = TaskPriority ? 0 : 1;
-				check(Priority >= 0 && Priority < MAX_THREAD_PRIORITIES);
 				{
 					TASKGRAPH_SCOPE_CYCLE_COUNTER(4, STAT_TaskGraph_QueueTask_IncomingAnyThreadTasks_Push);
 					int32 IndexToStart = IncomingAnyThreadTasks[Priority].Push(Task, PriIndex);
@@ -1360,6 +1673,7 @@ public:
 			int32 QueueToExecuteOn = ENamedThreads::GetQueueIndex(ThreadToExecuteOn);
 			ThreadToExecuteOn = ENamedThreads::GetThreadIndex(ThreadToExecuteOn);
 			FTaskThreadBase* Target = &Thread(ThreadToExecuteOn);
+			UE4TaskGraph_Private::OnTaskQueued(UE4TaskGraph_Private::GetNamedThreadTaskQueue(ThreadToExecuteOn));
 			if (ThreadToExecuteOn == ENamedThreads::GetThreadIndex(CurrentThreadIfKnown))
 			{
 				Target->EnqueueFromThisThread(QueueToExecuteOn, Task);
@@ -1372,6 +1686,46 @@ public:
 	}
 
 
+	virtual void QueueTasks(TArrayView<FBaseGraphTask* const> Tasks, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread) final override
+	{
+		TASKGRAPH_SCOPE_CYCLE_COUNTER(2, STAT_TaskGraph_QueueTask);
+
+		if (!FPlatformProcess::SupportsMultithreading())
+		{
+			for (FBaseGraphTask* Task : Tasks)
+			{
+				QueueTask(Task, Task->ThreadToExecuteOn, CurrentThreadIfKnown);
+			}
+			return;
+		}
+
+		// The threads are woken once everything is queued, so the first one to wake does not compete with the rest of the pushes.
+		// The batch does not go to the local deque even with work stealing on, the point of queueing many tasks at once is that many threads pick them up.
+		TArray<TPair<int32, int32>, TInlineAllocator<16>> ThreadsToStart;
+		for (FBaseGraphTask* Task : Tasks)
+		{
+			if (ENamedThreads::GetThreadIndex(Task->ThreadToExecuteOn) != ENamedThreads::AnyThread)
+			{
+				QueueTask(Task, Task->ThreadToExecuteOn, CurrentThreadIfKnown);
+				continue;
+			}
+			Task->QueuedCycles = UE4TaskGraph_Private::SampleQueuedCycles();
+			int32 Priority;
+			uint32 PriIndex;
+			GetAnyThreadQueue(Task, Priority, PriIndex);
+			UE4TaskGraph_Private::OnTaskQueued(UE4TaskGraph_Private::GetAnyThreadTaskQueue(Priority));
+			int32 IndexToStart = IncomingAnyThreadTasks[Priority].Push(Task, PriIndex);
+			if (IndexToStart >= 0)
+			{
+				ThreadsToStart.Emplace(Priority, IndexToStart);
+			}
+		}
+		for (const TPair<int32, int32>& ThreadToStart : ThreadsToStart)
+		{
+			StartTaskThread(ThreadToStart.Key, ThreadToStart.Value);
+		}
+	}
+
 	virtual	int32 GetNumWorkerThreads() final override
 	{
 		int32 Result = (NumThreads - NumNamedThreads) / NumTaskThreadSets - GNumWorkerThreadsToIgnore;
@@ -1495,6 +1849,14 @@ public:
 				}
 				UE_LOG(LogTaskGraph, Fatal, TEXT("Recursive waits are not allowed in single threaded mode."));
 			}
+			if (GTaskGraphUseLightweightWaits)
+			{
+				// We will just stall this thread on its own address while we wait, no event object needed
+				FLightweightEvent Event;
+				TGraphTask<FTriggerLightweightEventGraphTask>::CreateTask(&Tasks, CurrentThreadIfKnown).ConstructAndDispatchWhenReady(Event);
+				Event.Wait();
+				return;
+			}
 			// We will just stall this thread on an event while we wait
 			FScopedEvent Event;
 			TriggerEventWhenTasksComplete(Event.Get(), Tasks, CurrentThreadIfKnown);
@@ -1534,6 +1896,31 @@ public:
 
 	// Scheduling utilities
 
+	/** 
+	 *	Finds the shared queue of an any thread task, tasks for thread priorities that were not created run on the normal priority threads.
+	 *	@param	Task; the task to queue
+	 *	@param	OutPriority; thread priority index of the queue
+	 *	@param	OutPriIndex; index of the priority within the queue, 0 for high priority tasks
+	**/
+	void GetAnyThreadQueue(FBaseGraphTask* Task, int32& OutPriority, uint32& OutPriIndex)
+	{
+		uint32 TaskPriority = ENamedThreads::GetTaskPriority(Task->ThreadToExecuteOn);
+		int32 Priority = ENamedThreads::GetThreadPriorityIndex(Task->ThreadToExecuteOn);
+		if (Priority == (ENamedThreads::BackgroundThreadPriority >> ENamedThreads::ThreadPriorityShift) && (!bCreatedBackgroundPriorityThreads || !ENamedThreads::bHasBackgroundThreads))
+		{
+			Priority = ENamedThreads::NormalThreadPriority >> ENamedThreads::ThreadPriorityShift; // we don't have background threads, promote to normal
+			TaskPriority = ENamedThreads::NormalTaskPriority >> ENamedThreads::TaskPriorityShift; // demote to normal task pri
+		}
+		else if (Priority == (ENamedThreads::HighThreadPriority >> ENamedThreads::ThreadPriorityShift) && (!bCreatedHiPriorityThreads || !ENamedThreads::bHasHighPriorityThreads))
+		{
+			Priority = ENamedThreads::NormalThreadPriority >> ENamedThreads::ThreadPriorityShift; // we don't have hi priority threads, demote to normal
+			TaskPriority = ENamedThreads::HighTaskPriority >> ENamedThreads::TaskPriorityShift; // promote to hi task pri
+		}
+		check(Priority >= 0 && Priority < MAX_THREAD_PRIORITIES);
+		OutPriority = Priority;
+		OutPriIndex = TaskPriority ? 0 : 1;
+	}
+
 	void StartTaskThread(int32 Priority, int32 IndexToStart)
 	{
 		ENamedThreads::Type ThreadToWake = ENamedThreads::Type(IndexToStart + Priority * NumTaskThreadsPerSet + NumNamedThreads);
@@ -1565,7 +1952,79 @@ public:
 			MyIndex < (PLATFORM_64BITS ? 63 : 32) &&
 			Priority >= 0 && Priority < ENamedThreads::NumThreadPriorities);
 
-		return IncomingAnyThreadTasks[Priority].Pop(MyIndex, true);
+		// Our own deque is checked even when work stealing is off, so nothing is stranded if the cvar is toggled at runtime
+		FTaskThreadAnyThread& Me = (FTaskThreadAnyThread&)Thread(ThreadInNeed);
+		if (!Me.LocalQueue.IsEmpty())
+		{
+			if (FBaseGraphTask* Task = Me.LocalQueue.Pop())
+			{
+				return Task;
+			}
+		}
+
+		return IncomingAnyThreadTasks[Priority].PopOrSteal(MyIndex, true,
+			[this, MyIndex, Priority]() -> FBaseGraphTask*
+			{
+				return StealWork(MyIndex, Priority);
+			});
+	}
+
+	/**
+	 *	Queues a task on the deque of the current thread if it is a task thread of the given priority set.
+	 *	@param	Task; the task to queue
+	 *	@param	Priority; thread priority index the task should run at
+	 *	@return	true if the task was queued, false if the caller should use the shared queue.
+	**/
+	bool QueueToLocalWorker(FBaseGraphTask* Task, int32 Priority)
+	{
+		FWorkerThread* TLSPointer = (FWorkerThread*)FPlatformTLS::GetTlsValue(PerThreadIDTLSSlot);
+		if (!TLSPointer)
+		{
+			return false;
+		}
+		int32 ThreadIndex = UE_PTRDIFF_TO_INT32(TLSPointer - WorkerThreads);
+		if (ThreadIndex < NumNamedThreads || ThreadIndexToPriorityIndex(ThreadIndex) != Priority)
+		{
+			return false;
+		}
+		FTaskThreadAnyThread& Me = (FTaskThreadAnyThread&)Thread(ThreadIndex);
+		{
+			TASKGRAPH_SCOPE_CYCLE_COUNTER(5, STAT_TaskGraph_QueueTask_LocalQueue_Push);
+			if (!Me.LocalQueue.Push(Task))
+			{
+				return false; // full, overflow to the shared queue
+			}
+		}
+		// let a stalled thread know there is something to steal, this also keeps a thread that is about to stall from missing it
+		int32 IndexToStart = IncomingAnyThreadTasks[Priority].Signal();
+		if (IndexToStart >= 0)
+		{
+			StartTaskThread(Priority, IndexToStart);
+		}
+		return true;
+	}
+
+	/**
+	 *	Attempts to steal a task from the deques of the other task threads in a priority set.
+	 *	@param	MyIndex; index of the thief within its priority set
+	 *	@param	Priority; priority set to steal from
+	 *	@return	Stolen task or nullptr if all the deques were empty.
+	**/
+	FBaseGraphTask* StealWork(int32 MyIndex, int32 Priority)
+	{
+		const int32 FirstThread = Priority * NumTaskThreadsPerSet + NumNamedThreads;
+		for (int32 Offset = 1; Offset < NumTaskThreadsPerSet; Offset++)
+		{
+			FTaskThreadAnyThread& Victim = (FTaskThreadAnyThread&)Thread(FirstThread + (MyIndex + Offset) % NumTaskThreadsPerSet);
+			if (!Victim.LocalQueue.IsEmpty())
+			{
+				if (FBaseGraphTask* Task = Victim.LocalQueue.Steal())
+				{
+					return Task;
+				}
+			}
+		}
+		return nullptr;
 	}
 
 	void StallForTuning(int32 Index, bool Stall)
@@ -1588,6 +2047,48 @@ public:
 		}
 	}
 
+	/** Logs how busy each thread was and the statistics of each queue since the previous call, or since startup for the first one **/
+	void PrintSchedulingStats()
+	{
+		using namespace UE4TaskGraph_Private;
+
+		const uint64 Cycles = FPlatformTime::Cycles64();
+		const double ElapsedMs = FPlatformTime::ToMilliseconds64(Cycles - LastSchedulingStats.Cycles);
+		const double Percent = 100.0 / FMath::Max(ElapsedMs, 1e-3);
+		UE_LOG(LogTaskGraph, Display, TEXT("Task graph scheduling over the last %.1fms, busy and stalled are in percent of that time:"), ElapsedMs);
+
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+		{
+			FThreadActivity Activity;
+			Thread(ThreadIndex).GetActivity(Activity.BusyCycles, Activity.StallCycles, Activity.NumProcessedTasks);
+			FThreadActivity& Previous = LastSchedulingStats.Threads[ThreadIndex];
+			const TCHAR* QueueName = GetTaskQueueName(ThreadIndex < NumNamedThreads ? GetNamedThreadTaskQueue((ENamedThreads::Type)ThreadIndex) : GetAnyThreadTaskQueue(ThreadIndexToPriorityIndex(ThreadIndex)));
+			UE_LOG(LogTaskGraph, Display, TEXT("  Thread %2d %-20s %8llu tasks, %5.1f busy, %5.1f stalled"), ThreadIndex, QueueName,
+				Activity.NumProcessedTasks - Previous.NumProcessedTasks,
+				FPlatformTime::ToMilliseconds64(Activity.BusyCycles - Previous.BusyCycles) * Percent,
+				FPlatformTime::ToMilliseconds64(Activity.StallCycles - Previous.StallCycles) * Percent);
+			Previous = Activity;
+		}
+
+		for (int32 QueueIndex = 0; QueueIndex < (int32)ETaskQueue::Count; QueueIndex++)
+		{
+			FTaskQueueStats& Stats = GTaskQueueStats[QueueIndex];
+			const int64 NumLatencySamples = Stats.NumLatencySamples.GetValue();
+			const int64 TotalLatencyCycles = Stats.TotalLatencyCycles.GetValue();
+			FQueueLatency& Previous = LastSchedulingStats.Queues[QueueIndex];
+			const int64 NewSamples = NumLatencySamples - Previous.NumSamples;
+			const double AverageMs = NewSamples ? FPlatformTime::ToMilliseconds64(TotalLatencyCycles - Previous.TotalCycles) / NewSamples : 0.0;
+			// The maximum is since startup, resetting it here would race with the threads updating it
+			UE_LOG(LogTaskGraph, Display, TEXT("  Queue %-20s depth %5d, %6lld latency samples, average %.3fms, max %.3fms"), GetTaskQueueName((ETaskQueue)QueueIndex),
+				Stats.Depth.GetValue(), NewSamples, AverageMs, FPlatformTime::ToMilliseconds64(Stats.MaxLatencyCycles.Load(EMemoryOrder::Relaxed)));
+			Previous.NumSamples = NumLatencySamples;
+			Previous.TotalCycles = TotalLatencyCycles;
+		}
+		UE_CLOG(GTaskGraphQueueLatencySampleRate <= 0, LogTaskGraph, Display, TEXT("  Latency sampling is off, set TaskGraph.QueueLatencySampleRate to enable it."));
+
+		LastSchedulingStats.Cycles = Cycles;
+	}
+
 private:
 
 	// Internals
@@ -1673,6 +2174,26 @@ private:
 	TArray<TFunction<void()> > ShutdownCallbacks;
 
 	FStallingTaskQueue<FBaseGraphTask, PLATFORM_CACHE_LINE_SIZE, 2>	IncomingAnyThreadTasks[MAX_THREAD_PRIORITIES];
+
+	struct FThreadActivity
+	{
+		uint64 BusyCycles = 0;
+		uint64 StallCycles = 0;
+		uint64 NumProcessedTasks = 0;
+	};
+	struct FQueueLatency
+	{
+		int64 NumSamples = 0;
+		int64 TotalCycles = 0;
+	};
+	/** What PrintSchedulingStats printed last, so it can print the differences. **/
+	struct FSchedulingStats
+	{
+		uint64 Cycles = FPlatformTime::Cycles64();
+		FThreadActivity Threads[MAX_THREADS];
+		FQueueLatency Queues[(int32)UE4TaskGraph_Private::ETaskQueue::Count];
+	};
+	FSchedulingStats LastSchedulingStats;
 };
 
 
@@ -1718,6 +2239,35 @@ FBaseGraphTask::TSmallTaskAllocator& FBaseGraphTask::GetSmallTaskAllocator()
 	return TheSmallTaskAllocator;
 }
 
+static FBaseGraphTask::TMediumTaskAllocator TheMediumTaskAllocator;
+FBaseGraphTask::TMediumTaskAllocator& FBaseGraphTask::GetMediumTaskAllocator()
+{
+	return TheMediumTaskAllocator;
+}
+
+static FBaseGraphTask::TLargeTaskAllocator TheLargeTaskAllocator;
+FBaseGraphTask::TLargeTaskAllocator& FBaseGraphTask::GetLargeTaskAllocator()
+{
+	return TheLargeTaskAllocator;
+}
+
+TRACE_DECLARE_INT_COUNTER(TaskGraphHeapAllocatedTasks, TEXT("TaskGraph/HeapAllocatedTasks"));
+TRACE_DECLARE_MEMORY_COUNTER(TaskGraphHeapAllocatedTaskMemory, TEXT("TaskGraph/HeapAllocatedTaskMemory"));
+static FThreadSafeCounter GNumHeapAllocatedTasks;
+static FThreadSafeCounter64 GHeapAllocatedTaskMemory;
+
+void FBaseGraphTask::OnHeapTaskAllocated(SIZE_T TaskSize)
+{
+	TRACE_COUNTER_SET(TaskGraphHeapAllocatedTasks, GNumHeapAllocatedTasks.Increment());
+	TRACE_COUNTER_SET(TaskGraphHeapAllocatedTaskMemory, GHeapAllocatedTaskMemory.Add((int64)TaskSize) + (int64)TaskSize);
+}
+
+void FBaseGraphTask::OnHeapTaskFreed(SIZE_T TaskSize)
+{
+	TRACE_COUNTER_SET(TaskGraphHeapAllocatedTasks, GNumHeapAllocatedTasks.Decrement());
+	TRACE_COUNTER_SET(TaskGraphHeapAllocatedTaskMemory, GHeapAllocatedTaskMemory.Subtract((int64)TaskSize) - (int64)TaskSize);
+}
+
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 void FBaseGraphTask::LogPossiblyInvalidSubsequentsTask(const TCHAR* TaskName)
 {
@@ -1778,12 +2328,8 @@ void FGraphEvent::DispatchSubsequents(TArray<FBaseGraphTask*>& NewTasks, ENamedT
 	}
 
 	SubsequentList.PopAllAndClose(NewTasks);
-	for (int32 Index = NewTasks.Num() - 1; Index >= 0 ; Index--) // reverse the order since PopAll is implicitly backwards
-	{
-		FBaseGraphTask* NewTask = NewTasks[Index];
-		checkThreadGraph(NewTask);
-		NewTask->ConditionalQueueTask(CurrentThreadIfKnown);
-	}
+	Algo::Reverse(NewTasks); // reverse the order since PopAll is implicitly backwards
+	FBaseGraphTask::ConditionalQueueTasks(NewTasks, CurrentThreadIfKnown);
 	NewTasks.Reset();
 }
 
@@ -2081,6 +2627,20 @@ static FAutoConsoleCommand CVarNumWorkerThreadsToIgnore(
 	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleNumWorkerThreadsToIgnore)
 	);
 
+static void HandlePrintSchedulingStats(const TArray<FString>& Args)
+{
+	if (FTaskGraphInterface::IsRunning())
+	{
+		FTaskGraphImplementation::Get().PrintSchedulingStats();
+	}
+}
+
+static FAutoConsoleCommand CVarPrintSchedulingStats(
+	TEXT("TaskGraph.PrintSchedulingStats"),
+	TEXT("Prints how busy each task graph thread was, the depth of every queue and the sampled queue latencies since the last time this was printed. See TaskGraph.QueueLatencySampleRate."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandlePrintSchedulingStats)
+	);
+
 // Benchmark
 
 #include "Async/ParallelFor.h"
@@ -2191,11 +2751,12 @@ private:
 };
 
 
-void PrintResult(double& StartTime, double& QueueTime, double& EndTime, double& JoinTime, FThreadSafeCounter& Counter, FThreadSafeCounter& Cycles, const TCHAR* Message)
+void PrintResult(double& StartTime, double& QueueTime, double& EndTime, double& JoinTime, FThreadSafeCounter& Counter, FThreadSafeCounter& Cycles, const TCHAR* Message, int32 NumTasks = 1000)
 {
-	UE_LOG(LogConsoleResponse, Display, TEXT("Total %6.3fms   %6.3fms queue   %6.3fms join   %6.3fms wait   %6.3fms work   : %s")
+	UE_LOG(LogConsoleResponse, Display, TEXT("Total %6.3fms   %6.3fms queue   %6.3fms join   %6.3fms wait   %6.3fms work   %8.3f Mtasks/s   : %s")
 		, float(1000.0 * (EndTime-StartTime)), float(1000.0 * (QueueTime-StartTime)), float(1000.0 * (JoinTime-QueueTime)), float(1000.0 * (EndTime-JoinTime))
 		, float(FPlatformTime::GetSecondsPerCycle() * double(Cycles.GetValue()) * 1000.0)
+		, EndTime > StartTime ? float(double(NumTasks) / (EndTime - StartTime) / 1000000.0) : 0.0f
 		, Message
 		);
 
@@ -2207,21 +2768,12 @@ void PrintResult(double& StartTime, double& QueueTime, double& EndTime, double&
 	JoinTime = 0.0;
 }
 
-static void TaskGraphBenchmark(const TArray<FString>& Args)
+static void TaskGraphBenchmarkPass(const TArray<FString>& Args)
 {
-	FSlowHeartBeatScope SuspendHeartBeat;
-	TGuardValue<int32> ReentrantGuard(GPrintBroadcastWarnings, 0);
-
 	double StartTime, QueueTime, EndTime, JoinTime;
 	FThreadSafeCounter Counter;
 	FThreadSafeCounter Cycles;
 
-	if (!FPlatformProcess::SupportsMultithreading())
-	{
-		UE_LOG(LogConsoleResponse, Display, TEXT("WARNING: TaskGraphBenchmark disabled for non multi-threading platforms"));
-		return;
-	}
-
 	if (Args.Num() == 1 && Args[0] == TEXT("infinite"))
 	{
 		while (true)
@@ -2342,6 +2894,32 @@ static void TaskGraphBenchmark(const TArray<FString>& Args)
 		EndTime = FPlatformTime::Seconds();
 	}
 	PrintResult(StartTime, QueueTime, EndTime, JoinTime, Counter, Cycles, TEXT("1000 tasks, ParallelFor start, batched completion 100x10"));
+	{
+		StartTime = FPlatformTime::Seconds();
+		FGraphEventArray Tasks;
+		Tasks.AddZeroed(10);
+
+		ParallelFor(10, 
+			[&Tasks, &Counter, &Cycles](int32 Index)
+		{
+			FGraphEventArray InnerTasks;
+			InnerTasks.AddZeroed(1000);
+			ENamedThreads::Type CurrentThread = FTaskGraphInterface::Get().GetCurrentThreadIfKnown();
+			for (int32 InnerIndex = 0; InnerIndex < 1000; InnerIndex++)
+			{
+				InnerTasks[InnerIndex] = TGraphTask<FIncGraphTaskSub>::CreateTask(nullptr, CurrentThread).ConstructAndDispatchWhenReady(Counter, Cycles, 100);
+			}
+			// join the above tasks
+			Tasks[Index] = TGraphTask<FNullGraphTask>::CreateTask(&InnerTasks, CurrentThread).ConstructAndDispatchWhenReady(TStatId(), ENamedThreads::AnyThread);
+		}
+		);
+		QueueTime = FPlatformTime::Seconds();
+		FGraphEventRef Join = TGraphTask<FNullGraphTask>::CreateTask(&Tasks, ENamedThreads::GameThread).ConstructAndDispatchWhenReady(TStatId(), ENamedThreads::AnyThread);
+		JoinTime = FPlatformTime::Seconds();
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Join, ENamedThreads::GameThread_Local);
+		EndTime = FPlatformTime::Seconds();
+	}
+	PrintResult(StartTime, QueueTime, EndTime, JoinTime, Counter, Cycles, TEXT("10000 tasks, ParallelFor start, worker fan-out 10x1000, with work"), 10000);
 
 	{
 		StartTime = FPlatformTime::Seconds();
@@ -2480,12 +3058,90 @@ static void TaskGraphBenchmark(const TArray<FString>& Args)
 	PrintResult(StartTime, QueueTime, EndTime, JoinTime, Counter, Cycles, TEXT("1000 element ParallelFor, single threaded, with work"));
 }
 
+static void TaskGraphBenchmark(const TArray<FString>& Args)
+{
+	FSlowHeartBeatScope SuspendHeartBeat;
+	TGuardValue<int32> ReentrantGuard(GPrintBroadcastWarnings, 0);
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		UE_LOG(LogConsoleResponse, Display, TEXT("WARNING: TaskGraphBenchmark disabled for non multi-threading platforms"));
+		return;
+	}
+
+	if (Args.Num() == 1 && Args[0] == TEXT("both"))
+	{
+		// run the whole suite once per scheduling mode so the numbers can be compared side by side
+		for (int32 UseWorkStealing = 0; UseWorkStealing < 2; UseWorkStealing++)
+		{
+			TGuardValue<int32> WorkStealingGuard(GTaskGraphUseWorkStealing, UseWorkStealing);
+			UE_LOG(LogConsoleResponse, Display, TEXT("---- Scheduling mode: %s ----"), UseWorkStealing ? TEXT("work stealing") : TEXT("shared queue"));
+			TaskGraphBenchmarkPass(TArray<FString>());
+		}
+		return;
+	}
+
+	UE_LOG(LogConsoleResponse, Display, TEXT("---- Scheduling mode: %s ----"), GTaskGraphUseWorkStealing ? TEXT("work stealing") : TEXT("shared queue"));
+	TaskGraphBenchmarkPass(Args);
+}
+
 static FAutoConsoleCommand TaskGraphBenchmarkCmd(
 	TEXT("TaskGraph.Benchmark"),
-	TEXT("Prints the time to run 1000 no-op tasks."),
+	TEXT("Prints the time to run 1000 no-op tasks. Pass 'both' to run once with the shared queue and once with TaskGraph.UseWorkStealing."),
 	FConsoleCommandWithArgsDelegate::CreateStatic(&TaskGraphBenchmark)
 	);
 
+/** Times from a task triggering an event to the parked waiter running again, for one kind of event */
+template<typename EventType>
+static void WakeLatencyBenchmarkPass(EventType& Event, const TCHAR* Name, int32 NumWakes)
+{
+	uint64 TotalCycles = 0;
+	uint64 MaxCycles = 0;
+	for (int32 Index = 0; Index < NumWakes; ++Index)
+	{
+		volatile uint64 TriggerCycles = 0;
+		FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&Event, &TriggerCycles]()
+		{
+			// Give the waiter time to park, this measures waking it rather than it spinning into the trigger
+			FPlatformProcess::SleepNoStats(0.0002f);
+			TriggerCycles = FPlatformTime::Cycles64();
+			Event.Trigger();
+		}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadHiPriTask);
+		Event.Wait();
+		const uint64 Cycles = FPlatformTime::Cycles64() - TriggerCycles;
+		TotalCycles += Cycles;
+		MaxCycles = FMath::Max(MaxCycles, Cycles);
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+		Event.Reset();
+	}
+	UE_LOG(LogConsoleResponse, Display, TEXT("%-20s %d wakes, average %7.2fus, max %7.2fus"), Name, NumWakes,
+		FPlatformTime::ToMilliseconds64(TotalCycles) * 1000.0 / NumWakes, FPlatformTime::ToMilliseconds64(MaxCycles) * 1000.0);
+}
+
+static void TaskGraphWakeLatencyBenchmark(const TArray<FString>& Args)
+{
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		UE_LOG(LogConsoleResponse, Display, TEXT("WARNING: TaskGraph.WakeLatencyBenchmark disabled for non multi-threading platforms"));
+		return;
+	}
+	FSlowHeartBeatScope SuspendHeartBeat;
+	const int32 NumWakes = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+	FEvent* PooledEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	WakeLatencyBenchmarkPass(*PooledEvent, TEXT("FEvent"), NumWakes);
+	FPlatformProcess::ReturnSynchEventToPool(PooledEvent);
+
+	FLightweightEvent LightweightEvent;
+	WakeLatencyBenchmarkPass(LightweightEvent, TEXT("FLightweightEvent"), NumWakes);
+}
+
+static FAutoConsoleCommand TaskGraphWakeLatencyBenchmarkCmd(
+	TEXT("TaskGraph.WakeLatencyBenchmark"),
+	TEXT("Prints the time it takes a thread parked on a FEvent and on a FLightweightEvent to run again after a task triggered it. Optional argument: the number of wakes, 1000 by default."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&TaskGraphWakeLatencyBenchmark)
+	);
+
 
 struct FTestStruct
 {
@@ -2536,7 +3192,8 @@ static void TestLockFree(int32 OuterIters = 3)
 
 	FScopedDurationTimeLogger DurationLogger(TEXT("TestLockFree Runtime"));
 	const uint32 NumWorkersForTest = static_cast<uint32>(FMath::Clamp(NumWorkers, MinWorkersForTest, MaxWorkersForTest));
-	auto RunWorkersSynchronous = [NumWorkersForTest](const TFunction<void(uint32)>& WorkerTask)
+	// Returns how long the workers took, which benchmarks the lists as well as testing them
+	auto RunWorkersSynchronous = [NumWorkersForTest](const TFunction<void(uint32)>& WorkerTask) -> double
 	{
 		const bool bIsManualReset = true;
 		FEvent* AllDoneEvent = FPlatformProcess::GetSynchEventFromPool(bIsManualReset);
@@ -2552,6 +3209,13 @@ static void TestLockFree(int32 OuterIters = 3)
 		}
 		AllDoneEvent->Wait();
 		FPlatformProcess::ReturnSynchEventToPool(AllDoneEvent);
+		return FPlatformTime::Seconds() - StartTime;
+	};
+	const int32 NumOpsPerWorker = 1000000;
+	auto LogThroughput = [NumWorkersForTest, NumOpsPerWorker](const TCHAR* ListName, double Seconds)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s: %u workers x %d operations in %.3fs, %.2f M operations/s with %s links"), ListName, NumWorkersForTest, NumOpsPerWorker, Seconds,
+			double(NumWorkersForTest) * NumOpsPerWorker / FMath::Max(Seconds, 1e-9) / 1e6, LOCK_FREE_LINKS_USE_128BIT_ATOMICS ? TEXT("128 bit pointer") : TEXT("indexed"));
 	};
 
 	for (int32 Iter = 0; Iter < OuterIters; Iter++)
@@ -2564,10 +3228,10 @@ static void TestLockFree(int32 OuterIters = 3)
 				Rig.Test1.Push(new FTestStruct(Index));
 			}
 			TFunction<void(uint32)> Broadcast =
-				[&Rig](uint32 WorkerIndex)
+				[&Rig, NumOpsPerWorker](uint32 WorkerIndex)
 			{
 				FRandomStream Stream(((int32)WorkerIndex) * 7 + 13);
-				for (int32 Index = 0; Index < 1000000; Index++)
+				for (int32 Index = 0; Index < NumOpsPerWorker; Index++)
 				{
 					if (Index % 200000 == 1)
 					{
@@ -2645,7 +3309,7 @@ static void TestLockFree(int32 OuterIters = 3)
 					}
 				}
 			};
-			RunWorkersSynchronous(Broadcast);
+			LogThroughput(TEXT("FLockFreePointerFIFOBase"), RunWorkersSynchronous(Broadcast));
 
 			TArray<FTestStruct*> Items;
 			Rig.Test1.PopAll(Items);
@@ -2683,10 +3347,10 @@ static void TestLockFree(int32 OuterIters = 3)
 				Rig.Test1.Push(new FTestStruct(Index));
 			}
 			TFunction<void(uint32)> Broadcast =
-				[&Rig](uint32 WorkerIndex)
+				[&Rig, NumOpsPerWorker](uint32 WorkerIndex)
 			{
 				FRandomStream Stream(((int32)WorkerIndex) * 7 + 13);
-				for (int32 Index = 0; Index < 1000000; Index++)
+				for (int32 Index = 0; Index < NumOpsPerWorker; Index++)
 				{
 					if (Index % 200000 == 1)
 					{
@@ -2764,7 +3428,7 @@ static void TestLockFree(int32 OuterIters = 3)
 					}
 				}
 			};
-			RunWorkersSynchronous(Broadcast);
+			LogThroughput(TEXT("FLockFreePointerListLIFOBase"), RunWorkersSynchronous(Broadcast));
 
 			TArray<FTestStruct*> Items;
 			Rig.Test1.PopAll(Items);
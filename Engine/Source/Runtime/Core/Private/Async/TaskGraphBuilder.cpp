@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Async/TaskGraphBuilder.h"
+#include "Containers/ArrayView.h"
+#include "HAL/PlatformAtomics.h"
+
+namespace UE4TaskGraphBuilder_Private
+{
+	/** What the nodes of a dispatched graph share, deleted by the last node to finish */
+	class FGraphState
+	{
+	public:
+
+		TStatId StatId;
+		TArray<TUniqueFunction<void()>> Functions;
+		TArray<ENamedThreads::Type> DesiredThreads;
+		/** The successors of node N are Successors[SuccessorOffsets[N]] up to Successors[SuccessorOffsets[N + 1]] */
+		TArray<int32> SuccessorOffsets;
+		TArray<int32> Successors;
+		/** Counted down atomically as the predecessors finish */
+		TArray<int32> NumPredecessorsLeft;
+		FThreadSafeCounter NumNodesLeft;
+		FGraphEventRef CompletionEvent;
+
+		/** Creates the tasks of nodes that have no predecessors left and queues them in one go */
+		void QueueNodes(TArrayView<const int32> ReadyNodes, ENamedThreads::Type CurrentThread);
+
+		void ExecuteNode(int32 NodeIndex, ENamedThreads::Type CurrentThread);
+	};
+
+	class FNodeTask
+	{
+	public:
+
+		FNodeTask(FGraphState* InState, int32 InNodeIndex)
+			: State(InState)
+			, NodeIndex(InNodeIndex)
+		{
+		}
+
+		TStatId GetStatId() const
+		{
+			return State->StatId;
+		}
+
+		static ESubsequentsMode::Type GetSubsequentsMode()
+		{
+			return ESubsequentsMode::FireAndForget;
+		}
+
+		ENamedThreads::Type GetDesiredThread()
+		{
+			return State->DesiredThreads[NodeIndex];
+		}
+
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			State->ExecuteNode(NodeIndex, CurrentThread);
+		}
+
+	private:
+
+		FGraphState* State;
+		int32 NodeIndex;
+	};
+
+	void FGraphState::QueueNodes(TArrayView<const int32> ReadyNodes, ENamedThreads::Type CurrentThread)
+	{
+		TArray<FBaseGraphTask*, TInlineAllocator<16>> Tasks;
+		Tasks.Reserve(ReadyNodes.Num());
+		for (int32 NodeIndex : ReadyNodes)
+		{
+			Tasks.Add(TGraphTask<FNodeTask>::CreateTask(nullptr, CurrentThread).ConstructAndHold(this, NodeIndex));
+		}
+		// Each held task waits for one unlock, which is what this gives them
+		FBaseGraphTask::ConditionalQueueTasks(Tasks, CurrentThread);
+	}
+
+	void FGraphState::ExecuteNode(int32 NodeIndex, ENamedThreads::Type CurrentThread)
+	{
+		Functions[NodeIndex]();
+
+		TArray<int32, TInlineAllocator<16>> ReadyNodes;
+		for (int32 Index = SuccessorOffsets[NodeIndex]; Index < SuccessorOffsets[NodeIndex + 1]; ++Index)
+		{
+			const int32 Successor = Successors[Index];
+			if (FPlatformAtomics::InterlockedDecrement(&NumPredecessorsLeft[Successor]) == 0)
+			{
+				ReadyNodes.Add(Successor);
+			}
+		}
+		if (ReadyNodes.Num())
+		{
+			QueueNodes(ReadyNodes, CurrentThread);
+		}
+
+		// Nothing may touch the state after this unless this was the last node
+		if (NumNodesLeft.Decrement() == 0)
+		{
+			FGraphEventRef Event = MoveTemp(CompletionEvent);
+			delete this;
+			TArray<FBaseGraphTask*> NewTasks;
+			Event->DispatchSubsequents(NewTasks, CurrentThread);
+		}
+	}
+}
+
+FGraphEventRef FTaskGraphBuilder::Dispatch(const FGraphEventArray* Prerequisites, ENamedThreads::Type CurrentThreadIfKnown)
+{
+	using namespace UE4TaskGraphBuilder_Private;
+
+	const int32 NumNodes = Nodes.Num();
+	if (NumNodes == 0)
+	{
+		check(Edges.Num() == 0);
+		if (Prerequisites && Prerequisites->Num())
+		{
+			return TGraphTask<FNullGraphTask>::CreateTask(Prerequisites, CurrentThreadIfKnown).ConstructAndDispatchWhenReady(StatId, ENamedThreads::AnyHiPriThreadHiPriTask);
+		}
+		FGraphEventRef CompletionEvent = FGraphEvent::CreateGraphEvent();
+		TArray<FBaseGraphTask*> NewTasks;
+		CompletionEvent->DispatchSubsequents(NewTasks, CurrentThreadIfKnown);
+		return CompletionEvent;
+	}
+
+	FGraphState* State = new FGraphState;
+	State->StatId = StatId;
+	State->CompletionEvent = FGraphEvent::CreateGraphEvent();
+	State->NumNodesLeft.Set(NumNodes);
+	State->Functions.Reserve(NumNodes);
+	State->DesiredThreads.Reserve(NumNodes);
+	for (FNode& Node : Nodes)
+	{
+		State->Functions.Add(MoveTemp(Node.Function));
+		State->DesiredThreads.Add(Node.DesiredThread);
+	}
+
+	// Counting sort of the edges by the node they start from, which also counts the predecessors
+	State->SuccessorOffsets.SetNumZeroed(NumNodes + 1);
+	State->NumPredecessorsLeft.SetNumZeroed(NumNodes);
+	for (const FEdge& Edge : Edges)
+	{
+		++State->SuccessorOffsets[Edge.Before + 1];
+		++State->NumPredecessorsLeft[Edge.After];
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		State->SuccessorOffsets[NodeIndex + 1] += State->SuccessorOffsets[NodeIndex];
+	}
+	TArray<int32> NextSuccessor(State->SuccessorOffsets.GetData(), NumNodes);
+	State->Successors.SetNumUninitialized(Edges.Num());
+	for (const FEdge& Edge : Edges)
+	{
+		State->Successors[NextSuccessor[Edge.Before]++] = Edge.After;
+	}
+
+	TArray<int32> RootNodes;
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		if (State->NumPredecessorsLeft[NodeIndex] == 0)
+		{
+			RootNodes.Add(NodeIndex);
+		}
+	}
+
+#if DO_CHECK
+	{
+		// A cycle would never finish, visit the nodes in dependency order to make sure all of them are reached
+		TArray<int32> NumPredecessors = State->NumPredecessorsLeft;
+		TArray<int32> Visit = RootNodes;
+		for (int32 VisitIndex = 0; VisitIndex < Visit.Num(); ++VisitIndex)
+		{
+			const int32 NodeIndex = Visit[VisitIndex];
+			for (int32 Index = State->SuccessorOffsets[NodeIndex]; Index < State->SuccessorOffsets[NodeIndex + 1]; ++Index)
+			{
+				if (--NumPredecessors[State->Successors[Index]] == 0)
+				{
+					Visit.Add(State->Successors[Index]);
+				}
+			}
+		}
+		checkf(Visit.Num() == NumNodes, TEXT("Task graph has a cycle, only %d of its %d nodes can run"), Visit.Num(), NumNodes);
+	}
+#endif
+
+	Nodes.Reset();
+	Edges.Reset();
+
+	FGraphEventRef CompletionEvent = State->CompletionEvent;
+	if (Prerequisites && Prerequisites->Num())
+	{
+		FFunctionGraphTask::CreateAndDispatchWhenReady([State, RootNodes = MoveTemp(RootNodes)]()
+		{
+			State->QueueNodes(RootNodes, ENamedThreads::AnyThread);
+		}, StatId, Prerequisites, ENamedThreads::AnyHiPriThreadHiPriTask);
+	}
+	else
+	{
+		State->QueueNodes(RootNodes, CurrentThreadIfKnown);
+	}
+	return CompletionEvent;
+}
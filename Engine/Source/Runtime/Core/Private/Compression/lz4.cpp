@@ -369,7 +369,7 @@ static const int      dec64table[8] = {0, 0, 0, -1, -4,  1, 2, 3};
 
 
 #ifndef LZ4_FAST_DEC_LOOP
-#  if defined(__i386__) || defined(__x86_64__)
+#  if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)   /* UE: MSVC too, as upstream does since v1.9.3 */
 #    define LZ4_FAST_DEC_LOOP 1
 #  elif defined(__aarch64__) && !defined(__clang__)
      /* On aarch64, we disable this optimization for clang because on certain
@@ -417,12 +417,62 @@ LZ4_wildCopy32(void* dstPtr, const void* srcPtr, void* dstEnd)
     do { memcpy(d,s,16); memcpy(d+16,s+16,16); d+=32; s+=32; } while (d<e);
 }
 
+/* UE: matches closer than 16 bytes are expanded into whole periods of the match with one byte shuffle, then stored
+ * 16 bytes at a time, stepping by a multiple of the offset so every store repeats the same pattern. */
+#if LZ4_FAST_DEC_LOOP && PLATFORM_ENABLE_VECTORINTRINSICS && (PLATFORM_ALWAYS_HAS_SSE4_1 || defined(__SSSE3__))
+#  include <tmmintrin.h>
+#  define LZ4_SHUFFLE_MATCH_COPY 1
+#elif LZ4_FAST_DEC_LOOP && PLATFORM_ENABLE_VECTORINTRINSICS_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+#  include <arm_neon.h>
+#  define LZ4_SHUFFLE_MATCH_COPY 2
+#else
+#  define LZ4_SHUFFLE_MATCH_COPY 0
+#endif
+
+#if LZ4_SHUFFLE_MATCH_COPY
+static const BYTE LZ4_shuffleMasks[16][16] = {
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1 },
+    {  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0 },
+    {  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0 },
+    {  0,  1,  2,  3,  4,  5,  0,  1,  2,  3,  4,  5,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  5,  6,  0,  1,  2,  3,  4,  5,  6,  0,  1 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  0,  1,  2,  3,  4,  5,  6,  7 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  0,  1,  2,  3,  4,  5,  6 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  1,  2,  3,  4,  5 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10,  0,  1,  2,  3,  4 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,  0,  1,  2 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,  0,  1 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  0 }
+};
+static const BYTE LZ4_shuffleSteps[16] = { 16, 16, 16, 15, 16, 15, 12, 14, 16, 9, 10, 11, 12, 13, 14, 15 };
+#endif
+
 /* LZ4_memcpy_using_offset()  presumes :
  * - dstEnd >= dstPtr + MINMATCH
- * - there is at least 8 bytes available to write after dstEnd */
+ * - there is at least 8 bytes available to write after dstEnd
+ *   (UE: 16 bytes with LZ4_SHUFFLE_MATCH_COPY, which the fast loop's FASTLOOP_SAFE_DISTANCE margin covers) */
 LZ4_FORCE_O2_INLINE_GCC_PPC64LE void
 LZ4_memcpy_using_offset(BYTE* dstPtr, const BYTE* srcPtr, BYTE* dstEnd, const size_t offset)
 {
+#if LZ4_SHUFFLE_MATCH_COPY
+    size_t const step = LZ4_shuffleSteps[offset];
+    assert(offset < 16);
+    assert(dstEnd >= dstPtr + MINMATCH);
+    /* the bytes read past dstPtr are not written yet, the masks only pick the first 'offset' ones */
+#  if LZ4_SHUFFLE_MATCH_COPY == 1
+    {   __m128i const pattern = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)srcPtr), _mm_loadu_si128((const __m128i*)LZ4_shuffleMasks[offset]));
+        do { _mm_storeu_si128((__m128i*)dstPtr, pattern); dstPtr += step; } while (dstPtr < dstEnd);
+    }
+#  else
+    {   uint8x16_t const pattern = vqtbl1q_u8(vld1q_u8(srcPtr), vld1q_u8(LZ4_shuffleMasks[offset]));
+        do { vst1q_u8(dstPtr, pattern); dstPtr += step; } while (dstPtr < dstEnd);
+    }
+#  endif
+#else
     BYTE v[8];
 
     assert(dstEnd >= dstPtr + MINMATCH);
@@ -452,6 +502,7 @@ LZ4_memcpy_using_offset(BYTE* dstPtr, const BYTE* srcPtr, BYTE* dstEnd, const si
         memcpy(dstPtr, v, 8);
         dstPtr += 8;
     }
+#endif /* LZ4_SHUFFLE_MATCH_COPY */
 }
 #endif
 
@@ -2090,6 +2141,127 @@ int LZ4_decompress_safe_partial(const char* src, char* dst, int compressedSize,
                                   noDict, (BYTE*)dst, NULL, 0);
 }
 
+/*===== UE: decoding several independent blocks at once =====*/
+
+#if LZ4_FAST_DEC_LOOP
+/* Decodes one sequence of a block with the fast loop's rules, advancing *ipPtr and *opPtr.
+ * Returns 0, leaving them as they were, when the sequence needs the regular decoder's checks:
+ * near the end of either buffer, at an invalid offset or on malformed input. */
+LZ4_FORCE_INLINE int
+LZ4_decodeSequence_fast(const BYTE** ipPtr, BYTE** opPtr, const BYTE* const iend, BYTE* const oend, const BYTE* const lowPrefix)
+{
+    const BYTE* ip = *ipPtr;
+    BYTE* op = *opPtr;
+    const BYTE* match;
+    BYTE* cpy;
+    size_t offset;
+    unsigned token;
+    size_t length;
+
+    if ((oend - op) < FASTLOOP_SAFE_DISTANCE || ip >= iend) { return 0; }
+
+    token = *ip++;
+    length = token >> ML_BITS;  /* literal length */
+    if (length == RUN_MASK) {
+        variable_length_error error = lz4ok;
+        length += read_variable_length(&ip, iend-RUN_MASK, 1, 1, &error);
+        if (error != lz4ok) { return 0; }
+        if (unlikely((uptrval)(op)+length<(uptrval)(op))) { return 0; }
+        if (unlikely((uptrval)(ip)+length<(uptrval)(ip))) { return 0; }
+        cpy = op+length;
+        if ((cpy>oend-32) || (ip+length>iend-32)) { return 0; }
+        LZ4_wildCopy32(op, ip, cpy);
+        ip += length; op = cpy;
+    } else {
+        if (ip > iend-(16 + 1/*max lit + offset + nextToken*/)) { return 0; }
+        memcpy(op, ip, 16);
+        ip += length; op += length;
+    }
+
+    offset = LZ4_readLE16(ip); ip+=2;
+    match = op - offset;
+
+    length = token & ML_MASK;
+    if (length == ML_MASK) {
+        variable_length_error error = lz4ok;
+        if (unlikely(match < lowPrefix)) { return 0; }
+        length += read_variable_length(&ip, iend - LASTLITERALS + 1, 1, 0, &error);
+        if (error != lz4ok) { return 0; }
+        if (unlikely((uptrval)(op)+length<(uptrval)op)) { return 0; }
+        length += MINMATCH;
+        if (op + length >= oend - FASTLOOP_SAFE_DISTANCE) { return 0; }
+    } else {
+        length += MINMATCH;
+        if (op + length >= oend - FASTLOOP_SAFE_DISTANCE) { return 0; }
+        if ((match >= lowPrefix) && (offset >= 8)) {
+            memcpy(op, match, 8);
+            memcpy(op+8, match+8, 8);
+            memcpy(op+16, match+16, 2);
+            *ipPtr = ip;
+            *opPtr = op + length;
+            return 1;
+    }   }
+
+    if (unlikely(match < lowPrefix)) { return 0; }
+    cpy = op + length;
+    if (unlikely(offset<16)) {
+        LZ4_memcpy_using_offset(op, match, cpy, offset);
+    } else {
+        LZ4_wildCopy32(op, match, cpy);
+    }
+    *ipPtr = ip;
+    *opPtr = cpy;
+    return 1;
+}
+
+/* Decodes the rest of a block from a sequence boundary, the part already decoded being the prefix of the remainder */
+static int LZ4_decompress_safe_remainder(const char* src, char* dst, int srcSize, int dstCapacity, const BYTE* ip, BYTE* op)
+{
+    int const decoded = (int)((char*)op - dst);
+    int const result = LZ4_decompress_safe_usingDict((const char*)ip, (char*)op, srcSize - (int)((const char*)ip - src), dstCapacity - decoded, dst, decoded);
+    /* errors report the input position from the start of the block, as LZ4_decompress_safe() does */
+    return result < 0 ? result - (int)((const char*)ip - src) : decoded + result;
+}
+#endif
+
+LZ4_FORCE_O2_GCC_PPC64LE
+int LZ4_decompress_safe_multi(int numBlocks, const char* const* srcs, char* const* dsts, const int* srcSizes, const int* dstCapacities, int* results)
+{
+    int numFailed = 0;
+    int i = 0;
+#if LZ4_FAST_DEC_LOOP
+    /* Two blocks at a time: each iteration decodes a sequence of both, so the loads of one overlap the copies of the other */
+    for (; i + 1 < numBlocks; i += 2) {
+        const BYTE* ip0 = (const BYTE*)srcs[i];
+        const BYTE* ip1 = (const BYTE*)srcs[i+1];
+        BYTE* op0 = (BYTE*)dsts[i];
+        BYTE* op1 = (BYTE*)dsts[i+1];
+        const BYTE* const iend0 = ip0 + (srcSizes[i] > 0 ? srcSizes[i] : 0);
+        const BYTE* const iend1 = ip1 + (srcSizes[i+1] > 0 ? srcSizes[i+1] : 0);
+        BYTE* const oend0 = op0 + (dstCapacities[i] > 0 ? dstCapacities[i] : 0);
+        BYTE* const oend1 = op1 + (dstCapacities[i+1] > 0 ? dstCapacities[i+1] : 0);
+        int more0 = srcSizes[i] > 0 && dstCapacities[i] > 0;
+        int more1 = srcSizes[i+1] > 0 && dstCapacities[i+1] > 0;
+
+        while (more0 & more1) {
+            more0 = LZ4_decodeSequence_fast(&ip0, &op0, iend0, oend0, (const BYTE*)dsts[i]);
+            more1 = LZ4_decodeSequence_fast(&ip1, &op1, iend1, oend1, (const BYTE*)dsts[i+1]);
+        }
+        while (more0) { more0 = LZ4_decodeSequence_fast(&ip0, &op0, iend0, oend0, (const BYTE*)dsts[i]); }
+        while (more1) { more1 = LZ4_decodeSequence_fast(&ip1, &op1, iend1, oend1, (const BYTE*)dsts[i+1]); }
+
+        results[i] = LZ4_decompress_safe_remainder(srcs[i], dsts[i], srcSizes[i], dstCapacities[i], ip0, op0);
+        results[i+1] = LZ4_decompress_safe_remainder(srcs[i+1], dsts[i+1], srcSizes[i+1], dstCapacities[i+1], ip1, op1);
+        numFailed += (results[i] < 0) + (results[i+1] < 0);
+    }
+#endif
+    for (; i < numBlocks; i++) {
+        results[i] = LZ4_decompress_safe(srcs[i], dsts[i], srcSizes[i], dstCapacities[i]);
+        numFailed += results[i] < 0;
+    }
+    return numFailed;
+}
+
 LZ4_FORCE_O2_GCC_PPC64LE
 int LZ4_decompress_fast(const char* source, char* dest, int originalSize)
 {
@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/SharedSnapshot.h"
+#include "Containers/Array.h"
+#include "HAL/ThreadSingleton.h"
+#include "Misc/AssertionMacros.h"
+#include <atomic>
+
+namespace UE4SharedSnapshot_Private
+{
+	enum
+	{
+		/** Threads beyond this many readers count themselves in OverflowReaders instead */
+		NumReaderSlots = 1024
+	};
+
+	/** Epoch of a reading thread, alone on its cache line so that readers never write to lines that others write */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FReaderSlot
+	{
+		/** Epoch the outermost read of the owning thread started in, 0 while not reading */
+		volatile int64 Epoch;
+
+		/** Whether a thread owns the slot */
+		volatile int32 bClaimed;
+	};
+
+	struct FRetiredObject
+	{
+		void* Object;
+		void (*Deleter)(void*);
+
+		/** Reads that started in this epoch or earlier may still use the object */
+		int64 Epoch;
+	};
+
+	/** Starts at 1 so that 0 can mean not reading */
+	static volatile int64 GlobalEpoch = 1;
+	static volatile int32 OverflowReaders = 0;
+	static FReaderSlot ReaderSlots[NumReaderSlots];
+
+	static FCriticalSection& GetRetiredCritical()
+	{
+		static FCriticalSection RetiredCritical;
+		return RetiredCritical;
+	}
+
+	static TArray<FRetiredObject>& GetRetiredObjects()
+	{
+		static TArray<FRetiredObject> RetiredObjects;
+		return RetiredObjects;
+	}
+
+	/** Orders the store of a reader's epoch before its loads of the value, and a writer's exchange before its loads of the epochs */
+	static FORCEINLINE void StoreLoadFence()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	/** Read state of a thread, which claims a slot on its first read and gives it back when it exits */
+	class FReaderState : public TThreadSingleton<FReaderState>
+	{
+		friend TThreadSingleton<FReaderState>;
+
+		FReaderState()
+			: SlotIndex(INDEX_NONE)
+			, NumNestedReads(0)
+		{
+			for (int32 Index = 0; Index < NumReaderSlots; ++Index)
+			{
+				if (!FPlatformAtomics::AtomicRead_Relaxed(&ReaderSlots[Index].bClaimed) && FPlatformAtomics::InterlockedCompareExchange(&ReaderSlots[Index].bClaimed, 1, 0) == 0)
+				{
+					SlotIndex = Index;
+					break;
+				}
+			}
+		}
+
+		virtual ~FReaderState()
+		{
+			if (SlotIndex != INDEX_NONE)
+			{
+				FPlatformAtomics::AtomicStore(&ReaderSlots[SlotIndex].Epoch, (int64)0);
+				FPlatformAtomics::AtomicStore(&ReaderSlots[SlotIndex].bClaimed, 0);
+			}
+		}
+
+	public:
+		int32 SlotIndex;
+		int32 NumNestedReads;
+	};
+}
+
+void FSharedSnapshotEpochs::EnterRead()
+{
+	using namespace UE4SharedSnapshot_Private;
+
+	FReaderState& State = FReaderState::Get();
+	if (State.NumNestedReads++ > 0)
+	{
+		return;
+	}
+
+	if (State.SlotIndex != INDEX_NONE)
+	{
+		FPlatformAtomics::AtomicStore_Relaxed(&ReaderSlots[State.SlotIndex].Epoch, FPlatformAtomics::AtomicRead_Relaxed(&GlobalEpoch));
+		StoreLoadFence();
+	}
+	else
+	{
+		FPlatformAtomics::InterlockedIncrement(&OverflowReaders);
+	}
+}
+
+void FSharedSnapshotEpochs::ExitRead()
+{
+	using namespace UE4SharedSnapshot_Private;
+
+	FReaderState& State = FReaderState::Get();
+	check(State.NumNestedReads > 0);
+	if (--State.NumNestedReads > 0)
+	{
+		return;
+	}
+
+	if (State.SlotIndex != INDEX_NONE)
+	{
+		// Loads of the value must not move past the store that lets writers delete it
+		FPlatformAtomics::AtomicStore(&ReaderSlots[State.SlotIndex].Epoch, (int64)0);
+	}
+	else
+	{
+		FPlatformAtomics::InterlockedDecrement(&OverflowReaders);
+	}
+}
+
+void FSharedSnapshotEpochs::Retire(void* Object, void (*Deleter)(void*))
+{
+	using namespace UE4SharedSnapshot_Private;
+
+	if (!Object)
+	{
+		return;
+	}
+
+	// The object is already unreachable, so reads that start after the epoch moves on can't find it
+	const int64 Epoch = FPlatformAtomics::InterlockedIncrement(&GlobalEpoch) - 1;
+	{
+		FScopeLock Lock(&GetRetiredCritical());
+		GetRetiredObjects().Add(FRetiredObject{ Object, Deleter, Epoch });
+	}
+
+	Reclaim();
+}
+
+void FSharedSnapshotEpochs::Reclaim()
+{
+	using namespace UE4SharedSnapshot_Private;
+
+	StoreLoadFence();
+
+	// Readers without a slot don't say when they started, nothing can be deleted until they are all done
+	if (FPlatformAtomics::AtomicRead(&OverflowReaders) != 0)
+	{
+		return;
+	}
+
+	int64 OldestReadEpoch = MAX_int64;
+	for (int32 Index = 0; Index < NumReaderSlots; ++Index)
+	{
+		const int64 Epoch = FPlatformAtomics::AtomicRead(&ReaderSlots[Index].Epoch);
+		if (Epoch != 0 && Epoch < OldestReadEpoch)
+		{
+			OldestReadEpoch = Epoch;
+		}
+	}
+
+	TArray<FRetiredObject> ObjectsToDelete;
+	{
+		FScopeLock Lock(&GetRetiredCritical());
+		TArray<FRetiredObject>& RetiredObjects = GetRetiredObjects();
+		for (int32 Index = RetiredObjects.Num() - 1; Index >= 0; --Index)
+		{
+			if (RetiredObjects[Index].Epoch < OldestReadEpoch)
+			{
+				ObjectsToDelete.Add(RetiredObjects[Index]);
+				RetiredObjects.RemoveAtSwap(Index, 1, false);
+			}
+		}
+	}
+
+	// Deleters run outside the lock, they may retire other objects
+	for (const FRetiredObject& Retired : ObjectsToDelete)
+	{
+		Retired.Deleter(Retired.Object);
+	}
+}
@@ -13,6 +13,7 @@
 #include "Misc/ByteSwap.h"
 #include "Misc/VarArgs.h"
 #include "String/HexToBytes.h"
+#include "String/VectorizedAscii.h"
 #include "Templates/UnrealTemplate.h"
 
 /* FString implementation
@@ -290,7 +291,17 @@ void FString::ToUpperInline()
 {
 	const int32 StringLength = Len();
 	TCHAR* RawData = Data.GetData();
-	for (int32 i = 0; i < StringLength; ++i)
+	int32 i = 0;
+#if UE_VECTORIZED_ASCII
+	// Only ASCII letters change case, so non-ASCII text goes through the same path
+	using namespace UE4VectorizedAscii_Private;
+	constexpr int32 NumPerVector = 16 / sizeof(TCHAR);
+	for (; i + NumPerVector <= StringLength; i += NumPerVector)
+	{
+		StoreBytes(RawData + i, FlipCase<sizeof(TCHAR)>(LoadBytes(RawData + i), 'a'));
+	}
+#endif
+	for (; i < StringLength; ++i)
 	{
 		RawData[i] = FChar::ToUpper(RawData[i]);
 	}
@@ -314,7 +325,17 @@ void FString::ToLowerInline()
 {
 	const int32 StringLength = Len();
 	TCHAR* RawData = Data.GetData();
-	for (int32 i = 0; i < StringLength; ++i)
+	int32 i = 0;
+#if UE_VECTORIZED_ASCII
+	// Only ASCII letters change case, so non-ASCII text goes through the same path
+	using namespace UE4VectorizedAscii_Private;
+	constexpr int32 NumPerVector = 16 / sizeof(TCHAR);
+	for (; i + NumPerVector <= StringLength; i += NumPerVector)
+	{
+		StoreBytes(RawData + i, FlipCase<sizeof(TCHAR)>(LoadBytes(RawData + i), 'A'));
+	}
+#endif
+	for (; i < StringLength; ++i)
 	{
 		RawData[i] = FChar::ToLower(RawData[i]);
 	}
@@ -3,12 +3,33 @@
 #include "Containers/Ticker.h"
 #include "Stats/Stats.h"
 #include "Misc/TimeGuard.h"
+#include "Misc/ScopeLock.h"
+
+namespace UE4Ticker_Private
+{
+	/** Seconds per tick of the timer wheel, delegates still never fire before their fire time */
+	static const double WheelResolution = 0.001;
+
+	static uint64 ToWheelTick(const double Time)
+	{
+		return Time > 0.0 ? (uint64)(Time / WheelResolution) : 0;
+	}
+}
 
 FTicker::FTicker()
 	: CurrentTime(0.0)
+	, WheelTick(0)
+	, FirstFreeElement(INDEX_NONE)
+	, NumUsedElements(0)
+	, CurrentElementIndex(INDEX_NONE)
 	, bInTick(false)
 	, bCurrentElementRemoved(false)
 {
+	for (int32& ListHead : ListHeads)
+	{
+		ListHead = INDEX_NONE;
+	}
+	FMemory::Memzero(WheelOccupancy);
 }
 
 FTicker::~FTicker()
@@ -17,8 +38,11 @@ FTicker::~FTicker()
 
 FDelegateHandle FTicker::AddTicker(const FTickerDelegate& InDelegate, float InDelay)
 {
-	// We can add elements safely even during tick.
-	Elements.Emplace(CurrentTime + InDelay, InDelay, InDelegate);
+	// We can add elements safely even during tick, and from other threads. They are scheduled by the next tick.
+	{
+		FScopeLock Lock(&PendingElementsCritical);
+		PendingElements.Add({ InDelay, InDelegate });
+	}
 	// @todo this needs a unique handle for each add call to allow you to register the same delegate twice with a different delay safely.
 	// because of this, RemoveTicker removes all elements that use this handle.
 	return InDelegate.GetHandle();
@@ -31,25 +55,31 @@ FDelegateHandle FTicker::AddTicker(const TCHAR* InName, float InDelay, TFunction
 
 	FTickerDelegate Delegate = FTickerDelegate::CreateLambda(Function);
 
-	// We can add elements safely even during tick.
-	Elements.Emplace(CurrentTime + InDelay, InDelay, Delegate);
-
-	return Delegate.GetHandle();
+	return AddTicker(Delegate, InDelay);
 }
 
 void FTicker::RemoveTicker(FDelegateHandle Handle)
 {
-	// must remove the handle from both arrays because we could be in the middle of a tick, 
-	// and may be removing ourselves or something else we've already considered this Tick
-	auto CompareHandle = [=](const FElement& Element){ return Element.Delegate.GetHandle() == Handle; };
-	// We can remove elements safely even during tick.
-	Elements.RemoveAllSwap(CompareHandle);
-	TickedElements.RemoveAllSwap(CompareHandle);
-	// if we are ticking, we must check for the edge case of the CurrentElement removing itself.
-	if (bInTick && CompareHandle(CurrentElement))
 	{
-		// Technically it's possible for someone to try to remove CurrentDelegate multiple times, so make sure we never set this value to false in here.
-		bCurrentElementRemoved = true;
+		FScopeLock Lock(&PendingElementsCritical);
+		PendingElements.RemoveAllSwap([Handle](const FPendingElement& Element){ return Element.Delegate.GetHandle() == Handle; });
+	}
+
+	// We can remove elements safely even during tick, wherever they are in the wheel or the lists of the tick
+	TArray<int32, TInlineAllocator<4>> ElementIndices;
+	HandleToElements.MultiFind(Handle, ElementIndices);
+	for (const int32 Index : ElementIndices)
+	{
+		if (bInTick && Index == CurrentElementIndex)
+		{
+			// Technically it's possible for someone to try to remove CurrentDelegate multiple times, so make sure we never set this value to false in here.
+			bCurrentElementRemoved = true;
+		}
+		else
+		{
+			UnlinkElement(Index);
+			FreeElement(Index);
+		}
 	}
 }
 
@@ -58,7 +88,10 @@ void FTicker::Tick(float DeltaTime)
 	SCOPE_TIME_GUARD(TEXT("FTicker::Tick"));
 
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_FTicker_Tick);
-	if (!Elements.Num())
+
+	// The delegates added since the last tick are due their delay after the time they were added at
+	DrainPendingElements();
+	if (!NumUsedElements)
 	{
 		return;
 	}
@@ -67,57 +100,228 @@ void FTicker::Tick(float DeltaTime)
 	TGuardValue<bool> TickGuard(bInTick, true);
 
 	CurrentTime += DeltaTime;
-	// we will keep popping off elements until the array is empty.
-	// We cannot keep references or iterators into any of these containers because the act of firing a delegate could
-	// add or remove any other delegate, including itself. 
-	// As we pop off elements, we track the CurrentElement in case it tries to remove itself.
-	// When finished, we put it onto a TickedElements list. This allows another delegate in the list to remove it,
-	// while still keeping track of elements we've ticked by popping off the Elements array.
+	CollectExpiredElements();
+
+	// Firing a delegate could add or remove any other delegate, including itself, so we keep popping the first element off the list.
+	// Rescheduled delegates go onto another list until all of them fired, so that a delegate doesn't fire twice in the same tick.
+	// As we pop off elements, we track the CurrentElementIndex in case it tries to remove itself.
 	// See RemoveTicker for details on how this state is used.
-	while (Elements.Num())
+	while (ListHeads[FireList] != INDEX_NONE)
+	{
+		CurrentElementIndex = ListHeads[FireList];
+		UnlinkElement(CurrentElementIndex);
+		// reset this state every time we reassign to CurrentElementIndex.
+		bCurrentElementRemoved = false;
+		// fire the delegate. It can return false to tell us to remove it immediately. Elements don't move while delegates fire, as adds go through the pending list.
+		bool bRemoveElement = !Elements[CurrentElementIndex].Fire(DeltaTime);
+		// The act of firing the delegate could also have caused it to remove itself.
+		if (bRemoveElement || bCurrentElementRemoved)
+		{
+			FreeElement(CurrentElementIndex);
+		}
+		else
+		{
+			// update the fire time.
+			// Note this is where Timer skew occurs. Use FireTime += DelayTime if skew is not wanted.
+			FElement& CurrentElement = Elements[CurrentElementIndex];
+			CurrentElement.FireTime = CurrentTime + CurrentElement.DelayTime;
+			LinkElement(CurrentElementIndex, RearmList);
+		}
+	}
+	CurrentElementIndex = INDEX_NONE;
+
+	// Re-arming an element only moves it to another slot of the wheel
+	while (ListHeads[RearmList] != INDEX_NONE)
+	{
+		const int32 Index = ListHeads[RearmList];
+		UnlinkElement(Index);
+		ScheduleElement(Index);
+	}
+}
+
+void FTicker::DrainPendingElements()
+{
+	TArray<FPendingElement> AddedElements;
+	{
+		FScopeLock Lock(&PendingElementsCritical);
+		if (!PendingElements.Num())
+		{
+			return;
+		}
+		Exchange(AddedElements, PendingElements);
+	}
+
+	for (FPendingElement& AddedElement : AddedElements)
 	{
-		// as an optimization, if the Element is not ready to fire, move it immediately to the TickedElements list.
-		// This is safe because no one can mutate the arrays while we do this.
-		if (Elements.Last().FireTime > CurrentTime)
+		int32 Index = FirstFreeElement;
+		if (Index != INDEX_NONE)
 		{
-			TickedElements.Add(Elements.Pop(false));
+			FirstFreeElement = Elements[Index].NextIndex;
+			Elements[Index] = FElement(CurrentTime + AddedElement.DelayTime, AddedElement.DelayTime, AddedElement.Delegate);
 		}
 		else
 		{
-			// we now know the element is ready to fire, so pop it off the list.
-			CurrentElement = Elements.Pop(false);
-			// reset this state every time we reassign to CurrentElement.
-			bCurrentElementRemoved = false;
-			// fire the delegate. It can return false to tell us to remove it immediately.
-			bool bRemoveElement = !CurrentElement.Fire(DeltaTime);
-			// The act of firing the delegate could also have caused it to remove itself.
-			// if either happens, we just won't add this to the TickedElements array.
-			if (!bRemoveElement && !bCurrentElementRemoved)
+			Index = Elements.Emplace(CurrentTime + AddedElement.DelayTime, AddedElement.DelayTime, AddedElement.Delegate);
+		}
+
+		++NumUsedElements;
+		HandleToElements.Add(AddedElement.Delegate.GetHandle(), Index);
+		ScheduleElement(Index);
+	}
+}
+
+void FTicker::ScheduleElement(int32 Index)
+{
+	const uint64 ElementTick = FMath::Max(UE4Ticker_Private::ToWheelTick(Elements[Index].FireTime), WheelTick);
+
+	// An element goes in the lowest level whose slots span both the current tick and its own
+	for (int32 Level = 0; Level < NumWheelLevels; ++Level)
+	{
+		const int32 HigherLevelsShift = (Level + 1) * WheelSlotBits;
+		if ((ElementTick >> HigherLevelsShift) == (WheelTick >> HigherLevelsShift))
+		{
+			LinkElement(Index, Level * NumWheelSlots + (int32)((ElementTick >> (Level * WheelSlotBits)) & (NumWheelSlots - 1)));
+			return;
+		}
+	}
+
+	// Beyond the span of the wheel, the element waits in the slot of the top level that comes last and is scheduled again from there
+	const int32 TopLevelShift = (NumWheelLevels - 1) * WheelSlotBits;
+	LinkElement(Index, (NumWheelLevels - 1) * NumWheelSlots + (int32)(((WheelTick >> TopLevelShift) - 1) & (NumWheelSlots - 1)));
+}
+
+void FTicker::CollectExpiredElements()
+{
+	const uint64 TargetTick = FMath::Max(UE4Ticker_Private::ToWheelTick(CurrentTime), WheelTick);
+	for (;;)
+	{
+		// Expire the slots of the bottom level up to the target tick or the end of the level, whichever comes first
+		const uint64 FirstTickOfLevel = WheelTick & ~uint64(NumWheelSlots - 1);
+		const uint64 LastTick = FMath::Min(TargetTick, FirstTickOfLevel + NumWheelSlots - 1);
+		const uint32 FirstSlot = (uint32)(WheelTick - FirstTickOfLevel);
+		const uint32 LastSlot = (uint32)(LastTick - FirstTickOfLevel);
+
+		uint64 SlotMask = WheelOccupancy[0] & (MAX_uint64 << FirstSlot) & (MAX_uint64 >> (NumWheelSlots - 1 - LastSlot));
+		while (SlotMask)
+		{
+			const int32 Slot = (int32)FMath::CountTrailingZeros64(SlotMask);
+			SlotMask &= SlotMask - 1;
+
+			// The slot of the target tick may hold elements due later within that tick of the wheel
+			const bool bWholeSlotExpired = FirstTickOfLevel + Slot < TargetTick;
+			for (int32 Index = ListHeads[Slot]; Index != INDEX_NONE; )
+			{
+				const int32 NextIndex = Elements[Index].NextIndex;
+				if (bWholeSlotExpired || Elements[Index].FireTime <= CurrentTime)
+				{
+					UnlinkElement(Index);
+					LinkElement(Index, FireList);
+				}
+				Index = NextIndex;
+			}
+		}
+
+		WheelTick = LastTick;
+		if (WheelTick == TargetTick)
+		{
+			return;
+		}
+
+		// Move on to the next span of the bottom level, bringing down the elements of the higher levels that fall in it
+		++WheelTick;
+		for (int32 Level = 1; Level < NumWheelLevels; ++Level)
+		{
+			const int32 Slot = (int32)((WheelTick >> (Level * WheelSlotBits)) & (NumWheelSlots - 1));
+			const int32 ListIndex = Level * NumWheelSlots + Slot;
+			while (ListHeads[ListIndex] != INDEX_NONE)
 			{
-				// update the fire time.
-				// Note this is where Timer skew occurs. Use FireTime += DelayTime if skew is not wanted.
-				CurrentElement.FireTime = CurrentTime + CurrentElement.DelayTime;
-				// push this element onto the TickedElement list so we know we already ticked it.
-				TickedElements.Push(CurrentElement);
+				const int32 Index = ListHeads[ListIndex];
+				UnlinkElement(Index);
+				ScheduleElement(Index);
+			}
+
+			// The higher levels only move on when this one wraps around
+			if (Slot != 0)
+			{
+				break;
 			}
 		}
 	}
+}
 
-	// Now that we've considered all the delegates, we swap it back into the Elements array.
-	Exchange(TickedElements, Elements);
-	// Also clear the CurrentElement delegate as our tick is done
-	CurrentElement.Delegate.Unbind();
+void FTicker::LinkElement(int32 Index, int32 ListIndex)
+{
+	FElement& Element = Elements[Index];
+	Element.ListIndex = ListIndex;
+	Element.PrevIndex = INDEX_NONE;
+	Element.NextIndex = ListHeads[ListIndex];
+	if (Element.NextIndex != INDEX_NONE)
+	{
+		Elements[Element.NextIndex].PrevIndex = Index;
+	}
+	ListHeads[ListIndex] = Index;
+
+	if (ListIndex < FireList)
+	{
+		WheelOccupancy[ListIndex / NumWheelSlots] |= uint64(1) << (ListIndex % NumWheelSlots);
+	}
+}
+
+void FTicker::UnlinkElement(int32 Index)
+{
+	FElement& Element = Elements[Index];
+	if (Element.ListIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Element.PrevIndex != INDEX_NONE)
+	{
+		Elements[Element.PrevIndex].NextIndex = Element.NextIndex;
+	}
+	else
+	{
+		ListHeads[Element.ListIndex] = Element.NextIndex;
+		if (Element.NextIndex == INDEX_NONE && Element.ListIndex < FireList)
+		{
+			WheelOccupancy[Element.ListIndex / NumWheelSlots] &= ~(uint64(1) << (Element.ListIndex % NumWheelSlots));
+		}
+	}
+	if (Element.NextIndex != INDEX_NONE)
+	{
+		Elements[Element.NextIndex].PrevIndex = Element.PrevIndex;
+	}
+
+	Element.ListIndex = INDEX_NONE;
+	Element.PrevIndex = INDEX_NONE;
+	Element.NextIndex = INDEX_NONE;
+}
+
+void FTicker::FreeElement(int32 Index)
+{
+	FElement& Element = Elements[Index];
+	HandleToElements.RemoveSingle(Element.Delegate.GetHandle(), Index);
+	Element.Delegate.Unbind();
+	Element.NextIndex = FirstFreeElement;
+	FirstFreeElement = Index;
+	--NumUsedElements;
 }
 
 FTicker::FElement::FElement() 
 	: FireTime(0.0)
 	, DelayTime(0.0f)
+	, PrevIndex(INDEX_NONE)
+	, NextIndex(INDEX_NONE)
+	, ListIndex(INDEX_NONE)
 {}
 
 FTicker::FElement::FElement(double InFireTime, float InDelayTime, const FTickerDelegate& InDelegate) 
 	: FireTime(InFireTime)
 	, DelayTime(InDelayTime)
 	, Delegate(InDelegate)
+	, PrevIndex(INDEX_NONE)
+	, NextIndex(INDEX_NONE)
+	, ListIndex(INDEX_NONE)
 {}
 
 bool FTicker::FElement::Fire(float DeltaTime)
@@ -13,6 +13,7 @@
 #include "HAL/PlatformFile.h"
 #include "HAL/PlatformFilemanager.h"
 #include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
 
 DECLARE_STATS_GROUP(TEXT("Streaming File Cache"), STATGROUP_SFC, STATCAT_Advanced);
 
@@ -29,6 +30,9 @@ DECLARE_MEMORY_STAT(TEXT("Locked Size"), STAT_SFC_LockedSize, STATGROUP_SFC);
 DECLARE_MEMORY_STAT(TEXT("Preloaded Size"), STAT_SFC_PreloadedSize, STATGROUP_SFC);
 DECLARE_MEMORY_STAT(TEXT("Fine Preloaded Size"), STAT_SFC_FinePreloadedSize, STATGROUP_SFC);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lines Read"), STAT_SFC_LinesRead, STATGROUP_SFC);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lines Found In Flight"), STAT_SFC_LinesFoundInFlight, STATGROUP_SFC);
+
 DEFINE_LOG_CATEGORY_STATIC(LogStreamingFileCache, Log, All);
 
 static const int CacheSlotCapacity = 64 * 1024;
@@ -39,10 +43,18 @@ static int32 GNumFileCacheBlocks = 256;
 static FAutoConsoleVariableRef CVarNumFileCacheBlocks(
 	TEXT("fc.NumFileCacheBlocks"),
 	GNumFileCacheBlocks,
-	TEXT("Number of blocks in the global file cache object\n"),
+	TEXT("Number of blocks in the global file cache object, changes are picked up by the next cache tick\n"),
 	ECVF_RenderThreadSafe
 );
 
+static int32 GShareFileCacheHandles = 1;
+static FAutoConsoleVariableRef CVarShareFileCacheHandles(
+	TEXT("fc.ShareFileCacheHandles"),
+	GShareFileCacheHandles,
+	TEXT("If set, file cache handles created for the same file share their cache lines and in flight reads\n"),
+	ECVF_Default
+);
+
 static int32 GLineReleaseFrameThreshold = 300;
 static FAutoConsoleVariableRef CVarLineReleaseFrameThreshold(
 	TEXT("fc.LineReleaseFrameThreshold"),
@@ -143,6 +155,9 @@ public:
 
 	void FlushCompletedRequests();
 
+	/** Releases the lock that kept the slots of the reads that completed since the last call from being recycled */
+	void UnlockCompletedReads();
+
 	void EvictFileCacheFromConsole()
 	{
 		EvictAll();
@@ -213,6 +228,10 @@ public:
 	TLockFreePointerListUnordered<IAsyncReadRequest, PLATFORM_CACHE_LINE_SIZE> CompletedRequests;
 	FThreadSafeCounter CompletedRequestsCounter;
 
+	// Slots stay locked while their line is being read, so the memory isn't handed to another line under the read
+	// and the line isn't evicted and read again. The read callbacks queue the slots here to be unlocked under CriticalSection
+	TQueue<CacheSlotID, EQueueMode::Mpsc> CompletedReadSlots;
+
 	// allocated with an extra dummy entry at index0 for linked list head
 	TArray<FSlotInfo> SlotInfo;
 	uint8* SlotMemory[CacheSlotCapacity];
@@ -274,6 +293,7 @@ PRAGMA_ENABLE_UNSAFE_TYPECAST_WARNINGS
 	virtual IMemoryReadStreamRef ReadData(FGraphEventArray& OutCompletionEvents, int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority) override;
 	virtual FGraphEventRef PreloadData(const FFileCachePreloadEntry* PreloadEntries, int32 NumEntries, int64 InOffset, EAsyncIOPriorityAndFlags Priority) override;
 	virtual void ReleasePreloadedData(const FFileCachePreloadEntry* PreloadEntries, int32 NumEntries, int64 InOffset) override;
+	virtual void PrefetchData(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority) override;
 
 	IMemoryReadStreamRef ReadDataUncached(FGraphEventArray& OutCompletionEvents, int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority);
 
@@ -288,6 +308,7 @@ private:
 	};
 
 	void CheckForSizeRequestComplete();
+	void EnsureNumSlots(CacheLineID EndLine);
 
 	CacheSlotID AcquireSlotAndReadLine(FFileCache& Cache, CacheLineID LineID, EAsyncIOPriorityAndFlags Priority);
 	void ReadLine(FFileCache& Cache, CacheSlotID SlotID, CacheLineID LineID, EAsyncIOPriorityAndFlags Priority, const FGraphEventRef& CompletionEvent);
@@ -351,14 +372,27 @@ FFileCache::~FFileCache()
 bool FFileCache::OnTick(float DeltaTime)
 {
 	FScopeLock Lock(&CriticalSection);
+	UnlockCompletedReads();
+
+	const int32 NewNumSlots = FMath::Clamp(GNumFileCacheBlocks, 0, CacheSlotCapacity - SLOTLIST_Num);
+	if (NewNumSlots != NumSlots)
+	{
+		// Growing takes effect as lines are read, shrinking releases the lines that haven't been used recently a few at a time
+		NumSlots = NewNumSlots;
+		SizeInBytes = NewNumSlots * CacheSlotID::BlockSize;
+	}
+
 	ReleaseMemory(30);
 	return true;
 }
 
 CacheSlotID FFileCache::AcquireAndLockSlot(FFileCacheHandle* InHandle, CacheLineID InLineID)
 {
+	UnlockCompletedReads();
+
+	// Only recycle the least recently used line once the cache is full
 	int32 SlotIndex = SlotInfo[SLOTLIST_UnlockedAllocated].NextSlotIndex;
-	if (SlotIndex == SLOTLIST_UnlockedAllocated)
+	if (SlotIndex == SLOTLIST_UnlockedAllocated || NumAllocatedSlots < NumSlots)
 	{
 		SlotIndex = SlotInfo[SLOTLIST_Free].NextSlotIndex;
 		if (SlotIndex == SLOTLIST_Free)
@@ -559,6 +593,7 @@ bool FFileCache::EvictAll(FFileCacheHandle* InFile)
 	SCOPE_CYCLE_COUNTER(STAT_SFC_EvictAll);
 
 	FScopeLock Lock(&CriticalSection);
+	UnlockCompletedReads();
 
 	bool bAllOK = true;
 	for (int SlotIndex = 1; SlotIndex < SlotInfo.Num(); ++SlotIndex)
@@ -601,6 +636,15 @@ void FFileCache::FlushCompletedRequests()
 	}
 }
 
+void FFileCache::UnlockCompletedReads()
+{
+	CacheSlotID SlotID;
+	while (CompletedReadSlots.Dequeue(SlotID))
+	{
+		UnlockSlot(SlotID);
+	}
+}
+
 FFileCacheHandle::~FFileCacheHandle()
 {
 	if (SizeRequestEvent)
@@ -748,6 +792,21 @@ public:
 	CacheSlotID CacheSlots[1]; // variable length, sized by NumCacheSlots
 };
 
+void FFileCacheHandle::EnsureNumSlots(CacheLineID EndLine)
+{
+	if (EndLine.Get() >= NumSlots)
+	{
+		// If we're still waiting on SizeRequest, may need to lazily allocate some slots to service this request
+		// If this happens after SizeRequest has completed, that means something must have gone wrong
+		check(SizeRequestEvent);
+		NumSlots = EndLine.Get() + 1;
+		// TArray is max signed int
+		check(NumSlots < MAX_int32);
+		LineToSlot.SetNum((int32)NumSlots, false);
+		LineToRequest.SetNum((int32)NumSlots, false);
+	}
+}
+
 void FFileCacheHandle::CheckForSizeRequestComplete()
 {
 	if (SizeRequestEvent && SizeRequestEvent->IsComplete())
@@ -775,8 +834,10 @@ void FFileCacheHandle::ReadLine(FFileCache& Cache, CacheSlotID SlotID, CacheLine
 	uint8* CacheSlotMemory = Cache.GetSlotMemory(SlotID);
 
 	// callback triggered when async read operation is complete, used to signal task graph event
-	FAsyncFileCallBack ReadCallbackFunction = [CompletionEvent](bool bWasCancelled, IAsyncReadRequest* Request)
+	// the slot is queued for unlocking first, so it is ready to be released once the event has completed
+	FAsyncFileCallBack ReadCallbackFunction = [SlotID, CompletionEvent](bool bWasCancelled, IAsyncReadRequest* Request)
 	{
+		GetCache().CompletedReadSlots.Enqueue(SlotID);
 		TArray<FBaseGraphTask*> NewTasks;
 		CompletionEvent->DispatchSubsequents(NewTasks);
 		GetCache().PushCompletedRequest(Request);
@@ -790,7 +851,10 @@ CacheSlotID FFileCacheHandle::AcquireSlotAndReadLine(FFileCache& Cache, CacheLin
 	SCOPED_LOADTIMER(FFileCacheHandle_AcquireSlotAndReadLine);
 
 	// no valid slot for this line, grab a new slot from cache and start a read request
+	// the slot is locked a second time for the read, ReadLine's completion callback releases that lock
 	CacheSlotID SlotID = Cache.AcquireAndLockSlot(this, LineID);
+	Cache.LockSlot(SlotID);
+	INC_DWORD_STAT(STAT_SFC_LinesRead);
 
 	FPendingRequest& PendingRequest = LineToRequest[LineID.Get()];
 	if (PendingRequest.Event)
@@ -828,13 +892,11 @@ IMemoryReadStreamRef FFileCacheHandle::ReadData(FGraphEventArray& OutCompletionE
 	const CacheLineID StartLine = GetBlock<CacheLineID>(Offset);
 	const CacheLineID EndLine = GetBlock<CacheLineID>(Offset + BytesToRead - 1);
 
-	CheckForSizeRequestComplete();
-
-	int32 NumSlotsNeeded = EndLine.Get() + 1 - StartLine.Get();
-
 	FFileCache& Cache = GetCache();
 
+	// Handles may be shared between threads, everything below is done under the cache lock
 	FScopeLock CacheLock(&Cache.CriticalSection);
+	CheckForSizeRequestComplete();
 	/*if (NumSlotsNeeded > Cache.NumFreeSlots)
 	{
 		// not enough free slots in the cache to service this request
@@ -847,17 +909,7 @@ IMemoryReadStreamRef FFileCacheHandle::ReadData(FGraphEventArray& OutCompletionE
 		return nullptr;
 	}*/
 
-	if (EndLine.Get() >= NumSlots)
-	{
-		// If we're still waiting on SizeRequest, may need to lazily allocate some slots to service this request
-		// If this happens after SizeRequest has completed, that means something must have gone wrong
-		check(SizeRequestEvent);
-		NumSlots = EndLine.Get() + 1;
-		// TArray is max signed int
-		check(NumSlots < MAX_int32);
-		LineToSlot.SetNum((int32)NumSlots, false);
-		LineToRequest.SetNum((int32)NumSlots, false);
-	}
+	EnsureNumSlots(EndLine);
 
 	const int32 NumCacheSlots = EndLine.Get() + 1 - StartLine.Get();
 	check(NumCacheSlots > 0);
@@ -880,6 +932,11 @@ IMemoryReadStreamRef FFileCacheHandle::ReadData(FGraphEventArray& OutCompletionE
 		else
 		{
 			Cache.LockSlot(SlotID);
+			if (LineToRequest[LineID.Get()].Event && !LineToRequest[LineID.Get()].Event->IsComplete())
+			{
+				// requested again while it is still being read, for another stream or another user of a shared handle
+				INC_DWORD_STAT(STAT_SFC_LinesFoundInFlight);
+			}
 		}
 
 		check(SlotID.IsValid());
@@ -930,26 +987,14 @@ FGraphEventRef FFileCacheHandle::PreloadData(const FFileCachePreloadEntry* Prelo
 
 	check(NumEntries > 0);
 
-	CheckForSizeRequestComplete();
-
 	FFileCache& Cache = GetCache();
 
 	FScopeLock CacheLock(&Cache.CriticalSection);
+	CheckForSizeRequestComplete();
 
 	{
 		const FFileCachePreloadEntry& LastEntry = PreloadEntries[NumEntries - 1];
-		const CacheLineID LastEndLine = GetBlock<CacheLineID>(LastEntry.Offset + LastEntry.Size - 1);
-		if (LastEndLine.Get() >= NumSlots)
-		{
-			// If we're still waiting on SizeRequest, may need to lazily allocate some slots to service this request
-			// If this happens after SizeRequest has completed, that means something must have gone wrong
-			check(SizeRequestEvent);
-			NumSlots = LastEndLine.Get() + 1;
-			// TArray is max signed int
-			check(NumSlots < MAX_int32);
-			LineToSlot.SetNum((int32)NumSlots, false);
-			LineToRequest.SetNum((int32)NumSlots, false);
-		}
+		EnsureNumSlots(GetBlock<CacheLineID>(InOffset + LastEntry.Offset + LastEntry.Size - 1));
 	}
 
 	FGraphEventArray CompletionEvents;
@@ -1084,31 +1129,198 @@ void FFileCacheHandle::ReleasePreloadedData(const FFileCachePreloadEntry* Preloa
 	Cache.ReleaseMemory(NumSlotsUnloaded);
 }
 
-void FFileCacheHandle::Evict(CacheLineID LineID)
+void FFileCacheHandle::PrefetchData(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority)
 {
-	LineToSlot[LineID.Get()] = CacheSlotID();
+	SCOPED_LOADTIMER(FFileCacheHandle_PrefetchData);
 
-	FPendingRequest& PendingRequest = LineToRequest[LineID.Get()];
-	if (PendingRequest.Event)
+	if (BytesToRead <= 0)
 	{
-		check(PendingRequest.Event->IsComplete());
-		PendingRequest.Event.SafeRelease();
+		return;
+	}
+
+	const CacheLineID StartLine = GetBlock<CacheLineID>(Offset);
+	const CacheLineID EndLine = GetBlock<CacheLineID>(Offset + BytesToRead - 1);
+
+	FFileCache& Cache = GetCache();
+
+	FScopeLock CacheLock(&Cache.CriticalSection);
+	CheckForSizeRequestComplete();
+	EnsureNumSlots(EndLine);
+
+	for (CacheLineID LineID = StartLine; LineID.Get() <= EndLine.Get(); ++LineID)
+	{
+		CacheSlotID& SlotID = LineToSlot[LineID.Get()];
+		if (!SlotID.IsValid())
+		{
+			// Only the read keeps the slot locked, the line joins the unlocked lines once it has landed
+			SlotID = AcquireSlotAndReadLine(Cache, LineID, Priority);
+			Cache.UnlockSlot(SlotID);
+		}
 	}
 }
 
+void FFileCacheHandle::Evict(CacheLineID LineID)
+{
+	LineToSlot[LineID.Get()] = CacheSlotID();
+
+	// The slot was locked until the read landed, but its completion event may still be dispatching
+	LineToRequest[LineID.Get()].Event.SafeRelease();
+}
+
 void FFileCacheHandle::WaitAll()
 {
+	FFileCache& Cache = GetCache();
+
+	// Prefetches keep nothing waiting on their reads, so there can still be some in flight
+	FGraphEventArray PendingEvents;
+	{
+		FScopeLock CacheLock(&Cache.CriticalSection);
+		for (int i = 0; i < LineToRequest.Num(); ++i)
+		{
+			FPendingRequest& PendingRequest = LineToRequest[i];
+			if (PendingRequest.Event && !PendingRequest.Event->IsComplete())
+			{
+				PendingEvents.Add(PendingRequest.Event);
+			}
+		}
+	}
+
+	if (PendingEvents.Num() > 0)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(PendingEvents);
+	}
+
+	// Users of a shared handle may have started more reads in the meantime, those are left alone
+	FScopeLock CacheLock(&Cache.CriticalSection);
 	for (int i = 0; i < LineToRequest.Num(); ++i)
 	{
 		FPendingRequest& PendingRequest = LineToRequest[i];
-		if (PendingRequest.Event)
+		if (PendingRequest.Event && PendingRequest.Event->IsComplete())
 		{
-			check(PendingRequest.Event->IsComplete());
 			PendingRequest.Event.SafeRelease();
 		}
 	}
 }
 
+// 
+// Handles created for the same file share one FFileCacheHandle, which lives as long as any of them
+// 
+class FSharedFileCacheHandle : public IFileCacheHandle
+{
+public:
+	struct FSharedHandle
+	{
+		FFileCacheHandle* Handle = nullptr;
+		int32 RefCount = 0;
+	};
+
+	struct FRegistry
+	{
+		FCriticalSection CriticalSection;
+		TMap<FString, FSharedHandle> Handles;
+	};
+
+	static FRegistry& GetRegistry()
+	{
+		static FRegistry Registry;
+		return Registry;
+	}
+
+	static IFileCacheHandle* Create(const TCHAR* InFileName)
+	{
+		FString Key = FPaths::ConvertRelativePathToFull(InFileName);
+		FRegistry& Registry = GetRegistry();
+		{
+			FScopeLock Lock(&Registry.CriticalSection);
+			if (FSharedHandle* Shared = Registry.Handles.Find(Key))
+			{
+				++Shared->RefCount;
+				return new FSharedFileCacheHandle(MoveTemp(Key), Shared->Handle);
+			}
+		}
+
+		IAsyncReadFileHandle* FileHandle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(InFileName);
+		if (!FileHandle)
+		{
+			return nullptr;
+		}
+		FFileCacheHandle* NewHandle = new FFileCacheHandle(FileHandle);
+
+		FFileCacheHandle* HandleToDelete = nullptr;
+		IFileCacheHandle* Result = nullptr;
+		{
+			FScopeLock Lock(&Registry.CriticalSection);
+			FSharedHandle& Shared = Registry.Handles.FindOrAdd(Key);
+			if (Shared.Handle)
+			{
+				// Another thread opened the file in the meantime
+				HandleToDelete = NewHandle;
+			}
+			else
+			{
+				Shared.Handle = NewHandle;
+			}
+			++Shared.RefCount;
+			Result = new FSharedFileCacheHandle(MoveTemp(Key), Shared.Handle);
+		}
+		delete HandleToDelete;
+		return Result;
+	}
+
+	virtual ~FSharedFileCacheHandle() override
+	{
+		FFileCacheHandle* HandleToDelete = nullptr;
+		{
+			FRegistry& Registry = GetRegistry();
+			FScopeLock Lock(&Registry.CriticalSection);
+			FSharedHandle& Shared = Registry.Handles.FindChecked(Key);
+			check(Shared.Handle == Handle && Shared.RefCount > 0);
+			if (--Shared.RefCount == 0)
+			{
+				HandleToDelete = Handle;
+				Registry.Handles.Remove(Key);
+			}
+		}
+		// Waits for the reads in flight, so it's done outside of the registry lock
+		delete HandleToDelete;
+	}
+
+	virtual IMemoryReadStreamRef ReadData(FGraphEventArray& OutCompletionEvents, int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority) override
+	{
+		return Handle->ReadData(OutCompletionEvents, Offset, BytesToRead, Priority);
+	}
+
+	virtual FGraphEventRef PreloadData(const FFileCachePreloadEntry* PreloadEntries, int32 NumEntries, int64 InOffset, EAsyncIOPriorityAndFlags Priority) override
+	{
+		return Handle->PreloadData(PreloadEntries, NumEntries, InOffset, Priority);
+	}
+
+	virtual void ReleasePreloadedData(const FFileCachePreloadEntry* PreloadEntries, int32 NumEntries, int64 InOffset) override
+	{
+		Handle->ReleasePreloadedData(PreloadEntries, NumEntries, InOffset);
+	}
+
+	virtual void PrefetchData(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority) override
+	{
+		Handle->PrefetchData(Offset, BytesToRead, Priority);
+	}
+
+	virtual void WaitAll() override
+	{
+		Handle->WaitAll();
+	}
+
+private:
+	FSharedFileCacheHandle(FString&& InKey, FFileCacheHandle* InHandle)
+		: Key(MoveTemp(InKey))
+		, Handle(InHandle)
+	{
+	}
+
+	FString Key;
+	FFileCacheHandle* Handle;
+};
+
 void IFileCacheHandle::EvictAll()
 {
 	GetCache().EvictAll();
@@ -1118,6 +1330,11 @@ IFileCacheHandle* IFileCacheHandle::CreateFileCacheHandle(const TCHAR* InFileNam
 {
 	SCOPE_CYCLE_COUNTER(STAT_SFC_CreateHandle);
 
+	if (GShareFileCacheHandles)
+	{
+		return FSharedFileCacheHandle::Create(InFileName);
+	}
+
 	IAsyncReadFileHandle* FileHandle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(InFileName);
 	if (!FileHandle)
 	{
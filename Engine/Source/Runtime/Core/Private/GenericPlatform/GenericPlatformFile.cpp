@@ -10,6 +10,9 @@
 #include "Templates/UniquePtr.h"
 #include "Misc/ScopeLock.h"
 #include "HAL/LowLevelMemTracker.h"
+#include "Async/ParallelFor.h"
+#include "Templates/Atomic.h"
+#include "Async/Async.h"
 
 #include "Async/AsyncFileHandle.h"
 #include "Async/MappedFileHandle.h"
@@ -441,6 +444,148 @@ IAsyncReadFileHandle* IPlatformFile::OpenAsyncRead(const TCHAR* Filename)
 	return new FGenericAsyncReadFileHandle(this, Filename);
 }
 
+class FGenericAsyncWriteFileHandle;
+
+class FGenericWriteWorker : public FNonAbandonableTask
+{
+	FGenericAsyncWriteFileHandle& Owner;
+public:
+	FGenericWriteWorker(FGenericAsyncWriteFileHandle* InOwner)
+		: Owner(*InOwner)
+	{
+	}
+	void DoWork();
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FGenericWriteWorker, STATGROUP_ThreadPoolAsyncTasks);
+	}
+};
+
+class FGenericAsyncWriteFileHandle final : public IAsyncWriteFileHandle
+{
+	/** Past this much data waiting to be written, Write waits for the writes in flight */
+	static const int32 MaxPendingBytes = 16 * 1024 * 1024;
+
+	TUniquePtr<IFileHandle> FileHandle;
+	EAsyncWriteSyncPolicy SyncPolicy;
+	TUniquePtr<FAsyncTask<FGenericWriteWorker>> Task;
+
+	FCriticalSection PendingCritical;
+	/** Data of the Write calls since the worker took the previous batch, written with a single write of the file */
+	TArray<uint8> PendingData;
+	TArray<FAsyncWriteCallback> PendingCallbacks;
+	/** Only used by the worker, swapped with PendingData so both allocations are reused */
+	TArray<uint8> WritingData;
+	TArray<FAsyncWriteCallback> WritingCallbacks;
+	bool bWorkerActive;
+	bool bFailed;
+
+public:
+	FGenericAsyncWriteFileHandle(IFileHandle* InFileHandle, EAsyncWriteSyncPolicy InSyncPolicy)
+		: FileHandle(InFileHandle)
+		, SyncPolicy(InSyncPolicy)
+		, bWorkerActive(false)
+		, bFailed(false)
+	{
+		Task = MakeUnique<FAsyncTask<FGenericWriteWorker>>(this);
+	}
+	~FGenericAsyncWriteFileHandle()
+	{
+		Flush(SyncPolicy == EAsyncWriteSyncPolicy::OnClose);
+	}
+
+	virtual void Write(const uint8* Source, int64 BytesToWrite, FAsyncWriteCallback&& CompleteCallback = FAsyncWriteCallback()) override
+	{
+		check(BytesToWrite >= 0 && BytesToWrite <= MAX_int32);
+		bool bStartWorker = false;
+		bool bWaitForWorker = false;
+		{
+			FScopeLock Lock(&PendingCritical);
+			PendingData.Append(Source, (int32)BytesToWrite);
+			if (CompleteCallback)
+			{
+				PendingCallbacks.Add(MoveTemp(CompleteCallback));
+			}
+			bStartWorker = !bWorkerActive;
+			bWaitForWorker = bWorkerActive && PendingData.Num() >= MaxPendingBytes;
+			bWorkerActive = true;
+		}
+
+		if (bStartWorker)
+		{
+			// The previous run already let go of the data, but the task may not be idle yet
+			Task->EnsureCompletion();
+			if (FPlatformProcess::SupportsMultithreading())
+			{
+				Task->StartBackgroundTask(GIOThreadPool);
+			}
+			else
+			{
+				Task->StartSynchronousTask();
+			}
+		}
+		else if (bWaitForWorker)
+		{
+			Task->EnsureCompletion();
+		}
+	}
+
+	virtual bool Flush(bool bFullFlush = false) override
+	{
+		// The worker only stops once everything queued before was written
+		Task->EnsureCompletion();
+		bool bResult = !bFailed;
+		if (bFullFlush && SyncPolicy != EAsyncWriteSyncPolicy::AfterEachWrite)
+		{
+			bResult = FileHandle->Flush(true) && bResult;
+		}
+		return bResult;
+	}
+
+	void WritePending()
+	{
+		for (;;)
+		{
+			{
+				FScopeLock Lock(&PendingCritical);
+				if (!PendingData.Num())
+				{
+					check(!PendingCallbacks.Num());
+					bWorkerActive = false;
+					return;
+				}
+				Exchange(WritingData, PendingData);
+				Exchange(WritingCallbacks, PendingCallbacks);
+			}
+
+			bool bSucceeded = FileHandle->Write(WritingData.GetData(), WritingData.Num());
+			if (bSucceeded && SyncPolicy == EAsyncWriteSyncPolicy::AfterEachWrite)
+			{
+				bSucceeded = FileHandle->Flush(true);
+			}
+			bFailed |= !bSucceeded;
+
+			for (FAsyncWriteCallback& Callback : WritingCallbacks)
+			{
+				Callback(bSucceeded);
+			}
+			WritingData.Reset();
+			WritingCallbacks.Reset();
+		}
+	}
+};
+
+void FGenericWriteWorker::DoWork()
+{
+	Owner.WritePending();
+}
+
+IAsyncWriteFileHandle* IPlatformFile::OpenAsyncWrite(const TCHAR* Filename, bool bAppend, EAsyncWriteSyncPolicy SyncPolicy)
+{
+	IFileHandle* FileHandle = OpenWrite(Filename, bAppend);
+	return FileHandle ? new FGenericAsyncWriteFileHandle(FileHandle, SyncPolicy) : nullptr;
+}
+
 DEFINE_STAT(STAT_AsyncFileMemory);
 DEFINE_STAT(STAT_AsyncFileHandles);
 DEFINE_STAT(STAT_AsyncFileRequests);
@@ -591,6 +736,82 @@ bool IPlatformFile::IterateDirectoryStatRecursively(const TCHAR* Directory, FDir
 	return IterateDirectoryStatRecursively(Directory, VisitorFuncWrapper);
 }
 
+bool IPlatformFile::IterateDirectoryStatRecursivelyParallel(const TCHAR* Directory, FDirectoryStatBatchVisitor& Visitor, const FDateTime& ChangedSince)
+{
+	struct FDirectoryContents
+	{
+		TArray<FString> Names;
+		TArray<FFileStatData> StatData;
+	};
+
+	const bool bFilterChanged = ChangedSince != FDateTime::MinValue();
+	FCriticalSection VisitorCritical;
+	TAtomic<bool> bContinue(true);
+	TArray<FString> Directories;
+	TArray<FString> NextDirectories;
+
+	auto GatherContents = [this, &ChangedSince, bFilterChanged](const TCHAR* InDirectory, FDirectoryContents& Contents)
+	{
+		return IterateDirectoryStat(InDirectory, [&Contents, &ChangedSince, bFilterChanged](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			if (StatData.bIsDirectory || !bFilterChanged || StatData.ModificationTime > ChangedSince)
+			{
+				Contents.Names.Emplace(FilenameOrDirectory);
+				Contents.StatData.Add(StatData);
+			}
+			return true;
+		});
+	};
+
+	auto VisitContents = [&Visitor, &VisitorCritical, &bContinue](FDirectoryContents& Contents, TArray<FString>& OutDirectories)
+	{
+		TArray<FString> Subdirectories;
+		for (int32 Index = 0; Index < Contents.Names.Num(); ++Index)
+		{
+			if (Contents.StatData[Index].bIsDirectory && Visitor.ShouldRecurse(*Contents.Names[Index]))
+			{
+				Subdirectories.Add(Contents.Names[Index]);
+			}
+		}
+
+		FScopeLock Lock(&VisitorCritical);
+		if (bContinue && Contents.Names.Num() && !Visitor.Visit(Contents.Names, Contents.StatData))
+		{
+			bContinue = false;
+		}
+		if (bContinue)
+		{
+			OutDirectories.Append(MoveTemp(Subdirectories));
+		}
+	};
+
+	// The root is enumerated on this thread so the result tells the caller whether it exists
+	FDirectoryContents RootContents;
+	if (!GatherContents(Directory, RootContents))
+	{
+		return false;
+	}
+	VisitContents(RootContents, Directories);
+
+	while (Directories.Num() && bContinue)
+	{
+		ParallelFor(Directories.Num(), [&Directories, &NextDirectories, &bContinue, &GatherContents, &VisitContents](int32 DirectoryIndex)
+		{
+			if (bContinue)
+			{
+				FDirectoryContents Contents;
+				GatherContents(*Directories[DirectoryIndex], Contents);
+				VisitContents(Contents, NextDirectories);
+			}
+		});
+
+		Swap(Directories, NextDirectories);
+		NextDirectories.Reset();
+	}
+
+	return bContinue;
+}
+
 class FFindFilesVisitor : public IPlatformFile::FDirectoryVisitor
 {
 public:
@@ -687,7 +908,7 @@ bool IPlatformFile::DeleteDirectoryRecursively(const TCHAR* Directory)
 
 bool IPlatformFile::CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags, EPlatformFileWrite WriteFlags)
 {
-	const int64 MaxBufferSize = 1024*1024;
+	const int64 MaxBufferSize = 4*1024*1024;
 
 	TUniquePtr<IFileHandle> FromFile(OpenRead(From, (ReadFlags & EPlatformFileRead::AllowWrite) != EPlatformFileRead::None));
 	if (!FromFile)
@@ -707,18 +928,49 @@ bool IPlatformFile::CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRe
 	}
 	int64 AllocSize = FMath::Min<int64>(MaxBufferSize, Size);
 	check(AllocSize);
-	uint8* Buffer = (uint8*)FMemory::Malloc(int32(AllocSize));
-	check(Buffer);
-	while (Size)
+
+	// Files larger than a buffer are double buffered, the next block is read while the previous one is written
+	const bool bDoubleBuffered = Size > AllocSize && FPlatformProcess::SupportsMultithreading();
+	uint8* Buffers[2];
+	Buffers[0] = (uint8*)FMemory::Malloc(int32(AllocSize));
+	Buffers[1] = bDoubleBuffered ? (uint8*)FMemory::Malloc(int32(AllocSize)) : nullptr;
+	check(Buffers[0]);
+
+	bool bResult = true;
+	TFuture<bool> PendingWrite;
+	for (int32 BufferIndex = 0; Size && bResult; BufferIndex ^= (bDoubleBuffered ? 1 : 0))
 	{
 		int64 ThisSize = FMath::Min<int64>(AllocSize, Size);
-		FromFile->Read(Buffer, ThisSize);
-		ToFile->Write(Buffer, ThisSize);
+		uint8* Buffer = Buffers[BufferIndex];
+		// The write reading from this buffer was waited for before the previous write started
+		bResult = FromFile->Read(Buffer, ThisSize);
+		if (PendingWrite.IsValid())
+		{
+			bResult = PendingWrite.Get() && bResult;
+		}
+		if (!bResult)
+		{
+			break;
+		}
+		if (bDoubleBuffered)
+		{
+			IFileHandle* LocalToFile = ToFile.Get();
+			PendingWrite = Async(EAsyncExecution::ThreadPool, [LocalToFile, Buffer, ThisSize]() { return LocalToFile->Write(Buffer, ThisSize); });
+		}
+		else
+		{
+			bResult = ToFile->Write(Buffer, ThisSize);
+		}
 		Size -= ThisSize;
 		check(Size >= 0);
 	}
-	FMemory::Free(Buffer);
-	return true;
+	if (PendingWrite.IsValid())
+	{
+		bResult = PendingWrite.Get() && bResult;
+	}
+	FMemory::Free(Buffers[0]);
+	FMemory::Free(Buffers[1]);
+	return bResult;
 }
 
 bool IPlatformFile::CopyDirectoryTree(const TCHAR* DestinationDirectory, const TCHAR* Source, bool bOverwriteAllExisting)
@@ -8,6 +8,7 @@
 #include "ProfilingDebugging/CountersTrace.h"
 #include "HAL/RunnableThread.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
 
 //PRAGMA_DISABLE_OPTIMIZATION
 
@@ -16,6 +17,7 @@ TRACE_DECLARE_INT_COUNTER(IoDispatcherForwardSeeks, TEXT("IoDispatcher/ForwardSe
 TRACE_DECLARE_INT_COUNTER(IoDispatcherBackwardSeeks, TEXT("IoDispatcher/BackwardSeeks"));
 TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalSeekDistance, TEXT("IoDispatcher/TotalSeekDistance"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherPendingBlocksCount, TEXT("IoDispatcher/PendingBlocksCount"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherReadTimeUs, TEXT("IoDispatcher/ReadTimeUs"));
 
 FGenericIoDispatcherEventQueue::FGenericIoDispatcherEventQueue()
 	: Event(FPlatformProcess::GetSynchEventFromPool())
@@ -37,6 +39,11 @@ void FGenericIoDispatcherEventQueue::Wait()
 	Event->Wait();
 }
 
+void FGenericIoDispatcherEventQueue::WaitFor(uint32 WaitTimeMs)
+{
+	Event->Wait(WaitTimeMs);
+}
+
 FGenericFileIoStoreImpl::FGenericFileIoStoreImpl(FGenericIoDispatcherEventQueue& InEventQueue)
 	: EventQueue(InEventQueue)
 	, PendingBlockEvent(FPlatformProcess::GetSynchEventFromPool())
@@ -189,7 +196,9 @@ uint32 FGenericFileIoStoreImpl::Run()
 			{
 				TRACE_COUNTER_INCREMENT(IoDispatcherSequentialReads);
 			}
+			const uint64 ReadStartCycles = FPlatformTime::Cycles64();
 			FileHandle->Read(BlockToRead->Buffer.Data(), BlockToRead->Size);
+			TRACE_COUNTER_ADD(IoDispatcherReadTimeUs, int64(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - ReadStartCycles) * 1000000.0));
 			TRACE_COUNTER_DECREMENT(IoDispatcherPendingBlocksCount);
 			{
 				FScopeLock _(&CompletedBlocksCritical);
@@ -18,6 +18,7 @@ public:
 	~FGenericIoDispatcherEventQueue();
 	void Notify();
 	void Wait();
+	void WaitFor(uint32 WaitTimeMs);
 	void Poll() {};
 
 private:
@@ -35,6 +36,7 @@ public:
 	void ReadBlockFromFile(FFileIoStoreReadBlock* Block);
 	void EndReadsForRequest();
 	FFileIoStoreReadBlock* GetNextCompletedBlock();
+	void ReleaseBlockBuffer(FFileIoStoreReadBlock* Block) {};
 	virtual bool Init() override;
 	virtual uint32 Run() override;
 	virtual void Stop() override;
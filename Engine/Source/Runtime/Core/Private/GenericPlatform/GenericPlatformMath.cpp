@@ -200,6 +200,13 @@ void FGenericPlatformMath::AutoTest()
 		Value >>= 32;
 		check(Value.ToInt() == 1LL);
 	}
+
+	{
+		// Montgomery modular power: 65^17 mod 3233 = 2790, and back with the private exponent 413
+		TMontgomeryModulus<256> Modulus(int256(3233LL));
+		check(Modulus.Pow(int256(65LL), int256(17LL)).ToInt() == 2790LL);
+		check(Modulus.Pow(int256(2790LL), int256(413LL)).ToInt() == 65LL);
+	}
 }
 
 #endif //WITH_DEV_AUTOMATION_TESTS
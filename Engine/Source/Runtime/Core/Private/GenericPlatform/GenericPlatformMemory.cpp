@@ -88,6 +88,8 @@ struct FGenericStatsUpdater
 	}
 };
 
+static volatile int64 GNumaNodeUsedPhysical[PLATFORM_MAX_NUMA_NODES];
+
 FGenericPlatformMemoryStats::FGenericPlatformMemoryStats()
 	: FGenericPlatformMemoryConstants( FPlatformMemory::GetConstants() )
 	, AvailablePhysical( 0 )
@@ -96,7 +98,18 @@ FGenericPlatformMemoryStats::FGenericPlatformMemoryStats()
 	, PeakUsedPhysical( 0 )
 	, UsedVirtual( 0 )
 	, PeakUsedVirtual( 0 )
-{}
+	, NumaNodeCount( FPlatformMemory::GetNumaNodeCount() )
+{
+	for (int32 Node = 0; Node < PLATFORM_MAX_NUMA_NODES; ++Node)
+	{
+		NumaNodeUsedPhysical[Node] = uint64(FPlatformAtomics::AtomicRead(&GNumaNodeUsedPhysical[Node]));
+	}
+}
+
+void FGenericPlatformMemory::UpdateNumaNodeUsage(int32 Node, int64 Delta)
+{
+	FPlatformAtomics::InterlockedAdd(&GNumaNodeUsedPhysical[FMath::Clamp(Node, 0, PLATFORM_MAX_NUMA_NODES - 1)], Delta);
+}
 
 bool FGenericPlatformMemory::bIsOOM = false;
 uint64 FGenericPlatformMemory::OOMAllocationSize = 0;
@@ -253,6 +266,12 @@ void FGenericPlatformMemory::DumpStats( class FOutputDevice& Ar )
 	Ar.CategorizedLogf(CategoryName, ELogVerbosity::Log, TEXT("Virtual Memory: %.2f MB used,  %.2f MB free, %.2f MB total"), 
 		(MemoryStats.TotalVirtual - MemoryStats.AvailableVirtual)*InvMB, MemoryStats.AvailableVirtual*InvMB, MemoryStats.TotalVirtual*InvMB);
 
+#if UE_NUMA_AWARE_ALLOCATION
+	for (uint32 Node = 0; Node < MemoryStats.NumaNodeCount; ++Node)
+	{
+		Ar.CategorizedLogf(CategoryName, ELogVerbosity::Log, TEXT("NUMA Node %u: %.2f MB allocated"), Node, MemoryStats.NumaNodeUsedPhysical[Node]*InvMB);
+	}
+#endif
 }
 
 void FGenericPlatformMemory::DumpPlatformAndAllocatorStats( class FOutputDevice& Ar )
@@ -1175,6 +1175,55 @@ int32 FGenericPlatformMisc::NumberOfCoresIncludingHyperthreads()
 	return FPlatformMisc::NumberOfCores();
 }
 
+void FCPUTopology::Finalize()
+{
+	// Insertion sort by the lowest logical processor, there are few cores
+	for (int32 Index = 1; Index < NumCores; ++Index)
+	{
+		for (int32 Other = Index; Other > 0 && FMath::CountTrailingZeros64(CoreMasks[Other]) < FMath::CountTrailingZeros64(CoreMasks[Other - 1]); --Other)
+		{
+			Swap(CoreMasks[Other], CoreMasks[Other - 1]);
+			Swap(CorePerformanceClasses[Other], CorePerformanceClasses[Other - 1]);
+		}
+	}
+
+	if (NumCacheDomains == 0)
+	{
+		NumCacheDomains = 1;
+		CacheDomainMasks[0] = 0;
+	}
+	for (int32 Index = 0; Index < NumCores; ++Index)
+	{
+		CoreCacheDomains[Index] = 0;
+		for (int32 Domain = 0; Domain < NumCacheDomains; ++Domain)
+		{
+			if (CacheDomainMasks[Domain] & CoreMasks[Index])
+			{
+				CoreCacheDomains[Index] = Domain;
+				break;
+			}
+		}
+		CacheDomainMasks[CoreCacheDomains[Index]] |= CoreMasks[Index];
+	}
+}
+
+const FCPUTopology& FGenericPlatformMisc::GetCPUTopology()
+{
+	static FCPUTopology Topology = []()
+	{
+		FCPUTopology Result;
+		Result.NumCores = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, (int32)FCPUTopology::MaxCores);
+		for (int32 Index = 0; Index < Result.NumCores; ++Index)
+		{
+			Result.CoreMasks[Index] = uint64(1) << Index;
+			Result.CorePerformanceClasses[Index] = 0;
+		}
+		Result.Finalize();
+		return Result;
+	}();
+	return Topology;
+}
+
 int32 FGenericPlatformMisc::NumberOfWorkerThreadsToSpawn()
 {
 	static int32 MaxGameThreads = 4;
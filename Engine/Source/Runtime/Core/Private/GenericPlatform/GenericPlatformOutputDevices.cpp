@@ -126,7 +126,9 @@ class FOutputDevice* FGenericPlatformOutputDevices::GetLog()
 #else
 				const bool bDisableBackup = true;
 #endif
-				LogDevice = MakeUnique<FOutputDeviceFile>(nullptr, bDisableBackup);
+				TUniquePtr<FOutputDeviceFile> FileDevice = MakeUnique<FOutputDeviceFile>(nullptr, bDisableBackup);
+				FileDevice->SetWriteOptions(FOutputDeviceFileWriteOptions::FromCommandLine());
+				LogDevice = MoveTemp(FileDevice);
 			}
 		}
 
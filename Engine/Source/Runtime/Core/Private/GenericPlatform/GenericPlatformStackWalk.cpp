@@ -156,6 +156,27 @@ uint32 FGenericPlatformStackWalk::CaptureStackBackTrace( uint64* BackTrace, uint
 	return 0;
 }
 
+FORCENOINLINE uint32 FGenericPlatformStackWalk::CaptureStackBackTraceFast( uint64* BackTrace, uint32 MaxDepth )
+{
+	if (BackTrace == nullptr || MaxDepth == 0)
+	{
+		return 0;
+	}
+
+	// There is no faster way here, only this function's own frame is removed so the result matches CaptureStackBackTrace's
+	const uint32 MaxFallbackDepth = 256;
+	uint64 FallbackBackTrace[MaxFallbackDepth + 1];
+	const uint32 Depth = FPlatformStackWalk::CaptureStackBackTrace(FallbackBackTrace, FMath::Min(MaxDepth, MaxFallbackDepth) + 1);
+	if (Depth < 2)
+	{
+		return 0;
+	}
+
+	BackTrace[0] = FallbackBackTrace[0];
+	FMemory::Memcpy(BackTrace + 1, FallbackBackTrace + 2, (Depth - 2) * sizeof(uint64));
+	return Depth - 1;
+}
+
 uint32 FGenericPlatformStackWalk::CaptureThreadStackBackTrace(uint64 ThreadId, uint64* BackTrace, uint32 MaxDepth)
 {
 	return 0;
@@ -2,6 +2,7 @@
 
 #include "GenericPlatform/GenericPlatformStricmp.h"
 #include "Misc/Char.h"
+#include "String/VectorizedAscii.h"
 
 static constexpr uint8 LowerAscii[128] = {
 	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
@@ -88,11 +89,120 @@ int32 StrnicmpImpl(const CharType1* String1, const CharType2* String2, SIZE_T Co
 	return 0;
 }
 
-int32 FGenericPlatformStricmp::Stricmp(const ANSICHAR* Str1, const ANSICHAR* Str2) { return StricmpImpl(Str1, Str2); }
-int32 FGenericPlatformStricmp::Stricmp(const WIDECHAR* Str1, const WIDECHAR* Str2) { return StricmpImpl(Str1, Str2); }
-int32 FGenericPlatformStricmp::Stricmp(const UTF8CHAR* Str1, const UTF8CHAR* Str2) { return StricmpImpl(Str1, Str2); }
-int32 FGenericPlatformStricmp::Stricmp(const UTF16CHAR* Str1, const UTF16CHAR* Str2) { return StricmpImpl(Str1, Str2); }
-int32 FGenericPlatformStricmp::Stricmp(const UTF32CHAR* Str1, const UTF32CHAR* Str2) { return StricmpImpl(Str1, Str2); }
+// Vectors are only loaded where they stay within the page of the strings, but they still read past the terminators,
+// which the address sanitizer would report
+#define UE_VECTORIZED_STRICMP (UE_VECTORIZED_ASCII && !USING_ADDRESS_SANITISER)
+
+/**
+ * Compares strings of the same character type 16 bytes at a time, lower casing their ASCII letters, until their
+ * lower cased characters differ or the first one ends. The remaining characters are left to StrnicmpImpl.
+ *
+ * @return false if the comparison has to go on after the NumPerVector characters at String1 and String2
+ */
+template<typename CharType>
+FORCEINLINE bool SkipSameChars(const CharType*& String1, const CharType*& String2)
+{
+#if UE_VECTORIZED_STRICMP
+	using namespace UE4VectorizedAscii_Private;
+
+	const FByteVector Chars1 = FlipCase<sizeof(CharType)>(LoadBytes(String1), 'A');
+	const FByteVector Chars2 = FlipCase<sizeof(CharType)>(LoadBytes(String2), 'A');
+	if (const uint64 Mask = GetDifferOrZeroMask<sizeof(CharType)>(Chars1, Chars2))
+	{
+		const int32 Index = GetFirstCharIndex<sizeof(CharType)>(Mask);
+		String1 += Index;
+		String2 += Index;
+		return true;
+	}
+	String1 += 16 / sizeof(CharType);
+	String2 += 16 / sizeof(CharType);
+#endif
+	return false;
+}
+
+template<typename CharType>
+int32 VectorizedStricmpImpl(const CharType* String1, const CharType* String2)
+{
+#if UE_VECTORIZED_STRICMP
+	using namespace UE4VectorizedAscii_Private;
+	constexpr SIZE_T NumPerVector = 16 / sizeof(CharType);
+
+	for (;;)
+	{
+		if (CanLoadBytesWithinPage(String1) && CanLoadBytesWithinPage(String2))
+		{
+			if (SkipSameChars(String1, String2))
+			{
+				// Decided by the first character
+				return StrnicmpImpl(String1, String2, 1);
+			}
+		}
+		else
+		{
+			// Near the end of a page, where the strings may end, go one character at a time until both are past it
+			if (int32 Diff = StrnicmpImpl(String1, String2, NumPerVector))
+			{
+				return Diff;
+			}
+			for (SIZE_T Index = 0; Index < NumPerVector; ++Index)
+			{
+				if (String1[Index] == 0)
+				{
+					return 0;
+				}
+			}
+			String1 += NumPerVector;
+			String2 += NumPerVector;
+		}
+	}
+#else
+	return StricmpImpl(String1, String2);
+#endif
+}
+
+template<typename CharType>
+int32 VectorizedStrnicmpImpl(const CharType* String1, const CharType* String2, SIZE_T Count)
+{
+#if UE_VECTORIZED_STRICMP
+	using namespace UE4VectorizedAscii_Private;
+	constexpr SIZE_T NumPerVector = 16 / sizeof(CharType);
+
+	while (Count >= NumPerVector)
+	{
+		if (CanLoadBytesWithinPage(String1) && CanLoadBytesWithinPage(String2))
+		{
+			if (SkipSameChars(String1, String2))
+			{
+				return StrnicmpImpl(String1, String2, 1);
+			}
+		}
+		else
+		{
+			if (int32 Diff = StrnicmpImpl(String1, String2, NumPerVector))
+			{
+				return Diff;
+			}
+			for (SIZE_T Index = 0; Index < NumPerVector; ++Index)
+			{
+				if (String1[Index] == 0)
+				{
+					return 0;
+				}
+			}
+			String1 += NumPerVector;
+			String2 += NumPerVector;
+		}
+		Count -= NumPerVector;
+	}
+#endif
+	return StrnicmpImpl(String1, String2, Count);
+}
+
+int32 FGenericPlatformStricmp::Stricmp(const ANSICHAR* Str1, const ANSICHAR* Str2) { return VectorizedStricmpImpl(Str1, Str2); }
+int32 FGenericPlatformStricmp::Stricmp(const WIDECHAR* Str1, const WIDECHAR* Str2) { return VectorizedStricmpImpl(Str1, Str2); }
+int32 FGenericPlatformStricmp::Stricmp(const UTF8CHAR* Str1, const UTF8CHAR* Str2) { return VectorizedStricmpImpl(Str1, Str2); }
+int32 FGenericPlatformStricmp::Stricmp(const UTF16CHAR* Str1, const UTF16CHAR* Str2) { return VectorizedStricmpImpl(Str1, Str2); }
+int32 FGenericPlatformStricmp::Stricmp(const UTF32CHAR* Str1, const UTF32CHAR* Str2) { return VectorizedStricmpImpl(Str1, Str2); }
 int32 FGenericPlatformStricmp::Stricmp(const ANSICHAR* Str1, const WIDECHAR* Str2) { return StricmpImpl(Str1, Str2); }
 int32 FGenericPlatformStricmp::Stricmp(const ANSICHAR* Str1, const UTF8CHAR* Str2) { return StricmpImpl(Str1, Str2); }
 int32 FGenericPlatformStricmp::Stricmp(const ANSICHAR* Str1, const UTF16CHAR* Str2) { return StricmpImpl(Str1, Str2); }
@@ -101,8 +211,8 @@ int32 FGenericPlatformStricmp::Stricmp(const WIDECHAR* Str1, const ANSICHAR* Str
 int32 FGenericPlatformStricmp::Stricmp(const UTF8CHAR* Str1, const ANSICHAR* Str2) { return StricmpImpl(Str1, Str2); }
 int32 FGenericPlatformStricmp::Stricmp(const UTF16CHAR* Str1, const ANSICHAR* Str2) { return StricmpImpl(Str1, Str2); }
 int32 FGenericPlatformStricmp::Stricmp(const UTF32CHAR* Str1, const ANSICHAR* Str2) { return StricmpImpl(Str1, Str2); }
-int32 FGenericPlatformStricmp::Strnicmp(const ANSICHAR* Str1, const ANSICHAR* Str2, SIZE_T Count) { return StrnicmpImpl(Str1, Str2, Count); }
-int32 FGenericPlatformStricmp::Strnicmp(const WIDECHAR* Str1, const WIDECHAR* Str2, SIZE_T Count) { return StrnicmpImpl(Str1, Str2, Count); }
+int32 FGenericPlatformStricmp::Strnicmp(const ANSICHAR* Str1, const ANSICHAR* Str2, SIZE_T Count) { return VectorizedStrnicmpImpl(Str1, Str2, Count); }
+int32 FGenericPlatformStricmp::Strnicmp(const WIDECHAR* Str1, const WIDECHAR* Str2, SIZE_T Count) { return VectorizedStrnicmpImpl(Str1, Str2, Count); }
 int32 FGenericPlatformStricmp::Strnicmp(const ANSICHAR* Str1, const WIDECHAR* Str2, SIZE_T Count) { return StrnicmpImpl(Str1, Str2, Count); }
 int32 FGenericPlatformStricmp::Strnicmp(const WIDECHAR* Str1, const ANSICHAR* Str2, SIZE_T Count) { return StrnicmpImpl(Str1, Str2, Count); }
 
@@ -137,6 +247,7 @@ template<typename CharType>
 void TestStricmp(const CharType* Str1, const CharType* Str2, FAutomationTestBase& Test)
 {
 	Test.TestEqual("Stricmp()", FMath::Sign(StricmpImpl(Str1, Str2)), FMath::Sign(StricmpExpected(Str1, Str2)));
+	Test.TestEqual("Vectorized Stricmp()", FMath::Sign(FGenericPlatformStricmp::Stricmp(Str1, Str2)), FMath::Sign(StricmpExpected(Str1, Str2)));
 }
 
 template<typename CharType>
@@ -169,6 +280,31 @@ void RunStricmpTests(FAutomationTestBase& Test)
 	TestStricmp(HelloLower, HelloMixed1, Test);
 	TestStricmp(HelloLower, HelloMixed2, Test);
 	TestStricmp(HelloLower, Hell0, Test);
+
+	// Test strings longer than a vector, differing or ending at every position, with non-ASCII characters in them
+	const int32 LongLength = 40;
+	CharType Long1[LongLength + 1];
+	CharType Long2[LongLength + 1];
+	for (int32 Position = 0; Position < LongLength; ++Position)
+	{
+		for (int32 Index = 0; Index < LongLength; ++Index)
+		{
+			Long1[Index] = (CharType)('A' + Index % 26);
+			Long2[Index] = (CharType)('a' + Index % 26);
+		}
+		Long1[LongLength] = Long2[LongLength] = '\0';
+		TestStricmp(Long1, Long2, Test);
+
+		Long2[Position] = (CharType)'[';
+		TestStricmp(Long1, Long2, Test);
+		Long2[Position] = (CharType)0xE9;
+		TestStricmp(Long1, Long2, Test);
+		Long2[Position] = '\0';
+		TestStricmp(Long1, Long2, Test);
+		Long1[Position] = '\0';
+		TestStricmp(Long1, Long2, Test);
+		Test.TestEqual("Vectorized Strnicmp()", FGenericPlatformStricmp::Strnicmp(Long1, Long2, LongLength), 0);
+	}
 }
 
 bool FGenericPlatformStricmpTest::RunTest(const FString& Parameters)
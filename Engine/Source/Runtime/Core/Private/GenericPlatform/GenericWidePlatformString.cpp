@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GenericPlatform/GenericWidePlatformString.h"
+#include "Algo/Impl/VectorizedFind.h"
 #include "HAL/UnrealMemory.h"
 #include "Templates/UnrealTemplate.h"
 #include "Logging/LogCategory.h"
@@ -77,6 +78,37 @@ WIDECHAR* FGenericWidePlatformString::Strcat(WIDECHAR* Dest, SIZE_T DestCount, c
 	return Dest;
 }
 
+const WIDECHAR* FGenericWidePlatformString::Strstr(const WIDECHAR* String, const WIDECHAR* Find)
+{
+	const WIDECHAR FirstChar = *Find++;
+	if (FirstChar == 0)
+	{
+		return String;
+	}
+
+	// Candidates are found with a vectorized scan for the first char, then the rest is compared
+	const size_t Length = Strlen(Find);
+	for (;;)
+	{
+		String = AlgoImpl::FindCharOrTerminator(String, FirstChar);
+		if (*String == 0)
+		{
+			return nullptr;
+		}
+		if (Strncmp(String + 1, Find, Length) == 0)
+		{
+			return String;
+		}
+		++String;
+	}
+}
+
+const WIDECHAR* FGenericWidePlatformString::Strchr(const WIDECHAR* String, WIDECHAR C)
+{
+	String = AlgoImpl::FindCharOrTerminator(String, C);
+	return (*String == C) ? String : nullptr;
+}
+
 int32 FGenericWidePlatformString::Strtoi( const WIDECHAR* Start, WIDECHAR** End, int32 Base )
 {
 	if (End == nullptr)
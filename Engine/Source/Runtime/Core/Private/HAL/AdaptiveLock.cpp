@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/AdaptiveLock.h"
+#include "HAL/AddressWait.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Math/UnrealMathUtility.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+#endif
+
+TRACE_DECLARE_INT_COUNTER(AdaptiveLockContendedAcquires, TEXT("AdaptiveLock/ContendedAcquires"));
+TRACE_DECLARE_INT_COUNTER(AdaptiveLockParks, TEXT("AdaptiveLock/Parks"));
+
+namespace UE4AdaptiveLock_Private
+{
+	/** Spins before parking, each one pauses twice as long as the one before up to MaxPausesPerSpin */
+	static constexpr int32 NumSpins = 12;
+	static constexpr int32 MaxPausesPerSpin = 64;
+
+#if ADAPTIVE_LOCK_STATS
+	static FThreadSafeCounter64 GNumContendedAcquires;
+	static FThreadSafeCounter64 GNumSpinAcquires;
+	static FThreadSafeCounter64 GNumParks;
+#endif
+
+	static FORCEINLINE void OnContended()
+	{
+#if ADAPTIVE_LOCK_STATS
+		TRACE_COUNTER_SET(AdaptiveLockContendedAcquires, GNumContendedAcquires.Add(1) + 1);
+#endif
+	}
+
+	static FORCEINLINE void OnSpinAcquire()
+	{
+#if ADAPTIVE_LOCK_STATS
+		GNumSpinAcquires.Add(1);
+#endif
+	}
+
+	static FORCEINLINE void OnPark()
+	{
+#if ADAPTIVE_LOCK_STATS
+		TRACE_COUNTER_SET(AdaptiveLockParks, GNumParks.Add(1) + 1);
+#endif
+	}
+
+	static FORCEINLINE void CpuPause()
+	{
+#if PLATFORM_CPU_X86_FAMILY
+		_mm_pause();
+#elif PLATFORM_CPU_ARM_FAMILY && (defined(__clang__) || defined(__GNUC__))
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+	/** @return true if the lock should be tried again rather than parking, after having backed off */
+	static bool SpinWithBackoff(int32& SpinCount)
+	{
+		// Spinning can not help while the owner waits for this core
+		static const bool bCanSpin = FPlatformMisc::NumberOfCoresIncludingHyperthreads() > 1;
+		if (!bCanSpin || SpinCount >= NumSpins)
+		{
+			return false;
+		}
+		const int32 NumPauses = FMath::Min(1 << SpinCount, MaxPausesPerSpin);
+		for (int32 Index = 0; Index < NumPauses; ++Index)
+		{
+			CpuPause();
+		}
+		++SpinCount;
+		return true;
+	}
+}
+
+FAdaptiveLockStats FAdaptiveLockStats::Get()
+{
+	FAdaptiveLockStats Stats;
+#if ADAPTIVE_LOCK_STATS
+	using namespace UE4AdaptiveLock_Private;
+	Stats.NumContendedAcquires = GNumContendedAcquires.GetValue();
+	Stats.NumSpinAcquires = GNumSpinAcquires.GetValue();
+	Stats.NumParks = GNumParks.GetValue();
+#endif
+	return Stats;
+}
+
+void FAdaptiveMutex::LockSlow()
+{
+	using namespace UE4AdaptiveLock_Private;
+	OnContended();
+
+	for (int32 SpinCount = 0; SpinWithBackoff(SpinCount);)
+	{
+		if (FPlatformAtomics::AtomicRead(&State) == Unlocked && TryLock())
+		{
+			OnSpinAcquire();
+			return;
+		}
+	}
+
+	// Whoever takes the lock from here on marks it as having waiters, there may be more parked behind it
+	int8 Previous = FPlatformAtomics::InterlockedExchange(&State, LockedWithWaiters);
+	while (Previous != Unlocked)
+	{
+		OnPark();
+		const int8 CompareState = LockedWithWaiters;
+		FAddressWait::Wait(&State, &CompareState, sizeof(State));
+		Previous = FPlatformAtomics::InterlockedExchange(&State, LockedWithWaiters);
+	}
+}
+
+void FAdaptiveMutex::UnlockSlow()
+{
+	FAddressWait::WakeOne(&State);
+}
+
+void FAdaptiveRWLock::ReadLockSlow()
+{
+	using namespace UE4AdaptiveLock_Private;
+	OnContended();
+
+	for (int32 SpinCount = 0;;)
+	{
+		int32 Current = FPlatformAtomics::AtomicRead(&State);
+		if (!(Current & (WriterBit | WriterWaitingBit)))
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&State, Current + ReaderUnit, Current) == Current)
+			{
+				if (SpinCount)
+				{
+					OnSpinAcquire();
+				}
+				return;
+			}
+			continue;
+		}
+		if (SpinWithBackoff(SpinCount))
+		{
+			continue;
+		}
+		if (!(Current & ReaderWaitingBit))
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&State, Current | ReaderWaitingBit, Current) != Current)
+			{
+				continue;
+			}
+			Current |= ReaderWaitingBit;
+		}
+		OnPark();
+		FAddressWait::Wait(&State, &Current, sizeof(State));
+	}
+}
+
+void FAdaptiveRWLock::ReadUnlockSlow()
+{
+	// The last reader out wakes the waiters, unless someone took the lock in between and has to do it instead
+	int32 Current = FPlatformAtomics::AtomicRead(&State);
+	while (!(Current & (WriterBit | ReaderMask)) && (Current & WaitingBits))
+	{
+		const int32 Previous = FPlatformAtomics::InterlockedCompareExchange(&State, Current & ~WaitingBits, Current);
+		if (Previous == Current)
+		{
+			FAddressWait::WakeAll(&State);
+			return;
+		}
+		Current = Previous;
+	}
+}
+
+void FAdaptiveRWLock::WriteLockSlow()
+{
+	using namespace UE4AdaptiveLock_Private;
+	OnContended();
+
+	for (int32 SpinCount = 0;;)
+	{
+		int32 Current = FPlatformAtomics::AtomicRead(&State);
+		if (!(Current & (WriterBit | ReaderMask)))
+		{
+			// The waiting bits stay, whoever is parked gets woken when this writer unlocks
+			if (FPlatformAtomics::InterlockedCompareExchange(&State, Current | WriterBit, Current) == Current)
+			{
+				if (SpinCount)
+				{
+					OnSpinAcquire();
+				}
+				return;
+			}
+			continue;
+		}
+		if (SpinWithBackoff(SpinCount))
+		{
+			continue;
+		}
+		if (!(Current & WriterWaitingBit))
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&State, Current | WriterWaitingBit, Current) != Current)
+			{
+				continue;
+			}
+			Current |= WriterWaitingBit;
+		}
+		OnPark();
+		FAddressWait::Wait(&State, &Current, sizeof(State));
+	}
+}
+
+void FAdaptiveRWLock::WriteUnlockSlow()
+{
+	FAddressWait::WakeAll(&State);
+}
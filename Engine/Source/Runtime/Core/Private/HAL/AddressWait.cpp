@@ -0,0 +1,246 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/AddressWait.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+#include "Containers/Array.h"
+#include "HAL/UnrealMemory.h"
+
+#define ADDRESS_WAIT_USE_FUTEX (PLATFORM_LINUX || PLATFORM_ANDROID)
+
+#if PLATFORM_WINDOWS
+	#include "Windows/WindowsHWrapper.h"
+#elif ADDRESS_WAIT_USE_FUTEX
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <limits.h>
+#endif
+
+namespace UE4AddressWait_Private
+{
+#if !ADDRESS_WAIT_USE_FUTEX
+	static bool IsValueEqual(const volatile void* Address, const void* CompareAddress, int32 Size)
+	{
+		switch (Size)
+		{
+		case 1: return FPlatformAtomics::AtomicRead((volatile const int8*)Address) == *(const int8*)CompareAddress;
+		case 2: return FPlatformAtomics::AtomicRead((volatile const int16*)Address) == *(const int16*)CompareAddress;
+		default: return FPlatformAtomics::AtomicRead((volatile const int32*)Address) == *(const int32*)CompareAddress;
+		}
+	}
+
+	/** A thread parked in the table, lives on the stack of the thread */
+	struct FWaiter
+	{
+		const volatile void* Address;
+		FEvent* Event;
+		FWaiter* Next;
+	};
+
+	/** Waiters whose addresses hash to the same slot, in the order they started waiting */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FBucket
+	{
+		FCriticalSection Lock;
+		FWaiter* Head = nullptr;
+		FWaiter* Tail = nullptr;
+	};
+
+	static FBucket& GetBucket(const volatile void* Address)
+	{
+		// Constructed on first use, locks may be used during static initialization
+		static FBucket Buckets[256];
+		return Buckets[(uint64(UPTRINT(Address)) * 0x9E3779B97F4A7C15ull) >> 56];
+	}
+
+	static void WaitInTable(const volatile void* Address, const void* CompareAddress, int32 Size)
+	{
+		FBucket& Bucket = GetBucket(Address);
+		FWaiter Waiter = { Address, FPlatformProcess::GetSynchEventFromPool(false), nullptr };
+		bool bWait = false;
+		{
+			// Wakers change the value before they take the lock, so checking it under the lock can not miss a wake
+			FScopeLock Lock(&Bucket.Lock);
+			if (IsValueEqual(Address, CompareAddress, Size))
+			{
+				if (Bucket.Tail)
+				{
+					Bucket.Tail->Next = &Waiter;
+				}
+				else
+				{
+					Bucket.Head = &Waiter;
+				}
+				Bucket.Tail = &Waiter;
+				bWait = true;
+			}
+		}
+		if (bWait)
+		{
+			Waiter.Event->Wait();
+		}
+		FPlatformProcess::ReturnSynchEventToPool(Waiter.Event);
+	}
+
+	static void WakeInTable(const volatile void* Address, bool bWakeAll)
+	{
+		FBucket& Bucket = GetBucket(Address);
+		TArray<FEvent*, TInlineAllocator<8>> EventsToTrigger;
+		{
+			FScopeLock Lock(&Bucket.Lock);
+			FWaiter* Previous = nullptr;
+			for (FWaiter* Waiter = Bucket.Head; Waiter;)
+			{
+				FWaiter* Next = Waiter->Next;
+				if (Waiter->Address == Address)
+				{
+					(Previous ? Previous->Next : Bucket.Head) = Next;
+					if (Bucket.Tail == Waiter)
+					{
+						Bucket.Tail = Previous;
+					}
+					// The waiter stays blocked, and its event valid, until it is triggered below
+					EventsToTrigger.Add(Waiter->Event);
+					if (!bWakeAll)
+					{
+						break;
+					}
+				}
+				else
+				{
+					Previous = Waiter;
+				}
+				Waiter = Next;
+			}
+		}
+		for (FEvent* Event : EventsToTrigger)
+		{
+			Event->Trigger();
+		}
+	}
+#endif
+
+#if PLATFORM_WINDOWS
+	/** WaitOnAddress is Windows 8 and later, it is looked up rather than linked */
+	struct FWaitOnAddressFunctions
+	{
+		typedef BOOL (WINAPI *FWaitOnAddress)(volatile VOID* Address, PVOID CompareAddress, SIZE_T AddressSize, DWORD Milliseconds);
+		typedef VOID (WINAPI *FWakeByAddress)(PVOID Address);
+
+		FWaitOnAddress WaitOnAddress = nullptr;
+		FWakeByAddress WakeByAddressSingle = nullptr;
+		FWakeByAddress WakeByAddressAll = nullptr;
+
+		FWaitOnAddressFunctions()
+		{
+			if (HMODULE Module = LoadLibraryW(L"api-ms-win-core-synch-l1-2-0.dll"))
+			{
+				WaitOnAddress = (FWaitOnAddress)(void*)GetProcAddress(Module, "WaitOnAddress");
+				WakeByAddressSingle = (FWakeByAddress)(void*)GetProcAddress(Module, "WakeByAddressSingle");
+				WakeByAddressAll = (FWakeByAddress)(void*)GetProcAddress(Module, "WakeByAddressAll");
+				if (!WaitOnAddress || !WakeByAddressSingle || !WakeByAddressAll)
+				{
+					WaitOnAddress = nullptr;
+				}
+			}
+		}
+
+		static const FWaitOnAddressFunctions& Get()
+		{
+			static FWaitOnAddressFunctions Functions;
+			return Functions;
+		}
+	};
+#elif ADDRESS_WAIT_USE_FUTEX
+	static volatile void* GetFutexWord(const volatile void* Address)
+	{
+		return (volatile void*)(UPTRINT(Address) & ~UPTRINT(3));
+	}
+
+	static void FutexWait(const volatile void* Address, const void* CompareAddress, int32 Size)
+	{
+		// Values smaller than a word wait on the word holding them, with the other bytes the way they are now
+		volatile void* Word = GetFutexWord(Address);
+		const uint32 Shift = uint32(UPTRINT(Address) - UPTRINT(Word)) * 8;
+		const uint32 Mask = (Size == 4 ? 0xffffffffu : (1u << (Size * 8)) - 1) << Shift;
+		uint32 Compare = 0;
+		FMemory::Memcpy(&Compare, CompareAddress, Size);
+		const uint32 Current = (uint32)FPlatformAtomics::AtomicRead((volatile const int32*)Word);
+		const uint32 Expected = (Current & ~Mask) | (Compare << Shift);
+		if (Current == Expected)
+		{
+			syscall(SYS_futex, Word, FUTEX_WAIT_PRIVATE, Expected, nullptr, nullptr, 0);
+		}
+	}
+
+	static void FutexWake(const volatile void* Address, bool bWakeAll)
+	{
+		// Waiters on the other bytes of the word share the futex, waking one of them could miss the right one
+		volatile void* Word = GetFutexWord(Address);
+		const int32 NumToWake = bWakeAll || Word != Address ? INT_MAX : 1;
+		syscall(SYS_futex, Word, FUTEX_WAKE_PRIVATE, NumToWake, nullptr, nullptr, 0);
+	}
+#endif
+}
+
+void FAddressWait::Wait(const volatile void* Address, const void* CompareAddress, int32 Size)
+{
+	using namespace UE4AddressWait_Private;
+	checkSlow((Size == 1 || Size == 2 || Size == 4) && (UPTRINT(Address) & (Size - 1)) == 0);
+
+#if ADDRESS_WAIT_USE_FUTEX
+	FutexWait(Address, CompareAddress, Size);
+#else
+#if PLATFORM_WINDOWS
+	const FWaitOnAddressFunctions& Functions = FWaitOnAddressFunctions::Get();
+	if (Functions.WaitOnAddress)
+	{
+		Functions.WaitOnAddress((volatile VOID*)Address, (PVOID)CompareAddress, Size, INFINITE);
+		return;
+	}
+#endif
+	WaitInTable(Address, CompareAddress, Size);
+#endif
+}
+
+void FAddressWait::WakeOne(const volatile void* Address)
+{
+	using namespace UE4AddressWait_Private;
+
+#if ADDRESS_WAIT_USE_FUTEX
+	FutexWake(Address, false);
+#else
+#if PLATFORM_WINDOWS
+	const FWaitOnAddressFunctions& Functions = FWaitOnAddressFunctions::Get();
+	if (Functions.WaitOnAddress)
+	{
+		Functions.WakeByAddressSingle((PVOID)Address);
+		return;
+	}
+#endif
+	WakeInTable(Address, false);
+#endif
+}
+
+void FAddressWait::WakeAll(const volatile void* Address)
+{
+	using namespace UE4AddressWait_Private;
+
+#if ADDRESS_WAIT_USE_FUTEX
+	FutexWake(Address, true);
+#else
+#if PLATFORM_WINDOWS
+	const FWaitOnAddressFunctions& Functions = FWaitOnAddressFunctions::Get();
+	if (Functions.WaitOnAddress)
+	{
+		Functions.WakeByAddressAll((PVOID)Address);
+		return;
+	}
+#endif
+	WakeInTable(Address, true);
+#endif
+}
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/CPUFeatures.h"
+#include "CoreGlobals.h"
+#include "Logging/LogMacros.h"
+#include "Containers/UnrealString.h"
+
+#if PLATFORM_HAS_CPUID
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#include <immintrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace UE4CPUFeatures_Private
+{
+#if PLATFORM_HAS_CPUID
+	static void CpuId(uint32 Leaf, uint32 SubLeaf, uint32 (&OutInfo)[4])
+	{
+	#if defined(_MSC_VER)
+		int Info[4];
+		__cpuidex(Info, int(Leaf), int(SubLeaf));
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			OutInfo[Index] = uint32(Info[Index]);
+		}
+	#else
+		__cpuid_count(Leaf, SubLeaf, OutInfo[0], OutInfo[1], OutInfo[2], OutInfo[3]);
+	#endif
+	}
+
+	/** The register state the OS saves on context switches, XCR0 */
+	static uint64 GetEnabledRegisterState()
+	{
+	#if defined(_MSC_VER)
+		return _xgetbv(0);
+	#else
+		uint32 Low, High;
+		__asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+		return (uint64(High) << 32) | Low;
+	#endif
+	}
+
+	static ECPUFeatures DetectX86()
+	{
+		ECPUFeatures Features = ECPUFeatures::None;
+
+		uint32 Info[4];
+		CpuId(0, 0, Info);
+		const uint32 MaxLeaf = Info[0];
+		if (MaxLeaf < 1)
+		{
+			return Features;
+		}
+
+		// Leaf 1 ECX
+		CpuId(1, 0, Info);
+		const uint32 Leaf1ECX = Info[2];
+		auto AddIf = [&Features](bool bCondition, ECPUFeatures Feature) { Features |= bCondition ? Feature : ECPUFeatures::None; };
+		AddIf(Leaf1ECX & (1u << 0), ECPUFeatures::SSE3);
+		AddIf(Leaf1ECX & (1u << 9), ECPUFeatures::SSSE3);
+		AddIf(Leaf1ECX & (1u << 19), ECPUFeatures::SSE41);
+		AddIf(Leaf1ECX & (1u << 20), ECPUFeatures::SSE42);
+		AddIf(Leaf1ECX & (1u << 23), ECPUFeatures::POPCNT);
+		AddIf(Leaf1ECX & (1u << 25), ECPUFeatures::AES);
+
+		// The AVX registers are only usable if the OS saves them, XCR0 bits 1 and 2 for XMM and YMM, 5 to 7 for AVX-512
+		const bool bHasOSXSave = (Leaf1ECX & (1u << 27)) != 0;
+		const uint64 RegisterState = bHasOSXSave ? GetEnabledRegisterState() : 0;
+		const bool bOSSavesYMM = (RegisterState & 0x6) == 0x6;
+		const bool bOSSavesZMM = (RegisterState & 0xe6) == 0xe6;
+		const bool bHasAVX = bOSSavesYMM && (Leaf1ECX & (1u << 28)) != 0;
+		AddIf(bHasAVX, ECPUFeatures::AVX);
+		AddIf(bHasAVX && (Leaf1ECX & (1u << 12)) != 0, ECPUFeatures::FMA3);
+		AddIf(bHasAVX && (Leaf1ECX & (1u << 29)) != 0, ECPUFeatures::F16C);
+
+		if (MaxLeaf >= 7)
+		{
+			// Leaf 7 EBX
+			CpuId(7, 0, Info);
+			const uint32 Leaf7EBX = Info[1];
+			AddIf(Leaf7EBX & (1u << 3), ECPUFeatures::BMI1);
+			AddIf(Leaf7EBX & (1u << 8), ECPUFeatures::BMI2);
+			AddIf(bHasAVX && (Leaf7EBX & (1u << 5)) != 0, ECPUFeatures::AVX2);
+			AddIf(bHasAVX && bOSSavesZMM && (Leaf7EBX & (1u << 16)) != 0, ECPUFeatures::AVX512F);
+			// The SHA code paths also use SSSE3 and SSE4.1, every processor with SHA has them
+			AddIf(Leaf7EBX & (1u << 29), ECPUFeatures::SHA);
+		}
+
+		return Features;
+	}
+#endif
+
+	static ECPUFeatures Detect()
+	{
+#if PLATFORM_HAS_CPUID
+		return DetectX86();
+#else
+		ECPUFeatures Features = ECPUFeatures::None;
+	#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		Features |= ECPUFeatures::NEON;
+	#endif
+	#if defined(__ARM_FEATURE_CRC32)
+		Features |= ECPUFeatures::ARMCRC32;
+	#endif
+	#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+		Features |= ECPUFeatures::ARMCrypto;
+	#endif
+		return Features;
+#endif
+	}
+}
+
+ECPUFeatures FCPUFeatures::Get()
+{
+	static const ECPUFeatures Features = UE4CPUFeatures_Private::Detect();
+	return Features;
+}
+
+void FCPUFeatures::LogFeatures()
+{
+	static const struct
+	{
+		ECPUFeatures Feature;
+		const TCHAR* Name;
+	} Names[] =
+	{
+		{ ECPUFeatures::SSE3, TEXT("SSE3") }, { ECPUFeatures::SSSE3, TEXT("SSSE3") }, { ECPUFeatures::SSE41, TEXT("SSE4.1") },
+		{ ECPUFeatures::SSE42, TEXT("SSE4.2") }, { ECPUFeatures::POPCNT, TEXT("POPCNT") }, { ECPUFeatures::AES, TEXT("AES") },
+		{ ECPUFeatures::SHA, TEXT("SHA") }, { ECPUFeatures::AVX, TEXT("AVX") }, { ECPUFeatures::AVX2, TEXT("AVX2") },
+		{ ECPUFeatures::FMA3, TEXT("FMA3") }, { ECPUFeatures::F16C, TEXT("F16C") }, { ECPUFeatures::BMI1, TEXT("BMI1") },
+		{ ECPUFeatures::BMI2, TEXT("BMI2") }, { ECPUFeatures::AVX512F, TEXT("AVX512F") }, { ECPUFeatures::NEON, TEXT("NEON") },
+		{ ECPUFeatures::ARMCRC32, TEXT("CRC32") }, { ECPUFeatures::ARMCrypto, TEXT("Crypto") },
+	};
+
+	FString FeatureList;
+	for (const auto& Entry : Names)
+	{
+		if (Has(Entry.Feature))
+		{
+			if (!FeatureList.IsEmpty())
+			{
+				FeatureList += TEXT(" ");
+			}
+			FeatureList += Entry.Name;
+		}
+	}
+	UE_LOG(LogHAL, Log, TEXT("CPU features: %s"), FeatureList.IsEmpty() ? TEXT("none") : *FeatureList);
+}
@@ -12,6 +12,7 @@ ConsoleManager.cpp: console command handling
 #include "Modules/ModuleManager.h"
 #include "HAL/PlatformProcess.h"
 #include "Misc/RemoteConfigIni.h"
+#include "Containers/SharedSnapshot.h"
 
 DEFINE_LOG_CATEGORY(LogConsoleResponse);
 DEFINE_LOG_CATEGORY_STATIC(LogConsoleManager, Log, All);
@@ -349,10 +350,39 @@ private: // ----------------------------------------------------
 	{
 		// propagate from main thread to render thread
 		OnCVarChange(Data.ShadowedValue[1], Data.ShadowedValue[0], Flags, SetBy);
+		if (Data.Snapshot)
+		{
+			OnSnapshotChange(*Data.Snapshot, Data.ShadowedValue[0]);
+		}
 		FConsoleVariableBase::OnChanged(SetBy);
 	}
+
+	void OnSnapshotChange(TConsoleVariableSnapshot<T>& Snapshot, const T& Src)
+	{
+		// the epochs are stored after the values so that a reader which sees the new epoch also sees the new value
+		Snapshot.GameThreadValue = Src;
+		FPlatformAtomics::AtomicStore(&FConsoleVariableSnapshotEpoch::GameThreadEpoch, FConsoleVariableSnapshotEpoch::GameThreadEpoch + 1);
+
+		FConsoleManager& ConsoleManager = (FConsoleManager&)IConsoleManager::Get();
+		const int32 RenderThreadEpoch = ++FConsoleVariableSnapshotEpoch::QueuedRenderThreadEpoch;
+		if ((Flags & ECVF_RenderThreadSafe) && ConsoleManager.GetThreadPropagationCallback())
+		{
+			// render commands execute in order, so the epoch is published after the value
+			ConsoleManager.GetThreadPropagationCallback()->OnCVarChange(Snapshot.RenderThreadValue, Src);
+			ConsoleManager.GetThreadPropagationCallback()->OnCVarChange(FConsoleVariableSnapshotEpoch::RenderThreadEpoch, RenderThreadEpoch);
+		}
+		else
+		{
+			Snapshot.RenderThreadValue = Src;
+			FPlatformAtomics::AtomicStore(&FConsoleVariableSnapshotEpoch::RenderThreadEpoch, RenderThreadEpoch);
+		}
+	}
 };
 
+int32 FConsoleVariableSnapshotEpoch::GameThreadEpoch = 0;
+int32 FConsoleVariableSnapshotEpoch::RenderThreadEpoch = 0;
+int32 FConsoleVariableSnapshotEpoch::QueuedRenderThreadEpoch = 0;
+
 // specialization for all
 
 template<> bool FConsoleVariable<bool>::IsVariableBool() const
@@ -1143,13 +1173,113 @@ IConsoleObject* FConsoleManager::FindConsoleObject(const TCHAR* Name, bool bTrac
 	return CVar;
 }
 
+struct FConsoleManager::FLookupTable
+{
+	/** Number of finds that take the lock after a change before the table is built again, so that a burst of registrations interleaved with a few finds builds it once */
+	static const int32 RebuildThreshold = 8;
+
+	struct FEntry
+	{
+		/** Case insensitive hash of the name, the same as the ConsoleObjects key hash */
+		uint32 Hash;
+		int32 NameOffset;
+		/** Null for the free entries */
+		IConsoleObject* Object;
+	};
+
+	/** Number of entries is a power of two at least twice the number of objects, so that probe sequences stay short */
+	TArray<FEntry> Entries;
+
+	/** The null terminated names of all the objects, the table doesn't point into the keys of ConsoleObjects */
+	TArray<TCHAR> Names;
+
+	explicit FLookupTable(const TMap<FString, IConsoleObject*>& ConsoleObjects)
+	{
+		const int32 NumEntries = (int32)FMath::RoundUpToPowerOfTwo(FMath::Max(2 * ConsoleObjects.Num(), 16));
+		Entries.AddZeroed(NumEntries);
+
+		int32 NumChars = 0;
+		for (const TPair<FString, IConsoleObject*>& Pair : ConsoleObjects)
+		{
+			NumChars += Pair.Key.Len() + 1;
+		}
+		Names.Reserve(NumChars);
+
+		for (const TPair<FString, IConsoleObject*>& Pair : ConsoleObjects)
+		{
+			const uint32 Hash = GetTypeHash(Pair.Key);
+			uint32 Index = Hash & (NumEntries - 1);
+			while (Entries[Index].Object)
+			{
+				Index = (Index + 1) & (NumEntries - 1);
+			}
+
+			Entries[Index].Hash = Hash;
+			Entries[Index].NameOffset = Names.Num();
+			Entries[Index].Object = Pair.Value;
+			Names.Append(*Pair.Key, Pair.Key.Len() + 1);
+		}
+	}
+
+	IConsoleObject* Find(const TCHAR* Name) const
+	{
+		const uint32 Hash = FCrc::Strihash_DEPRECATED(FCString::Strlen(Name), Name);
+		const uint32 Mask = Entries.Num() - 1;
+		for (uint32 Index = Hash & Mask; Entries[Index].Object; Index = (Index + 1) & Mask)
+		{
+			const FEntry& Entry = Entries[Index];
+			if (Entry.Hash == Hash && FCString::Stricmp(&Names[Entry.NameOffset], Name) == 0)
+			{
+				return Entry.Object;
+			}
+		}
+		return nullptr;
+	}
+
+	static void Delete(void* Table)
+	{
+		delete (FLookupTable*)Table;
+	}
+};
+
 IConsoleObject* FConsoleManager::FindConsoleObjectUnfiltered(const TCHAR* Name) const
 {
+	{
+		FSharedSnapshotEpochs::EnterRead();
+		const FLookupTable* Table = LookupTable;
+		IConsoleObject* Var = Table ? Table->Find(Name) : nullptr;
+		FSharedSnapshotEpochs::ExitRead();
+
+		if (Table)
+		{
+			return Var;
+		}
+	}
+
 	FScopeLock ScopeLock( &ConsoleObjectsSynchronizationObject );
 	IConsoleObject* Var = ConsoleObjects.FindRef(Name);
+
+	// Registrations come in bursts, at static init and as modules load, so the table is only built again once
+	// finds keep coming after the last change
+	if (!LookupTable && ++NumStaleLookups >= FLookupTable::RebuildThreshold)
+	{
+		NumStaleLookups = 0;
+		FPlatformAtomics::InterlockedExchangePtr((void*volatile*)&LookupTable, new FLookupTable(ConsoleObjects));
+	}
 	return Var;
 }
 
+void FConsoleManager::InvalidateLookupTable()
+{
+	NumStaleLookups = 0;
+	if (LookupTable)
+	{
+		// Finds that start from now on take the lock, the ones still reading the old table finish with it first
+		FLookupTable* OldTable = (FLookupTable*)FPlatformAtomics::InterlockedExchangePtr((void*volatile*)&LookupTable, nullptr);
+		FSharedSnapshotEpochs::Retire(OldTable, &FLookupTable::Delete);
+	}
+}
+
 void FConsoleManager::UnregisterConsoleObject(IConsoleObject* CVar, bool bKeepState)
 {
 	if(!CVar)
@@ -1185,6 +1315,7 @@ void FConsoleManager::UnregisterConsoleObject(const TCHAR* Name, bool bKeepState
 		else
 		{
 			ConsoleObjects.Remove(Name);
+			InvalidateLookupTable();
 			Object->Release();
 		}
 	}
@@ -1526,6 +1657,7 @@ IConsoleObject* FConsoleManager::AddConsoleObject(const TCHAR* Name, IConsoleObj
 				ExistingVar->Release();
 
 				ConsoleObjects.Add(Name, Var);
+				InvalidateLookupTable();
 				return Var;
 			}
 #if WITH_HOT_RELOAD
@@ -1552,6 +1684,7 @@ IConsoleObject* FConsoleManager::AddConsoleObject(const TCHAR* Name, IConsoleObj
 				}
 				ExistingVar->Release();
 				ConsoleObjects.Add(Name, Var);
+				InvalidateLookupTable();
 				return Var;
 			}
 #endif
@@ -1575,6 +1708,7 @@ IConsoleObject* FConsoleManager::AddConsoleObject(const TCHAR* Name, IConsoleObj
 			// Replace console command with the new one and release the existing one.
 			// This should be safe, because we don't have FindConsoleVariable equivalent for commands.
 			ConsoleObjects.Add( Name, Cmd );
+			InvalidateLookupTable();
 			ExistingCmd->Release();
 
 			return Cmd;
@@ -1586,6 +1720,7 @@ IConsoleObject* FConsoleManager::AddConsoleObject(const TCHAR* Name, IConsoleObj
 	else
 	{
 		ConsoleObjects.Add(Name, Obj);
+		InvalidateLookupTable();
 		return Obj;
 	}
 }
@@ -1720,8 +1855,7 @@ void FConsoleManager::GetConsoleHistory(const TCHAR* Key, TArray<FString>& Out)
 
 bool FConsoleManager::IsNameRegistered(const TCHAR* Name) const
 {
-	FScopeLock ScopeLock(&ConsoleObjectsSynchronizationObject);
-	return ConsoleObjects.Contains(Name);
+	return FindConsoleObjectUnfiltered(Name) != nullptr;
 }
 
 void FConsoleManager::RegisterThreadPropagation(uint32 ThreadId, IConsoleThreadPropagation* InCallback)
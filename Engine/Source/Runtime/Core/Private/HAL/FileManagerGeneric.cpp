@@ -17,6 +17,7 @@
 #include "Misc/Paths.h"
 #include "Misc/SecureHash.h"
 #include "Templates/UniquePtr.h"
+#include "Async/TaskGraphInterfaces.h"
 #include <time.h>
 
 DEFINE_LOG_CATEGORY_STATIC( LogFileManager, Log, All );
@@ -53,7 +54,7 @@ FArchive* FFileManagerGeneric::CreateFileReaderInternal( const TCHAR* InFilename
 		}
 		return NULL;
 	}
-	return new FArchiveFileReaderGeneric( Handle, InFilename, Handle->Size(), BufferSize );
+	return new FArchiveFileReaderGeneric( Handle, InFilename, Handle->Size(), BufferSize, Flags );
 }
 
 /**
@@ -653,7 +654,48 @@ void FFileManagerGeneric::FindFilesRecursiveInternal( TArray<FString>& FileNames
 	}
 }
 
-FArchiveFileReaderGeneric::FArchiveFileReaderGeneric( IFileHandle* InHandle, const TCHAR* InFilename, int64 InSize, uint32 InBufferSize )
+namespace UE4FileManagerGeneric_Private
+{
+	/** Reads ahead start at this size after a seek and double as long as the archive is read sequentially */
+	static const int64 MinReadaheadSize = 64 * 1024;
+	static const int64 MaxReadaheadSize = 1024 * 1024;
+
+	/** Reads in flight besides the buffer being consumed, i.e. the archive is triple-buffered */
+	static const int32 MaxReadaheads = 2;
+}
+
+struct FArchiveFileReaderGeneric::FReadahead
+{
+	struct FRequest
+	{
+		int64 Offset = 0;
+		int64 BytesRead = 0;
+		TArray64<uint8> Buffer;
+		FGraphEventRef CompletionEvent;
+	};
+
+	/** Reads in flight in file order, each one starting where the previous one ends */
+	TArray<TUniquePtr<FRequest>, TInlineAllocator<UE4FileManagerGeneric_Private::MaxReadaheads>> Requests;
+
+	/** Completed requests, kept to reuse their buffers */
+	TArray<TUniquePtr<FRequest>, TInlineAllocator<UE4FileManagerGeneric_Private::MaxReadaheads>> FreeRequests;
+
+	int64 RequestSize = UE4FileManagerGeneric_Private::MinReadaheadSize;
+
+	/** Where the last refill of the buffer ended, the archive reads sequentially while refills start there */
+	int64 LastRefillEnd = -1;
+
+	void Wait(FRequest& Request)
+	{
+		if (Request.CompletionEvent.IsValid())
+		{
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Request.CompletionEvent);
+			Request.CompletionEvent = nullptr;
+		}
+	}
+};
+
+FArchiveFileReaderGeneric::FArchiveFileReaderGeneric( IFileHandle* InHandle, const TCHAR* InFilename, int64 InSize, uint32 InBufferSize, uint32 InFlags )
 	: Filename( InFilename )
 	, Size( InSize )
 	, Pos( 0 )
@@ -661,17 +703,137 @@ FArchiveFileReaderGeneric::FArchiveFileReaderGeneric( IFileHandle* InHandle, con
 	, Handle( InHandle )
 {
 	BufferSize = FMath::RoundUpToPowerOfTwo64((int64)InBufferSize);
+	if ((InFlags & FILEREAD_Readahead) && FPlatformProcess::SupportsMultithreading())
+	{
+		Readahead = MakeUnique<FReadahead>();
+		BufferSize = FMath::Max(BufferSize, UE4FileManagerGeneric_Private::MinReadaheadSize);
+	}
 	BufferArray.Reserve(BufferSize);
 	this->SetIsLoading(true);
 	this->SetIsPersistent(true);
 }
 
+void FArchiveFileReaderGeneric::IssueReadaheads()
+{
+	if (!FTaskGraphInterface::IsRunning())
+	{
+		return;
+	}
+
+	while (Readahead->Requests.Num() < UE4FileManagerGeneric_Private::MaxReadaheads)
+	{
+		const FReadahead::FRequest* PreviousRequest = Readahead->Requests.Num() ? Readahead->Requests.Last().Get() : nullptr;
+		const int64 Offset = PreviousRequest ? PreviousRequest->Offset + PreviousRequest->Buffer.Num() : BufferBase + BufferArray.Num();
+		const int64 Count = FMath::Min(Readahead->RequestSize, Size - Offset);
+		if (Count <= 0)
+		{
+			return;
+		}
+
+		TUniquePtr<FReadahead::FRequest> Request = Readahead->FreeRequests.Num() ? Readahead->FreeRequests.Pop(false) : MakeUnique<FReadahead::FRequest>();
+		Request->Offset = Offset;
+		Request->BytesRead = 0;
+		Request->Buffer.SetNumUninitialized(Count, false);
+
+		// Chaining the reads keeps them in file order on the handle
+		FGraphEventArray Prerequisites;
+		if (PreviousRequest && PreviousRequest->CompletionEvent.IsValid())
+		{
+			Prerequisites.Add(PreviousRequest->CompletionEvent);
+		}
+
+		FReadahead::FRequest* RequestPtr = Request.Get();
+		Request->CompletionEvent = FFunctionGraphTask::CreateAndDispatchWhenReady([this, RequestPtr]()
+		{
+			ReadLowLevel(RequestPtr->Buffer.GetData(), RequestPtr->Buffer.Num(), RequestPtr->BytesRead);
+		}, TStatId(), &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+
+		Readahead->Requests.Add(MoveTemp(Request));
+	}
+}
+
+bool FArchiveFileReaderGeneric::ConsumeReadahead()
+{
+	TUniquePtr<FReadahead::FRequest> Request = MoveTemp(Readahead->Requests[0]);
+	Readahead->Requests.RemoveAt(0, 1, false);
+	Readahead->Wait(*Request);
+
+	Swap(BufferArray, Request->Buffer);
+	BufferBase = Request->Offset;
+	const int64 BytesRead = Request->BytesRead;
+	Readahead->FreeRequests.Add(MoveTemp(Request));
+
+	if (BytesRead != BufferArray.Num())
+	{
+		TCHAR ErrorBuffer[1024];
+		UE_LOG( LogFileManager, Warning, TEXT( "ReadFile failed: Count=%lld BufferCount=%lld Error=%s" ), BytesRead, BufferArray.Num(), FPlatformMisc::GetSystemErrorMessage( ErrorBuffer, 1024, 0 ) );
+		return false;
+	}
+
+	Readahead->RequestSize = FMath::Min(Readahead->RequestSize * 2, UE4FileManagerGeneric_Private::MaxReadaheadSize);
+	Readahead->LastRefillEnd = BufferBase + BufferArray.Num();
+	IssueReadaheads();
+	return true;
+}
+
+bool FArchiveFileReaderGeneric::SeekWithinReadaheads( int64 InPos )
+{
+	for (int32 RequestIndex = 0; RequestIndex < Readahead->Requests.Num(); ++RequestIndex)
+	{
+		const FReadahead::FRequest& Request = *Readahead->Requests[RequestIndex];
+		if (InPos >= Request.Offset && InPos < Request.Offset + Request.Buffer.Num())
+		{
+			// The reads that were skipped over still have to complete before the handle can be used again
+			for (int32 SkippedIndex = 0; SkippedIndex < RequestIndex; ++SkippedIndex)
+			{
+				Readahead->Wait(*Readahead->Requests[SkippedIndex]);
+				Readahead->FreeRequests.Add(MoveTemp(Readahead->Requests[SkippedIndex]));
+			}
+			Readahead->Requests.RemoveAt(0, RequestIndex, false);
+
+			if (!ConsumeReadahead())
+			{
+				ArIsError = true;
+			}
+			Pos = InPos;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FArchiveFileReaderGeneric::CancelReadaheads()
+{
+	for (TUniquePtr<FReadahead::FRequest>& Request : Readahead->Requests)
+	{
+		Readahead->Wait(*Request);
+		Readahead->FreeRequests.Add(MoveTemp(Request));
+	}
+	Readahead->Requests.Reset();
+}
 
 void FArchiveFileReaderGeneric::Seek( int64 InPos )
 {
 	checkf(InPos >= 0, TEXT("Attempted to seek to a negative location (%lld/%lld), file: %s. The file is most likely corrupt."), InPos, Size, *Filename);
 	checkf(InPos <= Size, TEXT("Attempted to seek past the end of file (%lld/%lld), file: %s. The file is most likely corrupt."), InPos, Size, *Filename);
 
+	if (Readahead)
+	{
+		// Seeks within the bytes already read keep them, the handle stays where the last read ends
+		if (InPos >= BufferBase && InPos <= BufferBase + BufferArray.Num())
+		{
+			Pos = InPos;
+			return;
+		}
+		if (SeekWithinReadaheads(InPos))
+		{
+			return;
+		}
+
+		CancelReadaheads();
+		Readahead->RequestSize = UE4FileManagerGeneric_Private::MinReadaheadSize;
+	}
+
 	if (!SeekLowLevel(InPos))
 	{
 		TCHAR ErrorBuffer[1024];
@@ -713,6 +875,10 @@ void FArchiveFileReaderGeneric::CloseLowLevel()
 
 bool FArchiveFileReaderGeneric::Close()
 {
+	if (Readahead)
+	{
+		CancelReadaheads();
+	}
 	CloseLowLevel();
 	return !ArIsError;
 }
@@ -765,6 +931,15 @@ void FArchiveFileReaderGeneric::Serialize( void* V, int64 Length )
 	while( Length>0 )
 	{
 		int64 Copy = FMath::Min( Length, BufferBase+BufferArray.Num()-Pos );
+		if( Copy<=0 && Readahead && Readahead->Requests.Num() )
+		{
+			if (!ConsumeReadahead())
+			{
+				ArIsError = true;
+				return;
+			}
+			Copy = FMath::Min( Length, BufferBase+BufferArray.Num()-Pos );
+		}
 		if( Copy<=0 )
 		{
 			if( Length >= BufferSize )
@@ -781,6 +956,13 @@ void FArchiveFileReaderGeneric::Serialize( void* V, int64 Length )
 						Count, Length, FPlatformMisc::GetSystemErrorMessage( ErrorBuffer, 1024, 0 ), *Filename );
 				}
 				Pos += Length;
+				if (Readahead)
+				{
+					// The handle is past the buffer now, so it can't be kept for seeks or followed by reads ahead
+					BufferBase = Pos;
+					BufferArray.Reset();
+					Readahead->LastRefillEnd = Pos;
+				}
 				return;
 			}
 			if (!InternalPrecache(Pos, MAX_int32))
@@ -789,6 +971,16 @@ void FArchiveFileReaderGeneric::Serialize( void* V, int64 Length )
 				UE_LOG( LogFileManager, Warning, TEXT( "ReadFile failed during precaching for file %s" ),*Filename );
 				return;
 			}
+			if (Readahead)
+			{
+				// Only read ahead once the archive reads sequentially, seek heavy access would waste the reads
+				const bool bSequential = BufferBase == Readahead->LastRefillEnd;
+				Readahead->LastRefillEnd = BufferBase + BufferArray.Num();
+				if (bSequential)
+				{
+					IssueReadaheads();
+				}
+			}
 			Copy = FMath::Min( Length, BufferBase+BufferArray.Num()-Pos );
 			if( Copy<=0 )
 			{
@@ -808,6 +1000,31 @@ void FArchiveFileReaderGeneric::Serialize( void* V, int64 Length )
 	}
 }
 
+namespace UE4FileManagerGeneric_Private
+{
+	/** Buffers written in the background are at least this big, as each write is dispatched as a task */
+	static const int64 MinBackgroundWriteSize = 256 * 1024;
+
+	/** Writes in flight besides the buffer being filled */
+	static const int32 MaxBackgroundWrites = 3;
+}
+
+struct FArchiveFileWriterGeneric::FBackgroundWrites
+{
+	struct FRequest
+	{
+		TArray64<uint8> Buffer;
+		bool bSucceeded = false;
+		FGraphEventRef CompletionEvent;
+	};
+
+	/** Writes in flight in file order */
+	TArray<TUniquePtr<FRequest>, TInlineAllocator<UE4FileManagerGeneric_Private::MaxBackgroundWrites>> Requests;
+
+	/** Completed requests, kept to reuse their buffers */
+	TArray<TUniquePtr<FRequest>, TInlineAllocator<UE4FileManagerGeneric_Private::MaxBackgroundWrites>> FreeRequests;
+};
+
 FArchiveFileWriterGeneric::FArchiveFileWriterGeneric( IFileHandle* InHandle, const TCHAR* InFilename, int64 InPos, uint32 InBufferSize, uint32 InFlags )
 	: Filename( InFilename )
 	, Flags( InFlags )
@@ -816,6 +1033,11 @@ FArchiveFileWriterGeneric::FArchiveFileWriterGeneric( IFileHandle* InHandle, con
 	, bLoggingError( false )
 {
 	BufferSize = FMath::RoundUpToPowerOfTwo64((int64)InBufferSize);
+	if ((InFlags & FILEWRITE_BackgroundFlush) && FPlatformProcess::SupportsMultithreading())
+	{
+		BackgroundWrites = MakeUnique<FBackgroundWrites>();
+		BufferSize = FMath::Max(BufferSize, UE4FileManagerGeneric_Private::MinBackgroundWriteSize);
+	}
 	BufferArray.Reserve(BufferSize);
 	this->SetIsSaving(true);
 	this->SetIsPersistent(true);
@@ -841,6 +1063,10 @@ int64 FArchiveFileWriterGeneric::TotalSize()
 {
 	// Make sure that all data is written before looking at file size.
 	FlushBuffer();
+	if (BackgroundWrites)
+	{
+		WaitForBackgroundWrites();
+	}
 	return Handle->Size();
 }
 
@@ -852,6 +1078,10 @@ bool FArchiveFileWriterGeneric::WriteLowLevel( const uint8* Src, int64 CountToWr
 void FArchiveFileWriterGeneric::Seek( int64 InPos )
 {
 	FlushBuffer();
+	if (BackgroundWrites)
+	{
+		WaitForBackgroundWrites();
+	}
 	if( !SeekLowLevel( InPos ) )
 	{
 		ArIsError = true;
@@ -863,6 +1093,15 @@ void FArchiveFileWriterGeneric::Seek( int64 InPos )
 bool FArchiveFileWriterGeneric::Close()
 {
 	FlushBuffer();
+	if (BackgroundWrites && Handle)
+	{
+		// The serializer didn't wait for the writes, so closing is where they have to reach the disk
+		if (WaitForBackgroundWrites() && !Handle->Flush(true))
+		{
+			ArIsError = true;
+			LogWriteError(TEXT("Error flushing file"));
+		}
+	}
 	if( !CloseLowLevel() )
 	{
 		ArIsError = true;
@@ -874,7 +1113,8 @@ bool FArchiveFileWriterGeneric::Close()
 void FArchiveFileWriterGeneric::Serialize( void* V, int64 Length )
 {
 	Pos += Length;
-	if ( Length >= BufferSize )
+	// Background writes go through the buffers even for large serializes, so that they stay in order without waiting
+	if ( Length >= BufferSize && !BackgroundWrites )
 	{
 		FlushBuffer();
 		if( !WriteLowLevel( (uint8*)V, Length ) )
@@ -902,14 +1142,90 @@ void FArchiveFileWriterGeneric::Serialize( void* V, int64 Length )
 
 void FArchiveFileWriterGeneric::Flush()
 {
-	if (FlushBuffer() && Handle)
+	const bool bHadBackgroundWrites = BackgroundWrites && BackgroundWrites->Requests.Num() > 0;
+	bool bDidWriteData = FlushBuffer();
+	if (BackgroundWrites)
+	{
+		bDidWriteData = WaitForBackgroundWrites() && (bDidWriteData || bHadBackgroundWrites);
+	}
+
+	if (bDidWriteData && Handle)
 	{
 		Handle->Flush();
 	}
 }
 
+bool FArchiveFileWriterGeneric::FlushBufferInBackground()
+{
+	if (BackgroundWrites->Requests.Num() >= UE4FileManagerGeneric_Private::MaxBackgroundWrites)
+	{
+		RetireBackgroundWrite();
+	}
+
+	TUniquePtr<FBackgroundWrites::FRequest> Request = BackgroundWrites->FreeRequests.Num() ? BackgroundWrites->FreeRequests.Pop(false) : MakeUnique<FBackgroundWrites::FRequest>();
+	Swap(Request->Buffer, BufferArray);
+	BufferArray.Reset();
+	BufferArray.Reserve(BufferSize);
+
+	// Chaining the writes keeps them in file order on the handle
+	FGraphEventArray Prerequisites;
+	if (BackgroundWrites->Requests.Num())
+	{
+		Prerequisites.Add(BackgroundWrites->Requests.Last()->CompletionEvent);
+	}
+
+	FBackgroundWrites::FRequest* RequestPtr = Request.Get();
+	Request->bSucceeded = false;
+	Request->CompletionEvent = FFunctionGraphTask::CreateAndDispatchWhenReady([this, RequestPtr]()
+	{
+		RequestPtr->bSucceeded = WriteLowLevel(RequestPtr->Buffer.GetData(), RequestPtr->Buffer.Num());
+	}, TStatId(), &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+
+	BackgroundWrites->Requests.Add(MoveTemp(Request));
+	return true;
+}
+
+bool FArchiveFileWriterGeneric::RetireBackgroundWrite()
+{
+	TUniquePtr<FBackgroundWrites::FRequest> Request = MoveTemp(BackgroundWrites->Requests[0]);
+	BackgroundWrites->Requests.RemoveAt(0, 1, false);
+
+	FTaskGraphInterface::Get().WaitUntilTaskCompletes(Request->CompletionEvent);
+	Request->CompletionEvent = nullptr;
+
+	const bool bSucceeded = Request->bSucceeded;
+	if (!bSucceeded)
+	{
+		ArIsError = true;
+		LogWriteError(TEXT("Error writing to file"));
+	}
+
+	Request->Buffer.Reset();
+	BackgroundWrites->FreeRequests.Add(MoveTemp(Request));
+	return bSucceeded;
+}
+
+bool FArchiveFileWriterGeneric::WaitForBackgroundWrites()
+{
+	bool bSucceeded = true;
+	while (BackgroundWrites->Requests.Num())
+	{
+		bSucceeded &= RetireBackgroundWrite();
+	}
+	return bSucceeded;
+}
+
 bool FArchiveFileWriterGeneric::FlushBuffer()
 {
+	if (BackgroundWrites && BufferArray.Num() && FTaskGraphInterface::IsRunning())
+	{
+		return FlushBufferInBackground();
+	}
+	if (BackgroundWrites)
+	{
+		WaitForBackgroundWrites();
+	}
+
 	bool bDidWriteData = false;
 	if (int64 BufferNum = BufferArray.Num())
 	{
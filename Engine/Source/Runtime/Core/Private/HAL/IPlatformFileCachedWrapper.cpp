@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/IPlatformFileCachedWrapper.h"
+
+DEFINE_STAT(STAT_CachedFileReadaheadHits);
+DEFINE_STAT(STAT_CachedFileReadaheadWaits);
+DEFINE_STAT(STAT_CachedFileReadaheadWasted);
+
+FCachedFileHandle::~FCachedFileHandle()
+{
+	CancelReadaheads();
+	for (FReadahead& Readahead : Readaheads)
+	{
+		FMemory::Free(Readahead.Buffer);
+	}
+}
+
+bool FCachedFileHandle::ReadRegion(int64 AlignedPos, int64 SizeToRead, uint8* Dest)
+{
+	const bool bSequential = AlignedPos == NextSequentialPos;
+	NumSequentialMisses = bSequential ? NumSequentialMisses + 1 : 0;
+	NextSequentialPos = AlignedPos + SizeToRead;
+
+	bool bResult = NumReadaheads && FinishReadahead(AlignedPos, SizeToRead, Dest);
+	if (!bResult)
+	{
+		bResult = InnerSeek(AlignedPos) && InnerRead(Dest, SizeToRead);
+	}
+
+	if (bResult && NumSequentialMisses >= SequentialMissesBeforeReadahead)
+	{
+		StartReadaheads();
+	}
+	return bResult;
+}
+
+void FCachedFileHandle::StartReadaheads()
+{
+	if (!AsyncFileHandle)
+	{
+		AsyncFileHandle.Reset(ReadaheadPlatformFile->OpenAsyncRead(*Filename));
+		if (!AsyncFileHandle)
+		{
+			// Don't try again, the handle keeps reading synchronously
+			ReadaheadPlatformFile = nullptr;
+			return;
+		}
+	}
+
+	int64 Pos = NextSequentialPos;
+	if (NumReadaheads)
+	{
+		const FReadahead& Last = Readaheads[(FirstReadahead + NumReadaheads - 1) % MaxReadaheadCount];
+		Pos = Last.Start + Last.Size;
+	}
+
+	while (NumReadaheads < ReadaheadWindow && Pos < FileSize)
+	{
+		FReadahead& Readahead = Readaheads[(FirstReadahead + NumReadaheads) % MaxReadaheadCount];
+		if (!Readahead.Buffer)
+		{
+			Readahead.Buffer = (uint8*)FMemory::Malloc(BufferCacheSize);
+		}
+		Readahead.Start = Pos;
+		Readahead.Size = FMath::Min<int64>(BufferCacheSize, FileSize - Pos);
+		Readahead.Request = AsyncFileHandle->ReadRequest(Readahead.Start, Readahead.Size, AIOP_Normal, nullptr, Readahead.Buffer);
+		if (!Readahead.Request)
+		{
+			break;
+		}
+		Pos += Readahead.Size;
+		++NumReadaheads;
+	}
+}
+
+bool FCachedFileHandle::FinishReadahead(int64 Pos, int64 SizeToRead, uint8* Dest)
+{
+	FReadahead& Readahead = Readaheads[FirstReadahead];
+	if (Readahead.Start != Pos || Readahead.Size != SizeToRead)
+	{
+		CancelReadaheads();
+		return false;
+	}
+
+	const bool bWasReady = Readahead.Request->PollCompletion();
+	if (!bWasReady)
+	{
+		// The reader caught up with the reads in flight, keep more of them going
+		Readahead.Request->WaitCompletion();
+		ReadaheadWindow = FMath::Min(ReadaheadWindow * 2, (uint32)MaxReadaheadCount);
+		INC_DWORD_STAT(STAT_CachedFileReadaheadWaits);
+	}
+
+	const uint8* Memory = Readahead.Request->GetReadResults();
+	delete Readahead.Request;
+	Readahead.Request = nullptr;
+	FirstReadahead = (FirstReadahead + 1) % MaxReadaheadCount;
+	--NumReadaheads;
+
+	if (!Memory)
+	{
+		return false;
+	}
+	check(Memory == Readahead.Buffer);
+	FMemory::Memcpy(Dest, Memory, SizeToRead);
+	INC_DWORD_STAT(STAT_CachedFileReadaheadHits);
+	return true;
+}
+
+void FCachedFileHandle::CancelReadaheads()
+{
+	if (!NumReadaheads)
+	{
+		return;
+	}
+
+	for (uint32 Index = 0; Index < NumReadaheads; ++Index)
+	{
+		Readaheads[(FirstReadahead + Index) % MaxReadaheadCount].Request->Cancel();
+	}
+	for (uint32 Index = 0; Index < NumReadaheads; ++Index)
+	{
+		FReadahead& Readahead = Readaheads[(FirstReadahead + Index) % MaxReadaheadCount];
+		Readahead.Request->WaitCompletion();
+		delete Readahead.Request;
+		Readahead.Request = nullptr;
+	}
+	INC_DWORD_STAT_BY(STAT_CachedFileReadaheadWasted, NumReadaheads);
+
+	FirstReadahead = 0;
+	NumReadaheads = 0;
+	ReadaheadWindow = FMath::Max(ReadaheadWindow / 2, 1u);
+}
@@ -0,0 +1,576 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/IPlatformFileLocalCacheWrapper.h"
+#include "Containers/BitArray.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLocalCache, Log, All);
+
+TRACE_DECLARE_MEMORY_COUNTER(LocalCacheBytesReadFromCache, TEXT("LocalCache/BytesReadFromCache"));
+TRACE_DECLARE_MEMORY_COUNTER(LocalCacheBytesReadFromSource, TEXT("LocalCache/BytesReadFromSource"));
+TRACE_DECLARE_MEMORY_COUNTER(LocalCacheSize, TEXT("LocalCache/Size"));
+
+/**
+ * A version of a file in the cache, and which of its blocks its cache file has.
+ */
+struct FLocalCacheEntry
+{
+	FString Name;
+	FString Filename;
+	int64 FileSize = 0;
+	int64 TimeStampTicks = 0;
+	/** Bytes of the blocks that are in the cache file */
+	int64 CachedSize = 0;
+	/** Value of the wrapper's AccessSequence when the file was last opened */
+	uint64 LastAccess = 0;
+	TBitArray<> ValidBlocks;
+
+	// Not saved in the index
+	/** Guards ValidBlocks, CachedSize and CacheHandle */
+	FCriticalSection Critical;
+	/** Open while handles use the entry, shared between them since cache files are opened for exclusive writes */
+	TUniquePtr<IFileHandle> CacheHandle;
+	bool bCacheHandleFailed = false;
+	/** Guarded by the wrapper's IndexCritical */
+	int32 NumOpenHandles = 0;
+
+	void Serialize(FArchive& Ar)
+	{
+		Ar << Name << Filename << FileSize << TimeStampTicks << CachedSize << LastAccess << ValidBlocks;
+	}
+};
+
+namespace UE4LocalCache_Private
+{
+	static const uint32 IndexMagic = 0x43434C55; // 'ULCC'
+	static const int32 IndexVersion = 1;
+
+	static const int64 DefaultMaxCacheSizeMB = 10 * 1024;
+	static const int64 DefaultBlockSizeKB = 1024;
+
+	/** The index is written at most this often while files are being closed, and on exit */
+	static const double IndexSaveIntervalSeconds = 10.0;
+
+	/** Synchronous read only handle that reads through the cache */
+	class FLocalCacheFileHandle : public IFileHandle
+	{
+	public:
+		FLocalCacheFileHandle(FLocalCachePlatformFile& InOwner, FLocalCacheEntry& InEntry, IPlatformFile& InLowerLevel, const TCHAR* InFilename)
+			: Owner(InOwner)
+			, Entry(InEntry)
+			, LowerLevel(InLowerLevel)
+			, Filename(InFilename)
+			, Position(0)
+			, bSourceOpenFailed(false)
+		{
+		}
+
+		virtual ~FLocalCacheFileHandle()
+		{
+			Owner.ReleaseEntry(Entry);
+		}
+
+		virtual int64 Tell() override
+		{
+			return Position;
+		}
+		virtual bool Seek(int64 NewPosition) override
+		{
+			if (NewPosition < 0 || NewPosition > Size())
+			{
+				return false;
+			}
+			Position = NewPosition;
+			return true;
+		}
+		virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd) override
+		{
+			return Seek(Size() + NewPositionRelativeToEnd);
+		}
+		virtual bool Read(uint8* Destination, int64 BytesToRead) override
+		{
+			const bool bRead = Owner.ReadCached(Entry, [this]() { return GetSourceHandle(); }, Position, Destination, BytesToRead);
+			if (bRead)
+			{
+				Position += BytesToRead;
+			}
+			return bRead;
+		}
+		virtual bool Write(const uint8* Source, int64 BytesToWrite) override
+		{
+			return false;
+		}
+		virtual bool Flush(const bool bFullFlush = false) override
+		{
+			return false;
+		}
+		virtual bool Truncate(int64 NewSize) override
+		{
+			return false;
+		}
+		virtual int64 Size() override
+		{
+			return FLocalCachePlatformFile::GetCachedFileSize(Entry);
+		}
+
+	private:
+		IFileHandle* GetSourceHandle()
+		{
+			// Files that are fully cached are never opened, that is most of what the cache saves on a network share
+			if (!SourceHandle && !bSourceOpenFailed)
+			{
+				SourceHandle.Reset(LowerLevel.OpenRead(*Filename));
+				bSourceOpenFailed = !SourceHandle;
+			}
+			return SourceHandle.Get();
+		}
+
+		FLocalCachePlatformFile& Owner;
+		FLocalCacheEntry& Entry;
+		IPlatformFile& LowerLevel;
+		FString Filename;
+		TUniquePtr<IFileHandle> SourceHandle;
+		int64 Position;
+		bool bSourceOpenFailed;
+	};
+}
+
+FLocalCachePlatformFile::FLocalCachePlatformFile()
+	: LowerLevel(nullptr)
+	, MaxCacheSize(0)
+	, BlockSize(0)
+	, bEnabled(false)
+	, TotalCachedSize(0)
+	, AccessSequence(0)
+	, bIndexDirty(false)
+	, LastIndexSaveTime(0.0)
+{
+}
+
+FLocalCachePlatformFile::~FLocalCachePlatformFile()
+{
+	FCoreDelegates::OnExit.RemoveAll(this);
+}
+
+bool FLocalCachePlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
+{
+	using namespace UE4LocalCache_Private;
+
+	LowerLevel = Inner;
+	if (!LowerLevel)
+	{
+		return false;
+	}
+
+	if (!FParse::Value(CmdLine, TEXT("LocalCacheDir="), CacheDir))
+	{
+		CacheDir = FPaths::ProjectSavedDir() / TEXT("LocalCache");
+	}
+	CacheDir = FPaths::ConvertRelativePathToFull(CacheDir);
+
+	int64 MaxCacheSizeMB = DefaultMaxCacheSizeMB;
+	FParse::Value(CmdLine, TEXT("LocalCacheSizeMB="), MaxCacheSizeMB);
+	MaxCacheSize = FMath::Max<int64>(MaxCacheSizeMB, 0) << 20;
+
+	int64 BlockSizeKB = DefaultBlockSizeKB;
+	FParse::Value(CmdLine, TEXT("LocalCacheBlockKB="), BlockSizeKB);
+	BlockSize = FMath::Clamp<int64>(BlockSizeKB, 4, 64 * 1024) << 10;
+
+	FString CachedPathsValue;
+	if (FParse::Value(CmdLine, TEXT("LocalCachePaths="), CachedPathsValue, false))
+	{
+		CachedPathsValue.ParseIntoArray(CachedPaths, TEXT("+"), true);
+		for (FString& Path : CachedPaths)
+		{
+			Path = FPaths::ConvertRelativePathToFull(Path);
+		}
+	}
+
+	LowerLevel->CreateDirectoryTree(*CacheDir);
+	LockHandle.Reset(LowerLevel->OpenWrite(*(CacheDir / TEXT("Lock"))));
+	if (!LockHandle)
+	{
+		UE_LOG(LogLocalCache, Warning, TEXT("Local cache %s is in use by another process, reading without it"), *CacheDir);
+		return true;
+	}
+
+	LoadIndex();
+	bEnabled = true;
+	FCoreDelegates::OnExit.AddRaw(this, &FLocalCachePlatformFile::SaveIndexIfDirty);
+	UE_LOG(LogLocalCache, Log, TEXT("Local cache %s holds %lld of %lld MB in %d files"), *CacheDir, TotalCachedSize >> 20, MaxCacheSize >> 20, Entries.Num());
+	return true;
+}
+
+bool FLocalCachePlatformFile::ShouldCache(const TCHAR* Filename) const
+{
+	const FString FullFilename = FPaths::ConvertRelativePathToFull(Filename);
+	if (FullFilename.StartsWith(CacheDir))
+	{
+		return false;
+	}
+	if (CachedPaths.Num() == 0)
+	{
+		return true;
+	}
+	for (const FString& Path : CachedPaths)
+	{
+		if (FullFilename.StartsWith(Path))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+IFileHandle* FLocalCachePlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
+{
+	if (!bEnabled || bAllowWrite || MaxCacheSize == 0 || !ShouldCache(Filename))
+	{
+		return LowerLevel->OpenRead(Filename, bAllowWrite);
+	}
+
+	// The size and time stamp are what tell versions of a file apart, a file that changed gets a new entry
+	const FFileStatData StatData = LowerLevel->GetStatData(Filename);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+	{
+		return LowerLevel->OpenRead(Filename, bAllowWrite);
+	}
+
+	FLocalCacheEntry* Entry = AcquireEntry(Filename, StatData);
+	return new UE4LocalCache_Private::FLocalCacheFileHandle(*this, *Entry, *LowerLevel, Filename);
+}
+
+FLocalCacheEntry* FLocalCachePlatformFile::AcquireEntry(const TCHAR* Filename, const FFileStatData& StatData)
+{
+	const FString FullFilename = FPaths::ConvertRelativePathToFull(Filename);
+	const int64 TimeStampTicks = StatData.ModificationTime.GetTicks();
+
+	FSHA1 Sha;
+	Sha.UpdateWithString(*FullFilename, FullFilename.Len());
+	Sha.Update((const uint8*)&StatData.FileSize, sizeof(StatData.FileSize));
+	Sha.Update((const uint8*)&TimeStampTicks, sizeof(TimeStampTicks));
+	Sha.Final();
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	const FString Name = Hash.ToString();
+
+	FScopeLock Lock(&IndexCritical);
+	TUniquePtr<FLocalCacheEntry>& Entry = Entries.FindOrAdd(Name);
+	if (!Entry)
+	{
+		Entry = MakeUnique<FLocalCacheEntry>();
+		Entry->Name = Name;
+		Entry->Filename = FullFilename;
+		Entry->FileSize = StatData.FileSize;
+		Entry->TimeStampTicks = TimeStampTicks;
+		Entry->ValidBlocks.Init(false, int32((StatData.FileSize + BlockSize - 1) / BlockSize));
+	}
+	++Entry->NumOpenHandles;
+	Entry->LastAccess = ++AccessSequence;
+	bIndexDirty = true;
+	return Entry.Get();
+}
+
+void FLocalCachePlatformFile::ReleaseEntry(FLocalCacheEntry& Entry)
+{
+	using namespace UE4LocalCache_Private;
+
+	bool bSaveIndex = false;
+	{
+		FScopeLock Lock(&IndexCritical);
+		check(Entry.NumOpenHandles > 0);
+		if (--Entry.NumOpenHandles == 0)
+		{
+			Entry.CacheHandle.Reset();
+			Entry.bCacheHandleFailed = false;
+			const double CurrentTime = FPlatformTime::Seconds();
+			if (bIndexDirty && CurrentTime - LastIndexSaveTime > IndexSaveIntervalSeconds)
+			{
+				LastIndexSaveTime = CurrentTime;
+				bSaveIndex = true;
+			}
+			TrimToBudget();
+		}
+	}
+	if (bSaveIndex)
+	{
+		SaveIndexIfDirty();
+	}
+}
+
+int64 FLocalCachePlatformFile::GetCachedFileSize(const FLocalCacheEntry& Entry)
+{
+	return Entry.FileSize;
+}
+
+IFileHandle* FLocalCachePlatformFile::GetCacheHandle(FLocalCacheEntry& Entry)
+{
+	if (!Entry.CacheHandle && !Entry.bCacheHandleFailed)
+	{
+		// Appending keeps what is there, writes past the end leave holes where the file system supports sparse files
+		Entry.CacheHandle.Reset(LowerLevel->OpenWrite(*GetCacheFilename(Entry.Name), true, true));
+		Entry.bCacheHandleFailed = !Entry.CacheHandle;
+	}
+	return Entry.CacheHandle.Get();
+}
+
+bool FLocalCachePlatformFile::ReadCached(FLocalCacheEntry& Entry, TFunctionRef<IFileHandle*()> GetSourceHandle, int64 Offset, uint8* Destination, int64 BytesToRead)
+{
+	if (Offset < 0 || BytesToRead < 0 || Offset + BytesToRead > Entry.FileSize)
+	{
+		return false;
+	}
+
+	TArray<uint8> BlockBuffer;
+	const int64 EndOffset = Offset + BytesToRead;
+	for (int64 BlockOffset = (Offset / BlockSize) * BlockSize; BlockOffset < EndOffset; BlockOffset += BlockSize)
+	{
+		const int32 BlockIndex = int32(BlockOffset / BlockSize);
+		const int64 BlockEnd = FMath::Min(BlockOffset + BlockSize, Entry.FileSize);
+		const int64 CopyOffset = FMath::Max(Offset, BlockOffset);
+		const int64 CopySize = FMath::Min(EndOffset, BlockEnd) - CopyOffset;
+		uint8* CopyDestination = Destination + (CopyOffset - Offset);
+
+		{
+			FScopeLock Lock(&Entry.Critical);
+			if (Entry.ValidBlocks[BlockIndex])
+			{
+				IFileHandle* CacheHandle = GetCacheHandle(Entry);
+				if (CacheHandle && CacheHandle->Seek(CopyOffset) && CacheHandle->Read(CopyDestination, CopySize))
+				{
+					TRACE_COUNTER_ADD(LocalCacheBytesReadFromCache, CopySize);
+					continue;
+				}
+				// The cache file lost the block, read it again
+				Entry.ValidBlocks[BlockIndex] = false;
+				Entry.CachedSize -= BlockEnd - BlockOffset;
+			}
+		}
+
+		// Whole blocks are read from the file so that they can be cached, straight into the destination when the read covers one
+		IFileHandle* SourceHandle = GetSourceHandle();
+		if (!SourceHandle || !SourceHandle->Seek(BlockOffset))
+		{
+			return false;
+		}
+		const int64 ReadSize = BlockEnd - BlockOffset;
+		const bool bReadIntoDestination = CopyOffset == BlockOffset && CopySize == ReadSize;
+		if (!bReadIntoDestination)
+		{
+			BlockBuffer.SetNumUninitialized(ReadSize, false);
+		}
+		uint8* ReadDestination = bReadIntoDestination ? CopyDestination : BlockBuffer.GetData();
+		if (!SourceHandle->Read(ReadDestination, ReadSize))
+		{
+			return false;
+		}
+		TRACE_COUNTER_ADD(LocalCacheBytesReadFromSource, ReadSize);
+		if (!bReadIntoDestination)
+		{
+			FMemory::Memcpy(CopyDestination, BlockBuffer.GetData() + (CopyOffset - BlockOffset), CopySize);
+		}
+		StoreBlock(Entry, BlockIndex, ReadDestination, ReadSize);
+	}
+	return true;
+}
+
+void FLocalCachePlatformFile::StoreBlock(FLocalCacheEntry& Entry, int32 BlockIndex, const uint8* Data, int64 Size)
+{
+	{
+		FScopeLock Lock(&Entry.Critical);
+		if (Entry.ValidBlocks[BlockIndex])
+		{
+			// Another handle of the file read it at the same time
+			return;
+		}
+		IFileHandle* CacheHandle = GetCacheHandle(Entry);
+		if (!CacheHandle || !CacheHandle->Seek(int64(BlockIndex) * BlockSize) || !CacheHandle->Write(Data, Size))
+		{
+			return;
+		}
+		Entry.ValidBlocks[BlockIndex] = true;
+		Entry.CachedSize += Size;
+	}
+
+	FScopeLock Lock(&IndexCritical);
+	TotalCachedSize += Size;
+	bIndexDirty = true;
+	TrimToBudget();
+}
+
+void FLocalCachePlatformFile::TrimToBudget()
+{
+	while (TotalCachedSize > MaxCacheSize)
+	{
+		const FLocalCacheEntry* OldestEntry = nullptr;
+		for (const TPair<FString, TUniquePtr<FLocalCacheEntry>>& Pair : Entries)
+		{
+			const FLocalCacheEntry* Entry = Pair.Value.Get();
+			if (Entry->NumOpenHandles == 0 && Entry->CachedSize > 0 && (!OldestEntry || Entry->LastAccess < OldestEntry->LastAccess))
+			{
+				OldestEntry = Entry;
+			}
+		}
+		if (!OldestEntry)
+		{
+			// The files in use are larger than the budget, they are trimmed once they are closed
+			break;
+		}
+		RemoveEntry(OldestEntry->Name);
+	}
+	TRACE_COUNTER_SET(LocalCacheSize, TotalCachedSize);
+}
+
+void FLocalCachePlatformFile::RemoveEntry(const FString& Name)
+{
+	TUniquePtr<FLocalCacheEntry> Entry;
+	if (Entries.RemoveAndCopyValue(Name, Entry))
+	{
+		check(Entry->NumOpenHandles == 0);
+		TotalCachedSize -= Entry->CachedSize;
+		LowerLevel->DeleteFile(*GetCacheFilename(Name));
+		bIndexDirty = true;
+	}
+}
+
+FString FLocalCachePlatformFile::GetCacheFilename(const FString& Name) const
+{
+	return CacheDir / Name + TEXT(".blocks");
+}
+
+void FLocalCachePlatformFile::LoadIndex()
+{
+	using namespace UE4LocalCache_Private;
+
+	const FString IndexFilename = CacheDir / TEXT("Index.bin");
+	TArray<TUniquePtr<FLocalCacheEntry>> LoadedEntries;
+	if (TUniquePtr<IFileHandle> IndexHandle{ LowerLevel->OpenRead(*IndexFilename) })
+	{
+		TArray<uint8> IndexData;
+		IndexData.SetNumUninitialized(IndexHandle->Size());
+		if (IndexHandle->Read(IndexData.GetData(), IndexData.Num()))
+		{
+			FMemoryReader Reader(IndexData);
+			uint32 Magic = 0;
+			int32 Version = 0;
+			int64 IndexBlockSize = 0;
+			int32 NumEntries = 0;
+			Reader << Magic << Version << IndexBlockSize << NumEntries;
+			// Blocks of another size can't be looked up, the files of that index are deleted below
+			if (Magic == IndexMagic && Version == IndexVersion && IndexBlockSize == BlockSize && NumEntries >= 0)
+			{
+				for (int32 Index = 0; Index < NumEntries && !Reader.IsError(); ++Index)
+				{
+					TUniquePtr<FLocalCacheEntry> Entry = MakeUnique<FLocalCacheEntry>();
+					Entry->Serialize(Reader);
+					LoadedEntries.Add(MoveTemp(Entry));
+				}
+			}
+			if (Reader.IsError())
+			{
+				LoadedEntries.Empty();
+			}
+		}
+	}
+
+	for (TUniquePtr<FLocalCacheEntry>& Entry : LoadedEntries)
+	{
+		const int32 NumBlocks = int32((Entry->FileSize + BlockSize - 1) / BlockSize);
+		if (Entry->ValidBlocks.Num() != NumBlocks || !LowerLevel->FileExists(*GetCacheFilename(Entry->Name)))
+		{
+			continue;
+		}
+		AccessSequence = FMath::Max(AccessSequence, Entry->LastAccess);
+		TotalCachedSize += Entry->CachedSize;
+		const FString Name = Entry->Name;
+		Entries.Add(Name, MoveTemp(Entry));
+	}
+
+	// Cache files the index doesn't know about were written after it was last saved, their blocks can't be trusted
+	TArray<FString> StrayFilenames;
+	LowerLevel->IterateDirectory(*CacheDir, [this, &StrayFilenames](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+	{
+		const FString Filename(FilenameOrDirectory);
+		if (!bIsDirectory && Filename.EndsWith(TEXT(".blocks")) && !Entries.Contains(FPaths::GetBaseFilename(Filename)))
+		{
+			StrayFilenames.Add(Filename);
+		}
+		return true;
+	});
+	for (const FString& Filename : StrayFilenames)
+	{
+		LowerLevel->DeleteFile(*Filename);
+	}
+
+	FScopeLock Lock(&IndexCritical);
+	TrimToBudget();
+	bIndexDirty = StrayFilenames.Num() > 0 || LoadedEntries.Num() != Entries.Num();
+}
+
+void FLocalCachePlatformFile::SaveIndexIfDirty()
+{
+	FScopeLock Lock(&IndexCritical);
+	if (bIndexDirty)
+	{
+		SaveIndex();
+	}
+}
+
+void FLocalCachePlatformFile::SaveIndex()
+{
+	using namespace UE4LocalCache_Private;
+
+	TArray<uint8> IndexData;
+	FMemoryWriter Writer(IndexData);
+	uint32 Magic = IndexMagic;
+	int32 Version = IndexVersion;
+	int32 NumEntries = Entries.Num();
+	Writer << Magic << Version << BlockSize << NumEntries;
+	for (TPair<FString, TUniquePtr<FLocalCacheEntry>>& Pair : Entries)
+	{
+		FScopeLock EntryLock(&Pair.Value->Critical);
+		Pair.Value->Serialize(Writer);
+	}
+
+	// Written next to the index and moved over it, so that a crash while writing leaves the previous one
+	const FString IndexFilename = CacheDir / TEXT("Index.bin");
+	const FString TempFilename = IndexFilename + TEXT(".tmp");
+	bool bWritten = false;
+	{
+		TUniquePtr<IFileHandle> IndexHandle(LowerLevel->OpenWrite(*TempFilename));
+		bWritten = IndexHandle && IndexHandle->Write(IndexData.GetData(), IndexData.Num()) && IndexHandle->Flush(true);
+	}
+	if (bWritten)
+	{
+		LowerLevel->DeleteFile(*IndexFilename);
+		bWritten = LowerLevel->MoveFile(*IndexFilename, *TempFilename);
+	}
+	UE_CLOG(!bWritten, LogLocalCache, Warning, TEXT("Failed to write the local cache index %s"), *IndexFilename);
+	bIndexDirty = !bWritten;
+}
+
+static FDelayedAutoRegisterHelper GLocalCacheRegister(EDelayedRegisterRunPhase::FileSystemReady, []
+{
+	const TCHAR* CmdLine = FCommandLine::Get();
+	FPlatformFileManager& PlatformFileManager = FPlatformFileManager::Get();
+	if (!FParse::Param(CmdLine, TEXT("LocalCache")) || PlatformFileManager.FindPlatformFile(FLocalCachePlatformFile::GetTypeName()))
+	{
+		return;
+	}
+
+	IPlatformFile* PlatformFile = PlatformFileManager.GetPlatformFile(FLocalCachePlatformFile::GetTypeName());
+	if (PlatformFile && PlatformFile->Initialize(&PlatformFileManager.GetPlatformFile(), CmdLine))
+	{
+		PlatformFileManager.SetPlatformFile(*PlatformFile);
+	}
+});
@@ -3,12 +3,254 @@
 #include "HAL/IPlatformFileProfilerWrapper.h"
 #include "Stats/Stats.h"
 #include "Containers/Ticker.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/PlatformFileTrace.h"
 
 #if !UE_BUILD_SHIPPING
 
 bool bSuppressProfiledFileLog = false;
 DEFINE_LOG_CATEGORY(LogProfiledFile);
 
+static thread_local const TCHAR* GProfiledFileCallSite = nullptr;
+
+FScopedProfiledFileCallSite::FScopedProfiledFileCallSite(const TCHAR* Name)
+	: PreviousName(GProfiledFileCallSite)
+{
+	GProfiledFileCallSite = Name;
+}
+
+FScopedProfiledFileCallSite::~FScopedProfiledFileCallSite()
+{
+	GProfiledFileCallSite = PreviousName;
+}
+
+const TCHAR* FScopedProfiledFileCallSite::Get()
+{
+	return GProfiledFileCallSite ? GProfiledFileCallSite : TEXT("Unknown");
+}
+
+void FProfiledFileLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Buckets);
+	Count = 0;
+	MaxMs = 0.0;
+	Bytes = 0;
+}
+
+void FProfiledFileLatencyHistogram::Add(double DurationMs, int64 InBytes)
+{
+	const double DurationUs = FMath::Clamp(DurationMs * 1000.0, 1.0, (double)MAX_uint32);
+	const int32 BucketIndex = FMath::Min<int32>(FMath::FloorLog2((uint32)DurationUs), NumBuckets - 1);
+	++Buckets[BucketIndex];
+	++Count;
+	MaxMs = FMath::Max(MaxMs, DurationMs);
+	Bytes += InBytes;
+}
+
+double FProfiledFileLatencyHistogram::GetPercentileMs(double Percentile) const
+{
+	const uint32 Target = FMath::Max<uint32>((uint32)FMath::CeilToDouble(Percentile * Count), 1);
+	uint32 Total = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		Total += Buckets[BucketIndex];
+		if (Total >= Target)
+		{
+			return FMath::Min(double(2ull << BucketIndex) / 1000.0, MaxMs);
+		}
+	}
+	return MaxMs;
+}
+
+/** Async read handle recording the time from each request to its completion */
+class FProfiledAsyncReadFileHandle final : public IAsyncReadFileHandle
+{
+	TUniquePtr<IAsyncReadFileHandle> FileHandle;
+	FProfiledPlatformFile& Owner;
+	FProfiledFileStatsFileBase* FileStats;
+
+public:
+	FProfiledAsyncReadFileHandle(IAsyncReadFileHandle* InFileHandle, FProfiledPlatformFile& InOwner, FProfiledFileStatsFileBase* InFileStats)
+		: FileHandle(InFileHandle)
+		, Owner(InOwner)
+		, FileStats(InFileStats)
+	{
+	}
+
+	virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) override
+	{
+		return FileHandle->SizeRequest(CompleteCallback);
+	}
+
+	virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) override
+	{
+		// Nobody waits on precaches, their latency would only hide the one of the reads that matter
+		if (PriorityAndFlags & AIOP_FLAG_PRECACHE)
+		{
+			return FileHandle->ReadRequest(Offset, BytesToRead, PriorityAndFlags, CompleteCallback, UserSuppliedMemory);
+		}
+
+		FProfiledPlatformFile* LocalOwner = &Owner;
+		FProfiledFileStatsFileBase* LocalFileStats = FileStats;
+		const TCHAR* CallSite = FScopedProfiledFileCallSite::Get();
+		const double OpStartTime = FPlatformTime::Seconds() * 1000.0;
+		const int64 Bytes = BytesToRead == MAX_int64 ? 0 : BytesToRead;
+		FAsyncFileCallBack UserCallback = CompleteCallback ? *CompleteCallback : FAsyncFileCallBack();
+
+		// Requests copy the callback, it doesn't need to outlive this call
+		FAsyncFileCallBack ProfiledCallback = [LocalOwner, LocalFileStats, CallSite, OpStartTime, Bytes, UserCallback](bool bWasCancelled, IAsyncReadRequest* Request)
+		{
+			LocalOwner->EndLatencyOp(LocalFileStats, CallSite, FPlatformTime::Seconds() * 1000.0 - OpStartTime, bWasCancelled ? 0 : Bytes);
+			if (UserCallback)
+			{
+				UserCallback(bWasCancelled, Request);
+			}
+		};
+		Owner.BeginLatencyOp();
+		return FileHandle->ReadRequest(Offset, BytesToRead, PriorityAndFlags, &ProfiledCallback, UserSuppliedMemory);
+	}
+
+	virtual bool UsesCache() override
+	{
+		return FileHandle->UsesCache();
+	}
+};
+
+IAsyncReadFileHandle* FProfiledPlatformFile::CreateProfiledAsyncReadHandle(IAsyncReadFileHandle* FileHandle, FProfiledFileStatsFileBase* FileStats)
+{
+	return new FProfiledAsyncReadFileHandle(FileHandle, *this, FileStats);
+}
+
+bool FProfiledPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CommandLineParam)
+{
+	// Inner is required.
+	check(Inner != nullptr);
+	LowerLevel = Inner;
+	StartTime = FPlatformTime::Seconds() * 1000.0;
+	IntervalStartTime = StartTime;
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FProfiledPlatformFile::TickLatency), 1.0f);
+	return !!LowerLevel;
+}
+
+void FProfiledPlatformFile::BeginLatencyOp()
+{
+	const int32 NewNumOpsInFlight = FPlatformAtomics::InterlockedIncrement(&NumOpsInFlight);
+	for (int32 OldMax = MaxOpsInFlight; NewNumOpsInFlight > OldMax; OldMax = MaxOpsInFlight)
+	{
+		if (FPlatformAtomics::InterlockedCompareExchange(&MaxOpsInFlight, NewNumOpsInFlight, OldMax) == OldMax)
+		{
+			break;
+		}
+	}
+}
+
+void FProfiledPlatformFile::EndLatencyOp(FProfiledFileStatsFileBase* FileStats, const TCHAR* CallSite, double DurationMs, int64 Bytes)
+{
+	FPlatformAtomics::InterlockedDecrement(&NumOpsInFlight);
+
+	FScopeLock Lock(&LatencyCritical);
+	if (FileStats->IntervalLatency.Count == 0)
+	{
+		IntervalFiles.Add(FileStats);
+	}
+	FileStats->Latency.Add(DurationMs, Bytes);
+	FileStats->IntervalLatency.Add(DurationMs, Bytes);
+	CallSiteLatency.FindOrAdd(CallSite).Add(DurationMs, Bytes);
+	CallSiteIntervalLatency.FindOrAdd(CallSite).Add(DurationMs, Bytes);
+	IntervalBytes += Bytes;
+}
+
+bool FProfiledPlatformFile::TickLatency(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FProfiledPlatformFile_TickLatency);
+
+	const double Now = FPlatformTime::Seconds() * 1000.0;
+	const int32 QueueDepth = NumOpsInFlight;
+	const int32 MaxQueueDepth = FPlatformAtomics::InterlockedExchange(&MaxOpsInFlight, QueueDepth);
+
+	FScopeLock Lock(&LatencyCritical);
+	const double IntervalMs = FMath::Max(Now - IntervalStartTime, 1.0);
+	TRACE_PLATFORMFILE_ACTIVITY(QueueDepth, MaxQueueDepth, uint64(IntervalBytes * 1000.0 / IntervalMs));
+	for (const TPair<const TCHAR*, FProfiledFileLatencyHistogram>& Pair : CallSiteIntervalLatency)
+	{
+		const FProfiledFileLatencyHistogram& Histogram = Pair.Value;
+		TRACE_PLATFORMFILE_LATENCY_SUMMARY(Pair.Key, true, Histogram.Count, Histogram.Bytes, Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.99), Histogram.MaxMs);
+	}
+	for (FProfiledFileStatsFileBase* FileStats : IntervalFiles)
+	{
+		FProfiledFileLatencyHistogram& Histogram = FileStats->IntervalLatency;
+		TRACE_PLATFORMFILE_LATENCY_SUMMARY(*FileStats->Name, false, Histogram.Count, Histogram.Bytes, Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.99), Histogram.MaxMs);
+		Histogram.Reset();
+	}
+	IntervalFiles.Reset();
+	CallSiteIntervalLatency.Reset();
+	IntervalBytes = 0;
+	IntervalStartTime = Now;
+	return true;
+}
+
+void FProfiledPlatformFile::DumpLatency(FOutputDevice& Ar, int32 NumFiles)
+{
+	auto LogHistogram = [&Ar](const TCHAR* Name, const FProfiledFileLatencyHistogram& Histogram)
+	{
+		Ar.Logf(TEXT("  %8.2f %8.2f %8.2f %8u %10.2f  %s"), Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.99), Histogram.MaxMs, Histogram.Count, Histogram.Bytes / (1024.0 * 1024.0), Name);
+	};
+	auto SortByP99 = [](const TPair<const TCHAR*, const FProfiledFileLatencyHistogram*>& A, const TPair<const TCHAR*, const FProfiledFileLatencyHistogram*>& B)
+	{
+		return A.Value->GetPercentileMs(0.99) > B.Value->GetPercentileMs(0.99);
+	};
+
+	FScopeLock StatsLock(&SynchronizationObject);
+	FScopeLock Lock(&LatencyCritical);
+
+	TArray<TPair<const TCHAR*, const FProfiledFileLatencyHistogram*>> Entries;
+	for (const TPair<const TCHAR*, FProfiledFileLatencyHistogram>& Pair : CallSiteLatency)
+	{
+		Entries.Emplace(Pair.Key, &Pair.Value);
+	}
+	Entries.Sort(SortByP99);
+	Ar.Logf(TEXT("File latency by call site, in ms:"));
+	Ar.Logf(TEXT("  %8s %8s %8s %8s %10s  %s"), TEXT("p50"), TEXT("p99"), TEXT("max"), TEXT("count"), TEXT("MB"), TEXT("call site"));
+	for (const TPair<const TCHAR*, const FProfiledFileLatencyHistogram*>& Entry : Entries)
+	{
+		LogHistogram(Entry.Key, *Entry.Value);
+	}
+
+	Entries.Reset();
+	for (const TPair<FString, TSharedPtr<FProfiledFileStatsFileBase>>& Pair : Stats)
+	{
+		if (Pair.Value->Latency.Count)
+		{
+			Entries.Emplace(*Pair.Value->Name, &Pair.Value->Latency);
+		}
+	}
+	Entries.Sort(SortByP99);
+	Ar.Logf(TEXT("File latency of the %d files with the worst p99, in ms:"), FMath::Min(NumFiles, Entries.Num()));
+	Ar.Logf(TEXT("  %8s %8s %8s %8s %10s  %s"), TEXT("p50"), TEXT("p99"), TEXT("max"), TEXT("count"), TEXT("MB"), TEXT("file"));
+	for (int32 Index = 0; Index < FMath::Min(NumFiles, Entries.Num()); ++Index)
+	{
+		LogHistogram(Entries[Index].Key, *Entries[Index].Value);
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice GDumpProfiledFileLatencyCmd(
+	TEXT("ProfiledFile.DumpLatency"),
+	TEXT("Logs the latency percentiles of the reads and writes by call site and by file, when running with -ProfileFile or -SimpleProfileFile"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic([](FOutputDevice& Ar)
+	{
+		for (const TCHAR* TypeName : { TProfiledPlatformFile<FProfiledFileStatsFileDetailed>::GetTypeName(), TProfiledPlatformFile<FProfiledFileStatsFileSimple>::GetTypeName() })
+		{
+			if (IPlatformFile* PlatformFile = FPlatformFileManager::Get().FindPlatformFile(TypeName))
+			{
+				static_cast<FProfiledPlatformFile*>(PlatformFile)->DumpLatency(Ar);
+			}
+		}
+	})
+);
+
 DECLARE_STATS_GROUP(TEXT("File Stats"), STATGROUP_FileStats, STATCAT_Advanced);
 DECLARE_FLOAT_COUNTER_STAT(TEXT("Read Speed MB/s"), STAT_ReadSpeedMBs, STATGROUP_FileStats);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Read Calls"), STAT_ReadIssued, STATGROUP_FileStats);
@@ -0,0 +1,420 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/IPlatformFileStartupPrefetchWrapper.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Templates/UniquePtr.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStartupPrefetch, Log, All);
+
+namespace UE4StartupPrefetch_Private
+{
+	static const uint32 ManifestMagic = 0x50465355; // 'USFP'
+	static const int32 ManifestVersion = 1;
+
+	/** Ranges closer than this are merged, reading the gap is cheaper than another seek */
+	static const int64 MergeGapSize = 64 * 1024;
+
+	/** Size of the reads the replay does, larger ranges are split so a stop request is seen quickly */
+	static const int64 ReplayReadSize = 1024 * 1024;
+
+	static const float DefaultRecordSeconds = 30.0f;
+
+	static void MergeRanges(TArray<FStartupPrefetchRange>& Ranges)
+	{
+		Ranges.Sort([](const FStartupPrefetchRange& A, const FStartupPrefetchRange& B) { return A.Offset < B.Offset; });
+
+		int32 NumMerged = 0;
+		for (int32 Index = 0; Index < Ranges.Num(); ++Index)
+		{
+			const FStartupPrefetchRange& Range = Ranges[Index];
+			if (NumMerged > 0)
+			{
+				FStartupPrefetchRange& Last = Ranges[NumMerged - 1];
+				if (Range.Offset <= Last.Offset + Last.Size + MergeGapSize)
+				{
+					Last.Size = FMath::Max(Last.Size, Range.Offset + Range.Size - Last.Offset);
+					continue;
+				}
+			}
+			Ranges[NumMerged++] = Range;
+		}
+		Ranges.SetNum(NumMerged, false);
+	}
+
+	/** Synchronous file handle that records what is read from it while the wrapper is recording */
+	class FRecordingFileHandle : public IFileHandle
+	{
+	public:
+		FRecordingFileHandle(FStartupPrefetchPlatformFile& InOwner, IFileHandle* InFileHandle, int32 InFileIndex)
+			: Owner(InOwner)
+			, FileHandle(InFileHandle)
+			, FileIndex(InFileIndex)
+		{
+		}
+
+		virtual int64 Tell() override
+		{
+			return FileHandle->Tell();
+		}
+		virtual bool Seek(int64 NewPosition) override
+		{
+			return FileHandle->Seek(NewPosition);
+		}
+		virtual bool SeekFromEnd(int64 NewPositionRelativeToEnd) override
+		{
+			return FileHandle->SeekFromEnd(NewPositionRelativeToEnd);
+		}
+		virtual bool Read(uint8* Destination, int64 BytesToRead) override
+		{
+			if (Owner.IsRecording())
+			{
+				Owner.RecordRead(FileIndex, FileHandle->Tell(), BytesToRead);
+			}
+			return FileHandle->Read(Destination, BytesToRead);
+		}
+		virtual bool Write(const uint8* Source, int64 BytesToWrite) override
+		{
+			return FileHandle->Write(Source, BytesToWrite);
+		}
+		virtual bool Flush(const bool bFullFlush = false) override
+		{
+			return FileHandle->Flush(bFullFlush);
+		}
+		virtual bool Truncate(int64 NewSize) override
+		{
+			return FileHandle->Truncate(NewSize);
+		}
+		virtual int64 Size() override
+		{
+			return FileHandle->Size();
+		}
+
+	private:
+		FStartupPrefetchPlatformFile& Owner;
+		TUniquePtr<IFileHandle> FileHandle;
+		int32 FileIndex;
+	};
+
+	/** Async file handle that records the ranges requested from it while the wrapper is recording */
+	class FRecordingAsyncReadFileHandle : public IAsyncReadFileHandle
+	{
+	public:
+		FRecordingAsyncReadFileHandle(FStartupPrefetchPlatformFile& InOwner, IAsyncReadFileHandle* InFileHandle, int32 InFileIndex)
+			: Owner(InOwner)
+			, FileHandle(InFileHandle)
+			, FileIndex(InFileIndex)
+		{
+		}
+
+		virtual IAsyncReadRequest* SizeRequest(FAsyncFileCallBack* CompleteCallback = nullptr) override
+		{
+			return FileHandle->SizeRequest(CompleteCallback);
+		}
+		virtual IAsyncReadRequest* ReadRequest(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, FAsyncFileCallBack* CompleteCallback = nullptr, uint8* UserSuppliedMemory = nullptr) override
+		{
+			// Precaches are guesses of what might be read, only record what the game asked for
+			if (Owner.IsRecording() && !(PriorityAndFlags & AIOP_FLAG_PRECACHE))
+			{
+				Owner.RecordRead(FileIndex, Offset, BytesToRead);
+			}
+			return FileHandle->ReadRequest(Offset, BytesToRead, PriorityAndFlags, CompleteCallback, UserSuppliedMemory);
+		}
+		virtual bool UsesCache() override
+		{
+			return FileHandle->UsesCache();
+		}
+
+	private:
+		FStartupPrefetchPlatformFile& Owner;
+		TUniquePtr<IAsyncReadFileHandle> FileHandle;
+		int32 FileIndex;
+	};
+}
+
+/**
+ * Reads the files of a manifest on a background thread, one file at a time and each in offset order.
+ */
+class FStartupPrefetchReplay : public FRunnable
+{
+public:
+	FStartupPrefetchReplay(IPlatformFile* InPlatformFile, TArray<FStartupPrefetchFile>&& InFiles)
+		: PlatformFile(InPlatformFile)
+		, Files(MoveTemp(InFiles))
+		, bStopRequested(false)
+	{
+	}
+
+	virtual uint32 Run() override
+	{
+		using namespace UE4StartupPrefetch_Private;
+
+		const double StartTime = FPlatformTime::Seconds();
+		int64 TotalBytesRead = 0;
+		int32 NumFilesRead = 0;
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(ReplayReadSize);
+
+		for (const FStartupPrefetchFile& File : Files)
+		{
+			if (bStopRequested)
+			{
+				break;
+			}
+
+			TUniquePtr<IFileHandle> FileHandle(PlatformFile->OpenRead(*File.Filename));
+			// A file that changed since it was recorded is read differently now, don't waste time on it
+			if (!FileHandle || FileHandle->Size() != File.FileSize)
+			{
+				continue;
+			}
+
+			for (const FStartupPrefetchRange& Range : File.Ranges)
+			{
+				if (bStopRequested || !FileHandle->Seek(Range.Offset))
+				{
+					break;
+				}
+				for (int64 Remaining = Range.Size; Remaining > 0 && !bStopRequested; )
+				{
+					const int64 SizeToRead = FMath::Min(Remaining, ReplayReadSize);
+					if (!FileHandle->Read(Buffer.GetData(), SizeToRead))
+					{
+						break;
+					}
+					Remaining -= SizeToRead;
+					TotalBytesRead += SizeToRead;
+				}
+			}
+			++NumFilesRead;
+		}
+
+		UE_LOG(LogStartupPrefetch, Log, TEXT("Prefetched %lld bytes from %d of %d files in %.2fs"), TotalBytesRead, NumFilesRead, Files.Num(), FPlatformTime::Seconds() - StartTime);
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested = true;
+	}
+
+private:
+	IPlatformFile* PlatformFile;
+	TArray<FStartupPrefetchFile> Files;
+	TAtomic<bool> bStopRequested;
+};
+
+FStartupPrefetchPlatformFile::FStartupPrefetchPlatformFile()
+	: LowerLevel(nullptr)
+	, bRecording(false)
+	, RecordEndTime(0.0)
+	, Replay(nullptr)
+	, ReplayThread(nullptr)
+{
+}
+
+FStartupPrefetchPlatformFile::~FStartupPrefetchPlatformFile()
+{
+	if (ReplayThread)
+	{
+		ReplayThread->Kill(true);
+		delete ReplayThread;
+	}
+	delete Replay;
+}
+
+bool FStartupPrefetchPlatformFile::Initialize(IPlatformFile* Inner, const TCHAR* CmdLine)
+{
+	using namespace UE4StartupPrefetch_Private;
+
+	LowerLevel = Inner;
+	if (!FParse::Value(CmdLine, TEXT("StartupPrefetchManifest="), ManifestPath))
+	{
+		ManifestPath = FPaths::ProjectSavedDir() / TEXT("StartupPrefetch.bin");
+	}
+
+	TArray<FStartupPrefetchFile> Files;
+	bool bLoaded = false;
+	if (!FParse::Param(CmdLine, TEXT("StartupPrefetchRecord")))
+	{
+		TUniquePtr<IFileHandle> ManifestHandle(LowerLevel->OpenRead(*ManifestPath));
+		if (ManifestHandle)
+		{
+			TArray<uint8> ManifestData;
+			ManifestData.SetNumUninitialized(ManifestHandle->Size());
+			if (ManifestHandle->Read(ManifestData.GetData(), ManifestData.Num()))
+			{
+				FMemoryReader Reader(ManifestData);
+				uint32 Magic = 0;
+				int32 Version = 0;
+				Reader << Magic << Version;
+				if (Magic == ManifestMagic && Version == ManifestVersion)
+				{
+					Reader << Files;
+					bLoaded = !Reader.IsError();
+				}
+			}
+			if (!bLoaded)
+			{
+				UE_LOG(LogStartupPrefetch, Warning, TEXT("Ignoring invalid startup prefetch manifest %s, recording a new one"), *ManifestPath);
+			}
+		}
+	}
+
+	if (bLoaded)
+	{
+		if (FPlatformProcess::SupportsMultithreading())
+		{
+			Replay = new FStartupPrefetchReplay(LowerLevel, MoveTemp(Files));
+			ReplayThread = FRunnableThread::Create(Replay, TEXT("StartupPrefetch"), 0, TPri_BelowNormal);
+		}
+	}
+	else
+	{
+		float RecordSeconds = DefaultRecordSeconds;
+		FParse::Value(CmdLine, TEXT("StartupPrefetchSeconds="), RecordSeconds);
+		RecordEndTime = FPlatformTime::Seconds() + RecordSeconds;
+		bRecording = true;
+		UE_LOG(LogStartupPrefetch, Log, TEXT("Recording the reads of the next %.0fs to %s"), RecordSeconds, *ManifestPath);
+	}
+
+	return !!LowerLevel;
+}
+
+IFileHandle* FStartupPrefetchPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
+{
+	IFileHandle* FileHandle = LowerLevel->OpenRead(Filename, bAllowWrite);
+	if (!FileHandle || !bRecording)
+	{
+		return FileHandle;
+	}
+	const int32 FileIndex = AddRecordedFile(Filename, FileHandle->Size());
+	return new UE4StartupPrefetch_Private::FRecordingFileHandle(*this, FileHandle, FileIndex);
+}
+
+IAsyncReadFileHandle* FStartupPrefetchPlatformFile::OpenAsyncRead(const TCHAR* Filename)
+{
+	IAsyncReadFileHandle* FileHandle = LowerLevel->OpenAsyncRead(Filename);
+	if (!FileHandle || !bRecording)
+	{
+		return FileHandle;
+	}
+	const int32 FileIndex = AddRecordedFile(Filename, LowerLevel->FileSize(Filename));
+	return new UE4StartupPrefetch_Private::FRecordingAsyncReadFileHandle(*this, FileHandle, FileIndex);
+}
+
+int32 FStartupPrefetchPlatformFile::AddRecordedFile(const TCHAR* Filename, int64 FileSize)
+{
+	FScopeLock Lock(&RecordCritical);
+	FString Key(Filename);
+	if (const int32* Index = RecordedFileIndices.Find(Key))
+	{
+		// The same file is read again after it changed, only the last version is worth prefetching
+		RecordedFiles[*Index].FileSize = FileSize;
+		return *Index;
+	}
+	const int32 Index = RecordedFiles.AddDefaulted();
+	RecordedFiles[Index].Filename = Key;
+	RecordedFiles[Index].FileSize = FileSize;
+	RecordedFileIndices.Add(MoveTemp(Key), Index);
+	return Index;
+}
+
+void FStartupPrefetchPlatformFile::RecordRead(int32 FileIndex, int64 Offset, int64 Size)
+{
+	if (FPlatformTime::Seconds() > RecordEndTime)
+	{
+		StopRecording();
+		return;
+	}
+	if (Size <= 0)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&RecordCritical);
+	TArray<FStartupPrefetchRange>& Ranges = RecordedFiles[FileIndex].Ranges;
+	// Most reads continue the previous one, extend it instead of adding a range
+	if (Ranges.Num() && Ranges.Last().Offset + Ranges.Last().Size == Offset)
+	{
+		Ranges.Last().Size += Size;
+	}
+	else
+	{
+		Ranges.Add({ Offset, Size });
+	}
+}
+
+void FStartupPrefetchPlatformFile::StopRecording()
+{
+	if (bRecording.Exchange(false))
+	{
+		SaveManifest();
+	}
+}
+
+void FStartupPrefetchPlatformFile::SaveManifest()
+{
+	using namespace UE4StartupPrefetch_Private;
+
+	TArray<FStartupPrefetchFile> Files;
+	{
+		FScopeLock Lock(&RecordCritical);
+		Files = MoveTemp(RecordedFiles);
+		RecordedFileIndices.Empty();
+	}
+	Files.RemoveAll([](const FStartupPrefetchFile& File) { return File.Ranges.Num() == 0 || File.FileSize < 0; });
+
+	int64 TotalSize = 0;
+	for (FStartupPrefetchFile& File : Files)
+	{
+		MergeRanges(File.Ranges);
+		for (const FStartupPrefetchRange& Range : File.Ranges)
+		{
+			TotalSize += Range.Size;
+		}
+	}
+
+	TArray<uint8> ManifestData;
+	FMemoryWriter Writer(ManifestData);
+	uint32 Magic = ManifestMagic;
+	int32 Version = ManifestVersion;
+	Writer << Magic << Version << Files;
+
+	LowerLevel->CreateDirectoryTree(*FPaths::GetPath(ManifestPath));
+	TUniquePtr<IFileHandle> ManifestHandle(LowerLevel->OpenWrite(*ManifestPath));
+	if (ManifestHandle && ManifestHandle->Write(ManifestData.GetData(), ManifestData.Num()))
+	{
+		UE_LOG(LogStartupPrefetch, Log, TEXT("Wrote startup prefetch manifest %s, %d files, %lld bytes to prefetch"), *ManifestPath, Files.Num(), TotalSize);
+	}
+	else
+	{
+		UE_LOG(LogStartupPrefetch, Warning, TEXT("Failed to write startup prefetch manifest %s"), *ManifestPath);
+	}
+}
+
+static FDelayedAutoRegisterHelper GStartupPrefetchRegister(EDelayedRegisterRunPhase::FileSystemReady, []
+{
+	const TCHAR* CmdLine = FCommandLine::Get();
+	FPlatformFileManager& PlatformFileManager = FPlatformFileManager::Get();
+	if (!FParse::Param(CmdLine, TEXT("StartupPrefetch")) || PlatformFileManager.FindPlatformFile(FStartupPrefetchPlatformFile::GetTypeName()))
+	{
+		return;
+	}
+
+	IPlatformFile* PlatformFile = PlatformFileManager.GetPlatformFile(FStartupPrefetchPlatformFile::GetTypeName());
+	if (PlatformFile && PlatformFile->Initialize(&PlatformFileManager.GetPlatformFile(), CmdLine))
+	{
+		PlatformFileManager.SetPlatformFile(*PlatformFile);
+	}
+});
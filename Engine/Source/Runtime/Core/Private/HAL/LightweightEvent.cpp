@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/LightweightEvent.h"
+#include "Stats/Stats.h"
+
+void FLightweightEvent::WaitSlow()
+{
+	FThreadIdleStats::FScopeIdle Scope;
+	for (;;)
+	{
+		int32 Current = FPlatformAtomics::AtomicRead(&State);
+		if (Current == Triggered)
+		{
+			return;
+		}
+		if (Current == NotTriggered)
+		{
+			Current = FPlatformAtomics::InterlockedCompareExchange(&State, NotTriggeredWithWaiters, NotTriggered);
+			if (Current != NotTriggered)
+			{
+				continue;
+			}
+		}
+		const int32 CompareState = NotTriggeredWithWaiters;
+		FAddressWait::Wait(&State, &CompareState, sizeof(State));
+	}
+}
+
+void FLightweightLatch::WaitSlow()
+{
+	FThreadIdleStats::FScopeIdle Scope;
+	for (;;)
+	{
+		const int32 Current = FPlatformAtomics::AtomicRead(&State);
+		if (Current < CountUnit)
+		{
+			return;
+		}
+		if (!(Current & WaitersBit) && FPlatformAtomics::InterlockedCompareExchange(&State, Current | WaitersBit, Current) != Current)
+		{
+			continue;
+		}
+		const int32 CompareState = Current | WaitersBit;
+		FAddressWait::Wait(&State, &CompareState, sizeof(State));
+	}
+}
@@ -11,6 +11,7 @@
 
 #if ENABLE_LOW_LEVEL_MEM_TRACKER
 #include "MemPro/MemProProfiler.h"
+#include "Trace/Trace.h"
 
 // There is a little memory and cpu overhead in tracking peak memory but it is generally more useful than current memory.
 // Disable if you need a little more memory or speed
@@ -122,8 +123,11 @@ DECLARE_LLM_MEMORY_STAT(TEXT("Landscape"), STAT_LandscapeLLM, STATGROUP_LLMFULL)
 DECLARE_LLM_MEMORY_STAT(TEXT("MediaStreaming"), STAT_MediaStreamingLLM, STATGROUP_LLMFULL);
 DECLARE_LLM_MEMORY_STAT(TEXT("ElectraPlayer"), STAT_ElectraPlayerLLM, STATGROUP_LLMFULL);
 DECLARE_LLM_MEMORY_STAT(TEXT("WMFPlayer"), STAT_WMFPlayerLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Compression"), STAT_CompressionLLM, STATGROUP_LLMFULL);
 DECLARE_LLM_MEMORY_STAT(TEXT("MMIO"), STAT_PlatformMMIOLLM, STATGROUP_LLMPlatform);
 DECLARE_LLM_MEMORY_STAT(TEXT("VirtualMemory"), STAT_PlatformVMLLM, STATGROUP_LLMPlatform);
+DECLARE_LLM_MEMORY_STAT(TEXT("HugePages"), STAT_PlatformHugePagesLLM, STATGROUP_LLMPlatform);
+DECLARE_LLM_MEMORY_STAT(TEXT("HugePagesMissed"), STAT_PlatformHugePagesMissedLLM, STATGROUP_LLMPlatform);
 
 /*
 * LLM Summary stats referenced by ELLMTagNames
@@ -251,6 +255,19 @@ bool LLMPrivate::HandleAssert(bool bLog, const TCHAR* Format, ...)
 
 #endif
 
+UE_TRACE_CHANNEL(LLMHistogramChannel)
+
+UE_TRACE_EVENT_BEGIN(LLM, TagHistogram)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Tag)
+	UE_TRACE_EVENT_FIELD(int64, NumAllocs)
+	UE_TRACE_EVENT_FIELD(int64, NumFrees)
+	UE_TRACE_EVENT_FIELD(uint32, SampleRate)
+	UE_TRACE_EVENT_FIELD(uint8, Tracker)
+UE_TRACE_EVENT_END()
+
+class FLLMHistograms;
+
 /**
  * FLLMCsvWriter: class for writing out the LLM stats to a csv file every few seconds
  */
@@ -283,10 +300,13 @@ public:
 
 	void SetEnabled(bool value) { Enabled = value; }
 
+	void WriteHistograms(const FLLMHistograms& Histograms, FLLMCustomTag* CustomTags, const int32* ParentTags);
+
 private:
 	void WriteGraph(FLLMCustomTag* CustomTags, const int32* ParentTags);
 
 	void Write(const FString& Text);
+	static void Write(FArchive* Ar, const FString& Text);
 
 	static FString GetTagName(int64 Tag, FLLMCustomTag* CustomTags, const int32* ParentTags);
 
@@ -319,6 +339,181 @@ private:
 	int32 LastWriteStatValueCount;
 };
 
+/*
+ * Optional per tag histograms of allocation sizes and lifetimes, enabled with -LLMHISTOGRAMS.
+ * Allocations are sampled by a hash of their address so that frees can tell cheaply whether they were sampled,
+ * only sampled allocations pay for a lookup. Counts are estimates, scaled up by the sample rate.
+ */
+class FLLMHistograms
+{
+public:
+	enum
+	{
+		NumBuckets = 32,
+		// all tags that are FNames share the last slot
+		NumTagSlots = LLM_TAG_COUNT + 1,
+		StatTagsSlot = LLM_TAG_COUNT,
+	};
+
+	struct FTagHistogram
+	{
+		int64 NumAllocs;
+		int64 NumFrees;
+		// bucket N counts allocations of [2^N, 2^(N+1)) bytes
+		int64 SizeCounts[NumBuckets];
+		// bucket N counts allocations that lived [2^N, 2^(N+1)) microseconds
+		int64 LifetimeCounts[NumBuckets];
+	};
+
+	FLLMHistograms()
+		: Allocator(nullptr)
+		, Histograms(nullptr)
+		, SampledAllocations(nullptr)
+		, SampleMask(0)
+	{
+	}
+
+	~FLLMHistograms()
+	{
+		Clear();
+	}
+
+	void Enable(FLLMAllocator* InAllocator, uint32 SampleRate)
+	{
+		LLMCheck(!Histograms);
+		Allocator = InAllocator;
+		SampleMask = FPlatformMath::RoundUpToPowerOfTwo(FMath::Max(SampleRate, 1u)) - 1;
+
+		// the map is only created when enabled, it can't be destructed without an allocator
+		SampledAllocations = new (Allocator->Alloc(sizeof(FSampleMap))) FSampleMap();
+		SampledAllocations->SetAllocator(Allocator);
+
+		Histograms = (FTagHistogram*)Allocator->Alloc(sizeof(FTagHistogram) * NumTagSlots);
+		FMemory::Memzero(Histograms, sizeof(FTagHistogram) * NumTagSlots);
+	}
+
+	void Clear()
+	{
+		if (Histograms)
+		{
+			SampledAllocations->~FSampleMap();
+			Allocator->Free(SampledAllocations, sizeof(FSampleMap));
+			SampledAllocations = nullptr;
+
+			Allocator->Free(Histograms, sizeof(FTagHistogram) * NumTagSlots);
+			Histograms = nullptr;
+		}
+	}
+
+	FORCEINLINE bool IsEnabled() const
+	{
+		return Histograms != nullptr;
+	}
+
+	FORCEINLINE bool ShouldSample(const void* Ptr) const
+	{
+		// fibonacci hashing, the low bits of the address are mostly alignment
+		return (uint32(((uint64)(UPTRINT)Ptr * 0x9E3779B97F4A7C15ull) >> 40) & SampleMask) == 0;
+	}
+
+	uint32 GetSampleRate() const
+	{
+		return SampleMask + 1;
+	}
+
+	const FTagHistogram& GetHistogram(int32 TagSlot) const
+	{
+		return Histograms[TagSlot];
+	}
+
+	static int64 GetTagForSlot(int32 TagSlot)
+	{
+		return TagSlot == StatTagsSlot ? -1 : TagSlot;
+	}
+
+	void OnAlloc(const void* Ptr, uint64 Size, int64 Tag)
+	{
+		const uint32 TagSlot = Tag >= 0 && Tag < LLM_TAG_COUNT ? uint32(Tag) : uint32(StatTagsSlot);
+		FTagHistogram& Histogram = Histograms[TagSlot];
+		FPlatformAtomics::InterlockedIncrement(&Histogram.NumAllocs);
+		FPlatformAtomics::InterlockedIncrement(&Histogram.SizeCounts[GetBucket(Size)]);
+
+		SampledAllocations->Add(Ptr, TagSlot, FPlatformTime::Cycles64());
+	}
+
+	void OnFree(const void* Ptr)
+	{
+		if (!SampledAllocations->HasKey(Ptr))
+		{
+			// allocated before we were enabled
+			return;
+		}
+
+		FSampleMap::Values Values = SampledAllocations->Remove(Ptr);
+		const uint64 LifetimeMicroseconds = uint64(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Values.Value2) * 1000.0);
+
+		FTagHistogram& Histogram = Histograms[Values.Value1];
+		FPlatformAtomics::InterlockedIncrement(&Histogram.NumFrees);
+		FPlatformAtomics::InterlockedIncrement(&Histogram.LifetimeCounts[GetBucket(LifetimeMicroseconds)]);
+	}
+
+	void OnMoved(const void* Dest, const void* Source)
+	{
+		// a move is not the end of the allocation, carry the sample over if the new address is sampled as well
+		if (ShouldSample(Source) && SampledAllocations->HasKey(Source))
+		{
+			FSampleMap::Values Values = SampledAllocations->Remove(Source);
+			if (ShouldSample(Dest))
+			{
+				SampledAllocations->Add(Dest, Values.Value1, Values.Value2);
+			}
+		}
+	}
+
+	void Trace(ELLMTracker Tracker) const
+	{
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(LLMHistogramChannel))
+		{
+			return;
+		}
+
+		const uint64 Cycle = FPlatformTime::Cycles64();
+		for (int32 TagSlot = 0; TagSlot < NumTagSlots; ++TagSlot)
+		{
+			const FTagHistogram& Histogram = Histograms[TagSlot];
+			if (Histogram.NumAllocs == 0)
+			{
+				continue;
+			}
+
+			// the attachment is the size buckets followed by the lifetime buckets
+			const uint16 AttachmentSize = sizeof(Histogram.SizeCounts) + sizeof(Histogram.LifetimeCounts);
+			UE_TRACE_LOG(LLM, TagHistogram, LLMHistogramChannel, AttachmentSize)
+				<< TagHistogram.Cycle(Cycle)
+				<< TagHistogram.Tag(uint64(GetTagForSlot(TagSlot)))
+				<< TagHistogram.NumAllocs(Histogram.NumAllocs)
+				<< TagHistogram.NumFrees(Histogram.NumFrees)
+				<< TagHistogram.SampleRate(GetSampleRate())
+				<< TagHistogram.Tracker(uint8(Tracker))
+				<< TagHistogram.Attachment(Histogram.SizeCounts, AttachmentSize);
+		}
+	}
+
+private:
+	static uint32 GetBucket(uint64 Value)
+	{
+		return FMath::Min<uint32>(uint32(FPlatformMath::FloorLog2_64(FMath::Max<uint64>(Value, 1))), NumBuckets - 1);
+	}
+
+	// sampled pointer -> tag slot, allocation time in cycles
+	typedef LLMMap<PointerKey, uint32, uint64> FSampleMap;
+
+	FLLMAllocator* Allocator;
+	FTagHistogram* Histograms;
+	FSampleMap* SampledAllocations;
+	uint32 SampleMask;
+};
+
 /*
  * this is really the main LLM class. It owns the thread state objects.
  */
@@ -355,6 +550,9 @@ public:
 
 	void WriteCsv(FLLMCustomTag* CustomTags, const int32* ParentTags);
 
+	void EnableHistograms(uint32 SampleRate);
+	void WriteHistograms(FLLMCustomTag* CustomTags, const int32* ParentTags, bool bForce);
+
 #define LLM_USE_ALLOC_INFO_STRUCT (LLM_STAT_TAGS_ENABLED || LLM_ALLOW_ASSETS_TAGS)
 
 #if LLM_USE_ALLOC_INFO_STRUCT
@@ -477,6 +675,12 @@ protected:
 
 	FLLMCsvWriter CsvWriter;
 
+	FLLMHistograms Histograms;
+
+	ELLMTracker TrackerType;
+
+	double LastHistogramWriteTime;
+
 	double LastTrimTime;
 
 	int64 EnumTagAmounts[LLM_TAG_COUNT];
@@ -680,6 +884,11 @@ void FLowLevelMemTracker::UpdateStatsPerFrame(const TCHAR* LogName)
 		GetTracker(ELLMTracker::Platform)->WriteCsv(CustomTags,ParentTags);
 	}
 
+	for (int32 TrackerIndex = 0; TrackerIndex < (int32)ELLMTracker::Max; TrackerIndex++)
+	{
+		GetTracker((ELLMTracker)TrackerIndex)->WriteHistograms(CustomTags, ParentTags, false);
+	}
+
 	if (LogName != nullptr)
 	{
 		FPlatformMisc::LowLevelOutputDebugStringf(TEXT("---> Untracked memory at %s = %.2f mb\n"), LogName, (double)PlatformTotalUntracked / (1024.0 * 1024.0));
@@ -742,6 +951,22 @@ void FLowLevelMemTracker::ProcessCommandLine(const TCHAR* CmdLine)
 		bIsDisabled = false;
 	}
 
+	// size and lifetime histograms, one in LLMHISTOGRAMSAMPLERATE allocations is sampled
+	if (FParse::Param(CmdLine, TEXT("LLMHISTOGRAMS")))
+	{
+		if (bIsDisabled && bCanEnable)
+		{
+			bIsDisabled = false;
+		}
+
+		uint32 SampleRate = 16;
+		FParse::Value(CmdLine, TEXT("LLMHISTOGRAMSAMPLERATE="), SampleRate);
+		for (int32 TrackerIndex = 0; TrackerIndex < (int32)ELLMTracker::Max; ++TrackerIndex)
+		{
+			GetTracker((ELLMTracker)TrackerIndex)->EnableHistograms(SampleRate);
+		}
+	}
+
 	if (bIsDisabled)
 	{
 		for (int32 TrackerIndex = 0; TrackerIndex < (int32)ELLMTracker::Max; TrackerIndex++)
@@ -885,6 +1110,13 @@ bool FLowLevelMemTracker::Exec(const TCHAR* Cmd, FOutputDevice& Ar)
 
 			UpdateStatsPerFrame(TEXT("After cleanup"));
 		}
+		else if (FParse::Command(&Cmd, TEXT("HISTOGRAMS")))
+		{
+			for (int32 TrackerIndex = 0; TrackerIndex < (int32)ELLMTracker::Max; TrackerIndex++)
+			{
+				GetTracker((ELLMTracker)TrackerIndex)->WriteHistograms(CustomTags, ParentTags, true);
+			}
+		}
 		return true;
 	}
 
@@ -1180,6 +1412,8 @@ FLLMTracker::FLLMTracker()
 	: TrackedMemoryOverFrames(0)
 	, UntaggedTotalTag(ELLMTag::Untagged)
 	, TrackedTotalTag(ELLMTag::Untagged)
+	, TrackerType(ELLMTracker::Default)
+	, LastHistogramWriteTime(0.0)
 	, LastTrimTime(0.0)
 
 {
@@ -1209,6 +1443,8 @@ void FLLMTracker::Initialise(
 {
 	CsvWriter.SetTracker(Tracker);
 
+	TrackerType = Tracker;
+
 	Allocator = InAllocator;
 
 	AllocationMap.SetAllocator(InAllocator);
@@ -1321,6 +1557,11 @@ void FLLMTracker::TrackAllocation(const void* Ptr, uint64 Size, ELLMTag DefaultT
 
 		LLMCheck(Size <= 0xffffffffu);
 		GetAllocationMap().Add(Ptr, (uint32)Size, AllocInfo);
+
+		if (Histograms.IsEnabled() && Histograms.ShouldSample(Ptr))
+		{
+			Histograms.OnAlloc(Ptr, Size, Tag);
+		}
 	}
 }
 
@@ -1343,6 +1584,11 @@ void FLLMTracker::TrackFree(const void* Ptr, ELLMTracker Tracker, ELLMAllocType
 	// track the total quickly
 	FPlatformAtomics::InterlockedAdd(&TrackedMemoryOverFrames, 0 - Size);
 
+	if (Histograms.IsEnabled() && Histograms.ShouldSample(Ptr))
+	{
+		Histograms.OnFree(Ptr);
+	}
+
 	FLLMThreadState* State = GetOrCreateState();
 
 #if LLM_USE_ALLOC_INFO_STRUCT
@@ -1360,6 +1606,11 @@ void FLLMTracker::OnAllocMoved(const void* Dest, const void* Source, uint64& Out
 	LLMMap::Values Values = GetAllocationMap().Remove(Source);
 	GetAllocationMap().Add(Dest, Values.Value1, Values.Value2);
 
+	if (Histograms.IsEnabled())
+	{
+		Histograms.OnMoved(Dest, Source);
+	}
+
 
 	const FLLMTracker::FLowLevelAllocInfo& AllocInfo = Values.Value2;
 #if LLM_USE_ALLOC_INFO_STRUCT
@@ -1424,6 +1675,7 @@ void FLLMTracker::Clear()
 
 	AllocationMap.Clear();
 	CsvWriter.Clear();
+	Histograms.Clear();
 	ThreadStateAllocator.Clear();
 }
 
@@ -1506,6 +1758,32 @@ void FLLMTracker::WriteCsv(FLLMCustomTag* CustomTags, const int32* ParentTags)
 	CsvWriter.Update(CustomTags,ParentTags);
 }
 
+void FLLMTracker::EnableHistograms(uint32 SampleRate)
+{
+	if (!Histograms.IsEnabled())
+	{
+		Histograms.Enable(Allocator, SampleRate);
+		LastHistogramWriteTime = FPlatformTime::Seconds();
+	}
+}
+
+void FLLMTracker::WriteHistograms(FLLMCustomTag* CustomTags, const int32* ParentTags, bool bForce)
+{
+	if (!Histograms.IsEnabled())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (bForce || Now - LastHistogramWriteTime >= (double)CVarLLMWriteInterval.GetValueOnGameThread())
+	{
+		CsvWriter.WriteHistograms(Histograms, CustomTags, ParentTags);
+		Histograms.Trace(TrackerType);
+
+		LastHistogramWriteTime = Now;
+	}
+}
+
 int64 FLLMTracker::GetActiveTag()
 {
     FLLMThreadState* State = GetOrCreateState();
@@ -2010,7 +2288,68 @@ const TCHAR* FLLMCsvWriter::GetTrackerCsvName(ELLMTracker InTracker)
 */
 void FLLMCsvWriter::Write(const FString& Text)
 {
-	Archive->Serialize(TCHAR_TO_ANSI(*Text), Text.Len() * sizeof(ANSICHAR));
+	Write(Archive, Text);
+}
+
+void FLLMCsvWriter::Write(FArchive* Ar, const FString& Text)
+{
+	Ar->Serialize(TCHAR_TO_ANSI(*Text), Text.Len() * sizeof(ANSICHAR));
+}
+
+/*
+ * the histograms are rewritten as a whole every time, one row per tag. Counts are estimates for all allocations, not just the sampled ones.
+*/
+void FLLMCsvWriter::WriteHistograms(const FLLMHistograms& Histograms, FLLMCustomTag* CustomTags, const int32* ParentTags)
+{
+	FString Directory = FPaths::ProfilingDir() + "LLM/";
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+#if WITH_SERVER_CODE
+	FString Filename = FString::Printf(TEXT("%s/%sHistograms_Pid%d.csv"), *Directory, GetTrackerCsvName(Tracker), FPlatformProcess::GetCurrentProcessId());
+#else
+	FString Filename = FString::Printf(TEXT("%s/%sHistograms.csv"), *Directory, GetTrackerCsvName(Tracker));
+#endif
+	FArchive* HistogramArchive = IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_AllowRead);
+	if (!HistogramArchive)
+	{
+		return;
+	}
+
+	FString Header = TEXT("Tag,Allocs,Frees,Live");
+	for (int32 Bucket = 0; Bucket < FLLMHistograms::NumBuckets; ++Bucket)
+	{
+		Header += FString::Printf(TEXT(",Size%lluB"), 1ull << Bucket);
+	}
+	for (int32 Bucket = 0; Bucket < FLLMHistograms::NumBuckets; ++Bucket)
+	{
+		Header += FString::Printf(TEXT(",Lifetime%lluus"), 1ull << Bucket);
+	}
+	Write(HistogramArchive, Header + TEXT("\n"));
+
+	const int64 SampleRate = Histograms.GetSampleRate();
+	for (int32 TagSlot = 0; TagSlot < FLLMHistograms::NumTagSlots; ++TagSlot)
+	{
+		const FLLMHistograms::FTagHistogram& Histogram = Histograms.GetHistogram(TagSlot);
+		if (Histogram.NumAllocs == 0)
+		{
+			continue;
+		}
+
+		const int64 Tag = FLLMHistograms::GetTagForSlot(TagSlot);
+		FString Row = Tag < 0 ? FString(TEXT("StatTags")) : GetTagName(Tag, CustomTags, ParentTags);
+		Row += FString::Printf(TEXT(",%lld,%lld,%lld"), Histogram.NumAllocs * SampleRate, Histogram.NumFrees * SampleRate, (Histogram.NumAllocs - Histogram.NumFrees) * SampleRate);
+		for (int32 Bucket = 0; Bucket < FLLMHistograms::NumBuckets; ++Bucket)
+		{
+			Row += FString::Printf(TEXT(",%lld"), Histogram.SizeCounts[Bucket] * SampleRate);
+		}
+		for (int32 Bucket = 0; Bucket < FLLMHistograms::NumBuckets; ++Bucket)
+		{
+			Row += FString::Printf(TEXT(",%lld"), Histogram.LifetimeCounts[Bucket] * SampleRate);
+		}
+		Write(HistogramArchive, Row + TEXT("\n"));
+	}
+
+	delete HistogramArchive;
 }
 
 /*
@@ -86,6 +86,9 @@ static uint16 SmallBlockSizes[] =
 MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) static uint8 UnusedAlignPadding[PLATFORM_CACHE_LINE_SIZE] GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE) = { 0 };
 uint16 FMallocBinned2::SmallBlockSizesReversed[BINNED2_SMALL_POOL_COUNT] = { 0 };
 uint32 FMallocBinned2::Binned2TlsSlot = 0;
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+thread_local FMallocBinned2::FPerThreadFreeBlockLists* FMallocBinned2::ThreadFreeBlockLists TLS_INITIAL_EXEC = nullptr;
+#endif
 uint32 FMallocBinned2::OsAllocationGranularity = 0;
 uint32 FMallocBinned2::PageSize = 0;
 FMallocBinned2* FMallocBinned2::MallocBinned2 = nullptr;
@@ -1208,6 +1211,9 @@ void FMallocBinned2::FPerThreadFreeBlockLists::SetTLS()
 		Binned2TLSMemory += Align(sizeof(FPerThreadFreeBlockLists), FMallocBinned2::OsAllocationGranularity);
 #endif
 		FPlatformTLS::SetTlsValue(FMallocBinned2::Binned2TlsSlot, ThreadSingleton);
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+		FMallocBinned2::ThreadFreeBlockLists = ThreadSingleton;
+#endif
 		FMallocBinned2::Private::RegisterThreadFreeBlockLists(ThreadSingleton);
 	}
 }
@@ -1221,6 +1227,9 @@ void FMallocBinned2::FPerThreadFreeBlockLists::ClearTLS()
 		FMallocBinned2::Private::UnregisterThreadFreeBlockLists(ThreadSingleton);
 	}
 	FPlatformTLS::SetTlsValue(FMallocBinned2::Binned2TlsSlot, nullptr);
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+	FMallocBinned2::ThreadFreeBlockLists = nullptr;
+#endif
 }
 
 void FMallocBinned2::FFreeBlock::CanaryFail() const
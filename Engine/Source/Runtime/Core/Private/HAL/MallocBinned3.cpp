@@ -19,7 +19,7 @@ PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 #define BINNED3_MAX_CACHED_OS_FREES (64)
 #define BINNED3_MAX_CACHED_OS_FREES_BYTE_LIMIT (64*1024*1024)
 
-typedef TCachedOSPageAllocator<BINNED3_MAX_CACHED_OS_FREES, BINNED3_MAX_CACHED_OS_FREES_BYTE_LIMIT> TBinned3CachedOSPageAllocator;
+typedef TBinnedCachedOSPageAllocator<BINNED3_MAX_CACHED_OS_FREES, BINNED3_MAX_CACHED_OS_FREES_BYTE_LIMIT> TBinned3CachedOSPageAllocator;
 
 TBinned3CachedOSPageAllocator& GetCachedOSPageAllocator()
 {
@@ -66,6 +66,13 @@ static FAutoConsoleVariableRef GMallocBinned3AllocExtraCVar(
 	TEXT("When we do acquire the lock, how many blocks cached in TLS caches. In no case will we grab more than a page.")
 	);
 
+int32 GMallocBinned3MagazineDepth = DEFAULT_GMallocBinned3MagazineDepth;
+static FAutoConsoleVariableRef GMallocBinned3MagazineDepthCVar(
+	TEXT("MallocBinned3.MagazineDepth"),
+	GMallocBinned3MagazineDepth,
+	TEXT("Number of bundles other threads can free into the TLS cache of the thread allocating from a pool before they fall back to the global recycler. Limited by BINNED3_MAX_GMallocBinned3MagazineDepth (currently 8)")
+	);
+
 #endif
 
 #if BINNED3_ALLOCATOR_STATS
@@ -562,6 +569,15 @@ struct FMallocBinned3::Private
 
 	static FGlobalRecycler GGlobalRecycler;
 
+	// The thread that most recently ran out of cached blocks for each pool, remote frees are handed to it first.
+	// Thread caches are never deallocated, so a stale pointer is safe to use: a cache that went away has its inboxes closed.
+	static FPerThreadFreeBlockLists* GInboxOwners[BINNED3_SMALL_POOL_COUNT];
+
+	static FBundleNode* ClosedInbox()
+	{
+		return (FBundleNode*)UPTRINT(1);
+	}
+
 	static void FreeBundles(FMallocBinned3& Allocator, FBundleNode* BundlesToRecycle, uint32 InBlockSize, uint32 InPoolIndex)
 	{
 		FPoolTable& Table = Allocator.SmallPoolTables[InPoolIndex];
@@ -651,6 +667,10 @@ struct FMallocBinned3::Private
 	}
 	static void UnregisterThreadFreeBlockLists( FPerThreadFreeBlockLists* FreeBlockLists )
 	{
+		for (uint32 PoolIndex = 0; PoolIndex < BINNED3_SMALL_POOL_COUNT; ++PoolIndex)
+		{
+			FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GInboxOwners[PoolIndex], nullptr, FreeBlockLists);
+		}
 		FScopeLock Lock(&GetFreeBlockListsRegistrationMutex());
 		GetRegisteredFreeBlockLists().Remove(FreeBlockLists);
 #if BINNED3_ALLOCATOR_STATS
@@ -660,6 +680,7 @@ struct FMallocBinned3::Private
 };
 
 FMallocBinned3::Private::FGlobalRecycler FMallocBinned3::Private::GGlobalRecycler;
+FMallocBinned3::FPerThreadFreeBlockLists* FMallocBinned3::Private::GInboxOwners[BINNED3_SMALL_POOL_COUNT];
 
 #if BINNED3_ALLOCATOR_STATS
 TAtomic<int64> FMallocBinned3::FPerThreadFreeBlockLists::ConsolidatedMemory;
@@ -905,6 +926,12 @@ void FMallocBinned3::Commit(uint32 InPoolIndex, void *Ptr, SIZE_T Size)
 #if BINNED3_ALLOCATOR_STATS
 	Binned3Commits++;
 #endif
+#if UE_NUMA_AWARE_ALLOCATION
+	// the bundles carved from these pages usually stay with the thread that needed them
+	const int32 NumaNode = FPlatformMemory::GetCurrentNumaNode();
+	FPlatformMemory::BindToNumaNode(Ptr, Size, NumaNode);
+	FPlatformMemory::UpdateNumaNodeUsage(NumaNode, int64(Size));
+#endif
 #if !BINNED3_USE_SEPARATE_VM_PER_POOL
 	Binned3BaseVMBlock.CommitByPtr(Ptr, Size);
 #else
@@ -915,6 +942,9 @@ void FMallocBinned3::Commit(uint32 InPoolIndex, void *Ptr, SIZE_T Size)
 void FMallocBinned3::Decommit(uint32 InPoolIndex, void *Ptr, SIZE_T Size)
 {
 	LLM(FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Platform, Ptr));
+#if UE_NUMA_AWARE_ALLOCATION
+	FPlatformMemory::UpdateNumaNodeUsage(FPlatformMemory::GetNumaNodeForAddress(Ptr), -int64(Size));
+#endif
 
 #if BINNED3_ALLOCATOR_STATS
 	Binned3Decommits++;
@@ -1283,7 +1313,7 @@ const TCHAR* FMallocBinned3::GetDescriptiveName()
 	return TEXT("Binned3");
 }
 
-void FMallocBinned3::FlushCurrentThreadCache()
+void FMallocBinned3::FlushCurrentThreadCache(bool bCloseInboxes)
 {
 	double StartTimeInner = FPlatformTime::Seconds();
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_FMallocBinned3_FlushCurrentThreadCache);
@@ -1298,7 +1328,7 @@ void FMallocBinned3::FlushCurrentThreadCache()
 		WaitForMutexTime = FPlatformTime::Seconds() - StartTimeInner;
 		for (int32 PoolIndex = 0; PoolIndex != BINNED3_SMALL_POOL_COUNT; ++PoolIndex)
 		{
-			FBundleNode* Bundles = Lists->PopBundles(PoolIndex);
+			FBundleNode* Bundles = Lists->PopBundles(PoolIndex, bCloseInboxes);
 			if (Bundles)
 			{
 				Private::FreeBundles(*this, Bundles, PoolIndexToBlockSize(PoolIndex), PoolIndex);
@@ -1354,7 +1384,7 @@ void FMallocBinned3::SetupTLSCachesOnCurrentThread()
 
 void FMallocBinned3::ClearAndDisableTLSCachesOnCurrentThread()
 {
-	FlushCurrentThreadCache();
+	FlushCurrentThreadCache(true);
 	if (!BINNED3_ALLOW_RUNTIME_TWEAKING && !GMallocBinned3PerThreadCaches)
 	{
 		return;
@@ -1363,12 +1393,16 @@ void FMallocBinned3::ClearAndDisableTLSCachesOnCurrentThread()
 }
 
 
-bool FMallocBinned3::FFreeBlockList::ObtainPartial(uint32 InPoolIndex)
+bool FMallocBinned3::FFreeBlockList::ObtainPartial(uint32 InPoolIndex, FBundleInbox& InInbox)
 {
 	if (!PartialBundle.Head)
 	{
 		PartialBundle.Count = 0;
-		PartialBundle.Head = FMallocBinned3::Private::GGlobalRecycler.PopBundle(InPoolIndex);
+		PartialBundle.Head = InInbox.Pop();
+		if (!PartialBundle.Head)
+		{
+			PartialBundle.Head = FMallocBinned3::Private::GGlobalRecycler.PopBundle(InPoolIndex);
+		}
 		if (PartialBundle.Head)
 		{
 			PartialBundle.Count = PartialBundle.Head->Count;
@@ -1380,13 +1414,16 @@ bool FMallocBinned3::FFreeBlockList::ObtainPartial(uint32 InPoolIndex)
 	return true;
 }
 
-FMallocBinned3::FBundleNode* FMallocBinned3::FFreeBlockList::RecyleFull(uint32 InPoolIndex)
+FMallocBinned3::FBundleNode* FMallocBinned3::FFreeBlockList::RecyleFull(uint32 InPoolIndex, FPerThreadFreeBlockLists* InOwner)
 {
 	FMallocBinned3::FBundleNode* Result = nullptr;
 	if (FullBundle.Head)
 	{
 		FullBundle.Head->Count = FullBundle.Count;
-		if (!FMallocBinned3::Private::GGlobalRecycler.PushBundle(InPoolIndex, FullBundle.Head))
+		// hand the bundle to the thread that is allocating from this pool first, if it isn't us
+		FPerThreadFreeBlockLists* InboxOwner = FMallocBinned3::Private::GInboxOwners[InPoolIndex];
+		bool bRecycled = InboxOwner && InboxOwner != InOwner && InboxOwner->PushToInbox(InPoolIndex, FullBundle.Head);
+		if (!bRecycled && !FMallocBinned3::Private::GGlobalRecycler.PushBundle(InPoolIndex, FullBundle.Head))
 		{
 			Result = FullBundle.Head;
 			Result->NextBundle = nullptr;
@@ -1425,6 +1462,88 @@ FMallocBinned3::FBundleNode* FMallocBinned3::FFreeBlockList::PopBundles(uint32 I
 	return Result;
 }
 
+bool FMallocBinned3::FPerThreadFreeBlockLists::ObtainRecycledPartial(uint32 InPoolIndex)
+{
+	if (FreeLists[InPoolIndex].ObtainPartial(InPoolIndex, Inboxes[InPoolIndex]))
+	{
+		return true;
+	}
+	// we are about to take the lock, let the threads freeing into this pool know we're the one to feed
+	if (FMallocBinned3::Private::GInboxOwners[InPoolIndex] != this)
+	{
+		FPlatformAtomics::InterlockedExchangePtr((void**)&FMallocBinned3::Private::GInboxOwners[InPoolIndex], this);
+	}
+	return false;
+}
+
+FMallocBinned3::FBundleNode* FMallocBinned3::FPerThreadFreeBlockLists::PopBundles(uint32 InPoolIndex, bool bCloseInbox)
+{
+	FBundleNode* Result = FreeLists[InPoolIndex].PopBundles(InPoolIndex);
+	if (FBundleNode* Inbox = Inboxes[InPoolIndex].PopAll(bCloseInbox))
+	{
+		FBundleNode* Last = Inbox;
+		while (Last->NextBundle)
+		{
+			Last = Last->NextBundle;
+		}
+		Last->NextBundle = Result;
+		Result = Inbox;
+	}
+	return Result;
+}
+
+bool FMallocBinned3::FBundleInbox::Push(FBundleNode* InBundle)
+{
+	uint32 Depth = FMath::Min<uint32>(GMallocBinned3MagazineDepth, BINNED3_MAX_GMallocBinned3MagazineDepth);
+	for (uint32 Slot = 0; Slot < Depth; Slot++)
+	{
+		// closed slots hold a sentinel, so the exchange can only succeed on an open inbox
+		if (!Slots[Slot])
+		{
+			if (!FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Slots[Slot], InBundle, nullptr))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+FMallocBinned3::FBundleNode* FMallocBinned3::FBundleInbox::Pop()
+{
+	for (uint32 Slot = 0; Slot < BINNED3_MAX_GMallocBinned3MagazineDepth; Slot++)
+	{
+		FBundleNode* Result = Slots[Slot];
+		if (Result && Result != FMallocBinned3::Private::ClosedInbox())
+		{
+			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Slots[Slot], nullptr, Result) == Result)
+			{
+				return Result;
+			}
+		}
+	}
+	return nullptr;
+}
+
+FMallocBinned3::FBundleNode* FMallocBinned3::FBundleInbox::PopAll(bool bClose)
+{
+	FBundleNode* Result = nullptr;
+	for (uint32 Slot = 0; Slot < BINNED3_MAX_GMallocBinned3MagazineDepth; Slot++)
+	{
+		FBundleNode* Bundle = Slots[Slot];
+		if (Bundle || bClose)
+		{
+			Bundle = (FBundleNode*)FPlatformAtomics::InterlockedExchangePtr((void**)&Slots[Slot], bClose ? FMallocBinned3::Private::ClosedInbox() : nullptr);
+		}
+		if (Bundle && Bundle != FMallocBinned3::Private::ClosedInbox())
+		{
+			Bundle->NextBundle = Result;
+			Result = Bundle;
+		}
+	}
+	return Result;
+}
+
 void FMallocBinned3::FPerThreadFreeBlockLists::SetTLS()
 {
 	check(FMallocBinned3::Binned3TlsSlot);
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/MallocCountingProxy.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/ScopeLock.h"
+
+namespace UE4MallocCountingProxy_Private
+{
+	/** Plain thread locals, allocating here would recurse */
+	static thread_local FMallocThreadCounts GThreadCounts;
+
+	static FMallocCountingProxy* volatile GProxy = nullptr;
+}
+
+bool FMallocCountingProxy::Enable()
+{
+	using namespace UE4MallocCountingProxy_Private;
+
+	if (PLATFORM_USES_FIXED_GMalloc_CLASS)
+	{
+		return false;
+	}
+	if (GProxy)
+	{
+		return true;
+	}
+
+	// Make sure GMalloc exists, as FMemory creates it lazily
+	FMemory::Free(FMemory::Malloc(1));
+
+	static FCriticalSection EnableCritical;
+	FScopeLock ScopeLock(&EnableCritical);
+	while (!GProxy)
+	{
+		FMalloc* LocalGMalloc = GMalloc;
+		FMallocCountingProxy* Proxy = new FMallocCountingProxy(LocalGMalloc);
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GMalloc, Proxy, LocalGMalloc) == LocalGMalloc)
+		{
+			GProxy = Proxy;
+			break;
+		}
+		delete Proxy;
+	}
+	return true;
+}
+
+bool FMallocCountingProxy::IsEnabled()
+{
+	return UE4MallocCountingProxy_Private::GProxy != nullptr;
+}
+
+FMallocThreadCounts FMallocCountingProxy::GetThreadCounts()
+{
+	return UE4MallocCountingProxy_Private::GThreadCounts;
+}
+
+void* FMallocCountingProxy::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	FMallocThreadCounts& Counts = UE4MallocCountingProxy_Private::GThreadCounts;
+	++Counts.NumAllocations;
+	Counts.AllocatedBytes += Size;
+	return UsedMalloc->Malloc(Size, Alignment);
+}
+
+void* FMallocCountingProxy::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
+{
+	FMallocThreadCounts& Counts = UE4MallocCountingProxy_Private::GThreadCounts;
+	if (!Ptr)
+	{
+		++Counts.NumAllocations;
+		Counts.AllocatedBytes += NewSize;
+	}
+	else if (!NewSize)
+	{
+		++Counts.NumFrees;
+	}
+	else
+	{
+		++Counts.NumReallocations;
+		SIZE_T OldSize = 0;
+		if (UsedMalloc->GetAllocationSize(Ptr, OldSize) && NewSize > OldSize)
+		{
+			Counts.AllocatedBytes += NewSize - OldSize;
+		}
+	}
+	return UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+}
+
+void FMallocCountingProxy::Free(void* Ptr)
+{
+	if (Ptr)
+	{
+		++UE4MallocCountingProxy_Private::GThreadCounts.NumFrees;
+	}
+	UsedMalloc->Free(Ptr);
+}
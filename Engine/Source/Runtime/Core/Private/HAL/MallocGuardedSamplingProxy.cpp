@@ -0,0 +1,436 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/MallocGuardedSamplingProxy.h"
+#include "CoreGlobals.h"
+#include "Containers/StringConv.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/UnrealMemory.h"
+#include "Logging/LogMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CString.h"
+#include "Templates/AlignmentTemplates.h"
+
+CORE_API uint32 GMallocGuardedSamplingRate = 0;
+
+namespace MallocGuardedSamplingProxy
+{
+	struct FThreadState
+	{
+		/** Allocations left before the next sample, the one that makes it drop to zero or below is sampled. */
+		int32 AllocationsUntilSample;
+
+		/** xorshift state, zero until the thread made its first allocation. */
+		uint32 RandomState;
+
+		/** Non zero while the proxy itself is allocating, those allocations are never sampled. */
+		int32 Depth;
+	};
+
+	static thread_local FThreadState ThreadState;
+
+	/** The proxy that GMalloc goes through, the one the crash handlers ask about faults. */
+	static FMallocGuardedSamplingProxy* GInstalledProxy = nullptr;
+
+	/** Frames of CaptureStackBackTraceFast, the proxy and the FMalloc entry point that are of no interest. */
+	static const uint32 CallStackEntriesToSkipCount = 3;
+
+	struct FScopeGuard
+	{
+		FScopeGuard() { ++ThreadState.Depth; }
+		~FScopeGuard() { --ThreadState.Depth; }
+	};
+
+	static uint32 NextRandom(FThreadState& State)
+	{
+		uint32 X = State.RandomState;
+		X ^= X << 13;
+		X ^= X >> 17;
+		X ^= X << 5;
+		State.RandomState = X;
+		return X;
+	}
+
+	static uint32 CaptureCallStack(uint64* OutCallStack)
+	{
+		uint64 CallStack[FMallocGuardedSamplingProxy::MaxCallStackDepth + CallStackEntriesToSkipCount];
+		const uint32 NumFrames = FPlatformStackWalk::CaptureStackBackTraceFast(CallStack, UE_ARRAY_COUNT(CallStack));
+		const uint32 NumSkippedFrames = FMath::Min(NumFrames, CallStackEntriesToSkipCount);
+		FMemory::Memcpy(OutCallStack, CallStack + NumSkippedFrames, (NumFrames - NumSkippedFrames) * sizeof(uint64));
+		return NumFrames - NumSkippedFrames;
+	}
+
+	static void AppendCallStack(const uint64* CallStack, uint32 NumFrames, FString& OutDescription)
+	{
+		for (uint32 Index = 0; Index < NumFrames; ++Index)
+		{
+			ANSICHAR Line[1024];
+			Line[0] = '\0';
+			FPlatformStackWalk::ProgramCounterToHumanReadableString(Index, CallStack[Index], Line, UE_ARRAY_COUNT(Line));
+			OutDescription += FString::Printf(TEXT("\t%s\n"), ANSI_TO_TCHAR(Line));
+		}
+	}
+}
+
+FMallocGuardedSamplingProxy::FMallocGuardedSamplingProxy(FMalloc* InMalloc, uint32 InSampleRate, uint32 InNumSlots)
+	: UsedMalloc(InMalloc)
+	, SampleRate(FMath::Clamp<uint32>(InSampleRate, 1, 1u << 30))
+	, NumSlots(FMath::Max<uint32>(InNumSlots, 1))
+	, PageSize(FMath::Max<SIZE_T>(FPlatformMemory::GetConstants().PageSize, FPlatformMemory::FPlatformVirtualMemoryBlock::GetCommitAlignment()))
+	, PoolBegin(0)
+	, PoolSize(0)
+	, NumNeverUsedSlots(NumSlots)
+	, FreedSlotsHead(0)
+	, NumFreedSlots(0)
+	, NumSampled(0)
+	, NumPoolFull(0)
+{
+	checkf(UsedMalloc, TEXT("FMallocGuardedSamplingProxy is used without a valid malloc!"));
+
+	const SIZE_T MetadataSize = NumSlots * (sizeof(FSlot) + sizeof(int32));
+	Slots = (FSlot*)FPlatformMemory::BinnedAllocFromOS(MetadataSize);
+	FreedSlots = (int32*)(Slots + NumSlots);
+	FMemory::Memzero(Slots, MetadataSize);
+
+	// reserved pages can be accessible on some platforms, Unix maps them read-write, so make sure the whole pool starts out faulting
+	Pool = FPlatformMemory::FPlatformVirtualMemoryBlock::AllocateVirtual((2 * SIZE_T(NumSlots) + 1) * PageSize);
+	FPlatformMemory::PageProtect(Pool.GetVirtualPointer(), Pool.GetActualSize(), false, false);
+
+	// set last, IsInPool stays false until the pool can be looked at
+	PoolBegin = UPTRINT(Pool.GetVirtualPointer());
+	PoolSize = (2 * SIZE_T(NumSlots) + 1) * PageSize;
+}
+
+FMallocGuardedSamplingProxy::~FMallocGuardedSamplingProxy()
+{
+	if (MallocGuardedSamplingProxy::GInstalledProxy == this)
+	{
+		MallocGuardedSamplingProxy::GInstalledProxy = nullptr;
+	}
+	Pool.FreeVirtual();
+	FPlatformMemory::BinnedFreeToOS(Slots, NumSlots * (sizeof(FSlot) + sizeof(int32)));
+}
+
+FMalloc* FMallocGuardedSamplingProxy::OverrideIfEnabled(FMalloc* InUsedAlloc)
+{
+	if (GMallocGuardedSamplingRate)
+	{
+		FMallocGuardedSamplingProxy* Proxy = new FMallocGuardedSamplingProxy(InUsedAlloc, GMallocGuardedSamplingRate);
+		MallocGuardedSamplingProxy::GInstalledProxy = Proxy;
+		return Proxy;
+	}
+	return InUsedAlloc;
+}
+
+void* FMallocGuardedSamplingProxy::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	MallocGuardedSamplingProxy::FThreadState& State = MallocGuardedSamplingProxy::ThreadState;
+	if (UNLIKELY(--State.AllocationsUntilSample <= 0))
+	{
+		if (void* Result = SampleAllocation(Size, Alignment))
+		{
+			return Result;
+		}
+	}
+	return UsedMalloc->Malloc(Size, Alignment);
+}
+
+void* FMallocGuardedSamplingProxy::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
+{
+	if (UNLIKELY(IsInPool(Ptr)))
+	{
+		// only a live allocation has a size to copy, GuardedFree reports any other pointer
+		const int32 SlotIndex = GetSlotIndex(UPTRINT(Ptr));
+		const FSlot* Slot = SlotIndex != INDEX_NONE ? &Slots[SlotIndex] : nullptr;
+		const SIZE_T OldSize = Slot && !Slot->bFreed && Slot->Address == UPTRINT(Ptr) ? Slot->Size : 0;
+
+		void* Result = NewSize ? Malloc(NewSize, Alignment) : nullptr;
+		if (Result)
+		{
+			FMemory::Memcpy(Result, Ptr, FMath::Min(OldSize, NewSize));
+		}
+		GuardedFree(Ptr);
+		return Result;
+	}
+	return UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+}
+
+void FMallocGuardedSamplingProxy::Free(void* Ptr)
+{
+	if (UNLIKELY(IsInPool(Ptr)))
+	{
+		GuardedFree(Ptr);
+		return;
+	}
+	UsedMalloc->Free(Ptr);
+}
+
+bool FMallocGuardedSamplingProxy::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	if (IsInPool(Original))
+	{
+		const int32 SlotIndex = GetSlotIndex(UPTRINT(Original));
+		if (SlotIndex == INDEX_NONE || Slots[SlotIndex].Address != UPTRINT(Original))
+		{
+			return false;
+		}
+		SizeOut = Slots[SlotIndex].Size;
+		return true;
+	}
+	return UsedMalloc->GetAllocationSize(Original, SizeOut);
+}
+
+void FMallocGuardedSamplingProxy::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	UsedMalloc->DumpAllocatorStats(Ar);
+
+	FScopeLock Lock(&SlotsCritical);
+	Ar.Logf(TEXT("Guarded sampling: one in %u allocations, %llu sampled, %u of %u slots in use, %llu not sampled with all the slots in use"),
+		SampleRate, NumSampled, NumSlots - NumNeverUsedSlots - NumFreedSlots, NumSlots, NumPoolFull);
+}
+
+void* FMallocGuardedSamplingProxy::SampleAllocation(SIZE_T Size, uint32 Alignment)
+{
+	using namespace MallocGuardedSamplingProxy;
+
+	FThreadState& State = ThreadState;
+	const bool bFirstAllocation = State.RandomState == 0;
+	if (bFirstAllocation)
+	{
+		State.RandomState = ((FPlatformTLS::GetCurrentThreadId() * 0x9E3779B9u) ^ uint32(FPlatformTime::Cycles64())) | 1;
+	}
+
+	// uniform over [1, 2 * SampleRate] so that threads do not sample in step
+	State.AllocationsUntilSample = int32(1 + NextRandom(State) % (2 * uint64(SampleRate)));
+
+	// the first allocation of a thread only seeds it, otherwise every thread start would be sampled
+	if (bFirstAllocation || State.Depth || Size == 0 || Size > PageSize || Alignment > PageSize)
+	{
+		return nullptr;
+	}
+
+	FScopeGuard Guard;
+
+	int32 SlotIndex;
+	{
+		FScopeLock Lock(&SlotsCritical);
+		if (NumNeverUsedSlots)
+		{
+			SlotIndex = int32(NumSlots - NumNeverUsedSlots--);
+		}
+		else if (NumFreedSlots)
+		{
+			// the slot freed the longest time ago, so that the others catch a use after free for as long as possible
+			SlotIndex = FreedSlots[FreedSlotsHead];
+			FreedSlotsHead = (FreedSlotsHead + 1) % NumSlots;
+			--NumFreedSlots;
+		}
+		else
+		{
+			++NumPoolFull;
+			return nullptr;
+		}
+		++NumSampled;
+	}
+
+	const UPTRINT Page = GetSlotPage(SlotIndex);
+	Pool.Commit(Page - PoolBegin, PageSize);
+	FPlatformMemory::PageProtect((void*)Page, PageSize, true, true);
+
+	// against the guard page after the allocation to catch overflows, or the one before it to catch underflows,
+	// small overflows within the alignment of an allocation placed at the end of its page are not caught
+	const SIZE_T EffectiveAlignment = FMath::Max<SIZE_T>(Alignment, Size >= 16 ? 16 : 8);
+	const bool bAtEnd = (NextRandom(State) & 1) != 0;
+	const UPTRINT Address = bAtEnd ? AlignDown(Page + PageSize - Size, EffectiveAlignment) : Page;
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Address = Address;
+	Slot.Size = Size;
+	Slot.AllocThreadId = FPlatformTLS::GetCurrentThreadId();
+	Slot.FreeThreadId = 0;
+	Slot.NumAllocFrames = CaptureCallStack(Slot.AllocCallStack);
+	Slot.NumFreeFrames = 0;
+	Slot.bFreed = false;
+
+	return (void*)Address;
+}
+
+void FMallocGuardedSamplingProxy::GuardedFree(void* Ptr)
+{
+	using namespace MallocGuardedSamplingProxy;
+
+	FScopeGuard Guard;
+
+	uint64 FreeCallStack[MaxCallStackDepth];
+	const uint32 NumFreeFrames = CaptureCallStack(FreeCallStack);
+
+	const UPTRINT Address = UPTRINT(Ptr);
+	const bool bOnSlotPage = (((Address - PoolBegin) / PageSize) & 1) != 0;
+	const int32 SlotIndex = GetSlotIndex(Address);
+
+	FString Description;
+	{
+		FScopeLock Lock(&SlotsCritical);
+		FSlot* Slot = SlotIndex != INDEX_NONE ? &Slots[SlotIndex] : nullptr;
+		if (!bOnSlotPage || !Slot || Slot->Address != Address)
+		{
+			Describe(Address, TEXT("Invalid free"), Description);
+		}
+		else if (Slot->bFreed)
+		{
+			Describe(Address, TEXT("Double free"), Description);
+		}
+		else
+		{
+			// inaccessible before it can be handed out again
+			FPlatformMemory::PageProtect((void*)GetSlotPage(SlotIndex), PageSize, false, false);
+			Pool.Decommit(GetSlotPage(SlotIndex) - PoolBegin, PageSize);
+
+			Slot->bFreed = true;
+			Slot->FreeThreadId = FPlatformTLS::GetCurrentThreadId();
+			Slot->NumFreeFrames = NumFreeFrames;
+			FMemory::Memcpy(Slot->FreeCallStack, FreeCallStack, NumFreeFrames * sizeof(uint64));
+
+			FreedSlots[(FreedSlotsHead + NumFreedSlots) % NumSlots] = SlotIndex;
+			++NumFreedSlots;
+			return;
+		}
+	}
+
+	Description += FString::Printf(TEXT("Freed again by thread %u:\n"), FPlatformTLS::GetCurrentThreadId());
+	AppendCallStack(FreeCallStack, NumFreeFrames, Description);
+	UE_LOG(LogMemory, Fatal, TEXT("%s"), *Description);
+}
+
+int32 FMallocGuardedSamplingProxy::GetSlotIndex(UPTRINT Address) const
+{
+	const SIZE_T PageIndex = (Address - PoolBegin) / PageSize;
+	if (PageIndex & 1)
+	{
+		return int32(PageIndex / 2);
+	}
+
+	// a guard page belongs to the slot before it in its first half, to the slot after it in its second half
+	const int32 SlotBefore = int32(PageIndex / 2) - 1;
+	const int32 SlotAfter = int32(PageIndex / 2);
+	const bool bFirstHalf = (Address - PoolBegin) % PageSize < PageSize / 2;
+	if ((bFirstHalf && SlotBefore >= 0) || SlotAfter >= int32(NumSlots))
+	{
+		return SlotBefore;
+	}
+	return SlotAfter;
+}
+
+void FMallocGuardedSamplingProxy::Describe(UPTRINT Address, const TCHAR* Error, FString& OutDescription) const
+{
+	const int32 SlotIndex = GetSlotIndex(Address);
+	const FSlot* Slot = SlotIndex != INDEX_NONE ? &Slots[SlotIndex] : nullptr;
+	if (!Slot || !Slot->Address)
+	{
+		OutDescription += FString::Printf(TEXT("%s at 0x%016llx, on a guarded page that was never allocated\n"), Error, uint64(Address));
+		return;
+	}
+
+	const UPTRINT Begin = Slot->Address;
+	const UPTRINT End = Slot->Address + Slot->Size;
+	FString Where;
+	if (Address < Begin)
+	{
+		Where = FString::Printf(TEXT("%llu bytes before"), uint64(Begin - Address));
+	}
+	else if (Address >= End)
+	{
+		Where = FString::Printf(TEXT("%llu bytes after the end of"), uint64(Address - End));
+	}
+	else
+	{
+		Where = FString::Printf(TEXT("%llu bytes into"), uint64(Address - Begin));
+	}
+
+	OutDescription += FString::Printf(TEXT("%s at 0x%016llx, %s the %s allocation of %llu bytes at 0x%016llx\n"),
+		Error, uint64(Address), *Where, Slot->bFreed ? TEXT("freed") : TEXT("live"), uint64(Slot->Size), uint64(Begin));
+
+	OutDescription += FString::Printf(TEXT("Allocated by thread %u:\n"), Slot->AllocThreadId);
+	MallocGuardedSamplingProxy::AppendCallStack(Slot->AllocCallStack, Slot->NumAllocFrames, OutDescription);
+	if (Slot->bFreed)
+	{
+		OutDescription += FString::Printf(TEXT("Freed by thread %u:\n"), Slot->FreeThreadId);
+		MallocGuardedSamplingProxy::AppendCallStack(Slot->FreeCallStack, Slot->NumFreeFrames, OutDescription);
+	}
+}
+
+bool FMallocGuardedSamplingProxy::DescribeAddress(const void* Address, FString& OutDescription)
+{
+	const FMallocGuardedSamplingProxy* Proxy = MallocGuardedSamplingProxy::GInstalledProxy;
+	if (!Proxy || !Proxy->IsInPool(Address))
+	{
+		return false;
+	}
+
+	const UPTRINT Ptr = UPTRINT(Address);
+	const int32 SlotIndex = Proxy->GetSlotIndex(Ptr);
+	const FSlot* Slot = SlotIndex != INDEX_NONE ? &Proxy->Slots[SlotIndex] : nullptr;
+
+	const TCHAR* Error = TEXT("Invalid access");
+	if (Slot && Slot->Address)
+	{
+		if (Slot->bFreed)
+		{
+			Error = TEXT("Use after free");
+		}
+		else if (Ptr >= Slot->Address + Slot->Size)
+		{
+			Error = TEXT("Buffer overflow");
+		}
+		else if (Ptr < Slot->Address)
+		{
+			Error = TEXT("Buffer underflow");
+		}
+	}
+
+	Proxy->Describe(Ptr, Error, OutDescription);
+	return true;
+}
+
+static void EnableGuardedSampling(const TArray<FString>& Args)
+{
+#if !PLATFORM_USES_FIXED_GMalloc_CLASS
+	static bool bOnce = false;
+	if (bOnce || MallocGuardedSamplingProxy::GInstalledProxy)
+	{
+		UE_LOG(LogMemory, Error, TEXT("Guarded sampling proxy was already turned on."));
+		return;
+	}
+	bOnce = true;
+
+	const uint32 SampleRate = Args.Num() > 0 ? uint32(FMath::Max(FCString::Atoi(*Args[0]), 1)) : FMallocGuardedSamplingProxy::DefaultSampleRate;
+
+	// allocations made before the proxy was installed are not in its pool, so their frees go straight through
+	while (true)
+	{
+		FMalloc* LocalGMalloc = GMalloc;
+		FMallocGuardedSamplingProxy* Proxy = new FMallocGuardedSamplingProxy(LocalGMalloc, SampleRate);
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GMalloc, Proxy, LocalGMalloc) == LocalGMalloc)
+		{
+			MallocGuardedSamplingProxy::GInstalledProxy = Proxy;
+			UE_LOG(LogConsoleResponse, Display, TEXT("Guarded sampling proxy is now on, guarding one in %u allocations on average."), SampleRate);
+			return;
+		}
+		delete Proxy;
+	}
+#else
+	UE_LOG(LogMemory, Error, TEXT("Guarded sampling proxy requires an allocator that can be proxied."));
+#endif
+}
+
+static FAutoConsoleCommand FMallocUseGuardedSamplingCommand
+(
+	TEXT("Memory.UseGuardedSampling"),
+	TEXT("Installs the guarded sampling malloc proxy, which puts sampled allocations between guard pages to catch overflows and uses after free, optionally with the mean number of allocations between samples."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&EnableGuardedSampling)
+);
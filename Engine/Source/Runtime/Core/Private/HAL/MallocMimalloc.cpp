@@ -7,6 +7,7 @@
 #include "HAL/MallocMimalloc.h"
 #include "Math/UnrealMathUtility.h"
 #include "HAL/UnrealMemory.h"
+#include "HAL/PlatformTLS.h"
 
 // Only use for supported platforms
 #if PLATFORM_SUPPORTS_MIMALLOC && MIMALLOC_ALLOCATOR_ALLOWED
@@ -161,4 +162,157 @@ void FMallocMimalloc::Trim(bool bTrimThreadCaches)
 {
 }
 
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+FMimallocHeap::FMimallocHeap(const TCHAR* InName, ELLMTag InLLMTag)
+	: LLMTag(InLLMTag)
+#else
+FMimallocHeap::FMimallocHeap(const TCHAR* InName)
+#endif
+{
+	Heap = mi_heap_new();
+	Name = InName;
+	OwnerThreadId = FPlatformTLS::GetCurrentThreadId();
+	checkf(Heap, TEXT("Could not create the mimalloc heap %s"), InName);
+}
+
+FMimallocHeap::~FMimallocHeap()
+{
+	CheckOwnerThread();
+	checkf(mi_heap_get_default() != Heap, TEXT("The mimalloc heap %s is destroyed within its own FMimallocHeapScope"), Name);
+	mi_heap_delete(Heap);
+}
+
+bool FMimallocHeap::IsGMallocMimalloc()
+{
+	return FPlatformMemory::AllocatorToUse == FPlatformMemory::Mimalloc;
+}
+
+void FMimallocHeap::CheckOwnerThread() const
+{
+	checkf(FPlatformTLS::GetCurrentThreadId() == OwnerThreadId, TEXT("The mimalloc heap %s is used on a thread other than the one that created it"), Name);
+}
+
+void* FMimallocHeap::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	CheckOwnerThread();
+
+	const uint32 MinAlignment = Size >= 16 ? 16 : 8;
+	void* NewPtr = mi_heap_malloc_aligned(Heap, Size, FMath::Max(MinAlignment, Alignment));
+	if (NewPtr == nullptr && Size)
+	{
+		FPlatformMemory::OnOutOfMemory(Size, Alignment);
+	}
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	LLM_IF_ENABLED(FLowLevelMemTracker::Get().OnLowLevelAlloc(ELLMTracker::Default, NewPtr, Size, LLMTag, ELLMAllocType::FMalloc));
+#endif
+	return NewPtr;
+}
+
+void* FMimallocHeap::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
+{
+	CheckOwnerThread();
+
+	if (NewSize == 0)
+	{
+		Free(Ptr);
+		return nullptr;
+	}
+
+	const uint32 MinAlignment = NewSize >= 16 ? 16 : 8;
+	void* NewPtr = mi_heap_realloc_aligned(Heap, Ptr, NewSize, FMath::Max(MinAlignment, Alignment));
+	if (NewPtr == nullptr)
+	{
+		FPlatformMemory::OnOutOfMemory(NewSize, Alignment);
+	}
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	LLM_IF_ENABLED(if (Ptr) FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Default, Ptr, ELLMAllocType::FMalloc));
+	LLM_IF_ENABLED(FLowLevelMemTracker::Get().OnLowLevelAlloc(ELLMTracker::Default, NewPtr, NewSize, LLMTag, ELLMAllocType::FMalloc));
+#endif
+	return NewPtr;
+}
+
+void FMimallocHeap::Free(void* Ptr)
+{
+	if (Ptr)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		LLM_IF_ENABLED(FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Default, Ptr, ELLMAllocType::FMalloc));
+#endif
+		mi_free(Ptr);
+	}
+}
+
+void FMimallocHeap::Reset()
+{
+	CheckOwnerThread();
+	checkf(mi_heap_get_default() != Heap, TEXT("The mimalloc heap %s is reset within its own FMimallocHeapScope"), Name);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	// LLM only knows of the blocks it is told about, the one place where this has to walk them all
+	if (FLowLevelMemTracker::IsEnabled())
+	{
+		mi_heap_visit_blocks(Heap, true, [](const mi_heap_t*, const mi_heap_area_t*, void* Block, size_t, void*) -> bool
+		{
+			if (Block)
+			{
+				FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Default, Block, ELLMAllocType::FMalloc);
+			}
+			return true;
+		}, nullptr);
+	}
+#endif
+
+	// releases the pages of the heap as they are, the heap itself goes with them
+	mi_heap_destroy(Heap);
+	Heap = mi_heap_new();
+	checkf(Heap, TEXT("Could not create the mimalloc heap %s"), Name);
+}
+
+bool FMimallocHeap::Contains(const void* Ptr) const
+{
+	return mi_heap_contains_block(Heap, Ptr);
+}
+
+void FMimallocHeap::GetStats(SIZE_T& OutUsedSize, SIZE_T& OutCommittedSize) const
+{
+	struct FStats
+	{
+		SIZE_T Used;
+		SIZE_T Committed;
+	};
+	FStats Stats = { 0, 0 };
+
+	mi_heap_visit_blocks(Heap, false, [](const mi_heap_t*, const mi_heap_area_t* Area, void*, size_t, void* Arg) -> bool
+	{
+		// used is the number of blocks in use, whatever the comment in mimalloc.h says
+		FStats* AreaStats = (FStats*)Arg;
+		AreaStats->Used += Area->used * Area->block_size;
+		AreaStats->Committed += Area->committed;
+		return true;
+	}, &Stats);
+
+	OutUsedSize = Stats.Used;
+	OutCommittedSize = Stats.Committed;
+}
+
+FMimallocHeapScope::FMimallocHeapScope(FMimallocHeap& Heap)
+{
+	Heap.CheckOwnerThread();
+	PreviousHeap = mi_heap_set_default(Heap.Heap);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (Heap.LLMTag != ELLMTag::Untagged)
+	{
+		LLMScope.Emplace(Heap.LLMTag, ELLMTagSet::None, ELLMTracker::Default);
+	}
+#endif
+}
+
+FMimallocHeapScope::~FMimallocHeapScope()
+{
+	mi_heap_set_default(PreviousHeap);
+}
+
 #endif
@@ -102,8 +102,9 @@ void FMallocReplayProxy::Free(void* Ptr)
 {
 	if (LIKELY(Ptr))
 	{
-		UsedMalloc->Free(Ptr);
+		// record before freeing, so that no other thread can be handed the same address and record it first
 		AddToHistory("Free", nullptr, Ptr, 0, 0);
+		UsedMalloc->Free(Ptr);
 	}
 }
 
@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/MallocSamplingProxy.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/UnrealMemory.h"
+#include "Logging/LogMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CString.h"
+#include "Trace/Trace.h"
+
+CORE_API uint64 GMallocSamplingProxyInterval = 0;
+
+UE_TRACE_CHANNEL(HeapSamplingChannel)
+
+UE_TRACE_EVENT_BEGIN(HeapSampling, SampledAlloc)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Address)
+	UE_TRACE_EVENT_FIELD(uint64, Size)
+	UE_TRACE_EVENT_FIELD(uint64, Weight)
+	UE_TRACE_EVENT_FIELD(uint32, Alignment)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(HeapSampling, SampledFree)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Address)
+UE_TRACE_EVENT_END()
+
+namespace MallocSamplingProxy
+{
+	struct FThreadState
+	{
+		/** Bytes left to allocate before the next sample, the allocation that makes it drop to zero or below is sampled. */
+		int64 BytesUntilSample;
+
+		/** xorshift state, zero until the thread made its first allocation. */
+		uint32 RandomState;
+
+		/** Non zero while the proxy itself is allocating, those allocations are never sampled. */
+		int32 Depth;
+	};
+
+	static thread_local FThreadState ThreadState;
+
+	/** Frames of CaptureStackBackTraceFast, SampleAllocation and the FMalloc entry point that are of no interest. */
+	static const uint32 CallStackEntriesToSkipCount = 3;
+
+	struct FScopeGuard
+	{
+		FScopeGuard() { ++ThreadState.Depth; }
+		~FScopeGuard() { --ThreadState.Depth; }
+	};
+}
+
+FMallocSamplingProxy::FMallocSamplingProxy(FMalloc* InMalloc, uint64 InSampleInterval)
+	: UsedMalloc(InMalloc)
+	, SampleInterval(FMath::Max<uint64>(InSampleInterval, 1))
+{
+	checkf(UsedMalloc, TEXT("FMallocSamplingProxy is used without a valid malloc!"));
+	FMemory::Memzero((void*)SampledFilter, sizeof(SampledFilter));
+}
+
+FMalloc* FMallocSamplingProxy::OverrideIfEnabled(FMalloc* InUsedAlloc)
+{
+#if UE_TRACE_ENABLED
+	if (GMallocSamplingProxyInterval)
+	{
+		return new FMallocSamplingProxy(InUsedAlloc, GMallocSamplingProxyInterval);
+	}
+#endif
+	return InUsedAlloc;
+}
+
+void* FMallocSamplingProxy::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	void* Result = UsedMalloc->Malloc(Size, Alignment);
+
+	MallocSamplingProxy::FThreadState& State = MallocSamplingProxy::ThreadState;
+	State.BytesUntilSample -= (int64)Size;
+	if (UNLIKELY(State.BytesUntilSample <= 0))
+	{
+		SampleAllocation(Result, Size, Alignment);
+	}
+	return Result;
+}
+
+void* FMallocSamplingProxy::Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment)
+{
+	// the free has to be reported before the memory can be handed out again on another thread
+	if (Ptr && UNLIKELY(MightBeSampled(Ptr)))
+	{
+		OnSampledFree(Ptr);
+	}
+
+	void* Result = UsedMalloc->Realloc(Ptr, NewSize, Alignment);
+
+	// treat the result as a new allocation of the full size, a sample has to describe the block as it is now
+	MallocSamplingProxy::FThreadState& State = MallocSamplingProxy::ThreadState;
+	State.BytesUntilSample -= (int64)NewSize;
+	if (UNLIKELY(State.BytesUntilSample <= 0) && NewSize)
+	{
+		SampleAllocation(Result, NewSize, Alignment);
+	}
+	return Result;
+}
+
+void FMallocSamplingProxy::Free(void* Ptr)
+{
+	if (Ptr && UNLIKELY(MightBeSampled(Ptr)))
+	{
+		OnSampledFree(Ptr);
+	}
+	UsedMalloc->Free(Ptr);
+}
+
+int64 FMallocSamplingProxy::DrawSampleDistance()
+{
+	MallocSamplingProxy::FThreadState& State = MallocSamplingProxy::ThreadState;
+
+	uint32 X = State.RandomState;
+	X ^= X << 13;
+	X ^= X >> 17;
+	X ^= X << 5;
+	State.RandomState = X;
+
+	// exponentially distributed distances make the sample points a Poisson process over the allocated bytes
+	const float Uniform = float((X >> 8) + 1) * (1.0f / 16777216.0f);
+	const double Distance = -FMath::Loge(Uniform) * (double)SampleInterval;
+	return FMath::Clamp<int64>((int64)Distance, 1, (int64)SampleInterval * 32);
+}
+
+void FMallocSamplingProxy::SampleAllocation(void* Ptr, SIZE_T Size, uint32 Alignment)
+{
+	using namespace MallocSamplingProxy;
+
+	FThreadState& State = ThreadState;
+	if (State.RandomState == 0)
+	{
+		// first allocation on this thread, nothing to sample yet
+		State.RandomState = ((FPlatformTLS::GetCurrentThreadId() * 0x9E3779B9u) ^ uint32(FPlatformTime::Cycles64())) | 1;
+		State.BytesUntilSample = DrawSampleDistance();
+		return;
+	}
+
+	// an allocation larger than the distance may cross several sample points, it is still reported once
+	do
+	{
+		State.BytesUntilSample += DrawSampleDistance();
+	}
+	while (State.BytesUntilSample <= 0);
+
+	if (!Ptr || State.Depth || !UE_TRACE_CHANNELEXPR_IS_ENABLED(HeapSamplingChannel))
+	{
+		return;
+	}
+
+	FScopeGuard Guard;
+
+	uint64 CallStack[MaxCallStackDepth + CallStackEntriesToSkipCount];
+	const uint32 NumFrames = FPlatformStackWalk::CaptureStackBackTraceFast(CallStack, MaxCallStackDepth + CallStackEntriesToSkipCount);
+	const uint32 NumSkippedFrames = FMath::Min(NumFrames, CallStackEntriesToSkipCount);
+	const uint16 CallStackSize = uint16((NumFrames - NumSkippedFrames) * sizeof(uint64));
+
+	{
+		FScopeLock Lock(&SampledAllocationsCritical);
+		SampledAllocations.Add(Ptr);
+		FPlatformAtomics::InterlockedIncrement(&SampledFilter[GetFilterIndex(Ptr)]);
+	}
+
+	// an allocation of Size is sampled with probability 1 - e^(-Size / SampleInterval), this is the unbiased number of bytes it stands for
+	const double Probability = 1.0 - FMath::Exp(-(double)Size / (double)SampleInterval);
+	const uint64 Weight = Probability > 0.0 ? uint64((double)Size / Probability) : SampleInterval;
+
+	UE_TRACE_LOG(HeapSampling, SampledAlloc, HeapSamplingChannel, CallStackSize)
+		<< SampledAlloc.Cycle(FPlatformTime::Cycles64())
+		<< SampledAlloc.Address(uint64(UPTRINT(Ptr)))
+		<< SampledAlloc.Size(uint64(Size))
+		<< SampledAlloc.Weight(Weight)
+		<< SampledAlloc.Alignment(Alignment)
+		<< SampledAlloc.Attachment(CallStack + NumSkippedFrames, CallStackSize);
+}
+
+void FMallocSamplingProxy::OnSampledFree(void* Ptr)
+{
+	using namespace MallocSamplingProxy;
+
+	if (ThreadState.Depth)
+	{
+		// the proxy's own memory is never sampled
+		return;
+	}
+
+	FScopeGuard Guard;
+	{
+		FScopeLock Lock(&SampledAllocationsCritical);
+		if (SampledAllocations.Remove(Ptr) == 0)
+		{
+			// another sample shares the counter
+			return;
+		}
+		FPlatformAtomics::InterlockedDecrement(&SampledFilter[GetFilterIndex(Ptr)]);
+	}
+
+	UE_TRACE_LOG(HeapSampling, SampledFree, HeapSamplingChannel)
+		<< SampledFree.Cycle(FPlatformTime::Cycles64())
+		<< SampledFree.Address(uint64(UPTRINT(Ptr)));
+}
+
+static void EnableHeapSampling(const TArray<FString>& Args)
+{
+#if UE_TRACE_ENABLED && !PLATFORM_USES_FIXED_GMalloc_CLASS
+	static bool bOnce = false;
+	if (bOnce || GMallocSamplingProxyInterval)
+	{
+		UE_LOG(LogMemory, Error, TEXT("Heap sampling proxy was already turned on."));
+		return;
+	}
+	bOnce = true;
+
+	const uint64 SampleInterval = Args.Num() > 0 ? FMath::Max<int64>(FCString::Atoi64(*Args[0]), 1) : FMallocSamplingProxy::DefaultSampleInterval;
+
+	// allocations made before the proxy was installed were not sampled, so their frees go straight through
+	while (true)
+	{
+		FMalloc* LocalGMalloc = GMalloc;
+		FMalloc* Proxy = new FMallocSamplingProxy(LocalGMalloc, SampleInterval);
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GMalloc, Proxy, LocalGMalloc) == LocalGMalloc)
+		{
+			UE_LOG(LogConsoleResponse, Display, TEXT("Heap sampling proxy is now on, sampling every %llu bytes on average."), SampleInterval);
+			return;
+		}
+		delete Proxy;
+	}
+#else
+	UE_LOG(LogMemory, Error, TEXT("Heap sampling proxy requires trace support and an allocator that can be proxied."));
+#endif
+}
+
+static FAutoConsoleCommand FMallocUseHeapSamplingCommand
+(
+	TEXT("Memory.UseHeapSampling"),
+	TEXT("Installs the heap sampling malloc proxy, optionally with the mean number of bytes between samples. Record with -trace=heapsampling."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&EnableHeapSampling)
+);
@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/UnrealMemory.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/CPUFeatures.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/AlignmentTemplates.h"
+
+#if PLATFORM_HAS_CPUID && PLATFORM_ENABLE_VECTORINTRINSICS
+	#define UE_NONTEMPORAL_MEMORY_X86 1
+	#include <immintrin.h>
+#else
+	#define UE_NONTEMPORAL_MEMORY_X86 0
+#endif
+
+static int32 GNonTemporalThreshold = 1024 * 1024;
+static FAutoConsoleVariableRef CVarNonTemporalThreshold(
+	TEXT("memory.NonTemporalThreshold"),
+	GNonTemporalThreshold,
+	TEXT("Size in bytes from which FMemory::NonTemporalMemcpy and NonTemporalMemset bypass the caches, smaller blocks are likely to be read again soon."),
+	ECVF_Default
+);
+
+static int32 GParallelMemcpyThreshold = 16 * 1024 * 1024;
+static FAutoConsoleVariableRef CVarParallelMemcpyThreshold(
+	TEXT("memory.ParallelMemcpyThreshold"),
+	GParallelMemcpyThreshold,
+	TEXT("Size in bytes from which FMemory::ParallelMemcpy splits the copy across the task graph workers."),
+	ECVF_Default
+);
+
+static int32 GParallelMemcpyMinChunkSize = 4 * 1024 * 1024;
+static FAutoConsoleVariableRef CVarParallelMemcpyMinChunkSize(
+	TEXT("memory.ParallelMemcpyMinChunkSize"),
+	GParallelMemcpyMinChunkSize,
+	TEXT("Smallest range of a copy that FMemory::ParallelMemcpy gives to a thread, so that each one streams long enough to be worth waking it."),
+	ECVF_Default
+);
+
+namespace UE4NonTemporalMemory_Private
+{
+#if UE_NONTEMPORAL_MEMORY_X86
+	/** Copies the start of Dest up to an Alignment boundary with a regular copy, and returns how many bytes that was */
+	static FORCEINLINE SIZE_T CopyHead(uint8* Dest, const uint8* Src, SIZE_T Count, SIZE_T Alignment)
+	{
+		const SIZE_T Head = FMath::Min<SIZE_T>((Alignment - (UPTRINT(Dest) & (Alignment - 1))) & (Alignment - 1), Count);
+		memcpy(Dest, Src, Head);
+		return Head;
+	}
+
+	/** SSE2 is always there on the processors we build x86 vector code for */
+	static void* MemcpySSE2(void* Dest, const void* Src, SIZE_T Count)
+	{
+		uint8* Out = (uint8*)Dest;
+		const uint8* In = (const uint8*)Src;
+		const SIZE_T Head = CopyHead(Out, In, Count, 16);
+		Out += Head;
+		In += Head;
+		Count -= Head;
+
+		for (; Count >= 64; Count -= 64, In += 64, Out += 64)
+		{
+			const __m128i A = _mm_loadu_si128((const __m128i*)In);
+			const __m128i B = _mm_loadu_si128((const __m128i*)In + 1);
+			const __m128i C = _mm_loadu_si128((const __m128i*)In + 2);
+			const __m128i D = _mm_loadu_si128((const __m128i*)In + 3);
+			_mm_stream_si128((__m128i*)Out, A);
+			_mm_stream_si128((__m128i*)Out + 1, B);
+			_mm_stream_si128((__m128i*)Out + 2, C);
+			_mm_stream_si128((__m128i*)Out + 3, D);
+		}
+
+		// Streaming stores are weakly ordered, the fence orders them with the stores that come after the copy
+		_mm_sfence();
+		memcpy(Out, In, Count);
+		return Dest;
+	}
+
+	UE_CPU_TARGET("avx") static void* MemcpyAVX(void* Dest, const void* Src, SIZE_T Count)
+	{
+		uint8* Out = (uint8*)Dest;
+		const uint8* In = (const uint8*)Src;
+		const SIZE_T Head = CopyHead(Out, In, Count, 32);
+		Out += Head;
+		In += Head;
+		Count -= Head;
+
+		for (; Count >= 128; Count -= 128, In += 128, Out += 128)
+		{
+			const __m256i A = _mm256_loadu_si256((const __m256i*)In);
+			const __m256i B = _mm256_loadu_si256((const __m256i*)In + 1);
+			const __m256i C = _mm256_loadu_si256((const __m256i*)In + 2);
+			const __m256i D = _mm256_loadu_si256((const __m256i*)In + 3);
+			_mm256_stream_si256((__m256i*)Out, A);
+			_mm256_stream_si256((__m256i*)Out + 1, B);
+			_mm256_stream_si256((__m256i*)Out + 2, C);
+			_mm256_stream_si256((__m256i*)Out + 3, D);
+		}
+
+		_mm_sfence();
+		_mm256_zeroupper();
+		memcpy(Out, In, Count);
+		return Dest;
+	}
+
+	static void* MemsetSSE2(void* Dest, uint8 Char, SIZE_T Count)
+	{
+		uint8* Out = (uint8*)Dest;
+		const SIZE_T Head = FMath::Min<SIZE_T>((16 - (UPTRINT(Out) & 15)) & 15, Count);
+		memset(Out, Char, Head);
+		Out += Head;
+		Count -= Head;
+
+		const __m128i Value = _mm_set1_epi8(char(Char));
+		for (; Count >= 64; Count -= 64, Out += 64)
+		{
+			_mm_stream_si128((__m128i*)Out, Value);
+			_mm_stream_si128((__m128i*)Out + 1, Value);
+			_mm_stream_si128((__m128i*)Out + 2, Value);
+			_mm_stream_si128((__m128i*)Out + 3, Value);
+		}
+
+		_mm_sfence();
+		memset(Out, Char, Count);
+		return Dest;
+	}
+
+	UE_CPU_TARGET("avx") static void* MemsetAVX(void* Dest, uint8 Char, SIZE_T Count)
+	{
+		uint8* Out = (uint8*)Dest;
+		const SIZE_T Head = FMath::Min<SIZE_T>((32 - (UPTRINT(Out) & 31)) & 31, Count);
+		memset(Out, Char, Head);
+		Out += Head;
+		Count -= Head;
+
+		const __m256i Value = _mm256_set1_epi8(char(Char));
+		for (; Count >= 128; Count -= 128, Out += 128)
+		{
+			_mm256_stream_si256((__m256i*)Out, Value);
+			_mm256_stream_si256((__m256i*)Out + 1, Value);
+			_mm256_stream_si256((__m256i*)Out + 2, Value);
+			_mm256_stream_si256((__m256i*)Out + 3, Value);
+		}
+
+		_mm_sfence();
+		_mm256_zeroupper();
+		memset(Out, Char, Count);
+		return Dest;
+	}
+
+	typedef TMultiVersionFunction<void*(void*, const void*, SIZE_T)> FMemcpyFunction;
+	typedef TMultiVersionFunction<void*(void*, uint8, SIZE_T)> FMemsetFunction;
+
+	static const FMemcpyFunction& GetMemcpy()
+	{
+		static const FMemcpyFunction Function = FMemcpyFunction(&MemcpySSE2).Register(ECPUFeatures::AVX, &MemcpyAVX);
+		return Function;
+	}
+
+	static const FMemsetFunction& GetMemset()
+	{
+		static const FMemsetFunction Function = FMemsetFunction(&MemsetSSE2).Register(ECPUFeatures::AVX, &MemsetAVX);
+		return Function;
+	}
+#endif
+}
+
+void* FMemory::NonTemporalMemcpy(void* Dest, const void* Src, SIZE_T Count)
+{
+#if UE_NONTEMPORAL_MEMORY_X86
+	if (Count >= SIZE_T(FMath::Max(GNonTemporalThreshold, 0)))
+	{
+		return UE4NonTemporalMemory_Private::GetMemcpy()(Dest, Src, Count);
+	}
+#endif
+	return Memcpy(Dest, Src, Count);
+}
+
+void* FMemory::NonTemporalMemset(void* Dest, uint8 Char, SIZE_T Count)
+{
+#if UE_NONTEMPORAL_MEMORY_X86
+	if (Count >= SIZE_T(FMath::Max(GNonTemporalThreshold, 0)))
+	{
+		return UE4NonTemporalMemory_Private::GetMemset()(Dest, Char, Count);
+	}
+#endif
+	return Memset(Dest, Char, Count);
+}
+
+void* FMemory::ParallelMemcpy(void* Dest, const void* Src, SIZE_T Count)
+{
+	const SIZE_T MinChunkSize = Align(SIZE_T(FMath::Max(GParallelMemcpyMinChunkSize, 4096)), 4096);
+	if (Count < SIZE_T(FMath::Max(GParallelMemcpyThreshold, 0)) || Count < 2 * MinChunkSize || !FTaskGraphInterface::IsRunning())
+	{
+		return NonTemporalMemcpy(Dest, Src, Count);
+	}
+
+	// Every thread gets one contiguous range made of whole pages of the destination, so that the pages a thread
+	// touches first are the ones it writes, and no two threads write to the same page or cache line
+	const SIZE_T MaxChunks = SIZE_T(FTaskGraphInterface::Get().GetNumWorkerThreads()) + 1;
+	const SIZE_T NumChunks = FMath::Min(MaxChunks, Count / MinChunkSize);
+	const SIZE_T ChunkSize = Align((Count + NumChunks - 1) / NumChunks, 4096);
+
+	uint8* Out = (uint8*)Dest;
+	const uint8* In = (const uint8*)Src;
+	const SIZE_T FirstChunkSize = FMath::Min(Count, ChunkSize - (UPTRINT(Out) & 4095));
+	ParallelFor(int32(NumChunks), [Out, In, Count, NumChunks, ChunkSize, FirstChunkSize](int32 ChunkIndex)
+	{
+		// The first range ends on a page boundary, so the last one takes what the first one is short of
+		const SIZE_T Begin = ChunkIndex == 0 ? 0 : FirstChunkSize + (ChunkIndex - 1) * ChunkSize;
+		const SIZE_T End = SIZE_T(ChunkIndex) == NumChunks - 1 ? Count : FMath::Min(Count, FirstChunkSize + ChunkIndex * ChunkSize);
+		if (Begin < End)
+		{
+			NonTemporalMemcpy(Out + Begin, In + Begin, End - Begin);
+		}
+	});
+	return Dest;
+}
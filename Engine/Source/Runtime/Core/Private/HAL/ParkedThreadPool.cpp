@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/ParkedThreadPool.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/ScopeLock.h"
+
+static int32 GParkedThreadPoolMaxThreads = 8;
+static FAutoConsoleVariableRef CVarParkedThreadPoolMaxThreads(
+	TEXT("ParkedThreadPool.MaxThreads"),
+	GParkedThreadPoolMaxThreads,
+	TEXT("How many threads of FThread and Async(EAsyncExecution::Thread) can be parked to be reused once their function returned. 0 makes every function create its own thread."),
+	ECVF_Default
+);
+
+static float GParkedThreadPoolIdleSeconds = 10.0f;
+static FAutoConsoleVariableRef CVarParkedThreadPoolIdleSeconds(
+	TEXT("ParkedThreadPool.IdleSeconds"),
+	GParkedThreadPoolIdleSeconds,
+	TEXT("How long a parked thread waits for another function before exiting."),
+	ECVF_Default
+);
+
+/** The runnable of the threads of FParkedThreadPool, runs functions until it stays parked for too long */
+class FParkedThread final : public FRunnable
+{
+public:
+	explicit FParkedThread(uint32 InStackSize)
+		: StackSize(InStackSize)
+		, Thread(nullptr)
+		, WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+	{
+	}
+
+	virtual ~FParkedThread()
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	virtual uint32 Run() override;
+
+	/** Set before the thread is started or woken up, only the thread itself touches them otherwise */
+	FString Name;
+	TUniqueFunction<void()> Function;
+	TSharedPtr<FParkedThreadPool::FTask, ESPMode::ThreadSafe> Task;
+	EThreadPriority Priority = TPri_Normal;
+	uint64 AffinityMask = 0;
+
+	/** As requested when the thread was created, which can't be changed after */
+	const uint32 StackSize;
+
+	/** Set by the thread that created this one once FRunnableThread::Create returned */
+	TAtomic<FRunnableThread*> Thread;
+
+	/** Triggered when a function was given to this parked thread */
+	FEvent* WakeEvent;
+};
+
+namespace UE4ParkedThreadPool_Private
+{
+	struct FPool
+	{
+		FCriticalSection Critical;
+
+		/** Threads waiting for a function, the most recently parked last */
+		TArray<FParkedThread*> Parked;
+
+		/** Threads that are exiting or exited, deleted by the next Launch */
+		TArray<FParkedThread*> Exited;
+	};
+
+	/** Never destroyed, parked threads can still be using it when the process exits */
+	static FPool& GetPool()
+	{
+		static FPool* Pool = new FPool();
+		return *Pool;
+	}
+
+	/**
+	 * Parks a thread whose function returned, unless there are enough parked threads already.
+	 *
+	 * @return false if the thread has to exit
+	 */
+	static bool Park(FParkedThread* Thread)
+	{
+		FPool& Pool = GetPool();
+		FScopeLock Lock(&Pool.Critical);
+		if (Pool.Parked.Num() >= GParkedThreadPoolMaxThreads)
+		{
+			Pool.Exited.Add(Thread);
+			return false;
+		}
+		Pool.Parked.Add(Thread);
+		return true;
+	}
+
+	/**
+	 * Removes a thread that waited too long from the parked threads.
+	 *
+	 * @return false if a function was given to it meanwhile, it has to wait for the wake up
+	 */
+	static bool Unpark(FParkedThread* Thread)
+	{
+		FPool& Pool = GetPool();
+		FScopeLock Lock(&Pool.Critical);
+		if (Pool.Parked.RemoveSingle(Thread))
+		{
+			Pool.Exited.Add(Thread);
+			return true;
+		}
+		return false;
+	}
+}
+
+uint32 FParkedThread::Run()
+{
+	using namespace UE4ParkedThreadPool_Private;
+
+	for (;;)
+	{
+		Function();
+		Function = nullptr;
+
+		Task->bDone = true;
+		Task->DoneEvent->Trigger();
+		Task.Reset();
+
+		// The creating thread has to be done with Thread before this one can be reused and FRunnableThread changed
+		while (!Thread)
+		{
+			FPlatformProcess::Yield();
+		}
+
+		if (!Park(this))
+		{
+			break;
+		}
+
+		const uint32 IdleMilliseconds = uint32(FMath::Max(GParkedThreadPoolIdleSeconds, 0.0f) * 1000.0f);
+		if (!WakeEvent->Wait(IdleMilliseconds))
+		{
+			if (Unpark(this))
+			{
+				break;
+			}
+
+			// Launch took this thread as it was timing out, the wake up is about to come
+			WakeEvent->Wait();
+		}
+
+		FPlatformProcess::SetThreadName(*Name);
+		FPlatformProcess::SetThreadAffinityMask(AffinityMask);
+	}
+
+	return 0;
+}
+
+FParkedThreadPool::FTask::FTask()
+	: DoneEvent(FPlatformProcess::GetSynchEventFromPool(true))
+	, bDone(false)
+	, ThreadId(0)
+{
+}
+
+FParkedThreadPool::FTask::~FTask()
+{
+	FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+}
+
+void FParkedThreadPool::FTask::Wait()
+{
+	DoneEvent->Wait();
+}
+
+TSharedPtr<FParkedThreadPool::FTask, ESPMode::ThreadSafe> FParkedThreadPool::Launch(
+	const TCHAR* ThreadName,
+	TUniqueFunction<void()>&& Function,
+	uint32 StackSize,
+	EThreadPriority ThreadPriority,
+	uint64 ThreadAffinityMask
+)
+{
+	using namespace UE4ParkedThreadPool_Private;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FTask, ESPMode::ThreadSafe> Task = MakeShared<FTask, ESPMode::ThreadSafe>();
+
+	FParkedThread* Reused = nullptr;
+	TArray<FParkedThread*> Exited;
+	{
+		FPool& Pool = GetPool();
+		FScopeLock Lock(&Pool.Critical);
+		Exited = MoveTemp(Pool.Exited);
+		for (int32 Index = Pool.Parked.Num() - 1; Index >= 0; --Index)
+		{
+			if (Pool.Parked[Index]->StackSize == StackSize)
+			{
+				Reused = Pool.Parked[Index];
+				Pool.Parked.RemoveAt(Index, 1, false);
+				break;
+			}
+		}
+	}
+
+	// Deleting the FRunnableThread waits for the thread to exit, which it does right after being put in Exited
+	for (FParkedThread* Thread : Exited)
+	{
+		delete Thread->Thread.Load();
+		delete Thread;
+	}
+
+	if (Reused)
+	{
+		FRunnableThread* RunnableThread = Reused->Thread;
+		if (Reused->Priority != ThreadPriority)
+		{
+			RunnableThread->SetThreadPriority(ThreadPriority);
+		}
+		Task->ThreadId = RunnableThread->GetThreadID();
+
+		Reused->Name = ThreadName;
+		Reused->Function = MoveTemp(Function);
+		Reused->Task = Task;
+		Reused->Priority = ThreadPriority;
+		Reused->AffinityMask = ThreadAffinityMask;
+		Reused->WakeEvent->Trigger();
+		return Task;
+	}
+
+	FParkedThread* NewThread = new FParkedThread(StackSize);
+	NewThread->Name = ThreadName;
+	NewThread->Function = MoveTemp(Function);
+	NewThread->Task = Task;
+	NewThread->Priority = ThreadPriority;
+	NewThread->AffinityMask = ThreadAffinityMask;
+
+	FRunnableThread* RunnableThread = FRunnableThread::Create(NewThread, ThreadName, StackSize, ThreadPriority, ThreadAffinityMask);
+	if (!RunnableThread)
+	{
+		delete NewThread;
+		return nullptr;
+	}
+
+	Task->ThreadId = RunnableThread->GetThreadID();
+	NewThread->Thread = RunnableThread;
+	return Task;
+}
+
+int32 FParkedThreadPool::GetNumParkedThreads()
+{
+	using namespace UE4ParkedThreadPool_Private;
+
+	FPool& Pool = GetPool();
+	FScopeLock Lock(&Pool.Critical);
+	return Pool.Parked.Num();
+}
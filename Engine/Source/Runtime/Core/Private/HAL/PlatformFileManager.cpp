@@ -13,6 +13,8 @@
 #include "HAL/IPlatformFileCachedWrapper.h"
 #include "HAL/IPlatformFileModule.h"
 #include "HAL/IPlatformFileOpenLogWrapper.h"
+#include "HAL/IPlatformFileStartupPrefetchWrapper.h"
+#include "HAL/IPlatformFileLocalCacheWrapper.h"
 #include "Templates/UniquePtr.h"
 
 FPlatformFileManager::FPlatformFileManager()
@@ -92,6 +94,16 @@ IPlatformFile* FPlatformFileManager::GetPlatformFile(const TCHAR* Name)
 		static TUniquePtr<IPlatformFile> AutoDestroySingleton(new FCachedReadPlatformFile());
 		PlatformFile = AutoDestroySingleton.Get();
 	}
+	else if (FCString::Strcmp(FStartupPrefetchPlatformFile::GetTypeName(), Name) == 0)
+	{
+		static TUniquePtr<IPlatformFile> AutoDestroySingleton(new FStartupPrefetchPlatformFile());
+		PlatformFile = AutoDestroySingleton.Get();
+	}
+	else if (FCString::Strcmp(FLocalCachePlatformFile::GetTypeName(), Name) == 0)
+	{
+		static TUniquePtr<IPlatformFile> AutoDestroySingleton(new FLocalCachePlatformFile());
+		PlatformFile = AutoDestroySingleton.Get();
+	}
 	else if (FModuleManager::Get().ModuleExists(Name))
 	{
 		// Try to load a module containing the platform file.
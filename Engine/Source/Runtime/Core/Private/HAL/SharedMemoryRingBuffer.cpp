@@ -0,0 +1,330 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HAL/SharedMemoryRingBuffer.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/AlignmentTemplates.h"
+#include "CoreGlobals.h"
+
+#define SHARED_MEMORY_RING_USE_FUTEX (PLATFORM_LINUX || PLATFORM_ANDROID)
+#define SHARED_MEMORY_RING_USE_SEMAPHORES PLATFORM_WINDOWS
+
+#if SHARED_MEMORY_RING_USE_FUTEX
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <limits.h>
+	#include <errno.h>
+	#include <time.h>
+#endif
+
+namespace UE4SharedMemoryRingBuffer_Private
+{
+	static const uint32 RingMagic = 0x52494E47;
+	static const uint32 MinCapacity = 4096;
+	static const uint32 RecordAlignment = 8;
+	/** Size of a record that tells the reader to continue at the start of the ring */
+	static const uint32 WrapMarker = MAX_uint32;
+
+	static uint32 GetRecordSize(uint32 MessageSize)
+	{
+		return Align(sizeof(uint32) + MessageSize, RecordAlignment);
+	}
+}
+
+/** Lives at the start of the region, the readers' and writers' state on their own cache lines */
+struct FSharedMemoryRingBuffer::FHeader
+{
+	volatile int32 Magic;
+	uint32 Capacity;
+
+	/** Bytes written since creation, wrapped to the ring by the capacity */
+	alignas(PLATFORM_CACHE_LINE_SIZE) volatile int64 WriteOffset;
+	volatile int32 WriterLock;
+	/** Changes whenever a message is written, readers wait on it */
+	volatile int32 DataSequence;
+	volatile int32 NumDataWaiters;
+	volatile int32 bDataWakePending;
+
+	/** Bytes read since creation */
+	alignas(PLATFORM_CACHE_LINE_SIZE) volatile int64 ReadOffset;
+	/** Changes whenever a message is read, writers wait on it */
+	volatile int32 SpaceSequence;
+	volatile int32 NumSpaceWaiters;
+	volatile int32 bSpaceWakePending;
+};
+
+FSharedMemoryRingBuffer* FSharedMemoryRingBuffer::Create(const FString& Name, uint32 Capacity)
+{
+	return MapRing(Name, FMath::RoundUpToPowerOfTwo(FMath::Max(Capacity, UE4SharedMemoryRingBuffer_Private::MinCapacity)), true);
+}
+
+FSharedMemoryRingBuffer* FSharedMemoryRingBuffer::Open(const FString& Name, uint32 Capacity)
+{
+	return MapRing(Name, FMath::RoundUpToPowerOfTwo(FMath::Max(Capacity, UE4SharedMemoryRingBuffer_Private::MinCapacity)), false);
+}
+
+FSharedMemoryRingBuffer* FSharedMemoryRingBuffer::MapRing(const FString& Name, uint32 Capacity, bool bCreate)
+{
+	using namespace UE4SharedMemoryRingBuffer_Private;
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, bCreate,
+		FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, GetDataOffset() + Capacity);
+	if (!Region)
+	{
+		return nullptr;
+	}
+
+	FHeader& Header = *(FHeader*)Region->GetAddress();
+	if (bCreate)
+	{
+		FMemory::Memzero(&Header, sizeof(FHeader));
+		Header.Capacity = Capacity;
+		// Publish the header last, rings that are opened before it is set up don't open
+		FPlatformAtomics::InterlockedExchange(&Header.Magic, (int32)RingMagic);
+	}
+	else if (FPlatformAtomics::AtomicRead(&Header.Magic) != (int32)RingMagic || Header.Capacity != Capacity)
+	{
+		UE_LOG(LogHAL, Warning, TEXT("Shared memory ring '%s' isn't set up with a capacity of %u bytes"), *Name, Capacity);
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+		return nullptr;
+	}
+
+	FSharedMemoryRingBuffer* Ring = new FSharedMemoryRingBuffer(Region, Capacity);
+
+#if SHARED_MEMORY_RING_USE_SEMAPHORES
+	Ring->DataSemaphore = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Data"), bCreate, 1);
+	Ring->SpaceSemaphore = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Space"), bCreate, 1);
+	if (!Ring->DataSemaphore || !Ring->SpaceSemaphore)
+	{
+		delete Ring;
+		return nullptr;
+	}
+	if (bCreate)
+	{
+		// The semaphores are created signaled, they are only signaled for wake ups here
+		Ring->DataSemaphore->TryLock(0);
+		Ring->SpaceSemaphore->TryLock(0);
+	}
+#endif
+
+	return Ring;
+}
+
+FSharedMemoryRingBuffer::FSharedMemoryRingBuffer(FPlatformMemory::FSharedMemoryRegion* InRegion, uint32 InCapacity)
+	: Region(InRegion)
+	, Capacity(InCapacity)
+	, DataSemaphore(nullptr)
+	, SpaceSemaphore(nullptr)
+{
+}
+
+FSharedMemoryRingBuffer::~FSharedMemoryRingBuffer()
+{
+	if (DataSemaphore)
+	{
+		FPlatformProcess::DeleteInterprocessSynchObject(DataSemaphore);
+	}
+	if (SpaceSemaphore)
+	{
+		FPlatformProcess::DeleteInterprocessSynchObject(SpaceSemaphore);
+	}
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+FSharedMemoryRingBuffer::FHeader& FSharedMemoryRingBuffer::GetHeader() const
+{
+	return *(FHeader*)Region->GetAddress();
+}
+
+SIZE_T FSharedMemoryRingBuffer::GetDataOffset()
+{
+	return Align(sizeof(FHeader), PLATFORM_CACHE_LINE_SIZE);
+}
+
+uint8* FSharedMemoryRingBuffer::GetData() const
+{
+	return (uint8*)Region->GetAddress() + GetDataOffset();
+}
+
+uint32 FSharedMemoryRingBuffer::GetMaxMessageSize() const
+{
+	// A record that would cross the end of the ring starts over at its beginning, half the ring always fits in one go
+	return Capacity / 2 - sizeof(uint32);
+}
+
+bool FSharedMemoryRingBuffer::Write(const void* Data, uint32 Size, uint32 WaitTimeMs)
+{
+	using namespace UE4SharedMemoryRingBuffer_Private;
+
+	if (Size > GetMaxMessageSize())
+	{
+		return false;
+	}
+
+	FHeader& Header = GetHeader();
+	const double EndTime = WaitTimeMs == MAX_uint32 ? MAX_dbl : FPlatformTime::Seconds() + WaitTimeMs / 1000.0;
+	auto GetRemainingTimeMs = [EndTime, WaitTimeMs]() -> uint32
+	{
+		return WaitTimeMs == MAX_uint32 ? MAX_uint32 : (uint32)FMath::Max((EndTime - FPlatformTime::Seconds()) * 1000.0, 0.0);
+	};
+
+	// Writers take turns, a writer holds the lock while it waits for room
+	for (int32 SpinCount = 0; FPlatformAtomics::InterlockedCompareExchange(&Header.WriterLock, 1, 0) != 0; ++SpinCount)
+	{
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			return false;
+		}
+		FPlatformProcess::Sleep(SpinCount < 64 ? 0.0f : 0.0001f);
+	}
+
+	const uint32 RecordSize = GetRecordSize(Size);
+	const int64 WriteOffset = Header.WriteOffset;
+	const uint32 Position = (uint32)WriteOffset & (Capacity - 1);
+	const uint32 WrapSize = Capacity - Position < RecordSize ? Capacity - Position : 0;
+	for (;;)
+	{
+		const int32 SpaceSequence = FPlatformAtomics::AtomicRead(&Header.SpaceSequence);
+		const int64 UsedSize = WriteOffset - FPlatformAtomics::AtomicRead(&Header.ReadOffset);
+		if (Capacity - UsedSize >= WrapSize + RecordSize)
+		{
+			break;
+		}
+
+		if (!WaitForChange(&Header.SpaceSequence, SpaceSequence, &Header.NumSpaceWaiters, &Header.bSpaceWakePending, SpaceSemaphore, GetRemainingTimeMs()))
+		{
+			FPlatformAtomics::InterlockedExchange(&Header.WriterLock, 0);
+			return false;
+		}
+	}
+
+	uint8* RingData = GetData();
+	if (WrapSize)
+	{
+		*(uint32*)(RingData + Position) = WrapMarker;
+	}
+	const uint32 RecordPosition = WrapSize ? 0 : Position;
+	*(uint32*)(RingData + RecordPosition) = Size;
+	FMemory::Memcpy(RingData + RecordPosition + sizeof(uint32), Data, Size);
+
+	// Publish the record, then let a waiting reader know
+	FPlatformAtomics::InterlockedExchange(&Header.WriteOffset, WriteOffset + WrapSize + RecordSize);
+	FPlatformAtomics::InterlockedExchange(&Header.WriterLock, 0);
+	FPlatformAtomics::InterlockedIncrement(&Header.DataSequence);
+	WakeWaiters(&Header.DataSequence, &Header.NumDataWaiters, &Header.bDataWakePending, DataSemaphore);
+	return true;
+}
+
+bool FSharedMemoryRingBuffer::Read(TArray<uint8>& OutData, uint32 WaitTimeMs)
+{
+	using namespace UE4SharedMemoryRingBuffer_Private;
+
+	FHeader& Header = GetHeader();
+	const double EndTime = WaitTimeMs == MAX_uint32 ? MAX_dbl : FPlatformTime::Seconds() + WaitTimeMs / 1000.0;
+
+	int64 ReadOffset = Header.ReadOffset;
+	for (;;)
+	{
+		const int32 DataSequence = FPlatformAtomics::AtomicRead(&Header.DataSequence);
+		if (FPlatformAtomics::AtomicRead(&Header.WriteOffset) != ReadOffset)
+		{
+			break;
+		}
+
+		const uint32 RemainingTimeMs = WaitTimeMs == MAX_uint32 ? MAX_uint32 : (uint32)FMath::Max((EndTime - FPlatformTime::Seconds()) * 1000.0, 0.0);
+		if (!WaitForChange(&Header.DataSequence, DataSequence, &Header.NumDataWaiters, &Header.bDataWakePending, DataSemaphore, RemainingTimeMs))
+		{
+			return false;
+		}
+	}
+
+	const uint8* RingData = GetData();
+	uint32 Position = (uint32)ReadOffset & (Capacity - 1);
+	uint32 Size = *(const uint32*)(RingData + Position);
+	if (Size == WrapMarker)
+	{
+		// Writers only publish the marker together with the record after it
+		ReadOffset += Capacity - Position;
+		Position = 0;
+		Size = *(const uint32*)RingData;
+	}
+	check(Size <= GetMaxMessageSize());
+
+	OutData.SetNumUninitialized(Size, false);
+	FMemory::Memcpy(OutData.GetData(), RingData + Position + sizeof(uint32), Size);
+
+	// Hand the room back, then let a waiting writer know
+	FPlatformAtomics::InterlockedExchange(&Header.ReadOffset, ReadOffset + GetRecordSize(Size));
+	FPlatformAtomics::InterlockedIncrement(&Header.SpaceSequence);
+	WakeWaiters(&Header.SpaceSequence, &Header.NumSpaceWaiters, &Header.bSpaceWakePending, SpaceSemaphore);
+	return true;
+}
+
+bool FSharedMemoryRingBuffer::WaitForChange(volatile int32* Value, int32 Expected, volatile int32* NumWaiters, volatile int32* bWakePending, FPlatformProcess::FSemaphore* Semaphore, uint32 WaitTimeMs)
+{
+	if (WaitTimeMs == 0)
+	{
+		return false;
+	}
+
+	// Registering as a waiter before checking the value again means that whoever changes it after this sees the waiter
+	FPlatformAtomics::InterlockedIncrement(NumWaiters);
+	if (FPlatformAtomics::AtomicRead(Value) != Expected)
+	{
+		FPlatformAtomics::InterlockedDecrement(NumWaiters);
+		return true;
+	}
+
+	bool bWoken = true;
+#if SHARED_MEMORY_RING_USE_FUTEX
+	struct timespec Timeout;
+	Timeout.tv_sec = WaitTimeMs / 1000;
+	Timeout.tv_nsec = (WaitTimeMs % 1000) * 1000000;
+	// Not a private futex, the value is in memory shared with other processes
+	if (syscall(SYS_futex, Value, FUTEX_WAIT, Expected, WaitTimeMs == MAX_uint32 ? nullptr : &Timeout, nullptr, 0) != 0 && errno == ETIMEDOUT)
+	{
+		bWoken = false;
+	}
+#elif SHARED_MEMORY_RING_USE_SEMAPHORES
+	bWoken = Semaphore->TryLock(WaitTimeMs == MAX_uint32 ? MAX_uint64 : uint64(WaitTimeMs) * 1000000ull);
+	if (bWoken)
+	{
+		FPlatformAtomics::InterlockedExchange(bWakePending, 0);
+	}
+#else
+	const double EndTime = FPlatformTime::Seconds() + WaitTimeMs / 1000.0;
+	while (FPlatformAtomics::AtomicRead(Value) == Expected)
+	{
+		if (WaitTimeMs != MAX_uint32 && FPlatformTime::Seconds() >= EndTime)
+		{
+			bWoken = false;
+			break;
+		}
+		FPlatformProcess::Sleep(0.0001f);
+	}
+#endif
+
+	FPlatformAtomics::InterlockedDecrement(NumWaiters);
+	return bWoken || FPlatformAtomics::AtomicRead(Value) != Expected;
+}
+
+void FSharedMemoryRingBuffer::WakeWaiters(volatile int32* Value, volatile int32* NumWaiters, volatile int32* bWakePending, FPlatformProcess::FSemaphore* Semaphore)
+{
+	if (FPlatformAtomics::AtomicRead(NumWaiters) == 0)
+	{
+		return;
+	}
+
+#if SHARED_MEMORY_RING_USE_FUTEX
+	syscall(SYS_futex, Value, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#elif SHARED_MEMORY_RING_USE_SEMAPHORES
+	// The semaphores count to one, so only the first wake up until a waiter takes it signals them
+	if (FPlatformAtomics::InterlockedCompareExchange(bWakePending, 1, 0) == 0)
+	{
+		Semaphore->Unlock();
+	}
+#endif
+}
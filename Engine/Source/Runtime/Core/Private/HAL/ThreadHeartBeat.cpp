@@ -16,6 +16,14 @@
 #include "Stats/Stats.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerAggregator.h"
+#include "ProfilingDebugging/TraceFlightRecorder.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
 #include "Misc/App.h"
 
 #if PLATFORM_SWITCH
@@ -38,6 +46,20 @@
 const double HangDetectorClock_MaxTimeStep_MS = 2000.0;
 const double HitchDetectorClock_MaxTimeStep_MS = 50.0;
 
+static float GHitchBundleMinIntervalSeconds = 60.0f;
+static FAutoConsoleVariableRef CVarHitchBundleMinIntervalSeconds(
+	TEXT("HitchDetector.BundleMinIntervalSeconds"),
+	GHitchBundleMinIntervalSeconds,
+	TEXT("Least number of seconds between two hitch bundles.")
+	);
+
+static int32 GHitchBundleMaxCount = 10;
+static FAutoConsoleVariableRef CVarHitchBundleMaxCount(
+	TEXT("HitchDetector.MaxBundles"),
+	GHitchBundleMaxCount,
+	TEXT("Most hitch bundles written in a session.")
+	);
+
 FThreadHeartBeatClock::FThreadHeartBeatClock(double InMaxTimeStep)
 	: MaxTimeStepCycles((uint64)(InMaxTimeStep / FPlatformTime::GetSecondsPerCycle64()))
 {
@@ -566,6 +588,9 @@ FGameThreadHitchHeartBeatThreaded::FGameThreadHitchHeartBeatThreaded()
 	: Thread(nullptr)
 	, HangDuration(-1.f)
 	, bWalkStackOnHitch(false)
+	, bWriteBundleOnHitch(false)
+	, LastBundleTime(0.0)
+	, NumBundlesWritten(0)
 	, FirstStartTime(0.0)
 	, FrameStartTime(0.0)
 	, SuspendedCount(0)
@@ -634,11 +659,13 @@ void FGameThreadHitchHeartBeatThreaded::InitSettings()
 	static bool bHasCmdLine = false;
 	static float CmdLine_HangDuration = 0.0f;
 	static bool CmdLine_StackWalk = false;
+	static bool CmdLine_Bundle = false;
 
 	if (bFirst)
 	{
 		bHasCmdLine = FParse::Value(FCommandLine::Get(), TEXT("hitchdetection="), CmdLine_HangDuration);
 		CmdLine_StackWalk = FParse::Param(FCommandLine::Get(), TEXT("hitchdetectionstackwalk"));
+		CmdLine_Bundle = FParse::Param(FCommandLine::Get(), TEXT("hitchdetectionbundle"));
 
 		// Determine whether to start suspended
 		bool bStartSuspended = false;
@@ -667,11 +694,13 @@ void FGameThreadHitchHeartBeatThreaded::InitSettings()
 		// Command line takes priority over config
 		HangDuration = CmdLine_HangDuration;
 		bWalkStackOnHitch = CmdLine_StackWalk;
+		bWriteBundleOnHitch = CmdLine_Bundle;
 	}
 	else
 	{
 		float Config_Duration = -1.0f;
 		bool Config_StackWalk = false;
+		bool Config_Bundle = false;
 
 		// Read from config files
 		bool bReadFromConfig = false;
@@ -679,18 +708,21 @@ void FGameThreadHitchHeartBeatThreaded::InitSettings()
 		{
 			bReadFromConfig |= GConfig->GetFloat(TEXT("Core.System"), TEXT("GameThreadHeartBeatHitchDuration"), Config_Duration, GEngineIni);
 			bReadFromConfig |= GConfig->GetBool(TEXT("Core.System"), TEXT("GameThreadHeartBeatStackWalk"), Config_StackWalk, GEngineIni);
+			bReadFromConfig |= GConfig->GetBool(TEXT("Core.System"), TEXT("GameThreadHeartBeatHitchBundle"), Config_Bundle, GEngineIni);
 		}
 
 		if (bReadFromConfig)
 		{
 			HangDuration = Config_Duration;
 			bWalkStackOnHitch = Config_StackWalk;
+			bWriteBundleOnHitch = Config_Bundle;
 		}
 		else
 		{
 			// No config provided. Use defaults to disable.
 			HangDuration = -1.0f;
 			bWalkStackOnHitch = false;
+			bWriteBundleOnHitch = false;
 		}
 	}
 	
@@ -781,6 +813,11 @@ uint32 FGameThreadHitchHeartBeatThreaded::Run()
 						}
 #endif
 
+						if (bWriteBundleOnHitch)
+						{
+							WriteHitchBundle(CurrentTime - LocalFrameStartTime);
+						}
+
 						Clock.Tick();
 						UE_LOG(LogCore, Error, TEXT("Leaving hitch detector (+%8.2fms)"), float(Clock.Seconds() - LocalFrameStartTime) * 1000.0f);
 					}
@@ -803,6 +840,63 @@ void FGameThreadHitchHeartBeatThreaded::Stop()
 	StopTaskCounter.Increment();
 }
 
+void FGameThreadHitchHeartBeatThreaded::WriteHitchBundle(double HitchSeconds)
+{
+	// Writing a bundle takes a while and hitches tend to come in bursts, so keep the number and size on disk bounded
+	const double Now = FPlatformTime::Seconds();
+	if (NumBundlesWritten >= GHitchBundleMaxCount || (NumBundlesWritten > 0 && Now - LastBundleTime < GHitchBundleMinIntervalSeconds))
+	{
+		return;
+	}
+	++NumBundlesWritten;
+	LastBundleTime = Now;
+
+	const FString BundleDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectLogDir()) / TEXT("Hitches") / FString::Printf(TEXT("Hitch-%s"), *FDateTime::Now().ToString());
+	IFileManager::Get().MakeDirectory(*BundleDir, true);
+
+	// The trace ring goes first so that it ends as close to the hitch as possible. It holds the CPU scopes and
+	// counters of the last seconds given by -traceflightrecorderseconds, in a ring of fixed size.
+#if TRACEFLIGHTRECORDER_ENABLED
+	if (FTraceFlightRecorder::IsEnabled())
+	{
+		FTraceFlightRecorder::Dump(*(BundleDir / TEXT("FlightRecorder.utrace")));
+	}
+#endif
+
+	TStringBuilder<4096> Stacks;
+	Stacks.Appendf(TEXT("Hitch on gamethread, frame %llu hasn't finished for %.2fms\n"), (uint64)GFrameCounter, HitchSeconds * 1000.0);
+#if PLATFORM_WINDOWS || PLATFORM_MAC
+	TArray<FThreadManager::FThreadStackBackTrace> StackTraces;
+	FThreadManager::Get().GetAllThreadStackBackTraces(StackTraces);
+	for (const FThreadManager::FThreadStackBackTrace& StackTrace : StackTraces)
+	{
+		Stacks.Appendf(TEXT("\n%s (%u):\n"), *StackTrace.ThreadName, StackTrace.ThreadId);
+		for (uint64 ProgramCounter : StackTrace.ProgramCounters)
+		{
+			Stacks.Appendf(TEXT("  0x%016llx\n"), ProgramCounter);
+		}
+	}
+#else
+	uint64 GameThreadStack[128];
+	const uint32 Depth = FPlatformStackWalk::CaptureThreadStackBackTrace(GGameThreadId, GameThreadStack, UE_ARRAY_COUNT(GameThreadStack));
+	Stacks.Appendf(TEXT("\nGameThread (%u):\n"), GGameThreadId);
+	for (uint32 Index = 0; Index < Depth; ++Index)
+	{
+		Stacks.Appendf(TEXT("  0x%016llx\n"), GameThreadStack[Index]);
+	}
+#endif
+	FFileHelper::SaveStringToFile(FString(Stacks.ToString()), *(BundleDir / TEXT("Stacks.txt")));
+
+#if CPUPROFILERTRACE_ENABLED
+	if (FCpuProfilerAggregator::IsRunning())
+	{
+		FFileHelper::SaveStringToFile(FCpuProfilerAggregator::ToJsonString(false), *(BundleDir / TEXT("CpuProfilerAggregate.json")));
+	}
+#endif
+
+	UE_LOG(LogCore, Error, TEXT("Hitch bundle written to %s (+%.2fs)"), *BundleDir, FPlatformTime::Seconds() - Now);
+}
+
 void FGameThreadHitchHeartBeatThreaded::FrameStart(bool bSkipThisFrame)
 {
 #if USE_HITCH_DETECTION
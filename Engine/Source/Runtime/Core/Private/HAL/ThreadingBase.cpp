@@ -11,6 +11,10 @@
 #include "HAL/IConsoleManager.h"
 #include "HAL/PlatformStackWalk.h"
 #include "ProfilingDebugging/MiscTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Containers/LockFreeList.h"
+#include "Containers/LockFreeFixedSizeAllocator.h"
 
 DEFINE_STAT( STAT_EventWaitWithId );
 DEFINE_STAT( STAT_EventTriggerWithId );
@@ -476,12 +480,21 @@ void FRunnableThread::FreeTls()
 	FQueuedThread
 -----------------------------------------------------------------------------*/
 
+TRACE_DECLARE_INT_COUNTER(ThreadPoolQueuedJobs, TEXT("ThreadPool/QueuedJobs"));
+/** Queued jobs of all pools, trace counters are not thread safe so they are set from this */
+static FThreadSafeCounter GNumQueuedThreadPoolJobs;
+TRACE_DECLARE_FLOAT_COUNTER(ThreadPoolQueueTime, TEXT("ThreadPool/QueueTime (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(ThreadPoolExecutionTime, TEXT("ThreadPool/ExecutionTime (ms)"));
+
+/** The pool the current thread belongs to, if it is a pool thread */
+static thread_local class FQueuedThreadPoolBase* GCurrentQueuedThreadPool = nullptr;
+
 /**
  * This is the interface used for all poolable threads. The usage pattern for
  * a poolable thread is different from a regular thread and this interface
  * reflects that. Queued threads spend most of their life cycle idle, waiting
- * for work to do. When signaled they perform a job and then return themselves
- * to their owning pool via a callback and go back to an idle state.
+ * for work to do. When signaled they take work from their owning pool until
+ * it has none left and then return themselves to it and go back to an idle state.
  */
 class FQueuedThread
 	: public FRunnable
@@ -494,12 +507,22 @@ protected:
 	/** If true, the thread should exit. */
 	TAtomic<bool> TimeToDie { false };
 
-	/** The work this thread is doing. */
-	IQueuedWork* volatile QueuedWork = nullptr;
-
 	/** The pool this thread belongs to. */
 	class FQueuedThreadPoolBase* OwningThreadPool = nullptr;
 
+	enum class EState : int32
+	{
+		/** Waiting for work, in the idle threads of the pool */
+		Idle,
+		/** Taken from the idle threads and told to work */
+		Woken,
+		/** Left its pool after it was idle for long enough, it is exiting or has exited */
+		Retired,
+	};
+
+	/** Decides between the pool waking an idle thread and the thread retiring while it waits. */
+	TAtomic<EState> State { EState::Idle };
+
 	/** My Thread  */
 	FRunnableThread* Thread = nullptr;
 
@@ -525,9 +548,9 @@ public:
 	 */
 	virtual bool Create(class FQueuedThreadPoolBase* InPool,uint32 InStackSize = 0,EThreadPriority ThreadPriority=TPri_Normal)
 	{
-		static int32 PoolThreadIndex = 0;
-		const FString PoolThreadName = FString::Printf( TEXT( "PoolThread %d" ), PoolThreadIndex );
-		PoolThreadIndex++;
+		// Elastic pools create threads while others run
+		static TAtomic<int32> PoolThreadIndex { 0 };
+		const FString PoolThreadName = FString::Printf( TEXT( "PoolThread %d" ), PoolThreadIndex++ );
 
 		OwningThreadPool = InPool;
 		DoWorkEvent = FPlatformProcess::GetSynchEventFromPool();
@@ -563,54 +586,120 @@ public:
 	}
 
 	/**
-	 * Tells the thread there is work to be done. Upon completion, the thread
-	 * is responsible for adding itself back into the available pool.
+	 * Tells the thread there is work to be done. The thread takes work from
+	 * its pool until there is none left and then adds itself back into the
+	 * available pool.
 	 *
-	 * @param InQueuedWork The queued work to perform
+	 * @return false if the thread retired instead
 	 */
-	void DoWork(IQueuedWork* InQueuedWork)
+	bool TryWake()
 	{
-		DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "FQueuedThread::DoWork" ), STAT_FQueuedThread_DoWork, STATGROUP_ThreadPoolAsyncTasks );
+		DECLARE_SCOPE_CYCLE_COUNTER( TEXT( "FQueuedThread::TryWake" ), STAT_FQueuedThread_TryWake, STATGROUP_ThreadPoolAsyncTasks );
 
-		check(QueuedWork == nullptr && "Can't do more than one task at a time");
-		// Tell the thread the work to be done
-		QueuedWork = InQueuedWork;
-		FPlatformMisc::MemoryBarrier();
-		// Tell the thread to wake up and do its job
+		EState Expected = EState::Idle;
+		if (!State.CompareExchange(Expected, EState::Woken))
+		{
+			return false;
+		}
 		DoWorkEvent->Trigger();
+		return true;
+	}
+
+	/** A thread that waited for work long enough leaves the pool, unless it was woken at the same time */
+	bool TryRetire()
+	{
+		EState Expected = EState::Idle;
+		return State.CompareExchange(Expected, EState::Retired);
+	}
+
+	/** Called before the thread goes back to its pool's idle threads */
+	void MarkIdle()
+	{
+		State = EState::Idle;
 	}
 };
 
 
 /**
  * Implementation of a queued thread pool.
+ *
+ * Work waits in one lock free FIFO per priority and idle threads wait on their
+ * own event in a lock free stack, so adding and starting work never takes a lock.
+ *
+ * An elastic pool also adds threads when no thread took work for a while or all of its
+ * threads are blocked, and lets threads retire that were idle for long enough. Threads
+ * are added when work is added or taken, there is no thread watching the pool, so these
+ * checks only see waiting work while work keeps coming in and going out.
  */
 class FQueuedThreadPoolBase : public FQueuedThreadPool
 {
 protected:
 
-	/** The work queue to pull from. */
-	TArray<IQueuedWork*> QueuedWork;
-	
-	/** The thread pool to dole work out to. */
-	TArray<FQueuedThread*> QueuedThreads;
+	/** Queued work and the time it was queued at, so the pool can report how long work waits. */
+	struct FQueuedWorkEntry
+	{
+		IQueuedWork* Work = nullptr;
+		uint64 QueuedCycles = 0;
+	};
+
+	/** The work queues to pull from, one per priority. */
+	TLockFreePointerListFIFO<FQueuedWorkEntry, PLATFORM_CACHE_LINE_SIZE> QueuedWork[(int32)EQueuedWorkPriority::Count];
+
+	/** Recycles the queue entries. */
+	TLockFreeClassAllocator<FQueuedWorkEntry, PLATFORM_CACHE_LINE_SIZE> EntryAllocator;
+
+	/** Approximate number of entries in the queues. */
+	FThreadSafeCounter NumQueuedWork;
+
+	/**
+	 * The idle threads, waiting on their event. Most recently idle threads are woken first since they are
+	 * the most likely to have a 'hot' cache for the stack etc (similar to Windows IOCP scheduling strategy).
+	 */
+	TLockFreePointerListLIFO<FQueuedThread> QueuedThreads;
 
-	/** All threads in the pool. */
+	/** All threads in the pool, including retired threads that were not deleted yet. */
 	TArray<FQueuedThread*> AllThreads;
 
-	/** The synchronization object used to protect access to the queued work. */
-	FCriticalSection* SynchQueue;
+	/** Protects AllThreads while an elastic pool adds and deletes threads. */
+	FCriticalSection AllThreadsCritical;
+
+	/** The number of threads that did not retire. */
+	TAtomic<int32> NumLiveThreads { 0 };
+
+	/** The number of threads in a FQueuedThreadPoolBlockingScope. */
+	TAtomic<int32> NumBlockedThreads { 0 };
+
+	/** When a thread last took work or went idle, the pool adds a thread when it has been a while. */
+	TAtomic<uint64> LastProgressCycles { 0 };
+
+	/** When the pool last added a thread. */
+	TAtomic<uint64> LastGrowCycles { 0 };
+
+	/** Limits of an elastic pool, a fixed pool never grows or retires threads. */
+	FElasticThreadPoolSettings ElasticSettings;
+	bool bIsElastic = false;
+	uint64 GrowAfterWaitCycles = 0;
+
+	/** What new threads are created with. */
+	uint32 ThreadStackSize = 0;
+	EThreadPriority ThreadPriority = TPri_Normal;
 
 	/** If true, indicates the destruction process has taken place. */
-	bool TimeToDie;
+	TAtomic<bool> TimeToDie { false };
 
 public:
 
 	/** Default constructor. */
-	FQueuedThreadPoolBase()
-		: SynchQueue(nullptr)
-		, TimeToDie(0)
-	{ }
+	FQueuedThreadPoolBase() = default;
+
+	/** Creates an elastic pool. */
+	explicit FQueuedThreadPoolBase(const FElasticThreadPoolSettings& InSettings)
+		: ElasticSettings(InSettings)
+		, bIsElastic(true)
+	{
+		check(ElasticSettings.MinThreads <= ElasticSettings.MaxThreads && ElasticSettings.MaxThreads > 0);
+		GrowAfterWaitCycles = (uint64)(FMath::Max(ElasticSettings.GrowAfterWaitSeconds, 0.0f) / FPlatformTime::GetSecondsPerCycle64());
+	}
 
 	/** Virtual destructor (cleans up the synchronization objects). */
 	virtual ~FQueuedThreadPoolBase()
@@ -618,22 +707,27 @@ public:
 		Destroy();
 	}
 
-	virtual bool Create(uint32 InNumQueuedThreads,uint32 StackSize = (32 * 1024),EThreadPriority ThreadPriority=TPri_Normal) override
+	virtual bool Create(uint32 InNumQueuedThreads,uint32 StackSize = (32 * 1024),EThreadPriority InThreadPriority=TPri_Normal) override
 	{
-		// Make sure we have synch objects
 		bool bWasSuccessful = true;
-		check(SynchQueue == nullptr);
-		SynchQueue = new FCriticalSection();
-		FScopeLock Lock(SynchQueue);
+		check(AllThreads.Num() == 0);
+		TimeToDie = false;
+		if (bIsElastic)
+		{
+			InNumQueuedThreads = FMath::Clamp(InNumQueuedThreads, ElasticSettings.MinThreads, ElasticSettings.MaxThreads);
+		}
 		// Presize the array so there is no extra memory allocated
-		check(QueuedThreads.Num() == 0);
-		QueuedThreads.Empty(InNumQueuedThreads);
+		AllThreads.Empty(bIsElastic ? ElasticSettings.MaxThreads : InNumQueuedThreads);
 
 		// Check for stack size override.
 		if( OverrideStackSize > StackSize )
 		{
 			StackSize = OverrideStackSize;
 		}
+		ThreadStackSize = StackSize;
+		ThreadPriority = InThreadPriority;
+		NumLiveThreads = (int32)InNumQueuedThreads;
+		LastProgressCycles = FPlatformTime::Cycles64();
 
 		// Now create each thread and add it to the array
 		for (uint32 Count = 0; Count < InNumQueuedThreads && bWasSuccessful == true; Count++)
@@ -641,9 +735,9 @@ public:
 			// Create a new queued thread
 			FQueuedThread* pThread = new FQueuedThread();
 			// Now create the thread and add it if ok
-			if (pThread->Create(this,StackSize,ThreadPriority) == true)
+			if (pThread->Create(this,ThreadStackSize,ThreadPriority) == true)
 			{
-				QueuedThreads.Add(pThread);
+				QueuedThreads.Push(pThread);
 				AllThreads.Add(pThread);
 			}
 			else
@@ -663,62 +757,48 @@ public:
 
 	virtual void Destroy() override
 	{
-		if (SynchQueue)
+		if (AllThreads.Num())
 		{
+			TimeToDie = true;
+			// Clean up all queued objects
+			AbandonQueuedWork();
+
+			// Now tell each thread to die and delete those. Threads finish the work they are doing first,
+			// which may delete retired threads, so that must not wait for the lock
+			TArray<FQueuedThread*> ThreadsToKill;
 			{
-				FScopeLock Lock(SynchQueue);
-				TimeToDie = 1;
-				FPlatformMisc::MemoryBarrier();
-				// Clean up all queued objects
-				for (int32 Index = 0; Index < QueuedWork.Num(); Index++)
-				{
-					QueuedWork[Index]->Abandon();
-				}
-				// Empty out the invalid pointers
-				QueuedWork.Empty();
+				FScopeLock Lock(&AllThreadsCritical);
+				ThreadsToKill = MoveTemp(AllThreads);
+				AllThreads.Reset();
 			}
-			// wait for all threads to finish up
-			while (1)
+			for (int32 Index = 0; Index < ThreadsToKill.Num(); Index++)
 			{
-				{
-					FScopeLock Lock(SynchQueue);
-					if (AllThreads.Num() == QueuedThreads.Num())
-					{
-						break;
-					}
-				}
-				FPlatformProcess::Sleep(0.0f);
-			}
-			// Delete all threads
-			{
-				FScopeLock Lock(SynchQueue);
-				// Now tell each thread to die and delete those
-				for (int32 Index = 0; Index < AllThreads.Num(); Index++)
-				{
-					AllThreads[Index]->KillThread();
-					delete AllThreads[Index];
-				}
-				QueuedThreads.Empty();
-				AllThreads.Empty();
+				ThreadsToKill[Index]->KillThread();
+				delete ThreadsToKill[Index];
 			}
-			delete SynchQueue;
-			SynchQueue = nullptr;
+			NumLiveThreads = 0;
+
+			TArray<FQueuedThread*> IdleThreads;
+			QueuedThreads.PopAll(IdleThreads);
+
+			// Work that was added while the threads were shutting down
+			AbandonQueuedWork();
 		}
 	}
 
 	int32 GetNumQueuedJobs() const
 	{
-		// this is a estimate of the number of queued jobs. 
-		// no need for thread safe lock as the queuedWork array isn't moved around in memory so unless this class is being destroyed then we don't need to wrory about it
-		return QueuedWork.Num();
+		// this is a estimate of the number of queued jobs
+		return NumQueuedWork.GetValue();
 	}
 	virtual int32 GetNumThreads() const 
 	{
-		return AllThreads.Num();
+		return NumLiveThreads.Load(EMemoryOrder::Relaxed);
 	}
-	void AddQueuedWork(IQueuedWork* InQueuedWork) override
+	void AddQueuedWork(IQueuedWork* InQueuedWork, EQueuedWorkPriority InQueuedWorkPriority = EQueuedWorkPriority::Normal) override
 	{
 		check(InQueuedWork != nullptr);
+		check(InQueuedWorkPriority < EQueuedWorkPriority::Count);
 
 		if (TimeToDie)
 		{
@@ -726,79 +806,260 @@ public:
 			return;
 		}
 
-		// Check to see if a thread is available. Make sure no other threads
-		// can manipulate the thread pool while we do this.
-		//
-		// We pick a thread from the back of the array since this will be the
-		// most recently used thread and therefore the most likely to have
-		// a 'hot' cache for the stack etc (similar to Windows IOCP scheduling
-		// strategy). Picking from the back also happens to be cheaper since
-		// no memory movement is necessary.
+		FQueuedWorkEntry* Entry = EntryAllocator.New();
+		Entry->Work = InQueuedWork;
+		Entry->QueuedCycles = FPlatformTime::Cycles64();
+		NumQueuedWork.Increment();
+		TRACE_COUNTER_SET(ThreadPoolQueuedJobs, GNumQueuedThreadPoolJobs.Increment());
+		QueuedWork[(int32)InQueuedWorkPriority].Push(Entry);
 
-		check(SynchQueue);
+		if (!WakeIdleThread() && bIsElastic)
+		{
+			const bool bAllBlocked = NumBlockedThreads.Load(EMemoryOrder::Relaxed) >= NumLiveThreads.Load(EMemoryOrder::Relaxed);
+			if (bAllBlocked || FPlatformTime::Cycles64() - LastProgressCycles.Load(EMemoryOrder::Relaxed) > GrowAfterWaitCycles)
+			{
+				TryAddThread();
+			}
+		}
+	}
 
-		FQueuedThread* Thread = nullptr;
+	/**
+	 * Retracting takes every entry of a priority out of its queue and puts back all but the retracted one, which is
+	 * linear in the amount of queued work like it always was. Work of the same priority keeps its order, work queued
+	 * while the retraction runs may get ahead of it.
+	 */
+	virtual bool RetractQueuedWork(IQueuedWork* InQueuedWork) override
+	{
+		if (TimeToDie)
+		{
+			return false; // no special consideration for this, refuse the retraction and let shutdown proceed
+		}
+		check(InQueuedWork != nullptr);
 
+		bool bRetracted = false;
+		TArray<FQueuedWorkEntry*, TInlineAllocator<64>> Entries;
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count && !bRetracted; ++Priority)
 		{
-			FScopeLock sl(SynchQueue);
-			const int32 AvailableThreadCount = QueuedThreads.Num();
-			if (AvailableThreadCount == 0)
+			while (FQueuedWorkEntry* Entry = QueuedWork[Priority].Pop())
 			{
-				// No thread available, queue the work to be done
-				// as soon as one does become available
-				QueuedWork.Add(InQueuedWork);
+				Entries.Add(Entry);
+			}
 
-				return;
+			for (FQueuedWorkEntry* Entry : Entries)
+			{
+				if (!bRetracted && Entry->Work == InQueuedWork)
+				{
+					bRetracted = true;
+					NumQueuedWork.Decrement();
+					TRACE_COUNTER_SET(ThreadPoolQueuedJobs, GNumQueuedThreadPoolJobs.Decrement());
+					EntryAllocator.Free(Entry);
+				}
+				else
+				{
+					QueuedWork[Priority].Push(Entry);
+				}
 			}
 
-			const int32 ThreadIndex = AvailableThreadCount - 1;
+			// A thread may have found the queue empty and gone idle while it was taken apart
+			if (Entries.Num() > (bRetracted ? 1 : 0))
+			{
+				WakeIdleThread();
+			}
+			Entries.Reset();
+		}
+		return bRetracted;
+	}
 
-			Thread = QueuedThreads[ThreadIndex];
-			// Remove it from the list so no one else grabs it
-			QueuedThreads.RemoveAt(ThreadIndex, 1, /* do not allow shrinking */ false);
+	/** Takes the oldest work of the highest priority that has any, or returns null if there is none */
+	IQueuedWork* GetNextJob()
+	{
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; ++Priority)
+		{
+			if (FQueuedWorkEntry* Entry = QueuedWork[Priority].Pop())
+			{
+				IQueuedWork* Work = Entry->Work;
+				const uint64 Cycles = FPlatformTime::Cycles64();
+				const uint64 WaitCycles = Cycles - Entry->QueuedCycles;
+				NumQueuedWork.Decrement();
+				TRACE_COUNTER_SET(ThreadPoolQueuedJobs, GNumQueuedThreadPoolJobs.Decrement());
+				TRACE_COUNTER_SET(ThreadPoolQueueTime, FPlatformTime::ToMilliseconds64(WaitCycles));
+				EntryAllocator.Free(Entry);
+
+				if (bIsElastic)
+				{
+					LastProgressCycles = Cycles;
+					// This work waited too long and there is more behind it that no idle thread can take
+					if (WaitCycles > GrowAfterWaitCycles && QueuedThreads.IsEmpty() && HasQueuedWork())
+					{
+						TryAddThread();
+					}
+				}
+				return Work;
+			}
 		}
+		return nullptr;
+	}
 
-		// Tell our chosen thread to do the work
-		Thread->DoWork(InQueuedWork);
+	/** Called by a thread that found no work, it goes back to waiting for its event. */
+	void ReturnToPool(FQueuedThread* InQueuedThread)
+	{
+		check(InQueuedThread != nullptr);
+		if (bIsElastic)
+		{
+			LastProgressCycles = FPlatformTime::Cycles64();
+		}
+		InQueuedThread->MarkIdle();
+		QueuedThreads.Push(InQueuedThread);
+
+		// Work may have been added after this thread last looked and before it became idle, in which case whoever added
+		// it found no thread to wake. Wake one now, which may well be this thread, in which case its next wait returns at once.
+		if (HasQueuedWork())
+		{
+			WakeIdleThread();
+		}
 	}
 
-	virtual bool RetractQueuedWork(IQueuedWork* InQueuedWork) override
+	/** How long idle threads wait for work before they try to retire */
+	uint32 GetIdleTimeoutMs() const
 	{
-		if (TimeToDie)
+		return bIsElastic ? (uint32)FMath::Max(ElasticSettings.RetireAfterIdleSeconds * 1000.0f, 1.0f) : MAX_uint32;
+	}
+
+	/**
+	 * Called by an idle thread whose wait for work timed out. It stays in the idle threads, whoever takes it
+	 * from there deletes it.
+	 *
+	 * @return true if the thread retired and must exit
+	 */
+	bool TryRetireThread(FQueuedThread* InQueuedThread)
+	{
+		if (!bIsElastic)
 		{
-			return false; // no special consideration for this, refuse the retraction and let shutdown proceed
+			return false;
 		}
-		check(InQueuedWork != nullptr);
-		check(SynchQueue);
-		FScopeLock sl(SynchQueue);
-		return !!QueuedWork.RemoveSingle(InQueuedWork);
+
+		int32 NumLive = NumLiveThreads.Load();
+		do
+		{
+			if (NumLive <= (int32)ElasticSettings.MinThreads)
+			{
+				return false;
+			}
+		}
+		while (!NumLiveThreads.CompareExchange(NumLive, NumLive - 1));
+
+		if (!InQueuedThread->TryRetire())
+		{
+			// Woken at the same time, the wake up is already on its way
+			++NumLiveThreads;
+			return false;
+		}
+		return true;
 	}
 
-	IQueuedWork* ReturnToPoolOrGetNextJob(FQueuedThread* InQueuedThread)
+	void BeginBlocking()
 	{
-		check(InQueuedThread != nullptr);
-		IQueuedWork* Work = nullptr;
-		// Check to see if there is any work to be done
-		FScopeLock sl(SynchQueue);
-		if (TimeToDie)
+		const int32 NumBlocked = ++NumBlockedThreads;
+		if (bIsElastic && NumBlocked >= NumLiveThreads.Load(EMemoryOrder::Relaxed) && HasQueuedWork())
 		{
-			check(!QueuedWork.Num());  // we better not have anything if we are dying
+			TryAddThread();
 		}
-		if (QueuedWork.Num() > 0)
+	}
+
+	void EndBlocking()
+	{
+		--NumBlockedThreads;
+	}
+
+protected:
+
+	bool HasQueuedWork() const
+	{
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; ++Priority)
 		{
-			// Grab the oldest work in the queue. This is slower than
-			// getting the most recent but prevents work from being
-			// queued and never done
-			Work = QueuedWork[0];
-			// Remove it from the list so no one else grabs it
-			QueuedWork.RemoveAt(0, 1, /* do not allow shrinking */ false);
+			if (!QueuedWork[Priority].IsEmpty())
+			{
+				return true;
+			}
 		}
-		if (!Work)
+		return false;
+	}
+
+	bool WakeIdleThread()
+	{
+		while (FQueuedThread* Thread = QueuedThreads.Pop())
 		{
-			// There was no work to be done, so add the thread to the pool
-			QueuedThreads.Add(InQueuedThread);
+			if (Thread->TryWake())
+			{
+				return true;
+			}
+			DeleteRetiredThread(Thread);
+		}
+		return false;
+	}
+
+	/** Adds a thread to an elastic pool if it is below its maximum and did not just grow */
+	void TryAddThread()
+	{
+		const uint64 Cycles = FPlatformTime::Cycles64();
+		uint64 LastGrow = LastGrowCycles.Load();
+		if (Cycles - LastGrow < GrowAfterWaitCycles || !LastGrowCycles.CompareExchange(LastGrow, Cycles))
+		{
+			return;
+		}
+
+		int32 NumLive = NumLiveThreads.Load();
+		do
+		{
+			if (NumLive >= (int32)ElasticSettings.MaxThreads)
+			{
+				return;
+			}
+		}
+		while (!NumLiveThreads.CompareExchange(NumLive, NumLive + 1));
+
+		FQueuedThread* NewThread = new FQueuedThread();
+		{
+			FScopeLock Lock(&AllThreadsCritical);
+			if (TimeToDie || !NewThread->Create(this, ThreadStackSize, ThreadPriority))
+			{
+				--NumLiveThreads;
+				delete NewThread;
+				return;
+			}
+			AllThreads.Add(NewThread);
+		}
+		QueuedThreads.Push(NewThread);
+		WakeIdleThread();
+	}
+
+	/** Deletes a thread that retired, once it was taken from the idle threads nothing else refers to it */
+	void DeleteRetiredThread(FQueuedThread* InQueuedThread)
+	{
+		{
+			FScopeLock Lock(&AllThreadsCritical);
+			if (AllThreads.RemoveSingleSwap(InQueuedThread, /* do not allow shrinking */ false) == 0)
+			{
+				// Destroy owns it now
+				return;
+			}
+		}
+		InQueuedThread->KillThread();
+		delete InQueuedThread;
+	}
+
+	void AbandonQueuedWork()
+	{
+		for (int32 Priority = 0; Priority < (int32)EQueuedWorkPriority::Count; ++Priority)
+		{
+			while (FQueuedWorkEntry* Entry = QueuedWork[Priority].Pop())
+			{
+				Entry->Work->Abandon();
+				NumQueuedWork.Decrement();
+				TRACE_COUNTER_SET(ThreadPoolQueuedJobs, GNumQueuedThreadPoolJobs.Decrement());
+				EntryAllocator.Free(Entry);
+			}
 		}
-		return Work;
 	}
 };
 
@@ -809,11 +1070,35 @@ FQueuedThreadPool* FQueuedThreadPool::Allocate()
 	return new FQueuedThreadPoolBase;
 }
 
+FQueuedThreadPool* FQueuedThreadPool::AllocateElastic(const FElasticThreadPoolSettings& Settings)
+{
+	return new FQueuedThreadPoolBase(Settings);
+}
+
+FQueuedThreadPoolBlockingScope::FQueuedThreadPoolBlockingScope()
+	: Pool(GCurrentQueuedThreadPool)
+{
+	if (Pool)
+	{
+		Pool->BeginBlocking();
+	}
+}
+
+FQueuedThreadPoolBlockingScope::~FQueuedThreadPoolBlockingScope()
+{
+	if (Pool)
+	{
+		Pool->EndBlocking();
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 uint32
 FQueuedThread::Run()
 {
+	GCurrentQueuedThreadPool = OwningThreadPool;
+
 	while (!TimeToDie.Load(EMemoryOrder::Relaxed))
 	{
 		// This will force sending the stats packet from the previous frame.
@@ -838,22 +1123,30 @@ FQueuedThread::Run()
 		}
 #endif
 
-		if (bContinueWaiting)
+		if (bContinueWaiting && !DoWorkEvent->Wait(OwningThreadPool->GetIdleTimeoutMs()))
+		{
+			if (OwningThreadPool->TryRetireThread(this))
+			{
+				break;
+			}
+			// Still in the idle threads, or woken and about to be triggered
+			continue;
+		}
+
+		if (TimeToDie.Load(EMemoryOrder::Relaxed))
 		{
-			DoWorkEvent->Wait();
+			break;
 		}
 
-		IQueuedWork* LocalQueuedWork = QueuedWork;
-		QueuedWork = nullptr;
-		FPlatformMisc::MemoryBarrier();
-		check(LocalQueuedWork || TimeToDie.Load(EMemoryOrder::Relaxed)); // well you woke me up, where is the job or termination request?
-		while (LocalQueuedWork)
+		// Another thread may have taken the work we were woken for, in which case we just go back to waiting
+		while (IQueuedWork* LocalQueuedWork = OwningThreadPool->GetNextJob())
 		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
 			// Tell the object to do the work
 			LocalQueuedWork->DoThreadedWork();
-			// Let the object cleanup before we remove our ref to it
-			LocalQueuedWork = OwningThreadPool->ReturnToPoolOrGetNextJob(this);
+			TRACE_COUNTER_SET(ThreadPoolExecutionTime, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
 		}
+		OwningThreadPool->ReturnToPool(this);
 	}
 	return 0;
 }
@@ -25,6 +25,8 @@
 #include "HAL/PlatformMallocCrash.h"
 #include "HAL/MallocPoisonProxy.h"
 #include "HAL/MallocDoubleFreeFinder.h"
+#include "HAL/MallocSamplingProxy.h"
+#include "HAL/MallocGuardedSamplingProxy.h"
 
 #if MALLOC_GT_HOOKS
 
@@ -373,6 +375,12 @@ static int FMemory_GCreateMalloc_ThreadUnsafe()
 	GMalloc = new FMallocPoisonProxy(GMalloc);
 #endif
 
+	// sample allocations for heap profiling if enabled on the command line
+	GMalloc = FMallocSamplingProxy::OverrideIfEnabled(GMalloc);
+
+	// guard a sample of allocations to catch overflows and uses after free if enabled on the command line
+	GMalloc = FMallocGuardedSamplingProxy::OverrideIfEnabled(GMalloc);
+
 #endif
 
 // On Mac it's too early to log here in some cases. For example GMalloc may be created during initialization of a third party dylib on load, before CoreFoundation is initialized
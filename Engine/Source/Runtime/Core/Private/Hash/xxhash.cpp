@@ -0,0 +1,590 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Hash/xxhash.h"
+
+#include "HAL/UnrealMemory.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_XXHASH_SSE2 1
+	#define UE_XXHASH_NEON 0
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#define UE_XXHASH_SSE2 0
+	#define UE_XXHASH_NEON 1
+	#include <arm_neon.h>
+#else
+	#define UE_XXHASH_SSE2 0
+	#define UE_XXHASH_NEON 0
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+namespace UE4XxHash_Private
+{
+	static const uint32 Prime32_1 = 0x9E3779B1U;
+	static const uint32 Prime32_2 = 0x85EBCA77U;
+	static const uint32 Prime32_3 = 0xC2B2AE3DU;
+	static const uint64 Prime64_1 = 0x9E3779B185EBCA87ULL;
+	static const uint64 Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+	static const uint64 Prime64_3 = 0x165667B19E3779F9ULL;
+	static const uint64 Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+	static const uint64 Prime64_5 = 0x27D4EB2F165667C5ULL;
+
+	static const uint32 StripeSize = 64;
+	static const uint32 SecretConsumeRate = 8;
+	static const uint32 SecretSize = 192;
+	static const uint32 SecretMergeAccsStart = 11;
+	static const uint32 SecretLastAccStart = 7;
+	static const uint32 MidSizeMax = 240;
+	static const uint32 StripesPerBlock = (SecretSize - StripeSize) / SecretConsumeRate;
+
+	alignas(16) static const uint8 DefaultSecret[SecretSize] =
+	{
+		0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+		0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+		0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+		0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+		0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+		0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+		0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+		0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+		0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+		0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+		0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+		0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+	};
+
+	static const uint64 InitialAcc[8] = { Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1 };
+
+	// The hash is defined on little endian reads
+	static FORCEINLINE uint32 Read32(const uint8* Data)
+	{
+		uint32 Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+#if !PLATFORM_LITTLE_ENDIAN
+		Value = ((Value & 0xFF) << 24) | ((Value & 0xFF00) << 8) | ((Value >> 8) & 0xFF00) | (Value >> 24);
+#endif
+		return Value;
+	}
+
+	static FORCEINLINE uint64 Swap64(uint64 Value)
+	{
+		Value = ((Value & 0x00FF00FF00FF00FFULL) << 8) | ((Value >> 8) & 0x00FF00FF00FF00FFULL);
+		Value = ((Value & 0x0000FFFF0000FFFFULL) << 16) | ((Value >> 16) & 0x0000FFFF0000FFFFULL);
+		return (Value << 32) | (Value >> 32);
+	}
+
+	static FORCEINLINE uint64 Read64(const uint8* Data)
+	{
+		uint64 Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+#if !PLATFORM_LITTLE_ENDIAN
+		Value = Swap64(Value);
+#endif
+		return Value;
+	}
+
+	static FORCEINLINE uint32 Swap32(uint32 Value)
+	{
+		return ((Value & 0xFF) << 24) | ((Value & 0xFF00) << 8) | ((Value >> 8) & 0xFF00) | (Value >> 24);
+	}
+
+	static FORCEINLINE uint64 Rotl64(uint64 Value, uint32 Shift)
+	{
+		return (Value << Shift) | (Value >> (64 - Shift));
+	}
+
+	static FORCEINLINE uint32 Rotl32(uint32 Value, uint32 Shift)
+	{
+		return (Value << Shift) | (Value >> (32 - Shift));
+	}
+
+	static FORCEINLINE uint64 Multiply128(uint64 A, uint64 B, uint64& OutHigh)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Product = (unsigned __int128)A * B;
+		OutHigh = (uint64)(Product >> 64);
+		return (uint64)Product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return _umul128(A, B, &OutHigh);
+#else
+		const uint64 LoLo = (A & 0xFFFFFFFF) * (B & 0xFFFFFFFF);
+		const uint64 HiLo = (A >> 32) * (B & 0xFFFFFFFF);
+		const uint64 LoHi = (A & 0xFFFFFFFF) * (B >> 32);
+		const uint64 HiHi = (A >> 32) * (B >> 32);
+		const uint64 Cross = (LoLo >> 32) + (HiLo & 0xFFFFFFFF) + LoHi;
+		OutHigh = (HiLo >> 32) + (Cross >> 32) + HiHi;
+		return (Cross << 32) | (LoLo & 0xFFFFFFFF);
+#endif
+	}
+
+	static FORCEINLINE uint64 MultiplyFold64(uint64 A, uint64 B)
+	{
+		uint64 High;
+		const uint64 Low = Multiply128(A, B, High);
+		return Low ^ High;
+	}
+
+	static FORCEINLINE uint64 XxHash64Avalanche(uint64 Hash)
+	{
+		Hash ^= Hash >> 33;
+		Hash *= Prime64_2;
+		Hash ^= Hash >> 29;
+		Hash *= Prime64_3;
+		return Hash ^ (Hash >> 32);
+	}
+
+	static FORCEINLINE uint64 Avalanche(uint64 Hash)
+	{
+		Hash ^= Hash >> 37;
+		Hash *= 0x165667919E3779F9ULL;
+		return Hash ^ (Hash >> 32);
+	}
+
+	static FORCEINLINE uint64 Mix16(const uint8* Data, const uint8* Secret)
+	{
+		return MultiplyFold64(Read64(Data) ^ Read64(Secret), Read64(Data + 8) ^ Read64(Secret + 8));
+	}
+
+	static FORCEINLINE void Mix32(uint64& Low, uint64& High, const uint8* Data1, const uint8* Data2, const uint8* Secret)
+	{
+		Low += Mix16(Data1, Secret);
+		Low ^= Read64(Data2) + Read64(Data2 + 8);
+		High += Mix16(Data2, Secret + 16);
+		High ^= Read64(Data1) + Read64(Data1 + 8);
+	}
+
+	/** Adds a 64 byte stripe to the accumulators */
+	static FORCEINLINE void Accumulate512(uint64* __restrict Acc, const uint8* __restrict Data, const uint8* __restrict Secret)
+	{
+#if UE_XXHASH_SSE2
+		__m128i* Accs = (__m128i*)Acc;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const __m128i DataVec = _mm_loadu_si128((const __m128i*)Data + Index);
+			const __m128i DataKey = _mm_xor_si128(DataVec, _mm_loadu_si128((const __m128i*)Secret + Index));
+			const __m128i Product = _mm_mul_epu32(DataKey, _mm_shuffle_epi32(DataKey, _MM_SHUFFLE(0, 3, 0, 1)));
+			const __m128i DataSwap = _mm_shuffle_epi32(DataVec, _MM_SHUFFLE(1, 0, 3, 2));
+			Accs[Index] = _mm_add_epi64(Accs[Index], _mm_add_epi64(Product, DataSwap));
+		}
+#elif UE_XXHASH_NEON
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const uint64x2_t DataVec = vreinterpretq_u64_u8(vld1q_u8(Data + Index * 16));
+			const uint64x2_t DataKey = veorq_u64(DataVec, vreinterpretq_u64_u8(vld1q_u8(Secret + Index * 16)));
+			uint64x2_t AccVec = vaddq_u64(vld1q_u64(Acc + Index * 2), vextq_u64(DataVec, DataVec, 1));
+			AccVec = vmlal_u32(AccVec, vmovn_u64(DataKey), vshrn_n_u64(DataKey, 32));
+			vst1q_u64(Acc + Index * 2, AccVec);
+		}
+#else
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			const uint64 DataValue = Read64(Data + Index * 8);
+			const uint64 DataKey = DataValue ^ Read64(Secret + Index * 8);
+			Acc[Index ^ 1] += DataValue;
+			Acc[Index] += (DataKey & 0xFFFFFFFF) * (DataKey >> 32);
+		}
+#endif
+	}
+
+	/** Mixes the accumulators at the end of each block */
+	static FORCEINLINE void ScrambleAcc(uint64* __restrict Acc, const uint8* __restrict Secret)
+	{
+#if UE_XXHASH_SSE2
+		__m128i* Accs = (__m128i*)Acc;
+		const __m128i Prime = _mm_set1_epi32((int32)Prime32_1);
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			__m128i AccVec = Accs[Index];
+			AccVec = _mm_xor_si128(AccVec, _mm_srli_epi64(AccVec, 47));
+			AccVec = _mm_xor_si128(AccVec, _mm_loadu_si128((const __m128i*)Secret + Index));
+			const __m128i ProductLow = _mm_mul_epu32(AccVec, Prime);
+			const __m128i ProductHigh = _mm_mul_epu32(_mm_shuffle_epi32(AccVec, _MM_SHUFFLE(0, 3, 0, 1)), Prime);
+			Accs[Index] = _mm_add_epi64(ProductLow, _mm_slli_epi64(ProductHigh, 32));
+		}
+#elif UE_XXHASH_NEON
+		const uint32x2_t Prime = vdup_n_u32(Prime32_1);
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			uint64x2_t AccVec = vld1q_u64(Acc + Index * 2);
+			AccVec = veorq_u64(AccVec, vshrq_n_u64(AccVec, 47));
+			AccVec = veorq_u64(AccVec, vreinterpretq_u64_u8(vld1q_u8(Secret + Index * 16)));
+			const uint64x2_t ProductHigh = vshlq_n_u64(vmull_u32(vshrn_n_u64(AccVec, 32), Prime), 32);
+			vst1q_u64(Acc + Index * 2, vmlal_u32(ProductHigh, vmovn_u64(AccVec), Prime));
+		}
+#else
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			uint64 Value = Acc[Index];
+			Value ^= Value >> 47;
+			Value ^= Read64(Secret + Index * 8);
+			Acc[Index] = Value * Prime32_1;
+		}
+#endif
+	}
+
+	static FORCEINLINE void AccumulateStripes(uint64* Acc, const uint8* Data, const uint8* Secret, uint64 NumStripes)
+	{
+		for (uint64 Stripe = 0; Stripe < NumStripes; ++Stripe)
+		{
+			Accumulate512(Acc, Data + Stripe * StripeSize, Secret + Stripe * SecretConsumeRate);
+		}
+	}
+
+	static uint64 MergeAccs(const uint64* Acc, const uint8* Secret, uint64 Start)
+	{
+		uint64 Result = Start;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Result += MultiplyFold64(Acc[Index * 2] ^ Read64(Secret + Index * 16), Acc[Index * 2 + 1] ^ Read64(Secret + Index * 16 + 8));
+		}
+		return Avalanche(Result);
+	}
+
+	/** Runs the accumulators over inputs longer than MidSizeMax */
+	static void HashLong(uint64 (&Acc)[8], const uint8* Data, uint64 Size)
+	{
+		FMemory::Memcpy(Acc, InitialAcc, sizeof(Acc));
+
+		const uint64 BlockSize = StripeSize * StripesPerBlock;
+		const uint64 NumBlocks = (Size - 1) / BlockSize;
+		for (uint64 Block = 0; Block < NumBlocks; ++Block)
+		{
+			AccumulateStripes(Acc, Data + Block * BlockSize, DefaultSecret, StripesPerBlock);
+			ScrambleAcc(Acc, DefaultSecret + SecretSize - StripeSize);
+		}
+
+		// The last partial block, then the last stripe which may overlap it
+		const uint64 NumStripes = ((Size - 1) - BlockSize * NumBlocks) / StripeSize;
+		AccumulateStripes(Acc, Data + NumBlocks * BlockSize, DefaultSecret, NumStripes);
+		Accumulate512(Acc, Data + Size - StripeSize, DefaultSecret + SecretSize - StripeSize - SecretLastAccStart);
+	}
+
+	static uint64 Hash64Short(const uint8* Data, uint64 Size)
+	{
+		const uint8* Secret = DefaultSecret;
+		if (Size > 8)
+		{
+			const uint64 Low = Read64(Data) ^ (Read64(Secret + 24) ^ Read64(Secret + 32));
+			const uint64 High = Read64(Data + Size - 8) ^ (Read64(Secret + 40) ^ Read64(Secret + 48));
+			return Avalanche(Size + Swap64(Low) + High + MultiplyFold64(Low, High));
+		}
+		else if (Size >= 4)
+		{
+			const uint64 Input = Read32(Data + Size - 4) + ((uint64)Read32(Data) << 32);
+			uint64 Keyed = Input ^ (Read64(Secret + 8) ^ Read64(Secret + 16));
+			Keyed ^= Rotl64(Keyed, 49) ^ Rotl64(Keyed, 24);
+			Keyed *= 0x9FB21C651E98DF25ULL;
+			Keyed ^= (Keyed >> 35) + Size;
+			Keyed *= 0x9FB21C651E98DF25ULL;
+			return Keyed ^ (Keyed >> 28);
+		}
+		else if (Size > 0)
+		{
+			const uint32 Combined = ((uint32)Data[0] << 16) | ((uint32)Data[Size >> 1] << 24) | (uint32)Data[Size - 1] | ((uint32)Size << 8);
+			return XxHash64Avalanche(Combined ^ (uint64)(Read32(Secret) ^ Read32(Secret + 4)));
+		}
+		return XxHash64Avalanche(Read64(Secret + 56) ^ Read64(Secret + 64));
+	}
+
+	static uint64 Hash64Medium(const uint8* Data, uint64 Size)
+	{
+		const uint8* Secret = DefaultSecret;
+		uint64 Acc = Size * Prime64_1;
+		if (Size <= 128)
+		{
+			if (Size > 32)
+			{
+				if (Size > 64)
+				{
+					if (Size > 96)
+					{
+						Acc += Mix16(Data + 48, Secret + 96);
+						Acc += Mix16(Data + Size - 64, Secret + 112);
+					}
+					Acc += Mix16(Data + 32, Secret + 64);
+					Acc += Mix16(Data + Size - 48, Secret + 80);
+				}
+				Acc += Mix16(Data + 16, Secret + 32);
+				Acc += Mix16(Data + Size - 32, Secret + 48);
+			}
+			Acc += Mix16(Data, Secret);
+			Acc += Mix16(Data + Size - 16, Secret + 16);
+			return Avalanche(Acc);
+		}
+
+		const uint32 NumRounds = (uint32)Size / 16;
+		for (uint32 Round = 0; Round < 8; ++Round)
+		{
+			Acc += Mix16(Data + Round * 16, Secret + Round * 16);
+		}
+		Acc = Avalanche(Acc);
+		for (uint32 Round = 8; Round < NumRounds; ++Round)
+		{
+			Acc += Mix16(Data + Round * 16, Secret + (Round - 8) * 16 + 3);
+		}
+		Acc += Mix16(Data + Size - 16, Secret + 136 - 17);
+		return Avalanche(Acc);
+	}
+
+	static uint64 Hash64(const uint8* Data, uint64 Size)
+	{
+		if (Size <= 16)
+		{
+			return Hash64Short(Data, Size);
+		}
+		if (Size <= MidSizeMax)
+		{
+			return Hash64Medium(Data, Size);
+		}
+
+		uint64 Acc[8];
+		HashLong(Acc, Data, Size);
+		return MergeAccs(Acc, DefaultSecret + SecretMergeAccsStart, Size * Prime64_1);
+	}
+
+	static FXxHash128 Hash128Short(const uint8* Data, uint64 Size)
+	{
+		const uint8* Secret = DefaultSecret;
+		FXxHash128 Result;
+		if (Size > 8)
+		{
+			const uint64 Low = Read64(Data);
+			uint64 High = Read64(Data + Size - 8);
+			uint64 MulHigh;
+			uint64 MulLow = Multiply128(Low ^ High ^ (Read64(Secret + 32) ^ Read64(Secret + 40)), Prime64_1, MulHigh);
+			MulLow += (Size - 1) << 54;
+			High ^= Read64(Secret + 48) ^ Read64(Secret + 56);
+			MulHigh += High + (uint64)(uint32)High * (Prime32_2 - 1);
+			MulLow ^= Swap64(MulHigh);
+
+			uint64 ResultHigh;
+			const uint64 ResultLow = Multiply128(MulLow, Prime64_2, ResultHigh);
+			ResultHigh += MulHigh * Prime64_2;
+			Result.HashLow = Avalanche(ResultLow);
+			Result.HashHigh = Avalanche(ResultHigh);
+		}
+		else if (Size >= 4)
+		{
+			const uint64 Input = Read32(Data) + ((uint64)Read32(Data + Size - 4) << 32);
+			const uint64 Keyed = Input ^ (Read64(Secret + 16) ^ Read64(Secret + 24));
+			uint64 High;
+			uint64 Low = Multiply128(Keyed, Prime64_1 + (Size << 2), High);
+			High += Low << 1;
+			Low ^= High >> 3;
+			Low ^= Low >> 35;
+			Low *= 0x9FB21C651E98DF25ULL;
+			Low ^= Low >> 28;
+			Result.HashLow = Low;
+			Result.HashHigh = Avalanche(High);
+		}
+		else if (Size > 0)
+		{
+			const uint32 Low = ((uint32)Data[0] << 16) | ((uint32)Data[Size >> 1] << 24) | (uint32)Data[Size - 1] | ((uint32)Size << 8);
+			const uint32 High = Rotl32(Swap32(Low), 13);
+			Result.HashLow = XxHash64Avalanche(Low ^ (uint64)(Read32(Secret) ^ Read32(Secret + 4)));
+			Result.HashHigh = XxHash64Avalanche(High ^ (uint64)(Read32(Secret + 8) ^ Read32(Secret + 12)));
+		}
+		else
+		{
+			Result.HashLow = XxHash64Avalanche(Read64(Secret + 64) ^ Read64(Secret + 72));
+			Result.HashHigh = XxHash64Avalanche(Read64(Secret + 80) ^ Read64(Secret + 88));
+		}
+		return Result;
+	}
+
+	static FXxHash128 Hash128Medium(const uint8* Data, uint64 Size)
+	{
+		const uint8* Secret = DefaultSecret;
+		uint64 Low = Size * Prime64_1;
+		uint64 High = 0;
+		if (Size <= 128)
+		{
+			if (Size > 32)
+			{
+				if (Size > 64)
+				{
+					if (Size > 96)
+					{
+						Mix32(Low, High, Data + 48, Data + Size - 64, Secret + 96);
+					}
+					Mix32(Low, High, Data + 32, Data + Size - 48, Secret + 64);
+				}
+				Mix32(Low, High, Data + 16, Data + Size - 32, Secret + 32);
+			}
+			Mix32(Low, High, Data, Data + Size - 16, Secret);
+		}
+		else
+		{
+			const uint32 NumRounds = (uint32)Size / 32;
+			for (uint32 Round = 0; Round < 4; ++Round)
+			{
+				Mix32(Low, High, Data + Round * 32, Data + Round * 32 + 16, Secret + Round * 32);
+			}
+			Low = Avalanche(Low);
+			High = Avalanche(High);
+			for (uint32 Round = 4; Round < NumRounds; ++Round)
+			{
+				Mix32(Low, High, Data + Round * 32, Data + Round * 32 + 16, Secret + (Round - 4) * 32 + 3);
+			}
+			Mix32(Low, High, Data + Size - 16, Data + Size - 32, Secret + 136 - 17 - 16);
+		}
+
+		FXxHash128 Result;
+		Result.HashLow = Avalanche(Low + High);
+		Result.HashHigh = 0 - Avalanche(Low * Prime64_1 + High * Prime64_4 + Size * Prime64_2);
+		return Result;
+	}
+
+	static FXxHash128 MergeAccs128(const uint64 (&Acc)[8], uint64 Size)
+	{
+		FXxHash128 Result;
+		Result.HashLow = MergeAccs(Acc, DefaultSecret + SecretMergeAccsStart, Size * Prime64_1);
+		Result.HashHigh = MergeAccs(Acc, DefaultSecret + SecretSize - sizeof(Acc) - SecretMergeAccsStart, ~(Size * Prime64_2));
+		return Result;
+	}
+
+	static FXxHash128 Hash128(const uint8* Data, uint64 Size)
+	{
+		if (Size <= 16)
+		{
+			return Hash128Short(Data, Size);
+		}
+		if (Size <= MidSizeMax)
+		{
+			return Hash128Medium(Data, Size);
+		}
+
+		uint64 Acc[8];
+		HashLong(Acc, Data, Size);
+		return MergeAccs128(Acc, Size);
+	}
+
+	/** Accumulates stripes for the streaming state, scrambling when a block of stripes is complete */
+	static uint32 ConsumeStripes(uint64* Acc, uint32 NumStripesInBlock, const uint8* Data, uint64 NumStripes)
+	{
+		if (StripesPerBlock - NumStripesInBlock <= NumStripes)
+		{
+			const uint64 StripesToEnd = StripesPerBlock - NumStripesInBlock;
+			const uint64 StripesAfterEnd = NumStripes - StripesToEnd;
+			AccumulateStripes(Acc, Data, DefaultSecret + NumStripesInBlock * SecretConsumeRate, StripesToEnd);
+			ScrambleAcc(Acc, DefaultSecret + SecretSize - StripeSize);
+			AccumulateStripes(Acc, Data + StripesToEnd * StripeSize, DefaultSecret, StripesAfterEnd);
+			return (uint32)StripesAfterEnd;
+		}
+
+		AccumulateStripes(Acc, Data, DefaultSecret + NumStripesInBlock * SecretConsumeRate, NumStripes);
+		return NumStripesInBlock + (uint32)NumStripes;
+	}
+
+	void FStreamState::Reset()
+	{
+		FMemory::Memcpy(Acc, InitialAcc, sizeof(Acc));
+		TotalSize = 0;
+		BufferedSize = 0;
+		NumStripesInBlock = 0;
+	}
+
+	void FStreamState::Update(const void* InData, uint64 Size)
+	{
+		const uint8* Data = (const uint8*)InData;
+		TotalSize += Size;
+
+		// The buffer is only consumed once more data follows it, so the last stripe is always available to finalize
+		if (BufferedSize + Size <= BufferSize)
+		{
+			FMemory::Memcpy(Buffer + BufferedSize, Data, Size);
+			BufferedSize += (uint32)Size;
+			return;
+		}
+
+		const uint32 BufferStripes = BufferSize / StripeSize;
+		if (BufferedSize)
+		{
+			const uint32 FillSize = BufferSize - BufferedSize;
+			FMemory::Memcpy(Buffer + BufferedSize, Data, FillSize);
+			Data += FillSize;
+			Size -= FillSize;
+			NumStripesInBlock = ConsumeStripes(Acc, NumStripesInBlock, Buffer, BufferStripes);
+			BufferedSize = 0;
+		}
+
+		if (Size > BufferSize)
+		{
+			do
+			{
+				NumStripesInBlock = ConsumeStripes(Acc, NumStripesInBlock, Data, BufferStripes);
+				Data += BufferSize;
+				Size -= BufferSize;
+			}
+			while (Size > BufferSize);
+
+			// Keep the last consumed stripe in case finalizing needs it
+			FMemory::Memcpy(Buffer + BufferSize - StripeSize, Data - StripeSize, StripeSize);
+		}
+
+		FMemory::Memcpy(Buffer, Data, Size);
+		BufferedSize = (uint32)Size;
+	}
+
+	void FStreamState::FinalizeAcc(uint64 (&OutAcc)[8]) const
+	{
+		FMemory::Memcpy(OutAcc, Acc, sizeof(OutAcc));
+		const uint8* LastStripeSecret = DefaultSecret + SecretSize - StripeSize - SecretLastAccStart;
+		if (BufferedSize >= StripeSize)
+		{
+			const uint32 NumStripes = (BufferedSize - 1) / StripeSize;
+			ConsumeStripes(OutAcc, NumStripesInBlock, Buffer, NumStripes);
+			Accumulate512(OutAcc, Buffer + BufferedSize - StripeSize, LastStripeSecret);
+		}
+		else
+		{
+			// The last stripe starts in the data consumed before
+			uint8 LastStripe[StripeSize];
+			const uint32 CatchupSize = StripeSize - BufferedSize;
+			FMemory::Memcpy(LastStripe, Buffer + BufferSize - CatchupSize, CatchupSize);
+			FMemory::Memcpy(LastStripe + CatchupSize, Buffer, BufferedSize);
+			Accumulate512(OutAcc, LastStripe, LastStripeSecret);
+		}
+	}
+}
+
+FXxHash64 FXxHash64::HashBuffer(const void* Data, uint64 Size)
+{
+	return FXxHash64{ UE4XxHash_Private::Hash64((const uint8*)Data, Size) };
+}
+
+FXxHash128 FXxHash128::HashBuffer(const void* Data, uint64 Size)
+{
+	return UE4XxHash_Private::Hash128((const uint8*)Data, Size);
+}
+
+FXxHash64 FXxHash64Builder::Finalize() const
+{
+	using namespace UE4XxHash_Private;
+
+	if (State.TotalSize <= MidSizeMax)
+	{
+		return FXxHash64{ Hash64(State.Buffer, State.TotalSize) };
+	}
+
+	uint64 Acc[8];
+	State.FinalizeAcc(Acc);
+	return FXxHash64{ MergeAccs(Acc, DefaultSecret + SecretMergeAccsStart, State.TotalSize * Prime64_1) };
+}
+
+FXxHash128 FXxHash128Builder::Finalize() const
+{
+	using namespace UE4XxHash_Private;
+
+	if (State.TotalSize <= MidSizeMax)
+	{
+		return Hash128(State.Buffer, State.TotalSize);
+	}
+
+	uint64 Acc[8];
+	State.FinalizeAcc(Acc);
+	return MergeAccs128(Acc, State.TotalSize);
+}
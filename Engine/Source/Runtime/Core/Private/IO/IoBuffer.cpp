@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "IO/IoDispatcher.h"
+#include "Async/MappedFileHandle.h"
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -14,6 +15,7 @@ FIoBuffer::BufCore::~BufCore()
 	{
 		FMemory::Free(Data());
 	}
+	delete MappedRegion;
 }
 
 FIoBuffer::BufCore::BufCore(const uint8* InData, uint64 InSize, bool InOwnsMemory)
@@ -44,6 +46,14 @@ FIoBuffer::BufCore::BufCore(ECloneTag, uint8* InData, uint64 InSize)
 	FMemory::Memcpy(Data(), InData, InSize);
 }
 
+FIoBuffer::BufCore::BufCore(IMappedFileRegion* InMappedRegion)
+:	MappedRegion(InMappedRegion)
+{
+	SetDataAndSize(InMappedRegion->GetMappedPtr(), InMappedRegion->GetMappedSize());
+
+	Flags |= ReadOnlyBuffer;
+}
+
 void
 FIoBuffer::BufCore::CheckRefCount() const
 {
@@ -82,6 +92,13 @@ FIoBuffer::BufCore::MakeOwned()
 	SetDataAndSize(NewBuffer, BufferSize);
 
 	SetIsOwned(true);
+
+	if (MappedRegion)
+	{
+		delete MappedRegion;
+		MappedRegion = nullptr;
+		Flags &= ~ReadOnlyBuffer;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -116,6 +133,11 @@ FIoBuffer::FIoBuffer(FIoBuffer::ECloneTag, const void* Data, uint64 InSize)
 {
 }
 
+FIoBuffer::FIoBuffer(FIoBuffer::EAssumeOwnershipTag, IMappedFileRegion* MappedRegion)
+:	CorePtr(new BufCore(MappedRegion))
+{
+}
+
 void		
 FIoBuffer::MakeOwned() const
 {
@@ -14,9 +14,48 @@
 #include "Serialization/LargeMemoryReader.h"
 #include "GenericPlatform/GenericPlatformChunkInstall.h"
 #include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
 DEFINE_LOG_CATEGORY(LogIoDispatcher);
 
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCompletionTimeUs, TEXT("IoDispatcher/CompletionTimeUs"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherInFlightBytes, TEXT("IoDispatcher/InFlightBytes"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCriticalLatencyUs, TEXT("IoDispatcher/CriticalLatencyUs"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherNormalLatencyUs, TEXT("IoDispatcher/NormalLatencyUs"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherBackgroundLatencyUs, TEXT("IoDispatcher/BackgroundLatencyUs"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherMissedDeadlines, TEXT("IoDispatcher/MissedDeadlines"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCancelledRequests, TEXT("IoDispatcher/CancelledRequests"));
+
+int32 GIoDispatcherMaxInFlightMB = 32;
+static FAutoConsoleVariableRef CVar_IoDispatcherMaxInFlightMB(
+	TEXT("s.IoDispatcherMaxInFlightMB"),
+	GIoDispatcherMaxInFlightMB,
+	TEXT("Normal and background requests stay queued while the requests being read add up to this size (in megabytes), critical requests never do. 0 dispatches every request right away.")
+);
+
+int32 GIoDispatcherQosNormalMaxBandwidthMB = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherQosNormalMaxBandwidthMB(
+	TEXT("s.IoDispatcherQosNormalMaxBandwidthMB"),
+	GIoDispatcherQosNormalMaxBandwidthMB,
+	TEXT("Bandwidth cap of normal requests (in megabytes per second), they stay queued while they are over it. 0 doesn't cap them.")
+);
+
+int32 GIoDispatcherQosBackgroundMaxBandwidthMB = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherQosBackgroundMaxBandwidthMB(
+	TEXT("s.IoDispatcherQosBackgroundMaxBandwidthMB"),
+	GIoDispatcherQosBackgroundMaxBandwidthMB,
+	TEXT("Bandwidth cap of background requests (in megabytes per second), they stay queued while they are over it. 0 doesn't cap them.")
+);
+
+int32 GIoDispatcherQosBackgroundMinPercent = 10;
+static FAutoConsoleVariableRef CVar_IoDispatcherQosBackgroundMinPercent(
+	TEXT("s.IoDispatcherQosBackgroundMinPercent"),
+	GIoDispatcherQosBackgroundMinPercent,
+	TEXT("Share of the dispatched bytes (in percent) that background requests get ahead of normal ones, so that they are never starved.")
+);
+
 const FIoChunkId FIoChunkId::InvalidChunkId = FIoChunkId::CreateEmptyId();
 
 TUniquePtr<FIoDispatcher> GIoDispatcher;
@@ -161,6 +200,7 @@ public:
 		Request->ChunkId = ChunkId;
 		Request->Options = Options;
 		Request->Status = FIoStatus::Unknown;
+		Request->IssueCycles = FPlatformTime::Cycles64();
 
 		return Request;
 	}
@@ -261,46 +301,160 @@ public:
 			{
 				WaitingRequestsTail->NextRequest = Batch->FirstRequest;
 			}
+			const uint64 IssueCycles = FPlatformTime::Cycles64();
 			WaitingRequestsTail = Batch->FirstRequest;
+			WaitingRequestsTail->IssueCycles = IssueCycles;
 			while (WaitingRequestsTail->BatchNextRequest)
 			{
 				WaitingRequestsTail->NextRequest = WaitingRequestsTail->BatchNextRequest;
 				WaitingRequestsTail = WaitingRequestsTail->BatchNextRequest;
+				WaitingRequestsTail->IssueCycles = IssueCycles;
 			}
 			WaitingRequestsTail->NextRequest = nullptr;
 		}
 		EventQueue.Notify();
 	}
 
+	void CancelBatch(const FIoBatchImpl* Batch)
+	{
+		for (FIoRequestImpl* Request = Batch->FirstRequest; Request; Request = Request->BatchNextRequest)
+		{
+			Request->bCancelled = true;
+		}
+		bCancelRequested = true;
+		EventQueue.Notify();
+	}
+
 private:
 	friend class FIoBatch;
 
+	/** Requests waiting to be dispatched in one quality of service class, and what the class was given lately */
+	struct FQosQueue
+	{
+		// Heap ordered by FRequestOrder
+		TArray<FIoRequestImpl*> Requests;
+		// Bytes the class may still dispatch before its bandwidth cap holds it back, can go below zero
+		double BandwidthTokens = 0.0;
+		// Bytes dispatched lately, halved every QosWindowSeconds
+		uint64 WindowBytes = 0;
+	};
+
+	/** Higher priority first, then earliest deadline first, then first in first out */
+	struct FRequestOrder
+	{
+		bool operator()(const FIoRequestImpl& A, const FIoRequestImpl& B) const
+		{
+			if (A.Options.GetPriority() != B.Options.GetPriority())
+			{
+				return A.Options.GetPriority() > B.Options.GetPriority();
+			}
+			if (A.Options.GetDeadline() != B.Options.GetDeadline())
+			{
+				return A.Options.GetDeadline() < B.Options.GetDeadline();
+			}
+			return A.Sequence < B.Sequence;
+		}
+	};
+
+	/** Capped classes can save up this many seconds of their bandwidth to dispatch at once */
+	static constexpr double QosBurstSeconds = 0.1;
+	static constexpr double QosWindowSeconds = 1.0;
+
+	static uint64 GetMaxBandwidth(EIoQosClass QosClass)
+	{
+		int32 MaxBandwidthMB = 0;
+		switch (QosClass)
+		{
+		case EIoQosClass::Normal:
+			MaxBandwidthMB = GIoDispatcherQosNormalMaxBandwidthMB;
+			break;
+		case EIoQosClass::Background:
+			MaxBandwidthMB = GIoDispatcherQosBackgroundMaxBandwidthMB;
+			break;
+		default:
+			break;
+		}
+		return MaxBandwidthMB > 0 ? uint64(MaxBandwidthMB) << 20 : 0;
+	}
+
+	static int32 GetMinPercent(EIoQosClass QosClass)
+	{
+		return QosClass == EIoQosClass::Background ? FMath::Clamp(GIoDispatcherQosBackgroundMinPercent, 0, 100) : 0;
+	}
+
 	void ProcessCompletedBlocks()
 	{
 		EventQueue.Poll();
 		while (FileIoStore.ProcessCompletedBlock())
 		{
-			ProcessCompletedRequests();
 		}
 	}
 
 	void ProcessCompletedRequests()
 	{
-		while (SubmittedRequestsHead && SubmittedRequestsHead->UnfinishedReadsCount == 0)
+		// Requests complete as soon as all their reads are done and not in the order they were dispatched in,
+		// a critical request must not wait behind background ones that were dispatched before it
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		FIoRequestImpl* PrevRequest = nullptr;
+		for (FIoRequestImpl* Request = SubmittedRequestsHead; Request;)
+		{
+			FIoRequestImpl* NextRequest = Request->NextRequest;
+			if (Request->UnfinishedReadsCount == 0)
+			{
+				//TRACE_CPUPROFILER_EVENT_SCOPE(CompleteRequest);
+				if (PrevRequest)
+				{
+					PrevRequest->NextRequest = NextRequest;
+				}
+				else
+				{
+					SubmittedRequestsHead = NextRequest;
+				}
+				if (SubmittedRequestsTail == Request)
+				{
+					SubmittedRequestsTail = PrevRequest;
+				}
+				InFlightBytes -= Request->DispatchedSize;
+				CompleteRequest(Request);
+			}
+			else
+			{
+				PrevRequest = Request;
+			}
+			Request = NextRequest;
+		}
+		TRACE_COUNTER_SET(IoDispatcherInFlightBytes, InFlightBytes);
+		TRACE_COUNTER_ADD(IoDispatcherCompletionTimeUs, int64(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0));
+	}
+
+	void TraceRequestLatency(const FIoRequestImpl* Request)
+	{
+		const uint64 CompletionCycles = FPlatformTime::Cycles64();
+		const int64 LatencyUs = int64(FPlatformTime::ToSeconds64(CompletionCycles - Request->IssueCycles) * 1000000.0);
+		switch (Request->Options.GetQosClass())
 		{
-			//TRACE_CPUPROFILER_EVENT_SCOPE(CompleteRequest);
-			FIoRequestImpl* NextRequest = SubmittedRequestsHead->NextRequest;
-			CompleteRequest(SubmittedRequestsHead);
-			SubmittedRequestsHead = NextRequest;
+		case EIoQosClass::Critical:
+			TRACE_COUNTER_SET(IoDispatcherCriticalLatencyUs, LatencyUs);
+			break;
+		case EIoQosClass::Normal:
+			TRACE_COUNTER_SET(IoDispatcherNormalLatencyUs, LatencyUs);
+			break;
+		default:
+			TRACE_COUNTER_SET(IoDispatcherBackgroundLatencyUs, LatencyUs);
+			break;
 		}
-		if (!SubmittedRequestsHead)
+		if (CompletionCycles > Request->Options.GetDeadline())
 		{
-			SubmittedRequestsTail = nullptr;
+			TRACE_COUNTER_INCREMENT(IoDispatcherMissedDeadlines);
 		}
 	}
 
 	void CompleteRequest(FIoRequestImpl* Request)
 	{
+		if (Request->Status.GetErrorCode() != EIoErrorCode::Cancelled)
+		{
+			TraceRequestLatency(Request);
+		}
 		if (!Request->Status.IsCompleted())
 		{
 			Request->Status = EIoErrorCode::Ok;
@@ -322,61 +476,196 @@ private:
 		}
 	}
 
-	void ProcessIncomingRequests()
+	void CompleteCancelledRequest(FIoRequestImpl* Request)
 	{
-		FIoRequestImpl* RequestsToSubmitHead = nullptr;
-		FIoRequestImpl* RequestsToSubmitTail = nullptr;
-		//TRACE_CPUPROFILER_EVENT_SCOPE(ProcessIncomingRequests);
-		for (;;)
+		TRACE_COUNTER_INCREMENT(IoDispatcherCancelledRequests);
+		Request->Status = FIoStatus(EIoErrorCode::Cancelled);
+		CompleteRequest(Request);
+	}
+
+	void QueueRequest(FIoRequestImpl* Request)
+	{
+		if (Request->bCancelled)
+		{
+			CompleteCancelledRequest(Request);
+			return;
+		}
+		Request->Sequence = NextRequestSequence++;
+		const int32 QosIndex = FMath::Min(int32(Request->Options.GetQosClass()), int32(EIoQosClass::Count) - 1);
+		QosQueues[QosIndex].Requests.HeapPush(Request, FRequestOrder());
+	}
+
+	void RemoveCancelledRequests()
+	{
+		for (FQosQueue& Queue : QosQueues)
 		{
+			const int32 RemovedCount = Queue.Requests.RemoveAllSwap([this](FIoRequestImpl* Request)
 			{
-				FScopeLock _(&WaitingLock);
-				if (WaitingRequestsHead)
+				if (Request->bCancelled)
 				{
-					if (RequestsToSubmitTail)
-					{
-						RequestsToSubmitTail->NextRequest = WaitingRequestsHead;
-						RequestsToSubmitTail = WaitingRequestsTail;
-					}
-					else
-					{
-						RequestsToSubmitHead = WaitingRequestsHead;
-						RequestsToSubmitTail = WaitingRequestsTail;
-					}
-					WaitingRequestsHead = WaitingRequestsTail = nullptr;
+					CompleteCancelledRequest(Request);
+					return true;
 				}
+				return false;
+			}, false);
+			if (RemovedCount > 0)
+			{
+				Queue.Requests.Heapify(FRequestOrder());
 			}
-			if (!RequestsToSubmitHead)
+		}
+	}
+
+	void UpdateQosQueues(uint64 CurrentCycles)
+	{
+		const double ElapsedSeconds = FPlatformTime::ToSeconds64(CurrentCycles - QosUpdateCycles);
+		QosUpdateCycles = CurrentCycles;
+		const bool bWindowElapsed = FPlatformTime::ToSeconds64(CurrentCycles - QosWindowStartCycles) >= QosWindowSeconds;
+		if (bWindowElapsed)
+		{
+			QosWindowStartCycles = CurrentCycles;
+		}
+		for (int32 QosIndex = 0; QosIndex < int32(EIoQosClass::Count); ++QosIndex)
+		{
+			FQosQueue& Queue = QosQueues[QosIndex];
+			const double MaxBandwidth = double(GetMaxBandwidth(EIoQosClass(QosIndex)));
+			Queue.BandwidthTokens = FMath::Min(Queue.BandwidthTokens + MaxBandwidth * ElapsedSeconds, MaxBandwidth * QosBurstSeconds);
+			if (bWindowElapsed)
 			{
-				return;
+				Queue.WindowBytes /= 2;
 			}
+		}
+	}
+
+	/** Picks the class to dispatch from next, or none when the in-flight budget or the bandwidth caps hold every queued request back */
+	FQosQueue* PickQosQueue()
+	{
+		FQosQueue& CriticalQueue = QosQueues[int32(EIoQosClass::Critical)];
+		if (CriticalQueue.Requests.Num())
+		{
+			return &CriticalQueue;
+		}
+
+		const uint64 MaxInFlightBytes = GIoDispatcherMaxInFlightMB > 0 ? uint64(GIoDispatcherMaxInFlightMB) << 20 : MAX_uint64;
+		if (InFlightBytes > 0 && InFlightBytes >= MaxInFlightBytes)
+		{
+			return nullptr;
+		}
+
+		uint64 TotalWindowBytes = 0;
+		for (const FQosQueue& Queue : QosQueues)
+		{
+			TotalWindowBytes += Queue.WindowBytes;
+		}
 
-			FIoRequestImpl* Request = RequestsToSubmitHead;
-			RequestsToSubmitHead = RequestsToSubmitHead->NextRequest;
-			if (!RequestsToSubmitHead)
+		FQosQueue* PickedQueue = nullptr;
+		for (int32 QosIndex = int32(EIoQosClass::Critical) + 1; QosIndex < int32(EIoQosClass::Count); ++QosIndex)
+		{
+			FQosQueue& Queue = QosQueues[QosIndex];
+			if (!Queue.Requests.Num())
+			{
+				continue;
+			}
+			const uint64 MaxBandwidth = GetMaxBandwidth(EIoQosClass(QosIndex));
+			if (MaxBandwidth > 0 && Queue.BandwidthTokens <= 0.0)
+			{
+				const uint32 RefillTimeMs = uint32(-Queue.BandwidthTokens * 1000.0 / double(MaxBandwidth)) + 1;
+				ThrottleWaitTimeMs = ThrottleWaitTimeMs ? FMath::Min(ThrottleWaitTimeMs, RefillTimeMs) : RefillTimeMs;
+				continue;
+			}
+			// A class below its guaranteed share goes ahead of the ones before it
+			const int32 MinPercent = GetMinPercent(EIoQosClass(QosIndex));
+			if (MinPercent > 0 && Queue.WindowBytes * 100 < TotalWindowBytes * MinPercent)
+			{
+				return &Queue;
+			}
+			if (!PickedQueue)
 			{
-				RequestsToSubmitTail = nullptr;
+				PickedQueue = &Queue;
 			}
+		}
+		return PickedQueue;
+	}
+
+	void DispatchRequest(FIoRequestImpl* Request, FQosQueue& Queue)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(ResolveRequest);
+
+		EIoStoreResolveResult Result = FileIoStore.Resolve(Request);
+		if (Result == IoStoreResolveResult_NotFound)
+		{
+			Request->Status = FIoStatus(EIoErrorCode::NotFound);
+		}
+		Request->DispatchedSize = Request->IoBuffer.DataSize();
+		InFlightBytes += Request->DispatchedSize;
+		Queue.BandwidthTokens -= double(Request->DispatchedSize);
+		Queue.WindowBytes += Request->DispatchedSize;
+
+		if (!SubmittedRequestsTail)
+		{
+			SubmittedRequestsHead = SubmittedRequestsTail = Request;
+		}
+		else
+		{
+			SubmittedRequestsTail->NextRequest = Request;
+			SubmittedRequestsTail = Request;
+		}
+		Request->NextRequest = nullptr;
+	}
 
-			//TRACE_CPUPROFILER_EVENT_SCOPE(ResolveRequest);
+	/** Resolves queued requests in scheduling order until the budget is used up. Returns whether any were dispatched. */
+	bool DispatchQueuedRequests()
+	{
+		UpdateQosQueues(FPlatformTime::Cycles64());
+		ThrottleWaitTimeMs = 0;
+		bool bDispatchedAny = false;
+		while (FQosQueue* Queue = PickQosQueue())
+		{
+			FIoRequestImpl* Request;
+			Queue->Requests.HeapPop(Request, FRequestOrder(), false);
+			if (Request->bCancelled)
+			{
+				CompleteCancelledRequest(Request);
+				continue;
+			}
+			DispatchRequest(Request, *Queue);
+			bDispatchedAny = true;
+		}
+		TRACE_COUNTER_SET(IoDispatcherInFlightBytes, InFlightBytes);
+		return bDispatchedAny;
+	}
 
-			EIoStoreResolveResult Result = FileIoStore.Resolve(Request);
-			if (Result == IoStoreResolveResult_NotFound)
+	void ProcessIncomingRequests()
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(ProcessIncomingRequests);
+		for (;;)
+		{
+			FIoRequestImpl* IncomingRequestsHead = nullptr;
 			{
-				Request->Status = FIoStatus(EIoErrorCode::NotFound);
+				FScopeLock _(&WaitingLock);
+				IncomingRequestsHead = WaitingRequestsHead;
+				WaitingRequestsHead = WaitingRequestsTail = nullptr;
 			}
-			if (!SubmittedRequestsTail)
+			while (IncomingRequestsHead)
 			{
-				SubmittedRequestsHead = SubmittedRequestsTail = Request;
+				FIoRequestImpl* Request = IncomingRequestsHead;
+				IncomingRequestsHead = IncomingRequestsHead->NextRequest;
+				QueueRequest(Request);
 			}
-			else
+			if (bCancelRequested.Exchange(false))
 			{
-				SubmittedRequestsTail->NextRequest = Request;
-				SubmittedRequestsTail = Request;
+				RemoveCancelledRequests();
+			}
+
+			// Resolve everything that may be dispatched before issuing any reads so that the file backend
+			// can sort them and merge adjacent blocks into larger reads
+			if (!DispatchQueuedRequests())
+			{
+				return;
 			}
-			Request->NextRequest = nullptr;
 
+			FileIoStore.FlushPendingReads();
 			ProcessCompletedBlocks();
+			ProcessCompletedRequests();
 		}
 	}
 
@@ -389,12 +678,21 @@ private:
 	{
 		while (!bStopRequested)
 		{
-			EventQueue.Wait();
-			
+			// Requests held back by a bandwidth cap are dispatched once it has refilled, nothing else would wake the thread
+			if (ThrottleWaitTimeMs)
+			{
+				EventQueue.WaitFor(ThrottleWaitTimeMs);
+			}
+			else
+			{
+				EventQueue.Wait();
+			}
+
 			TRACE_CPUPROFILER_EVENT_SCOPE(ProcessEventQueue);
-			ProcessIncomingRequests();
+			// Completions go first, the in-flight budget they give back is used by the requests dispatched next
 			ProcessCompletedBlocks();
 			ProcessCompletedRequests();
+			ProcessIncomingRequests();
 		}
 		return 0;
 	}
@@ -419,6 +717,13 @@ private:
 	FIoRequestImpl* WaitingRequestsTail = nullptr;
 	FIoRequestImpl* SubmittedRequestsHead = nullptr;
 	FIoRequestImpl* SubmittedRequestsTail = nullptr;
+	FQosQueue QosQueues[int32(EIoQosClass::Count)];
+	uint64 NextRequestSequence = 0;
+	uint64 InFlightBytes = 0;
+	uint64 QosUpdateCycles = FPlatformTime::Cycles64();
+	uint64 QosWindowStartCycles = QosUpdateCycles;
+	uint32 ThrottleWaitTimeMs = 0;
+	TAtomic<bool> bCancelRequested { false };
 	TAtomic<bool> bStopRequested { false };
 };
 
@@ -543,7 +848,7 @@ FIoBatch::Wait()
 void
 FIoBatch::Cancel()
 {
-	unimplemented();
+	Dispatcher->CancelBatch(Impl);
 }
 
 //////////////////////////////////////////////////////////////////////////
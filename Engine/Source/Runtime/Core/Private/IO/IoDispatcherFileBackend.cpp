@@ -7,12 +7,40 @@
 #include "HAL/PlatformFilemanager.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "Compression/lz4.h"
+THIRD_PARTY_INCLUDES_END
 
 TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalBytesRead, TEXT("IoDispatcher/TotalBytesRead"));
 TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalBytesScattered, TEXT("IoDispatcher/TotalBytesScattered"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheHitsCold, TEXT("IoDispatcher/CacheHitsCold"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheHitsHot, TEXT("IoDispatcher/CacheHitsHot"));
 TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheMisses, TEXT("IoDispatcher/CacheMisses"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheHitsGhost, TEXT("IoDispatcher/CacheHitsGhost"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheEvictions, TEXT("IoDispatcher/CacheEvictions"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherCacheRecentUsage, TEXT("IoDispatcher/CacheRecentUsage"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherCacheFrequentUsage, TEXT("IoDispatcher/CacheFrequentUsage"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherMappedReads, TEXT("IoDispatcher/MappedReads"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherTotalBytesMapped, TEXT("IoDispatcher/TotalBytesMapped"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherMergedReads, TEXT("IoDispatcher/MergedReads"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherMergedBlocks, TEXT("IoDispatcher/MergedBlocks"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDecompressedBlocks, TEXT("IoDispatcher/DecompressedBlocks"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDecompressionQueueDepth, TEXT("IoDispatcher/DecompressionQueueDepth"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDecompressionTasks, TEXT("IoDispatcher/DecompressionTasks"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDecompressionTimeUs, TEXT("IoDispatcher/DecompressionTimeUs"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherScatterTimeUs, TEXT("IoDispatcher/ScatterTimeUs"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDeferredFlushes, TEXT("IoDispatcher/DeferredFlushes"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCompressedCacheHits, TEXT("IoDispatcher/CompressedCacheHits"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCompressedCacheInserts, TEXT("IoDispatcher/CompressedCacheInserts"));
+TRACE_DECLARE_MEMORY_COUNTER(IoDispatcherCompressedCacheUsage, TEXT("IoDispatcher/CompressedCacheUsage"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCacheHitRatePercent, TEXT("IoDispatcher/CacheHitRatePercent"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherCompressedCacheHitRatePercent, TEXT("IoDispatcher/CompressedCacheHitRatePercent"));
 
 //PRAGMA_DISABLE_OPTIMIZATION
 
@@ -30,6 +58,58 @@ static FAutoConsoleVariableRef CVar_IoDispatcherCacheSizeMB(
 	TEXT("IoDispatcher cache size (in megabytes).")
 );
 
+int32 GIoDispatcherCacheRecentPercent = 25;
+static FAutoConsoleVariableRef CVar_IoDispatcherCacheRecentPercent(
+	TEXT("s.IoDispatcherCacheRecentPercent"),
+	GIoDispatcherCacheRecentPercent,
+	TEXT("Share of the IoDispatcher cache (in percent) kept for blocks that have only been read once.")
+);
+
+int32 GIoDispatcherCacheGhostPercent = 50;
+static FAutoConsoleVariableRef CVar_IoDispatcherCacheGhostPercent(
+	TEXT("s.IoDispatcherCacheGhostPercent"),
+	GIoDispatcherCacheGhostPercent,
+	TEXT("Number of evicted blocks the IoDispatcher cache remembers, in percent of the number of blocks that fit in the cache.")
+);
+
+int32 GIoDispatcherCompressedCacheSizeMB = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherCompressedCacheSizeMB(
+	TEXT("s.IoDispatcherCompressedCacheSizeMB"),
+	GIoDispatcherCompressedCacheSizeMB,
+	TEXT("Size of the secondary IoDispatcher cache tier (in megabytes), which keeps evicted blocks LZ4 compressed so reading them again only costs an uncompress. 0 disables it.")
+);
+
+int32 GIoDispatcherCacheEvictionScanDepth = 8;
+static FAutoConsoleVariableRef CVar_IoDispatcherCacheEvictionScanDepth(
+	TEXT("s.IoDispatcherCacheEvictionScanDepth"),
+	GIoDispatcherCacheEvictionScanDepth,
+	TEXT("Number of the oldest blocks considered on eviction, the one read with the lowest priority is evicted first.")
+);
+
+int32 GIoDispatcherMaxMergedReadSizeKB = 2048;
+static FAutoConsoleVariableRef CVar_IoDispatcherMaxMergedReadSizeKB(
+	TEXT("s.IoDispatcherMaxMergedReadSizeKB"),
+	GIoDispatcherMaxMergedReadSizeKB,
+	TEXT("Adjacent cache blocks are read with a single read of up to this size (in kilobytes). 0 reads every block separately.")
+);
+
+int32 GIoDispatcherDecompressionWorkerCount = 4;
+static FAutoConsoleVariableRef CVar_IoDispatcherDecompressionWorkerCount(
+	TEXT("s.IoDispatcherDecompressionWorkerCount"),
+	GIoDispatcherDecompressionWorkerCount,
+	TEXT("Number of task graph tasks decompressing IoDispatcher blocks at once. 0 decompresses on the IoDispatcher thread.")
+);
+
+int32 GIoDispatcherMaxDecompressionQueueDepth = 32;
+static FAutoConsoleVariableRef CVar_IoDispatcherMaxDecompressionQueueDepth(
+	TEXT("s.IoDispatcherMaxDecompressionQueueDepth"),
+	GIoDispatcherMaxDecompressionQueueDepth,
+	TEXT("No new reads are issued while this many IoDispatcher blocks are waiting to be decompressed, so reading can't run ahead of decompression.")
+);
+
+// Upper bound of the blocks one decompression task takes, so they can be uncompressed in a batch
+static constexpr int32 GIoDispatcherMaxBlocksPerDecompressionTask = 16;
+
 FFileIoStoreReader::FFileIoStoreReader(FFileIoStoreImpl& InPlatformImpl)
 	: PlatformImpl(InPlatformImpl)
 {
@@ -52,10 +132,19 @@ FIoStatus FFileIoStoreReader::Initialize(const FIoStoreEnvironment& Environment)
 	{
 		return FIoStatusBuilder(EIoErrorCode::FileOpenFailed) << TEXT("Failed to open IoStore container file '") << *ContainerFilePath << TEXT("'");
 	}
+	MappedContainerPath = *ContainerFilePath;
 
-	TUniquePtr<uint8[]> TocBuffer;
-	bool bTocReadOk = false;
-
+	// The TOC is used as it is on disk, mapped if the platform can map files
+	const uint8* TocData = nullptr;
+	int64 TocSize = 0;
+	MappedTocHandle.Reset(Ipf.OpenMapped(*TocFilePath));
+	if (MappedTocHandle)
+	{
+		TocSize = MappedTocHandle->GetFileSize();
+		MappedTocRegion.Reset(TocSize >= int64(sizeof(FIoStoreTocHeader)) ? MappedTocHandle->MapRegion(0, TocSize) : nullptr);
+		TocData = MappedTocRegion ? MappedTocRegion->GetMappedPtr() : nullptr;
+	}
+	if (!TocData)
 	{
 		TUniquePtr<IFileHandle>	TocFileHandle(Ipf.OpenRead(*TocFilePath, /* allowwrite */ false));
 
@@ -64,17 +153,17 @@ FIoStatus FFileIoStoreReader::Initialize(const FIoStoreEnvironment& Environment)
 			return FIoStatusBuilder(EIoErrorCode::FileOpenFailed) << TEXT("Failed to open IoStore TOC file '") << *TocFilePath << TEXT("'");
 		}
 
-		const int64 TocSize = TocFileHandle->Size();
+		TocSize = TocFileHandle->Size();
 		TocBuffer = MakeUnique<uint8[]>(TocSize);
-		bTocReadOk = TocFileHandle->Read(TocBuffer.Get(), TocSize);
+		TocData = TocSize >= int64(sizeof(FIoStoreTocHeader)) && TocFileHandle->Read(TocBuffer.Get(), TocSize) ? TocBuffer.Get() : nullptr;
 	}
 
-	if (!bTocReadOk)
+	if (!TocData)
 	{
 		return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("Failed to read IoStore TOC file '") << *TocFilePath << TEXT("'");
 	}
 
-	const FIoStoreTocHeader* Header = reinterpret_cast<const FIoStoreTocHeader*>(TocBuffer.Get());
+	const FIoStoreTocHeader* Header = reinterpret_cast<const FIoStoreTocHeader*>(TocData);
 
 	if (!Header->CheckMagic())
 	{
@@ -91,33 +180,102 @@ FIoStatus FFileIoStoreReader::Initialize(const FIoStoreEnvironment& Environment)
 		return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC entry size mismatch while reading '") << *TocFilePath << TEXT("'");
 	}
 
-	const FIoStoreTocEntry* Entry = reinterpret_cast<const FIoStoreTocEntry*>(TocBuffer.Get() + sizeof(FIoStoreTocHeader));
+	if (Header->TocEntryCount && !Header->TocChunkPerfectHashSeedCount)
+	{
+		return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC has no chunk perfect hash, the container must be rebuilt: '") << *TocFilePath << TEXT("'");
+	}
+
+	// Sizes of the sections, in 64 bits so that corrupt counts can't wrap around
+	const uint64 EntriesSize = uint64(Header->TocEntryCount) * sizeof(FIoStoreTocEntry);
+	const uint64 CompressedBlocksSize = Header->CompressionBlockSize ? uint64(Header->TocCompressedBlockEntryCount) * sizeof(FIoStoreTocCompressedBlockEntry) : 0;
+	const uint64 MethodNamesSize = Header->CompressionBlockSize ? uint64(Header->CompressionMethodNameCount) * Header->CompressionMethodNameLength : 0;
+	const uint64 DictionarySize = Header->CompressionBlockSize ? Header->CompressionDictionarySize : 0;
+	const uint64 PerfectHashOffset = Align(sizeof(FIoStoreTocHeader) + EntriesSize + CompressedBlocksSize + MethodNamesSize + DictionarySize, alignof(int32));
+	const uint64 PerfectHashSize = (uint64(Header->TocChunkPerfectHashSeedCount) + Header->TocChunkWithoutPerfectHashCount) * sizeof(int32);
+	if (PerfectHashOffset + PerfectHashSize > uint64(TocSize))
+	{
+		return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC is smaller than its sections while reading '") << *TocFilePath << TEXT("'");
+	}
+
+	const FIoStoreTocEntry* Entry = reinterpret_cast<const FIoStoreTocEntry*>(TocData + sizeof(FIoStoreTocHeader));
 	uint32 EntryCount = Header->TocEntryCount;
+	TocEntries = MakeArrayView(Entry, EntryCount);
+	const int32* PerfectHash = reinterpret_cast<const int32*>(TocData + PerfectHashOffset);
+	TocPerfectHashSeeds = MakeArrayView(PerfectHash, Header->TocChunkPerfectHashSeedCount);
+	TocEntriesWithoutPerfectHash = MakeArrayView(PerfectHash + Header->TocChunkPerfectHashSeedCount, Header->TocChunkWithoutPerfectHashCount);
 
-	Toc.Reserve(EntryCount);
-	while (EntryCount--)
+	if (Header->CompressionBlockSize)
 	{
-		if ((Entry->GetOffset() + Entry->GetLength()) > ContainerFileSize)
+		if (Header->TocCompressedBlockEntrySize != sizeof(FIoStoreTocCompressedBlockEntry))
 		{
-			// TODO: add details
-			return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC entry out of container bounds while reading '") << *TocFilePath << TEXT("'");
+			return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC compressed block entry size mismatch while reading '") << *TocFilePath << TEXT("'");
 		}
 
-		Toc.Add(Entry->ChunkId, Entry->OffsetAndLength);
-		++Entry;
+		const FIoStoreTocCompressedBlockEntry* BlockEntry = reinterpret_cast<const FIoStoreTocCompressedBlockEntry*>(Entry + EntryCount);
+		CompressedBlocks = MakeArrayView(BlockEntry, Header->TocCompressedBlockEntryCount);
+		const ANSICHAR* MethodName = reinterpret_cast<const ANSICHAR*>(BlockEntry + Header->TocCompressedBlockEntryCount);
+		for (uint32 MethodIndex = 0; MethodIndex < Header->CompressionMethodNameCount; ++MethodIndex)
+		{
+			CompressionMethods.Add(FName(FString(FCStringAnsi::Strnlen(MethodName, Header->CompressionMethodNameLength), MethodName)));
+			MethodName += Header->CompressionMethodNameLength;
+		}
+
+		if (Header->CompressionDictionarySize)
+		{
+			const uint8* Dictionary = reinterpret_cast<const uint8*>(MethodName);
+			if (CompressionMethods.Num() != 1)
+			{
+				return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC compression dictionary out of bounds while reading '") << *TocFilePath << TEXT("'");
+			}
+			CompressionDictionary = FCompression::CreateDictionary(CompressionMethods[0], MakeArrayView(Dictionary, Header->CompressionDictionarySize));
+			if (!CompressionDictionary)
+			{
+				return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("Failed to load the TOC compression dictionary while reading '") << *TocFilePath << TEXT("'");
+			}
+		}
+
+		for (const FIoStoreTocCompressedBlockEntry& Block : CompressedBlocks)
+		{
+			if (Block.GetOffset() + Block.GetCompressedSize() > ContainerFileSize ||
+				Block.GetCompressionMethodIndex() > CompressionMethods.Num() ||
+				Block.GetUncompressedSize() > Header->CompressionBlockSize)
+			{
+				return FIoStatusBuilder(EIoErrorCode::CorruptToc) << TEXT("TOC compressed block out of container bounds while reading '") << *TocFilePath << TEXT("'");
+			}
+		}
+		CompressionBlockSize = Header->CompressionBlockSize;
 	}
+	ContainerDataSize = IsCompressed() ? CompressedBlocks.Num() * CompressionBlockSize : ContainerFileSize;
 
+	// Entries are only checked against the container bounds when they are looked up, so that mounting doesn't touch every page of the TOC
 	return FIoStatus::Ok;
 }
 
+const FIoOffsetAndLength* FFileIoStoreReader::FindTocEntry(const FIoChunkId& ChunkId) const
+{
+	const int32 EntryIndex = FIoStoreTocPerfectHash::Find(ChunkId, TocEntries, TocPerfectHashSeeds, TocEntriesWithoutPerfectHash);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FIoStoreTocEntry& Entry = TocEntries[EntryIndex];
+	if (Entry.GetOffset() + Entry.GetLength() > ContainerDataSize)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("TOC entry %d out of container bounds in '%s'"), EntryIndex, *MappedContainerPath);
+		return nullptr;
+	}
+	return &Entry.OffsetAndLength;
+}
+
 bool FFileIoStoreReader::DoesChunkExist(const FIoChunkId& ChunkId) const
 {
-	return Toc.Find(ChunkId) != nullptr;
+	return FindTocEntry(ChunkId) != nullptr;
 }
 
 TIoStatusOr<uint64> FFileIoStoreReader::GetSizeForChunk(const FIoChunkId& ChunkId) const
 {
-	const FIoOffsetAndLength* OffsetAndLength = Toc.Find(ChunkId);
+	const FIoOffsetAndLength* OffsetAndLength = FindTocEntry(ChunkId);
 
 	if (OffsetAndLength != nullptr)
 	{
@@ -131,7 +289,7 @@ TIoStatusOr<uint64> FFileIoStoreReader::GetSizeForChunk(const FIoChunkId& ChunkI
 
 bool FFileIoStoreReader::Resolve(FFileIoStoreResolvedRequest& ResolvedRequest)
 {
-	const FIoOffsetAndLength* OffsetAndLength = Toc.Find(ResolvedRequest.Request->ChunkId);
+	const FIoOffsetAndLength* OffsetAndLength = FindTocEntry(ResolvedRequest.Request->ChunkId);
 
 	if (!OffsetAndLength)
 	{
@@ -153,12 +311,60 @@ bool FFileIoStoreReader::Resolve(FFileIoStoreResolvedRequest& ResolvedRequest)
 	return true;
 }
 
+bool FFileIoStoreReader::MapResolvedRequest(FFileIoStoreResolvedRequest& ResolvedRequest)
+{
+	if (!MappedFileHandle)
+	{
+		if (bMappingFailed)
+		{
+			return false;
+		}
+		MappedFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*MappedContainerPath));
+		if (!MappedFileHandle)
+		{
+			UE_LOG(LogIoDispatcher, Log, TEXT("Memory mapping isn't supported for '%s', mapped reads are copied"), *MappedContainerPath);
+			bMappingFailed = true;
+			return false;
+		}
+	}
+
+	// Container chunks are stored uncompressed, so the mapped range is the chunk data as is
+	IMappedFileRegion* MappedRegion = MappedFileHandle->MapRegion(ResolvedRequest.ResolvedOffset, ResolvedRequest.ResolvedSize);
+	if (!MappedRegion)
+	{
+		return false;
+	}
+	check(uint64(MappedRegion->GetMappedSize()) == ResolvedRequest.ResolvedSize);
+	ResolvedRequest.Request->IoBuffer = FIoBuffer(FIoBuffer::AssumeOwnership, MappedRegion);
+	return true;
+}
+
 FFileIoStore::FFileIoStore(FIoDispatcherEventQueue& InEventQueue)
-	: PlatformImpl(InEventQueue)
+	: EventQueue(InEventQueue)
+	, PlatformImpl(InEventQueue)
 	, CacheBlockSize(GIoDispatcherBlockSizeKB > 0 ? uint64(GIoDispatcherBlockSizeKB) << 10 : 256 << 10)
 {
-	LruHead.LruNext = &LruTail;
-	LruTail.LruPrev = &LruHead;
+}
+
+FFileIoStore::~FFileIoStore()
+{
+	// Decompression tasks reference this until they have handed their blocks back
+	for (;;)
+	{
+		{
+			FScopeLock _(&DecompressedBlocksCritical);
+			if (NumFinishedDecompressionTasks == NumDecompressionTasks)
+			{
+				break;
+			}
+		}
+		FPlatformProcess::Sleep(0);
+	}
+
+	while (CompressedBlocksHead)
+	{
+		RemoveFromCompressedCache(CompressedBlocksHead);
+	}
 }
 
 FIoStatus FFileIoStore::Mount(const FIoStoreEnvironment& Environment)
@@ -185,11 +391,26 @@ EIoStoreResolveResult FFileIoStore::Resolve(FIoRequestImpl* Request)
 			Request->UnfinishedReadsCount = 0;
 			if (ResolvedRequest.ResolvedSize > 0)
 			{
+				if (EnumHasAnyFlags(Request->Options.GetFlags(), EIoReadOptionsFlags::MemoryMapped) &&
+					!Request->Options.GetTargetVa() &&
+					!Reader->IsCompressed() &&
+					Reader->MapResolvedRequest(ResolvedRequest))
+				{
+					TRACE_COUNTER_INCREMENT(IoDispatcherMappedReads);
+					TRACE_COUNTER_ADD(IoDispatcherTotalBytesMapped, ResolvedRequest.ResolvedSize);
+					return IoStoreResolveResult_OK;
+				}
 				if (void* TargetVa = Request->Options.GetTargetVa())
 				{
 					ResolvedRequest.Request->IoBuffer = FIoBuffer(FIoBuffer::Wrap, TargetVa, ResolvedRequest.ResolvedSize);
 				}
 				PlatformImpl.BeginReadsForRequest(ResolvedRequest);
+				if (Reader->IsCompressed())
+				{
+					ReadCompressedBlocks(*Reader, ResolvedRequest);
+					PlatformImpl.EndReadsForRequest();
+					return IoStoreResolveResult_OK;
+				}
 				const uint32 RequestBeginBlockIndex = (uint32)(ResolvedRequest.ResolvedOffset / CacheBlockSize);
 				const uint32 RequestEndBlockIndex = (uint32)((ResolvedRequest.ResolvedOffset + ResolvedRequest.ResolvedSize - 1) / CacheBlockSize + 1);
 				const uint32 BlockCount = RequestEndBlockIndex - RequestBeginBlockIndex;
@@ -251,17 +472,214 @@ bool FFileIoStore::IsValidEnvironment(const FIoStoreEnvironment& Environment)
 bool FFileIoStore::ProcessCompletedBlock()
 {
 	const uint64 CacheMemorySize = GIoDispatcherCacheSizeMB > 0 ? uint64(GIoDispatcherCacheSizeMB) << 20 : 0;
+	if (CollectDecompressedBlocks(CacheMemorySize))
+	{
+		return true;
+	}
 	FFileIoStoreReadBlock* CompletedBlock = PlatformImpl.GetNextCompletedBlock();
 	if (!CompletedBlock)
 	{
 		return false;
 	}
+	TRACE_COUNTER_ADD(IoDispatcherTotalBytesRead, CompletedBlock->Size);
+	if (CompletedBlock->CompressionMethod != NAME_None && GIoDispatcherDecompressionWorkerCount > 0 &&
+		FPlatformProcess::SupportsMultithreading() && FTaskGraphInterface::IsRunning())
+	{
+		// Decompressing here would hold up the completion of every other read
+		QueueBlockForDecompression(CompletedBlock);
+	}
+	else if (CompletedBlock->MergedHead)
+	{
+		// the merged read itself isn't cached, the blocks it filled each keep a reference to its buffer
+		check(!CompletedBlock->LruPrev);
+		FFileIoStoreReadBlock* MergedBlock = CompletedBlock->MergedHead;
+		while (MergedBlock)
+		{
+			FFileIoStoreReadBlock* NextMergedBlock = MergedBlock->MergedNext;
+			MergedBlock->MergedNext = nullptr;
+			FinalizeCompletedBlock(MergedBlock, CacheMemorySize);
+			MergedBlock = NextMergedBlock;
+		}
+		delete CompletedBlock;
+	}
+	else
+	{
+		FinalizeCompletedBlock(CompletedBlock, CacheMemorySize);
+	}
+	return true;
+}
+
+void FFileIoStore::QueueBlockForDecompression(FFileIoStoreReadBlock* Block)
+{
+	Block->Next = nullptr;
+	if (!DecompressionQueueTail)
+	{
+		DecompressionQueueHead = DecompressionQueueTail = Block;
+	}
+	else
+	{
+		DecompressionQueueTail->Next = Block;
+		DecompressionQueueTail = Block;
+	}
+	++DecompressionQueueDepth;
+	++NumBlocksInDecompression;
+	StartDecompressionTasks();
+}
+
+void FFileIoStore::StartDecompressionTasks()
+{
+	const int32 MaxTasks = FMath::Max(GIoDispatcherDecompressionWorkerCount, 1);
+	while (DecompressionQueueHead && NumDecompressionTasks < MaxTasks)
+	{
+		// Share the queue between the tasks that can still be started rather than handing it all to the first one
+		const int32 BlockCount = FMath::Clamp(FMath::DivideAndRoundUp(DecompressionQueueDepth, MaxTasks - NumDecompressionTasks), 1, GIoDispatcherMaxBlocksPerDecompressionTask);
+		TArray<FFileIoStoreReadBlock*, TInlineAllocator<GIoDispatcherMaxBlocksPerDecompressionTask>> Blocks;
+		while (DecompressionQueueHead && Blocks.Num() < BlockCount)
+		{
+			Blocks.Add(DecompressionQueueHead);
+			DecompressionQueueHead = DecompressionQueueHead->Next;
+			--DecompressionQueueDepth;
+		}
+		if (!DecompressionQueueHead)
+		{
+			DecompressionQueueTail = nullptr;
+		}
+
+		++NumDecompressionTasks;
+		FFunctionGraphTask::CreateAndDispatchWhenReady([this, Blocks = MoveTemp(Blocks)]()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(IoDispatcherDecompressBlocks);
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			UncompressBlocks(Blocks);
+			const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+			// Notifying while holding the lock means the store can't be destroyed before this is done with it
+			FScopeLock _(&DecompressedBlocksCritical);
+			DecompressedBlocks.Append(Blocks);
+			DecompressionCycles += Cycles;
+			++NumFinishedDecompressionTasks;
+			EventQueue.Notify();
+		}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+	}
+	TRACE_COUNTER_SET(IoDispatcherDecompressionQueueDepth, DecompressionQueueDepth);
+	TRACE_COUNTER_SET(IoDispatcherDecompressionTasks, NumDecompressionTasks);
+}
+
+bool FFileIoStore::CollectDecompressedBlocks(uint64 CacheMemorySize)
+{
+	if (!NumDecompressionTasks)
+	{
+		return false;
+	}
+
+	TArray<FFileIoStoreReadBlock*> Blocks;
+	int32 FinishedTasks;
+	uint64 Cycles;
+	{
+		FScopeLock _(&DecompressedBlocksCritical);
+		if (!NumFinishedDecompressionTasks)
+		{
+			return false;
+		}
+		Swap(Blocks, DecompressedBlocks);
+		FinishedTasks = NumFinishedDecompressionTasks;
+		Cycles = DecompressionCycles;
+		NumFinishedDecompressionTasks = 0;
+		DecompressionCycles = 0;
+	}
+	NumDecompressionTasks -= FinishedTasks;
+	NumBlocksInDecompression -= Blocks.Num();
+	TRACE_COUNTER_ADD(IoDispatcherDecompressionTimeUs, int64(FPlatformTime::ToSeconds64(Cycles) * 1000000.0));
+
+	// Keep the workers busy while the blocks they handed back are scattered
+	StartDecompressionTasks();
+	for (FFileIoStoreReadBlock* Block : Blocks)
+	{
+		FinishDecompression(Block);
+		FinalizeCompletedBlock(Block, CacheMemorySize);
+	}
+	if (PendingReadBlocks.Num() && !IsDecompressionBackedUp())
+	{
+		FlushPendingReads();
+	}
+	return true;
+}
+
+bool FFileIoStore::IsDecompressionBackedUp() const
+{
+	return NumBlocksInDecompression >= FMath::Max(GIoDispatcherMaxDecompressionQueueDepth, 1);
+}
+
+void FFileIoStore::UncompressBlocks(TArrayView<FFileIoStoreReadBlock* const> Blocks)
+{
+	TArray<FFileIoStoreReadBlock*, TInlineAllocator<GIoDispatcherMaxBlocksPerDecompressionTask>> BatchedBlocks;
+	TArray<FCompression::FUncompressBlock, TInlineAllocator<GIoDispatcherMaxBlocksPerDecompressionTask>> UncompressBatch;
+	auto UncompressBatchedBlocks = [&BatchedBlocks, &UncompressBatch]()
+	{
+		if (BatchedBlocks.Num())
+		{
+			// Blocks uncompressed together can be interleaved by the format
+			FCompression::UncompressMemoryBatch(BatchedBlocks[0]->CompressionMethod, UncompressBatch);
+			for (int32 Index = 0; Index < BatchedBlocks.Num(); ++Index)
+			{
+				BatchedBlocks[Index]->bDecompressionFailed = !UncompressBatch[Index].bSucceeded;
+			}
+			BatchedBlocks.Reset();
+			UncompressBatch.Reset();
+		}
+	};
+
+	for (FFileIoStoreReadBlock* Block : Blocks)
+	{
+		check(Block->CompressionMethod != NAME_None);
+		Block->UncompressedBuffer = FIoBuffer(Block->UncompressedSize);
+		if (Block->CompressionDictionary)
+		{
+			Block->bDecompressionFailed = !Block->CompressionDictionary->Uncompress(Block->UncompressedBuffer.Data(), int32(Block->UncompressedSize), Block->Buffer.Data(), int32(Block->Size));
+			continue;
+		}
+		if (BatchedBlocks.Num() && BatchedBlocks[0]->CompressionMethod != Block->CompressionMethod)
+		{
+			UncompressBatchedBlocks();
+		}
+		BatchedBlocks.Add(Block);
+		UncompressBatch.Add({ Block->UncompressedBuffer.Data(), int32(Block->UncompressedSize), Block->Buffer.Data(), int32(Block->Size), false });
+	}
+	UncompressBatchedBlocks();
+}
+
+void FFileIoStore::FinishDecompression(FFileIoStoreReadBlock* Block)
+{
+	// The platform may have to recycle the buffer the block was read into, which is only done on this thread
+	PlatformImpl.ReleaseBlockBuffer(Block);
+	Block->Buffer = Block->UncompressedBuffer;
+	Block->UncompressedBuffer = FIoBuffer();
+	Block->CompressionMethod = NAME_None;
+	TRACE_COUNTER_INCREMENT(IoDispatcherDecompressedBlocks);
+	UE_CLOG(Block->bDecompressionFailed, LogIoDispatcher, Warning, TEXT("Failed to decompress block at offset %llu"), Block->Offset);
+}
+
+void FFileIoStore::FinalizeCompletedBlock(FFileIoStoreReadBlock* CompletedBlock, uint64 CacheMemorySize)
+{
 	check(!CompletedBlock->bIsReady);
 	CompletedBlock->bIsReady = true;
-	TRACE_COUNTER_ADD(IoDispatcherTotalBytesRead, CompletedBlock->Size);
+	if (CompletedBlock->CompressionMethod != NAME_None)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		UncompressBlocks(MakeArrayView(&CompletedBlock, 1));
+		TRACE_COUNTER_ADD(IoDispatcherDecompressionTimeUs, int64(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0));
+		FinishDecompression(CompletedBlock);
+	}
+
+	const uint64 ScatterStartCycles = FPlatformTime::Cycles64();
+	const bool bDecompressionFailed = CompletedBlock->bDecompressionFailed;
 	for (FFileIoStoreReadBlockScatter& Scatter : CompletedBlock->ScatterList)
 	{
-		if (Scatter.DstOffset != MAX_uint64)
+		if (bDecompressionFailed)
+		{
+			Scatter.Request->Status = FIoStatus(EIoErrorCode::ReadError, TEXT("Failed to decompress block"));
+		}
+		else if (Scatter.DstOffset != MAX_uint64)
 		{
 			FMemory::Memcpy(Scatter.Request->IoBuffer.Data() + Scatter.DstOffset, CompletedBlock->Buffer.Data() + Scatter.SrcOffset, Scatter.Size);
 		}
@@ -269,30 +687,219 @@ bool FFileIoStore::ProcessCompletedBlock()
 		check(Scatter.Request->UnfinishedReadsCount > 0);
 		--Scatter.Request->UnfinishedReadsCount;
 	}
+	TRACE_COUNTER_ADD(IoDispatcherScatterTimeUs, int64(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - ScatterStartCycles) * 1000000.0));
 	//CompletedBlock->ScatterList.Empty();
 
 	if (CompletedBlock->LruPrev)
 	{
 		CurrentCacheUsage += CompletedBlock->Size;
+		FFileIoStoreCacheQueue& Queue = CompletedBlock->bFrequent ? FrequentBlocks : RecentBlocks;
+		Queue.Usage += CompletedBlock->Size;
+		EvictCachedBlocks(CacheMemorySize);
+	}
+	else
+	{
+		PlatformImpl.ReleaseBlockBuffer(CompletedBlock);
+		delete CompletedBlock;
+	}
+}
+
+FFileIoStoreReadBlock* FFileIoStore::FindEvictionCandidate(FFileIoStoreCacheQueue& Queue)
+{
+	// Of the oldest few ready blocks evict the one that was read with the lowest priority, the oldest one on ties
+	FFileIoStoreReadBlock* Candidate = nullptr;
+	int32 ScanCount = FMath::Max(GIoDispatcherCacheEvictionScanDepth, 1);
+	for (FFileIoStoreReadBlock* Block = Queue.Tail.LruPrev; Block != &Queue.Head && ScanCount > 0; Block = Block->LruPrev)
+	{
+		if (!Block->bIsReady)
+		{
+			continue;
+		}
+		if (!Candidate || Block->Priority < Candidate->Priority)
+		{
+			Candidate = Block;
+		}
+		--ScanCount;
+	}
+	return Candidate;
+}
+
+void FFileIoStore::EvictBlock(FFileIoStoreReadBlock* Block, uint64 CacheMemorySize)
+{
+	FFileIoStoreCacheQueue::Unlink(Block);
+	FFileIoStoreCacheQueue& Queue = Block->bFrequent ? FrequentBlocks : RecentBlocks;
+	Queue.Usage -= Block->Size;
+	CurrentCacheUsage -= Block->Size;
+	CachedBlocksMap.Remove(Block->Key);
 
-		FFileIoStoreReadBlock* EvictionCandidate = LruTail.LruPrev;
-		while (CurrentCacheUsage > CacheMemorySize && EvictionCandidate != &LruHead && EvictionCandidate->bIsReady)
+	if (!Block->bFrequent)
+	{
+		const int32 GhostCapacity = int32(((CacheMemorySize / CacheBlockSize) * FMath::Clamp(GIoDispatcherCacheGhostPercent, 0, 1000)) / 100);
+		if (GhostCapacity > 0)
+		{
+			const uint64 Sequence = GhostSequence++;
+			if (GhostKeys.Num() < GhostCapacity)
+			{
+				GhostKeys.Emplace(Block->Key, Sequence);
+			}
+			else
+			{
+				// Forget the oldest ghost unless its key has been remembered again since
+				TPair<FFileIoStoreCacheBlockKey, uint64>& OldestGhost = GhostKeys[Sequence % GhostKeys.Num()];
+				const uint64* OldestSequence = GhostKeysMap.Find(OldestGhost.Key);
+				if (OldestSequence && *OldestSequence == OldestGhost.Value)
+				{
+					GhostKeysMap.Remove(OldestGhost.Key);
+				}
+				OldestGhost = TPair<FFileIoStoreCacheBlockKey, uint64>(Block->Key, Sequence);
+			}
+			GhostKeysMap.Add(Block->Key, Sequence);
+		}
+	}
+
+	TRACE_COUNTER_INCREMENT(IoDispatcherCacheEvictions);
+	AddToCompressedCache(Block);
+	PlatformImpl.ReleaseBlockBuffer(Block);
+	delete Block;
+}
+
+void FFileIoStore::EvictCachedBlocks(uint64 CacheMemorySize)
+{
+	const uint64 RecentTargetSize = (CacheMemorySize * FMath::Clamp(GIoDispatcherCacheRecentPercent, 0, 100)) / 100;
+	while (CurrentCacheUsage > CacheMemorySize)
+	{
+		// Blocks that were only read once go first while they use more than their share
+		FFileIoStoreReadBlock* EvictionCandidate = nullptr;
+		if (RecentBlocks.Usage > RecentTargetSize || FrequentBlocks.IsEmpty())
+		{
+			EvictionCandidate = FindEvictionCandidate(RecentBlocks);
+		}
+		if (!EvictionCandidate)
+		{
+			EvictionCandidate = FindEvictionCandidate(FrequentBlocks);
+		}
+		if (!EvictionCandidate)
 		{
-			FFileIoStoreReadBlock* NextEvictionCandidate = EvictionCandidate->LruPrev;
-			EvictionCandidate->LruNext->LruPrev = EvictionCandidate->LruPrev;
-			EvictionCandidate->LruPrev->LruNext = EvictionCandidate->LruNext;
-			CurrentCacheUsage -= EvictionCandidate->Size;
-			CachedBlocksMap.Remove(EvictionCandidate->Key);
-			delete EvictionCandidate;
-			EvictionCandidate = NextEvictionCandidate;
+			EvictionCandidate = FindEvictionCandidate(RecentBlocks);
 		}
+		if (!EvictionCandidate)
+		{
+			// Everything is still waiting to be read
+			break;
+		}
+		EvictBlock(EvictionCandidate, CacheMemorySize);
+	}
+	TRACE_COUNTER_SET(IoDispatcherCacheRecentUsage, RecentBlocks.Usage);
+	TRACE_COUNTER_SET(IoDispatcherCacheFrequentUsage, FrequentBlocks.Usage);
+}
+
+void FFileIoStore::AddToCompressedCache(const FFileIoStoreReadBlock* Block)
+{
+	const uint64 CompressedCacheMemorySize = GIoDispatcherCompressedCacheSizeMB > 0 ? uint64(GIoDispatcherCompressedCacheSizeMB) << 20 : 0;
+	if (!CompressedCacheMemorySize || Block->bDecompressionFailed || Block->Buffer.DataSize() != Block->Size || Block->Size > MAX_int32)
+	{
+		return;
+	}
+
+	// Blocks that don't get smaller would only take room from ones that do, LZ4 gives up on them when the output doesn't fit
+	const int32 UncompressedSize = int32(Block->Size);
+	CompressionScratchBuffer.SetNumUninitialized(UncompressedSize - 1, false);
+	const int32 CompressedSize = LZ4_compress_default((const char*)Block->Buffer.Data(), (char*)CompressionScratchBuffer.GetData(), UncompressedSize, CompressionScratchBuffer.Num());
+	if (CompressedSize <= 0 || uint64(CompressedSize) > CompressedCacheMemorySize)
+	{
+		return;
+	}
+
+	if (FFileIoStoreCompressedCacheEntry* StaleEntry = CompressedBlocksMap.FindRef(Block->Key))
+	{
+		RemoveFromCompressedCache(StaleEntry);
+	}
+	FFileIoStoreCompressedCacheEntry* Entry = new FFileIoStoreCompressedCacheEntry();
+	Entry->Key = Block->Key;
+	Entry->CompressedData.Append(CompressionScratchBuffer.GetData(), CompressedSize);
+	Entry->UncompressedSize = Block->Size;
+	Entry->Next = CompressedBlocksHead;
+	if (CompressedBlocksHead)
+	{
+		CompressedBlocksHead->Prev = Entry;
 	}
 	else
 	{
-		CachedBlocksMap.Remove(CompletedBlock->Key);
-		delete CompletedBlock;
+		CompressedBlocksTail = Entry;
 	}
-	return true;
+	CompressedBlocksHead = Entry;
+	CompressedBlocksMap.Add(Entry->Key, Entry);
+	CompressedCacheUsage += CompressedSize;
+	TRACE_COUNTER_INCREMENT(IoDispatcherCompressedCacheInserts);
+
+	while (CompressedCacheUsage > CompressedCacheMemorySize)
+	{
+		RemoveFromCompressedCache(CompressedBlocksTail);
+	}
+	TRACE_COUNTER_SET(IoDispatcherCompressedCacheUsage, CompressedCacheUsage);
+}
+
+bool FFileIoStore::TakeFromCompressedCache(FFileIoStoreReadBlock* Block)
+{
+	if (!CompressedBlocksHead)
+	{
+		return false;
+	}
+	++CompressedCacheLookupCount;
+	FFileIoStoreCompressedCacheEntry* Entry = CompressedBlocksMap.FindRef(Block->Key);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	// Whether or not it uncompresses, the copy won't be needed again: the block is either cached again or read from disk
+	bool bUncompressed = false;
+	if (Entry->UncompressedSize == Block->Size)
+	{
+		Block->Buffer = FIoBuffer(Block->Size);
+		bUncompressed = LZ4_decompress_safe((const char*)Entry->CompressedData.GetData(), (char*)Block->Buffer.Data(), Entry->CompressedData.Num(), int32(Block->Size)) == int32(Block->Size);
+		if (!bUncompressed)
+		{
+			Block->Buffer = FIoBuffer();
+		}
+	}
+	RemoveFromCompressedCache(Entry);
+	TRACE_COUNTER_SET(IoDispatcherCompressedCacheUsage, CompressedCacheUsage);
+	if (bUncompressed)
+	{
+		++CompressedCacheHitCount;
+		TRACE_COUNTER_INCREMENT(IoDispatcherCompressedCacheHits);
+	}
+	return bUncompressed;
+}
+
+void FFileIoStore::RemoveFromCompressedCache(FFileIoStoreCompressedCacheEntry* Entry)
+{
+	if (Entry->Prev)
+	{
+		Entry->Prev->Next = Entry->Next;
+	}
+	else
+	{
+		CompressedBlocksHead = Entry->Next;
+	}
+	if (Entry->Next)
+	{
+		Entry->Next->Prev = Entry->Prev;
+	}
+	else
+	{
+		CompressedBlocksTail = Entry->Prev;
+	}
+	CompressedBlocksMap.Remove(Entry->Key);
+	CompressedCacheUsage -= Entry->CompressedData.Num();
+	delete Entry;
+}
+
+void FFileIoStore::TraceCacheHitRates()
+{
+	TRACE_COUNTER_SET(IoDispatcherCacheHitRatePercent, CacheLookupCount ? int64((CacheHitCount * 100) / CacheLookupCount) : 0);
+	TRACE_COUNTER_SET(IoDispatcherCompressedCacheHitRatePercent, CompressedCacheLookupCount ? int64((CompressedCacheHitCount * 100) / CompressedCacheLookupCount) : 0);
 }
 
 void FFileIoStore::ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolvedRequest& ResolvedRequest)
@@ -302,6 +909,8 @@ void FFileIoStore::ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolved
 	Key.BlockIndex = BlockIndex;
 	uint64 BlockOffset = uint64(BlockIndex) * uint64(CacheBlockSize);
 	FFileIoStoreReadBlock* CachedBlock = CachedBlocksMap.FindRef(Key);
+	bool bEvictAfterScatter = false;
+	++CacheLookupCount;
 	if (!CachedBlock)
 	{
 		uint64 ReadSize = FMath::Min(ResolvedRequest.ResolvedFileSize, BlockOffset + CacheBlockSize) - BlockOffset;
@@ -313,11 +922,36 @@ void FFileIoStore::ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolved
 		CachedBlock->Size = ReadSize;
 		CachedBlocksMap.Add(CachedBlock->Key, CachedBlock);
 
-		PlatformImpl.ReadBlockFromFile(CachedBlock);
-		TRACE_COUNTER_INCREMENT(IoDispatcherCacheMisses);
+		if (GhostKeysMap.Remove(Key))
+		{
+			// Evicted from the recent queue and needed again, worth keeping around
+			CachedBlock->bFrequent = true;
+			FrequentBlocks.AddFirst(CachedBlock);
+			TRACE_COUNTER_INCREMENT(IoDispatcherCacheHitsGhost);
+		}
+		else
+		{
+			RecentBlocks.AddFirst(CachedBlock);
+		}
+
+		if (TakeFromCompressedCache(CachedBlock))
+		{
+			// Ready right away, eviction waits until this request has copied from it
+			CachedBlock->bIsReady = true;
+			CurrentCacheUsage += CachedBlock->Size;
+			FFileIoStoreCacheQueue& Queue = CachedBlock->bFrequent ? FrequentBlocks : RecentBlocks;
+			Queue.Usage += CachedBlock->Size;
+			bEvictAfterScatter = true;
+		}
+		else
+		{
+			PendingReadBlocks.Add(CachedBlock);
+			TRACE_COUNTER_INCREMENT(IoDispatcherCacheMisses);
+		}
 	}
 	else
 	{
+		++CacheHitCount;
 		if (CachedBlock->bIsReady)
 		{
 			TRACE_COUNTER_INCREMENT(IoDispatcherCacheHitsHot);
@@ -326,19 +960,16 @@ void FFileIoStore::ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolved
 		{
 			TRACE_COUNTER_INCREMENT(IoDispatcherCacheHitsCold);
 		}
-	}
 
-	if (CachedBlock->LruPrev)
-	{
-		check(CachedBlock->LruNext);
-		CachedBlock->LruPrev->LruNext = CachedBlock->LruNext;
-		CachedBlock->LruNext->LruPrev = CachedBlock->LruPrev;
+		// Hits in the recent queue are left alone, they usually are neighbouring reads of the same scan
+		if (CachedBlock->bFrequent)
+		{
+			FFileIoStoreCacheQueue::Unlink(CachedBlock);
+			FrequentBlocks.AddFirst(CachedBlock);
+		}
 	}
-
-	CachedBlock->LruNext = LruHead.LruNext;
-	CachedBlock->LruPrev = &LruHead;
-	LruHead.LruNext->LruPrev = CachedBlock;
-	LruHead.LruNext = CachedBlock;
+	CachedBlock->Priority = FMath::Max(CachedBlock->Priority, ResolvedRequest.Request->Options.GetPriority());
+	CachedBlock->Deadline = FMath::Min(CachedBlock->Deadline, ResolvedRequest.Request->Options.GetDeadline());
 
 	uint64 RequestStartOffsetInBlock = FMath::Max<int64>(0, int64(ResolvedRequest.ResolvedOffset) - BlockOffset);
 	uint64 RequestEndOffsetInBlock = FMath::Min<uint64>(CacheBlockSize, ResolvedRequest.ResolvedOffset + ResolvedRequest.ResolvedSize - BlockOffset);
@@ -362,6 +993,12 @@ void FFileIoStore::ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolved
 		check(RequestSizeInBlock <= TNumericLimits<uint32>::Max());
 		Scatter.Size = (uint32)RequestSizeInBlock;
 	}
+
+	if (bEvictAfterScatter)
+	{
+		EvictCachedBlocks(GIoDispatcherCacheSizeMB > 0 ? uint64(GIoDispatcherCacheSizeMB) << 20 : 0);
+	}
+	TraceCacheHitRates();
 }
 
 void FFileIoStore::ReadBlocksUncached(uint32 BeginBlockIndex, uint32 BlockCount, FFileIoStoreResolvedRequest& ResolvedRequest)
@@ -384,5 +1021,142 @@ void FFileIoStore::ReadBlocksUncached(uint32 BeginBlockIndex, uint32 BlockCount,
 	Scatter.DstOffset = MAX_uint64;
 	Scatter.SrcOffset = MAX_uint64;
 	Scatter.Size = ReadSize;
-	PlatformImpl.ReadBlockFromFile(UncachedBlock);
+	UncachedBlock->Priority = ResolvedRequest.Request->Options.GetPriority();
+	UncachedBlock->Deadline = ResolvedRequest.Request->Options.GetDeadline();
+	PendingReadBlocks.Add(UncachedBlock);
+}
+
+void FFileIoStore::ReadCompressedBlocks(const FFileIoStoreReader& Reader, FFileIoStoreResolvedRequest& ResolvedRequest)
+{
+	// Compressed blocks can't be read partially, each one touched by the request is read and decompressed as a whole
+	const uint64 BlockSize = Reader.GetCompressionBlockSize();
+	const uint64 RequestEndOffset = ResolvedRequest.ResolvedOffset + ResolvedRequest.ResolvedSize;
+	const int32 BeginBlockIndex = int32(ResolvedRequest.ResolvedOffset / BlockSize);
+	const int32 EndBlockIndex = int32((RequestEndOffset - 1) / BlockSize + 1);
+	for (int32 BlockIndex = BeginBlockIndex; BlockIndex < EndBlockIndex; ++BlockIndex)
+	{
+		const FIoStoreTocCompressedBlockEntry& CompressedBlock = Reader.GetCompressedBlock(BlockIndex);
+		const uint64 BlockOffset = BlockIndex * BlockSize;
+
+		FFileIoStoreReadBlock* UncachedBlock = new FFileIoStoreReadBlock();
+		UncachedBlock->Offset = CompressedBlock.GetOffset();
+		UncachedBlock->Size = CompressedBlock.GetCompressedSize();
+		UncachedBlock->Key.FileHandle = ResolvedRequest.ResolvedFileHandle;
+		UncachedBlock->Key.BlockIndex = BlockIndex;
+		UncachedBlock->CompressionMethod = Reader.GetCompressionMethod(CompressedBlock);
+		UncachedBlock->CompressionDictionary = UncachedBlock->CompressionMethod != NAME_None ? Reader.GetCompressionDictionary() : nullptr;
+		UncachedBlock->UncompressedSize = CompressedBlock.GetUncompressedSize();
+		UncachedBlock->Priority = ResolvedRequest.Request->Options.GetPriority();
+		UncachedBlock->Deadline = ResolvedRequest.Request->Options.GetDeadline();
+
+		const uint64 RequestStartOffsetInBlock = FMath::Max(ResolvedRequest.ResolvedOffset, BlockOffset) - BlockOffset;
+		const uint64 RequestEndOffsetInBlock = FMath::Min(RequestEndOffset, BlockOffset + BlockSize) - BlockOffset;
+		check(RequestEndOffsetInBlock <= CompressedBlock.GetUncompressedSize());
+
+		++ResolvedRequest.Request->UnfinishedReadsCount;
+		FFileIoStoreReadBlockScatter& Scatter = UncachedBlock->ScatterList.AddDefaulted_GetRef();
+		Scatter.Request = ResolvedRequest.Request;
+		Scatter.DstOffset = BlockOffset + RequestStartOffsetInBlock - ResolvedRequest.ResolvedOffset;
+		Scatter.SrcOffset = RequestStartOffsetInBlock;
+		Scatter.Size = RequestEndOffsetInBlock - RequestStartOffsetInBlock;
+		PendingReadBlocks.Add(UncachedBlock);
+	}
+}
+
+void FFileIoStore::FlushPendingReads()
+{
+	if (PendingReadBlocks.Num() == 0)
+	{
+		return;
+	}
+	if (IsDecompressionBackedUp())
+	{
+		// Issued by CollectDecompressedBlocks once the decompression stage has drained
+		TRACE_COUNTER_INCREMENT(IoDispatcherDeferredFlushes);
+		return;
+	}
+
+	PendingReadBlocks.Sort([](const FFileIoStoreReadBlock& A, const FFileIoStoreReadBlock& B)
+	{
+		if (A.Key.FileHandle != B.Key.FileHandle)
+		{
+			return A.Key.FileHandle < B.Key.FileHandle;
+		}
+		return A.Offset < B.Offset;
+	});
+
+	// Blocks that read straight into the destination buffer are never merged, they are large reads already.
+	// Cache blocks own their memory, so runs of adjacent ones are read into one buffer that they then reference.
+	const uint64 MaxMergedReadSize = GIoDispatcherMaxMergedReadSizeKB > 0 ? uint64(GIoDispatcherMaxMergedReadSizeKB) << 10 : 0;
+	TArray<FFileIoStoreReadBlock*, TInlineAllocator<64>> ReadsToIssue;
+	const int32 PendingCount = PendingReadBlocks.Num();
+	for (int32 RunBegin = 0; RunBegin < PendingCount;)
+	{
+		FFileIoStoreReadBlock* FirstBlock = PendingReadBlocks[RunBegin];
+		int32 RunEnd = RunBegin + 1;
+		uint64 RunSize = FirstBlock->Size;
+		int32 RunPriority = FirstBlock->Priority;
+		uint64 RunDeadline = FirstBlock->Deadline;
+		if (FirstBlock->LruPrev)
+		{
+			while (RunEnd < PendingCount)
+			{
+				const FFileIoStoreReadBlock* PrevBlock = PendingReadBlocks[RunEnd - 1];
+				const FFileIoStoreReadBlock* NextBlock = PendingReadBlocks[RunEnd];
+				if (!NextBlock->LruPrev ||
+					NextBlock->Key.FileHandle != FirstBlock->Key.FileHandle ||
+					NextBlock->Offset != PrevBlock->Offset + PrevBlock->Size ||
+					RunSize + NextBlock->Size > MaxMergedReadSize)
+				{
+					break;
+				}
+				RunSize += NextBlock->Size;
+				RunPriority = FMath::Max(RunPriority, NextBlock->Priority);
+				RunDeadline = FMath::Min(RunDeadline, NextBlock->Deadline);
+				++RunEnd;
+			}
+		}
+
+		if (RunEnd - RunBegin == 1)
+		{
+			ReadsToIssue.Add(FirstBlock);
+		}
+		else
+		{
+			FFileIoStoreReadBlock* MergedRead = new FFileIoStoreReadBlock();
+			MergedRead->Key = FirstBlock->Key;
+			MergedRead->Offset = FirstBlock->Offset;
+			MergedRead->Size = RunSize;
+			MergedRead->Priority = RunPriority;
+			MergedRead->Deadline = RunDeadline;
+			MergedRead->Buffer = FIoBuffer(RunSize);
+			FFileIoStoreReadBlock** MergedTail = &MergedRead->MergedHead;
+			for (int32 Index = RunBegin; Index < RunEnd; ++Index)
+			{
+				FFileIoStoreReadBlock* Block = PendingReadBlocks[Index];
+				Block->Buffer = FIoBuffer(MergedRead->Buffer.Data() + (Block->Offset - MergedRead->Offset), Block->Size, MergedRead->Buffer);
+				*MergedTail = Block;
+				MergedTail = &Block->MergedNext;
+			}
+			TRACE_COUNTER_INCREMENT(IoDispatcherMergedReads);
+			TRACE_COUNTER_ADD(IoDispatcherMergedBlocks, RunEnd - RunBegin);
+			ReadsToIssue.Add(MergedRead);
+		}
+		RunBegin = RunEnd;
+	}
+	PendingReadBlocks.Reset();
+
+	// the order within a container is kept so the reads stay sequential when priorities and deadlines are equal
+	ReadsToIssue.StableSort([](const FFileIoStoreReadBlock& A, const FFileIoStoreReadBlock& B)
+	{
+		if (A.Priority != B.Priority)
+		{
+			return A.Priority > B.Priority;
+		}
+		return A.Deadline < B.Deadline;
+	});
+	for (FFileIoStoreReadBlock* Read : ReadsToIssue)
+	{
+		PlatformImpl.ReadBlockFromFile(Read);
+	}
 }
@@ -5,7 +5,12 @@
 #include"IO/IoDispatcherPrivate.h"
 #include "IO/IoStore.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Containers/Map.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+#include "Misc/ICompressionFormat.h"
 
 struct FFileIoStoreCacheBlockKey
 {
@@ -36,12 +41,75 @@ struct FFileIoStoreReadBlock
 	FFileIoStoreReadBlock* Next = nullptr;
 	FFileIoStoreReadBlock* LruPrev = nullptr;
 	FFileIoStoreReadBlock* LruNext = nullptr;
+	// For a merged read: the adjacent cache blocks it fills, linked through MergedNext. Their buffers are views into this block's buffer
+	FFileIoStoreReadBlock* MergedHead = nullptr;
+	FFileIoStoreReadBlock* MergedNext = nullptr;
 	FFileIoStoreCacheBlockKey Key;
 	FIoBuffer Buffer;
 	uint64 Size = 0;
 	uint64 Offset = 0;
 	TArray<FFileIoStoreReadBlockScatter> ScatterList;
+	// Blocks of compressed containers are read compressed and decompressed into a buffer of UncompressedSize
+	FName CompressionMethod = NAME_None;
+	// Owned by the reader of the container, set if its compressed blocks use a dictionary
+	ICompressionDictionary* CompressionDictionary = nullptr;
+	uint32 UncompressedSize = 0;
+	// Filled by the decompression stage, which may run off the IoDispatcher thread, and swapped in for Buffer back on it
+	FIoBuffer UncompressedBuffer;
+	bool bDecompressionFailed = false;
+	// Highest priority of the requests that used this block
+	int32 Priority = MIN_int32;
+	// Earliest deadline of the requests that used this block, reads of equal priority are issued earliest deadline first
+	uint64 Deadline = MAX_uint64;
 	bool bIsReady = false;
+	// Cached blocks referenced again after being evicted from the recent queue live in the frequent queue
+	bool bFrequent = false;
+};
+
+/** Intrusive list of cached blocks, most recently inserted or used first */
+struct FFileIoStoreCacheQueue
+{
+	FFileIoStoreCacheQueue()
+	{
+		Head.LruNext = &Tail;
+		Tail.LruPrev = &Head;
+	}
+
+	void AddFirst(FFileIoStoreReadBlock* Block)
+	{
+		Block->LruNext = Head.LruNext;
+		Block->LruPrev = &Head;
+		Head.LruNext->LruPrev = Block;
+		Head.LruNext = Block;
+	}
+
+	static void Unlink(FFileIoStoreReadBlock* Block)
+	{
+		check(Block->LruPrev && Block->LruNext);
+		Block->LruPrev->LruNext = Block->LruNext;
+		Block->LruNext->LruPrev = Block->LruPrev;
+		Block->LruPrev = Block->LruNext = nullptr;
+	}
+
+	bool IsEmpty() const
+	{
+		return Head.LruNext == &Tail;
+	}
+
+	FFileIoStoreReadBlock Head;
+	FFileIoStoreReadBlock Tail;
+	// Size of the ready blocks in the queue
+	uint64 Usage = 0;
+};
+
+/** Block evicted from the cache that is kept LZ4 compressed in the secondary tier, linked newest first */
+struct FFileIoStoreCompressedCacheEntry
+{
+	FFileIoStoreCompressedCacheEntry* Prev = nullptr;
+	FFileIoStoreCompressedCacheEntry* Next = nullptr;
+	FFileIoStoreCacheBlockKey Key;
+	TArray<uint8> CompressedData;
+	uint64 UncompressedSize = 0;
 };
 
 struct FFileIoStoreResolvedRequest
@@ -61,39 +129,150 @@ public:
 	bool DoesChunkExist(const FIoChunkId& ChunkId) const;
 	TIoStatusOr<uint64> GetSizeForChunk(const FIoChunkId& ChunkId) const;
 	bool Resolve(FFileIoStoreResolvedRequest& ResolvedRequest);
+	/** Points the request's buffer at a mapping of the resolved range, returns false if the platform can't map the container */
+	bool MapResolvedRequest(FFileIoStoreResolvedRequest& ResolvedRequest);
+
+	bool IsCompressed() const
+	{
+		return CompressionBlockSize != 0;
+	}
+
+	uint64 GetCompressionBlockSize() const
+	{
+		return CompressionBlockSize;
+	}
+
+	const FIoStoreTocCompressedBlockEntry& GetCompressedBlock(int32 BlockIndex) const
+	{
+		return CompressedBlocks[BlockIndex];
+	}
+
+	/** Name of the method the block was compressed with, NAME_None for blocks stored as is */
+	FName GetCompressionMethod(const FIoStoreTocCompressedBlockEntry& Block) const
+	{
+		const uint8 MethodIndex = Block.GetCompressionMethodIndex();
+		return MethodIndex ? CompressionMethods[MethodIndex - 1] : NAME_None;
+	}
+
+	/** Dictionary the compressed blocks use, null if they don't use one */
+	ICompressionDictionary* GetCompressionDictionary() const
+	{
+		return CompressionDictionary.Get();
+	}
 
 private:
 	FFileIoStoreImpl& PlatformImpl;
 
-	TMap<FIoChunkId, FIoOffsetAndLength> Toc;
+	/** Finds the entry of a chunk through the perfect hash in the TOC, null if there is none or it is out of bounds */
+	const FIoOffsetAndLength* FindTocEntry(const FIoChunkId& ChunkId) const;
+
+	// The TOC as it is on disk, mapped if the platform can map files and read into TocBuffer otherwise. The views point into it.
+	TUniquePtr<IMappedFileHandle> MappedTocHandle;
+	TUniquePtr<IMappedFileRegion> MappedTocRegion;
+	TUniquePtr<uint8[]> TocBuffer;
+	TArrayView<const FIoStoreTocEntry> TocEntries;
+	TArrayView<const int32> TocPerfectHashSeeds;
+	TArrayView<const int32> TocEntriesWithoutPerfectHash;
+	// Chunk offsets of compressed containers are in the uncompressed stream, which is split into blocks of CompressionBlockSize
+	TArrayView<const FIoStoreTocCompressedBlockEntry> CompressedBlocks;
+	uint64 ContainerDataSize = 0;
+	TArray<FName> CompressionMethods;
+	TUniquePtr<ICompressionDictionary> CompressionDictionary;
+	uint64 CompressionBlockSize = 0;
+	FString MappedContainerPath;
 	uint64 ContainerFileHandle;
 	uint64 ContainerFileSize;
+	// Opened on the first mapped read, the regions mapped from it must not outlive the reader
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	bool bMappingFailed = false;
 };
 
 class FFileIoStore
 {
 public:
 	FFileIoStore(FIoDispatcherEventQueue& InEventQueue);
+	~FFileIoStore();
 	FIoStatus Mount(const FIoStoreEnvironment& Environment);
 	EIoStoreResolveResult Resolve(FIoRequestImpl* Request);
 	bool DoesChunkExist(const FIoChunkId& ChunkId) const;
 	TIoStatusOr<uint64> GetSizeForChunk(const FIoChunkId& ChunkId) const;
+
+	/**
+	 * Moves one completed read, or the blocks handed back by a decompression task, to the next stage of the pipeline:
+	 * compressed blocks are queued for decompression on task graph workers, everything else is scattered to its requests.
+	 * Returns false if there was nothing to do.
+	 */
 	bool ProcessCompletedBlock();
 
+	/**
+	 * Issues the reads for everything resolved since the last call, sorted by container and offset with adjacent cache blocks merged into single reads.
+	 * Nothing is issued while too many blocks are waiting to be decompressed, the reads are issued once the decompression stage has caught up.
+	 */
+	void FlushPendingReads();
+
 	static bool IsValidEnvironment(const FIoStoreEnvironment& Environment);
 
 private:
 	void InitCache();
 	void ReadBlockCached(uint32 BlockIndex, const FFileIoStoreResolvedRequest& ResolvedRequest);
 	void ReadBlocksUncached(uint32 BeginBlockIndex, uint32 BlockCount, FFileIoStoreResolvedRequest& ResolvedRequest);
+	void ReadCompressedBlocks(const FFileIoStoreReader& Reader, FFileIoStoreResolvedRequest& ResolvedRequest);
+	void QueueBlockForDecompression(FFileIoStoreReadBlock* Block);
+	void StartDecompressionTasks();
+	bool CollectDecompressedBlocks(uint64 CacheMemorySize);
+	bool IsDecompressionBackedUp() const;
+	/** Uncompresses the blocks into their UncompressedBuffer, batching those that share a compression method. Safe to call from any thread. */
+	static void UncompressBlocks(TArrayView<FFileIoStoreReadBlock* const> Blocks);
+	void FinishDecompression(FFileIoStoreReadBlock* Block);
+	void FinalizeCompletedBlock(FFileIoStoreReadBlock* CompletedBlock, uint64 CacheMemorySize);
+	FFileIoStoreReadBlock* FindEvictionCandidate(FFileIoStoreCacheQueue& Queue);
+	void EvictBlock(FFileIoStoreReadBlock* Block, uint64 CacheMemorySize);
+	void EvictCachedBlocks(uint64 CacheMemorySize);
+	/** Keeps a compressed copy of a block that is being evicted, if the secondary tier is enabled and the block compresses */
+	void AddToCompressedCache(const FFileIoStoreReadBlock* Block);
+	/** Uncompresses the secondary tier copy of the block into its buffer and drops the copy, returns false if there is none */
+	bool TakeFromCompressedCache(FFileIoStoreReadBlock* Block);
+	void RemoveFromCompressedCache(FFileIoStoreCompressedCacheEntry* Entry);
+	void TraceCacheHitRates();
 
+	FIoDispatcherEventQueue& EventQueue;
 	FFileIoStoreImpl PlatformImpl;
 
 	mutable FRWLock IoStoreReadersLock;
 	TArray<FFileIoStoreReader*> IoStoreReaders;
 	TMap<FFileIoStoreCacheBlockKey, FFileIoStoreReadBlock*> CachedBlocksMap;
-	FFileIoStoreReadBlock LruHead;
-	FFileIoStoreReadBlock LruTail;
+	// 2Q: blocks start in the recent FIFO, the keys of the ones evicted from it are remembered in the ghost list
+	// and a block that is read again while its key is there goes to the frequent LRU, so large scans can't flush hot blocks
+	FFileIoStoreCacheQueue RecentBlocks;
+	FFileIoStoreCacheQueue FrequentBlocks;
+	TMap<FFileIoStoreCacheBlockKey, uint64> GhostKeysMap;
+	TArray<TPair<FFileIoStoreCacheBlockKey, uint64>> GhostKeys;
+	uint64 GhostSequence = 0;
+	TArray<FFileIoStoreReadBlock*> PendingReadBlocks;
 	const uint64 CacheBlockSize;
 	uint64 CurrentCacheUsage = 0;
+	// Secondary tier: evicted blocks kept LZ4 compressed, a hit costs an uncompress instead of a read. The oldest are dropped first.
+	TMap<FFileIoStoreCacheBlockKey, FFileIoStoreCompressedCacheEntry*> CompressedBlocksMap;
+	FFileIoStoreCompressedCacheEntry* CompressedBlocksHead = nullptr;
+	FFileIoStoreCompressedCacheEntry* CompressedBlocksTail = nullptr;
+	uint64 CompressedCacheUsage = 0;
+	TArray<uint8> CompressionScratchBuffer;
+	// Lookups and hits of both tiers, the secondary tier is only looked up on misses of the first
+	uint64 CacheLookupCount = 0;
+	uint64 CacheHitCount = 0;
+	uint64 CompressedCacheLookupCount = 0;
+	uint64 CompressedCacheHitCount = 0;
+
+	// Compressed blocks waiting for a decompression task, linked through Next
+	FFileIoStoreReadBlock* DecompressionQueueHead = nullptr;
+	FFileIoStoreReadBlock* DecompressionQueueTail = nullptr;
+	int32 DecompressionQueueDepth = 0;
+	// Blocks queued or being decompressed, and the tasks started, that haven't been collected yet
+	int32 NumBlocksInDecompression = 0;
+	int32 NumDecompressionTasks = 0;
+	// Handed back by the decompression tasks
+	FCriticalSection DecompressedBlocksCritical;
+	TArray<FFileIoStoreReadBlock*> DecompressedBlocks;
+	int32 NumFinishedDecompressionTasks = 0;
+	uint64 DecompressionCycles = 0;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "IO/IoDispatcher.h"
+#include "Templates/Atomic.h"
 
 #ifndef PLATFORM_IMPLEMENTS_IO
 #define PLATFORM_IMPLEMENTS_IO 0
@@ -42,5 +43,12 @@ public:
 	FIoBuffer IoBuffer;
 	uint32 UnfinishedReadsCount;
 	TFunction<void(TIoStatusOr<FIoBuffer>)> Callback;
+	// Set by FIoBatch::Cancel from any thread, the dispatcher thread completes the request if it is still queued
+	TAtomic<bool> bCancelled { false };
+	// Bytes counted against the in-flight budget once the request is dispatched
+	uint64 DispatchedSize = 0;
+	uint64 IssueCycles = 0;
+	// Issue order, keeps requests of equal priority and deadline first in first out
+	uint64 Sequence = 0;
 };
 
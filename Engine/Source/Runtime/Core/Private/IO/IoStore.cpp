@@ -1,9 +1,18 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "IO/IoStore.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/BitArray.h"
 #include "Containers/Map.h"
+#include "HAL/Event.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/Compression.h"
+#include "Misc/ICompressionFormat.h"
+#include "Misc/ScopeLock.h"
 #include "Templates/UniquePtr.h"
+#include "Templates/Atomic.h"
 #include "Misc/Paths.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -30,14 +39,54 @@ void FIoStoreEnvironment::InitializeFileEnvironment(FStringView InPath)
 
 class FIoStoreWriterImpl
 {
+	/** Block of a compressed container on its way to the container file */
+	struct FPendingBlock
+	{
+		// View into the appended chunk
+		FIoBuffer UncompressedData;
+		TArray<uint8> CompressedData;
+		uint8 CompressionMethodIndex = 0;
+		bool bIsReady = false;
+	};
+
 public:
 	FIoStoreWriterImpl(FIoStoreEnvironment& InEnvironment)
 	:	Environment(InEnvironment)
+	,	BlockWrittenEvent(FPlatformProcess::GetSynchEventFromPool())
+	{
+	}
+
+	~FIoStoreWriterImpl()
 	{
+		WaitForPendingBlocks();
+		FPlatformProcess::ReturnSynchEventToPool(BlockWrittenEvent);
 	}
 
-	FIoStatus Initialize()
+	FIoStatus Initialize(const FIoStoreWriterSettings& InSettings)
 	{
+		if (InSettings.CompressionMethod != NAME_None)
+		{
+			if (!FCompression::IsFormatValid(InSettings.CompressionMethod))
+			{
+				return FIoStatusBuilder(EIoErrorCode::InvalidParameter) << TEXT("Unknown compression method '") << *InSettings.CompressionMethod.ToString() << TEXT("'");
+			}
+			if (InSettings.CompressionBlockSize == 0 || InSettings.CompressionBlockSize >= (1ull << FIoStoreTocCompressedBlockEntry::SizeBits))
+			{
+				return FIoStatus(EIoErrorCode::InvalidParameter, TEXT("CompressionBlockSize must be between 1 byte and 16MB"));
+			}
+			if (InSettings.CompressionDictionary.Num())
+			{
+				CompressionDictionary = FCompression::CreateDictionary(InSettings.CompressionMethod, InSettings.CompressionDictionary);
+				if (!CompressionDictionary)
+				{
+					return FIoStatusBuilder(EIoErrorCode::InvalidParameter) << TEXT("Compression method '") << *InSettings.CompressionMethod.ToString() << TEXT("' could not load the compression dictionary");
+				}
+			}
+		}
+		Settings = InSettings;
+		Settings.MaxPendingBlocks = FMath::Max(Settings.MaxPendingBlocks, 1);
+		PendingBlockSlots.SetNumZeroed(Settings.MaxPendingBlocks);
+
 		IPlatformFile& Ipf = IPlatformFile::GetPlatformPhysical();
 
 		FString TocFilePath = Environment.GetPath() + TEXT(".utoc");
@@ -78,6 +127,8 @@ public:
 
 	UE_NODISCARD FIoStatus Append(FIoChunkId ChunkId, FIoBuffer Chunk, const TCHAR* Name)
 	{
+		FScopeLock AppendLock(&AppendCritical);
+
 		if (!ContainerFileHandle)
 		{
 			return FIoStatus(EIoErrorCode::FileNotOpen, TEXT("No container file to append to"));
@@ -93,6 +144,11 @@ public:
 			return FIoStatus(EIoErrorCode::InvalidParameter, TEXT("ChunkId is already mapped"));
 		}
 
+		if (Settings.CompressionMethod != NAME_None)
+		{
+			return AppendCompressed(ChunkId, Chunk, Name);
+		}
+
 		FIoStoreTocEntry TocEntry;
 
 		check(ContainerFileHandle->Tell() % IoChunkAlignment == 0);
@@ -115,13 +171,7 @@ public:
 		if (Success)
 		{
 			Toc.Add(ChunkId, TocEntry);
-
-			if (CsvArchive)
-			{
-				ANSICHAR Line[MAX_SPRINTF];
-				FCStringAnsi::Sprintf(Line, "%s,%lld,%lld\n", TCHAR_TO_ANSI(Name), TocEntry.GetOffset(), TocEntry.GetLength());
-				CsvArchive->Serialize(Line, FCStringAnsi::Strlen(Line));
-			}
+			WriteCsvLine(Name, TocEntry);
 
 			return FIoStatus::Ok;
 		}
@@ -135,6 +185,8 @@ public:
 	{
 		//TODO: Does RelativeOffset + Length overflow?
 
+		FScopeLock AppendLock(&AppendCritical);
+
 		const FIoStoreTocEntry* Entry = Toc.Find(OriginalChunkId);
 		if (Entry == nullptr)
 		{
@@ -171,40 +223,360 @@ public:
 
 	UE_NODISCARD FIoStatus FlushMetadata()
 	{
+		FScopeLock AppendLock(&AppendCritical);
+
+		WaitForPendingBlocks();
+
+		if (bBlockWriteFailed)
+		{
+			return FIoStatus(EIoErrorCode::WriteError, TEXT("Block write failed"));
+		}
+
 		TocFileHandle->Seek(0);
 
 		FIoStoreTocHeader TocHeader;
 		FMemory::Memset(TocHeader, 0);
 
+		TArray<FIoStoreTocEntry> TocEntries;
+		TocEntries.Reserve(Toc.Num());
+		for (auto& _: Toc)
+		{
+			TocEntries.Add(_.Value);
+		}
+		TArray<int32> PerfectHashSeeds;
+		TArray<int32> EntriesWithoutPerfectHash;
+		BuildPerfectHash(TocEntries, PerfectHashSeeds, EntriesWithoutPerfectHash);
+
 		TocHeader.MakeMagic();
 		TocHeader.TocHeaderSize = sizeof TocHeader;
-		TocHeader.TocEntryCount = Toc.Num();
+		TocHeader.TocEntryCount = TocEntries.Num();
 		TocHeader.TocEntrySize = sizeof(FIoStoreTocEntry);
+		TocHeader.TocChunkPerfectHashSeedCount = PerfectHashSeeds.Num();
+		TocHeader.TocChunkWithoutPerfectHashCount = EntriesWithoutPerfectHash.Num();
+
+		if (Settings.CompressionMethod != NAME_None)
+		{
+			TocHeader.TocCompressedBlockEntryCount = CompressedBlocks.Num();
+			TocHeader.TocCompressedBlockEntrySize = sizeof(FIoStoreTocCompressedBlockEntry);
+			TocHeader.CompressionMethodNameCount = 1;
+			TocHeader.CompressionMethodNameLength = CompressionMethodNameLength;
+			TocHeader.CompressionBlockSize = uint32(Settings.CompressionBlockSize);
+			TocHeader.CompressionDictionarySize = CompressionDictionary ? Settings.CompressionDictionary.Num() : 0;
+		}
 
-		const bool Success = TocFileHandle->Write(reinterpret_cast<const uint8*>(&TocHeader), sizeof TocHeader);
+		bool Success = TocFileHandle->Write(reinterpret_cast<const uint8*>(&TocHeader), sizeof TocHeader);
 
 		if (!Success)
 		{
 			return FIoStatus(EIoErrorCode::WriteError, TEXT("TOC write failed"));
 		}
 
-		for (auto& _: Toc)
+		Success &= TocFileHandle->Write(reinterpret_cast<const uint8*>(TocEntries.GetData()), TocEntries.Num() * sizeof(FIoStoreTocEntry));
+
+		if (Settings.CompressionMethod != NAME_None)
 		{
-			FIoStoreTocEntry& TocEntry = _.Value;
-			
-			TocFileHandle->Write(reinterpret_cast<const uint8*>(&TocEntry), sizeof TocEntry);
+			Success &= TocFileHandle->Write(reinterpret_cast<const uint8*>(CompressedBlocks.GetData()), CompressedBlocks.Num() * sizeof(FIoStoreTocCompressedBlockEntry));
+
+			ANSICHAR MethodName[CompressionMethodNameLength] = {};
+			FCStringAnsi::Strncpy(MethodName, TCHAR_TO_ANSI(*Settings.CompressionMethod.ToString()), CompressionMethodNameLength);
+			Success &= TocFileHandle->Write(reinterpret_cast<const uint8*>(MethodName), CompressionMethodNameLength);
+			if (CompressionDictionary)
+			{
+				Success &= TocFileHandle->Write(Settings.CompressionDictionary.GetData(), Settings.CompressionDictionary.Num());
+			}
+
+			if (!Success)
+			{
+				return FIoStatus(EIoErrorCode::WriteError, TEXT("TOC compressed block write failed"));
+			}
+		}
+
+		// The perfect hash starts on an int32 boundary so that readers can use it where the TOC is mapped
+		if (uint32 UnalignedBytes = uint32(TocFileHandle->Tell() % alignof(int32)))
+		{
+			static constexpr uint8 Zeroes[alignof(int32)] = {};
+			Success &= TocFileHandle->Write(Zeroes, alignof(int32) - UnalignedBytes);
+		}
+		Success &= TocFileHandle->Write(reinterpret_cast<const uint8*>(PerfectHashSeeds.GetData()), PerfectHashSeeds.Num() * sizeof(int32));
+		Success &= TocFileHandle->Write(reinterpret_cast<const uint8*>(EntriesWithoutPerfectHash.GetData()), EntriesWithoutPerfectHash.Num() * sizeof(int32));
+		if (!Success)
+		{
+			return FIoStatus(EIoErrorCode::WriteError, TEXT("TOC write failed"));
 		}
 
 		return FIoStatus::Ok;
 	}
 
 private:
+	static constexpr uint32 CompressionMethodNameLength = 32;
+
+	/** Seeds tried for a bucket before its entries are left to the sorted list of entries without a perfect hash */
+	static constexpr int32 MaxPerfectHashSeedAttempts = 1 << 16;
+
+	/** Reorders the entries so that FIoStoreTocPerfectHash finds them, see there for what the seeds mean */
+	static void BuildPerfectHash(TArray<FIoStoreTocEntry>& Entries, TArray<int32>& OutSeeds, TArray<int32>& OutEntriesWithoutPerfectHash)
+	{
+		const int32 EntryCount = Entries.Num();
+		if (EntryCount == 0)
+		{
+			return;
+		}
+
+		// Two entries per bucket on average, the largest buckets pick their seeds first while most entries are still free
+		const int32 SeedCount = FMath::Max(1, EntryCount / 2);
+		TArray<TArray<int32>> Buckets;
+		Buckets.SetNum(SeedCount);
+		for (int32 EntryIndex = 0; EntryIndex < EntryCount; ++EntryIndex)
+		{
+			Buckets[int32(FIoStoreTocPerfectHash::HashChunkId(Entries[EntryIndex].ChunkId, 0) % uint32(SeedCount))].Add(EntryIndex);
+		}
+		TArray<int32> BucketOrder;
+		BucketOrder.SetNumUninitialized(SeedCount);
+		for (int32 BucketIndex = 0; BucketIndex < SeedCount; ++BucketIndex)
+		{
+			BucketOrder[BucketIndex] = BucketIndex;
+		}
+		BucketOrder.Sort([&Buckets](int32 A, int32 B) { return Buckets[A].Num() > Buckets[B].Num(); });
+
+		OutSeeds.SetNumZeroed(SeedCount);
+		TArray<int32> SlotEntries;
+		SlotEntries.Init(INDEX_NONE, EntryCount);
+		TArray<int32> UnplacedEntries;
+		TArray<int32, TInlineAllocator<16>> BucketSlots;
+		int32 NextFreeSlot = 0;
+		for (int32 BucketIndex : BucketOrder)
+		{
+			const TArray<int32>& Bucket = Buckets[BucketIndex];
+			if (Bucket.Num() == 0)
+			{
+				break;
+			}
+
+			if (Bucket.Num() == 1)
+			{
+				while (SlotEntries[NextFreeSlot] != INDEX_NONE)
+				{
+					++NextFreeSlot;
+				}
+				SlotEntries[NextFreeSlot] = Bucket[0];
+				OutSeeds[BucketIndex] = -NextFreeSlot - 1;
+				continue;
+			}
+
+			bool bPlaced = false;
+			for (int32 Seed = 1; Seed <= MaxPerfectHashSeedAttempts && !bPlaced; ++Seed)
+			{
+				BucketSlots.Reset();
+				bPlaced = true;
+				for (int32 EntryIndex : Bucket)
+				{
+					const int32 Slot = int32(FIoStoreTocPerfectHash::HashChunkId(Entries[EntryIndex].ChunkId, Seed) % uint32(EntryCount));
+					if (SlotEntries[Slot] != INDEX_NONE || BucketSlots.Contains(Slot))
+					{
+						bPlaced = false;
+						break;
+					}
+					BucketSlots.Add(Slot);
+				}
+				if (bPlaced)
+				{
+					for (int32 Index = 0; Index < Bucket.Num(); ++Index)
+					{
+						SlotEntries[BucketSlots[Index]] = Bucket[Index];
+					}
+					OutSeeds[BucketIndex] = Seed;
+				}
+			}
+			if (!bPlaced)
+			{
+				UnplacedEntries.Append(Bucket);
+			}
+		}
+
+		// Entries of buckets without a seed take the slots that are left, and are found by binary search
+		for (int32 EntryIndex : UnplacedEntries)
+		{
+			while (SlotEntries[NextFreeSlot] != INDEX_NONE)
+			{
+				++NextFreeSlot;
+			}
+			SlotEntries[NextFreeSlot] = EntryIndex;
+			OutEntriesWithoutPerfectHash.Add(NextFreeSlot);
+		}
+
+		TArray<FIoStoreTocEntry> SortedEntries;
+		SortedEntries.Reserve(EntryCount);
+		for (int32 EntryIndex : SlotEntries)
+		{
+			SortedEntries.Add(Entries[EntryIndex]);
+		}
+		Entries = MoveTemp(SortedEntries);
+		OutEntriesWithoutPerfectHash.Sort([&Entries](int32 A, int32 B)
+		{
+			return FIoStoreTocPerfectHash::CompareChunkIds(Entries[A].ChunkId, Entries[B].ChunkId) < 0;
+		});
+	}
+
+	void WriteCsvLine(const TCHAR* Name, const FIoStoreTocEntry& TocEntry)
+	{
+		if (CsvArchive)
+		{
+			ANSICHAR Line[MAX_SPRINTF];
+			FCStringAnsi::Sprintf(Line, "%s,%lld,%lld\n", TCHAR_TO_ANSI(Name), TocEntry.GetOffset(), TocEntry.GetLength());
+			CsvArchive->Serialize(Line, FCStringAnsi::Strlen(Line));
+		}
+	}
+
+	/** Splits the chunk into blocks that are compressed on the task graph, the caller must hold AppendCritical */
+	FIoStatus AppendCompressed(FIoChunkId ChunkId, FIoBuffer Chunk, const TCHAR* Name)
+	{
+		// Chunks of compressed containers are addressed in the uncompressed stream and start on a block boundary
+		const uint64 BlockSize = Settings.CompressionBlockSize;
+		FIoStoreTocEntry TocEntry;
+		TocEntry.SetOffset(NextUncompressedOffset);
+		TocEntry.SetLength(Chunk.DataSize());
+		TocEntry.ChunkId = ChunkId;
+		NextUncompressedOffset += Align(Chunk.DataSize(), BlockSize);
+
+		IsMetadataDirty = true;
+		Toc.Add(ChunkId, TocEntry);
+		WriteCsvLine(Name, TocEntry);
+
+		// The blocks are processed after we return
+		Chunk.EnsureOwned();
+
+		for (uint64 BlockOffset = 0; BlockOffset < Chunk.DataSize(); BlockOffset += BlockSize)
+		{
+			while (PendingBlockCount.GetValue() >= Settings.MaxPendingBlocks)
+			{
+				BlockWrittenEvent->Wait();
+			}
+			if (bBlockWriteFailed)
+			{
+				return FIoStatus(EIoErrorCode::WriteError, TEXT("Block write failed"));
+			}
+
+			FPendingBlock* Block = new FPendingBlock();
+			Block->UncompressedData = Chunk.Slice(BlockOffset, FMath::Min(BlockSize, Chunk.DataSize() - BlockOffset));
+			{
+				FScopeLock WriteLock(&WriteCritical);
+				PendingBlockSlots[NextBlockSequence % PendingBlockSlots.Num()] = Block;
+				++NextBlockSequence;
+			}
+			PendingBlockCount.Increment();
+
+			if (FTaskGraphInterface::IsRunning())
+			{
+				FFunctionGraphTask::CreateAndDispatchWhenReady([this, Block]()
+				{
+					CompressBlock(*Block);
+					OnBlockCompressed(*Block);
+				}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+			}
+			else
+			{
+				CompressBlock(*Block);
+				OnBlockCompressed(*Block);
+			}
+		}
+
+		return FIoStatus::Ok;
+	}
+
+	void CompressBlock(FPendingBlock& Block) const
+	{
+		const int32 UncompressedSize = int32(Block.UncompressedData.DataSize());
+		int32 CompressedSize = FCompression::CompressMemoryBound(Settings.CompressionMethod, UncompressedSize);
+		Block.CompressedData.SetNumUninitialized(CompressedSize);
+		const bool bCompressed = CompressionDictionary
+			? CompressionDictionary->Compress(Block.CompressedData.GetData(), CompressedSize, Block.UncompressedData.Data(), UncompressedSize)
+			: FCompression::CompressMemory(Settings.CompressionMethod, Block.CompressedData.GetData(), CompressedSize, Block.UncompressedData.Data(), UncompressedSize);
+		if (bCompressed && CompressedSize < UncompressedSize)
+		{
+			Block.CompressedData.SetNum(CompressedSize, false);
+			Block.CompressionMethodIndex = 1;
+		}
+		else
+		{
+			// Not worth it, the block is stored as is
+			Block.CompressedData.Empty();
+			Block.CompressionMethodIndex = 0;
+		}
+	}
+
+	/** Writes every block that is ready, in the order they were appended */
+	void OnBlockCompressed(FPendingBlock& Block)
+	{
+		FScopeLock WriteLock(&WriteCritical);
+		Block.bIsReady = true;
+		while (NextBlockToWrite < NextBlockSequence)
+		{
+			FPendingBlock*& Slot = PendingBlockSlots[NextBlockToWrite % PendingBlockSlots.Num()];
+			if (!Slot->bIsReady)
+			{
+				break;
+			}
+			WriteBlock(*Slot);
+			delete Slot;
+			Slot = nullptr;
+			++NextBlockToWrite;
+			PendingBlockCount.Decrement();
+			BlockWrittenEvent->Trigger();
+		}
+	}
+
+	void WriteBlock(const FPendingBlock& Block)
+	{
+		const bool bIsCompressed = Block.CompressionMethodIndex != 0;
+		const uint8* Data = bIsCompressed ? Block.CompressedData.GetData() : Block.UncompressedData.Data();
+		const uint64 Size = bIsCompressed ? Block.CompressedData.Num() : Block.UncompressedData.DataSize();
+
+		check(ContainerFileHandle->Tell() % IoChunkAlignment == 0);
+		FIoStoreTocCompressedBlockEntry& Entry = CompressedBlocks.AddDefaulted_GetRef();
+		Entry.Set(ContainerFileHandle->Tell(), uint32(Size), uint32(Block.UncompressedData.DataSize()), Block.CompressionMethodIndex);
+
+		bool Success = ContainerFileHandle->Write(Data, Size);
+		if (uint32 UnpaddedBytes = Size % IoChunkAlignment)
+		{
+			static constexpr uint8 Zeroes[IoChunkAlignment] = {};
+			Success &= ContainerFileHandle->Write(Zeroes, IoChunkAlignment - UnpaddedBytes);
+		}
+		if (!Success)
+		{
+			bBlockWriteFailed = true;
+		}
+	}
+
+	void WaitForPendingBlocks()
+	{
+		while (PendingBlockCount.GetValue() > 0)
+		{
+			BlockWrittenEvent->Wait();
+		}
+	}
+
 	FIoStoreEnvironment&				Environment;
+	FIoStoreWriterSettings				Settings;
+	TUniquePtr<ICompressionDictionary>	CompressionDictionary;
 	TMap<FIoChunkId, FIoStoreTocEntry>	Toc;
 	TUniquePtr<IFileHandle>				ContainerFileHandle;
 	TUniquePtr<IFileHandle>				TocFileHandle;
 	TUniquePtr<FArchive>				CsvArchive;
 	bool								IsMetadataDirty = true;
+
+	// Serializes Append, MapPartialRange and FlushMetadata, which fixes the layout of the container
+	FCriticalSection					AppendCritical;
+	uint64								NextUncompressedOffset = 0;
+
+	// Bounded pipeline of compressed blocks, guarded by WriteCritical
+	FCriticalSection					WriteCritical;
+	TArray<FPendingBlock*>				PendingBlockSlots;
+	uint64								NextBlockSequence = 0;
+	uint64								NextBlockToWrite = 0;
+	TArray<FIoStoreTocCompressedBlockEntry> CompressedBlocks;
+	FThreadSafeCounter					PendingBlockCount;
+	FEvent*								BlockWrittenEvent;
+	TAtomic<bool>						bBlockWriteFailed { false };
 };
 
 FIoStoreWriter::FIoStoreWriter(FIoStoreEnvironment& InEnvironment)
@@ -215,11 +587,17 @@ FIoStoreWriter::FIoStoreWriter(FIoStoreEnvironment& InEnvironment)
 FIoStoreWriter::~FIoStoreWriter()
 {
 	(void)Impl->FlushMetadata();
+	delete Impl;
 }
 
 FIoStatus FIoStoreWriter::Initialize()
 {
-	return Impl->Initialize();
+	return Impl->Initialize(FIoStoreWriterSettings());
+}
+
+FIoStatus FIoStoreWriter::Initialize(const FIoStoreWriterSettings& Settings)
+{
+	return Impl->Initialize(Settings);
 }
 
 FIoStatus FIoStoreWriter::EnableCsvOutput()
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/ArrayView.h"
 #include "IO/IoDispatcher.h"
 
 /**
@@ -15,7 +16,19 @@ struct FIoStoreTocHeader
 	uint32	TocHeaderSize;
 	uint32	TocEntryCount;
 	uint32	TocEntrySize;	// For sanity checking
-	uint32	TocPad[25];
+	// Compressed containers only, zero for containers that store their chunks as is
+	uint32	TocCompressedBlockEntryCount;
+	uint32	TocCompressedBlockEntrySize;	// For sanity checking
+	uint32	CompressionMethodNameCount;
+	uint32	CompressionMethodNameLength;
+	uint32	CompressionBlockSize;
+	// Size of the dictionary the compressed blocks use, stored after the method names. Zero if they don't use one.
+	uint32	CompressionDictionarySize;
+	// Perfect hash of the chunk IDs, see FIoStoreTocPerfectHash. The seeds and then the indices of the entries
+	// that the hash doesn't place are stored after the dictionary.
+	uint32	TocChunkPerfectHashSeedCount;
+	uint32	TocChunkWithoutPerfectHashCount;
+	uint32	TocPad[17];
 
 	void MakeMagic()
 	{
@@ -109,3 +122,130 @@ struct FIoStoreTocEntry
 		OffsetAndLength.SetLength(Length);
 	}
 };
+
+/**
+ * Compression block entry of a compressed container.
+ *
+ * Chunks of compressed containers are addressed in the uncompressed stream, which is split into blocks of
+ * FIoStoreTocHeader::CompressionBlockSize. Every chunk starts on a block boundary.
+ */
+struct FIoStoreTocCompressedBlockEntry
+{
+	static constexpr uint32 OffsetBits = 40;
+	static constexpr uint32 SizeBits = 24;
+
+	inline uint64 GetOffset() const
+	{
+		return uint64(Data[0]) | (uint64(Data[1]) << 8) | (uint64(Data[2]) << 16) | (uint64(Data[3]) << 24) | (uint64(Data[4]) << 32);
+	}
+
+	inline uint32 GetCompressedSize() const
+	{
+		return uint32(Data[5]) | (uint32(Data[6]) << 8) | (uint32(Data[7]) << 16);
+	}
+
+	inline uint32 GetUncompressedSize() const
+	{
+		return uint32(Data[8]) | (uint32(Data[9]) << 8) | (uint32(Data[10]) << 16);
+	}
+
+	/** Zero for blocks that are stored uncompressed, otherwise the index of the method name plus one */
+	inline uint8 GetCompressionMethodIndex() const
+	{
+		return Data[11];
+	}
+
+	inline void Set(uint64 Offset, uint32 CompressedSize, uint32 UncompressedSize, uint8 CompressionMethodIndex)
+	{
+		check(Offset < (1ull << OffsetBits) && CompressedSize < (1u << SizeBits) && UncompressedSize < (1u << SizeBits));
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			Data[Index] = uint8(Offset >> (Index * 8));
+		}
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			Data[5 + Index] = uint8(CompressedSize >> (Index * 8));
+			Data[8 + Index] = uint8(UncompressedSize >> (Index * 8));
+		}
+		Data[11] = CompressionMethodIndex;
+	}
+
+private:
+	uint8 Data[5 + 3 + 3 + 1];
+};
+
+/**
+ * Perfect hash of the chunk IDs of a container, which lets readers find entries in the TOC as it is on disk.
+ *
+ * The writer orders the TOC entries so that every chunk ID hashes to the index of its own entry, hash and displace
+ * style: the ID first picks one of the seeds, and the seed then picks the entry.
+ *  - A positive seed is the seed of a second hash of the ID, modulo the entry count.
+ *  - A negative seed is minus one minus the index of the only entry in its bucket.
+ *  - A zero seed means the writer found no seed for the bucket. Its entries are listed in the indices of the entries
+ *    without a perfect hash, sorted by chunk ID.
+ *
+ * Containers store the hashes implicitly, they must never change.
+ */
+struct FIoStoreTocPerfectHash
+{
+	static uint64 HashChunkId(const FIoChunkId& ChunkId, int32 Seed)
+	{
+		static_assert(sizeof(FIoChunkId) == 12, "The TOC hashes the bytes of chunk IDs");
+		const uint8* Data = reinterpret_cast<const uint8*>(&ChunkId);
+
+		// FNV-1a, with the seed as the offset basis
+		uint64 Hash = Seed ? uint64(Seed) : 0xcbf29ce484222325ull;
+		for (int32 Index = 0; Index < sizeof(FIoChunkId); ++Index)
+		{
+			Hash = (Hash ^ Data[Index]) * 0x00000100000001b3ull;
+		}
+		return Hash;
+	}
+
+	static int32 CompareChunkIds(const FIoChunkId& A, const FIoChunkId& B)
+	{
+		return FMemory::Memcmp(&A, &B, sizeof(FIoChunkId));
+	}
+
+	/**
+	 * Finds the entry of a chunk ID.
+	 *
+	 * @return The index of the entry, or INDEX_NONE if the container doesn't have the chunk.
+	 */
+	static int32 Find(const FIoChunkId& ChunkId, TArrayView<const FIoStoreTocEntry> Entries, TArrayView<const int32> Seeds, TArrayView<const int32> EntriesWithoutPerfectHash)
+	{
+		if (Entries.Num() == 0 || Seeds.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Seed = Seeds[int32(HashChunkId(ChunkId, 0) % uint32(Seeds.Num()))];
+		if (Seed == 0)
+		{
+			int32 Low = 0;
+			int32 High = EntriesWithoutPerfectHash.Num();
+			while (Low < High)
+			{
+				const int32 Middle = Low + (High - Low) / 2;
+				const int32 EntryIndex = EntriesWithoutPerfectHash[Middle];
+				const int32 Compare = uint32(EntryIndex) < uint32(Entries.Num()) ? CompareChunkIds(Entries[EntryIndex].ChunkId, ChunkId) : 1;
+				if (Compare == 0)
+				{
+					return EntryIndex;
+				}
+				if (Compare < 0)
+				{
+					Low = Middle + 1;
+				}
+				else
+				{
+					High = Middle;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		const int32 EntryIndex = Seed < 0 ? -Seed - 1 : int32(HashChunkId(ChunkId, Seed) % uint32(Entries.Num()));
+		return uint32(EntryIndex) < uint32(Entries.Num()) && Entries[EntryIndex].ChunkId == ChunkId ? EntryIndex : INDEX_NONE;
+	}
+};
@@ -463,6 +463,17 @@ public:
 	}
 	
 	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64, bool bPreloadHint = false) override
+	{
+		return MapRegionWithProtection(Offset, BytesToMap, PROT_READ);
+	}
+
+	virtual IMappedFileRegion* MapRegionCopyOnWrite(int64 Offset = 0, int64 BytesToMap = MAX_int64) override
+	{
+		// Private mappings of a file opened read only can be written to, the writes never reach the file
+		return MapRegionWithProtection(Offset, BytesToMap, PROT_READ | PROT_WRITE);
+	}
+
+	IMappedFileRegion* MapRegionWithProtection(int64 Offset, int64 BytesToMap, int Protection)
 	{
 		LLM_PLATFORM_SCOPE(ELLMTag::PlatformMMIO);
 		check(Offset < GetFileSize()); // don't map zero bytes and don't map off the end of the file
@@ -484,7 +495,7 @@ public:
 			return nullptr;
 		}
 		
-		const uint8* AlignedMapPtr = (const uint8 *)mmap(NULL, AlignedSize, PROT_READ, MAP_PRIVATE, FileHandle, AlignedOffset);
+		const uint8* AlignedMapPtr = (const uint8 *)mmap(NULL, AlignedSize, Protection, MAP_PRIVATE, FileHandle, AlignedOffset);
 		if (AlignedMapPtr == (const uint8*)-1 || AlignedMapPtr == nullptr)
 		{
 			UE_LOG(LogIOS, Warning, TEXT("Failed to map memory %s, error is %d"), *Filename, errno);
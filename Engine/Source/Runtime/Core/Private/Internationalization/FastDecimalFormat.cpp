@@ -1,7 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Internationalization/FastDecimalFormat.h"
+#include "Algo/Reverse.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/Internationalization.h"
 #include "Misc/EnumClassFlags.h"
+#include "Misc/StringBuilder.h"
+#include "Internationalization/FastDecimalFormatTables.h"
 
 namespace FastDecimalFormat
 {
@@ -12,6 +17,9 @@ namespace Internal
 static const int32 MaxIntegralPrintLength = 20;
 static const int32 MaxFractionalPrintPrecision = 18;
 static const int32 MinRequiredIntegralBufferSize = (MaxIntegralPrintLength * 2) + 1; // *2 for an absolute worst case group separator scenario, +1 for null terminator
+static const int32 MaxDoubleIntegralDigits = 309; // DBL_MAX is 309 digits long
+static const int32 MinRequiredFractionalIntegralBufferSize = (MaxDoubleIntegralDigits * 2) + 1; // *2 for an absolute worst case group separator scenario, +1 for null terminator
+static const int32 MaxShortestDecimalDigits = 17;
 
 static const uint64 Pow10Table[] = {
 	1,						// 10^0
@@ -37,6 +45,253 @@ static const uint64 Pow10Table[] = {
 
 static_assert(UE_ARRAY_COUNT(Pow10Table) - 1 >= MaxFractionalPrintPrecision, "Pow10Table must at big enough to index any value up-to MaxFractionalPrintPrecision");
 
+/** The value of a double as the fewest decimal digits that read back as that double, see DoubleToShortestDecimal */
+struct FShortestDecimal
+{
+	/** Value is Mantissa * 10^Exponent, with at most 17 digits in the mantissa */
+	uint64 Mantissa;
+	int32 Exponent;
+};
+
+FORCEINLINE uint64 ShortestDecimal_UMul128(const uint64 InA, const uint64 InB, uint64& OutHigh)
+{
+#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 Product = (unsigned __int128)InA * InB;
+	OutHigh = (uint64)(Product >> 64);
+	return (uint64)Product;
+#else
+	const uint64 ALow = (uint32)InA;
+	const uint64 AHigh = InA >> 32;
+	const uint64 BLow = (uint32)InB;
+	const uint64 BHigh = InB >> 32;
+
+	const uint64 LowLow = ALow * BLow;
+	const uint64 Mid1 = AHigh * BLow + (LowLow >> 32); // Can't overflow
+	const uint64 Mid2 = ALow * BHigh + (uint32)Mid1; // Can't overflow
+
+	OutHigh = AHigh * BHigh + (Mid1 >> 32) + (Mid2 >> 32);
+	return (Mid2 << 32) | (uint32)LowLow;
+#endif
+}
+
+/** (InMantissa * InMul) >> InShift, where InMul is a 128-bit { low, high } table entry and InShift is in (64, 128) */
+FORCEINLINE uint64 ShortestDecimal_MulShift(const uint64 InMantissa, const uint64* InMul, const int32 InShift)
+{
+	uint64 High1;
+	const uint64 Low1 = ShortestDecimal_UMul128(InMantissa, InMul[1], High1);
+	uint64 High0;
+	ShortestDecimal_UMul128(InMantissa, InMul[0], High0);
+
+	const uint64 Sum = High0 + Low1;
+	if (Sum < High0)
+	{
+		++High1;
+	}
+
+	const int32 Dist = InShift - 64;
+	return (High1 << (64 - Dist)) | (Sum >> Dist);
+}
+
+/** ceil(log2(5^InExp)), or 1 for 0 */
+FORCEINLINE int32 ShortestDecimal_Pow5Bits(const int32 InExp)
+{
+	return (int32)(((uint32)InExp * 1217359) >> 19) + 1;
+}
+
+/** floor(log10(2^InExp)) */
+FORCEINLINE uint32 ShortestDecimal_Log10Pow2(const int32 InExp)
+{
+	return ((uint32)InExp * 78913) >> 18;
+}
+
+/** floor(log10(5^InExp)) */
+FORCEINLINE uint32 ShortestDecimal_Log10Pow5(const int32 InExp)
+{
+	return ((uint32)InExp * 732923) >> 20;
+}
+
+FORCEINLINE bool ShortestDecimal_IsMultipleOfPow5(uint64 InVal, const uint32 InPow)
+{
+	uint32 Count = 0;
+	while (InVal != 0 && InVal % 5 == 0)
+	{
+		InVal /= 5;
+		++Count;
+	}
+	return Count >= InPow;
+}
+
+FORCEINLINE bool ShortestDecimal_IsMultipleOfPow2(const uint64 InVal, const uint32 InPow)
+{
+	return (InVal & ((1ull << InPow) - 1)) == 0;
+}
+
+/**
+ * Finds the shortest decimal that reads back as the given finite, positive or zero double, the one closest to it when several are as short.
+ * This is Ryu (Ulf Adams, "Ryu: Fast Float-to-String Conversion", PLDI 2018): the interval of decimals that round to the double is scaled
+ * by a power of ten with 128-bit fixed point multiplications, and digits are removed while its bounds still differ.
+ */
+FShortestDecimal DoubleToShortestDecimal(const double InVal)
+{
+	static const int32 MantissaBits = 52;
+	static const int32 ExponentBias = 1023;
+
+	uint64 Bits;
+	FMemory::Memcpy(&Bits, &InVal, sizeof(Bits));
+	const uint64 IeeeMantissa = Bits & ((1ull << MantissaBits) - 1);
+	const uint32 IeeeExponent = (uint32)((Bits >> MantissaBits) & 0x7FF);
+
+	FShortestDecimal Result;
+	if (IeeeExponent == 0 && IeeeMantissa == 0)
+	{
+		Result.Mantissa = 0;
+		Result.Exponent = 0;
+		return Result;
+	}
+
+	// The value is M2 * 2^E2, offset by two bits for the bounds of the interval halfway to the neighboring doubles
+	int32 E2;
+	uint64 M2;
+	if (IeeeExponent == 0)
+	{
+		E2 = 1 - ExponentBias - MantissaBits - 2;
+		M2 = IeeeMantissa;
+	}
+	else
+	{
+		E2 = (int32)IeeeExponent - ExponentBias - MantissaBits - 2;
+		M2 = (1ull << MantissaBits) | IeeeMantissa;
+	}
+	const bool bAcceptBounds = (M2 & 1) == 0;
+
+	const uint64 MV = 4 * M2;
+	// The lower neighbor is closer when the mantissa wraps to a lower exponent
+	const uint32 MMShift = IeeeMantissa != 0 || IeeeExponent <= 1;
+
+	// VR, VP and VM are the value and the bounds of its interval, scaled by 10^-E10
+	uint64 VR, VP, VM;
+	int32 E10;
+	bool bVMIsTrailingZeros = false;
+	bool bVRIsTrailingZeros = false;
+	if (E2 >= 0)
+	{
+		const uint32 Q = ShortestDecimal_Log10Pow2(E2) - (E2 > 3);
+		E10 = (int32)Q;
+		const int32 K = DoublePow5InvBitCount + ShortestDecimal_Pow5Bits((int32)Q) - 1;
+		const int32 I = -E2 + (int32)Q + K;
+		VR = ShortestDecimal_MulShift(MV, DoublePow5InvSplit[Q], I);
+		VP = ShortestDecimal_MulShift(MV + 2, DoublePow5InvSplit[Q], I);
+		VM = ShortestDecimal_MulShift(MV - 1 - MMShift, DoublePow5InvSplit[Q], I);
+		if (Q <= 21)
+		{
+			// Only one of MV, MP and MM can be a multiple of 5, if any
+			if (MV % 5 == 0)
+			{
+				bVRIsTrailingZeros = ShortestDecimal_IsMultipleOfPow5(MV, Q);
+			}
+			else if (bAcceptBounds)
+			{
+				bVMIsTrailingZeros = ShortestDecimal_IsMultipleOfPow5(MV - 1 - MMShift, Q);
+			}
+			else
+			{
+				VP -= ShortestDecimal_IsMultipleOfPow5(MV + 2, Q);
+			}
+		}
+	}
+	else
+	{
+		const uint32 Q = ShortestDecimal_Log10Pow5(-E2) - (-E2 > 1);
+		E10 = (int32)Q + E2;
+		const int32 I = -E2 - (int32)Q;
+		const int32 K = ShortestDecimal_Pow5Bits(I) - DoublePow5BitCount;
+		const int32 J = (int32)Q - K;
+		VR = ShortestDecimal_MulShift(MV, DoublePow5Split[I], J);
+		VP = ShortestDecimal_MulShift(MV + 2, DoublePow5Split[I], J);
+		VM = ShortestDecimal_MulShift(MV - 1 - MMShift, DoublePow5Split[I], J);
+		if (Q <= 1)
+		{
+			// MV has at least two trailing zero bits, MM has one when MMShift is 1, MP always has one
+			bVRIsTrailingZeros = true;
+			if (bAcceptBounds)
+			{
+				bVMIsTrailingZeros = MMShift == 1;
+			}
+			else
+			{
+				--VP;
+			}
+		}
+		else if (Q < 63)
+		{
+			bVRIsTrailingZeros = ShortestDecimal_IsMultipleOfPow2(MV, Q);
+		}
+	}
+
+	// Remove digits while the bounds differ, remembering the last removed digit of the value to round it
+	int32 Removed = 0;
+	uint8 LastRemovedDigit = 0;
+	uint64 Output;
+	if (bVMIsTrailingZeros || bVRIsTrailingZeros)
+	{
+		// Rare case where the bounds or the value are exact decimals
+		while (VP / 10 > VM / 10)
+		{
+			bVMIsTrailingZeros &= VM % 10 == 0;
+			bVRIsTrailingZeros &= LastRemovedDigit == 0;
+			LastRemovedDigit = (uint8)(VR % 10);
+			VR /= 10;
+			VP /= 10;
+			VM /= 10;
+			++Removed;
+		}
+		if (bVMIsTrailingZeros)
+		{
+			while (VM % 10 == 0)
+			{
+				bVRIsTrailingZeros &= LastRemovedDigit == 0;
+				LastRemovedDigit = (uint8)(VR % 10);
+				VR /= 10;
+				VP /= 10;
+				VM /= 10;
+				++Removed;
+			}
+		}
+		if (bVRIsTrailingZeros && LastRemovedDigit == 5 && VR % 2 == 0)
+		{
+			// Round to even when the value is exactly halfway
+			LastRemovedDigit = 4;
+		}
+		Output = VR + ((VR == VM && (!bAcceptBounds || !bVMIsTrailingZeros)) || LastRemovedDigit >= 5);
+	}
+	else
+	{
+		bool bRoundUp = false;
+		if (VP / 100 > VM / 100)
+		{
+			// Remove two digits at a time, which is what most values allow
+			bRoundUp = VR % 100 >= 50;
+			VR /= 100;
+			VP /= 100;
+			VM /= 100;
+			Removed += 2;
+		}
+		while (VP / 10 > VM / 10)
+		{
+			bRoundUp = VR % 10 >= 5;
+			VR /= 10;
+			VP /= 10;
+			VM /= 10;
+			++Removed;
+		}
+		Output = VR + (VR == VM || bRoundUp);
+	}
+
+	Result.Mantissa = Output;
+	Result.Exponent = E10 + Removed;
+	return Result;
+}
+
 enum class EDecimalNumberSigningStringsFlags : uint8
 {
 	None = 0,
@@ -265,113 +520,206 @@ FORCEINLINE int32 IntegralToString_Common(const uint64 InVal, const FDecimalNumb
 		);
 }
 
-void FractionalToString_SplitAndRoundNumber(const bool bIsNegative, const double InValue, const int32 InNumDecimalPlaces, ERoundingMode InRoundingMode, double& OutIntegralPart, double& OutFractionalPart)
+int32 FractionalToString_DigitsToString(
+	const uint8* InDigits, const int32 InNumDigits,
+	const bool InUseGrouping, const uint8 InPrimaryGroupingSize, const uint8 InSecondaryGroupingSize, const TCHAR InGroupingSeparatorCharacter, const TCHAR* InDigitCharacters,
+	const int32 InMinDigitsToPrint, const int32 InMaxDigitsToPrint,
+	TCHAR* InBufferToFill, const int32 InBufferToFillSize
+	)
+{
+	// Matches IntegralToString_UInt64ToString, for integral parts that may not fit in a uint64
+	check(InBufferToFillSize >= MinRequiredFractionalIntegralBufferSize);
+
+	TCHAR TmpBuffer[MinRequiredFractionalIntegralBufferSize];
+	int32 StringLen = 0;
+
+	int32 DigitsPrinted = 0;
+	uint8 NumUntilNextGroup = InPrimaryGroupingSize;
+
+	// Skip the leading zeros, the loop below stops when only zeros are left
+	int32 FirstDigitIndex = 0;
+	while (FirstDigitIndex < InNumDigits && InDigits[FirstDigitIndex] == 0)
+	{
+		++FirstDigitIndex;
+	}
+
+	for (int32 DigitIndex = InNumDigits - 1; DigitIndex >= FirstDigitIndex && DigitsPrinted < InMaxDigitsToPrint; --DigitIndex)
+	{
+		if (InUseGrouping && NumUntilNextGroup-- == 0)
+		{
+			TmpBuffer[StringLen++] = InGroupingSeparatorCharacter;
+			NumUntilNextGroup = InSecondaryGroupingSize - 1; // -1 to account for the digit we're about to print
+		}
+
+		TmpBuffer[StringLen++] = InDigitCharacters[InDigits[DigitIndex]];
+		++DigitsPrinted;
+	}
+
+	// Pad the string to the min digits requested
+	{
+		const int32 PaddingToApply = FMath::Min(InMinDigitsToPrint - DigitsPrinted, MaxIntegralPrintLength - DigitsPrinted);
+		for (int32 PaddingIndex = 0; PaddingIndex < PaddingToApply; ++PaddingIndex)
+		{
+			if (InUseGrouping && NumUntilNextGroup-- == 0)
+			{
+				TmpBuffer[StringLen++] = InGroupingSeparatorCharacter;
+				NumUntilNextGroup = InSecondaryGroupingSize;
+			}
+
+			TmpBuffer[StringLen++] = InDigitCharacters[0];
+		}
+	}
+
+	// TmpBuffer is backwards, flip it into the final output buffer
+	for (int32 FinalBufferIndex = 0; FinalBufferIndex < StringLen; ++FinalBufferIndex)
+	{
+		InBufferToFill[FinalBufferIndex] = TmpBuffer[StringLen - FinalBufferIndex - 1];
+	}
+	InBufferToFill[StringLen] = 0;
+
+	return StringLen;
+}
+
+/**
+ * Rounds the decimal digits of a value to the given number of fractional digits, ties and directions as ICU does.
+ * See http://userguide.icu-project.org/formatparse/numbers/rounding-modes
+ * @param InDigits				Digits of the value, most significant first
+ * @param InDecimalPointPos		Number of digits of InDigits before the decimal point, which can be negative or more than InNumDigits
+ * @param OutFixedDigits		Receives OutNumIntegralDigits + 1 integral digits, the first one a carry that is 0 unless rounding overflowed, then InNumFractionalDigits fractional digits
+ */
+void FractionalToString_RoundDigits(const bool bIsNegative, const uint8* InDigits, const int32 InNumDigits, const int32 InDecimalPointPos, const int32 InNumFractionalDigits, const ERoundingMode InRoundingMode, uint8* OutFixedDigits, int32& OutNumIntegralDigits)
 {
-	const int32 DecimalPlacesToRoundTo = FMath::Min(InNumDecimalPlaces, MaxFractionalPrintPrecision);
+	OutNumIntegralDigits = FMath::Max(InDecimalPointPos, 0);
+	const int32 NumFixedDigits = OutNumIntegralDigits + InNumFractionalDigits;
 
-	const bool bIsRoundingEntireNumber = DecimalPlacesToRoundTo == 0;
+	// Fixed digit K (after the carry) is digit K + DigitOffset of the value
+	const int32 DigitOffset = InDecimalPointPos - OutNumIntegralDigits;
+	OutFixedDigits[0] = 0;
+	for (int32 FixedIndex = 0; FixedIndex < NumFixedDigits; ++FixedIndex)
+	{
+		const int32 DigitIndex = FixedIndex + DigitOffset;
+		OutFixedDigits[FixedIndex + 1] = (DigitIndex >= 0 && DigitIndex < InNumDigits) ? InDigits[DigitIndex] : 0;
+	}
 
-	// We split the value before performing the rounding to avoid losing precision during the rounding calculations
-	// If we're rounding to zero decimal places, then we just apply rounding to the number as a whole
-	double IntegralPart = InValue;
-	double FractionalPart = (bIsRoundingEntireNumber) ? 0.0 : FMath::Modf(InValue, &IntegralPart);
+	// Nothing to round when every digit of the value was kept
+	const int32 FirstDroppedIndex = NumFixedDigits + DigitOffset;
+	if (FirstDroppedIndex >= InNumDigits)
+	{
+		return;
+	}
 
-	// Multiply the value to round by 10^DecimalPlacesToRoundTo - this will allow us to perform rounding calculations 
-	// that correctly trim any remaining fractional parts that are outside of our rounding range
-	double& ValueToRound = ((bIsRoundingEntireNumber) ? IntegralPart : FractionalPart);
-	ValueToRound = FMath::TruncateToHalfIfClose(ValueToRound * Pow10Table[DecimalPlacesToRoundTo]);
+	const uint8 FirstDroppedDigit = (FirstDroppedIndex >= 0) ? InDigits[FirstDroppedIndex] : 0;
+	bool bDroppedDigitsAfterFirstAreZero = true;
+	for (int32 DigitIndex = FMath::Max(FirstDroppedIndex + 1, 0); DigitIndex < InNumDigits; ++DigitIndex)
+	{
+		if (InDigits[DigitIndex] != 0)
+		{
+			bDroppedDigitsAfterFirstAreZero = false;
+			break;
+		}
+	}
+	const bool bDroppedDigitsAreZero = FirstDroppedDigit == 0 && bDroppedDigitsAfterFirstAreZero;
+	const bool bIsLastKeptDigitOdd = (OutFixedDigits[NumFixedDigits] & 1) != 0;
 
-	// The rounding modes here mimic those of ICU. See http://userguide.icu-project.org/formatparse/numbers/rounding-modes
+	// Whether to round the magnitude up, away from zero
+	bool bRoundUp = false;
 	switch (InRoundingMode)
 	{
 	case ERoundingMode::HalfToEven:
 		// Rounds to the nearest place, equidistant ties go to the value which is closest to an even value: 1.5 becomes 2, 0.5 becomes 0
-		ValueToRound = FMath::RoundHalfToEven(ValueToRound);
+		bRoundUp = FirstDroppedDigit > 5 || (FirstDroppedDigit == 5 && (!bDroppedDigitsAfterFirstAreZero || bIsLastKeptDigitOdd));
 		break;
 
 	case ERoundingMode::HalfFromZero:
 		// Rounds to nearest place, equidistant ties go to the value which is further from zero: -0.5 becomes -1.0, 0.5 becomes 1.0
-		ValueToRound = FMath::RoundHalfFromZero(ValueToRound);
+		bRoundUp = FirstDroppedDigit >= 5;
 		break;
-	
+
 	case ERoundingMode::HalfToZero:
 		// Rounds to nearest place, equidistant ties go to the value which is closer to zero: -0.5 becomes 0, 0.5 becomes 0
-		ValueToRound = FMath::RoundHalfToZero(ValueToRound);
+		bRoundUp = FirstDroppedDigit > 5 || (FirstDroppedDigit == 5 && !bDroppedDigitsAfterFirstAreZero);
 		break;
 
 	case ERoundingMode::FromZero:
 		// Rounds to the value which is further from zero, "larger" in absolute value: 0.1 becomes 1, -0.1 becomes -1
-		ValueToRound = FMath::RoundFromZero(ValueToRound);
+		bRoundUp = !bDroppedDigitsAreZero;
 		break;
-	
+
 	case ERoundingMode::ToZero:
 		// Rounds to the value which is closer to zero, "smaller" in absolute value: 0.1 becomes 0, -0.1 becomes 0
-		ValueToRound = FMath::RoundToZero(ValueToRound);
+		bRoundUp = false;
 		break;
-	
+
 	case ERoundingMode::ToNegativeInfinity:
 		// Rounds to the value which is more negative: 0.1 becomes 0, -0.1 becomes -1
-		ValueToRound = FMath::RoundToNegativeInfinity(ValueToRound);
+		bRoundUp = bIsNegative && !bDroppedDigitsAreZero;
 		break;
-	
+
 	case ERoundingMode::ToPositiveInfinity:
 		// Rounds to the value which is more positive: 0.1 becomes 1, -0.1 becomes 0
-		ValueToRound = FMath::RoundToPositiveInfinity(ValueToRound);
+		bRoundUp = !bIsNegative && !bDroppedDigitsAreZero;
 		break;
 
 	default:
 		break;
 	}
 
-	// Copy to the correct output param depending on whether we were rounding to the number as a whole
-	if (bIsRoundingEntireNumber)
+	if (bRoundUp)
 	{
-		OutIntegralPart = ValueToRound;
-		OutFractionalPart = 0.0;
-	}
-	else
-	{
-		// Rounding may have caused the fractional value to overflow, and any overflow will need to be applied to the integral part and stripped from the fractional part
-		const double ValueToOverflowTest = (bIsNegative) ? -ValueToRound : ValueToRound;
-		if (ValueToOverflowTest >= Pow10Table[DecimalPlacesToRoundTo])
+		// The carry digit absorbs any overflow
+		for (int32 FixedIndex = NumFixedDigits; FixedIndex >= 0; --FixedIndex)
 		{
-			if (bIsNegative)
+			if (++OutFixedDigits[FixedIndex] < 10)
 			{
-				IntegralPart -= 1;
-				ValueToRound += Pow10Table[DecimalPlacesToRoundTo];
-			}
-			else
-			{
-				IntegralPart += 1;
-				ValueToRound -= Pow10Table[DecimalPlacesToRoundTo];
+				break;
 			}
+			OutFixedDigits[FixedIndex] = 0;
 		}
-
-		OutIntegralPart = IntegralPart;
-		OutFractionalPart = ValueToRound;
 	}
 }
 
-void BuildFinalString(const bool bIsNegative, const bool bAlwaysSign, const FDecimalNumberFormattingRules& InFormattingRules, const TCHAR* InIntegralBuffer, const int32 InIntegralLen, const TCHAR* InFractionalBuffer, const int32 InFractionalLen, FString& OutString)
+FORCEINLINE void AppendToOutput(FString& OutString, const TCHAR* InChars, const int32 InLen)
+{
+	OutString.AppendChars(InChars, InLen);
+}
+
+FORCEINLINE void AppendToOutput(FStringBuilderBase& OutString, const TCHAR* InChars, const int32 InLen)
+{
+	OutString.Append(InChars, InLen);
+}
+
+FORCEINLINE void ReserveOutput(FString& OutString, const int32 InLen)
+{
+	OutString.Reserve(OutString.Len() + InLen);
+}
+
+FORCEINLINE void ReserveOutput(FStringBuilderBase& OutString, const int32 InLen)
+{
+	// String builders grow themselves
+}
+
+template <typename OutputType>
+void BuildFinalString(const bool bIsNegative, const bool bAlwaysSign, const FDecimalNumberFormattingRules& InFormattingRules, const TCHAR* InIntegralBuffer, const int32 InIntegralLen, const TCHAR* InFractionalBuffer, const int32 InFractionalLen, OutputType& OutString)
 {
 	const FDecimalNumberSigningStrings SigningStrings(InFormattingRules, bAlwaysSign ? EDecimalNumberSigningStringsFlags::AlwaysSign : EDecimalNumberSigningStringsFlags::None);
 
 	const FString& FinalPrefixStr = (bIsNegative) ? SigningStrings.GetNegativePrefixString() : SigningStrings.GetPositivePrefixString();
 	const FString& FinalSuffixStr = (bIsNegative) ? SigningStrings.GetNegativeSuffixString() : SigningStrings.GetPositiveSuffixString();
 
-	OutString.Reserve(OutString.Len() + FinalPrefixStr.Len() + InIntegralLen + 1 + InFractionalLen + FinalSuffixStr.Len());
+	ReserveOutput(OutString, FinalPrefixStr.Len() + InIntegralLen + 1 + InFractionalLen + FinalSuffixStr.Len());
 
-	OutString.Append(FinalPrefixStr);
-	OutString.AppendChars(InIntegralBuffer, InIntegralLen);
+	AppendToOutput(OutString, *FinalPrefixStr, FinalPrefixStr.Len());
+	AppendToOutput(OutString, InIntegralBuffer, InIntegralLen);
 	if (InFractionalLen > 0)
 	{
-		OutString.AppendChar(InFormattingRules.DecimalSeparatorCharacter);
-		OutString.AppendChars(InFractionalBuffer, InFractionalLen);
+		AppendToOutput(OutString, &InFormattingRules.DecimalSeparatorCharacter, 1);
+		AppendToOutput(OutString, InFractionalBuffer, InFractionalLen);
 	}
-	OutString.Append(FinalSuffixStr);
+	AppendToOutput(OutString, *FinalSuffixStr, FinalSuffixStr.Len());
 }
 
-void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString)
+template <typename OutputType>
+void IntegralToString_Impl(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, OutputType& OutString)
 {
 	SanitizeNumberFormattingOptions(InFormattingOptions);
 
@@ -395,60 +743,74 @@ void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimal
 	BuildFinalString(bIsNegative, InFormattingOptions.AlwaysSign, InFormattingRules, IntegralPartBuffer, IntegralPartLen, FractionalPartBuffer, FractionalPartLen, OutString);
 }
 
-void FractionalToString(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString)
+template <typename OutputType>
+void FractionalToString_Impl(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, OutputType& OutString)
 {
 	SanitizeNumberFormattingOptions(InFormattingOptions);
 
-	if (FMath::IsNaN((float)InVal)) //@TODO: FLOATPRECISION: Need a double version?
+	if (FMath::IsNaN(InVal))
 	{
-		OutString.Append(InFormattingRules.NaNString);
+		AppendToOutput(OutString, *InFormattingRules.NaNString, InFormattingRules.NaNString.Len());
 		return;
 	}
 
 	const bool bIsNegative = FMath::IsNegativeDouble(InVal);
 
-	double IntegralPart = 0.0;
-	double FractionalPart = 0.0;
-	FractionalToString_SplitAndRoundNumber(bIsNegative, InVal, InFormattingOptions.MaximumFractionalDigits, InFormattingOptions.RoundingMode, IntegralPart, FractionalPart);
+	TCHAR IntegralPartBuffer[MinRequiredFractionalIntegralBufferSize];
+	int32 IntegralPartLen = 0;
+	TCHAR FractionalPartBuffer[MinRequiredIntegralBufferSize];
+	int32 FractionalPartLen = 0;
 
-	if (bIsNegative)
+	if (!FMath::IsFinite(InVal))
 	{
-		IntegralPart = -IntegralPart;
-		FractionalPart = -FractionalPart;
+		// Infinity is written as ICU does, signed like any other number
+		IntegralPartBuffer[IntegralPartLen++] = (TCHAR)0x221E;
 	}
-
-	// Deal with the integral part (produces a string of the integral part, inserting group separators if requested and required, and padding as needed)
-	TCHAR IntegralPartBuffer[MinRequiredIntegralBufferSize];
-	const int32 IntegralPartLen = IntegralToString_Common(static_cast<uint64>(IntegralPart), InFormattingRules, InFormattingOptions, IntegralPartBuffer, UE_ARRAY_COUNT(IntegralPartBuffer));
-
-	// Deal with the fractional part (produces a string of the fractional part, potentially padding with zeros up to InFormattingOptions.MaximumFractionalDigits)
-	TCHAR FractionalPartBuffer[MinRequiredIntegralBufferSize];
-	int32 FractionalPartLen = 0;
-	if (FractionalPart != 0.0)
+	else
 	{
-		FractionalPartLen = IntegralToString_UInt64ToString(static_cast<uint64>(FractionalPart), false, 0, 0, ' ', InFormattingRules.DigitCharacters, 0, InFormattingOptions.MaximumFractionalDigits, FractionalPartBuffer, UE_ARRAY_COUNT(FractionalPartBuffer));
-	
-		{
-			// Pad the fractional part with any leading zeros that may have been lost when the number was split
-			const int32 LeadingZerosToAdd = FMath::Min(InFormattingOptions.MaximumFractionalDigits - FractionalPartLen, MaxFractionalPrintPrecision - FractionalPartLen);
-			if (LeadingZerosToAdd > 0)
-			{
-				FMemory::Memmove(FractionalPartBuffer + LeadingZerosToAdd, FractionalPartBuffer, FractionalPartLen * sizeof(TCHAR));
-
-				for (int32 Index = 0; Index < LeadingZerosToAdd; ++Index)
-				{
-					FractionalPartBuffer[Index] = InFormattingRules.DigitCharacters[0];
-				}
+		// Rounding is done on the shortest decimal digits of the value, so that 0.15 rounds as the 0.15 that the user sees rather than as the double just below it
+		const FShortestDecimal Shortest = DoubleToShortestDecimal(FMath::Abs(InVal));
 
-				FractionalPartLen += LeadingZerosToAdd;
-			}
+		uint8 ValueDigits[MaxShortestDecimalDigits];
+		int32 NumValueDigits = 0;
+		for (uint64 Mantissa = Shortest.Mantissa; Mantissa != 0; Mantissa /= 10)
+		{
+			ValueDigits[NumValueDigits++] = (uint8)(Mantissa % 10);
 		}
-
-		// Trim any trailing zeros back down to InFormattingOptions.MinimumFractionalDigits
-		while (FractionalPartLen > InFormattingOptions.MinimumFractionalDigits && FractionalPartBuffer[FractionalPartLen - 1] == InFormattingRules.DigitCharacters[0])
+		Algo::Reverse(ValueDigits, NumValueDigits);
+
+		const int32 NumFractionalDigits = FMath::Min(InFormattingOptions.MaximumFractionalDigits, MaxFractionalPrintPrecision);
+
+		uint8 FixedDigits[1 + MaxDoubleIntegralDigits + MaxFractionalPrintPrecision];
+		int32 NumIntegralDigits = 0;
+		FractionalToString_RoundDigits(bIsNegative, ValueDigits, NumValueDigits, NumValueDigits + Shortest.Exponent, NumFractionalDigits, InFormattingOptions.RoundingMode, FixedDigits, NumIntegralDigits);
+
+		// Deal with the integral part (produces a string of the integral part, inserting group separators if requested and required, and padding as needed)
+		IntegralPartLen = FractionalToString_DigitsToString(
+			FixedDigits,
+			NumIntegralDigits + 1,
+			InFormattingOptions.UseGrouping && InFormattingRules.PrimaryGroupingSize > 0,
+			InFormattingRules.PrimaryGroupingSize,
+			InFormattingRules.SecondaryGroupingSize,
+			InFormattingRules.GroupingSeparatorCharacter,
+			InFormattingRules.DigitCharacters,
+			InFormattingOptions.MinimumIntegralDigits,
+			InFormattingOptions.MaximumIntegralDigits,
+			IntegralPartBuffer,
+			UE_ARRAY_COUNT(IntegralPartBuffer)
+			);
+
+		// Deal with the fractional part, trimming any trailing zeros back down to InFormattingOptions.MinimumFractionalDigits
+		const uint8* FractionalDigits = FixedDigits + 1 + NumIntegralDigits;
+		FractionalPartLen = NumFractionalDigits;
+		while (FractionalPartLen > InFormattingOptions.MinimumFractionalDigits && FractionalDigits[FractionalPartLen - 1] == 0)
 		{
 			--FractionalPartLen;
 		}
+		for (int32 Index = 0; Index < FractionalPartLen; ++Index)
+		{
+			FractionalPartBuffer[Index] = InFormattingRules.DigitCharacters[FractionalDigits[Index]];
+		}
 	}
 	FractionalPartBuffer[FractionalPartLen] = 0;
 
@@ -465,6 +827,26 @@ void FractionalToString(const double InVal, const FDecimalNumberFormattingRules&
 	BuildFinalString(bIsNegative, InFormattingOptions.AlwaysSign, InFormattingRules, IntegralPartBuffer, IntegralPartLen, FractionalPartBuffer, FractionalPartLen, OutString);
 }
 
+void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString)
+{
+	IntegralToString_Impl(bIsNegative, InVal, InFormattingRules, InFormattingOptions, OutString);
+}
+
+void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FStringBuilderBase& OutString)
+{
+	IntegralToString_Impl(bIsNegative, InVal, InFormattingRules, InFormattingOptions, OutString);
+}
+
+void FractionalToString(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString)
+{
+	FractionalToString_Impl(InVal, InFormattingRules, InFormattingOptions, OutString);
+}
+
+void FractionalToString(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FStringBuilderBase& OutString)
+{
+	FractionalToString_Impl(InVal, InFormattingRules, InFormattingOptions, OutString);
+}
+
 enum class EDecimalNumberParseFlags : uint8
 {
 	None = 0,
@@ -713,3 +1095,15 @@ const FDecimalNumberFormattingRules& GetCultureAgnosticFormattingRules()
 }
 
 } // namespace FastDecimalFormat
+
+FCultureNumberFormatter::FCultureNumberFormatter(const FCulturePtr& InTargetCulture)
+	: Culture(InTargetCulture.IsValid() ? InTargetCulture.ToSharedRef() : FInternationalization::Get().GetCurrentLocale())
+{
+	NumberFormattingRules = &Culture->GetDecimalNumberFormattingRules();
+	PercentFormattingRules = &Culture->GetPercentFormattingRules();
+}
+
+const FDecimalNumberFormattingRules& FCultureNumberFormatter::GetCurrencyFormattingRules(const FString& InCurrencyCode) const
+{
+	return Culture->GetCurrencyFormattingRules(InCurrencyCode);
+}
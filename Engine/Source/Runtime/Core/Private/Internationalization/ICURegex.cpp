@@ -1,12 +1,24 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ICURegex.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/ScopeLock.h"
 
 #if UE_ENABLE_ICU
 #include "Internationalization/Regex.h"
 #include "Internationalization/ICUUtilities.h"
 
+namespace UE4ICURegex_Private
+{
+	static int32 GPatternCacheSize = 64;
+	static FAutoConsoleVariableRef CVarPatternCacheSize(
+		TEXT("Regex.PatternCacheSize"),
+		GPatternCacheSize,
+		TEXT("The number of compiled regex patterns to keep cached by their source string (0 disables the cache)."),
+		ECVF_Default
+		);
+}
+
 class FRegexPatternImplementation
 {
 public:
@@ -23,24 +35,36 @@ public:
 		}
 	}
 
-	TSharedPtr<icu::RegexPattern> GetInternalRegexPattern() const
+	TSharedPtr<icu::RegexPattern, ESPMode::ThreadSafe> GetInternalRegexPattern() const
 	{
 		return ICURegexPattern.Pin();
 	}
 
 private:
-	TWeakPtr<icu::RegexPattern> ICURegexPattern;
+	TWeakPtr<icu::RegexPattern, ESPMode::ThreadSafe> ICURegexPattern;
 };
 
 
 class FRegexMatcherImplementation
 {
 public:
+	FRegexMatcherImplementation(const FRegexPatternImplementation& Pattern)
+		: ICURegexMatcher(FICURegexManager::Get().CreateRegexMatcher(Pattern.GetInternalRegexPattern().Get(), &ICUString))
+	{
+	}
+
 	FRegexMatcherImplementation(const FRegexPatternImplementation& Pattern, const FString& InputString)
-		: ICUString(ICUUtilities::ConvertString(InputString))
+		: OwnedString(InputString)
 		, ICURegexMatcher(FICURegexManager::Get().CreateRegexMatcher(Pattern.GetInternalRegexPattern().Get(), &ICUString))
-		, OriginalString(InputString)
 	{
+		SetInput(OwnedString);
+	}
+
+	FRegexMatcherImplementation(const FRegexPatternImplementation& Pattern, FString&& InputString)
+		: OwnedString(MoveTemp(InputString))
+		, ICURegexMatcher(FICURegexManager::Get().CreateRegexMatcher(Pattern.GetInternalRegexPattern().Get(), &ICUString))
+	{
+		SetInput(OwnedString);
 	}
 
 	~FRegexMatcherImplementation()
@@ -51,20 +75,49 @@ public:
 		}
 	}
 
+	/** Points the matcher at the given input, which must outlive the matching */
+	void SetInput(const FStringView& InInput)
+	{
+		Input = InInput;
+
+		if (TIsSame<ICUUtilities::FStringConverterImpl, ICUUtilities::FStringConverterImpl_NativeUTF16>::Value)
+		{
+			// Read-only alias of the input, ICU doesn't copy it unless it's written to
+			ICUString.setTo(false, reinterpret_cast<const UChar*>(Input.GetData()), Input.Len());
+		}
+		else
+		{
+			ICUUtilities::ConvertString(Input.GetData(), 0, Input.Len(), ICUString, false);
+		}
+
+		if (TSharedPtr<icu::RegexMatcher> Matcher = ICURegexMatcher.Pin())
+		{
+			Matcher->reset(ICUString);
+		}
+	}
+
+	/** Points the matcher at a string it doesn't own, releasing the string it may have been given when created */
+	void ResetInput(const FStringView& InInput)
+	{
+		SetInput(InInput);
+		OwnedString.Empty();
+	}
+
 	TSharedPtr<icu::RegexMatcher> GetInternalRegexMatcher() const
 	{
 		return ICURegexMatcher.Pin();
 	}
 
-	const FString& GetInternalString() const
+	const FStringView& GetInternalString() const
 	{
-		return OriginalString;
+		return Input;
 	}
 
 private:
-	const icu::UnicodeString ICUString; // ICURegexMatcher keeps a reference to this string internally
+	FString OwnedString;
+	FStringView Input;
+	icu::UnicodeString ICUString; // ICURegexMatcher keeps a reference to this string internally
 	TWeakPtr<icu::RegexMatcher> ICURegexMatcher;
-	FString OriginalString;
 };
 
 
@@ -79,6 +132,10 @@ void FICURegexManager::Create()
 void FICURegexManager::Destroy()
 {
 	check(Singleton);
+
+	// The cached patterns unregister themselves from the manager
+	Singleton->CachedPatterns.Empty();
+
 	delete Singleton;
 	Singleton = nullptr;
 }
@@ -94,13 +151,13 @@ FICURegexManager& FICURegexManager::Get()
 	return *Singleton;
 }
 
-TWeakPtr<icu::RegexPattern> FICURegexManager::CreateRegexPattern(const FString& InSourceString)
+TWeakPtr<icu::RegexPattern, ESPMode::ThreadSafe> FICURegexManager::CreateRegexPattern(const FString& InSourceString)
 {
 	icu::UnicodeString ICUSourceString;
 	ICUUtilities::ConvertString(InSourceString, ICUSourceString);
 
 	UErrorCode ICUStatus = U_ZERO_ERROR;
-	TSharedPtr<icu::RegexPattern>ICURegexPattern = MakeShareable(icu::RegexPattern::compile(ICUSourceString, 0, ICUStatus));
+	TSharedPtr<icu::RegexPattern, ESPMode::ThreadSafe> ICURegexPattern = MakeShareable(icu::RegexPattern::compile(ICUSourceString, 0, ICUStatus));
 
 	if (ICURegexPattern.IsValid())
 	{
@@ -111,9 +168,9 @@ TWeakPtr<icu::RegexPattern> FICURegexManager::CreateRegexPattern(const FString&
 	return ICURegexPattern;
 }
 
-void FICURegexManager::DestroyRegexPattern(TWeakPtr<icu::RegexPattern>& InICURegexPattern)
+void FICURegexManager::DestroyRegexPattern(TWeakPtr<icu::RegexPattern, ESPMode::ThreadSafe>& InICURegexPattern)
 {
-	TSharedPtr<icu::RegexPattern> ICURegexPattern = InICURegexPattern.Pin();
+	TSharedPtr<icu::RegexPattern, ESPMode::ThreadSafe> ICURegexPattern = InICURegexPattern.Pin();
 	if (ICURegexPattern.IsValid())
 	{
 		FScopeLock ScopeLock(&AllocatedRegexPatternsCS);
@@ -122,6 +179,56 @@ void FICURegexManager::DestroyRegexPattern(TWeakPtr<icu::RegexPattern>& InICUReg
 	InICURegexPattern.Reset();
 }
 
+TSharedRef<FRegexPatternImplementation, ESPMode::ThreadSafe> FICURegexManager::FindOrCreateCachedPattern(const FString& InSourceString)
+{
+	const int32 CacheSize = UE4ICURegex_Private::GPatternCacheSize;
+	if (CacheSize <= 0)
+	{
+		return MakeShared<FRegexPatternImplementation, ESPMode::ThreadSafe>(InSourceString);
+	}
+
+	{
+		FScopeLock ScopeLock(&CachedPatternsCS);
+		if (FCachedPattern* CachedPattern = CachedPatterns.Find(InSourceString))
+		{
+			CachedPattern->LastUsed = ++CachedPatternsUseCount;
+			return CachedPattern->Pattern.ToSharedRef();
+		}
+	}
+
+	// Compile outside of the lock, if another thread adds the same pattern meanwhile the first one added is kept
+	TSharedRef<FRegexPatternImplementation, ESPMode::ThreadSafe> NewPattern = MakeShared<FRegexPatternImplementation, ESPMode::ThreadSafe>(InSourceString);
+
+	// Evicted patterns are released once the lock is, as they unregister themselves from the manager
+	TArray<TSharedPtr<FRegexPatternImplementation, ESPMode::ThreadSafe>, TInlineAllocator<1>> EvictedPatterns;
+	FScopeLock ScopeLock(&CachedPatternsCS);
+
+	if (FCachedPattern* CachedPattern = CachedPatterns.Find(InSourceString))
+	{
+		CachedPattern->LastUsed = ++CachedPatternsUseCount;
+		return CachedPattern->Pattern.ToSharedRef();
+	}
+
+	while (CachedPatterns.Num() >= CacheSize)
+	{
+		auto LeastRecentlyUsedIt = CachedPatterns.CreateIterator();
+		for (auto It = CachedPatterns.CreateIterator(); It; ++It)
+		{
+			if (It->Value.LastUsed < LeastRecentlyUsedIt->Value.LastUsed)
+			{
+				LeastRecentlyUsedIt = It;
+			}
+		}
+		EvictedPatterns.Add(MoveTemp(LeastRecentlyUsedIt->Value.Pattern));
+		LeastRecentlyUsedIt.RemoveCurrent();
+	}
+
+	FCachedPattern& CachedPattern = CachedPatterns.Add(InSourceString);
+	CachedPattern.Pattern = NewPattern;
+	CachedPattern.LastUsed = ++CachedPatternsUseCount;
+	return NewPattern;
+}
+
 TWeakPtr<icu::RegexMatcher> FICURegexManager::CreateRegexMatcher(icu::RegexPattern* InPattern, const icu::UnicodeString* InInputString)
 {
 	TSharedPtr<icu::RegexMatcher> ICURegexMatcher;
@@ -154,7 +261,7 @@ void FICURegexManager::DestroyRegexMatcher(TWeakPtr<icu::RegexMatcher>& InICUReg
 
 
 FRegexPattern::FRegexPattern(const FString& SourceString) 
-	: Implementation(new FRegexPatternImplementation(SourceString))
+	: Implementation(FICURegexManager::Get().FindOrCreateCachedPattern(SourceString))
 {
 }
 
@@ -164,6 +271,42 @@ FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern, const FString& InputS
 {
 }	
 
+FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern, FString&& InputString)
+	: Implementation(new FRegexMatcherImplementation(Pattern.Implementation.Get(), MoveTemp(InputString)))
+{
+}
+
+FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern)
+	: Implementation(new FRegexMatcherImplementation(Pattern.Implementation.Get()))
+{
+}
+
+void FRegexMatcher::Reset(const FStringView& Input)
+{
+	Implementation->ResetInput(Input);
+}
+
+TArray<int32> FRegexMatcher::FindMatchingInputs(const FRegexPattern& Pattern, TArrayView<const FString> Inputs)
+{
+	TArray<int32> MatchingInputs;
+
+	FRegexMatcherImplementation MatcherImplementation(Pattern.Implementation.Get());
+	TSharedPtr<icu::RegexMatcher> ICURegexMatcher = MatcherImplementation.GetInternalRegexMatcher();
+	if (ICURegexMatcher.IsValid())
+	{
+		for (int32 InputIndex = 0; InputIndex < Inputs.Num(); ++InputIndex)
+		{
+			MatcherImplementation.SetInput(Inputs[InputIndex]);
+			if (ICURegexMatcher->find() != 0)
+			{
+				MatchingInputs.Add(InputIndex);
+			}
+		}
+	}
+
+	return MatchingInputs;
+}
+
 bool FRegexMatcher::FindNext()
 {
 	TSharedPtr<icu::RegexMatcher> ICURegexMatcher = Implementation->GetInternalRegexMatcher();
@@ -214,7 +357,7 @@ FString FRegexMatcher::GetCaptureGroup(const int32 Index)
 	CaptureGroupBeginning = FMath::Max(0, CaptureGroupBeginning);
 	CaptureGroupEnding = FMath::Max(CaptureGroupBeginning, CaptureGroupEnding);
 
-	return Implementation->GetInternalString().Mid(CaptureGroupBeginning, CaptureGroupEnding - CaptureGroupBeginning);
+	return FString(Implementation->GetInternalString().Mid(CaptureGroupBeginning, CaptureGroupEnding - CaptureGroupBeginning));
 }
 
 int32 FRegexMatcher::GetBeginLimit()
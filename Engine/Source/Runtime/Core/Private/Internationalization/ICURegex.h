@@ -3,10 +3,14 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/Map.h"
 #include "Containers/Set.h"
 #include "Containers/UnrealString.h"
+#include "Misc/Crc.h"
 #include "Templates/SharedPointer.h"
 
+class FRegexPatternImplementation;
+
 #if UE_ENABLE_ICU
 THIRD_PARTY_INCLUDES_START
 	#include <unicode/regex.h>
@@ -23,17 +27,50 @@ public:
 	static bool IsInitialized();
 	static FICURegexManager& Get();
 
-	TWeakPtr<icu::RegexPattern> CreateRegexPattern(const FString& InSourceString);
-	void DestroyRegexPattern(TWeakPtr<icu::RegexPattern>& InICURegexPattern);
+	TWeakPtr<icu::RegexPattern, ESPMode::ThreadSafe> CreateRegexPattern(const FString& InSourceString);
+	void DestroyRegexPattern(TWeakPtr<icu::RegexPattern, ESPMode::ThreadSafe>& InICURegexPattern);
+
+	/** Get the compiled pattern of the given source string from the cache, compiling and caching it if needed */
+	TSharedRef<FRegexPatternImplementation, ESPMode::ThreadSafe> FindOrCreateCachedPattern(const FString& InSourceString);
 
 	TWeakPtr<icu::RegexMatcher> CreateRegexMatcher(icu::RegexPattern* InPattern, const icu::UnicodeString* InInputString);
 	void DestroyRegexMatcher(TWeakPtr<icu::RegexMatcher>& InICURegexMatcher);
 
 private:
+	struct FCachedPattern
+	{
+		TSharedPtr<FRegexPatternImplementation, ESPMode::ThreadSafe> Pattern;
+		uint64 LastUsed = 0;
+	};
+
+	/** Regex patterns are case sensitive, unlike the default FString keys */
+	struct FCachedPatternKeyFuncs : BaseKeyFuncs<TPair<FString, FCachedPattern>, FString>
+	{
+		static FORCEINLINE const FString& GetSetKey(const TPair<FString, FCachedPattern>& Element)
+		{
+			return Element.Key;
+		}
+
+		static FORCEINLINE bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
 	static FICURegexManager* Singleton;
 
 	FCriticalSection AllocatedRegexPatternsCS;
-	TSet<TSharedPtr<icu::RegexPattern>> AllocatedRegexPatterns;
+	TSet<TSharedPtr<icu::RegexPattern, ESPMode::ThreadSafe>> AllocatedRegexPatterns;
+
+	/** Most recently used patterns by source string, the least recently used is evicted when the cache is full */
+	FCriticalSection CachedPatternsCS;
+	TMap<FString, FCachedPattern, FDefaultSetAllocator, FCachedPatternKeyFuncs> CachedPatterns;
+	uint64 CachedPatternsUseCount = 0;
 
 	FCriticalSection AllocatedRegexMatchersCS;
 	TSet<TSharedPtr<icu::RegexMatcher>> AllocatedRegexMatchers;
@@ -11,7 +11,7 @@ class FRegexPatternImplementation
 
 };
 
-FRegexPattern::FRegexPattern(const FString& SourceString) : Implementation( MakeShareable( new FRegexPatternImplementation() ) )
+FRegexPattern::FRegexPattern(const FString& SourceString) : Implementation( MakeShared<FRegexPatternImplementation, ESPMode::ThreadSafe>() )
 {
 }
 
@@ -24,6 +24,23 @@ FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern, const FString& InputS
 {
 }	
 
+FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern, FString&& InputString) : Implementation( MakeShareable( new FRegexMatcherImplementation() ) )
+{
+}
+
+FRegexMatcher::FRegexMatcher(const FRegexPattern& Pattern) : Implementation( MakeShareable( new FRegexMatcherImplementation() ) )
+{
+}
+
+void FRegexMatcher::Reset(const FStringView& Input)
+{
+}
+
+TArray<int32> FRegexMatcher::FindMatchingInputs(const FRegexPattern& Pattern, TArrayView<const FString> Inputs)
+{
+	return TArray<int32>();
+}
+
 bool FRegexMatcher::FindNext()
 {
 	return false;
@@ -0,0 +1,346 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Internationalization/MappedTextLocalizationResource.h"
+#include "Internationalization/TextLocalizationResource.h"
+#include "Async/MappedFileHandle.h"
+#include "Containers/Map.h"
+#include "CoreGlobals.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/CityHash.h"
+#include "Logging/LogMacros.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMappedTextLocalizationResource, Log, All);
+
+/** Start of a LocMap file, followed by uint32 BucketSeeds[NumBuckets], FMappedTextLocalizationSlot Slots[NumSlots] and TCHAR Strings[NumStringChars] */
+struct FMappedTextLocalizationHeader
+{
+	static const uint32 ExpectedMagic = 0x50414D4C; // LMAP
+	static const uint32 LatestVersion = 1;
+
+	uint32 Magic;
+	uint32 Version;
+	uint32 CharSize;
+	uint32 NumEntries;
+	uint32 NumBuckets;
+	uint32 NumSlots;
+	uint32 NumStringChars;
+	uint32 Padding;
+};
+
+/** Offsets are in characters from the start of the strings, every string is null terminated */
+struct FMappedTextLocalizationSlot
+{
+	static const uint32 EmptyOffset = MAX_uint32;
+
+	uint32 NamespaceOffset;
+	uint32 KeyOffset;
+	uint32 LocalizedStringOffset;
+	uint32 LocalizedStringLen;
+	uint32 SourceStringHash;
+};
+
+namespace UE4MappedTextLocalizationResource_Private
+{
+	/** Hash and displace: an identity hashes to a bucket, and the seed of the bucket picks its slot from a second hash, chosen so that the entries of no two buckets share slots */
+	static uint64 HashTextId(const TCHAR* Namespace, const TCHAR* Key)
+	{
+		const uint64 NamespaceHash = CityHash64((const char*)Namespace, FCString::Strlen(Namespace) * sizeof(TCHAR));
+		return CityHash64WithSeed((const char*)Key, FCString::Strlen(Key) * sizeof(TCHAR), NamespaceHash);
+	}
+
+	static uint32 GetBucketIndex(const uint64 Hash, const uint32 NumBuckets)
+	{
+		return uint32((Hash >> 32) % NumBuckets);
+	}
+
+	static uint32 GetSlotIndex(const uint64 Hash, const uint32 Seed, const uint32 NumSlots)
+	{
+		uint64 Mixed = Hash ^ (uint64(Seed) * 0x9E3779B97F4A7C15ull);
+		Mixed = (Mixed ^ (Mixed >> 33)) * 0xFF51AFD7ED558CCDull;
+		Mixed = (Mixed ^ (Mixed >> 33)) * 0xC4CEB9FE1A85EC53ull;
+		return uint32((Mixed ^ (Mixed >> 33)) % NumSlots);
+	}
+
+	/** Seeds are tried in turn until the entries of a bucket land in free slots, 0 marks an empty bucket */
+	static const uint32 MaxSeed = 1 << 20;
+}
+
+FMappedTextLocalizationResource::FMappedTextLocalizationResource()
+{
+}
+
+FMappedTextLocalizationResource::~FMappedTextLocalizationResource()
+{
+	// The region has to be unmapped before the file is closed
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+TSharedPtr<FMappedTextLocalizationResource, ESPMode::ThreadSafe> FMappedTextLocalizationResource::Open(const FString& FilePath, const int32 Priority)
+{
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!MappedFile)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	if (!MappedRegion)
+	{
+		UE_LOG(LogMappedTextLocalizationResource, Warning, TEXT("LocMap '%s' could not be mapped!"), *FilePath);
+		return nullptr;
+	}
+
+	const uint8* Data = MappedRegion->GetMappedPtr();
+	const int64 Size = MappedRegion->GetMappedSize();
+	const FMappedTextLocalizationHeader* Header = (const FMappedTextLocalizationHeader*)Data;
+	if (Size < (int64)sizeof(FMappedTextLocalizationHeader) || Header->Magic != FMappedTextLocalizationHeader::ExpectedMagic)
+	{
+		UE_LOG(LogMappedTextLocalizationResource, Warning, TEXT("LocMap '%s' failed the magic number check!"), *FilePath);
+		return nullptr;
+	}
+	if (Header->Version != FMappedTextLocalizationHeader::LatestVersion || Header->CharSize != sizeof(TCHAR))
+	{
+		UE_LOG(LogMappedTextLocalizationResource, Warning, TEXT("LocMap '%s' was written for another version or platform (File Version: %u, Loader Version: %u)"), *FilePath, Header->Version, FMappedTextLocalizationHeader::LatestVersion);
+		return nullptr;
+	}
+
+	const int64 BucketSeedsOffset = sizeof(FMappedTextLocalizationHeader);
+	const int64 SlotsOffset = BucketSeedsOffset + int64(Header->NumBuckets) * sizeof(uint32);
+	const int64 StringsOffset = SlotsOffset + int64(Header->NumSlots) * sizeof(FMappedTextLocalizationSlot);
+	if (Header->NumBuckets == 0 || Header->NumSlots == 0 || StringsOffset + int64(Header->NumStringChars) * sizeof(TCHAR) > Size
+		|| (Header->NumStringChars > 0 && ((const TCHAR*)(Data + StringsOffset))[Header->NumStringChars - 1] != TEXT('\0')))
+	{
+		UE_LOG(LogMappedTextLocalizationResource, Warning, TEXT("LocMap '%s' is truncated or corrupt!"), *FilePath);
+		return nullptr;
+	}
+
+	TSharedPtr<FMappedTextLocalizationResource, ESPMode::ThreadSafe> Resource = MakeShareable(new FMappedTextLocalizationResource());
+	Resource->FilePath = FilePath;
+	Resource->LocResID = FTextKey(FilePath);
+	Resource->Priority = Priority;
+	Resource->Header = Header;
+	Resource->BucketSeeds = (const uint32*)(Data + BucketSeedsOffset);
+	Resource->Slots = (const FMappedTextLocalizationSlot*)(Data + SlotsOffset);
+	Resource->Strings = (const TCHAR*)(Data + StringsOffset);
+	Resource->MappedFile = MoveTemp(MappedFile);
+	Resource->MappedRegion = MoveTemp(MappedRegion);
+	return Resource;
+}
+
+bool FMappedTextLocalizationResource::SaveToFile(const FTextLocalizationResource& Resource, const FString& FilePath)
+{
+	using namespace UE4MappedTextLocalizationResource_Private;
+
+	struct FBuildEntry
+	{
+		uint64 Hash;
+		FMappedTextLocalizationSlot Slot;
+	};
+
+	// Strings are stored once however many entries use them, namespaces are shared by many
+	TArray<TCHAR> Strings;
+	TMap<FString, uint32> StringOffsets;
+	auto AddString = [&Strings, &StringOffsets](const TCHAR* String, const int32 Len) -> uint32
+	{
+		const FString Key(Len, String);
+		if (const uint32* Offset = StringOffsets.Find(Key))
+		{
+			return *Offset;
+		}
+		const uint32 Offset = Strings.Num();
+		Strings.Append(String, Len);
+		Strings.Add(TEXT('\0'));
+		StringOffsets.Add(Key, Offset);
+		return Offset;
+	};
+
+	TArray<FBuildEntry> Entries;
+	Entries.Reserve(Resource.Entries.Num());
+	for (const TPair<FTextId, FTextLocalizationResource::FEntry>& EntryPair : Resource.Entries)
+	{
+		const TCHAR* Namespace = EntryPair.Key.GetNamespace().GetChars();
+		const TCHAR* Key = EntryPair.Key.GetKey().GetChars();
+
+		FBuildEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Hash = HashTextId(Namespace, Key);
+		Entry.Slot.NamespaceOffset = AddString(Namespace, FCString::Strlen(Namespace));
+		Entry.Slot.KeyOffset = AddString(Key, FCString::Strlen(Key));
+		Entry.Slot.LocalizedStringOffset = AddString(*EntryPair.Value.LocalizedString, EntryPair.Value.LocalizedString.Len());
+		Entry.Slot.LocalizedStringLen = EntryPair.Value.LocalizedString.Len();
+		Entry.Slot.SourceStringHash = EntryPair.Value.SourceStringHash;
+	}
+
+	// About four entries a bucket, and slots for a load factor under 0.9 so that the last buckets find free slots quickly
+	const uint32 NumBuckets = FMath::Max(1, (Entries.Num() + 3) / 4);
+	const uint32 NumSlots = FMath::Max(1, Entries.Num() + Entries.Num() / 8 + 1);
+
+	TArray<TArray<int32>> Buckets;
+	Buckets.SetNum(NumBuckets);
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		Buckets[GetBucketIndex(Entries[EntryIndex].Hash, NumBuckets)].Add(EntryIndex);
+	}
+
+	// Place the largest buckets first, while most slots are free
+	TArray<uint32> BucketOrder;
+	for (uint32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+	{
+		BucketOrder.Add(BucketIndex);
+	}
+	BucketOrder.Sort([&Buckets](const uint32 A, const uint32 B) { return Buckets[A].Num() > Buckets[B].Num(); });
+
+	TArray<uint32> BucketSeeds;
+	BucketSeeds.SetNumZeroed(NumBuckets);
+	TArray<FMappedTextLocalizationSlot> Slots;
+	Slots.SetNumUninitialized(NumSlots);
+	for (FMappedTextLocalizationSlot& Slot : Slots)
+	{
+		Slot.NamespaceOffset = FMappedTextLocalizationSlot::EmptyOffset;
+		Slot.KeyOffset = FMappedTextLocalizationSlot::EmptyOffset;
+		Slot.LocalizedStringOffset = 0;
+		Slot.LocalizedStringLen = 0;
+		Slot.SourceStringHash = 0;
+	}
+
+	TArray<uint32, TInlineAllocator<16>> BucketSlots;
+	for (const uint32 BucketIndex : BucketOrder)
+	{
+		const TArray<int32>& Bucket = Buckets[BucketIndex];
+		if (Bucket.Num() == 0)
+		{
+			break;
+		}
+
+		uint32 Seed = 1;
+		for (; Seed < MaxSeed; ++Seed)
+		{
+			BucketSlots.Reset();
+			for (const int32 EntryIndex : Bucket)
+			{
+				const uint32 SlotIndex = GetSlotIndex(Entries[EntryIndex].Hash, Seed, NumSlots);
+				if (Slots[SlotIndex].KeyOffset != FMappedTextLocalizationSlot::EmptyOffset || BucketSlots.Contains(SlotIndex))
+				{
+					break;
+				}
+				BucketSlots.Add(SlotIndex);
+			}
+			if (BucketSlots.Num() == Bucket.Num())
+			{
+				break;
+			}
+		}
+
+		if (Seed == MaxSeed)
+		{
+			UE_LOG(LogMappedTextLocalizationResource, Error, TEXT("LocMap '%s' could not be indexed, no seed places the %d entries of a bucket"), *FilePath, Bucket.Num());
+			return false;
+		}
+
+		BucketSeeds[BucketIndex] = Seed;
+		for (int32 Index = 0; Index < Bucket.Num(); ++Index)
+		{
+			Slots[BucketSlots[Index]] = Entries[Bucket[Index]].Slot;
+		}
+	}
+
+	FMappedTextLocalizationHeader Header;
+	Header.Magic = FMappedTextLocalizationHeader::ExpectedMagic;
+	Header.Version = FMappedTextLocalizationHeader::LatestVersion;
+	Header.CharSize = sizeof(TCHAR);
+	Header.NumEntries = Entries.Num();
+	Header.NumBuckets = NumBuckets;
+	Header.NumSlots = NumSlots;
+	Header.NumStringChars = Strings.Num();
+	Header.Padding = 0;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogMappedTextLocalizationResource, Log, TEXT("LocMap '%s' could not be opened for writing!"), *FilePath);
+		return false;
+	}
+
+	Writer->Serialize(&Header, sizeof(Header));
+	Writer->Serialize(BucketSeeds.GetData(), BucketSeeds.Num() * sizeof(uint32));
+	Writer->Serialize(Slots.GetData(), Slots.Num() * sizeof(FMappedTextLocalizationSlot));
+	Writer->Serialize(Strings.GetData(), Strings.Num() * sizeof(TCHAR));
+
+	bool bSaved = !Writer->IsError();
+	bSaved &= Writer->Close();
+	return bSaved;
+}
+
+FString FMappedTextLocalizationResource::GetFilePathForLocRes(const FString& LocResFilePath)
+{
+	return FPaths::ChangeExtension(LocResFilePath, TEXT("locmap"));
+}
+
+bool FMappedTextLocalizationResource::Find(const FTextKey& Namespace, const FTextKey& Key, FEntry& OutEntry) const
+{
+	using namespace UE4MappedTextLocalizationResource_Private;
+
+	const uint64 Hash = HashTextId(Namespace.GetChars(), Key.GetChars());
+	const uint32 Seed = BucketSeeds[GetBucketIndex(Hash, Header->NumBuckets)];
+	if (Seed == 0)
+	{
+		return false;
+	}
+
+	// Any identity lands on some slot, so the stored identity is compared to tell whether it is this one
+	const FMappedTextLocalizationSlot& Slot = Slots[GetSlotIndex(Hash, Seed, Header->NumSlots)];
+	const uint32 NumStringChars = Header->NumStringChars;
+	if (Slot.NamespaceOffset >= NumStringChars || Slot.KeyOffset >= NumStringChars || uint64(Slot.LocalizedStringOffset) + Slot.LocalizedStringLen >= NumStringChars)
+	{
+		return false;
+	}
+	if (FCString::Strcmp(Strings + Slot.KeyOffset, Key.GetChars()) != 0 || FCString::Strcmp(Strings + Slot.NamespaceOffset, Namespace.GetChars()) != 0)
+	{
+		return false;
+	}
+
+	OutEntry.LocalizedString.Chars = Strings + Slot.LocalizedStringOffset;
+	OutEntry.LocalizedString.Len = Slot.LocalizedStringLen;
+	OutEntry.SourceStringHash = Slot.SourceStringHash;
+	return true;
+}
+
+int32 FMappedTextLocalizationResource::GetNum() const
+{
+	return Header->NumEntries;
+}
+
+static FAutoConsoleCommand CmdSaveMappedLocRes(
+	TEXT("Localization.SaveMappedLocRes"),
+	TEXT("Writes a LocMap file next to every LocRes file under the given directory, for Localization.UseMappedLocRes."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		if (Args.Num() != 1)
+		{
+			UE_LOG(LogConsoleResponse, Display, TEXT("Usage: Localization.SaveMappedLocRes <Directory>"));
+			return;
+		}
+
+		TArray<FString> LocResFilePaths;
+		IFileManager::Get().FindFilesRecursive(LocResFilePaths, *Args[0], TEXT("*.locres"), true, false);
+		for (const FString& LocResFilePath : LocResFilePaths)
+		{
+			// Read the LocRes itself, LoadFromFile would map the LocMap being replaced
+			FTextLocalizationResource Resource;
+			TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*LocResFilePath));
+			const FString LocMapFilePath = FMappedTextLocalizationResource::GetFilePathForLocRes(LocResFilePath);
+			if (Reader && Resource.LoadFromArchive(*Reader, FTextKey(LocResFilePath), 0) && Reader->Close()
+				&& FMappedTextLocalizationResource::SaveToFile(Resource, LocMapFilePath))
+			{
+				UE_LOG(LogConsoleResponse, Display, TEXT("Wrote %d entries to '%s'"), Resource.Entries.Num(), *LocMapFilePath);
+			}
+			else
+			{
+				UE_LOG(LogConsoleResponse, Warning, TEXT("Could not convert '%s'"), *LocResFilePath);
+			}
+		}
+	})
+	);
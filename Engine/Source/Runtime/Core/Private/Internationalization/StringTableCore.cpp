@@ -363,7 +363,7 @@ bool FStringTable::ExportStrings(const FString& InFilename) const
 		for (const FName MetaDataColumnName : MetaDataColumnNames)
 		{
 			ExportedStrings += TEXT(",");
-			ExportedStrings += MetaDataColumnName.ToString();
+			MetaDataColumnName.AppendString(ExportedStrings);
 		}
 		ExportedStrings += TEXT("\n");
 
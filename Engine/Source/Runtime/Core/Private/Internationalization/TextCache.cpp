@@ -2,7 +2,6 @@
 
 #include "Internationalization/TextCache.h"
 #include "Misc/LazySingleton.h"
-#include "Misc/ScopeLock.h"
 
 FTextCache& FTextCache::Get()
 {
@@ -17,19 +16,19 @@ void FTextCache::TearDown()
 FText FTextCache::FindOrCache(const TCHAR* InTextLiteral, const TCHAR* InNamespace, const TCHAR* InKey)
 {
 	const FTextId TextId(InNamespace, InKey);
+	const uint32 TextIdHash = GetTypeHash(TextId);
+	auto MatchesTextId = [&TextId](const FCachedText& InCachedText)
+	{
+		return InCachedText.TextId == TextId;
+	};
 
 	// First try and find a cached instance
+	if (const FCachedText* FoundText = CachedText.Find(TextIdHash, MatchesTextId))
 	{
-		FScopeLock Lock(&CachedTextCS);
-	
-		const FText* FoundText = CachedText.Find(TextId);
-		if (FoundText)
+		const FString* FoundTextLiteral = FTextInspector::GetSourceString(FoundText->Text);
+		if (FoundTextLiteral && FCString::Strcmp(**FoundTextLiteral, InTextLiteral) == 0)
 		{
-			const FString* FoundTextLiteral = FTextInspector::GetSourceString(*FoundText);
-			if (FoundTextLiteral && FCString::Strcmp(**FoundTextLiteral, InTextLiteral) == 0)
-			{
-				return *FoundText;
-			}
+			return FoundText->Text;
 		}
 	}
 
@@ -37,11 +36,7 @@ FText FTextCache::FindOrCache(const TCHAR* InTextLiteral, const TCHAR* InNamespa
 	FText NewText = FText(InTextLiteral, TextId.GetNamespace(), TextId.GetKey(), ETextFlag::Immutable);
 
 	// ... and add it to the cache
-	{
-		FScopeLock Lock(&CachedTextCS);
-
-		CachedText.Emplace(TextId, NewText);
-	}
+	CachedText.AddOrReplace(TextIdHash, MatchesTextId, FCachedText{ TextId, NewText });
 
 	return NewText;
-}
\ No newline at end of file
+}
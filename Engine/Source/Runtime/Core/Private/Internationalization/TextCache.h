@@ -3,9 +3,9 @@
 #pragma once
 
 #include "CoreTypes.h"
-#include "Containers/Map.h"
 #include "Internationalization/Text.h"
 #include "Internationalization/TextKey.h"
+#include "Internationalization/TextInternTable.h"
 
 /** Caches FText instances generated via the LOCTEXT macro to avoid repeated constructions */
 class FTextCache
@@ -24,6 +24,12 @@ public:
 
 
 private:
-	TMap<FTextId, FText> CachedText;
-	FCriticalSection CachedTextCS;
+	struct FCachedText
+	{
+		FTextId TextId;
+		FText Text;
+	};
+
+	/** Lock-free to find in, an entry is only replaced when the same identity is used with a different literal */
+	TTextInternTable<FCachedText> CachedText;
 };
@@ -320,7 +320,7 @@ void FTextFormatArgumentModifier_PluralForm::Evaluate(const FFormatArgumentValue
 		}
 	}
 
-	OutResult += FTextFormatter::Format(CompiledPluralForms[(int32)ValuePluralForm], InFormatArgs);
+	FTextFormatter::FormatInto(CompiledPluralForms[(int32)ValuePluralForm], InFormatArgs, OutResult);
 }
 
 void FTextFormatArgumentModifier_PluralForm::GetFormatArgumentNames(TArray<FString>& OutArgumentNames) const
@@ -412,13 +412,13 @@ void FTextFormatArgumentModifier_GenderForm::Evaluate(const FFormatArgumentValue
 		switch (InValue.GetGenderValue())
 		{
 		case ETextGender::Masculine:
-			OutResult += FTextFormatter::Format(MasculineForm, InFormatArgs);
+			FTextFormatter::FormatInto(MasculineForm, InFormatArgs, OutResult);
 			break;
 		case ETextGender::Feminine:
-			OutResult += FTextFormatter::Format(FeminineForm, InFormatArgs);
+			FTextFormatter::FormatInto(FeminineForm, InFormatArgs, OutResult);
 			break;
 		case ETextGender::Neuter:
-			OutResult += FTextFormatter::Format(NeuterForm, InFormatArgs);
+			FTextFormatter::FormatInto(NeuterForm, InFormatArgs, OutResult);
 			break;
 		default:
 			break;
@@ -371,10 +371,10 @@ public:
 	/**
 	 * Produce a formatted string using the given argument look-up.
 	 */
-	FORCEINLINE FString Format(const FPrivateTextFormatArguments& InFormatArgs)
+	FORCEINLINE void Format(const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult)
 	{
 		FScopeLock Lock(&CompiledDataCS);
-		return Format_NoLock(InFormatArgs);
+		Format_NoLock(InFormatArgs, OutResult);
 	}
 
 	/**
@@ -447,10 +447,10 @@ private:
 	bool ValidatePattern_NoLock(const FCulturePtr& InCulture, TArray<FString>& OutValidationErrors);
 
 	/**
-	 * Produce a formatted string using the given argument look-up.
+	 * Append a formatted string to OutResult using the given argument look-up.
 	 * Internal version that doesn't lock, so the calling code must handle that!
 	 */
-	FString Format_NoLock(const FPrivateTextFormatArguments& InFormatArgs);
+	void Format_NoLock(const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult);
 
 	/**
 	 * Append the names of any arguments to the given array.
@@ -759,7 +759,7 @@ bool FTextFormatData::ValidatePattern_NoLock(const FCulturePtr& InCulture, TArra
 	return bIsValidPattern;
 }
 
-FString FTextFormatData::Format_NoLock(const FPrivateTextFormatArguments& InFormatArgs)
+void FTextFormatData::Format_NoLock(const FPrivateTextFormatArguments& InFormatArgs, FString& ResultString)
 {
 	if (SourceType == ESourceType::Text && InFormatArgs.bRebuildText)
 	{
@@ -770,11 +770,11 @@ FString FTextFormatData::Format_NoLock(const FPrivateTextFormatArguments& InForm
 
 	if (LexedExpression.Num() == 0)
 	{
-		return SourceExpression;
+		ResultString += SourceExpression;
+		return;
 	}
 
-	FString ResultString;
-	ResultString.Reserve(BaseFormatStringLength + (InFormatArgs.EstimatedArgumentValuesLength * FormatArgumentEstimateMultiplier));
+	ResultString.Reserve(ResultString.Len() + BaseFormatStringLength + (InFormatArgs.EstimatedArgumentValuesLength * FormatArgumentEstimateMultiplier));
 
 	int32 ArgumentIndex = 0;
 	for (int32 TokenIndex = 0; TokenIndex < LexedExpression.Num(); ++TokenIndex)
@@ -824,8 +824,6 @@ FString FTextFormatData::Format_NoLock(const FPrivateTextFormatArguments& InForm
 			ResultString.AppendChars(ArgumentModifierToken->ModifierPatternStartPos, ArgumentModifierToken->ModifierPatternLen);
 		}
 	}
-
-	return ResultString;
 }
 
 void FTextFormatData::GetFormatArgumentNames_NoLock(TArray<FString>& OutArgumentNames)
@@ -1041,6 +1039,13 @@ FString FTextFormatter::FormatStr(const FTextFormat& InFmt, const TArray<FFormat
 }
 
 FString FTextFormatter::Format(const FTextFormat& InFmt, const FPrivateTextFormatArguments& InFormatArgs)
+{
+	FString Result;
+	FormatInto(InFmt, InFormatArgs, Result);
+	return Result;
+}
+
+void FTextFormatter::FormatInto(const FTextFormat& InFmt, const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult)
 {
 	FTextFormat FmtPattern = InFmt;
 
@@ -1058,7 +1063,7 @@ FString FTextFormatter::Format(const FTextFormat& InFmt, const FPrivateTextForma
 		FmtPattern = FTextFormat(FmtText.BuildSourceString(), FmtPattern.GetPatternDefinition());
 	}
 
-	return FmtPattern.TextFormatData->Format(InFormatArgs);
+	FmtPattern.TextFormatData->Format(InFormatArgs, OutResult);
 }
 
 void FTextFormatter::ArgumentValueToFormattedString(const FFormatArgumentValue& InValue, const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult)
@@ -1084,4 +1089,65 @@ int32 FTextFormatter::EstimateArgumentValueLength(const FFormatArgumentValue& Ar
 	return 0;
 }
 
+namespace TextFormatTokens
+{
+	static int32 FindPreparedTextFormatSlot(const TArray<FString>& InArgumentNames, const FArgumentTokenSpecifier& InArgumentToken)
+	{
+		return InArgumentNames.IndexOfByPredicate([&InArgumentToken](const FString& InName)
+		{
+			return InArgumentToken.ArgumentNameLen == InName.Len() && FCString::Strncmp(InArgumentToken.ArgumentNameStartPos, *InName, InArgumentToken.ArgumentNameLen) == 0;
+		});
+	}
+}
+
+FPreparedTextFormat::FPreparedTextFormat(FTextFormat InFmt, TArray<FString> InArgumentNames)
+	: Fmt(MoveTemp(InFmt))
+	, ArgumentNames(MoveTemp(InArgumentNames))
+{
+	// Without values the formatter visits the top-level arguments in order, and doesn't evaluate any argument modifier
+	auto BindArgument = [this](const TextFormatTokens::FArgumentTokenSpecifier& ArgumentToken, int32 ArgumentNumber) -> const FFormatArgumentValue*
+	{
+		SlotsByArgumentNumber.SetNum(FMath::Max(SlotsByArgumentNumber.Num(), ArgumentNumber + 1));
+		SlotsByArgumentNumber[ArgumentNumber] = TextFormatTokens::FindPreparedTextFormatSlot(ArgumentNames, ArgumentToken);
+		return nullptr;
+	};
+
+	FString Unused;
+	FTextFormatter::FormatInto(Fmt, FPrivateTextFormatArguments(FPrivateTextFormatArguments::FGetArgumentValue(BindArgument), 0, false, false), Unused);
+}
+
+const FString& FPreparedTextFormat::FormatToString(TArrayView<const FFormatArgumentValue> InValues) const
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		checkf(FInternationalization::Get().IsInitialized() == true, TEXT("FInternationalization is not initialized. An FText formatting method was likely used in static object initialization - this is not supported."));
+	}
+
+	auto GetArgumentValue = [this, InValues](const TextFormatTokens::FArgumentTokenSpecifier& ArgumentToken, int32 ArgumentNumber) -> const FFormatArgumentValue*
+	{
+		// The bound slot is right unless the token belongs to the pattern of an argument modifier or the pattern was recompiled for another culture
+		int32 Slot = SlotsByArgumentNumber.IsValidIndex(ArgumentNumber) ? SlotsByArgumentNumber[ArgumentNumber] : INDEX_NONE;
+		if (!ArgumentNames.IsValidIndex(Slot) || ArgumentToken.ArgumentNameLen != ArgumentNames[Slot].Len() || FCString::Strncmp(ArgumentToken.ArgumentNameStartPos, *ArgumentNames[Slot], ArgumentToken.ArgumentNameLen) != 0)
+		{
+			Slot = TextFormatTokens::FindPreparedTextFormatSlot(ArgumentNames, ArgumentToken);
+		}
+		return InValues.IsValidIndex(Slot) ? &InValues[Slot] : nullptr;
+	};
+
+	static thread_local FString Result;
+	Result.Reset();
+	FTextFormatter::FormatInto(Fmt, FPrivateTextFormatArguments(FPrivateTextFormatArguments::FGetArgumentValue(GetArgumentValue), 0, false, false), Result);
+	return Result;
+}
+
+FText FPreparedTextFormat::FormatText(TArrayView<const FFormatArgumentValue> InValues) const
+{
+	FFormatNamedArguments Arguments;
+	for (int32 Slot = 0; Slot < FMath::Min(ArgumentNames.Num(), InValues.Num()); ++Slot)
+	{
+		Arguments.Add(ArgumentNames[Slot], InValues[Slot]);
+	}
+	return FTextFormatter::Format(CopyTemp(Fmt), MoveTemp(Arguments), false, false);
+}
+
 #undef LOCTEXT_NAMESPACE
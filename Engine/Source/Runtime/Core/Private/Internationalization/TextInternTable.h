@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Atomic.h"
+#include "Templates/UnrealTemplate.h"
+
+/**
+ * Sharded hash table of immutable values, used to intern FTextKey strings and to cache LOCTEXT instances so that parallel
+ * loading doesn't serialize on one lock. Finds are lock-free: a value is published in its slot with an atomic store once written,
+ * and neither the values nor the slot tables they were found in are freed until the table is destroyed. Writers take the lock of their shard.
+ *
+ * Replacing a value publishes a new value in the same slot and retires the old one, so a pointer returned by Find stays valid
+ * for the lifetime of the table. Tables at least double when they grow, so the retired tables add up to less than the live ones.
+ */
+template <typename ValueType, uint32 NumShardBits = 6>
+class TTextInternTable : FNoncopyable
+{
+public:
+	TTextInternTable()
+	{
+		for (FShard& Shard : Shards)
+		{
+			Shard.Table = FSlotTable::Allocate(InitialCapacity);
+		}
+	}
+
+	~TTextInternTable()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FSlotTable* Table = Shard.Table.Load(EMemoryOrder::Relaxed);
+			for (uint32 SlotIndex = 0; SlotIndex < Table->Capacity(); ++SlotIndex)
+			{
+				delete Table->GetSlots()[SlotIndex].Load(EMemoryOrder::Relaxed);
+			}
+			FMemory::Free(Table);
+
+			for (FSlotTable* RetiredTable : Shard.RetiredTables)
+			{
+				FMemory::Free(RetiredTable);
+			}
+			for (FNode* RetiredNode : Shard.RetiredNodes)
+			{
+				delete RetiredNode;
+			}
+		}
+	}
+
+	/** Find the value of the given hash that the predicate matches, without locking */
+	template <typename PredicateType>
+	const ValueType* Find(const uint32 InHash, PredicateType Predicate) const
+	{
+		const FShard& Shard = GetShard(InHash);
+		const FSlotTable* Table = Shard.Table.Load(EMemoryOrder::SequentiallyConsistent);
+		const TAtomic<FNode*>* Slots = Table->GetSlots();
+		for (uint32 SlotIndex = GetProbeStart(InHash, Table); true; SlotIndex = (SlotIndex + 1) & Table->CapacityMask)
+		{
+			const FNode* Node = Slots[SlotIndex].Load(EMemoryOrder::SequentiallyConsistent);
+			if (!Node)
+			{
+				return nullptr;
+			}
+			if (Node->Hash == InHash && Predicate(Node->Value))
+			{
+				return &Node->Value;
+			}
+		}
+	}
+
+	/** Find the value of the given hash that the predicate matches, or add the value made by the factory */
+	template <typename PredicateType, typename FactoryType>
+	const ValueType& FindOrAdd(const uint32 InHash, PredicateType Predicate, FactoryType Factory)
+	{
+		// A find racing with the insertion of the same value can miss it, so the slow path looks again under the lock
+		if (const ValueType* Found = Find(InHash, Predicate))
+		{
+			return *Found;
+		}
+
+		FShard& Shard = GetShard(InHash);
+		FScopeLock ScopeLock(&Shard.Lock);
+
+		TAtomic<FNode*>& Slot = Probe(Shard, InHash, Predicate);
+		if (FNode* Node = Slot.Load(EMemoryOrder::Relaxed))
+		{
+			return Node->Value;
+		}
+		return Publish(Shard, Slot, new FNode(InHash, Factory()))->Value;
+	}
+
+	/** Add the given value, replacing any value of the given hash that the predicate matches */
+	template <typename PredicateType>
+	const ValueType& AddOrReplace(const uint32 InHash, PredicateType Predicate, ValueType&& InValue)
+	{
+		FShard& Shard = GetShard(InHash);
+		FScopeLock ScopeLock(&Shard.Lock);
+
+		TAtomic<FNode*>& Slot = Probe(Shard, InHash, Predicate);
+		if (FNode* OldNode = Slot.Load(EMemoryOrder::Relaxed))
+		{
+			// Readers may still be using the old value
+			FNode* NewNode = new FNode(InHash, MoveTemp(InValue));
+			Slot.Store(NewNode, EMemoryOrder::SequentiallyConsistent);
+			Shard.RetiredNodes.Add(OldNode);
+			return NewNode->Value;
+		}
+		return Publish(Shard, Slot, new FNode(InHash, MoveTemp(InValue)))->Value;
+	}
+
+private:
+	static const uint32 NumShards = 1 << NumShardBits;
+	static const uint32 InitialCapacity = 64;
+	enum { LoadFactorQuotient = 3, LoadFactorDivisor = 4 }; // I.e. grow the slots when 75% full
+
+	struct FNode
+	{
+		FNode(const uint32 InHash, ValueType&& InValue)
+			: Hash(InHash)
+			, Value(MoveTemp(InValue))
+		{
+		}
+
+		uint32 Hash;
+		ValueType Value;
+	};
+
+	/** Open addressing slots of one shard, the header is followed by Capacity() slots */
+	struct alignas(TAtomic<FNode*>) FSlotTable
+	{
+		uint32 CapacityMask;
+
+		uint32 Capacity() const { return CapacityMask + 1; }
+
+		TAtomic<FNode*>* GetSlots() { return reinterpret_cast<TAtomic<FNode*>*>(this + 1); }
+		const TAtomic<FNode*>* GetSlots() const { return reinterpret_cast<const TAtomic<FNode*>*>(this + 1); }
+
+		static FSlotTable* Allocate(const uint32 InCapacity)
+		{
+			FSlotTable* Table = (FSlotTable*)FMemory::Malloc(sizeof(FSlotTable) + InCapacity * sizeof(TAtomic<FNode*>), alignof(TAtomic<FNode*>));
+			Table->CapacityMask = InCapacity - 1;
+			FMemory::Memzero(Table->GetSlots(), InCapacity * sizeof(TAtomic<FNode*>));
+			return Table;
+		}
+	};
+
+	static_assert(sizeof(FSlotTable) % alignof(TAtomic<FNode*>) == 0, "Slots must follow the table header aligned");
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		TAtomic<FSlotTable*> Table;
+		FCriticalSection Lock;
+		uint32 NumUsedSlots = 0;
+		TArray<FSlotTable*> RetiredTables;
+		TArray<FNode*> RetiredNodes;
+	};
+
+	FORCEINLINE FShard& GetShard(const uint32 InHash)
+	{
+		return Shards[InHash & (NumShards - 1)];
+	}
+
+	FORCEINLINE const FShard& GetShard(const uint32 InHash) const
+	{
+		return Shards[InHash & (NumShards - 1)];
+	}
+
+	/** The bits that picked the shard are the same for the whole shard, so the slots are picked by the others */
+	static FORCEINLINE uint32 GetProbeStart(const uint32 InHash, const FSlotTable* InTable)
+	{
+		return (InHash >> NumShardBits) & InTable->CapacityMask;
+	}
+
+	/** Find the slot of the matching value or the free slot it would go in, must be called with the lock of the shard held */
+	template <typename PredicateType>
+	static TAtomic<FNode*>& Probe(FShard& InShard, const uint32 InHash, PredicateType Predicate)
+	{
+		FSlotTable* Table = InShard.Table.Load(EMemoryOrder::Relaxed);
+		TAtomic<FNode*>* Slots = Table->GetSlots();
+		for (uint32 SlotIndex = GetProbeStart(InHash, Table); true; SlotIndex = (SlotIndex + 1) & Table->CapacityMask)
+		{
+			const FNode* Node = Slots[SlotIndex].Load(EMemoryOrder::Relaxed);
+			if (!Node || (Node->Hash == InHash && Predicate(Node->Value)))
+			{
+				return Slots[SlotIndex];
+			}
+		}
+	}
+
+	/** Claim a free slot for the given node, which must be fully constructed as lock-free finds can see it right away */
+	static FNode* Publish(FShard& InShard, TAtomic<FNode*>& InFreeSlot, FNode* InNode)
+	{
+		InFreeSlot.Store(InNode, EMemoryOrder::SequentiallyConsistent);
+
+		FSlotTable* Table = InShard.Table.Load(EMemoryOrder::Relaxed);
+		if (++InShard.NumUsedSlots * LoadFactorDivisor >= Table->Capacity() * LoadFactorQuotient)
+		{
+			Grow(InShard, Table);
+		}
+		return InNode;
+	}
+
+	static void Grow(FShard& InShard, FSlotTable* InOldTable)
+	{
+		FSlotTable* NewTable = FSlotTable::Allocate(InOldTable->Capacity() * 2);
+		TAtomic<FNode*>* NewSlots = NewTable->GetSlots();
+		for (uint32 OldSlotIndex = 0; OldSlotIndex < InOldTable->Capacity(); ++OldSlotIndex)
+		{
+			if (FNode* Node = InOldTable->GetSlots()[OldSlotIndex].Load(EMemoryOrder::Relaxed))
+			{
+				uint32 SlotIndex = GetProbeStart(Node->Hash, NewTable);
+				while (NewSlots[SlotIndex].Load(EMemoryOrder::Relaxed))
+				{
+					SlotIndex = (SlotIndex + 1) & NewTable->CapacityMask;
+				}
+				NewSlots[SlotIndex].Store(Node, EMemoryOrder::Relaxed);
+			}
+		}
+
+		// Publish the fully built table, readers may still be probing the old one so it is retired rather than freed
+		InShard.Table.Store(NewTable, EMemoryOrder::SequentiallyConsistent);
+		InShard.RetiredTables.Add(InOldTable);
+	}
+
+	FShard Shards[NumShards];
+};
@@ -7,8 +7,8 @@
 #include "Misc/Crc.h"
 #include "Misc/ByteSwap.h"
 #include "Misc/LazySingleton.h"
-#include "Misc/ScopeLock.h"
 #include "Logging/LogMacros.h"
+#include "Internationalization/TextInternTable.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTextKey, Log, All);
 
@@ -19,84 +19,36 @@ public:
 	{
 		check(*InStr != 0);
 
-		FScopeLock ScopeLock(&SynchronizationObject);
-
-		const FKeyData SrcKey(InStr, InStrLen);
-		const FString* StrPtr = KeysTable.Find(SrcKey);
-		if (!StrPtr)
-		{
-			FString StrCopy = CopyString(InStrLen, InStr); // Need to copy the string here so we can reference its internal allocation as the key
-			const FKeyData DestKey(*StrCopy, StrCopy.Len(), SrcKey.StrHash);
-			StrPtr = &KeysTable.Add(DestKey, MoveTemp(StrCopy));
-			check(DestKey.Str == **StrPtr); // The move must have moved the allocation we referenced in the key
-		}
-
-		OutStrPtr = **StrPtr;
-		OutStrHash = SrcKey.StrHash;
+		OutStrHash = FCrc::StrCrc32(InStr); // Note: This hash gets serialized so *DO NOT* change it
+		OutStrPtr = *FindOrAddImpl(InStr, InStrLen, OutStrHash, [InStr, InStrLen]() { return CopyString(InStrLen, InStr); });
 	}
 
 	void FindOrAdd(const TCHAR* InStr, const int32 InStrLen, const uint32 InStrHash, const TCHAR*& OutStrPtr)
 	{
 		check(*InStr != 0);
 
-		FScopeLock ScopeLock(&SynchronizationObject);
-
-		const FKeyData SrcKey(InStr, InStrLen, InStrHash);
-		const FString* StrPtr = KeysTable.Find(SrcKey);
-		if (!StrPtr)
-		{
-			FString StrCopy = CopyString(InStrLen, InStr); // Need to copy the string here so we can reference its internal allocation as the key
-			const FKeyData DestKey(*StrCopy, StrCopy.Len(), SrcKey.StrHash);
-			StrPtr = &KeysTable.Add(DestKey, MoveTemp(StrCopy));
-			check(DestKey.Str == **StrPtr); // The move must have moved the allocation we referenced in the key
-		}
-
-		OutStrPtr = **StrPtr;
+		OutStrPtr = *FindOrAddImpl(InStr, InStrLen, InStrHash, [InStr, InStrLen]() { return CopyString(InStrLen, InStr); });
 	}
 
 	void FindOrAdd(const FString& InStr, const TCHAR*& OutStrPtr, uint32& OutStrHash)
 	{
 		check(!InStr.IsEmpty());
 
-		FScopeLock ScopeLock(&SynchronizationObject);
-
-		const FKeyData SrcKey(*InStr, InStr.Len());
-		const FString* StrPtr = KeysTable.Find(SrcKey);
-		if (!StrPtr)
-		{
-			FString StrCopy = InStr; // Need to copy the string here so we can reference its internal allocation as the key
-			const FKeyData DestKey(*StrCopy, StrCopy.Len(), SrcKey.StrHash);
-			StrPtr = &KeysTable.Add(DestKey, MoveTemp(StrCopy));
-			check(DestKey.Str == **StrPtr); // The move must have moved the allocation we referenced in the key
-		}
-		
-		OutStrPtr = **StrPtr;
-		OutStrHash = SrcKey.StrHash;
+		OutStrHash = FCrc::StrCrc32(*InStr);
+		OutStrPtr = *FindOrAddImpl(*InStr, InStr.Len(), OutStrHash, [&InStr]() { return CopyString(InStr.Len(), *InStr); });
 	}
 
 	void FindOrAdd(FString&& InStr, const TCHAR*& OutStrPtr, uint32& OutStrHash)
 	{
 		check(!InStr.IsEmpty());
 
-		FScopeLock ScopeLock(&SynchronizationObject);
-
-		const FKeyData SrcKey(*InStr, InStr.Len());
-		const FString* StrPtr = KeysTable.Find(SrcKey);
-		if (!StrPtr)
-		{
-			const FKeyData DestKey(*InStr, InStr.Len(), SrcKey.StrHash);
-			StrPtr = &KeysTable.Add(DestKey, MoveTemp(InStr));
-			check(DestKey.Str == **StrPtr); // The move must have moved the allocation we referenced in the key
-		}
-
-		OutStrPtr = **StrPtr;
-		OutStrHash = SrcKey.StrHash;
+		OutStrHash = FCrc::StrCrc32(*InStr);
+		OutStrPtr = *FindOrAddImpl(*InStr, InStr.Len(), OutStrHash, [&InStr]() { return MoveTemp(InStr); });
 	}
 
 	void Shrink()
 	{
-		FScopeLock ScopeLock(&SynchronizationObject);
-		KeysTable.Shrink();
+		// Nothing to compact, the interned strings are allocated without slack and the tables only grow by their load factor
 	}
 
 	static FTextKeyState& GetState()
@@ -110,45 +62,18 @@ public:
 	}
 
 private:
-	struct FKeyData
+	/** Finds are lock-free, so keys made by parallel loading only contend when they add the same shard at once */
+	template <typename FactoryType>
+	const FString& FindOrAddImpl(const TCHAR* InStr, const int32 InStrLen, const uint32 InStrHash, FactoryType Factory)
 	{
-		FKeyData(const TCHAR* InStr, const int32 InStrLen)
-			: Str(InStr)
-			, StrLen(InStrLen)
-			, StrHash(FCrc::StrCrc32(Str)) // Note: This hash gets serialized so *DO NOT* change it
-		{
-		}
-
-		FKeyData(const TCHAR* InStr, const int32 InStrLen, const uint32 InStrHash)
-			: Str(InStr)
-			, StrLen(InStrLen)
-			, StrHash(InStrHash)
-		{
-		}
-
-		friend FORCEINLINE bool operator==(const FKeyData& A, const FKeyData& B)
+		return KeysTable.FindOrAdd(InStrHash, [InStr, InStrLen](const FString& InKeyStr)
 		{
 			// We can use Memcmp here as we know we're comparing two blocks of the same size and don't care about lexical ordering
-			return A.StrLen == B.StrLen && FMemory::Memcmp(A.Str, B.Str, A.StrLen * sizeof(TCHAR)) == 0;
-		}
-
-		friend FORCEINLINE bool operator!=(const FKeyData& A, const FKeyData& B)
-		{
-			// We can use Memcmp here as we know we're comparing two blocks of the same size and don't care about lexical ordering
-			return A.StrLen != B.StrLen || FMemory::Memcmp(A.Str, B.Str, A.StrLen * sizeof(TCHAR)) != 0;
-		}
-
-		friend FORCEINLINE uint32 GetTypeHash(const FKeyData& A)
-		{
-			return A.StrHash;
-		}
-
-		const TCHAR* Str;
-		int32 StrLen;
-		uint32 StrHash;
-	};
+			return InKeyStr.Len() == InStrLen && FMemory::Memcmp(*InKeyStr, InStr, InStrLen * sizeof(TCHAR)) == 0;
+		}, Factory);
+	}
 
-	FORCEINLINE FString CopyString(const int32 InStrLen, const TCHAR* InStr)
+	static FORCEINLINE FString CopyString(const int32 InStrLen, const TCHAR* InStr)
 	{
 		// We do this rather than use the FString constructor directly, 
 		// as this method avoids slack being added to the allocation
@@ -158,8 +83,8 @@ private:
 		return Str;
 	}
 
-	FCriticalSection SynchronizationObject;
-	TMap<FKeyData, FString> KeysTable;
+	/** The interned strings, which are never moved or freed until tear down so that keys can reference their allocations */
+	TTextInternTable<FString> KeysTable;
 };
 
 namespace TextKeyUtil
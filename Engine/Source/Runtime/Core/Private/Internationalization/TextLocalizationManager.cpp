@@ -23,6 +23,7 @@
 #include "Misc/App.h"
 #include "Misc/CoreDelegates.h"
 #include "Templates/UniquePtr.h"
+#include "ProfilingDebugging/StartupPhases.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTextLocalizationManager, Log, All);
 
@@ -308,6 +309,7 @@ void BeginInitTextLocalization()
 	LLM_SCOPE(ELLMTag::Localization);
 
 	SCOPED_BOOT_TIMING("BeginInitTextLocalization");
+	SCOPED_STARTUP_PHASE(TEXT("Internationalization"), TEXT("CommandLine"));
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("BeginInitTextLocalization"), STAT_BeginInitTextLocalization, STATGROUP_LoadTime);
 
 	// Initialize FInternationalization before we bind to OnCultureChanged, otherwise we can accidentally initialize
@@ -321,6 +323,7 @@ void InitEngineTextLocalization()
 	LLM_SCOPE(ELLMTag::Localization);
 	
 	SCOPED_BOOT_TIMING("InitEngineTextLocalization");
+	SCOPED_STARTUP_PHASE(TEXT("EngineTextLocalization"), TEXT("ConfigSystem"), TEXT("Internationalization"));
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("InitEngineTextLocalization"), STAT_InitEngineTextLocalization, STATGROUP_LoadTime);
 
 	// Make sure the String Table Registry is initialized as it may trigger module loads
@@ -373,6 +376,7 @@ void InitGameTextLocalization()
 	LLM_SCOPE(ELLMTag::Localization);
 
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("InitGameTextLocalization"), STAT_InitGameTextLocalization, STATGROUP_LoadTime);
+	SCOPED_STARTUP_PHASE(TEXT("GameTextLocalization"), TEXT("EngineTextLocalization"));
 
 	ELocalizationLoadFlags LocLoadFlags = ELocalizationLoadFlags::None;
 	LocLoadFlags |= (FApp::IsGame() ? ELocalizationLoadFlags::Game : ELocalizationLoadFlags::None);
@@ -575,6 +579,11 @@ FTextDisplayStringPtr FTextLocalizationManager::FindDisplayString(const FTextKey
 		return LiveEntry->DisplayString;
 	}
 
+	if ( LiveEntry == nullptr )
+	{
+		return AddDisplayStringFromMapped(TextId, SourceString, SourceString ? FTextLocalizationResource::HashString(*SourceString) : 0);
+	}
+
 	return nullptr;
 }
 
@@ -683,6 +692,12 @@ FTextDisplayStringRef FTextLocalizationManager::GetDisplayString(const FTextKey&
 	// Entry is absent.
 	else
 	{
+		// LocMap files are only copied from as their strings are used
+		if (FTextDisplayStringPtr MappedDisplayString = AddDisplayStringFromMapped(TextId, SourceString, SourceStringHash))
+		{
+			return MappedDisplayString.ToSharedRef();
+		}
+
 		// Don't log warnings about unlocalized strings if the system hasn't been initialized - we simply don't have localization data yet.
 		if (bIsInitialized)
 		{
@@ -992,6 +1007,13 @@ void FTextLocalizationManager::LoadLocalizationResourcesForPrioritizedCultures(T
 	}
 #endif
 
+	// The LocMap files of the previous culture no longer apply to entries that are added
+	{
+		FScopeLock ScopeLock(&SynchronizationObject);
+		NativeMappedResources.Reset();
+		LocalizedMappedResources.Reset();
+	}
+
 	// Load the resources from each text source
 	FTextLocalizationResource NativeResource;
 	FTextLocalizationResource LocalizedResource;
@@ -1047,6 +1069,8 @@ void FTextLocalizationManager::UpdateFromNative(FTextLocalizationResource&& Text
 		DisplayStringLookupTable.Reserve(TextLocalizationResource.Entries.Num());
 		NamespaceKeyLookupTable.Reserve(TextLocalizationResource.Entries.Num());
 
+		UpdateFromMapped(MoveTemp(TextLocalizationResource.MappedResources), NativeMappedResources);
+
 		// Add/update entries
 		// Note: This code doesn't handle "leet-ification" itself as it is resetting everything to a known "good" state ("leet-ification" happens later on the "good" native text)
 		for (auto& EntryPair : TextLocalizationResource.Entries)
@@ -1151,6 +1175,8 @@ void FTextLocalizationManager::UpdateFromLocalizations(FTextLocalizationResource
 		DisplayStringLookupTable.Reserve(TextLocalizationResource.Entries.Num());
 		NamespaceKeyLookupTable.Reserve(TextLocalizationResource.Entries.Num());
 
+		UpdateFromMapped(MoveTemp(TextLocalizationResource.MappedResources), LocalizedMappedResources);
+
 		// Add/update entries
 		for (auto& EntryPair : TextLocalizationResource.Entries)
 		{
@@ -1247,6 +1273,108 @@ void FTextLocalizationManager::UpdateFromLocalizations(FTextLocalizationResource
 	}
 }
 
+static bool FindMappedEntry(const TArray<FMappedTextLocalizationResourceRef>& MappedResources, const FTextId& TextId, const FMappedTextLocalizationResource*& OutMappedResource, FMappedTextLocalizationResource::FEntry& OutMappedEntry)
+{
+	// Sorted by priority, so the first one found is the one to use
+	for (const FMappedTextLocalizationResourceRef& MappedResource : MappedResources)
+	{
+		if (MappedResource->Find(TextId.GetNamespace(), TextId.GetKey(), OutMappedEntry))
+		{
+			OutMappedResource = &MappedResource.Get();
+			return true;
+		}
+	}
+	return false;
+}
+
+void FTextLocalizationManager::UpdateFromMapped(TArray<FMappedTextLocalizationResourceRef>&& MappedResources, TArray<FMappedTextLocalizationResourceRef>& OutCultureMappedResources)
+{
+	// Note: Must be called with SynchronizationObject locked, before the entries of the resource are applied so that those take precedence
+	if (MappedResources.Num() == 0)
+	{
+		return;
+	}
+
+	for (auto& DisplayStringPair : DisplayStringLookupTable)
+	{
+		FDisplayStringEntry& LiveEntry = DisplayStringPair.Value;
+
+		const FMappedTextLocalizationResource* MappedResource = nullptr;
+		FMappedTextLocalizationResource::FEntry MappedEntry;
+		if (FindMappedEntry(MappedResources, DisplayStringPair.Key, MappedResource, MappedEntry) && LiveEntry.SourceStringHash == MappedEntry.SourceStringHash)
+		{
+			LiveEntry.bIsLocalized = true;
+			*LiveEntry.DisplayString = FString(MappedEntry.LocalizedString.Len, MappedEntry.LocalizedString.Chars);
+#if WITH_EDITORONLY_DATA
+			LiveEntry.LocResID = MappedResource->GetLocResID();
+#endif	// WITH_EDITORONLY_DATA
+#if ENABLE_LOC_TESTING
+			LiveEntry.NativeStringBackup.Reset();
+#endif	// ENABLE_LOC_TESTING
+		}
+	}
+
+	// Resources loaded after the culture, such as those of chunks, add to its resources
+	OutCultureMappedResources.Append(MoveTemp(MappedResources));
+	OutCultureMappedResources.StableSort([](const FMappedTextLocalizationResourceRef& A, const FMappedTextLocalizationResourceRef& B)
+	{
+		return A->GetPriority() < B->GetPriority();
+	});
+}
+
+FTextDisplayStringPtr FTextLocalizationManager::AddDisplayStringFromMapped(const FTextId& TextId, const FString* const SourceString, const uint32 SourceStringHash)
+{
+	// Note: Must be called with SynchronizationObject locked
+	const FMappedTextLocalizationResource* NativeResource = nullptr;
+	FMappedTextLocalizationResource::FEntry NativeEntry;
+	const bool bHasNative = FindMappedEntry(NativeMappedResources, TextId, NativeResource, NativeEntry);
+
+	const FMappedTextLocalizationResource* LocalizedResource = nullptr;
+	FMappedTextLocalizationResource::FEntry LocalizedEntry;
+	const bool bHasLocalized = FindMappedEntry(LocalizedMappedResources, TextId, LocalizedResource, LocalizedEntry);
+
+	// Without a source string, a localization still has to be of the native string, as when both are added to the tables up front
+	const uint32 RequiredSourceStringHash = SourceString ? SourceStringHash : (bHasNative ? NativeEntry.SourceStringHash : LocalizedEntry.SourceStringHash);
+
+	const FMappedTextLocalizationResource* MappedResource = nullptr;
+	const FMappedTextLocalizationResource::FEntry* MappedEntry = nullptr;
+	if (bHasLocalized && LocalizedEntry.SourceStringHash == RequiredSourceStringHash)
+	{
+		MappedResource = LocalizedResource;
+		MappedEntry = &LocalizedEntry;
+	}
+	else if (bHasNative && NativeEntry.SourceStringHash == RequiredSourceStringHash)
+	{
+		MappedResource = NativeResource;
+		MappedEntry = &NativeEntry;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	FDisplayStringEntry NewEntry(
+		true,																																/*bIsLocalized*/
+		MappedResource->GetLocResID(),																										/*LocResID*/
+		MappedEntry->SourceStringHash,																										/*SourceStringHash*/
+		MakeShared<FString, ESPMode::ThreadSafe>(MappedEntry->LocalizedString.Len, MappedEntry->LocalizedString.Chars)					/*String*/
+	);
+
+#if ENABLE_LOC_TESTING
+	// The leet culture only loads native resources, see LoadLocalizationResourcesForPrioritizedCultures
+	if (bIsInitialized && FInternationalization::Get().GetCurrentLanguage()->GetName() == FLeetCulture::StaticGetName())
+	{
+		NewEntry.NativeStringBackup = *NewEntry.DisplayString;
+		FInternationalization::Leetify(*NewEntry.DisplayString);
+	}
+#endif
+
+	DisplayStringLookupTable.Emplace(TextId, NewEntry);
+	NamespaceKeyLookupTable.Emplace(NewEntry.DisplayString, TextId);
+
+	return NewEntry.DisplayString;
+}
+
 void FTextLocalizationManager::DirtyLocalRevisionForDisplayString(const FTextDisplayStringRef& InDisplayString)
 {
 	FScopeLock ScopeLock(&SynchronizationObject);
@@ -14,6 +14,7 @@
 #include "Misc/FileHelper.h"
 #include "Misc/CommandLine.h"
 #include "Serialization/MemoryReader.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTextLocalizationResource, Log, All);
 
@@ -26,6 +27,13 @@ const FGuid FTextLocalizationResourceVersion::LocResMagic = FGuid(0x7574140E, 0x
 /** LocRes files can be quite large, so we won't pre-load those by default */
 #define PRELOAD_LOCRES_FILES (0)
 
+static int32 GUseMappedLocRes = 0;
+static FAutoConsoleVariableRef CVarUseMappedLocRes(
+	TEXT("Localization.UseMappedLocRes"),
+	GUseMappedLocRes,
+	TEXT("1 to map the LocMap file next to a LocRes file instead of loading the LocRes, when there is one (see Localization.SaveMappedLocRes). Also set by -usemappedlocres.")
+	);
+
 bool FTextLocalizationMetaDataResource::LoadFromFile(const FString& FilePath)
 {
 	TUniquePtr<FArchive> Reader;
@@ -156,7 +164,7 @@ void FTextLocalizationResource::AddEntry(const FTextKey& InNamespace, const FTex
 
 bool FTextLocalizationResource::IsEmpty() const
 {
-	return Entries.Num() == 0;
+	return Entries.Num() == 0 && MappedResources.Num() == 0;
 }
 
 void FTextLocalizationResource::LoadFromDirectory(const FString& DirectoryPath, const int32 Priority)
@@ -176,6 +184,23 @@ void FTextLocalizationResource::LoadFromDirectory(const FString& DirectoryPath,
 
 bool FTextLocalizationResource::LoadFromFile(const FString& FilePath, const int32 Priority)
 {
+	// Localization is loaded before the ini settings are applied, hence the switch
+	static const bool bUseMappedLocRes = GUseMappedLocRes || FParse::Param(FCommandLine::Get(), TEXT("usemappedlocres"));
+	if (bUseMappedLocRes)
+	{
+		if (TSharedPtr<FMappedTextLocalizationResource, ESPMode::ThreadSafe> MappedResource = FMappedTextLocalizationResource::Open(FMappedTextLocalizationResource::GetFilePathForLocRes(FilePath), Priority))
+		{
+			// Equal priorities keep the first resource loaded, as AddEntry does
+			int32 InsertIndex = 0;
+			while (InsertIndex < MappedResources.Num() && MappedResources[InsertIndex]->GetPriority() <= Priority)
+			{
+				++InsertIndex;
+			}
+			MappedResources.Insert(MappedResource.ToSharedRef(), InsertIndex);
+			return true;
+		}
+	}
+
 	TUniquePtr<FArchive> Reader;
 #if PRELOAD_LOCRES_FILES
 	TArray<uint8> FileBytes;
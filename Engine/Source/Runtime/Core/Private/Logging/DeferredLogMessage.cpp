@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Logging/DeferredLogMessage.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/CString.h"
+#include "ProfilingDebugging/FormatArgsTrace.h"
+
+namespace DeferredLogMessage
+{
+	/** Payloads are packed, so they are not aligned */
+	template<typename T>
+	static T ReadPayload(const uint8*& Payload)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Payload, sizeof(T));
+		Payload += sizeof(T);
+		return Value;
+	}
+
+	static int64 ReadInteger(const uint8*& Payload, uint8 Size)
+	{
+		switch (Size)
+		{
+		case 1:		return ReadPayload<int8>(Payload);
+		case 2:		return ReadPayload<int16>(Payload);
+		case 4:		return ReadPayload<int32>(Payload);
+		default:	return ReadPayload<int64>(Payload);
+		}
+	}
+
+	static uint32 ReadChar(const uint8*& Payload, uint8 Size)
+	{
+		switch (Size)
+		{
+		case 1:		return ReadPayload<uint8>(Payload);
+		case 2:		return ReadPayload<uint16>(Payload);
+		default:	return ReadPayload<uint32>(Payload);
+		}
+	}
+
+	/** Characters that can appear between the % and the conversion character */
+	static const TCHAR* const SpecificationChars = TEXT("-+ #0123456789.*hlLqjztI");
+}
+
+void FDeferredLogMessage::FormatMessage(FString& Out, const TCHAR* InFormat, const uint8* InEncodedArgs)
+{
+	using namespace DeferredLogMessage;
+
+	const uint8 ArgCount = InEncodedArgs[0];
+	const uint8* TypeCodes = InEncodedArgs + 1;
+	const uint8* Payload = TypeCodes + ArgCount;
+	uint8 ArgIndex = 0;
+
+	const TCHAR* Str = InFormat;
+	while (*Str)
+	{
+		const TCHAR* Percent = FCString::Strchr(Str, TEXT('%'));
+		if (!Percent)
+		{
+			Out += Str;
+			break;
+		}
+
+		Out.AppendChars(Str, int32(Percent - Str));
+		if (Percent[1] == TEXT('%'))
+		{
+			Out.AppendChar(TEXT('%'));
+			Str = Percent + 2;
+			continue;
+		}
+
+		// Rebuild the conversion specification for a single argument, '*' widths and precisions are replaced by their value
+		TCHAR Spec[64];
+		int32 SpecLen = 0;
+		Spec[SpecLen++] = TEXT('%');
+		const TCHAR* SpecEnd = Percent + 1;
+		while (*SpecEnd && FCString::Strchr(SpecificationChars, *SpecEnd) && SpecLen < int32(UE_ARRAY_COUNT(Spec)) - 16)
+		{
+			if (*SpecEnd == TEXT('*'))
+			{
+				const int32 Value = ArgIndex < ArgCount ? int32(ReadInteger(Payload, TypeCodes[ArgIndex++] & FFormatArgsTrace::FormatArgTypeCode_SizeBitMask)) : 0;
+				SpecLen += FCString::Sprintf(Spec + SpecLen, TEXT("%d"), Value);
+			}
+			else
+			{
+				Spec[SpecLen++] = *SpecEnd;
+			}
+			++SpecEnd;
+		}
+
+		const TCHAR Conversion = *SpecEnd;
+		if (!Conversion || ArgIndex >= ArgCount)
+		{
+			// Malformed format or fewer arguments than conversions, keep the rest of the format as it is
+			Out += Percent;
+			break;
+		}
+		Spec[SpecLen++] = Conversion;
+		Spec[SpecLen] = TEXT('\0');
+		Str = SpecEnd + 1;
+
+		// Arguments passed through varargs are promoted, pass them the same way the original call did
+		const uint8 TypeCode = TypeCodes[ArgIndex++];
+		const uint8 Size = TypeCode & FFormatArgsTrace::FormatArgTypeCode_SizeBitMask;
+		switch (TypeCode & FFormatArgsTrace::FormatArgTypeCode_CategoryBitMask)
+		{
+		case FFormatArgsTrace::FormatArgTypeCode_CategoryInteger:
+		{
+			const int64 Value = ReadInteger(Payload, Size);
+			if (Conversion == TEXT('p'))
+			{
+				Out.Appendf(Spec, (const void*)UPTRINT(Value));
+			}
+			else if (Size == sizeof(int64))
+			{
+				Out.Appendf(Spec, Value);
+			}
+			else
+			{
+				Out.Appendf(Spec, int32(Value));
+			}
+			break;
+		}
+
+		case FFormatArgsTrace::FormatArgTypeCode_CategoryFloatingPoint:
+		{
+			const double Value = Size == sizeof(float) ? double(ReadPayload<float>(Payload)) : ReadPayload<double>(Payload);
+			Out.Appendf(Spec, Value);
+			break;
+		}
+
+		case FFormatArgsTrace::FormatArgTypeCode_CategoryString:
+		{
+			// Strings of any character type are widened to TCHAR
+			Spec[SpecLen - 1] = TEXT('s');
+			if (Size == sizeof(TCHAR) && IsAligned(Payload, alignof(TCHAR)))
+			{
+				const TCHAR* Value = reinterpret_cast<const TCHAR*>(Payload);
+				Out.Appendf(Spec, Value);
+				Payload += (FCString::Strlen(Value) + 1) * sizeof(TCHAR);
+			}
+			else
+			{
+				FString Value;
+				while (const uint32 Char = ReadChar(Payload, Size))
+				{
+					Value.AppendChar(TCHAR(Char));
+				}
+				Out.Appendf(Spec, *Value);
+			}
+			break;
+		}
+
+		default:
+			checkf(false, TEXT("Unknown argument type code %d in deferred log message '%s'"), TypeCode, InFormat);
+			return;
+		}
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
+#include "Logging/DeferredLogMessage.h"
 #include "Misc/ScopeLock.h"
 #include "Misc/OutputDeviceRedirector.h"
 #include "Misc/FeedbackContext.h"
@@ -18,6 +19,29 @@ static TCHAR							MsgLogfStaticBuffer[8192];
 
 CSV_DEFINE_CATEGORY(FMsgLogf, true);
 
+void FMsg::LogDeferredImpl(const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, const uint8* EncodedArgs, uint16 EncodedArgsSize)
+{
+#if !NO_LOGGING
+	FDeferredLogMessage Message(Fmt, EncodedArgs, EncodedArgsSize, Verbosity, Category);
+	switch (Verbosity)
+	{
+	case ELogVerbosity::Error:
+	case ELogVerbosity::Warning:
+	case ELogVerbosity::Display:
+	case ELogVerbosity::SetColor:
+		// GWarn keeps track of errors and warnings by their text
+		if (GWarn)
+		{
+			GWarn->Log(Category, Verbosity, Message.GetText());
+			break;
+		}
+	default:
+		GLog->SerializeDeferred(Message);
+		break;
+	}
+#endif
+}
+
 void FMsg::LogfImpl(const ANSICHAR* File, int32 Line, const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ...)
 {
 #if !NO_LOGGING
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/BigInt.h"
+#include "Async/ParallelFor.h"
+
+namespace UE4BigInt_Private
+{
+	/** Signatures per task, a few microseconds of work each */
+	static const int32 SignaturesPerBatch = 32;
+
+	template <typename FunctionType>
+	static void ParallelForSignatures(int32 NumSignatures, const FunctionType& Body)
+	{
+		const int32 NumBatches = (NumSignatures + SignaturesPerBatch - 1) / SignaturesPerBatch;
+		ParallelFor(NumBatches, [NumSignatures, &Body](int32 BatchIndex)
+		{
+			const int32 End = FMath::Min((BatchIndex + 1) * SignaturesPerBatch, NumSignatures);
+			for (int32 Index = BatchIndex * SignaturesPerBatch; Index < End; ++Index)
+			{
+				Body(Index);
+			}
+		}, NumBatches < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	/** Same as FEncryption::ModularPow, with the Montgomery setup done once for all the signatures */
+	struct FSignatureDecryptor
+	{
+		explicit FSignatureDecryptor(const FEncryptionKey& InKey)
+			: Key(InKey)
+			, bMontgomery(InKey.Modulus.IsFirstBitSet() && InKey.Modulus.IsGreaterThanZero())
+			, Montgomery(bMontgomery ? InKey.Modulus : TEncryptionInt(1))
+		{
+		}
+
+		FDecryptedSignature::DataType Decrypt(const FEncryptedSignature& Signature) const
+		{
+			const TEncryptionInt Value = bMontgomery
+				? Montgomery.Pow(Signature.Data, Key.Exponent)
+				: FEncryption::ModularPow(Signature.Data, Key.Exponent, Key.Modulus);
+			return (FDecryptedSignature::DataType)Value.ToInt();
+		}
+
+		const FEncryptionKey& Key;
+		const bool bMontgomery;
+		const TMontgomeryModulus<512> Montgomery;
+	};
+}
+
+void FEncryption::DecryptSignatures(TArrayView<const FEncryptedSignature> InEncryptedSignatures, TArrayView<FDecryptedSignature> OutUnencryptedSignatures, const FEncryptionKey& EncryptionKey)
+{
+	using namespace UE4BigInt_Private;
+
+	check(InEncryptedSignatures.Num() == OutUnencryptedSignatures.Num());
+
+	const FSignatureDecryptor Decryptor(EncryptionKey);
+	ParallelForSignatures(InEncryptedSignatures.Num(), [&Decryptor, InEncryptedSignatures, OutUnencryptedSignatures](int32 Index)
+	{
+		OutUnencryptedSignatures[Index].Data = Decryptor.Decrypt(InEncryptedSignatures[Index]);
+	});
+}
+
+bool FEncryption::VerifySignatures(TArrayView<const FEncryptedSignature> InEncryptedSignatures, TArrayView<const FDecryptedSignature> InExpectedSignatures, const FEncryptionKey& EncryptionKey, TArray<int32>* OutFailedIndices)
+{
+	using namespace UE4BigInt_Private;
+
+	check(InEncryptedSignatures.Num() == InExpectedSignatures.Num());
+
+	const int32 NumSignatures = InEncryptedSignatures.Num();
+	TArray<bool> Matches;
+	Matches.SetNumUninitialized(NumSignatures);
+
+	const FSignatureDecryptor Decryptor(EncryptionKey);
+	ParallelForSignatures(NumSignatures, [&Decryptor, &Matches, InEncryptedSignatures, InExpectedSignatures](int32 Index)
+	{
+		Matches[Index] = Decryptor.Decrypt(InEncryptedSignatures[Index]) == InExpectedSignatures[Index].Data;
+	});
+
+	bool bAllMatch = true;
+	for (int32 Index = 0; Index < NumSignatures; ++Index)
+	{
+		if (!Matches[Index])
+		{
+			bAllMatch = false;
+			if (OutFailedIndices)
+			{
+				OutFailedIndices->Add(Index);
+			}
+		}
+	}
+	return bAllMatch;
+}
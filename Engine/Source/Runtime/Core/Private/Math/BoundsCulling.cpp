@@ -0,0 +1,254 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/BoundsCulling.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Math/VectorRegister.h"
+
+namespace UE4BoundsCulling_Private
+{
+	/** Bounds per ParallelFor chunk, a multiple of 32 so that chunks never share a word of the mask */
+	static const int32 ChunkSize = 8192;
+
+	/** The box centers and extents of 4 bounds, one per lane */
+	struct FBoundsGroup
+	{
+		VectorRegister CenterX, CenterY, CenterZ;
+		VectorRegister ExtentX, ExtentY, ExtentZ;
+	};
+
+	static FORCEINLINE VectorRegister LoadLanes(const float* Values, int32 Index, int32 NumValid)
+	{
+		if (NumValid == 4)
+		{
+			return VectorLoad(Values + Index);
+		}
+
+		// The last group of the batch, its missing lanes are masked out of the result
+		MS_ALIGN(16) float Padded[4] GCC_ALIGN(16) = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int32 Lane = 0; Lane < NumValid; ++Lane)
+		{
+			Padded[Lane] = Values[Index + Lane];
+		}
+		return VectorLoadAligned(Padded);
+	}
+
+	static FORCEINLINE FBoundsGroup LoadGroup(const FBoundsSoA& Bounds, int32 Index, int32 NumValid)
+	{
+		FBoundsGroup Group;
+		Group.CenterX = LoadLanes(Bounds.CenterX.GetData(), Index, NumValid);
+		Group.CenterY = LoadLanes(Bounds.CenterY.GetData(), Index, NumValid);
+		Group.CenterZ = LoadLanes(Bounds.CenterZ.GetData(), Index, NumValid);
+		Group.ExtentX = LoadLanes(Bounds.ExtentX.GetData(), Index, NumValid);
+		Group.ExtentY = LoadLanes(Bounds.ExtentY.GetData(), Index, NumValid);
+		Group.ExtentZ = LoadLanes(Bounds.ExtentZ.GetData(), Index, NumValid);
+		return Group;
+	}
+
+	/** A plane with each component in all the lanes */
+	struct FSplatPlane
+	{
+		VectorRegister X, Y, Z, W;
+		VectorRegister AbsX, AbsY, AbsZ;
+	};
+
+	/** Outside of a convex volume if outside of any of its planes */
+	struct FPlanesTest
+	{
+		TArray<FSplatPlane, TInlineAllocator<8>> Planes;
+
+		explicit FPlanesTest(TArrayView<const FPlane> InPlanes)
+		{
+			Planes.Reserve(InPlanes.Num());
+			for (const FPlane& Plane : InPlanes)
+			{
+				FSplatPlane& Splat = Planes.AddDefaulted_GetRef();
+				Splat.X = VectorSetFloat1(Plane.X);
+				Splat.Y = VectorSetFloat1(Plane.Y);
+				Splat.Z = VectorSetFloat1(Plane.Z);
+				Splat.W = VectorSetFloat1(Plane.W);
+				Splat.AbsX = VectorSetFloat1(FMath::Abs(Plane.X));
+				Splat.AbsY = VectorSetFloat1(FMath::Abs(Plane.Y));
+				Splat.AbsZ = VectorSetFloat1(FMath::Abs(Plane.Z));
+			}
+		}
+
+		/** @return A bit per lane of the bounds that pass */
+		FORCEINLINE uint32 operator()(const FBoundsGroup& Group) const
+		{
+			VectorRegister Outside = VectorZero();
+			for (const FSplatPlane& Plane : Planes)
+			{
+				VectorRegister Distance = VectorMultiplyAdd(Group.CenterX, Plane.X, VectorNegate(Plane.W));
+				Distance = VectorMultiplyAdd(Group.CenterY, Plane.Y, Distance);
+				Distance = VectorMultiplyAdd(Group.CenterZ, Plane.Z, Distance);
+
+				VectorRegister PushOut = VectorMultiply(Group.ExtentX, Plane.AbsX);
+				PushOut = VectorMultiplyAdd(Group.ExtentY, Plane.AbsY, PushOut);
+				PushOut = VectorMultiplyAdd(Group.ExtentZ, Plane.AbsZ, PushOut);
+
+				Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, PushOut));
+			}
+			return ~uint32(VectorMaskBits(Outside)) & 0xF;
+		}
+	};
+
+	/** Separated from the box if apart on any axis */
+	struct FBoxTest
+	{
+		VectorRegister CenterX, CenterY, CenterZ;
+		VectorRegister ExtentX, ExtentY, ExtentZ;
+
+		explicit FBoxTest(const FBox& Box)
+		{
+			const FVector Center = Box.GetCenter();
+			const FVector Extent = Box.GetExtent();
+			CenterX = VectorSetFloat1(Center.X);
+			CenterY = VectorSetFloat1(Center.Y);
+			CenterZ = VectorSetFloat1(Center.Z);
+			ExtentX = VectorSetFloat1(Extent.X);
+			ExtentY = VectorSetFloat1(Extent.Y);
+			ExtentZ = VectorSetFloat1(Extent.Z);
+		}
+
+		FORCEINLINE uint32 operator()(const FBoundsGroup& Group) const
+		{
+			VectorRegister Apart = VectorCompareGT(VectorAbs(VectorSubtract(Group.CenterX, CenterX)), VectorAdd(Group.ExtentX, ExtentX));
+			Apart = VectorBitwiseOr(Apart, VectorCompareGT(VectorAbs(VectorSubtract(Group.CenterY, CenterY)), VectorAdd(Group.ExtentY, ExtentY)));
+			Apart = VectorBitwiseOr(Apart, VectorCompareGT(VectorAbs(VectorSubtract(Group.CenterZ, CenterZ)), VectorAdd(Group.ExtentZ, ExtentZ)));
+			return ~uint32(VectorMaskBits(Apart)) & 0xF;
+		}
+	};
+
+	/** Calls Emit(Index, LaneBits) for each group of 4 bounds of [Begin, End), Begin a multiple of 4 */
+	template <typename TestType, typename EmitType>
+	static FORCEINLINE void TestGroups(const FBoundsSoA& Bounds, const TestType& Test, int32 Begin, int32 End, EmitType&& Emit)
+	{
+		for (int32 Index = Begin; Index < End; Index += 4)
+		{
+			const int32 NumValid = FMath::Min(End - Index, 4);
+			const uint32 LaneMask = (1u << NumValid) - 1;
+			Emit(Index, Test(LoadGroup(Bounds, Index, NumValid)) & LaneMask);
+		}
+	}
+
+	static void CheckBounds(const FBoundsSoA& Bounds)
+	{
+		const int32 Num = Bounds.Num();
+		check(Bounds.CenterY.Num() == Num && Bounds.CenterZ.Num() == Num);
+		check(Bounds.ExtentX.Num() == Num && Bounds.ExtentY.Num() == Num && Bounds.ExtentZ.Num() == Num);
+	}
+
+	static FORCEINLINE void AppendIndices(int32 Index, uint32 LaneBits, TArray<int32>& OutIndices)
+	{
+		while (LaneBits)
+		{
+			OutIndices.Add(Index + int32(FMath::CountTrailingZeros(LaneBits)));
+			LaneBits &= LaneBits - 1;
+		}
+	}
+
+	template <typename TestType>
+	static int32 TestToIndices(const FBoundsSoA& Bounds, const TestType& Test, TArray<int32>& OutIndices, EParallelForFlags Flags)
+	{
+		CheckBounds(Bounds);
+
+		const int32 Num = Bounds.Num();
+		const int32 NumChunks = (Num + ChunkSize - 1) / ChunkSize;
+		OutIndices.Reset();
+
+		if (NumChunks <= 1 || EnumHasAnyFlags(Flags, EParallelForFlags::ForceSingleThread))
+		{
+			OutIndices.Reserve(Num);
+			TestGroups(Bounds, Test, 0, Num, [&OutIndices](int32 Index, uint32 LaneBits)
+			{
+				AppendIndices(Index, LaneBits, OutIndices);
+			});
+			return OutIndices.Num();
+		}
+
+		// Each chunk appends to its own array, concatenated in order once they are all done
+		TArray<TArray<int32>> ChunkIndices;
+		ChunkIndices.SetNum(NumChunks);
+		ParallelFor(NumChunks, [&Bounds, &Test, &ChunkIndices, Num](int32 ChunkIndex)
+		{
+			TArray<int32>& Indices = ChunkIndices[ChunkIndex];
+			const int32 Begin = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Begin + ChunkSize, Num);
+			Indices.Reserve(End - Begin);
+			TestGroups(Bounds, Test, Begin, End, [&Indices](int32 Index, uint32 LaneBits)
+			{
+				AppendIndices(Index, LaneBits, Indices);
+			});
+		}, Flags);
+
+		int32 NumIndices = 0;
+		for (const TArray<int32>& Indices : ChunkIndices)
+		{
+			NumIndices += Indices.Num();
+		}
+		OutIndices.Reserve(NumIndices);
+		for (const TArray<int32>& Indices : ChunkIndices)
+		{
+			OutIndices.Append(Indices);
+		}
+		return NumIndices;
+	}
+
+	template <typename TestType>
+	static void TestToMask(const FBoundsSoA& Bounds, const TestType& Test, TArray<uint32>& OutMask, EParallelForFlags Flags)
+	{
+		CheckBounds(Bounds);
+
+		const int32 Num = Bounds.Num();
+		const int32 NumChunks = (Num + ChunkSize - 1) / ChunkSize;
+		OutMask.Reset();
+		OutMask.SetNumZeroed((Num + 31) / 32);
+
+		uint32* Words = OutMask.GetData();
+		auto TestChunk = [&Bounds, &Test, Words, Num](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Begin + ChunkSize, Num);
+			TestGroups(Bounds, Test, Begin, End, [Words](int32 Index, uint32 LaneBits)
+			{
+				Words[Index / 32] |= LaneBits << (Index % 32);
+			});
+		};
+
+		if (NumChunks <= 1 || EnumHasAnyFlags(Flags, EParallelForFlags::ForceSingleThread))
+		{
+			for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+			{
+				TestChunk(ChunkIndex);
+			}
+		}
+		else
+		{
+			ParallelFor(NumChunks, TestChunk, Flags);
+		}
+	}
+}
+
+int32 FBoundsCulling::CullAgainstPlanes(const FBoundsSoA& Bounds, TArrayView<const FPlane> Planes, TArray<int32>& OutIndices, EParallelForFlags Flags)
+{
+	using namespace UE4BoundsCulling_Private;
+	return TestToIndices(Bounds, FPlanesTest(Planes), OutIndices, Flags);
+}
+
+void FBoundsCulling::CullAgainstPlanes(const FBoundsSoA& Bounds, TArrayView<const FPlane> Planes, TArray<uint32>& OutMask, EParallelForFlags Flags)
+{
+	using namespace UE4BoundsCulling_Private;
+	TestToMask(Bounds, FPlanesTest(Planes), OutMask, Flags);
+}
+
+int32 FBoundsCulling::OverlapBox(const FBoundsSoA& Bounds, const FBox& Box, TArray<int32>& OutIndices, EParallelForFlags Flags)
+{
+	using namespace UE4BoundsCulling_Private;
+	return TestToIndices(Bounds, FBoxTest(Box), OutIndices, Flags);
+}
+
+void FBoundsCulling::OverlapBox(const FBoundsSoA& Bounds, const FBox& Box, TArray<uint32>& OutMask, EParallelForFlags Flags)
+{
+	using namespace UE4BoundsCulling_Private;
+	TestToMask(Bounds, FBoxTest(Box), OutMask, Flags);
+}
@@ -0,0 +1,470 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/ConvexHull3d.h"
+#include "Async/ParallelFor.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
+
+namespace UE4ConvexHull3D_Private
+{
+	// Points per task when a pass sees many of them. Fixed so that the merged results do not depend on the thread count.
+	static const int32 ChunkSize = 16384;
+
+	struct FFace
+	{
+		int32 Vertices[3];
+		// Neighbors[i] is the face across the edge Vertices[i] -> Vertices[(i + 1) % 3]
+		int32 Neighbors[3];
+		FVector Normal;
+		// A corner, distances are measured from it to keep them small
+		FVector Origin;
+		// Points in front of this face and of no face created before it
+		TArray<int32> Points;
+		int32 FurthestPoint;
+		float FurthestDistance;
+		int32 VisitTag;
+		bool bAlive;
+
+		float PlaneDistance(const FVector& P) const
+		{
+			return Normal | (P - Origin);
+		}
+	};
+
+	struct FFurthest
+	{
+		int32 Index = INDEX_NONE;
+		float Distance = -1.0f;
+
+		void Merge(const FFurthest& Other)
+		{
+			if (Other.Distance > Distance)
+			{
+				*this = Other;
+			}
+		}
+	};
+
+	/** Runs Function(Begin, End, Result) over fixed chunks of [0, Num), on the task graph when there is more than one */
+	template <typename ResultType, typename FunctionType>
+	static void ForEachChunk(int32 Num, TArray<ResultType>& OutResults, FunctionType Function)
+	{
+		const int32 NumChunks = FMath::Max(1, (Num + ChunkSize - 1) / ChunkSize);
+		OutResults.Reset();
+		OutResults.SetNum(NumChunks);
+		ParallelFor(NumChunks, [Num, &OutResults, &Function](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * ChunkSize;
+			Function(Begin, FMath::Min(Begin + ChunkSize, Num), OutResults[ChunkIndex]);
+		}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	class FHullBuilder
+	{
+	public:
+		explicit FHullBuilder(TArrayView<const FVector> InPoints)
+			: Points(InPoints)
+		{
+		}
+
+		bool Build(TArray<int32>& OutTriangles, TArray<int32>* OutVertices)
+		{
+			int32 Simplex[4];
+			if (!FindSimplex(Simplex))
+			{
+				return false;
+			}
+
+			AddSimplexFaces(Simplex);
+			TArray<int32> SimplexFaces = { 0, 1, 2, 3 };
+			AssignPoints(nullptr, Points.Num(), SimplexFaces);
+
+			// New faces are appended, so one pass sees every face that ever gets points
+			for (int32 FaceIndex = 0; FaceIndex < Faces.Num(); ++FaceIndex)
+			{
+				if (Faces[FaceIndex].bAlive && Faces[FaceIndex].Points.Num() > 0)
+				{
+					if (!AddPoint(FaceIndex))
+					{
+						return false;
+					}
+				}
+			}
+
+			TBitArray<> IsHullVertex(false, Points.Num());
+			for (const FFace& Face : Faces)
+			{
+				if (Face.bAlive)
+				{
+					for (int32 Corner = 0; Corner < 3; ++Corner)
+					{
+						OutTriangles.Add(Face.Vertices[Corner]);
+						IsHullVertex[Face.Vertices[Corner]] = true;
+					}
+				}
+			}
+
+			if (OutVertices)
+			{
+				for (TConstSetBitIterator<> It(IsHullVertex); It; ++It)
+				{
+					OutVertices->Add(It.GetIndex());
+				}
+			}
+			return true;
+		}
+
+	private:
+		/** Picks the four starting points, spread as far apart as the extremes allow */
+		bool FindSimplex(int32 (&OutSimplex)[4])
+		{
+			const int32 NumPoints = Points.Num();
+			if (NumPoints < 4)
+			{
+				return false;
+			}
+
+			// Smallest and largest point on each axis
+			struct FExtremes
+			{
+				int32 Min[3] = { 0, 0, 0 };
+				int32 Max[3] = { 0, 0, 0 };
+			};
+			TArray<FExtremes> ChunkExtremes;
+			ForEachChunk(NumPoints, ChunkExtremes, [this](int32 Begin, int32 End, FExtremes& Result)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Result.Min[Axis] = Result.Max[Axis] = Begin;
+				}
+				for (int32 Index = Begin + 1; Index < End; ++Index)
+				{
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						Result.Min[Axis] = Points[Index][Axis] < Points[Result.Min[Axis]][Axis] ? Index : Result.Min[Axis];
+						Result.Max[Axis] = Points[Index][Axis] > Points[Result.Max[Axis]][Axis] ? Index : Result.Max[Axis];
+					}
+				}
+			});
+
+			FExtremes Extremes = ChunkExtremes[0];
+			for (const FExtremes& Chunk : ChunkExtremes)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Extremes.Min[Axis] = Points[Chunk.Min[Axis]][Axis] < Points[Extremes.Min[Axis]][Axis] ? Chunk.Min[Axis] : Extremes.Min[Axis];
+					Extremes.Max[Axis] = Points[Chunk.Max[Axis]][Axis] > Points[Extremes.Max[Axis]][Axis] ? Chunk.Max[Axis] : Extremes.Max[Axis];
+				}
+			}
+
+			// Same tolerance as qhull, the round-off of a plane distance for coordinates of this size
+			float MaxCoordinateSum = 0.0f;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				MaxCoordinateSum += FMath::Max(FMath::Abs(Points[Extremes.Min[Axis]][Axis]), FMath::Abs(Points[Extremes.Max[Axis]][Axis]));
+			}
+			Tolerance = 3.0f * FLT_EPSILON * MaxCoordinateSum;
+
+			// The two extremes furthest apart
+			const int32 Candidates[6] = { Extremes.Min[0], Extremes.Max[0], Extremes.Min[1], Extremes.Max[1], Extremes.Min[2], Extremes.Max[2] };
+			float MaxDistanceSquared = -1.0f;
+			for (int32 First = 0; First < 6; ++First)
+			{
+				for (int32 Second = First + 1; Second < 6; ++Second)
+				{
+					const float DistanceSquared = FVector::DistSquared(Points[Candidates[First]], Points[Candidates[Second]]);
+					if (DistanceSquared > MaxDistanceSquared)
+					{
+						MaxDistanceSquared = DistanceSquared;
+						OutSimplex[0] = Candidates[First];
+						OutSimplex[1] = Candidates[Second];
+					}
+				}
+			}
+			if (MaxDistanceSquared <= FMath::Square(Tolerance))
+			{
+				return false;
+			}
+
+			// The point furthest from their line
+			const FVector Origin = Points[OutSimplex[0]];
+			const FVector Direction = (Points[OutSimplex[1]] - Origin).GetSafeNormal();
+			FFurthest FromLine = FindFurthest([&Origin, &Direction](const FVector& P) { return ((P - Origin) ^ Direction).SizeSquared(); });
+			if (FromLine.Distance <= FMath::Square(Tolerance))
+			{
+				return false;
+			}
+			OutSimplex[2] = FromLine.Index;
+
+			// The point furthest from their plane
+			const FVector Normal = ((Points[OutSimplex[1]] - Origin) ^ (Points[OutSimplex[2]] - Origin)).GetSafeNormal();
+			FFurthest FromPlane = FindFurthest([&Origin, &Normal](const FVector& P) { return FMath::Abs((P - Origin) | Normal); });
+			if (FromPlane.Distance <= Tolerance)
+			{
+				return false;
+			}
+			OutSimplex[3] = FromPlane.Index;
+			return true;
+		}
+
+		template <typename DistanceFunction>
+		FFurthest FindFurthest(DistanceFunction Distance) const
+		{
+			TArray<FFurthest> ChunkResults;
+			ForEachChunk(Points.Num(), ChunkResults, [this, &Distance](int32 Begin, int32 End, FFurthest& Result)
+			{
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					Result.Merge({ Index, Distance(Points[Index]) });
+				}
+			});
+
+			FFurthest Furthest;
+			for (const FFurthest& Chunk : ChunkResults)
+			{
+				Furthest.Merge(Chunk);
+			}
+			return Furthest;
+		}
+
+		int32 AddFace(int32 A, int32 B, int32 C)
+		{
+			FFace& Face = Faces.AddDefaulted_GetRef();
+			Face.Vertices[0] = A;
+			Face.Vertices[1] = B;
+			Face.Vertices[2] = C;
+			Face.Neighbors[0] = Face.Neighbors[1] = Face.Neighbors[2] = INDEX_NONE;
+			// In double, the cross product of a sliver cancels too much in float. Dense point sets make tiny faces, so only an
+			// exactly degenerate one is left without a normal.
+			const double U[3] = { double(Points[B].X) - Points[A].X, double(Points[B].Y) - Points[A].Y, double(Points[B].Z) - Points[A].Z };
+			const double V[3] = { double(Points[C].X) - Points[A].X, double(Points[C].Y) - Points[A].Y, double(Points[C].Z) - Points[A].Z };
+			const double Cross[3] = { U[1] * V[2] - U[2] * V[1], U[2] * V[0] - U[0] * V[2], U[0] * V[1] - U[1] * V[0] };
+			const double Length = sqrt(Cross[0] * Cross[0] + Cross[1] * Cross[1] + Cross[2] * Cross[2]);
+			Face.Normal = Length > 0.0 ? FVector(float(Cross[0] / Length), float(Cross[1] / Length), float(Cross[2] / Length)) : FVector::ZeroVector;
+			Face.Origin = Points[A];
+			Face.FurthestPoint = INDEX_NONE;
+			Face.FurthestDistance = 0.0f;
+			Face.VisitTag = 0;
+			Face.bAlive = true;
+			return Faces.Num() - 1;
+		}
+
+		void AddSimplexFaces(const int32 (&Simplex)[4])
+		{
+			// Each face is wound so that the corner it leaves out is behind it
+			for (int32 Opposite = 0; Opposite < 4; ++Opposite)
+			{
+				int32 A = Simplex[(Opposite + 1) & 3], B = Simplex[(Opposite + 2) & 3], C = Simplex[(Opposite + 3) & 3];
+				const FVector Normal = (Points[B] - Points[A]) ^ (Points[C] - Points[A]);
+				if ((Normal | (Points[Simplex[Opposite]] - Points[A])) > 0.0f)
+				{
+					Swap(B, C);
+				}
+				AddFace(A, B, C);
+			}
+
+			for (int32 FaceIndex = 0; FaceIndex < 4; ++FaceIndex)
+			{
+				for (int32 Edge = 0; Edge < 3; ++Edge)
+				{
+					const int32 EdgeStart = Faces[FaceIndex].Vertices[Edge];
+					const int32 EdgeEnd = Faces[FaceIndex].Vertices[(Edge + 1) % 3];
+					for (int32 Other = 0; Other < 4; ++Other)
+					{
+						for (int32 OtherEdge = 0; Other != FaceIndex && OtherEdge < 3; ++OtherEdge)
+						{
+							if (Faces[Other].Vertices[OtherEdge] == EdgeEnd && Faces[Other].Vertices[(OtherEdge + 1) % 3] == EdgeStart)
+							{
+								Faces[FaceIndex].Neighbors[Edge] = Other;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * Gives each candidate to the face in TargetFaces it is furthest in front of, if it is in front of any.
+		 * Candidates == nullptr means every point.
+		 */
+		void AssignPoints(const int32* Candidates, int32 NumCandidates, const TArray<int32>& TargetFaces)
+		{
+			struct FChunkAssignment
+			{
+				TArray<TArray<int32>> Points;
+				TArray<FFurthest> Furthest;
+			};
+
+			TArray<FChunkAssignment> ChunkResults;
+			ForEachChunk(NumCandidates, ChunkResults, [this, Candidates, &TargetFaces](int32 Begin, int32 End, FChunkAssignment& Result)
+			{
+				Result.Points.SetNum(TargetFaces.Num());
+				Result.Furthest.SetNum(TargetFaces.Num());
+				for (int32 Candidate = Begin; Candidate < End; ++Candidate)
+				{
+					const int32 PointIndex = Candidates ? Candidates[Candidate] : Candidate;
+					const FVector& P = Points[PointIndex];
+					int32 BestTarget = INDEX_NONE;
+					float BestDistance = Tolerance;
+					for (int32 Target = 0; Target < TargetFaces.Num(); ++Target)
+					{
+						const float Distance = Faces[TargetFaces[Target]].PlaneDistance(P);
+						if (Distance > BestDistance)
+						{
+							BestDistance = Distance;
+							BestTarget = Target;
+						}
+					}
+
+					if (BestTarget != INDEX_NONE)
+					{
+						Result.Points[BestTarget].Add(PointIndex);
+						Result.Furthest[BestTarget].Merge({ PointIndex, BestDistance });
+					}
+				}
+			});
+
+			for (int32 Target = 0; Target < TargetFaces.Num(); ++Target)
+			{
+				FFace& Face = Faces[TargetFaces[Target]];
+				FFurthest Furthest;
+				for (FChunkAssignment& Chunk : ChunkResults)
+				{
+					if (Chunk.Points.IsValidIndex(Target))
+					{
+						Face.Points.Append(MoveTemp(Chunk.Points[Target]));
+						Furthest.Merge(Chunk.Furthest[Target]);
+					}
+				}
+				Face.FurthestPoint = Furthest.Index;
+				Face.FurthestDistance = Furthest.Distance;
+			}
+		}
+
+		/** Adds the furthest point of a face to the hull. Returns false if round-off left a horizon that is not a single loop. */
+		bool AddPoint(int32 StartFace)
+		{
+			const int32 Eye = Faces[StartFace].FurthestPoint;
+			const FVector EyePosition = Points[Eye];
+
+			// Flood the faces the eye sees, the edges to the ones it does not see form the horizon
+			struct FHorizonEdge
+			{
+				int32 Face;
+				int32 Edge;
+			};
+			TArray<int32> VisibleFaces;
+			TArray<FHorizonEdge> Horizon;
+			++VisitTag;
+			Faces[StartFace].VisitTag = VisitTag;
+			VisibleFaces.Add(StartFace);
+			for (int32 Visible = 0; Visible < VisibleFaces.Num(); ++Visible)
+			{
+				const int32 FaceIndex = VisibleFaces[Visible];
+				for (int32 Edge = 0; Edge < 3; ++Edge)
+				{
+					const int32 Neighbor = Faces[FaceIndex].Neighbors[Edge];
+					if (Faces[Neighbor].VisitTag == VisitTag)
+					{
+						continue;
+					}
+					if (Faces[Neighbor].PlaneDistance(EyePosition) > Tolerance)
+					{
+						Faces[Neighbor].VisitTag = VisitTag;
+						VisibleFaces.Add(Neighbor);
+					}
+					else
+					{
+						Horizon.Add({ FaceIndex, Edge });
+					}
+				}
+			}
+
+			// A fan of new faces from the eye to each horizon edge, linked to each other through the edge end points
+			TMap<int32, int32> FaceStartingAt, FaceEndingAt;
+			FaceStartingAt.Reserve(Horizon.Num());
+			FaceEndingAt.Reserve(Horizon.Num());
+			TArray<int32> NewFaces;
+			NewFaces.Reserve(Horizon.Num());
+			for (const FHorizonEdge& HorizonEdge : Horizon)
+			{
+				const int32 EdgeStart = Faces[HorizonEdge.Face].Vertices[HorizonEdge.Edge];
+				const int32 EdgeEnd = Faces[HorizonEdge.Face].Vertices[(HorizonEdge.Edge + 1) % 3];
+				const int32 Outside = Faces[HorizonEdge.Face].Neighbors[HorizonEdge.Edge];
+				if (FaceStartingAt.Contains(EdgeStart) || FaceEndingAt.Contains(EdgeEnd))
+				{
+					return false;
+				}
+
+				const int32 NewFace = AddFace(EdgeStart, EdgeEnd, Eye);
+				Faces[NewFace].Neighbors[0] = Outside;
+				for (int32 OutsideEdge = 0; OutsideEdge < 3; ++OutsideEdge)
+				{
+					if (Faces[Outside].Vertices[OutsideEdge] == EdgeEnd && Faces[Outside].Vertices[(OutsideEdge + 1) % 3] == EdgeStart)
+					{
+						Faces[Outside].Neighbors[OutsideEdge] = NewFace;
+					}
+				}
+				FaceStartingAt.Add(EdgeStart, NewFace);
+				FaceEndingAt.Add(EdgeEnd, NewFace);
+				NewFaces.Add(NewFace);
+			}
+
+			for (int32 NewFace : NewFaces)
+			{
+				const int32* Next = FaceStartingAt.Find(Faces[NewFace].Vertices[1]);
+				const int32* Previous = FaceEndingAt.Find(Faces[NewFace].Vertices[0]);
+				if (!Next || !Previous)
+				{
+					return false;
+				}
+				Faces[NewFace].Neighbors[1] = *Next;
+				Faces[NewFace].Neighbors[2] = *Previous;
+			}
+
+			// The points of the removed faces go to the new ones, or are inside the hull now
+			TArray<int32> Orphans;
+			for (int32 FaceIndex : VisibleFaces)
+			{
+				FFace& Face = Faces[FaceIndex];
+				Face.bAlive = false;
+				for (int32 PointIndex : Face.Points)
+				{
+					if (PointIndex != Eye)
+					{
+						Orphans.Add(PointIndex);
+					}
+				}
+				Face.Points.Empty();
+			}
+			AssignPoints(Orphans.GetData(), Orphans.Num(), NewFaces);
+			return true;
+		}
+
+		TArrayView<const FVector> Points;
+		TArray<FFace> Faces;
+		float Tolerance = 0.0f;
+		int32 VisitTag = 0;
+	};
+}
+
+bool ConvexHull3D::ComputeConvexHull(TArrayView<const FVector> Points, TArray<int32>& OutTriangles, TArray<int32>* OutVertices)
+{
+	OutTriangles.Reset();
+	if (OutVertices)
+	{
+		OutVertices->Reset();
+	}
+
+	UE4ConvexHull3D_Private::FHullBuilder Builder(Points);
+	if (!Builder.Build(OutTriangles, OutVertices))
+	{
+		OutTriangles.Reset();
+		if (OutVertices)
+		{
+			OutVertices->Reset();
+		}
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/Halton.h"
+#include "Misc/AssertionMacros.h"
+#include "Async/ParallelFor.h"
+
+namespace UE4Halton_Private
+{
+	static const int32 BatchMaxDims = 16;
+	static const uint32 BatchPrimes[BatchMaxDims] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53 };
+
+	// Points per chunk of a batch, each chunk is one task and starts from a full digit expansion
+	static const int32 BatchChunkSize = 4096;
+
+	/**
+	 * Radical inverse of a running index in 64-bit fixed point. Digit K of the index is worth DigitScale[K], which is
+	 * Base^(NumDigits - 1 - K), so the value is Fixed / Base^NumDigits and incrementing only touches the digits that carry.
+	 */
+	struct FRadicalInverse
+	{
+		uint64 DigitScale[64];
+		uint8 Digits[64];
+		uint64 Fixed;
+		double InvFullScale;
+		uint32 Base;
+
+		FRadicalInverse(uint32 InBase, uint32 Index)
+			: Fixed(0)
+			, Base(InBase)
+		{
+			// As many digits as fit, at least enough for any int32 index
+			int32 NumDigits = 0;
+			uint64 FullScale = 1;
+			while (FullScale <= MAX_uint64 / Base)
+			{
+				FullScale *= Base;
+				++NumDigits;
+			}
+			InvFullScale = 1.0 / double(FullScale);
+
+			uint64 Scale = FullScale;
+			for (int32 Digit = 0; Digit < NumDigits; ++Digit)
+			{
+				Scale /= Base;
+				DigitScale[Digit] = Scale;
+				Digits[Digit] = uint8(Index % Base);
+				Fixed += Digits[Digit] * Scale;
+				Index /= Base;
+			}
+		}
+
+		float GetValue() const
+		{
+			return float(double(Fixed) * InvFullScale);
+		}
+
+		void Increment()
+		{
+			int32 Digit = 0;
+			while (Digits[Digit] == Base - 1)
+			{
+				Digits[Digit] = 0;
+				Fixed -= (Base - 1) * DigitScale[Digit];
+				++Digit;
+			}
+			++Digits[Digit];
+			Fixed += DigitScale[Digit];
+		}
+	};
+}
+
+void HaltonBatch(int32 FirstIndex, int32 NumDims, TArrayView<float> OutValues)
+{
+	using namespace UE4Halton_Private;
+
+	check(NumDims >= 1 && NumDims <= BatchMaxDims);
+	check(OutValues.Num() % NumDims == 0);
+
+	const int32 NumPoints = OutValues.Num() / NumDims;
+	check(FirstIndex >= 0 && NumPoints <= MAX_int32 - FirstIndex);
+
+	const int32 NumChunks = (NumPoints + BatchChunkSize - 1) / BatchChunkSize;
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 ChunkFirst = ChunkIndex * BatchChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkFirst + BatchChunkSize, NumPoints);
+
+		// One dimension at a time keeps the digit state in cache
+		for (int32 Dim = 0; Dim < NumDims; ++Dim)
+		{
+			FRadicalInverse Inverse(BatchPrimes[Dim], uint32(FirstIndex + ChunkFirst));
+			float* Dest = OutValues.GetData() + int64(ChunkFirst) * NumDims + Dim;
+			for (int32 Point = ChunkFirst; Point < ChunkEnd; ++Point, Dest += NumDims)
+			{
+				*Dest = Inverse.GetValue();
+				Inverse.Increment();
+			}
+		}
+	}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/QuantizeBatch.h"
+#include "Math/VectorRegister.h"
+#include "Misc/AssertionMacros.h"
+
+#if PLATFORM_ALWAYS_HAS_F16C
+	#include <immintrin.h>
+	#define QUANTIZE_BATCH_F16C 1
+	#define QUANTIZE_BATCH_NEON_FP16 0
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+	#include <arm_neon.h>
+	#define QUANTIZE_BATCH_F16C 0
+	#define QUANTIZE_BATCH_NEON_FP16 1
+#else
+	#define QUANTIZE_BATCH_F16C 0
+	#define QUANTIZE_BATCH_NEON_FP16 0
+#endif
+
+static_assert(sizeof(FFloat16) == sizeof(uint16), "The half conversions store FFloat16 arrays as packed uint16");
+
+namespace UE4QuantizeBatch_Private
+{
+	/** Largest half, FFloat16 clamps to it */
+	static const float MaxHalf = 65504.0f;
+
+	// Dropping the float mantissa bits below the half mantissa makes the round to nearest conversion truncate like FFloat16::Set
+	static const uint32 HalfTruncateMask = 0xffffe000u;
+
+	/**
+	 * Out[i] = round(clamp(In[i], Lower, 1) * MaxValue), 4 at a time with a padded tail so every element sees the same code.
+	 * Signed values are offset to be positive during the rounding, so a truncating conversion rounds to nearest.
+	 */
+	template <bool bSigned, int32 MaxValue, typename IntType>
+	static void Quantize(TArrayView<const float> In, TArrayView<IntType> Out)
+	{
+		check(In.Num() == Out.Num());
+
+		static const int32 Offset = bSigned ? MaxValue + 1 : 0;
+		const VectorRegister Lower = VectorSetFloat1(bSigned ? -1.0f : 0.0f);
+		const VectorRegister Scale = VectorSetFloat1(float(MaxValue));
+		const VectorRegister Bias = VectorSetFloat1(float(Offset) + 0.5f);
+		const VectorRegisterInt IntOffset = MakeVectorRegisterInt(Offset, Offset, Offset, Offset);
+		auto QuantizeVector = [&](const VectorRegister& V)
+		{
+			const VectorRegister Clamped = VectorMin(VectorMax(V, Lower), VectorOne());
+			return VectorIntSubtract(VectorFloatToInt(VectorMultiplyAdd(Clamped, Scale, Bias)), IntOffset);
+		};
+
+		const int32 Num = In.Num();
+		MS_ALIGN(16) int32 Results[4] GCC_ALIGN(16);
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			VectorIntStoreAligned(QuantizeVector(VectorLoad(In.GetData() + Index)), Results);
+			Out[Index + 0] = IntType(Results[0]);
+			Out[Index + 1] = IntType(Results[1]);
+			Out[Index + 2] = IntType(Results[2]);
+			Out[Index + 3] = IntType(Results[3]);
+		}
+
+		if (Index < Num)
+		{
+			MS_ALIGN(16) float Tail[4] GCC_ALIGN(16) = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Tail[TailIndex] = In[Index + TailIndex];
+			}
+			VectorIntStoreAligned(QuantizeVector(VectorLoadAligned(Tail)), Results);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Out[Index + TailIndex] = IntType(Results[TailIndex]);
+			}
+		}
+	}
+
+	/** Out[i] = In[i] * (1 / MaxValue), 4 at a time */
+	template <int32 MaxValue, typename IntType>
+	static void Dequantize(TArrayView<const IntType> In, TArrayView<float> Out)
+	{
+		check(In.Num() == Out.Num());
+
+		const VectorRegister InvScale = VectorSetFloat1(1.0f / float(MaxValue));
+		const int32 Num = In.Num();
+		MS_ALIGN(16) int32 Values[4] GCC_ALIGN(16);
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			Values[0] = In[Index + 0];
+			Values[1] = In[Index + 1];
+			Values[2] = In[Index + 2];
+			Values[3] = In[Index + 3];
+			VectorStore(VectorMultiply(VectorIntToFloat(VectorIntLoadAligned(Values)), InvScale), Out.GetData() + Index);
+		}
+
+		if (Index < Num)
+		{
+			MS_ALIGN(16) float Tail[4] GCC_ALIGN(16);
+			Values[0] = Values[1] = Values[2] = Values[3] = 0;
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Values[TailIndex] = In[Index + TailIndex];
+			}
+			VectorStoreAligned(VectorMultiply(VectorIntToFloat(VectorIntLoadAligned(Values)), InvScale), Tail);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Out[Index + TailIndex] = Tail[TailIndex];
+			}
+		}
+	}
+}
+
+void FQuantizeBatch::FloatToHalf(TArrayView<const float> In, TArrayView<FFloat16> Out)
+{
+	using namespace UE4QuantizeBatch_Private;
+	check(In.Num() == Out.Num());
+
+	const float* Source = In.GetData();
+	uint16* Dest = reinterpret_cast<uint16*>(Out.GetData());
+	const int32 Num = In.Num();
+	int32 Index = 0;
+
+#if QUANTIZE_BATCH_F16C
+	const __m128i TruncateMask = _mm_set1_epi32(int32(HalfTruncateMask));
+	const __m128 SignMask = _mm_castsi128_ps(_mm_set1_epi32(int32(0x80000000u)));
+	const __m128 Max = _mm_set1_ps(MaxHalf);
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const __m128 Truncated = _mm_castsi128_ps(_mm_and_si128(_mm_castps_si128(_mm_loadu_ps(Source + Index)), TruncateMask));
+		// minps returns its second operand for NaNs, so they clamp to the largest half like infinities
+		const __m128 Abs = _mm_min_ps(_mm_andnot_ps(SignMask, Truncated), Max);
+		const __m128i Half = _mm_cvtps_ph(_mm_or_ps(Abs, _mm_and_ps(Truncated, SignMask)), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(Dest + Index), Half);
+	}
+#elif QUANTIZE_BATCH_NEON_FP16
+	const uint32x4_t TruncateMask = vdupq_n_u32(HalfTruncateMask);
+	const uint32x4_t SignMask = vdupq_n_u32(0x80000000u);
+	const float32x4_t Max = vdupq_n_f32(MaxHalf);
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const uint32x4_t Truncated = vandq_u32(vreinterpretq_u32_f32(vld1q_f32(Source + Index)), TruncateMask);
+		// fminnm returns the number for NaNs, so they clamp to the largest half like infinities
+		const float32x4_t Abs = vminnmq_f32(vabsq_f32(vreinterpretq_f32_u32(Truncated)), Max);
+		const uint32x4_t Clamped = vorrq_u32(vreinterpretq_u32_f32(Abs), vandq_u32(Truncated, SignMask));
+		vst1_u16(Dest + Index, vreinterpret_u16_f16(vcvt_f16_f32(vreinterpretq_f32_u32(Clamped))));
+	}
+#endif
+
+	for (; Index < Num; ++Index)
+	{
+		Out[Index].Set(Source[Index]);
+	}
+}
+
+void FQuantizeBatch::HalfToFloat(TArrayView<const FFloat16> In, TArrayView<float> Out)
+{
+	using namespace UE4QuantizeBatch_Private;
+	check(In.Num() == Out.Num());
+
+	const uint16* Source = reinterpret_cast<const uint16*>(In.GetData());
+	float* Dest = Out.GetData();
+	const int32 Num = In.Num();
+	int32 Index = 0;
+
+#if QUANTIZE_BATCH_F16C
+	const __m128 SignMask = _mm_castsi128_ps(_mm_set1_epi32(int32(0x80000000u)));
+	const __m128 Max = _mm_set1_ps(MaxHalf);
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const __m128 Value = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(Source + Index)));
+		// GetFloat turns infinities and NaNs into the largest half
+		const __m128 Abs = _mm_min_ps(_mm_andnot_ps(SignMask, Value), Max);
+		_mm_storeu_ps(Dest + Index, _mm_or_ps(Abs, _mm_and_ps(Value, SignMask)));
+	}
+#elif QUANTIZE_BATCH_NEON_FP16
+	const uint32x4_t SignMask = vdupq_n_u32(0x80000000u);
+	const float32x4_t Max = vdupq_n_f32(MaxHalf);
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const float32x4_t Value = vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Source + Index)));
+		// GetFloat turns infinities and NaNs into the largest half
+		const float32x4_t Abs = vminnmq_f32(vabsq_f32(Value), Max);
+		vst1q_f32(Dest + Index, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(Abs), vandq_u32(vreinterpretq_u32_f32(Value), SignMask))));
+	}
+#endif
+
+	for (; Index < Num; ++Index)
+	{
+		Dest[Index] = In[Index].GetFloat();
+	}
+}
+
+void FQuantizeBatch::QuantizeSNorm8(TArrayView<const float> In, TArrayView<int8> Out)
+{
+	UE4QuantizeBatch_Private::Quantize<true, MAX_int8>(In, Out);
+}
+
+void FQuantizeBatch::DequantizeSNorm8(TArrayView<const int8> In, TArrayView<float> Out)
+{
+	UE4QuantizeBatch_Private::Dequantize<MAX_int8>(In, Out);
+}
+
+void FQuantizeBatch::QuantizeUNorm8(TArrayView<const float> In, TArrayView<uint8> Out)
+{
+	UE4QuantizeBatch_Private::Quantize<false, MAX_uint8>(In, Out);
+}
+
+void FQuantizeBatch::DequantizeUNorm8(TArrayView<const uint8> In, TArrayView<float> Out)
+{
+	UE4QuantizeBatch_Private::Dequantize<MAX_uint8>(In, Out);
+}
+
+void FQuantizeBatch::QuantizeSNorm16(TArrayView<const float> In, TArrayView<int16> Out)
+{
+	UE4QuantizeBatch_Private::Quantize<true, MAX_int16>(In, Out);
+}
+
+void FQuantizeBatch::DequantizeSNorm16(TArrayView<const int16> In, TArrayView<float> Out)
+{
+	UE4QuantizeBatch_Private::Dequantize<MAX_int16>(In, Out);
+}
+
+void FQuantizeBatch::QuantizeUNorm16(TArrayView<const float> In, TArrayView<uint16> Out)
+{
+	UE4QuantizeBatch_Private::Quantize<false, MAX_uint16>(In, Out);
+}
+
+void FQuantizeBatch::DequantizeUNorm16(TArrayView<const uint16> In, TArrayView<float> Out)
+{
+	UE4QuantizeBatch_Private::Dequantize<MAX_uint16>(In, Out);
+}
+
+#undef QUANTIZE_BATCH_F16C
+#undef QUANTIZE_BATCH_NEON_FP16
@@ -2,6 +2,14 @@
 
 
 #include "Math/Sobol.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+
+namespace UE4Sobol_Private
+{
+	// Points per chunk of a batch, each chunk is one task and starts with a full evaluation
+	static const int32 BatchChunkSize = 4096;
+}
 
 float FSobol::Evaluate(int32 Index, int32 Dim, int32 Seed)
 {
@@ -27,6 +35,106 @@ float FSobol::Next(int32 Index, int32 Dim, float Value)
 	return float(Result) * 5.96046448e-08f;	// 2^-24
 }
 
+void FSobol::EvaluateBatch(int32 FirstIndex, int32 NumDims, TArrayView<float> OutValues, TArrayView<const int32> Seeds)
+{
+	using namespace UE4Sobol_Private;
+
+	check(NumDims >= 1 && NumDims <= MaxDimension + 1);
+	check(OutValues.Num() % NumDims == 0);
+	check(Seeds.Num() == 0 || Seeds.Num() >= NumDims);
+
+	const int32 NumPoints = OutValues.Num() / NumDims;
+	check(FirstIndex >= 0 && NumPoints <= MAX_int32 - FirstIndex);
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	// Gray code direction numbers by changed bit, four dimensions per register
+	static const int32 NumGroups = (MaxDimension + 1) / 4;
+	const int32 NumUsedGroups = (NumDims + 3) / 4;
+	VectorRegisterInt GrayByBit[32][NumGroups];
+	for (int32 Bit = 0; Bit < 32; ++Bit)
+	{
+		for (int32 Group = 0; Group < NumGroups; ++Group)
+		{
+			const int32 Dim = Group * 4;
+			GrayByBit[Bit][Group] = MakeVectorRegisterInt(GrayNumbers[Dim][Bit], GrayNumbers[Dim + 1][Bit], GrayNumbers[Dim + 2][Bit], GrayNumbers[Dim + 3][Bit]);
+		}
+	}
+
+	const int32 NumChunks = (NumPoints + BatchChunkSize - 1) / BatchChunkSize;
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 ChunkFirst = ChunkIndex * BatchChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkFirst + BatchChunkSize, NumPoints);
+
+		// Full evaluation of the first point, unused lanes stay zero
+		MS_ALIGN(16) int32 StartValues[MaxDimension + 1] GCC_ALIGN(16) = {};
+		for (int32 Dim = 0; Dim < NumDims; ++Dim)
+		{
+			int32 Result = (Seeds.Num() ? Seeds[Dim] : 0) & 0xffffff;
+			int32 Index = FirstIndex + ChunkFirst;
+			for (int32 Bit = 0; Bit < 32; ++Bit, Index >>= 1)
+			{
+				Result ^= (Index & 1) * DirectionNumbers[Dim][Bit];
+			}
+			StartValues[Dim] = Result;
+		}
+
+		VectorRegisterInt Values[NumGroups];
+		for (int32 Group = 0; Group < NumUsedGroups; ++Group)
+		{
+			Values[Group] = VectorIntLoadAligned(&StartValues[Group * 4]);
+		}
+
+		const VectorRegister Scale = VectorSetFloat1(5.96046448e-08f);	// 2^-24
+		const int32 NumFullGroups = NumDims / 4;
+		for (int32 Point = ChunkFirst; Point < ChunkEnd; ++Point)
+		{
+			if (Point != ChunkFirst)
+			{
+				const int32 ChangedBit = FMath::CountTrailingZeros(FirstIndex + Point) & 31;
+				for (int32 Group = 0; Group < NumUsedGroups; ++Group)
+				{
+					Values[Group] = VectorIntXor(Values[Group], GrayByBit[ChangedBit][Group]);
+				}
+			}
+
+			// Values are below 2^24, the conversion and scale are exact and match Evaluate
+			float* Dest = OutValues.GetData() + int64(Point) * NumDims;
+			for (int32 Group = 0; Group < NumFullGroups; ++Group)
+			{
+				VectorStore(VectorMultiply(VectorIntToFloat(Values[Group]), Scale), Dest + Group * 4);
+			}
+			if (NumFullGroups < NumUsedGroups)
+			{
+				MS_ALIGN(16) float Tail[4] GCC_ALIGN(16);
+				VectorStoreAligned(VectorMultiply(VectorIntToFloat(Values[NumFullGroups]), Scale), Tail);
+				for (int32 Dim = NumFullGroups * 4; Dim < NumDims; ++Dim)
+				{
+					Dest[Dim] = Tail[Dim - NumFullGroups * 4];
+				}
+			}
+		}
+	}, NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void FSobol::ComputeScrambleSeeds(uint32 Seed, TArrayView<int32> OutSeeds)
+{
+	for (int32 Dim = 0; Dim < OutSeeds.Num(); ++Dim)
+	{
+		// Murmur3 finalizer of the seed and dimension
+		uint32 Hash = Seed ^ (uint32(Dim + 1) * 0x9e3779b9u);
+		Hash ^= Hash >> 16;
+		Hash *= 0x85ebca6bu;
+		Hash ^= Hash >> 13;
+		Hash *= 0xc2b2ae35u;
+		Hash ^= Hash >> 16;
+		OutSeeds[Dim] = int32(Hash & 0xffffff);
+	}
+}
+
 FVector2D FSobol::Evaluate(int32 Index, int32 CellBits, FIntPoint Cell, FIntPoint Seed)
 {
 	check(CellBits >= 0 && CellBits <= MaxCell2DBits);
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/TransformBatch.h"
+#include "Math/VectorRegister.h"
+
+namespace UE4TransformBatch_Private
+{
+	/** Out = In * Matrix, with or without the translation row */
+	template <bool bWithTranslation>
+	static void TransformByMatrix(const FMatrix& Matrix, TArrayView<const FVector> In, TArrayView<FVector> Out)
+	{
+		check(In.Num() == Out.Num());
+
+		const VectorRegister Row0 = VectorLoadAligned(&Matrix.M[0][0]);
+		const VectorRegister Row1 = VectorLoadAligned(&Matrix.M[1][0]);
+		const VectorRegister Row2 = VectorLoadAligned(&Matrix.M[2][0]);
+		const VectorRegister Row3 = bWithTranslation ? VectorLoadAligned(&Matrix.M[3][0]) : VectorZero();
+
+		const FVector* Source = In.GetData();
+		FVector* Dest = Out.GetData();
+		const int32 Num = In.Num();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			// Load the components before the store, In and Out may be the same array
+			const FVector& V = Source[Index];
+			VectorRegister Result = VectorMultiplyAdd(VectorSetFloat1(V.X), Row0, Row3);
+			Result = VectorMultiplyAdd(VectorSetFloat1(V.Y), Row1, Result);
+			Result = VectorMultiplyAdd(VectorSetFloat1(V.Z), Row2, Result);
+			VectorStoreFloat3(Result, &Dest[Index]);
+		}
+	}
+
+	/** OutX/Y/Z = (X, Y, Z) * Matrix on separate component arrays, 8 at a time */
+	template <bool bWithTranslation>
+	static void TransformByMatrixSoA(const FMatrix& Matrix, int32 Num, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ)
+	{
+		const VectorRegister8 M00 = VectorSetFloat8(Matrix.M[0][0]), M01 = VectorSetFloat8(Matrix.M[0][1]), M02 = VectorSetFloat8(Matrix.M[0][2]);
+		const VectorRegister8 M10 = VectorSetFloat8(Matrix.M[1][0]), M11 = VectorSetFloat8(Matrix.M[1][1]), M12 = VectorSetFloat8(Matrix.M[1][2]);
+		const VectorRegister8 M20 = VectorSetFloat8(Matrix.M[2][0]), M21 = VectorSetFloat8(Matrix.M[2][1]), M22 = VectorSetFloat8(Matrix.M[2][2]);
+		const VectorRegister8 M30 = bWithTranslation ? VectorSetFloat8(Matrix.M[3][0]) : VectorZero8();
+		const VectorRegister8 M31 = bWithTranslation ? VectorSetFloat8(Matrix.M[3][1]) : VectorZero8();
+		const VectorRegister8 M32 = bWithTranslation ? VectorSetFloat8(Matrix.M[3][2]) : VectorZero8();
+
+		int32 Index = 0;
+		for (; Index + 8 <= Num; Index += 8)
+		{
+			const VectorRegister8 VX = VectorLoad8(X + Index);
+			const VectorRegister8 VY = VectorLoad8(Y + Index);
+			const VectorRegister8 VZ = VectorLoad8(Z + Index);
+			VectorStore8(VectorMultiplyAdd8(VZ, M20, VectorMultiplyAdd8(VY, M10, VectorMultiplyAdd8(VX, M00, M30))), OutX + Index);
+			VectorStore8(VectorMultiplyAdd8(VZ, M21, VectorMultiplyAdd8(VY, M11, VectorMultiplyAdd8(VX, M01, M31))), OutY + Index);
+			VectorStore8(VectorMultiplyAdd8(VZ, M22, VectorMultiplyAdd8(VY, M12, VectorMultiplyAdd8(VX, M02, M32))), OutZ + Index);
+		}
+
+		for (; Index < Num; ++Index)
+		{
+			const FVector V(X[Index], Y[Index], Z[Index]);
+			const FVector Result = bWithTranslation ? Matrix.TransformPosition(V) : Matrix.TransformVector(V);
+			OutX[Index] = Result.X;
+			OutY[Index] = Result.Y;
+			OutZ[Index] = Result.Z;
+		}
+	}
+}
+
+void FTransformBatch::TransformPositions(const FTransform& Transform, TArrayView<const FVector> Positions, TArrayView<FVector> OutPositions)
+{
+	UE4TransformBatch_Private::TransformByMatrix<true>(Transform.ToMatrixWithScale(), Positions, OutPositions);
+}
+
+void FTransformBatch::TransformVectors(const FTransform& Transform, TArrayView<const FVector> Vectors, TArrayView<FVector> OutVectors)
+{
+	UE4TransformBatch_Private::TransformByMatrix<false>(Transform.ToMatrixWithScale(), Vectors, OutVectors);
+}
+
+void FTransformBatch::TransformPositions(const FMatrix& Matrix, TArrayView<const FVector> Positions, TArrayView<FVector> OutPositions)
+{
+	UE4TransformBatch_Private::TransformByMatrix<true>(Matrix, Positions, OutPositions);
+}
+
+void FTransformBatch::TransformVectors(const FMatrix& Matrix, TArrayView<const FVector> Vectors, TArrayView<FVector> OutVectors)
+{
+	UE4TransformBatch_Private::TransformByMatrix<false>(Matrix, Vectors, OutVectors);
+}
+
+void FTransformBatch::TransformPositionsSoA(const FTransform& Transform, int32 Num, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ)
+{
+	UE4TransformBatch_Private::TransformByMatrixSoA<true>(Transform.ToMatrixWithScale(), Num, X, Y, Z, OutX, OutY, OutZ);
+}
+
+void FTransformBatch::TransformVectorsSoA(const FTransform& Transform, int32 Num, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ)
+{
+	UE4TransformBatch_Private::TransformByMatrixSoA<false>(Transform.ToMatrixWithScale(), Num, X, Y, Z, OutX, OutY, OutZ);
+}
+
+void FTransformBatch::MultiplyTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, TArrayView<FTransform> OutTransforms)
+{
+	check(A.Num() == OutTransforms.Num() && B.Num() == OutTransforms.Num());
+
+	const int32 Num = OutTransforms.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FTransform::Multiply(&OutTransforms[Index], &A[Index], &B[Index]);
+	}
+}
+
+void FTransformBatch::MultiplyTransforms(TArrayView<const FTransform> A, const FTransform& B, TArrayView<FTransform> OutTransforms)
+{
+	check(A.Num() == OutTransforms.Num());
+
+	// B may be one of the outputs, it must not change while the batch runs
+	const FTransform Parent = B;
+	const int32 Num = OutTransforms.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FTransform::Multiply(&OutTransforms[Index], &A[Index], &Parent);
+	}
+}
+
+void FTransformBatch::MultiplyMatrices(TArrayView<const FMatrix> A, TArrayView<const FMatrix> B, TArrayView<FMatrix> OutMatrices)
+{
+	check(A.Num() == OutMatrices.Num() && B.Num() == OutMatrices.Num());
+
+	const int32 Num = OutMatrices.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		// Not all backends support the result aliasing an input
+		FMatrix Result;
+		VectorMatrixMultiply(&Result, &A[Index], &B[Index]);
+		OutMatrices[Index] = Result;
+	}
+}
+
+void FTransformBatch::BlendTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, float Alpha, TArrayView<FTransform> OutTransforms)
+{
+	check(A.Num() == OutTransforms.Num() && B.Num() == OutTransforms.Num());
+
+	const int32 Num = OutTransforms.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		OutTransforms[Index].Blend(A[Index], B[Index], Alpha);
+	}
+}
+
+void FTransformBatch::BlendTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, TArrayView<const float> Alphas, TArrayView<FTransform> OutTransforms)
+{
+	check(A.Num() == OutTransforms.Num() && B.Num() == OutTransforms.Num() && Alphas.Num() == OutTransforms.Num());
+
+	const int32 Num = OutTransforms.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		OutTransforms[Index].Blend(A[Index], B[Index], Alphas[Index]);
+	}
+}
+
+void FTransformBatch::QuatsToMatrices(TArrayView<const FQuat> Quats, TArrayView<FMatrix> OutMatrices)
+{
+	check(Quats.Num() == OutMatrices.Num());
+
+	// Same as FQuatRotationTranslationMatrix with a zero origin, without its per element checks
+	const FQuat* RESTRICT Source = Quats.GetData();
+	FMatrix* RESTRICT Dest = OutMatrices.GetData();
+	const int32 Num = Quats.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FQuat& Q = Source[Index];
+		float (&M)[4][4] = Dest[Index].M;
+
+		const float x2 = Q.X + Q.X;  const float y2 = Q.Y + Q.Y;  const float z2 = Q.Z + Q.Z;
+		const float xx = Q.X * x2;   const float xy = Q.X * y2;   const float xz = Q.X * z2;
+		const float yy = Q.Y * y2;   const float yz = Q.Y * z2;   const float zz = Q.Z * z2;
+		const float wx = Q.W * x2;   const float wy = Q.W * y2;   const float wz = Q.W * z2;
+
+		M[0][0] = 1.0f - (yy + zz);	M[1][0] = xy - wz;				M[2][0] = xz + wy;			M[3][0] = 0.0f;
+		M[0][1] = xy + wz;			M[1][1] = 1.0f - (xx + zz);		M[2][1] = yz - wx;			M[3][1] = 0.0f;
+		M[0][2] = xz - wy;			M[1][2] = yz + wx;				M[2][2] = 1.0f - (xx + yy);	M[3][2] = 0.0f;
+		M[0][3] = 0.0f;				M[1][3] = 0.0f;					M[2][3] = 0.0f;				M[3][3] = 1.0f;
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/UnrealMathApprox.h"
+#include "Misc/AssertionMacros.h"
+
+namespace UE4MathApprox_Private
+{
+	/** Out[i] = Function(A[i]), 4 at a time. The tail goes through a padded register so every element sees the same code */
+	template <typename FunctionType>
+	static void Apply(TArrayView<const float> A, TArrayView<float> Out, FunctionType Function)
+	{
+		check(A.Num() == Out.Num());
+
+		const int32 Num = A.Num();
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			VectorStore(Function(VectorLoad(A.GetData() + Index)), Out.GetData() + Index);
+		}
+
+		if (Index < Num)
+		{
+			MS_ALIGN(16) float Tail[4] GCC_ALIGN(16) = { 1.0f, 1.0f, 1.0f, 1.0f };
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Tail[TailIndex] = A[Index + TailIndex];
+			}
+			VectorStoreAligned(Function(VectorLoadAligned(Tail)), Tail);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Out[Index + TailIndex] = Tail[TailIndex];
+			}
+		}
+	}
+
+	/** Out[i] = Function(A[i], B[i]), 4 at a time */
+	template <typename FunctionType>
+	static void Apply(TArrayView<const float> A, TArrayView<const float> B, TArrayView<float> Out, FunctionType Function)
+	{
+		check(A.Num() == Out.Num() && B.Num() == Out.Num());
+
+		const int32 Num = A.Num();
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			VectorStore(Function(VectorLoad(A.GetData() + Index), VectorLoad(B.GetData() + Index)), Out.GetData() + Index);
+		}
+
+		if (Index < Num)
+		{
+			MS_ALIGN(16) float TailA[4] GCC_ALIGN(16) = { 1.0f, 1.0f, 1.0f, 1.0f };
+			MS_ALIGN(16) float TailB[4] GCC_ALIGN(16) = { 1.0f, 1.0f, 1.0f, 1.0f };
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				TailA[TailIndex] = A[Index + TailIndex];
+				TailB[TailIndex] = B[Index + TailIndex];
+			}
+			VectorStoreAligned(Function(VectorLoadAligned(TailA), VectorLoadAligned(TailB)), TailA);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				Out[Index + TailIndex] = TailA[TailIndex];
+			}
+		}
+	}
+
+	template <EApproxMathPrecision Precision>
+	static void SinCos(TArrayView<const float> X, TArrayView<float> OutSin, TArrayView<float> OutCos)
+	{
+		check(X.Num() == OutSin.Num() && X.Num() == OutCos.Num());
+
+		const int32 Num = X.Num();
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			VectorRegister Sin, Cos;
+			VectorApproxSinCos<Precision>(VectorLoad(X.GetData() + Index), Sin, Cos);
+			VectorStore(Sin, OutSin.GetData() + Index);
+			VectorStore(Cos, OutCos.GetData() + Index);
+		}
+
+		if (Index < Num)
+		{
+			MS_ALIGN(16) float TailSin[4] GCC_ALIGN(16) = { 0.0f, 0.0f, 0.0f, 0.0f };
+			MS_ALIGN(16) float TailCos[4] GCC_ALIGN(16);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				TailSin[TailIndex] = X[Index + TailIndex];
+			}
+			VectorRegister Sin, Cos;
+			VectorApproxSinCos<Precision>(VectorLoadAligned(TailSin), Sin, Cos);
+			VectorStoreAligned(Sin, TailSin);
+			VectorStoreAligned(Cos, TailCos);
+			for (int32 TailIndex = 0; Index + TailIndex < Num; ++TailIndex)
+			{
+				OutSin[Index + TailIndex] = TailSin[TailIndex];
+				OutCos[Index + TailIndex] = TailCos[TailIndex];
+			}
+		}
+	}
+}
+
+#define APPROX_MATH_DISPATCH(Precision, Call) \
+	if (Precision == EApproxMathPrecision::Fast) \
+	{ \
+		static constexpr EApproxMathPrecision P = EApproxMathPrecision::Fast; \
+		Call; \
+	} \
+	else \
+	{ \
+		static constexpr EApproxMathPrecision P = EApproxMathPrecision::Accurate; \
+		Call; \
+	}
+
+void FApproxMath::Sin(TArrayView<const float> X, TArrayView<float> OutSin, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutSin, [](const VectorRegister& V) { return VectorApproxSin<P>(V); }));
+}
+
+void FApproxMath::Cos(TArrayView<const float> X, TArrayView<float> OutCos, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutCos, [](const VectorRegister& V) { return VectorApproxCos<P>(V); }));
+}
+
+void FApproxMath::SinCos(TArrayView<const float> X, TArrayView<float> OutSin, TArrayView<float> OutCos, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::SinCos<P>(X, OutSin, OutCos));
+}
+
+void FApproxMath::Atan2(TArrayView<const float> Y, TArrayView<const float> X, TArrayView<float> OutAtan2, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(Y, X, OutAtan2, [](const VectorRegister& VY, const VectorRegister& VX) { return VectorApproxAtan2<P>(VY, VX); }));
+}
+
+void FApproxMath::Exp(TArrayView<const float> X, TArrayView<float> OutExp, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutExp, [](const VectorRegister& V) { return VectorApproxExp<P>(V); }));
+}
+
+void FApproxMath::Log(TArrayView<const float> X, TArrayView<float> OutLog, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutLog, [](const VectorRegister& V) { return VectorApproxLog<P>(V); }));
+}
+
+void FApproxMath::Pow(TArrayView<const float> X, TArrayView<const float> Y, TArrayView<float> OutPow, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, Y, OutPow, [](const VectorRegister& VX, const VectorRegister& VY) { return VectorApproxPow<P>(VX, VY); }));
+}
+
+void FApproxMath::Sqrt(TArrayView<const float> X, TArrayView<float> OutSqrt, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutSqrt, [](const VectorRegister& V) { return VectorApproxSqrt<P>(V); }));
+}
+
+void FApproxMath::ReciprocalSqrt(TArrayView<const float> X, TArrayView<float> OutReciprocalSqrt, EApproxMathPrecision Precision)
+{
+	APPROX_MATH_DISPATCH(Precision, UE4MathApprox_Private::Apply(X, OutReciprocalSqrt, [](const VectorRegister& V) { return VectorApproxReciprocalSqrt<P>(V); }));
+}
+
+#undef APPROX_MATH_DISPATCH
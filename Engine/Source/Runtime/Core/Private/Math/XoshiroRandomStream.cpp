@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/XoshiroRandomStream.h"
+
+namespace UE4XoshiroRandomStream_Private
+{
+	static uint64 SplitMix64(uint64& InOutState)
+	{
+		uint64 Result = (InOutState += 0x9e3779b97f4a7c15ull);
+		Result = (Result ^ (Result >> 30)) * 0xbf58476d1ce4e5b9ull;
+		Result = (Result ^ (Result >> 27)) * 0x94d049bb133111ebull;
+		return Result ^ (Result >> 31);
+	}
+
+	static const uint32 JumpPolynomial[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+	static const uint32 LongJumpPolynomial[4] = { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+
+	static const int32 NumLanes = 4;
+}
+
+void FXoshiroRandomStream::Initialize(uint64 InSeed)
+{
+	using namespace UE4XoshiroRandomStream_Private;
+
+	uint64 SplitMixState = InSeed;
+	const uint64 Low = SplitMix64(SplitMixState);
+	const uint64 High = SplitMix64(SplitMixState);
+	State[0] = uint32(Low);
+	State[1] = uint32(Low >> 32);
+	State[2] = uint32(High);
+	State[3] = uint32(High >> 32);
+
+	// An all zero state would only ever produce zeros
+	if ((State[0] | State[1] | State[2] | State[3]) == 0)
+	{
+		State[0] = 1;
+	}
+}
+
+FVector FXoshiroRandomStream::GetUnitVector()
+{
+	FVector Result;
+	float L;
+	do
+	{
+		// Check random vectors in the unit sphere so result is statistically uniform.
+		Result.X = GetFraction() * 2.f - 1.f;
+		Result.Y = GetFraction() * 2.f - 1.f;
+		Result.Z = GetFraction() * 2.f - 1.f;
+		L = Result.SizeSquared();
+	}
+	while (L > 1.f || L < KINDA_SMALL_NUMBER);
+
+	return Result.GetUnsafeNormal();
+}
+
+void FXoshiroRandomStream::ApplyJump(const uint32 (&Polynomial)[4])
+{
+	uint32 Jumped[4] = { 0, 0, 0, 0 };
+	for (int32 Word = 0; Word < 4; ++Word)
+	{
+		for (int32 Bit = 0; Bit < 32; ++Bit)
+		{
+			if (Polynomial[Word] & (1u << Bit))
+			{
+				Jumped[0] ^= State[0];
+				Jumped[1] ^= State[1];
+				Jumped[2] ^= State[2];
+				Jumped[3] ^= State[3];
+			}
+			GetUnsignedInt();
+		}
+	}
+	FMemory::Memcpy(State, Jumped, sizeof(State));
+}
+
+void FXoshiroRandomStream::Jump()
+{
+	ApplyJump(UE4XoshiroRandomStream_Private::JumpPolynomial);
+}
+
+void FXoshiroRandomStream::LongJump()
+{
+	ApplyJump(UE4XoshiroRandomStream_Private::LongJumpPolynomial);
+}
+
+FXoshiroRandomStream FXoshiroRandomStream::GetSubstream(int32 Index) const
+{
+	check(Index >= 0);
+
+	FXoshiroRandomStream Substream(*this);
+	for (int32 Jumps = 0; Jumps <= Index; ++Jumps)
+	{
+		Substream.LongJump();
+	}
+	return Substream;
+}
+
+template <typename OutputFunction>
+void FXoshiroRandomStream::Fill(int32 Num, OutputFunction Output)
+{
+	using namespace UE4XoshiroRandomStream_Private;
+
+	if (Num <= 0)
+	{
+		return;
+	}
+
+	// Lane L is this stream jumped L times, kept as structure of arrays so the lane loops compile to vector instructions.
+	// Jumps commute with stepping, so rebuilding the lanes from lane 0 on the next fill continues where they stopped.
+	MS_ALIGN(16) uint32 S0[NumLanes] GCC_ALIGN(16);
+	MS_ALIGN(16) uint32 S1[NumLanes] GCC_ALIGN(16);
+	MS_ALIGN(16) uint32 S2[NumLanes] GCC_ALIGN(16);
+	MS_ALIGN(16) uint32 S3[NumLanes] GCC_ALIGN(16);
+	FXoshiroRandomStream Lane(*this);
+	for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+	{
+		S0[LaneIndex] = Lane.State[0];
+		S1[LaneIndex] = Lane.State[1];
+		S2[LaneIndex] = Lane.State[2];
+		S3[LaneIndex] = Lane.State[3];
+		if (LaneIndex + 1 < NumLanes)
+		{
+			Lane.Jump();
+		}
+	}
+
+	MS_ALIGN(16) uint32 Results[NumLanes] GCC_ALIGN(16);
+	for (int32 First = 0; First < Num; First += NumLanes)
+	{
+		for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+		{
+			const uint32 Scaled = (S1[LaneIndex] << 2) + S1[LaneIndex];
+			const uint32 Rotated = RotateLeft(Scaled, 7);
+			Results[LaneIndex] = (Rotated << 3) + Rotated;
+
+			const uint32 Shifted = S1[LaneIndex] << 9;
+			S2[LaneIndex] ^= S0[LaneIndex];
+			S3[LaneIndex] ^= S1[LaneIndex];
+			S1[LaneIndex] ^= S2[LaneIndex];
+			S0[LaneIndex] ^= S3[LaneIndex];
+			S2[LaneIndex] ^= Shifted;
+			S3[LaneIndex] = RotateLeft(S3[LaneIndex], 11);
+		}
+
+		const int32 Count = FMath::Min(NumLanes, Num - First);
+		for (int32 LaneIndex = 0; LaneIndex < Count; ++LaneIndex)
+		{
+			Output(First + LaneIndex, Results[LaneIndex]);
+		}
+	}
+
+	State[0] = S0[0];
+	State[1] = S1[0];
+	State[2] = S2[0];
+	State[3] = S3[0];
+}
+
+void FXoshiroRandomStream::FillUnsignedInts(TArrayView<uint32> Out)
+{
+	uint32* Dest = Out.GetData();
+	Fill(Out.Num(), [Dest](int32 Index, uint32 Value) { Dest[Index] = Value; });
+}
+
+void FXoshiroRandomStream::FillFractions(TArrayView<float> Out)
+{
+	float* Dest = Out.GetData();
+	Fill(Out.Num(), [Dest](int32 Index, uint32 Value) { Dest[Index] = float(Value >> 8) * (1.0f / 16777216.0f); });
+}
+
+void FXoshiroRandomStream::FillRange(TArrayView<float> Out, float InMin, float InMax)
+{
+	float* Dest = Out.GetData();
+	const float Scale = (InMax - InMin) * (1.0f / 16777216.0f);
+	Fill(Out.Num(), [Dest, InMin, Scale](int32 Index, uint32 Value) { Dest[Index] = InMin + float(Value >> 8) * Scale; });
+}
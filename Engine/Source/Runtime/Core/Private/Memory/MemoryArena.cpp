@@ -5,6 +5,7 @@
 #include "HAL/MallocAnsi.h"
 #include "HAL/CriticalSection.h"
 #include "Misc/ScopeRWLock.h"
+#include "Templates/AlignmentTemplates.h"
 #include <atomic>
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
@@ -167,6 +168,11 @@ UE_NOALIAS void FMemoryArena::Free(const void* MemoryBlock)
 	return InternalFree(MemoryBlock, 0);
 }
 
+void* FMemoryArena::Realloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment)
+{
+	return InternalRealloc(MemoryBlock, OldSize, NewSize, Alignment);
+}
+
 SIZE_T FMemoryArena::BlockSize(const void* MemoryBlock) const
 {
 	return InternalBlockSize(MemoryBlock);
@@ -181,6 +187,20 @@ void FMemoryArena::InternalFree(const void* MemoryBlock, SIZE_T MemoryBlockSize)
 {
 }
 
+void* FMemoryArena::InternalRealloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment)
+{
+	void* NewBlock = InternalAlloc(NewSize, Alignment);
+
+	if (MemoryBlock)
+	{
+		FMemory::Memcpy(NewBlock, MemoryBlock, FMath::Min(OldSize, NewSize));
+
+		Free(MemoryBlock);
+	}
+
+	return NewBlock;
+}
+
 const TCHAR* FMemoryArena::InternalGetDebugName() const
 {
 	return TEXT("(unnamed)");
@@ -202,16 +222,23 @@ FArenaPointer ArenaRealloc(FMemoryArena* Arena, void* InPtr, SIZE_T OldSize, SIZ
 		return FArenaPointer();
 	}
 
-	void* NewPtr = Arena->Alloc(NewSize, Alignment);
+	void* NewPtr = Arena->Realloc(InPtr, OldSize, NewSize, Alignment);
 
-	if (InPtr)
-	{
-		FMemory::Memcpy(NewPtr, InPtr, FMath::Min(OldSize, NewSize));
+	return FArenaPointer(NewPtr, Arena->ArenaId);
+}
 
-		Arena->Free(InPtr);
-	}
+static thread_local FMemoryArena* GActiveMemoryArena = nullptr;
 
-	return FArenaPointer(NewPtr, Arena->ArenaId);
+FMemoryArena* GetActiveMemoryArena()
+{
+	return GActiveMemoryArena;
+}
+
+FMemoryArena* SetActiveMemoryArena(FMemoryArena* Arena)
+{
+	FMemoryArena* PreviousArena = GActiveMemoryArena;
+	GActiveMemoryArena = Arena;
+	return PreviousArena;
 }
 
 FArenaPointer ArenaRealloc(FArenaPointer InPtr, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment)
@@ -287,6 +314,103 @@ const TCHAR* FMallocArena::InternalGetDebugName() const
 
 //////////////////////////////////////////////////////////////////////////
 
+FLinearArena::FLinearArena(SIZE_T InChunkSize)
+: ChunkSize(InChunkSize)
+{
+}
+
+FLinearArena::~FLinearArena()
+{
+	while (FChunk* Chunk = Chunks)
+	{
+		Chunks = Chunk->Next;
+		FMemory::Free(Chunk);
+	}
+}
+
+void FLinearArena::Reset()
+{
+	if (!Chunks)
+	{
+		return;
+	}
+
+	while (FChunk* Chunk = Chunks->Next)
+	{
+		Chunks->Next = Chunk->Next;
+		FMemory::Free(Chunk);
+	}
+
+	Cursor		= reinterpret_cast<uint8*>(Chunks + 1);
+	End			= reinterpret_cast<uint8*>(Chunks) + Chunks->Size;
+	LastBlock	= nullptr;
+}
+
+void FLinearArena::AllocateChunk(SIZE_T MinSize)
+{
+	const SIZE_T AllocSize = FMath::Max(ChunkSize, MinSize + sizeof(FChunk));
+
+	FChunk* Chunk	= reinterpret_cast<FChunk*>(FMemory::Malloc(AllocSize));
+	Chunk->Next		= Chunks;
+	Chunk->Size		= AllocSize;
+	Chunks			= Chunk;
+
+	Cursor			= reinterpret_cast<uint8*>(Chunk + 1);
+	End				= reinterpret_cast<uint8*>(Chunk) + AllocSize;
+	LastBlock		= nullptr;
+}
+
+void* FLinearArena::InternalAlloc(SIZE_T Size, SIZE_T Alignment)
+{
+	if (!Cursor || Align(Cursor, Alignment) + Size > End)
+	{
+		// the rest of the current chunk is abandoned, the next block may need more than what's left anyway
+		AllocateChunk(Size + Alignment);
+	}
+
+	uint8* Result	= Align(Cursor, Alignment);
+	Cursor			= Result + Size;
+	LastBlock		= Result;
+
+	return Result;
+}
+
+void FLinearArena::InternalFree(const void* MemoryBlock, SIZE_T MemoryBlockSize)
+{
+	// only the most recent block can be given back, everything else waits for the reset
+	if (MemoryBlock == LastBlock)
+	{
+		Cursor		= LastBlock;
+		LastBlock	= nullptr;
+	}
+}
+
+SIZE_T FLinearArena::InternalBlockSize(const void* MemoryBlock) const
+{
+	// block sizes are not tracked
+	return MemoryBlock == LastBlock ? SIZE_T(Cursor - LastBlock) : 0;
+}
+
+void* FLinearArena::InternalRealloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment)
+{
+	// the most recent block is followed by free space, so grow or shrink it in place if it fits
+	if (MemoryBlock && MemoryBlock == LastBlock && IsAligned(MemoryBlock, Alignment) && LastBlock + NewSize <= End)
+	{
+		Cursor = LastBlock + NewSize;
+
+		return MemoryBlock;
+	}
+
+	return FMemoryArena::InternalRealloc(MemoryBlock, OldSize, NewSize, Alignment);
+}
+
+const TCHAR* FLinearArena::InternalGetDebugName() const
+{
+	return TEXT("LinearArena");
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 FMallocAnsi GAnsiMalloc;
 
 FAnsiArena::FAnsiArena() = default;
@@ -4,6 +4,7 @@
 #include "Misc/AssertionMacros.h"
 #include "Misc/CString.h"
 #include "Misc/CoreDelegates.h"
+#include "Math/UnrealMathUtility.h"
 
 // This is using the reference implementation of rijndael encryption algorithm
 // http://www.efgh.com/software/rijndael.htm
@@ -1131,6 +1132,269 @@ static void rijndaelDecrypt( const uint32 *rk, int32 nrounds, const uint8 cipher
 	PUTU32( plaintext + 12, s3 );
 }
 
+// Hardware AES, which runs each round as a single instruction and doesn't leak the key through table lookups.
+// AES-NI is detected at runtime as x86 builds don't assume it, ARMv8 Crypto Extensions are used when the target enables them.
+#if PLATFORM_HAS_CPUID && PLATFORM_ENABLE_VECTORINTRINSICS
+	#define UE_AES_NI 1
+	#include <wmmintrin.h>
+	#include "HAL/CPUFeatures.h"
+	#define UE_AES_NI_TARGET UE_CPU_TARGET("aes")
+#else
+	#define UE_AES_NI 0
+#endif
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+	#define UE_AES_ARMV8 1
+	#include <arm_neon.h>
+#else
+	#define UE_AES_ARMV8 0
+#endif
+
+namespace UE4AES_Private
+{
+	static const int32 NumRounds = NROUNDS(AES_KEYBITS);
+
+	/** The round keys in the byte order of the state, as the AES instructions take them */
+	struct FRoundKeys
+	{
+		alignas(16) uint8 Keys[NumRounds + 1][FAES::AESBlockSize];
+	};
+
+	/** A 128 bit big endian counter, as counter mode increments the whole block */
+	struct FCounter
+	{
+		uint64 High;
+		uint64 Low;
+
+		explicit FCounter(const uint8* Block)
+			: High(0)
+			, Low(0)
+		{
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				High = (High << 8) | Block[Index];
+				Low = (Low << 8) | Block[Index + 8];
+			}
+		}
+
+		void Add(uint64 Value)
+		{
+			const uint64 OldLow = Low;
+			Low += Value;
+			High += Low < OldLow;
+		}
+
+		/** Writes the counter block and moves to the next one */
+		void Next(uint8* Block)
+		{
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				Block[Index] = (uint8)(High >> (56 - Index * 8));
+				Block[Index + 8] = (uint8)(Low >> (56 - Index * 8));
+			}
+			Add(1);
+		}
+	};
+
+	static bool HasHardwareAES()
+	{
+#if UE_AES_ARMV8
+		return true;
+#elif UE_AES_NI
+		return FCPUFeatures::Has(ECPUFeatures::AES);
+#else
+		return false;
+#endif
+	}
+
+	static void ExpandEncryptKey(const uint8* KeyBytes, FRoundKeys& OutKeys)
+	{
+		uint32 rk[RKLENGTH(AES_KEYBITS)];
+		rijndaelSetupEncrypt(rk, KeyBytes, AES_KEYBITS);
+		for (int32 Index = 0; Index < RKLENGTH(AES_KEYBITS); ++Index)
+		{
+			PUTU32(OutKeys.Keys[Index / 4] + (Index % 4) * 4, rk[Index]);
+		}
+		FMemory::Memzero(rk);
+	}
+
+	/** Hardware kernels for ECB and counter mode, each keeps four blocks in flight to hide the latency of the rounds */
+	static const int32 NumParallelBlocks = 4;
+
+#if UE_AES_NI
+	UE_AES_NI_TARGET static void ExpandDecryptKey(const FRoundKeys& EncryptKeys, FRoundKeys& OutKeys)
+	{
+		// The equivalent inverse cipher runs the rounds backwards with InvMixColumns applied to the inner keys
+		FMemory::Memcpy(OutKeys.Keys[0], EncryptKeys.Keys[NumRounds], FAES::AESBlockSize);
+		for (int32 Round = 1; Round < NumRounds; ++Round)
+		{
+			_mm_store_si128((__m128i*)OutKeys.Keys[Round], _mm_aesimc_si128(_mm_load_si128((const __m128i*)EncryptKeys.Keys[NumRounds - Round])));
+		}
+		FMemory::Memcpy(OutKeys.Keys[NumRounds], EncryptKeys.Keys[0], FAES::AESBlockSize);
+	}
+
+	template <bool bDecrypt>
+	UE_AES_NI_TARGET static FORCEINLINE void CryptBlocks(const __m128i (&Keys)[NumRounds + 1], __m128i* Blocks, int32 NumBlocks)
+	{
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			Blocks[Index] = _mm_xor_si128(Blocks[Index], Keys[0]);
+		}
+		for (int32 Round = 1; Round < NumRounds; ++Round)
+		{
+			for (int32 Index = 0; Index < NumBlocks; ++Index)
+			{
+				Blocks[Index] = bDecrypt ? _mm_aesdec_si128(Blocks[Index], Keys[Round]) : _mm_aesenc_si128(Blocks[Index], Keys[Round]);
+			}
+		}
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			Blocks[Index] = bDecrypt ? _mm_aesdeclast_si128(Blocks[Index], Keys[NumRounds]) : _mm_aesenclast_si128(Blocks[Index], Keys[NumRounds]);
+		}
+	}
+
+	template <bool bDecrypt>
+	UE_AES_NI_TARGET static void CryptDataECB(const FRoundKeys& RoundKeys, uint8* Contents, uint64 NumBlocks)
+	{
+		__m128i Keys[NumRounds + 1];
+		for (int32 Round = 0; Round <= NumRounds; ++Round)
+		{
+			Keys[Round] = _mm_load_si128((const __m128i*)RoundKeys.Keys[Round]);
+		}
+
+		while (NumBlocks)
+		{
+			const int32 NumBatchBlocks = (int32)FMath::Min<uint64>(NumBlocks, NumParallelBlocks);
+			__m128i Blocks[NumParallelBlocks];
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				Blocks[Index] = _mm_loadu_si128((const __m128i*)Contents + Index);
+			}
+			CryptBlocks<bDecrypt>(Keys, Blocks, NumBatchBlocks);
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				_mm_storeu_si128((__m128i*)Contents + Index, Blocks[Index]);
+			}
+			Contents += NumBatchBlocks * FAES::AESBlockSize;
+			NumBlocks -= NumBatchBlocks;
+		}
+	}
+
+	UE_AES_NI_TARGET static void CryptDataCTR(const FRoundKeys& RoundKeys, uint8* Contents, uint64 NumBlocks, FCounter& Counter)
+	{
+		__m128i Keys[NumRounds + 1];
+		for (int32 Round = 0; Round <= NumRounds; ++Round)
+		{
+			Keys[Round] = _mm_load_si128((const __m128i*)RoundKeys.Keys[Round]);
+		}
+
+		while (NumBlocks)
+		{
+			const int32 NumBatchBlocks = (int32)FMath::Min<uint64>(NumBlocks, NumParallelBlocks);
+			alignas(16) uint8 CounterBlocks[NumParallelBlocks][FAES::AESBlockSize];
+			__m128i Blocks[NumParallelBlocks];
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				Counter.Next(CounterBlocks[Index]);
+				Blocks[Index] = _mm_load_si128((const __m128i*)CounterBlocks[Index]);
+			}
+			CryptBlocks<false>(Keys, Blocks, NumBatchBlocks);
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				__m128i* Block = (__m128i*)Contents + Index;
+				_mm_storeu_si128(Block, _mm_xor_si128(_mm_loadu_si128(Block), Blocks[Index]));
+			}
+			Contents += NumBatchBlocks * FAES::AESBlockSize;
+			NumBlocks -= NumBatchBlocks;
+		}
+	}
+#elif UE_AES_ARMV8
+	static void ExpandDecryptKey(const FRoundKeys& EncryptKeys, FRoundKeys& OutKeys)
+	{
+		// The equivalent inverse cipher runs the rounds backwards with InvMixColumns applied to the inner keys
+		FMemory::Memcpy(OutKeys.Keys[0], EncryptKeys.Keys[NumRounds], FAES::AESBlockSize);
+		for (int32 Round = 1; Round < NumRounds; ++Round)
+		{
+			vst1q_u8(OutKeys.Keys[Round], vaesimcq_u8(vld1q_u8(EncryptKeys.Keys[NumRounds - Round])));
+		}
+		FMemory::Memcpy(OutKeys.Keys[NumRounds], EncryptKeys.Keys[0], FAES::AESBlockSize);
+	}
+
+	template <bool bDecrypt>
+	static FORCEINLINE void CryptBlocks(const uint8x16_t (&Keys)[NumRounds + 1], uint8x16_t* Blocks, int32 NumBlocks)
+	{
+		// AESE and AESD add the round key first, so the last round key is added on its own
+		for (int32 Round = 0; Round < NumRounds - 1; ++Round)
+		{
+			for (int32 Index = 0; Index < NumBlocks; ++Index)
+			{
+				Blocks[Index] = bDecrypt ? vaesimcq_u8(vaesdq_u8(Blocks[Index], Keys[Round])) : vaesmcq_u8(vaeseq_u8(Blocks[Index], Keys[Round]));
+			}
+		}
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			Blocks[Index] = veorq_u8(bDecrypt ? vaesdq_u8(Blocks[Index], Keys[NumRounds - 1]) : vaeseq_u8(Blocks[Index], Keys[NumRounds - 1]), Keys[NumRounds]);
+		}
+	}
+
+	template <bool bDecrypt>
+	static void CryptDataECB(const FRoundKeys& RoundKeys, uint8* Contents, uint64 NumBlocks)
+	{
+		uint8x16_t Keys[NumRounds + 1];
+		for (int32 Round = 0; Round <= NumRounds; ++Round)
+		{
+			Keys[Round] = vld1q_u8(RoundKeys.Keys[Round]);
+		}
+
+		while (NumBlocks)
+		{
+			const int32 NumBatchBlocks = (int32)FMath::Min<uint64>(NumBlocks, NumParallelBlocks);
+			uint8x16_t Blocks[NumParallelBlocks];
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				Blocks[Index] = vld1q_u8(Contents + Index * FAES::AESBlockSize);
+			}
+			CryptBlocks<bDecrypt>(Keys, Blocks, NumBatchBlocks);
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				vst1q_u8(Contents + Index * FAES::AESBlockSize, Blocks[Index]);
+			}
+			Contents += NumBatchBlocks * FAES::AESBlockSize;
+			NumBlocks -= NumBatchBlocks;
+		}
+	}
+
+	static void CryptDataCTR(const FRoundKeys& RoundKeys, uint8* Contents, uint64 NumBlocks, FCounter& Counter)
+	{
+		uint8x16_t Keys[NumRounds + 1];
+		for (int32 Round = 0; Round <= NumRounds; ++Round)
+		{
+			Keys[Round] = vld1q_u8(RoundKeys.Keys[Round]);
+		}
+
+		while (NumBlocks)
+		{
+			const int32 NumBatchBlocks = (int32)FMath::Min<uint64>(NumBlocks, NumParallelBlocks);
+			uint8 CounterBlocks[NumParallelBlocks][FAES::AESBlockSize];
+			uint8x16_t Blocks[NumParallelBlocks];
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				Counter.Next(CounterBlocks[Index]);
+				Blocks[Index] = vld1q_u8(CounterBlocks[Index]);
+			}
+			CryptBlocks<false>(Keys, Blocks, NumBatchBlocks);
+			for (int32 Index = 0; Index < NumBatchBlocks; ++Index)
+			{
+				uint8* Block = Contents + Index * FAES::AESBlockSize;
+				vst1q_u8(Block, veorq_u8(vld1q_u8(Block), Blocks[Index]));
+			}
+			Contents += NumBatchBlocks * FAES::AESBlockSize;
+			NumBlocks -= NumBatchBlocks;
+		}
+	}
+#endif // UE_AES_ARMV8
+}
+
 void FAES::EncryptData(uint8 *Contents, uint32 NumBytes, const FAESKey& Key)
 {
 	checkf(Key.IsValid(), TEXT("No valid encryption key specified"));
@@ -1157,13 +1421,25 @@ void FAES::EncryptData(uint8* Contents, uint32 NumBytes, const uint8* KeyBytes,
 	FMemory::Memcpy( OriginalBlob.GetData(), Contents, NumBytes );
 #endif
 
-	// Set up the rk buffer
-	nrounds = rijndaelSetupEncrypt(rk, KeyBytes, AES_KEYBITS);
-
-	// Encrypt the data a block at a time
-	for( uint32 Offset = 0; Offset < NumBytes; Offset += AESBlockSize )
+#if UE_AES_NI || UE_AES_ARMV8
+	if (UE4AES_Private::HasHardwareAES())
 	{
-		rijndaelEncrypt( rk, nrounds, Contents + Offset, Contents + Offset );
+		UE4AES_Private::FRoundKeys RoundKeys;
+		UE4AES_Private::ExpandEncryptKey(KeyBytes, RoundKeys);
+		UE4AES_Private::CryptDataECB<false>(RoundKeys, Contents, NumBytes / AESBlockSize);
+		FMemory::Memzero(RoundKeys);
+	}
+	else
+#endif
+	{
+		// Set up the rk buffer
+		nrounds = rijndaelSetupEncrypt(rk, KeyBytes, AES_KEYBITS);
+
+		// Encrypt the data a block at a time
+		for( uint32 Offset = 0; Offset < NumBytes; Offset += AESBlockSize )
+		{
+			rijndaelEncrypt( rk, nrounds, Contents + Offset, Contents + Offset );
+		}
 	}
 
 #if TEST_ENCRYPTION
@@ -1196,12 +1472,97 @@ void FAES::DecryptData(uint8* Contents, uint32 NumBytes, const uint8* KeyBytes,
 	checkf((NumBytes & (AESBlockSize - 1)) == 0, TEXT("NumBytes needs to tbe a multiple of 16 bytes"));
 	checkf(NumKeyBytes >= KEYLENGTH(AES_KEYBITS), TEXT("AES key needs to be at least %d characters"), KEYLENGTH(AES_KEYBITS));
 
-	// Set up the rk buffer
-	nrounds = rijndaelSetupDecrypt(rk, KeyBytes, AES_KEYBITS);
+#if UE_AES_NI || UE_AES_ARMV8
+	if (UE4AES_Private::HasHardwareAES())
+	{
+		UE4AES_Private::FRoundKeys EncryptKeys;
+		UE4AES_Private::FRoundKeys DecryptKeys;
+		UE4AES_Private::ExpandEncryptKey(KeyBytes, EncryptKeys);
+		UE4AES_Private::ExpandDecryptKey(EncryptKeys, DecryptKeys);
+		UE4AES_Private::CryptDataECB<true>(DecryptKeys, Contents, NumBytes / AESBlockSize);
+		FMemory::Memzero(EncryptKeys);
+		FMemory::Memzero(DecryptKeys);
+	}
+	else
+#endif
+	{
+		// Set up the rk buffer
+		nrounds = rijndaelSetupDecrypt(rk, KeyBytes, AES_KEYBITS);
+
+		// Decrypt the data a block at a time
+		for( uint32 Offset = 0; Offset < NumBytes; Offset += AESBlockSize )
+		{
+			rijndaelDecrypt( rk, nrounds, Contents + Offset, Contents + Offset );
+		}
+	}
+}
+
+void FAES::CryptDataCTR(uint8* Contents, uint64 NumBytes, const FAESKey& Key, const uint8 (&InitialCounter)[AESBlockSize], uint64 Offset)
+{
+	checkf(Key.IsValid(), TEXT("No valid encryption key specified"));
+
+	UE4AES_Private::FCounter Counter(InitialCounter);
+	Counter.Add(Offset / AESBlockSize);
+
+	// Each block of the key stream is the encrypted counter, so full blocks can be processed in any order
+	auto CryptPartialBlock = [&Counter, &Key](uint8* Block, uint32 BlockOffset, uint32 Count)
+	{
+		uint8 KeyStream[AESBlockSize];
+		Counter.Next(KeyStream);
+		EncryptData(KeyStream, AESBlockSize, Key);
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			Block[Index] ^= KeyStream[BlockOffset + Index];
+		}
+	};
+
+	// Finish the block Offset starts in
+	if (const uint32 BlockOffset = (uint32)(Offset % AESBlockSize))
+	{
+		const uint32 Count = (uint32)FMath::Min<uint64>(AESBlockSize - BlockOffset, NumBytes);
+		CryptPartialBlock(Contents, BlockOffset, Count);
+		Contents += Count;
+		NumBytes -= Count;
+	}
 
-	// Decrypt the data a block at a time
-	for( uint32 Offset = 0; Offset < NumBytes; Offset += AESBlockSize )
+	const uint64 NumBlocks = NumBytes / AESBlockSize;
+#if UE_AES_NI || UE_AES_ARMV8
+	if (UE4AES_Private::HasHardwareAES())
 	{
-		rijndaelDecrypt( rk, nrounds, Contents + Offset, Contents + Offset );
+		UE4AES_Private::FRoundKeys RoundKeys;
+		UE4AES_Private::ExpandEncryptKey(Key.Key, RoundKeys);
+		UE4AES_Private::CryptDataCTR(RoundKeys, Contents, NumBlocks, Counter);
+		FMemory::Memzero(RoundKeys);
 	}
+	else
+#endif
+	{
+		uint32 rk[RKLENGTH(AES_KEYBITS)] = { 0 };
+		const int32 nrounds = rijndaelSetupEncrypt(rk, Key.Key, AES_KEYBITS);
+		for (uint64 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			uint8 KeyStream[AESBlockSize];
+			Counter.Next(KeyStream);
+			rijndaelEncrypt(rk, nrounds, KeyStream, KeyStream);
+
+			uint8* Block = Contents + BlockIndex * AESBlockSize;
+			for (uint32 Index = 0; Index < AESBlockSize; ++Index)
+			{
+				Block[Index] ^= KeyStream[Index];
+			}
+		}
+	}
+	Contents += NumBlocks * AESBlockSize;
+	NumBytes -= NumBlocks * AESBlockSize;
+
+	// The data may end part way through a block
+	if (NumBytes)
+	{
+		CryptPartialBlock(Contents, 0, (uint32)NumBytes);
+	}
+}
+
+bool FAES::IsHardwareAccelerated()
+{
+	return UE4AES_Private::HasHardwareAES();
 }
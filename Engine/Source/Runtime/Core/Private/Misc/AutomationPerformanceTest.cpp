@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationPerformanceTest.h"
+#include "Containers/Map.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MallocCountingProxy.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static float GAutomationPerformanceTimeTolerance = 0.1f;
+static FAutoConsoleVariableRef CVarAutomationPerformanceTimeTolerance(
+	TEXT("Automation.Performance.TimeTolerance"),
+	GAutomationPerformanceTimeTolerance,
+	TEXT("Fraction a performance test may be slower than its baseline, on top of the noise of the runs.")
+	);
+
+static float GAutomationPerformanceAllocationTolerance = 0.0f;
+static FAutoConsoleVariableRef CVarAutomationPerformanceAllocationTolerance(
+	TEXT("Automation.Performance.AllocationTolerance"),
+	GAutomationPerformanceAllocationTolerance,
+	TEXT("Fraction a performance test may allocate more than its baseline, in count and bytes.")
+	);
+
+static int32 GAutomationPerformanceUpdateBaselines = 0;
+static FAutoConsoleVariableRef CVarAutomationPerformanceUpdateBaselines(
+	TEXT("Automation.Performance.UpdateBaselines"),
+	GAutomationPerformanceUpdateBaselines,
+	TEXT("1 to record what performance tests measure as their baselines instead of checking against them.")
+	);
+
+static FAutoConsoleVariable CVarAutomationPerformanceBaselineFile(
+	TEXT("Automation.Performance.BaselineFile"),
+	TEXT(""),
+	TEXT("File the baselines of performance tests are read from and written to, empty for Build/PerformanceBaselines/<Platform>.txt in the project.")
+	);
+
+namespace UE4AutomationPerformanceTest_Private
+{
+	/** Baselines by test and metric name, one per line in the file: Name<tab>Seconds<tab>DeviationSeconds<tab>NumAllocations<tab>AllocatedBytes */
+	class FBaselines
+	{
+	public:
+		static FBaselines& Get()
+		{
+			static FBaselines Baselines;
+			return Baselines;
+		}
+
+		bool Find(const FString& Name, FAutomationPerformanceMetrics& OutMetrics)
+		{
+			FScopeLock ScopeLock(&Critical);
+			Load();
+			if (const FAutomationPerformanceMetrics* Found = Metrics.Find(Name))
+			{
+				OutMetrics = *Found;
+				return true;
+			}
+			return false;
+		}
+
+		bool Update(const FString& Name, const FAutomationPerformanceMetrics& InMetrics)
+		{
+			FScopeLock ScopeLock(&Critical);
+			Load();
+			Metrics.Add(Name, InMetrics);
+			Metrics.KeySort(TLess<FString>());
+
+			FString Text;
+			for (const TPair<FString, FAutomationPerformanceMetrics>& It : Metrics)
+			{
+				Text += FString::Printf(TEXT("%s\t%.9f\t%.9f\t%llu\t%llu\n"), *It.Key, It.Value.Seconds, It.Value.DeviationSeconds, It.Value.NumAllocations, It.Value.AllocatedBytes);
+			}
+			return FFileHelper::SaveStringToFile(Text, *GetFilename());
+		}
+
+		static FString GetFilename()
+		{
+			const FString Filename = CVarAutomationPerformanceBaselineFile->GetString();
+			return Filename.Len() ? Filename : FPaths::ProjectDir() / TEXT("Build/PerformanceBaselines") / FString(FPlatformProperties::IniPlatformName()) + TEXT(".txt");
+		}
+
+	private:
+		void Load()
+		{
+			if (bLoaded)
+			{
+				return;
+			}
+			bLoaded = true;
+
+			TArray<FString> Lines;
+			FFileHelper::LoadFileToStringArray(Lines, *GetFilename());
+			for (const FString& Line : Lines)
+			{
+				TArray<FString> Fields;
+				if (Line.ParseIntoArray(Fields, TEXT("\t")) == 5)
+				{
+					FAutomationPerformanceMetrics& Baseline = Metrics.Add(Fields[0]);
+					Baseline.Seconds = FCString::Atod(*Fields[1]);
+					Baseline.DeviationSeconds = FCString::Atod(*Fields[2]);
+					Baseline.NumAllocations = FCString::Strtoui64(*Fields[3], nullptr, 10);
+					Baseline.AllocatedBytes = FCString::Strtoui64(*Fields[4], nullptr, 10);
+				}
+			}
+		}
+
+		FCriticalSection Critical;
+		TMap<FString, FAutomationPerformanceMetrics> Metrics;
+		bool bLoaded = false;
+	};
+
+	template <typename T>
+	static T GetMedian(TArray<T>& Values)
+	{
+		Values.Sort();
+		const int32 Num = Values.Num();
+		return Num % 2 ? Values[Num / 2] : (Values[Num / 2 - 1] + Values[Num / 2]) / 2;
+	}
+}
+
+bool FAutomationPerformanceTestBase::MeasurePerformance(const FString& MetricName, TFunctionRef<void()> Body, int32 NumRuns)
+{
+	using namespace UE4AutomationPerformanceTest_Private;
+
+	const bool bCountAllocations = FMallocCountingProxy::Enable();
+	if (!bCountAllocations)
+	{
+		AddWarning(TEXT("Allocations can't be counted on this platform, only time is checked"));
+	}
+
+	Body();
+
+	TArray<double> Times;
+	TArray<uint64> Allocations;
+	TArray<uint64> Bytes;
+	for (int32 Run = 0; Run < FMath::Max(NumRuns, 1); ++Run)
+	{
+		const FMallocThreadCounts StartCounts = FMallocCountingProxy::GetThreadCounts();
+		const double StartTime = FPlatformTime::Seconds();
+		Body();
+		Times.Add(FPlatformTime::Seconds() - StartTime);
+		const FMallocThreadCounts Counts = FMallocCountingProxy::GetThreadCounts() - StartCounts;
+		Allocations.Add(Counts.NumAllocations);
+		Bytes.Add(Counts.AllocatedBytes);
+	}
+
+	FAutomationPerformanceMetrics Metrics;
+	Metrics.Seconds = GetMedian(Times);
+	TArray<double> Deviations;
+	for (double Time : Times)
+	{
+		Deviations.Add(FMath::Abs(Time - Metrics.Seconds));
+	}
+	Metrics.DeviationSeconds = GetMedian(Deviations);
+	if (bCountAllocations)
+	{
+		Metrics.NumAllocations = GetMedian(Allocations);
+		Metrics.AllocatedBytes = GetMedian(Bytes);
+	}
+	return CheckPerformance(MetricName, Metrics);
+}
+
+bool FAutomationPerformanceTestBase::CheckPerformance(const FString& MetricName, const FAutomationPerformanceMetrics& Metrics)
+{
+	using namespace UE4AutomationPerformanceTest_Private;
+
+	const FString Name = GetBeautifiedTestName() + TEXT(".") + MetricName;
+	AddInfo(FString::Printf(TEXT("%s: %.3f ms (+-%.3f), %llu allocations, %llu bytes"), *MetricName, Metrics.Seconds * 1000.0, Metrics.DeviationSeconds * 1000.0, Metrics.NumAllocations, Metrics.AllocatedBytes));
+
+	FBaselines& Baselines = FBaselines::Get();
+	if (GAutomationPerformanceUpdateBaselines || FParse::Param(FCommandLine::Get(), TEXT("updateperformancebaselines")))
+	{
+		if (!Baselines.Update(Name, Metrics))
+		{
+			AddError(FString::Printf(TEXT("Could not write the baseline of %s to %s"), *MetricName, *FBaselines::GetFilename()));
+			return false;
+		}
+		return true;
+	}
+
+	FAutomationPerformanceMetrics Baseline;
+	if (!Baselines.Find(Name, Baseline))
+	{
+		AddWarning(FString::Printf(TEXT("%s has no baseline in %s, run with -updateperformancebaselines to record one"), *MetricName, *FBaselines::GetFilename()));
+		return true;
+	}
+
+	bool bPassed = true;
+	const double Noise = 3.0 * FMath::Max(Baseline.DeviationSeconds, Metrics.DeviationSeconds);
+	const double MaxSeconds = Baseline.Seconds * (1.0 + GAutomationPerformanceTimeTolerance) + Noise;
+	if (Metrics.Seconds > MaxSeconds)
+	{
+		AddError(FString::Printf(TEXT("%s regressed: %.3f ms, the baseline is %.3f ms and at most %.3f ms is allowed"), *MetricName, Metrics.Seconds * 1000.0, Baseline.Seconds * 1000.0, MaxSeconds * 1000.0));
+		bPassed = false;
+	}
+
+	if (FMallocCountingProxy::IsEnabled())
+	{
+		const double Tolerance = 1.0 + GAutomationPerformanceAllocationTolerance;
+		if (double(Metrics.NumAllocations) > double(Baseline.NumAllocations) * Tolerance)
+		{
+			AddError(FString::Printf(TEXT("%s regressed: %llu allocations, the baseline is %llu"), *MetricName, Metrics.NumAllocations, Baseline.NumAllocations));
+			bPassed = false;
+		}
+		if (double(Metrics.AllocatedBytes) > double(Baseline.AllocatedBytes) * Tolerance)
+		{
+			AddError(FString::Printf(TEXT("%s regressed: %llu bytes allocated, the baseline is %llu"), *MetricName, Metrics.AllocatedBytes, Baseline.AllocatedBytes));
+			bPassed = false;
+		}
+	}
+	return bPassed;
+}
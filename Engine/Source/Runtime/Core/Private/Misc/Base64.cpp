@@ -2,6 +2,8 @@
 
 #include "Misc/Base64.h"
 #include "Containers/StringConv.h"
+#include "Misc/StringBuilder.h"
+#include "String/VectorizedAscii.h"
 
 /** The table used to encode a 6 bit value as an ascii character */
 static const uint8 EncodingAlphabet[64] = 
@@ -33,6 +35,120 @@ static const uint8 DecodingAlphabet[256] =
 	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF  // 0xf0-0xff
 };
 
+#if UE_VECTORIZED_ASCII
+namespace UE4Base64_Private
+{
+	using namespace UE4VectorizedAscii_Private;
+
+	/** Encodes 12 bytes as 16 characters, reading 13 bytes from Source */
+	FORCEINLINE FByteVector EncodeBlock(const uint8* Source)
+	{
+		// Each 32 bit lane takes a triplet, bytes A B C as the lower three bytes of the lane in memory order
+		uint32 Triplets[4];
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			FMemory::Memcpy(&Triplets[Index], Source + Index * 3, sizeof(uint32));
+		}
+
+#if UE_VECTORIZED_ASCII_SSE2
+		const __m128i Lanes = _mm_loadu_si128((const __m128i*)Triplets);
+		const __m128i ByteMask = _mm_set1_epi32(0xFF);
+		const __m128i SixBitMask = _mm_set1_epi32(0x3F);
+
+		// A << 16 | B << 8 | C, then its four 6 bit values in character order
+		const __m128i ByteTriplets = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(Lanes, ByteMask), 16), _mm_and_si128(Lanes, _mm_set1_epi32(0xFF00))), _mm_and_si128(_mm_srli_epi32(Lanes, 16), ByteMask));
+		const __m128i Values = _mm_or_si128(
+			_mm_or_si128(_mm_srli_epi32(ByteTriplets, 18), _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(ByteTriplets, 12), SixBitMask), 8)),
+			_mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(ByteTriplets, 6), SixBitMask), 16), _mm_slli_epi32(_mm_and_si128(ByteTriplets, SixBitMask), 24)));
+
+		// Offset each value to its character in the alphabet: A-Z, a-z, 0-9, '+' and '/'
+		__m128i Offsets = _mm_set1_epi8('A');
+		Offsets = _mm_add_epi8(Offsets, _mm_and_si128(_mm_cmpgt_epi8(Values, _mm_set1_epi8(25)), _mm_set1_epi8('a' - 26 - 'A')));
+		Offsets = _mm_sub_epi8(Offsets, _mm_and_si128(_mm_cmpgt_epi8(Values, _mm_set1_epi8(51)), _mm_set1_epi8('a' - 26 - '0' + 52)));
+		Offsets = _mm_sub_epi8(Offsets, _mm_and_si128(_mm_cmpeq_epi8(Values, _mm_set1_epi8(62)), _mm_set1_epi8('0' - 52 - '+' + 62)));
+		Offsets = _mm_sub_epi8(Offsets, _mm_and_si128(_mm_cmpeq_epi8(Values, _mm_set1_epi8(63)), _mm_set1_epi8('0' - 52 - '/' + 63)));
+		return _mm_add_epi8(Values, Offsets);
+#else
+		const uint32x4_t Lanes = vld1q_u32(Triplets);
+		const uint32x4_t ByteMask = vdupq_n_u32(0xFF);
+		const uint32x4_t SixBitMask = vdupq_n_u32(0x3F);
+
+		const uint32x4_t ByteTriplets = vorrq_u32(vorrq_u32(vshlq_n_u32(vandq_u32(Lanes, ByteMask), 16), vandq_u32(Lanes, vdupq_n_u32(0xFF00))), vandq_u32(vshrq_n_u32(Lanes, 16), ByteMask));
+		const uint8x16_t Values = vreinterpretq_u8_u32(vorrq_u32(
+			vorrq_u32(vshrq_n_u32(ByteTriplets, 18), vshlq_n_u32(vandq_u32(vshrq_n_u32(ByteTriplets, 12), SixBitMask), 8)),
+			vorrq_u32(vshlq_n_u32(vandq_u32(vshrq_n_u32(ByteTriplets, 6), SixBitMask), 16), vshlq_n_u32(vandq_u32(ByteTriplets, SixBitMask), 24))));
+
+		uint8x16_t Offsets = vdupq_n_u8('A');
+		Offsets = vaddq_u8(Offsets, vandq_u8(vcgtq_u8(Values, vdupq_n_u8(25)), vdupq_n_u8('a' - 26 - 'A')));
+		Offsets = vsubq_u8(Offsets, vandq_u8(vcgtq_u8(Values, vdupq_n_u8(51)), vdupq_n_u8('a' - 26 - '0' + 52)));
+		Offsets = vsubq_u8(Offsets, vandq_u8(vceqq_u8(Values, vdupq_n_u8(62)), vdupq_n_u8('0' - 52 - '+' + 62)));
+		Offsets = vsubq_u8(Offsets, vandq_u8(vceqq_u8(Values, vdupq_n_u8(63)), vdupq_n_u8('0' - 52 - '/' + 63)));
+		return vaddq_u8(Values, Offsets);
+#endif
+	}
+
+	/** Decodes 16 characters into 12 bytes, writing 13 bytes to Dest. @return false if a character isn't in the alphabet */
+	FORCEINLINE bool DecodeBlock(FByteVector Chars, uint8* Dest)
+	{
+		const FByteVector IsUpper = InRange(Chars, 'A', 'Z');
+		const FByteVector IsLower = InRange(Chars, 'a', 'z');
+		const FByteVector IsDigit = InRange(Chars, '0', '9');
+
+#if UE_VECTORIZED_ASCII_SSE2
+		const __m128i IsPlus = _mm_cmpeq_epi8(Chars, _mm_set1_epi8('+'));
+		const __m128i IsSlash = _mm_cmpeq_epi8(Chars, _mm_set1_epi8('/'));
+		if (!AllSet(_mm_or_si128(_mm_or_si128(_mm_or_si128(IsUpper, IsLower), _mm_or_si128(IsDigit, IsPlus)), IsSlash)))
+		{
+			return false;
+		}
+
+		const __m128i Offsets = _mm_or_si128(
+			_mm_or_si128(_mm_and_si128(IsUpper, _mm_set1_epi8(char(0 - 'A'))), _mm_and_si128(IsLower, _mm_set1_epi8(char(26 - 'a')))),
+			_mm_or_si128(_mm_and_si128(IsDigit, _mm_set1_epi8(52 - '0')), _mm_or_si128(_mm_and_si128(IsPlus, _mm_set1_epi8(62 - '+')), _mm_and_si128(IsSlash, _mm_set1_epi8(63 - '/')))));
+		const __m128i Lanes = _mm_add_epi8(Chars, Offsets);
+
+		// Four 6 bit values per lane in character order make A << 16 | B << 8 | C, written out as A B C
+		const __m128i SixBitMask = _mm_set1_epi32(0x3F);
+		const __m128i ByteTriplets = _mm_or_si128(
+			_mm_or_si128(_mm_slli_epi32(_mm_and_si128(Lanes, SixBitMask), 18), _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(Lanes, 8), SixBitMask), 12)),
+			_mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(Lanes, 16), SixBitMask), 6), _mm_srli_epi32(Lanes, 24)));
+		const __m128i Bytes = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(ByteTriplets, 16), _mm_and_si128(ByteTriplets, _mm_set1_epi32(0xFF00))), _mm_slli_epi32(_mm_and_si128(ByteTriplets, _mm_set1_epi32(0xFF)), 16));
+
+		uint32 Triplets[4];
+		_mm_storeu_si128((__m128i*)Triplets, Bytes);
+#else
+		const uint8x16_t IsPlus = vceqq_u8(Chars, vdupq_n_u8('+'));
+		const uint8x16_t IsSlash = vceqq_u8(Chars, vdupq_n_u8('/'));
+		if (!AllSet(vorrq_u8(vorrq_u8(vorrq_u8(IsUpper, IsLower), vorrq_u8(IsDigit, IsPlus)), IsSlash)))
+		{
+			return false;
+		}
+
+		const uint8x16_t Offsets = vorrq_u8(
+			vorrq_u8(vandq_u8(IsUpper, vdupq_n_u8(uint8(0 - 'A'))), vandq_u8(IsLower, vdupq_n_u8(uint8(26 - 'a')))),
+			vorrq_u8(vandq_u8(IsDigit, vdupq_n_u8(52 - '0')), vorrq_u8(vandq_u8(IsPlus, vdupq_n_u8(62 - '+')), vandq_u8(IsSlash, vdupq_n_u8(63 - '/')))));
+		const uint32x4_t Lanes = vreinterpretq_u32_u8(vaddq_u8(Chars, Offsets));
+
+		const uint32x4_t SixBitMask = vdupq_n_u32(0x3F);
+		const uint32x4_t ByteTriplets = vorrq_u32(
+			vorrq_u32(vshlq_n_u32(vandq_u32(Lanes, SixBitMask), 18), vshlq_n_u32(vandq_u32(vshrq_n_u32(Lanes, 8), SixBitMask), 12)),
+			vorrq_u32(vshlq_n_u32(vandq_u32(vshrq_n_u32(Lanes, 16), SixBitMask), 6), vshrq_n_u32(Lanes, 24)));
+		const uint32x4_t Bytes = vorrq_u32(vorrq_u32(vshrq_n_u32(ByteTriplets, 16), vandq_u32(ByteTriplets, vdupq_n_u32(0xFF00))), vshlq_n_u32(vandq_u32(ByteTriplets, vdupq_n_u32(0xFF)), 16));
+
+		uint32 Triplets[4];
+		vst1q_u32(Triplets, Bytes);
+#endif
+
+		// The fourth byte of each lane is overwritten by the next one, the caller leaves room for the last
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			FMemory::Memcpy(Dest + Index * 3, &Triplets[Index], sizeof(uint32));
+		}
+		return true;
+	}
+}
+#endif // UE_VECTORIZED_ASCII
+
 FString FBase64::Encode(const FString& Source)
 {
 	return Encode((uint8*)TCHAR_TO_ANSI(*Source), Source.Len());
@@ -61,6 +177,16 @@ template<typename CharType> uint32 FBase64::Encode(const uint8* Source, uint32 L
 {
 	CharType* EncodedBytes = Dest;
 
+#if UE_VECTORIZED_ASCII
+	// Convert 12 bytes at a time while there are enough left to read 16 bytes
+	for (; Length >= 16; Length -= 12)
+	{
+		UE4VectorizedAscii_Private::StoreChars(EncodedBytes, UE4Base64_Private::EncodeBlock(Source));
+		Source += 12;
+		EncodedBytes += 16;
+	}
+#endif
+
 	// Loop through the buffer converting 3 bytes of binary data at a time
 	while (Length >= 3)
 	{
@@ -127,6 +253,19 @@ template<typename CharType> uint32 FBase64::Encode(const uint8* Source, uint32 L
 template CORE_API uint32 FBase64::Encode<ANSICHAR>(const uint8* Source, uint32 Length, ANSICHAR* Dest);
 template CORE_API uint32 FBase64::Encode<WIDECHAR>(const uint8* Source, uint32 Length, WIDECHAR* Dest);
 
+void FBase64::Encode(const uint8* Source, uint32 Length, FStringBuilderBase& Builder)
+{
+	// Builders always have room for a terminator past their length
+	const int32 Offset = Builder.AddUninitialized(GetEncodedDataSize(Length));
+	Encode(Source, Length, Builder.GetData() + Offset);
+}
+
+void FBase64::Encode(const uint8* Source, uint32 Length, FAnsiStringBuilderBase& Builder)
+{
+	const int32 Offset = Builder.AddUninitialized(GetEncodedDataSize(Length));
+	Encode(Source, Length, Builder.GetData() + Offset);
+}
+
 bool FBase64::Decode(const FString& Source, FString& OutDest)
 {
 	uint32 ExpectedLength = GetDecodedDataSize(Source);
@@ -161,6 +300,20 @@ template<typename CharType> bool FBase64::Decode(const CharType* Source, uint32
 		return false;
 	}
 
+#if UE_VECTORIZED_ASCII
+	// Convert 16 characters at a time while at least one more byte follows them, as each block writes 13 bytes
+	for (; Length >= 18; Length -= 16)
+	{
+		if (!UE4Base64_Private::DecodeBlock(UE4VectorizedAscii_Private::LoadChars(Source), Dest))
+		{
+			// Let the loop below find the invalid character
+			break;
+		}
+		Source += 16;
+		Dest += 12;
+	}
+#endif
+
 	// Convert all the full chunks of data
 	for(; Length >= 4; Length -= 4)
 	{
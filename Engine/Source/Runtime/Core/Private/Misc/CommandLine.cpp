@@ -7,6 +7,10 @@
 #include "Misc/CoreMisc.h"
 #include "Internationalization/Text.h"
 #include "Internationalization/Internationalization.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
+#include "Containers/StringView.h"
+#include "ProfilingDebugging/StartupPhases.h"
 
 /*-----------------------------------------------------------------------------
 	FCommandLine
@@ -18,6 +22,141 @@ TCHAR FCommandLine::OriginalCmdLine[FCommandLine::MaxCommandLineSize] = TEXT("")
 TCHAR FCommandLine::LoggingCmdLine[FCommandLine::MaxCommandLineSize] = TEXT("");
 TCHAR FCommandLine::LoggingOriginalCmdLine[FCommandLine::MaxCommandLineSize] = TEXT("");
 
+namespace UE4CommandLine_Private
+{
+	/** Characters FCString::Strifind won't start a match after */
+	static bool IsWordChar(TCHAR Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') || (Char >= 'a' && Char <= 'z') || (Char >= '0' && Char <= '9');
+	}
+
+	/** Where each word is in the command line, so FParse queries don't have to search all of it */
+	struct FCommandLineIndex
+	{
+		/** The start of every run of letters and digits, by the run, in order */
+		TMap<FString, TArray<int32, TInlineAllocator<1>>> Words;
+		/** Whether each character is after an odd number of quotes, like the bSkipQuotedChars of Strifind counts them */
+		TBitArray<> Quoted;
+		/** The command line indexed, nullptr until the first Set */
+		const TCHAR* String = nullptr;
+
+		void Build(const TCHAR* InString)
+		{
+			Words.Reset();
+			Quoted.Reset();
+
+			bool bInQuotes = false;
+			for (int32 Index = 0; InString[Index]; ++Index)
+			{
+				Quoted.Add(bInQuotes);
+				if (InString[Index] == TEXT('"'))
+				{
+					bInQuotes = !bInQuotes;
+				}
+				else if (IsWordChar(InString[Index]) && (Index == 0 || !IsWordChar(InString[Index - 1])))
+				{
+					int32 End = Index + 1;
+					while (IsWordChar(InString[End]))
+					{
+						++End;
+					}
+					Words.FindOrAdd(FString(End - Index, InString + Index)).Add(Index);
+				}
+			}
+			String = InString;
+		}
+
+		/** Match is split into non-word characters, a word, and the rest which has to start with a non-word character */
+		bool Find(const TCHAR* Match, bool bSkipQuotedChars, const TCHAR*& OutFound) const
+		{
+			int32 PrefixLen = 0;
+			while (Match[PrefixLen] && !IsWordChar(Match[PrefixLen]))
+			{
+				++PrefixLen;
+			}
+			int32 WordLen = 0;
+			while (IsWordChar(Match[PrefixLen + WordLen]))
+			{
+				++WordLen;
+			}
+			const TCHAR* Rest = Match + PrefixLen + WordLen;
+
+			// A match ending in a word could be the start of a longer one, and Strifind compares a non-ASCII first character exactly
+			if (WordLen == 0 || *Rest == 0 || uint32(Match[0]) >= 128)
+			{
+				return false;
+			}
+
+			OutFound = nullptr;
+			if (const TArray<int32, TInlineAllocator<1>>* Starts = Words.FindByKey(FStringView(Match + PrefixLen, WordLen)))
+			{
+				const int32 RestLen = FCString::Strlen(Rest);
+				for (int32 WordStart : *Starts)
+				{
+					const int32 Start = WordStart - PrefixLen;
+					if (Start < 0 || (Start > 0 && IsWordChar(String[Start - 1])) || (bSkipQuotedChars && Quoted[Start]))
+					{
+						continue;
+					}
+					if ((PrefixLen && FCString::Strnicmp(String + Start, Match, PrefixLen)) || FCString::Strnicmp(String + WordStart + WordLen, Rest, RestLen))
+					{
+						continue;
+					}
+					OutFound = String + Start;
+					break;
+				}
+			}
+			return true;
+		}
+
+		/** The same checks as FParse::Param, for a Param starting with a word */
+		bool Param(const TCHAR* Param, bool& bOutFound) const
+		{
+			int32 WordLen = 0;
+			while (IsWordChar(Param[WordLen]))
+			{
+				++WordLen;
+			}
+			if (WordLen == 0)
+			{
+				return false;
+			}
+
+			bOutFound = false;
+			if (const TArray<int32, TInlineAllocator<1>>* Starts = Words.FindByKey(FStringView(Param, WordLen)))
+			{
+				const TCHAR* Rest = Param + WordLen;
+				const int32 RestLen = FCString::Strlen(Rest);
+				for (int32 Start : *Starts)
+				{
+					if (Quoted[Start] || Start == 0 || (String[Start - 1] != TEXT('-') && String[Start - 1] != TEXT('/')) || (Start > 1 && !FChar::IsWhitespace(String[Start - 2])))
+					{
+						continue;
+					}
+					if (RestLen && FCString::Strnicmp(String + Start + WordLen, Rest, RestLen))
+					{
+						continue;
+					}
+					const TCHAR End = String[Start + WordLen + RestLen];
+					if (End == 0 || FChar::IsWhitespace(End))
+					{
+						bOutFound = true;
+						break;
+					}
+				}
+			}
+			return true;
+		}
+	};
+
+	/** Function static so Set works from other static initializers */
+	static FCommandLineIndex& GetIndex()
+	{
+		static FCommandLineIndex Index;
+		return Index;
+	}
+}
+
 FString& FCommandLine::GetSubprocessCommandLine_Internal()
 {
 	static FString SubprocessCommandLine = TEXT(" -Multiprocess");
@@ -55,6 +194,8 @@ const TCHAR* FCommandLine::GetOriginalForLogging()
 
 bool FCommandLine::Set(const TCHAR* NewCommandLine)
 {
+	SCOPED_STARTUP_PHASE(TEXT("CommandLine"));
+
 	if (!bIsInitialized)
 	{
 		FCString::Strncpy(OriginalCmdLine, NewCommandLine, UE_ARRAY_COUNT(OriginalCmdLine));
@@ -65,6 +206,7 @@ bool FCommandLine::Set(const TCHAR* NewCommandLine)
 	FCString::Strncpy(LoggingCmdLine, NewCommandLine, UE_ARRAY_COUNT(LoggingCmdLine));
 	// If configured as part of the build, strip out any unapproved args
 	WhitelistCommandLines();
+	BuildIndex();
 
 	bIsInitialized = true;
 
@@ -88,6 +230,24 @@ void FCommandLine::Append(const TCHAR* AppendString)
 	FCString::Strncat( CmdLine, AppendString, UE_ARRAY_COUNT(CmdLine) );
 	// If configured as part of the build, strip out any unapproved args
 	WhitelistCommandLines();
+	BuildIndex();
+}
+
+void FCommandLine::BuildIndex()
+{
+	UE4CommandLine_Private::GetIndex().Build(CmdLine);
+}
+
+bool FCommandLine::FindIndexed(const TCHAR* Stream, const TCHAR* Match, bool bSkipQuotedChars, const TCHAR*& OutFound)
+{
+	const UE4CommandLine_Private::FCommandLineIndex& Index = UE4CommandLine_Private::GetIndex();
+	return Stream && Stream == Index.String && Match && Index.Find(Match, bSkipQuotedChars, OutFound);
+}
+
+bool FCommandLine::ParamIndexed(const TCHAR* Stream, const TCHAR* Param, bool& bOutFound)
+{
+	const UE4CommandLine_Private::FCommandLineIndex& Index = UE4CommandLine_Private::GetIndex();
+	return Stream && Stream == Index.String && Index.Param(Param, bOutFound);
 }
 
 bool FCommandLine::IsCommandLineLoggingFiltered()
@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/CompiledWildcard.h"
+
+#include "Misc/Char.h"
+
+namespace UE4CompiledWildcard_Private
+{
+	static const TCHAR ExactWildcard = TCHAR('?');
+	static const TCHAR SequenceWildcard = TCHAR('*');
+}
+
+FCompiledWildcard::FCompiledWildcard(const FStringView& InPattern, ESearchCase::Type InSearchCase)
+	: Pattern(InPattern)
+	, PrefixLen(0)
+	, SuffixLen(0)
+	, MinInputLen(0)
+	, SearchCase(InSearchCase)
+	, bContainsWildcards(false)
+	, bContainsSequenceWildcard(false)
+	, bUseAutomaton(false)
+	, LoopMask(0)
+	, AcceptMask(0)
+	, AnyCharMask(0)
+{
+	using namespace UE4CompiledWildcard_Private;
+
+	FMemory::Memzero(AsciiMasks);
+
+	// Repeated '*' match the same as a single one
+	Compiled.Reserve(InPattern.Len());
+	for (TCHAR Char : InPattern)
+	{
+		if (Char == SequenceWildcard && Compiled.Len() && Compiled[Compiled.Len() - 1] == SequenceWildcard)
+		{
+			continue;
+		}
+		Compiled.AppendChar(SearchCase == ESearchCase::IgnoreCase ? FChar::ToLower(Char) : Char);
+	}
+
+	int32 FirstSequenceIndex = INDEX_NONE;
+	int32 LastSequenceIndex = INDEX_NONE;
+	Compiled.FindChar(SequenceWildcard, FirstSequenceIndex);
+	Compiled.FindLastChar(SequenceWildcard, LastSequenceIndex);
+
+	bContainsSequenceWildcard = FirstSequenceIndex != INDEX_NONE;
+	bContainsWildcards = bContainsSequenceWildcard || Compiled.Contains(TEXT("?"), ESearchCase::CaseSensitive);
+	PrefixLen = bContainsSequenceWildcard ? FirstSequenceIndex : Compiled.Len();
+	SuffixLen = bContainsSequenceWildcard ? Compiled.Len() - LastSequenceIndex - 1 : 0;
+	MinInputLen = Compiled.Len();
+	for (TCHAR Char : Compiled)
+	{
+		MinInputLen -= Char == SequenceWildcard;
+	}
+
+	// The middle starts and ends with '*', build the automaton for it when its characters fit the states
+	const int32 NumMiddleChars = MinInputLen - PrefixLen - SuffixLen;
+	bUseAutomaton = bContainsSequenceWildcard && NumMiddleChars <= MaxAutomatonChars;
+	if (bUseAutomaton)
+	{
+		int32 State = 0;
+		for (int32 Index = FirstSequenceIndex; Index <= LastSequenceIndex; ++Index)
+		{
+			const TCHAR Char = Compiled[Index];
+			if (Char == SequenceWildcard)
+			{
+				LoopMask |= uint64(1) << State;
+				continue;
+			}
+
+			const uint64 NextStateBit = uint64(1) << ++State;
+			if (Char == ExactWildcard)
+			{
+				AnyCharMask |= NextStateBit;
+			}
+			else if (uint32(Char) < UE_ARRAY_COUNT(AsciiMasks))
+			{
+				AsciiMasks[Char] |= NextStateBit;
+			}
+			else
+			{
+				TTuple<TCHAR, uint64>* OtherMask = OtherMasks.FindByPredicate([Char](const TTuple<TCHAR, uint64>& Mask) { return Mask.Get<0>() == Char; });
+				if (OtherMask)
+				{
+					OtherMask->Get<1>() |= NextStateBit;
+				}
+				else
+				{
+					OtherMasks.Emplace(Char, NextStateBit);
+				}
+			}
+		}
+		AcceptMask = uint64(1) << State;
+
+		// '?' matches every character
+		for (uint64& Mask : AsciiMasks)
+		{
+			Mask |= AnyCharMask;
+		}
+	}
+}
+
+bool FCompiledWildcard::IsMatch(const FStringView& Input) const
+{
+	const int32 InputLen = Input.Len();
+	const TCHAR* InputChars = Input.GetData();
+
+	if (!bContainsSequenceWildcard)
+	{
+		return InputLen == MinInputLen && MatchesChars(*Compiled, InputChars, InputLen);
+	}
+
+	// The literal ends are fixed to the ends of the input
+	if (InputLen < MinInputLen
+		|| !MatchesChars(*Compiled, InputChars, PrefixLen)
+		|| !MatchesChars(*Compiled + Compiled.Len() - SuffixLen, InputChars + InputLen - SuffixLen, SuffixLen))
+	{
+		return false;
+	}
+
+	const TCHAR* Middle = InputChars + PrefixLen;
+	const int32 MiddleLen = InputLen - PrefixLen - SuffixLen;
+	return bUseAutomaton ? IsMiddleMatchAutomaton(Middle, MiddleLen) : IsMiddleMatchSearch(Middle, MiddleLen);
+}
+
+bool FCompiledWildcard::MatchesChars(const TCHAR* PatternChars, const TCHAR* InputChars, int32 Len) const
+{
+	using namespace UE4CompiledWildcard_Private;
+
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const TCHAR PatternChar = PatternChars[Index];
+		const TCHAR InputChar = SearchCase == ESearchCase::IgnoreCase ? FChar::ToLower(InputChars[Index]) : InputChars[Index];
+		if (PatternChar != InputChar && PatternChar != ExactWildcard)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FCompiledWildcard::IsMiddleMatchAutomaton(const TCHAR* Input, int32 Len) const
+{
+	// The last state loops, so the middle matches as soon as it is reached
+	uint64 States = 1;
+	for (int32 Index = 0; Index < Len && !(States & AcceptMask); ++Index)
+	{
+		const TCHAR Char = SearchCase == ESearchCase::IgnoreCase ? FChar::ToLower(Input[Index]) : Input[Index];
+		States = ((States << 1) & GetCharMask(Char)) | (States & LoopMask);
+	}
+	return (States & AcceptMask) != 0;
+}
+
+bool FCompiledWildcard::IsMiddleMatchSearch(const TCHAR* Input, int32 Len) const
+{
+	using namespace UE4CompiledWildcard_Private;
+
+	// Between two '*' the leftmost match of each part is always the best one
+	const TCHAR* PatternChars = *Compiled + PrefixLen + 1;
+	const TCHAR* PatternEnd = *Compiled + Compiled.Len() - SuffixLen - 1;
+	int32 InputIndex = 0;
+	while (PatternChars < PatternEnd)
+	{
+		const TCHAR* PartEnd = PatternChars;
+		while (*PartEnd != SequenceWildcard)
+		{
+			++PartEnd;
+		}
+
+		const int32 PartLen = UE_PTRDIFF_TO_INT32(PartEnd - PatternChars);
+		while (InputIndex + PartLen <= Len && !MatchesChars(PatternChars, Input + InputIndex, PartLen))
+		{
+			++InputIndex;
+		}
+		if (InputIndex + PartLen > Len)
+		{
+			return false;
+		}
+
+		InputIndex += PartLen;
+		PatternChars = PartEnd + 1;
+	}
+	return true;
+}
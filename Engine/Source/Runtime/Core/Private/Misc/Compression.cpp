@@ -11,6 +11,8 @@
 #include "Misc/ConfigCacheIni.h"
 #include "Misc/CompressedGrowableBuffer.h"
 #include "Misc/ICompressionFormat.h"
+#include "Containers/Map.h"
+#include "HAL/LowLevelMemTracker.h"
 
 #include "Misc/MemoryReadStream.h"
 // #include "TargetPlatformBase.h"
@@ -23,6 +25,14 @@ THIRD_PARTY_INCLUDES_START
 #include "Compression/lz4hc.h"
 THIRD_PARTY_INCLUDES_END
 
+#if WITH_ZSTD
+THIRD_PARTY_INCLUDES_START
+#define ZSTD_STATIC_LINKING_ONLY
+#include "zstd.h"
+#include "zdict.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
 DECLARE_LOG_CATEGORY_EXTERN(LogCompression, Log, All);
 DEFINE_LOG_CATEGORY(LogCompression);
 
@@ -30,12 +40,12 @@ DECLARE_STATS_GROUP( TEXT( "Compression" ), STATGROUP_Compression, STATCAT_Advan
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
-TMap<FName, struct ICompressionFormat*> FCompression::CompressionFormats;
-FCriticalSection FCompression::CompressionFormatsCriticalSection;
+TConcurrentMap<FName, struct ICompressionFormat*> FCompression::CompressionFormats;
 
 
 static void *zalloc(void *opaque, unsigned int size, unsigned int num)
 {
+	LLM_SCOPE(ELLMTag::Compression);
 	return FMemory::Malloc(size * num);
 }
 
@@ -44,6 +54,179 @@ static void zfree(void *opaque, void *p)
 	FMemory::Free(p);
 }
 
+#if WITH_ZSTD
+static void* ZstdAlloc(void* Opaque, size_t Size)
+{
+	LLM_SCOPE(ELLMTag::Compression);
+	return FMemory::Malloc(Size);
+}
+
+static void ZstdFree(void* Opaque, void* Address)
+{
+	FMemory::Free(Address);
+}
+#endif
+
+/**
+ * Compression contexts are expensive to create relative to compressing a block, so each thread keeps at most one of
+ * each kind and resets it between calls. They are allocated on first use under ELLMTag::Compression and freed when
+ * the thread exits, which bounds their memory to a few hundred KB per thread that compresses, plus the Zstd contexts,
+ * which zstd shrinks itself when they stay oversized for a while.
+ */
+struct FCompressionThreadContexts
+{
+	/** Deflate stream and the parameters it was initialized with, as changing the window or memory level needs a new stream */
+	z_stream DeflateStream;
+	int32 DeflateLevel = 0;
+	int32 DeflateBitWindow = 0;
+	int32 DeflateMemLevel = 0;
+	bool bDeflateInitialized = false;
+
+	z_stream InflateStream;
+	bool bInflateInitialized = false;
+
+	LZ4_streamHC_t* LZ4HCState = nullptr;
+
+#if WITH_ZSTD
+	ZSTD_CCtx* ZstdCompressContext = nullptr;
+	ZSTD_DCtx* ZstdDecompressContext = nullptr;
+#endif
+
+	~FCompressionThreadContexts()
+	{
+		if (bDeflateInitialized)
+		{
+			deflateEnd(&DeflateStream);
+		}
+		if (bInflateInitialized)
+		{
+			inflateEnd(&InflateStream);
+		}
+		FMemory::Free(LZ4HCState);
+#if WITH_ZSTD
+		ZSTD_freeCCtx(ZstdCompressContext);
+		ZSTD_freeDCtx(ZstdDecompressContext);
+#endif
+	}
+
+	/** Returns a deflate stream ready to compress with the given parameters, or null if it could not be initialized */
+	static z_stream* GetDeflateStream(int32 CompLevel, int32 BitWindow, int32 MemLevel)
+	{
+		FCompressionThreadContexts& Contexts = Get();
+		z_stream& Stream = Contexts.DeflateStream;
+		if (Contexts.bDeflateInitialized)
+		{
+			if (Contexts.DeflateBitWindow == BitWindow && Contexts.DeflateMemLevel == MemLevel)
+			{
+				if (deflateReset(&Stream) != Z_OK)
+				{
+					return nullptr;
+				}
+				// The level only changes the parameters, deflateParams does not compress anything on a stream with no input yet
+				if (Contexts.DeflateLevel != CompLevel)
+				{
+					Stream.next_in = Z_NULL;
+					Stream.avail_in = 0;
+					Stream.next_out = Z_NULL;
+					Stream.avail_out = 0;
+					if (deflateParams(&Stream, CompLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+					{
+						return nullptr;
+					}
+					Contexts.DeflateLevel = CompLevel;
+				}
+				return &Stream;
+			}
+
+			deflateEnd(&Stream);
+			Contexts.bDeflateInitialized = false;
+		}
+
+		Stream.next_in = Z_NULL;
+		Stream.avail_in = 0;
+		Stream.zalloc = &zalloc;
+		Stream.zfree = &zfree;
+		Stream.opaque = Z_NULL;
+		if (deflateInit2(&Stream, CompLevel, Z_DEFLATED, BitWindow, MemLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return nullptr;
+		}
+
+		Contexts.DeflateLevel = CompLevel;
+		Contexts.DeflateBitWindow = BitWindow;
+		Contexts.DeflateMemLevel = MemLevel;
+		Contexts.bDeflateInitialized = true;
+		return &Stream;
+	}
+
+	/** Returns an inflate stream ready to uncompress with the given window, or null if it could not be initialized */
+	static z_stream* GetInflateStream(int32 BitWindow)
+	{
+		FCompressionThreadContexts& Contexts = Get();
+		z_stream& Stream = Contexts.InflateStream;
+		if (Contexts.bInflateInitialized)
+		{
+			// inflateReset2 keeps the window allocation unless its size changes
+			return inflateReset2(&Stream, BitWindow) == Z_OK ? &Stream : nullptr;
+		}
+
+		Stream.next_in = Z_NULL;
+		Stream.avail_in = 0;
+		Stream.zalloc = &zalloc;
+		Stream.zfree = &zfree;
+		Stream.opaque = Z_NULL;
+		if (inflateInit2(&Stream, BitWindow) != Z_OK)
+		{
+			return nullptr;
+		}
+
+		Contexts.bInflateInitialized = true;
+		return &Stream;
+	}
+
+	/** Returns the LZ4HC state, to use with the _fastReset functions */
+	static LZ4_streamHC_t* GetLZ4HCState()
+	{
+		FCompressionThreadContexts& Contexts = Get();
+		if (!Contexts.LZ4HCState)
+		{
+			LLM_SCOPE(ELLMTag::Compression);
+			void* State = FMemory::Malloc(sizeof(LZ4_streamHC_t), alignof(LZ4_streamHC_t));
+			Contexts.LZ4HCState = LZ4_initStreamHC(State, sizeof(LZ4_streamHC_t));
+		}
+		return Contexts.LZ4HCState;
+	}
+
+#if WITH_ZSTD
+	static ZSTD_CCtx* GetZstdCompressContext()
+	{
+		FCompressionThreadContexts& Contexts = Get();
+		if (!Contexts.ZstdCompressContext)
+		{
+			Contexts.ZstdCompressContext = ZSTD_createCCtx_advanced({ &ZstdAlloc, &ZstdFree, nullptr });
+		}
+		return Contexts.ZstdCompressContext;
+	}
+
+	static ZSTD_DCtx* GetZstdDecompressContext()
+	{
+		FCompressionThreadContexts& Contexts = Get();
+		if (!Contexts.ZstdDecompressContext)
+		{
+			Contexts.ZstdDecompressContext = ZSTD_createDCtx_advanced({ &ZstdAlloc, &ZstdFree, nullptr });
+		}
+		return Contexts.ZstdDecompressContext;
+	}
+#endif
+
+private:
+	static FCompressionThreadContexts& Get()
+	{
+		static thread_local FCompressionThreadContexts Contexts;
+		return Contexts;
+	}
+};
+
 static const uint32 appZLIBVersion()
 {
 	return uint32(ZLIB_VERNUM);
@@ -74,47 +257,25 @@ static bool appCompressMemoryZLIB(void* CompressedBuffer, int32& CompressedSize,
 
 	CompLevel = FMath::Clamp(CompLevel, Z_DEFAULT_COMPRESSION, Z_BEST_COMPRESSION);
 
-	// Zlib wants to use unsigned long.
-	unsigned long ZCompressedSize = CompressedSize;
-	unsigned long ZUncompressedSize = UncompressedSize;
-	bool bOperationSucceeded = false;
-
-	// Compress data
-	// If using the default Zlib bit window, use the zlib routines, otherwise go manual with deflate2
-	if (BitWindow == 0 || BitWindow == DEFAULT_ZLIB_BIT_WINDOW)
+	// compress2 uses zlib's default memory level of 8 with the default window, keep producing the same data
+	const bool bDefaultBitWindow = BitWindow == 0 || BitWindow == DEFAULT_ZLIB_BIT_WINDOW;
+	z_stream* Stream = FCompressionThreadContexts::GetDeflateStream(CompLevel, bDefaultBitWindow ? DEFAULT_ZLIB_BIT_WINDOW : BitWindow, bDefaultBitWindow ? 8 : MAX_MEM_LEVEL);
+	if (!ensure(Stream))
 	{
-		bOperationSucceeded = compress2((uint8*)CompressedBuffer, &ZCompressedSize, (const uint8*)UncompressedBuffer, ZUncompressedSize, CompLevel) == Z_OK ? true : false;
+		return false;
 	}
-	else
-	{
-		z_stream stream;
-		stream.next_in = (Bytef*)UncompressedBuffer;
-		stream.avail_in = (uInt)ZUncompressedSize;
-		stream.next_out = (Bytef*)CompressedBuffer;
-		stream.avail_out = (uInt)ZCompressedSize;
-		stream.zalloc = &zalloc;
-		stream.zfree = &zfree;
-		stream.opaque = Z_NULL;
 
-		if (ensure(Z_OK == deflateInit2(&stream, CompLevel, Z_DEFLATED, BitWindow, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY)))
-		{
-			if (ensure(Z_STREAM_END == deflate(&stream, Z_FINISH)))
-			{
-				ZCompressedSize = stream.total_out;
-				if (ensure(Z_OK == deflateEnd(&stream)))
-				{
-					bOperationSucceeded = true;
-				}
-			}
-			else
-			{
-				deflateEnd(&stream);
-			}
-		}
-	}
+	Stream->next_in = (Bytef*)UncompressedBuffer;
+	Stream->avail_in = (uInt)UncompressedSize;
+	Stream->next_out = (Bytef*)CompressedBuffer;
+	Stream->avail_out = (uInt)CompressedSize;
 
-	// Propagate compressed size from intermediate variable back into out variable.
-	CompressedSize = ZCompressedSize;
+	// Compress data, failing if CompressedBuffer is too small to hold all of it
+	const bool bOperationSucceeded = deflate(Stream, Z_FINISH) == Z_STREAM_END;
+	if (bOperationSucceeded)
+	{
+		CompressedSize = Stream->total_out;
+	}
 	return bOperationSucceeded;
 }
 
@@ -181,36 +342,31 @@ bool appUncompressMemoryZLIB( void* UncompressedBuffer, int32 UncompressedSize,
 	unsigned long ZCompressedSize	= CompressedSize;
 	unsigned long ZUncompressedSize	= UncompressedSize;
 	
-	z_stream stream;
-	stream.zalloc = &zalloc;
-	stream.zfree = &zfree;
-	stream.opaque = Z_NULL;
-	stream.next_in = (uint8*)CompressedBuffer;
-	stream.avail_in = ZCompressedSize;
-	stream.next_out = (uint8*)UncompressedBuffer;
-	stream.avail_out = ZUncompressedSize;
-
 	if (BitWindow == 0)
 	{
 		BitWindow = DEFAULT_ZLIB_BIT_WINDOW;
 	}
 
-	int32 Result = inflateInit2(&stream, BitWindow);
-
-	if(Result != Z_OK)
+	z_stream* Stream = FCompressionThreadContexts::GetInflateStream(BitWindow);
+	if (!Stream)
 		return false;
 
+	Stream->next_in = (uint8*)CompressedBuffer;
+	Stream->avail_in = ZCompressedSize;
+	Stream->next_out = (uint8*)UncompressedBuffer;
+	Stream->avail_out = ZUncompressedSize;
+
 	// Uncompress data.
-	Result = inflate(&stream, Z_FINISH);
+	int32 Result = inflate(Stream, Z_FINISH);
 	if(Result == Z_STREAM_END)
 	{
-		ZUncompressedSize = stream.total_out;
+		ZUncompressedSize = Stream->total_out;
 	}
 
-	int32 EndResult = inflateEnd(&stream);
+	// The stream is reset rather than ended for the next call
 	if (Result >= Z_OK)
 	{
-		Result = EndResult;
+		Result = Z_OK;
 	}
 
 	// These warnings will be compiled out in shipping.
@@ -238,43 +394,40 @@ bool appUncompressMemoryStreamZLIB(void* UncompressedBuffer, int32 UncompressedS
 	const void* ChunkMemory = Stream->Read(ChunkSize, StreamOffset + ChunkOffset, CompressedSize);
 	ChunkOffset += ChunkSize;
 
-	z_stream stream;
-	stream.zalloc = &zalloc;
-	stream.zfree = &zfree;
-	stream.opaque = Z_NULL;
-	stream.next_in = (uint8*)ChunkMemory;
-	stream.avail_in = ChunkSize;
-	stream.next_out = (uint8*)UncompressedBuffer;
-	stream.avail_out = UncompressedSize;
-
 	if (BitWindow == 0)
 	{
 		BitWindow = DEFAULT_ZLIB_BIT_WINDOW;
 	}
 
-	int32 Result = inflateInit2(&stream, BitWindow);
-	if (Result != Z_OK)
+	z_stream* ZStream = FCompressionThreadContexts::GetInflateStream(BitWindow);
+	if (!ZStream)
 		return false;
 
+	ZStream->next_in = (uint8*)ChunkMemory;
+	ZStream->avail_in = ChunkSize;
+	ZStream->next_out = (uint8*)UncompressedBuffer;
+	ZStream->avail_out = UncompressedSize;
+
+	int32 Result = Z_OK;
 	while (Result == Z_OK)
 	{
-		if (stream.avail_in == 0u)
+		if (ZStream->avail_in == 0u)
 		{
 			ChunkMemory = Stream->Read(ChunkSize, StreamOffset + ChunkOffset, CompressedSize - ChunkOffset);
 			ChunkOffset += ChunkSize;
 			check(ChunkOffset <= CompressedSize);
 
-			stream.next_in = (uint8*)ChunkMemory;
-			stream.avail_in = ChunkSize;
+			ZStream->next_in = (uint8*)ChunkMemory;
+			ZStream->avail_in = ChunkSize;
 		}
 
-		Result = inflate(&stream, Z_SYNC_FLUSH);
+		Result = inflate(ZStream, Z_SYNC_FLUSH);
 	}
 
-	int32 EndResult = inflateEnd(&stream);
+	// The stream is reset rather than ended for the next call
 	if (Result >= Z_OK)
 	{
-		Result = EndResult;
+		Result = Z_OK;
 	}
 
 	// These warnings will be compiled out in shipping.
@@ -287,6 +440,302 @@ bool appUncompressMemoryStreamZLIB(void* UncompressedBuffer, int32 UncompressedS
 	return bOperationSucceeded;
 }
 
+#if WITH_ZSTD
+/** Registered dictionaries, which are never freed so they can be used without holding the lock */
+struct FZstdDictionaries
+{
+	FCriticalSection Lock;
+	TMap<uint32, ZSTD_DDict*> DecompressDictionaries;
+	ZSTD_CDict* CompressDictionary = nullptr;
+
+	static FZstdDictionaries& Get()
+	{
+		static FZstdDictionaries Dictionaries;
+		return Dictionaries;
+	}
+
+	ZSTD_CDict* GetCompressDictionary()
+	{
+		FScopeLock ScopeLock(&Lock);
+		return CompressDictionary;
+	}
+
+	ZSTD_DDict* FindDecompressDictionary(uint32 DictionaryId)
+	{
+		FScopeLock ScopeLock(&Lock);
+		ZSTD_DDict** Dictionary = DecompressDictionaries.Find(DictionaryId);
+		return Dictionary ? *Dictionary : nullptr;
+	}
+};
+
+static int32 GetZstdCompressionLevel(ECompressionFlags Flags, int32 CompressionData)
+{
+	if (CompressionData != 0)
+	{
+		return FMath::Clamp(CompressionData, ZSTD_minCLevel(), ZSTD_maxCLevel());
+	}
+	else if (Flags & COMPRESS_BiasMemory)
+	{
+		return 19;
+	}
+	else if (Flags & COMPRESS_BiasSpeed)
+	{
+		return 1;
+	}
+	return ZSTD_CLEVEL_DEFAULT;
+}
+
+static bool appCompressMemoryZSTD(void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags, int32 CompressionData)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Compress Memory ZSTD"), STAT_appCompressMemoryZSTD, STATGROUP_Compression);
+
+	ZSTD_CCtx* Context = FCompressionThreadContexts::GetZstdCompressContext();
+	ZSTD_CDict* Dictionary = FZstdDictionaries::Get().GetCompressDictionary();
+
+	const size_t Result = Dictionary
+		? ZSTD_compress_usingCDict(Context, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Dictionary)
+		: ZSTD_compressCCtx(Context, CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, GetZstdCompressionLevel(Flags, CompressionData));
+
+	if (ZSTD_isError(Result))
+	{
+		// Most likely CompressedBuffer was too small, which callers handle
+		return false;
+	}
+
+	CompressedSize = (int32)Result;
+	return true;
+}
+
+static ZSTD_DDict* FindZstdDictionaryForFrame(const void* CompressedBuffer, int32 CompressedSize, bool& bOutFound)
+{
+	const uint32 DictionaryId = ZSTD_getDictID_fromFrame(CompressedBuffer, CompressedSize);
+	ZSTD_DDict* Dictionary = DictionaryId ? FZstdDictionaries::Get().FindDecompressDictionary(DictionaryId) : nullptr;
+	bOutFound = !DictionaryId || Dictionary;
+	UE_CLOG(!bOutFound, LogCompression, Warning, TEXT("Zstd frame needs dictionary %u, which is not registered"), DictionaryId);
+	return Dictionary;
+}
+
+static bool appUncompressMemoryZSTD(void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Uncompress Memory ZSTD"), STAT_appUncompressMemoryZSTD, STATGROUP_Compression);
+
+	bool bFoundDictionary = false;
+	ZSTD_DDict* Dictionary = FindZstdDictionaryForFrame(CompressedBuffer, CompressedSize, bFoundDictionary);
+	if (!bFoundDictionary)
+	{
+		return false;
+	}
+
+	ZSTD_DCtx* Context = FCompressionThreadContexts::GetZstdDecompressContext();
+	const size_t Result = Dictionary
+		? ZSTD_decompress_usingDDict(Context, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize, Dictionary)
+		: ZSTD_decompressDCtx(Context, UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+
+	if (ZSTD_isError(Result))
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryZSTD failed: %s"), ANSI_TO_TCHAR(ZSTD_getErrorName(Result)));
+		return false;
+	}
+	if (Result != (size_t)UncompressedSize)
+	{
+		UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryZSTD failed: Mismatched uncompressed size. Expected: %d, Got:%d."), UncompressedSize, (int32)Result);
+		return false;
+	}
+	return true;
+}
+
+static bool appUncompressMemoryStreamZSTD(void* UncompressedBuffer, int32 UncompressedSize, IMemoryReadStream* Stream, int64 StreamOffset, int32 CompressedSize)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Uncompress Memory ZSTD"), STAT_appUncompressMemoryZSTD, STATGROUP_Compression);
+
+	// The frame header holding the dictionary id is at most 18 bytes, and may be split across chunks
+	uint8 FrameHeader[18];
+	const int32 FrameHeaderSize = FMath::Min<int32>(sizeof(FrameHeader), CompressedSize);
+	Stream->CopyTo(FrameHeader, StreamOffset, FrameHeaderSize);
+	bool bFoundDictionary = false;
+	ZSTD_DDict* Dictionary = FindZstdDictionaryForFrame(FrameHeader, FrameHeaderSize, bFoundDictionary);
+	if (!bFoundDictionary)
+	{
+		return false;
+	}
+
+	int64 ChunkOffset = 0;
+	int64 ChunkSize = 0;
+	const void* ChunkMemory = Stream->Read(ChunkSize, StreamOffset, CompressedSize);
+	ChunkOffset += ChunkSize;
+
+	ZSTD_DCtx* Context = FCompressionThreadContexts::GetZstdDecompressContext();
+	ZSTD_DCtx_reset(Context, ZSTD_reset_session_and_parameters);
+	ZSTD_DCtx_refDDict(Context, Dictionary);
+
+	ZSTD_inBuffer Input = { ChunkMemory, (size_t)ChunkSize, 0 };
+	ZSTD_outBuffer Output = { UncompressedBuffer, (size_t)UncompressedSize, 0 };
+	size_t Result = 1;
+	while (Result != 0)
+	{
+		if (Input.pos == Input.size)
+		{
+			if (ChunkOffset >= CompressedSize)
+			{
+				break;
+			}
+			ChunkMemory = Stream->Read(ChunkSize, StreamOffset + ChunkOffset, CompressedSize - ChunkOffset);
+			ChunkOffset += ChunkSize;
+			Input = { ChunkMemory, (size_t)ChunkSize, 0 };
+		}
+
+		const size_t InputPos = Input.pos;
+		const size_t OutputPos = Output.pos;
+		Result = ZSTD_decompressStream(Context, &Output, &Input);
+		if (ZSTD_isError(Result))
+		{
+			UE_LOG(LogCompression, Warning, TEXT("appUncompressMemoryStreamZSTD failed: %s"), ANSI_TO_TCHAR(ZSTD_getErrorName(Result)));
+			break;
+		}
+		if (Input.pos == InputPos && Output.pos == OutputPos)
+		{
+			// The output is full but the frame is not finished
+			break;
+		}
+	}
+
+	// Leave the context without a dictionary for the following calls
+	ZSTD_DCtx_refDDict(Context, nullptr);
+
+	const bool bOperationSucceeded = Result == 0 && Output.pos == (size_t)UncompressedSize;
+	UE_CLOG(!bOperationSucceeded && !ZSTD_isError(Result), LogCompression, Warning, TEXT("appUncompressMemoryStreamZSTD failed: Mismatched uncompressed size. Expected: %d, Got:%d."), UncompressedSize, (int32)Output.pos);
+	return bOperationSucceeded;
+}
+
+uint32 FCompression::RegisterZstdDictionary(const void* Dictionary, int32 DictionarySize, int32 CompressionLevel, bool bUseForCompression)
+{
+	ZSTD_DDict* DecompressDictionary = ZSTD_createDDict(Dictionary, DictionarySize);
+	const uint32 DictionaryId = DecompressDictionary ? ZSTD_getDictID_fromDDict(DecompressDictionary) : 0;
+	if (!DictionaryId)
+	{
+		// Raw content dictionaries have no id, so frames using them could not be matched to them
+		UE_LOG(LogCompression, Warning, TEXT("FCompression::RegisterZstdDictionary - Only trained dictionaries with an id can be registered"));
+		ZSTD_freeDDict(DecompressDictionary);
+		return 0;
+	}
+
+	ZSTD_CDict* CompressDictionary = bUseForCompression ? ZSTD_createCDict(Dictionary, DictionarySize, GetZstdCompressionLevel(COMPRESS_NoFlags, CompressionLevel)) : nullptr;
+
+	FZstdDictionaries& Dictionaries = FZstdDictionaries::Get();
+	FScopeLock ScopeLock(&Dictionaries.Lock);
+	if (Dictionaries.DecompressDictionaries.Contains(DictionaryId))
+	{
+		ZSTD_freeDDict(DecompressDictionary);
+	}
+	else
+	{
+		Dictionaries.DecompressDictionaries.Add(DictionaryId, DecompressDictionary);
+	}
+	if (CompressDictionary)
+	{
+		// The previous dictionary may still be in use on another thread, and is small enough to leak
+		Dictionaries.CompressDictionary = CompressDictionary;
+	}
+	return DictionaryId;
+}
+
+/** Dictionary loaded once for compression and once for decompression, used with the thread contexts */
+class FZstdCompressionDictionary final : public ICompressionDictionary
+{
+public:
+	FZstdCompressionDictionary(ZSTD_CDict* InCompressDictionary, ZSTD_DDict* InDecompressDictionary)
+		: CompressDictionary(InCompressDictionary)
+		, DecompressDictionary(InDecompressDictionary)
+	{
+	}
+
+	virtual ~FZstdCompressionDictionary()
+	{
+		ZSTD_freeCDict(CompressDictionary);
+		ZSTD_freeDDict(DecompressDictionary);
+	}
+
+	virtual bool Compress(void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize) override
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Compress Memory ZSTD"), STAT_appCompressMemoryZSTD, STATGROUP_Compression);
+
+		const size_t Result = ZSTD_compress_usingCDict(FCompressionThreadContexts::GetZstdCompressContext(), CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, CompressDictionary);
+		if (ZSTD_isError(Result))
+		{
+			return false;
+		}
+		CompressedSize = (int32)Result;
+		return true;
+	}
+
+	virtual bool Uncompress(void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize) override
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Uncompress Memory ZSTD"), STAT_appUncompressMemoryZSTD, STATGROUP_Compression);
+
+		const size_t Result = ZSTD_decompress_usingDDict(FCompressionThreadContexts::GetZstdDecompressContext(), UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize, DecompressDictionary);
+		UE_CLOG(ZSTD_isError(Result), LogCompression, Warning, TEXT("FZstdCompressionDictionary::Uncompress failed: %s"), ANSI_TO_TCHAR(ZSTD_getErrorName(Result)));
+		return Result == (size_t)UncompressedSize;
+	}
+
+private:
+	ZSTD_CDict* CompressDictionary;
+	ZSTD_DDict* DecompressDictionary;
+};
+#endif // WITH_ZSTD
+
+bool FCompression::TrainDictionary(FName FormatName, TArrayView<const TArrayView<const uint8>> Samples, int32 MaxDictionarySize, TArray<uint8>& OutDictionary)
+{
+#if WITH_ZSTD
+	if (FormatName == NAME_Zstd)
+	{
+		// The trainer takes the samples back to back
+		TArray<uint8> SampleData;
+		TArray<size_t> SampleSizes;
+		SampleSizes.Reserve(Samples.Num());
+		for (TArrayView<const uint8> Sample : Samples)
+		{
+			SampleData.Append(Sample.GetData(), Sample.Num());
+			SampleSizes.Add(Sample.Num());
+		}
+
+		OutDictionary.SetNumUninitialized(MaxDictionarySize);
+		const size_t DictionarySize = ZDICT_trainFromBuffer(OutDictionary.GetData(), MaxDictionarySize, SampleData.GetData(), SampleSizes.GetData(), SampleSizes.Num());
+		if (ZDICT_isError(DictionarySize))
+		{
+			UE_LOG(LogCompression, Warning, TEXT("FCompression::TrainDictionary - Zstd training failed: %s"), ANSI_TO_TCHAR(ZDICT_getErrorName(DictionarySize)));
+			OutDictionary.Empty();
+			return false;
+		}
+		OutDictionary.SetNum((int32)DictionarySize, false);
+		return true;
+	}
+#endif
+
+	ICompressionFormat* Format = GetCompressionFormat(FormatName);
+	return Format && Format->TrainDictionary(Samples, MaxDictionarySize, OutDictionary);
+}
+
+TUniquePtr<ICompressionDictionary> FCompression::CreateDictionary(FName FormatName, TArrayView<const uint8> Dictionary, int32 CompressionData)
+{
+#if WITH_ZSTD
+	if (FormatName == NAME_Zstd)
+	{
+		ZSTD_CDict* CompressDictionary = ZSTD_createCDict(Dictionary.GetData(), Dictionary.Num(), GetZstdCompressionLevel(COMPRESS_NoFlags, CompressionData));
+		ZSTD_DDict* DecompressDictionary = ZSTD_createDDict(Dictionary.GetData(), Dictionary.Num());
+		if (!CompressDictionary || !DecompressDictionary)
+		{
+			ZSTD_freeCDict(CompressDictionary);
+			ZSTD_freeDDict(DecompressDictionary);
+			return nullptr;
+		}
+		return MakeUnique<FZstdCompressionDictionary>(CompressDictionary, DecompressDictionary);
+	}
+#endif
+
+	ICompressionFormat* Format = GetCompressionFormat(FormatName);
+	return TUniquePtr<ICompressionDictionary>(Format ? Format->CreateDictionary(Dictionary, CompressionData) : nullptr);
+}
+
 /** Time spent compressing data in cycles. */
 TAtomic<uint64> FCompression::CompressorTimeCycles(0);
 /** Number of bytes before compression.		*/
@@ -331,6 +780,12 @@ uint32 FCompression::GetCompressorVersion(FName FormatName)
 	{
 		return appZLIBVersion();
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		return ZSTD_versionNumber();
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -346,39 +801,32 @@ uint32 FCompression::GetCompressorVersion(FName FormatName)
 
 ICompressionFormat* FCompression::GetCompressionFormat(FName FormatName, bool bErrorOnFailure)
 {
-	FScopeLock Lock(&CompressionFormatsCriticalSection);
-	ICompressionFormat** ExistingFormat = CompressionFormats.Find(FormatName);
-	if (ExistingFormat == nullptr)
+	if (TOptional<ICompressionFormat*> ExistingFormat = CompressionFormats.Find(FormatName))
 	{
-		TArray<ICompressionFormat*> Features = IModularFeatures::Get().GetModularFeatureImplementations<ICompressionFormat>(COMPRESSION_FORMAT_FEATURE_NAME);
+		return ExistingFormat.GetValue();
+	}
 
-		for (ICompressionFormat* CompressionFormat : Features)
-		{
-			// is this format the right one?
-			if (CompressionFormat->GetCompressionFormatName() == FormatName)
-			{
-				// remember it in our format map
-				ExistingFormat = &CompressionFormats.Add(FormatName, CompressionFormat);
-				break;
-			}
-		}
+	TArray<ICompressionFormat*> Features = IModularFeatures::Get().GetModularFeatureImplementations<ICompressionFormat>(COMPRESSION_FORMAT_FEATURE_NAME);
 
-		if (ExistingFormat == nullptr)
+	for (ICompressionFormat* CompressionFormat : Features)
+	{
+		// is this format the right one?
+		if (CompressionFormat->GetCompressionFormatName() == FormatName)
 		{
-			if (bErrorOnFailure)
-			{
-				UE_LOG(LogCompression, Error, TEXT("FCompression::GetCompressionFormat - Unable to find a module or plugin for compression format %s"), *FormatName.ToString());
-			}
-			else
-			{
-				UE_LOG(LogCompression, Display, TEXT("FCompression::GetCompressionFormat - Unable to find a module or plugin for compression format %s"), *FormatName.ToString());
-			}
-			return nullptr;
+			// remember it in our format map, another thread may have found it first
+			return CompressionFormats.FindOrAdd(FormatName, CompressionFormat);
 		}
 	}
 
-	return *ExistingFormat;
-
+	if (bErrorOnFailure)
+	{
+		UE_LOG(LogCompression, Error, TEXT("FCompression::GetCompressionFormat - Unable to find a module or plugin for compression format %s"), *FormatName.ToString());
+	}
+	else
+	{
+		UE_LOG(LogCompression, Display, TEXT("FCompression::GetCompressionFormat - Unable to find a module or plugin for compression format %s"), *FormatName.ToString());
+	}
+	return nullptr;
 }
 
 FName FCompression::GetCompressionFormatFromDeprecatedFlags(ECompressionFlags Flags)
@@ -424,6 +872,12 @@ int32 FCompression::CompressMemoryBound(FName FormatName, int32 UncompressedSize
 		// hardcoded lz4
 		CompressionBound = LZ4_compressBound(UncompressedSize);
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		CompressionBound = (int32)ZSTD_compressBound(UncompressedSize);
+	}
+#endif
 	else
 	{
 		ICompressionFormat* Format = GetCompressionFormat(FormatName);
@@ -458,9 +912,15 @@ bool FCompression::CompressMemory(FName FormatName, void* CompressedBuffer, int3
 	else if (FormatName == NAME_LZ4)
 	{
 		// hardcoded lz4
-		CompressedSize = LZ4_compress_HC((const char*)UncompressedBuffer, (char*)CompressedBuffer, UncompressedSize, CompressedSize, LZ4HC_CLEVEL_MAX);
+		CompressedSize = LZ4_compress_HC_extStateHC_fastReset(FCompressionThreadContexts::GetLZ4HCState(), (const char*)UncompressedBuffer, (char*)CompressedBuffer, UncompressedSize, CompressedSize, LZ4HC_CLEVEL_MAX);
 		bCompressSucceeded = CompressedSize > 0;
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		bCompressSucceeded = appCompressMemoryZSTD(CompressedBuffer, CompressedSize, UncompressedBuffer, UncompressedSize, Flags, CompressionData);
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -484,6 +944,7 @@ bool FCompression::CompressMemory(FName FormatName, void* CompressedBuffer, int3
 
 #define ZLIB_DERIVEDDATA_VER TEXT("9810EC9C5D34401CBD57AA3852417A6C")
 #define GZIP_DERIVEDDATA_VER TEXT("FB2181277DF44305ABBE03FD1751CBDE")
+#define ZSTD_DERIVEDDATA_VER TEXT("3C5E2A9F0B7D4E6A8F1C92D4A7B05E61")
 
 
 FString FCompression::GetCompressorDDCSuffix(FName FormatName)
@@ -496,10 +957,16 @@ FString FCompression::GetCompressorDDCSuffix(FName FormatName)
 		// hardcoded zlib
 		DDCSuffix += ZLIB_DERIVEDDATA_VER;
 	}
-	if (FormatName == NAME_Gzip)
+	else if (FormatName == NAME_Gzip)
 	{
 		DDCSuffix += GZIP_DERIVEDDATA_VER;
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		DDCSuffix += ZSTD_DERIVEDDATA_VER;
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -537,6 +1004,12 @@ bool FCompression::UncompressMemory(FName FormatName, void* UncompressedBuffer,
 		// hardcoded lz4
 		bUncompressSucceeded = LZ4_decompress_safe((const char*)CompressedBuffer, (char*)UncompressedBuffer, CompressedSize, UncompressedSize) > 0;
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		bUncompressSucceeded = appUncompressMemoryZSTD(UncompressedBuffer, UncompressedSize, CompressedBuffer, CompressedSize);
+	}
+#endif
 	else
 	{
 		// let the format module compress it
@@ -578,6 +1051,70 @@ bool FCompression::UncompressMemory(FName FormatName, void* UncompressedBuffer,
 	return bUncompressSucceeded;
 }
 
+bool FCompression::UncompressMemoryBatch(FName FormatName, TArrayView<FUncompressBlock> Blocks, ECompressionFlags Flags, int32 CompressionData)
+{
+	bool bAllSucceeded = true;
+
+	if (FormatName == NAME_LZ4 && Blocks.Num() > 1)
+	{
+		SCOPED_NAMED_EVENT(FCompression_UncompressMemoryBatch, FColor::Cyan);
+		STAT(double UncompressorStartTime = FPlatformTime::Seconds();)
+
+		// LZ4_decompress_safe_multi takes arrays, go through it a bounded number of blocks at a time
+		constexpr int32 MaxBatchSize = 16;
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); BlockIndex += MaxBatchSize)
+		{
+			const int32 BatchSize = FMath::Min(Blocks.Num() - BlockIndex, MaxBatchSize);
+			const char* Sources[MaxBatchSize];
+			char* Destinations[MaxBatchSize];
+			int32 SourceSizes[MaxBatchSize];
+			int32 DestinationSizes[MaxBatchSize];
+			int32 Results[MaxBatchSize];
+			for (int32 Index = 0; Index < BatchSize; ++Index)
+			{
+				const FUncompressBlock& Block = Blocks[BlockIndex + Index];
+				Sources[Index] = (const char*)Block.CompressedBuffer;
+				Destinations[Index] = (char*)Block.UncompressedBuffer;
+				SourceSizes[Index] = Block.CompressedSize;
+				DestinationSizes[Index] = Block.UncompressedSize;
+			}
+
+			LZ4_decompress_safe_multi(BatchSize, Sources, Destinations, SourceSizes, DestinationSizes, Results);
+
+			for (int32 Index = 0; Index < BatchSize; ++Index)
+			{
+				FUncompressBlock& Block = Blocks[BlockIndex + Index];
+				Block.bSucceeded = Results[Index] > 0;
+			}
+		}
+
+#if	STATS
+		if (FThreadStats::IsThreadingReady())
+		{
+			INC_FLOAT_STAT_BY( STAT_UncompressorTime, (float)(FPlatformTime::Seconds() - UncompressorStartTime) )
+		}
+#endif // STATS
+
+		// Failed blocks go through UncompressMemory again, which logs them and knows whether to ignore the failure
+		for (FUncompressBlock& Block : Blocks)
+		{
+			if (!Block.bSucceeded)
+			{
+				Block.bSucceeded = UncompressMemory(FormatName, Block.UncompressedBuffer, Block.UncompressedSize, Block.CompressedBuffer, Block.CompressedSize, Flags, CompressionData);
+				bAllSucceeded &= Block.bSucceeded;
+			}
+		}
+		return bAllSucceeded;
+	}
+
+	for (FUncompressBlock& Block : Blocks)
+	{
+		Block.bSucceeded = UncompressMemory(FormatName, Block.UncompressedBuffer, Block.UncompressedSize, Block.CompressedBuffer, Block.CompressedSize, Flags, CompressionData);
+		bAllSucceeded &= Block.bSucceeded;
+	}
+	return bAllSucceeded;
+}
+
 bool FCompression::UncompressMemoryStream(FName FormatName, void* UncompressedBuffer, int32 UncompressedSize, IMemoryReadStream* Stream, int64 StreamOffset, int32 CompressedSize, ECompressionFlags Flags, int32 CompressionData)
 {
 	int64 ContiguousChunkSize = 0;
@@ -602,6 +1139,21 @@ bool FCompression::UncompressMemoryStream(FName FormatName, void* UncompressedBu
 		}
 #endif // STATS
 	}
+#if WITH_ZSTD
+	else if (FormatName == NAME_Zstd)
+	{
+		SCOPED_NAMED_EVENT(FCompression_UncompressMemoryStream, FColor::Cyan);
+		STAT(double UncompressorStartTime = FPlatformTime::Seconds();)
+		// Zstd streams from non-contiguous buffers as well
+		bUncompressResult = appUncompressMemoryStreamZSTD(UncompressedBuffer, UncompressedSize, Stream, StreamOffset, CompressedSize);
+#if	STATS
+		if (FThreadStats::IsThreadingReady())
+		{
+			INC_FLOAT_STAT_BY(STAT_UncompressorTime, (float)(FPlatformTime::Seconds() - UncompressorStartTime))
+		}
+#endif // STATS
+	}
+#endif
 	else
 	{
 		// need to allocate temp memory to create contiguous buffer for default uncompress
@@ -795,6 +1347,12 @@ bool FCompression::IsFormatValid(FName FormatName)
 	{
 		return true;
 	}
+#if WITH_ZSTD
+	if (FormatName == NAME_Zstd)
+	{
+		return true;
+	}
+#endif
 
 	// otherwise, if we can get the format class, we are good!
 	return GetCompressionFormat(FormatName, false) != nullptr;
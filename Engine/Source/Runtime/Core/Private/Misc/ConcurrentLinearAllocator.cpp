@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/ConcurrentLinearAllocator.h"
+#include "Misc/MemStack.h"
+#include "HAL/ThreadSingleton.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/AlignmentTemplates.h"
+
+namespace ConcurrentLinearAllocator
+{
+	/** Header at the start of every page. */
+	struct FPage
+	{
+		/**
+		 * Number of live allocations, plus OwnerBias while a thread is still allocating from the page. The owner only counts its
+		 * allocations locally and settles them in one go when it retires the page, frees on any thread decrement this directly.
+		 */
+		FThreadSafeCounter NumLive;
+
+		uint8* Data()
+		{
+			return (uint8*)this + sizeof(FPage);
+		}
+
+		uint8* End()
+		{
+			return (uint8*)this + FPageAllocator::PageSize;
+		}
+
+		/** Drops Count references, returning the page to the pool when they were the last ones. */
+		void Release(int32 Count)
+		{
+			if (NumLive.Subtract(Count) == Count)
+			{
+				FPageAllocator::Free(this);
+			}
+		}
+	};
+
+	/** Reference held by the owning thread, larger than the number of allocations that fit in a page. */
+	static constexpr int32 OwnerBias = 1 << 30;
+
+	/** Allocations larger than this go to FMemory, so that at most a quarter of a page is lost when it fills up. */
+	static constexpr SIZE_T MaxPageAllocationSize = (FPageAllocator::PageSize - sizeof(FPage)) / 4;
+
+	/** Every allocation is preceded by a tag, either the FPage it was carved from or the FMemory block address with this bit set. */
+	static constexpr UPTRINT LargeAllocationTag = 1;
+
+	static_assert(FPageAllocator::PageSize / sizeof(UPTRINT) < OwnerBias, "Owner bias must exceed the number of allocations that fit in a page");
+
+	/** The page the current thread allocates from. */
+	class FThreadCache : public TThreadSingleton<FThreadCache>
+	{
+	public:
+		FPage* Page = nullptr;
+		uint8* Top = nullptr;
+		int32 NumAllocations = 0;
+
+		virtual ~FThreadCache()
+		{
+			Retire();
+		}
+
+		void Retire()
+		{
+			if (Page)
+			{
+				Page->Release(OwnerBias - NumAllocations);
+				Page = nullptr;
+				Top = nullptr;
+				NumAllocations = 0;
+			}
+		}
+
+		void Refill()
+		{
+			// if everything allocated from the current page has been freed already nobody else can reference it, so start over
+			if (Page && Page->NumLive.GetValue() == OwnerBias - NumAllocations)
+			{
+				Page->NumLive.Set(OwnerBias);
+			}
+			else
+			{
+				Retire();
+				Page = new (FPageAllocator::Alloc()) FPage();
+				Page->NumLive.Set(OwnerBias);
+			}
+			Top = Page->Data();
+			NumAllocations = 0;
+		}
+	};
+}
+
+void* FConcurrentLinearAllocator::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	using namespace ConcurrentLinearAllocator;
+
+	checkSlow(FMath::IsPowerOfTwo(Alignment));
+	Alignment = FMath::Max<uint32>(Alignment, alignof(UPTRINT));
+
+	if (Size + Alignment > MaxPageAllocationSize)
+	{
+		const SIZE_T TagSize = Align(sizeof(UPTRINT), Alignment);
+		uint8* Block = (uint8*)FMemory::Malloc(Size + TagSize, Alignment);
+		uint8* Result = Block + TagSize;
+		((UPTRINT*)Result)[-1] = (UPTRINT)Block | LargeAllocationTag;
+		return Result;
+	}
+
+	FThreadCache& Cache = FThreadCache::Get();
+	if (!Cache.Page || Align(Cache.Top + sizeof(UPTRINT), Alignment) + Size > Cache.Page->End())
+	{
+		Cache.Refill();
+	}
+	uint8* Result = Align(Cache.Top + sizeof(UPTRINT), Alignment);
+	checkSlow(Result + Size <= Cache.Page->End());
+
+	Cache.Top = Result + Size;
+	Cache.NumAllocations++;
+	((UPTRINT*)Result)[-1] = (UPTRINT)Cache.Page;
+	return Result;
+}
+
+void FConcurrentLinearAllocator::Free(void* Ptr)
+{
+	using namespace ConcurrentLinearAllocator;
+
+	if (!Ptr)
+	{
+		return;
+	}
+
+	const UPTRINT Tag = ((UPTRINT*)Ptr)[-1];
+	if (Tag & LargeAllocationTag)
+	{
+		FMemory::Free((void*)(Tag & ~LargeAllocationTag));
+	}
+	else
+	{
+		((FPage*)Tag)->Release(1);
+	}
+}
+
+void FConcurrentLinearAllocator::FlushCurrentThreadCache()
+{
+	if (ConcurrentLinearAllocator::FThreadCache* Cache = ConcurrentLinearAllocator::FThreadCache::TryGet())
+	{
+		Cache->Retire();
+	}
+}
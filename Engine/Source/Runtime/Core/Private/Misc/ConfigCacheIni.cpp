@@ -21,6 +21,16 @@
 #include "Misc/StringBuilder.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Hash/CityHash.h"
+#include "ProfilingDebugging/StartupPhases.h"
 
 #if WITH_EDITOR
 	#define INI_CACHE 1
@@ -28,6 +38,11 @@
 	#define INI_CACHE 0
 #endif
 
+// Caches fully combined ini hierarchies in Saved/Config/BinaryCache, disable at runtime with -NoIniBinaryCache
+#ifndef INI_BINARY_CACHE
+	#define INI_BINARY_CACHE PLATFORM_DESKTOP
+#endif
+
 #ifndef DISABLE_GENERATED_INI_WHEN_COOKED
 #define DISABLE_GENERATED_INI_WHEN_COOKED 0
 #endif
@@ -42,6 +57,23 @@ namespace
 }
 
 DEFINE_LOG_CATEGORY(LogConfig);
+
+static int32 GConfigAsyncFlush = 0;
+static FAutoConsoleVariableRef CVarConfigAsyncFlush(
+	TEXT("ini.AsyncFlush"),
+	GConfigAsyncFlush,
+	TEXT("Makes FConfigCacheIni::Flush write its files on a background thread like FlushAsync when it does not read them back."),
+	ECVF_Default
+);
+
+static float GConfigAsyncFlushDelay = 1.0f;
+static FAutoConsoleVariableRef CVarConfigAsyncFlushDelay(
+	TEXT("ini.AsyncFlushDelay"),
+	GConfigAsyncFlushDelay,
+	TEXT("Seconds FConfigCacheIni::FlushAsync waits for more flushes to write along with the first one."),
+	ECVF_Default
+);
+
 namespace 
 {
 	FString GenerateHierarchyCacheKey(const FConfigFileHierarchy& IniHierarchy, const FString& IniPath, const FString& BaseIniName)
@@ -461,6 +493,87 @@ static bool DoesConfigFileExistWrapper(const TCHAR* IniFile)
 	return IFileManager::Get().FileSize(IniFile) >= 0;
 }
 
+/**
+ * An ini file an ini hierarchy was combined from, as it was when it was read
+ */
+struct FIniFileDependency
+{
+	FString Filename;
+	FDateTime TimeStamp;
+	/** -1 if the file didn't exist */
+	int64 Size = -1;
+	/** Hash of the loaded text, used when the timestamp changed but the contents might not have */
+	uint64 Hash = 0;
+
+	/** Records the file's timestamp, stat before reading so that a file changing meanwhile looks out of date rather than current */
+	explicit FIniFileDependency(const FString& InFilename = FString())
+		: Filename(InFilename)
+	{
+		if (Filename.Len())
+		{
+			FFileStatData StatData = IFileManager::Get().GetStatData(*Filename);
+			if (StatData.bIsValid && !StatData.bIsDirectory)
+			{
+				TimeStamp = StatData.ModificationTime;
+				Size = StatData.FileSize;
+			}
+		}
+	}
+
+	static uint64 HashContents(const FString& Contents)
+	{
+		return CityHash64((const char*)*Contents, Contents.Len() * sizeof(TCHAR));
+	}
+
+	bool IsUpToDate() const
+	{
+		FIniFileDependency Current(Filename);
+		if (Current.Size != Size)
+		{
+			return false;
+		}
+		if (Size < 0 || Current.TimeStamp == TimeStamp)
+		{
+			return true;
+		}
+
+		// touched by a sync or a tool, only a change to the contents counts
+		FString Contents;
+		return FFileHelper::LoadFileToString(Contents, *Filename) && HashContents(Contents) == Hash;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FIniFileDependency& Dependency)
+	{
+		return Ar << Dependency.Filename << Dependency.TimeStamp << Dependency.Size << Dependency.Hash;
+	}
+};
+
+/**
+ * Active while an ini hierarchy is loaded on this thread. Hands out file contents that were prefetched in parallel
+ * and records every file that was read, including the ones pulled in with #!, for the binary cache.
+ */
+struct FIniFileLoadScope
+{
+	FIniFileLoadScope()
+		: Previous(Current)
+	{
+		Current = this;
+	}
+
+	~FIniFileLoadScope()
+	{
+		Current = Previous;
+	}
+
+	TMap<FString, FString> PrefetchedContents;
+	TMap<FString, FIniFileDependency> FilesRead;
+
+	FIniFileLoadScope* Previous;
+	static thread_local FIniFileLoadScope* Current;
+};
+
+thread_local FIniFileLoadScope* FIniFileLoadScope::Current = nullptr;
+
 /**
  * Load ini file, but allowing a delegate to handle the loading instead of the standard file load
  */
@@ -475,6 +588,20 @@ static bool LoadConfigFileWrapper(const TCHAR* IniFile, FString& Contents)
 		return true;
 	}
 
+	if (FIniFileLoadScope* Scope = FIniFileLoadScope::Current)
+	{
+		if (Scope->PrefetchedContents.RemoveAndCopyValue(IniFile, Contents))
+		{
+			return true;
+		}
+
+		FIniFileDependency Dependency(IniFile);
+		const bool bLoaded = FFileHelper::LoadFileToString(Contents, IniFile);
+		Dependency.Hash = FIniFileDependency::HashContents(Contents);
+		Scope->FilesRead.Add(IniFile, MoveTemp(Dependency));
+		return bLoaded;
+	}
+
 	// note: we don't check if FileOperations are disabled because downloadable content calls this directly (which
 	// needs file ops), and the other caller of this is already checking for disabled file ops
 	// and don't read from the file, if the delegate got anything loaded
@@ -498,6 +625,26 @@ static bool SaveConfigFileWrapper(const TCHAR* IniFile, const FString& Contents)
 }
 
 
+/**
+ * Save an ini file to a temporary file next to it, then rename it over the old one, so that a crash while writing does not leave a truncated ini
+ */
+static bool SaveConfigFileAtomically(const TCHAR* IniFile, const FString& Contents)
+{
+	const FString TempFile = FString(IniFile) + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Contents, *TempFile))
+	{
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(IniFile, *TempFile, true, false, false, true))
+	{
+		IFileManager::Get().Delete(*TempFile);
+		return false;
+	}
+	return true;
+}
+
+
 enum class EConfigLayerFlags : int32
 {
 	Required					= (1 << 0),
@@ -655,6 +802,8 @@ FConfigFile::~FConfigFile()
 		delete SourceConfigFile;
 		SourceConfigFile = nullptr;
 	}
+
+	FConfigCacheIni::IncrementGeneration();
 }
 bool FConfigFile::operator==( const FConfigFile& Other ) const
 {
@@ -721,6 +870,8 @@ bool FConfigFile::Combine(const FString& Filename)
 
 void FConfigFile::CombineFromBuffer(const FString& Buffer)
 {
+	FConfigCacheIni::IncrementGeneration();
+
 	const TCHAR* Ptr = *Buffer;
 	FConfigSection* CurrentSection = nullptr;
 	FString CurrentSectionName;
@@ -903,6 +1054,8 @@ void FConfigFile::CombineFromBuffer(const FString& Buffer)
  */
 void FConfigFile::ProcessInputFileContents(const FString& Contents)
 {
+	FConfigCacheIni::IncrementGeneration();
+
 	const TCHAR* Ptr = Contents.Len() > 0 ? *Contents : nullptr;
 	FConfigSection* CurrentSection = nullptr;
 	bool Done = false;
@@ -1227,6 +1380,214 @@ void FConfigFile::AddDynamicLayerToHeirarchy(const FString& Filename)
 	NoSave = true;
 }
 
+/**
+ * Reads the local files of an ini hierarchy on the task graph, so that combining them in order afterwards doesn't wait on IO.
+ */
+static void PrefetchIniFileHierarchy(const FConfigFileHierarchy& HierarchyToLoad, int32 FirstIndex, FIniFileLoadScope& Scope)
+{
+	// delegates that supply contents are not expected to run off the game thread, and the task graph isn't up during early startup
+	if (!FTaskGraphInterface::IsRunning() || FCoreDelegates::PreLoadConfigFileDelegate.IsBound())
+	{
+		return;
+	}
+
+	TArray<FString> Filenames;
+	for (const TPair<int32, FIniFilename>& Pair : HierarchyToLoad)
+	{
+		if (FirstIndex <= Pair.Key && IsUsingLocalIniFile(*Pair.Value.Filename, nullptr))
+		{
+			FString Filename = Pair.Value.Filename;
+			FConfigFile::OverrideFileFromCommandline(Filename);
+			Filenames.Add(MoveTemp(Filename));
+		}
+	}
+
+	if (Filenames.Num() < 2)
+	{
+		return;
+	}
+
+	TArray<FString> Contents;
+	TArray<FIniFileDependency> Dependencies;
+	TArray<bool> Loaded;
+	Contents.SetNum(Filenames.Num());
+	Dependencies.SetNum(Filenames.Num());
+	Loaded.SetNumZeroed(Filenames.Num());
+
+	ParallelFor(Filenames.Num(), [&Filenames, &Contents, &Dependencies, &Loaded](int32 Index)
+	{
+		Dependencies[Index] = FIniFileDependency(Filenames[Index]);
+		if (Dependencies[Index].Size >= 0)
+		{
+			Loaded[Index] = FFileHelper::LoadFileToString(Contents[Index], *Filenames[Index]);
+			Dependencies[Index].Hash = FIniFileDependency::HashContents(Contents[Index]);
+		}
+	});
+
+	for (int32 Index = 0; Index < Filenames.Num(); ++Index)
+	{
+		if (Loaded[Index])
+		{
+			Scope.FilesRead.Add(Filenames[Index], MoveTemp(Dependencies[Index]));
+			Scope.PrefetchedContents.Add(MoveTemp(Filenames[Index]), MoveTemp(Contents[Index]));
+		}
+	}
+}
+
+#if INI_BINARY_CACHE
+static const uint32 IniBinaryCacheMagic = 0x43494E49;
+// Bump when FConfigFile serialization changes
+static const int32 IniBinaryCacheVersion = 1;
+
+/**
+ * Returns the file the combined hierarchy is cached in, or an empty string if it can't be cached because
+ * its contents may not come from the files on disk.
+ */
+static FString GetIniBinaryCacheFilename(const FConfigFileHierarchy& HierarchyToLoad, const FConfigFile& ConfigFile)
+{
+	static const bool bDisabled = FParse::Param(FCommandLine::Get(), TEXT("NoIniBinaryCache"));
+	if (bDisabled || ConfigFile.Num() > 0 || ConfigFile.SourceConfigFile || FCoreDelegates::PreLoadConfigFileDelegate.IsBound() || (GConfig && GConfig->AreFileOperationsDisabled()))
+	{
+		return FString();
+	}
+
+	uint64 Hash = IniBinaryCacheVersion;
+	for (const TPair<int32, FIniFilename>& Pair : HierarchyToLoad)
+	{
+		if (!IsUsingLocalIniFile(*Pair.Value.Filename, nullptr))
+		{
+			return FString();
+		}
+
+		FString Filename = Pair.Value.Filename;
+		FConfigFile::OverrideFileFromCommandline(Filename);
+		Hash = CityHash128to64(Uint128_64(Hash, CityHash64((const char*)*Filename, Filename.Len() * sizeof(TCHAR)) + Pair.Key));
+	}
+
+	return FPaths::ProjectSavedDir() / TEXT("Config/BinaryCache") / FString::Printf(TEXT("%016llx.bin"), Hash);
+}
+
+/**
+ * Loads a combined hierarchy cached by SaveIniBinaryCache, if none of the files it was combined from changed since.
+ * The cache is memory mapped when the platform supports it.
+ */
+static bool LoadIniBinaryCache(const FString& CacheFilename, FConfigFile& ConfigFile)
+{
+	TUniquePtr<IMappedFileHandle> MappedHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CacheFilename));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedHandle ? MappedHandle->MapRegion() : nullptr);
+
+	TArray<uint8> FileContents;
+	TArrayView<const uint8> Bytes;
+	if (MappedRegion)
+	{
+		Bytes = MakeArrayView(MappedRegion->GetMappedPtr(), (int32)MappedRegion->GetMappedSize());
+	}
+	else if (FFileHelper::LoadFileToArray(FileContents, *CacheFilename, FILEREAD_Silent))
+	{
+		Bytes = FileContents;
+	}
+	else
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(Bytes, true);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != IniBinaryCacheMagic || Version != IniBinaryCacheVersion)
+	{
+		return false;
+	}
+
+	TArray<FIniFileDependency> Dependencies;
+	Reader << Dependencies;
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	for (const FIniFileDependency& Dependency : Dependencies)
+	{
+		if (!Dependency.IsUpToDate())
+		{
+			return false;
+		}
+	}
+
+	FConfigFile CachedConfigFile;
+	Reader << CachedConfigFile;
+	if (Reader.IsError() || CachedConfigFile.SourceConfigFile)
+	{
+		return false;
+	}
+
+	// only the sections come from the hierarchy, keep what the caller has already set up
+	const FName Name = ConfigFile.Name;
+	const bool bNoSave = ConfigFile.NoSave;
+	const FString SourceEngineConfigDir = ConfigFile.SourceEngineConfigDir;
+	const FString SourceProjectConfigDir = ConfigFile.SourceProjectConfigDir;
+#if ALLOW_INI_OVERRIDE_FROM_COMMANDLINE
+	const TArray<FConfigCommandlineOverride> CommandlineOptions = ConfigFile.CommandlineOptions;
+#endif
+
+	ConfigFile = CachedConfigFile;
+
+	ConfigFile.Name = Name;
+	ConfigFile.NoSave = bNoSave;
+	ConfigFile.SourceEngineConfigDir = SourceEngineConfigDir;
+	ConfigFile.SourceProjectConfigDir = SourceProjectConfigDir;
+#if ALLOW_INI_OVERRIDE_FROM_COMMANDLINE
+	ConfigFile.CommandlineOptions = CommandlineOptions;
+#endif
+	return true;
+}
+
+/**
+ * Saves a combined hierarchy together with the timestamps and hashes of all the files it was combined from.
+ */
+static void SaveIniBinaryCache(const FString& CacheFilename, const FConfigFileHierarchy& HierarchyToLoad, const FIniFileLoadScope& Scope, FConfigFile& ConfigFile)
+{
+	// many processes would race updating the same file, see the Multiprocess check for saving generated inis
+	if (FParse::Param(FCommandLine::Get(), TEXT("Multiprocess")))
+	{
+		return;
+	}
+
+	TArray<FIniFileDependency> Dependencies;
+	Scope.FilesRead.GenerateValueArray(Dependencies);
+
+	// files that don't exist matter as well, creating one has to invalidate the cache
+	for (const TPair<int32, FIniFilename>& Pair : HierarchyToLoad)
+	{
+		FString Filename = Pair.Value.Filename;
+		FConfigFile::OverrideFileFromCommandline(Filename);
+		if (!Scope.FilesRead.Contains(Filename))
+		{
+			Dependencies.Add(FIniFileDependency(Filename));
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes, true);
+	uint32 Magic = IniBinaryCacheMagic;
+	int32 Version = IniBinaryCacheVersion;
+	Writer << Magic << Version << Dependencies << ConfigFile;
+
+	// write to a temporary file and move it in place so other processes never see a partial cache
+	const FString CacheDir = FPaths::GetPath(CacheFilename);
+	const FString TempFilename = FPaths::CreateTempFilename(*CacheDir, TEXT("IniCache"));
+	if (FFileHelper::SaveArrayToFile(Bytes, *TempFilename))
+	{
+		if (!IFileManager::Get().Move(*CacheFilename, *TempFilename, /*Replace*/ true, /*EvenIfReadOnly*/ true, /*Attributes*/ false, /*bDoNotRetryOrError*/ true))
+		{
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+		}
+	}
+}
+#endif // INI_BINARY_CACHE
+
 /**
  * This will completely load .ini file hierarchy into the passed in FConfigFile. The passed in FConfigFile will then
  * have the data after combining all of those .ini 
@@ -1264,6 +1625,15 @@ static bool LoadIniFileHierarchy(const FConfigFileHierarchy& HierarchyToLoad, FC
 		}
 	}
 
+#if INI_BINARY_CACHE
+	const FString BinaryCacheFilename = bUseCache ? GetIniBinaryCacheFilename(HierarchyToLoad, ConfigFile) : FString();
+	if (BinaryCacheFilename.Len() && LoadIniBinaryCache(BinaryCacheFilename, ConfigFile))
+	{
+		ConfigFile.SourceIniHierarchy = HierarchyToLoad;
+		return true;
+	}
+#endif
+
 	int32 FirstCacheIndex = 0;
 #if INI_CACHE
 	if (bUseCache && HierarchyCache.Num() > 0)
@@ -1280,10 +1650,17 @@ static bool LoadIniFileHierarchy(const FConfigFileHierarchy& HierarchyToLoad, FC
 #endif
 
 	TArray<FDateTime> TimestampsOfInis;
+#if INI_BINARY_CACHE
+	bool bUsedHierarchyCache = FirstCacheIndex > 0;
+#endif
 	
 	// Making a copy of the HierarchyToLoad so we can loop and make changes to ConfigFile without breaking the iteration.
 	const FConfigFileHierarchy TempHierarchyToLoad = HierarchyToLoad;
 
+	// The layers have to be combined in order, but they can be read in parallel up front
+	FIniFileLoadScope LoadScope;
+	PrefetchIniFileHierarchy(TempHierarchyToLoad, FirstCacheIndex, LoadScope);
+
 	// Traverse ini list back to front, merging along the way.
 	for (auto& HierarchyIt : TempHierarchyToLoad)
 	{
@@ -1302,6 +1679,9 @@ static bool LoadIniFileHierarchy(const FConfigFileHierarchy& HierarchyToLoad, FC
 				{
 					ConfigFile = *CachedConfigFile;
 					bDoProcess = false;
+#if INI_BINARY_CACHE
+					bUsedHierarchyCache = true;
+#endif
 				}
 				ConfigFile.CacheKey = IniToLoad.CacheKey;
 			}
@@ -1350,6 +1730,14 @@ static bool LoadIniFileHierarchy(const FConfigFileHierarchy& HierarchyToLoad, FC
 	// Set this configs files source ini hierarchy to show where it was loaded from.
 	ConfigFile.SourceIniHierarchy = TempHierarchyToLoad;
 
+#if INI_BINARY_CACHE
+	// a load that used the in memory cache didn't read every file, so it can't be cached
+	if (BinaryCacheFilename.Len() && !bUsedHierarchyCache)
+	{
+		SaveIniBinaryCache(BinaryCacheFilename, TempHierarchyToLoad, LoadScope, ConfigFile);
+	}
+#endif
+
 	return true;
 }
 
@@ -1429,7 +1817,7 @@ bool PropertySetFromCommandlineOption(const FConfigFile* InConfigFile, const FSt
 #if ALLOW_INI_OVERRIDE_FROM_COMMANDLINE
 	for (const FConfigCommandlineOverride& CommandlineOverride : InConfigFile->CommandlineOptions)
 	{
-		if (CommandlineOverride.PropertyKey.Equals(InPropertyName.ToString(), ESearchCase::IgnoreCase) &&
+		if (InPropertyName == *CommandlineOverride.PropertyKey &&
 			CommandlineOverride.PropertyValue.Equals(InPropertyValue, ESearchCase::IgnoreCase) &&
 			CommandlineOverride.Section.Equals(InSectionName, ESearchCase::IgnoreCase) &&
 			CommandlineOverride.BaseFileName.Equals(FPaths::GetBaseFilename(InConfigFile->Name.ToString()), ESearchCase::IgnoreCase))
@@ -1474,6 +1862,14 @@ bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite/* = true*/,
 }
 
 bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite, TMap<FString, FString>& InOutSectionTexts, const TArray<FString>& InSectionOrder)
+{
+	return WriteInternal(Filename, bDoRemoteWrite, InOutSectionTexts, InSectionOrder, [&Filename](const FString& Contents)
+	{
+		return SaveConfigFileWrapper(*Filename, Contents);
+	});
+}
+
+bool FConfigFile::WriteInternal(const FString& Filename, bool bDoRemoteWrite, TMap<FString, FString>& InOutSectionTexts, const TArray<FString>& InSectionOrder, TFunctionRef<bool(const FString&)> Save)
 {
 	if( !Dirty || NoSave || FParse::Param( FCommandLine::Get(), TEXT("nowrite")) || 
 		(FParse::Param( FCommandLine::Get(), TEXT("Multiprocess"))  && !FParse::Param( FCommandLine::Get(), TEXT("MultiprocessSaveConfig"))) // Is can be useful to save configs with multiprocess if they are given INI overrides
@@ -1483,6 +1879,12 @@ bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite, TMap<FStri
 	bool bAcquiredIniCombineThreshold = false;	// avoids extra work when writing multiple properties
 	int32 IniCombineThreshold = -1;
 
+	// If we are writing to a default config file and a property is an array, we need to be careful to remove those from higher up the hierarchy
+	const FString AbsoluteFilename = FPaths::ConvertRelativePathToFull(Filename);
+	const FString AbsoluteGameGeneratedConfigDir = FPaths::ConvertRelativePathToFull(FPaths::GeneratedConfigDir());
+	const FString AbsoluteGameAgnosticGeneratedConfigDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(*FPaths::GameAgnosticSavedDir(), TEXT("Config")) + TEXT("/"));
+	const bool bIsADefaultIniWrite = !AbsoluteFilename.Contains(AbsoluteGameGeneratedConfigDir) && !AbsoluteFilename.Contains(AbsoluteGameAgnosticGeneratedConfigDir);
+
 	TStringBuilder<128> Text;
 	FStringView BlankLine(LINE_TERMINATOR LINE_TERMINATOR);
 	TArray<FString> SectionOrder;
@@ -1530,12 +1932,6 @@ bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite, TMap<FStri
 				// check whether the option we are attempting to write out, came from the commandline as a temporary override.
 				const bool bOptionIsFromCommandline = PropertySetFromCommandlineOption(this, SectionName, PropertyName, PropertyValue);
 
-				// If we are writing to a default config file and this property is an array, we need to be careful to remove those from higher up the hierarchy
-				const FString AbsoluteFilename = FPaths::ConvertRelativePathToFull(Filename);
-				const FString AbsoluteGameGeneratedConfigDir = FPaths::ConvertRelativePathToFull(FPaths::GeneratedConfigDir());
-				const FString AbsoluteGameAgnosticGeneratedConfigDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(*FPaths::GameAgnosticSavedDir(), TEXT("Config")) + TEXT("/"));
-				const bool bIsADefaultIniWrite = !AbsoluteFilename.Contains(AbsoluteGameGeneratedConfigDir) && !AbsoluteFilename.Contains(AbsoluteGameAgnosticGeneratedConfigDir);
-				
 				// We ALWAYS want to write CurrentIniVersion.
 				const bool bIsCurrentIniVersion = (SectionName == CurrentIniVersionString);
 
@@ -1671,7 +2067,7 @@ bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite, TMap<FStri
 		FRemoteConfig::Get()->Write(*Filename, TextAsString);
 	}
 
-	bool bResult = SaveConfigFileWrapper(*Filename, TextAsString);
+	bool bResult = Save(TextAsString);
 
 #if INI_CACHE
 	// if we wrote the config successfully
@@ -1699,6 +2095,8 @@ bool FConfigFile::Write(const FString& Filename, bool bDoRemoteWrite, TMap<FStri
 /** Adds any properties that exist in InSourceFile that this config file is missing */
 void FConfigFile::AddMissingProperties( const FConfigFile& InSourceFile )
 {
+	FConfigCacheIni::IncrementGeneration();
+
 	for( TConstIterator SourceSectionIt( InSourceFile ); SourceSectionIt; ++SourceSectionIt )
 	{
 		const FString& SourceSectionName = SourceSectionIt.Key();
@@ -1869,10 +2267,12 @@ void FConfigFile::SetString( const TCHAR* Section, const TCHAR* Key, const TCHAR
 	{
 		Sec->Add( Key, Value );
 		Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 	}
 	else if( FCString::Strcmp(*ConfigValue->GetSavedValue(),Value)!=0 )
 	{
 		Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 		*ConfigValue = FConfigValue(Value);
 	}
 }
@@ -1889,10 +2289,12 @@ void FConfigFile::SetText( const TCHAR* Section, const TCHAR* Key, const FText&
 	{
 		Sec->Add( Key, StrValue );
 		Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 	}
 	else if( FCString::Strcmp(*ConfigValue->GetSavedValue(), *StrValue)!=0 )
 	{
 		Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 		*ConfigValue = FConfigValue(StrValue);
 	}
 }
@@ -2028,10 +2430,100 @@ void FConfigFile::ProcessPropertyAndWriteForDefaults( int IniCombineThreshold, c
 	FConfigCacheIni
 -----------------------------------------------------------------------------*/
 
+TAtomic<uint32> FConfigCacheIni::Generation(1);
+
+class FConfigCacheIni::FAsyncWriter
+{
+public:
+	~FAsyncWriter()
+	{
+		Wait();
+	}
+
+	void Enqueue(const FString& Filename, const FString& Contents)
+	{
+		if (!FPlatformProcess::SupportsMultithreading() || !GThreadPool)
+		{
+			Write(Filename, Contents);
+			return;
+		}
+
+		FScopeLock Lock(&Critical);
+
+		// a file that is still waiting to be written only needs its latest text written
+		Queue.Add(Filename, Contents);
+		if (!bWriting)
+		{
+			bWriting = true;
+			Task = Async(EAsyncExecution::ThreadPool, [this]()
+			{
+				WriteQueue();
+			});
+		}
+	}
+
+	/** Only called from the thread that enqueues */
+	void Wait()
+	{
+		if (Task.IsValid())
+		{
+			Task.Wait();
+		}
+	}
+
+	void TakeFailedFilenames(TArray<FString>& OutFilenames)
+	{
+		FScopeLock Lock(&Critical);
+		OutFilenames = MoveTemp(FailedFilenames);
+	}
+
+private:
+	void WriteQueue()
+	{
+		while (true)
+		{
+			FString Filename;
+			FString Contents;
+			{
+				FScopeLock Lock(&Critical);
+				TMap<FString, FString>::TIterator It = Queue.CreateIterator();
+				if (!It)
+				{
+					bWriting = false;
+					return;
+				}
+				Filename = It.Key();
+				Contents = MoveTemp(It.Value());
+				It.RemoveCurrent();
+			}
+			Write(Filename, Contents);
+		}
+	}
+
+	void Write(const FString& Filename, const FString& Contents)
+	{
+		if (!SaveConfigFileAtomically(*Filename, Contents))
+		{
+			UE_LOG(LogConfig, Warning, TEXT("Could not write %s in the background, it will be written by the next flush."), *Filename);
+
+			FScopeLock Lock(&Critical);
+			FailedFilenames.AddUnique(Filename);
+		}
+	}
+
+	/** One write at a time, so that an older text of a file never lands after a newer one */
+	FCriticalSection Critical;
+	TMap<FString, FString> Queue;
+	TArray<FString> FailedFilenames;
+	bool bWriting = false;
+	TFuture<void> Task;
+};
+
 FConfigCacheIni::FConfigCacheIni(EConfigCacheType InType)
 	: bAreFileOperationsDisabled(false)
 	, bIsReadyForUse(false)
 	, Type(InType)
+	, bPendingAsyncFlushAll(false)
 {
 }
 
@@ -2043,6 +2535,11 @@ FConfigCacheIni::FConfigCacheIni()
 FConfigCacheIni::~FConfigCacheIni()
 {
 	Flush( 1 );
+
+	if (AsyncFlushExitHandle.IsValid())
+	{
+		FCoreDelegates::OnExit.Remove(AsyncFlushExitHandle);
+	}
 }
 
 FConfigFile* FConfigCacheIni::FindConfigFile( const FString& Filename )
@@ -2090,6 +2587,15 @@ void FConfigCacheIni::Flush( bool Read, const FString& Filename )
 		return;
 	}
 
+	if (!Read && GConfigAsyncFlush && !IsEngineExitRequested())
+	{
+		FlushAsync(Filename);
+		return;
+	}
+
+	// a write still waiting or in the background must not land after this one
+	FinishAsyncFlushes();
+
 	// write out the files if we can
 	if (!bAreFileOperationsDisabled)
 	{
@@ -2121,6 +2627,100 @@ void FConfigCacheIni::Flush( bool Read, const FString& Filename )
 	}
 }
 
+void FConfigCacheIni::FlushAsync( const FString& Filename )
+{
+	if (Type == EConfigCacheType::Temporary || bAreFileOperationsDisabled)
+	{
+		return;
+	}
+
+	if (Filename.Len() == 0)
+	{
+		bPendingAsyncFlushAll = true;
+	}
+	else
+	{
+		PendingAsyncFlushes.Add(Filename);
+	}
+
+	if (!AsyncFlushTickerHandle.IsValid())
+	{
+		AsyncFlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FConfigCacheIni::TickAsyncFlush), FMath::Max(GConfigAsyncFlushDelay, 0.0f));
+	}
+
+	// the ticker may not tick again once the engine exits
+	if (!AsyncFlushExitHandle.IsValid())
+	{
+		AsyncFlushExitHandle = FCoreDelegates::OnExit.AddRaw(this, &FConfigCacheIni::FinishAsyncFlushes);
+	}
+}
+
+bool FConfigCacheIni::TickAsyncFlush(float DeltaTime)
+{
+	AsyncFlushTickerHandle.Reset();
+	RedirtyFailedAsyncWrites();
+
+	if (!bAreFileOperationsDisabled)
+	{
+		for (TIterator It(*this); It; ++It)
+		{
+			if (bPendingAsyncFlushAll || PendingAsyncFlushes.Contains(It.Key()))
+			{
+				const FString& Filename = It.Key();
+				TMap<FString, FString> SectionTexts;
+				It.Value().WriteInternal(Filename, true, SectionTexts, TArray<FString>(), [this, &Filename](const FString& Contents)
+				{
+					// the delegates are called here rather than on the background thread, as they are with Flush
+					int32 SavedCount = 0;
+					FCoreDelegates::PreSaveConfigFileDelegate.Broadcast(*Filename, Contents, SavedCount);
+
+					if (!AsyncWriter)
+					{
+						AsyncWriter = MakeUnique<FAsyncWriter>();
+					}
+					AsyncWriter->Enqueue(Filename, Contents);
+					return true;
+				});
+			}
+		}
+	}
+
+	PendingAsyncFlushes.Reset();
+	bPendingAsyncFlushAll = false;
+	return false;
+}
+
+void FConfigCacheIni::FinishAsyncFlushes()
+{
+	if (AsyncFlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(AsyncFlushTickerHandle);
+		TickAsyncFlush(0.0f);
+	}
+
+	if (AsyncWriter)
+	{
+		AsyncWriter->Wait();
+		RedirtyFailedAsyncWrites();
+	}
+}
+
+void FConfigCacheIni::RedirtyFailedAsyncWrites()
+{
+	if (AsyncWriter)
+	{
+		TArray<FString> FailedFilenames;
+		AsyncWriter->TakeFailedFilenames(FailedFilenames);
+		for (const FString& Filename : FailedFilenames)
+		{
+			if (FConfigFile* File = FindConfigFile(Filename))
+			{
+				File->Dirty = true;
+			}
+		}
+	}
+}
+
 /**
  * Disables any file IO by the config cache system
  */
@@ -2287,6 +2887,7 @@ void FConfigCacheIni::LoadFile( const FString& Filename, const FConfigFile* Fall
 	else if( Fallback )
 	{
 		Add( *Filename, *Fallback );
+		IncrementGeneration();
 		UE_LOG(LogConfig, Verbose, TEXT( "GConfig::LoadFile associated file:  %s" ), *Filename);
 	}
 	else
@@ -2302,6 +2903,7 @@ void FConfigCacheIni::LoadFile( const FString& Filename, const FConfigFile* Fall
 void FConfigCacheIni::SetFile( const FString& Filename, const FConfigFile* NewConfigFile )
 {
 	Add(Filename, *NewConfigFile);
+	IncrementGeneration();
 }
 
 
@@ -2418,7 +3020,9 @@ FConfigSection* FConfigCacheIni::GetSectionPrivate( const TCHAR* Section, bool F
 	}
 	if (Sec && (Force || !Const))
 	{
+		// the caller may modify the section
 		File->Dirty = true;
+		IncrementGeneration();
 	}
 
 	if (Sec)
@@ -2462,10 +3066,12 @@ void FConfigCacheIni::SetString( const TCHAR* Section, const TCHAR* Key, const T
 	{
 		Sec->Add( Key, Value );
 		File->Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 	}
 	else if( FCString::Strcmp(*ConfigValue->GetSavedValue(),Value)!=0 )
 	{
 		File->Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 		*ConfigValue = FConfigValue(Value);
 	}
 }
@@ -2489,10 +3095,12 @@ void FConfigCacheIni::SetText( const TCHAR* Section, const TCHAR* Key, const FTe
 	{
 		Sec->Add( Key, StrValue );
 		File->Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 	}
 	else if( FCString::Strcmp(*ConfigValue->GetSavedValue(), *StrValue)!=0 )
 	{
 		File->Dirty = true;
+		FConfigCacheIni::IncrementGeneration();
 		*ConfigValue = FConfigValue(StrValue);
 	}
 }
@@ -2508,6 +3116,7 @@ bool FConfigCacheIni::RemoveKey( const TCHAR* Section, const TCHAR* Key, const F
 			if( Sec->Remove(Key) > 0 )
 			{
 				File->Dirty = 1;
+				IncrementGeneration();
 				return true;
 			}
 		}
@@ -2529,6 +3138,7 @@ bool FConfigCacheIni::EmptySection( const TCHAR* Section, const FString& Filenam
 				Sec->Empty();
 			}
 			File->Remove(Section);
+			IncrementGeneration();
 			if (bAreFileOperationsDisabled == false)
 			{
 				if (File->Num())
@@ -3778,6 +4388,21 @@ FArchive& operator<<(FArchive& Ar, FConfigCacheIni& ConfigCacheIni)
 	return Ar;
 }
 
+FConfigValueHandle::FConfigValueHandle(const TCHAR* InSection, const TCHAR* InKey, const FString& InFilename)
+	: Section(InSection)
+	, Key(InKey)
+	, Filename(InFilename)
+	, Generation(0)
+{
+}
+
+bool FConfigValueHandle::Resolve(FString& OutValue)
+{
+	// read the generation first, a change made during the lookup has to make the next read look it up again
+	Generation = FConfigCacheIni::GetGeneration();
+	return GConfig && GConfig->GetString(*Section, *Key, OutValue, Filename);
+}
+
 void FConfigCacheIni::SerializeStateForBootstrap_Impl(FArchive& Ar)
 {
 	// This implementation is meant to stay private and be used for 
@@ -3805,6 +4430,8 @@ void FConfigCacheIni::SerializeStateForBootstrap_Impl(FArchive& Ar)
 
 void FConfigCacheIni::InitializeConfigSystem()
 {
+	SCOPED_STARTUP_PHASE(TEXT("ConfigSystem"), TEXT("CommandLine"));
+
 	// Bootstrap the Ini config cache
 	FString IniBootstrapFilename;
 	if (FParse::Value( FCommandLine::Get(), TEXT("IniBootstrap="), IniBootstrapFilename))
@@ -4,6 +4,22 @@
 #include "Templates/AlignmentTemplates.h"
 #include "Templates/UnrealTemplate.h"
 #include "Misc/ByteSwap.h"
+#include "HAL/UnrealMemory.h"
+#include "HAL/CPUFeatures.h"
+
+#if PLATFORM_HAS_CPUID && PLATFORM_ENABLE_VECTORINTRINSICS
+	#define UE_CRC32C_SSE42 1
+	#include <nmmintrin.h>
+#else
+	#define UE_CRC32C_SSE42 0
+#endif
+
+#if !UE_CRC32C_SSE42 && defined(__ARM_FEATURE_CRC32)
+	#define UE_CRC32C_ARM 1
+	#include <arm_acle.h>
+#else
+	#define UE_CRC32C_ARM 0
+#endif
 
 /** CRC 32 polynomial */
 enum { Crc32Poly = 0x04c11db7 };
@@ -528,3 +544,125 @@ uint32 FCrc::MemCrc_DEPRECATED(const void* InData, int32 Length, uint32 CRC/*=0
 
 	return BYTESWAP_ORDER32(~CRC);
 }
+
+namespace UE4Crc_Private
+{
+	/** Slicing by 8 tables for the Castagnoli polynomial, for CPUs without a CRC32C instruction */
+	struct FCrc32CTables
+	{
+		uint32 Tables[8][256];
+
+		FCrc32CTables()
+		{
+			const uint32 ReversedPoly = 0x82F63B78;
+			for (uint32 i = 0; i != 256; ++i)
+			{
+				uint32 CRC = i;
+				for (uint32 j = 8; j; --j)
+				{
+					CRC = (CRC & 1) ? (CRC >> 1) ^ ReversedPoly : (CRC >> 1);
+				}
+				Tables[0][i] = CRC;
+			}
+
+			for (uint32 i = 0; i != 256; ++i)
+			{
+				uint32 CRC = Tables[0][i];
+				for (uint32 j = 1; j != 8; ++j)
+				{
+					CRC = Tables[0][CRC & 0xFF] ^ (CRC >> 8);
+					Tables[j][i] = CRC;
+				}
+			}
+		}
+	};
+
+	static uint32 MemCrc32CTables(const uint8* __restrict Data, int32 Length, uint32 CRC)
+	{
+		static const FCrc32CTables Crc32CTables;
+		const uint32 (&Tables)[8][256] = Crc32CTables.Tables;
+
+		for (; Length >= 8; Length -= 8, Data += 8)
+		{
+			uint32 V1;
+			uint32 V2;
+			FMemory::Memcpy(&V1, Data, sizeof(V1));
+			FMemory::Memcpy(&V2, Data + 4, sizeof(V2));
+			V1 ^= CRC;
+			CRC =
+				Tables[7][ V1         & 0xFF] ^
+				Tables[6][(V1 >> 8)   & 0xFF] ^
+				Tables[5][(V1 >> 16)  & 0xFF] ^
+				Tables[4][ V1 >> 24         ] ^
+				Tables[3][ V2         & 0xFF] ^
+				Tables[2][(V2 >> 8)   & 0xFF] ^
+				Tables[1][(V2 >> 16)  & 0xFF] ^
+				Tables[0][ V2 >> 24         ];
+		}
+
+		for (; Length; --Length)
+		{
+			CRC = (CRC >> 8) ^ Tables[0][(CRC & 0xFF) ^ *Data++];
+		}
+		return CRC;
+	}
+
+#if UE_CRC32C_SSE42
+	UE_CPU_TARGET("sse4.2") static uint32 MemCrc32CSSE42(const uint8* __restrict Data, int32 Length, uint32 CRC)
+	{
+#if PLATFORM_64BITS
+		uint64 CRC64 = CRC;
+		for (; Length >= 8; Length -= 8, Data += 8)
+		{
+			uint64 Value;
+			FMemory::Memcpy(&Value, Data, sizeof(Value));
+			CRC64 = _mm_crc32_u64(CRC64, Value);
+		}
+		CRC = (uint32)CRC64;
+#endif
+		for (; Length >= 4; Length -= 4, Data += 4)
+		{
+			uint32 Value;
+			FMemory::Memcpy(&Value, Data, sizeof(Value));
+			CRC = _mm_crc32_u32(CRC, Value);
+		}
+		for (; Length; --Length)
+		{
+			CRC = _mm_crc32_u8(CRC, *Data++);
+		}
+		return CRC;
+	}
+#elif UE_CRC32C_ARM
+	static uint32 MemCrc32CARM(const uint8* __restrict Data, int32 Length, uint32 CRC)
+	{
+		for (; Length >= 8; Length -= 8, Data += 8)
+		{
+			uint64 Value;
+			FMemory::Memcpy(&Value, Data, sizeof(Value));
+			CRC = __crc32cd(CRC, Value);
+		}
+		for (; Length; --Length)
+		{
+			CRC = __crc32cb(CRC, *Data++);
+		}
+		return CRC;
+	}
+#endif
+}
+
+uint32 FCrc::MemCrc32C(const void* InData, int32 Length, uint32 CRC/*=0 */)
+{
+	const uint8* Data = (const uint8*)InData;
+	CRC = ~CRC;
+
+#if UE_CRC32C_SSE42
+	typedef TMultiVersionFunction<uint32(const uint8*, int32, uint32)> FMemCrc32CFunction;
+	static const FMemCrc32CFunction MemCrc32CImpl = FMemCrc32CFunction(&UE4Crc_Private::MemCrc32CTables)
+		.Register(ECPUFeatures::SSE42, &UE4Crc_Private::MemCrc32CSSE42);
+	return ~MemCrc32CImpl(Data, Length, CRC);
+#elif UE_CRC32C_ARM
+	return ~UE4Crc_Private::MemCrc32CARM(Data, Length, CRC);
+#else
+	return ~UE4Crc_Private::MemCrc32CTables(Data, Length, CRC);
+#endif
+}
@@ -673,12 +673,19 @@ namespace ExpressionParser
 	}
 
 	FExpressionResult Evaluate(const TArray<FCompiledToken>& CompiledTokens, const IOperatorEvaluationEnvironment& InEnvironment)
+	{
+		FEvaluationStack Stack;
+		return Evaluate(CompiledTokens, InEnvironment, Stack);
+	}
+
+	FExpressionResult Evaluate(const TArray<FCompiledToken>& CompiledTokens, const IOperatorEvaluationEnvironment& InEnvironment, FEvaluationStack& Stack)
 	{
 		// Evaluation strategy: the supplied compiled tokens are const. To avoid copying the whole array, we store a separate array of
 		// any tokens that are generated at runtime by the evaluator. The operand stack will consist of indices into either the CompiledTokens
 		// array, or the RuntimeGeneratedTokens (where Index >= CompiledTokens.Num())
-		TArray<FExpressionToken> RuntimeGeneratedTokens;
-		TArray<int32> OperandStack;
+		Stack.Reset();
+		TArray<FExpressionToken, TInlineAllocator<8>>& RuntimeGeneratedTokens = Stack.RuntimeGeneratedTokens;
+		TArray<int32, TInlineAllocator<16>>& OperandStack = Stack.OperandStack;
 
 		/** Get the token pertaining to the specified operand index */
 		auto GetToken = [&](int32 Index) -> const FExpressionToken& {
@@ -777,6 +784,11 @@ namespace ExpressionParser
 
 		if (OperandStack.Num() == 1)
 		{
+			// Runtime generated results are only working memory, so they're moved out rather than copied
+			if (OperandStack[0] >= CompiledTokens.Num())
+			{
+				return MakeValue(MoveTemp(RuntimeGeneratedTokens[OperandStack[0] - CompiledTokens.Num()].Node));
+			}
 			return MakeValue(GetToken(OperandStack[0]).Node.Copy());
 		}
 
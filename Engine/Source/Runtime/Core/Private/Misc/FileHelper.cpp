@@ -13,6 +13,8 @@
 #include "Misc/ConfigCacheIni.h"
 #include "Misc/SecureHash.h"
 #include "HAL/FileManagerGeneric.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
 
 #define LOCTEXT_NAMESPACE "FileHelper"
 
@@ -22,6 +24,105 @@ static const TCHAR* InvalidFilenames[] = {
 	TEXT("LPT1"), TEXT("LPT2"), TEXT("LPT3"), TEXT("LPT4"), TEXT("LPT5"), TEXT("LPT6"), TEXT("LPT7"), TEXT("LPT8"), TEXT("LPT9")
 };
 
+namespace UE4FileHelper_Private
+{
+	/** Size of the blocks LoadFileToUTF8LineVisitor reads files it can't map in */
+	static constexpr int32 LineVisitorBlockSize = 64 * 1024;
+
+	static bool HasUTF16BOM(const uint8* Buffer, int64 Size)
+	{
+		return Size >= 2 && !(Size & 1) && ((Buffer[0] == 0xff && Buffer[1] == 0xfe) || (Buffer[0] == 0xfe && Buffer[1] == 0xff));
+	}
+
+	static int32 GetUTF8BOMSize(const uint8* Buffer, int64 Size)
+	{
+		return Size >= 3 && Buffer[0] == 0xef && Buffer[1] == 0xbb && Buffer[2] == 0xbf ? 3 : 0;
+	}
+
+	/**
+	 * Calls Visitor for each line in [Start, End). Unless bFinal, the line that isn't terminated yet is left for the next block.
+	 * @return Where the lines not visited yet start
+	 */
+	static const ANSICHAR* VisitUTF8Lines(const ANSICHAR* Start, const ANSICHAR* End, bool bFinal, TFunctionRef<void(FAnsiStringView Line)> Visitor)
+	{
+		const ANSICHAR* LineStart = Start;
+		for (const ANSICHAR* Pos = Start; Pos < End; ++Pos)
+		{
+			if (*Pos != '\n' && *Pos != '\r')
+			{
+				continue;
+			}
+			if (*Pos == '\r' && Pos + 1 == End && !bFinal)
+			{
+				// The \n of a \r\n may be in the next block
+				break;
+			}
+
+			Visitor(FAnsiStringView(LineStart, UE_PTRDIFF_TO_INT32(Pos - LineStart)));
+			if (*Pos == '\r' && Pos + 1 < End && Pos[1] == '\n')
+			{
+				++Pos;
+			}
+			LineStart = Pos + 1;
+		}
+
+		if (bFinal && LineStart < End)
+		{
+			Visitor(FAnsiStringView(LineStart, UE_PTRDIFF_TO_INT32(End - LineStart)));
+			LineStart = End;
+		}
+		return LineStart;
+	}
+
+	/** Converts the lines of a UTF-16 file, the only case LoadFileToUTF8LineVisitor needs the whole file as TCHAR */
+	static void VisitUTF16Lines(const uint8* Buffer, int64 Size, TFunctionRef<void(FAnsiStringView Line)> Visitor)
+	{
+		FString Text;
+		FFileHelper::BufferToString(Text, Buffer, (int32)Size);
+		FTCHARToUTF8 UTF8Text(*Text, Text.Len());
+		VisitUTF8Lines(UTF8Text.Get(), UTF8Text.Get() + UTF8Text.Length(), true, Visitor);
+	}
+
+	/** LoadFileToStringArray without the whole file as TCHAR, only a line at a time */
+	static bool LoadFileToStringArrayByLine(TArray<FString>& Result, const TCHAR* Filename, TFunctionRef<bool(const FString&)> Predicate)
+	{
+		return FFileHelper::LoadFileToUTF8LineVisitor(Filename, [&Result, &Predicate](FAnsiStringView Line)
+		{
+			FUTF8ToTCHAR Converted(Line.GetData(), Line.Len());
+			FString String(Converted.Length(), Converted.Get());
+			if (Invoke(Predicate, String))
+			{
+				Result.Add(MoveTemp(String));
+			}
+		});
+	}
+}
+
+/*-----------------------------------------------------------------------------
+	FMappedFileView
+-----------------------------------------------------------------------------*/
+
+FMappedFileView::FMappedFileView()
+	: Data(nullptr)
+	, Size(0)
+{
+}
+
+FMappedFileView::~FMappedFileView()
+{
+	Reset();
+}
+
+void FMappedFileView::Reset()
+{
+	// The region must be unmapped before the file is closed
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	LoadedData.Empty();
+	Data = nullptr;
+	Size = 0;
+}
+
 /*-----------------------------------------------------------------------------
 	FFileHelper
 -----------------------------------------------------------------------------*/
@@ -79,6 +180,106 @@ bool FFileHelper::LoadFileToArray(TArray64<uint8>& Result, const TCHAR* Filename
 	return Success;
 }
 
+bool FFileHelper::LoadFileToMappedView(FMappedFileView& Result, const TCHAR* Filename, uint32 Flags)
+{
+	FScopedLoadingState ScopedLoadingState(Filename);
+	Result.Reset();
+
+	TUniquePtr<IMappedFileHandle> MappedHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+	if (MappedHandle)
+	{
+		// Mapped regions can't be empty, an empty file is an empty view
+		if (MappedHandle->GetFileSize() > 0)
+		{
+			Result.MappedRegion.Reset(MappedHandle->MapRegion());
+			Result.MappedHandle = MoveTemp(MappedHandle);
+			Result.Data = Result.MappedRegion->GetMappedPtr();
+			Result.Size = Result.MappedRegion->GetMappedSize();
+		}
+		return true;
+	}
+
+	if (!LoadFileToArray(Result.LoadedData, Filename, Flags))
+	{
+		Result.Reset();
+		return false;
+	}
+	Result.Data = Result.LoadedData.GetData();
+	Result.Size = Result.LoadedData.Num();
+	return true;
+}
+
+bool FFileHelper::LoadFileToUTF8LineVisitor(const TCHAR* Filename, TFunctionRef<void(FAnsiStringView Line)> Visitor, uint32 Flags)
+{
+	using namespace UE4FileHelper_Private;
+
+	FScopedLoadingState ScopedLoadingState(Filename);
+
+	TUniquePtr<IMappedFileHandle> MappedHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+	if (MappedHandle)
+	{
+		if (MappedHandle->GetFileSize() > 0)
+		{
+			TUniquePtr<IMappedFileRegion> Region(MappedHandle->MapRegion());
+			const uint8* Buffer = Region->GetMappedPtr();
+			const int64 Size = Region->GetMappedSize();
+			if (HasUTF16BOM(Buffer, Size))
+			{
+				VisitUTF16Lines(Buffer, Size, Visitor);
+			}
+			else
+			{
+				const int32 BOMSize = GetUTF8BOMSize(Buffer, Size);
+				VisitUTF8Lines((const ANSICHAR*)Buffer + BOMSize, (const ANSICHAR*)Buffer + Size, true, Visitor);
+			}
+		}
+		return true;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(Filename, Flags));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	const int64 TotalSize = Reader->TotalSize();
+	int64 Remaining = TotalSize;
+	TArray<ANSICHAR> Block;
+	int32 NumCarried = 0;
+	while (Remaining > 0 && !Reader->IsError())
+	{
+		const int32 ReadSize = (int32)FMath::Min<int64>(LineVisitorBlockSize, Remaining);
+		Block.SetNumUninitialized(NumCarried + ReadSize, false);
+		Reader->Serialize(Block.GetData() + NumCarried, ReadSize);
+		Remaining -= ReadSize;
+
+		const ANSICHAR* Start = Block.GetData();
+		if (Remaining + ReadSize == TotalSize)
+		{
+			const uint8* FirstBlock = (const uint8*)Block.GetData();
+			if (HasUTF16BOM(FirstBlock, TotalSize))
+			{
+				// Rare enough to read the rest of the file in one go
+				Block.SetNumUninitialized(TotalSize, false);
+				Reader->Serialize(Block.GetData() + ReadSize, Remaining);
+				VisitUTF16Lines((const uint8*)Block.GetData(), TotalSize, Visitor);
+				break;
+			}
+			Start += GetUTF8BOMSize(FirstBlock, ReadSize);
+		}
+
+		const ANSICHAR* End = Block.GetData() + Block.Num();
+		const ANSICHAR* Rest = VisitUTF8Lines(Start, End, Remaining == 0, Visitor);
+		NumCarried = UE_PTRDIFF_TO_INT32(End - Rest);
+		if (NumCarried)
+		{
+			FMemory::Memmove(Block.GetData(), Rest, NumCarried);
+		}
+	}
+
+	return Reader->Close();
+}
+
 /**
  * Converts an arbitrary text buffer to an FString.
  * Supports all combination of ANSI/Unicode files and platforms.
@@ -225,6 +426,11 @@ bool FFileHelper::LoadFileToStringArray( TArray<FString>& Result, const TCHAR* F
 {
 	Result.Empty();
 
+	if (VerifyFlags == EHashOptions::None)
+	{
+		return UE4FileHelper_Private::LoadFileToStringArrayByLine(Result, Filename, [](const FString&) { return true; });
+	}
+
 	FString Buffer;
 	if(!LoadFileToString(Buffer, Filename, VerifyFlags))
 	{
@@ -258,6 +464,11 @@ bool FFileHelper::LoadFileToStringArrayWithPredicate(TArray<FString>& Result, co
 {
 	Result.Empty();
 
+	if (VerifyFlags == EHashOptions::None)
+	{
+		return UE4FileHelper_Private::LoadFileToStringArrayByLine(Result, Filename, Predicate);
+	}
+
 	FString Buffer;
 	if (!LoadFileToString(Buffer, Filename, VerifyFlags))
 	{
@@ -2,8 +2,219 @@
 
 #include "Misc/Guid.h"
 #include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
 #include "UObject/PropertyPortFlags.h"
 #include "Misc/Base64.h"
+#include "String/BytesToHex.h"
+#include "String/HexToBytes.h"
+#include "String/VectorizedAscii.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+	#include <pthread.h>
+#endif
+
+
+namespace UE4Guid_Private
+{
+	/** The characters of a format, '#' standing for a digit and anything else for itself */
+	struct FLayout
+	{
+		const TCHAR* Chars;
+		int32 Len;
+	};
+
+	/** Layout of any format but Short */
+	static FLayout GetLayout(EGuidFormats Format)
+	{
+		switch (Format)
+		{
+		case EGuidFormats::DigitsWithHyphens:
+			return { TEXT("########-####-####-####-############"), 36 };
+
+		case EGuidFormats::DigitsWithHyphensInBraces:
+			return { TEXT("{########-####-####-####-############}"), 38 };
+
+		case EGuidFormats::DigitsWithHyphensInParentheses:
+			return { TEXT("(########-####-####-####-############)"), 38 };
+
+		case EGuidFormats::HexValuesInBraces:
+			return { TEXT("{0x########,0x####,0x####,{0x##,0x##,0x##,0x##,0x##,0x##,0x##,0x##}}"), 68 };
+
+		case EGuidFormats::UniqueObjectGuid:
+			return { TEXT("########-########-########-########"), 35 };
+
+		default:
+			return { TEXT("################################"), 32 };
+		}
+	}
+
+	/** Longest format, HexValuesInBraces */
+	static const int32 MaxLen = 68;
+
+	/** Writes the string of a GUID to Out, which must have room for MaxLen characters, and returns its length */
+	static int32 Format(const FGuid& Guid, EGuidFormats Format, TCHAR* Out)
+	{
+		if (Format == EGuidFormats::Short)
+		{
+			// Base64 of the components as they are in memory, url safe and without the padding
+			const uint32 Data[] = { Guid.A, Guid.B, Guid.C, Guid.D };
+			TCHAR Encoded[FBase64::GetEncodedDataSize(sizeof(Data)) + 1];
+			FBase64::Encode(reinterpret_cast<const uint8*>(&Data), sizeof(Data), Encoded);
+			for (int32 Index = 0; Index < 22; ++Index)
+			{
+				const TCHAR Char = Encoded[Index];
+				Out[Index] = Char == TEXT('+') ? TEXT('-') : Char == TEXT('/') ? TEXT('_') : Char;
+			}
+			return 22;
+		}
+
+		uint8 Bytes[16];
+		const uint32 Components[] = { Guid.A, Guid.B, Guid.C, Guid.D };
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			Bytes[Index] = uint8(Components[Index / 4] >> (24 - 8 * (Index % 4)));
+		}
+
+		const FLayout Layout = GetLayout(Format);
+		if (Format == EGuidFormats::Digits)
+		{
+			UE::String::BytesToHex(Bytes, Out);
+			return Layout.Len;
+		}
+
+		TCHAR Digits[32];
+		UE::String::BytesToHex(Bytes, Digits);
+		for (int32 Index = 0, DigitIndex = 0; Index < Layout.Len; ++Index)
+		{
+			Out[Index] = Layout.Chars[Index] == TEXT('#') ? Digits[DigitIndex++] : Layout.Chars[Index];
+		}
+		return Layout.Len;
+	}
+
+	/** Converts 32 hex digits of either case, A's first, fails on anything else */
+	static bool DigitsToGuid(const TCHAR* Digits, FGuid& OutGuid)
+	{
+#if UE_VECTORIZED_ASCII
+		using namespace UE4VectorizedAscii_Private;
+		const FByteVector First = LoadChars(Digits);
+		const FByteVector Second = LoadChars(Digits + 16);
+#if UE_VECTORIZED_ASCII_SSE2
+		auto IsHex = [](__m128i Chars) { return _mm_or_si128(_mm_or_si128(InRange(Chars, '0', '9'), InRange(Chars, 'A', 'F')), InRange(Chars, 'a', 'f')); };
+		if (!AllSet(_mm_and_si128(IsHex(First), IsHex(Second))))
+#else
+		auto IsHex = [](uint8x16_t Chars) { return vorrq_u8(vorrq_u8(InRange(Chars, '0', '9'), InRange(Chars, 'A', 'F')), InRange(Chars, 'a', 'f')); };
+		if (!AllSet(vandq_u8(IsHex(First), IsHex(Second))))
+#endif
+		{
+			return false;
+		}
+#else
+		for (int32 Index = 0; Index < 32; ++Index)
+		{
+			if (!FChar::IsHexDigit(Digits[Index]))
+			{
+				return false;
+			}
+		}
+#endif
+
+		uint8 Bytes[16];
+		UE::String::HexToBytes(FStringView(Digits, 32), Bytes);
+
+		uint32 Components[4];
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const uint8* Component = Bytes + Index * 4;
+			Components[Index] = (uint32(Component[0]) << 24) | (uint32(Component[1]) << 16) | (uint32(Component[2]) << 8) | uint32(Component[3]);
+		}
+
+		OutGuid = FGuid(Components[0], Components[1], Components[2], Components[3]);
+		return true;
+	}
+
+	/** Number of GUIDs a thread makes with a key before it draws a new one */
+	static const uint32 GuidsPerKey = 1 << 20;
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+	/** Moves on in forked children, so that they don't make the GUIDs their parent makes from the same keys */
+	static volatile int32 GForkEpoch = 0;
+#endif
+
+	/**
+	 * ChaCha20 keystream of a thread, keyed with platform GUIDs, of which each block makes four GUIDs.
+	 * Zero initialized, so that a thread draws its key on its first GUID.
+	 */
+	struct FGuidGenerator
+	{
+		uint32 Key[8];
+		uint32 Nonce[3];
+		uint32 Counter;
+		uint32 Block[16];
+		uint32 NextGuid;
+		uint32 NumGuidsLeft;
+		int32 ForkEpoch;
+	};
+
+	static thread_local FGuidGenerator GGuidGenerator;
+
+	static FORCEINLINE void QuarterRound(uint32& A, uint32& B, uint32& C, uint32& D)
+	{
+		A += B; D ^= A; D = (D << 16) | (D >> 16);
+		C += D; B ^= C; B = (B << 12) | (B >> 20);
+		A += B; D ^= A; D = (D << 8) | (D >> 24);
+		C += D; B ^= C; B = (B << 7) | (B >> 25);
+	}
+
+	static void NextBlock(FGuidGenerator& Generator)
+	{
+		uint32 State[16] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+		FMemory::Memcpy(State + 4, Generator.Key, sizeof(Generator.Key));
+		State[12] = Generator.Counter++;
+		FMemory::Memcpy(State + 13, Generator.Nonce, sizeof(Generator.Nonce));
+
+		uint32* X = Generator.Block;
+		FMemory::Memcpy(X, State, sizeof(State));
+		for (int32 Round = 0; Round < 10; ++Round)
+		{
+			QuarterRound(X[0], X[4], X[8], X[12]);
+			QuarterRound(X[1], X[5], X[9], X[13]);
+			QuarterRound(X[2], X[6], X[10], X[14]);
+			QuarterRound(X[3], X[7], X[11], X[15]);
+			QuarterRound(X[0], X[5], X[10], X[15]);
+			QuarterRound(X[1], X[6], X[11], X[12]);
+			QuarterRound(X[2], X[7], X[8], X[13]);
+			QuarterRound(X[3], X[4], X[9], X[14]);
+		}
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			X[Index] += State[Index];
+		}
+		Generator.NextGuid = 0;
+	}
+
+	static FORCENOINLINE void DrawKey(FGuidGenerator& Generator)
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		static const bool bForkHandlerRegistered = pthread_atfork(nullptr, nullptr, []() { ++GForkEpoch; }) == 0;
+		(void)bForkHandlerRegistered;
+		Generator.ForkEpoch = GForkEpoch;
+#endif
+
+		// The platform GUIDs come from the OS random number generator where there is one, six of their bits are fixed
+		FGuid Seeds[3];
+		for (FGuid& Seed : Seeds)
+		{
+			FPlatformMisc::CreateGuid(Seed);
+		}
+		FMemory::Memcpy(Generator.Key, Seeds, sizeof(Generator.Key));
+		Generator.Nonce[0] = Seeds[2].A;
+		Generator.Nonce[1] = Seeds[2].B;
+		Generator.Nonce[2] = Seeds[2].C ^ Seeds[2].D;
+		Generator.Counter = 0;
+		Generator.NumGuidsLeft = GuidsPerKey;
+		NextBlock(Generator);
+	}
+}
 
 
 /* FGuid interface
@@ -29,7 +240,7 @@ bool FGuid::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, class UObject*
 		return false;
 	}
 
-	if (!ParseExact(FString(Buffer).Left(32), EGuidFormats::Digits, *this))
+	if (!ParseExact(FStringView(Buffer, 32), EGuidFormats::Digits, *this))
 	{
 		return false;
 	}
@@ -42,41 +253,17 @@ bool FGuid::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, class UObject*
 
 FString FGuid::ToString(EGuidFormats Format) const
 {
-	switch (Format)
-	{
-	case EGuidFormats::DigitsWithHyphens:
-		return FString::Printf(TEXT("%08X-%04X-%04X-%04X-%04X%08X"), A, B >> 16, B & 0xFFFF, C >> 16, C & 0xFFFF, D);
-
-	case EGuidFormats::DigitsWithHyphensInBraces:
-		return FString::Printf(TEXT("{%08X-%04X-%04X-%04X-%04X%08X}"), A, B >> 16, B & 0xFFFF, C >> 16, C & 0xFFFF, D);
-
-	case EGuidFormats::DigitsWithHyphensInParentheses:
-		return FString::Printf(TEXT("(%08X-%04X-%04X-%04X-%04X%08X)"), A, B >> 16, B & 0xFFFF, C >> 16, C & 0xFFFF, D);
-
-	case EGuidFormats::HexValuesInBraces:
-		return FString::Printf(TEXT("{0x%08X,0x%04X,0x%04X,{0x%02X,0x%02X,0x%02X,0x%02X,0x%02X,0x%02X,0x%02X,0x%02X}}"), A, B >> 16, B & 0xFFFF, C >> 24, (C >> 16) & 0xFF, (C >> 8) & 0xFF, C & 0XFF, D >> 24, (D >> 16) & 0XFF, (D >> 8) & 0XFF, D & 0XFF);
-
-	case EGuidFormats::UniqueObjectGuid:
-		return FString::Printf(TEXT("%08X-%08X-%08X-%08X"), A, B, C, D);
-
-	case EGuidFormats::Short:
-	{
-		const uint32 Data[] = {A,B,C,D};
-		FString Result = FBase64::Encode(reinterpret_cast<const uint8*>(&Data), sizeof(Data));
-
-		Result.ReplaceCharInline(TEXT('+'), TEXT('-'), ESearchCase::CaseSensitive);
-		Result.ReplaceCharInline(TEXT('/'), TEXT('_'), ESearchCase::CaseSensitive);
+	TCHAR Chars[UE4Guid_Private::MaxLen];
+	const int32 Len = UE4Guid_Private::Format(*this, Format, Chars);
+	return FString(Len, Chars);
+}
 
-		// Remove trailing '=' base64 padding
-		check(Result.Len() == 24);
-		Result.RemoveAt(22, 2, false);
 
-		return Result;
-	}
-
-	default:
-		return FString::Printf(TEXT("%08X%08X%08X%08X"), A, B, C, D);
-	}
+void FGuid::AppendString(FStringBuilderBase& Builder, EGuidFormats Format) const
+{
+	TCHAR Chars[UE4Guid_Private::MaxLen];
+	const int32 Len = UE4Guid_Private::Format(*this, Format, Chars);
+	Builder.Append(Chars, Len);
 }
 
 
@@ -85,75 +272,89 @@ FString FGuid::ToString(EGuidFormats Format) const
 
 FGuid FGuid::NewGuid()
 {
-	FGuid Result(0, 0, 0, 0);
-	FPlatformMisc::CreateGuid(Result);
+	using namespace UE4Guid_Private;
+
+	FGuidGenerator& Generator = GGuidGenerator;
+#if PLATFORM_UNIX || PLATFORM_MAC
+	const bool bForked = Generator.ForkEpoch != GForkEpoch;
+#else
+	const bool bForked = false;
+#endif
+	if (Generator.NumGuidsLeft == 0 || bForked)
+	{
+		DrawKey(Generator);
+	}
+	else if (Generator.NextGuid == 4)
+	{
+		NextBlock(Generator);
+	}
+	--Generator.NumGuidsLeft;
 
+	// https://tools.ietf.org/html/rfc4122#section-4.4, same bits as FUnixPlatformMisc::CreateGuid
+	uint32* Words = Generator.Block + 4 * Generator.NextGuid++;
+	FGuid Result(Words[0], (Words[1] & 0xffff0fff) | 0x00004000, (Words[2] & 0x3fffffff) | 0x80000000, Words[3]);
+
+	// Used words are cleared so that a dump of the thread's memory doesn't hold GUIDs it made
+	FMemory::Memzero(Words, 4 * sizeof(uint32));
 	return Result;
 }
 
 
-bool FGuid::Parse(const FString& GuidString, FGuid& OutGuid)
+bool FGuid::Parse(const FStringView& GuidString, FGuid& OutGuid)
 {
-	if (GuidString.Len() == 32)
+	switch (GuidString.Len())
 	{
+	case 32:
 		return ParseExact(GuidString, EGuidFormats::Digits, OutGuid);
-	}
 
-	if (GuidString.Len() == 36)
-	{
+	case 36:
 		return ParseExact(GuidString, EGuidFormats::DigitsWithHyphens, OutGuid);
-	}
 
-	if (GuidString.Len() == 38)
-	{
-		if (GuidString.StartsWith("{"))
-		{
-			return ParseExact(GuidString, EGuidFormats::DigitsWithHyphensInBraces, OutGuid);
-		}
-
-		return ParseExact(GuidString, EGuidFormats::DigitsWithHyphensInParentheses, OutGuid);
-	}
+	case 38:
+		return ParseExact(GuidString, GuidString[0] == TEXT('{') ? EGuidFormats::DigitsWithHyphensInBraces : EGuidFormats::DigitsWithHyphensInParentheses, OutGuid);
 
-	if (GuidString.Len() == 68)
-	{
+	case 68:
 		return ParseExact(GuidString, EGuidFormats::HexValuesInBraces, OutGuid);
-	}
 
-	if (GuidString.Len() == 35)
-	{
+	case 35:
 		return ParseExact(GuidString, EGuidFormats::UniqueObjectGuid, OutGuid);
-	}
 
-	if (GuidString.Len() == 22)
-	{
+	case 22:
 		return ParseExact(GuidString, EGuidFormats::Short, OutGuid);
-	}
 
-	return false;
+	default:
+		return false;
+	}
 }
 
 
-bool FGuid::ParseExact(const FString& GuidString, EGuidFormats Format, FGuid& OutGuid)
+bool FGuid::ParseExact(const FStringView& GuidString, EGuidFormats Format, FGuid& OutGuid)
 {
-	// The below normalizing into the Digits format doesn't work with Short Guids
+	using namespace UE4Guid_Private;
+
+	const TCHAR* Chars = GuidString.GetData();
+	const int32 Len = GuidString.Len();
+
 	if (Format == EGuidFormats::Short)
 	{
 		uint32 Data[4] = {};
 
-		// We don't need to do replacements to get an accurate size (defering allocations till later)
-		if (FBase64::GetDecodedDataSize(GuidString) != sizeof(Data))
+		// This isn't a Short GUID if it's not 128 bits / 16 bytes (the size of Data)
+		if (Len > int32(FBase64::GetEncodedDataSize(sizeof(Data))) || FBase64::GetDecodedDataSize(Chars, Len) != sizeof(Data))
 		{
-			// This isn't a Short GUID if it's not 128 bits / 16 bytes (the size of Data)
 			return false;
 		}
 
 		// Replace the characters we replaced going out (but not the padding, UE4 discards it immediately)
-		FString GuidCopy = GuidString;
-		GuidCopy.ReplaceCharInline(TEXT('-'), TEXT('+'), ESearchCase::CaseSensitive);
-		GuidCopy.ReplaceCharInline(TEXT('_'), TEXT('/'), ESearchCase::CaseSensitive);
+		TCHAR Base64[FBase64::GetEncodedDataSize(sizeof(Data))];
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			const TCHAR Char = Chars[Index];
+			Base64[Index] = Char == TEXT('-') ? TEXT('+') : Char == TEXT('_') ? TEXT('/') : Char;
+		}
 
 		// Decode the data
-		if (!FBase64::Decode(*GuidCopy, GuidCopy.Len(), reinterpret_cast<uint8*>(&Data)))
+		if (!FBase64::Decode(Base64, Len, reinterpret_cast<uint8*>(&Data)))
 		{
 			// Data is not valid in some way
 			return false;
@@ -166,151 +367,33 @@ bool FGuid::ParseExact(const FString& GuidString, EGuidFormats Format, FGuid& Ou
 		return true;
 	}
 
-	FString NormalizedGuidString;
-
-	NormalizedGuidString.Empty(32);
-
-	if (Format == EGuidFormats::Digits)
+	const FLayout Layout = GetLayout(Format);
+	if (Len != Layout.Len)
 	{
-		NormalizedGuidString = GuidString;
+		return false;
 	}
-	else if (Format == EGuidFormats::DigitsWithHyphens)
-	{
-		if ((GuidString[8] != TCHAR('-')) ||
-			(GuidString[13] != TCHAR('-')) ||
-			(GuidString[18] != TCHAR('-')) ||
-			(GuidString[23] != TCHAR('-')))
-		{
-			return false;
-		}
 
-		NormalizedGuidString += GuidString.Mid(0, 8);
-		NormalizedGuidString += GuidString.Mid(9, 4);
-		NormalizedGuidString += GuidString.Mid(14, 4);
-		NormalizedGuidString += GuidString.Mid(19, 4);
-		NormalizedGuidString += GuidString.Mid(24, 12);
-	}
-	else if (Format == EGuidFormats::DigitsWithHyphensInBraces)
+	if (Format == EGuidFormats::Digits)
 	{
-		if ((GuidString[0] != TCHAR('{')) ||
-			(GuidString[9] != TCHAR('-')) ||
-			(GuidString[14] != TCHAR('-')) ||
-			(GuidString[19] != TCHAR('-')) ||
-			(GuidString[24] != TCHAR('-')) ||
-			(GuidString[37] != TCHAR('}')))
-		{
-			return false;
-		}
-
-		NormalizedGuidString += GuidString.Mid(1, 8);
-		NormalizedGuidString += GuidString.Mid(10, 4);
-		NormalizedGuidString += GuidString.Mid(15, 4);
-		NormalizedGuidString += GuidString.Mid(20, 4);
-		NormalizedGuidString += GuidString.Mid(25, 12);
+		return DigitsToGuid(Chars, OutGuid);
 	}
-	else if (Format == EGuidFormats::DigitsWithHyphensInParentheses)
-	{
-		if ((GuidString[0] != TCHAR('(')) ||
-			(GuidString[9] != TCHAR('-')) ||
-			(GuidString[14] != TCHAR('-')) ||
-			(GuidString[19] != TCHAR('-')) ||
-			(GuidString[24] != TCHAR('-')) ||
-			(GuidString[37] != TCHAR(')')))
-		{
-			return false;
-		}
-
-		NormalizedGuidString += GuidString.Mid(1, 8);
-		NormalizedGuidString += GuidString.Mid(10, 4);
-		NormalizedGuidString += GuidString.Mid(15, 4);
-		NormalizedGuidString += GuidString.Mid(20, 4);
-		NormalizedGuidString += GuidString.Mid(25, 12);
-	}
-	else if (Format == EGuidFormats::HexValuesInBraces)
-	{
-		if ((GuidString[0] != TCHAR('{')) ||
-			(GuidString[1] != TCHAR('0')) ||
-			(GuidString[2] != TCHAR('x')) ||
-			(GuidString[11] != TCHAR(',')) ||
-			(GuidString[12] != TCHAR('0')) ||
-			(GuidString[13] != TCHAR('x')) ||
-			(GuidString[18] != TCHAR(',')) ||
-			(GuidString[19] != TCHAR('0')) ||
-			(GuidString[20] != TCHAR('x')) ||
-			(GuidString[25] != TCHAR(',')) ||
-			(GuidString[26] != TCHAR('{')) ||
-			(GuidString[27] != TCHAR('0')) ||
-			(GuidString[28] != TCHAR('x')) ||
-			(GuidString[31] != TCHAR(',')) ||
-			(GuidString[32] != TCHAR('0')) ||
-			(GuidString[33] != TCHAR('x')) ||
-			(GuidString[36] != TCHAR(',')) ||
-			(GuidString[37] != TCHAR('0')) ||
-			(GuidString[38] != TCHAR('x')) ||
-			(GuidString[41] != TCHAR(',')) ||
-			(GuidString[42] != TCHAR('0')) ||
-			(GuidString[43] != TCHAR('x')) ||
-			(GuidString[46] != TCHAR(',')) ||
-			(GuidString[47] != TCHAR('0')) ||
-			(GuidString[48] != TCHAR('x')) ||
-			(GuidString[51] != TCHAR(',')) ||
-			(GuidString[52] != TCHAR('0')) ||
-			(GuidString[53] != TCHAR('x')) ||
-			(GuidString[56] != TCHAR(',')) ||
-			(GuidString[57] != TCHAR('0')) ||
-			(GuidString[58] != TCHAR('x')) ||
-			(GuidString[61] != TCHAR(',')) ||
-			(GuidString[62] != TCHAR('0')) ||
-			(GuidString[63] != TCHAR('x')) ||
-			(GuidString[66] != TCHAR('}')) ||
-			(GuidString[67] != TCHAR('}')))
-		{
-			return false;
-		}
 
-		NormalizedGuidString += GuidString.Mid(3, 8);
-		NormalizedGuidString += GuidString.Mid(14, 4);
-		NormalizedGuidString += GuidString.Mid(21, 4);
-		NormalizedGuidString += GuidString.Mid(29, 2);
-		NormalizedGuidString += GuidString.Mid(34, 2);
-		NormalizedGuidString += GuidString.Mid(39, 2);
-		NormalizedGuidString += GuidString.Mid(44, 2);
-		NormalizedGuidString += GuidString.Mid(49, 2);
-		NormalizedGuidString += GuidString.Mid(54, 2);
-		NormalizedGuidString += GuidString.Mid(59, 2);
-		NormalizedGuidString += GuidString.Mid(64, 2);
-	}
-	else if (Format == EGuidFormats::UniqueObjectGuid)
+	// Gather the digits, checking the other characters on the way
+	TCHAR Digits[32];
+	int32 NumDigits = 0;
+	for (int32 Index = 0; Index < Len; ++Index)
 	{
-		if ((GuidString[8] != TCHAR('-')) ||
-			(GuidString[17] != TCHAR('-')) ||
-			(GuidString[26] != TCHAR('-')))
+		if (Layout.Chars[Index] == TEXT('#'))
 		{
-			return false;
+			Digits[NumDigits++] = Chars[Index];
 		}
-
-		NormalizedGuidString += GuidString.Mid(0, 8);
-		NormalizedGuidString += GuidString.Mid(9, 8);
-		NormalizedGuidString += GuidString.Mid(18, 8);
-		NormalizedGuidString += GuidString.Mid(27, 8);
-	}
-
-	for (int32 Index = 0; Index < NormalizedGuidString.Len(); ++Index)
-	{
-		if (!FChar::IsHexDigit(NormalizedGuidString[Index]))
+		else if (Chars[Index] != Layout.Chars[Index])
 		{
 			return false;
 		}
 	}
 
-	OutGuid = FGuid(
-		FParse::HexNumber(*NormalizedGuidString.Mid(0, 8)),
-		FParse::HexNumber(*NormalizedGuidString.Mid(8, 8)),
-		FParse::HexNumber(*NormalizedGuidString.Mid(16, 8)),
-		FParse::HexNumber(*NormalizedGuidString.Mid(24, 8))
-	);
-
-	return true;
+	return DigitsToGuid(Digits, OutGuid);
 }
 
 FArchive& operator<<(FArchive& Ar, FGuid& G)
@@ -219,12 +219,19 @@ uint32 FInteractiveProcess::Run()
 	// control and interact with the process
 	StartTime = FDateTime::UtcNow();
 	{
+		bool bHadOutput = false;
 		do
 		{
-			FPlatformProcess::Sleep(SleepTime);
+			// Keep reading without sleeping while the process produces output
+			if (!bHadOutput)
+			{
+				FPlatformProcess::Sleep(SleepTime);
+			}
 
 			// Read pipe and redirect it to ProcessOutput function
-			ProcessOutput(FPlatformProcess::ReadPipe(ReadPipeParent));
+			const FString Output = FPlatformProcess::ReadPipe(ReadPipeParent);
+			bHadOutput = !Output.IsEmpty();
+			ProcessOutput(Output);
 
 			// Write to process if there is a message
 			SendMessageToProcessIf();
@@ -47,41 +47,86 @@ bool FLocalTimestampDirectoryVisitor::Visit(const TCHAR* FilenameOrDirectory, bo
 		FileTimes.Add(RelativeFilename, 0);
 	}
 
-	// iterate over directories we care about
-	if (bIsDirectory)
+	// recurse into the directories we care about
+	if (bIsDirectory && ShouldRecurse(RelativeFilename))
 	{
-		bool bShouldRecurse = true;
-		// look in all the ignore directories looking for a match
-		for (int32 DirIndex = 0; DirIndex < DirectoriesToIgnore.Num() && bShouldRecurse; DirIndex++)
-		{
-			if (RelativeFilename.StartsWith(DirectoriesToIgnore[DirIndex]))
-			{
-				bShouldRecurse = false;
-			}
-		}
+		FileInterface.IterateDirectory(FilenameOrDirectory, *this);
+	}
+
+	return true;
+}
+
 
-		if (bShouldRecurse == true)
+void FLocalTimestampDirectoryVisitor::VisitParallel(const TCHAR* Directory, const FDateTime& ChangedSince)
+{
+	class FBatchVisitor
+		: public IPlatformFile::FDirectoryStatBatchVisitor
+	{
+	public:
+
+		FBatchVisitor(FLocalTimestampDirectoryVisitor& InOwner)
+			: Owner(InOwner)
+		{ }
+
+		virtual bool Visit(const TArray<FString>& FilenamesOrDirectories, const TArray<FFileStatData>& StatData) override
 		{
-			// If it is a directory that we should not recurse (ie we don't want to process subdirectories of it)
-			// handle that case as well...
-			for (int32 DirIndex = 0; DirIndex < DirectoriesToNotRecurse.Num() && bShouldRecurse; DirIndex++)
+			for (int32 Index = 0; Index < FilenamesOrDirectories.Num(); Index++)
 			{
-				if (RelativeFilename.StartsWith(DirectoriesToNotRecurse[DirIndex]))
+				FString RelativeFilename = FilenamesOrDirectories[Index];
+				FPaths::MakeStandardFilename(RelativeFilename);
+
+				if (!StatData[Index].bIsDirectory)
+				{
+					Owner.FileTimes.Add(MoveTemp(RelativeFilename), StatData[Index].ModificationTime);
+				}
+				else if (Owner.bCacheDirectories)
 				{
-					// Are we more than level deep in that directory?
-					FString CheckFilename = RelativeFilename.Right(RelativeFilename.Len() - DirectoriesToNotRecurse[DirIndex].Len());
-					if (CheckFilename.Len() > 1)
-					{
-						bShouldRecurse = false;
-					}
+					Owner.FileTimes.Add(MoveTemp(RelativeFilename), 0);
 				}
 			}
+			return true;
 		}
 
-		// recurse if we should
-		if (bShouldRecurse)
+		virtual bool ShouldRecurse(const TCHAR* InDirectory) const override
 		{
-			FileInterface.IterateDirectory(FilenameOrDirectory, *this);
+			FString RelativeDirectory = InDirectory;
+			FPaths::MakeStandardFilename(RelativeDirectory);
+			return Owner.ShouldRecurse(RelativeDirectory);
+		}
+
+	private:
+
+		FLocalTimestampDirectoryVisitor& Owner;
+	};
+
+	FBatchVisitor BatchVisitor(*this);
+	FileInterface.IterateDirectoryStatRecursivelyParallel(Directory, BatchVisitor, ChangedSince);
+}
+
+
+bool FLocalTimestampDirectoryVisitor::ShouldRecurse(const FString& RelativeDirectory) const
+{
+	// look in all the ignore directories looking for a match
+	for (int32 DirIndex = 0; DirIndex < DirectoriesToIgnore.Num(); DirIndex++)
+	{
+		if (RelativeDirectory.StartsWith(DirectoriesToIgnore[DirIndex]))
+		{
+			return false;
+		}
+	}
+
+	// If it is a directory that we should not recurse (ie we don't want to process subdirectories of it)
+	// handle that case as well...
+	for (int32 DirIndex = 0; DirIndex < DirectoriesToNotRecurse.Num(); DirIndex++)
+	{
+		if (RelativeDirectory.StartsWith(DirectoriesToNotRecurse[DirIndex]))
+		{
+			// Are we more than level deep in that directory?
+			FString CheckFilename = RelativeDirectory.Right(RelativeDirectory.Len() - DirectoriesToNotRecurse[DirIndex].Len());
+			if (CheckFilename.Len() > 1)
+			{
+				return false;
+			}
 		}
 	}
 
@@ -2,7 +2,107 @@
 
 #include "Misc/MonitoredProcess.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Atomic.h"
+
+/* FMonitoredProcessSharedThread
+ *****************************************************************************/
+
+/**
+ * Monitors any number of processes from one thread, for tools that run many child processes at once.
+ *
+ * The pipes of the processes can't be waited on portably, so the thread checks all of them again right away
+ * while any of them produces output, and waits longer and longer up to a limit while none do.
+ */
+class FMonitoredProcessSharedThread
+	: public FRunnable
+{
+public:
+
+	static FMonitoredProcessSharedThread& Get()
+	{
+		// Never destroyed, processes may still be monitored while the process exits
+		static FMonitoredProcessSharedThread* Singleton = new FMonitoredProcessSharedThread;
+		return *Singleton;
+	}
+
+	void Add( FMonitoredProcess* Process )
+	{
+		{
+			FScopeLock Lock(&ProcessesCritical);
+			Processes.Add(Process);
+		}
+		WakeEvent->Trigger();
+	}
+
+	/** Returns once the thread no longer monitors the process */
+	void Remove( FMonitoredProcess* Process )
+	{
+		FScopeLock Lock(&ProcessesCritical);
+		Processes.RemoveSingleSwap(Process);
+	}
+
+	// FRunnable interface
+
+	virtual uint32 Run() override
+	{
+		uint32 WaitTimeMs = 0;
+		while (!bStopping)
+		{
+			bool bHadOutput = false;
+			{
+				FScopeLock Lock(&ProcessesCritical);
+				for (int32 Index = Processes.Num() - 1; Index >= 0; --Index)
+				{
+					FMonitoredProcess* Process = Processes[Index];
+					bHadOutput |= Process->TickInternal();
+
+					// The delegates may have removed processes
+					Index = FMath::Min(Index, Processes.Num());
+					if (!Process->bIsRunning)
+					{
+						Processes.RemoveSingleSwap(Process);
+					}
+				}
+			}
+
+			WaitTimeMs = bHadOutput ? 0 : FMath::Clamp(WaitTimeMs * 2, MinWaitTimeMs, MaxWaitTimeMs);
+			if (WaitTimeMs)
+			{
+				WakeEvent->Wait(WaitTimeMs);
+			}
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+		WakeEvent->Trigger();
+	}
+
+private:
+
+	FMonitoredProcessSharedThread()
+		: WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		, bStopping(false)
+	{
+		Thread = FRunnableThread::Create(this, TEXT("FMonitoredProcessSharedThread"), 128 * 1024, TPri_AboveNormal);
+	}
+
+	static const uint32 MinWaitTimeMs = 1;
+	static const uint32 MaxWaitTimeMs = 16;
+
+	FCriticalSection ProcessesCritical;
+	TArray<FMonitoredProcess*> Processes;
+	FEvent* WakeEvent;
+	FRunnableThread* Thread;
+	TAtomic<bool> bStopping;
+};
 
 /* FMonitoredProcess structors
  *****************************************************************************/
@@ -27,6 +127,7 @@ FMonitoredProcess::FMonitoredProcess( const FString& InURL, const FString& InPar
 	, WritePipe(nullptr)
 	, bCreatePipes(InCreatePipes)
 	, SleepInterval(0.0f)
+	, bUseSharedThread(false)
 { }
 
  
@@ -37,6 +138,17 @@ FMonitoredProcess::~FMonitoredProcess()
 		Cancel(true);
 	}
 
+	if (bUseSharedThread && Thread == nullptr)
+	{
+		FMonitoredProcessSharedThread::Get().Remove(this);
+
+		// Cancel the process the way the shared thread would have
+		if (bIsRunning)
+		{
+			TickInternal();
+		}
+	}
+
 	if (Thread != nullptr) 
 	{
 		Thread->WaitForCompletion();
@@ -85,6 +197,13 @@ bool FMonitoredProcess::Launch()
 	MonitoredProcessIndex++;
 
 	bIsRunning = true;
+	if (bUseSharedThread && FPlatformProcess::SupportsMultithreading())
+	{
+		StartTime = FDateTime::UtcNow();
+		FMonitoredProcessSharedThread::Get().Add(this);
+		return true;
+	}
+
 	Thread = FRunnableThread::Create(this, *MonitoredProcessName, 128 * 1024, TPri_AboveNormal);
 	if ( !FPlatformProcess::SupportsMultithreading() )
 	{
@@ -124,10 +243,11 @@ void FMonitoredProcess::ProcessOutput( const FString& Output )
 	OutputBuffer.MidInline(LineStartIdx, MAX_int32, false);
 }
 
-void FMonitoredProcess::TickInternal()
+bool FMonitoredProcess::TickInternal()
 {
 	// monitor the process
-	ProcessOutput(FPlatformProcess::ReadPipe(ReadPipe));
+	const FString Output = FPlatformProcess::ReadPipe(ReadPipe);
+	ProcessOutput(Output);
 
 	if (Canceling)
 	{
@@ -152,6 +272,8 @@ void FMonitoredProcess::TickInternal()
 		CompletedDelegate.ExecuteIfBound(ReturnCode);
 		bIsRunning = false;
 	}
+
+	return !Output.IsEmpty();
 }
 
 
@@ -172,10 +294,15 @@ bool FMonitoredProcess::Update()
 uint32 FMonitoredProcess::Run()
 {
 	StartTime = FDateTime::UtcNow();
+	bool bHadOutput = false;
 	while (bIsRunning)
 	{
-		FPlatformProcess::Sleep(SleepInterval);
-		TickInternal();
+		// Keep reading without sleeping while the process produces output
+		if (!bHadOutput)
+		{
+			FPlatformProcess::Sleep(SleepInterval);
+		}
+		bHadOutput = TickInternal();
 	} 
 
 	return 0;
@@ -3,6 +3,7 @@
 #include "Misc/OutputDevice.h"
 #include "Containers/UnrealString.h"
 #include "Logging/LogMacros.h"
+#include "Logging/DeferredLogMessage.h"
 #include "Internationalization/Text.h"
 #include "Logging/LogScopedCategoryAndVerbosityOverride.h"
 #include "Misc/OutputDeviceHelper.h"
@@ -10,6 +11,18 @@
 
 DEFINE_LOG_CATEGORY(LogOutputDevice);
 
+void FOutputDevice::SerializeDeferred(const FDeferredLogMessage& Message)
+{
+	if (Message.GetTime() < 0.0)
+	{
+		Serialize(Message.GetText(), Message.GetVerbosity(), Message.GetCategory());
+	}
+	else
+	{
+		Serialize(Message.GetText(), Message.GetVerbosity(), Message.GetCategory(), Message.GetTime());
+	}
+}
+
 void FOutputDevice::Log( ELogVerbosity::Type Verbosity, const TCHAR* Str )
 {
 	Serialize( Str, Verbosity, NAME_None );
@@ -26,6 +26,7 @@
 #include "Math/Color.h"
 #include "Templates/Atomic.h"
 #include "HAL/ConsoleManager.h"
+#include "Compression/lz4.h"
 
 /** Used by tools which include only core to disable log file creation. */
 #ifndef ALLOW_LOG_FILE
@@ -70,6 +71,12 @@ void FAsyncWriter::FlushArchiveAndResetTimer()
 	LastArchiveFlushTime = FPlatformTime::Seconds();
 }
 
+/** [WRITER THREAD] Time between two periodic flushes of the archive */
+double FAsyncWriter::GetArchiveFlushIntervalSec() const
+{
+	return FMath::Max(GetLogFlushIntervalSec(), MinArchiveFlushIntervalSec);
+}
+
 /** [WRITER THREAD] Serialize the contents of the ring buffer to disk */
 void FAsyncWriter::SerializeBufferToArchive()
 {
@@ -108,7 +115,7 @@ void FAsyncWriter::SerializeBufferToArchive()
 		// Flush the archive periodically if running on a separate thread
 		if (Thread)
 		{
-			if ((FPlatformTime::Seconds() - LastArchiveFlushTime) > GetLogFlushIntervalSec() )
+			if ((FPlatformTime::Seconds() - LastArchiveFlushTime) > GetArchiveFlushIntervalSec() )
 			{
 				FlushArchiveAndResetTimer();
 			}
@@ -141,12 +148,13 @@ void FAsyncWriter::FlushBuffer()
 	check(SerializeRequestCounter.GetValue() == 0);
 }
 
-FAsyncWriter::FAsyncWriter(FArchive& InAr)
+FAsyncWriter::FAsyncWriter(FArchive& InAr, double InMinArchiveFlushIntervalSec)
 	: Thread(nullptr)
 	, Ar(InAr)
 	, BufferStartPos(0)
 	, BufferEndPos(0)
 	, LastArchiveFlushTime(0.0)
+	, MinArchiveFlushIntervalSec(InMinArchiveFlushIntervalSec)
 {
 	Buffer.AddUninitialized(InitialBufferSize);
 
@@ -254,7 +262,7 @@ uint32 FAsyncWriter::Run()
 		{
 			SerializeBufferToArchive();
 		}
-		else if ((FPlatformTime::Seconds() - LastArchiveFlushTime) > GetLogFlushIntervalSec() )
+		else if ((FPlatformTime::Seconds() - LastArchiveFlushTime) > GetArchiveFlushIntervalSec() )
 		{
 			FlushArchiveAndResetTimer();
 		}
@@ -272,6 +280,245 @@ void FAsyncWriter::Stop()
 }
 
 
+FOutputDeviceFileWriteOptions FOutputDeviceFileWriteOptions::FromCommandLine()
+{
+	FOutputDeviceFileWriteOptions Options;
+
+	int32 BlockSizeKB = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LogBlockSize="), BlockSizeKB) && BlockSizeKB > 0)
+	{
+		Options.BlockSize = BlockSizeKB * 1024;
+	}
+	Options.bCompress = FParse::Param(FCommandLine::Get(), TEXT("LogCompress"));
+	if (Options.bCompress && Options.BlockSize <= 0)
+	{
+		Options.BlockSize = DefaultBlockSize;
+	}
+
+	int32 RotateSizeMB = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LogRotateSizeMB="), RotateSizeMB) && RotateSizeMB > 0)
+	{
+		Options.RotateSize = int64(RotateSizeMB) * 1024 * 1024;
+	}
+	float RotateMinutes = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LogRotateMinutes="), RotateMinutes) && RotateMinutes > 0.0f)
+	{
+		Options.RotateInterval = double(RotateMinutes) * 60.0;
+	}
+
+	return Options;
+}
+
+/** Makes the name of a timestamped backup of a log file */
+static FString MakeBackupFilename(const TCHAR* Filename, const FDateTime& Time)
+{
+	FString Name, Extension;
+	FString(Filename).Split(TEXT("."), &Name, &Extension, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	return FString::Printf(TEXT("%s%s%s.%s"), *Name, BACKUP_LOG_FILENAME_POSTFIX, *Time.ToString(), *Extension);
+}
+
+/**
+ * [WRITER THREAD] Archive the async writer serializes to when FOutputDeviceFileWriteOptions asks for batched writes.
+ * Output is accumulated into blocks written in a single call, optionally compressed, and the file is rotated once
+ * it gets too big or too old. All of it runs on the async writer thread so the threads logging never wait on it.
+ */
+class FOutputDeviceFileBlockWriter final : public FArchive
+{
+public:
+	FOutputDeviceFileBlockWriter(FArchive* InFileAr, const TCHAR* InFilename, const FOutputDeviceFileWriteOptions& InOptions, const uint8* InFileHeader, int32 InFileHeaderSize)
+		: FileAr(InFileAr)
+		, Filename(InFilename)
+		, Options(InOptions)
+		, FileSize(InFileAr->TotalSize())
+		, UncompressedOffset(0)
+		, FileOpenTime(FPlatformTime::Seconds())
+	{
+		SetIsSaving(true);
+		if (Options.BlockSize <= 0)
+		{
+			Options.BlockSize = FOutputDeviceFileWriteOptions::DefaultBlockSize;
+		}
+		Block.Reserve(Options.BlockSize);
+		FileHeader.Append(InFileHeader, InFileHeaderSize);
+	}
+
+	virtual ~FOutputDeviceFileBlockWriter()
+	{
+		WriteBlock();
+		delete FileAr;
+	}
+
+	virtual void Serialize(void* Data, int64 Length) override
+	{
+		const uint8* Src = (const uint8*)Data;
+		while (Length > 0)
+		{
+			const int64 Count = FMath::Min<int64>(GetBlockCapacity() - Block.Num(), Length);
+			Block.Append(Src, (int32)Count);
+			Src += Count;
+			Length -= Count;
+
+			if (Block.Num() >= GetBlockCapacity())
+			{
+				WriteBlock();
+				RotateIfNeeded();
+			}
+		}
+	}
+
+	virtual void Flush() override
+	{
+		// The async writer flushes on request and otherwise no more often than BlockFlushInterval, write the partial block either way
+		WriteBlock();
+		if (FileAr)
+		{
+			FileAr->Flush();
+		}
+		RotateIfNeeded();
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return Filename;
+	}
+
+private:
+	/** Size the current block is written at. Uncompressed blocks end on a multiple of the block size in the file. */
+	int32 GetBlockCapacity() const
+	{
+		return Options.bCompress ? Options.BlockSize : int32(Options.BlockSize - FileSize % Options.BlockSize);
+	}
+
+	void WriteBlock()
+	{
+		if (!Block.Num())
+		{
+			return;
+		}
+
+		if (FileAr)
+		{
+			if (Options.bCompress)
+			{
+				const int32 CompressedBound = LZ4_compressBound(Block.Num());
+				CompressedBlock.SetNumUninitialized(sizeof(FOutputDeviceFile::FCompressedFrameHeader) + CompressedBound, false);
+				const int32 CompressedSize = LZ4_compress_default((const char*)Block.GetData(), (char*)CompressedBlock.GetData() + sizeof(FOutputDeviceFile::FCompressedFrameHeader), Block.Num(), CompressedBound);
+				check(CompressedSize > 0);
+
+				FOutputDeviceFile::FCompressedFrameHeader Header;
+				Header.Magic = FOutputDeviceFile::FCompressedFrameHeader::ExpectedMagic;
+				Header.CompressedSize = CompressedSize;
+				Header.UncompressedSize = Block.Num();
+				Header.Padding = 0;
+				Header.UncompressedOffset = UncompressedOffset;
+				FMemory::Memcpy(CompressedBlock.GetData(), &Header, sizeof(Header));
+
+				FileAr->Serialize(CompressedBlock.GetData(), sizeof(Header) + CompressedSize);
+				FileSize += sizeof(Header) + CompressedSize;
+			}
+			else
+			{
+				FileAr->Serialize(Block.GetData(), Block.Num());
+				FileSize += Block.Num();
+			}
+		}
+
+		UncompressedOffset += Block.Num();
+		Block.Reset();
+	}
+
+	void RotateIfNeeded()
+	{
+		const double Now = FPlatformTime::Seconds();
+		const bool bTooBig = Options.RotateSize > 0 && FileSize >= Options.RotateSize;
+		const bool bTooOld = Options.RotateInterval > 0.0 && Now - FileOpenTime >= Options.RotateInterval;
+		if (!bTooBig && !bTooOld)
+		{
+			return;
+		}
+
+		// Don't start new files when nothing was logged since the last one
+		if (!FileAr || UncompressedOffset <= uint64(FileHeader.Num()))
+		{
+			FileOpenTime = Now;
+			return;
+		}
+
+		Rotate();
+	}
+
+	/** Moves the current file to a timestamped backup and starts a new one in its place */
+	void Rotate()
+	{
+		delete FileAr;
+		FileAr = nullptr;
+
+		// The errors of the file manager would be logged back to this output device, don't let it report them
+		IFileManager& FileManager = IFileManager::Get();
+		const bool bMoved = FileManager.Move(*MakeBackupFilename(*Filename, FDateTime::Now()), *Filename, false, false, false, true);
+
+		// Keep appending to the same file if it couldn't be moved
+		FileAr = FileManager.CreateFileWriter(*Filename, FILEWRITE_Silent | FILEWRITE_AllowRead | (bMoved ? 0 : FILEWRITE_Append));
+		FileSize = FileAr ? FileAr->TotalSize() : 0;
+		FileOpenTime = FPlatformTime::Seconds();
+
+		if (bMoved)
+		{
+			// Rotation only happens after a block is written so the header starts the first block of the new file
+			UncompressedOffset = 0;
+			Block.Append(FileHeader);
+		}
+	}
+
+	/** File currently written to, null if it couldn't be reopened after rotating */
+	FArchive* FileAr;
+	FString Filename;
+	FOutputDeviceFileWriteOptions Options;
+	/** Written at the start of each new file */
+	TArray<uint8> FileHeader;
+	/** Output waiting to be written */
+	TArray<uint8> Block;
+	/** Scratch buffer the block is compressed into */
+	TArray<uint8> CompressedBlock;
+	/** Size of the current file */
+	int64 FileSize;
+	/** Offset of the current block in the uncompressed file */
+	uint64 UncompressedOffset;
+	/** Time the current file was started at */
+	double FileOpenTime;
+};
+
+bool FOutputDeviceFile::DecompressLog(const TArray<uint8>& CompressedData, TArray<uint8>& OutData)
+{
+	int64 Offset = 0;
+	while (Offset < CompressedData.Num())
+	{
+		FCompressedFrameHeader Header;
+		if (CompressedData.Num() - Offset < int64(sizeof(Header)))
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Header, CompressedData.GetData() + Offset, sizeof(Header));
+		Offset += sizeof(Header);
+
+		if (Header.Magic != FCompressedFrameHeader::ExpectedMagic || Header.CompressedSize > CompressedData.Num() - Offset || Header.UncompressedSize > MAX_int32)
+		{
+			return false;
+		}
+
+		const int32 OutOffset = OutData.AddUninitialized(Header.UncompressedSize);
+		const int32 DecompressedSize = LZ4_decompress_safe((const char*)CompressedData.GetData() + Offset, (char*)OutData.GetData() + OutOffset, Header.CompressedSize, Header.UncompressedSize);
+		if (DecompressedSize != int32(Header.UncompressedSize))
+		{
+			OutData.SetNum(OutOffset, false);
+			return false;
+		}
+		Offset += Header.CompressedSize;
+	}
+	return true;
+}
+
+
 /**
 
 */
@@ -365,10 +612,8 @@ void FOutputDeviceFile::CreateBackupCopy(const TCHAR* Filename)
 	IFileManager& FileManager = IFileManager::Get();
 	if (FileManager.FileSize(Filename) > 0) // file exists and is not empty
 	{
-		FString Name, Extension;
-		FString(Filename).Split(TEXT("."), &Name, &Extension, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
 		FDateTime OriginalTime = FileManager.GetTimeStamp(Filename);
-		FString BackupFilename = FString::Printf(TEXT("%s%s%s.%s"), *Name, BACKUP_LOG_FILENAME_POSTFIX, *OriginalTime.ToString(), *Extension);
+		FString BackupFilename = MakeBackupFilename(Filename, OriginalTime);
 		if (FileManager.Copy(*BackupFilename, Filename, false) == COPY_OK)
 		{
 			FileManager.SetTimeStamp(*BackupFilename, OriginalTime);
@@ -429,8 +674,17 @@ bool FOutputDeviceFile::CreateWriter(uint32 MaxAttempts)
 	FAsyncWriter* Result = nullptr;
 	if (Ar)
 	{
-		WriterArchive = Ar;
-		AsyncWriter = new FAsyncWriter(*WriterArchive);
+		if (WriteOptions.IsBatched())
+		{
+			// Files are only written by the async writer thread so the block writer can rotate them without synchronization
+			WriterArchive = new FOutputDeviceFileBlockWriter(Ar, Filename, WriteOptions, UTF8BOM, sizeof(UTF8BOM));
+			AsyncWriter = new FAsyncWriter(*WriterArchive, WriteOptions.BlockFlushInterval);
+		}
+		else
+		{
+			WriterArchive = Ar;
+			AsyncWriter = new FAsyncWriter(*WriterArchive);
+		}
 	}
 
 	return !!AsyncWriter;
@@ -461,6 +715,12 @@ void FOutputDeviceFile::Serialize( const TCHAR* Data, ELogVerbosity::Type Verbos
 				FCString::Strcpy(Filename, *FPlatformOutputDevices::GetAbsoluteLogFilename());
 			}
 
+			static const TCHAR CompressedExtension[] = TEXT(".lz4");
+			if (WriteOptions.bCompress && !FString(Filename).EndsWith(CompressedExtension))
+			{
+				FCString::Strcat(Filename, CompressedExtension);
+			}
+
 			// if the file already exists, create a backup as we are going to overwrite it
 			if (!bDisableBackup && !Opened)
 			{
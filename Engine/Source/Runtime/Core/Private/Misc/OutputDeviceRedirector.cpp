@@ -4,9 +4,12 @@
 
 #include "Containers/BitArray.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/TlsAutoCleanup.h"
+#include "Logging/DeferredLogMessage.h"
 #include "Misc/CoreStats.h"
 #include "Misc/ScopeLock.h"
 #include "Stats/Stats.h"
+#include "Templates/Atomic.h"
 
 /*-----------------------------------------------------------------------------
 	FOutputDeviceRedirector.
@@ -60,6 +63,181 @@ private:
 	int32 BufferIndex = 0;
 };
 
+/**
+ * Single producer single consumer ring of log records. The thread owning the ring appends records without taking
+ * a lock, the master thread drains it when flushing threaded logs. Rings are handed back when their thread exits
+ * and reused by the next thread that logs, they are never freed.
+ */
+class FThreadLogRing
+{
+public:
+	/** Header of each record, followed by the null terminated line or the encoded arguments of a deferred message. */
+	struct FRecord
+	{
+		/** Size of the record including header and payload, a multiple of the record alignment. */
+		uint32 Size;
+		uint16 EncodedArgsSize;
+		ELogVerbosity::Type Verbosity;
+		/** Filler up to the end of the ring. Only Size is valid, the header may not fit. */
+		bool bPadding;
+		double Time;
+		FLazyName Category;
+		/** Format string of a deferred message, null if the record holds a formatted line. */
+		const TCHAR* Format;
+
+		const uint8* GetPayload() const
+		{
+			return reinterpret_cast<const uint8*>(this + 1);
+		}
+
+		const TCHAR* GetData() const
+		{
+			return reinterpret_cast<const TCHAR*>(this + 1);
+		}
+	};
+
+	static constexpr uint32 Capacity = 32 * 1024;
+	/** Longer lines would take up too much of the ring and are buffered in BufferedLines instead. */
+	static constexpr uint32 MaxRecordSize = Capacity / 4;
+
+	explicit FThreadLogRing(FOutputDeviceRedirector* InRedirector)
+		: Redirector(InRedirector)
+		, Next(nullptr)
+		, bOwned(1)
+		, Head(0)
+		, Tail(0)
+		, DrainedTail(0)
+	{
+	}
+
+	/** Called by the producer. */
+	bool TryPush(const TCHAR* Line, ELogVerbosity::Type Verbosity, const FLazyName& Category, double Time)
+	{
+		return TryPush(nullptr, Line, (FCString::Strlen(Line) + 1) * sizeof(TCHAR), Verbosity, Category, Time);
+	}
+
+	/** Called by the producer, the message is left for the consumer to format. */
+	bool TryPush(const FDeferredLogMessage& Message, double Time)
+	{
+		return TryPush(Message.GetFormat(), Message.GetEncodedArgs(), Message.GetEncodedArgsSize(), Message.GetVerbosity(), FLazyName(Message.GetCategory()), Time);
+	}
+
+	/** Called by the consumer, visits the records published so far. They stay valid until FinishDrain is called. */
+	template<typename FuncType>
+	void Drain(FuncType Visit)
+	{
+		const uint32 LocalHead = Head.Load();
+		uint32 LocalTail = Tail.Load(EMemoryOrder::Relaxed);
+		while (LocalTail != LocalHead)
+		{
+			const FRecord* Record = GetRecord(LocalTail);
+			if (!Record->bPadding)
+			{
+				Visit(*Record);
+			}
+			LocalTail += Record->Size;
+		}
+		DrainedTail = LocalTail;
+	}
+
+	/** Hands the space of the drained records back to the producer. */
+	void FinishDrain()
+	{
+		Tail = DrainedTail;
+	}
+
+	bool IsEmpty() const
+	{
+		return Head.Load() == Tail.Load(EMemoryOrder::Relaxed);
+	}
+
+	/** Claims an unowned ring for the calling thread. */
+	bool TryClaim()
+	{
+		return bOwned == 0 && FPlatformAtomics::InterlockedCompareExchange(&bOwned, 1, 0) == 0;
+	}
+
+	/** Gives up ownership, called when the owning thread exits. Records that weren't drained yet are kept. */
+	void Release()
+	{
+		FPlatformAtomics::InterlockedExchange(&bOwned, 0);
+	}
+
+	FOutputDeviceRedirector* const Redirector;
+	FThreadLogRing* Next;
+
+private:
+	bool TryPush(const TCHAR* Format, const void* Payload, uint32 PayloadSize, ELogVerbosity::Type Verbosity, const FLazyName& Category, double Time)
+	{
+		const uint32 RecordSize = Align(uint32(sizeof(FRecord) + PayloadSize), alignof(FRecord));
+		if (RecordSize > MaxRecordSize)
+		{
+			return false;
+		}
+
+		uint32 LocalHead = Head.Load(EMemoryOrder::Relaxed);
+		const uint32 Offset = LocalHead % Capacity;
+		const uint32 PaddingSize = Offset + RecordSize > Capacity ? Capacity - Offset : 0;
+		if (LocalHead + PaddingSize + RecordSize - Tail.Load() > Capacity)
+		{
+			return false;
+		}
+
+		if (PaddingSize)
+		{
+			FRecord* Padding = GetRecord(LocalHead);
+			Padding->Size = PaddingSize;
+			Padding->bPadding = true;
+			LocalHead += PaddingSize;
+		}
+
+		FRecord* Record = GetRecord(LocalHead);
+		Record->Size = RecordSize;
+		Record->EncodedArgsSize = Format ? uint16(PayloadSize) : 0;
+		Record->Verbosity = Verbosity;
+		Record->bPadding = false;
+		Record->Time = Time;
+		new (&Record->Category) FLazyName(Category);
+		Record->Format = Format;
+		FMemory::Memcpy(const_cast<uint8*>(Record->GetPayload()), Payload, PayloadSize);
+
+		// publish the record
+		Head = LocalHead + RecordSize;
+		return true;
+	}
+
+	FRecord* GetRecord(uint32 Position)
+	{
+		return reinterpret_cast<FRecord*>(Buffer + Position % Capacity);
+	}
+
+	volatile int32 bOwned;
+	/** Written by the producer only. Positions grow forever and are wrapped when indexing into Buffer. */
+	TAtomic<uint32> Head;
+	/** Written by the consumer only. */
+	TAtomic<uint32> Tail;
+	uint32 DrainedTail;
+	alignas(FRecord) uint8 Buffer[Capacity];
+};
+
+/** Hands the thread's ring back when the thread exits. */
+struct FThreadLogRingOwner : public FTlsAutoCleanup
+{
+	explicit FThreadLogRingOwner(FThreadLogRing* InRing)
+		: Ring(InRing)
+	{
+	}
+
+	virtual ~FThreadLogRingOwner()
+	{
+		Ring->Release();
+	}
+
+	FThreadLogRing* Ring;
+};
+
+static thread_local FThreadLogRingOwner* GThreadLogRingOwner = nullptr;
+
 FBufferedLine::FBufferedLine(const TCHAR* InData, const FName& InCategory, ELogVerbosity::Type InVerbosity, double InTime, FLogAllocator* ExternalAllocator)
 	: FBufferedLine(InData, FLazyName(InCategory), InVerbosity, InTime, ExternalAllocator)
 {
@@ -89,6 +267,9 @@ FOutputDeviceRedirector::FOutputDeviceRedirector(FLogAllocator* Allocator)
 :	MasterThreadID(FPlatformTLS::GetCurrentThreadId())
 ,	bEnableBacklog(false)
 ,	BufferedLinesAllocator(Allocator)
+,	ThreadLogRings(nullptr)
+,	bDrainingThreadLogRings(false)
+,	OutputDevicesWriting(0)
 {
 }
 
@@ -100,6 +281,30 @@ FOutputDeviceRedirector* FOutputDeviceRedirector::Get()
 	return &Singleton;
 }
 
+template<typename FuncType>
+void FOutputDeviceRedirector::ModifyOutputDevices(FuncType Modify)
+{
+	for (;;)
+	{
+		{
+			FScopeLock OutputDevicesLock(&OutputDevicesMutex);
+			FPlatformAtomics::InterlockedExchange(&OutputDevicesWriting, 1);
+			const bool bNoReaders = OutputDevicesLockCounter.GetValue() == 0;
+			if (bNoReaders)
+			{
+				Modify();
+			}
+			FPlatformAtomics::InterlockedExchange(&OutputDevicesWriting, 0);
+			if (bNoReaders)
+			{
+				return;
+			}
+		}
+		// Don't hold the mutex while waiting, a thread that has the arrays locked may log and need it
+		FPlatformProcess::Sleep(0);
+	}
+}
+
 /**
  * Adds an output device to the chain of redirections.	
  *
@@ -109,29 +314,17 @@ void FOutputDeviceRedirector::AddOutputDevice( FOutputDevice* OutputDevice )
 {
 	if (OutputDevice)
 	{
-		bool bAdded = false;
-		do
+		ModifyOutputDevices([this, OutputDevice]()
 		{
+			if (OutputDevice->CanBeUsedOnMultipleThreads())
 			{
-				FScopeLock ScopeLock(&OutputDevicesMutex);
-				if (OutputDevicesLockCounter.GetValue() == 0)
-				{
-					if (OutputDevice->CanBeUsedOnMultipleThreads())
-					{
-						UnbufferedOutputDevices.AddUnique(OutputDevice);
-					}
-					else
-					{
-						BufferedOutputDevices.AddUnique(OutputDevice);
-					}
-					bAdded = true;
-				}
+				UnbufferedOutputDevices.AddUnique(OutputDevice);
 			}
-			if (!bAdded)
+			else
 			{
-				FPlatformProcess::Sleep(0);
+				BufferedOutputDevices.AddUnique(OutputDevice);
 			}
-		} while (!bAdded);
+		});
 	}
 }
 
@@ -142,23 +335,11 @@ void FOutputDeviceRedirector::AddOutputDevice( FOutputDevice* OutputDevice )
  */
 void FOutputDeviceRedirector::RemoveOutputDevice( FOutputDevice* OutputDevice )
 {
-	bool bRemoved = false;
-	do
+	ModifyOutputDevices([this, OutputDevice]()
 	{
-		{
-			FScopeLock ScopeLock(&OutputDevicesMutex);
-			if (OutputDevicesLockCounter.GetValue() == 0)
-			{
-				BufferedOutputDevices.Remove( OutputDevice );
-				UnbufferedOutputDevices.Remove(OutputDevice);
-				bRemoved = true;
-			}
-		}
-		if (!bRemoved)
-		{
-			FPlatformProcess::Sleep(0);
-		}
-	} while (!bRemoved);
+		BufferedOutputDevices.Remove(OutputDevice);
+		UnbufferedOutputDevices.Remove(OutputDevice);
+	});
 }
 
 /**
@@ -188,7 +369,8 @@ void FOutputDeviceRedirector::InternalFlushThreadedLogs(bool bUseAllDevices)
  */
 void FOutputDeviceRedirector::InternalFlushThreadedLogs(TLocalOutputDevicesArray& InBufferedDevices, bool bUseAllDevices)
 {	
-	if (BufferedLines.Num())
+	const bool bHasThreadLogRecords = HasThreadLogRecords();
+	if (BufferedLines.Num() || bHasThreadLogRecords)
 	{
 		TArray<FBufferedLine, TInlineAllocator<64>> LocalBufferedLines;
 		FLogAllocator::FBufferLock BufferLock;
@@ -199,30 +381,93 @@ void FOutputDeviceRedirector::InternalFlushThreadedLogs(TLocalOutputDevicesArray
 			{
 				new(&LocalBufferedLines[LineIndex]) FBufferedLine(BufferedLines[LineIndex], FBufferedLine::EMoveCtor);
 			}
-			if (BufferedLinesAllocator)
+			if (BufferedLines.Num())
+			{
+				if (BufferedLinesAllocator)
+				{
+					BufferLock = BufferedLinesAllocator->LockBuffer();
+				}
+				EmptyBufferedLines();
+			}
+		}
+
+		struct FPendingLine
+		{
+			const TCHAR* Data;
+			const FLazyName* Category;
+			double Time;
+			ELogVerbosity::Type Verbosity;
+			/** Set for deferred messages, Data then points to their encoded arguments */
+			const TCHAR* Format;
+			uint16 EncodedArgsSize;
+		};
+
+		TArray<FPendingLine, TInlineAllocator<64>> PendingLines;
+		for (const FBufferedLine& Line : LocalBufferedLines)
+		{
+			PendingLines.Add({ Line.Data, &Line.Category, Line.Time, Line.Verbosity, nullptr, 0 });
+		}
+
+		// Records stay in the rings until they were serialized, a flush from within an output device leaves them to this one
+		TArray<FThreadLogRing*, TInlineAllocator<64>> DrainedRings;
+		FScopeLock RingsLock(&ThreadLogRingsMutex);
+		if (bHasThreadLogRecords && !bDrainingThreadLogRings)
+		{
+			bDrainingThreadLogRings = true;
+			for (FThreadLogRing* Ring = ThreadLogRings; Ring; Ring = Ring->Next)
 			{
-				BufferLock = BufferedLinesAllocator->LockBuffer();
+				if (!Ring->IsEmpty())
+				{
+					Ring->Drain([&PendingLines](const FThreadLogRing::FRecord& Record)
+					{
+						PendingLines.Add({ Record.GetData(), &Record.Category, Record.Time, Record.Verbosity, Record.Format, Record.EncodedArgsSize });
+					});
+					DrainedRings.Add(Ring);
+				}
 			}
-			EmptyBufferedLines();
 		}
 
-		for (FBufferedLine& Line : LocalBufferedLines)
+		// Every thread's lines are in order already, merge them into a single timeline
+		if (DrainedRings.Num())
 		{
-			const TCHAR* Data = Line.Data;
-			const FLazyName Category = Line.Category;
-			const double Time = Line.Time;
-			const ELogVerbosity::Type Verbosity = Line.Verbosity;
+			PendingLines.StableSort([](const FPendingLine& A, const FPendingLine& B) { return A.Time < B.Time; });
+		}
+
+		for (const FPendingLine& Line : PendingLines)
+		{
+			if (Line.Format)
+			{
+				// Formatted by the first device that needs the text
+				const FDeferredLogMessage Message(Line.Format, reinterpret_cast<const uint8*>(Line.Data), Line.EncodedArgsSize, Line.Verbosity, *Line.Category, Line.Time);
+				for (FOutputDevice* OutputDevice : InBufferedDevices)
+				{
+					if (OutputDevice->CanBeUsedOnAnyThread() || bUseAllDevices)
+					{
+						OutputDevice->SerializeDeferred(Message);
+					}
+				}
+				continue;
+			}
 
 			for (FOutputDevice* OutputDevice : InBufferedDevices)
 			{
 				if (OutputDevice->CanBeUsedOnAnyThread() || bUseAllDevices)
 				{
-					OutputDevice->Serialize(Data, Verbosity, Category, Time);
+					OutputDevice->Serialize(Line.Data, Line.Verbosity, *Line.Category, Line.Time);
 				}
 			}
 		}
 
-		if (BufferedLinesAllocator)
+		if (DrainedRings.Num())
+		{
+			for (FThreadLogRing* Ring : DrainedRings)
+			{
+				Ring->FinishDrain();
+			}
+			bDrainingThreadLogRings = false;
+		}
+
+		if (BufferedLinesAllocator && LocalBufferedLines.Num())
 		{
 			FScopeLock ScopeLock(&BufferSynchronizationObject);
 			BufferedLinesAllocator->UnlockBuffer(BufferLock);
@@ -230,6 +475,67 @@ void FOutputDeviceRedirector::InternalFlushThreadedLogs(TLocalOutputDevicesArray
 	}
 }
 
+bool FOutputDeviceRedirector::HasThreadLogRecords() const
+{
+	for (const FThreadLogRing* Ring = ThreadLogRings; Ring; Ring = Ring->Next)
+	{
+		if (!Ring->IsEmpty())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FThreadLogRing* FOutputDeviceRedirector::GetThreadLogRing()
+{
+	FThreadLogRing* Ring = GThreadLogRingOwner ? GThreadLogRingOwner->Ring : nullptr;
+	if (!Ring)
+	{
+		// Reuse the ring of a thread that exited before making a new one
+		for (FThreadLogRing* Existing = ThreadLogRings; Existing; Existing = Existing->Next)
+		{
+			if (Existing->TryClaim())
+			{
+				Ring = Existing;
+				break;
+			}
+		}
+
+		if (!Ring)
+		{
+			Ring = new FThreadLogRing(this);
+			do
+			{
+				Ring->Next = ThreadLogRings;
+			}
+			while (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&ThreadLogRings, Ring, Ring->Next) != Ring->Next);
+		}
+
+		GThreadLogRingOwner = new FThreadLogRingOwner(Ring);
+		GThreadLogRingOwner->Register();
+	}
+	else if (Ring->Redirector != this)
+	{
+		// The thread's ring belongs to a different redirector
+		return nullptr;
+	}
+
+	return Ring;
+}
+
+bool FOutputDeviceRedirector::TryBufferLineInThreadRing(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FLazyName& Category, double Time)
+{
+	FThreadLogRing* Ring = GetThreadLogRing();
+	return Ring && Ring->TryPush(Data, Verbosity, Category, Time);
+}
+
+bool FOutputDeviceRedirector::TryBufferMessageInThreadRing(const FDeferredLogMessage& Message, double Time)
+{
+	FThreadLogRing* Ring = GetThreadLogRing();
+	return Ring && Ring->TryPush(Message, Time);
+}
+
 void FOutputDeviceRedirector::EmptyBufferedLines()
 {
 	BufferedLines.Empty();
@@ -324,19 +630,38 @@ void FOutputDeviceRedirector::SetCurrentThreadAsMasterThread()
 
 void FOutputDeviceRedirector::LockOutputDevices(TLocalOutputDevicesArray& OutBufferedDevices, TLocalOutputDevicesArray& OutUnbufferedDevices)
 {
-	FScopeLock OutputDevicesLock(&OutputDevicesMutex);
+	// Writers only modify the arrays after raising OutputDevicesWriting and seeing no readers.
+	// Both sides use full barriers so at least one of them backs off.
 	OutputDevicesLockCounter.Increment();
+	if (FPlatformAtomics::AtomicRead(&OutputDevicesWriting))
+	{
+		OutputDevicesLockCounter.Decrement();
+
+		FScopeLock OutputDevicesLock(&OutputDevicesMutex);
+		OutputDevicesLockCounter.Increment();
+	}
 	OutBufferedDevices.Append(BufferedOutputDevices);
 	OutUnbufferedDevices.Append(UnbufferedOutputDevices);
 }
 
 void FOutputDeviceRedirector::UnlockOutputDevices()
 {
-	FScopeLock OutputDevicesLock(&OutputDevicesMutex);
 	int32 LockValue = OutputDevicesLockCounter.Decrement();
 	check(LockValue >= 0);
 }
 
+#if PLATFORM_DESKTOP
+static void PrintAfterShutdown(const TCHAR* Data)
+{
+#if PLATFORM_WINDOWS
+	_tprintf(_T("%s\n"), Data);
+#else
+	FGenericPlatformMisc::LocalPrint(Data);
+	// printf("%s\n", TCHAR_TO_ANSI(Data));
+#endif
+}
+#endif
+
 template<class T>
 void FOutputDeviceRedirector::SerializeImpl(const TCHAR* Data, ELogVerbosity::Type Verbosity, T& Category, const double Time)
 {
@@ -350,12 +675,7 @@ void FOutputDeviceRedirector::SerializeImpl(const TCHAR* Data, ELogVerbosity::Ty
 	// this is for errors which occur after shutdown we might be able to salvage information from stdout 
 	if ((LocalBufferedDevices.Num() == 0) && IsEngineExitRequested())
 	{
-#if PLATFORM_WINDOWS
-		_tprintf(_T("%s\n"), Data);
-#else
-		FGenericPlatformMisc::LocalPrint(Data);
-		// printf("%s\n", TCHAR_TO_ANSI(Data));
-#endif
+		PrintAfterShutdown(Data);
 		return;
 	}
 #endif
@@ -375,8 +695,11 @@ void FOutputDeviceRedirector::SerializeImpl(const TCHAR* Data, ELogVerbosity::Ty
 
 	if (FPlatformTLS::GetCurrentThreadId() != MasterThreadID || LocalBufferedDevices.Num() == 0)
 	{
-		FScopeLock ScopeLock(&BufferSynchronizationObject);
-		new(BufferedLines)FBufferedLine(Data, Category, Verbosity, RealTime, BufferedLinesAllocator);
+		if (!TryBufferLineInThreadRing(Data, Verbosity, FLazyName(Category), RealTime))
+		{
+			FScopeLock ScopeLock(&BufferSynchronizationObject);
+			new(BufferedLines)FBufferedLine(Data, Category, Verbosity, RealTime, BufferedLinesAllocator);
+		}
 	}
 	else
 	{
@@ -400,6 +723,55 @@ void FOutputDeviceRedirector::Serialize( const TCHAR* Data, ELogVerbosity::Type
 	SerializeImpl( Data, Verbosity, Category, -1.0 );
 }
 
+void FOutputDeviceRedirector::SerializeDeferred(const FDeferredLogMessage& InMessage)
+{
+	const double RealTime = InMessage.GetTime() == -1.0f ? FPlatformTime::Seconds() - GStartTime : InMessage.GetTime();
+	const FDeferredLogMessage Message(InMessage.GetFormat(), InMessage.GetEncodedArgs(), InMessage.GetEncodedArgsSize(), InMessage.GetVerbosity(), InMessage.GetCategory(), RealTime);
+
+	TLocalOutputDevicesArray LocalBufferedDevices;
+	TLocalOutputDevicesArray LocalUnbufferedDevices;
+	FOutputDevicesLock OutputDevicesLock(this, LocalBufferedDevices, LocalUnbufferedDevices);
+
+#if PLATFORM_DESKTOP
+	if ((LocalBufferedDevices.Num() == 0) && IsEngineExitRequested())
+	{
+		PrintAfterShutdown(Message.GetText());
+		return;
+	}
+#endif
+
+	for (FOutputDevice* OutputDevice : LocalUnbufferedDevices)
+	{
+		OutputDevice->SerializeDeferred(Message);
+	}
+
+	if (bEnableBacklog)
+	{
+		FScopeLock ScopeLock(&SynchronizationObject);
+		new(BacklogLines)FBufferedLine(Message.GetText(), Message.GetCategory(), Message.GetVerbosity(), RealTime, nullptr);
+	}
+
+	if (FPlatformTLS::GetCurrentThreadId() != MasterThreadID || LocalBufferedDevices.Num() == 0)
+	{
+		// The master thread formats the message when it flushes threaded logs
+		if (!TryBufferMessageInThreadRing(Message, RealTime))
+		{
+			FScopeLock ScopeLock(&BufferSynchronizationObject);
+			new(BufferedLines)FBufferedLine(Message.GetText(), Message.GetCategory(), Message.GetVerbosity(), RealTime, BufferedLinesAllocator);
+		}
+	}
+	else
+	{
+		// Flush previously buffered lines from secondary threads.
+		InternalFlushThreadedLogs(LocalBufferedDevices, true);
+
+		for (FOutputDevice* OutputDevice : LocalBufferedDevices)
+		{
+			OutputDevice->SerializeDeferred(Message);
+		}
+	}
+}
+
 void FOutputDeviceRedirector::RedirectLog(const FName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Data)
 {
 	SerializeImpl(Data, Verbosity, Category, -1.0);
@@ -449,13 +821,15 @@ void FOutputDeviceRedirector::TearDown()
 	TLocalOutputDevicesArray LocalBufferedDevices;
 	TLocalOutputDevicesArray LocalUnbufferedDevices;
 
+	// Keep the devices locked until they are torn down so that nothing can be added or removed meanwhile
+	ModifyOutputDevices([this, &LocalBufferedDevices, &LocalUnbufferedDevices]()
 	{
-		// We need to lock the mutex here so that it gets unlocked after we empty the devices arrays
-		FScopeLock GlobalOutputDevicesLock(&OutputDevicesMutex);
-		LockOutputDevices(LocalBufferedDevices, LocalUnbufferedDevices);
+		LocalBufferedDevices.Append(BufferedOutputDevices);
+		LocalUnbufferedDevices.Append(UnbufferedOutputDevices);
 		BufferedOutputDevices.Empty();
-		UnbufferedOutputDevices.Empty();	
-	}
+		UnbufferedOutputDevices.Empty();
+		OutputDevicesLockCounter.Increment();
+	});
 
 	// Flush previously buffered lines from secondary threads.
 	InternalFlushThreadedLogs(LocalBufferedDevices, false);
@@ -11,6 +11,7 @@
 #include "Internationalization/Text.h"
 #include "Misc/AsciiSet.h"
 #include "Misc/Guid.h"
+#include "Misc/CommandLine.h"
 #include "Misc/OutputDeviceNull.h"
 #include "Misc/StringBuilder.h"
 #include "HAL/IConsoleManager.h"
@@ -219,6 +220,20 @@ void ConsoleCommandLibrary_DumpLibraryHTML(UWorld* InWorld, FExec& SubSystem, co
 }
 #endif // UE_BUILD_SHIPPING
 
+namespace UE4Parse_Private
+{
+	/** FCString::Strifind, from the index of the command line when Stream is the command line */
+	static const TCHAR* FindMatch(const TCHAR* Stream, const TCHAR* Match, bool bSkipQuotedChars = false)
+	{
+		const TCHAR* Found;
+		if (FCommandLine::FindIndexed(Stream, Match, bSkipQuotedChars, Found))
+		{
+			return Found;
+		}
+		return FCString::Strifind(Stream, Match, bSkipQuotedChars);
+	}
+}
+
 //
 // Get a string from a text string.
 //
@@ -233,7 +248,7 @@ bool FParse::Value(
 	bool bSuccess = false;
 	int32 MatchLen = FCString::Strlen(Match);
 
-	for (const TCHAR* Found = FCString::Strifind(Stream, Match, true); Found != nullptr; Found = FCString::Strifind(Found + MatchLen, Match, true))
+	for (const TCHAR* Found = UE4Parse_Private::FindMatch(Stream, Match, true); Found != nullptr; Found = FCString::Strifind(Found + MatchLen, Match, true))
 	{
 		const TCHAR* Start = Found + MatchLen;
 
@@ -287,6 +302,12 @@ bool FParse::Value(
 //
 bool FParse::Param( const TCHAR* Stream, const TCHAR* Param )
 {
+	bool bFound;
+	if (FCommandLine::ParamIndexed(Stream, Param, bFound))
+	{
+		return bFound;
+	}
+
 	const TCHAR* Start = Stream;
 	if( *Stream )
 	{
@@ -499,7 +520,7 @@ bool FParse::Text( const TCHAR* Buffer, FText& Value, const TCHAR* Namespace )
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, FText& Value, const TCHAR* Namespace )
 {
 	// The FText 
-	Stream = FCString::Strifind( Stream, Match );
+	Stream = UE4Parse_Private::FindMatch( Stream, Match );
 	if( Stream )
 	{
 		Stream += FCString::Strlen( Match );
@@ -562,7 +583,7 @@ bool FParse::Value(	const TCHAR* Stream, const TCHAR* Match, FName& Name )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint32& Value )
 {
-	const TCHAR* Temp = FCString::Strifind(Stream,Match);
+	const TCHAR* Temp = UE4Parse_Private::FindMatch(Stream,Match);
 	TCHAR* End;
 	if( Temp==NULL )
 		return false;
@@ -576,7 +597,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint32& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint8& Value )
 {
-	const TCHAR* Temp = FCString::Strifind(Stream,Match);
+	const TCHAR* Temp = UE4Parse_Private::FindMatch(Stream,Match);
 	if( Temp==NULL )
 		return false;
 	Temp += FCString::Strlen( Match );
@@ -589,7 +610,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint8& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, int8& Value )
 {
-	const TCHAR* Temp = FCString::Strifind(Stream,Match);
+	const TCHAR* Temp = UE4Parse_Private::FindMatch(Stream,Match);
 	if( Temp==NULL )
 		return false;
 	Temp += FCString::Strlen( Match );
@@ -602,7 +623,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, int8& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint16& Value )
 {
-	const TCHAR* Temp = FCString::Strifind( Stream, Match );
+	const TCHAR* Temp = UE4Parse_Private::FindMatch( Stream, Match );
 	if( Temp==NULL )
 		return false;
 	Temp += FCString::Strlen( Match );
@@ -615,7 +636,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, uint16& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, int16& Value )
 {
-	const TCHAR* Temp = FCString::Strifind( Stream, Match );
+	const TCHAR* Temp = UE4Parse_Private::FindMatch( Stream, Match );
 	if( Temp==NULL )
 		return false;
 	Temp += FCString::Strlen( Match );
@@ -628,7 +649,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, int16& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, float& Value )
 {
-	const TCHAR* Temp = FCString::Strifind( Stream, Match );
+	const TCHAR* Temp = UE4Parse_Private::FindMatch( Stream, Match );
 	if( Temp==NULL )
 		return false;
 	Value = FCString::Atof( Temp+FCString::Strlen(Match) );
@@ -640,7 +661,7 @@ bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, float& Value )
 //
 bool FParse::Value( const TCHAR* Stream, const TCHAR* Match, int32& Value )
 {
-	const TCHAR* Temp = FCString::Strifind( Stream, Match );
+	const TCHAR* Temp = UE4Parse_Private::FindMatch( Stream, Match );
 	if( Temp==NULL )
 		return false;
 	Value = FCString::Atoi( Temp + FCString::Strlen(Match) );
@@ -4,12 +4,92 @@
 
 #include "Algo/FindLast.h"
 #include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/Char.h"
 #include "Misc/StringBuilder.h"
 
 namespace UE4PathViews_Private
 {
 	static bool IsSlashOrBackslash(TCHAR C) { return C == TEXT('/') || C == TEXT('\\'); }
 	static bool IsNotSlashOrBackslash(TCHAR C) { return C != TEXT('/') && C != TEXT('\\'); }
+
+	/** Finds "/.." in the path at or after StartIndex, matching FString::Find */
+	static int32 FindParentDir(const TCHAR* Path, int32 Len, int32 StartIndex)
+	{
+		for (int32 Index = StartIndex; Index + 3 <= Len; ++Index)
+		{
+			if (Path[Index] == TEXT('/') && Path[Index + 1] == TEXT('.') && Path[Index + 2] == TEXT('.'))
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/** Removes the characters in [Index, Index + Count) from the builder */
+	static void RemoveAt(FStringBuilderBase& Builder, int32 Index, int32 Count)
+	{
+		TCHAR* Data = Builder.GetData();
+		FMemory::Memmove(Data + Index, Data + Index + Count, (Builder.Len() - Index - Count) * sizeof(TCHAR));
+		Builder.RemoveSuffix(Count);
+	}
+
+	/** Removes every occurrence of the two character Pattern from the builder, scanning the original characters left to right */
+	static void RemoveAll(FStringBuilderBase& Builder, const TCHAR (&Pattern)[3])
+	{
+		TCHAR* Data = Builder.GetData();
+		const int32 Len = Builder.Len();
+		int32 Write = 0;
+		for (int32 Read = 0; Read < Len; ++Read)
+		{
+			if (Read + 1 < Len && Data[Read] == Pattern[0] && Data[Read + 1] == Pattern[1])
+			{
+				++Read;
+				continue;
+			}
+			Data[Write++] = Data[Read];
+		}
+		Builder.RemoveSuffix(Len - Write);
+	}
+
+	/** Replaces backslashes with forward slashes, the first step of FPaths::NormalizeFilename */
+	static void ReplaceBackslashes(FStringBuilderBase& Builder)
+	{
+		TCHAR* Data = Builder.GetData();
+		for (int32 Index = 0, Len = Builder.Len(); Index < Len; ++Index)
+		{
+			if (Data[Index] == TEXT('\\'))
+			{
+				Data[Index] = TEXT('/');
+			}
+		}
+	}
+
+	/** Applies FPlatformMisc::NormalizePath, which only changes paths starting with a home directory, rare enough to allocate for */
+	static void NormalizePlatformPath(FStringBuilderBase& Builder)
+	{
+		if (Builder.Len() && Builder.GetData()[0] == TEXT('~'))
+		{
+			FString Path(Builder.Len(), Builder.GetData());
+			FPlatformMisc::NormalizePath(Path);
+			Builder.Reset();
+			Builder.Append(Path);
+		}
+	}
+
+	/** Appends a path component with the same rules as FString::PathAppend */
+	static void PathAppend(FStringBuilderBase& Builder, const FStringView& Suffix)
+	{
+		const bool bEndsWithSeparator = Builder.Len() == 0 || IsSlashOrBackslash(Builder.LastChar());
+		if (!bEndsWithSeparator && (Suffix.IsEmpty() || Suffix[0] != TEXT('/')))
+		{
+			Builder.Append(TEXT('/'));
+		}
+		Builder.Append(Suffix);
+	}
 }
 
 FStringView FPathViews::GetCleanFilename(const FStringView& InPath)
@@ -84,3 +164,179 @@ void FPathViews::Append(FStringBuilderBase& Builder, const FStringView& Suffix)
 	}
 	Builder.Append(Suffix);
 }
+
+bool FPathViews::IsRelative(const FStringView& InPath)
+{
+	// The same rules as FPaths::IsRelative, which accepts both normalized and unnormalized paths
+	const int32 PathLen = InPath.Len();
+	const bool bIsRooted = PathLen &&
+		((InPath[0] == TEXT('/')) ||
+		(PathLen >= 2 && (
+			((InPath[0] == TEXT('\\')) && (InPath[1] == TEXT('\\')))
+			|| (InPath[1] == TEXT(':') && FChar::IsAlpha(InPath[0]))
+#if WITH_EDITOR
+			|| InPath.StartsWith(TEXT("root:/"), ESearchCase::IgnoreCase)
+#endif // WITH_EDITOR
+			))
+		);
+	return !bIsRooted;
+}
+
+void FPathViews::ChangeExtension(FStringBuilderBase& Builder, const FStringView& InPath, const FStringView& InNewExtension)
+{
+	if (GetExtension(InPath, /*bIncludeDot*/ true).IsEmpty())
+	{
+		Builder.Append(InPath);
+		return;
+	}
+	SetExtension(Builder, InPath, InNewExtension);
+}
+
+void FPathViews::SetExtension(FStringBuilderBase& Builder, const FStringView& InPath, const FStringView& InNewExtension)
+{
+	Builder.Append(GetBaseFilenameWithPath(InPath));
+	if (InNewExtension.Len() && InNewExtension[0] != TEXT('.'))
+	{
+		Builder.Append(TEXT('.'));
+	}
+	Builder.Append(InNewExtension);
+}
+
+void FPathViews::NormalizeFilename(FStringBuilderBase& InOutPath)
+{
+	UE4PathViews_Private::ReplaceBackslashes(InOutPath);
+	UE4PathViews_Private::NormalizePlatformPath(InOutPath);
+}
+
+void FPathViews::NormalizeDirectoryName(FStringBuilderBase& InOutPath)
+{
+	UE4PathViews_Private::ReplaceBackslashes(InOutPath);
+
+	const FStringView Path = InOutPath;
+	if (Path.EndsWith(TEXT('/')) && !Path.EndsWith(TEXT("//"), ESearchCase::CaseSensitive) && !Path.EndsWith(TEXT(":/"), ESearchCase::CaseSensitive))
+	{
+		InOutPath.RemoveSuffix(1);
+	}
+
+	UE4PathViews_Private::NormalizePlatformPath(InOutPath);
+}
+
+bool FPathViews::CollapseRelativeDirectories(FStringBuilderBase& InOutPath)
+{
+	using namespace UE4PathViews_Private;
+
+	constexpr int32 ParentDirLength = 3;
+
+	for (;;)
+	{
+		const TCHAR* Path = InOutPath.GetData();
+		const int32 Len = InOutPath.Len();
+
+		// An empty path is finished
+		if (Len == 0)
+		{
+			break;
+		}
+
+		// Consider paths which start with .. or /.. as invalid
+		const FStringView PathView(Path, Len);
+		if (PathView.StartsWith(TEXT(".."), ESearchCase::CaseSensitive) || PathView.StartsWith(TEXT("/.."), ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+
+		// If there are no "/.."s left then we're done, ignoring folders beginning with dots
+		int32 Index = FindParentDir(Path, Len, 0);
+		while (Index != INDEX_NONE && Len > Index + ParentDirLength && Path[Index + ParentDirLength] != TEXT('/'))
+		{
+			Index = FindParentDir(Path, Len, Index + ParentDirLength);
+		}
+
+		if (Index == INDEX_NONE)
+		{
+			break;
+		}
+
+		int32 PreviousSeparatorIndex = Index;
+		for (;;)
+		{
+			// Find the previous slash, skipping the character before it like FString::Find from the end
+			int32 SearchIndex = PreviousSeparatorIndex - 2;
+			while (SearchIndex >= 0 && Path[SearchIndex] != TEXT('/'))
+			{
+				--SearchIndex;
+			}
+			PreviousSeparatorIndex = FMath::Max(0, SearchIndex);
+
+			// Stop if we've hit the start of the string
+			if (PreviousSeparatorIndex == 0)
+			{
+				break;
+			}
+
+			// Stop if we've found a directory that isn't "/./"
+			if ((Index - PreviousSeparatorIndex) > 1 && (Path[PreviousSeparatorIndex + 1] != TEXT('.') || Path[PreviousSeparatorIndex + 2] != TEXT('/')))
+			{
+				break;
+			}
+		}
+
+		// If we're attempting to remove the drive letter, that's illegal
+		for (int32 ColonIndex = PreviousSeparatorIndex; ColonIndex < Index; ++ColonIndex)
+		{
+			if (Path[ColonIndex] == TEXT(':'))
+			{
+				return false;
+			}
+		}
+
+		RemoveAt(InOutPath, PreviousSeparatorIndex, Index - PreviousSeparatorIndex + ParentDirLength);
+	}
+
+	RemoveAll(InOutPath, TEXT("./"));
+
+	return true;
+}
+
+void FPathViews::RemoveDuplicateSlashes(FStringBuilderBase& InOutPath)
+{
+	TCHAR* Data = InOutPath.GetData();
+	const int32 Len = InOutPath.Len();
+	int32 Write = 0;
+	for (int32 Read = 0; Read < Len; ++Read)
+	{
+		if (Write == 0 || Data[Read] != TEXT('/') || Data[Write - 1] != TEXT('/'))
+		{
+			Data[Write++] = Data[Read];
+		}
+	}
+	InOutPath.RemoveSuffix(Len - Write);
+}
+
+void FPathViews::ConvertRelativePathToFull(FStringBuilderBase& OutPath, const FStringView& InPath)
+{
+	ConvertRelativePathToFull(OutPath, FPlatformProcess::BaseDir(), InPath);
+}
+
+void FPathViews::ConvertRelativePathToFull(FStringBuilderBase& OutPath, const FStringView& BasePath, const FStringView& InPath)
+{
+	OutPath.Reset();
+	if (IsRelative(InPath))
+	{
+		OutPath.Append(BasePath);
+		UE4PathViews_Private::PathAppend(OutPath, InPath);
+	}
+	else
+	{
+		OutPath.Append(InPath);
+	}
+
+	NormalizeFilename(OutPath);
+	CollapseRelativeDirectories(OutPath);
+
+	if (OutPath.Len() == 0)
+	{
+		// Empty path is not absolute, and '/' is the best guess across all the platforms
+		OutPath.Append(TEXT('/'));
+	}
+}
@@ -3,11 +3,76 @@
 #include "Misc/SecureHash.h"
 #include "Misc/StringBuilder.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/AsyncFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Templates/Function.h"
 #include "Misc/Paths.h"
 
 
 DEFINE_LOG_CATEGORY_STATIC(LogSecureHash, Log, All);
 
+namespace UE4SecureHash_Private
+{
+	/** Size of the parts files are read in by the HashFile functions, two of them are in flight per file */
+	static constexpr int64 ReadPartSize = 1024 * 1024;
+
+	/**
+	 * Reads a file in parts with IAsyncReadFileHandle, the read of the next part being issued before Consume is called on the
+	 * previous one, so reading and hashing overlap.
+	 *
+	 * @return false if the file could not be read, in which case Consume may have been called on the start of the file
+	 */
+	static bool ReadFileInParts(const TCHAR* Filename, TFunctionRef<void(const uint8*, int64)> Consume)
+	{
+		IAsyncReadFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(Filename);
+		if (!Handle)
+		{
+			return false;
+		}
+
+		IAsyncReadRequest* SizeRequest = Handle->SizeRequest();
+		SizeRequest->WaitCompletion();
+		const int64 FileSize = SizeRequest->GetSizeResults();
+		delete SizeRequest;
+
+		bool bSucceeded = FileSize >= 0;
+		if (FileSize > 0)
+		{
+			const int64 PartSize = FMath::Min(FileSize, ReadPartSize);
+			TArray<uint8> Buffer;
+			Buffer.SetNumUninitialized((int32)(PartSize * 2));
+			uint8* Parts[2] = { Buffer.GetData(), Buffer.GetData() + PartSize };
+
+			int32 PartIndex = 0;
+			IAsyncReadRequest* Request = Handle->ReadRequest(0, PartSize, AIOP_Normal, nullptr, Parts[PartIndex]);
+			for (int64 Offset = 0; Request; PartIndex ^= 1)
+			{
+				Request->WaitCompletion();
+				const uint8* Data = Request->GetReadResults();
+				delete Request;
+				Request = nullptr;
+				if (!Data)
+				{
+					bSucceeded = false;
+					break;
+				}
+
+				const int64 NextOffset = Offset + FMath::Min(FileSize - Offset, PartSize);
+				if (NextOffset < FileSize)
+				{
+					Request = Handle->ReadRequest(NextOffset, FMath::Min(FileSize - NextOffset, PartSize), AIOP_Normal, nullptr, Parts[PartIndex ^ 1]);
+				}
+				Consume(Data, NextOffset - Offset);
+				Offset = NextOffset;
+			}
+		}
+
+		delete Handle;
+		return bSucceeded;
+	}
+}
+
 
 /*-----------------------------------------------------------------------------
 	MD5 functions, adapted from MD5 RFC by Brandon Reinhart
@@ -566,6 +631,26 @@ FMD5Hash FMD5Hash::HashFileFromArchive( FArchive* Ar, TArray<uint8>* Buffer)
 	return Hash;
 }
 
+void FMD5Hash::HashFiles(TArrayView<const FString> Filenames, TArrayView<FMD5Hash> OutHashes)
+{
+	check(Filenames.Num() == OutHashes.Num());
+
+	ParallelFor(Filenames.Num(), [Filenames, OutHashes](int32 Index)
+	{
+		FMD5 MD5;
+		const bool bSucceeded = UE4SecureHash_Private::ReadFileInParts(*Filenames[Index], [&MD5](const uint8* Data, int64 Size)
+		{
+			MD5.Update(Data, Size);
+		});
+
+		OutHashes[Index] = FMD5Hash();
+		if (bSucceeded)
+		{
+			OutHashes[Index].Set(MD5);
+		}
+	});
+}
+
 
 /*-----------------------------------------------------------------------------
 	SHA-1
@@ -690,6 +775,369 @@ void FSHA1::Transform(uint32 *state, const uint8 *buffer)
 #undef _R3
 #undef _R4
 
+#if PLATFORM_HAS_CPUID && PLATFORM_ENABLE_VECTORINTRINSICS
+	#define UE_SHA1_SHANI 1
+	#include <immintrin.h>
+	#include "HAL/CPUFeatures.h"
+	#define UE_SHA1_SHANI_TARGET UE_CPU_TARGET("sha,ssse3,sse4.1")
+#else
+	#define UE_SHA1_SHANI 0
+#endif
+
+#if !UE_SHA1_SHANI && PLATFORM_ENABLE_VECTORINTRINSICS_NEON && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+	#define UE_SHA1_ARMV8 1
+#else
+	#define UE_SHA1_ARMV8 0
+#endif
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_SHA1_LANES_SSE2 1
+	#define UE_SHA1_LANES_NEON 0
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#define UE_SHA1_LANES_SSE2 0
+	#define UE_SHA1_LANES_NEON 1
+#else
+	#define UE_SHA1_LANES_SSE2 0
+	#define UE_SHA1_LANES_NEON 0
+#endif
+
+#if UE_SHA1_ARMV8 || UE_SHA1_LANES_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace UE4SecureHash_Private
+{
+#if UE_SHA1_ARMV8 || UE_SHA1_LANES_SSE2 || UE_SHA1_LANES_NEON
+	/** SHA-1 round constants, one for each 20 rounds */
+	static constexpr uint32 SHA1K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+#endif
+
+#if UE_SHA1_SHANI
+	static bool HasHardwareSHA1()
+	{
+		return FCPUFeatures::Has(ECPUFeatures::SHA | ECPUFeatures::SSSE3 | ECPUFeatures::SSE41);
+	}
+
+	/** Transforms consecutive blocks with the SHA extensions, giving the same state as as many calls to FSHA1::Transform */
+	UE_SHA1_SHANI_TARGET static void TransformBlocksHardware(uint32* State, const uint8* Blocks, uint64 NumBlocks)
+	{
+		// The words are kept in reverse order, A in the highest lane, which is what the instructions expect
+		const __m128i ByteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+		__m128i ABCD = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)State), 0x1B);
+		__m128i E0 = _mm_set_epi32((int32)State[4], 0, 0, 0);
+
+		for (; NumBlocks; --NumBlocks, Blocks += 64)
+		{
+			const __m128i SavedABCD = ABCD;
+			const __m128i SavedE = E0;
+
+			__m128i Msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)Blocks), ByteSwap);
+			__m128i Msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(Blocks + 16)), ByteSwap);
+			__m128i Msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(Blocks + 32)), ByteSwap);
+			__m128i Msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(Blocks + 48)), ByteSwap);
+			__m128i E1;
+
+			// Each step does 4 rounds, E0 holds ABCD from before the previous step which gives the next E once rotated
+			#define UE_SHA1_SHANI_SCHEDULE(M0, M1, M2, M3) M0 = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(M0, M1), M2), M3)
+			#define UE_SHA1_SHANI_ROUNDS(Func, Msg) E1 = ABCD; ABCD = _mm_sha1rnds4_epu32(ABCD, _mm_sha1nexte_epu32(E0, Msg), Func); E0 = E1
+
+			E1 = ABCD;
+			ABCD = _mm_sha1rnds4_epu32(ABCD, _mm_add_epi32(E0, Msg0), 0);
+			E0 = E1;
+			UE_SHA1_SHANI_ROUNDS(0, Msg1);
+			UE_SHA1_SHANI_ROUNDS(0, Msg2);
+			UE_SHA1_SHANI_ROUNDS(0, Msg3);
+			UE_SHA1_SHANI_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_SHANI_ROUNDS(0, Msg0);
+			UE_SHA1_SHANI_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_SHANI_ROUNDS(1, Msg1);
+			UE_SHA1_SHANI_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_SHANI_ROUNDS(1, Msg2);
+			UE_SHA1_SHANI_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_SHANI_ROUNDS(1, Msg3);
+			UE_SHA1_SHANI_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_SHANI_ROUNDS(1, Msg0);
+			UE_SHA1_SHANI_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_SHANI_ROUNDS(1, Msg1);
+			UE_SHA1_SHANI_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_SHANI_ROUNDS(2, Msg2);
+			UE_SHA1_SHANI_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_SHANI_ROUNDS(2, Msg3);
+			UE_SHA1_SHANI_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_SHANI_ROUNDS(2, Msg0);
+			UE_SHA1_SHANI_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_SHANI_ROUNDS(2, Msg1);
+			UE_SHA1_SHANI_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_SHANI_ROUNDS(2, Msg2);
+			UE_SHA1_SHANI_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_SHANI_ROUNDS(3, Msg3);
+			UE_SHA1_SHANI_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_SHANI_ROUNDS(3, Msg0);
+			UE_SHA1_SHANI_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_SHANI_ROUNDS(3, Msg1);
+			UE_SHA1_SHANI_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_SHANI_ROUNDS(3, Msg2);
+			UE_SHA1_SHANI_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_SHANI_ROUNDS(3, Msg3);
+
+			#undef UE_SHA1_SHANI_ROUNDS
+			#undef UE_SHA1_SHANI_SCHEDULE
+
+			E0 = _mm_sha1nexte_epu32(E0, SavedE);
+			ABCD = _mm_add_epi32(ABCD, SavedABCD);
+		}
+
+		_mm_storeu_si128((__m128i*)State, _mm_shuffle_epi32(ABCD, 0x1B));
+		State[4] = (uint32)_mm_extract_epi32(E0, 3);
+	}
+
+#elif UE_SHA1_ARMV8
+	static bool HasHardwareSHA1()
+	{
+		return true;
+	}
+
+	/** Transforms consecutive blocks with the ARMv8 SHA1 instructions, giving the same state as as many calls to FSHA1::Transform */
+	static void TransformBlocksHardware(uint32* State, const uint8* Blocks, uint64 NumBlocks)
+	{
+		uint32x4_t ABCD = vld1q_u32(State);
+		uint32 E0 = State[4];
+
+		for (; NumBlocks; --NumBlocks, Blocks += 64)
+		{
+			const uint32x4_t SavedABCD = ABCD;
+			const uint32 SavedE = E0;
+
+			uint32x4_t Msg0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks)));
+			uint32x4_t Msg1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks + 16)));
+			uint32x4_t Msg2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks + 32)));
+			uint32x4_t Msg3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks + 48)));
+			uint32 E1;
+
+			// Each step does 4 rounds, the next E being A rotated from before the step
+			#define UE_SHA1_ARMV8_SCHEDULE(M0, M1, M2, M3) M0 = vsha1su1q_u32(vsha1su0q_u32(M0, M1, M2), M3)
+			#define UE_SHA1_ARMV8_ROUNDS(Op, Round, Msg) E1 = vsha1h_u32(vgetq_lane_u32(ABCD, 0)); ABCD = Op(ABCD, E0, vaddq_u32(Msg, vdupq_n_u32(SHA1K[Round]))); E0 = E1
+
+			UE_SHA1_ARMV8_ROUNDS(vsha1cq_u32, 0, Msg0);
+			UE_SHA1_ARMV8_ROUNDS(vsha1cq_u32, 0, Msg1);
+			UE_SHA1_ARMV8_ROUNDS(vsha1cq_u32, 0, Msg2);
+			UE_SHA1_ARMV8_ROUNDS(vsha1cq_u32, 0, Msg3);
+			UE_SHA1_ARMV8_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_ARMV8_ROUNDS(vsha1cq_u32, 0, Msg0);
+			UE_SHA1_ARMV8_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 1, Msg1);
+			UE_SHA1_ARMV8_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 1, Msg2);
+			UE_SHA1_ARMV8_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 1, Msg3);
+			UE_SHA1_ARMV8_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 1, Msg0);
+			UE_SHA1_ARMV8_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 1, Msg1);
+			UE_SHA1_ARMV8_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_ARMV8_ROUNDS(vsha1mq_u32, 2, Msg2);
+			UE_SHA1_ARMV8_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_ARMV8_ROUNDS(vsha1mq_u32, 2, Msg3);
+			UE_SHA1_ARMV8_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_ARMV8_ROUNDS(vsha1mq_u32, 2, Msg0);
+			UE_SHA1_ARMV8_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_ARMV8_ROUNDS(vsha1mq_u32, 2, Msg1);
+			UE_SHA1_ARMV8_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_ARMV8_ROUNDS(vsha1mq_u32, 2, Msg2);
+			UE_SHA1_ARMV8_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 3, Msg3);
+			UE_SHA1_ARMV8_SCHEDULE(Msg0, Msg1, Msg2, Msg3); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 3, Msg0);
+			UE_SHA1_ARMV8_SCHEDULE(Msg1, Msg2, Msg3, Msg0); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 3, Msg1);
+			UE_SHA1_ARMV8_SCHEDULE(Msg2, Msg3, Msg0, Msg1); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 3, Msg2);
+			UE_SHA1_ARMV8_SCHEDULE(Msg3, Msg0, Msg1, Msg2); UE_SHA1_ARMV8_ROUNDS(vsha1pq_u32, 3, Msg3);
+
+			#undef UE_SHA1_ARMV8_ROUNDS
+			#undef UE_SHA1_ARMV8_SCHEDULE
+
+			ABCD = vaddq_u32(ABCD, SavedABCD);
+			E0 += SavedE;
+		}
+
+		vst1q_u32(State, ABCD);
+		State[4] = E0;
+	}
+#endif
+
+#if UE_SHA1_LANES_SSE2 || UE_SHA1_LANES_NEON
+	/** Number of buffers hashed together by TransformLanes */
+	static constexpr int32 NumLanes = 4;
+
+#if UE_SHA1_LANES_SSE2
+	using FLaneVector = __m128i;
+
+	FORCEINLINE FLaneVector LaneAdd(FLaneVector A, FLaneVector B) { return _mm_add_epi32(A, B); }
+	FORCEINLINE FLaneVector LaneXor(FLaneVector A, FLaneVector B) { return _mm_xor_si128(A, B); }
+	FORCEINLINE FLaneVector LaneChoose(FLaneVector Mask, FLaneVector A, FLaneVector B) { return _mm_or_si128(_mm_and_si128(Mask, A), _mm_andnot_si128(Mask, B)); }
+	FORCEINLINE FLaneVector LaneMajority(FLaneVector A, FLaneVector B, FLaneVector C) { return _mm_or_si128(_mm_and_si128(A, B), _mm_and_si128(C, _mm_or_si128(A, B))); }
+	FORCEINLINE FLaneVector LaneSplat(uint32 Value) { return _mm_set1_epi32((int32)Value); }
+	template <int32 Bits>
+	FORCEINLINE FLaneVector LaneRotate(FLaneVector A) { return _mm_or_si128(_mm_slli_epi32(A, Bits), _mm_srli_epi32(A, 32 - Bits)); }
+
+	/** Loads 16 bytes from each lane and transposes them into 4 big endian words, word X of each lane in vector X */
+	FORCEINLINE void LaneLoadWords(const uint8* const* Lanes, int32 Offset, FLaneVector* OutWords)
+	{
+		__m128i Rows[NumLanes];
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			// SSE2 has no byte shuffle, so swap the 16 bit halves then the bytes within them
+			__m128i Row = _mm_loadu_si128((const __m128i*)(Lanes[Lane] + Offset));
+			Row = _mm_shufflehi_epi16(_mm_shufflelo_epi16(Row, 0xB1), 0xB1);
+			Rows[Lane] = _mm_or_si128(_mm_slli_epi16(Row, 8), _mm_srli_epi16(Row, 8));
+		}
+		const __m128i Low01 = _mm_unpacklo_epi32(Rows[0], Rows[1]);
+		const __m128i Low23 = _mm_unpacklo_epi32(Rows[2], Rows[3]);
+		const __m128i High01 = _mm_unpackhi_epi32(Rows[0], Rows[1]);
+		const __m128i High23 = _mm_unpackhi_epi32(Rows[2], Rows[3]);
+		OutWords[0] = _mm_unpacklo_epi64(Low01, Low23);
+		OutWords[1] = _mm_unpackhi_epi64(Low01, Low23);
+		OutWords[2] = _mm_unpacklo_epi64(High01, High23);
+		OutWords[3] = _mm_unpackhi_epi64(High01, High23);
+	}
+
+	FORCEINLINE FLaneVector LaneLoadState(const uint32 (*States)[5], int32 Word)
+	{
+		return _mm_set_epi32((int32)States[3][Word], (int32)States[2][Word], (int32)States[1][Word], (int32)States[0][Word]);
+	}
+
+	FORCEINLINE void LaneStoreState(uint32 (*States)[5], int32 Word, FLaneVector Value)
+	{
+		alignas(16) uint32 Words[NumLanes];
+		_mm_store_si128((__m128i*)Words, Value);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			States[Lane][Word] = Words[Lane];
+		}
+	}
+#else
+	using FLaneVector = uint32x4_t;
+
+	FORCEINLINE FLaneVector LaneAdd(FLaneVector A, FLaneVector B) { return vaddq_u32(A, B); }
+	FORCEINLINE FLaneVector LaneXor(FLaneVector A, FLaneVector B) { return veorq_u32(A, B); }
+	FORCEINLINE FLaneVector LaneChoose(FLaneVector Mask, FLaneVector A, FLaneVector B) { return vbslq_u32(Mask, A, B); }
+	FORCEINLINE FLaneVector LaneMajority(FLaneVector A, FLaneVector B, FLaneVector C) { return vbslq_u32(veorq_u32(A, B), C, A); }
+	FORCEINLINE FLaneVector LaneSplat(uint32 Value) { return vdupq_n_u32(Value); }
+	template <int32 Bits>
+	FORCEINLINE FLaneVector LaneRotate(FLaneVector A) { return vsriq_n_u32(vshlq_n_u32(A, Bits), A, 32 - Bits); }
+
+	/** Loads 16 bytes from each lane and transposes them into 4 big endian words, word X of each lane in vector X */
+	FORCEINLINE void LaneLoadWords(const uint8* const* Lanes, int32 Offset, FLaneVector* OutWords)
+	{
+		uint32x4_t Rows[NumLanes];
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Rows[Lane] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Lanes[Lane] + Offset)));
+		}
+		const uint32x4x2_t Rows01 = vtrnq_u32(Rows[0], Rows[1]);
+		const uint32x4x2_t Rows23 = vtrnq_u32(Rows[2], Rows[3]);
+		OutWords[0] = vcombine_u32(vget_low_u32(Rows01.val[0]), vget_low_u32(Rows23.val[0]));
+		OutWords[1] = vcombine_u32(vget_low_u32(Rows01.val[1]), vget_low_u32(Rows23.val[1]));
+		OutWords[2] = vcombine_u32(vget_high_u32(Rows01.val[0]), vget_high_u32(Rows23.val[0]));
+		OutWords[3] = vcombine_u32(vget_high_u32(Rows01.val[1]), vget_high_u32(Rows23.val[1]));
+	}
+
+	FORCEINLINE FLaneVector LaneLoadState(const uint32 (*States)[5], int32 Word)
+	{
+		const uint32 Words[NumLanes] = { States[0][Word], States[1][Word], States[2][Word], States[3][Word] };
+		return vld1q_u32(Words);
+	}
+
+	FORCEINLINE void LaneStoreState(uint32 (*States)[5], int32 Word, FLaneVector Value)
+	{
+		uint32 Words[NumLanes];
+		vst1q_u32(Words, Value);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			States[Lane][Word] = Words[Lane];
+		}
+	}
+#endif
+
+	/** Does one of the 80 rounds, in the same way as the _R0 to _R4 macros, the callers rotating the state variables */
+	template <int32 Round>
+	FORCEINLINE void LaneRound(FLaneVector A, FLaneVector& B, FLaneVector C, FLaneVector D, FLaneVector& E, FLaneVector* W)
+	{
+		FLaneVector Word;
+		if (Round < 16)
+		{
+			Word = W[Round];
+		}
+		else
+		{
+			Word = LaneRotate<1>(LaneXor(LaneXor(W[(Round + 13) & 15], W[(Round + 8) & 15]), LaneXor(W[(Round + 2) & 15], W[Round & 15])));
+			W[Round & 15] = Word;
+		}
+
+		FLaneVector Func;
+		if (Round < 20)
+		{
+			Func = LaneChoose(B, C, D);
+		}
+		else if (Round < 40 || Round >= 60)
+		{
+			Func = LaneXor(LaneXor(B, C), D);
+		}
+		else
+		{
+			Func = LaneMajority(B, C, D);
+		}
+
+		E = LaneAdd(LaneAdd(E, LaneRotate<5>(A)), LaneAdd(LaneAdd(Func, Word), LaneSplat(SHA1K[Round / 20])));
+		B = LaneRotate<30>(B);
+	}
+
+	/**
+	 * Transforms the same number of blocks of 4 independent buffers at once, each buffer in one lane of the vectors.
+	 * Gives the same states as calling FSHA1::Transform on each buffer.
+	 */
+	static void TransformLanes(uint32 (*States)[5], const uint8* const* Lanes, uint64 NumBlocks)
+	{
+		FLaneVector A = LaneLoadState(States, 0);
+		FLaneVector B = LaneLoadState(States, 1);
+		FLaneVector C = LaneLoadState(States, 2);
+		FLaneVector D = LaneLoadState(States, 3);
+		FLaneVector E = LaneLoadState(States, 4);
+
+		for (uint64 Offset = 0; NumBlocks; --NumBlocks, Offset += 64)
+		{
+			const uint8* Blocks[NumLanes] = { Lanes[0] + Offset, Lanes[1] + Offset, Lanes[2] + Offset, Lanes[3] + Offset };
+			FLaneVector W[16];
+			for (int32 Part = 0; Part < 4; ++Part)
+			{
+				LaneLoadWords(Blocks, Part * 16, W + Part * 4);
+			}
+
+			const FLaneVector SavedA = A, SavedB = B, SavedC = C, SavedD = D, SavedE = E;
+
+			#define UE_SHA1_LANE_ROUNDS(Round) \
+				LaneRound<Round + 0>(A, B, C, D, E, W); LaneRound<Round + 1>(E, A, B, C, D, W); LaneRound<Round + 2>(D, E, A, B, C, W); \
+				LaneRound<Round + 3>(C, D, E, A, B, W); LaneRound<Round + 4>(B, C, D, E, A, W)
+
+			UE_SHA1_LANE_ROUNDS(0); UE_SHA1_LANE_ROUNDS(5); UE_SHA1_LANE_ROUNDS(10); UE_SHA1_LANE_ROUNDS(15);
+			UE_SHA1_LANE_ROUNDS(20); UE_SHA1_LANE_ROUNDS(25); UE_SHA1_LANE_ROUNDS(30); UE_SHA1_LANE_ROUNDS(35);
+			UE_SHA1_LANE_ROUNDS(40); UE_SHA1_LANE_ROUNDS(45); UE_SHA1_LANE_ROUNDS(50); UE_SHA1_LANE_ROUNDS(55);
+			UE_SHA1_LANE_ROUNDS(60); UE_SHA1_LANE_ROUNDS(65); UE_SHA1_LANE_ROUNDS(70); UE_SHA1_LANE_ROUNDS(75);
+
+			#undef UE_SHA1_LANE_ROUNDS
+
+			A = LaneAdd(A, SavedA);
+			B = LaneAdd(B, SavedB);
+			C = LaneAdd(C, SavedC);
+			D = LaneAdd(D, SavedD);
+			E = LaneAdd(E, SavedE);
+		}
+
+		LaneStoreState(States, 0, A);
+		LaneStoreState(States, 1, B);
+		LaneStoreState(States, 2, C);
+		LaneStoreState(States, 3, D);
+		LaneStoreState(States, 4, E);
+	}
+#endif
+}
+
+void FSHA1::TransformBlocks(uint32 *state, const uint8 *blocks, uint64 numBlocks)
+{
+#if UE_SHA1_SHANI || UE_SHA1_ARMV8
+	if (UE4SecureHash_Private::HasHardwareSHA1())
+	{
+		UE4SecureHash_Private::TransformBlocksHardware(state, blocks, numBlocks);
+		return;
+	}
+#endif
+
+	for (; numBlocks; --numBlocks, blocks += 64)
+	{
+		Transform(state, blocks);
+	}
+}
+
+bool FSHA1::IsHardwareAccelerated()
+{
+#if UE_SHA1_SHANI || UE_SHA1_ARMV8
+	return UE4SecureHash_Private::HasHardwareSHA1();
+#else
+	return false;
+#endif
+}
+
 // Use this function to hash in binary data
 void FSHA1::Update(const uint8 *data, uint64 len)
 {
@@ -706,9 +1154,11 @@ void FSHA1::Update(const uint8 *data, uint64 len)
 	{
 		i = 64 - j;
 		FMemory::Memcpy(&m_buffer[j], data, i);
-		Transform(m_state, m_buffer);
+		TransformBlocks(m_state, m_buffer, 1);
 
-		for( ; i + 63 < len; i += 64) Transform(m_state, &data[i]);
+		const uint64 numBlocks = (len - i) / 64;
+		TransformBlocks(m_state, &data[i], numBlocks);
+		i += numBlocks * 64;
 
 		j = 0;
 	}
@@ -828,6 +1278,118 @@ void FSHA1::HMACBuffer(const void* Key, uint32 KeySize, const void* Data, uint64
 	HashBuffer(OKeyPad_IHash, UE_ARRAY_COUNT(OKeyPad_IHash), OutHash);
 }
 
+void FSHA1::HashBuffers(TArrayView<const TArrayView<const uint8>> Buffers, TArrayView<FSHAHash> OutHashes)
+{
+	check(Buffers.Num() == OutHashes.Num());
+
+	// Hashes what follows the first NumBlocks blocks of a buffer, which were already transformed into State
+	auto FinishBuffer = [](const TArrayView<const uint8>& Buffer, const uint32 (&State)[5], uint64 NumBlocks, FSHAHash& OutHash)
+	{
+		FSHA1 Sha;
+		FMemory::Memcpy(Sha.m_state, State, sizeof(State));
+		const uint64 NumBits = NumBlocks * 512;
+		Sha.m_count[0] = uint32(NumBits);
+		Sha.m_count[1] = uint32(NumBits >> 32);
+		Sha.Update(Buffer.GetData() + NumBlocks * 64, Buffer.Num() - NumBlocks * 64);
+		Sha.Final();
+		Sha.GetHash(OutHash.Hash);
+	};
+
+	const FSHA1 Initial;
+
+#if UE_SHA1_LANES_SSE2 || UE_SHA1_LANES_NEON
+	if (!IsHardwareAccelerated())
+	{
+		using namespace UE4SecureHash_Private;
+
+		// Sort by size so each group of lanes runs together for as long as possible
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Buffers.Num());
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			Order[Index] = Index;
+		}
+		Order.Sort([Buffers](int32 A, int32 B) { return Buffers[A].Num() > Buffers[B].Num(); });
+
+		ParallelFor((Buffers.Num() + NumLanes - 1) / NumLanes, [Buffers, OutHashes, &Order, &Initial, &FinishBuffer](int32 Group)
+		{
+			const int32 First = Group * NumLanes;
+			const int32 NumInGroup = FMath::Min(NumLanes, Buffers.Num() - First);
+
+			uint32 States[NumLanes][5];
+			const uint8* Lanes[NumLanes];
+			for (int32 Lane = 0; Lane < NumInGroup; ++Lane)
+			{
+				FMemory::Memcpy(States[Lane], Initial.m_state, sizeof(States[Lane]));
+				Lanes[Lane] = Buffers[Order[First + Lane]].GetData();
+			}
+
+			// The last buffer of a group is the shortest, a group short of buffers is hashed one buffer at a time
+			const uint64 NumBlocks = NumInGroup == NumLanes ? Buffers[Order[First + NumLanes - 1]].Num() / 64 : 0;
+			if (NumBlocks)
+			{
+				TransformLanes(States, Lanes, NumBlocks);
+			}
+
+			for (int32 Lane = 0; Lane < NumInGroup; ++Lane)
+			{
+				const int32 Index = Order[First + Lane];
+				FinishBuffer(Buffers[Index], States[Lane], NumBlocks, OutHashes[Index]);
+			}
+		});
+		return;
+	}
+#endif
+
+	ParallelFor(Buffers.Num(), [Buffers, OutHashes, &Initial, &FinishBuffer](int32 Index)
+	{
+		FinishBuffer(Buffers[Index], Initial.m_state, 0, OutHashes[Index]);
+	});
+}
+
+bool FSHA1::HashFile(const TCHAR* Filename, FSHAHash& OutHash)
+{
+	FSHA1 Sha;
+	const bool bSucceeded = UE4SecureHash_Private::ReadFileInParts(Filename, [&Sha](const uint8* Data, int64 Size)
+	{
+		Sha.Update(Data, Size);
+	});
+
+	OutHash = FSHAHash();
+	if (bSucceeded)
+	{
+		Sha.Final();
+		Sha.GetHash(OutHash.Hash);
+	}
+	return bSucceeded;
+}
+
+bool FSHA1::HashFiles(TArrayView<const FString> Filenames, TArrayView<FSHAHash> OutHashes, TArray<int32>* OutFailedIndices)
+{
+	check(Filenames.Num() == OutHashes.Num());
+
+	TArray<bool> Succeeded;
+	Succeeded.SetNumZeroed(Filenames.Num());
+	ParallelFor(Filenames.Num(), [Filenames, OutHashes, &Succeeded](int32 Index)
+	{
+		Succeeded[Index] = HashFile(*Filenames[Index], OutHashes[Index]);
+	});
+
+	bool bAllSucceeded = true;
+	for (int32 Index = 0; Index < Succeeded.Num(); ++Index)
+	{
+		if (!Succeeded[Index])
+		{
+			bAllSucceeded = false;
+			if (OutFailedIndices)
+			{
+				OutFailedIndices->Add(Index);
+			}
+		}
+	}
+	return bAllSucceeded;
+}
+
 
 /**
  * Shared hashes.sha reading code (each platform gets a buffer to the data,
@@ -2,6 +2,7 @@
 
 #include "Misc/TextFilterExpressionEvaluator.h"
 #include "Math/BasicMathExpressionEvaluator.h"
+#include "Async/ParallelFor.h"
 
 namespace TextFilterExpressionParser
 {
@@ -235,6 +236,42 @@ public:
 	}
 };
 
+namespace UE4TextFilterExpressionEvaluator_Private
+{
+	/** Number of column strings tested per task, a multiple of the bits of a bit array word so that no two tasks write to the same word */
+	static const int32 ColumnChunkSize = 4096;
+	static_assert(ColumnChunkSize % NumBitsPerDWORD == 0, "Column chunks must not share bit array words");
+
+	/** Context testing the basic string terms of a filter against one string of a column */
+	class FColumnStringContext : public ITextFilterExpressionContext
+	{
+	public:
+		explicit FColumnStringContext(const FTextFilterStringColumn& InColumn)
+			: Column(InColumn)
+		{
+		}
+
+		void SetStringIndex(const int32 InStringIndex)
+		{
+			StringIndex = InStringIndex;
+		}
+
+		virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+		{
+			return Column.CompareText(StringIndex, InValue, InTextComparisonMode);
+		}
+
+		virtual bool TestComplexExpression(const FName& InKey, const FTextFilterString& InValue, const ETextFilterComparisonOperation InComparisonOperation, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+		{
+			return false;
+		}
+
+	private:
+		const FTextFilterStringColumn& Column;
+		int32 StringIndex = 0;
+	};
+}
+
 FTextFilterExpressionEvaluator::FTextFilterExpressionEvaluator(const ETextFilterExpressionEvaluatorMode InMode)
 	: ExpressionEvaluatorMode(InMode)
 	, FilterType(ETextFilterExpressionType::Empty)
@@ -489,6 +526,54 @@ bool FTextFilterExpressionEvaluator::TestTextFilter(const ITextFilterExpressionC
 	return false;
 }
 
+void FTextFilterExpressionEvaluator::TestTextFilters(TArrayView<const ITextFilterExpressionContext* const> InContexts, TBitArray<>& OutResults) const
+{
+	if (FilterType == ETextFilterExpressionType::Empty || !CompiledFilter.IsSet())
+	{
+		OutResults.Init(FilterType == ETextFilterExpressionType::Empty, InContexts.Num());
+		return;
+	}
+
+	OutResults.Init(false, InContexts.Num());
+	for (int32 ContextIndex = 0; ContextIndex < InContexts.Num(); ++ContextIndex)
+	{
+		if (EvaluateCompiledExpression(CompiledFilter.GetValue(), *InContexts[ContextIndex], nullptr))
+		{
+			OutResults[ContextIndex] = true;
+		}
+	}
+}
+
+void FTextFilterExpressionEvaluator::TestTextFilterColumn(const FTextFilterStringColumn& InColumn, TBitArray<>& OutResults) const
+{
+	using namespace UE4TextFilterExpressionEvaluator_Private;
+
+	if (FilterType == ETextFilterExpressionType::Empty || !CompiledFilter.IsSet())
+	{
+		OutResults.Init(FilterType == ETextFilterExpressionType::Empty, InColumn.Num());
+		return;
+	}
+
+	OutResults.Init(false, InColumn.Num());
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(InColumn.Num(), ColumnChunkSize);
+	const EParallelForFlags ParallelForFlags = TokenFunctionHandlers.Num() > 0 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	ParallelFor(NumChunks, [this, &InColumn, &OutResults](int32 ChunkIndex)
+	{
+		FColumnStringContext Context(InColumn);
+
+		const int32 ChunkEnd = FMath::Min((ChunkIndex + 1) * ColumnChunkSize, InColumn.Num());
+		for (int32 StringIndex = ChunkIndex * ColumnChunkSize; StringIndex < ChunkEnd; ++StringIndex)
+		{
+			Context.SetStringIndex(StringIndex);
+			if (EvaluateCompiledExpression(CompiledFilter.GetValue(), Context, nullptr))
+			{
+				OutResults[StringIndex] = true;
+			}
+		}
+	}, ParallelForFlags);
+}
+
 void FTextFilterExpressionEvaluator::AddFunctionTokenCallback(FString InFunctionName, FTokenFunctionHandler InCallback)
 {
 	TokenFunctionHandlers.Add(InFunctionName, InCallback);
@@ -408,3 +408,96 @@ bool TextFilterUtils::TestComplexExpression(const FTextFilterString& InValue1, c
 
 	return false;
 }
+
+namespace TextFilterInternal
+{
+	/** Find the needle in the haystack, testing the first and last characters of each position before comparing the rest of it */
+	static bool ContainsString(const TCHAR* Haystack, const int32 HaystackLength, const TCHAR* Needle, const int32 NeedleLength)
+	{
+		if (NeedleLength == 0)
+		{
+			return true;
+		}
+		if (HaystackLength < NeedleLength)
+		{
+			return false;
+		}
+
+		const TCHAR FirstChar = Needle[0];
+		const TCHAR LastChar = Needle[NeedleLength - 1];
+		const int32 NumInnerChars = FMath::Max(NeedleLength - 2, 0);
+
+		const TCHAR* LastCandidate = Haystack + (HaystackLength - NeedleLength);
+		for (const TCHAR* Candidate = Haystack; Candidate <= LastCandidate; ++Candidate)
+		{
+			if (Candidate[0] == FirstChar && Candidate[NeedleLength - 1] == LastChar && FMemory::Memcmp(Candidate + 1, Needle + 1, NumInnerChars * sizeof(TCHAR)) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+} // namespace TextFilterInternal
+
+FTextFilterStringColumn::FTextFilterStringColumn(TArrayView<const FString> InStrings)
+{
+	int32 NumChars = 0;
+	for (const FString& String : InStrings)
+	{
+		NumChars += String.Len();
+	}
+
+	Reserve(InStrings.Num(), NumChars);
+	for (const FString& String : InStrings)
+	{
+		Add(String);
+	}
+}
+
+void FTextFilterStringColumn::Reserve(const int32 InNumStrings, const int32 InNumChars)
+{
+	StringStarts.Reserve(InNumStrings);
+	Chars.Reserve(InNumChars);
+}
+
+int32 FTextFilterStringColumn::Add(const FStringView& InString)
+{
+	const int32 Start = Chars.AddUninitialized(InString.Len());
+	TCHAR* Dest = Chars.GetData() + Start;
+	for (const TCHAR Char : InString)
+	{
+		*Dest++ = FastToUpper::ToUpper(Char);
+	}
+
+	return StringStarts.Add(Start);
+}
+
+void FTextFilterStringColumn::Empty()
+{
+	Chars.Empty();
+	StringStarts.Empty();
+}
+
+bool FTextFilterStringColumn::CompareText(const int32 InIndex, const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const
+{
+	// Both strings are uppercase already, and the lengths of the column strings are known, so the comparisons are plain memory compares
+	const FStringView String = GetString(InIndex);
+	const FString& Find = InValue.AsString();
+
+	switch (InTextComparisonMode)
+	{
+	case ETextFilterTextComparisonMode::Exact:
+		return String.Len() == Find.Len() && FMemory::Memcmp(String.GetData(), *Find, Find.Len() * sizeof(TCHAR)) == 0;
+	case ETextFilterTextComparisonMode::Partial:
+		return TextFilterInternal::ContainsString(String.GetData(), String.Len(), *Find, Find.Len());
+	case ETextFilterTextComparisonMode::StartsWith:
+		return Find.Len() > 0 && String.Len() >= Find.Len() && FMemory::Memcmp(String.GetData(), *Find, Find.Len() * sizeof(TCHAR)) == 0;
+	case ETextFilterTextComparisonMode::EndsWith:
+		return String.Len() > 0 && String.Len() >= Find.Len() && FMemory::Memcmp(String.GetData() + (String.Len() - Find.Len()), *Find, Find.Len() * sizeof(TCHAR)) == 0;
+	default:
+		break;
+	}
+
+	return false;
+}
@@ -15,6 +15,11 @@
 #include "Misc/FileHelper.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogModuleManager, Log, All);
 
@@ -26,6 +31,19 @@ DEFINE_LOG_CATEGORY_STATIC(LogModuleManager, Log, All);
 
 int32 FModuleManager::FModuleInfo::CurrentLoadOrder = 1;
 
+namespace UE4ModuleManager_Private
+{
+	static int32 GPrefetchModuleFiles = 1;
+	static FAutoConsoleVariableRef CVarPrefetchModuleFiles(
+		TEXT("Module.PrefetchModuleFiles"),
+		GPrefetchModuleFiles,
+		TEXT("When non-zero, PrefetchModules reads the files of modules about to be loaded on worker threads so that the OS loader finds them cached."),
+		ECVF_Default);
+
+	/** Size of the reads that bring a module file into the OS file cache */
+	static const int64 PrefetchReadSize = 1024 * 1024;
+}
+
 void FModuleManager::WarnIfItWasntSafeToLoadHere(const FName InModuleName)
 {
 	if ( !IsInGameThread() )
@@ -343,6 +361,61 @@ IModuleInterface& FModuleManager::LoadModuleChecked( const FName InModuleName )
 }
 
 
+void FModuleManager::PrefetchModules(TArrayView<const FName> InModuleNames)
+{
+#if !IS_MONOLITHIC
+	if (!UE4ModuleManager_Private::GPrefetchModuleFiles || !FTaskGraphInterface::IsRunning() || !FApp::ShouldUseThreadingForPerformance())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModuleManager_PrefetchModules);
+
+	// Resolving the file names touches the module list, so it stays on this thread
+	ProcessPendingStaticallyLinkedModuleInitializers();
+
+	TArray<FString> ModuleFilenames;
+	ModuleFilenames.Reserve(InModuleNames.Num());
+	for (const FName ModuleName : InModuleNames)
+	{
+		if (IsModuleLoaded(ModuleName) || StaticallyLinkedModuleInitializers.Contains(ModuleName))
+		{
+			continue;
+		}
+
+		AddModule(ModuleName);
+
+		ModuleInfoPtr ModuleInfo = FindModule(ModuleName);
+		if (ModuleInfo.IsValid() && !ModuleInfo->Filename.IsEmpty())
+		{
+			ModuleFilenames.Add(FPaths::ConvertRelativePathToFull(ModuleInfo->Filename));
+		}
+	}
+
+	// The data read is thrown away, only the pages the OS keeps cached for the loader matter
+	ParallelFor(ModuleFilenames.Num(), [&ModuleFilenames](int32 Index)
+	{
+		TUniquePtr<IFileHandle> FileHandle(IPlatformFile::GetPlatformPhysical().OpenRead(*ModuleFilenames[Index]));
+		if (!FileHandle)
+		{
+			return;
+		}
+
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized((int32)UE4ModuleManager_Private::PrefetchReadSize);
+		for (int64 Remaining = FileHandle->Size(); Remaining > 0; )
+		{
+			const int64 ReadSize = FMath::Min(Remaining, UE4ModuleManager_Private::PrefetchReadSize);
+			if (!FileHandle->Read(Buffer.GetData(), ReadSize))
+			{
+				break;
+			}
+			Remaining -= ReadSize;
+		}
+	}, EParallelForFlags::Unbalanced);
+#endif
+}
+
 IModuleInterface* FModuleManager::LoadModuleWithFailureReason(const FName InModuleName, EModuleLoadResult& OutFailureReason)
 {
 #if 0
@@ -484,7 +557,13 @@ IModuleInterface* FModuleManager::LoadModuleWithFailureReason(const FName InModu
 		// Skip this check if file manager has not yet been initialized
 		if (FPaths::FileExists(ModuleFileToLoad))
 		{
-			ModuleInfo->Handle = FPlatformProcess::GetDllHandle(*ModuleFileToLoad);
+			FScopedBootTiming BootScope("LoadModule  - ", InModuleName);
+			TRACE_LOADTIME_REQUEST_GROUP_SCOPE(TEXT("LoadModule - %s"), *InModuleName.ToString());
+
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FString::Printf(TEXT("GetDllHandle - %s"), *InModuleName.ToString()));
+				ModuleInfo->Handle = FPlatformProcess::GetDllHandle(*ModuleFileToLoad);
+			}
 			if (ModuleInfo->Handle != nullptr)
 			{
 				// First things first.  If the loaded DLL has UObjects in it, then their generated code's
@@ -514,7 +593,10 @@ IModuleInterface* FModuleManager::LoadModuleWithFailureReason(const FName InModu
 						if ( ModuleInfo->Module.IsValid() )
 						{
 							// Startup the module
-							ModuleInfo->Module->StartupModule();
+							{
+								TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*FString::Printf(TEXT("StartupModule - %s"), *InModuleName.ToString()));
+								ModuleInfo->Module->StartupModule();
+							}
 							// The module might try to load other dependent modules in StartupModule. In this case, we want those modules shut down AFTER this one because we may still depend on the module at shutdown.
 							ModuleInfo->LoadOrder = FModuleInfo::CurrentLoadOrder++;
 
@@ -9,6 +9,8 @@
 // Core includes.
 #include "ProfilingDebugging/ABTesting.h"
 #include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 #if ENABLE_ABTEST
 
@@ -45,6 +47,215 @@ static TAutoConsoleVariable<int32> CVarABTestNumResamples(
 	256,
 	TEXT("The number of resamples to use to determine confidence."));
 
+static TAutoConsoleVariable<int32> CVarABTestWarmup(
+	TEXT("abtest.Warmup"),
+	0,
+	TEXT("Number of frames to discard when a test starts, on top of the cool down."));
+
+static TAutoConsoleVariable<int32> CVarABTestRandomizeArms(
+	TEXT("abtest.RandomizeArms"),
+	0,
+	TEXT("If non-zero, each trial runs A or B at random instead of alternating, so periodic load can't line up with one of them."));
+
+static TAutoConsoleVariable<int32> CVarABTestHistogramBins(
+	TEXT("abtest.HistogramBins"),
+	20,
+	TEXT("Number of bins in the frame time histograms of JSON reports."));
+
+static TAutoConsoleVariable<FString> CVarABTestReportFile(
+	TEXT("abtest.ReportFile"),
+	TEXT(""),
+	TEXT("File to write the samples to when a test stops, CSV unless it ends in .json for statistics and histograms. Relative to the profiling directory."));
+
+namespace UE4ABTesting_Private
+{
+	/** Two sided confidence of the intervals reported */
+	static const double Confidence = 0.95;
+
+	/** Summary of one arm's frame times, in milliseconds */
+	struct FArmStatistics
+	{
+		int32 Count = 0;
+		double Mean = 0.0;
+		/** Unbiased sample variance */
+		double Variance = 0.0;
+		double Min = 0.0;
+		double Median = 0.0;
+		double P90 = 0.0;
+		double P99 = 0.0;
+		double Max = 0.0;
+	};
+
+	/** Sorts the samples to find the percentiles */
+	static FArmStatistics ComputeStatistics(TArray<double>& Milliseconds)
+	{
+		FArmStatistics Result;
+		Result.Count = Milliseconds.Num();
+		if (Result.Count == 0)
+		{
+			return Result;
+		}
+
+		Milliseconds.Sort();
+		double Sum = 0.0;
+		for (double Value : Milliseconds)
+		{
+			Sum += Value;
+		}
+		Result.Mean = Sum / Result.Count;
+		double SquaredDeviations = 0.0;
+		for (double Value : Milliseconds)
+		{
+			SquaredDeviations += (Value - Result.Mean) * (Value - Result.Mean);
+		}
+		Result.Variance = Result.Count > 1 ? SquaredDeviations / (Result.Count - 1) : 0.0;
+
+		auto Percentile = [&Milliseconds](double Fraction)
+		{
+			return Milliseconds[FMath::Min(int32(Fraction * Milliseconds.Num()), Milliseconds.Num() - 1)];
+		};
+		Result.Min = Milliseconds[0];
+		Result.Median = Percentile(0.5);
+		Result.P90 = Percentile(0.9);
+		Result.P99 = Percentile(0.99);
+		Result.Max = Milliseconds.Last();
+		return Result;
+	}
+
+	/** The regularized incomplete beta function I_X(A, B), from Lentz's algorithm for its continued fraction */
+	static double IncompleteBeta(double A, double B, double X)
+	{
+		if (X <= 0.0)
+		{
+			return 0.0;
+		}
+		if (X >= 1.0)
+		{
+			return 1.0;
+		}
+		// The continued fraction only converges quickly on this side of the mean
+		if (X > (A + 1.0) / (A + B + 2.0))
+		{
+			return 1.0 - IncompleteBeta(B, A, 1.0 - X);
+		}
+
+		const double Front = exp(log(X) * A + log(1.0 - X) * B - (lgamma(A) + lgamma(B) - lgamma(A + B))) / A;
+		const double Tiny = 1.0e-30;
+		double F = 1.0;
+		double C = 1.0;
+		double D = 0.0;
+		for (int32 Term = 0; Term <= 200; ++Term)
+		{
+			const double M = double(Term / 2);
+			double Numerator;
+			if (Term == 0)
+			{
+				Numerator = 1.0;
+			}
+			else if (Term % 2 == 0)
+			{
+				Numerator = (M * (B - M) * X) / ((A + 2.0 * M - 1.0) * (A + 2.0 * M));
+			}
+			else
+			{
+				Numerator = -((A + M) * (A + B + M) * X) / ((A + 2.0 * M) * (A + 2.0 * M + 1.0));
+			}
+
+			D = 1.0 + Numerator * D;
+			D = 1.0 / (FMath::Abs(D) < Tiny ? Tiny : D);
+			C = 1.0 + Numerator / C;
+			C = FMath::Abs(C) < Tiny ? Tiny : C;
+
+			const double CD = C * D;
+			F *= CD;
+			if (FMath::Abs(1.0 - CD) < 1.0e-10)
+			{
+				break;
+			}
+		}
+		return Front * (F - 1.0);
+	}
+
+	/** The probability of a Student's t distributed value being at least |T| away from zero */
+	static double StudentTPValue(double T, double DegreesOfFreedom)
+	{
+		return IncompleteBeta(DegreesOfFreedom / 2.0, 0.5, DegreesOfFreedom / (DegreesOfFreedom + T * T));
+	}
+
+	/** The T with a two sided p-value of PValue, by bisection */
+	static double StudentTCritical(double PValue, double DegreesOfFreedom)
+	{
+		double Low = 0.0;
+		double High = 1000.0;
+		for (int32 Iteration = 0; Iteration < 64; ++Iteration)
+		{
+			const double Mid = 0.5 * (Low + High);
+			if (StudentTPValue(Mid, DegreesOfFreedom) > PValue)
+			{
+				Low = Mid;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		return 0.5 * (Low + High);
+	}
+
+	/** Welch's t-test of the difference between the arms' means, which doesn't assume they have the same variance */
+	struct FWelchTest
+	{
+		/** Mean of A minus the mean of B, positive when B is faster */
+		double Difference = 0.0;
+		double ConfidenceLow = 0.0;
+		double ConfidenceHigh = 0.0;
+		double T = 0.0;
+		double DegreesOfFreedom = 0.0;
+		double PValue = 1.0;
+	};
+
+	static bool WelchTest(const FArmStatistics& A, const FArmStatistics& B, FWelchTest& Out)
+	{
+		if (A.Count < 2 || B.Count < 2)
+		{
+			return false;
+		}
+
+		const double ErrorA = A.Variance / A.Count;
+		const double ErrorB = B.Variance / B.Count;
+		const double StandardError = sqrt(ErrorA + ErrorB);
+		if (StandardError <= 0.0)
+		{
+			return false;
+		}
+
+		Out.Difference = A.Mean - B.Mean;
+		Out.T = Out.Difference / StandardError;
+		Out.DegreesOfFreedom = FMath::Square(ErrorA + ErrorB) / (FMath::Square(ErrorA) / (A.Count - 1) + FMath::Square(ErrorB) / (B.Count - 1));
+		Out.PValue = StudentTPValue(Out.T, Out.DegreesOfFreedom);
+		const double Margin = StudentTCritical(1.0 - Confidence, Out.DegreesOfFreedom) * StandardError;
+		Out.ConfidenceLow = Out.Difference - Margin;
+		Out.ConfidenceHigh = Out.Difference + Margin;
+		return true;
+	}
+
+	static FString EscapeJson(const FString& String)
+	{
+		return String.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+
+	static FString ArmToJson(const FArmStatistics& Stats, const FString& Command, const TArray<int32>& Histogram)
+	{
+		FString Bins;
+		for (int32 Count : Histogram)
+		{
+			Bins += FString::Printf(TEXT("%s%d"), Bins.Len() ? TEXT(", ") : TEXT(""), Count);
+		}
+		return FString::Printf(TEXT("{ \"Command\": \"%s\", \"Samples\": %d, \"MeanMs\": %f, \"StdDevMs\": %f, \"MinMs\": %f, \"MedianMs\": %f, \"P90Ms\": %f, \"P99Ms\": %f, \"MaxMs\": %f, \"Histogram\": [%s] }"),
+			*EscapeJson(Command), Stats.Count, Stats.Mean, sqrt(Stats.Variance), Stats.Min, Stats.Median, Stats.P90, Stats.P99, Stats.Max, *Bins);
+	}
+}
+
 
 
 FABTest::FABTest()
@@ -52,6 +263,7 @@ FABTest::FABTest()
 		, bABTestActive(false)
 		, bABScopeTestActive(false)
 		, bFrameLog(false)
+		, bRandomizeArms(false)
 		, ABTestNumSamples(0)
 		, RemainingCoolDown(0)
 		, CurrentTest(0)
@@ -216,6 +428,7 @@ const TCHAR* FABTest::TickAndGetCommand()
 					ABTEST_LOG(TEXT("      B is %7.4fms faster than A;  %3.0f%% chance this is noise."), Diff, fConf * 100.0f);
 				}
 
+				LogStatistics();
 				ABTEST_LOG(TEXT("----------------"));
 			}
 			else
@@ -227,7 +440,16 @@ const TCHAR* FABTest::TickAndGetCommand()
 		check(RemainingTrial);
 		if (!--RemainingTrial)
 		{
-			OutCommand = SwitchTest(1 - CurrentTest);
+			const int32 NextTest = bRandomizeArms ? Stream.RandHelper(2) : 1 - CurrentTest;
+			if (NextTest != CurrentTest)
+			{
+				OutCommand = SwitchTest(NextTest);
+			}
+			else
+			{
+				// Same arm again, keep its samples coming without a command or a cool down
+				RemainingTrial = Stream.RandRange(MinFramesPerTrial, MinFramesPerTrial * 3);
+			}
 		}
 	}
 	else if (bFrameLog)
@@ -261,6 +483,11 @@ void FABTest::ABTestCmdFunc(const TArray<FString>& Args)
 		Get().Stop();		
 		return;
 	}
+	if (Args.Num() >= 1 && Args.Num() <= 2 && Args[0].Compare(FString(TEXT("save")), ESearchCase::IgnoreCase) == 0)
+	{
+		Get().WriteReport(Args.Num() == 2 ? Args[1].TrimQuotes() : CVarABTestReportFile.GetValueOnGameThread());
+		return;
+	}
 	if (Args.Num() == 1 && Args[0].Compare(FString(TEXT("scope")), ESearchCase::IgnoreCase) == 0)
 	{
 		ABTestCmds[0] = FString("ScopeA");
@@ -302,7 +529,7 @@ void FABTest::ABTestCmdFunc(const TArray<FString>& Args)
 	}
 	else
 	{
-		ABTEST_LOG(TEXT("abtest command requires two (quoted) arguments or three args or 'stop' or 'scope'."));
+		ABTEST_LOG(TEXT("abtest command requires two (quoted) arguments or three args or 'stop' or 'scope' or 'save [file]'."));
 		ABTEST_LOG(TEXT("Example: abtest \"r.MyCVar 0\" \"r.MyCVar 1\""));
 		ABTEST_LOG(TEXT("Example: abtest r.MyCVar 0 1"));
 		return;
@@ -314,6 +541,11 @@ void FABTest::Stop()
 {
 	if (bABTestActive)
 	{
+		const FString ReportFile = CVarABTestReportFile.GetValueOnGameThread();
+		if (ReportFile.Len())
+		{
+			WriteReport(ReportFile);
+		}
 		ABTEST_LOG(TEXT("Running 'A' console command and stopping test."));
 		SwitchTest(0);
 		bABTestActive = false;
@@ -351,6 +583,7 @@ void FABTest::Start(FString* InABTestCmds, bool bScopeTest)
 	CoolDown = CVarABTestCoolDown.GetValueOnGameThread();
 	MinFramesPerTrial = CVarABTestMinFramesPerTrial.GetValueOnGameThread();
 	NumResamples = CVarABTestNumResamples.GetValueOnGameThread();
+	bRandomizeArms = CVarABTestRandomizeArms.GetValueOnGameThread() != 0;
 
 	Samples.Empty(HistoryNum);
 	ResampleAccumulators.Empty(NumResamples);
@@ -366,6 +599,7 @@ void FABTest::Start(FString* InABTestCmds, bool bScopeTest)
 
 	bABTestActive = true;
 	SwitchTest(0);
+	RemainingCoolDown += FMath::Max(CVarABTestWarmup.GetValueOnGameThread(), 0);
 	ABTEST_LOG(TEXT("abtest started with A = '%s' and B = '%s'"), *ABTestCmds[0], *ABTestCmds[1]);
 }
 
@@ -383,6 +617,106 @@ const TCHAR* FABTest::SwitchTest(int32 Index)
 	return nullptr;
 }
 
+void FABTest::GetArmMilliseconds(TArray<double> (&OutMilliseconds)[2]) const
+{
+	OutMilliseconds[0].Reset(Samples.Num());
+	OutMilliseconds[1].Reset(Samples.Num());
+
+	// Samples is a ring buffer once the history is full
+	const int32 Oldest = ABTestNumSamples > Samples.Num() ? ABTestNumSamples % Samples.Num() : 0;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		const FSample& Sample = Samples[(Oldest + Index) % Samples.Num()];
+		OutMilliseconds[Sample.TestIndex].Add(double(Sample.Micros) / 1000.0);
+	}
+}
+
+void FABTest::LogStatistics() const
+{
+	using namespace UE4ABTesting_Private;
+
+	TArray<double> Milliseconds[2];
+	GetArmMilliseconds(Milliseconds);
+	const FArmStatistics Stats[2] = { ComputeStatistics(Milliseconds[0]), ComputeStatistics(Milliseconds[1]) };
+	for (int32 Arm = 0; Arm < 2; ++Arm)
+	{
+		ABTEST_LOG(TEXT("      %c: median %7.4fms  p90 %7.4fms  p99 %7.4fms  stddev %7.4fms"), TEXT('A') + Arm, Stats[Arm].Median, Stats[Arm].P90, Stats[Arm].P99, sqrt(Stats[Arm].Variance));
+	}
+
+	FWelchTest Test;
+	if (WelchTest(Stats[0], Stats[1], Test))
+	{
+		ABTEST_LOG(TEXT("      Welch's t-test: A - B = %7.4fms, %2.0f%% confidence interval [%7.4fms, %7.4fms], p = %6.4f%s"),
+			Test.Difference, Confidence * 100.0, Test.ConfidenceLow, Test.ConfidenceHigh, Test.PValue, Test.PValue < 1.0 - Confidence ? TEXT(" (significant)") : TEXT(""));
+	}
+}
+
+bool FABTest::WriteReport(const FString& Filename) const
+{
+	using namespace UE4ABTesting_Private;
+
+	if (Filename.IsEmpty())
+	{
+		ABTEST_LOG(TEXT("abtest save needs a file name, or abtest.ReportFile to be set."));
+		return false;
+	}
+
+	FString Report;
+	if (Filename.EndsWith(TEXT(".json")))
+	{
+		TArray<double> Milliseconds[2];
+		GetArmMilliseconds(Milliseconds);
+		const FArmStatistics Stats[2] = { ComputeStatistics(Milliseconds[0]), ComputeStatistics(Milliseconds[1]) };
+
+		// Both histograms share their bins so they can be compared directly
+		const int32 NumBins = FMath::Max(CVarABTestHistogramBins.GetValueOnGameThread(), 1);
+		const double HistogramMin = FMath::Min(Stats[0].Count ? Stats[0].Min : Stats[1].Min, Stats[1].Count ? Stats[1].Min : Stats[0].Min);
+		const double HistogramMax = FMath::Max(Stats[0].Max, Stats[1].Max);
+		const double BinWidth = HistogramMax > HistogramMin ? (HistogramMax - HistogramMin) / NumBins : 1.0;
+		TArray<int32> Histograms[2];
+		for (int32 Arm = 0; Arm < 2; ++Arm)
+		{
+			Histograms[Arm].AddZeroed(NumBins);
+			for (double Value : Milliseconds[Arm])
+			{
+				++Histograms[Arm][FMath::Clamp(int32((Value - HistogramMin) / BinWidth), 0, NumBins - 1)];
+			}
+		}
+
+		Report += TEXT("{\n");
+		Report += FString::Printf(TEXT("\t\"A\": %s,\n"), *ArmToJson(Stats[0], ABTestCmds[0], Histograms[0]));
+		Report += FString::Printf(TEXT("\t\"B\": %s,\n"), *ArmToJson(Stats[1], ABTestCmds[1], Histograms[1]));
+		Report += FString::Printf(TEXT("\t\"HistogramMinMs\": %f,\n\t\"HistogramBinMs\": %f"), HistogramMin, BinWidth);
+
+		FWelchTest Test;
+		if (WelchTest(Stats[0], Stats[1], Test))
+		{
+			Report += FString::Printf(TEXT(",\n\t\"WelchTest\": { \"DifferenceMs\": %f, \"Confidence\": %f, \"ConfidenceLowMs\": %f, \"ConfidenceHighMs\": %f, \"T\": %f, \"DegreesOfFreedom\": %f, \"PValue\": %f }"),
+				Test.Difference, Confidence, Test.ConfidenceLow, Test.ConfidenceHigh, Test.T, Test.DegreesOfFreedom, Test.PValue);
+		}
+		Report += TEXT("\n}\n");
+	}
+	else
+	{
+		Report += TEXT("Sample,Arm,Milliseconds\n");
+		const int32 Oldest = ABTestNumSamples > Samples.Num() ? ABTestNumSamples % Samples.Num() : 0;
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			const FSample& Sample = Samples[(Oldest + Index) % Samples.Num()];
+			Report += FString::Printf(TEXT("%d,%c,%.3f\n"), Index, TEXT('A') + Sample.TestIndex, double(Sample.Micros) / 1000.0);
+		}
+	}
+
+	const FString Path = FPaths::IsRelative(Filename) ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("ABTest"), Filename) : Filename;
+	if (!FFileHelper::SaveStringToFile(Report, *Path))
+	{
+		ABTEST_LOG(TEXT("Failed to write abtest report to '%s'."), *Path);
+		return false;
+	}
+	ABTEST_LOG(TEXT("Wrote abtest report to '%s'."), *Path);
+	return true;
+}
+
 static FAutoConsoleCommand ABTestCmd(
 	TEXT("abtest"),
 	TEXT("Provide two console commands or 'stop' to stop the abtest. Frames are timed with the two options, logging results over time."),
@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/AllocationScopes.h"
+
+#if ALLOCATIONSCOPES_ENABLED
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformAtomics.h"
+#include "Logging/LogMacros.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Parse.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAllocationScopes, Log, All);
+
+CSV_DEFINE_CATEGORY(AllocationScopes, true);
+
+bool FAllocationScopes::bEnabled = false;
+
+namespace UE4AllocationScopes_Private
+{
+	static FAllocationScopeSite* volatile GFirstSite = nullptr;
+	static thread_local FAllocationScope* GCurrentScope = nullptr;
+	static FDelegateHandle GEndFrameHandle;
+}
+
+FAllocationScopeSite::FAllocationScopeSite(const TCHAR* InName)
+	: Name(InName)
+{
+	using namespace UE4AllocationScopes_Private;
+
+	const TCHAR* Suffixes[] = { TEXT("_Allocs"), TEXT("_Frees"), TEXT("_Bytes") };
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Suffixes); ++Index)
+	{
+		StatNames[Index] = FName(*(FString(Name) + Suffixes[Index]));
+	}
+
+	while (true)
+	{
+		FAllocationScopeSite* LocalFirst = GFirstSite;
+		Next = LocalFirst;
+		if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&GFirstSite, this, LocalFirst) == LocalFirst)
+		{
+			break;
+		}
+	}
+}
+
+void FAllocationScope::Begin(FAllocationScopeSite& InSite)
+{
+	using namespace UE4AllocationScopes_Private;
+
+	for (FAllocationScope* Scope = GCurrentScope; Scope; Scope = Scope->Parent)
+	{
+		if (Scope->Site == &InSite)
+		{
+			return;
+		}
+	}
+
+	Site = &InSite;
+	Parent = GCurrentScope;
+	GCurrentScope = this;
+	StartCounts = FMallocCountingProxy::GetThreadCounts();
+}
+
+void FAllocationScope::End()
+{
+	using namespace UE4AllocationScopes_Private;
+
+	const FMallocThreadCounts Counts = FMallocCountingProxy::GetThreadCounts() - StartCounts;
+	check(GCurrentScope == this);
+	GCurrentScope = Parent;
+
+	FPlatformAtomics::InterlockedAdd(&Site->NumAllocations, (int64)Counts.NumAllocations);
+	FPlatformAtomics::InterlockedAdd(&Site->NumFrees, (int64)Counts.NumFrees);
+	FPlatformAtomics::InterlockedAdd(&Site->AllocatedBytes, (int64)Counts.AllocatedBytes);
+}
+
+void FAllocationScopes::SetEnabled(bool bInEnabled)
+{
+	using namespace UE4AllocationScopes_Private;
+
+	if (bInEnabled == bEnabled)
+	{
+		return;
+	}
+	if (bInEnabled && !FMallocCountingProxy::Enable())
+	{
+		UE_LOG(LogAllocationScopes, Warning, TEXT("Allocation scopes need FMallocCountingProxy, which can't wrap GMalloc on this platform"));
+		return;
+	}
+
+	// Open scopes that began counting still end counting after this, they don't look at it again
+	bEnabled = bInEnabled;
+	if (bEnabled)
+	{
+		GEndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FAllocationScopes::ReportFrame);
+	}
+	else
+	{
+		FCoreDelegates::OnEndFrame.Remove(GEndFrameHandle);
+	}
+}
+
+void FAllocationScopes::ReportFrame()
+{
+	using namespace UE4AllocationScopes_Private;
+
+	for (FAllocationScopeSite* Site = GFirstSite; Site; Site = Site->Next)
+	{
+		const int64 Values[] =
+		{
+			FPlatformAtomics::InterlockedExchange(&Site->NumAllocations, 0),
+			FPlatformAtomics::InterlockedExchange(&Site->NumFrees, 0),
+			FPlatformAtomics::InterlockedExchange(&Site->AllocatedBytes, 0),
+		};
+
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Values); ++Index)
+		{
+#if CSV_PROFILER
+			FCsvProfiler::RecordCustomStat(Site->StatNames[Index], CSV_CATEGORY_INDEX(AllocationScopes), float(Values[Index]), ECsvCustomStatOp::Set);
+#endif
+#if COUNTERSTRACE_ENABLED
+			if (!Site->TraceCounterIds[Index])
+			{
+				Site->TraceCounterIds[Index] = FCountersTrace::OutputInitCounter(*Site->StatNames[Index].ToString(), TraceCounterType_Int,
+					Index == 2 ? TraceCounterDisplayHint_Memory : TraceCounterDisplayHint_None);
+			}
+			FCountersTrace::OutputSetValue(Site->TraceCounterIds[Index], Values[Index]);
+#endif
+		}
+	}
+}
+
+static void HandleAllocationScopesEnableChanged(IConsoleVariable* Variable)
+{
+	FAllocationScopes::SetEnabled(Variable->GetBool());
+}
+
+static FAutoConsoleVariable CVarAllocationScopesEnable(
+	TEXT("AllocationScopes.Enable"),
+	0,
+	TEXT("Whether ALLOCATION_SCOPE scopes count allocations, reported every frame as CSV stats and trace counters."),
+	FConsoleVariableDelegate::CreateStatic(&HandleAllocationScopesEnableChanged)
+	);
+
+static FDelayedAutoRegisterHelper GAllocationScopesRegister(EDelayedRegisterRunPhase::StartOfEnginePreInit, []()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("allocationscopes")))
+	{
+		CVarAllocationScopesEnable->Set(1);
+	}
+});
+
+#endif
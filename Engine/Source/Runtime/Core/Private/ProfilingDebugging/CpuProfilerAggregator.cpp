@@ -0,0 +1,511 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/CpuProfilerAggregator.h"
+
+#if CPUPROFILERTRACE_ENABLED
+
+#include "Algo/Sort.h"
+#include "Containers/Map.h"
+#include "Containers/StringConv.h"
+#include "CoreGlobals.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadManager.h"
+#include "Logging/LogMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+bool GCpuProfilerAggregating = false;
+
+static int32 GCpuProfilerAggregateWindowSeconds = 10;
+static FAutoConsoleVariableRef CVarCpuProfilerAggregateWindowSeconds(
+	TEXT("CpuProfiler.Aggregate.WindowSeconds"),
+	GCpuProfilerAggregateWindowSeconds,
+	TEXT("How many of the last seconds the CPU profiler aggregate reports cover, at most 60.")
+	);
+
+namespace UE4CpuProfilerAggregator_Private
+{
+	enum
+	{
+		/** One second each */
+		MaxSlots = 60,
+	};
+
+	/** A scope path of a thread, a scope under the path of its parent */
+	struct FNode
+	{
+		int32 Parent;
+		uint32 SpecId;
+	};
+
+	struct FNodeTimes
+	{
+		uint64 Count;
+		uint64 InclusiveCycles;
+		uint64 ExclusiveCycles;
+	};
+
+	/** What a thread did in a second, only the nodes it went through */
+	struct FSlot
+	{
+		int64 SlotNumber;
+		TArray<TPair<int32, FNodeTimes>> Times;
+	};
+
+	struct FFrame
+	{
+		int32 Node;
+		uint64 StartCycle;
+		uint64 ChildCycles;
+	};
+
+	struct FThreadState
+	{
+		uint32 ThreadId = 0;
+
+		// Only used by the thread
+		uint32 Generation = 0;
+		TArray<FFrame, TInlineAllocator<64>> Stack;
+		TMap<uint64, int32> NodeMap;
+		TArray<FNodeTimes> Current;
+		int64 CurrentSlot = -1;
+
+		// Written by the thread and read by reports with Lock held
+		FCriticalSection Lock;
+		TArray<FNode> Nodes;
+		TArray<FSlot> Slots;
+	};
+
+	static thread_local FThreadState* GThreadState = nullptr;
+	/** Bumped by every start, threads drop what they had when they see it changed */
+	static volatile int32 GGeneration = 0;
+	static uint64 GCyclesPerSlot = 1;
+	static int64 GStopSlot = 0;
+
+	static FCriticalSection& GetThreadsLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	/** Thread states are never freed, what threads that exited did ages out of the window */
+	static TArray<FThreadState*>& GetThreads()
+	{
+		static TArray<FThreadState*> Threads;
+		return Threads;
+	}
+
+	static FCriticalSection& GetNamesLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	static TMap<uint32, FString>& GetScopeNames()
+	{
+		static TMap<uint32, FString> ScopeNames;
+		return ScopeNames;
+	}
+
+	static FThreadState* CreateThreadState()
+	{
+		FThreadState* State = new FThreadState();
+		State->ThreadId = FPlatformTLS::GetCurrentThreadId();
+		{
+			FScopeLock ThreadsLock(&GetThreadsLock());
+			GetThreads().Add(State);
+		}
+		GThreadState = State;
+		return State;
+	}
+
+	/** Moves the current slot of a thread to the ones reports see */
+	static void PublishSlot(FThreadState& State)
+	{
+		if (State.CurrentSlot < 0)
+		{
+			return;
+		}
+
+		FSlot Slot;
+		Slot.SlotNumber = State.CurrentSlot;
+		for (int32 Node = 0; Node < State.Current.Num(); ++Node)
+		{
+			if (State.Current[Node].Count)
+			{
+				Slot.Times.Emplace(Node, State.Current[Node]);
+			}
+		}
+		FMemory::Memzero(State.Current.GetData(), State.Current.Num() * sizeof(FNodeTimes));
+
+		FScopeLock ScopeLock(&State.Lock);
+		State.Slots.Add(MoveTemp(Slot));
+		if (State.Slots.Num() > MaxSlots)
+		{
+			State.Slots.RemoveAt(0, State.Slots.Num() - MaxSlots, false);
+		}
+	}
+
+	static FString GetThreadName(uint32 ThreadId)
+	{
+		if (ThreadId == GGameThreadId)
+		{
+			return TEXT("GameThread");
+		}
+		const FString& Name = FThreadManager::Get().GetThreadName(ThreadId);
+		return Name.Len() ? Name : FString::Printf(TEXT("Thread %u"), ThreadId);
+	}
+
+	static void AppendJsonString(FStringBuilderBase& Builder, const FString& String)
+	{
+		Builder.AppendChar(TEXT('"'));
+		for (TCHAR Char : String)
+		{
+			if (Char == TEXT('"') || Char == TEXT('\\'))
+			{
+				Builder.AppendChar(TEXT('\\'));
+				Builder.AppendChar(Char);
+			}
+			else if (Char < 0x20)
+			{
+				Builder.Appendf(TEXT("\\u%04x"), (uint32)Char);
+			}
+			else
+			{
+				Builder.AppendChar(Char);
+			}
+		}
+		Builder.AppendChar(TEXT('"'));
+	}
+}
+
+void FCpuProfilerAggregator::Start()
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	if (GCpuProfilerAggregating)
+	{
+		return;
+	}
+
+	GCyclesPerSlot = FMath::Max<uint64>(1, uint64(1.0 / FPlatformTime::GetSecondsPerCycle64()));
+	{
+		FScopeLock ThreadsLock(&GetThreadsLock());
+		for (FThreadState* State : GetThreads())
+		{
+			FScopeLock ScopeLock(&State->Lock);
+			State->Slots.Reset();
+		}
+	}
+	FPlatformAtomics::InterlockedIncrement(&GGeneration);
+	GCpuProfilerAggregating = true;
+}
+
+void FCpuProfilerAggregator::Stop()
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	if (GCpuProfilerAggregating)
+	{
+		// Reports keep covering the window up to now
+		GStopSlot = int64(FPlatformTime::Cycles64() / GCyclesPerSlot);
+		GCpuProfilerAggregating = false;
+	}
+}
+
+void FCpuProfilerAggregator::RegisterScopeName(uint32 SpecId, const ANSICHAR* Name)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	FScopeLock ScopeLock(&GetNamesLock());
+	GetScopeNames().Add(SpecId, ANSI_TO_TCHAR(Name));
+}
+
+void FCpuProfilerAggregator::RegisterScopeName(uint32 SpecId, const TCHAR* Name)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	FScopeLock ScopeLock(&GetNamesLock());
+	GetScopeNames().Add(SpecId, Name);
+}
+
+void FCpuProfilerAggregator::BeginScope(uint32 SpecId, uint64 Cycle)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	FThreadState* State = GThreadState ? GThreadState : CreateThreadState();
+	const uint32 Generation = (uint32)GGeneration;
+	if (State->Generation != Generation)
+	{
+		State->Generation = Generation;
+		State->Stack.Reset();
+		State->CurrentSlot = -1;
+		FMemory::Memzero(State->Current.GetData(), State->Current.Num() * sizeof(FNodeTimes));
+	}
+
+	const int32 Parent = State->Stack.Num() ? State->Stack.Last().Node : INDEX_NONE;
+	const uint64 Key = (uint64(uint32(Parent + 1)) << 32) | SpecId;
+	int32 Node;
+	if (const int32* Found = State->NodeMap.Find(Key))
+	{
+		Node = *Found;
+	}
+	else
+	{
+		FScopeLock ScopeLock(&State->Lock);
+		Node = State->Nodes.Add(FNode{ Parent, SpecId });
+		State->NodeMap.Add(Key, Node);
+	}
+
+	State->Stack.Add(FFrame{ Node, Cycle, 0 });
+}
+
+void FCpuProfilerAggregator::EndScope(uint64 Cycle)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	// Scopes that began before the start are not in the stack
+	FThreadState* State = GThreadState;
+	if (!State || State->Generation != (uint32)GGeneration || State->Stack.Num() == 0)
+	{
+		return;
+	}
+
+	const FFrame Frame = State->Stack.Pop(false);
+	const uint64 InclusiveCycles = Cycle - Frame.StartCycle;
+	if (State->Stack.Num())
+	{
+		State->Stack.Last().ChildCycles += InclusiveCycles;
+	}
+
+	// A scope counts in the second it ends in
+	const int64 Slot = int64(Cycle / GCyclesPerSlot);
+	if (Slot != State->CurrentSlot)
+	{
+		PublishSlot(*State);
+		State->CurrentSlot = Slot;
+	}
+
+	if (Frame.Node >= State->Current.Num())
+	{
+		State->Current.AddZeroed(State->Nodes.Num() - State->Current.Num());
+	}
+	FNodeTimes& Times = State->Current[Frame.Node];
+	++Times.Count;
+	Times.InclusiveCycles += InclusiveCycles;
+	Times.ExclusiveCycles += InclusiveCycles - FMath::Min(Frame.ChildCycles, InclusiveCycles);
+}
+
+void FCpuProfilerAggregator::GetScopeTimes(bool bFlat, TArray<FScopeTimes>& OutScopes, double& OutWindowSeconds)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	OutScopes.Reset();
+
+	// The current second is still being filled in
+	const int64 EndSlot = GCpuProfilerAggregating ? int64(FPlatformTime::Cycles64() / GCyclesPerSlot) : GStopSlot;
+	const int64 FirstSlot = EndSlot - FMath::Clamp(GCpuProfilerAggregateWindowSeconds, 1, (int32)MaxSlots);
+	int64 OldestSlotSeen = EndSlot;
+
+	TMap<uint32, FString> ScopeNames;
+	{
+		FScopeLock ScopeLock(&GetNamesLock());
+		ScopeNames = GetScopeNames();
+	}
+
+	TArray<FThreadState*> Threads;
+	{
+		FScopeLock ThreadsLock(&GetThreadsLock());
+		Threads = GetThreads();
+	}
+
+	TMap<FString, FScopeTimes> FlatScopes;
+	for (FThreadState* State : Threads)
+	{
+		TMap<int32, FNodeTimes> ThreadTimes;
+		TArray<FNode> Nodes;
+		{
+			FScopeLock ScopeLock(&State->Lock);
+			for (const FSlot& Slot : State->Slots)
+			{
+				if (Slot.SlotNumber < FirstSlot || Slot.SlotNumber >= EndSlot)
+				{
+					continue;
+				}
+				OldestSlotSeen = FMath::Min(OldestSlotSeen, Slot.SlotNumber);
+				for (const TPair<int32, FNodeTimes>& It : Slot.Times)
+				{
+					FNodeTimes& Times = ThreadTimes.FindOrAdd(It.Key, FNodeTimes{ 0, 0, 0 });
+					Times.Count += It.Value.Count;
+					Times.InclusiveCycles += It.Value.InclusiveCycles;
+					Times.ExclusiveCycles += It.Value.ExclusiveCycles;
+				}
+			}
+			if (ThreadTimes.Num())
+			{
+				Nodes = State->Nodes;
+			}
+		}
+		if (!ThreadTimes.Num())
+		{
+			continue;
+		}
+
+		const FString ThreadName = GetThreadName(State->ThreadId);
+		for (const TPair<int32, FNodeTimes>& It : ThreadTimes)
+		{
+			const FString* Name = ScopeNames.Find(Nodes[It.Key].SpecId);
+			const FString ScopeName = Name ? *Name : FString::Printf(TEXT("Scope %u"), Nodes[It.Key].SpecId);
+
+			FScopeTimes* Scope;
+			if (bFlat)
+			{
+				Scope = &FlatScopes.FindOrAdd(ScopeName);
+				Scope->Path = ScopeName;
+			}
+			else
+			{
+				Scope = &OutScopes.AddDefaulted_GetRef();
+				Scope->ThreadName = ThreadName;
+				Scope->Path = ScopeName;
+				for (int32 Parent = Nodes[It.Key].Parent; Parent != INDEX_NONE; Parent = Nodes[Parent].Parent)
+				{
+					const FString* ParentName = ScopeNames.Find(Nodes[Parent].SpecId);
+					Scope->Path = (ParentName ? *ParentName : FString::Printf(TEXT("Scope %u"), Nodes[Parent].SpecId)) + TEXT("/") + Scope->Path;
+				}
+			}
+			Scope->Count += It.Value.Count;
+			Scope->InclusiveCycles += It.Value.InclusiveCycles;
+			Scope->ExclusiveCycles += It.Value.ExclusiveCycles;
+		}
+	}
+
+	if (bFlat)
+	{
+		FlatScopes.GenerateValueArray(OutScopes);
+	}
+	Algo::Sort(OutScopes, [](const FScopeTimes& A, const FScopeTimes& B)
+	{
+		return A.ExclusiveCycles > B.ExclusiveCycles;
+	});
+
+	OutWindowSeconds = double(EndSlot - OldestSlotSeen) * double(GCyclesPerSlot) * FPlatformTime::GetSecondsPerCycle64();
+}
+
+FString FCpuProfilerAggregator::ToJsonString(bool bFlat)
+{
+	using namespace UE4CpuProfilerAggregator_Private;
+
+	TArray<FScopeTimes> Scopes;
+	double WindowSeconds = 0.0;
+	GetScopeTimes(bFlat, Scopes, WindowSeconds);
+
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+	TStringBuilder<4096> Builder;
+	Builder.Appendf(TEXT("{\"windowSeconds\":%.3f,\"scopes\":["), WindowSeconds);
+	for (int32 Index = 0; Index < Scopes.Num(); ++Index)
+	{
+		const FScopeTimes& Scope = Scopes[Index];
+		Builder.Append(Index ? TEXT(",{\"thread\":") : TEXT("{\"thread\":"));
+		AppendJsonString(Builder, Scope.ThreadName);
+		Builder.Append(TEXT(",\"path\":"));
+		AppendJsonString(Builder, Scope.Path);
+		Builder.Appendf(TEXT(",\"count\":%llu,\"inclusiveMs\":%.3f,\"exclusiveMs\":%.3f}"), Scope.Count, double(Scope.InclusiveCycles) * MsPerCycle, double(Scope.ExclusiveCycles) * MsPerCycle);
+	}
+	Builder.Append(TEXT("]}"));
+	return FString(Builder.ToString());
+}
+
+static void HandleCpuProfilerAggregatePrint(const TArray<FString>& Args)
+{
+	bool bFlat = false;
+	int32 MaxScopes = 30;
+	for (const FString& Arg : Args)
+	{
+		if (Arg == TEXT("flat"))
+		{
+			bFlat = true;
+		}
+		else if (Arg.IsNumeric())
+		{
+			MaxScopes = FCString::Atoi(*Arg);
+		}
+	}
+
+	TArray<FCpuProfilerAggregator::FScopeTimes> Scopes;
+	double WindowSeconds = 0.0;
+	FCpuProfilerAggregator::GetScopeTimes(bFlat, Scopes, WindowSeconds);
+
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+	UE_LOG(LogConsoleResponse, Display, TEXT("CPU scopes over the last %.0fs%s, by exclusive time:"), WindowSeconds, FCpuProfilerAggregator::IsRunning() ? TEXT("") : TEXT(" (stopped)"));
+	UE_LOG(LogConsoleResponse, Display, TEXT("  %10s %10s %10s  %s"), TEXT("Excl ms"), TEXT("Incl ms"), TEXT("Count"), bFlat ? TEXT("Scope") : TEXT("Thread: Path"));
+	for (int32 Index = 0; Index < FMath::Min(MaxScopes, Scopes.Num()); ++Index)
+	{
+		const FCpuProfilerAggregator::FScopeTimes& Scope = Scopes[Index];
+		UE_LOG(LogConsoleResponse, Display, TEXT("  %10.2f %10.2f %10llu  %s%s%s"), double(Scope.ExclusiveCycles) * MsPerCycle, double(Scope.InclusiveCycles) * MsPerCycle, Scope.Count,
+			*Scope.ThreadName, bFlat ? TEXT("") : TEXT(": "), *Scope.Path);
+	}
+}
+
+static void HandleCpuProfilerAggregateDumpJson(const TArray<FString>& Args)
+{
+	bool bFlat = false;
+	FString Filename;
+	for (const FString& Arg : Args)
+	{
+		if (Arg == TEXT("flat"))
+		{
+			bFlat = true;
+		}
+		else
+		{
+			Filename = Arg;
+		}
+	}
+	if (Filename.IsEmpty())
+	{
+		Filename = FPaths::ProfilingDir() / FString::Printf(TEXT("CpuProfilerAggregate-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	}
+
+	if (FFileHelper::SaveStringToFile(FCpuProfilerAggregator::ToJsonString(bFlat), *Filename))
+	{
+		UE_LOG(LogConsoleResponse, Display, TEXT("Wrote CPU profiler aggregate to %s"), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogConsoleResponse, Warning, TEXT("Could not write CPU profiler aggregate to %s"), *Filename);
+	}
+}
+
+static FAutoConsoleCommand CpuProfilerAggregateStartCmd(
+	TEXT("CpuProfiler.Aggregate.Start"),
+	TEXT("Starts aggregating the time spent in CPU profiler scopes in process."),
+	FConsoleCommandDelegate::CreateStatic(&FCpuProfilerAggregator::Start)
+	);
+
+static FAutoConsoleCommand CpuProfilerAggregateStopCmd(
+	TEXT("CpuProfiler.Aggregate.Stop"),
+	TEXT("Stops aggregating CPU profiler scopes, what was aggregated can still be printed."),
+	FConsoleCommandDelegate::CreateStatic(&FCpuProfilerAggregator::Stop)
+	);
+
+static FAutoConsoleCommand CpuProfilerAggregatePrintCmd(
+	TEXT("CpuProfiler.Aggregate.Print"),
+	TEXT("Prints the CPU profiler scopes of the last CpuProfiler.Aggregate.WindowSeconds by exclusive time. Arguments: [flat] [NumScopes]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCpuProfilerAggregatePrint)
+	);
+
+static FAutoConsoleCommand CpuProfilerAggregateDumpJsonCmd(
+	TEXT("CpuProfiler.Aggregate.DumpJson"),
+	TEXT("Writes the CPU profiler scopes of the last CpuProfiler.Aggregate.WindowSeconds as JSON, to the profiling directory if no filename is given. Arguments: [flat] [Filename]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCpuProfilerAggregateDumpJson)
+	);
+
+#endif
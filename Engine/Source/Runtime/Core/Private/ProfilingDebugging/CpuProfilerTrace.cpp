@@ -1,5 +1,6 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 #include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CpuProfilerAggregator.h"
 #include "Trace/Trace.h"
 #include "HAL/PlatformTime.h"
 #include "HAL/PlatformTLS.h"
@@ -148,6 +149,10 @@ void FCpuProfilerTraceInternal::EndCapture(FThreadBuffer* InThreadBuffer)
 	if (ThreadBuffer->BufferSize >= FCpuProfilerTraceInternal::FullBufferThreshold) \
 	{ \
 		FCpuProfilerTraceInternal::FlushThreadBuffer(ThreadBuffer); \
+	} \
+	if (GCpuProfilerAggregating) \
+	{ \
+		FCpuProfilerAggregator::BeginScope(SpecId, Cycle); \
 	}
 
 void FCpuProfilerTrace::OutputBeginEvent(uint32 SpecId)
@@ -212,6 +217,10 @@ void FCpuProfilerTrace::OutputEndEvent()
 	{
 		FCpuProfilerTraceInternal::FlushThreadBuffer(ThreadBuffer);
 	}
+	if (GCpuProfilerAggregating)
+	{
+		FCpuProfilerAggregator::EndScope(Cycle);
+	}
 }
 
 uint32 FCpuProfilerTraceInternal::GetNextSpecId()
@@ -223,6 +232,7 @@ uint32 FCpuProfilerTraceInternal::GetNextSpecId()
 uint32 FCpuProfilerTrace::OutputEventType(const TCHAR* Name)
 {
 	uint32 SpecId = FCpuProfilerTraceInternal::GetNextSpecId();
+	FCpuProfilerAggregator::RegisterScopeName(SpecId, Name);
 	uint16 NameSize = (uint16)((FCString::Strlen(Name) + 1) * sizeof(TCHAR));
 	UE_TRACE_LOG(CpuProfiler, EventSpec, CpuChannel, NameSize)
 		<< EventSpec.Id(SpecId)
@@ -234,6 +244,7 @@ uint32 FCpuProfilerTrace::OutputEventType(const TCHAR* Name)
 uint32 FCpuProfilerTrace::OutputEventType(const ANSICHAR* Name)
 {
 	uint32 SpecId = FCpuProfilerTraceInternal::GetNextSpecId();
+	FCpuProfilerAggregator::RegisterScopeName(SpecId, Name);
 	uint16 NameSize = (uint16)(strlen(Name) + 1);
 	UE_TRACE_LOG(CpuProfiler, EventSpec, CpuChannel, NameSize)
 		<< EventSpec.Id(SpecId)
@@ -248,6 +259,10 @@ void FCpuProfilerTrace::Init(const TCHAR* CmdLine)
 	{
 		Trace::ToggleChannel(CpuChannel, true);
 	}
+	if (FParse::Param(CmdLine, TEXT("cpuprofileraggregate")))
+	{
+		FCpuProfilerAggregator::Start();
+	}
 }
 
 void FCpuProfilerTrace::Shutdown()
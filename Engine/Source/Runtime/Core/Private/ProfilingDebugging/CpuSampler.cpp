@@ -0,0 +1,335 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/CpuSampler.h"
+
+#if CPUSAMPLER_ENABLED
+
+#include "Algo/Sort.h"
+#include "Containers/Map.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadManager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Logging/LogMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/StackWalkSymbolCache.h"
+#include "Trace/Trace.h"
+
+static float GCpuSamplerRateHz = 250.0f;
+static FAutoConsoleVariableRef CVarCpuSamplerRateHz(
+	TEXT("CpuSampler.RateHz"),
+	GCpuSamplerRateHz,
+	TEXT("How many times a second the CPU sampler takes the call stacks of the threads it samples, used when it starts.")
+	);
+
+static int32 GCpuSamplerAllThreads = 0;
+static FAutoConsoleVariableRef CVarCpuSamplerAllThreads(
+	TEXT("CpuSampler.AllThreads"),
+	GCpuSamplerAllThreads,
+	TEXT("0: the CPU sampler samples the game, task graph, render and RHI threads. 1: every thread created through FRunnableThread.")
+	);
+
+UE_TRACE_CHANNEL(CpuSamplerChannel)
+
+UE_TRACE_EVENT_BEGIN(CpuSampler, Module, Important)
+	UE_TRACE_EVENT_FIELD(uint64, Base)
+	UE_TRACE_EVENT_FIELD(uint32, Size)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(CpuSampler, Sample)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+UE_TRACE_EVENT_END()
+
+DEFINE_LOG_CATEGORY_STATIC(LogCpuSampler, Log, All);
+
+namespace UE4CpuSampler_Private
+{
+	enum
+	{
+		MaxStackDepth = 64,
+		/** Innermost frames counted for hotspots, new ones are dropped beyond this */
+		MaxHotspots = 64 * 1024,
+	};
+
+	/** The signal handler that captures the stack on Unix and the trampoline it returns through are the first frames */
+	static const uint32 NumHandlerFrames = PLATFORM_UNIX ? 3 : 0;
+
+	static bool IsSampledThread(const FString& ThreadName)
+	{
+		return GCpuSamplerAllThreads
+			|| ThreadName.Contains(TEXT("TaskGraph"))
+			|| ThreadName.Contains(TEXT("RenderThread"))
+			|| ThreadName.Contains(TEXT("RHIThread"));
+	}
+
+	class FSamplerThread : public FRunnable
+	{
+	public:
+
+		explicit FSamplerThread(float InRateHz)
+			: IntervalSeconds(1.0 / FMath::Clamp(InRateHz, 1.0f, 10000.0f))
+		{
+		}
+
+		virtual uint32 Run() override
+		{
+			TraceModules();
+
+			const uint32 OwnThreadId = FPlatformTLS::GetCurrentThreadId();
+			TArray<uint32> ThreadIds;
+			double NextRefreshTime = 0.0;
+			while (!bStopRequested)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				if (StartTime >= NextRefreshTime)
+				{
+					// Threads come and go, look again every second
+					ThreadIds.Reset();
+					ThreadIds.Add(GGameThreadId);
+					FThreadManager::Get().ForEachThread([&ThreadIds, OwnThreadId](uint32 ThreadId, FRunnableThread* Thread)
+					{
+						if (ThreadId != OwnThreadId && ThreadId != GGameThreadId && IsSampledThread(Thread->GetThreadName()))
+						{
+							ThreadIds.Add(ThreadId);
+						}
+					});
+					NextRefreshTime = StartTime + 1.0;
+				}
+
+				for (uint32 ThreadId : ThreadIds)
+				{
+					// Nothing may be allocated while the thread is stopped, it could hold the allocator lock
+					uint64 BackTrace[MaxStackDepth];
+					const uint32 Depth = FPlatformStackWalk::CaptureThreadStackBackTrace(ThreadId, BackTrace, MaxStackDepth);
+					if (Depth <= NumHandlerFrames)
+					{
+						continue;
+					}
+
+					UE_TRACE_LOG(CpuSampler, Sample, CpuSamplerChannel, Depth * sizeof(uint64))
+						<< Sample.Cycle(FPlatformTime::Cycles64())
+						<< Sample.ThreadId(ThreadId)
+						<< Sample.Attachment(BackTrace, Depth * sizeof(uint64));
+
+					CountHotspot(BackTrace[NumHandlerFrames]);
+				}
+
+				const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+				FPlatformProcess::SleepNoStats(float(FMath::Max(IntervalSeconds - ElapsedSeconds, 0.0)));
+			}
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopRequested = true;
+		}
+
+		/** @return the most sampled innermost frames and how often they were sampled, most first */
+		TArray<TPair<uint64, uint32>> GetHotspots() const
+		{
+			TArray<TPair<uint64, uint32>> Result;
+			{
+				FScopeLock ScopeLock(&HotspotsLock);
+				Result.Reserve(Hotspots.Num());
+				for (const TPair<uint64, uint32>& Hotspot : Hotspots)
+				{
+					Result.Add(Hotspot);
+				}
+			}
+			Algo::Sort(Result, [](const TPair<uint64, uint32>& A, const TPair<uint64, uint32>& B)
+			{
+				return A.Value > B.Value;
+			});
+			return Result;
+		}
+
+		uint64 GetNumSamples() const
+		{
+			FScopeLock ScopeLock(&HotspotsLock);
+			return NumSamples;
+		}
+
+	private:
+
+		void TraceModules()
+		{
+			const int32 NumModules = FPlatformStackWalk::GetProcessModuleCount();
+			TArray<FStackWalkModuleInfo> Modules;
+			Modules.SetNumZeroed(NumModules);
+			Modules.SetNum(FPlatformStackWalk::GetProcessModuleSignatures(Modules.GetData(), NumModules));
+			for (const FStackWalkModuleInfo& ModuleInfo : Modules)
+			{
+				const uint16 NameSize = (uint16)((FCString::Strlen(ModuleInfo.ImageName) + 1) * sizeof(TCHAR));
+				UE_TRACE_LOG(CpuSampler, Module, CpuSamplerChannel, NameSize)
+					<< Module.Base(ModuleInfo.BaseOfImage)
+					<< Module.Size(ModuleInfo.ImageSize)
+					<< Module.Attachment(ModuleInfo.ImageName, NameSize);
+			}
+		}
+
+		void CountHotspot(uint64 ProgramCounter)
+		{
+			FScopeLock ScopeLock(&HotspotsLock);
+			++NumSamples;
+			if (uint32* Count = Hotspots.Find(ProgramCounter))
+			{
+				++*Count;
+			}
+			else if (Hotspots.Num() < MaxHotspots)
+			{
+				Hotspots.Add(ProgramCounter, 1);
+			}
+		}
+
+		double IntervalSeconds;
+		FThreadSafeBool bStopRequested;
+
+		mutable FCriticalSection HotspotsLock;
+		TMap<uint64, uint32> Hotspots;
+		uint64 NumSamples = 0;
+	};
+
+	static FCriticalSection GSamplerLock;
+	static FSamplerThread* GSampler = nullptr;
+	static FRunnableThread* GSamplerThread = nullptr;
+}
+
+void FCpuSampler::Start(float RateHz)
+{
+	using namespace UE4CpuSampler_Private;
+
+	FScopeLock ScopeLock(&GSamplerLock);
+	if (GSampler || !FPlatformProcess::SupportsMultithreading())
+	{
+		return;
+	}
+
+	const float Rate = RateHz > 0.0f ? RateHz : GCpuSamplerRateHz;
+	GSampler = new FSamplerThread(Rate);
+	GSamplerThread = FRunnableThread::Create(GSampler, TEXT("CpuSampler"), 0, TPri_Highest);
+	UE_LOG(LogCpuSampler, Display, TEXT("CPU sampler started at %.0f Hz"), Rate);
+}
+
+void FCpuSampler::Stop()
+{
+	using namespace UE4CpuSampler_Private;
+
+	FScopeLock ScopeLock(&GSamplerLock);
+	if (GSampler)
+	{
+		GSamplerThread->Kill(true);
+		delete GSamplerThread;
+		GSamplerThread = nullptr;
+		delete GSampler;
+		GSampler = nullptr;
+		UE_LOG(LogCpuSampler, Display, TEXT("CPU sampler stopped"));
+	}
+}
+
+bool FCpuSampler::IsRunning()
+{
+	using namespace UE4CpuSampler_Private;
+
+	FScopeLock ScopeLock(&GSamplerLock);
+	return GSampler != nullptr;
+}
+
+void FCpuSampler::PrintHotspots(int32 NumHotspots)
+{
+	using namespace UE4CpuSampler_Private;
+
+	FScopeLock ScopeLock(&GSamplerLock);
+	if (!GSampler)
+	{
+		UE_LOG(LogConsoleResponse, Display, TEXT("The CPU sampler is not running, start it with CpuSampler.Start"));
+		return;
+	}
+
+	// Symbols are only looked up here, sampling stays cheap, and once for every program counter across prints.
+	// Frames in the same function are merged.
+	static FStackWalkSymbolCache SymbolCache;
+	const TArray<TPair<uint64, uint32>> Hotspots = GSampler->GetHotspots();
+	for (const TPair<uint64, uint32>& Hotspot : Hotspots)
+	{
+		SymbolCache.Add(&Hotspot.Key, 1);
+	}
+	SymbolCache.Symbolicate();
+
+	TMap<FString, uint32> FunctionCounts;
+	for (const TPair<uint64, uint32>& Hotspot : Hotspots)
+	{
+		FProgramCounterSymbolInfo SymbolInfo;
+		SymbolCache.Find(Hotspot.Key, SymbolInfo);
+		const FString Function = SymbolInfo.FunctionName[0]
+			? FString::Printf(TEXT("%s!%s"), ANSI_TO_TCHAR(SymbolInfo.ModuleName), ANSI_TO_TCHAR(SymbolInfo.FunctionName))
+			: FString::Printf(TEXT("0x%016llx"), Hotspot.Key);
+		FunctionCounts.FindOrAdd(Function) += Hotspot.Value;
+	}
+	FunctionCounts.ValueSort([](uint32 A, uint32 B)
+	{
+		return A > B;
+	});
+
+	const uint64 NumSamples = FMath::Max<uint64>(GSampler->GetNumSamples(), 1);
+	UE_LOG(LogConsoleResponse, Display, TEXT("CPU sampler hotspots over %llu samples:"), NumSamples);
+	int32 NumPrinted = 0;
+	for (const TPair<FString, uint32>& It : FunctionCounts)
+	{
+		if (NumPrinted++ >= NumHotspots)
+		{
+			break;
+		}
+		UE_LOG(LogConsoleResponse, Display, TEXT("  %6.2f%% %8u  %s"), 100.0 * double(It.Value) / double(NumSamples), It.Value, *It.Key);
+	}
+}
+
+static void HandleCpuSamplerStart(const TArray<FString>& Args)
+{
+	FCpuSampler::Start(Args.Num() ? FCString::Atof(*Args[0]) : 0.0f);
+}
+
+static void HandleCpuSamplerPrintHotspots(const TArray<FString>& Args)
+{
+	FCpuSampler::PrintHotspots(Args.Num() ? FCString::Atoi(*Args[0]) : 30);
+}
+
+static FAutoConsoleCommand CpuSamplerStartCmd(
+	TEXT("CpuSampler.Start"),
+	TEXT("Starts sampling the call stacks of the game, task graph, render and RHI threads. Arguments: [RateHz]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCpuSamplerStart)
+	);
+
+static FAutoConsoleCommand CpuSamplerStopCmd(
+	TEXT("CpuSampler.Stop"),
+	TEXT("Stops the CPU sampler."),
+	FConsoleCommandDelegate::CreateStatic(&FCpuSampler::Stop)
+	);
+
+static FAutoConsoleCommand CpuSamplerPrintHotspotsCmd(
+	TEXT("CpuSampler.PrintHotspots"),
+	TEXT("Prints the functions the CPU sampler caught the threads in the most. Arguments: [NumFunctions]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCpuSamplerPrintHotspots)
+	);
+
+static FDelayedAutoRegisterHelper GCpuSamplerRegister(EDelayedRegisterRunPhase::TaskGraphSystemReady, []()
+{
+	float RateHz = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("cpusampler="), RateHz) || FParse::Param(FCommandLine::Get(), TEXT("cpusampler")))
+	{
+		FCpuSampler::Start(RateHz);
+	}
+});
+
+#endif
@@ -6,6 +6,7 @@
 */
 
 #include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CsvProfilerBinary.h"
 #include "CoreGlobals.h"
 #include "HAL/RunnableThread.h"
 #include "HAL/ThreadManager.h"
@@ -26,6 +27,7 @@
 #include "Stats/Stats.h"
 #include "HAL/LowLevelMemTracker.h"
 #include "Misc/Compression.h"
+#include "Async/ParallelFor.h"
 
 #if CSV_PROFILER
 
@@ -99,6 +101,14 @@ TAutoConsoleVariable<int32> CVarCsvCompressionMode(
 	ECVF_Default
 );
 
+TAutoConsoleVariable<int32> CVarCsvBinaryOutput(
+	TEXT("csv.BinaryOutput"),
+	0,
+	TEXT("When 1, captures are written in the binary columnar format (.csvbin) instead of text, compressed a chunk of rows at a time.\r\n")
+	TEXT("Use csv.ConvertBinary to convert them back to text CSV files."),
+	ECVF_Default
+);
+
 TAutoConsoleVariable<int32> CVarCsvStatCounts(
 	TEXT("csv.statCounts"),
 	0,
@@ -114,6 +124,17 @@ TAutoConsoleVariable<int32> CVarCsvWriteBufferSize(
 	ECVF_Default
 );
 
+TAutoConsoleVariable<int32> CVarCsvParallelProcessing(
+	TEXT("csv.ParallelProcessing"),
+	1,
+	TEXT("When 1, the data of each profiled thread is processed on task graph worker threads in parallel.\r\n")
+	TEXT("When 0, it is all processed by the CSV processing thread."),
+	ECVF_Default
+);
+
+// Time between two updates of the CSV processing thread
+static const float GCsvProcessingIntervalMS = 50.0f;
+
 static bool GCsvUseProcessingThread = true;
 static int32 GCsvRepeatCount = 0;
 static int32 GCsvRepeatFrameCount = 0;
@@ -447,10 +468,13 @@ int32 FCsvProfiler::RegisterCategory(const FString& CategoryName, bool bEnableBy
 }
 
 
+// Set on the threads processing thread data on behalf of the CSV processing thread, see FCsvStreamWriter::Process
+static thread_local bool GIsInCsvProcessingTask = false;
+
 bool IsInCsvProcessingThread()
 {
 	uint32 ProcessingThreadId = GGameThreadIsCsvProcessingThread ? GGameThreadId : GCsvProcessingThreadId;
-	return FPlatformTLS::GetCurrentThreadId() == ProcessingThreadId;
+	return FPlatformTLS::GetCurrentThreadId() == ProcessingThreadId || GIsInCsvProcessingTask;
 }
 
 static void HandleCSVProfileCommand(const TArray<FString>& Args)
@@ -749,32 +773,47 @@ public:
 			const_cast<FFrameBoundaries*>(this)->Update(Timeline);
 		}
 
+		return GetFrameNumberForTimestamp(Timeline, Timestamp, CurrentReadFrameIndex);
+	}
+
+	/** Grabs the pending frame data of all timelines. Needed before looking up frame numbers from several threads */
+	void UpdateAll()
+	{
+		Update();
+	}
+
+	/**
+	 * Looks up the frame of a timestamp in the frame data grabbed so far, which can be done from several threads at once. 
+	 * Each thread needs its own ReadFrameIndex, it is where the search starts next time.
+	 */
+	int32 GetFrameNumberForTimestamp(ECsvTimeline::Type Timeline, uint64 Timestamp, int32& ReadFrameIndex) const
+	{
 		const TArray<uint64>& ThreadTimestamps = FrameBoundaryTimestamps[Timeline];
 		if (ThreadTimestamps.Num() == 0 || Timestamp < ThreadTimestamps[0])
 		{
 			// This timestamp is before the first frame, or there are no valid timestamps
-			CurrentReadFrameIndex = 0;
+			ReadFrameIndex = 0;
 			return -1;
 		}
 
-		if (CurrentReadFrameIndex >= ThreadTimestamps.Num())
+		if (ReadFrameIndex >= ThreadTimestamps.Num())
 		{
-			CurrentReadFrameIndex = ThreadTimestamps.Num() - 1;
+			ReadFrameIndex = ThreadTimestamps.Num() - 1;
 		}
 
 
 		// Check if we need to rewind
-		if (CurrentReadFrameIndex > 0 && ThreadTimestamps[CurrentReadFrameIndex - 1] > Timestamp)
+		if (ReadFrameIndex > 0 && ThreadTimestamps[ReadFrameIndex - 1] > Timestamp)
 		{
 			// Binary search to < 4 and then resume linear searching
 			int32 StartPos = 0;
-			int32 EndPos = CurrentReadFrameIndex;
+			int32 EndPos = ReadFrameIndex;
 			while (true)
 			{
 				int32 Diff = (EndPos - StartPos);
 				if (Diff <= 4)
 				{
-					CurrentReadFrameIndex = StartPos;
+					ReadFrameIndex = StartPos;
 					break;
 				}
 				int32 MidPos = (EndPos + StartPos) / 2;
@@ -789,12 +828,12 @@ public:
 			}
 		}
 
-		for (; CurrentReadFrameIndex < ThreadTimestamps.Num(); CurrentReadFrameIndex++)
+		for (; ReadFrameIndex < ThreadTimestamps.Num(); ReadFrameIndex++)
 		{
-			if (Timestamp < ThreadTimestamps[CurrentReadFrameIndex])
+			if (Timestamp < ThreadTimestamps[ReadFrameIndex])
 			{
 				// Might return -1 if this was before the first frame
-				return CurrentReadFrameIndex - 1;
+				return ReadFrameIndex - 1;
 			}
 		}
 		return ThreadTimestamps.Num() - 1;
@@ -1217,21 +1256,8 @@ public:
 		}
 		bIsLineStart = false;
 
-		int32 StrLen;
 		ANSICHAR StringBuffer[256];
-
-		if (FMath::Frac((float)Value) == 0.0f)
-		{
-			StrLen = FCStringAnsi::Snprintf(StringBuffer, 256, "%d", int(Value));
-		}
-		else if (FMath::Abs(Value) < 0.1)
-		{
-			StrLen = FCStringAnsi::Snprintf(StringBuffer, 256, "%.6f", Value);
-		}
-		else
-		{
-			StrLen = FCStringAnsi::Snprintf(StringBuffer, 256, "%.4f", Value);
-		}
+		int32 StrLen = CsvBinary::FormatValue(StringBuffer, UE_ARRAY_COUNT(StringBuffer), Value);
 		SerializeInternal((void*)StringBuffer, sizeof(ANSICHAR) * StrLen);
 	}
 
@@ -1375,7 +1401,7 @@ struct FCsvStatSeries
 		CustomStatFloat
 	};
 
-	FCsvStatSeries(EType InSeriesType, const FCsvStatID& InStatID, FCsvStreamWriter* InWriter, FCsvStatRegister& StatRegister, const FString& ThreadName);
+	FCsvStatSeries(EType InSeriesType, const FCsvStatID& InStatID, class FCsvProfilerThreadDataProcessor* InProcessor, FCsvStatRegister& StatRegister, const FString& ThreadName);
 	void FlushIfDirty();
 
 	void SetTimerValue(uint32 DataFrameNumber, uint64 ElapsedCycles)
@@ -1494,7 +1520,7 @@ struct FCsvStatSeries
 		uint64  AsTimerCycles;
 	} CurrentValue;
 
-	FCsvStreamWriter* Writer;
+	class FCsvProfilerThreadDataProcessor* Processor;
 
 	int32 ColumnIndex;
 
@@ -1509,6 +1535,13 @@ struct FCsvProcessThreadDataStats
 		, EventCount(0)
 	{}
 
+	void Add(const FCsvProcessThreadDataStats& Other)
+	{
+		TimestampCount += Other.TimestampCount;
+		CustomStatCount += Other.CustomStatCount;
+		EventCount += Other.EventCount;
+	}
+
 	uint32 TimestampCount;
 	uint32 CustomStatCount;
 	uint32 EventCount;
@@ -1535,6 +1568,9 @@ class FCsvStreamWriter
 	TMap<int64, FCsvRow> Rows;
 	FCsvWriterHelper Stream;
 
+	/** Set when writing the binary format, the text stream is unused then */
+	TUniquePtr<FCsvBinaryWriter> BinaryWriter;
+
 	// There is no way to know what a frame is completed, to flush a CSV row to disk. Instead, we track the maximum
 	// frame index we've seen from CSV data processing (WriteFrameIndex) and choose to flush all rows that have a
 	// frame index less than (WriteFrameIndex - NumFramesToBuffer). NumFramesToBuffer should be large enough to avoid
@@ -1550,8 +1586,18 @@ class FCsvStreamWriter
 	TArray<FCsvStatSeries*> AllSeries;
 	TArray<class FCsvProfilerThreadDataProcessor*> DataProcessors;
 
+	struct FProcessResult
+	{
+		FCsvProcessThreadDataStats Stats;
+		int32 MinFrameNumberProcessed = MAX_int32;
+	};
+	TArray<FProcessResult> ProcessResults;
+
+	int32 OverloadCount;
+	bool bOverloaded;
+
 public:
-	FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput);
+	FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, bool bInBinaryOutput);
 	~FCsvStreamWriter();
 
 	void AddSeries(FCsvStatSeries* Series);
@@ -1560,18 +1606,34 @@ public:
 	void PushEvent(const FCsvProcessedEvent& Event);
 
 	void FinalizeNextRow();
+	void FinalizeNextBinaryRow();
 	void Process(FCsvProcessThreadDataStats& OutStats);
 
 	void Finalize(const TMap<FString, FString>& Metadata);
 
+	/** Tracks whether processing keeps up with the profiled threads. Returns true when it starts falling behind */
+	bool UpdateOverload(float ProcessingTimeMS)
+	{
+		const bool bWasOverloaded = bOverloaded;
+		bOverloaded = ProcessingTimeMS > GCsvProcessingIntervalMS;
+		if (bOverloaded && !bWasOverloaded)
+		{
+			++OverloadCount;
+			return true;
+		}
+		return false;
+	}
+
+	int32 GetOverloadCount() const { return OverloadCount; }
+
 	inline uint64 GetAllocatedSize() const;
 };
 
-FCsvStatSeries::FCsvStatSeries(EType InSeriesType, const FCsvStatID& InStatID, FCsvStreamWriter* InWriter, FCsvStatRegister& StatRegister, const FString& ThreadName)
+FCsvStatSeries::FCsvStatSeries(EType InSeriesType, const FCsvStatID& InStatID, FCsvProfilerThreadDataProcessor* InProcessor, FCsvStatRegister& StatRegister, const FString& ThreadName)
 	: StatID(InStatID)
 	, SeriesType(InSeriesType)
 	, CurrentWriteFrameNumber(-1)
-	, Writer(InWriter)
+	, Processor(InProcessor)
 	, ColumnIndex(-1)
 	, bDirty(false)
 {
@@ -1599,31 +1661,6 @@ FCsvStatSeries::FCsvStatSeries(EType InSeriesType, const FCsvStatID& InStatID, F
 		// Add a counts prefix
 		Name = TEXT("COUNTS/") + Name;
 	}
-
-	Writer->AddSeries(this);
-}
-
-void FCsvStatSeries::FlushIfDirty()
-{
-	if (bDirty)
-	{
-		FCsvStatSeriesValue Value;
-		switch (SeriesType)
-		{
-		case EType::TimerData:
-			Value.Value.AsFloat = (float)FPlatformTime::ToMilliseconds64(CurrentValue.AsTimerCycles);
-			break;
-		case EType::CustomStatInt:
-			Value.Value.AsInt = CurrentValue.AsIntValue;
-			break;
-		case EType::CustomStatFloat:
-			Value.Value.AsFloat = CurrentValue.AsFloatValue;
-			break;
-		}
-		Writer->PushValue(this, CurrentWriteFrameNumber, Value);
-		CurrentValue.AsTimerCycles = 0;
-		bDirty = false;
-	}
 }
 
 class FCsvProfilerThreadData
@@ -1912,14 +1949,50 @@ class FCsvProfilerThreadDataProcessor
 
 	uint64 LastProcessedTimestamp;
 
+	/** Raw data read by FetchData, waiting to be processed */
+	TArray<FCsvTimingMarker> ThreadMarkers;
+	TArray<FCsvCustomStat> CustomStats;
+	TArray<FCsvEvent> Events;
+
+	/** Where the frame number lookups of this thread's data resume in each timeline */
+	int32 FrameReadIndices[ECsvTimeline::Count];
+
+	struct FPendingValue
+	{
+		FPendingValue(FCsvStatSeries* InSeries, int64 InFrameNumber, const FCsvStatSeriesValue& InValue)
+			: Series(InSeries)
+			, FrameNumber(InFrameNumber)
+			, Value(InValue)
+		{}
+
+		FCsvStatSeries* Series;
+		int64 FrameNumber;
+		FCsvStatSeriesValue Value;
+	};
+
+	/** 
+	 * Output of Process, which may run in parallel with the other processors. It is handed to the writer by CommitPendingData 
+	 * once they are all done.
+	 */
+	TArray<FCsvStatSeries*> PendingSeries;
+	TArray<FPendingValue> PendingValues;
+	TArray<FCsvProcessedEvent> PendingEvents;
+	bool bHasPendingData;
+
 public:
 	FCsvProfilerThreadDataProcessor(FCsvProfilerThreadData::FSharedPtr InThreadData, FCsvStreamWriter* InWriter)
 		: ThreadData(InThreadData)
 		, Writer(InWriter)
 		, LastProcessedTimestamp(0)
+		, bHasPendingData(false)
 	{
 		check(ThreadData->DataProcessor == nullptr);
 		ThreadData->DataProcessor = this;
+
+		for (int32& FrameReadIndex : FrameReadIndices)
+		{
+			FrameReadIndex = 0;
+		}
 	}
 
 	~FCsvProfilerThreadDataProcessor()
@@ -1941,11 +2014,59 @@ public:
 			((uint64)ExclusiveMarkerStack.GetAllocatedSize()) +
 			((uint64)StatSeriesArray.GetAllocatedSize()) +
 			((uint64)StatSeriesArray.Num() * sizeof(FCsvStatSeries)) +
+			((uint64)ThreadMarkers.GetAllocatedSize()) +
+			((uint64)CustomStats.GetAllocatedSize()) +
+			((uint64)Events.GetAllocatedSize()) +
+			((uint64)PendingSeries.GetAllocatedSize()) +
+			((uint64)PendingValues.GetAllocatedSize()) +
+			((uint64)PendingEvents.GetAllocatedSize()) +
 			((uint64)ThreadData->GetAllocatedSize());
 	}
 
+	/** Reads the data recorded by the thread since the last call */
+	void FetchData()
+	{
+		ThreadData->FlushResults(ThreadMarkers, CustomStats, Events);
+	}
+
+	/** Turns the fetched data into stat values. This only touches the processor's own state so processors can run in parallel */
 	void Process(FCsvProcessThreadDataStats& OutStats, int32& OutMinFrameNumberProcessed);
 
+	/** Hands the output of the last Process call to the writer */
+	void CommitPendingData()
+	{
+		for (FCsvStatSeries* Series : PendingSeries)
+		{
+			Writer->AddSeries(Series);
+		}
+		for (const FPendingValue& PendingValue : PendingValues)
+		{
+			Writer->PushValue(PendingValue.Series, PendingValue.FrameNumber, PendingValue.Value);
+		}
+		for (const FCsvProcessedEvent& PendingEvent : PendingEvents)
+		{
+			Writer->PushEvent(PendingEvent);
+		}
+
+		PendingSeries.Reset();
+		PendingValues.Reset();
+		PendingEvents.Reset();
+		bHasPendingData = false;
+	}
+
+	void PushValue(FCsvStatSeries* Series, int64 FrameNumber, const FCsvStatSeriesValue& Value)
+	{
+		if (bHasPendingData)
+		{
+			PendingValues.Emplace(Series, FrameNumber, Value);
+		}
+		else
+		{
+			// Series are also flushed when the writer finalizes rows, that goes straight to the row
+			Writer->PushValue(Series, FrameNumber, Value);
+		}
+	}
+
 private:
 	FCsvStatSeries* FindOrCreateStatSeries(const FCsvStatBase& Stat, FCsvStatSeries::EType SeriesType, bool bIsCountStat)
 	{
@@ -1959,8 +2080,9 @@ private:
 		}
 		if (StatSeriesArray[StatIndex] == nullptr)
 		{
-			Series = new FCsvStatSeries(SeriesType, StatIndex, Writer, StatRegister, ThreadData->ThreadName);
+			Series = new FCsvStatSeries(SeriesType, StatIndex, this, StatRegister, ThreadData->ThreadName);
 			StatSeriesArray[StatIndex] = Series;
+			PendingSeries.Add(Series);
 		}
 		else
 		{
@@ -1974,12 +2096,38 @@ private:
 	}
 };
 
-FCsvStreamWriter::FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput)
-	: Stream(InOutputFile, InBufferSize, bInCompressOutput)
+void FCsvStatSeries::FlushIfDirty()
+{
+	if (bDirty)
+	{
+		FCsvStatSeriesValue Value;
+		switch (SeriesType)
+		{
+		case EType::TimerData:
+			Value.Value.AsFloat = (float)FPlatformTime::ToMilliseconds64(CurrentValue.AsTimerCycles);
+			break;
+		case EType::CustomStatInt:
+			Value.Value.AsInt = CurrentValue.AsIntValue;
+			break;
+		case EType::CustomStatFloat:
+			Value.Value.AsFloat = CurrentValue.AsFloatValue;
+			break;
+		}
+		Processor->PushValue(this, CurrentWriteFrameNumber, Value);
+		CurrentValue.AsTimerCycles = 0;
+		bDirty = false;
+	}
+}
+
+FCsvStreamWriter::FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, bool bInBinaryOutput)
+	: Stream(InOutputFile, bInBinaryOutput ? 0 : InBufferSize, bInCompressOutput && !bInBinaryOutput)
+	, BinaryWriter(bInBinaryOutput ? MakeUnique<FCsvBinaryWriter>(InOutputFile) : nullptr)
 	, WriteFrameIndex(-1)
 	, ReadFrameIndex(-1)
 	, bContinuousWrites(bInContinuousWrites)
 	, bFirstRow(true)
+	, OverloadCount(0)
+	, bOverloaded(false)
 {}
 
 FCsvStreamWriter::~FCsvStreamWriter()
@@ -1996,6 +2144,11 @@ void FCsvStreamWriter::AddSeries(FCsvStatSeries* Series)
 	check(Series->ColumnIndex == -1);
 	Series->ColumnIndex = AllSeries.Num();
 	AllSeries.Add(Series);
+
+	if (BinaryWriter)
+	{
+		verify(BinaryWriter->AddColumn(Series->Name, Series->SeriesType == FCsvStatSeries::EType::CustomStatInt) == Series->ColumnIndex);
+	}
 }
 
 void FCsvStreamWriter::PushValue(FCsvStatSeries* Series, int64 FrameNumber, const FCsvStatSeriesValue& Value)
@@ -2024,6 +2177,12 @@ void FCsvStreamWriter::FinalizeNextRow()
 {
 	ReadFrameIndex++;
 
+	if (BinaryWriter)
+	{
+		FinalizeNextBinaryRow();
+		return;
+	}
+
 	if (bFirstRow)
 	{
 		// Write the first header row
@@ -2093,6 +2252,46 @@ void FCsvStreamWriter::FinalizeNextRow()
 	}
 }
 
+void FCsvStreamWriter::FinalizeNextBinaryRow()
+{
+	// Don't remove yet. Flushing series may modify this row
+	FCsvRow* Row = Rows.Find(ReadFrameIndex);
+	if (Row)
+	{
+		BinaryWriter->BeginRow(ReadFrameIndex);
+
+		for (FCsvProcessedEvent& Event : Row->Events)
+		{
+			BinaryWriter->AddEvent(Event.GetFullName());
+		}
+
+		for (FCsvStatSeries* Series : AllSeries)
+		{
+			// See FinalizeNextRow
+			if (Series->CurrentWriteFrameNumber == ReadFrameIndex)
+				Series->FlushIfDirty();
+
+			if (Row->Values.IsValidIndex(Series->ColumnIndex))
+			{
+				const FCsvStatSeriesValue& Value = Row->Values[Series->ColumnIndex];
+				if (Series->SeriesType == FCsvStatSeries::EType::CustomStatInt)
+				{
+					BinaryWriter->AddValue(Series->ColumnIndex, Value.Value.AsInt);
+				}
+				else
+				{
+					BinaryWriter->AddValue(Series->ColumnIndex, Value.Value.AsFloat);
+				}
+			}
+		}
+
+		BinaryWriter->EndRow();
+
+		// Finally remove the frame data
+		Rows.FindAndRemoveChecked(ReadFrameIndex);
+	}
+}
+
 void FCsvStreamWriter::Finalize(const TMap<FString, FString>& Metadata)
 {
 	// Flush all remaining data
@@ -2101,6 +2300,12 @@ void FCsvStreamWriter::Finalize(const TMap<FString, FString>& Metadata)
 		FinalizeNextRow();
 	}
 
+	if (BinaryWriter)
+	{
+		BinaryWriter->Finalize(Metadata);
+		return;
+	}
+
 	// Write a final summary header row
 	Stream.WriteString("EVENTS");
 	for (FCsvStatSeries* Series : AllSeries)
@@ -2144,10 +2349,35 @@ void FCsvStreamWriter::Process(FCsvProcessThreadDataStats& OutStats)
 		}
 	}
 
-	int32 MinFrameNumberProcessed = MAX_int32;
+	// Read the data of all threads before flushing the frame boundaries. This way, we ensure the frame boundary data is up to date
+	// (we do not want to encounter markers from a frame which hasn't been registered yet)
 	for (FCsvProfilerThreadDataProcessor* DataProcessor : DataProcessors)
 	{
-		DataProcessor->Process(OutStats, MinFrameNumberProcessed);
+		DataProcessor->FetchData();
+	}
+	FPlatformMisc::MemoryBarrier();
+	GFrameBoundaries.UpdateAll();
+
+	// Threads are processed independently of each other, their output is merged afterwards in a fixed order
+	ProcessResults.Reset();
+	ProcessResults.SetNum(DataProcessors.Num());
+
+	const bool bParallel = DataProcessors.Num() > 1 && CVarCsvParallelProcessing.GetValueOnAnyThread() != 0 && FTaskGraphInterface::IsRunning();
+	ParallelFor(DataProcessors.Num(), [this](int32 Index)
+	{
+		LLM_SCOPE(ELLMTag::CsvProfiler);
+		TGuardValue<bool> ProcessingTaskGuard(GIsInCsvProcessingTask, true);
+
+		FProcessResult& Result = ProcessResults[Index];
+		DataProcessors[Index]->Process(Result.Stats, Result.MinFrameNumberProcessed);
+	}, bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+
+	int32 MinFrameNumberProcessed = MAX_int32;
+	for (int32 Index = 0; Index < DataProcessors.Num(); ++Index)
+	{
+		DataProcessors[Index]->CommitPendingData();
+		OutStats.Add(ProcessResults[Index].Stats);
+		MinFrameNumberProcessed = FMath::Min(MinFrameNumberProcessed, ProcessResults[Index].MinFrameNumberProcessed);
 	}
 
 	if (bContinuousWrites && MinFrameNumberProcessed < MAX_int32)
@@ -2166,7 +2396,8 @@ uint64 FCsvStreamWriter::GetAllocatedSize() const
 		((uint64)Rows.GetAllocatedSize()) +
 		((uint64)AllSeries.GetAllocatedSize()) +
 		((uint64)DataProcessors.GetAllocatedSize()) +
-		((uint64)Stream.GetAllocatedSize());
+		((uint64)Stream.GetAllocatedSize()) +
+		(BinaryWriter ? BinaryWriter->GetAllocatedSize() : 0);
 
 	for (const auto& Pair          : Rows)           { Size += (uint64)Pair.Value.GetAllocatedSize();     }
 	for (const auto& Series        : AllSeries)      { Size += (uint64)Series->GetAllocatedSize();        }
@@ -2212,7 +2443,7 @@ public:
 
 	virtual uint32 Run() override
 	{
-		const float TimeBetweenUpdatesMS = 50.0f;
+		const float TimeBetweenUpdatesMS = GCsvProcessingIntervalMS;
 		GCsvProcessingThreadId = FPlatformTLS::GetCurrentThreadId();
 		GGameThreadIsCsvProcessingThread = false;
 
@@ -2251,22 +2482,15 @@ void FCsvProfilerThreadDataProcessor::Process(FCsvProcessThreadDataStats& OutSta
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_FCsvProfilerThreadData_ProcessThreadData);
 
-	// We can call this from the game thread just before reading back the data, or from the CSV processing thread
+	// We can call this from the game thread just before reading back the data, or from the CSV processing thread and its tasks
 	check(IsInCsvProcessingThread());
-
-	// Read the raw CSV data
-	TArray<FCsvTimingMarker> ThreadMarkers;
-	TArray<FCsvCustomStat> CustomStats;
-	TArray<FCsvEvent> Events;
-	ThreadData->FlushResults(ThreadMarkers, CustomStats, Events);
+	check(!bHasPendingData);
+	bHasPendingData = true;
 
 	OutStats.TimestampCount += ThreadMarkers.Num();
 	OutStats.CustomStatCount += CustomStats.Num();
 	OutStats.EventCount += Events.Num();
 
-	// Flush the frame boundaries after the stat data. This way, we ensure the frame boundary data is up to date
-	// (we do not want to encounter markers from a frame which hasn't been registered yet)
-	FPlatformMisc::MemoryBarrier();
 	ECsvTimeline::Type Timeline = (ThreadData->ThreadId == GRenderThreadId || ThreadData->ThreadId == GRHIThreadId) ? ECsvTimeline::Renderthread : ECsvTimeline::Gamethread;
 
 	if (ThreadMarkers.Num() > 0)
@@ -2331,7 +2555,7 @@ void FCsvProfilerThreadDataProcessor::Process(FCsvProcessThreadDataStats& OutSta
 		bAllowExclusiveMarkerInsertion = !bInsertExtraMarker;
 
 		FCsvTimingMarker& Marker = *MarkerPtr;
-		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, Marker.GetTimestamp());
+		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, Marker.GetTimestamp(), FrameReadIndices[Timeline]);
 		OutMinFrameNumberProcessed = FMath::Min(FrameNumber, OutMinFrameNumberProcessed);
 		if (Marker.IsBeginMarker())
 		{
@@ -2396,7 +2620,7 @@ void FCsvProfilerThreadDataProcessor::Process(FCsvProcessThreadDataStats& OutSta
 	for (int i = 0; i < CustomStats.Num(); i++)
 	{
 		FCsvCustomStat& CustomStat = CustomStats[i];
-		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, CustomStat.GetTimestamp());
+		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, CustomStat.GetTimestamp(), FrameReadIndices[Timeline]);
 		OutMinFrameNumberProcessed = FMath::Min(FrameNumber, OutMinFrameNumberProcessed);
 		if (FrameNumber >= 0)
 		{
@@ -2424,7 +2648,7 @@ void FCsvProfilerThreadDataProcessor::Process(FCsvProcessThreadDataStats& OutSta
 	for (int i = 0; i < Events.Num(); i++)
 	{
 		FCsvEvent& Event = Events[i];
-		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, Event.Timestamp);
+		int32 FrameNumber = GFrameBoundaries.GetFrameNumberForTimestamp(Timeline, Event.Timestamp, FrameReadIndices[Timeline]);
 		OutMinFrameNumberProcessed = FMath::Min(FrameNumber, OutMinFrameNumberProcessed);
 		if (FrameNumber >= 0)
 		{
@@ -2432,9 +2656,13 @@ void FCsvProfilerThreadDataProcessor::Process(FCsvProcessThreadDataStats& OutSta
 			ProcessedEvent.EventText = Event.EventText;
 			ProcessedEvent.FrameNumber = FrameNumber;
 			ProcessedEvent.CategoryIndex = Event.CategoryIndex;
-			Writer->PushEvent(ProcessedEvent);
+			PendingEvents.Add(ProcessedEvent);
 		}
 	}
+
+	ThreadMarkers.Reset();
+	CustomStats.Reset();
+	Events.Reset();
 }
 
 
@@ -2575,7 +2803,8 @@ void FCsvProfiler::BeginFrame()
 					break;
 				}
 
-				const TCHAR* CsvExtension = bCompressOutput ? TEXT(".csv.gz") : TEXT(".csv");
+				const bool bBinaryOutput = CVarCsvBinaryOutput.GetValueOnGameThread() != 0;
+				const TCHAR* CsvExtension = bBinaryOutput ? TEXT(".csvbin") : bCompressOutput ? TEXT(".csv.gz") : TEXT(".csv");
 
 				// Determine the output path and filename based on override params
 				FString DestinationFolder = CurrentCommand.DestinationFolder.IsEmpty() ? FPaths::ProfilingDir() + TEXT("CSV/") : CurrentCommand.DestinationFolder + TEXT("/");
@@ -2590,7 +2819,8 @@ void FCsvProfiler::BeginFrame()
 				else
 				{
 					
-					CsvWriter = new FCsvStreamWriter(OutputFile.ToSharedRef(), bContinuousWrites, BufferSize, bCompressOutput);
+					CsvWriter = new FCsvStreamWriter(OutputFile.ToSharedRef(), bContinuousWrites, BufferSize, bCompressOutput, bBinaryOutput);
+					SetMetadata(TEXT("CsvProcessingOverloads"), TEXT("0"));
 
 					NumFramesToCapture = CurrentCommand.Value;
 					GCsvRepeatFrameCount = NumFramesToCapture;
@@ -3215,6 +3445,11 @@ void FCsvProfiler::Init()
 	}
 	FParse::Value(FCommandLine::Get(), TEXT("csvRepeat="), GCsvRepeatCount);
 
+	if (FParse::Param(FCommandLine::Get(), TEXT("csvBinary")))
+	{
+		CVarCsvBinaryOutput->Set(1);
+	}
+
 	int32 CompressionMode;
 	if (FParse::Value(FCommandLine::Get(), TEXT("csvCompression="), CompressionMode))
 	{
@@ -3299,6 +3534,14 @@ float FCsvProfiler::ProcessStatData()
 		CSV_CUSTOM_STAT(CsvProfiler, NumCustomStatsProcessed, (int32)Stats.CustomStatCount, ECsvCustomStatOp::Accumulate);
 		CSV_CUSTOM_STAT(CsvProfiler, NumEventsProcessed, (int32)Stats.EventCount, ECsvCustomStatOp::Accumulate);
 		CSV_CUSTOM_STAT(CsvProfiler, ProcessCSVStats, ElapsedMS, ECsvCustomStatOp::Accumulate);
+
+		if (CsvWriter && CsvWriter->UpdateOverload(ElapsedMS))
+		{
+			// Data is produced faster than it is processed, it piles up in memory until processing catches up
+			UE_LOG(LogCsvProfiler, Warning, TEXT("Processing the CSV data took %.1fms, more than the %.0fms between updates"), ElapsedMS, GCsvProcessingIntervalMS);
+			CSV_EVENT(CsvProfiler, TEXT("CsvProcessingOverload"));
+			SetMetadata(TEXT("CsvProcessingOverloads"), *FString::FromInt(CsvWriter->GetOverloadCount()));
+		}
 	}
 	return ElapsedMS;
 }
@@ -0,0 +1,743 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/CsvProfilerBinary.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/LogMacros.h"
+#include "Misc/CString.h"
+#include "Misc/Compression.h"
+#include "Serialization/Archive.h"
+#include "Containers/StringConv.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCsvBinary, Log, All);
+
+namespace CsvBinary
+{
+	int32 FormatValue(ANSICHAR* Buffer, int32 BufferSize, double Value)
+	{
+		if (FMath::Frac((float)Value) == 0.0f)
+		{
+			return FCStringAnsi::Snprintf(Buffer, BufferSize, "%d", int(Value));
+		}
+		else if (FMath::Abs(Value) < 0.1)
+		{
+			return FCStringAnsi::Snprintf(Buffer, BufferSize, "%.6f", Value);
+		}
+		else
+		{
+			return FCStringAnsi::Snprintf(Buffer, BufferSize, "%.4f", Value);
+		}
+	}
+
+	// All values are written little endian, which is what FArchive uses too by default
+
+	static void WriteUInt32(TArray<uint8>& Out, uint32 Value)
+	{
+		Out.Append((const uint8*)&Value, sizeof(Value));
+	}
+
+	static void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+	{
+		do
+		{
+			uint8 HasMoreBytes = (uint8)((Value > uint64(0x7F)) << 7);
+			Out.Add((uint8)(Value & 0x7F) | HasMoreBytes);
+			Value >>= 7;
+		} while (Value > 0);
+	}
+
+	static void WriteString(TArray<uint8>& Out, const FString& Str)
+	{
+		FTCHARToUTF8 Utf8(*Str);
+		WriteUInt32(Out, Utf8.Length());
+		Out.Append((const uint8*)Utf8.Get(), Utf8.Length());
+	}
+
+	static bool ReadVarUInt(const uint8*& Ptr, const uint8* End, uint64& OutValue)
+	{
+		OutValue = 0;
+		for (uint32 Shift = 0; Ptr < End && Shift < 64; Shift += 7)
+		{
+			const uint8 Byte = *Ptr++;
+			OutValue |= uint64(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool ReadBytes(const uint8*& Ptr, const uint8* End, void* Out, uint32 Size)
+	{
+		if (uint32(End - Ptr) < Size)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Out, Ptr, Size);
+		Ptr += Size;
+		return true;
+	}
+
+	static bool ReadString(const uint8*& Ptr, const uint8* End, FString& OutStr)
+	{
+		uint32 Length;
+		if (!ReadBytes(Ptr, End, &Length, sizeof(Length)) || uint32(End - Ptr) < Length)
+		{
+			return false;
+		}
+		FUTF8ToTCHAR Converted((const ANSICHAR*)Ptr, Length);
+		OutStr = FString(Converted.Length(), Converted.Get());
+		Ptr += Length;
+		return true;
+	}
+
+	static bool ReadString(FArchive& Ar, FString& OutStr)
+	{
+		uint32 Length = 0;
+		Ar << Length;
+		if (Ar.IsError() || Length > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+		TArray<uint8> Utf8;
+		Utf8.SetNumUninitialized(Length);
+		Ar.Serialize(Utf8.GetData(), Length);
+		const uint8* Ptr = Utf8.GetData();
+		FUTF8ToTCHAR Converted((const ANSICHAR*)Ptr, Length);
+		OutStr = FString(Converted.Length(), Converted.Get());
+		return !Ar.IsError();
+	}
+
+	static uint32 ZigZag(int32 Value)
+	{
+		return (uint32(Value) << 1) ^ uint32(Value >> 31);
+	}
+
+	static int32 UnZigZag(uint32 Value)
+	{
+		return int32(Value >> 1) ^ -int32(Value & 1);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//	FCsvBinaryWriter
+//-----------------------------------------------------------------------------
+FCsvBinaryWriter::FCsvBinaryWriter(const TSharedRef<FArchive>& InOutputFile, int32 InRowsPerChunk)
+	: OutputFile(InOutputFile)
+	, RowsPerChunk(FMath::Max(InRowsPerChunk, 1))
+	, NumColumnsWritten(0)
+	, NumRows(0)
+	, CurrentFrameNumber(-1)
+	, LastRowFrameNumber(-1)
+	, LastEventFrameNumber(-1)
+	, bFinalized(false)
+{
+	TArray<uint8> Header;
+	CsvBinary::WriteUInt32(Header, CsvBinary::FileMagic);
+	CsvBinary::WriteUInt32(Header, CsvBinary::Version);
+	OutputFile->Serialize(Header.GetData(), Header.Num());
+}
+
+FCsvBinaryWriter::~FCsvBinaryWriter()
+{
+	// Keep what was captured if the writer goes away without being finalized
+	if (!bFinalized && NumRows > 0)
+	{
+		WriteChunk();
+	}
+}
+
+int32 FCsvBinaryWriter::AddColumn(const FString& Name, bool bIsInteger)
+{
+	FColumn& Column = Columns.AddDefaulted_GetRef();
+	Column.Name = Name;
+	Column.bIsInteger = bIsInteger;
+	Column.LastFrameNumber = -1;
+	return Columns.Num() - 1;
+}
+
+void FCsvBinaryWriter::BeginRow(int64 FrameNumber)
+{
+	check(!bFinalized);
+	check(FrameNumber > CurrentFrameNumber);
+	CurrentFrameNumber = FrameNumber;
+
+	CsvBinary::WriteVarUInt(RowData, uint64(FrameNumber - LastRowFrameNumber));
+	LastRowFrameNumber = FrameNumber;
+}
+
+void FCsvBinaryWriter::AddEvent(const FString& EventText)
+{
+	CsvBinary::WriteVarUInt(EventData, uint64(CurrentFrameNumber - LastEventFrameNumber));
+	CsvBinary::WriteString(EventData, EventText);
+	LastEventFrameNumber = CurrentFrameNumber;
+}
+
+void FCsvBinaryWriter::AddValue(int32 ColumnIndex, int32 Value)
+{
+	FColumn& Column = Columns[ColumnIndex];
+	check(Column.bIsInteger);
+	if (Value != 0)
+	{
+		CsvBinary::WriteVarUInt(Column.Data, uint64(CurrentFrameNumber - Column.LastFrameNumber));
+		CsvBinary::WriteVarUInt(Column.Data, CsvBinary::ZigZag(Value));
+		Column.LastFrameNumber = CurrentFrameNumber;
+	}
+}
+
+void FCsvBinaryWriter::AddValue(int32 ColumnIndex, float Value)
+{
+	FColumn& Column = Columns[ColumnIndex];
+	check(!Column.bIsInteger);
+	if (Value != 0.0f)
+	{
+		CsvBinary::WriteVarUInt(Column.Data, uint64(CurrentFrameNumber - Column.LastFrameNumber));
+		Column.Data.Append((const uint8*)&Value, sizeof(Value));
+		Column.LastFrameNumber = CurrentFrameNumber;
+	}
+}
+
+void FCsvBinaryWriter::EndRow()
+{
+	if (++NumRows >= RowsPerChunk)
+	{
+		WriteChunk();
+	}
+}
+
+void FCsvBinaryWriter::Finalize(const TMap<FString, FString>& Metadata)
+{
+	check(!bFinalized);
+	if (NumRows > 0)
+	{
+		WriteChunk();
+	}
+
+	// Same order as the text files, with the commandline last
+	TArray<uint8> Block;
+	CsvBinary::WriteUInt32(Block, CsvBinary::MetadataMagic);
+	CsvBinary::WriteUInt32(Block, Metadata.Num());
+	const TPair<FString, FString>* CommandlineEntry = nullptr;
+	for (const TPair<FString, FString>& Pair : Metadata)
+	{
+		if (Pair.Key == TEXT("Commandline"))
+		{
+			CommandlineEntry = &Pair;
+		}
+		else
+		{
+			CsvBinary::WriteString(Block, Pair.Key);
+			CsvBinary::WriteString(Block, Pair.Value);
+		}
+	}
+	if (CommandlineEntry)
+	{
+		CsvBinary::WriteString(Block, CommandlineEntry->Key);
+		CsvBinary::WriteString(Block, CommandlineEntry->Value);
+	}
+	OutputFile->Serialize(Block.GetData(), Block.Num());
+	OutputFile->Flush();
+
+	bFinalized = true;
+}
+
+void FCsvBinaryWriter::WriteChunk()
+{
+	TArray<uint8> BlockTable;
+	TArray<uint8> Blocks;
+
+	WriteBlock(CsvBinary::RowBlockIndex, RowData, BlockTable, Blocks);
+	if (EventData.Num() > 0)
+	{
+		WriteBlock(CsvBinary::EventBlockIndex, EventData, BlockTable, Blocks);
+	}
+	for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+	{
+		if (Columns[ColumnIndex].Data.Num() > 0)
+		{
+			WriteBlock(ColumnIndex, Columns[ColumnIndex].Data, BlockTable, Blocks);
+		}
+	}
+
+	TArray<uint8> Header;
+	CsvBinary::WriteUInt32(Header, CsvBinary::ChunkMagic);
+	CsvBinary::WriteUInt32(Header, Columns.Num() - NumColumnsWritten);
+	for (int32 ColumnIndex = NumColumnsWritten; ColumnIndex < Columns.Num(); ++ColumnIndex)
+	{
+		Header.Add(Columns[ColumnIndex].bIsInteger ? 1 : 0);
+		CsvBinary::WriteString(Header, Columns[ColumnIndex].Name);
+	}
+	CsvBinary::WriteUInt32(Header, NumRows);
+	CsvBinary::WriteUInt32(Header, BlockTable.Num() / (3 * sizeof(uint32)));
+
+	OutputFile->Serialize(Header.GetData(), Header.Num());
+	OutputFile->Serialize(BlockTable.GetData(), BlockTable.Num());
+	OutputFile->Serialize(Blocks.GetData(), Blocks.Num());
+
+	// Frame numbers are relative to the start of the chunk so chunks can be decoded on their own
+	RowData.Reset();
+	EventData.Reset();
+	for (FColumn& Column : Columns)
+	{
+		Column.Data.Reset();
+		Column.LastFrameNumber = -1;
+	}
+	LastRowFrameNumber = -1;
+	LastEventFrameNumber = -1;
+	NumColumnsWritten = Columns.Num();
+	NumRows = 0;
+}
+
+void FCsvBinaryWriter::WriteBlock(int32 BlockIndex, const TArray<uint8>& Data, TArray<uint8>& OutBlockTable, TArray<uint8>& OutBlocks)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Data.Num());
+	CompressionBuffer.SetNumUninitialized(CompressedSize, false);
+
+	const bool bCompressed = FCompression::CompressMemory(NAME_Zlib, CompressionBuffer.GetData(), CompressedSize, Data.GetData(), Data.Num(), COMPRESS_BiasSpeed)
+		&& CompressedSize < Data.Num();
+	if (bCompressed)
+	{
+		OutBlocks.Append(CompressionBuffer.GetData(), CompressedSize);
+	}
+	else
+	{
+		// Blocks which don't compress are stored as they are, their compressed and uncompressed sizes match
+		CompressedSize = Data.Num();
+		OutBlocks.Append(Data);
+	}
+
+	CsvBinary::WriteUInt32(OutBlockTable, uint32(BlockIndex));
+	CsvBinary::WriteUInt32(OutBlockTable, uint32(CompressedSize));
+	CsvBinary::WriteUInt32(OutBlockTable, uint32(Data.Num()));
+}
+
+uint64 FCsvBinaryWriter::GetAllocatedSize() const
+{
+	uint64 Size =
+		((uint64)Columns.GetAllocatedSize()) +
+		((uint64)RowData.GetAllocatedSize()) +
+		((uint64)EventData.GetAllocatedSize()) +
+		((uint64)CompressionBuffer.GetAllocatedSize());
+
+	for (const FColumn& Column : Columns)
+	{
+		Size += (uint64)Column.Name.GetAllocatedSize() + (uint64)Column.Data.GetAllocatedSize();
+	}
+	return Size;
+}
+
+//-----------------------------------------------------------------------------
+//	FCsvBinaryReader
+//-----------------------------------------------------------------------------
+FCsvBinaryReader::FCsvBinaryReader()
+{
+}
+
+FCsvBinaryReader::~FCsvBinaryReader()
+{
+}
+
+bool FCsvBinaryReader::Open(const TCHAR* Filename)
+{
+	return Open(TUniquePtr<FArchive>(IFileManager::Get().CreateFileReader(Filename)));
+}
+
+bool FCsvBinaryReader::Open(TUniquePtr<FArchive>&& InArchive)
+{
+	Archive = MoveTemp(InArchive);
+	Columns.Reset();
+	Chunks.Reset();
+	Metadata.Reset();
+
+	if (!Archive)
+	{
+		return false;
+	}
+
+	FArchive& Ar = *Archive;
+	const int64 TotalSize = Ar.TotalSize();
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic << Version;
+	if (Ar.IsError() || Magic != CsvBinary::FileMagic || Version != CsvBinary::Version)
+	{
+		return false;
+	}
+
+	// Only the chunk headers are read, the blocks are skipped. A chunk cut short ends the file
+	while (Ar.Tell() + int64(sizeof(uint32)) <= TotalSize)
+	{
+		Ar << Magic;
+		if (Magic == CsvBinary::MetadataMagic)
+		{
+			uint32 NumEntries = 0;
+			Ar << NumEntries;
+			for (uint32 Index = 0; Index < NumEntries && !Ar.IsError(); ++Index)
+			{
+				FString Key, Value;
+				if (!CsvBinary::ReadString(Ar, Key) || !CsvBinary::ReadString(Ar, Value))
+				{
+					break;
+				}
+				Metadata.Emplace(MoveTemp(Key), MoveTemp(Value));
+			}
+			break;
+		}
+
+		if (Magic != CsvBinary::ChunkMagic)
+		{
+			break;
+		}
+
+		const int32 NumColumnsBefore = Columns.Num();
+		uint32 NumNewColumns = 0;
+		Ar << NumNewColumns;
+		for (uint32 Index = 0; Index < NumNewColumns && !Ar.IsError(); ++Index)
+		{
+			uint8 bIsInteger = 0;
+			Ar << bIsInteger;
+			FColumn& Column = Columns.AddDefaulted_GetRef();
+			Column.bIsInteger = !!bIsInteger;
+			if (!CsvBinary::ReadString(Ar, Column.Name))
+			{
+				break;
+			}
+		}
+
+		uint32 NumRows = 0;
+		uint32 NumBlocks = 0;
+		Ar << NumRows << NumBlocks;
+		if (Ar.IsError() || int64(NumBlocks) * 3 * sizeof(uint32) > TotalSize - Ar.Tell())
+		{
+			Columns.SetNum(NumColumnsBefore);
+			break;
+		}
+
+		FChunk Chunk;
+		Chunk.Blocks.SetNum(NumBlocks);
+		for (FBlock& Block : Chunk.Blocks)
+		{
+			uint32 BlockIndex = 0;
+			Ar << BlockIndex << Block.CompressedSize << Block.UncompressedSize;
+			Block.BlockIndex = int32(BlockIndex);
+		}
+
+		int64 Offset = Ar.Tell();
+		for (FBlock& Block : Chunk.Blocks)
+		{
+			Block.Offset = Offset;
+			Offset += Block.CompressedSize;
+		}
+
+		if (Ar.IsError() || Offset > TotalSize)
+		{
+			Columns.SetNum(NumColumnsBefore);
+			break;
+		}
+
+		Chunks.Add(MoveTemp(Chunk));
+		Ar.Seek(Offset);
+	}
+
+	Ar.ClearError();
+	return true;
+}
+
+int32 FCsvBinaryReader::FindColumn(const FString& Name) const
+{
+	return Columns.IndexOfByPredicate([&Name](const FColumn& Column) { return Column.Name == Name; });
+}
+
+const FCsvBinaryReader::FBlock* FCsvBinaryReader::FindBlock(const FChunk& Chunk, int32 BlockIndex) const
+{
+	return Chunk.Blocks.FindByPredicate([BlockIndex](const FBlock& Block) { return Block.BlockIndex == BlockIndex; });
+}
+
+bool FCsvBinaryReader::ReadBlock(const FBlock& Block, TArray<uint8>& OutData)
+{
+	FArchive& Ar = *Archive;
+	Ar.Seek(Block.Offset);
+
+	OutData.SetNumUninitialized(Block.UncompressedSize, false);
+	if (Block.CompressedSize == Block.UncompressedSize)
+	{
+		Ar.Serialize(OutData.GetData(), Block.UncompressedSize);
+		return !Ar.IsError();
+	}
+
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(Block.CompressedSize);
+	Ar.Serialize(CompressedData.GetData(), Block.CompressedSize);
+	return !Ar.IsError() && FCompression::UncompressMemory(NAME_Zlib, OutData.GetData(), OutData.Num(), CompressedData.GetData(), CompressedData.Num());
+}
+
+bool FCsvBinaryReader::ReadRows(TArray<int64>& OutFrameNumbers)
+{
+	OutFrameNumbers.Reset();
+
+	TArray<uint8> Data;
+	for (const FChunk& Chunk : Chunks)
+	{
+		const FBlock* Block = FindBlock(Chunk, CsvBinary::RowBlockIndex);
+		if (!Block || !ReadBlock(*Block, Data))
+		{
+			return false;
+		}
+
+		int64 FrameNumber = -1;
+		for (const uint8* Ptr = Data.GetData(), *End = Ptr + Data.Num(); Ptr < End; )
+		{
+			uint64 Delta;
+			if (!CsvBinary::ReadVarUInt(Ptr, End, Delta))
+			{
+				return false;
+			}
+			FrameNumber += int64(Delta);
+			OutFrameNumbers.Add(FrameNumber);
+		}
+	}
+	return true;
+}
+
+bool FCsvBinaryReader::ReadColumn(int32 ColumnIndex, TArray<int64>& OutFrameNumbers, TArray<double>& OutValues)
+{
+	OutFrameNumbers.Reset();
+	OutValues.Reset();
+	if (!Columns.IsValidIndex(ColumnIndex))
+	{
+		return false;
+	}
+	const bool bIsInteger = Columns[ColumnIndex].bIsInteger;
+
+	TArray<uint8> Data;
+	for (const FChunk& Chunk : Chunks)
+	{
+		const FBlock* Block = FindBlock(Chunk, ColumnIndex);
+		if (!Block)
+		{
+			// No values in this chunk
+			continue;
+		}
+		if (!ReadBlock(*Block, Data))
+		{
+			return false;
+		}
+
+		int64 FrameNumber = -1;
+		for (const uint8* Ptr = Data.GetData(), *End = Ptr + Data.Num(); Ptr < End; )
+		{
+			uint64 Delta;
+			if (!CsvBinary::ReadVarUInt(Ptr, End, Delta))
+			{
+				return false;
+			}
+			FrameNumber += int64(Delta);
+
+			if (bIsInteger)
+			{
+				uint64 Value;
+				if (!CsvBinary::ReadVarUInt(Ptr, End, Value))
+				{
+					return false;
+				}
+				OutValues.Add(CsvBinary::UnZigZag(uint32(Value)));
+			}
+			else
+			{
+				float Value;
+				if (!CsvBinary::ReadBytes(Ptr, End, &Value, sizeof(Value)))
+				{
+					return false;
+				}
+				OutValues.Add(Value);
+			}
+			OutFrameNumbers.Add(FrameNumber);
+		}
+	}
+	return true;
+}
+
+bool FCsvBinaryReader::ReadEvents(TArray<int64>& OutFrameNumbers, TArray<FString>& OutEvents)
+{
+	OutFrameNumbers.Reset();
+	OutEvents.Reset();
+
+	TArray<uint8> Data;
+	for (const FChunk& Chunk : Chunks)
+	{
+		const FBlock* Block = FindBlock(Chunk, CsvBinary::EventBlockIndex);
+		if (!Block)
+		{
+			continue;
+		}
+		if (!ReadBlock(*Block, Data))
+		{
+			return false;
+		}
+
+		int64 FrameNumber = -1;
+		for (const uint8* Ptr = Data.GetData(), *End = Ptr + Data.Num(); Ptr < End; )
+		{
+			uint64 Delta;
+			FString Event;
+			if (!CsvBinary::ReadVarUInt(Ptr, End, Delta) || !CsvBinary::ReadString(Ptr, End, Event))
+			{
+				return false;
+			}
+			FrameNumber += int64(Delta);
+			OutFrameNumbers.Add(FrameNumber);
+			OutEvents.Add(MoveTemp(Event));
+		}
+	}
+	return true;
+}
+
+bool FCsvBinaryReader::WriteCsv(FArchive& OutCsv)
+{
+	TArray<int64> RowFrameNumbers;
+	TArray<int64> EventFrameNumbers;
+	TArray<FString> Events;
+	if (!ReadRows(RowFrameNumbers) || !ReadEvents(EventFrameNumbers, Events))
+	{
+		return false;
+	}
+
+	TArray<TArray<int64>> ColumnFrameNumbers;
+	TArray<TArray<double>> ColumnValues;
+	ColumnFrameNumbers.SetNum(Columns.Num());
+	ColumnValues.SetNum(Columns.Num());
+	for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+	{
+		if (!ReadColumn(ColumnIndex, ColumnFrameNumbers[ColumnIndex], ColumnValues[ColumnIndex]))
+		{
+			return false;
+		}
+	}
+
+	TArray<ANSICHAR> Text;
+	auto Append = [&Text](const FString& Str)
+	{
+		auto AnsiStr = StringCast<ANSICHAR>(*Str);
+		Text.Append(AnsiStr.Get(), AnsiStr.Length());
+	};
+	auto Flush = [&Text, &OutCsv]()
+	{
+		OutCsv.Serialize(Text.GetData(), Text.Num());
+		Text.Reset();
+	};
+	auto WriteHeaderRow = [this, &Text, &Append]()
+	{
+		Append(TEXT("EVENTS"));
+		for (const FColumn& Column : Columns)
+		{
+			Text.Add(',');
+			Append(Column.Name);
+		}
+		Text.Add('\n');
+	};
+
+	WriteHeaderRow();
+
+	int32 EventIndex = 0;
+	TArray<int32> ColumnCursors;
+	ColumnCursors.SetNumZeroed(Columns.Num());
+	for (int64 FrameNumber : RowFrameNumbers)
+	{
+		// Events are sanitized the same way the text writer does it
+		for (int32 FirstEventIndex = EventIndex; EventIndex < Events.Num() && EventFrameNumbers[EventIndex] == FrameNumber; ++EventIndex)
+		{
+			if (EventIndex > FirstEventIndex)
+			{
+				Text.Add(';');
+			}
+			FString SanitizedText = Events[EventIndex];
+			SanitizedText.ReplaceInline(TEXT(";"), TEXT("."));
+			SanitizedText.ReplaceInline(TEXT(","), TEXT("."));
+			Append(SanitizedText);
+		}
+
+		for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+		{
+			double Value = 0.0;
+			int32& Cursor = ColumnCursors[ColumnIndex];
+			if (Cursor < ColumnFrameNumbers[ColumnIndex].Num() && ColumnFrameNumbers[ColumnIndex][Cursor] == FrameNumber)
+			{
+				Value = ColumnValues[ColumnIndex][Cursor++];
+			}
+
+			ANSICHAR ValueString[256];
+			Text.Add(',');
+			Text.Append(ValueString, CsvBinary::FormatValue(ValueString, UE_ARRAY_COUNT(ValueString), Value));
+		}
+		Text.Add('\n');
+
+		if (Text.Num() > 64 * 1024)
+		{
+			Flush();
+		}
+	}
+
+	if (Metadata.Num() > 0)
+	{
+		WriteHeaderRow();
+
+		Append(TEXT("[HasHeaderRowAtEnd],1"));
+		for (const TPair<FString, FString>& Pair : Metadata)
+		{
+			Append(FString::Printf(TEXT(",[%s],%s"), *Pair.Key, *Pair.Value));
+		}
+	}
+
+	Flush();
+	return !OutCsv.IsError();
+}
+
+bool FCsvBinaryReader::ConvertToCsv(const TCHAR* BinaryFilename, const TCHAR* CsvFilename)
+{
+	FCsvBinaryReader Reader;
+	if (!Reader.Open(BinaryFilename))
+	{
+		UE_LOG(LogCsvBinary, Error, TEXT("\"%s\" is not a binary CSV file"), BinaryFilename);
+		return false;
+	}
+
+	TUniquePtr<FArchive> CsvFile(IFileManager::Get().CreateFileWriter(CsvFilename));
+	if (!CsvFile)
+	{
+		UE_LOG(LogCsvBinary, Error, TEXT("Failed to create \"%s\""), CsvFilename);
+		return false;
+	}
+
+	bool bOk = Reader.WriteCsv(*CsvFile);
+	bOk &= CsvFile->Close();
+	UE_CLOG(!bOk, LogCsvBinary, Error, TEXT("Failed to convert \"%s\" to \"%s\""), BinaryFilename, CsvFilename);
+	return bOk;
+}
+
+static void HandleCsvConvertBinaryCommand(const TArray<FString>& Args)
+{
+	if (Args.Num() < 1)
+	{
+		UE_LOG(LogCsvBinary, Display, TEXT("Usage: csv.ConvertBinary <BinaryFile> [CsvFile]"));
+		return;
+	}
+
+	FString CsvFilename = Args.Num() > 1 ? Args[1] : Args[0].Replace(TEXT(".csvbin"), TEXT(".csv"));
+	if (CsvFilename == Args[0])
+	{
+		CsvFilename += TEXT(".csv");
+	}
+
+	if (FCsvBinaryReader::ConvertToCsv(*Args[0], *CsvFilename))
+	{
+		UE_LOG(LogCsvBinary, Display, TEXT("Converted \"%s\" to \"%s\""), *Args[0], *CsvFilename);
+	}
+}
+
+static FAutoConsoleCommand HandleCsvConvertBinaryCmd(
+	TEXT("csv.ConvertBinary"),
+	TEXT("Converts a binary CSV profile to a text CSV file. Usage: csv.ConvertBinary <BinaryFile> [CsvFile]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&HandleCsvConvertBinaryCommand)
+);
@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/HardwareCounters.h"
+
+#if HARDWARECOUNTERS_ENABLED
+
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "Logging/LogMacros.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Parse.h"
+#include "Trace/Trace.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogHardwareCounters, Log, All);
+
+UE_TRACE_CHANNEL(HardwareCountersChannel)
+
+UE_TRACE_EVENT_BEGIN(HardwareCounters, Scope)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycles)
+	UE_TRACE_EVENT_FIELD(uint64, Instructions)
+	UE_TRACE_EVENT_FIELD(uint64, CacheMisses)
+	UE_TRACE_EVENT_FIELD(uint64, BranchMisses)
+UE_TRACE_EVENT_END()
+
+bool FHardwareCounters::bEnabled = false;
+
+namespace UE4HardwareCounters_Private
+{
+#if PLATFORM_LINUX
+	/** One group per thread, so that a single read returns every counter for the same window */
+	struct FThreadCounters
+	{
+		enum { NumCounters = 4 };
+
+		int Fds[NumCounters] = { -1, -1, -1, -1 };
+		bool bOpened = false;
+
+		~FThreadCounters()
+		{
+			Close();
+		}
+
+		bool Open()
+		{
+			static const uint64 Configs[NumCounters] =
+			{
+				PERF_COUNT_HW_CPU_CYCLES,
+				PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_MISSES,
+				PERF_COUNT_HW_BRANCH_MISSES,
+			};
+
+			for (int32 Index = 0; Index < NumCounters; ++Index)
+			{
+				perf_event_attr Attr;
+				FMemory::Memzero(Attr);
+				Attr.type = PERF_TYPE_HARDWARE;
+				Attr.size = sizeof(Attr);
+				Attr.config = Configs[Index];
+				Attr.read_format = PERF_FORMAT_GROUP;
+				Attr.exclude_kernel = 1;
+				Attr.exclude_hv = 1;
+
+				// This thread on any CPU, the cycles counter leads the group
+				Fds[Index] = (int)syscall(__NR_perf_event_open, &Attr, 0, -1, Index == 0 ? -1 : Fds[0], 0);
+				if (Fds[Index] < 0)
+				{
+					const int Error = errno;
+					Close();
+					UE_LOG(LogHardwareCounters, Warning, TEXT("perf_event_open failed (%d) on thread %u, check kernel.perf_event_paranoid"), Error, FPlatformTLS::GetCurrentThreadId());
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void Close()
+		{
+			for (int& Fd : Fds)
+			{
+				if (Fd >= 0)
+				{
+					close(Fd);
+					Fd = -1;
+				}
+			}
+		}
+
+		bool Read(FHardwareCounterValues& OutValues)
+		{
+			if (!bOpened)
+			{
+				bOpened = true;
+				Open();
+			}
+			if (Fds[0] < 0)
+			{
+				return false;
+			}
+
+			// { nr, values[nr] }
+			uint64 Buffer[1 + NumCounters];
+			if (read(Fds[0], Buffer, sizeof(Buffer)) != (ssize_t)sizeof(Buffer) || Buffer[0] != NumCounters)
+			{
+				return false;
+			}
+			OutValues.Cycles = Buffer[1];
+			OutValues.Instructions = Buffer[2];
+			OutValues.CacheMisses = Buffer[3];
+			OutValues.BranchMisses = Buffer[4];
+			return true;
+		}
+	};
+
+	static thread_local FThreadCounters GThreadCounters;
+#endif
+}
+
+void FHardwareCounters::SetEnabled(bool bInEnabled)
+{
+#if PLATFORM_LINUX
+	bEnabled = bInEnabled;
+#else
+	if (bInEnabled)
+	{
+		UE_LOG(LogHardwareCounters, Warning, TEXT("Hardware counters are only available on Linux"));
+	}
+#endif
+}
+
+bool FHardwareCounters::ReadThreadCounters(FHardwareCounterValues& OutValues)
+{
+#if PLATFORM_LINUX
+	return UE4HardwareCounters_Private::GThreadCounters.Read(OutValues);
+#else
+	return false;
+#endif
+}
+
+FHardwareCountersSite::FHardwareCountersSite(const TCHAR* InName, int32 InCsvCategoryIndex)
+	: Name(InName)
+	, CsvCategoryIndex(InCsvCategoryIndex)
+{
+	if (CsvCategoryIndex >= 0)
+	{
+		const TCHAR* Suffixes[] = { TEXT("_Cycles"), TEXT("_Instructions"), TEXT("_CacheMisses"), TEXT("_BranchMisses") };
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Suffixes); ++Index)
+		{
+			CsvStatNames[Index] = FName(*(FString(Name) + Suffixes[Index]));
+		}
+	}
+}
+
+void FHardwareCountersScope::EndScope()
+{
+	FHardwareCounterValues EndValues;
+	if (!FHardwareCounters::ReadThreadCounters(EndValues))
+	{
+		return;
+	}
+	const FHardwareCounterValues Delta = EndValues - StartValues;
+
+	const uint16 NameSize = (uint16)((FCString::Strlen(Site->Name) + 1) * sizeof(TCHAR));
+	UE_TRACE_LOG(HardwareCounters, Scope, HardwareCountersChannel, NameSize)
+		<< Scope.StartCycle(StartCycle)
+		<< Scope.EndCycle(FPlatformTime::Cycles64())
+		<< Scope.Cycles(Delta.Cycles)
+		<< Scope.Instructions(Delta.Instructions)
+		<< Scope.CacheMisses(Delta.CacheMisses)
+		<< Scope.BranchMisses(Delta.BranchMisses)
+		<< Scope.Attachment(Site->Name, NameSize);
+
+#if CSV_PROFILER
+	if (Site->CsvCategoryIndex >= 0)
+	{
+		const uint64 Values[] = { Delta.Cycles, Delta.Instructions, Delta.CacheMisses, Delta.BranchMisses };
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Values); ++Index)
+		{
+			FCsvProfiler::RecordCustomStat(Site->CsvStatNames[Index], Site->CsvCategoryIndex, float(Values[Index]), ECsvCustomStatOp::Accumulate);
+		}
+	}
+#endif
+}
+
+static void HandleHardwareCountersEnableChanged(IConsoleVariable* Variable)
+{
+	FHardwareCounters::SetEnabled(Variable->GetBool());
+}
+
+static FAutoConsoleVariable CVarHardwareCountersEnable(
+	TEXT("HardwareCounters.Enable"),
+	0,
+	TEXT("Whether hardware counter scopes read the cycles, instructions, cache misses and branch misses of their thread."),
+	FConsoleVariableDelegate::CreateStatic(&HandleHardwareCountersEnableChanged)
+	);
+
+static FDelayedAutoRegisterHelper GHardwareCountersRegister(EDelayedRegisterRunPhase::StartOfEnginePreInit, []()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("hardwarecounters")))
+	{
+		CVarHardwareCountersEnable->Set(1);
+	}
+});
+
+#endif
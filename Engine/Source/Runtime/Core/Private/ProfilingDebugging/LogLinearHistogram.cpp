@@ -0,0 +1,259 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/LogLinearHistogram.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/Archive.h"
+#include <new>
+
+FLogLinearHistogramSnapshot::FLogLinearHistogramSnapshot()
+{
+	Counts.SetNumZeroed(FLogLinearHistogramBuckets::NumBuckets);
+}
+
+uint64 FLogLinearHistogramSnapshot::GetValueAtPercentile(double Percentile) const
+{
+	if (TotalCount == 0)
+	{
+		return 0;
+	}
+
+	// The rank of the value, 1 based, so that percentile 0 is the smallest value and 100 the largest
+	const double Fraction = FMath::Clamp(Percentile, 0.0, 100.0) / 100.0;
+	const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Fraction * double(TotalCount)));
+	uint64 CountSoFar = 0;
+	for (int32 Index = 0; Index < Counts.Num(); ++Index)
+	{
+		CountSoFar += Counts[Index];
+		if (CountSoFar >= Rank)
+		{
+			return FMath::Max(FMath::Min(FLogLinearHistogramBuckets::GetUpperBound(Index), Max), Min);
+		}
+	}
+	return Max;
+}
+
+void FLogLinearHistogramSnapshot::Merge(const FLogLinearHistogramSnapshot& Other)
+{
+	check(Counts.Num() == Other.Counts.Num());
+	for (int32 Index = 0; Index < Counts.Num(); ++Index)
+	{
+		Counts[Index] += Other.Counts[Index];
+	}
+	TotalCount += Other.TotalCount;
+	Sum += Other.Sum;
+	Min = FMath::Min(Min, Other.Min);
+	Max = FMath::Max(Max, Other.Max);
+}
+
+FString FLogLinearHistogramSnapshot::ToCsvString() const
+{
+	TStringBuilder<1024> Builder;
+	Builder.Append(TEXT("LowerBound,UpperBound,Count\n"));
+	for (int32 Index = 0; Index < Counts.Num(); ++Index)
+	{
+		if (Counts[Index])
+		{
+			Builder.Appendf(TEXT("%llu,%llu,%llu\n"), FLogLinearHistogramBuckets::GetLowerBound(Index), FLogLinearHistogramBuckets::GetUpperBound(Index), Counts[Index]);
+		}
+	}
+	return FString(Builder.ToString());
+}
+
+FArchive& operator<<(FArchive& Ar, FLogLinearHistogramSnapshot& Snapshot)
+{
+	Ar << Snapshot.TotalCount << Snapshot.Sum << Snapshot.Min << Snapshot.Max;
+
+	int32 NumUsedBuckets = 0;
+	if (Ar.IsSaving())
+	{
+		for (uint64 Count : Snapshot.Counts)
+		{
+			NumUsedBuckets += Count != 0;
+		}
+	}
+	Ar << NumUsedBuckets;
+
+	if (Ar.IsLoading())
+	{
+		Snapshot.Counts.Reset();
+		Snapshot.Counts.SetNumZeroed(FLogLinearHistogramBuckets::NumBuckets);
+		for (int32 Used = 0; Used < NumUsedBuckets && !Ar.IsError(); ++Used)
+		{
+			int32 Index = 0;
+			uint64 Count = 0;
+			Ar << Index << Count;
+			if (Index < 0 || Index >= FLogLinearHistogramBuckets::NumBuckets)
+			{
+				Ar.SetError();
+				break;
+			}
+			Snapshot.Counts[Index] = Count;
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Snapshot.Counts.Num(); ++Index)
+		{
+			if (Snapshot.Counts[Index])
+			{
+				Ar << Index << Snapshot.Counts[Index];
+			}
+		}
+	}
+	return Ar;
+}
+
+FLogLinearHistogram::FShard::FShard()
+	: Sum(0)
+	, Min((int64)MAX_uint64)
+	, Max(0)
+{
+	FMemory::Memzero((void*)Counts, sizeof(Counts));
+}
+
+FLogLinearHistogram::FLogLinearHistogram(int32 InNumShards)
+	: NumShards(FMath::Clamp(InNumShards, 1, (int32)MaxShards))
+{
+	FMemory::Memzero((void*)Shards, sizeof(Shards));
+}
+
+FLogLinearHistogram::~FLogLinearHistogram()
+{
+	for (int32 Slot = 0; Slot < NumShards; ++Slot)
+	{
+		if (FShard* Shard = Shards[Slot])
+		{
+			Shard->~FShard();
+			FMemory::Free(Shard);
+		}
+	}
+}
+
+int32 FLogLinearHistogram::GetThreadSlot()
+{
+	static volatile int32 NextSlot = 0;
+	static thread_local int32 ThreadSlot = FPlatformAtomics::InterlockedIncrement(&NextSlot) & MAX_int32;
+	return ThreadSlot;
+}
+
+FLogLinearHistogram::FShard& FLogLinearHistogram::CreateShard(int32 Slot)
+{
+	FShard* NewShard = new (FMemory::Malloc(sizeof(FShard), alignof(FShard))) FShard();
+	if (FShard* Existing = (FShard*)FPlatformAtomics::InterlockedCompareExchangePointer((void* volatile*)&Shards[Slot], NewShard, nullptr))
+	{
+		// Another thread of this slot got there first
+		NewShard->~FShard();
+		FMemory::Free(NewShard);
+		return *Existing;
+	}
+	return *NewShard;
+}
+
+void FLogLinearHistogram::UpdateMin(FShard& Shard, uint64 Value)
+{
+	int64 Current = FPlatformAtomics::AtomicRead(&Shard.Min);
+	while (Value < (uint64)Current)
+	{
+		const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&Shard.Min, (int64)Value, Current);
+		if (Previous == Current)
+		{
+			break;
+		}
+		Current = Previous;
+	}
+}
+
+void FLogLinearHistogram::UpdateMax(FShard& Shard, uint64 Value)
+{
+	int64 Current = FPlatformAtomics::AtomicRead(&Shard.Max);
+	while (Value > (uint64)Current)
+	{
+		const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&Shard.Max, (int64)Value, Current);
+		if (Previous == Current)
+		{
+			break;
+		}
+		Current = Previous;
+	}
+}
+
+FLogLinearHistogramSnapshot FLogLinearHistogram::Snapshot() const
+{
+	FLogLinearHistogramSnapshot Result;
+	for (int32 Slot = 0; Slot < NumShards; ++Slot)
+	{
+		const FShard* Shard = Shards[Slot];
+		if (!Shard)
+		{
+			continue;
+		}
+		for (int32 Index = 0; Index < FLogLinearHistogramBuckets::NumBuckets; ++Index)
+		{
+			const uint64 Count = (uint64)FPlatformAtomics::AtomicRead(&Shard->Counts[Index]);
+			Result.Counts[Index] += Count;
+			Result.TotalCount += Count;
+		}
+		Result.Sum += (uint64)FPlatformAtomics::AtomicRead(&Shard->Sum);
+		Result.Min = FMath::Min(Result.Min, (uint64)FPlatformAtomics::AtomicRead(&Shard->Min));
+		Result.Max = FMath::Max(Result.Max, (uint64)FPlatformAtomics::AtomicRead(&Shard->Max));
+	}
+	return Result;
+}
+
+void FLogLinearHistogram::Reset()
+{
+	for (int32 Slot = 0; Slot < NumShards; ++Slot)
+	{
+		if (FShard* Shard = Shards[Slot])
+		{
+			for (int32 Index = 0; Index < FLogLinearHistogramBuckets::NumBuckets; ++Index)
+			{
+				FPlatformAtomics::InterlockedExchange(&Shard->Counts[Index], 0);
+			}
+			FPlatformAtomics::InterlockedExchange(&Shard->Sum, 0);
+			FPlatformAtomics::InterlockedExchange(&Shard->Min, (int64)MAX_uint64);
+			FPlatformAtomics::InterlockedExchange(&Shard->Max, 0);
+		}
+	}
+}
+
+#if COUNTERSTRACE_ENABLED
+
+FLogLinearHistogramTraceCounters::FLogLinearHistogramTraceCounters(const TCHAR* InName)
+{
+	static const TCHAR* Suffixes[NumCounters] = { TEXT("Count"), TEXT("P50"), TEXT("P90"), TEXT("P99"), TEXT("P999"), TEXT("Max") };
+	for (int32 Index = 0; Index < NumCounters; ++Index)
+	{
+		Names[Index] = FString::Printf(TEXT("%s/%s"), InName, Suffixes[Index]);
+		CounterIds[Index] = FCountersTrace::OutputInitCounter(*Names[Index], TraceCounterType_Int, TraceCounterDisplayHint_None);
+	}
+}
+
+void FLogLinearHistogramTraceCounters::Set(const FLogLinearHistogramSnapshot& Snapshot)
+{
+	const uint64 Values[NumCounters] =
+	{
+		Snapshot.TotalCount,
+		Snapshot.GetValueAtPercentile(50.0),
+		Snapshot.GetValueAtPercentile(90.0),
+		Snapshot.GetValueAtPercentile(99.0),
+		Snapshot.GetValueAtPercentile(99.9),
+		Snapshot.Max,
+	};
+	for (int32 Index = 0; Index < NumCounters; ++Index)
+	{
+		// The ids are 0 until the trace channel is up
+		if (!CounterIds[Index])
+		{
+			CounterIds[Index] = FCountersTrace::OutputInitCounter(*Names[Index], TraceCounterType_Int, TraceCounterDisplayHint_None);
+		}
+		if (CounterIds[Index])
+		{
+			FCountersTrace::OutputSetValue(CounterIds[Index], (int64)Values[Index]);
+		}
+	}
+}
+
+#endif
@@ -297,7 +297,7 @@ public:
 		FString FlatTags;
 		for (const FTagNameAndCount& TagAndCount : Tags)
 		{
-			FlatTags += TagAndCount.TagName.ToString();
+			TagAndCount.TagName.AppendString(FlatTags);
 			FlatTags.AppendChar(TEXT(';'));
 		}
 		return FlatTags;
@@ -65,6 +65,23 @@ UE_TRACE_EVENT_BEGIN(PlatformFile, EndWrite)
 	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
 UE_TRACE_EVENT_END()
 
+UE_TRACE_EVENT_BEGIN(PlatformFile, Activity)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, BytesPerSecond)
+	UE_TRACE_EVENT_FIELD(uint32, QueueDepth)
+	UE_TRACE_EVENT_FIELD(uint32, MaxQueueDepth)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(PlatformFile, LatencySummary)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Bytes)
+	UE_TRACE_EVENT_FIELD(uint32, Count)
+	UE_TRACE_EVENT_FIELD(float, P50Ms)
+	UE_TRACE_EVENT_FIELD(float, P99Ms)
+	UE_TRACE_EVENT_FIELD(float, MaxMs)
+	UE_TRACE_EVENT_FIELD(bool, IsCallSite)
+UE_TRACE_EVENT_END()
+
 void FPlatformFileTrace::BeginOpen(const TCHAR* Path)
 {
 	uint16 PathSize = (FCString::Strlen(Path) + 1) * sizeof(TCHAR);
@@ -137,6 +154,29 @@ void FPlatformFileTrace::EndWrite(uint64 WriteHandle, uint64 SizeWritten)
 		<< EndWrite.ThreadId(FPlatformTLS::GetCurrentThreadId());
 }
 
+void FPlatformFileTrace::Activity(uint32 QueueDepth, uint32 MaxQueueDepth, uint64 BytesPerSecond)
+{
+	UE_TRACE_LOG(PlatformFile, Activity, FileChannel)
+		<< Activity.Cycle(FPlatformTime::Cycles64())
+		<< Activity.BytesPerSecond(BytesPerSecond)
+		<< Activity.QueueDepth(QueueDepth)
+		<< Activity.MaxQueueDepth(MaxQueueDepth);
+}
+
+void FPlatformFileTrace::LatencySummary(const TCHAR* Name, bool bIsCallSite, uint32 Count, uint64 Bytes, float P50Ms, float P99Ms, float MaxMs)
+{
+	uint16 NameSize = (FCString::Strlen(Name) + 1) * sizeof(TCHAR);
+	UE_TRACE_LOG(PlatformFile, LatencySummary, FileChannel, NameSize)
+		<< LatencySummary.Cycle(FPlatformTime::Cycles64())
+		<< LatencySummary.Attachment(Name, NameSize)
+		<< LatencySummary.Bytes(Bytes)
+		<< LatencySummary.Count(Count)
+		<< LatencySummary.P50Ms(P50Ms)
+		<< LatencySummary.P99Ms(P99Ms)
+		<< LatencySummary.MaxMs(MaxMs)
+		<< LatencySummary.IsCallSite(bIsCallSite);
+}
+
 void FPlatformFileTrace::Init(const TCHAR* CmdLine)
 {
 	if (FParse::Param(CmdLine, TEXT("filetrace")))
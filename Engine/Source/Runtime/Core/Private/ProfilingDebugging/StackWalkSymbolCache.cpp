@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/StackWalkSymbolCache.h"
+
+#include "Async/Async.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+
+FStackWalkSymbolCache::FStackWalkSymbolCache()
+{
+}
+
+FStackWalkSymbolCache::~FStackWalkSymbolCache()
+{
+	Reset();
+}
+
+void FStackWalkSymbolCache::Add(const uint64* ProgramCounters, int32 NumProgramCounters)
+{
+	FScopeLock Lock(&EntriesCritical);
+	for (int32 Index = 0; Index < NumProgramCounters; ++Index)
+	{
+		const uint64 ProgramCounter = ProgramCounters[Index];
+		TUniquePtr<FEntry>& Entry = Entries.FindOrAdd(ProgramCounter);
+		if (!Entry.IsValid())
+		{
+			Entry = MakeUnique<FEntry>();
+			Pending.Add(ProgramCounter);
+		}
+	}
+}
+
+void FStackWalkSymbolCache::Symbolicate()
+{
+	SymbolicatePending();
+}
+
+TFuture<void> FStackWalkSymbolCache::SymbolicateAsync()
+{
+	// Symbolication blocks on file reads for a long time, so it is not given to the task graph
+	return Async(GThreadPool ? EAsyncExecution::ThreadPool : EAsyncExecution::Thread, [this]()
+	{
+		SymbolicatePending();
+	});
+}
+
+void FStackWalkSymbolCache::SymbolicatePending()
+{
+	FScopeLock SymbolicateLock(&SymbolicateCritical);
+
+	TArray<FEntry*> Batch;
+	TArray<uint64> BatchProgramCounters;
+	{
+		FScopeLock Lock(&EntriesCritical);
+		BatchProgramCounters = MoveTemp(Pending);
+		Batch.Reserve(BatchProgramCounters.Num());
+		for (uint64 ProgramCounter : BatchProgramCounters)
+		{
+			Batch.Add(Entries.FindChecked(ProgramCounter).Get());
+		}
+	}
+
+	// Only this batch, with SymbolicateCritical held, writes the symbol info of entries that are not symbolicated,
+	// and readers only look at it once bSymbolicated is set
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		FEntry* Entry = Batch[Index];
+		if (!Entry->bSymbolicated)
+		{
+			FPlatformStackWalk::ProgramCounterToSymbolInfo(BatchProgramCounters[Index], Entry->SymbolInfo);
+
+			FScopeLock Lock(&EntriesCritical);
+			Entry->bSymbolicated = true;
+		}
+	}
+}
+
+bool FStackWalkSymbolCache::Find(uint64 ProgramCounter, FProgramCounterSymbolInfo& OutSymbolInfo) const
+{
+	FScopeLock Lock(&EntriesCritical);
+	const TUniquePtr<FEntry>* Entry = Entries.Find(ProgramCounter);
+	if (Entry && (*Entry)->bSymbolicated)
+	{
+		OutSymbolInfo = (*Entry)->SymbolInfo;
+		return true;
+	}
+	return false;
+}
+
+FProgramCounterSymbolInfo FStackWalkSymbolCache::Get(uint64 ProgramCounter)
+{
+	FProgramCounterSymbolInfo SymbolInfo;
+	if (Find(ProgramCounter, SymbolInfo))
+	{
+		return SymbolInfo;
+	}
+
+	Add(&ProgramCounter, 1);
+
+	// Only this one, it stays in Pending and the batch it is in skips it
+	FScopeLock SymbolicateLock(&SymbolicateCritical);
+	FEntry* Entry;
+	{
+		FScopeLock Lock(&EntriesCritical);
+		const TUniquePtr<FEntry>* Found = Entries.Find(ProgramCounter);
+		Entry = Found ? Found->Get() : nullptr;
+	}
+	if (!Entry)
+	{
+		// Reset was called meanwhile
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+		return SymbolInfo;
+	}
+	if (!Entry->bSymbolicated)
+	{
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, Entry->SymbolInfo);
+
+		FScopeLock Lock(&EntriesCritical);
+		Entry->bSymbolicated = true;
+	}
+	return Entry->SymbolInfo;
+}
+
+int32 FStackWalkSymbolCache::Num() const
+{
+	FScopeLock Lock(&EntriesCritical);
+	return Entries.Num();
+}
+
+int32 FStackWalkSymbolCache::NumPending() const
+{
+	FScopeLock Lock(&EntriesCritical);
+	return Pending.Num();
+}
+
+void FStackWalkSymbolCache::Reset()
+{
+	FScopeLock SymbolicateLock(&SymbolicateCritical);
+	FScopeLock Lock(&EntriesCritical);
+	Entries.Empty();
+	Pending.Empty();
+}
@@ -0,0 +1,313 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProfilingDebugging/StartupPhases.h"
+
+#if STARTUPPHASES_ENABLED
+
+#include "Algo/Reverse.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "Logging/LogMacros.h"
+#include "Misc/CString.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/ScopeLock.h"
+#include "Trace/Trace.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStartupPhases, Log, All);
+
+UE_TRACE_CHANNEL(StartupPhasesChannel)
+
+UE_TRACE_EVENT_BEGIN(StartupPhases, Phase, Important)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+	UE_TRACE_EVENT_FIELD(int32, RunIndex)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(StartupPhases, Dependency, Important)
+	UE_TRACE_EVENT_FIELD(int32, RunIndex)
+	UE_TRACE_EVENT_FIELD(int32, DependencyRunIndex)
+UE_TRACE_EVENT_END()
+
+namespace UE4StartupPhases_Private
+{
+	/** Phases that started less than this long after they could have are not reported */
+	static const double MinReportedSlackSeconds = 0.001;
+	static const int32 MaxReportedSlacks = 8;
+	static const int32 MaxReportedBlockers = 3;
+
+	struct FPhaseRun
+	{
+		const TCHAR* Name;
+		TArray<const TCHAR*, TInlineAllocator<4>> Dependencies;
+		uint64 StartCycle;
+		uint64 EndCycle;
+		uint32 ThreadId;
+		bool bTraced;
+
+		bool IsComplete() const
+		{
+			return EndCycle != 0;
+		}
+
+		bool Encloses(const FPhaseRun& Other) const
+		{
+			return &Other != this && ThreadId == Other.ThreadId && StartCycle <= Other.StartCycle && (!IsComplete() || (Other.IsComplete() && Other.EndCycle <= EndCycle));
+		}
+	};
+
+	struct FTimeline
+	{
+		FCriticalSection Lock;
+		TArray<FPhaseRun> Runs;
+		bool bSummaryDumped = false;
+	};
+
+	/** Function level static as phases can begin during static initialization */
+	static FTimeline& GetTimeline()
+	{
+		static FTimeline Timeline;
+		return Timeline;
+	}
+
+	static bool IsSamePhase(const TCHAR* A, const TCHAR* B)
+	{
+		return A == B || FCString::Strcmp(A, B) == 0;
+	}
+
+	static double CyclesToSeconds(const uint64 Cycles)
+	{
+		return double(Cycles) * FPlatformTime::GetSecondsPerCycle64();
+	}
+
+	/** The run a dependency refers to is the last one of that phase to complete before the dependent run started */
+	static int32 FindDependencyRun(const TArray<FPhaseRun>& Runs, const TCHAR* DependencyName, const uint64 BeforeCycle)
+	{
+		int32 Found = INDEX_NONE;
+		for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+		{
+			const FPhaseRun& Run = Runs[RunIndex];
+			if (Run.IsComplete() && Run.EndCycle <= BeforeCycle && IsSamePhase(Run.Name, DependencyName) && (Found == INDEX_NONE || Runs[Found].EndCycle < Run.EndCycle))
+			{
+				Found = RunIndex;
+			}
+		}
+		return Found;
+	}
+
+	static void TraceRun(TArray<FPhaseRun>& Runs, const int32 RunIndex)
+	{
+		FPhaseRun& Run = Runs[RunIndex];
+		Run.bTraced = true;
+
+		const uint16 NameSize = (uint16)((FCString::Strlen(Run.Name) + 1) * sizeof(TCHAR));
+		UE_TRACE_LOG(StartupPhases, Phase, StartupPhasesChannel, NameSize)
+			<< Phase.StartCycle(Run.StartCycle)
+			<< Phase.EndCycle(Run.EndCycle)
+			<< Phase.ThreadId(Run.ThreadId)
+			<< Phase.RunIndex(RunIndex)
+			<< Phase.Attachment(Run.Name, NameSize);
+
+		for (const TCHAR* DependencyName : Run.Dependencies)
+		{
+			const uint16 DependencyNameSize = (uint16)((FCString::Strlen(DependencyName) + 1) * sizeof(TCHAR));
+			UE_TRACE_LOG(StartupPhases, Dependency, StartupPhasesChannel, DependencyNameSize)
+				<< Dependency.RunIndex(RunIndex)
+				<< Dependency.DependencyRunIndex(FindDependencyRun(Runs, DependencyName, Run.StartCycle))
+				<< Dependency.Attachment(DependencyName, DependencyNameSize);
+		}
+	}
+
+	static FDelayedAutoRegisterHelper GDumpSummaryAtEndOfInit(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+	{
+		FStartupPhases::DumpSummary();
+	});
+}
+
+void FStartupPhases::BeginPhase(const TCHAR* PhaseName, std::initializer_list<const TCHAR*> Dependencies)
+{
+	using namespace UE4StartupPhases_Private;
+
+	FPhaseRun Run;
+	Run.Name = PhaseName;
+	Run.Dependencies.Append(Dependencies.begin(), (int32)Dependencies.size());
+	Run.EndCycle = 0;
+	Run.ThreadId = FPlatformTLS::GetCurrentThreadId();
+	Run.bTraced = false;
+
+	FTimeline& Timeline = GetTimeline();
+	FScopeLock Lock(&Timeline.Lock);
+	Run.StartCycle = FPlatformTime::Cycles64();
+	Timeline.Runs.Add(MoveTemp(Run));
+}
+
+void FStartupPhases::EndPhase(const TCHAR* PhaseName)
+{
+	using namespace UE4StartupPhases_Private;
+
+	const uint64 EndCycle = FPlatformTime::Cycles64();
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	FTimeline& Timeline = GetTimeline();
+	FScopeLock Lock(&Timeline.Lock);
+	for (int32 RunIndex = Timeline.Runs.Num() - 1; RunIndex >= 0; --RunIndex)
+	{
+		FPhaseRun& Run = Timeline.Runs[RunIndex];
+		if (!Run.IsComplete() && Run.ThreadId == ThreadId && IsSamePhase(Run.Name, PhaseName))
+		{
+			Run.EndCycle = EndCycle;
+
+			// Runs that complete before the summary are traced with it, as the trace may not have been connected when they started
+			if (Timeline.bSummaryDumped)
+			{
+				TraceRun(Timeline.Runs, RunIndex);
+			}
+			return;
+		}
+	}
+}
+
+void FStartupPhases::DumpSummary()
+{
+	using namespace UE4StartupPhases_Private;
+
+	FTimeline& Timeline = GetTimeline();
+	FScopeLock Lock(&Timeline.Lock);
+	if (Timeline.bSummaryDumped)
+	{
+		return;
+	}
+	Timeline.bSummaryDumped = true;
+
+	TArray<FPhaseRun>& Runs = Timeline.Runs;
+
+	uint64 FirstCycle = MAX_uint64;
+	int32 LastRunIndex = INDEX_NONE;
+	for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+	{
+		if (Runs[RunIndex].IsComplete())
+		{
+			TraceRun(Runs, RunIndex);
+
+			FirstCycle = FMath::Min(FirstCycle, Runs[RunIndex].StartCycle);
+			if (LastRunIndex == INDEX_NONE || Runs[LastRunIndex].EndCycle < Runs[RunIndex].EndCycle)
+			{
+				LastRunIndex = RunIndex;
+			}
+		}
+	}
+
+	if (LastRunIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// A run is gated by the dependency that completed last, or by the start of the run that encloses it on the same thread
+	TArray<int32> GatingRunIndices;
+	TArray<uint64> ReadyCycles;
+	GatingRunIndices.Init(INDEX_NONE, Runs.Num());
+	ReadyCycles.Init(FirstCycle, Runs.Num());
+	for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+	{
+		const FPhaseRun& Run = Runs[RunIndex];
+		if (!Run.IsComplete())
+		{
+			continue;
+		}
+
+		for (const TCHAR* DependencyName : Run.Dependencies)
+		{
+			const int32 DependencyRunIndex = FindDependencyRun(Runs, DependencyName, Run.StartCycle);
+			if (DependencyRunIndex != INDEX_NONE && Runs[DependencyRunIndex].EndCycle >= ReadyCycles[RunIndex])
+			{
+				GatingRunIndices[RunIndex] = DependencyRunIndex;
+				ReadyCycles[RunIndex] = Runs[DependencyRunIndex].EndCycle;
+			}
+		}
+
+		for (const FPhaseRun& OtherRun : Runs)
+		{
+			if (OtherRun.Encloses(Run))
+			{
+				ReadyCycles[RunIndex] = FMath::Max(ReadyCycles[RunIndex], OtherRun.StartCycle);
+			}
+		}
+	}
+
+	const double TotalSeconds = CyclesToSeconds(Runs[LastRunIndex].EndCycle - FirstCycle);
+	UE_LOG(LogStartupPhases, Log, TEXT("------------- Startup phases -------------"));
+	UE_LOG(LogStartupPhases, Log, TEXT("%d phase runs over %.3fs"), Runs.Num(), TotalSeconds);
+
+	// The critical path walks back from the phase that completed last through the dependencies that gated each run
+	TArray<int32> CriticalPath;
+	for (int32 RunIndex = LastRunIndex; RunIndex != INDEX_NONE; RunIndex = GatingRunIndices[RunIndex])
+	{
+		CriticalPath.Add(RunIndex);
+	}
+	Algo::Reverse(CriticalPath);
+
+	double CriticalPathSeconds = 0.0;
+	UE_LOG(LogStartupPhases, Log, TEXT("Critical path:"));
+	for (const int32 RunIndex : CriticalPath)
+	{
+		const FPhaseRun& Run = Runs[RunIndex];
+		const double RunSeconds = CyclesToSeconds(Run.EndCycle - Run.StartCycle);
+		CriticalPathSeconds += RunSeconds;
+		UE_LOG(LogStartupPhases, Log, TEXT("  %7.3fs took %7.3fs %s"), CyclesToSeconds(Run.StartCycle - FirstCycle), RunSeconds, Run.Name);
+	}
+	UE_LOG(LogStartupPhases, Log, TEXT("The critical path runs for %.3fs, the other %.3fs are spent in phases it doesn't depend on"), CriticalPathSeconds, FMath::Max(TotalSeconds - CriticalPathSeconds, 0.0));
+
+	// Runs that started well after they were ready were serialized behind phases they don't depend on, and could overlap with them
+	struct FSlack
+	{
+		int32 RunIndex;
+		uint64 Cycles;
+	};
+
+	TArray<FSlack> Slacks;
+	for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+	{
+		const FPhaseRun& Run = Runs[RunIndex];
+		if (Run.IsComplete() && Run.StartCycle > ReadyCycles[RunIndex] && CyclesToSeconds(Run.StartCycle - ReadyCycles[RunIndex]) >= MinReportedSlackSeconds)
+		{
+			Slacks.Add({ RunIndex, Run.StartCycle - ReadyCycles[RunIndex] });
+		}
+	}
+	Slacks.Sort([](const FSlack& A, const FSlack& B) { return A.Cycles > B.Cycles; });
+
+	if (Slacks.Num() > 0)
+	{
+		UE_LOG(LogStartupPhases, Log, TEXT("Phases that could start earlier:"));
+	}
+	for (int32 SlackIndex = 0; SlackIndex < FMath::Min(Slacks.Num(), MaxReportedSlacks); ++SlackIndex)
+	{
+		const FPhaseRun& Run = Runs[Slacks[SlackIndex].RunIndex];
+		const uint64 ReadyCycle = ReadyCycles[Slacks[SlackIndex].RunIndex];
+
+		FString Blockers;
+		int32 NumBlockers = 0;
+		for (const FPhaseRun& OtherRun : Runs)
+		{
+			if (OtherRun.IsComplete() && OtherRun.ThreadId == Run.ThreadId && OtherRun.EndCycle > ReadyCycle && OtherRun.EndCycle <= Run.StartCycle && !OtherRun.Encloses(Run))
+			{
+				if (NumBlockers++ < MaxReportedBlockers)
+				{
+					Blockers += Blockers.IsEmpty() ? TEXT(" after ") : TEXT(", ");
+					Blockers += OtherRun.Name;
+				}
+			}
+		}
+		if (NumBlockers > MaxReportedBlockers)
+		{
+			Blockers += FString::Printf(TEXT(" and %d others"), NumBlockers - MaxReportedBlockers);
+		}
+
+		UE_LOG(LogStartupPhases, Log, TEXT("  %s was ready %.3fs before it started%s"), Run.Name, CyclesToSeconds(Slacks[SlackIndex].Cycles), *Blockers);
+	}
+	UE_LOG(LogStartupPhases, Log, TEXT("------------- -------------- -------------"));
+}
+
+#endif
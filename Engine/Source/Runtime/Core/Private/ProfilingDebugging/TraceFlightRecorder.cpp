@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#include "ProfilingDebugging/TraceFlightRecorder.h"
+#include "Trace/Trace.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/LogMacros.h"
+#include "Misc/CString.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if TRACEFLIGHTRECORDER_ENABLED
+
+DEFINE_LOG_CATEGORY_STATIC(LogTraceFlightRecorder, Log, All);
+
+struct FTraceFlightRecorderInternal
+{
+	static bool bEnabled;
+
+	// Built up front as there is no telling what still works once we crash
+	static TCHAR CrashPath[1024];
+	static TCHAR EnsurePath[1024];
+
+	static void OnSystemError()
+	{
+		Trace::WriteSnapshotTo(CrashPath);
+	}
+
+	static void OnSystemEnsure()
+	{
+		Trace::WriteSnapshotTo(EnsurePath);
+	}
+
+	static void DumpCommand(const TArray<FString>& Args)
+	{
+		FTraceFlightRecorder::Dump(Args.Num() ? *Args[0] : nullptr);
+	}
+};
+
+bool FTraceFlightRecorderInternal::bEnabled = false;
+TCHAR FTraceFlightRecorderInternal::CrashPath[1024];
+TCHAR FTraceFlightRecorderInternal::EnsurePath[1024];
+
+static FAutoConsoleCommand TraceFlightRecorderDumpCmd(
+	TEXT("Trace.FlightRecorder.Dump"),
+	TEXT("Writes the events kept by the trace flight recorder to the given path, or to the log directory if none is given"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FTraceFlightRecorderInternal::DumpCommand)
+	);
+
+void FTraceFlightRecorder::Init(const TCHAR* CmdLine)
+{
+	uint32 SizeMB = 0;
+	if (!FParse::Value(CmdLine, TEXT("traceflightrecorder="), SizeMB) || SizeMB == 0)
+	{
+		return;
+	}
+
+	Trace::FInitializeDesc Desc;
+	Desc.FlightRecorderSize = FMath::Min<uint32>(SizeMB, 1024) << 20;
+	FParse::Value(CmdLine, TEXT("traceflightrecorderseconds="), Desc.FlightRecorderSeconds);
+	if (!Trace::Initialize(Desc))
+	{
+		UE_LOG(LogTraceFlightRecorder, Warning, TEXT("Trace was initialized before the flight recorder could be enabled"));
+		return;
+	}
+
+	const FString LogDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectLogDir());
+	FCString::Strncpy(FTraceFlightRecorderInternal::CrashPath, *(LogDir / TEXT("FlightRecorder-Crash.utrace")), UE_ARRAY_COUNT(FTraceFlightRecorderInternal::CrashPath));
+	FCString::Strncpy(FTraceFlightRecorderInternal::EnsurePath, *(LogDir / TEXT("FlightRecorder-Ensure.utrace")), UE_ARRAY_COUNT(FTraceFlightRecorderInternal::EnsurePath));
+
+	FCoreDelegates::OnHandleSystemError.AddStatic(&FTraceFlightRecorderInternal::OnSystemError);
+	FCoreDelegates::OnHandleSystemEnsure.AddStatic(&FTraceFlightRecorderInternal::OnSystemEnsure);
+	FTraceFlightRecorderInternal::bEnabled = true;
+}
+
+bool FTraceFlightRecorder::IsEnabled()
+{
+	return FTraceFlightRecorderInternal::bEnabled;
+}
+
+bool FTraceFlightRecorder::Dump(const TCHAR* Path)
+{
+	if (!FTraceFlightRecorderInternal::bEnabled)
+	{
+		UE_LOG(LogTraceFlightRecorder, Warning, TEXT("The flight recorder is not enabled, use -traceflightrecorder=<MB>"));
+		return false;
+	}
+
+	FString DumpPath;
+	if (Path != nullptr && *Path)
+	{
+		DumpPath = Path;
+	}
+	else
+	{
+		DumpPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectLogDir()) / FString::Printf(TEXT("FlightRecorder-%s.utrace"), *FDateTime::Now().ToString());
+	}
+
+	if (!Trace::WriteSnapshotTo(*DumpPath))
+	{
+		UE_LOG(LogTraceFlightRecorder, Warning, TEXT("Failed to write the flight recorder to '%s', it may be sending a trace"), *DumpPath);
+		return false;
+	}
+
+	UE_LOG(LogTraceFlightRecorder, Display, TEXT("Flight recorder written to '%s'"), *DumpPath);
+	return true;
+}
+
+#endif // TRACEFLIGHTRECORDER_ENABLED
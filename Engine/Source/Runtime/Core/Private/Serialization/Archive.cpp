@@ -504,8 +504,7 @@ void FArchive::UsingCustomVersion(const FGuid& Key)
 		return;
 	}
 
-	FCustomVersion RegisteredVersion = FCurrentCustomVersions::Get(Key).GetValue();
-	const_cast<FCustomVersionContainer&>(GetCustomVersions()).SetVersion(Key, RegisteredVersion.Version, RegisteredVersion.GetFriendlyName());
+	const_cast<FCustomVersionContainer&>(GetCustomVersions()).SetCurrentVersion(Key);
 }
 
 int32 FArchiveState::CustomVer(const FGuid& Key) const
@@ -594,7 +593,7 @@ public:
 		, CompressedBuffer(0)
 		, CompressedSize(0)
 		, UncompressedSize(0)
-		, BitWindow(DEFAULT_ZLIB_BIT_WINDOW)
+		, BitWindow(0) // the default bit window for zlib, and the default level for the formats reading CompressionData as one
 		, CompressionFormat(NAME_Zlib)
 		, Flags(COMPRESS_NoFlags)
 	{
@@ -4,6 +4,12 @@
 #include "Math/UnrealMathUtility.h"
 #include "HAL/UnrealMemory.h"
 #include "Containers/Array.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ByteSwap.h"
+#include "Serialization/CompressedChunkInfo.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/ObjectVersion.h"
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -11,10 +17,12 @@ PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 	FArchiveLoadCompressedProxy
 ----------------------------------------------------------------------------*/
 
-FArchiveLoadCompressedProxy::FArchiveLoadCompressedProxy(const TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags)
+FArchiveLoadCompressedProxy::FArchiveLoadCompressedProxy(const TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags, int32 InNumAsyncBlocks)
 	:	CompressedData(InCompressedData)
 	,	CompressionFormat(InCompressionFormat)
 	,	CompressionFlags(InCompressionFlags)
+	,	OldestAsyncBlock(0)
+	,	NumQueuedAsyncBlocks(0)
 {
 	this->SetIsLoading(true);
 	this->SetIsPersistent(true);
@@ -27,11 +35,22 @@ FArchiveLoadCompressedProxy::FArchiveLoadCompressedProxy(const TArray<uint8>& In
 	TmpDataStart	= (uint8*) FMemory::Malloc(LOADING_COMPRESSION_CHUNK_SIZE);
 	TmpDataEnd		= TmpDataStart + LOADING_COMPRESSION_CHUNK_SIZE;
 	TmpData			= TmpDataEnd;
+
+	// Blocks are decompressed on the calling thread when there are no worker threads to hand them to.
+	if (InNumAsyncBlocks > 0 && FPlatformProcess::SupportsMultithreading() && FTaskGraphInterface::IsRunning())
+	{
+		AsyncBlocks.SetNum(InNumAsyncBlocks);
+	}
 }
 
 FArchiveLoadCompressedProxy::~FArchiveLoadCompressedProxy()
 {
-	// Free temporary memory allocated.
+	// Free temporary memory allocated, once the blocks decompressing into it are done.
+	for (FAsyncBlock& Block : AsyncBlocks)
+	{
+		Block.Task.Wait();
+		FMemory::Free(Block.UncompressedData);
+	}
 	FMemory::Free( TmpDataStart );
 	TmpDataStart	= NULL;
 	TmpDataEnd		= NULL;
@@ -43,6 +62,31 @@ FArchiveLoadCompressedProxy::~FArchiveLoadCompressedProxy()
  */
 void FArchiveLoadCompressedProxy::DecompressMoreData()
 {
+	if (AsyncBlocks.Num())
+	{
+		QueueAsyncBlocks();
+		if (NumQueuedAsyncBlocks)
+		{
+			FAsyncBlock& Block = AsyncBlocks[OldestAsyncBlock];
+			Block.Task.Wait();
+			Block.Task = TFuture<void>();
+
+			// Read from the block's buffer and give it the one that was just exhausted.
+			Swap(Block.UncompressedData, TmpDataStart);
+			TmpDataEnd	= TmpDataStart + Block.UncompressedSize;
+			TmpData		= TmpDataStart;
+
+			OldestAsyncBlock = (OldestAsyncBlock + 1) % AsyncBlocks.Num();
+			--NumQueuedAsyncBlocks;
+
+			// Keep decompressing ahead while this block is read.
+			QueueAsyncBlocks();
+			return;
+		}
+		// Otherwise the next block has to be decompressed here, which also reports it if it is invalid.
+		TmpDataEnd = TmpDataStart + LOADING_COMPRESSION_CHUNK_SIZE;
+	}
+
 	// This will call Serialize so we need to indicate that we want to serialize from array.
 	bShouldSerializeFromArray = true;
 	SerializeCompressed( TmpDataStart, LOADING_COMPRESSION_CHUNK_SIZE /** it's ignored, but that's how much we serialize */, CompressionFormat, CompressionFlags);
@@ -51,6 +95,84 @@ void FArchiveLoadCompressedProxy::DecompressMoreData()
 	TmpData = TmpDataStart;
 }
 
+/**
+ * Reads the header SerializeCompressed wrote at Offset to find the size of the block.
+ *
+ * @return false if there isn't a valid and complete block at Offset
+ */
+static bool PeekCompressedBlock(const TArray<uint8>& Data, int64 Offset, int64& OutBlockSize, int64& OutUncompressedSize)
+{
+	const int64 HeaderSize = 2 * sizeof(FCompressedChunkInfo);
+	if (Offset + HeaderSize > Data.Num())
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(MakeArrayView(Data.GetData() + Offset, (int32)HeaderSize));
+	FCompressedChunkInfo PackageFileTag;
+	FCompressedChunkInfo Summary;
+	Reader << PackageFileTag << Summary;
+
+	// Mirror how SerializeCompressed handles data saved with the other endianness and the old chunk size.
+	if (PackageFileTag.CompressedSize != PACKAGE_FILE_TAG)
+	{
+		if (PackageFileTag.CompressedSize != PACKAGE_FILE_TAG_SWAPPED)
+		{
+			return false;
+		}
+		Summary.CompressedSize = BYTESWAP_ORDER64(Summary.CompressedSize);
+		Summary.UncompressedSize = BYTESWAP_ORDER64(Summary.UncompressedSize);
+		PackageFileTag.UncompressedSize = BYTESWAP_ORDER64(PackageFileTag.UncompressedSize);
+	}
+
+	int64 ChunkSize = PackageFileTag.UncompressedSize;
+	if (ChunkSize == PACKAGE_FILE_TAG)
+	{
+		ChunkSize = LOADING_COMPRESSION_CHUNK_SIZE;
+	}
+	if (ChunkSize <= 0 || Summary.CompressedSize < 0 || Summary.UncompressedSize < 0)
+	{
+		return false;
+	}
+
+	const int64 ChunkCount = (Summary.UncompressedSize + ChunkSize - 1) / ChunkSize;
+	OutBlockSize = HeaderSize + ChunkCount * sizeof(FCompressedChunkInfo) + Summary.CompressedSize;
+	OutUncompressedSize = Summary.UncompressedSize;
+	return Offset + OutBlockSize <= Data.Num();
+}
+
+void FArchiveLoadCompressedProxy::QueueAsyncBlocks()
+{
+	while (NumQueuedAsyncBlocks < AsyncBlocks.Num())
+	{
+		// Blocks larger than the tmp buffer are left to be decompressed on this thread, as they always were.
+		int64 BlockSize = 0;
+		int64 UncompressedSize = 0;
+		if (!PeekCompressedBlock(CompressedData, CurrentIndex, BlockSize, UncompressedSize) || UncompressedSize > LOADING_COMPRESSION_CHUNK_SIZE)
+		{
+			break;
+		}
+
+		FAsyncBlock& Block = AsyncBlocks[(OldestAsyncBlock + NumQueuedAsyncBlocks) % AsyncBlocks.Num()];
+		++NumQueuedAsyncBlocks;
+
+		if (!Block.UncompressedData)
+		{
+			Block.UncompressedData = (uint8*)FMemory::Malloc(LOADING_COMPRESSION_CHUNK_SIZE);
+		}
+		Block.UncompressedSize = UncompressedSize;
+
+		const TArrayView<const uint8> BlockData(CompressedData.GetData() + CurrentIndex, (int32)BlockSize);
+		CurrentIndex += BlockSize;
+
+		Block.Task = Async(EAsyncExecution::TaskGraph, [UncompressedData = Block.UncompressedData, BlockData, Format = CompressionFormat, Flags = CompressionFlags]()
+		{
+			FMemoryReaderView Reader(BlockData);
+			Reader.SerializeCompressed(UncompressedData, 0, Format, Flags);
+		});
+	}
+}
+
 /**
  * Serializes data from archive. This function is called recursively and determines where to serialize
  * from and how to do so based on internal state.
@@ -5,6 +5,9 @@
 #include "HAL/UnrealMemory.h"
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "Serialization/MemoryWriter.h"
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -16,10 +19,12 @@ FArchiveSaveCompressedProxy::FArchiveSaveCompressedProxy(FArchiveSaveCompressedP
 {
 }
 
-FArchiveSaveCompressedProxy::FArchiveSaveCompressedProxy(TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags)
+FArchiveSaveCompressedProxy::FArchiveSaveCompressedProxy(TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags, int32 InNumAsyncBlocks)
 	: CompressedData(InCompressedData)
 	, CompressionFormat(InCompressionFormat)
 	, CompressionFlags(InCompressionFlags)
+	, OldestAsyncBlock(0)
+	, NumQueuedAsyncBlocks(0)
 {
 	this->SetIsSaving(true);
 	this->SetIsPersistent(true);
@@ -32,6 +37,12 @@ FArchiveSaveCompressedProxy::FArchiveSaveCompressedProxy(TArray<uint8>& InCompre
 	TmpDataStart	= (uint8*) FMemory::Malloc(LOADING_COMPRESSION_CHUNK_SIZE);
 	TmpDataEnd		= TmpDataStart + LOADING_COMPRESSION_CHUNK_SIZE;
 	TmpData			= TmpDataStart;
+
+	// Blocks are compressed on the calling thread when there are no worker threads to hand them to.
+	if (InNumAsyncBlocks > 0 && FPlatformProcess::SupportsMultithreading() && FTaskGraphInterface::IsRunning())
+	{
+		AsyncBlocks.SetNum(InNumAsyncBlocks);
+	}
 }
 
 /** Destructor, flushing array if needed. Also frees temporary memory. */
@@ -40,6 +51,10 @@ FArchiveSaveCompressedProxy::~FArchiveSaveCompressedProxy()
 	// Flush is required to write out remaining tmp data to array.
 	Flush();
 	// Free temporary memory allocated.
+	for (FAsyncBlock& Block : AsyncBlocks)
+	{
+		FMemory::Free(Block.UncompressedData);
+	}
 	FMemory::Free( TmpDataStart );
 	TmpDataStart	= NULL;
 	TmpDataEnd		= NULL;
@@ -51,7 +66,15 @@ FArchiveSaveCompressedProxy::~FArchiveSaveCompressedProxy()
  */
 void FArchiveSaveCompressedProxy::Flush()
 {
-	if( TmpData - TmpDataStart > 0 )
+	if (AsyncBlocks.Num())
+	{
+		QueueAsyncBlock();
+		while (NumQueuedAsyncBlocks)
+		{
+			RetireOldestAsyncBlock();
+		}
+	}
+	else if( TmpData - TmpDataStart > 0 )
 	{
 		// This will call Serialize so we need to indicate that we want to serialize to array.
 		bShouldSerializeToArray = true;
@@ -105,12 +128,73 @@ void FArchiveSaveCompressedProxy::Serialize( void* InData, int64 Count )
 			{
 				// Flush existing data to array after compressing it. This will call Serialize again 
 				// so we need to handle recursion.
-				Flush();
+				if (AsyncBlocks.Num())
+				{
+					QueueAsyncBlock();
+				}
+				else
+				{
+					Flush();
+				}
 			}
 		}
 	}
 }
 
+void FArchiveSaveCompressedProxy::QueueAsyncBlock()
+{
+	// Write out the blocks that are already done so the array fills in steadily.
+	while (NumQueuedAsyncBlocks && AsyncBlocks[OldestAsyncBlock].Task.IsReady())
+	{
+		RetireOldestAsyncBlock();
+	}
+
+	if( TmpData - TmpDataStart > 0 )
+	{
+		if (NumQueuedAsyncBlocks == AsyncBlocks.Num())
+		{
+			RetireOldestAsyncBlock();
+		}
+
+		FAsyncBlock& Block = AsyncBlocks[(OldestAsyncBlock + NumQueuedAsyncBlocks) % AsyncBlocks.Num()];
+		++NumQueuedAsyncBlocks;
+
+		// Hand the filled tmp buffer over to the block and carry on filling the one it had.
+		Block.UncompressedSize = TmpData - TmpDataStart;
+		if (!Block.UncompressedData)
+		{
+			Block.UncompressedData = (uint8*)FMemory::Malloc(LOADING_COMPRESSION_CHUNK_SIZE);
+		}
+		Swap(Block.UncompressedData, TmpDataStart);
+		TmpDataEnd	= TmpDataStart + LOADING_COMPRESSION_CHUNK_SIZE;
+		TmpData		= TmpDataStart;
+
+		// The block's own archive writes exactly what SerializeCompressed would have written to this one.
+		Block.CompressedData.Reset();
+		Block.Task = Async(EAsyncExecution::TaskGraph, [&Block, Format = CompressionFormat, Flags = CompressionFlags, Target = CookingTarget(), bByteSwapping = IsByteSwapping()]()
+		{
+			FMemoryWriter Writer(Block.CompressedData);
+			Writer.SetCookingTarget(Target);
+			Writer.SetByteSwapping(bByteSwapping);
+			Writer.SerializeCompressed(Block.UncompressedData, Block.UncompressedSize, Format, Flags);
+		});
+	}
+}
+
+void FArchiveSaveCompressedProxy::RetireOldestAsyncBlock()
+{
+	FAsyncBlock& Block = AsyncBlocks[OldestAsyncBlock];
+	Block.Task.Wait();
+	Block.Task = TFuture<void>();
+
+	bShouldSerializeToArray = true;
+	Serialize(Block.CompressedData.GetData(), Block.CompressedData.Num());
+	bShouldSerializeToArray = false;
+
+	OldestAsyncBlock = (OldestAsyncBlock + 1) % AsyncBlocks.Num();
+	--NumQueuedAsyncBlocks;
+}
+
 /**
  * Seeking is only implemented internally for writing out compressed data and asserts otherwise.
  * 
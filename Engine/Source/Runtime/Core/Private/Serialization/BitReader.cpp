@@ -2,6 +2,7 @@
 
 #include "Serialization/BitReader.h"
 #include "Math/UnrealMathUtility.h"
+#include "Math/Vector.h"
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
 
@@ -13,18 +14,59 @@ extern const uint8 GMask [8]={0x00,0x01,0x03,0x07,0x0f,0x1f,0x3f,0x7f};
 
 // Optimized arbitrary bit range memory copy routine.
 
-void appBitsCpy( uint8* Dest, int32 DestBit, uint8* Src, int32 SrcBit, int32 BitCount )
+void appBitsCpy( uint8* Dest, int64 DestBit, uint8* Src, int64 SrcBit, int64 BitCount )
 {
 	if( BitCount==0 ) return;
 
+#if PLATFORM_LITTLE_ENDIAN
+	// Copy 64 bits at a time while at least 72 are left, so the 9 bytes a misaligned word spans are within both ranges.
+	if( BitCount >= 72 )
+	{
+		const int32 SrcShift  = SrcBit & 7;
+		const int32 DestShift = DestBit & 7;
+		const uint64 DestKeepMask = (uint64(1) << DestShift) - 1;
+		const uint8* SrcPtr = Src + (SrcBit >> 3);
+		uint8* DestPtr = Dest + (DestBit >> 3);
+		do
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, SrcPtr, sizeof(Word));
+			if( SrcShift )
+			{
+				Word = (Word >> SrcShift) | (uint64(SrcPtr[8]) << (64 - SrcShift));
+			}
+			if( DestShift )
+			{
+				uint64 DestWord;
+				FMemory::Memcpy(&DestWord, DestPtr, sizeof(DestWord));
+				DestWord = (DestWord & DestKeepMask) | (Word << DestShift);
+				FMemory::Memcpy(DestPtr, &DestWord, sizeof(DestWord));
+				DestPtr[8] = (uint8)( (DestPtr[8] & ~DestKeepMask) | (Word >> (64 - DestShift)) );
+			}
+			else
+			{
+				FMemory::Memcpy(DestPtr, &Word, sizeof(Word));
+			}
+			SrcPtr += 8;
+			DestPtr += 8;
+			BitCount -= 64;
+		}
+		while( BitCount >= 72 );
+
+		// The rest, at least 8 bits, goes through the byte copier below
+		SrcBit  = ((SrcPtr - Src) << 3) + SrcShift;
+		DestBit = ((DestPtr - Dest) << 3) + DestShift;
+	}
+#endif
+
 	// Special case - always at least one bit to copy,
 	// a maximum of 2 bytes to read, 2 to write - only touch bytes that are actually used.
 	if( BitCount <= 8 ) 
 	{
-		uint32 DestIndex	   = DestBit/8;
-		uint32 SrcIndex	   = SrcBit /8;
-		uint32 LastDest	   =( DestBit+BitCount-1 )/8;  
-		uint32 LastSrc	   =( SrcBit +BitCount-1 )/8;  
+		int64 DestIndex	   = DestBit/8;
+		int64 SrcIndex	   = SrcBit /8;
+		int64 LastDest	   =( DestBit+BitCount-1 )/8;  
+		int64 LastSrc	   =( SrcBit +BitCount-1 )/8;  
 		uint32 ShiftSrc     = SrcBit & 7; 
 		uint32 ShiftDest    = DestBit & 7;
 		uint32 FirstMask    = 0xFF << ShiftDest;  
@@ -51,16 +93,16 @@ void appBitsCpy( uint8* Dest, int32 DestBit, uint8* Src, int32 SrcBit, int32 Bit
 	}
 
 	// Main copier, uses byte sized shifting. Minimum size is 9 bits, so at least 2 reads and 2 writes.
-	uint32 DestIndex		= DestBit/8;
+	int64 DestIndex		= DestBit/8;
 	uint32 FirstSrcMask  = 0xFF << ( DestBit & 7);  
-	uint32 LastDest		= ( DestBit+BitCount )/8; 
+	int64 LastDest		= ( DestBit+BitCount )/8; 
 	uint32 LastSrcMask   = 0xFF << ((DestBit + BitCount) & 7); 
-	uint32 SrcIndex		= SrcBit/8;
-	uint32 LastSrc		= ( SrcBit+BitCount )/8;  
+	int64 SrcIndex		= SrcBit/8;
+	int64 LastSrc		= ( SrcBit+BitCount )/8;  
 	int32   ShiftCount    = (DestBit & 7) - (SrcBit & 7); 
-	int32   DestLoop      = LastDest-DestIndex; 
-	int32   SrcLoop       = LastSrc -SrcIndex;  
-	uint32 FullLoop;
+	int64   DestLoop      = LastDest-DestIndex; 
+	int64   SrcLoop       = LastSrc -SrcIndex;  
+	int64 FullLoop;
 	uint32 BitAccu;
 
 	// Lead-in needs to read 1 or 2 source bytes depending on alignment.
@@ -97,7 +139,7 @@ void appBitsCpy( uint8* Dest, int32 DestBit, uint8* Src, int32 SrcBit, int32 Bit
 	// Lead-out. 
 	if( LastSrcMask != 0xFF) 
 	{
-		if ((uint32)(SrcBit+BitCount-1)/8 == SrcIndex ) // Last legal byte ?
+		if ((SrcBit+BitCount-1)/8 == SrcIndex ) // Last legal byte ?
 		{
 			BitAccu = ( ( (uint32)Src[SrcIndex] << ShiftCount ) + (BitAccu)) >> 8; 
 		}
@@ -247,7 +289,7 @@ void FBitReader::SerializeBitsWithOffset( void* Dest, int32 DestBit, int64 Lengt
 
 	if (LengthBits != 0)
 	{
-		appBitsCpy((uint8*)Dest, DestBit, Buffer.GetData(), (int32)Pos, (int32)LengthBits);
+		appBitsCpy((uint8*)Dest, DestBit, Buffer.GetData(), Pos, LengthBits);
 		Pos += LengthBits;
 	}
 }
@@ -294,6 +336,53 @@ void FBitReader::SerializeIntPacked(uint32& OutValue)
 	OutValue = Value;
 }
 
+void FBitReader::ReadQuantizedFloats(TArrayView<float> OutValues, float MinValue, float MaxValue, int32 NumBits)
+{
+	check(NumBits >= 1 && NumBits <= 24 && MaxValue > MinValue);
+
+	const int64 LengthBits = int64(OutValues.Num()) * NumBits;
+	if (IsError() || Pos + LengthBits > Num)
+	{
+		if (!IsError())
+		{
+			SetOverflowed(LengthBits);
+		}
+		FMemory::Memzero(OutValues.GetData(), OutValues.Num() * sizeof(float));
+		return;
+	}
+
+	// Refill a 64 bit accumulator 32 bits at a time rather than reading each value from the buffer
+	const uint32 ValueMask = (1U << NumBits) - 1;
+	const float Step = (MaxValue - MinValue) / float(ValueMask);
+	const uint8* Data = Buffer.GetData();
+	const int64 NumBytes = Buffer.Num();
+	int64 LocalPos = Pos;
+	int64 BitsLeft = LengthBits;
+	uint64 Accumulator = 0;
+	int32 AccumulatedBits = 0;
+	for (float& Value : OutValues)
+	{
+		if (AccumulatedBits < NumBits)
+		{
+			const int32 RefillBits = (int32)FMath::Min<int64>(32, BitsLeft);
+			Accumulator |= UE4BitArchive_Private::PeekBits(Data, NumBytes, LocalPos, RefillBits) << AccumulatedBits;
+			AccumulatedBits += RefillBits;
+			LocalPos += RefillBits;
+			BitsLeft -= RefillBits;
+		}
+		Value = MinValue + float(uint32(Accumulator) & ValueMask) * Step;
+		Accumulator >>= NumBits;
+		AccumulatedBits -= NumBits;
+	}
+	Pos += LengthBits;
+}
+
+void FBitReader::ReadQuantizedVectors(TArrayView<FVector> OutValues, float MinValue, float MaxValue, int32 NumBits)
+{
+	static_assert(sizeof(FVector) == 3 * sizeof(float), "The components of the vectors are read as one array of floats");
+	ReadQuantizedFloats(MakeArrayView(reinterpret_cast<float*>(OutValues.GetData()), OutValues.Num() * 3), MinValue, MaxValue, NumBits);
+}
+
 /*-----------------------------------------------------------------------------
 	FBitReader.
 -----------------------------------------------------------------------------*/
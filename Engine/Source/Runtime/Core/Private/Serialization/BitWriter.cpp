@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Serialization/BitWriter.h"
+#include "Math/Vector.h"
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
 
@@ -9,7 +10,7 @@ PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 extern const uint8 GShift[8];
 extern const uint8 GMask[8];
 
-CORE_API void appBitsCpy( uint8* Dest, int32 DestBit, uint8* Src, int32 SrcBit, int32 BitCount );
+CORE_API void appBitsCpy( uint8* Dest, int64 DestBit, uint8* Src, int64 SrcBit, int64 BitCount );
 
 /*-----------------------------------------------------------------------------
 	FBitWriter.
@@ -79,6 +80,17 @@ void FBitWriter::SerializeBits( void* Src, int64 LengthBits )
 				Buffer[Num>>3] |= GShift[Num&7];
 			Num++;
 		}
+		else if( LengthBits <= UE4BitArchive_Private::MaxWordBits )
+		{
+			// Small fields are written as one word
+			uint64 Value = 0;
+			for( int64 ByteIndex = 0, NumBytes = (LengthBits+7)>>3; ByteIndex < NumBytes; ++ByteIndex )
+			{
+				Value |= uint64(((uint8*)Src)[ByteIndex]) << (ByteIndex * 8);
+			}
+			UE4BitArchive_Private::PokeBits(Buffer.GetData(), Buffer.Num(), Num, Value, LengthBits);
+			Num += LengthBits;
+		}
 		else
 		{
 			appBitsCpy(Buffer.GetData(), Num, (uint8*)Src, 0, LengthBits);
@@ -137,19 +149,11 @@ void FBitWriter::SerializeInt(uint32& Value, uint32 ValueMax)
 
 	if (AllowAppend(LengthBits))
 	{
-		uint32 NewValue = 0;
-		int64 LocalNum = Num;	// Use local var to avoid LHS
-
-		for (uint32 Mask=1; (NewValue + Mask) < ValueMax && Mask; Mask*=2, LocalNum++)
-		{
-			if (WriteValue & Mask)
-			{
-				Buffer[LocalNum >> 3] += GShift[LocalNum & 7];
-				NewValue += Mask;
-			}
-		}
-
-		Num = LocalNum;
+		// Upper bits that can't be set without reaching ValueMax are skipped, as FBitReader::SerializeInt does
+		int32 WrittenBits;
+		const uint32 Bits = UE4BitArchive_Private::TruncateIntToMax(WriteValue, ValueMax, WrittenBits);
+		UE4BitArchive_Private::PokeBits(Buffer.GetData(), Buffer.Num(), Num, Bits, WrittenBits);
+		Num += WrittenBits;
 	}
 	else
 	{
@@ -165,22 +169,72 @@ void FBitWriter::WriteIntWrapped(uint32 Value, uint32 ValueMax)
 
 	if (AllowAppend(LengthBits))
 	{
-		uint32 NewValue = 0;
-
-		for (uint32 Mask=1; NewValue+Mask < ValueMax && Mask; Mask*=2, Num++)
-		{
-			if (Value & Mask)
-			{
-				Buffer[Num>>3] += GShift[Num&7];
-				NewValue += Mask;
-			}
-		}
+		int32 WrittenBits;
+		const uint32 Bits = UE4BitArchive_Private::TruncateIntToMax(Value, ValueMax, WrittenBits);
+		UE4BitArchive_Private::PokeBits(Buffer.GetData(), Buffer.Num(), Num, Bits, WrittenBits);
+		Num += WrittenBits;
 	}
 	else
 	{
 		SetOverflowed(LengthBits);
 	}
 }
+void FBitWriter::WriteBits(uint64 Value, int32 LengthBits)
+{
+	check(LengthBits >= 0 && LengthBits <= UE4BitArchive_Private::MaxWordBits);
+	if (AllowAppend(LengthBits))
+	{
+		UE4BitArchive_Private::PokeBits(Buffer.GetData(), Buffer.Num(), Num, Value, LengthBits);
+		Num += LengthBits;
+	}
+	else
+	{
+		SetOverflowed(LengthBits);
+	}
+}
+
+void FBitWriter::WriteQuantizedFloats(TArrayView<const float> Values, float MinValue, float MaxValue, int32 NumBits)
+{
+	check(NumBits >= 1 && NumBits <= 24 && MaxValue > MinValue);
+
+	const int64 LengthBits = int64(Values.Num()) * NumBits;
+	if (!AllowAppend(LengthBits))
+	{
+		SetOverflowed(LengthBits);
+		return;
+	}
+
+	// Values are gathered in a 64 bit accumulator that is written 32 bits at a time
+	const uint32 ValueMax = (1U << NumBits) - 1;
+	const float Scale = float(ValueMax) / (MaxValue - MinValue);
+	uint8* Data = Buffer.GetData();
+	const int64 NumBytes = Buffer.Num();
+	int64 LocalNum = Num;
+	uint64 Accumulator = 0;
+	int32 AccumulatedBits = 0;
+	for (float Value : Values)
+	{
+		const uint32 Quantized = (uint32)FMath::Clamp(FMath::RoundToInt((FMath::Clamp(Value, MinValue, MaxValue) - MinValue) * Scale), 0, (int32)ValueMax);
+		Accumulator |= uint64(Quantized) << AccumulatedBits;
+		AccumulatedBits += NumBits;
+		if (AccumulatedBits >= 32)
+		{
+			UE4BitArchive_Private::PokeBits(Data, NumBytes, LocalNum, Accumulator, 32);
+			Accumulator >>= 32;
+			AccumulatedBits -= 32;
+			LocalNum += 32;
+		}
+	}
+	UE4BitArchive_Private::PokeBits(Data, NumBytes, LocalNum, Accumulator, AccumulatedBits);
+	Num += LengthBits;
+}
+
+void FBitWriter::WriteQuantizedVectors(TArrayView<const FVector> Values, float MinValue, float MaxValue, int32 NumBits)
+{
+	static_assert(sizeof(FVector) == 3 * sizeof(float), "The components of the vectors are written as one array of floats");
+	WriteQuantizedFloats(MakeArrayView(reinterpret_cast<const float*>(Values.GetData()), Values.Num() * 3), MinValue, MaxValue, NumBits);
+}
+
 void FBitWriter::WriteBit( uint8 In )
 {
 	if( AllowAppend(1) )
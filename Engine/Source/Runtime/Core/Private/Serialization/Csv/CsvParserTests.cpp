@@ -4,6 +4,7 @@
 #include "Containers/UnrealString.h"
 #include "Misc/AutomationTest.h"
 #include "Serialization/Csv/CsvParser.h"
+#include "Serialization/Csv/CsvStreamParser.h"
 
 namespace CsvParser_Tests
 {
@@ -178,3 +179,57 @@ bool FEndOfStringTest::RunTest(const FString& Parameters)
 
 	return bSuccess;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamParserTest, "System.Core.CSV Parser.Stream Parser", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FStreamParserTest::RunTest(const FString& Parameters)
+{
+	const ANSICHAR* Sources[] = {
+		"1,2,3,4\n5,6,7,8",
+		"\"Quoted with nested \"\"quotes\"\", and \"\"commas\"\"\" \"unquoted due to \"whitespace\" , second \" unquoted\n\"Quoted\nString,With\nNewlines\",\"\"\n1,\"2\"\n",
+		",,,\n,,,\n , , , \n",
+		"1\r2\n3\r\n4\n\n5\r\r6\r\n\r\n7\n\r8",
+		"\r\n\r\r\n\n\r\n\n\r",
+		",,,",
+		"\"\",\"\",\"\",\"\"\n",
+	};
+
+	bool bSuccess = true;
+	for (const ANSICHAR* Source : Sources)
+	{
+		// The stream parser gives the same cells as FCsvParser, whether parsing in one go or in parts
+		const int32 Size = FCStringAnsi::Strlen(Source);
+		const FCsvParser Parser((FString(Source)));
+		const FCsvParser::FRows& Expected = Parser.GetRows();
+
+		int32 NumRows = 0;
+		FCsvStreamParser::ParseBuffer((const UTF8CHAR*)Source, Size, [&Expected, &NumRows, &bSuccess](TArrayView<const FAnsiStringView> Cells)
+		{
+			bSuccess &= Expected.IsValidIndex(NumRows) && Expected[NumRows].Num() == Cells.Num();
+			for (int32 Cell = 0; bSuccess && Cell < Cells.Num(); ++Cell)
+			{
+				bSuccess &= FString(Cells[Cell].Len(), Cells[Cell].GetData()) == Expected[NumRows][Cell];
+			}
+			++NumRows;
+			return true;
+		});
+		bSuccess &= NumRows == Expected.Num();
+
+		TArray<int32> NumPartRows;
+		NumPartRows.SetNumZeroed(3);
+		FCsvStreamParser::ParseBufferParallel((const UTF8CHAR*)Source, Size, 3, [&NumPartRows](int32 PartIndex, TArrayView<const FAnsiStringView> Cells)
+		{
+			++NumPartRows[PartIndex];
+			return true;
+		});
+		bSuccess &= NumPartRows[0] + NumPartRows[1] + NumPartRows[2] == Expected.Num();
+
+		if (!bSuccess)
+		{
+			AddError(FString::Printf(TEXT("Stream parser did not match FCsvParser on:\n%s"), ANSI_TO_TCHAR(Source)));
+			return false;
+		}
+	}
+
+	return true;
+}
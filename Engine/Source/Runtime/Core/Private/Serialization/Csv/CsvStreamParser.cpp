@@ -0,0 +1,433 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/Csv/CsvStreamParser.h"
+#include "Async/AsyncFileHandle.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Array.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Templates/Atomic.h"
+#include "Templates/UniquePtr.h"
+
+namespace UE4CsvStreamParser_Private
+{
+	/** Size of the parts files are read in when they cannot be mapped, two of them are in flight at once */
+	static constexpr int64 ReadPartSize = 4 * 1024 * 1024;
+
+	/** The cells of the row being parsed */
+	struct FRow
+	{
+		struct FCell
+		{
+			const ANSICHAR* Data;
+			int32 Len;
+			/** Offset of the cell in Unescaped, or INDEX_NONE if it points into the source text */
+			int32 UnescapedOffset;
+		};
+
+		TArray<FCell> Cells;
+		TArray<ANSICHAR> Unescaped;
+		TArray<FAnsiStringView> Views;
+
+		void Reset()
+		{
+			Cells.Reset();
+			Unescaped.Reset();
+		}
+
+		TArrayView<const FAnsiStringView> GetViews()
+		{
+			// Only made once the row is complete, as Unescaped moves while it grows
+			Views.Reset(Cells.Num());
+			for (const FCell& Cell : Cells)
+			{
+				Views.Emplace(Cell.UnescapedOffset == INDEX_NONE ? Cell.Data : Unescaped.GetData() + Cell.UnescapedOffset, Cell.Len);
+			}
+			return Views;
+		}
+	};
+
+	FORCEINLINE bool IsNewLine(ANSICHAR Char)
+	{
+		return Char == '\r' || Char == '\n';
+	}
+
+	FORCEINLINE bool IsCellEnd(ANSICHAR Char)
+	{
+		return Char == ',' || Char == '\r' || Char == '\n';
+	}
+
+	/**
+	 * Parse the row starting at At, which must not start with a new line, following the rules of FCsvParser::ParseCell.
+	 *
+	 * @param Row	Receives the cells of the row, or null to only find where the row ends
+	 * @return Where the next row starts, or null if the row runs to End without a new line
+	 */
+	static const ANSICHAR* ParseRow(const ANSICHAR* At, const ANSICHAR* End, FRow* Row)
+	{
+		for (;;)
+		{
+			if (At < End && *At == '"')
+			{
+				const ANSICHAR* CellStart = ++At;
+				while (At < End && *At != '"')
+				{
+					++At;
+				}
+
+				if (At == End || At + 1 == End || IsCellEnd(At[1]))
+				{
+					// The common case of a quoted cell without escaped quotes nor text after its closing quote
+					if (Row)
+					{
+						Row->Cells.Add({ CellStart, (int32)(At - CellStart), INDEX_NONE });
+					}
+					At += At < End;
+				}
+				else
+				{
+					// Unescape pairs of quotes, the cell stays quoted until an odd number of them, then runs up to the next cell end
+					const int32 UnescapedOffset = Row ? Row->Unescaped.Num() : 0;
+					bool bQuoted = true;
+					for (At = CellStart; At < End; )
+					{
+						if (bQuoted && *At == '"')
+						{
+							const ANSICHAR* QuotesStart = At;
+							while (At < End && *At == '"')
+							{
+								++At;
+							}
+							const int32 NumQuotes = (int32)(At - QuotesStart);
+							bQuoted = (NumQuotes % 2) == 0;
+							if (Row)
+							{
+								Row->Unescaped.Append(QuotesStart, NumQuotes / 2);
+							}
+						}
+						else if (!bQuoted && IsCellEnd(*At))
+						{
+							break;
+						}
+						else
+						{
+							const ANSICHAR* RunStart = At;
+							while (At < End && (bQuoted ? *At != '"' : !IsCellEnd(*At)))
+							{
+								++At;
+							}
+							if (Row)
+							{
+								Row->Unescaped.Append(RunStart, (int32)(At - RunStart));
+							}
+						}
+					}
+
+					if (Row)
+					{
+						Row->Cells.Add({ nullptr, Row->Unescaped.Num() - UnescapedOffset, UnescapedOffset });
+					}
+				}
+			}
+			else
+			{
+				const ANSICHAR* CellStart = At;
+				while (At < End && !IsCellEnd(*At))
+				{
+					++At;
+				}
+				if (Row)
+				{
+					Row->Cells.Add({ CellStart, (int32)(At - CellStart), INDEX_NONE });
+				}
+			}
+
+			if (At == End)
+			{
+				return nullptr;
+			}
+			else if (*At == ',')
+			{
+				// There is always another, potentially empty, cell after a comma
+				++At;
+			}
+			else
+			{
+				return At + ((At[0] == '\r' && At + 1 < End && At[1] == '\n') ? 2 : 1);
+			}
+		}
+	}
+
+	/** @return The start of the first row at or after At, skipping empty lines */
+	FORCEINLINE const ANSICHAR* SkipNewLines(const ANSICHAR* At, const ANSICHAR* End)
+	{
+		while (At < End && IsNewLine(*At))
+		{
+			++At;
+		}
+		return At;
+	}
+
+	/**
+	 * Parse the rows from At to End, passing each of them to OnRow.
+	 *
+	 * @param bFinal		Whether End is the end of the text, otherwise a row that runs to End is left unparsed
+	 * @param bOutStopped	Set if OnRow stopped the parsing
+	 * @return Where parsing stopped, which is End unless a row runs to End and bFinal is false, or OnRow stopped the parsing
+	 */
+	template <typename CallbackType>
+	static const ANSICHAR* ParseRows(const ANSICHAR* At, const ANSICHAR* End, bool bFinal, FRow& Row, CallbackType&& OnRow, bool& bOutStopped)
+	{
+		for (;;)
+		{
+			At = SkipNewLines(At, End);
+			if (At == End)
+			{
+				return End;
+			}
+
+			Row.Reset();
+			const ANSICHAR* NextRow = ParseRow(At, End, &Row);
+			if (!NextRow)
+			{
+				if (!bFinal)
+				{
+					return At;
+				}
+				NextRow = End;
+			}
+
+			if (!OnRow(Row.GetViews()))
+			{
+				bOutStopped = true;
+				return NextRow;
+			}
+			At = NextRow;
+		}
+	}
+
+	static const ANSICHAR* SkipByteOrderMark(const ANSICHAR* At, const ANSICHAR* End)
+	{
+		if (End - At >= 3 && (uint8)At[0] == 0xEF && (uint8)At[1] == 0xBB && (uint8)At[2] == 0xBF)
+		{
+			return At + 3;
+		}
+		return At;
+	}
+
+	/** Reads a file in parts with IAsyncReadFileHandle, rows that run over the end of a part are copied to be parsed whole */
+	static bool ParseFileInParts(const TCHAR* Filename, FCsvStreamParser::FRowCallback OnRow)
+	{
+		TUniquePtr<IAsyncReadFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(Filename));
+		if (!Handle)
+		{
+			return false;
+		}
+
+		IAsyncReadRequest* SizeRequest = Handle->SizeRequest();
+		SizeRequest->WaitCompletion();
+		const int64 FileSize = SizeRequest->GetSizeResults();
+		delete SizeRequest;
+		if (FileSize <= 0)
+		{
+			return FileSize == 0;
+		}
+
+		const int64 PartSize = FMath::Min(FileSize, ReadPartSize);
+		TArray<ANSICHAR> Buffer;
+		Buffer.SetNumUninitialized((int32)(PartSize * 2));
+		ANSICHAR* Parts[2] = { Buffer.GetData(), Buffer.GetData() + PartSize };
+
+		FRow Row;
+		TArray<ANSICHAR> Carried;
+		bool bSucceeded = true;
+		bool bStopped = false;
+
+		int32 PartIndex = 0;
+		IAsyncReadRequest* Request = Handle->ReadRequest(0, PartSize, AIOP_Normal, nullptr, (uint8*)Parts[PartIndex]);
+		for (int64 Offset = 0; Request; PartIndex ^= 1)
+		{
+			Request->WaitCompletion();
+			const ANSICHAR* PartStart = (const ANSICHAR*)Request->GetReadResults();
+			delete Request;
+			Request = nullptr;
+			if (!PartStart)
+			{
+				bSucceeded = false;
+				break;
+			}
+
+			const int64 NextOffset = Offset + FMath::Min(FileSize - Offset, PartSize);
+			const bool bFinalPart = NextOffset == FileSize;
+			if (!bFinalPart)
+			{
+				Request = Handle->ReadRequest(NextOffset, FMath::Min(FileSize - NextOffset, PartSize), AIOP_Normal, nullptr, (uint8*)Parts[PartIndex ^ 1]);
+			}
+
+			const ANSICHAR* PartEnd = PartStart + (NextOffset - Offset);
+			const ANSICHAR* At = Offset == 0 ? SkipByteOrderMark(PartStart, PartEnd) : PartStart;
+
+			// Finish the row carried over from the previous part first, growing it by at least its own size each time
+			// it turns out to be incomplete so rows spanning many new lines are not scanned over and over
+			while (Carried.Num() && At < PartEnd && !bStopped)
+			{
+				const ANSICHAR* NewLine = FMath::Min(At + Carried.Num(), PartEnd);
+				while (NewLine < PartEnd && *NewLine != '\n')
+				{
+					++NewLine;
+				}
+				const ANSICHAR* PieceStart = At;
+				const ANSICHAR* PieceEnd = NewLine + (NewLine < PartEnd);
+				const int32 NumPreviouslyCarried = Carried.Num();
+				Carried.Append(PieceStart, (int32)(PieceEnd - PieceStart));
+				At = PieceEnd;
+
+				const ANSICHAR* CarriedStart = Carried.GetData();
+				const ANSICHAR* Rest = ParseRows(CarriedStart, CarriedStart + Carried.Num(), bFinalPart && At == PartEnd, Row, OnRow, bStopped);
+				const int32 NumParsed = (int32)(Rest - CarriedStart);
+				if (NumParsed >= NumPreviouslyCarried)
+				{
+					// What is left starts in this part, so carry on parsing it in place
+					At = PieceStart + (NumParsed - NumPreviouslyCarried);
+					Carried.Reset();
+				}
+				else
+				{
+					Carried.RemoveAt(0, NumParsed, false);
+				}
+			}
+
+			if (Carried.Num() == 0 && !bStopped)
+			{
+				const ANSICHAR* Rest = ParseRows(At, PartEnd, bFinalPart, Row, OnRow, bStopped);
+				Carried.Append(Rest, (int32)(PartEnd - Rest));
+			}
+
+			if (bStopped && Request)
+			{
+				Request->WaitCompletion();
+				delete Request;
+				Request = nullptr;
+			}
+			Offset = NextOffset;
+		}
+
+		return bSucceeded && !bStopped;
+	}
+
+	/**
+	 * Maps a file and passes its contents to Parse.
+	 *
+	 * @param bOutResult	Receives what Parse returned, or true for an empty file
+	 * @return false if the platform could not map the file
+	 */
+	template <typename ParseType>
+	static bool ParseMappedFile(const TCHAR* Filename, ParseType&& Parse, bool& bOutResult)
+	{
+		TUniquePtr<IMappedFileHandle> MappedHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename));
+		if (!MappedHandle)
+		{
+			return false;
+		}
+
+		bOutResult = true;
+		if (MappedHandle->GetFileSize() > 0)
+		{
+			TUniquePtr<IMappedFileRegion> MappedRegion(MappedHandle->MapRegion());
+			bOutResult = Parse((const UTF8CHAR*)MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+		}
+		return true;
+	}
+}
+
+bool FCsvStreamParser::ParseBuffer(const UTF8CHAR* Text, int64 Size, FRowCallback OnRow)
+{
+	using namespace UE4CsvStreamParser_Private;
+
+	const ANSICHAR* End = (const ANSICHAR*)Text + Size;
+	FRow Row;
+	bool bStopped = false;
+	ParseRows(SkipByteOrderMark((const ANSICHAR*)Text, End), End, true, Row, OnRow, bStopped);
+	return !bStopped;
+}
+
+bool FCsvStreamParser::ParseBufferParallel(const UTF8CHAR* Text, int64 Size, int32 NumParts, FPartRowCallback OnRow)
+{
+	using namespace UE4CsvStreamParser_Private;
+
+	const ANSICHAR* End = (const ANSICHAR*)Text + Size;
+	const ANSICHAR* At = SkipByteOrderMark((const ANSICHAR*)Text, End);
+
+	// Find the first row starting at or after each even split of the text
+	TArray<const ANSICHAR*> PartStarts;
+	PartStarts.Add(At);
+	for (int32 Split = 1; Split < NumParts && At < End; ++Split)
+	{
+		const ANSICHAR* Target = (const ANSICHAR*)Text + Size * Split / NumParts;
+		while (At < Target)
+		{
+			At = SkipNewLines(At, End);
+			const ANSICHAR* NextRow = At < End ? ParseRow(At, End, nullptr) : nullptr;
+			At = NextRow ? NextRow : End;
+		}
+		if (At < End && At != PartStarts.Last())
+		{
+			PartStarts.Add(At);
+		}
+	}
+	PartStarts.Add(End);
+
+	TAtomic<bool> bStopped(false);
+	ParallelFor(PartStarts.Num() - 1, [&PartStarts, &bStopped, &OnRow](int32 PartIndex)
+	{
+		FRow Row;
+		bool bPartStopped = false;
+		auto OnPartRow = [PartIndex, &bStopped, &OnRow](TArrayView<const FAnsiStringView> Cells)
+		{
+			return !bStopped.Load(EMemoryOrder::Relaxed) && OnRow(PartIndex, Cells);
+		};
+		ParseRows(PartStarts[PartIndex], PartStarts[PartIndex + 1], true, Row, OnPartRow, bPartStopped);
+		if (bPartStopped)
+		{
+			bStopped = true;
+		}
+	});
+	return !bStopped;
+}
+
+bool FCsvStreamParser::ParseFile(const TCHAR* Filename, FRowCallback OnRow)
+{
+	using namespace UE4CsvStreamParser_Private;
+
+	bool bResult = false;
+	auto Parse = [&OnRow](const UTF8CHAR* Text, int64 Size)
+	{
+		return ParseBuffer(Text, Size, OnRow);
+	};
+	if (ParseMappedFile(Filename, Parse, bResult))
+	{
+		return bResult;
+	}
+
+	return ParseFileInParts(Filename, OnRow);
+}
+
+bool FCsvStreamParser::ParseFileParallel(const TCHAR* Filename, int32 NumParts, FPartRowCallback OnRow)
+{
+	using namespace UE4CsvStreamParser_Private;
+
+	bool bResult = false;
+	auto Parse = [NumParts, &OnRow](const UTF8CHAR* Text, int64 Size)
+	{
+		return ParseBufferParallel(Text, Size, NumParts, OnRow);
+	};
+	if (ParseMappedFile(Filename, Parse, bResult))
+	{
+		return bResult;
+	}
+
+	// Parts are parsed out of order, so the file is loaded in one go when it cannot be mapped
+	TArray64<uint8> Contents;
+	return FFileHelper::LoadFileToArray(Contents, Filename, FILEREAD_Silent) && Parse(Contents.GetData(), Contents.Num());
+}
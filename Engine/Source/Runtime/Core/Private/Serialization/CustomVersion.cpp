@@ -117,7 +117,7 @@ struct FStaticCustomVersionRegistry
 			for (const TPair<FGuid, FPendingRegistration>& Queued : Queue)
 			{
 				// Check if this tag hasn't already been registered
-				if (FCustomVersion* ExistingRegistration = Registered.Versions.FindByKey(Queued.Key))
+				if (FCustomVersion* ExistingRegistration = Registered.FindVersion(Queued.Key))
 				{
 					// We don't allow the registration details to change across registrations - this code path only exists to support hotreload
 
@@ -137,7 +137,7 @@ struct FStaticCustomVersionRegistry
 				}
 				else
 				{
-					Registered.Versions.Add(FCustomVersion(Queued.Key, Queued.Value.Version, Queued.Value.FriendlyName));
+					Registered.AddVersion(FCustomVersion(Queued.Key, Queued.Value.Version, Queued.Value.FriendlyName));
 				}
 			}
 
@@ -149,17 +149,19 @@ struct FStaticCustomVersionRegistry
 	{
 		if (Queue.Remove(Key) == 0)
 		{
-			const int32 KeyIndex = Registered.Versions.IndexOfByKey(Key);
+			const FCustomVersionContainer::FVersionIndex* VersionIndex = Registered.VersionIndices.Find(Key);
 
 			// Ensure this tag has been registered
-			check(KeyIndex != INDEX_NONE);
+			check(VersionIndex);
+
+			const int32 KeyIndex = VersionIndex->Index;
 
 			FCustomVersion* FoundKey = &Registered.Versions[KeyIndex];
 
 			--FoundKey->ReferenceCount;
 			if (FoundKey->ReferenceCount == 0)
 			{
-				Registered.Versions.RemoveAtSwap(KeyIndex);
+				Registered.RemoveVersionAtSwap(KeyIndex);
 			}
 		}
 	}
@@ -263,11 +265,13 @@ const FCustomVersionContainer& FCustomVersionContainer::GetRegistered()
 void FCustomVersionContainer::Empty()
 {
 	Versions.Empty();
+	VersionIndices.Empty();
 }
 
 void FCustomVersionContainer::SortByKey()
 {
 	Algo::SortBy(Versions, &FCustomVersion::Key);
+	RebuildIndices();
 }
 
 FString FCustomVersionContainer::ToString(const FString& Indent) const
@@ -343,6 +347,11 @@ void FCustomVersionContainer::Serialize(FStructuredArchive::FSlot Slot, ECustomV
 	}
 	break;
 	}
+
+	if (Slot.GetUnderlyingArchive().IsLoading())
+	{
+		RebuildIndices();
+	}
 }
 
 const FCustomVersion* FCustomVersionContainer::GetVersion(FGuid Key) const
@@ -354,7 +363,8 @@ const FCustomVersion* FCustomVersionContainer::GetVersion(FGuid Key) const
 		return &GetUnusedCustomVersion();
 	}
 
-	return Versions.FindByKey(Key);
+	const FVersionIndex* VersionIndex = VersionIndices.Find(Key);
+	return VersionIndex ? &Versions[VersionIndex->Index] : nullptr;
 }
 
 const FName FCustomVersionContainer::GetFriendlyName(FGuid Key) const
@@ -375,13 +385,70 @@ void FCustomVersionContainer::SetVersion(FGuid CustomKey, int32 Version, FName F
 		return;
 	}
 
-	if (FCustomVersion* Found = Versions.FindByKey(CustomKey))
+	if (FVersionIndex* Found = VersionIndices.Find(CustomKey))
 	{
-		Found->Version      = Version;
-		Found->FriendlyName = FriendlyName;
+		FCustomVersion& FoundVersion = Versions[Found->Index];
+		FoundVersion.Version      = Version;
+		FoundVersion.FriendlyName = FriendlyName;
+		Found->bIsCurrent = false;
 	}
 	else
 	{
-		Versions.Add(FCustomVersion(CustomKey, Version, FriendlyName));
+		AddVersion(FCustomVersion(CustomKey, Version, FriendlyName));
+	}
+}
+
+void FCustomVersionContainer::SetCurrentVersion(FGuid CustomKey)
+{
+	if (CustomKey == UnusedCustomVersionKey)
+	{
+		return;
+	}
+
+	if (const FVersionIndex* Found = VersionIndices.Find(CustomKey))
+	{
+		if (Found->bIsCurrent)
+		{
+			return;
+		}
+	}
+
+	FCustomVersion RegisteredVersion = FCurrentCustomVersions::Get(CustomKey).GetValue();
+	SetVersion(CustomKey, RegisteredVersion.Version, RegisteredVersion.GetFriendlyName());
+	VersionIndices.FindChecked(CustomKey).bIsCurrent = true;
+}
+
+FCustomVersion* FCustomVersionContainer::FindVersion(FGuid CustomKey)
+{
+	FVersionIndex* VersionIndex = VersionIndices.Find(CustomKey);
+	return VersionIndex ? &Versions[VersionIndex->Index] : nullptr;
+}
+
+void FCustomVersionContainer::AddVersion(const FCustomVersion& Version)
+{
+	VersionIndices.Add(Version.Key, { Versions.Add(Version), false });
+}
+
+void FCustomVersionContainer::RemoveVersionAtSwap(int32 Index)
+{
+	VersionIndices.Remove(Versions[Index].Key);
+	Versions.RemoveAtSwap(Index);
+	if (Index < Versions.Num())
+	{
+		VersionIndices.FindChecked(Versions[Index].Key).Index = Index;
+	}
+}
+
+void FCustomVersionContainer::RebuildIndices()
+{
+	VersionIndices.Reset();
+	VersionIndices.Reserve(Versions.Num());
+	for (int32 Index = 0; Index < Versions.Num(); ++Index)
+	{
+		// Serialized containers could hold the same key twice, the first one is the one that lookups have always found
+		if (!VersionIndices.Contains(Versions[Index].Key))
+		{
+			VersionIndices.Add(Versions[Index].Key, { Index, false });
+		}
 	}
 }
@@ -3,24 +3,46 @@
 #include "Serialization/LargeMemoryData.h"
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "IO/IoDispatcher.h"
 
 /*----------------------------------------------------------------------------
 	FLargeMemoryData
 ----------------------------------------------------------------------------*/
 
 FLargeMemoryData::FLargeMemoryData(const int64 PreAllocateBytes)
-	: Data(nullptr)
-	, NumBytes(FMath::Max<int64>(0, PreAllocateBytes))
-	, MaxBytes(0)
+	: FirstPageSize(FMath::Max<int64>(64 * 1024, FMemory::QuantizeSize(FMath::Max<int64>(0, PreAllocateBytes))))
+	, NumBytes(0)
 {
-	GrowBuffer();
+	Pages.Add((uint8*)FMemory::Malloc(FirstPageSize));
 }
 
 FLargeMemoryData::~FLargeMemoryData()
 {
-	if (Data)
+	for (uint8* Page : Pages)
 	{
-		FMemory::Free(Data);
+		FMemory::Free(Page);
+	}
+}
+
+template <typename FuncType>
+void FLargeMemoryData::ForEachPageInRange(int64 InOffset, int64 InNum, FuncType&& Func) const
+{
+	int32 PageIndex = 0;
+	int64 PageOffset = InOffset;
+	if (InOffset >= FirstPageSize)
+	{
+		PageIndex = 1 + (int32)((InOffset - FirstPageSize) / PageSize);
+		PageOffset = (InOffset - FirstPageSize) % PageSize;
+	}
+
+	while (InNum > 0)
+	{
+		const int64 PageNum = FMath::Min(InNum, (PageIndex ? PageSize : FirstPageSize) - PageOffset);
+		Func(Pages[PageIndex] + PageOffset, PageNum);
+		InNum -= PageNum;
+		PageOffset = 0;
+		++PageIndex;
 	}
 }
 
@@ -31,15 +53,17 @@ bool FLargeMemoryData::Write(void* InData, int64 InOffset, int64 InNum)
 	{
 		// Grow the buffer to the offset position even if InNum == 0.
 		NumBytes = FMath::Max<int64>(NumBytes, InOffset + InNum);
-		if (NumBytes > MaxBytes)
+		if (NumBytes > GetMaxBytes())
 		{
-			GrowBuffer();
+			AddPages(NumBytes);
 		}
 
-		if (InNum)
+		const uint8* Source = (const uint8*)InData;
+		ForEachPageInRange(InOffset, InNum, [&Source](uint8* PageData, int64 PageNum)
 		{
-			FMemory::Memcpy(&Data[InOffset], InData, InNum);
-		}
+			FMemory::Memcpy(PageData, Source, PageNum);
+			Source += PageNum;
+		});
 
 		return true;
 	}
@@ -54,10 +78,12 @@ bool FLargeMemoryData::Read(void* OutData, int64 InOffset, int64 InNum) const
 	// Allow OutData to be null if InNum == 0.
 	if (InOffset >= 0 && (OutData ? InNum >= 0 : InNum == 0) && (InOffset + InNum <= NumBytes))
 	{
-		if (InNum)
+		uint8* Dest = (uint8*)OutData;
+		ForEachPageInRange(InOffset, InNum, [&Dest](const uint8* PageData, int64 PageNum)
 		{
-			FMemory::Memcpy(OutData, &Data[InOffset], InNum);
-		}
+			FMemory::Memcpy(Dest, PageData, PageNum);
+			Dest += PageNum;
+		});
 
 		return true;
 	}
@@ -67,39 +93,111 @@ bool FLargeMemoryData::Read(void* OutData, int64 InOffset, int64 InNum) const
 	}
 }
 
+uint8* FLargeMemoryData::GetData()
+{
+	if (Pages.Num() > 1)
+	{
+		// Grow the first page in place when the allocator can, with slack proportional to the size as further writes
+		// would otherwise add pages that the next call coalesces again
+		const int64 NewFirstPageSize = FMemory::QuantizeSize(NumBytes + 3 * NumBytes / 8 + 16);
+		uint8* FirstPage = (uint8*)FMemory::Realloc(Pages[0], NewFirstPageSize);
+
+		int64 Offset = FirstPageSize;
+		for (int32 PageIndex = 1; PageIndex < Pages.Num(); ++PageIndex)
+		{
+			if (Offset < NumBytes)
+			{
+				FMemory::Memcpy(FirstPage + Offset, Pages[PageIndex], FMath::Min(NumBytes - Offset, PageSize));
+			}
+			FMemory::Free(Pages[PageIndex]);
+			Offset += PageSize;
+		}
+
+		Pages.Reset(1);
+		Pages.Add(FirstPage);
+		FirstPageSize = NewFirstPageSize;
+	}
+
+	return Pages.Num() ? Pages[0] : nullptr;
+}
+
 uint8* FLargeMemoryData::ReleaseOwnership()
 {
-	uint8* ReturnData = Data;
+	uint8* ReturnData = GetData();
 
-	Data = nullptr;
+	Pages.Empty();
+	FirstPageSize = 0;
 	NumBytes = 0;
-	MaxBytes = 0;
 
 	return ReturnData;
 }
 
-void FLargeMemoryData::Reserve(int64 NewMax)
+FIoBuffer FLargeMemoryData::ReleaseToIoBuffer()
 {
-	if (MaxBytes < NewMax)
+	if (Pages.Num() <= 1)
 	{
-		// Allocate slack proportional to the buffer size. Min 64 KB
-		MaxBytes = NewMax;
+		const int64 Size = NumBytes;
+		return FIoBuffer(FIoBuffer::AssumeOwnership, ReleaseOwnership(), Size);
+	}
 
-		Data = (uint8*)FMemory::Realloc(Data, MaxBytes);
+	// Untouched parts of a large allocation usually take no physical memory, so freeing each page once it is
+	// copied keeps the total close to the size of the data
+	FIoBuffer Buffer(NumBytes);
+	int64 Offset = 0;
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+	{
+		const int64 PageNum = FMath::Min(NumBytes - Offset, PageIndex ? PageSize : FirstPageSize);
+		if (PageNum > 0)
+		{
+			FMemory::Memcpy(Buffer.Data() + Offset, Pages[PageIndex], PageNum);
+			Offset += PageNum;
+		}
+		FMemory::Free(Pages[PageIndex]);
 	}
+
+	Pages.Empty();
+	FirstPageSize = 0;
+	NumBytes = 0;
+
+	return Buffer;
 }
 
-void FLargeMemoryData::GrowBuffer()
+bool FLargeMemoryData::WriteToFile(IFileHandle& FileHandle) const
 {
-	// Allocate slack proportional to the buffer size. Min 64 KB
-	MaxBytes = FMath::Max<int64>(64 * 1024, FMemory::QuantizeSize(NumBytes + 3 * NumBytes / 8 + 16));
+	bool bSuccess = true;
+	ForEachPageInRange(0, NumBytes, [&FileHandle, &bSuccess](const uint8* PageData, int64 PageNum)
+	{
+		bSuccess = bSuccess && FileHandle.Write(PageData, PageNum);
+	});
+	return bSuccess;
+}
 
-	if (Data)
+void FLargeMemoryData::Reserve(int64 NewMax)
+{
+	if (GetMaxBytes() < NewMax)
 	{
-		Data = (uint8*)FMemory::Realloc(Data, MaxBytes);
+		if (Pages.Num() == 1 && NumBytes == 0)
+		{
+			// Nothing to copy yet, so keep the data in one block
+			FirstPageSize = FMemory::QuantizeSize(NewMax);
+			FMemory::Free(Pages[0]);
+			Pages[0] = (uint8*)FMemory::Malloc(FirstPageSize);
+		}
+		else
+		{
+			AddPages(NewMax);
+		}
 	}
-	else
+}
+
+void FLargeMemoryData::AddPages(int64 NewMax)
+{
+	UE_CLOG(!HasData(), LogSerialization, Fatal, TEXT("Tried to grow an FLargeMemoryData that was already released."));
+
+	const int64 NumPagesNeeded = 1 + (NewMax - FirstPageSize + PageSize - 1) / PageSize;
+	Pages.Reserve((int32)NumPagesNeeded);
+	while (Pages.Num() < NumPagesNeeded)
 	{
-		Data = (uint8*)FMemory::Malloc(MaxBytes);
+		Pages.Add((uint8*)FMemory::Malloc(PageSize));
 	}
 }
@@ -3,6 +3,7 @@
 #include "Serialization/LargeMemoryWriter.h"
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
+#include "IO/IoDispatcher.h"
 
 /*----------------------------------------------------------------------------
 	FLargeMemoryWriter
@@ -37,3 +38,15 @@ uint8* FLargeMemoryWriter::GetData() const
 	UE_CLOG(!Data.HasData(), LogSerialization, Warning, TEXT("Tried to get written data from an FLargeMemoryWriter that was already released. Archive name: %s."), *ArchiveName);
 	return const_cast<uint8*>(Data.GetData());
 }
+
+FIoBuffer FLargeMemoryWriter::ReleaseToIoBuffer()
+{
+	UE_CLOG(!Data.HasData(), LogSerialization, Warning, TEXT("Tried to release written data from an FLargeMemoryWriter that was already released. Archive name: %s."), *ArchiveName);
+	return Data.ReleaseToIoBuffer();
+}
+
+bool FLargeMemoryWriter::WriteToFile(IFileHandle& FileHandle) const
+{
+	UE_CLOG(!Data.HasData(), LogSerialization, Warning, TEXT("Tried to write data from an FLargeMemoryWriter that was already released. Archive name: %s."), *ArchiveName);
+	return Data.WriteToFile(FileHandle);
+}
@@ -10,6 +10,12 @@
 #include "ProfilingDebugging/LoadTimeTracker.h"
 #include "Misc/DataDrivenPlatformInfoRegistry.h"
 #include "Serialization/Archive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "CoreGlobals.h"
 
 IMPLEMENT_TYPE_LAYOUT(FMemoryImageString);
 IMPLEMENT_TYPE_LAYOUT(FPlatformTypeLayoutParameters);
@@ -1089,6 +1095,130 @@ void FMemoryImageResult::ApplyPatchesFromArchive(void* FrozenObject, FArchive& A
 	}
 }
 
+static const uint32 MappableMemoryImageMagic = 0x4D4D494Du;
+
+void FMemoryImageResult::SaveToMappableArchive(FArchive& Ar) const
+{
+	check(Ar.Tell() == 0);
+
+	// FNames are saved as strings by memory archives, the tables are read back with one on load
+	TArray<uint8> Patches;
+	{
+		FMemoryWriter PatchesWriter(Patches);
+		SaveToArchive(PatchesWriter);
+	}
+
+	uint32 Magic = MappableMemoryImageMagic;
+	uint32 FrozenSize = Bytes.Num();
+	uint32 PatchesSize = Patches.Num();
+	uint32 BytesOffset = Align(4u * (uint32)sizeof(uint32) + PatchesSize, MappableAlignment);
+	Ar << Magic;
+	Ar << FrozenSize;
+	Ar << PatchesSize;
+	Ar << BytesOffset;
+	Ar.Serialize(Patches.GetData(), PatchesSize);
+
+	TArray<uint8> Padding;
+	Padding.SetNumZeroed(BytesOffset - (uint32)Ar.Tell());
+	Ar.Serialize(Padding.GetData(), Padding.Num());
+	Ar.Serialize(const_cast<uint8*>(Bytes.GetData()), FrozenSize);
+}
+
+FMappedMemoryImage* FMappedMemoryImage::Load(const TCHAR* Filename)
+{
+	SCOPED_LOADTIMER(FMappedMemoryImage_Load);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(Filename));
+	if (!FileHandle)
+	{
+		return nullptr;
+	}
+
+	uint32 Header[4];
+	if (!FileHandle->Read((uint8*)Header, sizeof(Header)))
+	{
+		return nullptr;
+	}
+
+	uint32 Magic = Header[0];
+	uint32 FrozenSize = Header[1];
+	uint32 PatchesSize = Header[2];
+	uint32 BytesOffset = Header[3];
+	if (Magic != MappableMemoryImageMagic || FrozenSize == 0u || BytesOffset < sizeof(Header) + PatchesSize || BytesOffset % FMemoryImageResult::MappableAlignment != 0u
+		|| FileHandle->Size() < (int64)BytesOffset + FrozenSize)
+	{
+		UE_LOG(LogSerialization, Warning, TEXT("'%s' is not a mappable memory image"), Filename);
+		return nullptr;
+	}
+
+	// The relocation table is all that is read, the frozen bytes are only touched where they are patched
+	TArray<uint8> Patches;
+	Patches.SetNumUninitialized(PatchesSize);
+	if (!FileHandle->Read(Patches.GetData(), PatchesSize))
+	{
+		return nullptr;
+	}
+
+	uint32 NumVTables = 0u;
+	uint32 NumNames = 0u;
+	{
+		FMemoryReader PatchesReader(Patches);
+		PatchesReader << NumVTables;
+		PatchesReader << NumNames;
+	}
+	const bool bHasPatches = NumVTables > 0u || NumNames > 0u;
+
+	FMappedMemoryImage* Result = new FMappedMemoryImage();
+	Result->FrozenSize = FrozenSize;
+	Result->MappedFileHandle.Reset(PlatformFile.OpenMapped(Filename));
+	if (Result->MappedFileHandle)
+	{
+		Result->MappedRegion.Reset(bHasPatches
+			? Result->MappedFileHandle->MapRegionCopyOnWrite(BytesOffset, FrozenSize)
+			: Result->MappedFileHandle->MapRegion(BytesOffset, FrozenSize));
+	}
+
+	if (Result->MappedRegion)
+	{
+		// Copy-on-write regions are writable
+		Result->FrozenObject = const_cast<uint8*>(Result->MappedRegion->GetMappedPtr());
+	}
+	else
+	{
+		Result->MappedFileHandle.Reset();
+		Result->FrozenObject = FMemory::Malloc(FrozenSize, FMemoryImageResult::MappableAlignment);
+		if (!FileHandle->Seek(BytesOffset) || !FileHandle->Read((uint8*)Result->FrozenObject, FrozenSize))
+		{
+			delete Result;
+			return nullptr;
+		}
+	}
+	FileHandle.Reset();
+
+	if (bHasPatches)
+	{
+		FMemoryReader PatchesReader(Patches);
+		FMemoryImageResult::ApplyPatchesFromArchive(Result->FrozenObject, PatchesReader);
+	}
+
+	return Result;
+}
+
+FMappedMemoryImage::~FMappedMemoryImage()
+{
+	if (MappedRegion)
+	{
+		// The region must be unmapped before the file is closed
+		MappedRegion.Reset();
+		MappedFileHandle.Reset();
+	}
+	else
+	{
+		FMemory::Free(FrozenObject);
+	}
+}
+
 void FPtrTableBase::SavePatchesToArchive(FArchive& Ar, uint32 PtrIndex) const
 {
 	if (PtrIndex < (uint32)PatchLists.Num())
@@ -1246,7 +1376,7 @@ void FMemoryImage::AddDependency(const FTypeLayoutDesc& TypeDesc)
 	}
 }
 
-void FMemoryImage::Flatten(FMemoryImageResult& OutResult, bool bMergeDuplicateSections)
+void FMemoryImage::Flatten(FMemoryImageResult& OutResult, bool bMergeDuplicateSections, bool bGroupPatchedSections)
 {
 	TArray<FMemoryImageSection*> UniqueSections;
 	UniqueSections.Reserve(Sections.Num());
@@ -1288,10 +1418,29 @@ void FMemoryImage::Flatten(FMemoryImageResult& OutResult, bool bMergeDuplicateSe
 	TArray<uint32> SectionOffset;
 	SectionOffset.SetNum(UniqueSections.Num());
 
-	for (int32 SectionIndex = 0; SectionIndex < UniqueSections.Num(); ++SectionIndex)
+	if (bGroupPatchedSections && UniqueSections.Num() > 0)
 	{
-		const FMemoryImageSection* Section = UniqueSections[SectionIndex];
-		SectionOffset[SectionIndex] = Section->Flatten(OutResult);
+		// The root section stays first, as the frozen object is at the start of the image
+		SectionOffset[0] = UniqueSections[0]->Flatten(OutResult);
+		for (bool bPatched : { true, false })
+		{
+			for (int32 SectionIndex = 1; SectionIndex < UniqueSections.Num(); ++SectionIndex)
+			{
+				const FMemoryImageSection* Section = UniqueSections[SectionIndex];
+				if ((Section->VTables.Num() > 0 || Section->Names.Num() > 0) == bPatched)
+				{
+					SectionOffset[SectionIndex] = Section->Flatten(OutResult);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int32 SectionIndex = 0; SectionIndex < UniqueSections.Num(); ++SectionIndex)
+		{
+			const FMemoryImageSection* Section = UniqueSections[SectionIndex];
+			SectionOffset[SectionIndex] = Section->Flatten(OutResult);
+		}
 	}
 
 	for (int32 SectionIndex = 0; SectionIndex < UniqueSections.Num(); ++SectionIndex)
@@ -3,9 +3,17 @@
 #include "Serialization/StructuredArchive.h"
 #include "Containers/Set.h"
 #include "Containers/UnrealString.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_TEXT_ARCHIVE_SUPPORT
 
+static bool GStructuredArchiveBinaryFastPath = true;
+static FAutoConsoleVariableRef CVarStructuredArchiveBinaryFastPath(
+	TEXT("Serialization.StructuredArchiveBinaryFastPath"),
+	GStructuredArchiveBinaryFastPath,
+	TEXT("If true, structured archives over binary formatters skip scope tracking and call the formatter without virtual dispatch.")
+);
+
 //////////// FStructuredArchive::FContainer ////////////
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -63,8 +71,10 @@ FStructuredArchiveChildReader::~FStructuredArchiveChildReader()
 FStructuredArchive::FStructuredArchive(FArchiveFormatterType& InFormatter)
 	: Formatter(InFormatter)
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
+	, BinaryFormatter(nullptr)
 	, bRequiresStructuralMetadata(true)
 #else
+	, BinaryFormatter(GStructuredArchiveBinaryFastPath ? InFormatter.AsBinaryFormatter() : nullptr)
 	, bRequiresStructuralMetadata(InFormatter.HasDocumentTree())
 #endif
 {
@@ -81,6 +91,11 @@ FStructuredArchive::~FStructuredArchive()
 
 FStructuredArchiveSlot FStructuredArchive::Open()
 {
+	if (BinaryFormatter)
+	{
+		return FStructuredArchiveSlot(*this, 0, UE4StructuredArchive_Private::FElementId());
+	}
+
 	check(CurrentScope.Num() == 0);
 	check(!RootElementId.IsValid());
 	check(!CurrentSlotElementId.IsValid());
@@ -95,6 +110,11 @@ FStructuredArchiveSlot FStructuredArchive::Open()
 
 void FStructuredArchive::Close()
 {
+	if (BinaryFormatter)
+	{
+		return;
+	}
+
 	SetScope(UE4StructuredArchive_Private::FSlotPosition(0, RootElementId));
 }
 
@@ -255,6 +275,12 @@ void FStructuredArchive::SetScope(UE4StructuredArchive_Private::FSlotPosition Sl
 
 FStructuredArchiveRecord FStructuredArchiveSlot::EnterRecord()
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterRecord();
+		return FStructuredArchiveRecord(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Record);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -268,6 +294,12 @@ FStructuredArchiveRecord FStructuredArchiveSlot::EnterRecord()
 
 FStructuredArchiveRecord FStructuredArchiveSlot::EnterRecord_TextOnly(TArray<FString>& OutFieldNames)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterRecord_TextOnly(OutFieldNames);
+		return FStructuredArchiveRecord(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Record);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -281,6 +313,12 @@ FStructuredArchiveRecord FStructuredArchiveSlot::EnterRecord_TextOnly(TArray<FSt
 
 FStructuredArchiveArray FStructuredArchiveSlot::EnterArray(int32& Num)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterArray(Num);
+		return FStructuredArchiveArray(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Array);
 
 	Ar.Formatter.EnterArray(Num);
@@ -294,6 +332,12 @@ FStructuredArchiveArray FStructuredArchiveSlot::EnterArray(int32& Num)
 
 FStructuredArchiveStream FStructuredArchiveSlot::EnterStream()
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterStream();
+		return FStructuredArchiveStream(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Stream);
 
 	Ar.Formatter.EnterStream();
@@ -303,6 +347,12 @@ FStructuredArchiveStream FStructuredArchiveSlot::EnterStream()
 
 FStructuredArchiveStream FStructuredArchiveSlot::EnterStream_TextOnly(int32& OutNumElements)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterStream_TextOnly(OutNumElements);
+		return FStructuredArchiveStream(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Stream);
 
 	Ar.Formatter.EnterStream_TextOnly(OutNumElements);
@@ -312,6 +362,12 @@ FStructuredArchiveStream FStructuredArchiveSlot::EnterStream_TextOnly(int32& Out
 
 FStructuredArchiveMap FStructuredArchiveSlot::EnterMap(int32& Num)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterMap(Num);
+		return FStructuredArchiveMap(Ar, Depth, ElementId);
+	}
+
 	int32 NewDepth = Ar.EnterSlotAsType(*this, UE4StructuredArchive_Private::EElementType::Map);
 
 	Ar.Formatter.EnterMap(Num);
@@ -325,6 +381,12 @@ FStructuredArchiveMap FStructuredArchiveSlot::EnterMap(int32& Num)
 
 FStructuredArchiveSlot FStructuredArchiveSlot::EnterAttribute(FArchiveFieldName AttributeName)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterAttribute(AttributeName);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	check(Ar.CurrentScope.Num() > 0);
 
 	int32 NewDepth = Depth + 1;
@@ -366,6 +428,15 @@ FStructuredArchiveSlot FStructuredArchiveSlot::EnterAttribute(FArchiveFieldName
 
 TOptional<FStructuredArchiveSlot> FStructuredArchiveSlot::TryEnterAttribute(FArchiveFieldName AttributeName, bool bEnterWhenWriting)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		if (BinaryFormatter->TryEnterAttribute(AttributeName, bEnterWhenWriting))
+		{
+			return FStructuredArchiveSlot(Ar, Depth, ElementId);
+		}
+		return {};
+	}
+
 	check(Ar.CurrentScope.Num() > 0);
 
 	int32 NewDepth = Depth + 1;
@@ -412,6 +483,12 @@ TOptional<FStructuredArchiveSlot> FStructuredArchiveSlot::TryEnterAttribute(FArc
 
 void FStructuredArchiveSlot::operator<< (uint8& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -419,6 +496,12 @@ void FStructuredArchiveSlot::operator<< (uint8& Value)
 
 void FStructuredArchiveSlot::operator<< (uint16& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -426,6 +509,12 @@ void FStructuredArchiveSlot::operator<< (uint16& Value)
 
 void FStructuredArchiveSlot::operator<< (uint32& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -433,6 +522,12 @@ void FStructuredArchiveSlot::operator<< (uint32& Value)
 
 void FStructuredArchiveSlot::operator<< (uint64& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -440,6 +535,12 @@ void FStructuredArchiveSlot::operator<< (uint64& Value)
 
 void FStructuredArchiveSlot::operator<< (int8& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -447,6 +548,12 @@ void FStructuredArchiveSlot::operator<< (int8& Value)
 
 void FStructuredArchiveSlot::operator<< (int16& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -454,6 +561,12 @@ void FStructuredArchiveSlot::operator<< (int16& Value)
 
 void FStructuredArchiveSlot::operator<< (int32& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -461,6 +574,12 @@ void FStructuredArchiveSlot::operator<< (int32& Value)
 
 void FStructuredArchiveSlot::operator<< (int64& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -468,6 +587,12 @@ void FStructuredArchiveSlot::operator<< (int64& Value)
 
 void FStructuredArchiveSlot::operator<< (float& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -475,6 +600,12 @@ void FStructuredArchiveSlot::operator<< (float& Value)
 
 void FStructuredArchiveSlot::operator<< (double& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -482,6 +613,12 @@ void FStructuredArchiveSlot::operator<< (double& Value)
 
 void FStructuredArchiveSlot::operator<< (bool& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -489,6 +626,12 @@ void FStructuredArchiveSlot::operator<< (bool& Value)
 
 void FStructuredArchiveSlot::operator<< (FString& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -496,6 +639,12 @@ void FStructuredArchiveSlot::operator<< (FString& Value)
 
 void FStructuredArchiveSlot::operator<< (FName& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -503,6 +652,12 @@ void FStructuredArchiveSlot::operator<< (FName& Value)
 
 void FStructuredArchiveSlot::operator<< (UObject*& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -510,6 +665,12 @@ void FStructuredArchiveSlot::operator<< (UObject*& Value)
 
 void FStructuredArchiveSlot::operator<< (FText& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -517,6 +678,12 @@ void FStructuredArchiveSlot::operator<< (FText& Value)
 
 void FStructuredArchiveSlot::operator<< (FWeakObjectPtr& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -524,6 +691,12 @@ void FStructuredArchiveSlot::operator<< (FWeakObjectPtr& Value)
 
 void FStructuredArchiveSlot::operator<< (FLazyObjectPtr& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -531,6 +704,12 @@ void FStructuredArchiveSlot::operator<< (FLazyObjectPtr& Value)
 
 void FStructuredArchiveSlot::operator<< (FSoftObjectPtr& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -538,6 +717,12 @@ void FStructuredArchiveSlot::operator<< (FSoftObjectPtr& Value)
 
 void FStructuredArchiveSlot::operator<< (FSoftObjectPath& Value)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Value);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Value);
 	Ar.LeaveSlot();
@@ -545,6 +730,12 @@ void FStructuredArchiveSlot::operator<< (FSoftObjectPath& Value)
 
 void FStructuredArchiveSlot::Serialize(TArray<uint8>& Data)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Data);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Data);
 	Ar.LeaveSlot();
@@ -552,6 +743,12 @@ void FStructuredArchiveSlot::Serialize(TArray<uint8>& Data)
 
 void FStructuredArchiveSlot::Serialize(void* Data, uint64 DataSize)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->Serialize(Data, DataSize);
+		return;
+	}
+
 	Ar.EnterSlot(*this);
 	Ar.Formatter.Serialize(Data, DataSize);
 	Ar.LeaveSlot();
@@ -561,6 +758,12 @@ void FStructuredArchiveSlot::Serialize(void* Data, uint64 DataSize)
 
 FStructuredArchiveSlot FStructuredArchiveRecord::EnterField(FArchiveFieldName Name)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterField(Name);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 	Ar.CurrentSlotElementId = Ar.ElementIdGenerator.Generate();
@@ -613,6 +816,15 @@ FStructuredArchiveMap FStructuredArchiveRecord::EnterMap(FArchiveFieldName Name,
 
 TOptional<FStructuredArchiveSlot> FStructuredArchiveRecord::TryEnterField(FArchiveFieldName Name, bool bEnterWhenWriting)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		if (BinaryFormatter->TryEnterField(Name, bEnterWhenWriting))
+		{
+			return FStructuredArchiveSlot(Ar, Depth, ElementId);
+		}
+		return {};
+	}
+
 	Ar.SetScope(*this);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -641,6 +853,12 @@ TOptional<FStructuredArchiveSlot> FStructuredArchiveRecord::TryEnterField(FArchi
 
 FStructuredArchiveSlot FStructuredArchiveArray::EnterElement()
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterArrayElement();
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -656,6 +874,12 @@ FStructuredArchiveSlot FStructuredArchiveArray::EnterElement()
 
 FStructuredArchiveSlot FStructuredArchiveArray::EnterElement_TextOnly(EArchiveValueType& OutType)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterArrayElement_TextOnly(OutType);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -673,6 +897,12 @@ FStructuredArchiveSlot FStructuredArchiveArray::EnterElement_TextOnly(EArchiveVa
 
 FStructuredArchiveSlot FStructuredArchiveStream::EnterElement()
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterStreamElement();
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 	Ar.CurrentSlotElementId = Ar.ElementIdGenerator.Generate();
@@ -684,6 +914,12 @@ FStructuredArchiveSlot FStructuredArchiveStream::EnterElement()
 
 FStructuredArchiveSlot FStructuredArchiveStream::EnterElement_TextOnly(EArchiveValueType& OutType)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterStreamElement_TextOnly(OutType);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 	Ar.CurrentSlotElementId = Ar.ElementIdGenerator.Generate();
@@ -697,6 +933,12 @@ FStructuredArchiveSlot FStructuredArchiveStream::EnterElement_TextOnly(EArchiveV
 
 FStructuredArchiveSlot FStructuredArchiveMap::EnterElement(FString& Name)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterMapElement(Name);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
@@ -734,6 +976,12 @@ FStructuredArchiveSlot FStructuredArchiveMap::EnterElement(FString& Name)
 
 FStructuredArchiveSlot FStructuredArchiveMap::EnterElement_TextOnly(FString& Name, EArchiveValueType& OutType)
 {
+	if (FBinaryArchiveFormatter* BinaryFormatter = Ar.BinaryFormatter)
+	{
+		BinaryFormatter->EnterMapElement_TextOnly(Name, OutType);
+		return FStructuredArchiveSlot(Ar, Depth, ElementId);
+	}
+
 	Ar.SetScope(*this);
 
 #if DO_STRUCTURED_ARCHIVE_CONTAINER_CHECKS
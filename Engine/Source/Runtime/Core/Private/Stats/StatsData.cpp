@@ -8,6 +8,7 @@
 #include "Containers/LockFreeFixedSizeAllocator.h"
 #include "HAL/IConsoleManager.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Async/ParallelFor.h"
 
 DECLARE_CYCLE_STAT(TEXT("Broadcast"),STAT_StatsBroadcast,STATGROUP_StatSystem);
 DECLARE_CYCLE_STAT(TEXT("Condense"),STAT_StatsCondense,STATGROUP_StatSystem);
@@ -811,47 +812,72 @@ void FStatsThreadState::ToggleFindMemoryExtensiveStats()
 	UE_LOG(LogStats, Log, TEXT("bFindMemoryExtensiveStats is %s now"), bFindMemoryExtensiveStats?TEXT("enabled"):TEXT("disabled"));
 }
 
-void FStatsThreadState::ProcessNonFrameStats(FStatMessagesArray& Data, TSet<FName>* NonFrameStatsFound)
+static int32 GStatsParallelNonFrameScan = 1;
+static FAutoConsoleVariableRef CVarStatsParallelNonFrameScan(
+	TEXT("stats.ParallelNonFrameScan"),
+	GStatsParallelNonFrameScan,
+	TEXT("If set to 1, the packets of a finished frame are scanned for non-frame stats on the task threads. The stats found are still accumulated in packet order.")
+	);
+
+void FStatsThreadState::FindNonFrameStats(const FStatMessagesArray& Data, TArray<int32>& OutNonFrameIndices)
 {
-	for (FStatMessage& Item : Data)
+	int32 Index = 0;
+	for (const FStatMessage& Item : Data)
 	{
 		check(Item.NameAndInfo.GetFlag(EStatMetaFlags::DummyAlwaysOne));  // we should never be sending short names to the stats any more
-		EStatOperation::Type Op = Item.NameAndInfo.GetField<EStatOperation>();
-		check(Op != EStatOperation::SetLongName);
+		check(Item.NameAndInfo.GetField<EStatOperation>() != EStatOperation::SetLongName);
 		if (!Item.NameAndInfo.GetFlag(EStatMetaFlags::ShouldClearEveryFrame))
 		{
-			if (!(
-				Op != EStatOperation::CycleScopeStart && 
-				Op != EStatOperation::CycleScopeEnd &&
-				Op != EStatOperation::ChildrenStart &&
-				Op != EStatOperation::ChildrenEnd &&
-				Op != EStatOperation::Leaf &&
-				Op != EStatOperation::AdvanceFrameEventGameThread &&
-				Op != EStatOperation::AdvanceFrameEventRenderThread
-				))
-			{
-				UE_LOG(LogStats, Fatal, TEXT( "Stat %s was not cleared every frame, but was used with a scope cycle counter." ), *Item.NameAndInfo.GetRawName().ToString() );
-			}
-			else
+			OutNonFrameIndices.Add(Index);
+		}
+		++Index;
+	}
+}
+
+void FStatsThreadState::ProcessNonFrameStats(FStatMessagesArray& Data, TSet<FName>* NonFrameStatsFound)
+{
+	TArray<int32> NonFrameIndices;
+	FindNonFrameStats(Data, NonFrameIndices);
+	ProcessNonFrameStats(Data, NonFrameIndices, NonFrameStatsFound);
+}
+
+void FStatsThreadState::ProcessNonFrameStats(FStatMessagesArray& Data, const TArray<int32>& NonFrameIndices, TSet<FName>* NonFrameStatsFound)
+{
+	for (int32 Index : NonFrameIndices)
+	{
+		FStatMessage& Item = Data[Index];
+		EStatOperation::Type Op = Item.NameAndInfo.GetField<EStatOperation>();
+		if (!(
+			Op != EStatOperation::CycleScopeStart && 
+			Op != EStatOperation::CycleScopeEnd &&
+			Op != EStatOperation::ChildrenStart &&
+			Op != EStatOperation::ChildrenEnd &&
+			Op != EStatOperation::Leaf &&
+			Op != EStatOperation::AdvanceFrameEventGameThread &&
+			Op != EStatOperation::AdvanceFrameEventRenderThread
+			))
+		{
+			UE_LOG(LogStats, Fatal, TEXT( "Stat %s was not cleared every frame, but was used with a scope cycle counter." ), *Item.NameAndInfo.GetRawName().ToString() );
+		}
+		else
+		{
+			// Ignore any memory or special messages, they shouldn't be treated as regular stats messages.
+			if( Op != EStatOperation::Memory && Op != EStatOperation::SpecialMessageMarker )
 			{
-				// Ignore any memory or special messages, they shouldn't be treated as regular stats messages.
-				if( Op != EStatOperation::Memory && Op != EStatOperation::SpecialMessageMarker )
+				FStatMessage* Result = NotClearedEveryFrame.Find(Item.NameAndInfo.GetRawName());
+				if (!Result)
 				{
-					FStatMessage* Result = NotClearedEveryFrame.Find(Item.NameAndInfo.GetRawName());
-					if (!Result)
-					{
-						UE_LOG(LogStats, Error, TEXT( "Stat %s was cleared every frame, but we don't have metadata for it. Data loss." ), *Item.NameAndInfo.GetRawName().ToString() );
-					}
-					else
+					UE_LOG(LogStats, Error, TEXT( "Stat %s was cleared every frame, but we don't have metadata for it. Data loss." ), *Item.NameAndInfo.GetRawName().ToString() );
+				}
+				else
+				{
+					if (NonFrameStatsFound)
 					{
-						if (NonFrameStatsFound)
-						{
-							NonFrameStatsFound->Add(Item.NameAndInfo.GetRawName());
-						}
-						FStatsUtils::AccumulateStat(*Result, Item);
-						Item = *Result; // now just write the accumulated value back into the stream
-						check(Item.NameAndInfo.GetField<EStatOperation>() == EStatOperation::Set);
+						NonFrameStatsFound->Add(Item.NameAndInfo.GetRawName());
 					}
+					FStatsUtils::AccumulateStat(*Result, Item);
+					Item = *Result; // now just write the accumulated value back into the stream
+					check(Item.NameAndInfo.GetField<EStatOperation>() == EStatOperation::Set);
 				}
 			}
 		}
@@ -914,10 +940,20 @@ void FStatsThreadState::AddToHistoryAndEmpty(FStatPacketArray& NewData)
 				FindAndDumpMemoryExtensiveStats(Frame);
 			}
 
+			// Almost all messages are cleared every frame, so the scan for the few that are not is the bulk of the work
+			// and goes wide. Accumulating them depends on the order of the packets and stays on this thread.
+			TArray<TArray<int32>> NonFrameIndices;
+			NonFrameIndices.SetNum(Frame.Packets.Num());
+			ParallelFor(Frame.Packets.Num(), [&Frame, &NonFrameIndices](int32 PacketIndex)
+			{
+				FindNonFrameStats(Frame.Packets[PacketIndex]->StatMessages, NonFrameIndices[PacketIndex]);
+			}, !GStatsParallelNonFrameScan || Frame.Packets.Num() < 2);
+
 			TSet<FName> NonFrameStatsFound;
-			for (FStatPacket* Packet : Frame.Packets)
+			for (int32 PacketIndex = 0; PacketIndex < Frame.Packets.Num(); ++PacketIndex)
 			{
-				ProcessNonFrameStats(Packet->StatMessages, &NonFrameStatsFound);
+				FStatPacket* Packet = Frame.Packets[PacketIndex];
+				ProcessNonFrameStats(Packet->StatMessages, NonFrameIndices[PacketIndex], &NonFrameStatsFound);
 				if (!PacketToCopyForNonFrame && Packet->ThreadType == EThreadType::Game)
 				{
 					PacketToCopyForNonFrame = Packet;
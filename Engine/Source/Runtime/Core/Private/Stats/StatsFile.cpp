@@ -15,10 +15,19 @@
 #if	STATS
 
 #include "Misc/ScopeExit.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
 
 DECLARE_CYCLE_STAT( TEXT( "Stream File" ), STAT_StreamFile, STATGROUP_StatSystem );
 DECLARE_CYCLE_STAT( TEXT( "Wait For Write" ), STAT_StreamFileWaitForWrite, STATGROUP_StatSystem );
 
+static int32 GStatsFileFrameTableCheckpointInterval = 300;
+static FAutoConsoleVariableRef CVarStatsFileFrameTableCheckpointInterval(
+	TEXT( "stats.FileFrameTableCheckpointInterval" ),
+	GStatsFileFrameTableCheckpointInterval,
+	TEXT( "Number of frames between frame table checkpoints in regular stats files, which let files that were not finalized be read up to the last one. 0 disables them." )
+	);
+
 #define LOCTEXT_NAMESPACE "StatsFile"
 
 /*-----------------------------------------------------------------------------
@@ -412,6 +421,36 @@ void FStatsWriteFile::WriteFrame( int64 TargetFrame )
 		ThreadCycles.Add( It.Key, Cycles );
 	}
 
+	// The FNames and metadata seen so far go into the checkpoint, the async write thread adds the frames table.
+	if (GStatsFileFrameTableCheckpointInterval > 0 && ++NumFramesSinceCheckpoint >= GStatsFileFrameTableCheckpointInterval)
+	{
+		NumFramesSinceCheckpoint = 0;
+
+		TSet<FNameEntryId> CheckpointFNames = FNamesSent;
+		for (const auto& It : Stats.ShortNameToLongName)
+		{
+			CheckpointFNames.Add( It.Value.NameAndInfo.GetRawName().GetComparisonIndex() );
+		}
+
+		// Send every FName with its string, so the checkpoint does not depend on the frames that sent them first.
+		TSet<FNameEntryId> FramesFNamesSent = MoveTemp( FNamesSent );
+		FNamesSent.Reset();
+
+		CheckpointData.Reset();
+		FMemoryWriter CheckpointAr( CheckpointData );
+		uint64 NumFNames = CheckpointFNames.Num();
+		CheckpointAr << NumFNames;
+		for (FNameEntryId Id : CheckpointFNames)
+		{
+			WriteFName( CheckpointAr, FStatNameAndInfo( FName( Id, Id, 0 ), false ) );
+		}
+		uint64 NumMetadataMessages = Stats.ShortNameToLongName.Num();
+		CheckpointAr << NumMetadataMessages;
+		WriteMetadata( CheckpointAr );
+
+		FNamesSent = MoveTemp( FramesFNamesSent );
+	}
+
 	SendTask();
 }
 
@@ -419,6 +458,43 @@ void FStatsWriteFile::FinalizeSavingData( int64 FrameFileOffset )
 {
 	// Called from the async write thread.
 	FramesInfo.Add( FStatsFrameInfo( FrameFileOffset, ThreadCycles ) );
+
+	if (CheckpointData.Num())
+	{
+		WriteFrameTableCheckpoint( *File );
+	}
+}
+
+void FStatsWriteFile::WriteFrameTableCheckpoint( FArchive& Ar )
+{
+	const int64 CheckpointOffset = Ar.Tell();
+
+	// The size is patched once the checkpoint is written.
+	int32 Marker = EStatsFileConstants::FRAME_TABLE_CHECKPOINT;
+	int32 CheckpointSize = 0;
+	Ar << Marker << CheckpointSize;
+	const int64 CheckpointStart = Ar.Tell();
+
+	uint64 PreviousCheckpointOffset = Header.FrameTableCheckpointOffset;
+	Ar << PreviousCheckpointOffset;
+	TArray<FStatsFrameInfo> NewFramesInfo( FramesInfo.GetData() + FirstFrameSinceCheckpoint, FramesInfo.Num() - FirstFrameSinceCheckpoint );
+	Ar << NewFramesInfo;
+	Ar.Serialize( CheckpointData.GetData(), CheckpointData.Num() );
+	CheckpointData.Reset();
+	FirstFrameSinceCheckpoint = FramesInfo.Num();
+
+	const int64 CheckpointEnd = Ar.Tell();
+	CheckpointSize = int32( CheckpointEnd - CheckpointStart );
+	Ar.Seek( CheckpointOffset + sizeof( int32 ) );
+	Ar << CheckpointSize;
+
+	// Point the header at the new checkpoint, the header has a fixed size.
+	Header.FrameTableCheckpointOffset = CheckpointOffset;
+	Ar.Seek( sizeof( uint32 ) );
+	Ar << Header;
+
+	Ar.Seek( CheckpointEnd );
+	Ar.Flush();
 }
 
 /*-----------------------------------------------------------------------------
@@ -587,7 +663,7 @@ bool FStatsReadFile::PrepareLoading()
 		}
 
 		const bool bIsFinalized = Stream.Header.IsFinalized();
-		if (!bIsFinalized)
+		if (!bIsFinalized && !Stream.Header.HasFrameTableCheckpoint())
 		{
 			UE_LOG( LogStats, Error, TEXT( "Could not read, file is not finalized: %s" ), *Filename );
 			bResult = false;
@@ -610,9 +686,23 @@ bool FStatsReadFile::PrepareLoading()
 		}
 	}
 
-	// Read metadata.
+	// Read metadata and frames offsets, from the last frame table checkpoint if the file was not finalized.
 	TArray<FStatMessage> MetadataMessages;
-	Stream.ReadFNamesAndMetadataMessages( *Reader, MetadataMessages );
+	if (Stream.Header.IsFinalized())
+	{
+		Stream.ReadFNamesAndMetadataMessages( *Reader, MetadataMessages );
+		Stream.ReadFramesOffsets( *Reader );
+	}
+	else if (Stream.ReadFrameTableCheckpoints( *Reader, MetadataMessages ))
+	{
+		UE_LOG( LogStats, Warning, TEXT( "File is not finalized, reading the %d frames up to its last frame table checkpoint: %s" ), Stream.FramesInfo.Num(), *Filename );
+	}
+	else
+	{
+		UE_LOG( LogStats, Error, TEXT( "Could not read, frame table checkpoint is invalid: %s" ), *Filename );
+		SetProcessingStage( EStatsProcessingStage::SPS_Invalid );
+		return false;
+	}
 	State.ProcessMetaDataOnly( MetadataMessages );
 
 	// Find all UObject metadata messages.
@@ -628,9 +718,6 @@ bool FStatsReadFile::PrepareLoading()
 		}
 	}
 
-	// Read frames offsets.
-	Stream.ReadFramesOffsets( *Reader );
-
 	// Move file pointer to the first frame or first stat packet.
 	if (Stream.FramesInfo.Num() > 0)
 	{
@@ -788,11 +875,12 @@ void FStatsReadFile::ReadRegularStats()
 	TArray<uint8> DestArray;
 
 	const bool bHasCompressedData = Stream.Header.HasCompressedData();
-	const bool bIsFinalized = Stream.Header.IsFinalized();
+	// Finalized files have all FNames at the end, the others in their last frame table checkpoint.
+	const bool bHasFNameMap = Stream.Header.IsFinalized() || Stream.Header.HasFrameTableCheckpoint();
 
 	// Sanity checks.
 	check( bHasCompressedData );
-	check( bIsFinalized );
+	check( bHasFNameMap );
 
 	// Update stage progress once per NumSecondsBetweenUpdates(2) seconds to avoid spamming.
 	SetProcessingStage( EStatsProcessingStage::SPS_ReadStats );
@@ -817,7 +905,7 @@ void FStatsReadFile::ReadRegularStats()
 		while (MemoryReader.Tell() < MemoryReader.TotalSize())
 		{
 			// Read the message.
-			FStatMessage Message( Stream.ReadMessage( MemoryReader, bIsFinalized ) );
+			FStatMessage Message( Stream.ReadMessage( MemoryReader, bHasFNameMap ) );
 			new (PendingMessages)FStatMessage( Message );
 		}
 
@@ -844,6 +932,72 @@ void FStatsReadFile::ReadRegularStats()
 	}
 }
 
+bool FStatsReadFile::ReadFrameRange( int32 FirstFrameIndex, int32 NumFramesToRead, TArray<TArray<FStatMessage>>& OutFrameMessages )
+{
+	OutFrameMessages.Reset();
+	if (bRawStatsFile || IsBusy() || FirstFrameIndex < 0 || NumFramesToRead < 0 || FirstFrameIndex + NumFramesToRead > Stream.FramesInfo.Num())
+	{
+		return false;
+	}
+
+	struct FCompressedFrame
+	{
+		int32 CompressedSize = 0;
+		int32 UncompressedSize = 0;
+		TArray<uint8> Data;
+	};
+
+	// There is only one file reader, so read the compressed frames in order first.
+	TArray<FCompressedFrame> CompressedFrames;
+	CompressedFrames.SetNum( NumFramesToRead );
+	for (int32 Index = 0; Index < NumFramesToRead; ++Index)
+	{
+		FCompressedFrame& Frame = CompressedFrames[Index];
+		Reader->Seek( Stream.FramesInfo[FirstFrameIndex + Index].FrameFileOffset );
+		*Reader << Frame.CompressedSize << Frame.UncompressedSize;
+
+		const int32 DataSize = Frame.CompressedSize == EStatsFileConstants::NO_COMPRESSION ? Frame.UncompressedSize : Frame.CompressedSize;
+		if (Reader->IsError() || DataSize < 0 || Frame.UncompressedSize < 0)
+		{
+			return false;
+		}
+		Frame.Data.AddUninitialized( DataSize );
+		Reader->Serialize( Frame.Data.GetData(), DataSize );
+	}
+	if (Reader->IsError())
+	{
+		return false;
+	}
+
+	// Each frame is compressed on its own and the FNames map is complete, so frames decode independently.
+	// ReadMessage only reads the map when it is complete, which is safe from many threads.
+	OutFrameMessages.SetNum( NumFramesToRead );
+	ParallelFor( NumFramesToRead, [this, &CompressedFrames, &OutFrameMessages]( int32 Index )
+	{
+		FCompressedFrame& Frame = CompressedFrames[Index];
+		TArray<uint8> UncompressedData;
+		if (Frame.CompressedSize == EStatsFileConstants::NO_COMPRESSION)
+		{
+			UncompressedData = MoveTemp( Frame.Data );
+		}
+		else
+		{
+			UncompressedData.AddUninitialized( Frame.UncompressedSize );
+			const bool bResult = FCompression::UncompressMemory( NAME_Zlib, UncompressedData.GetData(), Frame.UncompressedSize, Frame.Data.GetData(), Frame.CompressedSize );
+			check( bResult );
+		}
+
+		FMemoryReader MemoryReader( UncompressedData, true );
+		TArray<FStatMessage>& Messages = OutFrameMessages[Index];
+		while (MemoryReader.Tell() < MemoryReader.TotalSize())
+		{
+			new (Messages)FStatMessage( Stream.ReadMessage( MemoryReader, true ) );
+		}
+	} );
+
+	return true;
+}
+
 void FStatsReadFile::PreProcessStats()
 {
 	if (!IsProcessingStopped())
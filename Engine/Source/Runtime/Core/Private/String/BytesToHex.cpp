@@ -3,6 +3,7 @@
 #include "String/BytesToHex.h"
 
 #include "Misc/StringBuilder.h"
+#include "String/VectorizedAscii.h"
 
 namespace UE
 {
@@ -13,8 +14,32 @@ namespace String
 	{
 		auto NibbleToHex = [](uint8 Value) -> CharType { return Value + (Value > 9 ? 'A' - 10 : '0'); };
 		const uint8* Data = Bytes.GetData();
-		
-		for (const uint8* DataEnd = Data + Bytes.Num(); Data != DataEnd; ++Data)
+		const uint8* DataEnd = Data + Bytes.Num();
+
+#if UE_VECTORIZED_ASCII
+		// Convert 16 bytes to 32 digits at a time
+		for (; DataEnd - Data >= 16; Data += 16, OutHex += 32)
+		{
+			using namespace UE4VectorizedAscii_Private;
+#if UE_VECTORIZED_ASCII_SSE2
+			const __m128i Block = _mm_loadu_si128((const __m128i*)Data);
+			const __m128i NibbleMask = _mm_set1_epi8(15);
+			const __m128i High = _mm_and_si128(_mm_srli_epi16(Block, 4), NibbleMask);
+			const __m128i Low = _mm_and_si128(Block, NibbleMask);
+			auto NibblesToHex = [](__m128i Nibbles) { return _mm_add_epi8(Nibbles, _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(_mm_cmpgt_epi8(Nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('A' - 10 - '0')))); };
+			StoreChars(OutHex, NibblesToHex(_mm_unpacklo_epi8(High, Low)));
+			StoreChars(OutHex + 16, NibblesToHex(_mm_unpackhi_epi8(High, Low)));
+#else
+			const uint8x16_t Block = vld1q_u8(Data);
+			const uint8x16x2_t Nibbles = vzipq_u8(vshrq_n_u8(Block, 4), vandq_u8(Block, vdupq_n_u8(15)));
+			auto NibblesToHex = [](uint8x16_t Values) { return vaddq_u8(Values, vaddq_u8(vdupq_n_u8('0'), vandq_u8(vcgtq_u8(Values, vdupq_n_u8(9)), vdupq_n_u8('A' - 10 - '0')))); };
+			StoreChars(OutHex, NibblesToHex(Nibbles.val[0]));
+			StoreChars(OutHex + 16, NibblesToHex(Nibbles.val[1]));
+#endif
+		}
+#endif
+
+		for (; Data != DataEnd; ++Data)
 		{
 			*OutHex++ = NibbleToHex(*Data >> 4);
 			*OutHex++ = NibbleToHex(*Data & 15);
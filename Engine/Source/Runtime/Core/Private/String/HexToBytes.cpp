@@ -4,6 +4,7 @@
 
 #include "Containers/StringView.h"
 #include "Containers/UnrealString.h"
+#include "String/VectorizedAscii.h"
 
 namespace UE
 {
@@ -20,6 +21,48 @@ namespace String
 		{
 			*OutPos++ = TCharToNibble(*HexPos++);
 		}
+
+#if UE_VECTORIZED_ASCII
+		// Convert 32 digits to 16 bytes at a time, blocks holding anything else go through TCharToNibble below
+		for (; HexEnd - HexPos >= 32; HexPos += 32, OutPos += 16)
+		{
+			using namespace UE4VectorizedAscii_Private;
+			const FByteVector First = LoadChars(HexPos);
+			const FByteVector Second = LoadChars(HexPos + 16);
+			const FByteVector FirstIsDigit = InRange(First, '0', '9'), FirstIsUpper = InRange(First, 'A', 'F'), FirstIsLower = InRange(First, 'a', 'f');
+			const FByteVector SecondIsDigit = InRange(Second, '0', '9'), SecondIsUpper = InRange(Second, 'A', 'F'), SecondIsLower = InRange(Second, 'a', 'f');
+#if UE_VECTORIZED_ASCII_SSE2
+			if (!AllSet(_mm_and_si128(_mm_or_si128(_mm_or_si128(FirstIsDigit, FirstIsUpper), FirstIsLower), _mm_or_si128(_mm_or_si128(SecondIsDigit, SecondIsUpper), SecondIsLower))))
+			{
+				break;
+			}
+
+			auto ToNibbles = [](__m128i Chars, __m128i IsDigit, __m128i IsUpper, __m128i IsLower)
+			{
+				const __m128i Offsets = _mm_or_si128(_mm_or_si128(_mm_and_si128(IsDigit, _mm_set1_epi8(char(0 - '0'))), _mm_and_si128(IsUpper, _mm_set1_epi8(char(10 - 'A')))), _mm_and_si128(IsLower, _mm_set1_epi8(char(10 - 'a'))));
+				const __m128i Nibbles = _mm_add_epi8(Chars, Offsets);
+				// Each 16 bit lane holds the high nibble then the low nibble
+				return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(Nibbles, 4), _mm_set1_epi16(0xF0)), _mm_srli_epi16(Nibbles, 8));
+			};
+			_mm_storeu_si128((__m128i*)OutPos, _mm_packus_epi16(ToNibbles(First, FirstIsDigit, FirstIsUpper, FirstIsLower), ToNibbles(Second, SecondIsDigit, SecondIsUpper, SecondIsLower)));
+#else
+			if (!AllSet(vandq_u8(vorrq_u8(vorrq_u8(FirstIsDigit, FirstIsUpper), FirstIsLower), vorrq_u8(vorrq_u8(SecondIsDigit, SecondIsUpper), SecondIsLower))))
+			{
+				break;
+			}
+
+			auto ToNibbles = [](uint8x16_t Chars, uint8x16_t IsDigit, uint8x16_t IsUpper, uint8x16_t IsLower)
+			{
+				const uint8x16_t Offsets = vorrq_u8(vorrq_u8(vandq_u8(IsDigit, vdupq_n_u8(uint8(0 - '0'))), vandq_u8(IsUpper, vdupq_n_u8(uint8(10 - 'A')))), vandq_u8(IsLower, vdupq_n_u8(uint8(10 - 'a'))));
+				return vaddq_u8(Chars, Offsets);
+			};
+			// Even digits are the high nibbles and odd digits the low ones
+			const uint8x16x2_t Nibbles = vuzpq_u8(ToNibbles(First, FirstIsDigit, FirstIsUpper, FirstIsLower), ToNibbles(Second, SecondIsDigit, SecondIsUpper, SecondIsLower));
+			vst1q_u8(OutPos, vorrq_u8(vshlq_n_u8(Nibbles.val[0], 4), Nibbles.val[1]));
+#endif
+		}
+#endif
+
 		while (HexPos != HexEnd)
 		{
 			const uint8 HiNibble = uint8(TCharToNibble(*HexPos++) << 4);
@@ -5,65 +5,68 @@
 #include "Containers/StringView.h"
 #include "Containers/UnrealString.h"
 #include "Misc/StringBuilder.h"
+#include "String/NumberConversion.h"
+
+namespace UE4LexFromString_Private
+{
+	/** Skips leading whitespace and reads zero when there is no number, like the CRT functions the TCHAR* overloads use */
+	template <typename ParseType, typename ValueType>
+	static void ParseNumberOrZero(ValueType& OutValue, const FStringView& InString)
+	{
+		ParseType Value = 0;
+		UE::String::ParseNumber(InString.TrimStart(), Value);
+		OutValue = ValueType(Value);
+	}
+}
 
 void LexFromString(int8& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(int16& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(int32& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(int64& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(uint8& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(uint16& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(uint32& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<int64>(OutValue, InString);
 }
 
 void LexFromString(uint64& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<uint64>(OutValue, InString);
 }
 
 void LexFromString(float& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<float>(OutValue, InString);
 }
 
 void LexFromString(double& OutValue, const FStringView& InString)
 {
-	TStringBuilder<64> Builder;
-	LexFromString(OutValue, (Builder << InString).ToString());
+	UE4LexFromString_Private::ParseNumberOrZero<double>(OutValue, InString);
 }
 
 void LexFromString(bool& OutValue, const FStringView& InString)
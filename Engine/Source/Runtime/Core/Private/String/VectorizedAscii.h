@@ -0,0 +1,293 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/PlatformMath.h"
+#include "HAL/UnrealMemory.h"
+
+/**
+ * 16 byte vector helpers shared by the Base64 and hex codecs, which only ever read and write ASCII characters, and
+ * the case insensitive compares and case conversions, which only change the case of ASCII letters.
+ * They stick to SSE2 and NEON as those are always available where vector intrinsics are enabled.
+ */
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_VECTORIZED_ASCII_SSE2 1
+	#define UE_VECTORIZED_ASCII_NEON 0
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#define UE_VECTORIZED_ASCII_SSE2 0
+	#define UE_VECTORIZED_ASCII_NEON 1
+	#include <arm_neon.h>
+#else
+	#define UE_VECTORIZED_ASCII_SSE2 0
+	#define UE_VECTORIZED_ASCII_NEON 0
+#endif
+
+#define UE_VECTORIZED_ASCII (UE_VECTORIZED_ASCII_SSE2 || UE_VECTORIZED_ASCII_NEON)
+
+#if UE_VECTORIZED_ASCII
+
+namespace UE4VectorizedAscii_Private
+{
+#if UE_VECTORIZED_ASCII_SSE2
+	using FByteVector = __m128i;
+#else
+	using FByteVector = uint8x16_t;
+#endif
+
+	/** Loads 16 characters as bytes, characters above 255 become 0 or 255 which no codec accepts */
+	template <typename CharType>
+	FORCEINLINE FByteVector LoadChars(const CharType* Source)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		const __m128i* Blocks = (const __m128i*)Source;
+		if (sizeof(CharType) == 1)
+		{
+			return _mm_loadu_si128(Blocks);
+		}
+		else if (sizeof(CharType) == 2)
+		{
+			return _mm_packus_epi16(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1));
+		}
+		else
+		{
+			const __m128i Low = _mm_packs_epi32(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1));
+			const __m128i High = _mm_packs_epi32(_mm_loadu_si128(Blocks + 2), _mm_loadu_si128(Blocks + 3));
+			return _mm_packus_epi16(Low, High);
+		}
+#else
+		if (sizeof(CharType) == 1)
+		{
+			return vld1q_u8((const uint8*)Source);
+		}
+		else if (sizeof(CharType) == 2)
+		{
+			const uint16* Blocks = (const uint16*)Source;
+			return vcombine_u8(vqmovn_u16(vld1q_u16(Blocks)), vqmovn_u16(vld1q_u16(Blocks + 8)));
+		}
+		else
+		{
+			const uint32* Blocks = (const uint32*)Source;
+			const uint16x8_t Low = vcombine_u16(vqmovn_u32(vld1q_u32(Blocks)), vqmovn_u32(vld1q_u32(Blocks + 4)));
+			const uint16x8_t High = vcombine_u16(vqmovn_u32(vld1q_u32(Blocks + 8)), vqmovn_u32(vld1q_u32(Blocks + 12)));
+			return vcombine_u8(vqmovn_u16(Low), vqmovn_u16(High));
+		}
+#endif
+	}
+
+	/** Stores 16 ASCII bytes as characters */
+	template <typename CharType>
+	FORCEINLINE void StoreChars(CharType* Dest, FByteVector Chars)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		__m128i* Blocks = (__m128i*)Dest;
+		if (sizeof(CharType) == 1)
+		{
+			_mm_storeu_si128(Blocks, Chars);
+		}
+		else
+		{
+			const __m128i Zero = _mm_setzero_si128();
+			const __m128i Low = _mm_unpacklo_epi8(Chars, Zero);
+			const __m128i High = _mm_unpackhi_epi8(Chars, Zero);
+			if (sizeof(CharType) == 2)
+			{
+				_mm_storeu_si128(Blocks, Low);
+				_mm_storeu_si128(Blocks + 1, High);
+			}
+			else
+			{
+				_mm_storeu_si128(Blocks, _mm_unpacklo_epi16(Low, Zero));
+				_mm_storeu_si128(Blocks + 1, _mm_unpackhi_epi16(Low, Zero));
+				_mm_storeu_si128(Blocks + 2, _mm_unpacklo_epi16(High, Zero));
+				_mm_storeu_si128(Blocks + 3, _mm_unpackhi_epi16(High, Zero));
+			}
+		}
+#else
+		if (sizeof(CharType) == 1)
+		{
+			vst1q_u8((uint8*)Dest, Chars);
+		}
+		else
+		{
+			const uint16x8_t Low = vmovl_u8(vget_low_u8(Chars));
+			const uint16x8_t High = vmovl_u8(vget_high_u8(Chars));
+			if (sizeof(CharType) == 2)
+			{
+				uint16* Blocks = (uint16*)Dest;
+				vst1q_u16(Blocks, Low);
+				vst1q_u16(Blocks + 8, High);
+			}
+			else
+			{
+				uint32* Blocks = (uint32*)Dest;
+				vst1q_u32(Blocks, vmovl_u16(vget_low_u16(Low)));
+				vst1q_u32(Blocks + 4, vmovl_u16(vget_high_u16(Low)));
+				vst1q_u32(Blocks + 8, vmovl_u16(vget_low_u16(High)));
+				vst1q_u32(Blocks + 12, vmovl_u16(vget_high_u16(High)));
+			}
+		}
+#endif
+	}
+
+	/** @return A mask of the bytes in [Min, Max], all of which must be below 128 */
+	FORCEINLINE FByteVector InRange(FByteVector Bytes, uint8 Min, uint8 Max)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		// Bytes above 127 compare as negative so are never in range
+		return _mm_and_si128(_mm_cmpgt_epi8(Bytes, _mm_set1_epi8(char(Min - 1))), _mm_cmplt_epi8(Bytes, _mm_set1_epi8(char(Max + 1))));
+#else
+		return vandq_u8(vcgeq_u8(Bytes, vdupq_n_u8(Min)), vcleq_u8(Bytes, vdupq_n_u8(Max)));
+#endif
+	}
+
+	/** @return Whether every byte of the mask is set */
+	FORCEINLINE bool AllSet(FByteVector Mask)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		return _mm_movemask_epi8(Mask) == 0xFFFF;
+#else
+		const uint64x2_t Lanes = vreinterpretq_u64_u8(Mask);
+		return (vgetq_lane_u64(Lanes, 0) & vgetq_lane_u64(Lanes, 1)) == ~uint64(0);
+#endif
+	}
+
+	/** Number of bits per byte in the masks returned by GetDifferOrZeroMask */
+#if UE_VECTORIZED_ASCII_SSE2
+	enum { MaskBitsPerByte = 1 };
+#else
+	enum { MaskBitsPerByte = 4 };
+#endif
+
+	/** Loads 16 bytes as they are, that is 16 / sizeof(CharType) characters */
+	FORCEINLINE FByteVector LoadBytes(const void* Source)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		return _mm_loadu_si128((const __m128i*)Source);
+#else
+		return vld1q_u8((const uint8*)Source);
+#endif
+	}
+
+	FORCEINLINE void StoreBytes(void* Dest, FByteVector Bytes)
+	{
+#if UE_VECTORIZED_ASCII_SSE2
+		_mm_storeu_si128((__m128i*)Dest, Bytes);
+#else
+		vst1q_u8((uint8*)Dest, Bytes);
+#endif
+	}
+
+	/**
+	 * Flips the case of the ASCII letters from First to First + 25, 'A' to make them lower case and 'a' upper case,
+	 * in lanes of CharSize bytes. Any other character is left as it is, as with TChar::ToLower and ToUpper.
+	 */
+	template <uint32 CharSize>
+	FORCEINLINE FByteVector FlipCase(FByteVector Chars, uint8 First)
+	{
+		static_assert(CharSize == 1 || CharSize == 2 || CharSize == 4, "Unsupported character size");
+#if UE_VECTORIZED_ASCII_SSE2
+		// Letters are those less than 26 past First as unsigned numbers, which SSE2 can only compare as signed ones
+		__m128i InRange;
+		if (CharSize == 1)
+		{
+			InRange = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(Chars, _mm_set1_epi8(char(First))), _mm_set1_epi8(25)), _mm_setzero_si128());
+		}
+		else if (CharSize == 2)
+		{
+			InRange = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(Chars, _mm_set1_epi16(short(First))), _mm_set1_epi16(25)), _mm_setzero_si128());
+		}
+		else
+		{
+			const __m128i Bias = _mm_set1_epi32(int32(0x80000000u));
+			const __m128i Offset = _mm_xor_si128(_mm_sub_epi32(Chars, _mm_set1_epi32(First)), Bias);
+			InRange = _mm_cmplt_epi32(Offset, _mm_xor_si128(_mm_set1_epi32(26), Bias));
+		}
+		return _mm_xor_si128(Chars, _mm_and_si128(InRange, CharSize == 1 ? _mm_set1_epi8(0x20) : CharSize == 2 ? _mm_set1_epi16(0x20) : _mm_set1_epi32(0x20)));
+#else
+		if (CharSize == 1)
+		{
+			const uint8x16_t InRange = vcleq_u8(vsubq_u8(Chars, vdupq_n_u8(First)), vdupq_n_u8(25));
+			return veorq_u8(Chars, vandq_u8(InRange, vdupq_n_u8(0x20)));
+		}
+		else if (CharSize == 2)
+		{
+			const uint16x8_t Lanes = vreinterpretq_u16_u8(Chars);
+			const uint16x8_t InRange = vcleq_u16(vsubq_u16(Lanes, vdupq_n_u16(First)), vdupq_n_u16(25));
+			return vreinterpretq_u8_u16(veorq_u16(Lanes, vandq_u16(InRange, vdupq_n_u16(0x20))));
+		}
+		else
+		{
+			const uint32x4_t Lanes = vreinterpretq_u32_u8(Chars);
+			const uint32x4_t InRange = vcleq_u32(vsubq_u32(Lanes, vdupq_n_u32(First)), vdupq_n_u32(25));
+			return vreinterpretq_u8_u32(veorq_u32(Lanes, vandq_u32(InRange, vdupq_n_u32(0x20))));
+		}
+#endif
+	}
+
+	/**
+	 * @return A mask with MaskBitsPerByte bits set for each byte of the characters of CharSize bytes where A and B
+	 * differ or A is the terminator, 0 if there is none
+	 */
+	template <uint32 CharSize>
+	FORCEINLINE uint64 GetDifferOrZeroMask(FByteVector A, FByteVector B)
+	{
+		static_assert(CharSize == 1 || CharSize == 2 || CharSize == 4, "Unsupported character size");
+#if UE_VECTORIZED_ASCII_SSE2
+		const __m128i Zero = _mm_setzero_si128();
+		__m128i Same;
+		if (CharSize == 1)
+		{
+			Same = _mm_andnot_si128(_mm_cmpeq_epi8(A, Zero), _mm_cmpeq_epi8(A, B));
+		}
+		else if (CharSize == 2)
+		{
+			Same = _mm_andnot_si128(_mm_cmpeq_epi16(A, Zero), _mm_cmpeq_epi16(A, B));
+		}
+		else
+		{
+			Same = _mm_andnot_si128(_mm_cmpeq_epi32(A, Zero), _mm_cmpeq_epi32(A, B));
+		}
+		return uint64(~uint32(_mm_movemask_epi8(Same)) & 0xFFFF);
+#else
+		uint8x16_t Same;
+		if (CharSize == 1)
+		{
+			Same = vbicq_u8(vceqq_u8(A, B), vceqq_u8(A, vdupq_n_u8(0)));
+		}
+		else if (CharSize == 2)
+		{
+			const uint16x8_t LanesA = vreinterpretq_u16_u8(A);
+			Same = vreinterpretq_u8_u16(vbicq_u16(vceqq_u16(LanesA, vreinterpretq_u16_u8(B)), vceqq_u16(LanesA, vdupq_n_u16(0))));
+		}
+		else
+		{
+			const uint32x4_t LanesA = vreinterpretq_u32_u8(A);
+			Same = vreinterpretq_u8_u32(vbicq_u32(vceqq_u32(LanesA, vreinterpretq_u32_u8(B)), vceqq_u32(LanesA, vdupq_n_u32(0))));
+		}
+
+		// Narrowing each 16 bit pair of bytes to 8 bits keeps a nibble per byte, NEON has no movemask
+		return ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Same), 4)), 0);
+#endif
+	}
+
+	/** @return Index of the first character marked in a non zero mask returned by GetDifferOrZeroMask */
+	template <uint32 CharSize>
+	FORCEINLINE int32 GetFirstCharIndex(uint64 Mask)
+	{
+		return int32(FPlatformMath::CountTrailingZeros64(Mask) / (MaskBitsPerByte * CharSize));
+	}
+
+	/**
+	 * @return Whether 16 bytes can be loaded from Ptr without crossing into the next page, which a null terminated
+	 * string that ends before might not be mapped to. Pages are at least 4KB everywhere.
+	 */
+	FORCEINLINE bool CanLoadBytesWithinPage(const void* Ptr)
+	{
+		return (UPTRINT(Ptr) & 4095) <= 4096 - 16;
+	}
+}
+
+#endif // UE_VECTORIZED_ASCII
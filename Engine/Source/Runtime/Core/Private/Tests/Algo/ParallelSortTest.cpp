@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Algo/ParallelSort.h"
+#include "Algo/IsSorted.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelSortTest, "System.Core.Algo.ParallelSort", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+namespace ParallelSortTest
+{
+	struct FItem
+	{
+		int32 Key;
+		int32 Order;
+
+		bool operator==(const FItem& Other) const
+		{
+			return Key == Other.Key && Order == Other.Order;
+		}
+	};
+}
+
+bool FParallelSortTest::RunTest(const FString& Parameters)
+{
+	using namespace ParallelSortTest;
+
+	FRandomStream Random(7);
+
+	// Sizes below and above the threshold for using the task graph, with keys chosen to have many duplicates
+	for (int32 Num : { 0, 1, 1000, 100003, 1000000 })
+	{
+		TArray<FItem> Items;
+		Items.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Items.Add({ Random.RandRange(-5000, 5000), Index });
+		}
+
+		TArray<FItem> Expected = Items;
+		Algo::StableSortBy(Expected, &FItem::Key);
+
+		TArray<FItem> RadixSorted = Items;
+		Algo::ParallelStableSortBy(RadixSorted, &FItem::Key);
+		TestTrue(FString::Printf(TEXT("Radix sorted %d items by an integer key"), Num), RadixSorted == Expected);
+
+		TArray<FItem> MergeSorted = Items;
+		Algo::ParallelStableSortBy(MergeSorted, &FItem::Key, [](int32 A, int32 B) { return A < B; });
+		TestTrue(FString::Printf(TEXT("Merge sorted %d items with a custom predicate"), Num), MergeSorted == Expected);
+
+		TArray<FItem> UnstableSorted = Items;
+		Algo::ParallelSortBy(UnstableSorted, &FItem::Key, [](int32 A, int32 B) { return A < B; });
+		TestTrue(FString::Printf(TEXT("Unstable sorted %d items"), Num), Algo::IsSortedBy(UnstableSorted, &FItem::Key));
+
+		TArray<FItem> Descending = Items;
+		Algo::ParallelStableSortBy(Descending, &FItem::Key, TGreater<>());
+		Algo::StableSortBy(Expected, &FItem::Key, TGreater<>());
+		TestTrue(FString::Printf(TEXT("Radix sorted %d items in descending order"), Num), Descending == Expected);
+
+		TArray<float> Floats;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Floats.Add(Random.FRandRange(-1.0e6f, 1.0e6f));
+		}
+		Algo::ParallelSort(Floats);
+		TestTrue(FString::Printf(TEXT("Radix sorted %d floats"), Num), Algo::IsSorted(Floats));
+	}
+
+	// Elements that own memory are relocated between the range and the scratch buffer
+	{
+		TArray<FString> Strings;
+		for (int32 Index = 0; Index < 200000; ++Index)
+		{
+			Strings.Add(FString::FromInt(Random.RandRange(0, 1000000)));
+		}
+		TArray<FString> Expected = Strings;
+		Algo::Sort(Expected);
+		Algo::ParallelSort(Strings);
+		TestTrue(TEXT("Sorted strings"), Strings == Expected);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Misc/AutomationTest.h"
+#include "Async/Future.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFutureWhenAllWhenAnyTest, "System.Core.Async.Future.WhenAllWhenAny", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FFutureWhenAllWhenAnyTest::RunTest(const FString& Parameters)
+{
+	// WhenAll keeps the order of the futures, not the order they are set in
+	{
+		TPromise<int32> Promises[3];
+		TArray<TFuture<int32>> Futures;
+		for (TPromise<int32>& Promise : Promises)
+		{
+			Futures.Add(Promise.GetFuture());
+		}
+		Promises[1].SetValue(20);
+
+		TFuture<TArray<int32>> All = WhenAll(MoveTemp(Futures));
+		Promises[2].SetValue(30);
+		TestFalse(TEXT("WhenAll is not set before all its futures"), All.IsReady());
+		Promises[0].SetValue(10);
+
+		TestTrue(TEXT("WhenAll is set with all its futures"), All.IsReady());
+		TestEqual(TEXT("WhenAll results"), All.Get(), TArray<int32>({ 10, 20, 30 }));
+	}
+
+	TestTrue(TEXT("WhenAll of nothing is set"), WhenAll(TArray<TFuture<int32>>()).IsReady());
+	TestTrue(TEXT("WhenAll of no void futures is set"), WhenAll(TArray<TFuture<void>>()).IsReady());
+
+	// WhenAny is set by the first future and ignores the others
+	{
+		TPromise<FString> Promises[2];
+		TArray<TFuture<FString>> Futures;
+		for (TPromise<FString>& Promise : Promises)
+		{
+			Futures.Add(Promise.GetFuture());
+		}
+
+		TFuture<TWhenAnyResult<FString>> Any = WhenAny(MoveTemp(Futures));
+		TestFalse(TEXT("WhenAny is not set before any of its futures"), Any.IsReady());
+		Promises[1].SetValue(TEXT("Second"));
+		Promises[0].SetValue(TEXT("First"));
+
+		TestEqual(TEXT("WhenAny index"), Any.Get().Index, 1);
+		TestEqual(TEXT("WhenAny result"), Any.Get().Result, FString(TEXT("Second")));
+	}
+
+	// Void futures
+	{
+		TPromise<void> AllPromises[2];
+		TPromise<void> AnyPromises[2];
+		TArray<TFuture<void>> AllFutures;
+		TArray<TFuture<void>> AnyFutures;
+		for (int32 Index = 0; Index < 2; ++Index)
+		{
+			AllFutures.Add(AllPromises[Index].GetFuture());
+			AnyFutures.Add(AnyPromises[Index].GetFuture());
+		}
+
+		TFuture<void> All = WhenAll(MoveTemp(AllFutures));
+		TFuture<int32> Any = WhenAny(MoveTemp(AnyFutures));
+		AllPromises[0].SetValue();
+		AnyPromises[1].SetValue();
+		TestFalse(TEXT("WhenAll of void futures is not set before all of them"), All.IsReady());
+		TestEqual(TEXT("WhenAny of void futures index"), Any.Get(), 1);
+		AllPromises[1].SetValue();
+		AnyPromises[0].SetValue();
+		TestTrue(TEXT("WhenAll of void futures is set"), All.IsReady());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/AutomationTest.h"
+#include "Async/ParallelFor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForAdaptiveTest, "System.Core.Async.ParallelFor (Adaptive)", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelReduceTest, "System.Core.Async.ParallelReduce", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForWithTaskContextTest, "System.Core.Async.ParallelForWithTaskContext", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelScanTest, "System.Core.Async.ParallelScan", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+/** Test that every index is visited exactly once, including from nested loops. */
+bool FParallelForAdaptiveTest::RunTest(const FString& Parameters)
+{
+	const int32 NumOuter = 64;
+	const int32 NumInner = 1000;
+
+	TArray<int32> Visits;
+	Visits.AddZeroed(NumOuter * NumInner);
+
+	ParallelFor(NumOuter, [&Visits](int32 OuterIndex)
+	{
+		ParallelFor(NumInner, [&Visits, OuterIndex](int32 InnerIndex)
+		{
+			FPlatformAtomics::InterlockedIncrement(&Visits[OuterIndex * NumInner + InnerIndex]);
+		}, EParallelForFlags::AdaptiveSplitting);
+	}, EParallelForFlags::AdaptiveSplitting);
+
+	int32 NumWrong = 0;
+	for (int32 Count : Visits)
+	{
+		NumWrong += Count != 1;
+	}
+	TestEqual(TEXT("Every index of a nested adaptive ParallelFor must be visited exactly once"), NumWrong, 0);
+
+	FThreadSafeCounter Counter;
+	ParallelFor(0, [&Counter](int32) { Counter.Increment(); }, EParallelForFlags::AdaptiveSplitting);
+	ParallelFor(1, [&Counter](int32) { Counter.Increment(); }, EParallelForFlags::AdaptiveSplitting);
+	TestEqual(TEXT("Empty and single item adaptive loops must run the expected number of times"), Counter.GetValue(), 1);
+
+	return true;
+}
+
+
+/** Test that reductions are correct and respect the order of a non commutative operation. */
+bool FParallelReduceTest::RunTest(const FString& Parameters)
+{
+	const int32 Num = 100000;
+
+	int64 Sum = ParallelReduce(Num, int64(0), [](int32 Index) { return int64(Index); }, [](int64 A, int64 B) { return A + B; });
+	TestEqual(TEXT("Parallel sum must match the closed form"), Sum, int64(Num) * (Num - 1) / 2);
+
+	int64 Empty = ParallelReduce(0, int64(42), [](int32 Index) { return int64(Index); }, [](int64 A, int64 B) { return A + B; });
+	TestEqual(TEXT("Reducing nothing must return the identity"), Empty, int64(42));
+
+	// the composition of affine maps x -> A * x + B is associative but not commutative
+	struct FAffine
+	{
+		uint32 A;
+		uint32 B;
+	};
+	auto Compose = [](const FAffine& First, const FAffine& Second) { return FAffine{ Second.A * First.A, Second.A * First.B + Second.B }; };
+	auto MakeAffine = [](int32 Index) { return FAffine{ uint32(Index) * 2u + 1u, uint32(Index) }; };
+
+	FAffine Serial{ 1, 0 };
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Serial = Compose(Serial, MakeAffine(Index));
+	}
+	FAffine Parallel = ParallelReduce(Num, FAffine{ 1, 0 }, MakeAffine, Compose, EParallelForFlags::None, 16);
+	TestTrue(TEXT("Parallel reduction of a non commutative operation must match the serial result"), Serial.A == Parallel.A && Serial.B == Parallel.B);
+
+	return true;
+}
+
+
+/** Test that merging the contexts of a loop gives the serial result. */
+bool FParallelForWithTaskContextTest::RunTest(const FString& Parameters)
+{
+	const int32 Num = 100000;
+	const int32 NumBuckets = 16;
+
+	struct FHistogram
+	{
+		int64 Sum;
+		int32 Buckets[NumBuckets];
+	};
+
+	TArray<FHistogram> Contexts;
+	ParallelForWithTaskContext(Contexts, Num, [](FHistogram& Histogram, int32 Index)
+	{
+		Histogram.Sum += Index;
+		Histogram.Buckets[Index % NumBuckets]++;
+	});
+	TestTrue(TEXT("A loop must use at least one context"), Contexts.Num() > 0);
+
+	FHistogram Merged = {};
+	for (const FHistogram& Histogram : Contexts)
+	{
+		Merged.Sum += Histogram.Sum;
+		for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+		{
+			Merged.Buckets[Bucket] += Histogram.Buckets[Bucket];
+		}
+	}
+	TestEqual(TEXT("Merged sums must match the closed form"), Merged.Sum, int64(Num) * (Num - 1) / 2);
+
+	int32 NumWrong = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		NumWrong += Merged.Buckets[Bucket] != Num / NumBuckets;
+	}
+	TestEqual(TEXT("Merged buckets must count every index once"), NumWrong, 0);
+
+	ParallelForWithTaskContext(Contexts, Num, [](FHistogram& Histogram, int32 Index) { Histogram.Sum += Index; }, EParallelForFlags::ForceSingleThread);
+	TestTrue(TEXT("A single threaded loop must use a single context"), Contexts.Num() == 1 && Contexts[0].Sum == int64(Num) * (Num - 1) / 2);
+
+	ParallelForWithTaskContext(Contexts, 0, [](FHistogram& Histogram, int32 Index) { Histogram.Sum += Index; });
+	TestEqual(TEXT("An empty loop must not use any context"), Contexts.Num(), 0);
+
+	return true;
+}
+
+
+/** Test that inclusive scans match their serial equivalent. */
+bool FParallelScanTest::RunTest(const FString& Parameters)
+{
+	const int32 Num = 50000;
+
+	TArray<int64> Input;
+	Input.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Input[Index] = (Index * 7) % 13;
+	}
+
+	TArray<int64> Output;
+	Output.SetNumUninitialized(Num);
+	ParallelScan<int64>(Input, Output, 0, [](int64 A, int64 B) { return A + B; }, EParallelForFlags::None, 8);
+
+	int64 Running = 0;
+	int32 NumWrong = 0;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		Running += Input[Index];
+		NumWrong += Output[Index] != Running;
+	}
+	TestEqual(TEXT("Parallel inclusive scan must match the serial scan"), NumWrong, 0);
+
+	// in place
+	ParallelScan<int64>(Input, Input, 0, [](int64 A, int64 B) { return A + B; });
+	TestEqual(TEXT("In place scan must match the out of place scan"), Input, Output);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
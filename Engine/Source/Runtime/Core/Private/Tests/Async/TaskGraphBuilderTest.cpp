@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/TaskGraphBuilder.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Math/RandomStream.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTaskGraphBuilderTest, "System.Core.Async.TaskGraphBuilder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FTaskGraphBuilderTest::RunTest(const FString& Parameters)
+{
+	// Layers of nodes where every node depends on a few random nodes of the layers before it
+	const int32 NumLayers = 16;
+	const int32 NumNodesPerLayer = 32;
+	const int32 NumNodes = NumLayers * NumNodesPerLayer;
+
+	FRandomStream Random(0x6A7);
+	TArray<TArray<int32>> Predecessors;
+	Predecessors.SetNum(NumNodes);
+	for (int32 NodeIndex = NumNodesPerLayer; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		const int32 FirstNodeOfLayer = NodeIndex - NodeIndex % NumNodesPerLayer;
+		for (int32 EdgeIndex = 0; EdgeIndex < 3; ++EdgeIndex)
+		{
+			Predecessors[NodeIndex].Add(Random.RandRange(0, FirstNodeOfLayer - 1));
+		}
+	}
+
+	TArray<int32> Finished;
+	Finished.SetNumZeroed(NumNodes);
+	FThreadSafeCounter NumOutOfOrder;
+	FThreadSafeCounter NumRun;
+
+	FTaskGraphBuilder Builder;
+	Builder.Reserve(NumNodes, NumNodes * 3);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		Builder.AddNode([NodeIndex, &Predecessors, &Finished, &NumOutOfOrder, &NumRun]()
+		{
+			for (int32 Predecessor : Predecessors[NodeIndex])
+			{
+				if (FPlatformAtomics::AtomicRead(&Finished[Predecessor]) == 0)
+				{
+					NumOutOfOrder.Increment();
+				}
+			}
+			NumRun.Increment();
+			FPlatformAtomics::InterlockedExchange(&Finished[NodeIndex], 1);
+		}, NodeIndex % 5 == 0 ? ENamedThreads::AnyHiPriThreadHiPriTask : ENamedThreads::AnyThread);
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		for (int32 Predecessor : Predecessors[NodeIndex])
+		{
+			Builder.AddEdge(Predecessor, NodeIndex);
+		}
+	}
+
+	// Gate the whole graph on an event that is completed after dispatch
+	FGraphEventRef Gate = FGraphEvent::CreateGraphEvent();
+	FGraphEventArray Prerequisites;
+	Prerequisites.Add(Gate);
+	FGraphEventRef Done = Builder.Dispatch(&Prerequisites);
+	TestEqual(TEXT("The builder is empty after dispatch"), Builder.NumNodes(), 0);
+	TestEqual(TEXT("No node runs before the prerequisites completed"), NumRun.GetValue(), 0);
+
+	TArray<FBaseGraphTask*> NewTasks;
+	Gate->DispatchSubsequents(NewTasks);
+	FTaskGraphInterface::Get().WaitUntilTaskCompletes(Done);
+
+	TestEqual(TEXT("Every node ran"), NumRun.GetValue(), NumNodes);
+	TestEqual(TEXT("Every node ran after its predecessors"), NumOutOfOrder.GetValue(), 0);
+
+	// An empty graph completes right away
+	TestTrue(TEXT("An empty graph is complete"), FTaskGraphBuilder().Dispatch()->IsComplete());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
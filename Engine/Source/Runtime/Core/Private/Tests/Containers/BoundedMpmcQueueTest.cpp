@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/BoundedMpmcQueue.h"
+
+#include "Containers/Array.h"
+#include "Containers/Queue.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BoundedMpmcQueueTest
+{
+	uint32 EnqueueBatch(TBoundedMpmcQueue<uint64>& Queue, uint64* Items, uint32 NumItems)
+	{
+		return NumItems == 1 ? uint32(Queue.Enqueue(*Items)) : Queue.EnqueueBatch(Items, NumItems);
+	}
+
+	uint32 DequeueBatch(TBoundedMpmcQueue<uint64>& Queue, uint64* OutItems, uint32 MaxItems)
+	{
+		return MaxItems == 1 ? uint32(Queue.Dequeue(*OutItems)) : Queue.DequeueBatch(OutItems, MaxItems);
+	}
+
+	uint32 EnqueueBatch(TQueue<uint64, EQueueMode::Mpsc>& Queue, uint64* Items, uint32 NumItems)
+	{
+		for (uint32 Index = 0; Index < NumItems; ++Index)
+		{
+			Queue.Enqueue(Items[Index]);
+		}
+		return NumItems;
+	}
+
+	uint32 DequeueBatch(TQueue<uint64, EQueueMode::Mpsc>& Queue, uint64* OutItems, uint32 MaxItems)
+	{
+		uint32 NumItems = 0;
+		while (NumItems < MaxItems && Queue.Dequeue(OutItems[NumItems]))
+		{
+			++NumItems;
+		}
+		return NumItems;
+	}
+
+	/**
+	 * Runs NumProducers threads adding NumItemsPerProducer distinct values to the queue and NumConsumers threads removing them,
+	 * returning the time taken and the sum of the values removed.
+	 */
+	template <typename QueueType>
+	double RunProducersAndConsumers(QueueType& Queue, int32 NumProducers, int32 NumConsumers, int32 NumItemsPerProducer, uint32 BatchSize, uint64& OutSum)
+	{
+		const uint64 NumItems = uint64(NumProducers) * NumItemsPerProducer;
+		TAtomic<uint64> NumConsumed(0);
+		TAtomic<uint64> Sum(0);
+
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<FThread> Threads;
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			Threads.Emplace(TEXT("BoundedMpmcQueueTest Producer"), [&Queue, Producer, NumItemsPerProducer, BatchSize]()
+			{
+				TArray<uint64> Batch;
+				Batch.SetNumUninitialized(BatchSize);
+				const uint64 FirstValue = uint64(Producer) * NumItemsPerProducer;
+				for (int32 Index = 0; Index < NumItemsPerProducer;)
+				{
+					const uint32 NumInBatch = FMath::Min<uint32>(BatchSize, NumItemsPerProducer - Index);
+					for (uint32 BatchIndex = 0; BatchIndex < NumInBatch; ++BatchIndex)
+					{
+						Batch[BatchIndex] = FirstValue + Index + BatchIndex;
+					}
+
+					const uint32 NumAdded = EnqueueBatch(Queue, Batch.GetData(), NumInBatch);
+					Index += NumAdded;
+					if (NumAdded == 0)
+					{
+						FPlatformProcess::Sleep(0.0f);
+					}
+				}
+			});
+		}
+		for (int32 Consumer = 0; Consumer < NumConsumers; ++Consumer)
+		{
+			Threads.Emplace(TEXT("BoundedMpmcQueueTest Consumer"), [&Queue, &NumConsumed, &Sum, NumItems, BatchSize]()
+			{
+				TArray<uint64> Batch;
+				Batch.SetNumUninitialized(BatchSize);
+				uint64 LocalSum = 0;
+				while (NumConsumed.Load(EMemoryOrder::Relaxed) < NumItems)
+				{
+					const uint32 NumRemoved = DequeueBatch(Queue, Batch.GetData(), BatchSize);
+					for (uint32 BatchIndex = 0; BatchIndex < NumRemoved; ++BatchIndex)
+					{
+						LocalSum += Batch[BatchIndex];
+					}
+					if (NumRemoved == 0)
+					{
+						FPlatformProcess::Sleep(0.0f);
+					}
+					else
+					{
+						NumConsumed += NumRemoved;
+					}
+				}
+				Sum += LocalSum;
+			});
+		}
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+
+		OutSum = Sum.Load();
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	uint64 ExpectedSum(int32 NumProducers, int32 NumItemsPerProducer)
+	{
+		const uint64 NumItems = uint64(NumProducers) * NumItemsPerProducer;
+		return NumItems * (NumItems - 1) / 2;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoundedMpmcQueueTest, "System.Core.Containers.BoundedMpmcQueue", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FBoundedMpmcQueueTest::RunTest(const FString& Parameters)
+{
+	using namespace BoundedMpmcQueueTest;
+
+	// Single threaded ordering, full and empty queues, wrapping around
+	{
+		TBoundedMpmcQueue<FString> Queue(5);
+		TestEqual(TEXT("Capacity is rounded up to a power of two"), Queue.GetCapacity(), 8u);
+
+		FString Item;
+		TestFalse(TEXT("New queue is empty"), Queue.Dequeue(Item));
+		for (int32 Lap = 0; Lap < 3; ++Lap)
+		{
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				TestTrue(TEXT("Enqueue while not full"), Queue.Enqueue(FString::FromInt(Index)));
+			}
+			TestFalse(TEXT("Enqueue while full"), Queue.Enqueue(TEXT("Extra")));
+			TestEqual(TEXT("Full queue count"), Queue.Count(), 8u);
+
+			for (int32 Index = 0; Index < 5; ++Index)
+			{
+				TestTrue(TEXT("Dequeue while not empty"), Queue.Dequeue(Item) && Item == FString::FromInt(Index));
+			}
+
+			FString Batch[8] = { TEXT("A"), TEXT("B"), TEXT("C"), TEXT("D"), TEXT("E"), TEXT("F"), TEXT("G"), TEXT("H") };
+			TestEqual(TEXT("Batch enqueue is limited by the space left"), Queue.EnqueueBatch(Batch, 8), 5u);
+			TestEqual(TEXT("Dequeue batch"), Queue.DequeueBatch(Batch, 8), 8u);
+			TestTrue(TEXT("Batches keep the queue order"), Batch[2] == TEXT("7") && Batch[3] == TEXT("A") && Batch[7] == TEXT("E"));
+			TestTrue(TEXT("Emptied queue"), Queue.IsEmpty());
+		}
+
+		// Leave elements for the destructor to free
+		Queue.Emplace(TEXT("Left in the queue"));
+	}
+
+	// Several producers and consumers, every value must be removed exactly once
+	for (uint32 BatchSize : { 1u, 7u })
+	{
+		TBoundedMpmcQueue<uint64> Queue(64);
+		uint64 Sum = 0;
+		RunProducersAndConsumers(Queue, 4, 4, 100000, BatchSize, Sum);
+		TestEqual(FString::Printf(TEXT("Sum of the values removed with batches of %u"), BatchSize), Sum, ExpectedSum(4, 100000));
+		TestTrue(TEXT("Queue is empty after the consumers are done"), Queue.IsEmpty());
+	}
+
+	return true;
+}
+
+/** Compares TBoundedMpmcQueue with the MPSC mode of TQueue, then times it with several consumers */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoundedMpmcQueuePerfTest, "System.Core.Containers.BoundedMpmcQueuePerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FBoundedMpmcQueuePerfTest::RunTest(const FString& Parameters)
+{
+	using namespace BoundedMpmcQueueTest;
+
+	const int32 NumItemsPerProducer = 1000000;
+	for (int32 NumProducers : { 1, 2, 4, 8 })
+	{
+		const uint64 Expected = ExpectedSum(NumProducers, NumItemsPerProducer);
+		uint64 Sum = 0;
+
+		TQueue<uint64, EQueueMode::Mpsc> MpscQueue;
+		const double MpscTime = RunProducersAndConsumers(MpscQueue, NumProducers, 1, NumItemsPerProducer, 1, Sum);
+		TestEqual(TEXT("TQueue sum"), Sum, Expected);
+
+		TBoundedMpmcQueue<uint64> BoundedQueue(4096);
+		const double BoundedTime = RunProducersAndConsumers(BoundedQueue, NumProducers, 1, NumItemsPerProducer, 1, Sum);
+		TestEqual(TEXT("TBoundedMpmcQueue sum"), Sum, Expected);
+
+		const double BatchedTime = RunProducersAndConsumers(BoundedQueue, NumProducers, 1, NumItemsPerProducer, 32, Sum);
+		TestEqual(TEXT("Batched TBoundedMpmcQueue sum"), Sum, Expected);
+
+		const double MpmcTime = RunProducersAndConsumers(BoundedQueue, NumProducers, 4, NumItemsPerProducer, 1, Sum);
+		TestEqual(TEXT("TBoundedMpmcQueue sum with 4 consumers"), Sum, Expected);
+
+		const double NumItems = double(NumProducers) * NumItemsPerProducer;
+		AddInfo(FString::Printf(TEXT("%d producers: TQueue<Mpsc> %.1f ns, TBoundedMpmcQueue %.1f ns, with batches of 32 %.1f ns, with 4 consumers %.1f ns per item"),
+			NumProducers, MpscTime * 1e9 / NumItems, BoundedTime * 1e9 / NumItems, BatchedTime * 1e9 / NumItems, MpmcTime * 1e9 / NumItems));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/FlatMap.h"
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlatMapTest, "System.Core.Containers.FlatMap", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FFlatMapTest::RunTest(const FString& Parameters)
+{
+	// Random adds and removes over a small key range, so slots get deleted and reused, checked against TMap
+	{
+		FRandomStream Random(42);
+		TFlatMap<int32, int32> FlatMap;
+		TMap<int32, int32> Map;
+		for (int32 Index = 0; Index < 100000; ++Index)
+		{
+			const int32 Key = Random.RandRange(0, 4999);
+			if (Random.RandRange(0, 2) == 0)
+			{
+				TestEqual(TEXT("Remove"), FlatMap.Remove(Key), Map.Remove(Key));
+			}
+			else
+			{
+				FlatMap.Add(Key, Index);
+				Map.Add(Key, Index);
+			}
+		}
+
+		TestEqual(TEXT("Num"), FlatMap.Num(), Map.Num());
+		for (int32 Key = 0; Key < 5000; ++Key)
+		{
+			const int32* Value = FlatMap.Find(Key);
+			const int32* Expected = Map.Find(Key);
+			if (!TestEqual(TEXT("Contains"), Value != nullptr, Expected != nullptr))
+			{
+				break;
+			}
+			if (Value && !TestEqual(TEXT("Value"), *Value, *Expected))
+			{
+				break;
+			}
+		}
+
+		int32 NumIterated = 0;
+		for (const TPair<int32, int32>& Pair : FlatMap)
+		{
+			TestEqual(TEXT("Iterated value"), Pair.Value, Map.FindRef(Pair.Key));
+			++NumIterated;
+		}
+		TestEqual(TEXT("Iterated count"), NumIterated, Map.Num());
+
+		for (auto It = FlatMap.CreateIterator(); It; ++It)
+		{
+			if (It.Key() & 1)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		FlatMap.Shrink();
+		for (const TPair<int32, int32>& Pair : Map)
+		{
+			TestEqual(TEXT("Contains after removing while iterating"), FlatMap.Contains(Pair.Key), (Pair.Key & 1) == 0);
+		}
+	}
+
+	// Non trivial elements, copies and moves
+	{
+		TFlatMap<FString, FString> FlatMap;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			FlatMap.Add(FString::FromInt(Index), FString::Printf(TEXT("Value%d"), Index));
+		}
+		FlatMap.FindOrAdd(TEXT("Extra")) = TEXT("ExtraValue");
+
+		TFlatMap<FString, FString> Copy(FlatMap);
+		TFlatMap<FString, FString> Moved(MoveTemp(FlatMap));
+		TestEqual(TEXT("Moved from map is empty"), FlatMap.Num(), 0);
+		TestEqual(TEXT("Copy num"), Copy.Num(), 1001);
+		TestEqual(TEXT("Copy value"), Copy.FindRef(TEXT("123")), FString(TEXT("Value123")));
+		TestEqual(TEXT("Moved value"), Moved.FindChecked(TEXT("Extra")), FString(TEXT("ExtraValue")));
+		TestFalse(TEXT("Missing key"), Moved.Contains(TEXT("1000")));
+	}
+
+	// Sets
+	{
+		TFlatSet<int32> FlatSet = { 1, 2, 3 };
+		bool bIsAlreadyInSet = false;
+		FlatSet.Add(2, &bIsAlreadyInSet);
+		TestTrue(TEXT("Already in set"), bIsAlreadyInSet);
+		TestEqual(TEXT("Set num"), FlatSet.Num(), 3);
+		FlatSet.Empty();
+		TestFalse(TEXT("Emptied set"), FlatSet.Contains(1));
+	}
+
+	return true;
+}
+
+/** Compares TFlatMap against TMap for the common operations and a range of sizes */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlatMapPerfTest, "System.Core.Containers.FlatMapPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+template <typename MapType>
+static void MeasureMapOperations(const TArray<int32>& Keys, const TArray<int32>& MissingKeys, double OutTimes[4], int64& OutChecksum)
+{
+	MapType Map;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Key : Keys)
+	{
+		Map.Add(Key, Key);
+	}
+	OutTimes[0] = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Key : Keys)
+	{
+		OutChecksum += *Map.Find(Key);
+	}
+	OutTimes[1] = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Key : MissingKeys)
+	{
+		OutChecksum += Map.Find(Key) != nullptr;
+	}
+	OutTimes[2] = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (const TPair<int32, int32>& Pair : Map)
+	{
+		OutChecksum += Pair.Value;
+	}
+	OutTimes[3] = FPlatformTime::Seconds() - StartTime;
+}
+
+bool FFlatMapPerfTest::RunTest(const FString& Parameters)
+{
+	const TCHAR* OperationNames[] = { TEXT("insert"), TEXT("find hit"), TEXT("find miss"), TEXT("iterate") };
+
+	FRandomStream Random(1234);
+	for (int32 NumElements = 1000; NumElements <= 10000000; NumElements *= 10)
+	{
+		// Even keys are added, odd ones are looked up as missing, both in a random order
+		TArray<int32> Keys;
+		TArray<int32> MissingKeys;
+		Keys.Reserve(NumElements);
+		MissingKeys.Reserve(NumElements);
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			Keys.Add(Index * 2);
+			MissingKeys.Add(Index * 2 + 1);
+		}
+		for (int32 Index = NumElements - 1; Index > 0; --Index)
+		{
+			Keys.Swap(Index, Random.RandRange(0, Index));
+			MissingKeys.Swap(Index, Random.RandRange(0, Index));
+		}
+
+		double MapTimes[4];
+		double FlatMapTimes[4];
+		int64 MapChecksum = 0;
+		int64 FlatMapChecksum = 0;
+		MeasureMapOperations<TMap<int32, int32>>(Keys, MissingKeys, MapTimes, MapChecksum);
+		MeasureMapOperations<TFlatMap<int32, int32>>(Keys, MissingKeys, FlatMapTimes, FlatMapChecksum);
+		TestEqual(FString::Printf(TEXT("Same results with %d elements"), NumElements), FlatMapChecksum, MapChecksum);
+
+		for (int32 Operation = 0; Operation < 4; ++Operation)
+		{
+			AddInfo(FString::Printf(TEXT("%d elements, %s: TMap %.2f ns, TFlatMap %.2f ns per element"), NumElements, OperationNames[Operation],
+				MapTimes[Operation] * 1e9 / NumElements, FlatMapTimes[Operation] * 1e9 / NumElements));
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
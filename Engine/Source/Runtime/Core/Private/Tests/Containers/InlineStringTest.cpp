@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/InlineString.h"
+
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/NameTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInlineStringTest, "System.Core.String.InlineString", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FInlineStringTest::RunTest(const FString& Parameters)
+{
+	// Short strings stay inline, longer ones allocate
+	{
+		FInlineString Str(TEXT("Short"));
+		TestTrue(TEXT("Short string is inline"), Str.IsInline());
+		TestEqual(TEXT("Short string length"), Str.Len(), 5);
+
+		Str += TEXT(" string growing past the inline storage");
+		TestFalse(TEXT("Long string allocates"), Str.IsInline());
+		TestEqual(TEXT("Long string contents"), Str.ToString(), FString(TEXT("Short string growing past the inline storage")));
+
+		FInlineString Empty;
+		TestTrue(TEXT("Default constructed string is empty"), Empty.IsEmpty() && **Empty == TCHAR('\0'));
+	}
+
+	// Appending part of the string to itself
+	{
+		FInlineString Str(TEXT("abcdefghijklmnopqrstuvw"));
+		Str.Append(*Str, Str.Len());
+		TestTrue(TEXT("Self append"), Str == TEXT("abcdefghijklmnopqrstuvwabcdefghijklmnopqrstuvw"));
+	}
+
+	// Paths are joined the same way as FString
+	{
+		const TCHAR* Cases[][2] = { { TEXT(""), TEXT("File.txt") }, { TEXT("Dir"), TEXT("File.txt") }, { TEXT("Dir/"), TEXT("File.txt") }, { TEXT("Dir"), TEXT("/File.txt") }, { TEXT("Dir\\"), TEXT("") }, { TEXT("Dir"), TEXT("") } };
+		for (const TCHAR* const (&Case)[2] : Cases)
+		{
+			FInlineString Combined;
+			FPaths::CombineTo(Combined, Case[0], Case[1]);
+			TestEqual(FString::Printf(TEXT("Combined '%s' and '%s'"), Case[0], Case[1]), Combined.ToString(), FPaths::Combine(Case[0], Case[1]));
+		}
+
+		FInlineString Combined;
+		FPaths::CombineTo(Combined, TEXT("Engine"), FString(TEXT("Content")), TEXT("Asset.uasset"));
+		TestEqual(TEXT("Combined three paths"), Combined.ToString(), FString(TEXT("Engine/Content/Asset.uasset")));
+	}
+
+	// Interoperability with names, views and builders
+	{
+		FInlineString NameString;
+		FName(TEXT("Name"), 3).ToString(NameString);
+		TestTrue(TEXT("Name with a number"), NameString.Equals(TEXT("Name_2")) && NameString.IsInline());
+
+		const FStringView View = NameString;
+		TestEqual(TEXT("View length"), View.Len(), 6);
+
+		TStringBuilder<64> Builder;
+		Builder << TEXT("Prefix ") << NameString;
+		TestTrue(TEXT("Appended to a builder"), FStringView(Builder).Equals(TEXT("Prefix Name_2")));
+
+		NameString = FStringView(Builder).Right(6);
+		TestTrue(TEXT("Case insensitive comparison"), NameString == TEXT("NAME_2"));
+		TestEqual(TEXT("Hash matches FString"), GetTypeHash(NameString), GetTypeHash(FString(TEXT("name_2"))));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
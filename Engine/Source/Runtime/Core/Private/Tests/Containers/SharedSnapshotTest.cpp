@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/SharedSnapshot.h"
+#include "Containers/SeqLock.h"
+
+#include "Containers/Array.h"
+#include "HAL/Thread.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Atomic.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4SharedSnapshotTest_Private
+{
+	/** Value whose fields are always written together, so that readers can tell a torn or deleted value */
+	struct FPairValue
+	{
+		static TAtomic<int32> NumLive;
+
+		FPairValue()
+			: First(0)
+			, Second(0)
+		{
+			++NumLive;
+		}
+
+		FPairValue(const FPairValue& Other)
+			: First(Other.First)
+			, Second(Other.Second)
+		{
+			++NumLive;
+		}
+
+		~FPairValue()
+		{
+			First = -1;
+			Second = -2;
+			--NumLive;
+		}
+
+		int32 First;
+		int32 Second;
+	};
+
+	TAtomic<int32> FPairValue::NumLive(0);
+
+	struct FPodPair
+	{
+		int64 First;
+		int64 Second;
+	};
+
+	static const int32 NumReaders = 8;
+	static const int32 NumWrites = 20000;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSharedSnapshotTest, "System.Core.Containers.SharedSnapshot", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FSharedSnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4SharedSnapshotTest_Private;
+
+	// Readers must only ever see whole values that are still alive while one writer updates and another publishes
+	{
+		TSharedSnapshot<FPairValue> Snapshot;
+		TAtomic<bool> bDone(false);
+		TAtomic<int32> NumTornReads(0);
+
+		TArray<FThread> Threads;
+		for (int32 Reader = 0; Reader < NumReaders; ++Reader)
+		{
+			Threads.Emplace(TEXT("SharedSnapshotTest Reader"), [&Snapshot, &bDone, &NumTornReads]()
+			{
+				while (!bDone.Load(EMemoryOrder::Relaxed))
+				{
+					TSharedSnapshot<FPairValue>::FReadScope Scope(Snapshot);
+					const bool bNestedWhole = Snapshot.Read([](const FPairValue& Nested) { return Nested.First >= 0 && Nested.Second == Nested.First * 2; });
+					const bool bWhole = bNestedWhole && Scope->First >= 0 && Scope->Second == Scope->First * 2;
+					if (!bWhole)
+					{
+						++NumTornReads;
+					}
+				}
+			});
+		}
+		Threads.Emplace(TEXT("SharedSnapshotTest Publisher"), [&Snapshot]()
+		{
+			for (int32 Index = 0; Index < NumWrites; ++Index)
+			{
+				FPairValue Value;
+				Value.First = 0;
+				Value.Second = 0;
+				Snapshot.Publish(Value);
+			}
+		});
+		for (int32 Index = 0; Index < NumWrites; ++Index)
+		{
+			Snapshot.Update([](FPairValue& Value)
+			{
+				Value.First += 1;
+				Value.Second = Value.First * 2;
+			});
+		}
+		bDone = true;
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+
+		TestEqual(TEXT("Shared snapshot reads are never torn or of deleted values"), NumTornReads.Load(), 0);
+		FSharedSnapshotEpochs::Reclaim();
+		TestEqual(TEXT("Shared snapshot keeps only the current value once reads are done"), FPairValue::NumLive.Load(), 1);
+	}
+	FSharedSnapshotEpochs::Reclaim();
+	TestEqual(TEXT("Shared snapshot deletes its value"), FPairValue::NumLive.Load(), 0);
+
+	// Sequence lock reads must never mix two writes
+	{
+		TSeqLock<FPodPair> SeqLock(FPodPair{ 0, 0 });
+		TAtomic<bool> bDone(false);
+		TAtomic<int32> NumTornReads(0);
+
+		TArray<FThread> Threads;
+		for (int32 Reader = 0; Reader < NumReaders; ++Reader)
+		{
+			Threads.Emplace(TEXT("SharedSnapshotTest SeqLock Reader"), [&SeqLock, &bDone, &NumTornReads]()
+			{
+				while (!bDone.Load(EMemoryOrder::Relaxed))
+				{
+					const FPodPair Value = SeqLock.Read();
+					if (Value.Second != -Value.First)
+					{
+						++NumTornReads;
+					}
+				}
+			});
+		}
+		for (int64 Index = 1; Index <= NumWrites; ++Index)
+		{
+			SeqLock.Write(FPodPair{ Index, -Index });
+		}
+		bDone = true;
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+
+		TestEqual(TEXT("Sequence lock reads are never torn"), NumTornReads.Load(), 0);
+		TestEqual(TEXT("Sequence lock reads the last write"), SeqLock.Read().First, (int64)NumWrites);
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
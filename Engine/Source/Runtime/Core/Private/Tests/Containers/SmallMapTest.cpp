@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Containers/SmallMap.h"
+
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSmallMapTest, "System.Core.Containers.SmallMap", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSmallMapTest::RunTest(const FString& Parameters)
+{
+	// Random adds and removes over a key range around the inline size, checked against TMap
+	{
+		FRandomStream Random(42);
+		TSmallMap<int32, int32, 4> SmallMap;
+		TMap<int32, int32> Map;
+		for (int32 Index = 0; Index < 10000; ++Index)
+		{
+			const int32 Key = Random.RandRange(0, 9);
+			if (Random.RandRange(0, 2) == 0)
+			{
+				TestEqual(TEXT("Remove"), SmallMap.Remove(Key), Map.Remove(Key));
+			}
+			else
+			{
+				SmallMap.Add(Key, Index);
+				Map.Add(Key, Index);
+			}
+
+			if (Index % 100 == 0)
+			{
+				SmallMap.Shrink();
+				if (!TestEqual(TEXT("Inline after shrinking"), SmallMap.IsInline(), Map.Num() <= 4))
+				{
+					break;
+				}
+			}
+		}
+
+		TestEqual(TEXT("Num"), SmallMap.Num(), Map.Num());
+		for (int32 Key = 0; Key < 10; ++Key)
+		{
+			TestEqual(TEXT("Value"), SmallMap.FindRef(Key), Map.FindRef(Key));
+		}
+	}
+
+	// Iterating and removing while iterating, inline and hashed
+	for (int32 NumElements : { 3, 20 })
+	{
+		TSmallMap<int32, int32, 4> SmallMap;
+		for (int32 Key = 0; Key < NumElements; ++Key)
+		{
+			SmallMap.Add(Key, Key * 10);
+		}
+		TestEqual(TEXT("Inline"), SmallMap.IsInline(), NumElements <= 4);
+
+		int32 Sum = 0;
+		for (const TPair<int32, int32>& Pair : SmallMap)
+		{
+			Sum += Pair.Value;
+		}
+		TestEqual(TEXT("Iterated sum"), Sum, 10 * NumElements * (NumElements - 1) / 2);
+
+		for (auto It = SmallMap.CreateIterator(); It; ++It)
+		{
+			if (It.Key() & 1)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		TestEqual(TEXT("Num after removing while iterating"), SmallMap.Num(), (NumElements + 1) / 2);
+		for (int32 Key = 0; Key < NumElements; ++Key)
+		{
+			TestEqual(TEXT("Contains after removing while iterating"), SmallMap.Contains(Key), (Key & 1) == 0);
+		}
+	}
+
+	// Non trivial elements, copies and moves
+	{
+		TSmallMap<FString, FString> SmallMap;
+		SmallMap.Add(TEXT("A"), TEXT("ValueA"));
+		SmallMap.FindOrAdd(TEXT("B")) = TEXT("ValueB");
+		SmallMap.Add(TEXT("A"), TEXT("NewValueA"));
+
+		TSmallMap<FString, FString> Copy(SmallMap);
+		TSmallMap<FString, FString> Moved(MoveTemp(SmallMap));
+		TestEqual(TEXT("Copy num"), Copy.Num(), 2);
+		TestEqual(TEXT("Replaced value"), Copy.FindRef(TEXT("A")), FString(TEXT("NewValueA")));
+		TestEqual(TEXT("Moved value"), Moved.FindChecked(TEXT("B")), FString(TEXT("ValueB")));
+		TestFalse(TEXT("Missing key"), Moved.Contains(TEXT("C")));
+	}
+
+	// Sets
+	{
+		TSmallSet<int32, 2> SmallSet = { 1, 2, 3 };
+		bool bIsAlreadyInSet = false;
+		SmallSet.Add(2, &bIsAlreadyInSet);
+		TestTrue(TEXT("Already in set"), bIsAlreadyInSet);
+		TestEqual(TEXT("Set num"), SmallSet.Num(), 3);
+		TestFalse(TEXT("Set past its inline size is hashed"), SmallSet.IsInline());
+		SmallSet.Empty();
+		TestFalse(TEXT("Emptied set"), SmallSet.Contains(1));
+		TestTrue(TEXT("Emptied set is inline"), SmallSet.IsInline());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Templates/Atomic.h"
+#include "Templates/UniquePtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4AsyncWriteFileTest_Private
+{
+	static FString GetTestFilename()
+	{
+		return FPaths::ProjectIntermediateDir() / TEXT("AsyncWriteFileTest.bin");
+	}
+
+	static TArray<uint8> MakeTestData(int32 Size)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			Data[Index] = (uint8)(Index * 31 + (Index >> 8));
+		}
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWriteFileTest, "System.Core.HAL.AsyncWriteFile", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FAsyncWriteFileTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4AsyncWriteFileTest_Private;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Filename = GetTestFilename();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+
+	// Writes of varying sizes, most of them combined with the ones before, must land in order
+	const TArray<uint8> Data = MakeTestData(4 * 1024 * 1024);
+	TAtomic<int32> NumCallbacks(0);
+	int32 NumWrites = 0;
+	{
+		TUniquePtr<IAsyncWriteFileHandle> Handle(PlatformFile.OpenAsyncWrite(*Filename, false, EAsyncWriteSyncPolicy::OnClose));
+		if (!TestNotNull(TEXT("Async write handle opens"), Handle.Get()))
+		{
+			return false;
+		}
+		for (int32 Offset = 0; Offset < Data.Num(); ++NumWrites)
+		{
+			const int32 Size = FMath::Min(1 + (NumWrites * 37) % 5000, Data.Num() - Offset);
+			Handle->Write(Data.GetData() + Offset, Size, [&NumCallbacks](bool bSucceeded) { if (bSucceeded) { ++NumCallbacks; } });
+			Offset += Size;
+		}
+		TestTrue(TEXT("Flush succeeds"), Handle->Flush());
+		TestEqual(TEXT("Callbacks are called once the handle is flushed"), NumCallbacks.Load(), NumWrites);
+
+		// Appends after a flush
+		Handle->Write(Data.GetData(), 100);
+	}
+
+	TArray<uint8> ReadData;
+	ReadData.SetNumUninitialized(Data.Num() + 100);
+	TUniquePtr<IFileHandle> ReadHandle(PlatformFile.OpenRead(*Filename));
+	TestTrue(TEXT("Written file reads back"), ReadHandle && ReadHandle->Size() == ReadData.Num() && ReadHandle->Read(ReadData.GetData(), ReadData.Num()));
+	ReadHandle.Reset();
+	TestTrue(TEXT("Writes are in order"), FMemory::Memcmp(ReadData.GetData(), Data.GetData(), Data.Num()) == 0 && FMemory::Memcmp(ReadData.GetData() + Data.Num(), Data.GetData(), 100) == 0);
+
+	PlatformFile.DeleteFile(*Filename);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncWriteFilePerfTest, "System.Core.HAL.AsyncWriteFile.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FAsyncWriteFilePerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4AsyncWriteFileTest_Private;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Filename = GetTestFilename();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+
+	// Log sized lines, the case the write combining is for
+	constexpr int32 NumLines = 200000;
+	constexpr int32 LineSize = 120;
+	const TArray<uint8> Line = MakeTestData(LineSize);
+
+	for (bool bAsync : { false, true })
+	{
+		double StartTime = FPlatformTime::Seconds();
+		double IssueSeconds = 0.0;
+		if (bAsync)
+		{
+			TUniquePtr<IAsyncWriteFileHandle> Handle(PlatformFile.OpenAsyncWrite(*Filename));
+			for (int32 Index = 0; Index < NumLines; ++Index)
+			{
+				Handle->Write(Line.GetData(), LineSize);
+			}
+			IssueSeconds = FPlatformTime::Seconds() - StartTime;
+			Handle->Flush();
+		}
+		else
+		{
+			TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*Filename));
+			for (int32 Index = 0; Index < NumLines; ++Index)
+			{
+				Handle->Write(Line.GetData(), LineSize);
+			}
+			IssueSeconds = FPlatformTime::Seconds() - StartTime;
+			Handle->Flush();
+		}
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		AddInfo(FString::Printf(TEXT("%s: %d writes of %d bytes, %.1f ns per write on the calling thread, %.2fms until flushed"),
+			bAsync ? TEXT("Async write handle") : TEXT("Sync write handle"), NumLines, LineSize, IssueSeconds * 1e9 / NumLines, TotalSeconds * 1000.0));
+	}
+
+	PlatformFile.DeleteFile(*Filename);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConsoleManagerFindTest, "System.Core.HAL.ConsoleManager.Find", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FConsoleManagerFindTest::RunTest(const FString& Parameters)
+{
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+
+	IConsoleVariable* First = ConsoleManager.RegisterConsoleVariable(TEXT("Test.ConsoleManager.First"), 1, TEXT("Test variable"), ECVF_Default);
+	IConsoleVariable* Second = ConsoleManager.RegisterConsoleVariable(TEXT("Test.ConsoleManager.Second"), 2, TEXT("Test variable"), ECVF_Default);
+
+	// Enough finds to go from the locked path to the published table
+	for (int32 Iteration = 0; Iteration < 32; ++Iteration)
+	{
+		TestEqual(TEXT("Find a registered variable"), ConsoleManager.FindConsoleVariable(TEXT("Test.ConsoleManager.First"), false), First);
+		TestEqual(TEXT("Find ignores the case"), ConsoleManager.FindConsoleVariable(TEXT("test.consolemanager.SECOND"), false), Second);
+		TestNull(TEXT("Find an unknown name"), ConsoleManager.FindConsoleObject(TEXT("Test.ConsoleManager.Unknown"), false));
+	}
+
+	// A registration is seen by the next find
+	IConsoleVariable* Third = ConsoleManager.RegisterConsoleVariable(TEXT("Test.ConsoleManager.Third"), 3, TEXT("Test variable"), ECVF_Default);
+	TestEqual(TEXT("Find a variable registered after the others"), ConsoleManager.FindConsoleVariable(TEXT("Test.ConsoleManager.Third"), false), Third);
+	TestTrue(TEXT("The name is registered"), ConsoleManager.IsNameRegistered(TEXT("Test.ConsoleManager.Third")));
+
+	ConsoleManager.UnregisterConsoleObject(Third, false);
+	TestNull(TEXT("Find an unregistered variable"), ConsoleManager.FindConsoleObject(TEXT("Test.ConsoleManager.Third"), false));
+	TestFalse(TEXT("The name is not registered anymore"), ConsoleManager.IsNameRegistered(TEXT("Test.ConsoleManager.Third")));
+
+	for (int32 Iteration = 0; Iteration < 32; ++Iteration)
+	{
+		TestEqual(TEXT("Find a variable after the table is built again"), ConsoleManager.FindConsoleVariable(TEXT("Test.ConsoleManager.First"), false), First);
+		TestNull(TEXT("Find a variable unregistered before the table is built again"), ConsoleManager.FindConsoleObject(TEXT("Test.ConsoleManager.Third"), false));
+	}
+
+	ConsoleManager.UnregisterConsoleObject(First, false);
+	ConsoleManager.UnregisterConsoleObject(Second, false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
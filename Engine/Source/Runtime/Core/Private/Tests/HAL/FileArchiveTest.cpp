@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+#include "Templates/UniquePtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4FileArchiveTest_Private
+{
+	static TArray<uint8> MakeTestData(int32 Size)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			Data[Index] = (uint8)(Index * 31 + (Index >> 8));
+		}
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileArchiveBackgroundTest, "System.Core.HAL.FileArchiveBackground", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFileArchiveBackgroundTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4FileArchiveTest_Private;
+
+	const FString Filename = FPaths::ProjectIntermediateDir() / TEXT("FileArchiveBackgroundTest.bin");
+	const TArray<uint8> Data = MakeTestData(3 * 1024 * 1024 + 123);
+	const int32 PatchOffset = 100;
+	const uint8 Patch[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+
+	// Writes of varying sizes go through the ring of buffers, and the seek back to patch the start waits for them
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_BackgroundFlush));
+		if (!TestNotNull(TEXT("Background writer opens"), Writer.Get()))
+		{
+			return false;
+		}
+		for (int32 Offset = 0, WriteIndex = 0; Offset < Data.Num(); ++WriteIndex)
+		{
+			const int32 Size = FMath::Min(1 + (WriteIndex * 7919) % 400000, Data.Num() - Offset);
+			Writer->Serialize((void*)(Data.GetData() + Offset), Size);
+			Offset += Size;
+		}
+		TestEqual(TEXT("Background writer size"), Writer->TotalSize(), (int64)Data.Num());
+
+		Writer->Seek(PatchOffset);
+		Writer->Serialize((void*)Patch, sizeof(Patch));
+		Writer->Seek(Data.Num());
+		TestTrue(TEXT("Background writer closes"), Writer->Close());
+	}
+
+	TArray<uint8> Expected = Data;
+	FMemory::Memcpy(Expected.GetData() + PatchOffset, Patch, sizeof(Patch));
+
+	// Sequential reads start the reads ahead, seeks forward into them, back into the buffer and far away must all read the right bytes
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Readahead));
+		if (!TestNotNull(TEXT("Readahead reader opens"), Reader.Get()))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Readahead reader size"), Reader->TotalSize(), (int64)Expected.Num());
+
+		TArray<uint8> ReadData;
+		ReadData.SetNumZeroed(Expected.Num());
+		int64 Offset = 0;
+		for (int32 ReadIndex = 0; Offset < Expected.Num() && !Reader->IsError(); ++ReadIndex)
+		{
+			if (ReadIndex % 50 == 49)
+			{
+				// Skip ahead, then re-read what was skipped
+				const int64 SkipTo = FMath::Min<int64>(Offset + 100000, Expected.Num());
+				Reader->Seek(SkipTo);
+				Reader->Serialize(ReadData.GetData() + SkipTo, FMath::Min<int64>(10, Expected.Num() - SkipTo));
+				Reader->Seek(Offset);
+			}
+			else if (ReadIndex % 17 == 16 && Offset > 16)
+			{
+				Reader->Seek(Offset - 16);
+				Offset -= 16;
+			}
+
+			const int64 Size = FMath::Min<int64>(1 + (ReadIndex * 104729) % 20000, Expected.Num() - Offset);
+			Reader->Serialize(ReadData.GetData() + Offset, Size);
+			Offset += Size;
+			TestEqual(TEXT("Readahead reader position"), Reader->Tell(), Offset);
+		}
+		TestFalse(TEXT("Readahead reader has no error"), Reader->IsError());
+		TestTrue(TEXT("Readahead reader reads the written data"), FMemory::Memcmp(ReadData.GetData(), Expected.GetData(), Expected.Num()) == 0);
+	}
+
+	IFileManager::Get().Delete(*Filename);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/IPlatformFileLocalCacheWrapper.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Templates/UniquePtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4LocalCachePlatformFileTest_Private
+{
+	static TArray<uint8> MakeTestData(int32 Size, uint8 Seed)
+	{
+		TArray<uint8> Data;
+		Data.SetNumUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			Data[Index] = (uint8)(Index * 31 + (Index >> 8) + Seed);
+		}
+		return Data;
+	}
+
+	static bool WriteFile(IPlatformFile& PlatformFile, const FString& Filename, const TArray<uint8>& Data)
+	{
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*Filename));
+		return Handle && Handle->Write(Data.GetData(), Data.Num());
+	}
+
+	/** Reads the file through the wrapper, a range in the middle first and then all of it */
+	static bool ReadFile(IPlatformFile& PlatformFile, const FString& Filename, TArray<uint8>& OutData)
+	{
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*Filename));
+		if (!Handle)
+		{
+			return false;
+		}
+		OutData.SetNumZeroed(Handle->Size());
+		const int64 MiddleOffset = OutData.Num() / 3;
+		const int64 MiddleSize = FMath::Min<int64>(5000, OutData.Num() - MiddleOffset);
+		return Handle->Seek(MiddleOffset) && Handle->Read(OutData.GetData() + MiddleOffset, MiddleSize) &&
+			Handle->Seek(0) && Handle->Read(OutData.GetData(), OutData.Num()) &&
+			!Handle->Read(OutData.GetData(), 1);
+	}
+
+	static int32 CountCacheFiles(IPlatformFile& PlatformFile, const FString& CacheDir)
+	{
+		int32 Count = 0;
+		PlatformFile.IterateDirectory(*CacheDir, [&Count](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+		{
+			Count += !bIsDirectory && FString(FilenameOrDirectory).EndsWith(TEXT(".blocks"));
+			return true;
+		});
+		return Count;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocalCachePlatformFileTest, "System.Core.HAL.LocalCachePlatformFile", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLocalCachePlatformFileTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4LocalCachePlatformFileTest_Private;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString TestDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("LocalCachePlatformFileTest"));
+	const FString CacheDir = TestDir / TEXT("Cache");
+	const FString SourceFilename = TestDir / TEXT("Source.bin");
+	const FString CmdLine = FString::Printf(TEXT("-LocalCache -LocalCacheDir=\"%s\" -LocalCacheBlockKB=4 -LocalCacheSizeMB=1 -LocalCachePaths=\"%s\""), *CacheDir, *TestDir);
+	PlatformFile.DeleteDirectoryRecursively(*TestDir);
+	PlatformFile.CreateDirectoryTree(*TestDir);
+
+	const TArray<uint8> Data = MakeTestData(3 * 4096 + 100, 0);
+	if (!TestTrue(TEXT("Source file is written"), WriteFile(PlatformFile, SourceFilename, Data)))
+	{
+		return false;
+	}
+
+	// Blocks read in one run are found by the next
+	TArray<uint8> ReadData;
+	{
+		FLocalCachePlatformFile LocalCache;
+		TestTrue(TEXT("Local cache initializes"), LocalCache.Initialize(&PlatformFile, *CmdLine));
+		TestTrue(TEXT("Uncached file reads"), ReadFile(LocalCache, SourceFilename, ReadData) && ReadData == Data);
+		TestTrue(TEXT("Cached file reads"), ReadFile(LocalCache, SourceFilename, ReadData) && ReadData == Data);
+		LocalCache.SaveIndexIfDirty();
+	}
+	TestEqual(TEXT("Read file has a cache file"), CountCacheFiles(PlatformFile, CacheDir), 1);
+	{
+		FLocalCachePlatformFile LocalCache;
+		LocalCache.Initialize(&PlatformFile, *CmdLine);
+		TestEqual(TEXT("Cache file is kept across runs"), CountCacheFiles(PlatformFile, CacheDir), 1);
+		TestTrue(TEXT("File cached by the previous run reads"), ReadFile(LocalCache, SourceFilename, ReadData) && ReadData == Data);
+
+		// A file that changed must never be read from the copy of its previous version
+		const TArray<uint8> ChangedData = MakeTestData(2 * 4096 + 7, 1);
+		WriteFile(PlatformFile, SourceFilename, ChangedData);
+		TestTrue(TEXT("Changed file reads"), ReadFile(LocalCache, SourceFilename, ReadData) && ReadData == ChangedData);
+		TestEqual(TEXT("Changed file has its own cache file"), CountCacheFiles(PlatformFile, CacheDir), 2);
+
+		// Going over the budget deletes what was opened least recently once it is closed
+		const TArray<uint8> LargeData = MakeTestData(1024 * 1024 + 4096, 2);
+		WriteFile(PlatformFile, SourceFilename, LargeData);
+		TestTrue(TEXT("File larger than the cache reads"), ReadFile(LocalCache, SourceFilename, ReadData) && ReadData == LargeData);
+		TestEqual(TEXT("Cache is trimmed to its budget"), CountCacheFiles(PlatformFile, CacheDir), 0);
+	}
+
+	PlatformFile.DeleteDirectoryRecursively(*TestDir);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/MallocCountingProxy.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocCountingProxyTest, "System.Core.HAL.MallocCountingProxy", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FMallocCountingProxyTest::RunTest(const FString& Parameters)
+{
+	if (!FMallocCountingProxy::Enable())
+	{
+		AddInfo(TEXT("GMalloc can't be wrapped on this platform"));
+		return true;
+	}
+
+	const FMallocThreadCounts Start = FMallocCountingProxy::GetThreadCounts();
+	void* A = FMemory::Malloc(100);
+	void* B = FMemory::Realloc(nullptr, 50);
+	B = FMemory::Realloc(B, 20);
+	FMemory::Free(A);
+	FMemory::Free(B);
+	FMemory::Free(nullptr);
+	const FMallocThreadCounts Counts = FMallocCountingProxy::GetThreadCounts() - Start;
+
+	TestEqual(TEXT("Mallocs and Reallocs from nullptr are allocations"), Counts.NumAllocations, (uint64)2);
+	TestEqual(TEXT("Shrinking Realloc is a reallocation"), Counts.NumReallocations, (uint64)1);
+	TestEqual(TEXT("Frees of nullptr are not counted"), Counts.NumFrees, (uint64)2);
+	TestEqual(TEXT("Requested bytes"), Counts.AllocatedBytes, (uint64)150);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
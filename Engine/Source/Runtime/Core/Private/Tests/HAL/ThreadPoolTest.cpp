@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/IQueuedWork.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Function.h"
+
+namespace UE4ThreadPoolTest_Private
+{
+	class FTestWork : public IQueuedWork
+	{
+	public:
+		FTestWork(TFunction<void()>&& InFunction, FThreadSafeCounter& InNumAbandoned)
+			: Function(MoveTemp(InFunction))
+			, NumAbandoned(InNumAbandoned)
+		{
+		}
+
+		virtual void DoThreadedWork() override
+		{
+			Function();
+			delete this;
+		}
+
+		virtual void Abandon() override
+		{
+			NumAbandoned.Increment();
+			delete this;
+		}
+
+	private:
+		TFunction<void()> Function;
+		FThreadSafeCounter& NumAbandoned;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FThreadPoolTest, "System.Core.HAL.ThreadPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FThreadPoolTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4ThreadPoolTest_Private;
+
+	FThreadSafeCounter NumAbandoned;
+
+	// A single thread kept busy, so everything else queues up behind it
+	{
+		FQueuedThreadPool* Pool = FQueuedThreadPool::Allocate();
+		verify(Pool->Create(1, 64 * 1024));
+
+		FEvent* Started = FPlatformProcess::GetSynchEventFromPool(true);
+		FEvent* Release = FPlatformProcess::GetSynchEventFromPool(true);
+		FCriticalSection OrderLock;
+		TArray<int32> Order;
+		FThreadSafeCounter NumDone;
+
+		Pool->AddQueuedWork(new FTestWork([Started, Release]() { Started->Trigger(); Release->Wait(); }, NumAbandoned));
+		Started->Wait();
+
+		const EQueuedWorkPriority Priorities[] = { EQueuedWorkPriority::Lowest, EQueuedWorkPriority::Normal, EQueuedWorkPriority::Highest, EQueuedWorkPriority::Normal, EQueuedWorkPriority::High };
+		IQueuedWork* Retracted = nullptr;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Priorities); ++Index)
+		{
+			IQueuedWork* Work = new FTestWork([Index, &OrderLock, &Order, &NumDone]() { FScopeLock Lock(&OrderLock); Order.Add(Index); NumDone.Increment(); }, NumAbandoned);
+			Pool->AddQueuedWork(Work, Priorities[Index]);
+			if (Index == 3)
+			{
+				Retracted = Work;
+			}
+		}
+
+		TestTrue(TEXT("Queued work can be retracted"), Pool->RetractQueuedWork(Retracted));
+		TestFalse(TEXT("Retracted work can not be retracted again"), Pool->RetractQueuedWork(Retracted));
+		delete Retracted;
+
+		Release->Trigger();
+		while (NumDone.GetValue() < UE_ARRAY_COUNT(Priorities) - 1)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestTrue(TEXT("Work starts in priority order"), Order == TArray<int32>({ 2, 4, 1, 0 }));
+
+		Pool->Destroy();
+		delete Pool;
+		FPlatformProcess::ReturnSynchEventToPool(Started);
+		FPlatformProcess::ReturnSynchEventToPool(Release);
+	}
+
+	// Many small jobs from several producers at once
+	{
+		FQueuedThreadPool* Pool = FQueuedThreadPool::Allocate();
+		verify(Pool->Create(4, 64 * 1024));
+
+		const int32 NumProducers = 4;
+		const int32 NumJobsPerProducer = 10000;
+		FThreadSafeCounter NumDone;
+		FThreadSafeCounter NumProducersDone;
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			// The producers run on the pool too, the jobs they add queue behind them
+			Pool->AddQueuedWork(new FTestWork([Pool, Producer, &NumDone, &NumProducersDone, &NumAbandoned]()
+			{
+				for (int32 Index = 0; Index < NumJobsPerProducer; ++Index)
+				{
+					const EQueuedWorkPriority Priority = (EQueuedWorkPriority)((Producer + Index) % (int32)EQueuedWorkPriority::Count);
+					Pool->AddQueuedWork(new FTestWork([&NumDone]() { NumDone.Increment(); }, NumAbandoned), Priority);
+				}
+				NumProducersDone.Increment();
+			}, NumAbandoned), EQueuedWorkPriority::Highest);
+		}
+
+		while (NumProducersDone.GetValue() < NumProducers || NumDone.GetValue() < NumProducers * NumJobsPerProducer)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestEqual(TEXT("Every job ran"), NumDone.GetValue(), NumProducers * NumJobsPerProducer);
+
+		Pool->Destroy();
+		delete Pool;
+	}
+
+	TestEqual(TEXT("No work was abandoned"), NumAbandoned.GetValue(), 0);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Hash/xxhash.h"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Crc.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXxHashTest, "System.Core.Hash.XxHash", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FXxHashTest::RunTest(const FString& Parameters)
+{
+	// Values of the reference XXH3_64bits and XXH3_128bits, covering each of the size classes
+	uint8 Bytes[512];
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Bytes); ++Index)
+	{
+		Bytes[Index] = (uint8)Index;
+	}
+	const ANSICHAR* Alphabet = "abcdefghijklmnopqrstuvwxyz";
+
+	TestEqual(TEXT("XXH3 64 of nothing"), FXxHash64::HashBuffer(nullptr, 0).Hash, 0x2d06800538d394c2ULL);
+	TestEqual(TEXT("XXH3 64 of 3 bytes"), FXxHash64::HashBuffer(Alphabet, 3).Hash, 0x78af5f94892f3950ULL);
+	TestEqual(TEXT("XXH3 64 of 26 bytes"), FXxHash64::HashBuffer(Alphabet, 26).Hash, 0x810f9ca067fbb90cULL);
+	TestEqual(TEXT("XXH3 64 of 512 bytes"), FXxHash64::HashBuffer(Bytes, sizeof(Bytes)).Hash, 0x1059105ad19bfa09ULL);
+
+	const FXxHash128 Hash128 = FXxHash128::HashBuffer(Alphabet, 26);
+	TestTrue(TEXT("XXH3 128 of 26 bytes"), Hash128.HashLow == 0xebe162220154e1e6ULL && Hash128.HashHigh == 0xdb7ca44e84843d67ULL);
+	const FXxHash128 Long128 = FXxHash128::HashBuffer(Bytes, sizeof(Bytes));
+	TestTrue(TEXT("XXH3 128 of 512 bytes"), Long128.HashLow == 0x1059105ad19bfa09ULL && Long128.HashHigh == 0x111d5771df64cbcbULL);
+
+	// The builders give the same values whichever way the data is split
+	FRandomStream Random(0x5EED);
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(4096);
+	for (uint8& Byte : Data)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	bool bBuildersMatch = true;
+	for (int32 Size : { 0, 1, 17, 240, 241, 256, 257, 1024, 1025, 4096 })
+	{
+		FXxHash64Builder Builder64;
+		FXxHash128Builder Builder128;
+		for (int32 Offset = 0; Offset < Size;)
+		{
+			const int32 PartSize = FMath::Min(Size - Offset, Random.RandRange(0, 300));
+			Builder64.Update(Data.GetData() + Offset, PartSize);
+			Builder128.Update(Data.GetData() + Offset, PartSize);
+			Offset += PartSize;
+		}
+		bBuildersMatch &= Builder64.Finalize() == FXxHash64::HashBuffer(Data.GetData(), Size);
+		bBuildersMatch &= Builder128.Finalize() == FXxHash128::HashBuffer(Data.GetData(), Size);
+	}
+	TestTrue(TEXT("Builders match hashing the whole buffer"), bBuildersMatch);
+
+	// The CRC-32C check value, computed in one go and in parts
+	TestEqual(TEXT("CRC-32C check value"), FCrc::MemCrc32C("123456789", 9), 0xe3069283U);
+	TestEqual(TEXT("CRC-32C continues from a previous value"), FCrc::MemCrc32C(Data.GetData() + 1000, Data.Num() - 1000, FCrc::MemCrc32C(Data.GetData(), 1000)), FCrc::MemCrc32C(Data.GetData(), Data.Num()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXxHashPerfTest, "System.Core.Hash.XxHash.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FXxHashPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 BytesPerSize = 256 << 20;
+
+	FRandomStream Random(0x5EED);
+	TArray<uint8> Data;
+	Data.SetNumUninitialized((1 << 20) + 64);
+	for (uint8& Byte : Data)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	for (int32 Size : { 16, 64, 256, 4096, 1 << 20 })
+	{
+		const int32 NumIterations = (int32)(BytesPerSize / Size);
+		auto Measure = [&Data, Size, NumIterations](auto Hash)
+		{
+			uint64 Checksum = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Checksum += Hash(Data.GetData() + (Iteration & 63), Size);
+			}
+			const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 1e-9);
+			return FString::Printf(TEXT("%.0f MB/s (%llx)"), BytesPerSize / (Seconds * 1024.0 * 1024.0), Checksum & 0xF);
+		};
+
+		const FString Crc32 = Measure([](const uint8* Bytes, int32 Num) { return (uint64)FCrc::MemCrc32(Bytes, Num); });
+		const FString Crc32C = Measure([](const uint8* Bytes, int32 Num) { return (uint64)FCrc::MemCrc32C(Bytes, Num); });
+		const FString City64 = Measure([](const uint8* Bytes, int32 Num) { return CityHash64((const char*)Bytes, Num); });
+		const FString Xx64 = Measure([](const uint8* Bytes, int32 Num) { return FXxHash64::HashBuffer(Bytes, Num).Hash; });
+		const FString Xx128 = Measure([](const uint8* Bytes, int32 Num) { return FXxHash128::HashBuffer(Bytes, Num).HashLow; });
+		AddInfo(FString::Printf(TEXT("%d bytes: MemCrc32 %s, MemCrc32C %s, CityHash64 %s, XxHash64 %s, XxHash128 %s"), Size, *Crc32, *Crc32C, *City64, *Xx64, *Xx128));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Internationalization/FastDecimalFormat.h"
+#include "Internationalization/Internationalization.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/StringBuilder.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFastDecimalFormatTest, "System.Core.Misc.FastDecimalFormat", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FFastDecimalFormatTest::RunTest(const FString& Parameters)
+{
+	const FDecimalNumberFormattingRules& Rules = FastDecimalFormat::GetCultureAgnosticFormattingRules();
+
+	auto TestNumber = [this, &Rules](const double InValue, const FNumberFormattingOptions& InOptions, const TCHAR* InExpected)
+	{
+		const FString Result = FastDecimalFormat::NumberToString(InValue, Rules, InOptions);
+		if (Result != InExpected)
+		{
+			AddError(FString::Printf(TEXT("Formatting %.17g - expected '%s' - result '%s'"), InValue, InExpected, *Result));
+		}
+
+		TStringBuilder<64> Builder;
+		Builder.Append(TEXT("x"));
+		FastDecimalFormat::NumberToString(InValue, Rules, InOptions, Builder);
+		if (FString(Builder.ToString()) != FString(TEXT("x")) + Result)
+		{
+			AddError(FString::Printf(TEXT("Formatting %.17g into a string builder - expected 'x%s' - result '%s'"), InValue, *Result, Builder.ToString()));
+		}
+	};
+
+	const FNumberFormattingOptions Shortest = FNumberFormattingOptions().SetUseGrouping(false).SetMaximumFractionalDigits(18);
+	TestNumber(0.1, Shortest, TEXT("0.1"));
+	TestNumber(0.1 + 0.2, Shortest, TEXT("0.30000000000000004"));
+	TestNumber(-1234.5, Shortest, TEXT("-1234.5"));
+	TestNumber(1e-18, Shortest, TEXT("0.000000000000000001"));
+	TestNumber(1e-19, Shortest, TEXT("0"));
+	TestNumber(1e21, Shortest, TEXT("1000000000000000000000"));
+
+	// Rounding applies to the decimal the value reads as, rather than to the double just below it
+	const FNumberFormattingOptions OneDigit = FNumberFormattingOptions().SetMaximumFractionalDigits(1);
+	TestNumber(0.15, OneDigit, TEXT("0.2"));
+	TestNumber(0.25, OneDigit, TEXT("0.2"));
+	TestNumber(999999.96, OneDigit, TEXT("1,000,000"));
+	TestNumber(-0.04, FNumberFormattingOptions(OneDigit).SetRoundingMode(ERoundingMode::ToNegativeInfinity), TEXT("-0.1"));
+	TestNumber(12.5, FNumberFormattingOptions(OneDigit).SetMinimumFractionalDigits(3), TEXT("12.500"));
+
+	TestNumber(FMath::Sqrt(-1.0), Shortest, TEXT("NaN"));
+	TestNumber(-TNumericLimits<double>::Max() * 2.0, Shortest, TEXT("-\u221E"));
+
+	// The culture formatter matches FText::AsNumber, AsPercent and AsCurrency
+	{
+		FInternationalization& I18N = FInternationalization::Get();
+
+		FInternationalization::FCultureStateSnapshot OriginalCultureState;
+		I18N.BackupCultureState(OriginalCultureState);
+		I18N.SetCurrentCulture(TEXT("en-US"));
+
+		const FCultureNumberFormatter Formatter;
+		TStringBuilder<128> Builder;
+		Formatter.AppendNumber(Builder, 12345.678);
+		Builder.Append(TEXT(" "));
+		Formatter.AppendNumber(Builder, -42);
+		Builder.Append(TEXT(" "));
+		Formatter.AppendPercent(Builder, 0.5f);
+		Builder.Append(TEXT(" "));
+		Formatter.AppendCurrency(Builder, 9.99, TEXT("USD"));
+
+		const FString Expected = FText::AsNumber(12345.678).ToString() + TEXT(" ") + FText::AsNumber(-42).ToString() + TEXT(" ") + FText::AsPercent(0.5f).ToString() + TEXT(" ") + FText::AsCurrency(9.99, TEXT("USD")).ToString();
+		TestEqual(TEXT("Culture formatter output"), FString(Builder.ToString()), Expected);
+
+		I18N.RestoreCultureState(OriginalCultureState);
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Logging/DeferredLogMessage.h"
+#include "Misc/AutomationTest.h"
+#include "ProfilingDebugging/FormatArgsTrace.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDeferredLogMessageTest, "System.Core.Logging.DeferredLogMessage", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+template <typename FmtType, typename... Types>
+static FString FormatDeferred(const FmtType& Fmt, Types... Args)
+{
+	uint8 EncodedArgs[1024];
+	FFormatArgsTrace::EncodeVarArgs(EncodedArgs, Args...);
+
+	FString Result;
+	FDeferredLogMessage::FormatMessage(Result, Fmt, EncodedArgs);
+	return Result;
+}
+
+/** Deferred messages must read the same as the ones formatted eagerly by UE_LOG. */
+bool FDeferredLogMessageTest::RunTest(const FString& Parameters)
+{
+	#define TEST_SAME_AS_PRINTF(Format, ...) TestEqual(Format, FormatDeferred(Format, ##__VA_ARGS__), FString::Printf(Format, ##__VA_ARGS__))
+
+	TEST_SAME_AS_PRINTF(TEXT("No arguments"));
+	TEST_SAME_AS_PRINTF(TEXT("100%% literal"));
+	TEST_SAME_AS_PRINTF(TEXT("[%d] [%5d] [%-5d] [%05d]"), 42, -42, 42, 42);
+	TEST_SAME_AS_PRINTF(TEXT("[%u] [%x] [%X] [%08x]"), MAX_uint32, 0xbeefu, 0xbeefu, 0xbeefu);
+	TEST_SAME_AS_PRINTF(TEXT("[%lld] [%llu] [%llx]"), MIN_int64, MAX_uint64, 0x123456789abcull);
+	TEST_SAME_AS_PRINTF(TEXT("[%d] [%d] [%c]"), (int8)-3, (uint16)65535, TEXT('x'));
+	TEST_SAME_AS_PRINTF(TEXT("[%f] [%.2f] [%8.3f] [%g] [%e]"), 1.5f, 3.14159, -2.5f, 1e-10, 12345.678);
+	TEST_SAME_AS_PRINTF(TEXT("[%s] [%10s] [%-10s]"), TEXT("Str"), TEXT("Right"), TEXT("Left"));
+	TEST_SAME_AS_PRINTF(TEXT("[%*d] [%.*f]"), 6, 42, 3, 2.0);
+	TEST_SAME_AS_PRINTF(TEXT("[%p]"), (void*)this);
+	TEST_SAME_AS_PRINTF(TEXT("%s=%d, %s=%.1f, %s"), TEXT("Int"), 1, TEXT("Float"), 0.5f, TEXT("the end"));
+
+	#undef TEST_SAME_AS_PRINTF
+
+	TestEqual(TEXT("ANSI strings are widened"), FormatDeferred(TEXT("[%s]"), "Ansi"), FString(TEXT("[Ansi]")));
+	TestEqual(TEXT("Conversions without arguments are kept"), FormatDeferred(TEXT("%d and %d"), 1), FString(TEXT("1 and %d")));
+	TestEqual(TEXT("Trailing percent is kept"), FormatDeferred(TEXT("Half %"), 1), FString(TEXT("Half %")));
+
+	// the text is cached by the message
+	uint8 EncodedArgs[64];
+	const uint16 EncodedArgsSize = FFormatArgsTrace::EncodeVarArgs(EncodedArgs, 7, TEXT("seven"));
+	const FDeferredLogMessage Message(TEXT("%d is %s"), EncodedArgs, EncodedArgsSize, ELogVerbosity::Log, NAME_None);
+	const TCHAR* Text = Message.GetText();
+	TestEqual(TEXT("Message text"), FString(Text), FString(TEXT("7 is seven")));
+	TestTrue(TEXT("Message is only formatted once"), Text == Message.GetText());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
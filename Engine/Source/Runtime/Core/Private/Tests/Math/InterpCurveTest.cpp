@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Math/BakedInterpCurve.h"
+
+#include "Math/InterpCurve.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterpCurveTest, "System.Core.Math.InterpCurve", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FInterpCurveTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Random(1234);
+
+	FInterpCurveFloat Curve;
+	for (int32 Index = 0; Index < 20; ++Index)
+	{
+		const int32 PointIndex = Curve.AddPoint(float(Index) + Random.FRandRange(0.f, 0.5f), Random.FRandRange(-10.f, 10.f));
+		Curve.Points[PointIndex].InterpMode = Index % 5 == 0 ? CIM_Linear : CIM_CurveAuto;
+	}
+	Curve.AutoSetTangents();
+
+	// The evaluator matches Eval going forward in small and large steps, backwards and at the points themselves
+	{
+		FInterpCurveFloat CurveWithDuplicate = Curve;
+		CurveWithDuplicate.AddPoint(Curve.Points[7].InVal, 3.f);
+
+		TInterpCurveEvaluator<float> Evaluator(CurveWithDuplicate);
+		bool bMatches = true;
+		for (float InVal = -1.f; InVal < 22.f; InVal += 0.03f)
+		{
+			bMatches &= Evaluator.Eval(InVal) == CurveWithDuplicate.Eval(InVal);
+		}
+		for (float InVal = 22.f; InVal > -1.f; InVal -= 0.7f)
+		{
+			bMatches &= Evaluator.Eval(InVal) == CurveWithDuplicate.Eval(InVal);
+		}
+		for (const FInterpCurvePoint<float>& Point : CurveWithDuplicate.Points)
+		{
+			bMatches &= Evaluator.Eval(Point.InVal) == CurveWithDuplicate.Eval(Point.InVal);
+		}
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			const float InVal = Random.FRandRange(-1.f, 22.f);
+			bMatches &= Evaluator.Eval(InVal) == CurveWithDuplicate.Eval(InVal);
+		}
+		TestTrue(TEXT("Evaluator matches Eval"), bMatches);
+	}
+
+	// EvalMany on a looped curve, the loop segment included
+	{
+		FInterpCurveFloat LoopedCurve = Curve;
+		LoopedCurve.SetLoopKey(LoopedCurve.Points.Last().InVal + 2.f);
+
+		TArray<float> InVals;
+		for (float InVal = -1.f; InVal < 25.f; InVal += 0.1f)
+		{
+			InVals.Add(InVal);
+		}
+		TArray<float> OutVals;
+		OutVals.SetNumUninitialized(InVals.Num());
+		LoopedCurve.EvalMany(InVals, OutVals);
+
+		bool bMatches = true;
+		for (int32 Index = 0; Index < InVals.Num(); ++Index)
+		{
+			bMatches &= OutVals[Index] == LoopedCurve.Eval(InVals[Index]);
+		}
+		TestTrue(TEXT("EvalMany matches Eval"), bMatches);
+	}
+
+	// Baked curves are close to the curve at any input, and exact at the samples
+	{
+		const TBakedInterpCurve<float> Baked(Curve, 4096);
+		TestEqual(TEXT("Baked first sample"), Baked.Eval(-5.f), Curve.Points[0].OutVal);
+		TestEqual(TEXT("Baked last sample"), Baked.Eval(50.f), Curve.Points.Last().OutVal);
+
+		TArray<float> InVals;
+		for (int32 Index = 0; Index < 1001; ++Index)
+		{
+			InVals.Add(Random.FRandRange(-1.f, 22.f));
+		}
+		TArray<float> OutVals;
+		OutVals.SetNumUninitialized(InVals.Num());
+		Baked.EvalMany(InVals, OutVals);
+
+		float MaxError = 0.f;
+		float MaxBatchDifference = 0.f;
+		for (int32 Index = 0; Index < InVals.Num(); ++Index)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(Baked.Eval(InVals[Index]) - Curve.Eval(InVals[Index])));
+			MaxBatchDifference = FMath::Max(MaxBatchDifference, FMath::Abs(OutVals[Index] - Baked.Eval(InVals[Index])));
+		}
+		TestTrue(TEXT("Baked curve is close to the curve"), MaxError < 0.1f);
+		TestTrue(TEXT("Baked EvalMany matches Eval"), MaxBatchDifference < KINDA_SMALL_NUMBER);
+
+		FInterpCurveVector VectorCurve;
+		VectorCurve.AddPoint(0.f, FVector(0.f, 1.f, 2.f));
+		VectorCurve.AddPoint(1.f, FVector(3.f, 4.f, 5.f));
+		const TBakedInterpCurve<FVector> BakedVector(VectorCurve, 3);
+		TestEqual(TEXT("Baked vector curve"), BakedVector.Eval(0.25f), VectorCurve.Eval(0.25f));
+
+		FInterpCurveFloat SinglePointCurve;
+		SinglePointCurve.AddPoint(1.f, 7.f);
+		TestEqual(TEXT("Baked single point"), TBakedInterpCurve<float>(SinglePointCurve, 16).Eval(0.f), 7.f);
+		TestEqual(TEXT("Baked empty curve"), TBakedInterpCurve<float>(FInterpCurveFloat(), 16).Eval(0.f, 2.f), 2.f);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Math/SpatialAcceleration.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4SpatialAccelerationTest_Private
+{
+	struct FTestElement
+	{
+		FBox Box;
+		int32 Id;
+	};
+
+	struct FTestSemantics
+	{
+		static FBox GetBoundingBox(const FTestElement& Element)
+		{
+			return Element.Box;
+		}
+	};
+
+	static FTestElement MakeElement(FRandomStream& Random, int32 Id)
+	{
+		const FVector Center(Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f));
+		// Mostly small, a few that span many cells
+		const float Size = Random.FRand() < 0.02f ? 400.0f : Random.FRandRange(1.0f, 40.0f);
+		return { FBox(Center - FVector(Size), Center + FVector(Size)), Id };
+	}
+
+	/** Runs the same queries on both structures and compares the ids they found with a brute force search over Elements */
+	template<typename StructureType>
+	static bool CheckQueries(FAutomationTestBase& Test, const TCHAR* Name, const StructureType& Structure, const TArray<FTestElement>& Elements, FRandomStream& Random)
+	{
+		bool bAllMatch = true;
+		for (int32 QueryIndex = 0; QueryIndex < 64; ++QueryIndex)
+		{
+			const FTestElement Query = MakeElement(Random, INDEX_NONE);
+			const FSphere Sphere(Query.Box.GetCenter(), Random.FRandRange(10.0f, 200.0f));
+			const FRay Ray(Query.Box.GetCenter(), Random.VRand(), true);
+
+			TSet<int32> ExpectedBox, ExpectedSphere, ExpectedRay, FoundBox, FoundSphere, FoundRay;
+			for (const FTestElement& Element : Elements)
+			{
+				if (Element.Box.Intersect(Query.Box))
+				{
+					ExpectedBox.Add(Element.Id);
+				}
+				if (FMath::SphereAABBIntersection(Sphere, Element.Box))
+				{
+					ExpectedSphere.Add(Element.Id);
+				}
+				if (Element.Box.IsInside(Ray.Origin) || FMath::LineBoxIntersection(Element.Box, Ray.Origin, Ray.PointAt(5000.0f), Ray.Direction * 5000.0f))
+				{
+					ExpectedRay.Add(Element.Id);
+				}
+			}
+
+			Structure.FindElementsInBox(Query.Box, [&FoundBox](const FTestElement& Element) { FoundBox.Add(Element.Id); });
+			Structure.FindElementsInSphere(Sphere, [&FoundSphere](const FTestElement& Element) { FoundSphere.Add(Element.Id); });
+			Structure.FindElementsAlongRay(Ray, 5000.0f, [&FoundRay](const FTestElement& Element, float EntryDistance) { FoundRay.Add(Element.Id); return 5000.0f; });
+
+			// Elements that touch the query within float precision may go either way, allow a few
+			const int32 RayMismatches = ExpectedRay.Difference(FoundRay).Num() + FoundRay.Difference(ExpectedRay).Num();
+			bAllMatch &= ExpectedBox.Num() == FoundBox.Num() && ExpectedBox.Includes(FoundBox);
+			bAllMatch &= ExpectedSphere.Num() == FoundSphere.Num() && ExpectedSphere.Includes(FoundSphere);
+			bAllMatch &= RayMismatches <= 1;
+
+			// The closest hit query finds the same distance as the minimum over all the hits
+			float MinEntryDistance = MAX_flt;
+			Structure.FindElementsAlongRay(Ray, 5000.0f, [&MinEntryDistance](const FTestElement& Element, float EntryDistance) { MinEntryDistance = FMath::Min(MinEntryDistance, EntryDistance); return 5000.0f; });
+			float ClosestDistance = MAX_flt;
+			Structure.FindElementsAlongRay(Ray, 5000.0f, [&ClosestDistance](const FTestElement& Element, float EntryDistance) { ClosestDistance = FMath::Min(ClosestDistance, EntryDistance); return EntryDistance; });
+			bAllMatch &= FMath::IsNearlyEqual(ClosestDistance, MinEntryDistance, 1e-2f);
+		}
+
+		Test.TestTrue(FString::Printf(TEXT("%s queries match a brute force search"), Name), bAllMatch);
+		return bAllMatch;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialAccelerationTest, "System.Core.Math.SpatialAcceleration", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FSpatialAccelerationTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4SpatialAccelerationTest_Private;
+
+	FRandomStream Random(0x5EED);
+	TArray<FTestElement> Elements;
+	for (int32 Index = 0; Index < 10000; ++Index)
+	{
+		Elements.Add(MakeElement(Random, Index));
+	}
+
+	// Large enough for the parallel build
+	TBoundingVolumeHierarchy<FTestElement, FTestSemantics> Hierarchy;
+	Hierarchy.Build(Elements);
+	TestEqual(TEXT("Hierarchy has every element"), Hierarchy.Num(), Elements.Num());
+	CheckQueries(*this, TEXT("Hierarchy"), Hierarchy, Elements, Random);
+
+	// Move some of the elements and refit
+	for (int32 Index = 0; Index < Elements.Num(); Index += 7)
+	{
+		Elements[Index].Box = Elements[Index].Box.ShiftBy(FVector(Random.FRandRange(-50.0f, 50.0f)));
+		Hierarchy.GetElement(Index) = Elements[Index];
+	}
+	Hierarchy.Refit();
+	CheckQueries(*this, TEXT("Refit hierarchy"), Hierarchy, Elements, Random);
+
+	TSpatialHashGrid<FTestElement, FTestSemantics> Grid(50.0f);
+	TArray<int32> GridIds;
+	Grid.AddElements(Elements, &GridIds);
+	CheckQueries(*this, TEXT("Grid"), Grid, Elements, Random);
+
+	// Move, then remove from the back so the remaining ids match the element indices
+	for (int32 Index = 0; Index < Elements.Num(); Index += 5)
+	{
+		Elements[Index].Box = Elements[Index].Box.ShiftBy(FVector(Random.FRandRange(-100.0f, 100.0f)));
+		Grid.UpdateElement(GridIds[Index], Elements[Index]);
+	}
+	for (int32 Index = Elements.Num() - 1; Index >= Elements.Num() / 2; --Index)
+	{
+		Grid.RemoveElement(GridIds[Index]);
+	}
+	Elements.SetNum(Elements.Num() / 2);
+	TestEqual(TEXT("Grid has the remaining elements"), Grid.Num(), Elements.Num());
+	CheckQueries(*this, TEXT("Updated grid"), Grid, Elements, Random);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -16,7 +16,10 @@
 #include "Math/RotationMatrix.h"
 #include "Math/Quat.h"
 #include "Math/QuatRotationTranslationMatrix.h"
+#include "Math/UnrealMathApprox.h"
 #include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/Function.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -2005,5 +2008,240 @@ bool FMathTruncationTests::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVectorRegister8Test, "System.Core.Math.VectorRegister8", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FVectorRegister8Test::RunTest(const FString& Parameters)
+{
+	MS_ALIGN(32) float A[8] GCC_ALIGN(32) = { 1.0f, -2.0f, 3.5f, 4.0f, -0.25f, 6.0f, 7.0f, 1000.0f };
+	MS_ALIGN(32) float B[8] GCC_ALIGN(32) = { 2.0f, 0.5f, -1.0f, 8.0f, 4.0f, -3.0f, 0.125f, 0.001f };
+	MS_ALIGN(32) float C[8] GCC_ALIGN(32) = { 0.5f, 1.0f, 2.0f, -4.0f, 8.0f, 16.0f, -32.0f, 64.0f };
+	MS_ALIGN(32) float Result[8] GCC_ALIGN(32);
+
+	const VectorRegister8 VecA = VectorLoadAligned8(A);
+	const VectorRegister8 VecB = VectorLoad8(B);
+	const VectorRegister8 VecC = VectorLoadAligned8(C);
+
+	auto TestOp = [this, &Result](const TCHAR* Name, const VectorRegister8& Vec, TFunctionRef<float(int32)> Expected)
+	{
+		VectorStoreAligned8(Vec, Result);
+		bool bEqual = true;
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			// FMA rounds once instead of twice, allow for it
+			const float ExpectedValue = Expected(Index);
+			bEqual = bEqual && FMath::IsNearlyEqual(Result[Index], ExpectedValue, FMath::Abs(ExpectedValue) * 1e-6f);
+		}
+		TestTrue(Name, bEqual);
+	};
+
+	TestOp(TEXT("VectorZero8"), VectorZero8(), [](int32) { return 0.0f; });
+	TestOp(TEXT("VectorSetFloat8"), VectorSetFloat8(3.0f), [](int32) { return 3.0f; });
+	TestOp(TEXT("VectorAdd8"), VectorAdd8(VecA, VecB), [&](int32 Index) { return A[Index] + B[Index]; });
+	TestOp(TEXT("VectorSubtract8"), VectorSubtract8(VecA, VecB), [&](int32 Index) { return A[Index] - B[Index]; });
+	TestOp(TEXT("VectorMultiply8"), VectorMultiply8(VecA, VecB), [&](int32 Index) { return A[Index] * B[Index]; });
+	TestOp(TEXT("VectorDivide8"), VectorDivide8(VecA, VecB), [&](int32 Index) { return A[Index] / B[Index]; });
+	TestOp(TEXT("VectorMultiplyAdd8"), VectorMultiplyAdd8(VecA, VecB, VecC), [&](int32 Index) { return A[Index] * B[Index] + C[Index]; });
+	TestOp(TEXT("VectorMin8"), VectorMin8(VecA, VecB), [&](int32 Index) { return FMath::Min(A[Index], B[Index]); });
+	TestOp(TEXT("VectorMax8"), VectorMax8(VecA, VecB), [&](int32 Index) { return FMath::Max(A[Index], B[Index]); });
+
+	float Unaligned[9];
+	VectorStore8(VecA, Unaligned + 1);
+	TestTrue(TEXT("VectorStore8"), FMemory::Memcmp(Unaligned + 1, A, sizeof(A)) == 0);
+
+	float ExpectedSum = 0.0f;
+	for (float Value : A)
+	{
+		ExpectedSum += Value;
+	}
+	TestTrue(TEXT("VectorHorizontalSum8"), FMath::IsNearlyEqual(VectorHorizontalSum8(VecA), ExpectedSum, 1e-3f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVectorRegister8PerfTest, "System.Core.Math.VectorRegister8.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FVectorRegister8PerfTest::RunTest(const FString& Parameters)
+{
+	// A batch kernel, Out = A * B + Out over a buffer that stays in cache, with 4 and 8 wide registers
+	constexpr int32 NumFloats = 4096;
+	constexpr int32 NumIterations = 4096;
+	TArray<float, TAlignedHeapAllocator<32>> A, B, Out;
+	A.SetNumUninitialized(NumFloats);
+	B.SetNumUninitialized(NumFloats);
+	Out.SetNumZeroed(NumFloats);
+	for (int32 Index = 0; Index < NumFloats; ++Index)
+	{
+		A[Index] = 1.0f + Index * 1e-4f;
+		B[Index] = 1.0f - Index * 1e-5f;
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < NumFloats; Index += 4)
+		{
+			VectorStoreAligned(VectorMultiplyAdd(VectorLoadAligned(&A[Index]), VectorLoadAligned(&B[Index]), VectorLoadAligned(&Out[Index])), &Out[Index]);
+		}
+	}
+	const double Seconds4 = FPlatformTime::Seconds() - StartTime;
+	const float Checksum4 = Out[NumFloats - 1];
+
+	FMemory::Memzero(Out.GetData(), NumFloats * sizeof(float));
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < NumFloats; Index += 8)
+		{
+			VectorStoreAligned8(VectorMultiplyAdd8(VectorLoadAligned8(&A[Index]), VectorLoadAligned8(&B[Index]), VectorLoadAligned8(&Out[Index])), &Out[Index]);
+		}
+	}
+	const double Seconds8 = FPlatformTime::Seconds() - StartTime;
+	const float Checksum8 = Out[NumFloats - 1];
+
+	const double NumOps = (double)NumFloats * NumIterations;
+	AddInfo(FString::Printf(TEXT("VectorMultiplyAdd: %.3f ns per float, VectorMultiplyAdd8: %.3f ns per float, %.2fx (AVX %d, FMA3 %d, checksums %f %f)"),
+		Seconds4 * 1e9 / NumOps, Seconds8 * 1e9 / NumOps, Seconds4 / FMath::Max(Seconds8, 1e-9), PLATFORM_ALWAYS_HAS_AVX, PLATFORM_ALWAYS_HAS_FMA3, Checksum4, Checksum8));
+
+	return true;
+}
+
+namespace UE4UnrealMathTest_Private
+{
+	/** Inputs for the approximations, spread over [Min, Max] or over its logarithm. Not a multiple of 4 so the tail is covered */
+	static TArray<float> MakeApproxInputs(float Min, float Max, bool bLogarithmic)
+	{
+		constexpr int32 NumInputs = 100003;
+		TArray<float> Inputs;
+		Inputs.SetNumUninitialized(NumInputs);
+		for (int32 Index = 0; Index < NumInputs; ++Index)
+		{
+			const double Alpha = (double)Index / (NumInputs - 1);
+			Inputs[Index] = (float)(bLogarithmic ? exp(FMath::Lerp(log((double)Min), log((double)Max), Alpha)) : FMath::Lerp((double)Min, (double)Max, Alpha));
+		}
+		return Inputs;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FApproxMathTest, "System.Core.Math.ApproxMath", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FApproxMathTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4UnrealMathTest_Private;
+
+	// Largest error of Results against the double precision Reference, relative to the reference or absolute where it is below AbsoluteBelow
+	auto TestError = [this](const TCHAR* Name, const TArray<float>& Inputs, const TArray<float>& Results, TFunctionRef<double(float)> Reference, double AbsoluteBelow, double MaxError)
+	{
+		double Error = 0.0;
+		for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+		{
+			const double Expected = Reference(Inputs[Index]);
+			Error = FMath::Max(Error, FMath::Abs((double)Results[Index] - Expected) / FMath::Max(FMath::Abs(Expected), AbsoluteBelow));
+		}
+		TestTrue(FString::Printf(TEXT("%s error %g is within %g"), Name, Error, MaxError), Error <= MaxError);
+	};
+
+	TArray<float> Results;
+	for (EApproxMathPrecision Precision : { EApproxMathPrecision::Fast, EApproxMathPrecision::Accurate })
+	{
+		const bool bFast = Precision == EApproxMathPrecision::Fast;
+
+		const TArray<float> Angles = MakeApproxInputs(-8192.0f, 8192.0f, false);
+		TArray<float> Cosines;
+		Results.SetNumUninitialized(Angles.Num());
+		Cosines.SetNumUninitialized(Angles.Num());
+		FApproxMath::SinCos(Angles, Results, Cosines, Precision);
+		TestError(TEXT("Sin"), Angles, Results, [](float X) { return sin((double)X); }, 1.0, bFast ? 1.5e-5 : 2e-7);
+		TestError(TEXT("Cos"), Angles, Cosines, [](float X) { return cos((double)X); }, 1.0, bFast ? 1.5e-5 : 2e-7);
+
+		// Atan2 of points on a spiral, so every octant and ratio is covered
+		TArray<float> Y, X;
+		Y.SetNumUninitialized(Angles.Num());
+		X.SetNumUninitialized(Angles.Num());
+		for (int32 Index = 0; Index < Angles.Num(); ++Index)
+		{
+			const float Radius = 1e-3f + Index * 1e-2f;
+			Y[Index] = Radius * FMath::Sin(Angles[Index]);
+			X[Index] = Radius * FMath::Cos(Angles[Index]);
+		}
+		FApproxMath::Atan2(Y, X, Results, Precision);
+		double AtanError = 0.0;
+		for (int32 Index = 0; Index < Angles.Num(); ++Index)
+		{
+			AtanError = FMath::Max(AtanError, FMath::Abs((double)Results[Index] - atan2((double)Y[Index], (double)X[Index])));
+		}
+		TestTrue(FString::Printf(TEXT("Atan2 error %g"), AtanError), AtanError <= (bFast ? 1.5e-5 : 5e-7));
+
+		const TArray<float> Exponents = MakeApproxInputs(-87.3f, 88.0f, false);
+		FApproxMath::Exp(Exponents, Results, Precision);
+		TestError(TEXT("Exp"), Exponents, Results, [](float X) { return exp((double)X); }, 0.0, bFast ? 1e-5 : 3e-7);
+
+		const TArray<float> Positives = MakeApproxInputs(1.5e-38f, 3e38f, true);
+		FApproxMath::Log(Positives, Results, Precision);
+		TestError(TEXT("Log"), Positives, Results, [](float X) { return log((double)X); }, 1.0, bFast ? 3e-5 : 2e-7);
+		FApproxMath::Sqrt(Positives, Results, Precision);
+		TestError(TEXT("Sqrt"), Positives, Results, [](float X) { return sqrt((double)X); }, 0.0, bFast ? 2e-5 : 5e-7);
+		FApproxMath::ReciprocalSqrt(Positives, Results, Precision);
+		TestError(TEXT("ReciprocalSqrt"), Positives, Results, [](float X) { return 1.0 / sqrt((double)X); }, 0.0, bFast ? 2e-5 : 5e-7);
+
+		const TArray<float> Bases = MakeApproxInputs(0.01f, 100.0f, true);
+		TArray<float> Gammas;
+		Gammas.Init(2.2f, Bases.Num());
+		FApproxMath::Pow(Bases, Gammas, Results, Precision);
+		TestError(TEXT("Pow"), Bases, Results, [](float X) { return pow((double)X, 2.2); }, 0.0, bFast ? 2e-4 : 3e-6);
+	}
+
+	// Edge cases the documentation promises
+	float Edges[4];
+	VectorStore(VectorApproxSqrt(VectorZero()), Edges);
+	TestTrue(TEXT("Sqrt(0) is 0"), Edges[0] == 0.0f);
+	VectorStore(VectorApproxAtan2(VectorZero(), VectorZero()), Edges);
+	TestTrue(TEXT("Atan2(0, 0) is 0"), Edges[0] == 0.0f);
+	VectorStore(VectorApproxExp(VectorSetFloat1(1000.0f)), Edges);
+	TestTrue(TEXT("Exp clamps its input"), FMath::IsFinite(Edges[0]));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FApproxMathPerfTest, "System.Core.Math.ApproxMath.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FApproxMathPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4UnrealMathTest_Private;
+
+	constexpr int32 NumIterations = 64;
+	const TArray<float> Angles = MakeApproxInputs(-100.0f, 100.0f, false);
+	const TArray<float> Exponents = MakeApproxInputs(-10.0f, 10.0f, false);
+	TArray<float> Results;
+	Results.SetNumUninitialized(Angles.Num());
+
+	// Nanoseconds per element of Body over the whole input
+	auto Time = [&Angles](TFunctionRef<void()> Body)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Body();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1e9 / ((double)Angles.Num() * NumIterations);
+	};
+
+	auto TimeVector = [&Results](const TArray<float>& Inputs, VectorRegister (*Function)(const VectorRegister&))
+	{
+		for (int32 Index = 0; Index + 4 <= Inputs.Num(); Index += 4)
+		{
+			VectorStore(Function(VectorLoad(&Inputs[Index])), &Results[Index]);
+		}
+	};
+
+	const double SinScalar = Time([&]() { for (int32 Index = 0; Index < Angles.Num(); ++Index) { Results[Index] = FMath::Sin(Angles[Index]); } });
+	const double SinVector = Time([&]() { TimeVector(Angles, [](const VectorRegister& V) { VectorRegister Sin, Cos; VectorSinCos(&Sin, &Cos, &V); return Sin; }); });
+	const double SinFast = Time([&]() { FApproxMath::Sin(Angles, Results, EApproxMathPrecision::Fast); });
+	const double SinAccurate = Time([&]() { FApproxMath::Sin(Angles, Results, EApproxMathPrecision::Accurate); });
+	AddInfo(FString::Printf(TEXT("Sin: FMath %.2f ns, VectorSinCos %.2f ns, Fast %.2f ns, Accurate %.2f ns per float"), SinScalar, SinVector, SinFast, SinAccurate));
+
+	const double ExpScalar = Time([&]() { for (int32 Index = 0; Index < Exponents.Num(); ++Index) { Results[Index] = FMath::Exp(Exponents[Index]); } });
+	const double ExpVector = Time([&]() { TimeVector(Exponents, [](const VectorRegister& V) { return VectorExp(V); }); });
+	const double ExpFast = Time([&]() { FApproxMath::Exp(Exponents, Results, EApproxMathPrecision::Fast); });
+	const double ExpAccurate = Time([&]() { FApproxMath::Exp(Exponents, Results, EApproxMathPrecision::Accurate); });
+	AddInfo(FString::Printf(TEXT("Exp: FMath %.2f ns, VectorExp %.2f ns, Fast %.2f ns, Accurate %.2f ns per float"), ExpScalar, ExpVector, ExpFast, ExpAccurate));
+
+	return true;
+}
 
 #endif //WITH_DEV_AUTOMATION_TESTS
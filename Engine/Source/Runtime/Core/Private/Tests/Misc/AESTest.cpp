@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AES.h"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Parse.h"
+#include "Templates/Function.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AESTest
+{
+	static void ParseHex(const TCHAR* Hex, uint8* OutBytes)
+	{
+		for (; Hex[0] && Hex[1]; Hex += 2)
+		{
+			*OutBytes++ = (uint8)((FParse::HexDigit(Hex[0]) << 4) | FParse::HexDigit(Hex[1]));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAESTest, "System.Core.Misc.AES", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FAESTest::RunTest(const FString& Parameters)
+{
+	using namespace AESTest;
+
+	AddInfo(FString::Printf(TEXT("Hardware accelerated: %s"), FAES::IsHardwareAccelerated() ? TEXT("true") : TEXT("false")));
+
+	// FIPS-197 appendix C.3
+	{
+		FAES::FAESKey Key;
+		uint8 Plaintext[16];
+		uint8 Ciphertext[16];
+		ParseHex(TEXT("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"), Key.Key);
+		ParseHex(TEXT("00112233445566778899aabbccddeeff"), Plaintext);
+		ParseHex(TEXT("8ea2b7ca516745bfeafc49904b496089"), Ciphertext);
+
+		uint8 Block[16];
+		FMemory::Memcpy(Block, Plaintext, sizeof(Block));
+		FAES::EncryptData(Block, sizeof(Block), Key);
+		TestTrue(TEXT("ECB encryption matches the FIPS-197 vector"), FMemory::Memcmp(Block, Ciphertext, sizeof(Block)) == 0);
+		FAES::DecryptData(Block, sizeof(Block), Key);
+		TestTrue(TEXT("ECB decryption matches the FIPS-197 vector"), FMemory::Memcmp(Block, Plaintext, sizeof(Block)) == 0);
+	}
+
+	// NIST SP 800-38A F.5.5, decrypted in every split to check partial blocks and offsets
+	{
+		FAES::FAESKey Key;
+		uint8 InitialCounter[16];
+		uint8 Plaintext[64];
+		uint8 Ciphertext[64];
+		ParseHex(TEXT("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4"), Key.Key);
+		ParseHex(TEXT("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"), InitialCounter);
+		ParseHex(TEXT("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"), Plaintext);
+		ParseHex(TEXT("601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c52b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"), Ciphertext);
+
+		uint8 Data[64];
+		FMemory::Memcpy(Data, Plaintext, sizeof(Data));
+		FAES::CryptDataCTR(Data, sizeof(Data), Key, InitialCounter);
+		TestTrue(TEXT("CTR encryption matches the SP 800-38A vector"), FMemory::Memcmp(Data, Ciphertext, sizeof(Data)) == 0);
+
+		bool bSplitsMatch = true;
+		for (uint32 Split = 0; Split <= sizeof(Data); ++Split)
+		{
+			FMemory::Memcpy(Data, Ciphertext, sizeof(Data));
+			FAES::CryptDataCTR(Data, Split, Key, InitialCounter);
+			FAES::CryptDataCTR(Data + Split, sizeof(Data) - Split, Key, InitialCounter, Split);
+			bSplitsMatch &= FMemory::Memcmp(Data, Plaintext, sizeof(Data)) == 0;
+		}
+		TestTrue(TEXT("CTR decrypts from any offset"), bSplitsMatch);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAESPerfTest, "System.Core.Misc.AES.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FAESPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumBytes = 64 << 20;
+
+	FRandomStream Random(0x5EED);
+	FAES::FAESKey Key;
+	for (uint8& Byte : Key.Key)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+	uint8 InitialCounter[16];
+	for (uint8& Byte : InitialCounter)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+
+	TArray<uint8> Original;
+	Original.SetNumUninitialized(NumBytes);
+	for (uint8& Byte : Original)
+	{
+		Byte = (uint8)Random.RandHelper(256);
+	}
+	TArray<uint8> Data = Original;
+
+	auto Measure = [this, &Data](const TCHAR* Mode, TFunctionRef<void()> Crypt)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Crypt();
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 1e-9);
+		AddInfo(FString::Printf(TEXT("%s: %.2fms, %.1f MB/s"), Mode, Seconds * 1000.0, Data.Num() / (Seconds * 1024.0 * 1024.0)));
+	};
+
+	Measure(TEXT("ECB encrypt"), [&Data, &Key] { FAES::EncryptData(Data.GetData(), Data.Num(), Key); });
+	Measure(TEXT("ECB decrypt"), [&Data, &Key] { FAES::DecryptData(Data.GetData(), Data.Num(), Key); });
+	Measure(TEXT("CTR encrypt"), [&Data, &Key, &InitialCounter] { FAES::CryptDataCTR(Data.GetData(), Data.Num(), Key, InitialCounter); });
+	Measure(TEXT("CTR decrypt"), [&Data, &Key, &InitialCounter] { FAES::CryptDataCTR(Data.GetData(), Data.Num(), Key, InitialCounter); });
+	TestTrue(TEXT("Data survives the round trips"), Data == Original);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
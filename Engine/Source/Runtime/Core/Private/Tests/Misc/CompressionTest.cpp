@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/Compression.h"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/ArchiveLoadCompressedProxy.h"
+#include "Serialization/ArchiveSaveCompressedProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4CompressionTest_Private
+{
+	/** Data that compresses about as well as cooked content: runs of repeated bytes, near and far matches and noise */
+	static void MakeTestData(TArray<uint8>& OutData, int32 Size, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		OutData.SetNumUninitialized(Size);
+		for (int32 Index = 0; Index < Size; ++Index)
+		{
+			const int32 Kind = Random.RandHelper(8);
+			if (Index > 64 && Kind < 5)
+			{
+				OutData[Index] = OutData[Index - 1 - Random.RandHelper(Kind < 3 ? 15 : 64)];
+			}
+			else
+			{
+				OutData[Index] = (uint8)Random.RandHelper(Kind == 7 ? 256 : 16);
+			}
+		}
+	}
+
+	static bool CompressBlock(FName FormatName, const TArray<uint8>& Data, TArray<uint8>& OutCompressed)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Data.Num());
+		OutCompressed.SetNumUninitialized(CompressedSize);
+		const bool bSucceeded = FCompression::CompressMemory(FormatName, OutCompressed.GetData(), CompressedSize, Data.GetData(), Data.Num());
+		OutCompressed.SetNum(CompressedSize);
+		return bSucceeded;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionTest, "System.Core.Misc.Compression", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FCompressionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4CompressionTest_Private;
+
+	TArray<FName> Formats = { NAME_Zlib, NAME_LZ4 };
+#if WITH_ZSTD
+	Formats.Add(NAME_Zstd);
+#endif
+
+	// Each format round trips blocks of different sizes, reusing the contexts of this thread between them
+	TArray<TArray<uint8>> Blocks;
+	for (int32 Size : { 1, 100, 4096, 65536, 131072 })
+	{
+		MakeTestData(Blocks.AddDefaulted_GetRef(), Size, Size);
+	}
+
+	for (FName FormatName : Formats)
+	{
+		bool bRoundTrips = true;
+		TArray<TArray<uint8>> CompressedBlocks;
+		for (const TArray<uint8>& Block : Blocks)
+		{
+			TArray<uint8>& Compressed = CompressedBlocks.AddDefaulted_GetRef();
+			TArray<uint8> Uncompressed;
+			Uncompressed.SetNumUninitialized(Block.Num());
+			bRoundTrips &= CompressBlock(FormatName, Block, Compressed);
+			bRoundTrips &= FCompression::UncompressMemory(FormatName, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), Compressed.Num());
+			bRoundTrips &= Uncompressed == Block;
+		}
+		TestTrue(FString::Printf(TEXT("%s round trips"), *FormatName.ToString()), bRoundTrips);
+
+		// Uncompressing the blocks in one batch gives the same data
+		TArray<TArray<uint8>> UncompressedBlocks;
+		TArray<FCompression::FUncompressBlock> BatchBlocks;
+		for (int32 Index = 0; Index < Blocks.Num(); ++Index)
+		{
+			TArray<uint8>& Uncompressed = UncompressedBlocks.AddDefaulted_GetRef();
+			Uncompressed.SetNumZeroed(Blocks[Index].Num());
+			BatchBlocks.Add({ Uncompressed.GetData(), Uncompressed.Num(), CompressedBlocks[Index].GetData(), CompressedBlocks[Index].Num(), false });
+		}
+		TestTrue(FString::Printf(TEXT("%s batch succeeds"), *FormatName.ToString()), FCompression::UncompressMemoryBatch(FormatName, BatchBlocks));
+		TestTrue(FString::Printf(TEXT("%s batch matches"), *FormatName.ToString()), UncompressedBlocks == Blocks);
+	}
+
+	// The compressed proxies write the same data whether blocks are compressed asynchronously or not, and read it back either way
+	TArray<uint8> Data;
+	MakeTestData(Data, 5 * LOADING_COMPRESSION_CHUNK_SIZE + 1234, 0x5EED);
+
+	TArray<uint8> SyncCompressed;
+	TArray<uint8> AsyncCompressed;
+	{
+		FArchiveSaveCompressedProxy SyncProxy(SyncCompressed, NAME_Zlib);
+		FArchiveSaveCompressedProxy AsyncProxy(AsyncCompressed, NAME_Zlib, COMPRESS_NoFlags, 4);
+		for (int32 Offset = 0; Offset < Data.Num(); Offset += 10000)
+		{
+			const int32 Count = FMath::Min(Data.Num() - Offset, 10000);
+			SyncProxy.Serialize(Data.GetData() + Offset, Count);
+			AsyncProxy.Serialize(Data.GetData() + Offset, Count);
+		}
+	}
+	TestTrue(TEXT("Async compressed proxy writes the same data"), SyncCompressed == AsyncCompressed);
+
+	for (int32 NumAsyncBlocks : { 0, 3 })
+	{
+		TArray<uint8> Loaded;
+		Loaded.SetNumUninitialized(Data.Num());
+		FArchiveLoadCompressedProxy LoadProxy(AsyncCompressed, NAME_Zlib, COMPRESS_NoFlags, NumAsyncBlocks);
+		LoadProxy.Serialize(Loaded.GetData(), 777);
+		LoadProxy.Seek(5000);
+		LoadProxy.Serialize(Loaded.GetData() + 5000, Loaded.Num() - 5000);
+		TestTrue(FString::Printf(TEXT("Compressed proxy reads back the data with %d async blocks"), NumAsyncBlocks), FMemory::Memcmp(Loaded.GetData() + 5000, Data.GetData() + 5000, Data.Num() - 5000) == 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompressionPerfTest, "System.Core.Misc.Compression.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FCompressionPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4CompressionTest_Private;
+
+	// The size of the blocks of an IoStore container, uncompressed on one core
+	constexpr int32 BlockSize = 64 * 1024;
+	constexpr int32 NumBlocks = 64;
+	constexpr int32 NumIterations = 16;
+
+	TArray<FName> Formats = { NAME_Zlib, NAME_LZ4 };
+#if WITH_ZSTD
+	Formats.Add(NAME_Zstd);
+#endif
+
+	for (FName FormatName : Formats)
+	{
+		TArray<TArray<uint8>> Blocks;
+		TArray<TArray<uint8>> CompressedBlocks;
+		int64 CompressedBytes = 0;
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			MakeTestData(Blocks.AddDefaulted_GetRef(), BlockSize, Index);
+			CompressBlock(FormatName, Blocks.Last(), CompressedBlocks.AddDefaulted_GetRef());
+			CompressedBytes += CompressedBlocks.Last().Num();
+		}
+
+		TArray<uint8> Uncompressed;
+		Uncompressed.SetNumUninitialized(NumBlocks * BlockSize);
+		TArray<FCompression::FUncompressBlock> BatchBlocks;
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			BatchBlocks.Add({ Uncompressed.GetData() + Index * BlockSize, BlockSize, CompressedBlocks[Index].GetData(), CompressedBlocks[Index].Num(), false });
+		}
+
+		auto Measure = [NumBlocks, BlockSize, NumIterations](auto Uncompress)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Uncompress();
+			}
+			const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 1e-9);
+			return (double)NumIterations * NumBlocks * BlockSize / (Seconds * 1024.0 * 1024.0 * 1024.0);
+		};
+
+		const double SingleGBs = Measure([&BatchBlocks, FormatName]
+		{
+			for (const FCompression::FUncompressBlock& Block : BatchBlocks)
+			{
+				FCompression::UncompressMemory(FormatName, Block.UncompressedBuffer, Block.UncompressedSize, Block.CompressedBuffer, Block.CompressedSize);
+			}
+		});
+		const double BatchGBs = Measure([&BatchBlocks, FormatName]
+		{
+			FCompression::UncompressMemoryBatch(FormatName, BatchBlocks);
+		});
+
+		AddInfo(FString::Printf(TEXT("%s, ratio %.2f: UncompressMemory %.2f GB/s per core, UncompressMemoryBatch %.2f GB/s per core"),
+			*FormatName.ToString(), (double)NumBlocks * BlockSize / CompressedBytes, SingleGBs, BatchGBs));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ConcurrentLinearAllocator.h"
+#include "Async/ParallelFor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConcurrentLinearAllocatorTest, "System.Core.Misc.ConcurrentLinearAllocator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+
+/** Test that allocations are aligned, keep their contents and can be freed on a thread other than the one that made them. */
+bool FConcurrentLinearAllocatorTest::RunTest(const FString& Parameters)
+{
+	const int32 Num = 4096;
+
+	TArray<uint8*> Allocations;
+	Allocations.AddZeroed(Num);
+
+	int32 NumMisaligned = 0;
+	ParallelFor(Num, [&Allocations, &NumMisaligned](int32 Index)
+	{
+		// mix small, page sized and oversized allocations
+		const SIZE_T Size = (Index % 64 == 0) ? 100000 : 1 + (Index * 37) % 2000;
+		const uint32 Alignment = 1u << (Index % 8);
+		uint8* Ptr = (uint8*)FConcurrentLinearAllocator::Malloc(Size, Alignment);
+		if (!IsAligned(Ptr, Alignment))
+		{
+			FPlatformAtomics::InterlockedIncrement(&NumMisaligned);
+		}
+		FMemory::Memset(Ptr, uint8(Index), Size);
+		Allocations[Index] = Ptr;
+	});
+	TestEqual(TEXT("Concurrent linear allocations must respect the requested alignment"), NumMisaligned, 0);
+
+	int32 NumStomped = 0;
+	for (int32 Index = 0; Index < Num; Index++)
+	{
+		const SIZE_T Size = (Index % 64 == 0) ? 100000 : 1 + (Index * 37) % 2000;
+		for (SIZE_T Offset = 0; Offset < Size; Offset += 97)
+		{
+			NumStomped += Allocations[Index][Offset] != uint8(Index);
+		}
+	}
+	TestEqual(TEXT("Concurrent linear allocations must not overlap"), NumStomped, 0);
+
+	// free in reverse so that most allocations are released by a different thread than the one that made them
+	ParallelFor(Num, [&Allocations, Num](int32 Index)
+	{
+		FConcurrentLinearAllocator::Free(Allocations[Num - 1 - Index]);
+	});
+	FConcurrentLinearAllocator::Free(nullptr);
+
+	{
+		TArray<int32, TConcurrentLinearArrayAllocator<>> Array;
+		for (int32 Index = 0; Index < 10000; Index++)
+		{
+			Array.Add(Index);
+		}
+		int32 NumWrong = 0;
+		for (int32 Index = 0; Index < Array.Num(); Index++)
+		{
+			NumWrong += Array[Index] != Index;
+		}
+		TestEqual(TEXT("Arrays using the concurrent linear allocator must keep their elements when growing"), NumWrong, 0);
+
+		TMap<int32, int32, FConcurrentLinearSetAllocator> Map;
+		for (int32 Index = 0; Index < 1000; Index++)
+		{
+			Map.Add(Index, Index * 2);
+		}
+		const int32* Found = Map.Find(500);
+		TestTrue(TEXT("Maps using the concurrent linear allocator must find their elements"), Found && *Found == 1000);
+	}
+
+	FConcurrentLinearAllocator::FlushCurrentThreadCache();
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #include "CoreTypes.h"
 #include "Containers/UnrealString.h"
 #include "Misc/Guid.h"
+#include "Misc/StringBuilder.h"
 #include "Misc/AutomationTest.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -44,7 +45,14 @@ bool FGuidTest::RunTest( const FString& Parameters )
 	TestEqual(TEXT("Parsing valid strings must succeed (EGuidFormats::UniqueObjectGuid)"), g2_1, g);
 
 	// parsing invalid strings (exact)
+	TestFalse(TEXT("Parsing invalid strings must fail (non hex digit)"), FGuid::ParseExact(TEXT("1234567887654321123456788765432G"), EGuidFormats::Digits, g2_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (too long)"), FGuid::ParseExact(TEXT("123456788765432112345678876543210"), EGuidFormats::Digits, g2_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (wrong separator)"), FGuid::ParseExact(TEXT("12345678-8765-4321_1234-567887654321"), EGuidFormats::DigitsWithHyphens, g2_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (wrong braces)"), FGuid::ParseExact(TEXT("(12345678-8765-4321-1234-567887654321}"), EGuidFormats::DigitsWithHyphensInParentheses, g2_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (wrong prefix)"), FGuid::ParseExact(TEXT("{0x12345678,0x8765,0x4321,{0x12,0x34,0x56,0x78,0x87,0x65,0x43,1x21}}"), EGuidFormats::HexValuesInBraces, g2_1));
 
+	TestTrue(TEXT("Parsing lower case digits must succeed"), FGuid::ParseExact(TEXT("abcdef0123456789ABCDEF0123456789"), EGuidFormats::Digits, g2_1));
+	TestEqual(TEXT("Parsing lower case digits must succeed"), g2_1, FGuid(0xabcdef01, 0x23456789, 0xabcdef01, 0x23456789));
 
 	// parsing valid strings (automatic)
 	FGuid g3_1;
@@ -68,11 +76,34 @@ bool FGuidTest::RunTest( const FString& Parameters )
 	TestEqual(TEXT("Parsing valid strings must succeed (12345678-87654321-12345678-87654321)"), g3_1, g);
 
 	//parsing invalid strings (automatic)
+	TestFalse(TEXT("Parsing invalid strings must fail (empty)"), FGuid::Parse(TEXT(""), g3_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (wrong length)"), FGuid::Parse(TEXT("1234567887654321123456788765432"), g3_1));
+	TestFalse(TEXT("Parsing invalid strings must fail (non hex digit)"), FGuid::Parse(TEXT("12345678-8765-4321-1234-56788765432x"), g3_1));
+
+	// string builders and round trips
+	const EGuidFormats Formats[] = { EGuidFormats::Digits, EGuidFormats::DigitsWithHyphens, EGuidFormats::DigitsWithHyphensInBraces, EGuidFormats::DigitsWithHyphensInParentheses, EGuidFormats::HexValuesInBraces, EGuidFormats::UniqueObjectGuid, EGuidFormats::Short };
+	for (EGuidFormats Format : Formats)
+	{
+		TStringBuilder<128> Builder;
+		g.AppendString(Builder, Format);
+		TestEqual(TEXT("Appending to a string builder must match ToString"), FString(Builder.ToString()), g.ToString(Format));
+
+		FGuid g3_2;
+		TestTrue(TEXT("Parsing a converted string must succeed"), FGuid::ParseExact(FStringView(Builder.ToString(), Builder.Len()), Format, g3_2));
+		TestEqual(TEXT("Parsing a converted string must return the same GUID"), g3_2, g);
+	}
 
 	// GUID validation
 	FGuid g4_1 = FGuid::NewGuid();
 
 	TestTrue(TEXT("New GUIDs must be valid"), g4_1.IsValid());
+	TestTrue(TEXT("New GUIDs must be version 4"), (g4_1.B & 0x0000f000) == 0x00004000);
+	TestTrue(TEXT("New GUIDs must be of the RFC 4122 variant"), (g4_1.C & 0xc0000000) == 0x80000000);
+
+	for (int32 Index = 0; Index < 16; ++Index)
+	{
+		TestNotEqual(TEXT("New GUIDs must be unique"), FGuid::NewGuid(), g4_1);
+	}
 	
 	g4_1.Invalidate();
 
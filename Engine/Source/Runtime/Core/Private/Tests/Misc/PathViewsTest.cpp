@@ -3,7 +3,10 @@
 #include "Misc/PathViews.h"
 
 #include "Containers/StringView.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -232,4 +235,128 @@ bool FPathViewsSplitTest::RunTest(const FString& InParameters)
 	return true;
 }
 
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FPathViewsMatchPathsTest, FPathViewsTest, "System.Core.Misc.PathViews.MatchPaths", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FPathViewsMatchPathsTest::RunTest(const FString& InParameters)
+{
+	const TCHAR* Paths[] =
+	{
+		TEXT(""), TEXT("/"), TEXT("//"), TEXT("File.txt"), TEXT("Folder/"), TEXT("Folder\\"), TEXT("C:/"), TEXT("C:\\Folder\\File.txt"),
+		TEXT("A/B/../C"), TEXT("A/./B"), TEXT("A/../../B"), TEXT("../A"), TEXT("/../A"), TEXT("C:/../A"), TEXT("A/..B/C"),
+		TEXT("A//B///C"), TEXT("A.B/C"), TEXT("A/B.C.D"), TEXT("\\\\Server\\Share"), TEXT("A/.../B"),
+	};
+
+	auto TestBuilder = [this](const TCHAR* What, const TCHAR* InPath, const FStringBuilderBase& Actual, const FString& Expected)
+	{
+		if (!FStringView(Actual).Equals(FStringView(Expected), ESearchCase::CaseSensitive))
+		{
+			AddError(FString::Printf(TEXT("%s failed on path '%s' (got '%s', expected '%s')."), What, InPath, Actual.ToString(), *Expected));
+		}
+	};
+
+	for (const TCHAR* Path : Paths)
+	{
+		TStringBuilder<64> Builder;
+
+		TestTrue(FString::Printf(TEXT("IsRelative('%s')"), Path), FPathViews::IsRelative(Path) == FPaths::IsRelative(Path));
+
+		FPathViews::ChangeExtension(Builder, Path, TEXT("ext"));
+		TestBuilder(TEXT("ChangeExtension"), Path, Builder, FPaths::ChangeExtension(Path, TEXT("ext")));
+
+		Builder.Reset();
+		FPathViews::SetExtension(Builder, Path, TEXT(".ext"));
+		TestBuilder(TEXT("SetExtension"), Path, Builder, FPaths::SetExtension(Path, TEXT(".ext")));
+
+		FString Expected = Path;
+		FPaths::NormalizeFilename(Expected);
+		Builder.Reset();
+		Builder << Path;
+		FPathViews::NormalizeFilename(Builder);
+		TestBuilder(TEXT("NormalizeFilename"), Path, Builder, Expected);
+
+		Expected = Path;
+		FPaths::NormalizeDirectoryName(Expected);
+		Builder.Reset();
+		Builder << Path;
+		FPathViews::NormalizeDirectoryName(Builder);
+		TestBuilder(TEXT("NormalizeDirectoryName"), Path, Builder, Expected);
+
+		Expected = Path;
+		const bool bExpectedCollapsed = FPaths::CollapseRelativeDirectories(Expected);
+		Builder.Reset();
+		Builder << Path;
+		TestTrue(FString::Printf(TEXT("CollapseRelativeDirectories('%s')"), Path), FPathViews::CollapseRelativeDirectories(Builder) == bExpectedCollapsed);
+		TestBuilder(TEXT("CollapseRelativeDirectories"), Path, Builder, Expected);
+
+		Expected = Path;
+		FPaths::RemoveDuplicateSlashes(Expected);
+		Builder.Reset();
+		Builder << Path;
+		FPathViews::RemoveDuplicateSlashes(Builder);
+		TestBuilder(TEXT("RemoveDuplicateSlashes"), Path, Builder, Expected);
+
+		FPathViews::ConvertRelativePathToFull(Builder, TEXT("C:/Base/Dir"), Path);
+		TestBuilder(TEXT("ConvertRelativePathToFull"), Path, Builder, FPaths::ConvertRelativePathToFull(TEXT("C:/Base/Dir"), Path));
+
+		FPathViews::ConvertRelativePathToFull(Builder, Path);
+		TestBuilder(TEXT("ConvertRelativePathToFull"), Path, Builder, FPaths::ConvertRelativePathToFull(Path));
+	}
+
+	TStringBuilder<64> Builder;
+	FPathViews::Append(Builder, TEXT("A"), FString(TEXT("B/")), FStringView(TEXT("C")));
+	TestBuilder(TEXT("Append"), TEXT("A, B/, C"), Builder, TEXT("A/B/C"));
+
+	return true;
+}
+
+/**
+ * Compares the FString based FPaths functions with their builder based FPathViews counterparts on typical asset paths.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPathViewsPerfTest, "System.Core.Misc.PathViews.Perf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FPathViewsPerfTest::RunTest(const FString& InParameters)
+{
+	const TCHAR* Paths[] =
+	{
+		TEXT("../../../Engine/Content/EngineMaterials/DefaultMaterial.uasset"),
+		TEXT("../../../MyGame/Content/Characters/Hero/Meshes/../Textures/T_Hero_D.uasset"),
+		TEXT("Content\\Maps\\Level01\\Level01_BuiltData.uasset"),
+		TEXT("/Game/UI/Widgets/W_MainMenu.uasset"),
+	};
+	constexpr int32 NumIterations = 250000;
+
+	int32 Checksum = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const TCHAR* Path : Paths)
+		{
+			const FString Full = FPaths::ConvertRelativePathToFull(TEXT("C:/Projects/MyGame/Binaries/Win64"), Path);
+			const FString Combined = FPaths::Combine(FPaths::GetPath(Full), FPaths::ChangeExtension(FPaths::GetBaseFilename(Full), TEXT("uexp")));
+			Checksum += Combined.Len();
+		}
+	}
+	const double PathsTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 ViewsChecksum = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (const TCHAR* Path : Paths)
+		{
+			TStringBuilder<256> Full;
+			FPathViews::ConvertRelativePathToFull(Full, TEXT("C:/Projects/MyGame/Binaries/Win64"), Path);
+			TStringBuilder<256> Combined;
+			Combined << FPathViews::GetPath(Full);
+			FPathViews::Append(Combined, TEXT(""));
+			FPathViews::ChangeExtension(Combined, FPathViews::GetBaseFilename(Full), TEXT("uexp"));
+			ViewsChecksum += Combined.Len();
+		}
+	}
+	const double ViewsTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("FPaths and FPathViews produce paths of the same length"), ViewsChecksum, Checksum);
+	AddInfo(FString::Printf(TEXT("FPaths: %.2fms, FPathViews: %.2fms, %.2fx faster"), PathsTime * 1000.0, ViewsTime * 1000.0, PathsTime / FMath::Max(ViewsTime, 1e-9)));
+
+	return true;
+}
+
 #endif
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/TextFilterExpressionEvaluator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE4TextFilterTest_Private
+{
+	/** Tests the basic string terms of a filter against one item, the way a list view implements its filter context */
+	class FStringContext : public ITextFilterExpressionContext
+	{
+	public:
+		explicit FStringContext(const FString& InString)
+			: UpperString(InString.ToUpper())
+		{
+		}
+
+		virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+		{
+			return InValue.CompareFString(UpperString, InTextComparisonMode);
+		}
+
+		virtual bool TestComplexExpression(const FName& InKey, const FTextFilterString& InValue, const ETextFilterComparisonOperation InComparisonOperation, const ETextFilterTextComparisonMode InTextComparisonMode) const override
+		{
+			return false;
+		}
+
+	private:
+		FString UpperString;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextFilterColumnTest, "System.Core.Misc.TextFilterColumn", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FTextFilterColumnTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4TextFilterTest_Private;
+
+	const FString Strings[] = { TEXT("SM_Rock"), TEXT("T_Rock_D"), TEXT("sm_tree"), TEXT(""), TEXT("M"), TEXT("Mesh_SM"), TEXT("RockRock") };
+	const FTextFilterStringColumn Column(Strings);
+	TestEqual(TEXT("Column strings are uppercase"), FString(Column.GetString(2)), FString(TEXT("SM_TREE")));
+
+	const TCHAR* Filters[] = { TEXT("rock"), TEXT("+sm_rock"), TEXT("sm..."), TEXT("...rock"), TEXT("-rock"), TEXT("m"), TEXT("rock AND NOT t_"), TEXT("tree OR \"_D\""), TEXT("") };
+	for (const TCHAR* Filter : Filters)
+	{
+		FTextFilterExpressionEvaluator Evaluator(ETextFilterExpressionEvaluatorMode::BasicString);
+		Evaluator.SetFilterText(FText::FromString(Filter));
+
+		// The column must pass the same strings as the filter run over one item at a time
+		TBitArray<> Results;
+		Evaluator.TestTextFilterColumn(Column, Results);
+		TestEqual(TEXT("Column results"), Results.Num(), Column.Num());
+
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Strings); ++Index)
+		{
+			const bool bExpected = Evaluator.TestTextFilter(FStringContext(Strings[Index]));
+			if (Results[Index] != bExpected)
+			{
+				AddError(FString::Printf(TEXT("Filter '%s' on '%s' - expected %d - result %d"), Filter, *Strings[Index], bExpected, (bool)Results[Index]));
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
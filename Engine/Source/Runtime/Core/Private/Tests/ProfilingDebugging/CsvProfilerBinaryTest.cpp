@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "ProfilingDebugging/CsvProfilerBinary.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCsvProfilerBinaryTest, "System.Core.ProfilingDebugging.CsvProfilerBinary", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+/** Binary captures must read back the values written and convert to the same text the CSV writer produces. */
+bool FCsvProfilerBinaryTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> FileData;
+	{
+		TSharedRef<FArchive> File = MakeShared<FMemoryWriter>(FileData);
+		FCsvBinaryWriter Writer(File, 2 /*RowsPerChunk*/);
+
+		const int32 FrameTime = Writer.AddColumn(TEXT("FrameTime"), false);
+		const int32 DrawCalls = Writer.AddColumn(TEXT("DrawCalls"), true);
+
+		Writer.BeginRow(0);
+		Writer.AddEvent(TEXT("Start, then; go"));
+		Writer.AddValue(FrameTime, 16.5f);
+		Writer.AddValue(DrawCalls, 1200);
+		Writer.EndRow();
+
+		// Frame 1 has no row, frame 2 only has a frame time
+		Writer.BeginRow(2);
+		Writer.AddValue(FrameTime, 33.25f);
+		Writer.AddValue(DrawCalls, 0);
+		Writer.EndRow();
+
+		// A column added once rows were written to disk
+		const int32 Memory = Writer.AddColumn(TEXT("MemoryMB"), true);
+		Writer.BeginRow(3);
+		Writer.AddEvent(TEXT("A"));
+		Writer.AddEvent(TEXT("B"));
+		Writer.AddValue(FrameTime, 0.05f);
+		Writer.AddValue(DrawCalls, -3);
+		Writer.AddValue(Memory, 4096);
+		Writer.EndRow();
+
+		TMap<FString, FString> Metadata;
+		Metadata.Add(TEXT("commandline"), TEXT("\"-csvBinary\""));
+		Metadata.Add(TEXT("platform"), TEXT("Test"));
+		Writer.Finalize(Metadata);
+	}
+
+	FCsvBinaryReader Reader;
+	TestTrue(TEXT("File opens"), Reader.Open(MakeUnique<FMemoryReader>(FileData)));
+	TestEqual(TEXT("Column count"), Reader.GetNumColumns(), 3);
+	TestEqual(TEXT("Column found"), Reader.FindColumn(TEXT("MemoryMB")), 2);
+	TestTrue(TEXT("Integer column"), Reader.IsIntegerColumn(1) && !Reader.IsIntegerColumn(0));
+
+	TArray<int64> Frames;
+	TArray<double> Values;
+	TestTrue(TEXT("Column reads"), Reader.ReadColumn(1, Frames, Values));
+	TestEqual(TEXT("Zero values are skipped"), Frames, TArray<int64>({ 0, 3 }));
+	TestEqual(TEXT("Integer values"), Values, TArray<double>({ 1200.0, -3.0 }));
+
+	TArray<FString> Events;
+	TestTrue(TEXT("Events read"), Reader.ReadEvents(Frames, Events));
+	TestEqual(TEXT("Event frames"), Frames, TArray<int64>({ 0, 3, 3 }));
+
+	TArray<uint8> CsvData;
+	FMemoryWriter CsvFile(CsvData);
+	TestTrue(TEXT("Converts to CSV"), Reader.WriteCsv(CsvFile));
+	CsvData.Add(0);
+
+	const FString Expected =
+		TEXT("EVENTS,FrameTime,DrawCalls,MemoryMB\n")
+		TEXT("Start. then. go,16.5000,1200,0\n")
+		TEXT(",33.2500,0,0\n")
+		TEXT("A;B,0.050000,-3,4096\n")
+		TEXT("EVENTS,FrameTime,DrawCalls,MemoryMB\n")
+		TEXT("[HasHeaderRowAtEnd],1,[platform],Test,[commandline],\"-csvBinary\"");
+	TestEqual(TEXT("CSV text"), FString(ANSI_TO_TCHAR((const ANSICHAR*)CsvData.GetData())), Expected);
+
+	// A capture cut short keeps its complete chunks
+	FileData.SetNum(FileData.Num() - 70);
+	TestTrue(TEXT("Truncated file opens"), Reader.Open(MakeUnique<FMemoryReader>(FileData)));
+	TestTrue(TEXT("Truncated rows read"), Reader.ReadRows(Frames));
+	TestEqual(TEXT("Complete chunks are kept"), Frames, TArray<int64>({ 0, 2 }));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ProfilingDebugging/LogLinearHistogram.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLogLinearHistogramTest, "System.Core.ProfilingDebugging.LogLinearHistogram", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLogLinearHistogramTest::RunTest(const FString& Parameters)
+{
+	// Every value lands in a bucket whose bounds hold it and that is within the precision of it
+	const uint64 Values[] = { 0, 1, 31, 63, 64, 65, 100, 1000, 123456, 1ull << 40, (1ull << 40) + 12345, MAX_uint64 - 1, MAX_uint64 };
+	for (uint64 Value : Values)
+	{
+		const int32 Index = FLogLinearHistogramBuckets::GetIndex(Value);
+		const uint64 Lower = FLogLinearHistogramBuckets::GetLowerBound(Index);
+		const uint64 Upper = FLogLinearHistogramBuckets::GetUpperBound(Index);
+		TestTrue(FString::Printf(TEXT("Bucket of %llu is in range"), Value), Index >= 0 && Index < FLogLinearHistogramBuckets::NumBuckets);
+		TestTrue(FString::Printf(TEXT("Bucket of %llu holds it"), Value), Lower <= Value && Value <= Upper);
+		TestTrue(FString::Printf(TEXT("Bucket of %llu is within precision"), Value), (Upper - Lower) <= Lower / FLogLinearHistogramBuckets::SubBucketCount);
+	}
+	for (int32 Index = 1; Index < FLogLinearHistogramBuckets::NumBuckets; ++Index)
+	{
+		if (FLogLinearHistogramBuckets::GetLowerBound(Index) != FLogLinearHistogramBuckets::GetUpperBound(Index - 1) + 1)
+		{
+			AddError(FString::Printf(TEXT("Bucket %d does not follow the one before it"), Index));
+			break;
+		}
+	}
+
+	// Values 1 to 10000 recorded from many threads at once
+	const int32 NumValues = 10000;
+	FLogLinearHistogram Histogram;
+	ParallelFor(NumValues, [&Histogram](int32 Index)
+	{
+		Histogram.Record(uint64(Index) + 1);
+	});
+	const FLogLinearHistogramSnapshot Snapshot = Histogram.Snapshot();
+	TestEqual(TEXT("Every value counted"), Snapshot.TotalCount, (uint64)NumValues);
+	TestEqual(TEXT("Sum"), Snapshot.Sum, (uint64)NumValues * (NumValues + 1) / 2);
+	TestEqual(TEXT("Min"), Snapshot.Min, (uint64)1);
+	TestEqual(TEXT("Max"), Snapshot.Max, (uint64)NumValues);
+	const double Percentiles[] = { 0.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+	for (double Percentile : Percentiles)
+	{
+		const double Expected = FMath::Max(1.0, Percentile / 100.0 * NumValues);
+		const double Actual = (double)Snapshot.GetValueAtPercentile(Percentile);
+		TestTrue(FString::Printf(TEXT("P%g is %g, close to %g"), Percentile, Actual, Expected), FMath::Abs(Actual - Expected) <= Expected / FLogLinearHistogramBuckets::SubBucketCount + 1.0);
+	}
+
+	// Serialization keeps everything
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FLogLinearHistogramSnapshot Saved = Snapshot;
+	Writer << Saved;
+	FLogLinearHistogramSnapshot Loaded;
+	FMemoryReader Reader(Bytes);
+	Reader << Loaded;
+	TestFalse(TEXT("Loading succeeded"), Reader.IsError());
+	TestTrue(TEXT("Loaded snapshot is the saved one"), Loaded.Counts == Snapshot.Counts && Loaded.TotalCount == Snapshot.TotalCount && Loaded.Sum == Snapshot.Sum && Loaded.Min == Snapshot.Min && Loaded.Max == Snapshot.Max);
+
+	Histogram.Reset();
+	TestEqual(TEXT("Reset clears"), Histogram.Snapshot().TotalCount, (uint64)0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
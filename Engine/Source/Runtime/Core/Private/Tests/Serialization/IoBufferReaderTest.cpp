@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/IoBufferReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIoBufferReaderTest, "System.Core.Serialization.IoBufferReader", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FIoBufferReaderTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer(Bytes);
+		int32 Value = 42;
+		FString String(TEXT("IoBuffer"));
+		Writer << Value << String;
+		for (uint8 Index = 0; Index < 64; ++Index)
+		{
+			Writer << Index;
+		}
+	}
+
+	FIoBuffer Slice;
+	{
+		FIoBufferReader Reader(FIoBuffer(FIoBuffer::Clone, Bytes.GetData(), Bytes.Num()));
+		int32 Value = 0;
+		FString String;
+		Reader << Value << String;
+		TestTrue(TEXT("Values read back"), Value == 42 && String == TEXT("IoBuffer"));
+
+		const int64 SliceOffset = Reader.Tell();
+		Slice = Reader.ReadSlice(64);
+		TestTrue(TEXT("Slice points into the buffer"), Slice.Data() == Reader.GetBuffer().Data() + SliceOffset && Slice.DataSize() == 64);
+		TestEqual(TEXT("Slice is skipped"), Reader.Tell(), Reader.TotalSize());
+
+		uint8 Byte = 0;
+		Reader << Byte;
+		TestTrue(TEXT("Reading past the end is an error"), Reader.IsError());
+		TestEqual(TEXT("Slicing past the end returns an empty buffer"), Reader.ReadSlice(1).DataSize(), (uint64)0);
+	}
+
+	// The slice keeps the data alive once the reader and its buffer are gone
+	FIoBuffer SubSlice = Slice.Slice(16, 16);
+	Slice = FIoBuffer();
+	bool bSubSliceMatches = SubSlice.DataSize() == 16;
+	for (uint64 Index = 0; bSubSliceMatches && Index < SubSlice.DataSize(); ++Index)
+	{
+		bSubSliceMatches = SubSlice.Data()[Index] == 16 + Index;
+	}
+	TestTrue(TEXT("Slices of slices share the data"), bSubSliceMatches);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
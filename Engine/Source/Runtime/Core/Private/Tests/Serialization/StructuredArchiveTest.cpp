@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/StructuredArchive.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_TEXT_ARCHIVE_SUPPORT
+
+namespace UE4StructuredArchiveTest_Private
+{
+	struct FTestData
+	{
+		int32 Int = 0;
+		float Float = 0.0f;
+		FString String;
+		TArray<int32> Array;
+		TArray<FString> MapKeys;
+		TArray<double> MapValues;
+		uint8 Attribute = 0;
+		uint16 OptionalAttribute = 0;
+		int64 AttributedValue = 0;
+
+		bool operator==(const FTestData& Other) const
+		{
+			return Int == Other.Int && Float == Other.Float && String == Other.String && Array == Other.Array && MapKeys == Other.MapKeys
+				&& MapValues == Other.MapValues && Attribute == Other.Attribute && OptionalAttribute == Other.OptionalAttribute && AttributedValue == Other.AttributedValue;
+		}
+	};
+
+	static FTestData MakeTestData(int32 Seed)
+	{
+		FTestData Data;
+		Data.Int = Seed * 7;
+		Data.Float = Seed * 0.5f;
+		Data.String = FString::Printf(TEXT("Item_%d"), Seed);
+		for (int32 Index = 0; Index < Seed % 5; ++Index)
+		{
+			Data.Array.Add(Seed + Index);
+			Data.MapKeys.Add(FString::Printf(TEXT("Key_%d"), Index));
+			Data.MapValues.Add(Seed * 0.25 + Index);
+		}
+		Data.Attribute = (uint8)Seed;
+		Data.OptionalAttribute = (uint16)(Seed & 1 ? Seed : 0);
+		Data.AttributedValue = (int64)Seed << 33;
+		return Data;
+	}
+
+	static void SerializeTestData(FStructuredArchive::FSlot Slot, FTestData& Data)
+	{
+		FStructuredArchive::FRecord Record = Slot.EnterRecord();
+		Record << SA_VALUE(TEXT("Int"), Data.Int);
+		Record << SA_VALUE(TEXT("Float"), Data.Float);
+		Record << SA_VALUE(TEXT("String"), Data.String);
+		Record << SA_VALUE(TEXT("Array"), Data.Array);
+
+		int32 NumElements = Data.MapKeys.Num();
+		FStructuredArchive::FMap Map = Record.EnterMap(SA_FIELD_NAME(TEXT("Map")), NumElements);
+		if (Slot.GetUnderlyingArchive().IsLoading())
+		{
+			Data.MapKeys.SetNum(NumElements);
+			Data.MapValues.SetNum(NumElements);
+		}
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			Map.EnterElement(Data.MapKeys[Index]) << Data.MapValues[Index];
+		}
+
+		FStructuredArchive::FSlot AttributedSlot = Record.EnterField(SA_FIELD_NAME(TEXT("Attributed")));
+		AttributedSlot << SA_ATTRIBUTE(TEXT("Attribute"), Data.Attribute);
+		AttributedSlot << SA_OPTIONAL_ATTRIBUTE(TEXT("OptionalAttribute"), Data.OptionalAttribute, (uint16)0);
+		AttributedSlot << Data.AttributedValue;
+	}
+
+	static void SerializeTestArray(FArchive& Ar, TArray<FTestData>& Items)
+	{
+		FBinaryArchiveFormatter Formatter(Ar);
+		FStructuredArchive StructuredArchive(Formatter);
+		int32 NumItems = Items.Num();
+		FStructuredArchive::FArray Array = StructuredArchive.Open().EnterArray(NumItems);
+		if (Ar.IsLoading())
+		{
+			Items.SetNum(NumItems);
+		}
+		for (FTestData& Item : Items)
+		{
+			SerializeTestData(Array.EnterElement(), Item);
+		}
+		StructuredArchive.Close();
+	}
+
+	/** Runs Func with the binary fast path of structured archives turned on or off, restoring the setting after */
+	template <typename FuncType>
+	static void WithBinaryFastPath(bool bEnabled, FuncType&& Func)
+	{
+		IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Serialization.StructuredArchiveBinaryFastPath"));
+		check(CVar);
+		const bool bWasEnabled = CVar->GetBool();
+		CVar->Set(bEnabled);
+		Func();
+		CVar->Set(bWasEnabled);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructuredArchiveBinaryTest, "System.Core.Serialization.StructuredArchive.Binary", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+bool FStructuredArchiveBinaryTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4StructuredArchiveTest_Private;
+
+	TArray<FTestData> Items;
+	for (int32 Seed = 0; Seed < 64; ++Seed)
+	{
+		Items.Add(MakeTestData(Seed));
+	}
+
+	// The fast path writes the same bytes as the formatter's virtual interface, and each reads what the other wrote
+	TArray<uint8> VirtualBytes;
+	TArray<uint8> FastBytes;
+	WithBinaryFastPath(false, [&]
+	{
+		FMemoryWriter Writer(VirtualBytes);
+		SerializeTestArray(Writer, Items);
+	});
+	WithBinaryFastPath(true, [&]
+	{
+		FMemoryWriter Writer(FastBytes);
+		SerializeTestArray(Writer, Items);
+	});
+	TestTrue(TEXT("Fast path writes the same data"), VirtualBytes == FastBytes);
+
+	for (bool bFastPath : { false, true })
+	{
+		TArray<FTestData> LoadedItems;
+		WithBinaryFastPath(bFastPath, [&]
+		{
+			FMemoryReader Reader(bFastPath ? VirtualBytes : FastBytes);
+			SerializeTestArray(Reader, LoadedItems);
+		});
+		TestTrue(FString::Printf(TEXT("Data reads back with the fast path %s"), bFastPath ? TEXT("on") : TEXT("off")), LoadedItems == Items);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStructuredArchiveBinaryPerfTest, "System.Core.Serialization.StructuredArchive.BinaryPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FStructuredArchiveBinaryPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace UE4StructuredArchiveTest_Private;
+
+	constexpr int32 NumIterations = 64;
+
+	TArray<FTestData> Items;
+	for (int32 Seed = 0; Seed < 4096; ++Seed)
+	{
+		Items.Add(MakeTestData(Seed));
+	}
+
+	TArray<uint8> Bytes;
+	for (bool bFastPath : { false, true })
+	{
+		double SaveSeconds = 0.0;
+		double LoadSeconds = 0.0;
+		WithBinaryFastPath(bFastPath, [&]
+		{
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Bytes.Reset();
+				FMemoryWriter Writer(Bytes);
+				SerializeTestArray(Writer, Items);
+			}
+			SaveSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				TArray<FTestData> LoadedItems;
+				FMemoryReader Reader(Bytes);
+				SerializeTestArray(Reader, LoadedItems);
+			}
+			LoadSeconds = FPlatformTime::Seconds() - StartTime;
+		});
+
+		const double NumRecords = (double)NumIterations * Items.Num();
+		AddInfo(FString::Printf(TEXT("%s: save %.1f ns per record, load %.1f ns per record, %d bytes"),
+			bFastPath ? TEXT("Binary fast path") : TEXT("Virtual formatter"), SaveSeconds * 1e9 / NumRecords, LoadSeconds * 1e9 / NumRecords, Bytes.Num()));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_TEXT_ARCHIVE_SUPPORT
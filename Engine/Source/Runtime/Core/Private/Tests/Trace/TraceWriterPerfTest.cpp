@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Atomic.h"
+#include "Trace/Trace.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL(TraceWriterPerfChannel)
+
+UE_TRACE_EVENT_BEGIN(TraceWriterPerf, Scope)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, Counter)
+UE_TRACE_EVENT_END()
+
+/**
+ * Measures how many events per second each thread can write when many threads are tracing at once, which is
+ * bound by how often the threads have to go to the shared buffer pool once their write buffer is full.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTraceWriterPerfTest, "System.Core.Trace.WriterPerf", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/** Runs ThreadCount threads writing events for Duration seconds and returns the average number of events written per second by each thread */
+static double MeasureEventsPerSecondPerThread(int32 ThreadCount, double Duration)
+{
+	TAtomic<bool> bStart(false);
+	TAtomic<bool> bStop(false);
+	TArray<uint64> EventCounts;
+	EventCounts.SetNumZeroed(ThreadCount);
+
+	TArray<FThread> Threads;
+	Threads.Reserve(ThreadCount);
+	for (int32 ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		Threads.Emplace(TEXT("TraceWriterPerf"), [&bStart, &bStop, &Count = EventCounts[ThreadIndex]]()
+		{
+			while (!bStart.Load(EMemoryOrder::Relaxed)); //-V529
+
+			// only check the stop flag every few events to keep the counter the main cost
+			uint64 LocalCount = 0;
+			while (!bStop.Load(EMemoryOrder::Relaxed))
+			{
+				for (uint32 Index = 0; Index < 256; ++Index)
+				{
+					UE_TRACE_LOG(TraceWriterPerf, Scope, TraceWriterPerfChannel)
+						<< Scope.Cycle(FPlatformTime::Cycles64())
+						<< Scope.Counter(Index);
+				}
+				LocalCount += 256;
+			}
+			Count = LocalCount;
+		});
+	}
+
+	bStart = true;
+	const double StartTime = FPlatformTime::Seconds();
+	FPlatformProcess::Sleep(float(Duration));
+	bStop = true;
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	uint64 TotalCount = 0;
+	for (int32 ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+	{
+		Threads[ThreadIndex].Join();
+		TotalCount += EventCounts[ThreadIndex];
+	}
+
+	return double(TotalCount) / ElapsedTime / double(ThreadCount);
+}
+
+bool FTraceWriterPerfTest::RunTest(const FString& Parameters)
+{
+	Trace::ToggleChannel(TraceWriterPerfChannel, true);
+
+	const int32 ThreadCounts[] = { 1, 8, 64 };
+	for (int32 ThreadCount : ThreadCounts)
+	{
+		const double EventsPerSecond = MeasureEventsPerSecondPerThread(ThreadCount, 1.0);
+		TestTrue(FString::Printf(TEXT("Events are written with %d threads"), ThreadCount), EventsPerSecond > 0.0);
+		AddInfo(FString::Printf(TEXT("%d threads: %.0f events per second per thread"), ThreadCount, EventsPerSecond));
+	}
+
+	Trace::ToggleChannel(TraceWriterPerfChannel, false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && UE_TRACE_ENABLED
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/NameTypes.h"
+#include "UObject/NameBatchSerialization.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && ALLOW_NAME_BATCH_SAVING
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameBatchSerializationTest, "System.Core.UObject.NameBatchSerialization", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+/** Test that batches large enough to be loaded on several threads round trip, with and without the saved hashes. */
+bool FNameBatchSerializationTest::RunTest(const FString& Parameters)
+{
+	TArray<FNameEntryId> Names;
+	for (int32 Index = 0; Index < 50000; ++Index)
+	{
+		FString String = FString::Printf(TEXT("NameBatchSerializationTest_%d"), Index);
+		if (Index % 7 == 0)
+		{
+			String[5] = 60000;
+		}
+		Names.Add(FName(*String).GetComparisonIndex());
+	}
+	Names.Add(FName().GetComparisonIndex());
+	Names.Add(FName(NAME_Box).GetComparisonIndex());
+	Names.Add(Names[1]);
+
+	TArray<uint8> NameData;
+	TArray<uint8> HashData;
+	SaveNameBatch(MakeArrayView(Names), NameData, HashData);
+
+	ReserveNameBatch(NameData.Num(), HashData.Num());
+	TArray<FNameEntryId> LoadedNames;
+	LoadNameBatch(LoadedNames, MakeArrayView(NameData), MakeArrayView(HashData));
+	TestTrue(TEXT("Names load with the saved hashes"), LoadedNames == Names);
+
+	// A different hash version makes the loader hash the names itself
+	HashData[0] = 0xba;
+	HashData[1] = 0xad;
+	LoadNameBatch(LoadedNames, MakeArrayView(NameData), MakeArrayView(HashData));
+	TestTrue(TEXT("Names load after rehashing"), LoadedNames == Names);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && ALLOW_NAME_BATCH_SAVING
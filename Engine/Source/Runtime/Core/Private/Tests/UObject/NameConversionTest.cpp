@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/StringConv.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/NameTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameConversionTest, "System.Core.UObject.NameConversion", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FNameConversionTest::RunTest(const FString& Parameters)
+{
+	const FName AnsiName(TEXT("NameConversionTest"), 3);
+	const FName WideName(TEXT("NameConversion\u00e9\u4e2d"));
+
+	// Appending to a string keeps what was already there and matches ToString
+	{
+		FString Out(TEXT("Prefix."));
+		AnsiName.AppendString(Out);
+		TestEqual(TEXT("AppendString to FString"), Out, FString(TEXT("Prefix.NameConversionTest_2")));
+
+		TStringBuilder<FName::StringBufferSize> Builder;
+		WideName.AppendString(Builder);
+		TestEqual(TEXT("AppendString to builder"), FString(Builder.ToString()), WideName.ToString());
+		TestEqual(TEXT("GetPlainNameString"), AnsiName.GetPlainNameString(), FString(TEXT("NameConversionTest")));
+	}
+
+	// UTF-8 output decodes back to the TCHAR string, and UTF-8 input finds the same names
+	for (const FName& Name : { AnsiName, WideName, FName(TEXT("Latin\u00e9\u00ff")) })
+	{
+		TAnsiStringBuilder<FName::StringBufferSize> Utf8;
+		Name.AppendUtf8String(Utf8);
+		const FUTF8ToTCHAR Converted(Utf8.ToString(), Utf8.Len());
+		const FString Decoded(Converted.Length(), Converted.Get());
+		TestEqual(TEXT("AppendUtf8String"), Decoded, Name.ToString());
+
+		const FTCHARToUTF8 Plain(*Name.GetPlainNameString());
+		const FName FromUtf8(Plain.Length(), reinterpret_cast<const UTF8CHAR*>(Plain.Get()), Name.GetNumber(), FNAME_Find);
+		TestEqual(TEXT("FName from UTF-8"), FromUtf8, Name);
+	}
+
+	TestTrue(TEXT("FName from UTF-8 only finds"), FName(5, reinterpret_cast<const UTF8CHAR*>("\xC3\xA9NCT"), FNAME_Find).IsNone());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CString.h"
+#include "Hash/CityHash.h"
+#include "UObject/NameTypes.h"
+#include "UObject/NameLiteral.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNameLiteralTest, "System.Core.UObject.NameLiteral", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+static_assert(FNameLiteral::Make("Foo_12").Len == 3 && FNameLiteral::Make("Foo_12").Number == NAME_EXTERNAL_TO_INTERNAL(12), "Number suffix should be split at compile time");
+static_assert(FNameLiteral::Make("Foo_012").Len == 7 && FNameLiteral::Make("Foo_012").Number == NAME_NO_NUMBER_INTERNAL, "Numbers with leading zeroes are part of the name");
+
+template<int32 N>
+static bool TestLiteralHashes(const ANSICHAR (&Literal)[N])
+{
+	const FNameLiteral NameLiteral = FNameLiteral::Make(Literal);
+
+	ANSICHAR Lower[N];
+	for (int32 Index = 0; Index < N; ++Index)
+	{
+		Lower[Index] = FCharAnsi::ToLower(Literal[Index]);
+	}
+
+	return NameLiteral.DisplayHash == CityHash64(NameLiteral.Str, NameLiteral.Len) && NameLiteral.ComparisonHash == CityHash64(Lower, NameLiteral.Len);
+}
+
+/** Test that names made from literals hashed at compile time are the same as the ones made at runtime. */
+bool FNameLiteralTest::RunTest(const FString& Parameters)
+{
+	// cover each of the CityHash length ranges
+	TestTrue(TEXT("Compile time hash of an empty string"), TestLiteralHashes(""));
+	TestTrue(TEXT("Compile time hash of 1 to 3 characters"), TestLiteralHashes("Abc"));
+	TestTrue(TEXT("Compile time hash of 4 to 7 characters"), TestLiteralHashes("AbcDefG"));
+	TestTrue(TEXT("Compile time hash of 8 to 16 characters"), TestLiteralHashes("AbcDefGhiJklMnoP"));
+	TestTrue(TEXT("Compile time hash of 17 to 32 characters"), TestLiteralHashes("AbcDefGhiJklMnoPqrStuVwxYz012345"));
+	TestTrue(TEXT("Compile time hash of 33 to 64 characters"), TestLiteralHashes("AbcDefGhiJklMnoPqrStuVwxYz0123456789AbcDefGhiJklMnoPqrStuVwxYz"));
+	TestTrue(TEXT("Compile time hash of more than 64 characters"), TestLiteralHashes("AbcDefGhiJklMnoPqrStuVwxYz0123456789AbcDefGhiJklMnoPqrStuVwxYz0123456789AbcDefGhiJklMnoPqrStuVwxYz0123456789AbcDefGhiJklMnoPqrStuVwxYz"));
+
+	TestEqual(TEXT("Empty literal"), UE_FNAME_LITERAL(""), FName());
+	TestEqual(TEXT("Plain literal"), UE_FNAME_LITERAL("NameLiteralTest"), FName(TEXT("NameLiteralTest")));
+	TestEqual(TEXT("Literal with number"), UE_FNAME_LITERAL("NameLiteralTest_12"), FName(TEXT("NameLiteralTest_12")));
+	TestEqual(TEXT("Literal with number suffix"), UE_FNAME_LITERAL("NameLiteralTest_12").GetNumber(), NAME_EXTERNAL_TO_INTERNAL(12));
+	TestEqual(TEXT("Literal with leading zero"), UE_FNAME_LITERAL("NameLiteralTest_012"), FName(TEXT("NameLiteralTest_012")));
+	TestEqual(TEXT("Long literal"), UE_FNAME_LITERAL("NameLiteralTest_ThatIsLongerThanSixtyFourCharactersToCoverTheLoopInCityHash64"), FName(TEXT("NameLiteralTest_ThatIsLongerThanSixtyFourCharactersToCoverTheLoopInCityHash64")));
+
+	// comparison is case-insensitive but the display string is kept as written
+	TestEqual(TEXT("Literals differing in case compare equal"), UE_FNAME_LITERAL("namelitERALtest"), FName(TEXT("NameLiteralTest")));
+	TestTrue(TEXT("Literal keeps its own case"), UE_FNAME_LITERAL("NameLiteralTestCase").ToString().Equals(TEXT("NameLiteralTestCase"), ESearchCase::CaseSensitive));
+
+	TestTrue(TEXT("Finding a missing literal doesn't add it"), FName(FNameLiteral::Make("NameLiteralTest_NeverAdded"), FNAME_Find).IsNone());
+	TestEqual(TEXT("Finding an existing literal"), FName(FNameLiteral::Make("NameLiteralTest"), FNAME_Find), FName(TEXT("NameLiteralTest")));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
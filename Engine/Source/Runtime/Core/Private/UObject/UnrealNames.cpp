@@ -27,6 +27,14 @@
 #include "Serialization/MemoryImage.h"
 #include "Hash/CityHash.h"
 #include "Templates/AlignmentTemplates.h"
+#include "Templates/Atomic.h"
+#include "UObject/NameLiteral.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/Function.h"
+#include "ProfilingDebugging/StartupPhases.h"
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -254,6 +262,20 @@ struct FNameSlot
 	bool operator==(FNameSlot Rhs) const { return IdAndHash == Rhs.IdAndHash; }
 
 	bool Used() const { return !!IdAndHash;  }
+
+	/** Reads a slot that may be claimed concurrently, used by lock-free finds */
+	FNameSlot Load() const
+	{
+		FNameSlot Out;
+		Out.IdAndHash = (uint32)FPlatformAtomics::AtomicRead((volatile const int32*)&IdAndHash);
+		return Out;
+	}
+
+	/** Claims a slot, the entry it points to must be fully written before */
+	void Store(FNameSlot Value)
+	{
+		FPlatformAtomics::AtomicStore((volatile int32*)&IdAndHash, (int32)Value.IdAndHash);
+	}
 private:
 	uint32 IdAndHash = 0;
 };
@@ -278,7 +300,10 @@ public:
 	{
 		for (uint32 Index = 0; Index <= CurrentBlock; ++Index)
 		{
-			FMemory::Free(Blocks[Index]);
+			if (Index - FirstAttachedBlock >= NumAttachedBlocks)
+			{
+				FMemory::Free(Blocks[Index]);
+			}
 		}
 	}
 
@@ -333,6 +358,14 @@ public:
 		Entry.ComparisonId = ComparisonId.IsSet() ? ComparisonId.GetValue() : FNameEntryId(Handle);
 #endif
 
+		WriteEntry(Entry, Name, Header);
+
+		return Handle;
+	}
+
+	/** Writes a new entry in place, without its comparison id */
+	static void WriteEntry(FNameEntry& Entry, FNameStringView Name, FNameEntryHeader Header)
+	{
 		Entry.Header = Header;
 		
 		if (Name.bIsWide)
@@ -343,8 +376,52 @@ public:
 		{
 			Entry.StoreName(Name.Ansi, Name.Len);
 		}
+	}
 
-		return Handle;
+	/**
+	 * Makes blocks of entries that live elsewhere, such as in memory shared between processes, part of the allocator.
+	 * They are never written to or freed. The current block is closed and allocation continues after the attached ones.
+	 *
+	 * @param BlockData Num blocks of BlockSizeBytes each
+	 * @return Index of the first attached block
+	 */
+	uint32 AttachBlocks(uint8* BlockData, uint32 Num)
+	{
+		FWriteScopeLock _(Lock);
+		checkf(NumAttachedBlocks == 0, TEXT("Only one range of name blocks can be attached"));
+
+		CloseCurrentBlock();
+		const uint32 FirstBlock = CurrentBlock + 1;
+
+		// Move reserved blocks past the attached ones
+		uint32 NumReserved = 0;
+		while (FirstBlock + NumReserved < FNameMaxBlocks && Blocks[FirstBlock + NumReserved])
+		{
+			++NumReserved;
+		}
+		check(FirstBlock + Num + FMath::Max(NumReserved, 1u) <= FNameMaxBlocks);
+		for (uint32 Idx = NumReserved; Idx-- > 0; )
+		{
+			Blocks[FirstBlock + Num + Idx] = Blocks[FirstBlock + Idx];
+			Blocks[FirstBlock + Idx] = nullptr;
+		}
+
+		for (uint32 Idx = 0; Idx < Num; ++Idx)
+		{
+			Blocks[FirstBlock + Idx] = BlockData + Idx * BlockSizeBytes;
+		}
+		FirstAttachedBlock = FirstBlock;
+		NumAttachedBlocks = Num;
+
+		CurrentBlock = FirstBlock + Num;
+		CurrentByteCursor = 0;
+		if (Blocks[CurrentBlock] == nullptr)
+		{
+			LLM_SCOPE(ELLMTag::FName);
+			Blocks[CurrentBlock] = AllocBlock();
+		}
+
+		return FirstBlock;
 	}
 
 	FNameEntry& Resolve(FNameEntryHandle Handle) const
@@ -407,9 +484,8 @@ private:
 		return (uint8*)FMemory::MallocPersistentAuxiliary(BlockSizeBytes, FPlatformMemory::GetConstants().PageSize);
 	}
 	
-	void AllocateNewBlock()
+	void CloseCurrentBlock()
 	{
-		LLM_SCOPE(ELLMTag::FName);
 		// Null-terminate final entry to allow DebugDump() entry iteration
 		if (CurrentByteCursor + FNameEntry::GetDataOffset() <= BlockSizeBytes)
 		{
@@ -420,6 +496,12 @@ private:
 #if FNAME_WRITE_PROTECT_PAGES
 		FPlatformMemory::PageProtect(Blocks[CurrentBlock], BlockSizeBytes, /* read */ true, /* write */ false);
 #endif
+	}
+
+	void AllocateNewBlock()
+	{
+		LLM_SCOPE(ELLMTag::FName);
+		CloseCurrentBlock();
 		++CurrentBlock;
 		CurrentByteCursor = 0;
 
@@ -436,6 +518,9 @@ private:
 	uint32 CurrentBlock = 0;
 	uint32 CurrentByteCursor = 0;
 	uint8* Blocks[FNameMaxBlocks] = {};
+	/** Blocks from AttachBlocks, which aren't freed */
+	uint32 FirstAttachedBlock = 0;
+	uint32 NumAttachedBlocks = 0;
 };
 
 // Increasing shards reduces contention but uses more memory and adds cache pressure.
@@ -623,6 +708,43 @@ struct FNullScopeLock
 	FNullScopeLock(FRWLock&) {}
 };
 
+/**
+ * Open addressing table of one shard. Tables are never resized in place, growing publishes a new table and
+ * retires the old one, which stays alive for lock-free readers that may still be probing it.
+ */
+struct FNameSlotTable
+{
+	uint32 CapacityMask;
+	FNameSlotTable* Retired;
+
+	uint32 Capacity() const { return CapacityMask + 1; }
+
+	FNameSlot* GetSlots() { return reinterpret_cast<FNameSlot*>(this + 1); }
+	const FNameSlot* GetSlots() const { return reinterpret_cast<const FNameSlot*>(this + 1); }
+
+	static FNameSlotTable* Allocate(uint32 Capacity, FNameSlotTable* Retired)
+	{
+		FNameSlotTable* Table = (FNameSlotTable*)FMemory::Malloc(sizeof(FNameSlotTable) + Capacity * sizeof(FNameSlot), alignof(FNameSlotTable));
+		Table->CapacityMask = Capacity - 1;
+		Table->Retired = Retired;
+		memset(Table->GetSlots(), 0, Capacity * sizeof(FNameSlot));
+		return Table;
+	}
+
+	/** Frees the table and all tables it retired. */
+	static void Free(FNameSlotTable* Table)
+	{
+		while (Table)
+		{
+			FNameSlotTable* Retired = Table->Retired;
+			FMemory::Free(Table);
+			Table = Retired;
+		}
+	}
+};
+
+static_assert(sizeof(FNameSlotTable) % alignof(FNameSlot) == 0, "Slots must follow the table header aligned");
+
 class alignas(PLATFORM_CACHE_LINE_SIZE) FNamePoolShardBase : FNoncopyable
 {
 public:
@@ -631,24 +753,21 @@ public:
 		LLM_SCOPE(ELLMTag::FName);
 		Entries = &InEntries;
 
-		Slots = (FNameSlot*)FMemory::Malloc(FNamePoolInitialSlotsPerShard * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, FNamePoolInitialSlotsPerShard * sizeof(FNameSlot));
-		CapacityMask = FNamePoolInitialSlotsPerShard - 1;
+		Table = FNameSlotTable::Allocate(FNamePoolInitialSlotsPerShard, nullptr);
 	}
 
 	// This and ~FNamePool() is not called during normal shutdown
 	// but only via explicit FName::TearDown() call
 	~FNamePoolShardBase()
 	{
-		FMemory::Free(Slots);
+		FNameSlotTable::Free(Table.Load(EMemoryOrder::Relaxed));
 		UsedSlots = 0;
-		CapacityMask = 0;
-		Slots = nullptr;
+		Table = nullptr;
 		NumCreatedEntries = 0;
 		NumCreatedWideEntries = 0;
 	}
 
-	uint32 Capacity() const	{ return CapacityMask + 1; }
+	uint32 Capacity() const	{ return Table.Load(EMemoryOrder::Relaxed)->Capacity(); }
 
 	uint32 NumCreated() const { return NumCreatedEntries; }
 	uint32 NumCreatedWide() const { return NumCreatedWideEntries; }
@@ -660,10 +779,10 @@ public:
 protected:
 	enum { LoadFactorQuotient = 9, LoadFactorDivisor = 10 }; // I.e. realloc slots when 90% full
 
+	/** Only taken by writers, finds probe the published table without locking */
 	mutable FRWLock Lock;
 	uint32 UsedSlots = 0;
-	uint32 CapacityMask = 0;
-	FNameSlot* Slots = nullptr;
+	TAtomic<FNameSlotTable*> Table;
 	FNameEntryAllocator* Entries = nullptr;
 	uint32 NumCreatedEntries = 0;
 	uint32 NumCreatedWideEntries = 0;
@@ -680,14 +799,31 @@ template<ENameCase Sensitivity>
 class FNamePoolShard : public FNamePoolShardBase
 {
 public:
+	/**
+	 * Lock-free, slots only ever go from unused to used and a slot is published after its entry has been written.
+	 * A find racing with the insertion of the same name may miss it, Store() resolves that by retrying under the lock.
+	 */
 	FNameEntryId Find(const FNameValue<Sensitivity>& Value) const
 	{
-		FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
-
-		return Probe(Value).GetId();
+		const FNameSlotTable* CurrentTable = Table.Load(EMemoryOrder::SequentiallyConsistent);
+		const FNameSlot* Slots = CurrentTable->GetSlots();
+		const uint32 Mask = CurrentTable->CapacityMask;
+		for (uint32 I = FNameHash::GetProbeStart(Value.Hash.UnmaskedSlotIndex, Mask); true; I = (I + 1) & Mask)
+		{
+			const FNameSlot Slot = Slots[I].Load();
+			if (!Slot.Used())
+			{
+				return FNameEntryId();
+			}
+			if (Slot.GetProbeHash() == Value.Hash.SlotProbeHash && EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value))
+			{
+				return Slot.GetId();
+			}
+		}
 	}
 
-	template<class ScopeLock = FWriteScopeLock>
+	/** EntryScopeLock guards the entry allocator, which is shared by all shards */
+	template<class ScopeLock = FWriteScopeLock, class EntryScopeLock = ScopeLock>
 	FORCEINLINE FNameEntryId Insert(const FNameValue<Sensitivity>& Value, bool& bCreatedNewEntry)
 	{
 		ScopeLock _(Lock);
@@ -698,7 +834,7 @@ public:
 			return Slot.GetId();
 		}
 
-		FNameEntryId NewEntryId = Entries->Create<ScopeLock>(Value.Name, Value.ComparisonId, Value.Hash.EntryProbeHeader);
+		FNameEntryId NewEntryId = Entries->Create<EntryScopeLock>(Value.Name, Value.ComparisonId, Value.Hash.EntryProbeHeader);
 
 		ClaimSlot(Slot, FNameSlot(NewEntryId, Value.Hash.SlotProbeHash));
 
@@ -709,6 +845,26 @@ public:
 		return NewEntryId;
 	}
 
+	/** Inserts an entry that is already written, see FNameEntryAllocator::AttachBlocks, unless an equal one is found */
+	template<class ScopeLock = FWriteScopeLock>
+	FNameEntryId InsertWrittenEntry(const FNameValue<Sensitivity>& Value, FNameEntryId WrittenId)
+	{
+		ScopeLock _(Lock);
+		FNameSlot& Slot = Probe(Value);
+
+		if (Slot.Used())
+		{
+			return Slot.GetId();
+		}
+
+		ClaimSlot(Slot, FNameSlot(WrittenId, Value.Hash.SlotProbeHash));
+
+		++NumCreatedEntries;
+		NumCreatedWideEntries += Value.Name.bIsWide;
+
+		return WrittenId;
+	}
+
 	void InsertExistingEntry(FNameHash Hash, FNameEntryId ExistingId)
 	{
 		FNameSlot NewLookup(ExistingId, Hash.SlotProbeHash);
@@ -736,7 +892,8 @@ public:
 private:
 	void ClaimSlot(FNameSlot& UnusedSlot, FNameSlot NewValue)
 	{
-		UnusedSlot = NewValue;
+		// publishes the slot to lock-free finds
+		UnusedSlot.Store(NewValue);
 
 		++UsedSlots;
 		if (UsedSlots * LoadFactorDivisor >= LoadFactorQuotient * Capacity())
@@ -753,15 +910,15 @@ private:
 	void Grow(const uint32 NewCapacity)
 	{
 		LLM_SCOPE(ELLMTag::FName);
-		FNameSlot* const OldSlots = Slots;
+		FNameSlotTable* const OldTable = Table.Load(EMemoryOrder::Relaxed);
+		const FNameSlot* const OldSlots = OldTable->GetSlots();
 		const uint32 OldUsedSlots = UsedSlots;
-		const uint32 OldCapacity = Capacity();
+		const uint32 OldCapacity = OldTable->Capacity();
 
-		Slots = (FNameSlot*)FMemory::Malloc(NewCapacity * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, NewCapacity * sizeof(FNameSlot));
+		// readers may still be probing the old table, so it is retired rather than freed. The retired
+		// tables add up to less than the live one since capacity at least doubles on every growth.
+		FNameSlotTable* NewTable = FNameSlotTable::Allocate(NewCapacity, OldTable);
 		UsedSlots = 0;
-		CapacityMask = NewCapacity - 1;
-
 
 		for (uint32 OldIdx = 0; OldIdx < OldCapacity; ++OldIdx)
 		{
@@ -769,7 +926,7 @@ private:
 			if (OldSlot.Used())
 			{
 				FNameHash Hash = Rehash(OldSlot.GetId());
-				FNameSlot& NewSlot = Probe(Hash.UnmaskedSlotIndex, [](FNameSlot Slot) { return false; });
+				FNameSlot& NewSlot = Probe(NewTable, Hash.UnmaskedSlotIndex, [](FNameSlot Slot) { return false; });
 				NewSlot = OldSlot;
 				++UsedSlots;
 			}
@@ -777,7 +934,8 @@ private:
 
 		check(OldUsedSlots == UsedSlots);
 
-		FMemory::Free(OldSlots);
+		// publish the fully built table
+		Table.Store(NewTable, EMemoryOrder::SequentiallyConsistent);
 	}
 
 	/** Find slot containing value or the first free slot that should be used to store it  */
@@ -788,11 +946,18 @@ private:
 									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); });
 	}
 
-	/** Find slot that fulfills predicate or the first free slot  */
+	/** Find slot that fulfills predicate or the first free slot, must be called with the lock held */
 	template<class PredicateFn>
 	FORCEINLINE FNameSlot& Probe(uint32 UnmaskedSlotIndex, PredicateFn Predicate) const
 	{
-		const uint32 Mask = CapacityMask;
+		return Probe(Table.Load(EMemoryOrder::Relaxed), UnmaskedSlotIndex, Predicate);
+	}
+
+	template<class PredicateFn>
+	FORCEINLINE static FNameSlot& Probe(FNameSlotTable* InTable, uint32 UnmaskedSlotIndex, PredicateFn Predicate)
+	{
+		FNameSlot* Slots = InTable->GetSlots();
+		const uint32 Mask = InTable->CapacityMask;
 		for (uint32 I = FNameHash::GetProbeStart(UnmaskedSlotIndex, Mask); true; I = (I + 1) & Mask)
 		{
 			FNameSlot& Slot = Slots[I];
@@ -821,6 +986,9 @@ public:
 	FNameEntryId	Store(FNameStringView View);
 	FNameEntryId	Find(FNameStringView View) const;
 	FNameEntryId	Find(EName Ename) const;
+	/** Store and find with hashes computed ahead of time, see FNameLiteral */
+	FNameEntryId	StorePrehashed(FNameStringView View, uint64 ComparisonHash, uint64 DisplayHash);
+	FNameEntryId	FindPrehashed(FNameStringView View, uint64 ComparisonHash, uint64 DisplayHash) const;
 	const EName*	FindEName(FNameEntryId Id) const;
 
 	/** @pre !!Handle */
@@ -832,6 +1000,15 @@ public:
 	FNameEntryId	BatchStore(const FNameComparisonValue& ComparisonValue);
 	void			BatchUnlock();
 
+	/** Batch insertion into one comparison shard, other shards can be inserted into concurrently as entries are allocated under the allocator lock */
+	void			ShardBatchLock(uint32 ShardIndex) { ComparisonShards[ShardIndex].BatchLock(); }
+	FNameEntryId	ShardBatchStore(const FNameComparisonValue& ComparisonValue);
+	void			ShardBatchUnlock(uint32 ShardIndex) { ComparisonShards[ShardIndex].BatchUnlock(); }
+
+	/** Entries written ahead of time, see FNameEntryAllocator::AttachBlocks. Stored between BatchLock() and BatchUnlock(). */
+	uint32			AttachBlocks(uint8* BlockData, uint32 Num) { return Entries.AttachBlocks(BlockData, Num); }
+	FNameEntryId	BatchStoreWritten(const FNameComparisonValue& ComparisonValue, FNameEntryId WrittenId);
+
 	/// Stats and debug related functions ///
 
 	uint32			NumEntries() const;
@@ -846,6 +1023,12 @@ public:
 private:
 	enum { MaxENames = 512 };
 
+#if WITH_CASE_PRESERVING_NAME
+	FNameEntryId	Store(const FNameComparisonValue& ComparisonValue, FNameDisplayValue DisplayValue);
+#else
+	FNameEntryId	Store(const FNameComparisonValue& ComparisonValue);
+#endif
+
 	FNameEntryAllocator Entries;
 
 #if WITH_CASE_PRESERVING_NAME
@@ -861,6 +1044,8 @@ private:
 
 FNamePool::FNamePool()
 {
+	SCOPED_STARTUP_PHASE(TEXT("NamePool"));
+
 	for (FNamePoolShardBase& Shard : ComparisonShards)
 	{
 		Shard.Initialize(Entries);
@@ -937,10 +1122,54 @@ FNameEntryId FNamePool::Find(FNameStringView Name) const
 	return ComparisonShards[ComparisonValue.Hash.ShardIndex].Find(ComparisonValue);
 }
 
+FNameEntryId FNamePool::FindPrehashed(FNameStringView Name, uint64 ComparisonHash, uint64 DisplayHash) const
+{
+	check(Name.IsAnsi());
+	checkfSlow(ComparisonHash == HashName<ENameCase::IgnoreCase>(Name), TEXT("Precalculated hash was wrong"));
+
+#if WITH_CASE_PRESERVING_NAME
+	FNameDisplayValue DisplayValue(Name, FNameHash(Name.Ansi, Name.Len, DisplayHash));
+	if (FNameEntryId Existing = DisplayShards[DisplayValue.Hash.ShardIndex].Find(DisplayValue))
+	{
+		return Existing;
+	}
+#endif
+
+	FNameComparisonValue ComparisonValue(Name, FNameHash(Name.Ansi, Name.Len, ComparisonHash));
+	return ComparisonShards[ComparisonValue.Hash.ShardIndex].Find(ComparisonValue);
+}
+
 FNameEntryId FNamePool::Store(FNameStringView Name)
 {
 #if WITH_CASE_PRESERVING_NAME
-	FNameDisplayValue DisplayValue(Name);
+	return Store(FNameComparisonValue(Name), FNameDisplayValue(Name));
+#else
+	return Store(FNameComparisonValue(Name));
+#endif
+}
+
+FNameEntryId FNamePool::StorePrehashed(FNameStringView Name, uint64 ComparisonHash, uint64 DisplayHash)
+{
+	check(Name.IsAnsi());
+	checkfSlow(ComparisonHash == HashName<ENameCase::IgnoreCase>(Name), TEXT("Precalculated hash was wrong"));
+
+#if WITH_CASE_PRESERVING_NAME
+	checkfSlow(DisplayHash == HashName<ENameCase::CaseSensitive>(Name), TEXT("Precalculated hash was wrong"));
+	return Store(FNameComparisonValue(Name, FNameHash(Name.Ansi, Name.Len, ComparisonHash)), FNameDisplayValue(Name, FNameHash(Name.Ansi, Name.Len, DisplayHash)));
+#else
+	return Store(FNameComparisonValue(Name, FNameHash(Name.Ansi, Name.Len, ComparisonHash)));
+#endif
+}
+
+#if WITH_CASE_PRESERVING_NAME
+FORCEINLINE FNameEntryId FNamePool::Store(const FNameComparisonValue& ComparisonValue, FNameDisplayValue DisplayValue)
+#else
+FORCEINLINE FNameEntryId FNamePool::Store(const FNameComparisonValue& ComparisonValue)
+#endif
+{
+	const FNameStringView Name = ComparisonValue.Name;
+
+#if WITH_CASE_PRESERVING_NAME
 	FNamePoolShard<ENameCase::CaseSensitive>& DisplayShard = DisplayShards[DisplayValue.Hash.ShardIndex];
 	if (FNameEntryId Existing = DisplayShard.Find(DisplayValue))
 	{
@@ -951,7 +1180,6 @@ FNameEntryId FNamePool::Store(FNameStringView Name)
 	bool bAdded = false;
 
 	// Insert comparison name first since display value must contain comparison name
-	FNameComparisonValue ComparisonValue(Name);
 	FNameEntryId ComparisonId = ComparisonShards[ComparisonValue.Hash.ShardIndex].Insert(ComparisonValue, bAdded);
 
 #if WITH_CASE_PRESERVING_NAME
@@ -988,6 +1216,17 @@ FORCEINLINE FNameEntryId FNamePool::BatchStore(const FNameComparisonValue& Compa
 	return ComparisonShards[ComparisonValue.Hash.ShardIndex].Insert<FNullScopeLock>(ComparisonValue, bCreatedNewEntry);
 }
 
+FORCEINLINE FNameEntryId FNamePool::ShardBatchStore(const FNameComparisonValue& ComparisonValue)
+{
+	bool bCreatedNewEntry;
+	return ComparisonShards[ComparisonValue.Hash.ShardIndex].Insert<FNullScopeLock, FWriteScopeLock>(ComparisonValue, bCreatedNewEntry);
+}
+
+FORCEINLINE FNameEntryId FNamePool::BatchStoreWritten(const FNameComparisonValue& ComparisonValue, FNameEntryId WrittenId)
+{
+	return ComparisonShards[ComparisonValue.Hash.ShardIndex].InsertWrittenEntry<FNullScopeLock>(ComparisonValue, WrittenId);
+}
+
 void FNamePool::BatchUnlock()
 {
 	Entries.BatchUnlock();
@@ -1351,37 +1590,25 @@ static const TCHAR* EntryToCString(const FNameEntry& Entry, FNameBuffer& Temp)
 
 FString FNameEntry::GetPlainNameString() const
 {
-	FNameBuffer Temp;
-	if (Header.bIsWide)
-	{
-		return FString(Header.Len, GetUnterminatedName(Temp.WideName));
-	}
-	else
-	{
-		return FString(Header.Len, GetUnterminatedName(Temp.AnsiName));
-	}
+	FString Out;
+	AppendNameToString(Out);
+	return Out;
 }
 
 void FNameEntry::AppendNameToString(FString& Out) const
 {
-	FNameBuffer Temp;
-	Out.Append(EntryToCString(*this, Temp), Header.Len);
+	// Written straight into the string rather than through a temporary buffer
+	TArray<TCHAR>& Chars = Out.GetCharArray();
+	const int32 OldLen = Out.Len();
+	Chars.SetNumUninitialized(OldLen + Header.Len + 1, false);
+	CopyAndConvertUnterminatedName(Chars.GetData() + OldLen);
+	Chars[OldLen + Header.Len] = TEXT('\0');
 }
 
 void FNameEntry::AppendNameToString(FStringBuilderBase& Out) const
 {
 	const int32 Offset = Out.AddUninitialized(Header.Len);
-	TCHAR* OutChars = Out.GetData() + Offset;
-	if (Header.bIsWide)
-	{
-		CopyUnterminatedName(reinterpret_cast<WIDECHAR*>(OutChars));
-		ConvertInPlace<WIDECHAR, TCHAR>(reinterpret_cast<WIDECHAR*>(OutChars), Header.Len);
-	}
-	else
-	{
-		CopyUnterminatedName(reinterpret_cast<ANSICHAR*>(OutChars));
-		ConvertInPlace<ANSICHAR, TCHAR>(reinterpret_cast<ANSICHAR*>(OutChars), Header.Len);
-	}
+	CopyAndConvertUnterminatedName(Out.GetData() + Offset);
 }
 
 void FNameEntry::AppendAnsiNameToString(FAnsiStringBuilderBase& Out) const
@@ -1391,6 +1618,47 @@ void FNameEntry::AppendAnsiNameToString(FAnsiStringBuilderBase& Out) const
 	CopyUnterminatedName(Out.GetData() + Offset);
 }
 
+void FNameEntry::AppendUtf8NameToString(FAnsiStringBuilderBase& Out) const
+{
+	FNameBuffer Temp;
+	if (Header.bIsWide)
+	{
+		const WIDECHAR* Name = GetUnterminatedName(Temp.WideName);
+		const int32 Utf8Len = FTCHARToUTF8_Convert::ConvertedLength(Name, Header.Len);
+		const int32 Offset = Out.AddUninitialized(Utf8Len);
+		FTCHARToUTF8_Convert::Convert(Out.GetData() + Offset, Utf8Len, Name, Header.Len);
+		return;
+	}
+
+	// ANSI names are almost always ASCII and copied as is, other characters are Latin-1 and take two bytes
+	const ANSICHAR* Name = GetUnterminatedName(Temp.AnsiName);
+	int32 NumHighChars = 0;
+	for (uint32 Index = 0; Index < Header.Len; ++Index)
+	{
+		NumHighChars += uint8(Name[Index]) >> 7;
+	}
+
+	ANSICHAR* OutChars = Out.GetData() + Out.AddUninitialized(Header.Len + NumHighChars);
+	if (NumHighChars == 0)
+	{
+		FMemory::Memcpy(OutChars, Name, Header.Len);
+		return;
+	}
+	for (uint32 Index = 0; Index < Header.Len; ++Index)
+	{
+		const uint8 Char = uint8(Name[Index]);
+		if (Char < 0x80)
+		{
+			*OutChars++ = ANSICHAR(Char);
+		}
+		else
+		{
+			*OutChars++ = ANSICHAR(0xC0 | (Char >> 6));
+			*OutChars++ = ANSICHAR(0x80 | (Char & 0x3F));
+		}
+	}
+}
+
 void FNameEntry::AppendNameToPathString(FString& Out) const
 {
 	FNameBuffer Temp;
@@ -1865,6 +2133,45 @@ struct FNameHelper
 		return FName(ComparisonId, DisplayId, InternalNumber);
 	}
 
+	static FName MakeFromLiteral(const FNameLiteral& Literal, EFindName FindType)
+	{
+		if (Literal.Len == 0)
+		{
+			return FName();
+		}
+
+		FNameStringView View(Literal.Str, Literal.Len);
+		if (Literal.Len >= NAME_SIZE || FindType == FNAME_Replace_Not_Safe_For_Threading)
+		{
+			return Make(View, FindType, Literal.Number);
+		}
+
+		FNamePool& Pool = GetNamePool();
+
+		FNameEntryId DisplayId, ComparisonId;
+		if (FindType == FNAME_Add)
+		{
+			DisplayId = Pool.StorePrehashed(View, Literal.ComparisonHash, Literal.DisplayHash);
+#if WITH_CASE_PRESERVING_NAME
+			ComparisonId = Pool.Resolve(DisplayId).ComparisonId;
+#else
+			ComparisonId = DisplayId;
+#endif
+		}
+		else
+		{
+			check(FindType == FNAME_Find);
+			DisplayId = Pool.FindPrehashed(View, Literal.ComparisonHash, Literal.DisplayHash);
+#if WITH_CASE_PRESERVING_NAME
+			ComparisonId = DisplayId ? Pool.Resolve(DisplayId).ComparisonId : DisplayId;
+#else
+			ComparisonId = DisplayId;
+#endif
+		}
+
+		return FName(ComparisonId, DisplayId, Literal.Number);
+	}
+
 	static FName MakeFromLoaded(const FNameEntrySerialized& LoadedEntry)
 	{
 		FNameStringView View = LoadedEntry.bIsWide
@@ -1940,6 +2247,38 @@ FName::FName(const FAnsiStringView& Name, EFindName FindType)
 	: FName(FNameHelper::MakeDetectNumber(MakeUnconvertedView(Name.GetData(), Name.Len()), FindType))
 {}
 
+/** UTF-8 that is plain ASCII is stored as an ANSI name as is, anything else is decoded to a wide name */
+static FName MakeFromUtf8(const UTF8CHAR* Name, int32 Len, EFindName FindType, int32 InNumber)
+{
+	uint32 AllBits = 0;
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		AllBits |= Name[Index];
+	}
+
+	if (!(AllBits & 0x80))
+	{
+		const FNameAnsiStringView View = MakeUnconvertedView(reinterpret_cast<const ANSICHAR*>(Name), Len);
+		return InNumber != NAME_NO_NUMBER_INTERNAL ? FNameHelper::MakeWithNumber(View, FindType, InNumber) : FNameHelper::MakeDetectNumber(View, FindType);
+	}
+
+	const FUTF8ToTCHAR Wide(reinterpret_cast<const ANSICHAR*>(Name), Len);
+	const FWideStringViewWithWidth View = MakeUnconvertedView(Wide.Get(), Wide.Length());
+	return InNumber != NAME_NO_NUMBER_INTERNAL ? FNameHelper::MakeWithNumber(View, FindType, InNumber) : FNameHelper::MakeDetectNumber(View, FindType);
+}
+
+FName::FName(int32 Len, const UTF8CHAR* Name, EFindName FindType)
+	: FName(MakeFromUtf8(Name, Len, FindType, NAME_NO_NUMBER_INTERNAL))
+{}
+
+FName::FName(int32 Len, const UTF8CHAR* Name, int32 InNumber, EFindName FindType)
+	: FName(MakeFromUtf8(Name, Len, FindType, InNumber))
+{}
+
+FName::FName(const FNameLiteral& Literal, EFindName FindType)
+	: FName(FNameHelper::MakeFromLiteral(Literal, FindType))
+{}
+
 FName::FName(const WIDECHAR* Name, int32 InNumber, EFindName FindType)
 	: FName(FNameHelper::MakeWithNumber(MakeUnconvertedView(Name), FindType, InNumber))
 {}
@@ -1966,6 +2305,24 @@ FName::FName(const FAnsiStringView& Name, int32 InNumber, EFindName FindType)
 	: FName(Name.Len(), Name.GetData(), InNumber, FindType)
 {}
 
+bool FName::FindExisting(const FStringView& Name, FName& OutName)
+{
+	// Empty strings and "None" are NAME_None without being looked up, like every string that isn't a name
+	OutName = FName(Name, FNAME_Find);
+	return !OutName.IsNone() || Name.IsEmpty() || Name.Equals(TEXT("None"), ESearchCase::IgnoreCase);
+}
+
+bool FName::FindExisting(const FAnsiStringView& Name, FName& OutName)
+{
+	OutName = FName(Name, FNAME_Find);
+	return !OutName.IsNone() || Name.IsEmpty() || Name.Equals("None", ESearchCase::IgnoreCase);
+}
+
+bool FName::FindExisting(const TCHAR* Name, FName& OutName)
+{
+	return FindExisting(Name ? FStringView(Name) : FStringView(), OutName);
+}
+
 FName::FName(const TCHAR* Name, int32 InNumber, EFindName FindType, bool bSplitName)
 	: FName(InNumber == NAME_NO_NUMBER_INTERNAL && bSplitName 
 			? FNameHelper::MakeDetectNumber(MakeUnconvertedView(Name), FindType)
@@ -2155,6 +2512,17 @@ bool FName::TryAppendAnsiString(FAnsiStringBuilderBase& Out) const
 	return true;
 }
 
+void FName::AppendUtf8String(FAnsiStringBuilderBase& Out) const
+{
+	GetDisplayNameEntry()->AppendUtf8NameToString(Out);
+
+	const int32 InternalNumber = GetNumber();
+	if (InternalNumber != NAME_NO_NUMBER_INTERNAL)
+	{
+		Out << '_' << NAME_INTERNAL_TO_EXTERNAL(InternalNumber);
+	}
+}
+
 void FName::DisplayHash(FOutputDevice& Ar)
 {
 	GetNamePool().LogStats(Ar);
@@ -2881,6 +3249,119 @@ static FNameEntryId BatchLoadNameWithHash(const FNameSerializedView& InName, uin
 	}
 }
 
+// Below this many names the batch is loaded on the calling thread, as starting the tasks costs more than they save
+static constexpr int32 ParallelNameBatchMinNames = 16384;
+
+/** Returns a view that can be stored, names that can't be used in place are converted into Temp */
+static FNameStringView MakeLoadedNameView(const FNameSerializedView& Name, WIDECHAR (&Temp)[NAME_SIZE])
+{
+	if (!Name.bIsUtf16)
+	{
+		return FNameStringView(Name.Ansi, Name.Len);
+	}
+
+#if PLATFORM_LITTLE_ENDIAN
+	if (sizeof(UTF16CHAR) == sizeof(WIDECHAR))
+	{
+		return FNameStringView(reinterpret_cast<const WIDECHAR*>(Name.Utf16), Name.Len);
+	}
+#endif
+
+	uint32 Len = Name.Len;
+	for (uint32 Idx = 0; Idx < Len; ++Idx)
+	{
+		Temp[Idx] = INTEL_ORDER16(Name.Utf16[Idx]);
+	}
+
+#if PLATFORM_TCHAR_IS_4_BYTES
+	Len = StringConv::InlineCombineSurrogates_Buffer(Temp, Len);
+#endif
+
+	return FNameStringView(Temp, Len);
+}
+
+/**
+ * Hashes the names on task graph workers, using the saved hashes of names stored as is, then inserts them into the
+ * comparison shards concurrently. Each task takes the lock of the shard it fills once, instead of BatchLock locking the whole pool.
+ */
+static void LoadNameBatchParallel(TArray<FNameEntryId>& OutNames, const uint8* NameIt, const uint8* NameEnd, TArrayView<const uint64> Hashes, bool bUseSavedHashes)
+{
+	TArray<FNameSerializedView> Views;
+	Views.Reserve(Hashes.Num());
+	while (NameIt < NameEnd)
+	{
+		Views.Add(LoadNameHeader(/* in-out */ NameIt));
+	}
+	check(NameIt == NameEnd);
+	check(!bUseSavedHashes || Views.Num() == Hashes.Num());
+
+	const int32 NumNames = Views.Num();
+	constexpr int32 NamesPerHashTask = 4096;
+	TArray<FNameHash> NameHashes;
+	NameHashes.SetNumUninitialized(NumNames);
+	ParallelFor((NumNames + NamesPerHashTask - 1) / NamesPerHashTask, [&](int32 TaskIndex)
+	{
+		WIDECHAR Temp[NAME_SIZE];
+		const int32 End = FMath::Min(NumNames, (TaskIndex + 1) * NamesPerHashTask);
+		for (int32 Index = TaskIndex * NamesPerHashTask; Index < End; ++Index)
+		{
+			FNameStringView Name = MakeLoadedNameView(Views[Index], Temp);
+			if (bUseSavedHashes && Name.Data == Views[Index].Data)
+			{
+				const uint64 Hash = INTEL_ORDER64(Hashes[Index]);
+				NameHashes[Index] = Name.bIsWide ? FNameHash(Name.Wide, Name.Len, Hash) : FNameHash(Name.Ansi, Name.Len, Hash);
+				checkfSlow(NameHashes[Index] == HashName<ENameCase::IgnoreCase>(Name), TEXT("Precalculated hash was wrong"));
+			}
+			else
+			{
+				NameHashes[Index] = HashName<ENameCase::IgnoreCase>(Name);
+			}
+		}
+	});
+
+	// Group the names by shard, keeping the batch order within each
+	TArray<int32> ShardStarts;
+	ShardStarts.SetNumZeroed(FNamePoolShards + 1);
+	for (const FNameHash& Hash : NameHashes)
+	{
+		++ShardStarts[Hash.ShardIndex + 1];
+	}
+	for (int32 ShardIndex = 0; ShardIndex < FNamePoolShards; ++ShardIndex)
+	{
+		ShardStarts[ShardIndex + 1] += ShardStarts[ShardIndex];
+	}
+	TArray<int32> ShardNameIndices;
+	ShardNameIndices.SetNumUninitialized(NumNames);
+	{
+		TArray<int32> ShardCursors(ShardStarts.GetData(), FNamePoolShards);
+		for (int32 Index = 0; Index < NumNames; ++Index)
+		{
+			ShardNameIndices[ShardCursors[NameHashes[Index].ShardIndex]++] = Index;
+		}
+	}
+
+	OutNames.SetNumUninitialized(NumNames);
+	FNamePool& Pool = GetNamePoolPostInit();
+	ParallelFor(FNamePoolShards, [&](int32 ShardIndex)
+	{
+		const int32 Begin = ShardStarts[ShardIndex];
+		const int32 End = ShardStarts[ShardIndex + 1];
+		if (Begin == End)
+		{
+			return;
+		}
+
+		WIDECHAR Temp[NAME_SIZE];
+		Pool.ShardBatchLock(ShardIndex);
+		for (int32 It = Begin; It < End; ++It)
+		{
+			const int32 Index = ShardNameIndices[It];
+			OutNames[Index] = Pool.ShardBatchStore(FNameComparisonValue(MakeLoadedNameView(Views[Index], Temp), NameHashes[Index]));
+		}
+		Pool.ShardBatchUnlock(ShardIndex);
+	});
+}
+
 void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData)
 {
 	check(IsAligned(NameData.GetData(), sizeof(uint64)));
@@ -2897,6 +3378,12 @@ void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameD
 
 	OutNames.Empty(Hashes.Num());
 
+	if (Hashes.Num() >= ParallelNameBatchMinNames && FPlatformProcess::SupportsMultithreading() && FTaskGraphInterface::IsRunning())
+	{
+		LoadNameBatchParallel(OutNames, NameIt, NameEnd, Hashes, HashVersion == FNameHash::AlgorithmId);
+		return;
+	}
+
 	GetNamePoolPostInit().BatchLock();
 
 	if (HashVersion == FNameHash::AlgorithmId)
@@ -2923,6 +3410,175 @@ void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameD
 	check(NameIt == NameEnd);
 }
 
+#if !WITH_CASE_PRESERVING_NAME
+
+/** Lives at the start of a shared name batch region, the entry blocks follow it */
+struct FSharedNameBatchHeader
+{
+	/** Set to SharedNameBatchReady once all the entries are written */
+	volatile int32 State;
+	uint32 NumBlocks;
+	uint64 BatchHash;
+};
+
+static constexpr int32 SharedNameBatchReady = 0x464E4D42;
+static constexpr uint32 SharedNameBatchBlocksOffset = PLATFORM_CACHE_LINE_SIZE;
+static_assert(sizeof(FSharedNameBatchHeader) <= SharedNameBatchBlocksOffset, "Entry blocks must follow the header");
+/** How long to wait for another process writing the shared entries before loading the names privately */
+static constexpr double SharedNameBatchMaxWaitSeconds = 10.0;
+
+/** The region attached to the name pool, which is never unmapped */
+static FPlatformMemory::FSharedMemoryRegion* SharedNameBatchRegion = nullptr;
+
+/** Maps the shared entries of a batch, writing them if this is the first process to load it */
+static uint8* MapSharedNameBatch(const FString& RegionName, uint64 BatchHash, uint32 NumBlocks, TFunctionRef<void(uint8*)> WriteBlocks)
+{
+	const SIZE_T RegionSize = SharedNameBatchBlocksOffset + SIZE_T(NumBlocks) * FNameEntryAllocator::BlockSizeBytes;
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, FPlatformMemory::ESharedMemoryAccess::Read, RegionSize);
+	if (Region)
+	{
+		// Another process created the region and may still be writing the entries
+		const FSharedNameBatchHeader& Header = *(const FSharedNameBatchHeader*)Region->GetAddress();
+		const double WaitStart = FPlatformTime::Seconds();
+		while (FPlatformAtomics::AtomicRead(&Header.State) != SharedNameBatchReady && FPlatformTime::Seconds() - WaitStart < SharedNameBatchMaxWaitSeconds)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+
+		if (FPlatformAtomics::AtomicRead(&Header.State) != SharedNameBatchReady || Header.NumBlocks != NumBlocks || Header.BatchHash != BatchHash)
+		{
+			UE_LOG(LogUnrealNames, Warning, TEXT("Shared name batch '%s' isn't ready or doesn't match, loading the names privately"), *RegionName);
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+			return nullptr;
+		}
+	}
+	else
+	{
+		Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, RegionSize);
+		if (!Region)
+		{
+			return nullptr;
+		}
+
+		// New regions are zeroed, which also null-terminates the entries of every block for DebugDump()
+		FSharedNameBatchHeader& Header = *(FSharedNameBatchHeader*)Region->GetAddress();
+		WriteBlocks((uint8*)Region->GetAddress() + SharedNameBatchBlocksOffset);
+		Header.NumBlocks = NumBlocks;
+		Header.BatchHash = BatchHash;
+		// Publish the entries last, processes that open the region before wait for them
+		FPlatformAtomics::InterlockedExchange(&Header.State, SharedNameBatchReady);
+	}
+
+	SharedNameBatchRegion = Region;
+	return (uint8*)Region->GetAddress() + SharedNameBatchBlocksOffset;
+}
+
+#endif // !WITH_CASE_PRESERVING_NAME
+
+bool LoadNameBatchShared(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData, const TCHAR* SharedMemoryName)
+{
+#if WITH_CASE_PRESERVING_NAME
+	// Entries store their comparison ids, which would differ between processes
+	LoadNameBatch(OutNames, NameData, HashData);
+	return false;
+#else
+	check(IsAligned(NameData.GetData(), sizeof(uint64)));
+	check(IsAligned(HashData.GetData(), sizeof(uint64)));
+	check(IsAligned(HashData.Num(), sizeof(uint64)));
+	check(HashData.Num() > 0);
+
+	if (SharedNameBatchRegion || NameData.Num() == 0)
+	{
+		LoadNameBatch(OutNames, NameData, HashData);
+		return false;
+	}
+
+	const uint8* NameIt = NameData.GetData();
+	const uint8* NameEnd = NameData.GetData() + NameData.Num();
+	const uint64* HashDataIt = reinterpret_cast<const uint64*>(HashData.GetData());
+	const bool bUseSavedHashes = INTEL_ORDER64(HashDataIt[0]) == FNameHash::AlgorithmId;
+	TArrayView<const uint64> Hashes = MakeArrayView(HashDataIt + 1, HashData.Num() / sizeof(uint64) - 1);
+
+	TArray<FNameSerializedView> Views;
+	Views.Reserve(Hashes.Num());
+	while (NameIt < NameEnd)
+	{
+		Views.Add(LoadNameHeader(/* in-out */ NameIt));
+	}
+	check(NameIt == NameEnd);
+	check(!bUseSavedHashes || Views.Num() == Hashes.Num());
+
+	// Lay the entries out the way the allocator would, every process loading the batch comes up with the same layout
+	const int32 NumNames = Views.Num();
+	TArray<FNameHash> NameHashes;
+	TArray<uint32> EntryOffsets;
+	NameHashes.SetNumUninitialized(NumNames);
+	EntryOffsets.SetNumUninitialized(NumNames);
+	uint32 NumBlocks = 1;
+	uint32 ByteCursor = 0;
+	WIDECHAR Temp[NAME_SIZE];
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		FNameStringView Name = MakeLoadedNameView(Views[Index], Temp);
+		if (bUseSavedHashes && Name.Data == Views[Index].Data)
+		{
+			const uint64 Hash = INTEL_ORDER64(Hashes[Index]);
+			NameHashes[Index] = Name.bIsWide ? FNameHash(Name.Wide, Name.Len, Hash) : FNameHash(Name.Ansi, Name.Len, Hash);
+			checkfSlow(NameHashes[Index] == HashName<ENameCase::IgnoreCase>(Name), TEXT("Precalculated hash was wrong"));
+		}
+		else
+		{
+			NameHashes[Index] = HashName<ENameCase::IgnoreCase>(Name);
+		}
+
+		const uint32 Bytes = Align(FNameEntry::GetDataOffset() + Name.BytesWithoutTerminator(), alignof(FNameEntry));
+		if (FNameEntryAllocator::BlockSizeBytes - ByteCursor < Bytes)
+		{
+			++NumBlocks;
+			ByteCursor = 0;
+		}
+		EntryOffsets[Index] = (NumBlocks - 1) * FNameEntryAllocator::BlockSizeBytes + ByteCursor;
+		ByteCursor += Bytes;
+	}
+
+	// The layout depends on the entry format as well as on the names
+	const uint64 LayoutId = (uint64(FNameEntryAllocator::BlockSizeBytes) << 32) | (uint64(FNameEntry::GetDataOffset()) << 8) | sizeof(WIDECHAR);
+	const uint64 BatchHash = CityHash64WithSeed((const char*)NameData.GetData(), NameData.Num(), CityHash64WithSeed((const char*)HashData.GetData(), HashData.Num(), LayoutId));
+	const FString RegionName = FString::Printf(TEXT("%s_%016llx"), SharedMemoryName, BatchHash);
+
+	uint8* BlockData = MapSharedNameBatch(RegionName, BatchHash, NumBlocks, [&](uint8* OutBlockData)
+	{
+		WIDECHAR WriteTemp[NAME_SIZE];
+		for (int32 Index = 0; Index < NumNames; ++Index)
+		{
+			FNameEntry& Entry = *reinterpret_cast<FNameEntry*>(OutBlockData + EntryOffsets[Index]);
+			FNameEntryAllocator::WriteEntry(Entry, MakeLoadedNameView(Views[Index], WriteTemp), NameHashes[Index].EntryProbeHeader);
+		}
+	});
+	if (!BlockData)
+	{
+		LoadNameBatch(OutNames, NameData, HashData);
+		return false;
+	}
+
+	// Names that already exist, like the hardcoded ones, keep their private entries
+	FNamePool& Pool = GetNamePoolPostInit();
+	const uint32 FirstBlock = Pool.AttachBlocks(BlockData, NumBlocks);
+	OutNames.Reset(NumNames);
+	Pool.BatchLock();
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		const uint32 Offset = EntryOffsets[Index];
+		const FNameEntryHandle Handle(FirstBlock + Offset / FNameEntryAllocator::BlockSizeBytes, (Offset % FNameEntryAllocator::BlockSizeBytes) / FNameEntryAllocator::Stride);
+		OutNames.Add(Pool.BatchStoreWritten(FNameComparisonValue(MakeLoadedNameView(Views[Index], Temp), NameHashes[Index]), Handle));
+	}
+	Pool.BatchUnlock();
+
+	return true;
+#endif
+}
+
 #if 0 && ALLOW_NAME_BATCH_SAVING  
 
 FORCENOINLINE void PerfTestLoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData)
@@ -3200,6 +3856,62 @@ void CallNameCreationHook()
 	}
 }
 
+/** Measures FName lookup throughput when many threads hit the pool at once, with and without concurrent insertions. */
+static void FNameContentionBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumNames = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 65536;
+	const int32 NumTasks = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	const int32 NumPasses = 8;
+
+	TArray<FString> Strings;
+	Strings.Reserve(NumNames);
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		Strings.Add(FString::Printf(TEXT("FNameContentionBenchmark_%d"), Index));
+		FName(*Strings.Last());
+	}
+
+	auto Run = [&](const TCHAR* Description, bool bInsert)
+	{
+		TAtomic<int32> NumMissing(0);
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(NumTasks, [&](int32 TaskIndex)
+		{
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				for (int32 Index = 0; Index < NumNames; ++Index)
+				{
+					// spread the tasks over the names so that they don't walk the shards in lockstep
+					const FString& String = Strings[(Index + TaskIndex * 7919) % NumNames];
+					if (FName(*String, FNAME_Find).IsNone())
+					{
+						++NumMissing;
+					}
+
+					// every other task keeps creating names to make the shards grow under the readers
+					if (bInsert && (TaskIndex & 1) && (Index & 15) == 0)
+					{
+						FName(*FString::Printf(TEXT("FNameContentionBenchmark_%d_%d_%d"), TaskIndex, Pass, Index));
+					}
+				}
+			}
+		});
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		const double NumLookups = double(NumTasks) * NumPasses * NumNames;
+
+		UE_LOG(LogUnrealNames, Display, TEXT("%s: %d tasks, %.0f lookups in %.3fs, %.2f M lookups/s%s"), Description, NumTasks, NumLookups, Seconds,
+			NumLookups / Seconds / 1e6, NumMissing.Load() ? TEXT(", LOOKUPS FAILED") : TEXT(""));
+	};
+
+	Run(TEXT("FName lookups"), false);
+	Run(TEXT("FName lookups with concurrent inserts"), true);
+}
+
+static FAutoConsoleCommand FNameContentionBenchmarkCommand(
+	TEXT("FName.ContentionBenchmark"),
+	TEXT("Looks up [NumNames=65536] names from [NumTasks=NumCores] tasks at once, then again while half of the tasks create names, and logs the throughput."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FNameContentionBenchmark));
+
 #endif
 
 uint8** FNameDebugVisualizer::GetBlocks()
@@ -24,6 +24,7 @@
 #include "Misc/App.h"
 #include "Misc/EngineVersion.h"
 #include "HAL/PlatformMallocCrash.h"
+#include "HAL/MallocGuardedSamplingProxy.h"
 #include "Unix/UnixPlatformRealTimeSignals.h"
 #include "Unix/UnixPlatformRunnableThread.h"
 #include "HAL/ExceptionHandling.h"
@@ -79,6 +80,17 @@ FString DescribeSignal(int32 Signal, siginfo_t* Info, ucontext_t *Context)
 		ErrorString += FString::Printf(TEXT("Signal %d (unknown)"), Signal);
 	}
 
+	// faults on the pages of the guarded sampling proxy are memory errors it can tell more about
+	if ((Signal == SIGSEGV || Signal == SIGBUS) && Info)
+	{
+		FString GuardedDescription;
+		if (FMallocGuardedSamplingProxy::DescribeAddress(Info->si_addr, GuardedDescription))
+		{
+			ErrorString += TEXT("\n");
+			ErrorString += GuardedDescription;
+		}
+	}
+
 	return ErrorString;
 #undef HANDLE_CASE
 }
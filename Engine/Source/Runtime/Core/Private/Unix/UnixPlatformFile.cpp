@@ -7,7 +7,16 @@
 #include "Containers/LruCache.h"
 #include "Logging/LogMacros.h"
 #include "Misc/Paths.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/LowLevelMemTracker.h"
 #include <sys/file.h>
+#include <sys/mman.h>
+#if PLATFORM_LINUX
+	#include <sys/ioctl.h>
+	#include <sys/sendfile.h>
+	#include <sys/syscall.h>
+	#include <linux/fs.h>
+#endif
 
 #include "HAL/PlatformFileCommon.h"
 #include "HAL/PlatformFilemanager.h"
@@ -809,6 +818,99 @@ bool FUnixPlatformFile::MoveFile(const TCHAR* To, const TCHAR* From)
 	return Result != -1;
 }
 
+namespace UE4UnixPlatformFile_Private
+{
+	/** Copies the contents of a file without going through user space buffers. Returns false if no way of doing so worked */
+	static bool CopyFileContents(int32 FromHandle, int32 ToHandle, int64 Size)
+	{
+#if PLATFORM_LINUX
+	#if defined(FICLONE)
+		// Copy on write clone, instant on file systems that support it (btrfs, xfs)
+		if (ioctl(ToHandle, FICLONE, FromHandle) == 0)
+		{
+			return true;
+		}
+	#endif
+
+		const int64 MaxChunkSize = 1ll << 30;
+		int64 Copied = 0;
+	#if defined(__NR_copy_file_range)
+		// In kernel copy, offloaded to the server by NFS and CIFS. Not in glibc before 2.27, hence the syscall
+		while (Copied < Size)
+		{
+			const ssize_t Result = syscall(__NR_copy_file_range, FromHandle, nullptr, ToHandle, nullptr, (size_t)FMath::Min(Size - Copied, MaxChunkSize), 0u);
+			if (Result <= 0)
+			{
+				if (Result == -1 && errno == EINTR)
+				{
+					continue;
+				}
+				// Not supported by the kernel or across these file systems, sendfile continues from the current offsets
+				break;
+			}
+			Copied += Result;
+		}
+	#endif
+		while (Copied < Size)
+		{
+			const ssize_t Result = sendfile(ToHandle, FromHandle, nullptr, (size_t)FMath::Min(Size - Copied, MaxChunkSize));
+			if (Result <= 0)
+			{
+				if (Result == -1 && errno == EINTR)
+				{
+					continue;
+				}
+				break;
+			}
+			Copied += Result;
+		}
+		return Copied == Size;
+#else
+		return false;
+#endif
+	}
+}
+
+bool FUnixPlatformFile::CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags, EPlatformFileWrite WriteFlags)
+{
+	FString CaseSensitiveFilename;
+	const int32 FromHandle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(From, false), CaseSensitiveFilename);
+	if (FromHandle == -1)
+	{
+		return false;
+	}
+
+	struct stat FileInfo;
+	bool bCopied = false;
+	if (fstat(FromHandle, &FileInfo) == 0 && S_ISREG(FileInfo.st_mode))
+	{
+		// Same as OpenWrite
+		GetFileMapCache().Invalidate(FString(To));
+		if (!CreateDirectoriesFromPath(To))
+		{
+			close(FromHandle);
+			return false;
+		}
+		const int32 ToHandle = open(TCHAR_TO_UTF8(*NormalizeFilename(To, true)), O_WRONLY | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
+		if (ToHandle == -1)
+		{
+			close(FromHandle);
+			return false;
+		}
+		if (flock(ToHandle, LOCK_EX | LOCK_NB) == -1 && (EAGAIN == errno || EWOULDBLOCK == errno))
+		{
+			close(ToHandle);
+			close(FromHandle);
+			return false;
+		}
+		bCopied = ftruncate(ToHandle, 0) == 0 && UE4UnixPlatformFile_Private::CopyFileContents(FromHandle, ToHandle, FileInfo.st_size);
+		close(ToHandle);
+	}
+	close(FromHandle);
+
+	return bCopied || IPhysicalPlatformFile::CopyFile(To, From, ReadFlags, WriteFlags);
+}
+
 bool FUnixPlatformFile::SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue)
 {
 	FString CaseSensitiveFilename;
@@ -921,12 +1023,104 @@ FString FUnixPlatformFile::GetFilenameOnDisk(const TCHAR* Filename)
 */
 }
 
+/**
+ * Read-only mapping of a file. Regions are private mappings that are never written, so they share the pages of the page cache
+ * with every other process that maps the same file.
+ */
+class FUnixMappedFileRegion final : public IMappedFileRegion
+{
+public:
+	FUnixMappedFileRegion(const uint8* InMappedPtr, const uint8* InAlignedPtr, size_t InMappedSize, size_t InAlignedSize, const FString& InDebugFilename, size_t InDebugOffsetIntoFile)
+		: IMappedFileRegion(InMappedPtr, InMappedSize, InDebugFilename, InDebugOffsetIntoFile)
+		, AlignedPtr(InAlignedPtr)
+		, AlignedSize(InAlignedSize)
+	{
+	}
+
+	~FUnixMappedFileRegion()
+	{
+		LLM(FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Platform, (void*)AlignedPtr));
+		const int Res = munmap((void*)AlignedPtr, AlignedSize);
+		checkf(Res == 0, TEXT("Failed to unmap, errno is %d"), errno);
+	}
+
+	virtual void PreloadHint(int64 PreloadOffset = 0, int64 BytesToPreload = MAX_int64) override
+	{
+		const int64 Offset = FMath::Clamp<int64>(PreloadOffset, 0, GetMappedSize());
+		const uint8* Ptr = GetMappedPtr() + Offset;
+		const uint8* AlignedStart = (const uint8*)AlignDown(Ptr, FPlatformMemory::GetConstants().PageSize);
+		madvise((void*)AlignedStart, FMath::Min<int64>(BytesToPreload, GetMappedSize() - Offset) + (Ptr - AlignedStart), MADV_WILLNEED);
+	}
+
+private:
+	const uint8* AlignedPtr;
+	size_t AlignedSize;
+};
+
+class FUnixMappedFileHandle final : public IMappedFileHandle
+{
+public:
+	FUnixMappedFileHandle(int InFileHandle, int64 InFileSize, const FString& InFilename)
+		: IMappedFileHandle(InFileSize)
+		, Filename(InFilename)
+		, FileHandle(InFileHandle)
+	{
+	}
+
+	~FUnixMappedFileHandle()
+	{
+		close(FileHandle);
+	}
+
+	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64, bool bPreloadHint = false) override
+	{
+		LLM_PLATFORM_SCOPE(ELLMTag::PlatformMMIO);
+		check(Offset < GetFileSize()); // don't map zero bytes and don't map off the end of the file
+		BytesToMap = FMath::Min<int64>(BytesToMap, GetFileSize() - Offset);
+		check(BytesToMap > 0); // don't map zero bytes
+
+		const int64 AlignedOffset = AlignDown(Offset, (int64)FPlatformMemory::GetConstants().PageSize);
+		const int64 AlignedSize = BytesToMap + Offset - AlignedOffset;
+		const uint8* AlignedMapPtr = (const uint8*)mmap(nullptr, AlignedSize, PROT_READ, MAP_PRIVATE | (bPreloadHint ? MAP_POPULATE : 0), FileHandle, AlignedOffset);
+		if (AlignedMapPtr == (const uint8*)MAP_FAILED)
+		{
+			UE_LOG(LogUnixPlatformFile, Warning, TEXT("Failed to map '%s', errno is %d"), *Filename, errno);
+			return nullptr;
+		}
+		LLM(FLowLevelMemTracker::Get().OnLowLevelAlloc(ELLMTracker::Platform, AlignedMapPtr, AlignedSize));
+
+		return new FUnixMappedFileRegion(AlignedMapPtr + Offset - AlignedOffset, AlignedMapPtr, BytesToMap, AlignedSize, Filename, Offset);
+	}
+
+private:
+	FString Filename;
+	int FileHandle;
+};
+
 IFileHandle* FUnixPlatformFile::OpenRead(const TCHAR* Filename, bool bAllowWrite)
 {
 	// let the file registry manage read files
 	return GFileRegistry.InitialOpenFile(*NormalizeFilename(Filename, false));
 }
 
+IMappedFileHandle* FUnixPlatformFile::OpenMapped(const TCHAR* Filename)
+{
+	FString MappedToName;
+	const int32 Handle = GCaseInsensMapper.OpenCaseInsensitiveRead(NormalizeFilename(Filename, false), MappedToName);
+	if (Handle == -1)
+	{
+		return nullptr;
+	}
+
+	struct stat FileInfo;
+	if (fstat(Handle, &FileInfo) == -1 || FileInfo.st_size <= 0)
+	{
+		close(Handle);
+		return nullptr;
+	}
+	return new FUnixMappedFileHandle(Handle, FileInfo.st_size, MappedToName);
+}
+
 IFileHandle* FUnixPlatformFile::OpenWrite(const TCHAR* Filename, bool bAppend, bool bAllowRead)
 {
 	int Flags = O_CREAT | O_CLOEXEC;	// prevent children from inheriting this
@@ -1067,7 +1261,7 @@ bool FUnixPlatformFile::IterateDirectory(const TCHAR* Directory, FDirectoryVisit
 	const FString DirectoryStr = Directory;
 	const FString NormalizedDirectoryStr = NormalizeFilename(Directory, false);
 
-	return IterateDirectoryCommon(Directory, [&](struct dirent* InEntry) -> bool
+	return IterateDirectoryCommon(Directory, [&](struct dirent* InEntry, int DirectoryFd) -> bool
 	{
 		const FString UnicodeEntryName = UTF8_TO_TCHAR(InEntry->d_name);
 				
@@ -1080,15 +1274,14 @@ bool FUnixPlatformFile::IterateDirectory(const TCHAR* Directory, FDirectoryVisit
 		{
 			// either filesystem does not support d_type (e.g. a network one or non-native) or we're dealing with a symbolic link, fallback to stat
 			struct stat FileInfo;
-			const FString AbsoluteUnicodeName = NormalizedDirectoryStr / UnicodeEntryName;
-			if (stat(TCHAR_TO_UTF8(*AbsoluteUnicodeName), &FileInfo) != -1)
+			if (fstatat(DirectoryFd, InEntry->d_name, &FileInfo, 0) != -1)
 			{
 				bIsDirectory = ((FileInfo.st_mode & S_IFMT) == S_IFDIR);
 			}
 			else
 			{
 				int ErrNo = errno;
-				UE_LOG(LogUnixPlatformFile, Warning, TEXT( "Cannot determine whether '%s' is a directory - d_type not supported and stat() failed with errno=%d (%s)"), *AbsoluteUnicodeName, ErrNo, UTF8_TO_TCHAR(strerror(ErrNo)));
+				UE_LOG(LogUnixPlatformFile, Warning, TEXT( "Cannot determine whether '%s' is a directory - d_type not supported and stat() failed with errno=%d (%s)"), *(NormalizedDirectoryStr / UnicodeEntryName), ErrNo, UTF8_TO_TCHAR(strerror(ErrNo)));
 			}
 		}
 
@@ -1099,24 +1292,21 @@ bool FUnixPlatformFile::IterateDirectory(const TCHAR* Directory, FDirectoryVisit
 bool FUnixPlatformFile::IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor)
 {
 	const FString DirectoryStr = Directory;
-	const FString NormalizedDirectoryStr = NormalizeFilename(Directory, false);
 
-	return IterateDirectoryCommon(Directory, [&](struct dirent* InEntry) -> bool
+	return IterateDirectoryCommon(Directory, [&](struct dirent* InEntry, int DirectoryFd) -> bool
 	{
-		const FString UnicodeEntryName = UTF8_TO_TCHAR(InEntry->d_name);
-				
+		// stat relative to the open directory, which saves building and resolving the absolute path of every entry
 		struct stat FileInfo;
-		const FString AbsoluteUnicodeName = NormalizedDirectoryStr / UnicodeEntryName;	
-		if (stat(TCHAR_TO_UTF8(*AbsoluteUnicodeName), &FileInfo) != -1)
+		if (fstatat(DirectoryFd, InEntry->d_name, &FileInfo, 0) != -1)
 		{
-			return Visitor.Visit(*(DirectoryStr / UnicodeEntryName), UnixStatToUEFileData(FileInfo));
+			return Visitor.Visit(*(DirectoryStr / UTF8_TO_TCHAR(InEntry->d_name)), UnixStatToUEFileData(FileInfo));
 		}
 
 		return true;
 	});
 }
 
-bool FUnixPlatformFile::IterateDirectoryCommon(const TCHAR* Directory, const TFunctionRef<bool(struct dirent*)>& Visitor)
+bool FUnixPlatformFile::IterateDirectoryCommon(const TCHAR* Directory, const TFunctionRef<bool(struct dirent*, int)>& Visitor)
 {
 	bool Result = false;
 
@@ -1125,12 +1315,13 @@ bool FUnixPlatformFile::IterateDirectoryCommon(const TCHAR* Directory, const TFu
 	if (Handle)
 	{
 		Result = true;
+		const int DirectoryFd = dirfd(Handle);
 		struct dirent* Entry;
 		while ((Entry = readdir(Handle)) != NULL)
 		{
-			if (FCString::Strcmp(UTF8_TO_TCHAR(Entry->d_name), TEXT(".")) && FCString::Strcmp(UTF8_TO_TCHAR(Entry->d_name), TEXT("..")))
+			if (FCStringAnsi::Strcmp(Entry->d_name, ".") && FCStringAnsi::Strcmp(Entry->d_name, ".."))
 			{
-				Result = Visitor(Entry);
+				Result = Visitor(Entry, DirectoryFd);
 			}
 		}
 		closedir(Handle);
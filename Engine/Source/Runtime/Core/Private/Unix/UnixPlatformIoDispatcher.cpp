@@ -0,0 +1,699 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Unix/UnixPlatformIoDispatcher.h"
+
+#if PLATFORM_IMPLEMENTS_IO
+
+#include "IO/IoDispatcherFileBackend.h"
+#include "Containers/StringConv.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+TRACE_DECLARE_INT_COUNTER(IoDispatcherInflightReads, TEXT("IoDispatcher/InflightReads"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherRegisteredReads, TEXT("IoDispatcher/RegisteredReads"));
+TRACE_DECLARE_INT_COUNTER(IoDispatcherDirectReads, TEXT("IoDispatcher/DirectReads"));
+TRACE_DECLARE_INT_COUNTER_EXTERN(IoDispatcherPendingBlocksCount);
+
+extern int32 GIoDispatcherBlockSizeKB;
+
+int32 GIoDispatcherUseIoUring = 1;
+static FAutoConsoleVariableRef CVar_IoDispatcherUseIoUring(
+	TEXT("s.IoDispatcherUseIoUring"),
+	GIoDispatcherUseIoUring,
+	TEXT("Use io_uring for container reads when the kernel supports it. Only read at startup.")
+);
+
+int32 GIoDispatcherIoUringQueueDepth = 128;
+static FAutoConsoleVariableRef CVar_IoDispatcherIoUringQueueDepth(
+	TEXT("s.IoDispatcherIoUringQueueDepth"),
+	GIoDispatcherIoUringQueueDepth,
+	TEXT("Maximum number of container reads in flight with io_uring. Only read at startup.")
+);
+
+int32 GIoDispatcherIoUringRegisteredBlocks = 128;
+static FAutoConsoleVariableRef CVar_IoDispatcherIoUringRegisteredBlocks(
+	TEXT("s.IoDispatcherIoUringRegisteredBlocks"),
+	GIoDispatcherIoUringRegisteredBlocks,
+	TEXT("Number of cache blocks read into memory registered with io_uring, 0 disables registered buffers. Only read at startup.")
+);
+
+int32 GIoDispatcherDirectIO = 0;
+static FAutoConsoleVariableRef CVar_IoDispatcherDirectIO(
+	TEXT("s.IoDispatcherDirectIO"),
+	GIoDispatcherDirectIO,
+	TEXT("Read containers with O_DIRECT, bypassing the page cache, whenever the buffer, offset and size allow it.")
+);
+
+namespace UnixIoDispatcher
+{
+	static constexpr uint64 DirectIoAlignment = 4096;
+
+	// Containers are opened twice when direct I/O is enabled, both descriptors are packed into the container handle
+	static uint64 MakeContainerHandle(int Fd, int DirectFd)
+	{
+		return uint64(uint32(Fd)) | (uint64(uint32(DirectFd)) << 32);
+	}
+
+	static int GetBufferedFd(uint64 ContainerFileHandle)
+	{
+		return int(uint32(ContainerFileHandle));
+	}
+
+	static int GetDirectFd(uint64 ContainerFileHandle)
+	{
+		return int(uint32(ContainerFileHandle >> 32));
+	}
+}
+
+FUnixIoDispatcherEventQueue::FUnixIoDispatcherEventQueue()
+	: EventFd(eventfd(0, EFD_CLOEXEC))
+{
+	checkf(EventFd >= 0, TEXT("eventfd failed (errno=%d)"), errno);
+}
+
+FUnixIoDispatcherEventQueue::~FUnixIoDispatcherEventQueue()
+{
+	close(EventFd);
+}
+
+void FUnixIoDispatcherEventQueue::Notify()
+{
+	const uint64 One = 1;
+	while (write(EventFd, &One, sizeof(One)) < 0 && errno == EINTR)
+	{
+	}
+}
+
+void FUnixIoDispatcherEventQueue::Wait()
+{
+	uint64 Value;
+	while (read(EventFd, &Value, sizeof(Value)) < 0 && errno == EINTR)
+	{
+	}
+}
+
+void FUnixIoDispatcherEventQueue::WaitFor(uint32 WaitTimeMs)
+{
+	struct pollfd PollFd;
+	PollFd.fd = EventFd;
+	PollFd.events = POLLIN;
+	PollFd.revents = 0;
+	if (poll(&PollFd, 1, int(WaitTimeMs)) > 0)
+	{
+		Wait();
+	}
+}
+
+FUnixFileIoStoreImpl::FUnixFileIoStoreImpl(FUnixIoDispatcherEventQueue& InEventQueue)
+	: EventQueue(InEventQueue)
+{
+	if (!GIoDispatcherUseIoUring || !InitRing())
+	{
+		PendingBlockEvent = FPlatformProcess::GetSynchEventFromPool();
+		Thread = FRunnableThread::Create(this, TEXT("IoService"), 0, TPri_AboveNormal);
+	}
+}
+
+FUnixFileIoStoreImpl::~FUnixFileIoStoreImpl()
+{
+	if (Thread)
+	{
+		delete Thread;
+		FPlatformProcess::ReturnSynchEventToPool(PendingBlockEvent);
+	}
+	ShutdownRing();
+}
+
+bool FUnixFileIoStoreImpl::InitRing()
+{
+	struct io_uring_params Params;
+	FMemory::Memzero(Params);
+	const uint32 QueueDepth = FMath::RoundUpToPowerOfTwo(FMath::Clamp(GIoDispatcherIoUringQueueDepth, 1, 4096));
+	RingFd = int(syscall(__NR_io_uring_setup, QueueDepth, &Params));
+	if (RingFd < 0)
+	{
+		UE_LOG(LogIoDispatcher, Log, TEXT("io_uring is not available (errno=%d), container reads are blocking"), errno);
+		return false;
+	}
+
+	RingEntries = Params.sq_entries;
+	SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32);
+	CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(struct io_uring_cqe);
+	const bool bSingleMmap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (bSingleMmap)
+	{
+		SqRingSize = CqRingSize = FMath::Max(SqRingSize, CqRingSize);
+	}
+
+	SqRingPtr = mmap(nullptr, SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_SQ_RING);
+	if (SqRingPtr == MAP_FAILED)
+	{
+		SqRingPtr = nullptr;
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to map the io_uring submission queue (errno=%d)"), errno);
+		ShutdownRing();
+		return false;
+	}
+	if (bSingleMmap)
+	{
+		CqRingPtr = SqRingPtr;
+	}
+	else
+	{
+		CqRingPtr = mmap(nullptr, CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_CQ_RING);
+		if (CqRingPtr == MAP_FAILED)
+		{
+			CqRingPtr = nullptr;
+			UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to map the io_uring completion queue (errno=%d)"), errno);
+			ShutdownRing();
+			return false;
+		}
+	}
+	SqesSize = Params.sq_entries * sizeof(struct io_uring_sqe);
+	SqesPtr = mmap(nullptr, SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RingFd, IORING_OFF_SQES);
+	if (SqesPtr == MAP_FAILED)
+	{
+		SqesPtr = nullptr;
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to map the io_uring submission entries (errno=%d)"), errno);
+		ShutdownRing();
+		return false;
+	}
+
+	uint8* SqRing = reinterpret_cast<uint8*>(SqRingPtr);
+	SqHead = reinterpret_cast<uint32*>(SqRing + Params.sq_off.head);
+	SqTail = reinterpret_cast<uint32*>(SqRing + Params.sq_off.tail);
+	SqMask = reinterpret_cast<uint32*>(SqRing + Params.sq_off.ring_mask);
+	SqArray = reinterpret_cast<uint32*>(SqRing + Params.sq_off.array);
+	uint8* CqRing = reinterpret_cast<uint8*>(CqRingPtr);
+	CqHead = reinterpret_cast<uint32*>(CqRing + Params.cq_off.head);
+	CqTail = reinterpret_cast<uint32*>(CqRing + Params.cq_off.tail);
+	CqMask = reinterpret_cast<uint32*>(CqRing + Params.cq_off.ring_mask);
+	Cqes = CqRing + Params.cq_off.cqes;
+
+	// Completions wake the dispatcher thread through its event queue, so it can submit and reap without another thread
+	int EventFd = EventQueue.GetEventFd();
+	if (syscall(__NR_io_uring_register, RingFd, IORING_REGISTER_EVENTFD, &EventFd, 1) < 0)
+	{
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to register the dispatcher event with io_uring (errno=%d)"), errno);
+		ShutdownRing();
+		return false;
+	}
+
+	// Never more reads in flight than submission entries, which keeps both queues from overflowing
+	Ops = new FReadOp[RingEntries];
+	for (uint32 OpIndex = 0; OpIndex < RingEntries; ++OpIndex)
+	{
+		Ops[OpIndex].NextFree = OpIndex + 1 < RingEntries ? int32(OpIndex + 1) : INDEX_NONE;
+	}
+	FirstFreeOp = 0;
+
+	InitRegisteredBuffers();
+
+	UE_LOG(LogIoDispatcher, Log, TEXT("Using io_uring for container reads (queue depth %u, %d registered blocks, direct I/O %s)"),
+		RingEntries, RegisteredSlotCount, GIoDispatcherDirectIO ? TEXT("enabled") : TEXT("disabled"));
+	return true;
+}
+
+void FUnixFileIoStoreImpl::ShutdownRing()
+{
+	if (RingFd >= 0)
+	{
+		// Closing the ring waits for the reads still in flight
+		close(RingFd);
+		RingFd = -1;
+	}
+	if (SqesPtr)
+	{
+		munmap(SqesPtr, SqesSize);
+		SqesPtr = nullptr;
+	}
+	if (CqRingPtr && CqRingPtr != SqRingPtr)
+	{
+		munmap(CqRingPtr, CqRingSize);
+	}
+	CqRingPtr = nullptr;
+	if (SqRingPtr)
+	{
+		munmap(SqRingPtr, SqRingSize);
+		SqRingPtr = nullptr;
+	}
+	if (RegisteredMemory)
+	{
+		munmap(RegisteredMemory, SIZE_T(RegisteredSlotCount) * RegisteredSlotSize);
+		RegisteredMemory = nullptr;
+		RegisteredSlotCount = 0;
+		FreeRegisteredSlots.Empty();
+	}
+	delete[] Ops;
+	Ops = nullptr;
+	FirstFreeOp = INDEX_NONE;
+}
+
+bool FUnixFileIoStoreImpl::InitRegisteredBuffers()
+{
+	// Must match the cache block size of FFileIoStore
+	RegisteredSlotSize = GIoDispatcherBlockSizeKB > 0 ? uint64(GIoDispatcherBlockSizeKB) << 10 : 256 << 10;
+	const int32 MaxSlotCount = int32((1ull << 30) / RegisteredSlotSize);
+	const int32 SlotCount = FMath::Min(GIoDispatcherIoUringRegisteredBlocks, MaxSlotCount);
+	if (SlotCount <= 0)
+	{
+		return false;
+	}
+
+	const SIZE_T RegisteredSize = SIZE_T(SlotCount) * RegisteredSlotSize;
+	void* Memory = mmap(nullptr, RegisteredSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (Memory == MAP_FAILED)
+	{
+		return false;
+	}
+	struct iovec IoVec;
+	IoVec.iov_base = Memory;
+	IoVec.iov_len = RegisteredSize;
+	if (syscall(__NR_io_uring_register, RingFd, IORING_REGISTER_BUFFERS, &IoVec, 1) < 0)
+	{
+		// Registered memory is pinned for the lifetime of the ring, this usually fails because of RLIMIT_MEMLOCK
+		UE_LOG(LogIoDispatcher, Log, TEXT("Failed to register %llu bytes with io_uring (errno=%d), cache blocks are read into regular memory"), uint64(RegisteredSize), errno);
+		munmap(Memory, RegisteredSize);
+		return false;
+	}
+
+	RegisteredMemory = reinterpret_cast<uint8*>(Memory);
+	RegisteredSlotCount = SlotCount;
+	FreeRegisteredSlots.Reserve(SlotCount);
+	for (int32 SlotIndex = SlotCount - 1; SlotIndex >= 0; --SlotIndex)
+	{
+		FreeRegisteredSlots.Add(SlotIndex);
+	}
+	return true;
+}
+
+bool FUnixFileIoStoreImpl::IsRegisteredMemory(const uint8* Data) const
+{
+	return RegisteredMemory && Data >= RegisteredMemory && Data < RegisteredMemory + uint64(RegisteredSlotCount) * RegisteredSlotSize;
+}
+
+bool FUnixFileIoStoreImpl::OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize)
+{
+	IPlatformFile& Ipf = FPlatformFileManager::Get().GetPlatformFile();
+	const FString NativePath = Ipf.ConvertToAbsolutePathForExternalAppForRead(ContainerFilePath);
+	const int Fd = open(TCHAR_TO_UTF8(*NativePath), O_RDONLY | O_CLOEXEC);
+	if (Fd < 0)
+	{
+		return false;
+	}
+	struct stat FileInfo;
+	if (fstat(Fd, &FileInfo) < 0)
+	{
+		close(Fd);
+		return false;
+	}
+
+	int DirectFd = -1;
+	if (GIoDispatcherDirectIO && RingFd >= 0)
+	{
+		DirectFd = open(TCHAR_TO_UTF8(*NativePath), O_RDONLY | O_CLOEXEC | O_DIRECT);
+		UE_CLOG(DirectFd < 0, LogIoDispatcher, Warning, TEXT("Failed to open '%s' for direct I/O (errno=%d)"), *NativePath, errno);
+	}
+
+	ContainerFileHandle = UnixIoDispatcher::MakeContainerHandle(Fd, DirectFd);
+	ContainerFileSize = FileInfo.st_size;
+	return true;
+}
+
+void FUnixFileIoStoreImpl::BeginReadsForRequest(FFileIoStoreResolvedRequest& ResolvedRequest)
+{
+	if (!ResolvedRequest.Request->IoBuffer.DataSize())
+	{
+		if (GIoDispatcherDirectIO)
+		{
+			void* Memory = FMemory::Malloc(ResolvedRequest.ResolvedSize, UnixIoDispatcher::DirectIoAlignment);
+			ResolvedRequest.Request->IoBuffer = FIoBuffer(FIoBuffer::AssumeOwnership, Memory, ResolvedRequest.ResolvedSize);
+		}
+		else
+		{
+			ResolvedRequest.Request->IoBuffer = FIoBuffer(ResolvedRequest.ResolvedSize);
+		}
+	}
+}
+
+bool FUnixFileIoStoreImpl::PrepareBlockBuffer(FFileIoStoreReadBlock* Block)
+{
+	if (Block->Buffer.DataSize())
+	{
+		return false;
+	}
+
+	if (Block->Size <= RegisteredSlotSize && FreeRegisteredSlots.Num())
+	{
+		const int32 SlotIndex = FreeRegisteredSlots.Pop(false);
+		Block->Buffer = FIoBuffer(FIoBuffer::Wrap, RegisteredMemory + SlotIndex * RegisteredSlotSize, Block->Size);
+	}
+	else if (GIoDispatcherDirectIO)
+	{
+		void* Memory = FMemory::Malloc(Align(Block->Size, UnixIoDispatcher::DirectIoAlignment), UnixIoDispatcher::DirectIoAlignment);
+		Block->Buffer = FIoBuffer(FIoBuffer::AssumeOwnership, Memory, Block->Size);
+	}
+	else
+	{
+		Block->Buffer = FIoBuffer(Block->Size);
+	}
+	return true;
+}
+
+void FUnixFileIoStoreImpl::ReleaseBlockBuffer(FFileIoStoreReadBlock* Block)
+{
+	if (IsRegisteredMemory(Block->Buffer.Data()))
+	{
+		const int32 SlotIndex = int32((Block->Buffer.Data() - RegisteredMemory) / RegisteredSlotSize);
+		FreeRegisteredSlots.Add(SlotIndex);
+		Block->Buffer = FIoBuffer();
+	}
+}
+
+bool FUnixFileIoStoreImpl::CanReadDirect(const FFileIoStoreReadBlock* Block, bool bPaddedBuffer) const
+{
+	using namespace UnixIoDispatcher;
+	if (GetDirectFd(Block->Key.FileHandle) < 0)
+	{
+		return false;
+	}
+	// Reads past the end of the block are only allowed into buffers we allocated with room for them
+	return IsAligned(Block->Buffer.Data(), DirectIoAlignment) &&
+		IsAligned(Block->Offset, DirectIoAlignment) &&
+		(bPaddedBuffer || IsAligned(Block->Size, DirectIoAlignment));
+}
+
+void FUnixFileIoStoreImpl::ReadBlockFromFile(FFileIoStoreReadBlock* Block)
+{
+	if (RingFd >= 0)
+	{
+		StartRead(Block);
+		return;
+	}
+
+	PrepareBlockBuffer(Block);
+	{
+		FScopeLock Lock(&PendingBlocksCritical);
+		if (!PendingBlocksHead)
+		{
+			PendingBlocksHead = PendingBlocksTail = Block;
+		}
+		else
+		{
+			PendingBlocksTail->Next = Block;
+			PendingBlocksTail = Block;
+		}
+		Block->Next = nullptr;
+		TRACE_COUNTER_INCREMENT(IoDispatcherPendingBlocksCount);
+	}
+	PendingBlockEvent->Trigger();
+}
+
+void FUnixFileIoStoreImpl::StartRead(FFileIoStoreReadBlock* Block)
+{
+	if (FirstFreeOp == INDEX_NONE)
+	{
+		// The queue is full, the block is started as soon as a read completes
+		if (!WaitingBlocksHead)
+		{
+			WaitingBlocksHead = WaitingBlocksTail = Block;
+		}
+		else
+		{
+			WaitingBlocksTail->Next = Block;
+			WaitingBlocksTail = Block;
+		}
+		Block->Next = nullptr;
+		return;
+	}
+
+	const int32 OpIndex = FirstFreeOp;
+	FReadOp& Op = Ops[OpIndex];
+	FirstFreeOp = Op.NextFree;
+	Op.Block = Block;
+	Op.BytesRead = 0;
+	const bool bPaddedBuffer = PrepareBlockBuffer(Block);
+	Op.bDirect = CanReadDirect(Block, bPaddedBuffer);
+	TRACE_COUNTER_INCREMENT(IoDispatcherInflightReads);
+	QueueRead(OpIndex);
+}
+
+void FUnixFileIoStoreImpl::QueueRead(int32 OpIndex)
+{
+	using namespace UnixIoDispatcher;
+	FReadOp& Op = Ops[OpIndex];
+	FFileIoStoreReadBlock* Block = Op.Block;
+	uint8* Dst = Block->Buffer.Data() + Op.BytesRead;
+	uint64 ReadSize = Block->Size - Op.BytesRead;
+	if (Op.bDirect)
+	{
+		ReadSize = Align(ReadSize, DirectIoAlignment);
+		TRACE_COUNTER_INCREMENT(IoDispatcherDirectReads);
+	}
+
+	// We are the only producer, the kernel only reads the tail
+	const uint32 Tail = *SqTail;
+	const uint32 Index = Tail & *SqMask;
+	struct io_uring_sqe* Sqe = reinterpret_cast<struct io_uring_sqe*>(SqesPtr) + Index;
+	FMemory::Memzero(*Sqe);
+	Sqe->fd = Op.bDirect ? GetDirectFd(Block->Key.FileHandle) : GetBufferedFd(Block->Key.FileHandle);
+	Sqe->off = Block->Offset + Op.BytesRead;
+	Sqe->user_data = uint64(OpIndex);
+	if (IsRegisteredMemory(Dst))
+	{
+		Sqe->opcode = IORING_OP_READ_FIXED;
+		Sqe->addr = reinterpret_cast<UPTRINT>(Dst);
+		Sqe->len = uint32(ReadSize);
+		Sqe->buf_index = 0;
+		TRACE_COUNTER_INCREMENT(IoDispatcherRegisteredReads);
+	}
+	else
+	{
+		// Single reads are capped at 2GB by the kernel anyway, short reads are resubmitted
+		Op.IoVec.iov_base = Dst;
+		Op.IoVec.iov_len = SIZE_T(FMath::Min<uint64>(ReadSize, MAX_int32));
+		Sqe->opcode = IORING_OP_READV;
+		Sqe->addr = reinterpret_cast<UPTRINT>(&Op.IoVec);
+		Sqe->len = 1;
+	}
+	SqArray[Index] = Index;
+	__atomic_store_n(SqTail, Tail + 1, __ATOMIC_RELEASE);
+	++ReadsToSubmit;
+}
+
+void FUnixFileIoStoreImpl::SubmitQueuedReads()
+{
+	while (ReadsToSubmit > 0)
+	{
+		const int Submitted = int(syscall(__NR_io_uring_enter, RingFd, ReadsToSubmit, 0, 0, nullptr, 0));
+		if (Submitted < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			// Out of kernel resources, try again on the next pass of the dispatcher thread
+			UE_CLOG(errno != EAGAIN && errno != EBUSY, LogIoDispatcher, Error, TEXT("io_uring_enter failed (errno=%d)"), errno);
+			EventQueue.Notify();
+			return;
+		}
+		if (Submitted == 0)
+		{
+			return;
+		}
+		ReadsToSubmit -= uint32(Submitted);
+	}
+}
+
+bool FUnixFileIoStoreImpl::ReapCompletion(FFileIoStoreReadBlock*& OutCompletedBlock)
+{
+	OutCompletedBlock = nullptr;
+	const uint32 Head = *CqHead;
+	if (Head == __atomic_load_n(CqTail, __ATOMIC_ACQUIRE))
+	{
+		return false;
+	}
+	const struct io_uring_cqe& Cqe = reinterpret_cast<const struct io_uring_cqe*>(Cqes)[Head & *CqMask];
+	const int32 OpIndex = int32(Cqe.user_data);
+	const int32 Result = Cqe.res;
+	__atomic_store_n(CqHead, Head + 1, __ATOMIC_RELEASE);
+
+	FReadOp& Op = Ops[OpIndex];
+	FFileIoStoreReadBlock* Block = Op.Block;
+	if (Result < 0)
+	{
+		if (Result == -EAGAIN || Result == -EINTR)
+		{
+			QueueRead(OpIndex);
+			return true;
+		}
+		if (Op.bDirect && Result == -EINVAL)
+		{
+			// The file system doesn't support direct I/O at this alignment
+			Op.bDirect = false;
+			QueueRead(OpIndex);
+			return true;
+		}
+		UE_LOG(LogIoDispatcher, Warning, TEXT("Failed to read %llu bytes at offset %llu (errno=%d)"), Block->Size - Op.BytesRead, Block->Offset + Op.BytesRead, -Result);
+	}
+	else
+	{
+		Op.BytesRead += uint64(Result);
+		if (Result > 0 && Op.BytesRead < Block->Size)
+		{
+			QueueRead(OpIndex);
+			return true;
+		}
+	}
+
+	Op.Block = nullptr;
+	Op.NextFree = FirstFreeOp;
+	FirstFreeOp = OpIndex;
+	TRACE_COUNTER_DECREMENT(IoDispatcherInflightReads);
+	if (WaitingBlocksHead)
+	{
+		FFileIoStoreReadBlock* WaitingBlock = WaitingBlocksHead;
+		WaitingBlocksHead = WaitingBlocksHead->Next;
+		if (!WaitingBlocksHead)
+		{
+			WaitingBlocksTail = nullptr;
+		}
+		StartRead(WaitingBlock);
+	}
+	OutCompletedBlock = Block;
+	return true;
+}
+
+void FUnixFileIoStoreImpl::EndReadsForRequest()
+{
+
+}
+
+FFileIoStoreReadBlock* FUnixFileIoStoreImpl::GetNextCompletedBlock()
+{
+	if (RingFd < 0)
+	{
+		FScopeLock _(&CompletedBlocksCritical);
+		FFileIoStoreReadBlock* CompletedBlock = CompletedBlocksHead;
+		if (!CompletedBlocksHead)
+		{
+			return nullptr;
+		}
+		CompletedBlocksHead = CompletedBlocksHead->Next;
+		if (!CompletedBlocksHead)
+		{
+			CompletedBlocksTail = nullptr;
+		}
+		return CompletedBlock;
+	}
+
+	SubmitQueuedReads();
+	FFileIoStoreReadBlock* CompletedBlock = nullptr;
+	while (ReapCompletion(CompletedBlock))
+	{
+		if (CompletedBlock)
+		{
+			break;
+		}
+	}
+	// Resubmitted short reads and blocks that were waiting for a free slot
+	SubmitQueuedReads();
+	return CompletedBlock;
+}
+
+bool FUnixFileIoStoreImpl::Init()
+{
+	return true;
+}
+
+void FUnixFileIoStoreImpl::Stop()
+{
+	bStopRequested = true;
+	if (PendingBlockEvent)
+	{
+		PendingBlockEvent->Trigger();
+	}
+}
+
+void FUnixFileIoStoreImpl::ReadBlockBlocking(FFileIoStoreReadBlock* Block)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ReadBlockFromFile);
+	const int Fd = UnixIoDispatcher::GetBufferedFd(Block->Key.FileHandle);
+	uint64 BytesRead = 0;
+	while (BytesRead < Block->Size)
+	{
+		const ssize_t Result = pread(Fd, Block->Buffer.Data() + BytesRead, Block->Size - BytesRead, Block->Offset + BytesRead);
+		if (Result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (Result <= 0)
+		{
+			UE_CLOG(Result < 0, LogIoDispatcher, Warning, TEXT("Failed to read %llu bytes at offset %llu (errno=%d)"), Block->Size - BytesRead, Block->Offset + BytesRead, errno);
+			break;
+		}
+		BytesRead += uint64(Result);
+	}
+}
+
+void FUnixFileIoStoreImpl::AddCompletedBlock(FFileIoStoreReadBlock* Block)
+{
+	{
+		FScopeLock _(&CompletedBlocksCritical);
+		if (!CompletedBlocksHead)
+		{
+			CompletedBlocksHead = CompletedBlocksTail = Block;
+		}
+		else
+		{
+			CompletedBlocksTail->Next = Block;
+			CompletedBlocksTail = Block;
+		}
+		Block->Next = nullptr;
+	}
+	EventQueue.Notify();
+}
+
+uint32 FUnixFileIoStoreImpl::Run()
+{
+	while (!bStopRequested)
+	{
+		FFileIoStoreReadBlock* ScheduledBlocks;
+		{
+			FScopeLock PendingBlocksLock(&PendingBlocksCritical);
+			ScheduledBlocks = PendingBlocksHead;
+			PendingBlocksHead = PendingBlocksTail = nullptr;
+		}
+
+		if (!ScheduledBlocks)
+		{
+			PendingBlockEvent->Wait();
+			continue;
+		}
+
+		while (ScheduledBlocks && !bStopRequested)
+		{
+			FFileIoStoreReadBlock* BlockToRead = ScheduledBlocks;
+			ScheduledBlocks = ScheduledBlocks->Next;
+			ReadBlockBlocking(BlockToRead);
+			TRACE_COUNTER_DECREMENT(IoDispatcherPendingBlocksCount);
+			AddCompletedBlock(BlockToRead);
+		}
+	}
+	return 0;
+}
+
+#endif // PLATFORM_IMPLEMENTS_IO
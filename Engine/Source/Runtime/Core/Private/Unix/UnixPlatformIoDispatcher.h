@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "Templates/Atomic.h"
+#include <sys/uio.h>
+
+struct FFileIoStoreReadBlock;
+struct FFileIoStoreResolvedRequest;
+class FEvent;
+class FRunnableThread;
+
+/**
+ * Event queue of the dispatcher thread, backed by an eventfd so that io_uring can signal completions on it directly.
+ */
+class FUnixIoDispatcherEventQueue
+{
+public:
+	FUnixIoDispatcherEventQueue();
+	~FUnixIoDispatcherEventQueue();
+	void Notify();
+	void Wait();
+	void WaitFor(uint32 WaitTimeMs);
+	void Poll() {};
+
+	int GetEventFd() const
+	{
+		return EventFd;
+	}
+
+private:
+	int EventFd;
+};
+
+/**
+ * io_uring based container reads.
+ *
+ * Reads are submitted and reaped on the dispatcher thread itself, there is no dedicated I/O thread. A fixed range of memory is
+ * registered with the ring and cache blocks are read into it with fixed buffer reads. When the kernel doesn't support io_uring
+ * reads fall back to pread on a worker thread.
+ */
+class FUnixFileIoStoreImpl
+	: public FRunnable
+{
+public:
+	FUnixFileIoStoreImpl(FUnixIoDispatcherEventQueue& InEventQueue);
+	~FUnixFileIoStoreImpl();
+	bool OpenContainer(const TCHAR* ContainerFilePath, uint64& ContainerFileHandle, uint64& ContainerFileSize);
+	void BeginReadsForRequest(FFileIoStoreResolvedRequest& ResolvedRequest);
+	void ReadBlockFromFile(FFileIoStoreReadBlock* Block);
+	void EndReadsForRequest();
+	FFileIoStoreReadBlock* GetNextCompletedBlock();
+	void ReleaseBlockBuffer(FFileIoStoreReadBlock* Block);
+	virtual bool Init() override;
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FReadOp
+	{
+		FFileIoStoreReadBlock* Block = nullptr;
+		struct iovec IoVec;
+		uint64 BytesRead = 0;
+		int32 NextFree = INDEX_NONE;
+		bool bDirect = false;
+	};
+
+	bool InitRing();
+	void ShutdownRing();
+	bool InitRegisteredBuffers();
+	bool IsRegisteredMemory(const uint8* Data) const;
+	bool PrepareBlockBuffer(FFileIoStoreReadBlock* Block);
+	bool CanReadDirect(const FFileIoStoreReadBlock* Block, bool bPaddedBuffer) const;
+	void StartRead(FFileIoStoreReadBlock* Block);
+	void QueueRead(int32 OpIndex);
+	void SubmitQueuedReads();
+	bool ReapCompletion(FFileIoStoreReadBlock*& OutCompletedBlock);
+	void ReadBlockBlocking(FFileIoStoreReadBlock* Block);
+	void AddCompletedBlock(FFileIoStoreReadBlock* Block);
+
+	FUnixIoDispatcherEventQueue& EventQueue;
+
+	// io_uring state, only touched by the dispatcher thread
+	int RingFd = -1;
+	uint32 RingEntries = 0;
+	void* SqRingPtr = nullptr;
+	SIZE_T SqRingSize = 0;
+	void* CqRingPtr = nullptr;
+	SIZE_T CqRingSize = 0;
+	void* SqesPtr = nullptr;
+	SIZE_T SqesSize = 0;
+	uint32* SqHead = nullptr;
+	uint32* SqTail = nullptr;
+	uint32* SqMask = nullptr;
+	uint32* SqArray = nullptr;
+	uint32* CqHead = nullptr;
+	uint32* CqTail = nullptr;
+	uint32* CqMask = nullptr;
+	void* Cqes = nullptr;
+	uint32 ReadsToSubmit = 0;
+
+	FReadOp* Ops = nullptr;
+	int32 FirstFreeOp = INDEX_NONE;
+	FFileIoStoreReadBlock* WaitingBlocksHead = nullptr;
+	FFileIoStoreReadBlock* WaitingBlocksTail = nullptr;
+
+	// Registered memory, split into slots of one cache block each
+	uint8* RegisteredMemory = nullptr;
+	uint64 RegisteredSlotSize = 0;
+	int32 RegisteredSlotCount = 0;
+	TArray<int32> FreeRegisteredSlots;
+
+	// Blocking fallback when io_uring isn't available
+	FCriticalSection PendingBlocksCritical;
+	FFileIoStoreReadBlock* PendingBlocksHead = nullptr;
+	FFileIoStoreReadBlock* PendingBlocksTail = nullptr;
+	FCriticalSection CompletedBlocksCritical;
+	FFileIoStoreReadBlock* CompletedBlocksHead = nullptr;
+	FFileIoStoreReadBlock* CompletedBlocksTail = nullptr;
+	FEvent* PendingBlockEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	TAtomic<bool> bStopRequested{ false };
+};
+
+typedef FUnixIoDispatcherEventQueue FIoDispatcherEventQueue;
+typedef FUnixFileIoStoreImpl FFileIoStoreImpl;
@@ -18,8 +18,14 @@
 #include "HAL/MallocBinned.h"
 #include "HAL/MallocBinned2.h"
 #include "HAL/MallocReplayProxy.h"
+#include "HAL/MallocSamplingProxy.h"
+#include "HAL/MallocGuardedSamplingProxy.h"
 #include "HAL/MallocStomp.h"
 #include "HAL/PlatformMallocCrash.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
 
 #if PLATFORM_FREEBSD
 	#include <kvm.h>
@@ -27,10 +33,17 @@
 	#include <sys/sysinfo.h>
 #endif
 #include <sys/file.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <time.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <unistd.h>
 
 #include "GenericPlatform/OSAllocationPool.h"
 #include "Misc/ScopeLock.h"
+#include "Templates/Atomic.h"
 
 // on 64 bit Linux, it is easier to run out of vm.max_map_count than of other limits. Due to that, trade VIRT (address space) size for smaller amount of distinct mappings
 // by not leaving holes between them (kernel will coalesce the adjoining mappings into a single one)
@@ -56,6 +69,9 @@ bool CORE_API GFullCrashCallstack = false;
 bool CORE_API GUseKSM = false;
 bool CORE_API GKSMMergeAllPages = false;
 
+// Used to enable transparent huge pages for mmap'd memory
+bool CORE_API GUseHugePages = false;
+
 // Used to enable or disable timing of ensures. Enabled by default
 bool CORE_API GTimeEnsures = true;
 
@@ -182,6 +198,11 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 					GKSMMergeAllPages = true;
 				}
 
+				if (FCStringAnsi::Stricmp(Arg, "-hugepages") == 0)
+				{
+					GUseHugePages = true;
+				}
+
 				if (FCStringAnsi::Stricmp(Arg, "-noensuretiming") == 0)
 				{
 					GTimeEnsures = false;
@@ -208,6 +229,22 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 					GMaxNumberFileMappingCache = FMath::Clamp(Max, 0, MaximumAllowedMaxNumFileMappingCache);
 				}
 
+				const char HeapSamplingCmd[] = "-heapsampling";
+				if (FCStringAnsi::Strnicmp(Arg, HeapSamplingCmd, sizeof(HeapSamplingCmd) - 1) == 0)
+				{
+					const char* Value = Arg + sizeof(HeapSamplingCmd) - 1;
+					const int64 SampleInterval = *Value == '=' ? FCStringAnsi::Atoi64(Value + 1) : 0;
+					GMallocSamplingProxyInterval = SampleInterval > 0 ? SampleInterval : FMallocSamplingProxy::DefaultSampleInterval;
+				}
+
+				const char GuardedMallocCmd[] = "-guardedmalloc";
+				if (FCStringAnsi::Strnicmp(Arg, GuardedMallocCmd, sizeof(GuardedMallocCmd) - 1) == 0)
+				{
+					const char* Value = Arg + sizeof(GuardedMallocCmd) - 1;
+					const int32 SampleRate = *Value == '=' ? FCStringAnsi::Atoi(Value + 1) : 0;
+					GMallocGuardedSamplingRate = SampleRate > 0 ? uint32(SampleRate) : FMallocGuardedSamplingProxy::DefaultSampleRate;
+				}
+
 #if UE_USE_MALLOC_REPLAY_PROXY
 				if (FCStringAnsi::Stricmp(Arg, "-mallocsavereplay") == 0)
 				{
@@ -328,6 +365,62 @@ static void MarkMappedMemoryMergable(void* Pointer, SIZE_T Size)
 	}
 }
 
+namespace UnixPlatformMemory
+{
+	/** Size of a transparent huge page on the platforms we support (x86-64 and aarch64 with 4KB base pages). */
+	static constexpr SIZE_T HugePageSize = 2 * 1024 * 1024;
+
+	/** Bytes in 2MB aligned ranges that were advised to be backed by huge pages, the candidates for a huge page hit. */
+	static TAtomic<int64> HugePageEligibleBytes(0);
+
+	/** Returns the size of the part of the range that can be backed by whole huge pages. */
+	static SIZE_T GetHugePageRangeSize(void* Pointer, SIZE_T Size)
+	{
+		const UPTRINT Begin = Align(reinterpret_cast<UPTRINT>(Pointer), HugePageSize);
+		const UPTRINT End = AlignDown(reinterpret_cast<UPTRINT>(Pointer) + Size, HugePageSize);
+		return End > Begin ? End - Begin : 0;
+	}
+}
+
+/**
+ * Asks the kernel to back the mapping with transparent huge pages.
+ *
+ * The whole range is advised, not only its 2MB aligned part, so that small adjoining mappings end up with the same flags and get
+ * coalesced into a single VMA that khugepaged can collapse later.
+ */
+static void MarkMappedMemoryHugePages(void* Pointer, SIZE_T Size)
+{
+#if defined(MADV_HUGEPAGE)
+	if (GUseHugePages)
+	{
+		if (madvise(Pointer, Size, MADV_HUGEPAGE) == 0)
+		{
+			UnixPlatformMemory::HugePageEligibleBytes += UnixPlatformMemory::GetHugePageRangeSize(Pointer, Size);
+		}
+		else
+		{
+			// not fatal, unlike KSM this is only a performance hint
+			int ErrNo = errno;
+			UE_LOG(LogHAL, Warning, TEXT("madvise(addr=%p, length=%d, advice=MADV_HUGEPAGE) failed with errno = %d (%s), disabling huge pages"),
+				Pointer, Size, ErrNo, StringCast< TCHAR >(strerror(ErrNo)).Get());
+			GUseHugePages = false;
+			UnixPlatformMemory::HugePageEligibleBytes = 0;
+		}
+	}
+#endif // MADV_HUGEPAGE
+}
+
+/** Removes a mapping that is about to be unmapped from the huge page accounting. */
+static void UnmarkMappedMemoryHugePages(void* Pointer, SIZE_T Size)
+{
+#if defined(MADV_HUGEPAGE)
+	if (GUseHugePages)
+	{
+		UnixPlatformMemory::HugePageEligibleBytes -= UnixPlatformMemory::GetHugePageRangeSize(Pointer, Size);
+	}
+#endif // MADV_HUGEPAGE
+}
+
 #ifndef MALLOC_LEAKDETECTION
 	#define MALLOC_LEAKDETECTION 0
 #endif
@@ -363,7 +456,12 @@ void* FUnixPlatformMemory::BinnedAllocFromOS(SIZE_T Size)
 	void* Pointer = nullptr;
 
 	// Binned expects OS allocations to be BinnedPageSize-aligned, and that page is at least 64KB. mmap() alone cannot do this, so carve out the needed chunks.
-	const SIZE_T ExpectedAlignment = FPlatformMemory::GetConstants().BinnedPageSize;
+	SIZE_T ExpectedAlignment = FPlatformMemory::GetConstants().BinnedPageSize;
+	// align allocations that can hold a huge page to one so that none of it is lost to the unaligned ends
+	if (GUseHugePages && !UE4_PLATFORM_REDUCE_NUMBER_OF_MAPS && SizeInWholePages >= UnixPlatformMemory::HugePageSize)
+	{
+		ExpectedAlignment = FMath::Max(ExpectedAlignment, UnixPlatformMemory::HugePageSize);
+	}
 	// Descriptor is only used if we're sanity checking. However, #ifdef'ing its use would make the code more fragile. Size needs to be at least one page.
 	const SIZE_T DescriptorSize = (UE4_PLATFORM_REDUCE_NUMBER_OF_MAPS != 0 || UE4_PLATFORM_SANITY_CHECK_OS_ALLOCATIONS != 0) ? OSPageSize : 0;
 
@@ -450,6 +548,8 @@ void* FUnixPlatformMemory::BinnedAllocFromOS(SIZE_T Size)
 		AllocDescriptor->OriginalSizeAsPassed = Size;
 	}
 
+	MarkMappedMemoryHugePages(Pointer, SizeInWholePages);
+
 	LLM(FLowLevelMemTracker::Get().OnLowLevelAlloc(ELLMTracker::Platform, Pointer, Size));
 	return Pointer;
 }
@@ -461,6 +561,8 @@ void FUnixPlatformMemory::BinnedFreeToOS(void* Ptr, SIZE_T Size)
 	static SIZE_T OSPageSize = FPlatformMemory::GetConstants().PageSize;
 	SIZE_T SizeInWholePages = (Size % OSPageSize) ? (Size + OSPageSize - (Size % OSPageSize)) : Size;
 
+	UnmarkMappedMemoryHugePages(Ptr, SizeInWholePages);
+
 	if (UE4_PLATFORM_REDUCE_NUMBER_OF_MAPS || UE4_PLATFORM_SANITY_CHECK_OS_ALLOCATIONS)
 	{
 		const SIZE_T DescriptorSize = OSPageSize;
@@ -516,6 +618,129 @@ void FUnixPlatformMemory::BinnedFreeToOS(void* Ptr, SIZE_T Size)
 	}
 }
 
+namespace UnixPlatformMemory
+{
+	// from <numaif.h>, which isn't part of the toolchain
+	enum
+	{
+		MPOL_PREFERRED_MODE = 1,
+		MPOL_F_ADDR_FLAG = 1 << 1,
+	};
+
+	/** NUMA topology read from sysfs on first use */
+	struct FNumaTopology
+	{
+		int32 NodeCount = 1;
+		uint64 NodeProcessorMasks[PLATFORM_MAX_NUMA_NODES] = {};
+		int16 ProcessorToNode[64] = {};
+
+		FNumaTopology()
+		{
+#if !PLATFORM_FREEBSD
+			for (int32 Node = 0; Node < PLATFORM_MAX_NUMA_NODES; ++Node)
+			{
+				char Path[64];
+				snprintf(Path, sizeof(Path), "/sys/devices/system/node/node%d/cpulist", Node);
+				FILE* CpuList = fopen(Path, "r");
+				if (!CpuList)
+				{
+					break;
+				}
+				NodeCount = Node + 1;
+
+				// ranges like "0-7,16-23"
+				int First, Last;
+				while (fscanf(CpuList, "%d", &First) == 1)
+				{
+					Last = First;
+					int Separator = fgetc(CpuList);
+					if (Separator == '-')
+					{
+						if (fscanf(CpuList, "%d", &Last) != 1)
+						{
+							break;
+						}
+						Separator = fgetc(CpuList);
+					}
+					for (int Cpu = First; Cpu <= Last && Cpu < 64; ++Cpu)
+					{
+						NodeProcessorMasks[Node] |= uint64(1) << Cpu;
+						ProcessorToNode[Cpu] = Node;
+					}
+					if (Separator != ',')
+					{
+						break;
+					}
+				}
+				fclose(CpuList);
+			}
+#endif
+		}
+	};
+
+	static const FNumaTopology& GetNumaTopology()
+	{
+		static FNumaTopology Topology;
+		return Topology;
+	}
+}
+
+int32 FUnixPlatformMemory::GetNumaNodeCount()
+{
+	return UnixPlatformMemory::GetNumaTopology().NodeCount;
+}
+
+int32 FUnixPlatformMemory::GetCurrentNumaNode()
+{
+	const UnixPlatformMemory::FNumaTopology& Topology = UnixPlatformMemory::GetNumaTopology();
+	if (Topology.NodeCount > 1)
+	{
+#if !PLATFORM_FREEBSD
+		int Cpu = sched_getcpu();
+		if (Cpu >= 0 && Cpu < 64)
+		{
+			return Topology.ProcessorToNode[Cpu];
+		}
+#endif
+	}
+	return 0;
+}
+
+uint64 FUnixPlatformMemory::GetNumaNodeProcessorMask(int32 Node)
+{
+	const UnixPlatformMemory::FNumaTopology& Topology = UnixPlatformMemory::GetNumaTopology();
+	return Node >= 0 && Node < Topology.NodeCount ? Topology.NodeProcessorMasks[Node] : 0;
+}
+
+bool FUnixPlatformMemory::BindToNumaNode(void* Ptr, SIZE_T Size, int32 Node)
+{
+#if !PLATFORM_FREEBSD && defined(SYS_mbind)
+	if (GetNumaNodeCount() > 1)
+	{
+		unsigned long NodeMask = 1ul << Node;
+		return syscall(SYS_mbind, Ptr, Size, int(UnixPlatformMemory::MPOL_PREFERRED_MODE), &NodeMask, sizeof(NodeMask) * 8, 0) == 0;
+	}
+#endif
+	return false;
+}
+
+int32 FUnixPlatformMemory::GetNumaNodeForAddress(const void* Ptr)
+{
+#if !PLATFORM_FREEBSD && defined(SYS_get_mempolicy)
+	if (GetNumaNodeCount() > 1)
+	{
+		int Mode = 0;
+		unsigned long NodeMask = 0;
+		if (syscall(SYS_get_mempolicy, &Mode, &NodeMask, sizeof(NodeMask) * 8, Ptr, int(UnixPlatformMemory::MPOL_F_ADDR_FLAG)) == 0 &&
+			Mode == UnixPlatformMemory::MPOL_PREFERRED_MODE && NodeMask)
+		{
+			return FMath::CountTrailingZeros64(NodeMask);
+		}
+	}
+#endif
+	return 0;
+}
+
 size_t FUnixPlatformMemory::FPlatformVirtualMemoryBlock::GetVirtualSizeAlignment()
 {
 	static SIZE_T OSPageSize = FPlatformMemory::GetConstants().PageSize;
@@ -537,10 +762,29 @@ FUnixPlatformMemory::FPlatformVirtualMemoryBlock FUnixPlatformMemory::FPlatformV
 	size_t Alignment = FMath::Max(InAlignment, GetVirtualSizeAlignment());
 	check(Alignment <= GetVirtualSizeAlignment());
 
-	Result.Ptr = mmap(nullptr, Result.GetActualSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	// reservations that can hold a huge page are aligned to one, this is what lets the pools carved out of them be backed by huge pages
+	const bool bAlignToHugePage = GUseHugePages && Result.GetActualSize() >= UnixPlatformMemory::HugePageSize;
+	const size_t SizeToMap = bAlignToHugePage ? Result.GetActualSize() + UnixPlatformMemory::HugePageSize : Result.GetActualSize();
+
+	Result.Ptr = mmap(nullptr, SizeToMap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
 	if (LIKELY(Result.Ptr != MAP_FAILED))
 	{
+		if (bAlignToHugePage)
+		{
+			// trim the unaligned head and tail, unmapping a zero sized range fails so skip those
+			uint8* MappedPtr = (uint8*)Result.Ptr;
+			uint8* AlignedPtr = Align(MappedPtr, UnixPlatformMemory::HugePageSize);
+			const size_t HeadSize = AlignedPtr - MappedPtr;
+			const size_t TailSize = SizeToMap - HeadSize - Result.GetActualSize();
+			if ((HeadSize > 0 && munmap(MappedPtr, HeadSize) != 0) || (TailSize > 0 && munmap(AlignedPtr + Result.GetActualSize(), TailSize) != 0))
+			{
+				FPlatformMemory::OnOutOfMemory(SizeToMap, InAlignment);
+				// unreachable
+			}
+			Result.Ptr = AlignedPtr;
+		}
 		MarkMappedMemoryMergable(Result.Ptr, Result.GetActualSize());
+		MarkMappedMemoryHugePages(Result.Ptr, Result.GetActualSize());
 	}
 	else
 	{
@@ -557,6 +801,7 @@ void FUnixPlatformMemory::FPlatformVirtualMemoryBlock::FreeVirtual()
 	if (Ptr)
 	{
 		check(GetActualSize() > 0);
+		UnmarkMappedMemoryHugePages(Ptr, GetActualSize());
 		if (munmap(Ptr, GetActualSize()) != 0)
 		{
 			// we can ran out of VMAs here
@@ -629,123 +874,328 @@ namespace UnixPlatformMemory
 	}
 }
 
-FPlatformMemoryStats FUnixPlatformMemory::GetStats()
+namespace UnixPlatformMemory
 {
-	FPlatformMemoryStats MemoryStats;	// will init from constants
-
-#if PLATFORM_FREEBSD
-
-	const FPlatformMemoryConstants& MemoryConstants = FPlatformMemory::GetConstants();
-
-	size_t size = sizeof(SIZE_T);
-
-	SIZE_T SysFreeCount = 0;
-	sysctlbyname("vm.stats.vm.v_free_count", &SysFreeCount, &size, NULL, 0);
-
-	SIZE_T SysActiveCount = 0;
-	sysctlbyname("vm.stats.vm.v_active_count", &SysActiveCount, &size, NULL, 0);
+#if !PLATFORM_FREEBSD
+	/**
+	 * Reads the system wide stats, swap through sysinfo and the rest from the top of /proc/meminfo.
+	 * sysinfo() has no equivalent of MemAvailable, so that still has to be parsed.
+	 */
+	void ReadSystemStats(FPlatformMemoryStats& MemoryStats)
+	{
+		struct sysinfo SysInfo;
+		if (sysinfo(&SysInfo) == 0)
+		{
+			MemoryStats.AvailableVirtual = uint64(SysInfo.freeswap) * uint64(SysInfo.mem_unit);
+		}
 
-	// Get swap info from kvm api
-	kvm_t* Kvm = kvm_open(NULL, "/dev/null", NULL, O_RDONLY, NULL);
-	struct kvm_swap KvmSwap;
-	kvm_getswapinfo(Kvm, &KvmSwap, 1, 0);
-	kvm_close(Kvm);
+		if (FILE* FileGlobalMemStats = fopen("/proc/meminfo", "r"))
+		{
+			// MemFree, MemAvailable and Cached are all in the first few lines, so stop as soon as the ones needed are found
+			bool bHasMemFree = false, bHasMemAvailable = false, bHasCached = false;
+			uint64 MemFree = 0, Cached = 0;
+			while (!bHasMemFree || !(bHasMemAvailable || bHasCached))
+			{
+				char LineBuffer[256] = {0};
+				char *Line = fgets(LineBuffer, UE_ARRAY_COUNT(LineBuffer), FileGlobalMemStats);
+				if (Line == nullptr)
+				{
+					break;	// eof or an error
+				}
 
-	MemoryStats.AvailablePhysical = SysFreeCount * MemoryConstants.PageSize;
-	MemoryStats.AvailableVirtual = (KvmSwap.ksw_total - KvmSwap.ksw_used) * MemoryConstants.PageSize;
-	MemoryStats.UsedPhysical = SysActiveCount * MemoryConstants.PageSize;
-	MemoryStats.UsedVirtual = KvmSwap.ksw_used * MemoryConstants.PageSize;
+				// if we have MemAvailable, favor that (see http://git.kernel.org/cgit/linux/kernel/git/torvalds/linux.git/commit/?id=34e431b0ae398fc54ea69ff85ec700722c9da773)
+				if (strstr(Line, "MemAvailable:") == Line)
+				{
+					MemoryStats.AvailablePhysical = GetBytesFromStatusLine(Line);
+					bHasMemAvailable = MemoryStats.AvailablePhysical != 0;
+				}
+				else if (strstr(Line, "MemFree:") == Line)
+				{
+					MemFree = GetBytesFromStatusLine(Line);
+					bHasMemFree = true;
+				}
+				else if (strstr(Line, "Cached:") == Line)
+				{
+					Cached = GetBytesFromStatusLine(Line);
+					bHasCached = true;
+				}
+			}
 
-#else
+			// if we didn't have MemAvailable (kernels < 3.14 or CentOS 6.x), use free + cached as a (bad) approximation
+			if (!bHasMemAvailable)
+			{
+				MemoryStats.AvailablePhysical = FMath::Min(MemFree + Cached, MemoryStats.TotalPhysical);
+			}
 
-	// open to all kind of overflows, thanks to Unix approach of exposing system stats via /proc and lack of proper C API
-	// And no, sysinfo() isn't useful for this (cannot get the same value for MemAvailable through it for example).
+			fclose(FileGlobalMemStats);
+		}
+	}
 
-	if (FILE* FileGlobalMemStats = fopen("/proc/meminfo", "r"))
+	/** Reads the current and peak usage of this process from /proc/self/status */
+	void ReadProcessStatus(FPlatformMemoryStats& MemoryStats)
 	{
-		int FieldsSetSuccessfully = 0;
-		uint64 MemFree = 0, Cached = 0;
-		do
+		// again /proc "API" :/
+		if (FILE* ProcMemStats = fopen("/proc/self/status", "r"))
 		{
-			char LineBuffer[256] = {0};
-			char *Line = fgets(LineBuffer, UE_ARRAY_COUNT(LineBuffer), FileGlobalMemStats);
-			if (Line == nullptr)
+			int FieldsSetSuccessfully = 0;
+			do
 			{
-				break;	// eof or an error
-			}
+				char LineBuffer[256] = {0};
+				char *Line = fgets(LineBuffer, UE_ARRAY_COUNT(LineBuffer), ProcMemStats);
+				if (Line == nullptr)
+				{
+					break;	// eof or an error
+				}
 
-			// if we have MemAvailable, favor that (see http://git.kernel.org/cgit/linux/kernel/git/torvalds/linux.git/commit/?id=34e431b0ae398fc54ea69ff85ec700722c9da773)
-			if (strstr(Line, "MemAvailable:") == Line)
-			{
-				MemoryStats.AvailablePhysical = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
-			}
-			else if (strstr(Line, "SwapFree:") == Line)
-			{
-				MemoryStats.AvailableVirtual = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
-			}
-			else if (strstr(Line, "MemFree:") == Line)
-			{
-				MemFree = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
-			}
-			else if (strstr(Line, "Cached:") == Line)
-			{
-				Cached = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
+				if (strstr(Line, "VmPeak:") == Line)
+				{
+					MemoryStats.PeakUsedVirtual = GetBytesFromStatusLine(Line);
+					++FieldsSetSuccessfully;
+				}
+				else if (strstr(Line, "VmSize:") == Line)
+				{
+					MemoryStats.UsedVirtual = GetBytesFromStatusLine(Line);
+					++FieldsSetSuccessfully;
+				}
+				else if (strstr(Line, "VmHWM:") == Line)
+				{
+					MemoryStats.PeakUsedPhysical = GetBytesFromStatusLine(Line);
+					++FieldsSetSuccessfully;
+				}
+				else if (strstr(Line, "VmRSS:") == Line)
+				{
+					MemoryStats.UsedPhysical = GetBytesFromStatusLine(Line);
+					++FieldsSetSuccessfully;
+				}
 			}
+			while(FieldsSetSuccessfully < 4);
+
+			fclose(ProcMemStats);
 		}
-		while(FieldsSetSuccessfully < 4);
+	}
 
-		// if we didn't have MemAvailable (kernels < 3.14 or CentOS 6.x), use free + cached as a (bad) approximation
-		if (MemoryStats.AvailablePhysical == 0)
+	/**
+	 * Reads the current usage of this process from the single line of /proc/self/statm and the physical peak from getrusage(),
+	 * which is much less to parse than /proc/self/status. There is no counter for the virtual peak, that is left to the caller.
+	 *
+	 * @return false if statm could not be read
+	 */
+	bool ReadProcessCounters(FPlatformMemoryStats& MemoryStats)
+	{
+		const int Fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+		if (Fd < 0)
 		{
-			MemoryStats.AvailablePhysical = FMath::Min(MemFree + Cached, MemoryStats.TotalPhysical);
+			return false;
 		}
 
-		fclose(FileGlobalMemStats);
+		char Buffer[128];
+		const ssize_t BytesRead = read(Fd, Buffer, sizeof(Buffer) - 1);
+		close(Fd);
+		if (BytesRead <= 0)
+		{
+			return false;
+		}
+		Buffer[BytesRead] = 0;
+
+		// "size resident shared text lib data dt", in pages
+		char* End = nullptr;
+		const uint64 SizePages = strtoull(Buffer, &End, 10);
+		const uint64 ResidentPages = strtoull(End, nullptr, 10);
+		const uint64 PageSize = uint64(sysconf(_SC_PAGESIZE));
+		MemoryStats.UsedVirtual = SizePages * PageSize;
+		MemoryStats.UsedPhysical = ResidentPages * PageSize;
+
+		struct rusage Usage;
+		if (getrusage(RUSAGE_SELF, &Usage) == 0)
+		{
+			MemoryStats.PeakUsedPhysical = uint64(Usage.ru_maxrss) * 1024;
+		}
+		return true;
 	}
+#endif // !PLATFORM_FREEBSD
+
+	/** Number of FPlatformMemoryStats fields that change and are cached, see FCachedStats */
+	enum { NumCachedValues = 6 };
 
-	// again /proc "API" :/
-	if (FILE* ProcMemStats = fopen("/proc/self/status", "r"))
+	/**
+	 * The last stats read by GetStats, so that calling it every frame from several threads does not parse /proc each time.
+	 * One thread at a time refreshes the values, bumping Sequence before and after, and readers copy them without a lock,
+	 * retrying if Sequence shows that a refresh happened meanwhile.
+	 */
+	struct FCachedStats
 	{
-		int FieldsSetSuccessfully = 0;
-		do
+		/** Odd while the values are being written */
+		TAtomic<uint32> Sequence;
+
+		/** Set while a thread is refreshing, the others keep the previous values rather than wait for it */
+		TAtomic<bool> bRefreshing;
+
+		/** When the values were read, in nanoseconds of CLOCK_MONOTONIC_COARSE, zero until the first refresh */
+		TAtomic<uint64> RefreshNanoseconds;
+
+		/** AvailablePhysical, AvailableVirtual, UsedPhysical, PeakUsedPhysical, UsedVirtual and PeakUsedVirtual */
+		TAtomic<uint64> Values[NumCachedValues];
+
+		FCachedStats()
+			: Sequence(0)
+			, bRefreshing(false)
+			, RefreshNanoseconds(0)
 		{
-			char LineBuffer[256] = {0};
-			char *Line = fgets(LineBuffer, UE_ARRAY_COUNT(LineBuffer), ProcMemStats);
-			if (Line == nullptr)
+			for (TAtomic<uint64>& Value : Values)
 			{
-				break;	// eof or an error
+				Value = 0;
 			}
+		}
+	};
 
-			if (strstr(Line, "VmPeak:") == Line)
-			{
-				MemoryStats.PeakUsedVirtual = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
-			}
-			else if (strstr(Line, "VmSize:") == Line)
+	FCachedStats& GetCachedStats()
+	{
+		static FCachedStats CachedStats;
+		return CachedStats;
+	}
+
+	uint64 GetCoarseNanoseconds()
+	{
+		// The coarse clock is a plain read of the vDSO, with a tick's resolution which is plenty for this
+		struct timespec Time;
+		clock_gettime(CLOCK_MONOTONIC_COARSE, &Time);
+		return uint64(Time.tv_sec) * 1000000000ull + uint64(Time.tv_nsec);
+	}
+
+	void StoreCachedStats(FCachedStats& CachedStats, const FPlatformMemoryStats& MemoryStats, uint64 Nanoseconds)
+	{
+		++CachedStats.Sequence;
+		CachedStats.Values[0] = MemoryStats.AvailablePhysical;
+		CachedStats.Values[1] = MemoryStats.AvailableVirtual;
+		CachedStats.Values[2] = MemoryStats.UsedPhysical;
+		CachedStats.Values[3] = MemoryStats.PeakUsedPhysical;
+		CachedStats.Values[4] = MemoryStats.UsedVirtual;
+		CachedStats.Values[5] = MemoryStats.PeakUsedVirtual;
+		CachedStats.RefreshNanoseconds = Nanoseconds;
+		++CachedStats.Sequence;
+	}
+
+	/** @return false if a refresh was writing the values the whole time */
+	bool LoadCachedStats(const FCachedStats& CachedStats, FPlatformMemoryStats& OutMemoryStats)
+	{
+		for (int32 Attempt = 0; Attempt < 64; ++Attempt)
+		{
+			const uint32 Sequence = CachedStats.Sequence;
+			if (Sequence & 1)
 			{
-				MemoryStats.UsedVirtual = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
+				FPlatformProcess::Yield();
+				continue;
 			}
-			else if (strstr(Line, "VmHWM:") == Line)
+
+			uint64 Values[NumCachedValues];
+			for (int32 Index = 0; Index < NumCachedValues; ++Index)
 			{
-				MemoryStats.PeakUsedPhysical = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
+				Values[Index] = CachedStats.Values[Index];
 			}
-			else if (strstr(Line, "VmRSS:") == Line)
+
+			if (CachedStats.Sequence == Sequence)
 			{
-				MemoryStats.UsedPhysical = UnixPlatformMemory::GetBytesFromStatusLine(Line);
-				++FieldsSetSuccessfully;
+				OutMemoryStats.AvailablePhysical = Values[0];
+				OutMemoryStats.AvailableVirtual = Values[1];
+				OutMemoryStats.UsedPhysical = Values[2];
+				OutMemoryStats.PeakUsedPhysical = Values[3];
+				OutMemoryStats.UsedVirtual = Values[4];
+				OutMemoryStats.PeakUsedVirtual = Values[5];
+				return true;
 			}
 		}
-		while(FieldsSetSuccessfully < 4);
+		return false;
+	}
+}
+
+/** How long GetStats can return the values it read before instead of reading them again, 0 to always read them */
+float CORE_API GMemoryStatsCacheSeconds = 0.1f;
+static FAutoConsoleVariableRef CVarMemoryStatsCacheSeconds(
+	TEXT("memory.StatsCacheSeconds"),
+	GMemoryStatsCacheSeconds,
+	TEXT("How long FPlatformMemory::GetStats reuses the stats it read from the OS, in seconds. 0 reads them on every call."),
+	ECVF_Default);
 
-		fclose(ProcMemStats);
+FPlatformMemoryStats FUnixPlatformMemory::GetStats()
+{
+	using namespace UnixPlatformMemory;
+
+	if (GMemoryStatsCacheSeconds <= 0.f)
+	{
+		return GetStatsUncached();
 	}
 
+	FCachedStats& CachedStats = GetCachedStats();
+	const uint64 Now = GetCoarseNanoseconds();
+	const uint64 RefreshNanoseconds = CachedStats.RefreshNanoseconds;
+	const bool bStale = RefreshNanoseconds == 0 || Now - RefreshNanoseconds >= uint64(GMemoryStatsCacheSeconds * 1e9f);
+
+	FPlatformMemoryStats MemoryStats;	// will init from constants
+	if (!bStale || CachedStats.bRefreshing.Exchange(true))
+	{
+		// Fresh enough, or another thread is reading the new values and these will do until it is done
+		if (RefreshNanoseconds != 0 && LoadCachedStats(CachedStats, MemoryStats))
+		{
+			return MemoryStats;
+		}
+		return GetStatsUncached();
+	}
+
+#if PLATFORM_FREEBSD
+	MemoryStats = GetStatsUncached();
+#else
+	ReadSystemStats(MemoryStats);
+	if (RefreshNanoseconds == 0 || !ReadProcessCounters(MemoryStats))
+	{
+		// The first time, so there is a virtual peak to start from
+		ReadProcessStatus(MemoryStats);
+	}
+	else
+	{
+		MemoryStats.PeakUsedVirtual = CachedStats.Values[5];
+	}
+
+	MemoryStats.PeakUsedVirtual = FMath::Max(MemoryStats.PeakUsedVirtual, MemoryStats.UsedVirtual);
+	MemoryStats.PeakUsedPhysical = FMath::Max(MemoryStats.PeakUsedPhysical, MemoryStats.UsedPhysical);
+#endif // PLATFORM_FREEBSD
+
+	StoreCachedStats(CachedStats, MemoryStats, Now);
+	CachedStats.bRefreshing = false;
+	return MemoryStats;
+}
+
+FPlatformMemoryStats FUnixPlatformMemory::GetStatsUncached()
+{
+	FPlatformMemoryStats MemoryStats;	// will init from constants
+
+#if PLATFORM_FREEBSD
+
+	const FPlatformMemoryConstants& MemoryConstants = FPlatformMemory::GetConstants();
+
+	size_t size = sizeof(SIZE_T);
+
+	SIZE_T SysFreeCount = 0;
+	sysctlbyname("vm.stats.vm.v_free_count", &SysFreeCount, &size, NULL, 0);
+
+	SIZE_T SysActiveCount = 0;
+	sysctlbyname("vm.stats.vm.v_active_count", &SysActiveCount, &size, NULL, 0);
+
+	// Get swap info from kvm api
+	kvm_t* Kvm = kvm_open(NULL, "/dev/null", NULL, O_RDONLY, NULL);
+	struct kvm_swap KvmSwap;
+	kvm_getswapinfo(Kvm, &KvmSwap, 1, 0);
+	kvm_close(Kvm);
+
+	MemoryStats.AvailablePhysical = SysFreeCount * MemoryConstants.PageSize;
+	MemoryStats.AvailableVirtual = (KvmSwap.ksw_total - KvmSwap.ksw_used) * MemoryConstants.PageSize;
+	MemoryStats.UsedPhysical = SysActiveCount * MemoryConstants.PageSize;
+	MemoryStats.UsedVirtual = KvmSwap.ksw_used * MemoryConstants.PageSize;
+
+#else
+
+	UnixPlatformMemory::ReadSystemStats(MemoryStats);
+	UnixPlatformMemory::ReadProcessStatus(MemoryStats);
+
 #endif // PLATFORM_FREEBSD
 
 	// sanitize stats as sometimes peak < used for some reason
@@ -1003,7 +1453,7 @@ void FUnixPlatformMemory::OnOutOfMemory(uint64 Size, uint32 Alignment)
 	FMalloc* Prev = GMalloc;
 	FPlatformMallocCrash::Get().SetAsGMalloc();
 
-	FPlatformMemoryStats PlatformMemoryStats = FPlatformMemory::GetStats();
+	FPlatformMemoryStats PlatformMemoryStats = FPlatformMemory::GetStatsUncached();
 
 	UE_LOG(LogMemory, Warning, TEXT("MemoryStats:")\
 		TEXT("\n\tAvailablePhysical %llu")\
@@ -1068,3 +1518,45 @@ bool FUnixPlatformMemory::GetLLMAllocFunctions(void*(*&OutAllocFunction)(size_t)
 	return false;
 #endif
 }
+
+void FUnixPlatformMemory::UpdateCustomLLMTags()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER && defined(MADV_HUGEPAGE)
+	if (!GUseHugePages)
+	{
+		return;
+	}
+
+	// smaps_rollup walks every mapping of the process, don't do this every frame
+	static double LastUpdateTime = 0.0;
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (CurrentTime - LastUpdateTime < 1.0)
+	{
+		return;
+	}
+	LastUpdateTime = CurrentTime;
+
+	// AnonHugePages is the memory that actually got backed by huge pages, compare it against what we asked for
+	uint64 AnonHugePages = 0;
+	if (FILE* ProcSMapsRollup = fopen("/proc/self/smaps_rollup", "r"))
+	{
+		char LineBuffer[256] = { 0 };
+		while (char* Line = fgets(LineBuffer, UE_ARRAY_COUNT(LineBuffer), ProcSMapsRollup))
+		{
+			if (strstr(Line, "AnonHugePages:") == Line)
+			{
+				AnonHugePages = UnixPlatformMemory::GetBytesFromStatusLine(Line);
+				break;
+			}
+		}
+		fclose(ProcSMapsRollup);
+	}
+
+	const int64 EligibleBytes = UnixPlatformMemory::HugePageEligibleBytes.Load(EMemoryOrder::Relaxed);
+	const int64 MissedBytes = FMath::Max<int64>(EligibleBytes - (int64)AnonHugePages, 0);
+
+	// these overlap with the memory already tracked by the allocators so don't add them to the total
+	FLowLevelMemTracker::Get().SetTagAmountForTracker(ELLMTracker::Platform, ELLMTag::PlatformHugePages, (int64)AnonHugePages, false);
+	FLowLevelMemTracker::Get().SetTagAmountForTracker(ELLMTracker::Platform, ELLMTag::PlatformHugePagesMissed, MissedBytes, false);
+#endif
+}
@@ -161,6 +161,38 @@ static void UnixPlatForm_CheckIfKSMUsable()
 	GKSMMergeAllPages = GUseKSM && GKSMMergeAllPages;
 }
 
+// Defined in UnixPlatformMemory
+extern bool GUseHugePages;
+
+static void UnixPlatForm_CheckIfHugePagesUsable()
+{
+	// https://www.kernel.org/doc/Documentation/vm/transhuge.txt
+	if (GUseHugePages)
+	{
+		// the active mode is bracketed, e.g. "always [madvise] never"
+		char EnabledMode[128] = { 0 };
+		if (FILE* THPEnabledFile = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r"))
+		{
+			if (fgets(EnabledMode, UE_ARRAY_COUNT(EnabledMode), THPEnabledFile) == nullptr)
+			{
+				EnabledMode[0] = 0;
+			}
+
+			fclose(THPEnabledFile);
+		}
+
+		if (strstr(EnabledMode, "[always]") == nullptr && strstr(EnabledMode, "[madvise]") == nullptr)
+		{
+			GUseHugePages = false;
+			UE_LOG(LogInit, Error, TEXT("Cannot use transparent huge pages when they are disabled in the kernel. Please check /sys/kernel/mm/transparent_hugepage/enabled"));
+		}
+		else
+		{
+			UE_LOG(LogInit, Log, TEXT("Transparent huge pages enabled for mapped memory."));
+		}
+	}
+}
+
 // Init'ed in UnixPlatformMemory for now. Once the old crash symbolicator is gone remove this
 extern bool CORE_API GUseNewCrashSymbolicator;
 
@@ -180,6 +212,7 @@ void FUnixPlatformMisc::PlatformInit()
 	bool bPreloadedModuleSymbolFile = FParse::Param(FCommandLine::Get(), TEXT("preloadmodulesymbols"));
 
 	UnixPlatForm_CheckIfKSMUsable();
+	UnixPlatForm_CheckIfHugePagesUsable();
 
 	UE_LOG(LogInit, Log, TEXT("Unix hardware info:"));
 	UE_LOG(LogInit, Log, TEXT(" - we are %sthe first instance of this executable"), bFirstInstance ? TEXT("") : TEXT("not "));
@@ -211,6 +244,7 @@ void FUnixPlatformMisc::PlatformInit()
 	UE_LOG(LogInit, Log, TEXT(" -filemapcachesize=NUMBER - set the size for case-sensitive file mapping cache"));
 	UE_LOG(LogInit, Log, TEXT(" -useksm - uses kernel same-page mapping (KSM) for mapped memory (%s)"), GUseKSM ? TEXT("ON") : TEXT("OFF"));
 	UE_LOG(LogInit, Log, TEXT(" -ksmmergeall - marks all mmap'd memory pages suitable for KSM (%s)"), GKSMMergeAllPages ? TEXT("ON") : TEXT("OFF"));
+	UE_LOG(LogInit, Log, TEXT(" -hugepages - advises the kernel to back mmap'd memory with transparent huge pages (%s)"), GUseHugePages ? TEXT("ON") : TEXT("OFF"));
 	UE_LOG(LogInit, Log, TEXT(" -preloadmodulesymbols - Loads the main module symbols file into memory (%s)"), bPreloadedModuleSymbolFile ? TEXT("ON") : TEXT("OFF"));
 	UE_LOG(LogInit, Log, TEXT(" -sigdfl=SIGNAL - Allows a specific signal to be set to its default handler rather then ignoring the signal"));
 
@@ -568,6 +602,127 @@ int32 FUnixPlatformMisc::NumberOfCoresIncludingHyperthreads()
 	return NumCoreIds;
 }
 
+/** Reads a sysfs cpu list like "0-3,8-11" as an affinity mask, processors past the first 64 are left out */
+static uint64 UnixPlatform_ReadCpuListMask(const char* FileName)
+{
+	uint64 Mask = 0;
+	if (FILE* ListFile = fopen(FileName, "r"))
+	{
+		int First = 0;
+		while (fscanf(ListFile, "%d", &First) == 1)
+		{
+			int Last = First;
+			int Separator = fgetc(ListFile);
+			if (Separator == '-')
+			{
+				if (fscanf(ListFile, "%d", &Last) != 1)
+				{
+					break;
+				}
+				Separator = fgetc(ListFile);
+			}
+			for (int Cpu = FMath::Max(First, 0); Cpu <= Last && Cpu < 64; ++Cpu)
+			{
+				Mask |= uint64(1) << Cpu;
+			}
+			if (Separator != ',')
+			{
+				break;
+			}
+		}
+		fclose(ListFile);
+	}
+	return Mask;
+}
+
+const FCPUTopology& FUnixPlatformMisc::GetCPUTopology()
+{
+	static FCPUTopology Topology = []()
+	{
+		FCPUTopology Result;
+		cpu_set_t AvailableCpusMask;
+		CPU_ZERO(&AvailableCpusMask);
+		if (0 == sched_getaffinity(0, sizeof(AvailableCpusMask), &AvailableCpusMask))
+		{
+			uint64 AvailableMask = 0;
+			for (int32 CpuIdx = 0; CpuIdx < 64; ++CpuIdx)
+			{
+				if (CPU_ISSET(CpuIdx, &AvailableCpusMask))
+				{
+					AvailableMask |= uint64(1) << CpuIdx;
+				}
+			}
+
+			char FileNameBuffer[1024];
+			uint64 Described = 0;
+			for (int32 CpuIdx = 0; CpuIdx < 64; ++CpuIdx)
+			{
+				if (!(AvailableMask & ~Described & (uint64(1) << CpuIdx)))
+				{
+					continue;
+				}
+
+				// Processors the process can not run on are left out, they can not be in an affinity mask either
+				sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", CpuIdx);
+				const uint64 CoreMask = (UnixPlatform_ReadCpuListMask(FileNameBuffer) | (uint64(1) << CpuIdx)) & AvailableMask;
+				Described |= CoreMask;
+
+				// cpu_capacity is only there on asymmetric ARM systems
+				int32 Capacity = 0;
+				sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/cpu_capacity", CpuIdx);
+				if (FILE* CapacityFile = fopen(FileNameBuffer, "r"))
+				{
+					if (1 != fscanf(CapacityFile, "%d", &Capacity))
+					{
+						Capacity = 0;
+					}
+					fclose(CapacityFile);
+				}
+
+				Result.CoreMasks[Result.NumCores] = CoreMask;
+				Result.CorePerformanceClasses[Result.NumCores] = Capacity;
+				++Result.NumCores;
+
+				for (int32 CacheIdx = 0; CacheIdx < 8; ++CacheIdx)
+				{
+					int Level = 0;
+					sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/cache/index%d/level", CpuIdx, CacheIdx);
+					if (FILE* LevelFile = fopen(FileNameBuffer, "r"))
+					{
+						if (1 != fscanf(LevelFile, "%d", &Level))
+						{
+							Level = 0;
+						}
+						fclose(LevelFile);
+					}
+					if (Level == 3)
+					{
+						sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", CpuIdx, CacheIdx);
+						const uint64 DomainMask = UnixPlatform_ReadCpuListMask(FileNameBuffer) & AvailableMask;
+						bool bKnownDomain = false;
+						for (int32 Domain = 0; Domain < Result.NumCacheDomains; ++Domain)
+						{
+							bKnownDomain |= Result.CacheDomainMasks[Domain] == DomainMask;
+						}
+						if (DomainMask && !bKnownDomain)
+						{
+							Result.CacheDomainMasks[Result.NumCacheDomains++] = DomainMask;
+						}
+						break;
+					}
+				}
+			}
+		}
+		if (Result.NumCores == 0)
+		{
+			return FGenericPlatformMisc::GetCPUTopology();
+		}
+		Result.Finalize();
+		return Result;
+	}();
+	return Topology;
+}
+
 const TCHAR* FUnixPlatformMisc::GetNullRHIShaderFormat()
 {
 	return TEXT("SF_VULKAN_SM5");
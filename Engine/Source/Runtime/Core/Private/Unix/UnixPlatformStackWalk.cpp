@@ -17,6 +17,7 @@
 #include "HAL/PlatformTime.h"
 
 #include <link.h>
+#include <pthread.h>
 #include <signal.h>
 
 #include "HAL/IConsoleManager.h"
@@ -698,6 +699,86 @@ uint32 FUnixPlatformStackWalk::CaptureStackBackTrace( uint64* BackTrace, uint32
 	return (uint32)Size;
 }
 
+namespace
+{
+	/** Bounds of the calling thread's stack, frame pointers outside of it are where a walk has to stop */
+	struct FThreadStackBounds
+	{
+		uint64 Low = 0;
+		uint64 High = 0;
+	};
+
+	const FThreadStackBounds& GetThreadStackBounds()
+	{
+		static thread_local FThreadStackBounds Bounds;
+		static thread_local bool bInitialized = false;
+		if (!bInitialized)
+		{
+			bInitialized = true;
+			pthread_attr_t Attributes;
+			if (pthread_getattr_np(pthread_self(), &Attributes) == 0)
+			{
+				void* StackAddress = nullptr;
+				size_t StackSize = 0;
+				if (pthread_attr_getstack(&Attributes, &StackAddress, &StackSize) == 0)
+				{
+					Bounds.Low = reinterpret_cast<uint64>(StackAddress);
+					Bounds.High = Bounds.Low + StackSize;
+				}
+				pthread_attr_destroy(&Attributes);
+			}
+		}
+		return Bounds;
+	}
+
+	/**
+	 * Follows the chain of frame records, each one the caller's frame pointer followed by the return address, on both
+	 * x86-64 and AArch64. The walk stops at the first record that is not further up the stack than the previous one,
+	 * so code built without frame pointers cuts the backtrace short but can't make it read outside of the stack.
+	 * This is not inlined so that its first return address is in CaptureStackBackTraceFast, like backtrace()'s is.
+	 */
+	FORCENOINLINE uint32 WalkFramePointers(uint64* BackTrace, uint32 MaxDepth)
+	{
+#if PLATFORM_64BITS && (PLATFORM_CPU_X86_FAMILY || PLATFORM_CPU_ARM_FAMILY)
+		const FThreadStackBounds& Bounds = GetThreadStackBounds();
+		uint64 Frame = reinterpret_cast<uint64>(__builtin_frame_address(0));
+		uint32 Depth = 0;
+		while (Depth < MaxDepth && Frame >= Bounds.Low && Frame + 2 * sizeof(uint64) <= Bounds.High && (Frame & (sizeof(uint64) - 1)) == 0)
+		{
+			const uint64* Record = reinterpret_cast<const uint64*>(Frame);
+			const uint64 ReturnAddress = Record[1];
+			if (ReturnAddress == 0)
+			{
+				break;
+			}
+			BackTrace[Depth++] = ReturnAddress;
+
+			const uint64 CallerFrame = Record[0];
+			if (CallerFrame <= Frame)
+			{
+				break;
+			}
+			Frame = CallerFrame;
+		}
+		return Depth;
+#else
+		return 0;
+#endif
+	}
+}
+
+FORCENOINLINE uint32 FUnixPlatformStackWalk::CaptureStackBackTraceFast( uint64* BackTrace, uint32 MaxDepth )
+{
+	if (BackTrace == nullptr || MaxDepth == 0)
+	{
+		return 0;
+	}
+
+	// Nothing was walked when running on a signal stack, or on a CPU without a walker. backtrace() then has this frame too.
+	const uint32 Depth = WalkFramePointers(BackTrace, MaxDepth);
+	return Depth ? Depth : CaptureStackBackTrace(BackTrace, MaxDepth);
+}
+
 namespace
 {
 	void WaitForSignalHandlerToFinishOrCrash(ThreadStackUserData& ThreadStack)
@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Unix/UnixPlatformString.h"
+#include "Algo/Impl/VectorizedFind.h"
+
+int32 FUnixPlatformString::Strlen16(const UTF16CHAR* String)
+{
+	return int32(AlgoImpl::FindCharOrTerminator(String, UTF16CHAR(0)) - String);
+}
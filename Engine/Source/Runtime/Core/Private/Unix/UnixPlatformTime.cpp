@@ -9,8 +9,16 @@
 #include "Logging/LogMacros.h"
 #include "CoreGlobals.h"
 #include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER && PLATFORM_CPU_X86_FAMILY
+	#include <cpuid.h>
+#endif
 
 int FUnixTime::ClockSource = -1;
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+bool FUnixTime::bUseTimestampCounter = false;
+#endif
 char FUnixTime::CalibrationLog[4096] = {0};
 
 namespace
@@ -24,6 +32,35 @@ namespace
 	{
 		return static_cast<uint64>(ts.tv_sec) * 1000000000ULL + static_cast<uint64>(ts.tv_nsec);
 	}
+
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	/**
+	 * Whether the kernel keeps time with the timestamp counter. It only does so once it has checked that the counters
+	 * of all cores and sockets tick together, and switches away from them when they drift apart.
+	 * Should stay in sync with TraceLog's TimeGetTimestamp() or the timeline will be broken!
+	 */
+	bool KernelClockSourceIsTimestampCounter()
+	{
+#if PLATFORM_CPU_X86_FAMILY
+		const char* TimestampCounterSource = "tsc";
+#else
+		const char* TimestampCounterSource = "arch_sys_counter";
+#endif
+		char Source[64] = { 0 };
+		int File = open("/sys/devices/system/clocksource/clocksource0/current_clocksource", O_RDONLY);
+		if (File == -1)
+		{
+			return false;
+		}
+		ssize_t Size = read(File, Source, sizeof(Source) - 1);
+		close(File);
+		for (; Size > 0 && (Source[Size - 1] == '\n' || Source[Size - 1] == ' '); --Size)
+		{
+			Source[Size - 1] = 0;
+		}
+		return FCStringAnsi::Strcmp(Source, TimestampCounterSource) == 0;
+	}
+#endif
 }
 
 double FUnixTime::InitTiming()
@@ -34,8 +71,80 @@ double FUnixTime::InitTiming()
 		ClockSource = FUnixTime::CalibrateAndSelectClock();
 	}
 
-	return FGenericPlatformTime::InitTiming();
+	const double CurrentSeconds = FGenericPlatformTime::InitTiming();
+
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	// The counter is calibrated once, Cycles64 must not change units after it started counting ticks
+	static const uint64 TimestampCounterFrequency = CalibrateTimestampCounter();
+	if (TimestampCounterFrequency)
+	{
+		SecondsPerCycle64 = 1.0 / static_cast<double>(TimestampCounterFrequency);
+		bUseTimestampCounter = true;
+	}
+#endif
+
+	return CurrentSeconds;
+}
+
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+uint64 FUnixTime::CalibrateTimestampCounter()
+{
+	char Buffer[256];
+
+	if (!KernelClockSourceIsTimestampCounter())
+	{
+		FCStringAnsi::Strncat(CalibrationLog, "Timestamp counter not used, the kernel doesn't keep time with it so it may differ between cores.\n", sizeof(CalibrationLog));
+		return 0;
+	}
+
+#if PLATFORM_CPU_X86_FAMILY
+	// The counter must tick at the same rate whatever the power state, which the kernel doesn't require of its clock source
+	uint32 Eax = 0, Ebx = 0, Ecx = 0, Edx = 0;
+	if (!__get_cpuid(0x80000007, &Eax, &Ebx, &Ecx, &Edx) || !(Edx & (1 << 8)))
+	{
+		FCStringAnsi::Strncat(CalibrationLog, "Timestamp counter not used, the CPU doesn't report an invariant one.\n", sizeof(CalibrationLog));
+		return 0;
+	}
+
+	// Measure the counter against a clock that isn't slewed by NTP, bracketing each clock read with two counter reads
+	const uint64 kCalibrationPeriodNanoSec = 20ULL * 1000000ULL;
+	struct timespec ts;
+
+	const uint64 StartCounterBefore = ReadTimestampCounter();
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	const uint64 StartCounterAfter = ReadTimestampCounter();
+	const uint64 StartNanoSec = TimeSpecToMicroSec(ts);
+
+	uint64 EndNanoSec, EndCounterBefore, EndCounterAfter;
+	do
+	{
+		EndCounterBefore = ReadTimestampCounter();
+		clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+		EndCounterAfter = ReadTimestampCounter();
+		EndNanoSec = TimeSpecToMicroSec(ts);
+	}
+	while (EndNanoSec - StartNanoSec < kCalibrationPeriodNanoSec);
+
+	const double StartCounter = 0.5 * (static_cast<double>(StartCounterBefore) + static_cast<double>(StartCounterAfter));
+	const double EndCounter = 0.5 * (static_cast<double>(EndCounterBefore) + static_cast<double>(EndCounterAfter));
+	const uint64 Frequency = static_cast<uint64>((EndCounter - StartCounter) * 1e9 / static_cast<double>(EndNanoSec - StartNanoSec));
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	// The generic timer reports its own rate
+	uint64 Frequency;
+	__asm__ volatile("mrs %0, cntfrq_el0" : "=r"(Frequency));
+#else
+	const uint64 Frequency = 0;
+#endif
+	if (!Frequency)
+	{
+		return 0;
+	}
+
+	FCStringAnsi::Snprintf(Buffer, sizeof(Buffer), "Using the timestamp counter for Cycles64(), ticking at %llu Hz.\n", Frequency);
+	FCStringAnsi::Strncat(CalibrationLog, Buffer, sizeof(CalibrationLog));
+	return Frequency;
 }
+#endif
 
 FCPUTime FUnixTime::GetCPUTime()
 {
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "ProfilingDebugging/PlatformFileTrace.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
 
 PRAGMA_DISABLE_UNSAFE_TYPECAST_WARNINGS
 
@@ -28,6 +31,58 @@ public:
 	}
 };
 
+/** OVERLAPPED of a read, so the completion port can find the request it belongs to */
+struct FWindowsOverlappedRead : public OVERLAPPED
+{
+	FWindowsReadRequest* Request;
+};
+
+/**
+ * Completion port all the async read handles are associated with. A single thread dequeues the completions
+ * and finishes the requests, so the number of reads in flight is only limited by the device, not by GIOThreadPool.
+ */
+class FWindowsIOCompletionPort : public FRunnable
+{
+	HANDLE Port;
+	FRunnableThread* Thread;
+
+	FWindowsIOCompletionPort()
+		: Port(CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1))
+		, Thread(nullptr)
+	{
+		if (Port)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("WindowsIOCompletion"), 0, TPri_AboveNormal);
+		}
+	}
+
+public:
+	/** @return the completion port, or null if reads have to be completed by GIOThreadPool tasks */
+	static FWindowsIOCompletionPort* Get()
+	{
+		if (!FPlatformProcess::SupportsMultithreading())
+		{
+			return nullptr;
+		}
+		// Lives as long as the process, requests can complete during static destruction
+		static FWindowsIOCompletionPort* Singleton = new FWindowsIOCompletionPort();
+		return Singleton->Thread ? Singleton : nullptr;
+	}
+
+	/** Makes the completions of the reads of FileHandle go to the port. Must be called before any read is started on it. */
+	bool Associate(HANDLE FileHandle)
+	{
+		return CreateIoCompletionPort(FileHandle, Port, 0, 0) == Port;
+	}
+
+	virtual uint32 Run() override;
+
+	virtual void Stop() override
+	{
+		PostQueuedCompletionStatus(Port, 0, 0, nullptr);
+	}
+};
+
 extern CORE_API TLockFreePointerListUnordered<void, PLATFORM_CACHE_LINE_SIZE> WindowsAsyncIOEventPool;
 
 HANDLE GetIOPooledEvent()
@@ -62,9 +117,16 @@ class FWindowsReadRequest : public IAsyncReadRequest
 	uint8* TempMemory;
 	int64 AlignedOffset;
 	int64 AlignedBytesToRead;
-	OVERLAPPED OverlappedIO;
+	FWindowsOverlappedRead OverlappedIO;
+	/** Set when the read failed and has to be retried synchronously by the task */
+	FString FailedMessage;
+	/** Only used with the completion port, triggered once the request is complete */
+	FEvent* CompletionEvent;
+	/** Set by the completion port once it is done with the request, the request can't be deleted before */
+	volatile bool bCompletionPortDone;
+	bool bUsesCompletionPort;
 public:
-	FWindowsReadRequest(FWindowsAsyncReadFileHandle* InOwner, FAsyncFileCallBack* CompleteCallback, uint8* InUserSuppliedMemory, int64 InOffset, int64 InBytesToRead, int64 InFileSize, HANDLE InHandle, EAsyncIOPriorityAndFlags InPriorityAndFlags)
+	FWindowsReadRequest(FWindowsAsyncReadFileHandle* InOwner, FAsyncFileCallBack* CompleteCallback, uint8* InUserSuppliedMemory, int64 InOffset, int64 InBytesToRead, int64 InFileSize, HANDLE InHandle, EAsyncIOPriorityAndFlags InPriorityAndFlags, bool bInUsesCompletionPort, bool bUnbuffered)
 		: IAsyncReadRequest(CompleteCallback, false, InUserSuppliedMemory)
 		, Task(nullptr)
 		, Owner(InOwner)
@@ -74,9 +136,13 @@ public:
 		, FileHandle(InHandle)
 		, PriorityAndFlags(InPriorityAndFlags)
 		, TempMemory(nullptr)
+		, CompletionEvent(nullptr)
+		, bCompletionPortDone(true)
+		, bUsesCompletionPort(bInUsesCompletionPort)
 	{
 		FMemory::Memzero(OverlappedIO);
 		OverlappedIO.hEvent = INVALID_HANDLE_VALUE;
+		OverlappedIO.Request = this;
 		check(Offset >= 0 && BytesToRead > 0);
 		if (BytesToRead == MAX_int64)
 		{
@@ -95,8 +161,10 @@ public:
 			AlignedBytesToRead = Align(Offset + BytesToRead, 4096) - AlignedOffset;
 			check(AlignedOffset >= 0 && AlignedBytesToRead > 0);
 
+			// Unbuffered handles read straight into the destination, which has to be sector aligned too
+			const uint32 MemoryAlignment = bUnbuffered ? 4096 : DEFAULT_ALIGNMENT;
 			bool bMemoryHasBeenAcquired = bUserSuppliedMemory;
-			if (bUserSuppliedMemory && (AlignedOffset != Offset || AlignedBytesToRead != BytesToRead))
+			if (bUserSuppliedMemory && (AlignedOffset != Offset || AlignedBytesToRead != BytesToRead || !IsAligned(Memory, FMath::Max<uint32>(MemoryAlignment, 1))))
 			{
 				static int32 NumMessages = 0;
 				if (NumMessages < 10)
@@ -109,13 +177,13 @@ public:
 					NumMessages++;
 					UE_LOG(LogTemp, Log, TEXT("LAST NOTIFICATION THIS RUN: FWindowsReadRequest request was not aligned."));
 				}
-				TempMemory = (uint8*)FMemory::Malloc(AlignedBytesToRead);
+				TempMemory = (uint8*)FMemory::Malloc(AlignedBytesToRead, MemoryAlignment);
 				INC_MEMORY_STAT_BY(STAT_AsyncFileMemory, AlignedBytesToRead);
 			}
 			else if (!bMemoryHasBeenAcquired)
 			{
 				check(!Memory);
-				Memory = (uint8*)FMemory::Malloc(AlignedBytesToRead);
+				Memory = (uint8*)FMemory::Malloc(AlignedBytesToRead, MemoryAlignment);
 				INC_MEMORY_STAT_BY(STAT_AsyncFileMemory, AlignedBytesToRead);
 			}
 			check(Memory);
@@ -132,7 +200,17 @@ public:
 				OverlappedIO.Offset = LI.LowPart;
 				OverlappedIO.OffsetHigh = LI.HighPart;
 			}
-			OverlappedIO.hEvent = GetIOPooledEvent();
+			if (bUsesCompletionPort)
+			{
+				// The completion is posted to the port even if the read finishes right away, no event is needed
+				OverlappedIO.hEvent = nullptr;
+				CompletionEvent = FPlatformProcess::GetSynchEventFromPool(true);
+				bCompletionPortDone = false;
+			}
+			else
+			{
+				OverlappedIO.hEvent = GetIOPooledEvent();
+			}
 			TRACE_PLATFORMFILE_BEGIN_READ(&OverlappedIO, FileHandle, AlignedOffset, AlignedBytesToRead);
 			if (!ReadFile(FileHandle, TempMemory ? TempMemory : Memory, AlignedBytesToRead, (LPDWORD)&NumRead, &OverlappedIO))
 			{
@@ -143,8 +221,11 @@ public:
 				}
 			}
 
-			Task = new FAsyncTask<FWindowsReadRequestWorker>(this);
-			Start();
+			if (!bUsesCompletionPort)
+			{
+				Task = new FAsyncTask<FWindowsReadRequestWorker>(this);
+				Start();
+			}
 		}
 	}
 	virtual ~FWindowsReadRequest();
@@ -152,42 +233,70 @@ public:
 	bool CheckForPrecache();
 	const TCHAR* GetFileNameForErrorMessagesAndPanicRetry();
 
-	void PerformRequest()
+	/** Checks the result of the overlapped read, setting FailedMessage if it has to be retried */
+	void CheckReadResult(bool bSucceeded, uint32 BytesRead, uint32 ErrorCode)
 	{
-
-#if 0
-		if (!HasOverlappedIoCompleted(&OverlappedIO))
-		{
-			WaitForSingleObject(OverlappedIO.hEvent, 0);
-		}
-#endif
-		check(AlignedOffset <= Offset);
-		uint32 BytesRead = 0;
-
-		bool bFailed = false;
-		FString FailedMessage;
-
 		extern bool GTriggerFailedWindowsRead;
 
-		if (GTriggerFailedWindowsRead || !GetOverlappedResult(FileHandle, &OverlappedIO, (LPDWORD)&BytesRead, TRUE))
+		if (GTriggerFailedWindowsRead || !bSucceeded)
 		{
 			TRACE_PLATFORMFILE_END_READ(&OverlappedIO, 0);
 			GTriggerFailedWindowsRead = false;
-			uint32 ErrorCode = GetLastError();
 			FailedMessage = FString::Printf(TEXT("FWindowsReadRequest GetOverlappedResult Code = %x Offset = %lld Size = %lld FileSize = %lld File = %s"), ErrorCode, AlignedOffset, AlignedBytesToRead, FileSize, GetFileNameForErrorMessagesAndPanicRetry());
-			bFailed = true;
+			return;
+		}
+		TRACE_PLATFORMFILE_END_READ(&OverlappedIO, BytesRead);
+		if (int64(BytesRead) < BytesToRead + (Offset - AlignedOffset))
+		{
+			FailedMessage = FString::Printf(TEXT("FWindowsReadRequest Short Read Code = %x BytesRead = %lld Offset = %lld AlignedOffset = %lld BytesToRead = %lld Size = %lld File = %s"), ErrorCode, int64(BytesRead), Offset, AlignedOffset, BytesToRead, FileSize, GetFileNameForErrorMessagesAndPanicRetry());
+		}
+	}
+
+	/** Called on the completion port thread when the read finished */
+	void OnReadCompleted(bool bSucceeded, uint32 BytesRead, uint32 ErrorCode)
+	{
+		check(bUsesCompletionPort);
+		if (bCanceled && !bSucceeded && ErrorCode == ERROR_OPERATION_ABORTED)
+		{
+			TRACE_PLATFORMFILE_END_READ(&OverlappedIO, 0);
+			SetComplete();
+			FinishFromCompletionPort();
+			return;
+		}
+
+		CheckReadResult(bSucceeded, BytesRead, ErrorCode);
+		if (FailedMessage.IsEmpty())
+		{
+			FinalizeReadAndSetComplete();
+			FinishFromCompletionPort();
 		}
 		else
 		{
-			TRACE_PLATFORMFILE_END_READ(&OverlappedIO, BytesRead);
+			// Retries block and sleep, keep them off the completion port thread
+			Task = new FAsyncTask<FWindowsReadRequestWorker>(this);
+			Task->StartBackgroundTask(GIOThreadPool);
 		}
-		if (!bFailed && int64(BytesRead) < BytesToRead + (Offset - AlignedOffset))
+	}
+
+	void FinishFromCompletionPort()
+	{
+		CompletionEvent->Trigger();
+		FPlatformMisc::MemoryBarrier();
+		bCompletionPortDone = true;
+	}
+
+	void PerformRequest()
+	{
+		check(AlignedOffset <= Offset);
+		uint32 BytesRead = 0;
+
+		if (!bUsesCompletionPort)
 		{
-			uint32 ErrorCode = GetLastError();
-			FailedMessage = FString::Printf(TEXT("FWindowsReadRequest Short Read Code = %x BytesRead = %lld Offset = %lld AlignedOffset = %lld BytesToRead = %lld Size = %lld File = %s"), ErrorCode, int64(BytesRead), Offset, AlignedOffset, BytesToRead, FileSize, GetFileNameForErrorMessagesAndPanicRetry());
-			bFailed = true;
+			const bool bSucceeded = !!GetOverlappedResult(FileHandle, &OverlappedIO, (LPDWORD)&BytesRead, TRUE);
+			CheckReadResult(bSucceeded, BytesRead, bSucceeded ? 0 : GetLastError());
 		}
 
+		bool bFailed = !FailedMessage.IsEmpty();
 		if (bFailed)
 		{
 			UE_LOG(LogTemp, Error, TEXT("Bad read, retrying %s"), *FailedMessage);
@@ -249,6 +358,10 @@ public:
 		}
 
 		FinalizeReadAndSetComplete();
+		if (bUsesCompletionPort)
+		{
+			FinishFromCompletionPort();
+		}
 	}
 
 	void FinalizeReadAndSetComplete()
@@ -300,6 +413,14 @@ public:
 
 	virtual void WaitCompletionImpl(float TimeLimitSeconds) override
 	{
+		if (bUsesCompletionPort)
+		{
+			if (CompletionEvent)
+			{
+				CompletionEvent->Wait(TimeLimitSeconds <= 0.0f ? MAX_uint32 : FMath::Max<uint32>(uint32(TimeLimitSeconds * 1000.0f), 1));
+			}
+			return;
+		}
 		if (Task)
 		{
 			bool bResult;
@@ -322,7 +443,11 @@ public:
 	}
 	virtual void CancelImpl() override
 	{
-		// no cancel support
+		// Only reads completed by the port can be cancelled, the others are waited on by a task
+		if (bUsesCompletionPort && !bCompletionPortDone)
+		{
+			CancelIoEx(FileHandle, &OverlappedIO);
+		}
 	}
 
 };
@@ -332,6 +457,24 @@ void FWindowsReadRequestWorker::DoWork()
 	ReadRequest.PerformRequest();
 }
 
+uint32 FWindowsIOCompletionPort::Run()
+{
+	for (;;)
+	{
+		DWORD BytesRead = 0;
+		ULONG_PTR CompletionKey = 0;
+		OVERLAPPED* Overlapped = nullptr;
+		const bool bSucceeded = !!GetQueuedCompletionStatus(Port, &BytesRead, &CompletionKey, &Overlapped, INFINITE);
+		if (!Overlapped)
+		{
+			// Either Stop was called or the port was closed
+			break;
+		}
+		static_cast<FWindowsOverlappedRead*>(Overlapped)->Request->OnReadCompleted(bSucceeded, BytesRead, bSucceeded ? 0 : GetLastError());
+	}
+	return 0;
+}
+
 class FWindowsSizeRequest : public IAsyncReadRequest
 {
 public:
@@ -382,6 +525,10 @@ public:
 	HANDLE FileHandle;
 	int64 FileSize;
 	FString FileNameForErrorMessagesAndPanicRetry;
+	/** Reads complete on FWindowsIOCompletionPort instead of GIOThreadPool */
+	bool bUsesCompletionPort;
+	/** The handle was opened with FILE_FLAG_NO_BUFFERING */
+	bool bUnbuffered;
 private:
 	TArray<FWindowsReadRequest*> LiveRequests; // linear searches could be improved
 
@@ -389,16 +536,21 @@ private:
 	FCriticalSection HandleCacheCritical;
 public:
 
-	FWindowsAsyncReadFileHandle(HANDLE InFileHandle, const TCHAR* InFileNameForErrorMessagesAndPanicRetry)
+	FWindowsAsyncReadFileHandle(HANDLE InFileHandle, const TCHAR* InFileNameForErrorMessagesAndPanicRetry, bool bInUnbuffered = false)
 		: FileHandle(InFileHandle)
 		, FileSize(-1)
 		, FileNameForErrorMessagesAndPanicRetry(InFileNameForErrorMessagesAndPanicRetry)
+		, bUsesCompletionPort(false)
+		, bUnbuffered(bInUnbuffered)
 	{
 		if (FileHandle != INVALID_HANDLE_VALUE)
 		{
 			LARGE_INTEGER LI;
 			GetFileSizeEx(FileHandle, &LI);
 			FileSize = LI.QuadPart;
+
+			FWindowsIOCompletionPort* CompletionPort = FWindowsIOCompletionPort::Get();
+			bUsesCompletionPort = CompletionPort && CompletionPort->Associate(FileHandle);
 		}
 	}
 	~FWindowsAsyncReadFileHandle()
@@ -438,7 +590,7 @@ public:
 	{
 		if (FileHandle != INVALID_HANDLE_VALUE)
 		{
-			FWindowsReadRequest* Result = new FWindowsReadRequest(this, CompleteCallback, UserSuppliedMemory, Offset, BytesToRead, FileSize, FileHandle, PriorityAndFlags);
+			FWindowsReadRequest* Result = new FWindowsReadRequest(this, CompleteCallback, UserSuppliedMemory, Offset, BytesToRead, FileSize, FileHandle, PriorityAndFlags, bUsesCompletionPort, bUnbuffered);
 			if (PriorityAndFlags & AIOP_FLAG_PRECACHE) // only precache requests are tracked for possible reuse
 			{
 				FScopeLock Lock(&LiveRequestsCritical);
@@ -452,12 +604,22 @@ public:
 
 FWindowsReadRequest::~FWindowsReadRequest()
 {
+	// The completion port thread triggers the event after the request is complete, wait for it to let go of the request
+	while (!bCompletionPortDone)
+	{
+		FPlatformProcess::SleepNoStats(0.0f);
+	}
+	if (CompletionEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+		CompletionEvent = nullptr;
+	}
 	if (Task)
 	{
 		Task->EnsureCompletion(); // if the user polls, then we might never actual sync completion of the task until now, this will almost always be done, however we need to be sure the task is clear
 		delete Task;
 	}
-	if (OverlappedIO.hEvent != INVALID_HANDLE_VALUE)
+	if (OverlappedIO.hEvent != INVALID_HANDLE_VALUE && OverlappedIO.hEvent != nullptr)
 	{
 		FreeIOPooledEvent(OverlappedIO.hEvent);
 		OverlappedIO.hEvent = INVALID_HANDLE_VALUE;
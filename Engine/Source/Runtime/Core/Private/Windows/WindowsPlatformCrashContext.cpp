@@ -2,6 +2,7 @@
 
 #include "Windows/WindowsPlatformCrashContext.h"
 #include "HAL/PlatformMallocCrash.h"
+#include "HAL/MallocGuardedSamplingProxy.h"
 #include "HAL/ExceptionHandling.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/EngineBuildSettings.h"
@@ -912,6 +913,15 @@ void CreateExceptionInfoString(EXCEPTION_RECORD* ExceptionRecord)
 			ErrorString += TEXT("writing address ");
 		}
 		ErrorString += FString::Printf(TEXT("0x%08x"), (uint32)ExceptionRecord->ExceptionInformation[1]);
+		{
+			// faults on the pages of the guarded sampling proxy are memory errors it can tell more about
+			FString GuardedDescription;
+			if (FMallocGuardedSamplingProxy::DescribeAddress((const void*)ExceptionRecord->ExceptionInformation[1], GuardedDescription))
+			{
+				ErrorString += TEXT("\n");
+				ErrorString += GuardedDescription;
+			}
+		}
 		break;
 	HANDLE_CASE(EXCEPTION_ARRAY_BOUNDS_EXCEEDED)
 	HANDLE_CASE(EXCEPTION_DATATYPE_MISALIGNMENT)
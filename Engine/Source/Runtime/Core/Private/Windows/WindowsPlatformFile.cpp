@@ -30,6 +30,15 @@
 TLockFreePointerListUnordered<void, PLATFORM_CACHE_LINE_SIZE> WindowsAsyncIOEventPool;
 bool GTriggerFailedWindowsRead = false;
 
+static int32 GWindowsUnbufferedAsyncReads = 0;
+static FAutoConsoleVariableRef CVarWindowsUnbufferedAsyncReads(
+	TEXT("s.WindowsUnbufferedAsyncReads"),
+	GWindowsUnbufferedAsyncReads,
+	TEXT("If > 0, files opened for async reads bypass the system file cache (FILE_FLAG_NO_BUFFERING), reading straight into sector aligned buffers.\n")
+	TEXT("Only affects files opened after it is changed. Faster for large streaming reads that are not read again, slower for small loose files."),
+	ECVF_Default
+);
+
 #if !UE_BUILD_SHIPPING
 static void TriggerFailedWindowsRead(const TArray<FString>& Args)
 {
@@ -731,20 +740,36 @@ public:
 		TRACE_PLATFORMFILE_END_CLOSE();
 	}
 	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64, bool bPreloadHint = false) override
+	{
+		return MapRegionWithAccess(Offset, BytesToMap, FILE_MAP_READ);
+	}
+
+	virtual IMappedFileRegion* MapRegionCopyOnWrite(int64 Offset = 0, int64 BytesToMap = MAX_int64) override
+	{
+		// Copy-on-write views are allowed on read only mappings
+		return MapRegionWithAccess(Offset, BytesToMap, FILE_MAP_COPY);
+	}
+
+	void UnMap(FMappedFileRegionWindows* Region)
+	{
+		check(NumOutstandingRegions > 0);
+		NumOutstandingRegions--;
+	}
+
+private:
+	IMappedFileRegion* MapRegionWithAccess(int64 Offset, int64 BytesToMap, DWORD OpenMappingAccess)
 	{
 		check(Offset < GetFileSize()); // don't map zero bytes and don't map off the end of the file
 		BytesToMap = FMath::Min<int64>(BytesToMap, GetFileSize() - Offset);
 		check(BytesToMap > 0); // don't map zero bytes
 
-		DWORD OpenMappingAccess = FILE_MAP_READ;
-
 		int64 AlignedOffset = AlignDown(Offset, 65536);
 		int64 AlignedSize = Align(BytesToMap + Offset - AlignedOffset, 65536);
 
 		ULARGE_INTEGER LI;
 		LI.QuadPart = AlignedOffset;
 
-		const uint8* AlignedMapPtr = (const uint8*)MapViewOfFile(MappingHandle, FILE_MAP_READ, LI.HighPart, LI.LowPart, AlignedSize + AlignedOffset > GetFileSize() ? 0 : AlignedSize);
+		const uint8* AlignedMapPtr = (const uint8*)MapViewOfFile(MappingHandle, OpenMappingAccess, LI.HighPart, LI.LowPart, AlignedSize + AlignedOffset > GetFileSize() ? 0 : AlignedSize);
 		if (!AlignedMapPtr)
 		{
 			return nullptr;
@@ -754,12 +779,6 @@ public:
 		NumOutstandingRegions++;
 		return Result;
 	}
-
-	void UnMap(FMappedFileRegionWindows* Region)
-	{
-		check(NumOutstandingRegions > 0);
-		NumOutstandingRegions--;
-	}
 };
 
 FMappedFileRegionWindows::~FMappedFileRegionWindows()
@@ -881,6 +900,38 @@ public:
 		return !!SetFileAttributesW(*WindowsNormalizedFilename(Filename), bNewReadOnlyValue ? FILE_ATTRIBUTE_READONLY : FILE_ATTRIBUTE_NORMAL);
 	}
 
+	virtual bool CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags = EPlatformFileRead::None, EPlatformFileWrite WriteFlags = EPlatformFileWrite::None) override
+	{
+		// Files this large would evict everything else from the system cache, and are rarely read back right away
+		const int64 UnbufferedCopySize = 64 * 1024 * 1024;
+
+		const FString NormalizedTo = WindowsNormalizedFilename(To);
+		const FString NormalizedFrom = WindowsNormalizedFilename(From);
+		WIN32_FILE_ATTRIBUTE_DATA Info;
+		if (GetFileAttributesExW(*NormalizedFrom, GetFileExInfoStandard, &Info) && !(Info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		{
+			LARGE_INTEGER FileSize;
+			FileSize.HighPart = Info.nFileSizeHigh;
+			FileSize.LowPart = Info.nFileSizeLow;
+
+			// CopyFileEx offloads the copy to the storage when it can, SMB server side copies and ReFS block cloning included
+			const DWORD CopyFlags = FileSize.QuadPart >= UnbufferedCopySize ? COPY_FILE_NO_BUFFERING : 0;
+			if (CopyFileExW(*NormalizedFrom, *NormalizedTo, nullptr, nullptr, nullptr, CopyFlags))
+			{
+				// Same result as the generic copy: a writable file, modified now
+				const DWORD Attributes = GetFileAttributesW(*NormalizedTo);
+				if (Attributes != INVALID_FILE_ATTRIBUTES && (Attributes & FILE_ATTRIBUTE_READONLY))
+				{
+					SetFileAttributesW(*NormalizedTo, Attributes & ~FILE_ATTRIBUTE_READONLY);
+				}
+				SetTimeStamp(To, FDateTime::UtcNow());
+				return true;
+			}
+		}
+		// Source opened for write by someone else or the like, let the generic copy deal with it
+		return IPhysicalPlatformFile::CopyFile(To, From, ReadFlags, WriteFlags);
+	}
+
 	virtual FDateTime GetTimeStamp(const TCHAR* Filename) override
 	{
 		WIN32_FILE_ATTRIBUTE_DATA Info;
@@ -962,21 +1013,24 @@ public:
 		return NormalizedFileName;
 	}
 
-#define USE_WINDOWS_ASYNC_IMPL 0
+#ifndef USE_WINDOWS_ASYNC_IMPL
+	#define USE_WINDOWS_ASYNC_IMPL (!IS_PROGRAM && !WITH_EDITOR)
+#endif
 #if USE_WINDOWS_ASYNC_IMPL
 	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename) override
 	{
 		uint32  Access = GENERIC_READ;
 		uint32  WinFlags = FILE_SHARE_READ;
 		uint32  Create = OPEN_EXISTING;
+		const bool bUnbuffered = GWindowsUnbufferedAsyncReads != 0;
 
 
 		FString NormalizedFilename = WindowsNormalizedFilename(Filename);
 		TRACE_PLATFORMFILE_BEGIN_OPEN(Filename);
-		HANDLE Handle = CreateFileW(*NormalizedFilename, Access, WinFlags, NULL, Create, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
+		HANDLE Handle = CreateFileW(*NormalizedFilename, Access, WinFlags, NULL, Create, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | (bUnbuffered ? FILE_FLAG_NO_BUFFERING : 0), NULL);
 		TRACE_PLATFORMFILE_END_OPEN(Handle);
 		// we can't really fail here because this is intended to be an async open
-		return new FWindowsAsyncReadFileHandle(Handle, *NormalizedFilename);
+		return new FWindowsAsyncReadFileHandle(Handle, *NormalizedFilename, bUnbuffered);
 
 	}
 #endif
@@ -1168,7 +1222,8 @@ public:
 		bool Result = false;
 		WIN32_FIND_DATAW Data;
 		FString SearchWildcard = FString(Directory) / TEXT("*.*");
-		HANDLE Handle = FindFirstFileW(*(WindowsNormalizedDirname(*SearchWildcard)), &Data);
+		// Basic info skips looking up the short names, and the large fetch gets the entries from the file system in bigger batches
+		HANDLE Handle = FindFirstFileExW(*(WindowsNormalizedDirname(*SearchWildcard)), FindExInfoBasic, &Data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
 		if (Handle != INVALID_HANDLE_VALUE)
 		{
 			Result = true;
@@ -1729,6 +1729,45 @@ int32 FWindowsPlatformMisc::NumberOfCoresIncludingHyperthreads()
 	return CoreCount;
 }
 
+const FCPUTopology& FWindowsPlatformMisc::GetCPUTopology()
+{
+	static FCPUTopology Topology = []()
+	{
+		FCPUTopology Result;
+		::DWORD BufferSize = 0;
+		if (!GetLogicalProcessorInformationEx(RelationAll, nullptr, &BufferSize) && GetLastError() == ERROR_INSUFFICIENT_BUFFER && BufferSize > 0)
+		{
+			uint8* Buffer = (uint8*)FMemory::Malloc(BufferSize);
+			if (GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)Buffer, &BufferSize))
+			{
+				// Affinity masks only reach the first processor group
+				for (uint8* Entry = Buffer; Entry < Buffer + BufferSize; Entry += ((PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)Entry)->Size)
+				{
+					PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX Info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)Entry;
+					if (Info->Relationship == RelationProcessorCore && Info->Processor.GroupMask[0].Group == 0 && Info->Processor.GroupMask[0].Mask && Result.NumCores < FCPUTopology::MaxCores)
+					{
+						Result.CoreMasks[Result.NumCores] = (uint64)Info->Processor.GroupMask[0].Mask;
+						Result.CorePerformanceClasses[Result.NumCores] = Info->Processor.EfficiencyClass;
+						++Result.NumCores;
+					}
+					else if (Info->Relationship == RelationCache && Info->Cache.Level == 3 && Info->Cache.GroupMask.Group == 0 && Info->Cache.GroupMask.Mask && Result.NumCacheDomains < FCPUTopology::MaxCores)
+					{
+						Result.CacheDomainMasks[Result.NumCacheDomains++] = (uint64)Info->Cache.GroupMask.Mask;
+					}
+				}
+			}
+			FMemory::Free(Buffer);
+		}
+		if (Result.NumCores == 0)
+		{
+			return FGenericPlatformMisc::GetCPUTopology();
+		}
+		Result.Finalize();
+		return Result;
+	}();
+	return Topology;
+}
+
 const TCHAR* FWindowsPlatformMisc::GetPlatformFeaturesModuleName()
 {
 	bool bModuleExists = FModuleManager::Get().ModuleExists(TEXT("WindowsPlatformFeatures"));
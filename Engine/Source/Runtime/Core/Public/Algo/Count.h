@@ -3,17 +3,14 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Algo/Impl/VectorizedFind.h"
+#include "Templates/IntegralConstant.h"
+#include "Templates/Invoke.h"
 
-namespace Algo
+namespace AlgoImpl
 {
-	/**
-	 * Counts elements of a range that equal the supplied value
-	 *
-	 * @param  Input    Any iterable type
-	 * @param  InValue  Value to compare against
-	 */
 	template <typename InT, typename ValueT>
-	FORCEINLINE SIZE_T Count(const InT& Input, const ValueT& InValue)
+	FORCEINLINE SIZE_T CountValueInRange(const InT& Input, const ValueT& InValue, TIntegralConstant<bool, false>)
 	{
 		SIZE_T Result = 0;
 		for (const auto& Value : Input)
@@ -26,6 +23,28 @@ namespace Algo
 		return Result;
 	}
 
+	template <typename InT, typename ValueT>
+	FORCEINLINE SIZE_T CountValueInRange(const InT& Input, const ValueT& InValue, TIntegralConstant<bool, true>)
+	{
+		return AlgoImpl::CountValue(GetData(Input), GetNum(Input), InValue);
+	}
+}
+
+namespace Algo
+{
+	/**
+	 * Counts elements of a range that equal the supplied value
+	 *
+	 * @param  Input    Any iterable type
+	 * @param  InValue  Value to compare against
+	 */
+	template <typename InT, typename ValueT>
+	FORCEINLINE SIZE_T Count(const InT& Input, const ValueT& InValue)
+	{
+		// Contiguous ranges of integers, enums and pointers are counted with vector compares
+		return AlgoImpl::CountValueInRange(Input, InValue, TIntegralConstant<bool, AlgoImpl::TIsVectorizedFindRange<const InT&, ValueT>::Value>());
+	}
+
 	/**
 	 * Counts elements of a range that match a given predicate
 	 *
@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "HAL/PlatformMisc.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/IdentityFunctor.h"
+#include "Templates/Invoke.h"
+#include "Templates/Less.h"
+#include "Templates/UnrealTemplate.h"
+
+namespace AlgoImpl
+{
+	/** Moves the sorted elements from SortedIndex on into the subtree rooted at node K of the Eytzinger layout, in order */
+	template <typename ElementType>
+	uint64 EytzingerFill(ElementType* Sorted, ElementType* Out, uint64 Num, uint64 SortedIndex, uint64 K)
+	{
+		if (K <= Num)
+		{
+			SortedIndex = EytzingerFill(Sorted, Out, Num, SortedIndex, 2 * K);
+			Out[K - 1] = MoveTemp(Sorted[SortedIndex++]);
+			SortedIndex = EytzingerFill(Sorted, Out, Num, SortedIndex, 2 * K + 1);
+		}
+		return SortedIndex;
+	}
+
+	/**
+	 * Finds the first element >= Value in a range in the Eytzinger layout
+	 *
+	 * @param First Pointer to array
+	 * @param Num Number of elements in array
+	 * @param Value Value to look for
+	 * @param Projection Called on values in array to get type that can be compared to Value
+	 * @param SortPredicate Predicate for sort comparison
+	 *
+	 * @returns Position of the first element >= Value, may be == Num
+	 */
+	template <typename RangeValueType, typename SizeType, typename PredicateValueType, typename ProjectionType, typename SortPredicateType>
+	FORCEINLINE SizeType EytzingerLowerBoundInternal(RangeValueType* First, const SizeType Num, const PredicateValueType& Value, ProjectionType Projection, SortPredicateType SortPredicate)
+	{
+		// The descendants of node K that are this many levels down are next to each other from node K * PrefetchStride,
+		// fetching them while comparing hides the cache misses of the next levels
+		const uint64 PrefetchStride = FMath::Max<uint64>(1, PLATFORM_CACHE_LINE_SIZE / sizeof(RangeValueType));
+		const uint64 Count = uint64(Num);
+
+		// Nodes are numbered from 1 so that the children of node K are 2K and 2K + 1
+		uint64 K = 1;
+		while (K <= Count)
+		{
+			FPlatformMisc::Prefetch(First + FMath::Min(K * PrefetchStride, Count) - 1);
+			K = 2 * K + (SortPredicate(Invoke(Projection, First[K - 1]), Value) ? 1 : 0);
+		}
+
+		// The bits of K are the path from the root, 1 going right past an element < Value. The lower bound is the
+		// last node the search went left from, found by dropping the trailing ones and the 0 before them.
+		K >>= FMath::CountTrailingZeros64(~K) + 1;
+		return K ? SizeType(K - 1) : Num;
+	}
+}
+
+namespace Algo
+{
+	/**
+	 * Rearranges a sorted range into the Eytzinger layout, where the children of the element at index I are at 2I + 1
+	 * and 2I + 2, like in a binary heap. Searching it with EytzingerLowerBound() reads the elements in the order they
+	 * are stored and prefetches the next levels, which is faster than a binary search of large sorted ranges.
+	 *
+	 * @param Range Range to rearrange, must be already sorted
+	 */
+	template <typename RangeType>
+	void EytzingerLayout(RangeType& Range)
+	{
+		auto* Data = GetData(Range);
+		const auto Num = GetNum(Range);
+		typedef typename TRemovePointer<decltype(Data)>::Type ElementType;
+
+		TArray<ElementType> Sorted;
+		Sorted.Reserve(Num);
+		for (decltype(GetNum(Range)) Index = 0; Index < Num; ++Index)
+		{
+			Sorted.Add(MoveTemp(Data[Index]));
+		}
+		AlgoImpl::EytzingerFill(Sorted.GetData(), Data, uint64(Num), 0, 1);
+	}
+
+	/**
+	 * Finds the first element >= Value in a range in the Eytzinger layout using predicate
+	 *
+	 * @param Range Range to search through, must be in the Eytzinger layout of a range sorted by SortPredicate
+	 * @param Value Value to look for
+	 * @param SortPredicate Predicate for sort comparison, defaults to <
+	 *
+	 * @returns Position of the first element >= Value, may be position after last element in range
+	 */
+	template <typename RangeType, typename ValueType, typename SortPredicateType>
+	FORCEINLINE auto EytzingerLowerBound(RangeType& Range, const ValueType& Value, SortPredicateType SortPredicate) -> decltype(GetNum(Range))
+	{
+		return AlgoImpl::EytzingerLowerBoundInternal(GetData(Range), GetNum(Range), Value, FIdentityFunctor(), SortPredicate);
+	}
+	template <typename RangeType, typename ValueType>
+	FORCEINLINE auto EytzingerLowerBound(RangeType& Range, const ValueType& Value) -> decltype(GetNum(Range))
+	{
+		return AlgoImpl::EytzingerLowerBoundInternal(GetData(Range), GetNum(Range), Value, FIdentityFunctor(), TLess<>());
+	}
+
+	/**
+	 * Finds the first element with projected value >= Value in a range in the Eytzinger layout using predicate
+	 *
+	 * @param Range Range to search through, must be in the Eytzinger layout of a range sorted by SortPredicate
+	 * @param Value Value to look for
+	 * @param Projection Functor or data member pointer, called via Invoke to compare to Value
+	 * @param SortPredicate Predicate for sort comparison, defaults to <
+	 *
+	 * @returns Position of the first element >= Value, may be position after last element in range
+	 */
+	template <typename RangeType, typename ValueType, typename ProjectionType, typename SortPredicateType>
+	FORCEINLINE auto EytzingerLowerBoundBy(RangeType& Range, const ValueType& Value, ProjectionType Projection, SortPredicateType SortPredicate) -> decltype(GetNum(Range))
+	{
+		return AlgoImpl::EytzingerLowerBoundInternal(GetData(Range), GetNum(Range), Value, Projection, SortPredicate);
+	}
+	template <typename RangeType, typename ValueType, typename ProjectionType>
+	FORCEINLINE auto EytzingerLowerBoundBy(RangeType& Range, const ValueType& Value, ProjectionType Projection) -> decltype(GetNum(Range))
+	{
+		return AlgoImpl::EytzingerLowerBoundInternal(GetData(Range), GetNum(Range), Value, Projection, TLess<>());
+	}
+
+	/**
+	 * Returns index to the first found element matching a value in a range in the Eytzinger layout
+	 *
+	 * @param Range The range to search, must be in the Eytzinger layout of a range sorted by SortPredicate
+	 * @param Value The value to search for
+	 * @param SortPredicate Predicate for sort comparison, defaults to <
+	 * @return Index of found element, or INDEX_NONE
+	 */
+	template <typename RangeType, typename ValueType, typename SortPredicateType>
+	FORCEINLINE auto EytzingerBinarySearch(RangeType& Range, const ValueType& Value, SortPredicateType SortPredicate) -> decltype(GetNum(Range))
+	{
+		auto CheckIndex = EytzingerLowerBound(Range, Value, SortPredicate);
+		if (CheckIndex < GetNum(Range))
+		{
+			auto&& CheckValue = GetData(Range)[CheckIndex];
+			// Since we returned lower bound we already know Value <= CheckValue. So if Value is not < CheckValue, they must be equal
+			if (!SortPredicate(Value, CheckValue))
+			{
+				return CheckIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+	template <typename RangeType, typename ValueType>
+	FORCEINLINE auto EytzingerBinarySearch(RangeType& Range, const ValueType& Value)
+	{
+		return EytzingerBinarySearch(Range, Value, TLess<>());
+	}
+
+	/**
+	 * Returns index to the first found element with projected value matching Value in a range in the Eytzinger layout
+	 *
+	 * @param Range The range to search, must be in the Eytzinger layout of a range sorted by SortPredicate
+	 * @param Value The value to search for
+	 * @param Projection Functor or data member pointer, called via Invoke to compare to Value
+	 * @param SortPredicate Predicate for sort comparison, defaults to <
+	 * @return Index of found element, or INDEX_NONE
+	 */
+	template <typename RangeType, typename ValueType, typename ProjectionType, typename SortPredicateType>
+	FORCEINLINE auto EytzingerBinarySearchBy(RangeType& Range, const ValueType& Value, ProjectionType Projection, SortPredicateType SortPredicate) -> decltype(GetNum(Range))
+	{
+		auto CheckIndex = EytzingerLowerBoundBy(Range, Value, Projection, SortPredicate);
+		if (CheckIndex < GetNum(Range))
+		{
+			auto&& CheckValue = Invoke(Projection, GetData(Range)[CheckIndex]);
+			// Since we returned lower bound we already know Value <= CheckValue. So if Value is not < CheckValue, they must be equal
+			if (!SortPredicate(Value, CheckValue))
+			{
+				return CheckIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+	template <typename RangeType, typename ValueType, typename ProjectionType>
+	FORCEINLINE auto EytzingerBinarySearchBy(RangeType& Range, const ValueType& Value, ProjectionType Projection)
+	{
+		return EytzingerBinarySearchBy(Range, Value, Projection, TLess<>());
+	}
+}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Algo/Impl/RangePointerType.h"
+#include "Algo/Impl/VectorizedFind.h"
+#include "Templates/IntegralConstant.h"
 #include "Templates/IdentityFunctor.h"
 #include "Templates/Invoke.h"
 #include "Templates/UnrealTemplate.h" // For MoveTemp
@@ -23,6 +25,20 @@ namespace AlgoImpl
 		return nullptr;
 	}
 
+	template <typename RangeType, typename ValueType>
+	FORCEINLINE auto FindValueInRange(RangeType&& Range, const ValueType& Value, TIntegralConstant<bool, false>)
+		-> decltype(AlgoImpl::FindBy(Forward<RangeType>(Range), Value, FIdentityFunctor()))
+	{
+		return AlgoImpl::FindBy(Forward<RangeType>(Range), Value, FIdentityFunctor());
+	}
+
+	template <typename RangeType, typename ValueType>
+	FORCEINLINE auto FindValueInRange(RangeType&& Range, const ValueType& Value, TIntegralConstant<bool, true>)
+		-> decltype(GetData(Range))
+	{
+		return const_cast<decltype(GetData(Range))>(AlgoImpl::FindValue(GetData(Range), GetNum(Range), Value));
+	}
+
 	template <typename RangeType, typename PredicateType>
 	typename TRangePointerType<typename TRemoveReference<RangeType>::Type>::Type FindByPredicate(RangeType&& Range, PredicateType Pred)
 	{
@@ -52,7 +68,8 @@ namespace Algo
 	FORCEINLINE auto Find(RangeType&& Range, const ValueType& Value)
 		-> decltype(AlgoImpl::FindBy(Forward<RangeType>(Range), Value, FIdentityFunctor()))
 	{
-		return AlgoImpl::FindBy(Forward<RangeType>(Range), Value, FIdentityFunctor());
+		// Contiguous ranges of integers, enums and pointers are scanned with vector compares
+		return AlgoImpl::FindValueInRange(Forward<RangeType>(Range), Value, TIntegralConstant<bool, AlgoImpl::TIsVectorizedFindRange<RangeType, ValueType>::Value>());
 	}
 
 	/**
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Algo/Impl/RangePointerType.h"
+#include "Algo/Impl/VectorizedFind.h"
+#include "Templates/IntegralConstant.h"
 
 namespace AlgoImpl
 {
@@ -29,6 +31,38 @@ namespace AlgoImpl
 			}
 		}
 	}
+
+	template<typename WhereType, typename WhatType>
+	FORCEINLINE WhereType* FindSequence(WhereType* First, WhereType* Last, WhatType* WhatFirst, WhatType* WhatLast, TIntegralConstant<bool, false>)
+	{
+		return AlgoImpl::FindSequence(First, Last, WhatFirst, WhatLast);
+	}
+
+	/** Same as FindSequence for element types compared by their bytes, using a vectorized scan for the first element of the sequence */
+	template<typename WhereType, typename WhatType>
+	WhereType* FindSequence(WhereType* First, WhereType* Last, WhatType* WhatFirst, WhatType* WhatLast, TIntegralConstant<bool, true>)
+	{
+		const SIZE_T NumWhat = SIZE_T(WhatLast - WhatFirst);
+		if (NumWhat == 0)
+		{
+			return First;
+		}
+
+		while (SIZE_T(Last - First) >= NumWhat)
+		{
+			const WhereType* Candidate = AlgoImpl::FindValue<typename TRemoveCV<WhereType>::Type>(First, SIZE_T(Last - First) - NumWhat + 1, *WhatFirst);
+			if (!Candidate)
+			{
+				return nullptr;
+			}
+			if (FMemory::Memcmp(Candidate + 1, WhatFirst + 1, (NumWhat - 1) * sizeof(WhereType)) == 0)
+			{
+				return const_cast<WhereType*>(Candidate);
+			}
+			First = const_cast<WhereType*>(Candidate) + 1;
+		}
+		return nullptr;
+	}
 }
 
 namespace Algo
@@ -52,9 +86,11 @@ namespace Algo
 		}
 		else
 		{
+			typedef typename TRemoveCV<typename TRemovePointer<decltype(GetData(What))>::Type>::Type FWhatElement;
 			return AlgoImpl::FindSequence(
 				GetData(Where), GetData(Where) + GetNum(Where),
-				GetData(What), GetData(What) + GetNum(What));
+				GetData(What), GetData(What) + GetNum(What),
+				TIntegralConstant<bool, AlgoImpl::TIsVectorizedFindRange<const RangeWhereType&, FWhatElement>::Value>());
 		}
 	}
 
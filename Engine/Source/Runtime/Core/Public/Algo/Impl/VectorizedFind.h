@@ -0,0 +1,335 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/PlatformMath.h"
+#include "HAL/UnrealMemory.h"
+#include "Templates/AreTypesEqual.h"
+#include "Templates/EnableIf.h"
+#include "Templates/IsEnum.h"
+#include "Templates/IsIntegral.h"
+#include "Templates/IsPointer.h"
+#include "Templates/RemoveCV.h"
+#include "Templates/UnrealTemplate.h" // For GetData, DeclVal
+#include "Traits/IsContiguousContainer.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_VECTORIZED_FIND_SSE2 1
+	#define UE_VECTORIZED_FIND_NEON 0
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#define UE_VECTORIZED_FIND_SSE2 0
+	#define UE_VECTORIZED_FIND_NEON 1
+	#include <arm_neon.h>
+#else
+	#define UE_VECTORIZED_FIND_SSE2 0
+	#define UE_VECTORIZED_FIND_NEON 0
+#endif
+
+#define UE_VECTORIZED_FIND (UE_VECTORIZED_FIND_SSE2 || UE_VECTORIZED_FIND_NEON)
+
+namespace AlgoImpl
+{
+	/**
+	 * Element types whose operator== is the same as comparing their bytes, which can be searched 16 bytes at a time.
+	 * Floating point types are excluded as -0 equals 0 and NaN doesn't equal itself.
+	 */
+	template <typename T>
+	struct TIsVectorizedFindType
+	{
+		typedef typename TRemoveCV<T>::Type FUnqualified;
+
+		enum
+		{
+			Value = (TIsIntegral<FUnqualified>::Value || TIsEnum<FUnqualified>::Value || TIsPointer<FUnqualified>::Value) &&
+				(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+		};
+	};
+
+	/** Whether searching a range for a ValueType can go through FindValue and CountValue, which needs contiguous elements of the same type */
+	template <typename RangeType, typename ValueType, bool bIsContiguous = TIsContiguousContainer<RangeType>::Value>
+	struct TIsVectorizedFindRange
+	{
+		enum { Value = false };
+	};
+
+	template <typename RangeType, typename ValueType>
+	struct TIsVectorizedFindRange<RangeType, ValueType, true>
+	{
+		typedef typename TRemoveCV<typename TRemovePointer<decltype(GetData(DeclVal<RangeType&>()))>::Type>::Type FElement;
+
+		enum { Value = TIsVectorizedFindType<FElement>::Value && TAreTypesEqual<FElement, typename TRemoveCV<ValueType>::Type>::Value };
+	};
+
+#if UE_VECTORIZED_FIND
+	namespace VectorizedFind
+	{
+		enum { VectorSize = 16 };
+
+#if UE_VECTORIZED_FIND_SSE2
+		typedef __m128i FVector;
+
+		/** Number of bits per byte of a vector in the masks returned by GetByteMask */
+		enum { MaskBitsPerByte = 1 };
+
+		FORCEINLINE FVector LoadUnaligned(const void* Ptr) { return _mm_loadu_si128((const __m128i*)Ptr); }
+		FORCEINLINE FVector LoadAligned(const void* Ptr) { return _mm_load_si128((const __m128i*)Ptr); }
+		FORCEINLINE FVector Or(FVector A, FVector B) { return _mm_or_si128(A, B); }
+		FORCEINLINE uint64 GetByteMask(FVector Equal) { return uint32(_mm_movemask_epi8(Equal)); }
+
+		template <uint32 ElementSize> struct TLanes;
+		template <> struct TLanes<1>
+		{
+			static FORCEINLINE FVector Splat(uint8 Value) { return _mm_set1_epi8(char(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return _mm_cmpeq_epi8(A, B); }
+		};
+		template <> struct TLanes<2>
+		{
+			static FORCEINLINE FVector Splat(uint16 Value) { return _mm_set1_epi16(short(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return _mm_cmpeq_epi16(A, B); }
+		};
+		template <> struct TLanes<4>
+		{
+			static FORCEINLINE FVector Splat(uint32 Value) { return _mm_set1_epi32(int(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return _mm_cmpeq_epi32(A, B); }
+		};
+		template <> struct TLanes<8>
+		{
+			static FORCEINLINE FVector Splat(uint64 Value) { return _mm_set_epi32(int(Value >> 32), int(Value), int(Value >> 32), int(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B)
+			{
+				// SSE2 has no 64 bit compare, both halves of a lane have to match
+				const FVector Halves = _mm_cmpeq_epi32(A, B);
+				return _mm_and_si128(Halves, _mm_shuffle_epi32(Halves, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		};
+#else
+		typedef uint8x16_t FVector;
+
+		/** Number of bits per byte of a vector in the masks returned by GetByteMask */
+		enum { MaskBitsPerByte = 4 };
+
+		FORCEINLINE FVector LoadUnaligned(const void* Ptr) { return vld1q_u8((const uint8*)Ptr); }
+		FORCEINLINE FVector LoadAligned(const void* Ptr) { return vld1q_u8((const uint8*)Ptr); }
+		FORCEINLINE FVector Or(FVector A, FVector B) { return vorrq_u8(A, B); }
+		FORCEINLINE uint64 GetByteMask(FVector Equal)
+		{
+			// Narrowing each 16 bit pair of bytes to 8 bits keeps a nibble per byte, NEON has no movemask
+			return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Equal), 4)), 0);
+		}
+
+		template <uint32 ElementSize> struct TLanes;
+		template <> struct TLanes<1>
+		{
+			static FORCEINLINE FVector Splat(uint8 Value) { return vdupq_n_u8(Value); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return vceqq_u8(A, B); }
+		};
+		template <> struct TLanes<2>
+		{
+			static FORCEINLINE FVector Splat(uint16 Value) { return vreinterpretq_u8_u16(vdupq_n_u16(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(A), vreinterpretq_u16_u8(B))); }
+		};
+		template <> struct TLanes<4>
+		{
+			static FORCEINLINE FVector Splat(uint32 Value) { return vreinterpretq_u8_u32(vdupq_n_u32(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B) { return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(A), vreinterpretq_u32_u8(B))); }
+		};
+		template <> struct TLanes<8>
+		{
+			static FORCEINLINE FVector Splat(uint64 Value) { return vreinterpretq_u8_u64(vdupq_n_u64(Value)); }
+			static FORCEINLINE FVector Equal(FVector A, FVector B)
+			{
+				// A 64 bit compare is only available on ARM64, both halves of a lane have to match
+				const uint32x4_t Halves = vceqq_u32(vreinterpretq_u32_u8(A), vreinterpretq_u32_u8(B));
+				return vreinterpretq_u8_u32(vandq_u32(Halves, vrev64q_u32(Halves)));
+			}
+		};
+#endif
+
+		template <uint32 ElementSize> struct TBits;
+		template <> struct TBits<1> { typedef uint8 Type; };
+		template <> struct TBits<2> { typedef uint16 Type; };
+		template <> struct TBits<4> { typedef uint32 Type; };
+		template <> struct TBits<8> { typedef uint64 Type; };
+
+		/** @return A vector with every lane holding Value */
+		template <typename T>
+		FORCEINLINE FVector Splat(const T& Value)
+		{
+			typename TBits<sizeof(T)>::Type Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(T));
+			return TLanes<sizeof(T)>::Splat(Bits);
+		}
+
+		/** @return The index of the first element marked in a non zero mask returned by GetByteMask */
+		template <typename T>
+		FORCEINLINE int32 GetFirstIndex(uint64 Mask)
+		{
+			return int32(FPlatformMath::CountTrailingZeros64(Mask) / (MaskBitsPerByte * sizeof(T)));
+		}
+	}
+#endif
+
+	/** @return A pointer to the first of the Num elements starting at First which equals Value, or nullptr if there is none. */
+	template <typename T>
+	typename TEnableIf<!TIsVectorizedFindType<T>::Value, const T*>::Type FindValue(const T* First, SIZE_T Num, const T& Value)
+	{
+		for (const T* Last = First + Num; First != Last; ++First)
+		{
+			if (*First == Value)
+			{
+				return First;
+			}
+		}
+		return nullptr;
+	}
+
+	template <typename T>
+	typename TEnableIf<TIsVectorizedFindType<T>::Value, const T*>::Type FindValue(const T* First, SIZE_T Num, const T& Value)
+	{
+		const T* Last = First + Num;
+#if UE_VECTORIZED_FIND
+		using namespace VectorizedFind;
+		constexpr SIZE_T NumPerVector = VectorSize / sizeof(T);
+		if (Num >= NumPerVector)
+		{
+			const FVector Pattern = Splat(Value);
+			for (; SIZE_T(Last - First) >= NumPerVector; First += NumPerVector)
+			{
+				if (const uint64 Mask = GetByteMask(TLanes<sizeof(T)>::Equal(LoadUnaligned(First), Pattern)))
+				{
+					return First + GetFirstIndex<T>(Mask);
+				}
+			}
+
+			// The last vector overlaps elements already checked, which can't match
+			if (First != Last)
+			{
+				const T* Tail = Last - NumPerVector;
+				if (const uint64 Mask = GetByteMask(TLanes<sizeof(T)>::Equal(LoadUnaligned(Tail), Pattern)))
+				{
+					return Tail + GetFirstIndex<T>(Mask);
+				}
+			}
+			return nullptr;
+		}
+#endif
+
+		for (; First != Last; ++First)
+		{
+			if (*First == Value)
+			{
+				return First;
+			}
+		}
+		return nullptr;
+	}
+
+	/** @return Whether any of the Num elements starting at First equals Value, which can be of another type than the elements. */
+	template <typename T, typename ValueType>
+	typename TEnableIf<!TAreTypesEqual<T, ValueType>::Value, bool>::Type ContainsValue(const T* First, SIZE_T Num, const ValueType& Value)
+	{
+		for (const T* Last = First + Num; First != Last; ++First)
+		{
+			if (*First == Value)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename T>
+	FORCEINLINE bool ContainsValue(const T* First, SIZE_T Num, const T& Value)
+	{
+		return FindValue(First, Num, Value) != nullptr;
+	}
+
+	/** @return The number of the Num elements starting at First which equal Value. */
+	template <typename T>
+	typename TEnableIf<!TIsVectorizedFindType<T>::Value, SIZE_T>::Type CountValue(const T* First, SIZE_T Num, const T& Value)
+	{
+		SIZE_T Result = 0;
+		for (const T* Last = First + Num; First != Last; ++First)
+		{
+			if (*First == Value)
+			{
+				++Result;
+			}
+		}
+		return Result;
+	}
+
+	template <typename T>
+	typename TEnableIf<TIsVectorizedFindType<T>::Value, SIZE_T>::Type CountValue(const T* First, SIZE_T Num, const T& Value)
+	{
+		const T* Last = First + Num;
+		SIZE_T Result = 0;
+#if UE_VECTORIZED_FIND
+		using namespace VectorizedFind;
+		constexpr SIZE_T NumPerVector = VectorSize / sizeof(T);
+		if (Num >= NumPerVector)
+		{
+			const FVector Pattern = Splat(Value);
+			for (; SIZE_T(Last - First) >= NumPerVector; First += NumPerVector)
+			{
+				Result += FPlatformMath::CountBits(GetByteMask(TLanes<sizeof(T)>::Equal(LoadUnaligned(First), Pattern)));
+			}
+			Result /= MaskBitsPerByte * sizeof(T);
+		}
+#endif
+
+		for (; First != Last; ++First)
+		{
+			if (*First == Value)
+			{
+				++Result;
+			}
+		}
+		return Result;
+	}
+
+	/**
+	 * Scans a null terminated string for a character.
+	 *
+	 * @return A pointer to the first occurrence of Char, or to the terminator if Char isn't in the string.
+	 */
+	template <typename CharType>
+	const CharType* FindCharOrTerminator(const CharType* String, CharType Char)
+	{
+		// Vectors are loaded from aligned addresses so they never cross into a page the string doesn't use, but they
+		// still read past the terminator, which the address sanitizer would report
+#if UE_VECTORIZED_FIND && !USING_ADDRESS_SANITISER
+		using namespace VectorizedFind;
+		constexpr SIZE_T NumPerVector = VectorSize / sizeof(CharType);
+		if ((UPTRINT(String) & (sizeof(CharType) - 1)) == 0)
+		{
+			for (; (UPTRINT(String) & (VectorSize - 1)) != 0; ++String)
+			{
+				if (*String == Char || *String == 0)
+				{
+					return String;
+				}
+			}
+
+			const FVector Pattern = Splat(Char);
+			const FVector Zero = Splat(CharType(0));
+			for (;; String += NumPerVector)
+			{
+				const FVector Chars = LoadAligned(String);
+				if (const uint64 Mask = GetByteMask(Or(TLanes<sizeof(CharType)>::Equal(Chars, Pattern), TLanes<sizeof(CharType)>::Equal(Chars, Zero))))
+				{
+					return String + GetFirstIndex<CharType>(Mask);
+				}
+			}
+		}
+#endif
+
+		while (*String != Char && *String != 0)
+		{
+			++String;
+		}
+		return String;
+	}
+}
@@ -3,24 +3,29 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/UnrealMathUtility.h"
 #include "Templates/Invoke.h"
+#include "Templates/IntegralConstant.h"
+#include "Templates/IsIntegral.h"
+#include "Templates/UnrealTypeTraits.h"
 
-
-namespace Algo
+namespace AlgoImpl
 {
-	/**
-	* LevenshteinDistance return the number of edit operation we need to transform RangeA to RangeB.
-	* Operation type are Add/Remove/substitution of range element. Base on Levenshtein algorithm.
-	*
-	* Range[A/B]Type: Support [] operator and the range element must be able to be compare with == operator
-	*                 Support GetNum() functionality
-	*
-	* @param RangeA			The first range of element
-	* @param RangeB			The second range of element
-	* @return				The number of operation to transform RangeA to RangeB
-	*/
+	/** Whether the elements of a range are small integers, like characters, that the bit-parallel distance can look up */
+	template <typename RangeType>
+	struct TIsBitParallelLevenshteinRange
+	{
+		typedef typename TDecay<decltype(*GetData(DeclVal<const RangeType&>()))>::Type ElementType;
+		enum { Value = TIsIntegral<ElementType>::Value && sizeof(ElementType) <= 4 };
+	};
+
+	/** The classic dynamic programming distance, for elements that can only be compared with == */
 	template <typename RangeAType, typename RangeBType>
-	int32 LevenshteinDistance(const RangeAType& RangeA, const RangeBType& RangeB)
+	int32 LevenshteinDistanceDP(const RangeAType& RangeA, const RangeBType& RangeB)
 	{
 		const int32 LenA = GetNum(RangeA);
 		const int32 LenB = GetNum(RangeB);
@@ -37,7 +42,7 @@ namespace Algo
 		auto DataA = GetData(RangeA);
 		auto DataB = GetData(RangeB);
 
-		TArray<int32> OperationCount;
+		TArray<int32, TInlineAllocator<64>> OperationCount;
 		//Initialize data
 		OperationCount.AddUninitialized(LenB + 1);
 		for (int32 IndexB = 0; IndexB <= LenB; ++IndexB)
@@ -63,4 +68,291 @@ namespace Algo
 		return OperationCount[LenB];
 	}
 
+	/**
+	 * The positions of the elements of a pattern as bit masks, one bit per element in words of 64 elements, which the
+	 * bit-parallel distance looks up for every element of the text it's compared to. Elements below 128 are looked up
+	 * directly, the others are searched among the sorted distinct elements of the pattern above 127.
+	 */
+	class FLevenshteinPattern
+	{
+	public:
+		template <typename RangeType>
+		explicit FLevenshteinPattern(const RangeType& Pattern)
+			: Len(GetNum(Pattern))
+			, NumWords(FMath::Max(1, (Len + 63) / 64))
+		{
+			auto Data = GetData(Pattern);
+			TableMasks.SetNumZeroed(NumTableElements * NumWords);
+			for (int32 Index = 0; Index < Len; ++Index)
+			{
+				const int64 Element = (int64)Data[Index];
+				if (Element >= 0 && Element < NumTableElements)
+				{
+					TableMasks[Element * NumWords + Index / 64] |= uint64(1) << (Index % 64);
+				}
+				else
+				{
+					OtherElements.Add(Element);
+				}
+			}
+
+			if (OtherElements.Num())
+			{
+				OtherElements.Sort();
+				int32 NumUnique = 0;
+				for (int32 Index = 0; Index < OtherElements.Num(); ++Index)
+				{
+					if (NumUnique == 0 || OtherElements[NumUnique - 1] != OtherElements[Index])
+					{
+						OtherElements[NumUnique++] = OtherElements[Index];
+					}
+				}
+				OtherElements.SetNum(NumUnique, false);
+
+				// One more set of masks for the elements that are not in the pattern
+				OtherMasks.SetNumZeroed((NumUnique + 1) * NumWords);
+				for (int32 Index = 0; Index < Len; ++Index)
+				{
+					const int64 Element = (int64)Data[Index];
+					if (Element < 0 || Element >= NumTableElements)
+					{
+						OtherMasks[Algo::BinarySearch(OtherElements, Element) * NumWords + Index / 64] |= uint64(1) << (Index % 64);
+					}
+				}
+			}
+			else
+			{
+				OtherMasks.SetNumZeroed(NumWords);
+			}
+		}
+
+		/** @return The NumWords masks of the positions of Element in the pattern */
+		FORCEINLINE const uint64* GetMasks(int64 Element) const
+		{
+			if (Element >= 0 && Element < NumTableElements)
+			{
+				return TableMasks.GetData() + Element * NumWords;
+			}
+
+			const int32 Index = Algo::BinarySearch(OtherElements, Element);
+			return OtherMasks.GetData() + (Index != INDEX_NONE ? Index : OtherElements.Num()) * NumWords;
+		}
+
+		FORCEINLINE int32 GetLen() const
+		{
+			return Len;
+		}
+
+		FORCEINLINE int32 GetNumWords() const
+		{
+			return NumWords;
+		}
+
+	private:
+		enum { NumTableElements = 128 };
+
+		int32 Len;
+		int32 NumWords;
+		TArray<uint64, TInlineAllocator<NumTableElements>> TableMasks;
+		TArray<int64> OtherElements;
+		TArray<uint64> OtherMasks;
+	};
+
+	/**
+	 * Myers' bit-parallel edit distance in Hyyrö's formulation: the differences between neighbouring cells of a column of
+	 * the dynamic programming matrix are kept as bits, so that a whole column of up to 64 pattern elements is computed in
+	 * a few word operations per text element. Longer patterns are computed in blocks of 64 elements, passing the
+	 * horizontal differences of the last row of each block down to the next one.
+	 *
+	 * @return The distance, or MaxDistance + 1 as soon as the distance is known to be greater than MaxDistance
+	 */
+	template <typename TextRangeType>
+	int32 LevenshteinDistanceBitParallel(const FLevenshteinPattern& Pattern, const TextRangeType& Text, int32 MaxDistance)
+	{
+		const int32 LenPattern = Pattern.GetLen();
+		const int32 LenText = GetNum(Text);
+		if (FMath::Abs(LenPattern - LenText) > MaxDistance)
+		{
+			return MaxDistance + 1;
+		}
+		if (LenPattern == 0)
+		{
+			return LenText;
+		}
+
+		auto TextData = GetData(Text);
+		const int32 NumWords = Pattern.GetNumWords();
+		const uint64 LastRowBit = uint64(1) << ((LenPattern - 1) % 64);
+		int32 Distance = LenPattern;
+
+		if (NumWords == 1)
+		{
+			uint64 VerticalPositive = ~uint64(0);
+			uint64 VerticalNegative = 0;
+			for (int32 TextIndex = 0; TextIndex < LenText; ++TextIndex)
+			{
+				const uint64 Equal = *Pattern.GetMasks((int64)TextData[TextIndex]);
+				const uint64 Diagonal = (((Equal & VerticalPositive) + VerticalPositive) ^ VerticalPositive) | Equal | VerticalNegative;
+				uint64 HorizontalPositive = VerticalNegative | ~(Diagonal | VerticalPositive);
+				uint64 HorizontalNegative = Diagonal & VerticalPositive;
+				Distance += (HorizontalPositive & LastRowBit) ? 1 : 0;
+				Distance -= (HorizontalNegative & LastRowBit) ? 1 : 0;
+
+				// Every remaining text element can lower the distance by one at most
+				if (Distance - (LenText - TextIndex - 1) > MaxDistance)
+				{
+					return MaxDistance + 1;
+				}
+
+				// The first row of the matrix counts the text elements, so it always goes up by one
+				HorizontalPositive = (HorizontalPositive << 1) | 1;
+				HorizontalNegative = HorizontalNegative << 1;
+				VerticalPositive = HorizontalNegative | ~(Diagonal | HorizontalPositive);
+				VerticalNegative = HorizontalPositive & Diagonal;
+			}
+			return Distance;
+		}
+
+		TArray<uint64, TInlineAllocator<8>> VerticalPositive;
+		TArray<uint64, TInlineAllocator<8>> VerticalNegative;
+		VerticalPositive.Init(~uint64(0), NumWords);
+		VerticalNegative.Init(0, NumWords);
+		for (int32 TextIndex = 0; TextIndex < LenText; ++TextIndex)
+		{
+			const uint64* Equal = Pattern.GetMasks((int64)TextData[TextIndex]);
+			uint64 PositiveCarry = 1;
+			uint64 NegativeCarry = 0;
+			for (int32 Word = 0; Word < NumWords; ++Word)
+			{
+				// A negative difference coming down from the block above acts like a match in the first row of this one
+				const uint64 WordEqual = Equal[Word] | NegativeCarry;
+				const uint64 Positive = VerticalPositive[Word];
+				const uint64 Negative = VerticalNegative[Word];
+				const uint64 Diagonal = (((WordEqual & Positive) + Positive) ^ Positive) | WordEqual | Negative;
+				uint64 HorizontalPositive = Negative | ~(Diagonal | Positive);
+				uint64 HorizontalNegative = Diagonal & Positive;
+
+				const uint64 PositiveCarryIn = PositiveCarry;
+				const uint64 NegativeCarryIn = NegativeCarry;
+				const uint64 CarryBit = Word + 1 < NumWords ? uint64(1) << 63 : LastRowBit;
+				PositiveCarry = (HorizontalPositive & CarryBit) ? 1 : 0;
+				NegativeCarry = (HorizontalNegative & CarryBit) ? 1 : 0;
+
+				HorizontalPositive = (HorizontalPositive << 1) | PositiveCarryIn;
+				HorizontalNegative = (HorizontalNegative << 1) | NegativeCarryIn;
+				VerticalPositive[Word] = HorizontalNegative | ~(Diagonal | HorizontalPositive);
+				VerticalNegative[Word] = HorizontalPositive & Diagonal;
+			}
+			Distance += (int32)PositiveCarry - (int32)NegativeCarry;
+
+			if (Distance - (LenText - TextIndex - 1) > MaxDistance)
+			{
+				return MaxDistance + 1;
+			}
+		}
+		return Distance;
+	}
+
+	template <typename RangeAType, typename RangeBType>
+	FORCEINLINE int32 LevenshteinDistance(const RangeAType& RangeA, const RangeBType& RangeB, int32 MaxDistance, TIntegralConstant<bool, true>)
+	{
+		// The pattern is the shorter range, so that the columns of the matrix need as few words as possible
+		if (GetNum(RangeA) <= GetNum(RangeB))
+		{
+			return LevenshteinDistanceBitParallel(FLevenshteinPattern(RangeA), RangeB, MaxDistance);
+		}
+		return LevenshteinDistanceBitParallel(FLevenshteinPattern(RangeB), RangeA, MaxDistance);
+	}
+
+	template <typename RangeAType, typename RangeBType>
+	FORCEINLINE int32 LevenshteinDistance(const RangeAType& RangeA, const RangeBType& RangeB, int32 MaxDistance, TIntegralConstant<bool, false>)
+	{
+		if (FMath::Abs(GetNum(RangeA) - GetNum(RangeB)) > MaxDistance)
+		{
+			return MaxDistance + 1;
+		}
+		return FMath::Min(LevenshteinDistanceDP(RangeA, RangeB), MaxDistance + 1);
+	}
+
+	template <typename QueryRangeType, typename CandidatesRangeType>
+	void ParallelLevenshteinDistance(const QueryRangeType& Query, const CandidatesRangeType& Candidates, TArrayView<int32> OutDistances, int32 MaxDistance, TIntegralConstant<bool, true>)
+	{
+		const FLevenshteinPattern Pattern(Query);
+		auto CandidatesData = GetData(Candidates);
+		ParallelFor(GetNum(Candidates), [&Pattern, CandidatesData, OutDistances, MaxDistance](int32 Index)
+		{
+			OutDistances[Index] = LevenshteinDistanceBitParallel(Pattern, CandidatesData[Index], MaxDistance);
+		});
+	}
+
+	template <typename QueryRangeType, typename CandidatesRangeType>
+	void ParallelLevenshteinDistance(const QueryRangeType& Query, const CandidatesRangeType& Candidates, TArrayView<int32> OutDistances, int32 MaxDistance, TIntegralConstant<bool, false>)
+	{
+		auto CandidatesData = GetData(Candidates);
+		ParallelFor(GetNum(Candidates), [&Query, CandidatesData, OutDistances, MaxDistance](int32 Index)
+		{
+			OutDistances[Index] = LevenshteinDistance(Query, CandidatesData[Index], MaxDistance, TIntegralConstant<bool, false>());
+		});
+	}
+}
+
+namespace Algo
+{
+	/**
+	* LevenshteinDistance with a threshold, which stops as soon as the distance is known to be greater than MaxDistance.
+	* Much faster than computing the distance when most ranges are far from each other, like when filtering names.
+	*
+	* @param RangeA			The first range of element
+	* @param RangeB			The second range of element
+	* @param MaxDistance	The greatest distance of interest
+	* @return				The number of operation to transform RangeA to RangeB, or MaxDistance + 1 if it's greater than MaxDistance
+	*/
+	template <typename RangeAType, typename RangeBType>
+	int32 LevenshteinDistance(const RangeAType& RangeA, const RangeBType& RangeB, int32 MaxDistance)
+	{
+		typedef TIntegralConstant<bool, AlgoImpl::TIsBitParallelLevenshteinRange<RangeAType>::Value && AlgoImpl::TIsBitParallelLevenshteinRange<RangeBType>::Value> FBitParallel;
+
+		// Clamped so that MaxDistance + 1 can't overflow, no distance is greater than the longer range
+		MaxDistance = FMath::Min(MaxDistance, FMath::Max(GetNum(RangeA), GetNum(RangeB)));
+		return AlgoImpl::LevenshteinDistance(RangeA, RangeB, MaxDistance, FBitParallel());
+	}
+
+	/**
+	* LevenshteinDistance return the number of edit operation we need to transform RangeA to RangeB.
+	* Operation type are Add/Remove/substitution of range element. Base on Levenshtein algorithm.
+	* Ranges of characters or other integers of up to 32 bits use a bit-parallel algorithm, which computes 64 cells of
+	* the distance matrix at once.
+	*
+	* Range[A/B]Type: Support [] operator and the range element must be able to be compare with == operator
+	*                 Support GetNum() functionality
+	*
+	* @param RangeA			The first range of element
+	* @param RangeB			The second range of element
+	* @return				The number of operation to transform RangeA to RangeB
+	*/
+	template <typename RangeAType, typename RangeBType>
+	int32 LevenshteinDistance(const RangeAType& RangeA, const RangeBType& RangeB)
+	{
+		return LevenshteinDistance(RangeA, RangeB, FMath::Max(GetNum(RangeA), GetNum(RangeB)));
+	}
+
+	/**
+	* Computes the LevenshteinDistance of a query to each of many candidates on worker threads, like when ranking the
+	* names matching what a user types. The bit masks of the query are built once for all the candidates.
+	*
+	* @param Query			The range compared to every candidate
+	* @param Candidates		A range of candidate ranges, like an array of strings
+	* @param OutDistances	Receives the distance to each candidate, or MaxDistance + 1 for those farther than MaxDistance
+	* @param MaxDistance	The greatest distance of interest
+	*/
+	template <typename QueryRangeType, typename CandidatesRangeType>
+	void ParallelLevenshteinDistance(const QueryRangeType& Query, const CandidatesRangeType& Candidates, TArrayView<int32> OutDistances, int32 MaxDistance = MAX_int32)
+	{
+		typedef typename TDecay<decltype(*GetData(Candidates))>::Type CandidateType;
+		typedef TIntegralConstant<bool, AlgoImpl::TIsBitParallelLevenshteinRange<QueryRangeType>::Value && AlgoImpl::TIsBitParallelLevenshteinRange<CandidateType>::Value> FBitParallel;
+
+		check(OutDistances.Num() == GetNum(Candidates));
+		AlgoImpl::ParallelLevenshteinDistance(Query, Candidates, OutDistances, FMath::Min(MaxDistance, MAX_int32 - 1), FBitParallel());
+	}
+
 } //End namespace Algo
@@ -0,0 +1,543 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Algo/IntroSort.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/App.h"
+#include "Templates/ChooseClass.h"
+#include "Templates/Decay.h"
+#include "Templates/Greater.h"
+#include "Templates/IdentityFunctor.h"
+#include "Templates/IntegralConstant.h"
+#include "Templates/Invoke.h"
+#include "Templates/IsArithmetic.h"
+#include "Templates/IsFloatingPoint.h"
+#include "Templates/Less.h"
+#include "Templates/MemoryOps.h"
+#include "Templates/UnrealTemplate.h" // For GetData, GetNum, DeclVal
+
+
+namespace AlgoImpl
+{
+	/** Ranges shorter than twice this are sorted on the calling thread, and no task sorts or merges fewer elements */
+	constexpr int32 ParallelSortMinChunkSize = 16384;
+
+	/** Number of chunks to sort in parallel, 1 if Num elements should be sorted on the calling thread */
+	inline int32 GetParallelSortNumChunks(int32 Num)
+	{
+		if (Num < 2 * ParallelSortMinChunkSize || !FApp::ShouldUseThreadingForPerformance())
+		{
+			return 1;
+		}
+		const int32 NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+		return FMath::Clamp(Num / ParallelSortMinChunkSize, 1, NumThreads);
+	}
+
+	/**
+	 * Scratch memory for as many elements as the range being sorted. Elements are relocated in and out of it bitwise,
+	 * like the containers do when they grow, so it never holds constructed elements of its own.
+	 */
+	template <typename T>
+	struct TParallelSortBuffer
+	{
+		explicit TParallelSortBuffer(int32 Num)
+			: Data((T*)FMemory::Malloc(Num * sizeof(T), alignof(T)))
+		{
+		}
+
+		~TParallelSortBuffer()
+		{
+			FMemory::Free(Data);
+		}
+
+		T* Data;
+
+		UE_NONCOPYABLE(TParallelSortBuffer);
+	};
+
+	/** Relocates Num elements from Src to Dst in parallel chunks */
+	template <typename T>
+	void ParallelRelocate(T* Dst, T* Src, int32 Num, int32 NumChunks)
+	{
+		ParallelFor(NumChunks, [Dst, Src, Num, NumChunks](int32 ChunkIndex)
+		{
+			const int32 Start = int32(int64(Num) * ChunkIndex / NumChunks);
+			const int32 End = int32(int64(Num) * (ChunkIndex + 1) / NumChunks);
+			RelocateConstructItems<T>(Dst + Start, Src + Start, End - Start);
+		});
+	}
+
+	/**
+	 * Finds how many of the first OutIndex elements of the stable merge of A and B come from A.
+	 * Elements of A go first when they compare equal to elements of B.
+	 */
+	template <typename T, typename ProjectionType, typename PredicateType>
+	int32 MergePathSplit(const T* A, int32 NumA, const T* B, int32 NumB, int32 OutIndex, ProjectionType& Projection, PredicateType& Predicate)
+	{
+		int32 Low = FMath::Max(0, OutIndex - NumB);
+		int32 High = FMath::Min(OutIndex, NumA);
+		while (Low < High)
+		{
+			const int32 Mid = Low + (High - Low) / 2;
+			if (Invoke(Predicate, Invoke(Projection, B[OutIndex - Mid - 1]), Invoke(Projection, A[Mid])))
+			{
+				High = Mid;
+			}
+			else
+			{
+				Low = Mid + 1;
+			}
+		}
+		return Low;
+	}
+
+	/** Relocates the elements [OutStart, OutEnd) of the stable merge of the sorted runs A and B to Out + OutStart */
+	template <typename T, typename ProjectionType, typename PredicateType>
+	void MergeRelocate(T* A, int32 NumA, T* B, int32 NumB, T* Out, int32 OutStart, int32 OutEnd, ProjectionType& Projection, PredicateType& Predicate)
+	{
+		int32 IndexA = MergePathSplit(A, NumA, B, NumB, OutStart, Projection, Predicate);
+		int32 IndexB = OutStart - IndexA;
+		const int32 EndA = MergePathSplit(A, NumA, B, NumB, OutEnd, Projection, Predicate);
+		const int32 EndB = OutEnd - EndA;
+
+		T* Dst = Out + OutStart;
+		while (IndexA < EndA && IndexB < EndB)
+		{
+			if (Invoke(Predicate, Invoke(Projection, B[IndexB]), Invoke(Projection, A[IndexA])))
+			{
+				RelocateConstructItems<T>(Dst++, B + IndexB++, 1);
+			}
+			else
+			{
+				RelocateConstructItems<T>(Dst++, A + IndexA++, 1);
+			}
+		}
+		RelocateConstructItems<T>(Dst, A + IndexA, EndA - IndexA);
+		RelocateConstructItems<T>(Dst + (EndA - IndexA), B + IndexB, EndB - IndexB);
+	}
+
+	/** Stable merge sort of a range using a scratch buffer of the same size, the result ends up back in First */
+	template <typename T, typename ProjectionType, typename PredicateType>
+	void MergeSortWithBuffer(T* First, T* Buffer, int32 Num, ProjectionType& Projection, PredicateType& Predicate)
+	{
+		// Sort small runs in place, then merge them back and forth between the range and the buffer
+		constexpr int32 RunSize = 32;
+		for (int32 RunStart = 0; RunStart < Num; RunStart += RunSize)
+		{
+			AlgoImpl::StableSortInternal(First + RunStart, FMath::Min(RunSize, Num - RunStart), Projection, Predicate);
+		}
+
+		T* Src = First;
+		T* Dst = Buffer;
+		for (int32 Width = RunSize; Width < Num; Width *= 2)
+		{
+			for (int32 Start = 0; Start < Num; Start += 2 * Width)
+			{
+				const int32 NumA = FMath::Min(Width, Num - Start);
+				const int32 NumB = FMath::Min(Width, Num - Start - NumA);
+				MergeRelocate(Src + Start, NumA, Src + Start + NumA, NumB, Dst + Start, 0, NumA + NumB, Projection, Predicate);
+			}
+			Swap(Src, Dst);
+		}
+
+		if (Src != First)
+		{
+			RelocateConstructItems<T>(First, Src, Num);
+		}
+	}
+
+	/**
+	 * Sorts NumChunks chunks of the range in parallel, then merges pairs of sorted runs until one is left. Each merge round
+	 * splits its output into equal segments merged by separate tasks, which find where their inputs start by binary search.
+	 */
+	template <typename T, typename ProjectionType, typename PredicateType>
+	void ParallelMergeSort(T* First, int32 Num, int32 NumChunks, ProjectionType& Projection, PredicateType& Predicate, bool bStable)
+	{
+		TParallelSortBuffer<T> Buffer(Num);
+
+		TArray<int32, TInlineAllocator<65>> RunStarts;
+		for (int32 ChunkIndex = 0; ChunkIndex <= NumChunks; ++ChunkIndex)
+		{
+			RunStarts.Add(int32(int64(Num) * ChunkIndex / NumChunks));
+		}
+
+		T* BufferData = Buffer.Data;
+		ParallelFor(NumChunks, [First, BufferData, &RunStarts, &Projection, &Predicate, bStable](int32 ChunkIndex)
+		{
+			const int32 Start = RunStarts[ChunkIndex];
+			const int32 ChunkNum = RunStarts[ChunkIndex + 1] - Start;
+			if (bStable)
+			{
+				MergeSortWithBuffer(First + Start, BufferData + Start, ChunkNum, Projection, Predicate);
+			}
+			else
+			{
+				AlgoImpl::IntroSortInternal(First + Start, ChunkNum, Projection, Predicate);
+			}
+		});
+
+		T* Src = First;
+		T* Dst = Buffer.Data;
+		const int32 NumSegments = NumChunks;
+		while (RunStarts.Num() > 2)
+		{
+			const int32 NumRuns = RunStarts.Num() - 1;
+			ParallelFor(NumSegments, [Src, Dst, Num, NumSegments, NumRuns, &RunStarts, &Projection, &Predicate](int32 SegmentIndex)
+			{
+				const int32 SegmentStart = int32(int64(Num) * SegmentIndex / NumSegments);
+				const int32 SegmentEnd = int32(int64(Num) * (SegmentIndex + 1) / NumSegments);
+
+				// Merge the part of each pair of runs overlapping this segment, a trailing unpaired run is only relocated
+				for (int32 RunIndex = 0; RunIndex < NumRuns; RunIndex += 2)
+				{
+					const int32 PairStart = RunStarts[RunIndex];
+					const int32 PairEnd = RunStarts[FMath::Min(RunIndex + 2, NumRuns)];
+					const int32 Start = FMath::Max(PairStart, SegmentStart);
+					const int32 End = FMath::Min(PairEnd, SegmentEnd);
+					if (Start < End)
+					{
+						const int32 MidPoint = RunStarts[FMath::Min(RunIndex + 1, NumRuns)];
+						MergeRelocate(Src + PairStart, MidPoint - PairStart, Src + MidPoint, PairEnd - MidPoint, Dst + PairStart, Start - PairStart, End - PairStart, Projection, Predicate);
+					}
+				}
+			});
+
+			for (int32 RunIndex = 1; RunIndex * 2 < NumRuns; ++RunIndex)
+			{
+				RunStarts[RunIndex] = RunStarts[RunIndex * 2];
+			}
+			RunStarts[(NumRuns + 1) / 2] = Num;
+			RunStarts.SetNum((NumRuns + 1) / 2 + 1, false);
+			Swap(Src, Dst);
+		}
+
+		if (Src != First)
+		{
+			ParallelRelocate(First, Src, Num, NumChunks);
+		}
+	}
+
+	/** Maps an arithmetic key to an unsigned integer which sorts in the same order, one byte per radix pass */
+	template <typename KeyType, bool bIsFloat = TIsFloatingPoint<KeyType>::Value>
+	struct TRadixSortKey
+	{
+		typedef typename TChooseClass<sizeof(KeyType) <= 4, uint32, uint64>::Result FUnsigned;
+		enum { NumPasses = sizeof(KeyType) };
+
+		static FORCEINLINE FUnsigned Get(KeyType Key)
+		{
+			// Only the low sizeof(KeyType) bytes are sorted on, so flipping the sign bit of signed types is enough
+			constexpr bool bIsSigned = KeyType(-1) < KeyType(0);
+			return FUnsigned(Key) ^ (bIsSigned ? FUnsigned(1) << (sizeof(KeyType) * 8 - 1) : FUnsigned(0));
+		}
+	};
+
+	template <typename KeyType>
+	struct TRadixSortKey<KeyType, true>
+	{
+		typedef typename TChooseClass<sizeof(KeyType) == 4, uint32, uint64>::Result FUnsigned;
+		enum { NumPasses = sizeof(KeyType) };
+
+		static FORCEINLINE FUnsigned Get(KeyType Key)
+		{
+			// Flip all the bits of negative values and only the sign bit of positive ones, see FRadixSortKeyFloat
+			FUnsigned Bits;
+			FMemory::Memcpy(&Bits, &Key, sizeof(Key));
+			const FUnsigned SignBit = FUnsigned(1) << (sizeof(KeyType) * 8 - 1);
+			return Bits ^ ((Bits & SignBit) ? ~FUnsigned(0) : SignBit);
+		}
+	};
+
+	/**
+	 * Stable LSD radix sort on the projected arithmetic keys, one byte per pass with the range split into NumChunks
+	 * chunks that are counted and scattered in parallel. Passes where all keys have the same byte are skipped.
+	 */
+	template <typename T, typename ProjectionType, bool bDescending>
+	void ParallelRadixSort(T* First, int32 Num, int32 NumChunks, ProjectionType& Projection)
+	{
+		typedef typename TDecay<decltype(Invoke(Projection, *First))>::Type KeyType;
+		typedef TRadixSortKey<KeyType> FRadixKey;
+		typedef typename FRadixKey::FUnsigned FUnsigned;
+		constexpr int32 NumPasses = FRadixKey::NumPasses;
+		constexpr int32 NumBuckets = 256;
+
+		auto GetKey = [&Projection](const T& Element) -> FUnsigned
+		{
+			const FUnsigned Key = FRadixKey::Get(Invoke(Projection, Element));
+			return bDescending ? ~Key : Key;
+		};
+
+		TParallelSortBuffer<T> Buffer(Num);
+		TArray<int32> Counts;
+		Counts.SetNumZeroed(NumChunks * NumPasses * NumBuckets);
+
+		// The first count gives the byte histograms of every pass, to find the passes that can be skipped
+		ParallelFor(NumChunks, [First, Num, NumChunks, &Counts, &GetKey](int32 ChunkIndex)
+		{
+			int32* ChunkCounts = Counts.GetData() + ChunkIndex * NumPasses * NumBuckets;
+			const int32 End = int32(int64(Num) * (ChunkIndex + 1) / NumChunks);
+			for (int32 Index = int32(int64(Num) * ChunkIndex / NumChunks); Index < End; ++Index)
+			{
+				const FUnsigned Key = GetKey(First[Index]);
+				for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+				{
+					++ChunkCounts[Pass * NumBuckets + int32((Key >> (Pass * 8)) & 0xFF)];
+				}
+			}
+		});
+
+		bool bPassNeeded[NumPasses];
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			bPassNeeded[Pass] = true;
+			for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+			{
+				int32 Total = 0;
+				for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+				{
+					Total += Counts[(ChunkIndex * NumPasses + Pass) * NumBuckets + Bucket];
+				}
+				if (Total != 0)
+				{
+					bPassNeeded[Pass] = Total != Num;
+					break;
+				}
+			}
+		}
+
+		T* Src = First;
+		T* Dst = Buffer.Data;
+		bool bCountsAreCurrent = true;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			if (!bPassNeeded[Pass])
+			{
+				continue;
+			}
+
+			// Chunks cover different elements once they've been scattered, so later passes count their byte again
+			if (!bCountsAreCurrent)
+			{
+				ParallelFor(NumChunks, [Src, Num, NumChunks, Pass, &Counts, &GetKey](int32 ChunkIndex)
+				{
+					int32* PassCounts = Counts.GetData() + (ChunkIndex * NumPasses + Pass) * NumBuckets;
+					FMemory::Memzero(PassCounts, NumBuckets * sizeof(int32));
+					const int32 End = int32(int64(Num) * (ChunkIndex + 1) / NumChunks);
+					for (int32 Index = int32(int64(Num) * ChunkIndex / NumChunks); Index < End; ++Index)
+					{
+						++PassCounts[int32((GetKey(Src[Index]) >> (Pass * 8)) & 0xFF)];
+					}
+				});
+			}
+			bCountsAreCurrent = false;
+
+			// Each chunk writes its elements of a bucket after those of the same bucket in the previous chunks, which keeps the sort stable
+			int32 Offset = 0;
+			for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+			{
+				for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+				{
+					int32& Count = Counts[(ChunkIndex * NumPasses + Pass) * NumBuckets + Bucket];
+					const int32 ChunkBucketNum = Count;
+					Count = Offset;
+					Offset += ChunkBucketNum;
+				}
+			}
+
+			ParallelFor(NumChunks, [Src, Dst, Num, NumChunks, Pass, &Counts, &GetKey](int32 ChunkIndex)
+			{
+				int32* Offsets = Counts.GetData() + (ChunkIndex * NumPasses + Pass) * NumBuckets;
+				const int32 End = int32(int64(Num) * (ChunkIndex + 1) / NumChunks);
+				for (int32 Index = int32(int64(Num) * ChunkIndex / NumChunks); Index < End; ++Index)
+				{
+					const int32 Bucket = int32((GetKey(Src[Index]) >> (Pass * 8)) & 0xFF);
+					RelocateConstructItems<T>(Dst + Offsets[Bucket]++, Src + Index, 1);
+				}
+			});
+			Swap(Src, Dst);
+		}
+
+		if (Src != First)
+		{
+			ParallelRelocate(First, Src, Num, NumChunks);
+		}
+	}
+
+	/** Whether sorting by KeyType with PredicateType can use the radix sort, and in which direction */
+	template <typename KeyType, typename PredicateType>
+	struct TParallelSortUsesRadix
+	{
+		enum { Value = false, bDescending = false };
+	};
+
+	template <typename KeyType>
+	struct TParallelSortUsesRadix<KeyType, TLess<>>
+	{
+		enum { Value = TIsArithmetic<KeyType>::Value && sizeof(KeyType) <= 8, bDescending = false };
+	};
+
+	template <typename KeyType>
+	struct TParallelSortUsesRadix<KeyType, TLess<KeyType>> : TParallelSortUsesRadix<KeyType, TLess<>>
+	{
+	};
+
+	template <typename KeyType>
+	struct TParallelSortUsesRadix<KeyType, TGreater<>>
+	{
+		enum { Value = TIsArithmetic<KeyType>::Value && sizeof(KeyType) <= 8, bDescending = true };
+	};
+
+	template <typename KeyType>
+	struct TParallelSortUsesRadix<KeyType, TGreater<KeyType>> : TParallelSortUsesRadix<KeyType, TGreater<>>
+	{
+	};
+
+	template <typename T, typename ProjectionType, typename PredicateType>
+	FORCEINLINE void ParallelSortDispatch(T* First, int32 Num, int32 NumChunks, ProjectionType& Projection, PredicateType& Predicate, bool bStable, TIntegralConstant<bool, false>)
+	{
+		ParallelMergeSort(First, Num, NumChunks, Projection, Predicate, bStable);
+	}
+
+	template <typename T, typename ProjectionType, typename PredicateType>
+	FORCEINLINE void ParallelSortDispatch(T* First, int32 Num, int32 NumChunks, ProjectionType& Projection, PredicateType& Predicate, bool bStable, TIntegralConstant<bool, true>)
+	{
+		typedef typename TDecay<decltype(Invoke(Projection, *First))>::Type KeyType;
+		ParallelRadixSort<T, ProjectionType, TParallelSortUsesRadix<KeyType, PredicateType>::bDescending>(First, Num, NumChunks, Projection);
+	}
+
+	/**
+	 * Sort elements using user defined projection and predicate classes, splitting the work over the task graph.
+	 * Arithmetic keys sorted with TLess or TGreater use a radix sort, which is always stable, everything else a merge sort
+	 * of chunks sorted in parallel. Small ranges are sorted on the calling thread.
+	 *
+	 * @param  First       Pointer to the first element to sort.
+	 * @param  Num         The number of items to sort.
+	 * @param  Projection  A projection to apply to each element to get the value to sort by.
+	 * @param  Predicate   A predicate class which compares two projected elements and returns whether one occurs before the other.
+	 * @param  bStable     Whether the ordering of equal items must be preserved.
+	 */
+	template <typename T, typename ProjectionType, typename PredicateType>
+	void ParallelSortInternal(T* First, int32 Num, ProjectionType Projection, PredicateType Predicate, bool bStable)
+	{
+		const int32 NumChunks = GetParallelSortNumChunks(Num);
+		if (NumChunks <= 1)
+		{
+			if (bStable)
+			{
+				AlgoImpl::StableSortInternal(First, Num, MoveTemp(Projection), MoveTemp(Predicate));
+			}
+			else
+			{
+				AlgoImpl::IntroSortInternal(First, Num, MoveTemp(Projection), MoveTemp(Predicate));
+			}
+			return;
+		}
+
+		typedef typename TDecay<decltype(Invoke(Projection, *First))>::Type KeyType;
+		ParallelSortDispatch(First, Num, NumChunks, Projection, Predicate, bStable, TIntegralConstant<bool, TParallelSortUsesRadix<KeyType, PredicateType>::Value>());
+	}
+}
+
+namespace Algo
+{
+	/**
+	 * Sort a range of elements using its operator<, using the task graph for large ranges.  The sort is unstable.
+	 *
+	 * @param  Range  The range to sort.
+	 */
+	template <typename RangeType>
+	FORCEINLINE void ParallelSort(RangeType& Range)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), FIdentityFunctor(), TLess<>(), false);
+	}
+
+	/**
+	 * Sort a range of elements using a user-defined predicate class, using the task graph for large ranges.  The sort is unstable.
+	 *
+	 * @param  Range      The range to sort.
+	 * @param  Predicate  A binary predicate object used to specify if one element should precede another.
+	 */
+	template <typename RangeType, typename PredicateType>
+	FORCEINLINE void ParallelSort(RangeType& Range, PredicateType Pred)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), FIdentityFunctor(), MoveTemp(Pred), false);
+	}
+
+	/**
+	 * Sort a range of elements by a projection using the projection's operator<, using the task graph for large ranges.  The sort is unstable.
+	 *
+	 * @param  Range  The range to sort.
+	 * @param  Proj   The projection to sort by when applied to the element.
+	 */
+	template <typename RangeType, typename ProjectionType>
+	FORCEINLINE void ParallelSortBy(RangeType& Range, ProjectionType Proj)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), MoveTemp(Proj), TLess<>(), false);
+	}
+
+	/**
+	 * Sort a range of elements by a projection using a user-defined predicate class, using the task graph for large ranges.  The sort is unstable.
+	 *
+	 * @param  Range      The range to sort.
+	 * @param  Proj       The projection to sort by when applied to the element.
+	 * @param  Predicate  A binary predicate object, applied to the projection, used to specify if one element should precede another.
+	 */
+	template <typename RangeType, typename ProjectionType, typename PredicateType>
+	FORCEINLINE void ParallelSortBy(RangeType& Range, ProjectionType Proj, PredicateType Pred)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), MoveTemp(Proj), MoveTemp(Pred), false);
+	}
+
+	/**
+	 * Sort a range of elements using its operator<, using the task graph for large ranges.  The sort is stable.
+	 *
+	 * @param  Range  The range to sort.
+	 */
+	template <typename RangeType>
+	FORCEINLINE void ParallelStableSort(RangeType& Range)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), FIdentityFunctor(), TLess<>(), true);
+	}
+
+	/**
+	 * Sort a range of elements using a user-defined predicate class, using the task graph for large ranges.  The sort is stable.
+	 *
+	 * @param  Range      The range to sort.
+	 * @param  Predicate  A binary predicate object used to specify if one element should precede another.
+	 */
+	template <typename RangeType, typename PredicateType>
+	FORCEINLINE void ParallelStableSort(RangeType& Range, PredicateType Pred)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), FIdentityFunctor(), MoveTemp(Pred), true);
+	}
+
+	/**
+	 * Sort a range of elements by a projection using the projection's operator<, using the task graph for large ranges.  The sort is stable.
+	 *
+	 * @param  Range  The range to sort.
+	 * @param  Proj   The projection to sort by when applied to the element.
+	 */
+	template <typename RangeType, typename ProjectionType>
+	FORCEINLINE void ParallelStableSortBy(RangeType& Range, ProjectionType Proj)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), MoveTemp(Proj), TLess<>(), true);
+	}
+
+	/**
+	 * Sort a range of elements by a projection using a user-defined predicate class, using the task graph for large ranges.  The sort is stable.
+	 *
+	 * @param  Range      The range to sort.
+	 * @param  Proj       The projection to sort by when applied to the element.
+	 * @param  Predicate  A binary predicate object, applied to the projection, used to specify if one element should precede another.
+	 */
+	template <typename RangeType, typename ProjectionType, typename PredicateType>
+	FORCEINLINE void ParallelStableSortBy(RangeType& Range, ProjectionType Proj, PredicateType Pred)
+	{
+		AlgoImpl::ParallelSortInternal(GetData(Range), GetNum(Range), MoveTemp(Proj), MoveTemp(Pred), true);
+	}
+}
@@ -6,6 +6,7 @@
 #include "Async/Future.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "Containers/UnrealString.h"
+#include "HAL/ParkedThreadPool.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
@@ -16,6 +17,7 @@
 #include "Misc/QueuedThreadPool.h"
 #include "Stats/Stats.h"
 #include "Templates/Function.h"
+#include "Templates/Decay.h"
 
 /**
  * Enumerates available asynchronous execution methods.
@@ -153,6 +155,83 @@ private:
 };
 
 
+/**
+ * Template for asynchronous callables that are executed in the Task Graph system.
+ *
+ * Unlike TAsyncGraphTask the callable is stored in the task itself rather than in a TUniqueFunction,
+ * so it takes no allocation beyond the task, which comes from the task graph's pools unless it is large.
+ */
+template<typename ResultType, typename CallableType>
+class TAsyncGraphCallableTask
+	: public FAsyncGraphTaskBase
+{
+public:
+
+	template<typename InCallableType>
+	TAsyncGraphCallableTask(InCallableType&& InCallable, TPromise<ResultType>&& InPromise, ENamedThreads::Type InDesiredThread)
+		: Callable(Forward<InCallableType>(InCallable))
+		, Promise(MoveTemp(InPromise))
+		, DesiredThread(InDesiredThread)
+	{ }
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		SetPromise(Promise, Callable);
+	}
+
+	ENamedThreads::Type GetDesiredThread()
+	{
+		return DesiredThread;
+	}
+
+private:
+
+	/** The callable to execute on the Task Graph. */
+	CallableType Callable;
+
+	/** The promise to assign the result to. */
+	TPromise<ResultType> Promise;
+
+	/** The desired execution thread. */
+	ENamedThreads::Type DesiredThread;
+};
+
+
+/**
+ * Template for fire-and-forget asynchronous callables, see AsyncTask.
+ */
+template<typename CallableType>
+class TAsyncFireAndForgetGraphTask
+	: public FAsyncGraphTaskBase
+{
+public:
+
+	template<typename InCallableType>
+	TAsyncFireAndForgetGraphTask(ENamedThreads::Type InDesiredThread, InCallableType&& InCallable)
+		: DesiredThread(InDesiredThread)
+		, Callable(Forward<InCallableType>(InCallable))
+	{ }
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Callable();
+	}
+
+	ENamedThreads::Type GetDesiredThread()
+	{
+		return DesiredThread;
+	}
+
+private:
+
+	/** The thread to execute the callable on. */
+	ENamedThreads::Type DesiredThread;
+
+	/** The callable to execute on the Task Graph. */
+	CallableType Callable;
+};
+
+
 /**
  * Template for asynchronous functions that are executed in a separate thread.
  */
@@ -294,7 +373,6 @@ template<typename CallableType>
 auto Async(EAsyncExecution Execution, CallableType&& Callable, TUniqueFunction<void()> CompletionCallback = nullptr) -> TFuture<decltype(Forward<CallableType>(Callable)())>
 {
 	using ResultType = decltype(Forward<CallableType>(Callable)());
-	TUniqueFunction<ResultType()> Function(Forward<CallableType>(Callable));
 	TPromise<ResultType> Promise(MoveTemp(CompletionCallback));
 	TFuture<ResultType> Future = Promise.GetFuture();
 
@@ -304,39 +382,40 @@ auto Async(EAsyncExecution Execution, CallableType&& Callable, TUniqueFunction<v
 		// fallthrough
 	case EAsyncExecution::TaskGraph:
 		{
-			TGraphTask<TAsyncGraphTask<ResultType>>::CreateTask().ConstructAndDispatchWhenReady(MoveTemp(Function), MoveTemp(Promise), Execution == EAsyncExecution::TaskGraph ? ENamedThreads::AnyThread : ENamedThreads::GameThread);
+			TGraphTask<TAsyncGraphCallableTask<ResultType, typename TDecay<CallableType>::Type>>::CreateTask().ConstructAndDispatchWhenReady(Forward<CallableType>(Callable), MoveTemp(Promise), Execution == EAsyncExecution::TaskGraph ? ENamedThreads::AnyThread : ENamedThreads::GameThread);
 		}
 		break;
 	
 	case EAsyncExecution::Thread:
 		if (FPlatformProcess::SupportsMultithreading())
 		{
-			TPromise<FRunnableThread*> ThreadPromise;
-			TAsyncRunnable<ResultType>* Runnable = new TAsyncRunnable<ResultType>(MoveTemp(Function), MoveTemp(Promise), ThreadPromise.GetFuture());
-			
+			TUniqueFunction<ResultType()> Function(Forward<CallableType>(Callable));
 			const FString TAsyncThreadName = FString::Printf(TEXT("TAsync %d"), FAsyncThreadIndex::GetNext());
-			FRunnableThread* RunnableThread = FRunnableThread::Create(Runnable, *TAsyncThreadName);
 
-			check(RunnableThread != nullptr);
+			// The thread is parked for reuse rather than deleted once the function returned
+			const bool bLaunched = FParkedThreadPool::Launch(*TAsyncThreadName, [Function = MoveTemp(Function), Promise = MoveTemp(Promise)]() mutable
+			{
+				SetPromise(Promise, Function);
+			}).IsValid();
 
-			ThreadPromise.SetValue(RunnableThread);
+			check(bLaunched);
 		}
 		else
 		{
-			SetPromise(Promise, Function);
+			SetPromise(Promise, Forward<CallableType>(Callable));
 		}
 		break;
 
 	case EAsyncExecution::ThreadPool:
 		{
-			GThreadPool->AddQueuedWork(new TAsyncQueuedWork<ResultType>(MoveTemp(Function), MoveTemp(Promise)));
+			GThreadPool->AddQueuedWork(new TAsyncQueuedWork<ResultType>(TUniqueFunction<ResultType()>(Forward<CallableType>(Callable)), MoveTemp(Promise)));
 		}
 		break;
 
 #if WITH_EDITOR
 	case EAsyncExecution::LargeThreadPool:
 		{
-			GLargeThreadPool->AddQueuedWork(new TAsyncQueuedWork<ResultType>(MoveTemp(Function), MoveTemp(Promise)));
+			GLargeThreadPool->AddQueuedWork(new TAsyncQueuedWork<ResultType>(TUniqueFunction<ResultType()>(Forward<CallableType>(Callable)), MoveTemp(Promise)));
 		}
 		break;
 #endif
@@ -390,15 +469,15 @@ auto AsyncThread(CallableType&& Callable, uint32 StackSize = 0, EThreadPriority
 
 	if (FPlatformProcess::SupportsMultithreading())
 	{
-		TPromise<FRunnableThread*> ThreadPromise;
-		TAsyncRunnable<ResultType>* Runnable = new TAsyncRunnable<ResultType>(MoveTemp(Function), MoveTemp(Promise), ThreadPromise.GetFuture());
-
 		const FString TAsyncThreadName = FString::Printf(TEXT("TAsyncThread %d"), FAsyncThreadIndex::GetNext());
-		FRunnableThread* RunnableThread = FRunnableThread::Create(Runnable, *TAsyncThreadName, StackSize, ThreadPri);
 
-		check(RunnableThread != nullptr);
+		// A parked thread is only reused if it has the same stack size, and it is given ThreadPri
+		const bool bLaunched = FParkedThreadPool::Launch(*TAsyncThreadName, [Function = MoveTemp(Function), Promise = MoveTemp(Promise)]() mutable
+		{
+			SetPromise(Promise, Function);
+		}, StackSize, ThreadPri).IsValid();
 
-		ThreadPromise.SetValue(RunnableThread);
+		check(bLaunched);
 	}
 	else
 	{
@@ -416,6 +495,19 @@ auto AsyncThread(CallableType&& Callable, uint32 StackSize = 0, EThreadPriority
  */
 CORE_API void AsyncTask(ENamedThreads::Type Thread, TUniqueFunction<void()> Function);
 
+/**
+ * Convenience function for executing code asynchronously on the Task Graph. The callable is stored in the
+ * task, so there is no allocation for it unless the task is too large for the task graph's pools.
+ *
+ * @param Thread The name of the thread to run on.
+ * @param Callable The callable to execute.
+ */
+template<typename CallableType>
+void AsyncTask(ENamedThreads::Type Thread, CallableType&& Callable)
+{
+	TGraphTask<TAsyncFireAndForgetGraphTask<typename TDecay<CallableType>::Type>>::CreateTask().ConstructAndDispatchWhenReady(Thread, Forward<CallableType>(Callable));
+}
+
 /* Inline functions
  *****************************************************************************/
 
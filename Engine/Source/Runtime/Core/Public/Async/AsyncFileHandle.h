@@ -215,3 +215,44 @@ public:
 	IAsyncReadFileHandle(const IAsyncReadFileHandle&) = delete;
 	IAsyncReadFileHandle& operator=(const IAsyncReadFileHandle&) = delete;
 };
+
+/** Called on the thread doing the write, once the data of a Write call was written, or failed to be */
+typedef TFunction<void(bool bSucceeded)> FAsyncWriteCallback;
+
+/**
+ * Handle for ordered async writes to a file, see IPlatformFile::OpenAsyncWrite.
+ * Writes are copied and done on a background thread in the order they were issued. Writes issued while an earlier one is in flight
+ * are combined into a single write of the file.
+ */
+class CORE_API IAsyncWriteFileHandle
+{
+public:
+	IAsyncWriteFileHandle()
+	{
+		INC_DWORD_STAT(STAT_AsyncFileHandles);
+	}
+	/** Destructor, also the only way to close the file handle. Waits for the outstanding writes. **/
+	virtual ~IAsyncWriteFileHandle()
+	{
+		DEC_DWORD_STAT(STAT_AsyncFileHandles);
+	}
+
+	/**
+	* Queue a write at the end of the previous ones. Doesn't block unless too much data is already waiting to be written.
+	* @param Source				Data to write, copied before the call returns.
+	* @param BytesToWrite		Number of bytes to write.
+	* @param CompleteCallback	Called once the data was written. Can be nullptr.
+	**/
+	virtual void Write(const uint8* Source, int64 BytesToWrite, FAsyncWriteCallback&& CompleteCallback = FAsyncWriteCallback()) = 0;
+
+	/**
+	* Wait for all the queued writes to be written.
+	* @param bFullFlush			true to also make sure the data reached the disk, regardless of the sync policy.
+	* @return false if any write failed since the handle was opened.
+	**/
+	virtual bool Flush(bool bFullFlush = false) = 0;
+
+	// Non-copyable
+	IAsyncWriteFileHandle(const IAsyncWriteFileHandle&) = delete;
+	IAsyncWriteFileHandle& operator=(const IAsyncWriteFileHandle&) = delete;
+};
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Templates/Function.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+
+/** What a budgeted task tells the scheduler when it returns */
+enum class EBudgetedTaskResult : uint8
+{
+	/** The task is done */
+	Completed,
+	/** The task saved its progress and runs again when there is budget left, in this frame or a later one */
+	Yield,
+};
+
+/** Handed to a budgeted task while it runs */
+class FBudgetedTaskContext
+{
+public:
+
+	explicit FBudgetedTaskContext(uint64 InYieldCycles)
+		: YieldCycles(InYieldCycles)
+	{
+	}
+
+	/** @return true once the task used the budget it was given, long tasks check this and return EBudgetedTaskResult::Yield */
+	bool ShouldYield() const
+	{
+		return FPlatformTime::Cycles64() >= YieldCycles;
+	}
+
+private:
+
+	uint64 YieldCycles;
+};
+
+/**
+ * Runs background work only while the frame has budget left, so it does not take CPU from the frame critical task
+ * threads on machines with few cores. Each frame gets a budget of BudgetedTasks.FrameBudgetFraction of the
+ * FApp::GetDeltaTime of the last frame, capped at BudgetedTasks.MaxFrameBudgetMs. Tasks run in order on background
+ * priority task threads, one after the other, while their cost estimate fits into what is left of the budget. A
+ * frame's first task always runs so that tasks estimated over the whole budget still make progress.
+ *
+ * Until the first frame begins, and when BudgetedTasks.FrameBudgetFraction is 0, tasks run as soon as possible.
+ * Deferred and executed work is traced under BudgetedTasks/ and printed by BudgetedTasks.PrintStats.
+ */
+class CORE_API FBudgetedTaskScheduler
+{
+public:
+
+	typedef TUniqueFunction<EBudgetedTaskResult(const FBudgetedTaskContext&)> FTaskFunction;
+
+	/** Totals since startup */
+	struct FStats
+	{
+		/** Tasks that completed */
+		int64 NumCompleted = 0;
+		/** Times a task yielded and went back into the queue */
+		int64 NumYields = 0;
+		/** Frames at whose start tasks were still waiting for budget, summed over the tasks waiting */
+		int64 NumDeferred = 0;
+		/** Time spent running tasks */
+		double ExecutedMs = 0.0;
+	};
+
+	static FBudgetedTaskScheduler& Get();
+
+	/**
+	 * Queues a task for a background task thread.
+	 * @param Function; the work, returns EBudgetedTaskResult::Yield to be run again later
+	 * @param EstimatedCostMs; how long a run of the task is expected to take at most
+	 */
+	void Launch(FTaskFunction&& Function, float EstimatedCostMs);
+
+	/** Runs every queued task to completion on the calling thread, ignoring the budget, for loading screens or shutdown */
+	void Flush();
+
+	/** Starts the budget for a new frame. Bound to FCoreDelegates::OnBeginFrame, only call it by hand where that does not fire. */
+	void BeginFrame();
+
+	/** @return the number of tasks waiting, only a snapshot */
+	int32 GetNumQueued() const;
+
+	FStats GetStats() const;
+
+private:
+
+	struct FQueuedTask
+	{
+		FTaskFunction Function;
+		float EstimatedCostMs;
+	};
+
+	FBudgetedTaskScheduler();
+
+	/** Kicks off a pump task if there is none and something can run, with Lock held */
+	void ConditionalStartPump();
+
+	/** Runs tasks on a background task thread until the queue is empty or out of budget */
+	void Pump();
+
+	/** @return the budget left in this frame in milliseconds, with Lock held */
+	double GetRemainingBudgetMs() const;
+
+	mutable FCriticalSection Lock;
+	TQueue<FQueuedTask> Queue;
+	int32 NumQueued;
+	/** Whether a pump task is queued or running */
+	bool bPumpActive;
+	/** Whether frames tick, before the first one there is no budget to apply */
+	bool bFramesTicking;
+	double FrameBudgetMs;
+	double FrameSpentMs;
+	/** Tasks run in this frame, the first one runs whatever its estimate */
+	int32 FrameNumRuns;
+	FStats Stats;
+};
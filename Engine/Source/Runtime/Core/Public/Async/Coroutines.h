@@ -0,0 +1,370 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+#if PLATFORM_COMPILER_HAS_COROUTINES
+
+#include <coroutine>
+#include "Misc/AssertionMacros.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "Async/Future.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Async/AsyncFileHandle.h"
+#include "IO/IoDispatcher.h"
+
+/**
+ * Awaitables for C++20 coroutines, so chains of asynchronous work can be written as straight line code
+ * without a thread blocking on the result of each step:
+ *
+ *	TCoroutineTask<int32> LoadAndParse(IAsyncReadFileHandle& File, int64 Size)
+ *	{
+ *		IAsyncReadRequest* Request = co_await ReadRequestAsync(File, 0, Size, AIOP_Normal, nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+ *		Request->WaitCompletion();
+ *		const int32 Result = Parse(Request->GetReadResults(), Size);
+ *		delete Request;
+ *
+ *		co_await ResumeOn(ENamedThreads::GameThread);
+ *		co_return Result;
+ *	}
+ *
+ * A coroutine returning TCoroutineTask starts right away on the calling thread and runs until its first
+ * co_await that has to wait. Awaiting a TFuture resumes on the thread that set the value, every other
+ * awaitable resumes through the task graph on the thread it was given.
+ */
+
+namespace UE4Coroutines_Private
+{
+	/** Continues a suspended coroutine on Thread */
+	inline void ResumeOnThread(std::coroutine_handle<> Handle, ENamedThreads::Type Thread, const FGraphEventArray* Prerequisites = nullptr)
+	{
+		FFunctionGraphTask::CreateAndDispatchWhenReady([Handle]() { Handle.resume(); }, TStatId(), Prerequisites, Thread);
+	}
+
+	template<typename ResultType>
+	struct TCoroutineTaskPromiseBase
+	{
+		TPromise<ResultType> Promise;
+
+		std::suspend_never initial_suspend() const noexcept { return {}; }
+		// The result lives in the shared state of the promise, the frame can go as soon as the body ends
+		std::suspend_never final_suspend() const noexcept { return {}; }
+
+		void unhandled_exception()
+		{
+			checkf(false, TEXT("Coroutines can not throw"));
+		}
+	};
+}
+
+/**
+ * The return type of a coroutine whose result is delivered through a TFuture. Waiting for the result
+ * with Get blocks, co_await on the task or its future does not.
+ */
+template<typename ResultType>
+class TCoroutineTask
+{
+public:
+
+	struct promise_type : UE4Coroutines_Private::TCoroutineTaskPromiseBase<ResultType>
+	{
+		TCoroutineTask get_return_object()
+		{
+			return TCoroutineTask(this->Promise.GetFuture());
+		}
+
+		template<typename ValueType>
+		void return_value(ValueType&& Value)
+		{
+			this->Promise.SetValue(Forward<ValueType>(Value));
+		}
+	};
+
+	/** Gets the future of the result, the task no longer has one afterwards */
+	TFuture<ResultType> GetFuture()
+	{
+		return MoveTemp(Future);
+	}
+
+	bool IsReady() const
+	{
+		return Future.IsReady();
+	}
+
+	/** Blocks until the coroutine finished */
+	decltype(auto) Get() const
+	{
+		return Future.Get();
+	}
+
+private:
+
+	explicit TCoroutineTask(TFuture<ResultType>&& InFuture)
+		: Future(MoveTemp(InFuture))
+	{
+	}
+
+	TFuture<ResultType> Future;
+};
+
+template<>
+struct TCoroutineTask<void>::promise_type : UE4Coroutines_Private::TCoroutineTaskPromiseBase<void>
+{
+	TCoroutineTask get_return_object()
+	{
+		return TCoroutineTask(this->Promise.GetFuture());
+	}
+
+	void return_void()
+	{
+		this->Promise.SetValue();
+	}
+};
+
+/** Suspends until Future is set and continues on the thread that set it */
+template<typename ResultType>
+class TFutureAwaiter
+{
+public:
+
+	explicit TFutureAwaiter(TFuture<ResultType>&& InFuture)
+		: Future(MoveTemp(InFuture))
+	{
+		check(Future.IsValid());
+	}
+
+	bool await_ready() const
+	{
+		return Future.IsReady();
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		// Then takes the state from Future, the continuation gives it back before resuming. Nothing may touch
+		// this awaiter after Then, the coroutine may already be running on another thread.
+		Future.Then([this, Handle](TFuture<ResultType> Self)
+		{
+			Future = MoveTemp(Self);
+			Handle.resume();
+		});
+	}
+
+	ResultType await_resume()
+	{
+		if constexpr (TIsSame<ResultType, void>::Value || TIsReferenceType<ResultType>::Value)
+		{
+			return Future.Get();
+		}
+		else
+		{
+			// This is the only future of the state, its value can be moved out
+			return MoveTemp(const_cast<ResultType&>(Future.Get()));
+		}
+	}
+
+private:
+
+	TFuture<ResultType> Future;
+};
+
+template<typename ResultType>
+TFutureAwaiter<ResultType> operator co_await(TFuture<ResultType>&& Future)
+{
+	return TFutureAwaiter<ResultType>(MoveTemp(Future));
+}
+
+template<typename ResultType>
+TFutureAwaiter<ResultType> operator co_await(TCoroutineTask<ResultType>&& Task)
+{
+	return TFutureAwaiter<ResultType>(Task.GetFuture());
+}
+
+/** Suspends until a graph event completed and continues on the given thread */
+class FGraphEventAwaiter
+{
+public:
+
+	FGraphEventAwaiter(const FGraphEventRef& InEvent, ENamedThreads::Type InThread)
+		: Event(InEvent)
+		, Thread(InThread)
+	{
+	}
+
+	bool await_ready() const
+	{
+		return !Event.IsValid() || Event->IsComplete();
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		FGraphEventArray Prerequisites;
+		Prerequisites.Add(Event);
+		UE4Coroutines_Private::ResumeOnThread(Handle, Thread, &Prerequisites);
+	}
+
+	void await_resume() const
+	{
+	}
+
+private:
+
+	FGraphEventRef Event;
+	ENamedThreads::Type Thread;
+};
+
+/** co_await on an event continues on any task thread once it completed, or right away if it already did */
+inline FGraphEventAwaiter operator co_await(const FGraphEventRef& Event)
+{
+	return FGraphEventAwaiter(Event, ENamedThreads::AnyThread);
+}
+
+/** Continues on Thread once Event completed */
+inline FGraphEventAwaiter ResumeAfter(const FGraphEventRef& Event, ENamedThreads::Type Thread)
+{
+	return FGraphEventAwaiter(Event, Thread);
+}
+
+/** Moves the coroutine to another thread */
+class FResumeOnAwaiter
+{
+public:
+
+	explicit FResumeOnAwaiter(ENamedThreads::Type InThread)
+		: Thread(InThread)
+	{
+	}
+
+	bool await_ready() const
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		UE4Coroutines_Private::ResumeOnThread(Handle, Thread);
+	}
+
+	void await_resume() const
+	{
+	}
+
+private:
+
+	ENamedThreads::Type Thread;
+};
+
+/** co_await ResumeOn(ENamedThreads::GameThread) continues the coroutine on the game thread */
+inline FResumeOnAwaiter ResumeOn(ENamedThreads::Type Thread)
+{
+	return FResumeOnAwaiter(Thread);
+}
+
+/**
+ * Issues an async read when awaited and continues on the given thread when it completed. The request is
+ * given back to the coroutine, which owns it like any other request: call WaitCompletion, which returns
+ * right away, before deleting it. Requests take their callback when they are created, so this creates
+ * the request rather than awaiting an existing one.
+ */
+class FAsyncReadRequestAwaiter
+{
+public:
+
+	FAsyncReadRequestAwaiter(IAsyncReadFileHandle& InFileHandle, int64 InOffset, int64 InBytesToRead, EAsyncIOPriorityAndFlags InPriorityAndFlags, uint8* InUserSuppliedMemory, ENamedThreads::Type InThread)
+		: FileHandle(InFileHandle)
+		, Offset(InOffset)
+		, BytesToRead(InBytesToRead)
+		, PriorityAndFlags(InPriorityAndFlags)
+		, UserSuppliedMemory(InUserSuppliedMemory)
+		, Thread(InThread)
+	{
+	}
+
+	bool await_ready() const
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		// The callback is called from inside the request, the coroutine must not delete it from there
+		FAsyncFileCallBack Callback = [this, Handle](bool bWasCancelled, IAsyncReadRequest* InRequest)
+		{
+			Request = InRequest;
+			UE4Coroutines_Private::ResumeOnThread(Handle, Thread);
+		};
+		FileHandle.ReadRequest(Offset, BytesToRead, PriorityAndFlags, &Callback, UserSuppliedMemory);
+	}
+
+	IAsyncReadRequest* await_resume() const
+	{
+		return Request;
+	}
+
+private:
+
+	IAsyncReadFileHandle& FileHandle;
+	int64 Offset;
+	int64 BytesToRead;
+	EAsyncIOPriorityAndFlags PriorityAndFlags;
+	uint8* UserSuppliedMemory;
+	ENamedThreads::Type Thread;
+	IAsyncReadRequest* Request = nullptr;
+};
+
+inline FAsyncReadRequestAwaiter ReadRequestAsync(IAsyncReadFileHandle& FileHandle, int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags PriorityAndFlags = AIOP_Normal, uint8* UserSuppliedMemory = nullptr, ENamedThreads::Type Thread = ENamedThreads::AnyThread)
+{
+	return FAsyncReadRequestAwaiter(FileHandle, Offset, BytesToRead, PriorityAndFlags, UserSuppliedMemory, Thread);
+}
+
+/**
+ * Reads a chunk through the I/O dispatcher when awaited and continues on the given thread with the result.
+ * FIoRequest has no way to be told of its completion other than its batch, so this reads through
+ * FIoDispatcher::ReadWithCallback.
+ */
+class FIoReadAwaiter
+{
+public:
+
+	FIoReadAwaiter(FIoDispatcher& InDispatcher, const FIoChunkId& InChunkId, const FIoReadOptions& InOptions, ENamedThreads::Type InThread)
+		: Dispatcher(InDispatcher)
+		, ChunkId(InChunkId)
+		, Options(InOptions)
+		, Thread(InThread)
+	{
+	}
+
+	bool await_ready() const
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> Handle)
+	{
+		Dispatcher.ReadWithCallback(ChunkId, Options, [this, Handle](TIoStatusOr<FIoBuffer> InResult)
+		{
+			Result = MoveTemp(InResult);
+			UE4Coroutines_Private::ResumeOnThread(Handle, Thread);
+		});
+	}
+
+	TIoStatusOr<FIoBuffer> await_resume()
+	{
+		return MoveTemp(Result);
+	}
+
+private:
+
+	FIoDispatcher& Dispatcher;
+	FIoChunkId ChunkId;
+	FIoReadOptions Options;
+	ENamedThreads::Type Thread;
+	TIoStatusOr<FIoBuffer> Result;
+};
+
+inline FIoReadAwaiter IoReadAsync(FIoDispatcher& Dispatcher, const FIoChunkId& ChunkId, const FIoReadOptions& Options = FIoReadOptions(), ENamedThreads::Type Thread = ENamedThreads::AnyThread)
+{
+	return FIoReadAwaiter(Dispatcher, ChunkId, Options, Thread);
+}
+
+#endif // PLATFORM_COMPILER_HAS_COROUTINES
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/Array.h"
 #include "Misc/AssertionMacros.h"
 #include "Templates/UnrealTemplate.h"
 #include "Templates/Function.h"
@@ -195,6 +196,11 @@ private:
 /* TFuture
 *****************************************************************************/
 
+namespace FutureDetail
+{
+	struct FStateAccess;
+}
+
 /**
  * Abstract base template for futures and shared futures.
  */
@@ -357,6 +363,8 @@ protected:
 
 private:
 
+	friend struct FutureDetail::FStateAccess;
+
 	/** Holds the future's state. */
 	StateType State;
 };
@@ -1284,3 +1292,190 @@ TPromise<ResultType> MakeFulfilledPromise(ArgTypes&&... Args)
 	Promise.EmplaceValue(Forward<ArgTypes>(Args)...);
 	return Promise;
 }
+
+
+/* WhenAll and WhenAny
+*****************************************************************************/
+
+namespace FutureDetail
+{
+	/** Lets WhenAll and WhenAny wait for futures without the promise and future that Then makes for each of them */
+	struct FStateAccess
+	{
+		/**
+		 * Calls a function with the result of a future once it is set, on the thread that sets it.
+		 * This invalidates the future.
+		 */
+		template<typename InternalResultType, typename CallbackType>
+		static void OnComplete(TFutureBase<InternalResultType>& Future, CallbackType&& Callback)
+		{
+			check(Future.IsValid());
+			TSharedPtr<TFutureState<InternalResultType>, ESPMode::ThreadSafe> State = MoveTemp(Future.State);
+			TFutureState<InternalResultType>* StatePtr = State.Get();
+			StatePtr->SetContinuation([StateCapture = MoveTemp(State), CallbackCapture = Forward<CallbackType>(Callback)]() mutable
+			{
+				CallbackCapture(StateCapture->GetResult());
+			});
+		}
+	};
+}
+
+/**
+ * Gets a future that is set once all the given futures are, to their results in the same order. Nothing waits for
+ * them: each one decrements a counter when its result is set and the last one sets the future, on its own thread.
+ * Chain work on the returned future with Then or Next to gather results without tying up a thread.
+ *
+ * @param Futures The futures to wait for, they are invalidated.
+ * @return A future of all the results, already set if there are none.
+ */
+template<typename ResultType>
+TFuture<TArray<ResultType>> WhenAll(TArray<TFuture<ResultType>>&& Futures)
+{
+	struct FWhenAllState
+	{
+		TPromise<TArray<ResultType>> Promise;
+		TArray<ResultType> Results;
+		TAtomic<int32> NumRemaining;
+	};
+
+	TSharedRef<FWhenAllState, ESPMode::ThreadSafe> State = MakeShared<FWhenAllState, ESPMode::ThreadSafe>();
+	TFuture<TArray<ResultType>> Result = State->Promise.GetFuture();
+
+	const int32 NumFutures = Futures.Num();
+	if (NumFutures == 0)
+	{
+		State->Promise.EmplaceValue();
+		return Result;
+	}
+
+	State->Results.SetNum(NumFutures);
+	State->NumRemaining = NumFutures;
+	for (int32 Index = 0; Index < NumFutures; ++Index)
+	{
+		FutureDetail::FStateAccess::OnComplete(Futures[Index], [State, Index](const ResultType& Value)
+		{
+			State->Results[Index] = Value;
+			if (--State->NumRemaining == 0)
+			{
+				State->Promise.SetValue(MoveTemp(State->Results));
+			}
+		});
+	}
+	Futures.Reset();
+
+	return Result;
+}
+
+/** Same as above, for futures without results. */
+inline TFuture<void> WhenAll(TArray<TFuture<void>>&& Futures)
+{
+	struct FWhenAllState
+	{
+		TPromise<void> Promise;
+		TAtomic<int32> NumRemaining;
+	};
+
+	TSharedRef<FWhenAllState, ESPMode::ThreadSafe> State = MakeShared<FWhenAllState, ESPMode::ThreadSafe>();
+	TFuture<void> Result = State->Promise.GetFuture();
+
+	const int32 NumFutures = Futures.Num();
+	if (NumFutures == 0)
+	{
+		State->Promise.SetValue();
+		return Result;
+	}
+
+	State->NumRemaining = NumFutures;
+	for (TFuture<void>& Future : Futures)
+	{
+		FutureDetail::FStateAccess::OnComplete(Future, [State](int)
+		{
+			if (--State->NumRemaining == 0)
+			{
+				State->Promise.SetValue();
+			}
+		});
+	}
+	Futures.Reset();
+
+	return Result;
+}
+
+/** Result of WhenAny, the first future to be set. */
+template<typename ResultType>
+struct TWhenAnyResult
+{
+	/** Index of the future in the array given to WhenAny */
+	int32 Index = INDEX_NONE;
+
+	/** Its result */
+	ResultType Result;
+};
+
+/**
+ * Gets a future that is set as soon as any of the given futures is, on the thread that set that one. The other
+ * futures can still be set later, their results are discarded.
+ *
+ * @param Futures The futures to wait for, at least one, they are invalidated.
+ * @return A future of the first result and which future it came from.
+ */
+template<typename ResultType>
+TFuture<TWhenAnyResult<ResultType>> WhenAny(TArray<TFuture<ResultType>>&& Futures)
+{
+	check(Futures.Num() > 0);
+
+	struct FWhenAnyState
+	{
+		TPromise<TWhenAnyResult<ResultType>> Promise;
+		TAtomic<bool> bSet{ false };
+	};
+
+	TSharedRef<FWhenAnyState, ESPMode::ThreadSafe> State = MakeShared<FWhenAnyState, ESPMode::ThreadSafe>();
+	TFuture<TWhenAnyResult<ResultType>> Result = State->Promise.GetFuture();
+
+	for (int32 Index = 0; Index < Futures.Num(); ++Index)
+	{
+		FutureDetail::FStateAccess::OnComplete(Futures[Index], [State, Index](const ResultType& Value)
+		{
+			if (!State->bSet.Exchange(true))
+			{
+				TWhenAnyResult<ResultType> AnyResult;
+				AnyResult.Index = Index;
+				AnyResult.Result = Value;
+				State->Promise.SetValue(MoveTemp(AnyResult));
+			}
+		});
+	}
+	Futures.Reset();
+
+	return Result;
+}
+
+/** Same as above, for futures without results. The future is set to the index of the first one. */
+inline TFuture<int32> WhenAny(TArray<TFuture<void>>&& Futures)
+{
+	check(Futures.Num() > 0);
+
+	struct FWhenAnyState
+	{
+		TPromise<int32> Promise;
+		TAtomic<bool> bSet{ false };
+	};
+
+	TSharedRef<FWhenAnyState, ESPMode::ThreadSafe> State = MakeShared<FWhenAnyState, ESPMode::ThreadSafe>();
+	TFuture<int32> Result = State->Promise.GetFuture();
+
+	for (int32 Index = 0; Index < Futures.Num(); ++Index)
+	{
+		FutureDetail::FStateAccess::OnComplete(Futures[Index], [State, Index](int)
+		{
+			if (!State->bSet.Exchange(true))
+			{
+				State->Promise.SetValue(Index);
+			}
+		});
+	}
+	Futures.Reset();
+
+	return Result;
+}
@@ -114,6 +114,19 @@ public:
 	**/
 	virtual IMappedFileRegion* MapRegion(int64 Offset = 0, int64 BytesToMap = MAX_int64, bool bPreloadHint = false) = 0;
 
+	/**
+	* Map a region of the file copy-on-write. The pages are shared with the other mappings of the file until they are written to,
+	* at which point they become private to the process; writes are never written back to the file.
+	* The region is writable, so the const of IMappedFileRegion::GetMappedPtr can be cast away.
+	* @param Offset				Offset into the file to start mapping.
+	* @param BytesToMap			Number of bytes to map. Clamped to the size of the file.
+	* @return the mapped region interface, or null if the platform can't map files copy-on-write.
+	**/
+	virtual IMappedFileRegion* MapRegionCopyOnWrite(int64 Offset = 0, int64 BytesToMap = MAX_int64)
+	{
+		return nullptr;
+	}
+
 	// Non-copyable
 	IMappedFileHandle(const IMappedFileHandle&) = delete;
 	IMappedFileHandle& operator=(const IMappedFileHandle&) = delete;
@@ -10,6 +10,9 @@
 #include "Misc/AssertionMacros.h"
 #include "Math/UnrealMathUtility.h"
 #include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Templates/SharedPointer.h"
 #include "HAL/ThreadSafeCounter.h"
 #include "Stats/Stats.h"
@@ -31,12 +34,88 @@ enum class EParallelForFlags
 
 	// if running on the rendering thread, make sure the ProcessThread is called when idle
 	PumpRenderingThread = 4,
+
+	//Splits the range lazily instead of dividing it up front: a range is halved only when the previously split off half has
+	//already been picked up by another thread, otherwise the work runs inline. Safe to nest, nested loops run inline when
+	//the task threads are already busy. Also gives good distribution for unbalanced work without an atomic per item.
+	AdaptiveSplitting = 8,
 };
 
 ENUM_CLASS_FLAGS(EParallelForFlags)
 
 namespace ParallelForImpl
 {
+	/** A context of ParallelForWithTaskContext, on a cache line of its own so that workers updating theirs don't false share. */
+	template<typename ContextType>
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) TTaskContextSlot
+	{
+		ContextType Context;
+
+		/** value initialized, so that counters and sums start at zero */
+		TTaskContextSlot()
+			: Context()
+		{
+		}
+	};
+
+	/** Body of ParallelForWithTaskContext, a thread takes the next free context the first time it runs an item. */
+	template<typename ContextType, typename FunctionType>
+	struct TTaskContextBody
+	{
+		TTaskContextSlot<ContextType>* Contexts;
+		int32 MaxContexts;
+		const FunctionType* Body;
+		/** only grows while items remain, so it is final once the loop has returned */
+		FThreadSafeCounter NumContexts;
+
+		TTaskContextBody(TTaskContextSlot<ContextType>* InContexts, int32 InMaxContexts, const FunctionType& InBody)
+			: Contexts(InContexts)
+			, MaxContexts(InMaxContexts)
+			, Body(&InBody)
+		{
+		}
+	};
+
+	/** How Process calls the body of a loop, through a TFunctionRef to keep the loop out of line. */
+	template<typename FunctionType>
+	class TParallelForBodyRef
+	{
+		TFunctionRef<void(int32)> Body;
+	public:
+		explicit TParallelForBodyRef(FunctionType& InBody)
+			: Body(InBody)
+		{
+		}
+		FORCEINLINE void operator()(int32 Index)
+		{
+			Body(Index);
+		}
+	};
+
+	template<typename ContextType, typename FunctionType>
+	class TParallelForBodyRef<TTaskContextBody<ContextType, FunctionType>>
+	{
+		TTaskContextBody<ContextType, FunctionType>& Body;
+		/** context of this thread, taken lazily so that tasks which find no work left don't use one */
+		ContextType* Context;
+	public:
+		explicit TParallelForBodyRef(TTaskContextBody<ContextType, FunctionType>& InBody)
+			: Body(InBody)
+			, Context(nullptr)
+		{
+		}
+		FORCEINLINE void operator()(int32 Index)
+		{
+			if (!Context)
+			{
+				const int32 ContextIndex = Body.NumContexts.Increment() - 1;
+				check(ContextIndex < Body.MaxContexts);
+				Context = &Body.Contexts[ContextIndex].Context;
+			}
+			(*Body.Body)(*Context, Index);
+		}
+	};
+
 	// struct to hold the working data; this outlives the ParallelFor call; lifetime is controlled by a shared pointer
 	template<typename FunctionType>
 	struct TParallelForData
@@ -144,7 +223,7 @@ namespace ParallelForImpl
 		int32 LocalBlockSize = BlockSize;
 		int32 LocalNum = Num;
 		bool bLocalSaveLastBlockForMaster = bSaveLastBlockForMaster;
-		TFunctionRef<void(int32)> LocalBody(Body);
+		TParallelForBodyRef<FunctionType> LocalBody(Body);
 		while (true)
 		{
 			int32 MyIndex = IndexToDo.Increment() - 1;
@@ -186,9 +265,291 @@ namespace ParallelForImpl
 		return false;
 	}
 
+	/** Number of ranges split off by adaptive loops that no thread has picked up yet, shared by all loops so nested loops don't oversubscribe. */
+	extern CORE_API FThreadSafeCounter GAdaptiveUnclaimedSplits;
+
+	/** A contiguous piece of an adaptive loop as it was finally executed. */
+	struct FAdaptiveRange
+	{
+		int32 Begin;
+		int32 End;
+		/** Index of the range, stable for the duration of the loop; used to address per range data such as partial results. */
+		int32 RangeIndex;
+	};
+
+	/** default batch size for adaptive loops, small enough that idle threads find something to split off */
+	inline int32 GetAdaptiveMinBatchSize(int32 Num, int32 NumWorkers)
+	{
+		return FMath::Max<int32>(1, Num / ((NumWorkers + 1) * 64));
+	}
+
+	/** upper bound on the number of ranges an adaptive loop may be split into */
+	inline int32 GetAdaptiveMaxRanges(int32 Num, int32 MinBatchSize, int32 NumWorkers)
+	{
+		const int32 NumBatches = FMath::Max<int32>(1, Num / FMath::Max<int32>(MinBatchSize, 1));
+		return FMath::Min<int32>(NumBatches, (NumWorkers + 1) * (FMath::FloorLog2(NumBatches) + 2));
+	}
+
+	// struct to hold the working data of an adaptive loop; this outlives the call; lifetime is controlled by a shared pointer
+	template<typename RangeBodyType>
+	struct TAdaptiveParallelForData
+	{
+		enum ERangeState
+		{
+			Unpublished,
+			Unclaimed,
+			Claimed
+		};
+
+		struct FRangeSlot
+		{
+			int32 Begin;
+			/** shrinks as upper halves are split off, only touched by the thread that claimed the range */
+			int32 End;
+			volatile int32 State;
+		};
+
+		RangeBodyType Body;
+		int32 MinBatchSize;
+		int32 MaxRanges;
+		TUniquePtr<FRangeSlot[]> Ranges;
+		FThreadSafeCounter NumReservedRanges;
+		FThreadSafeCounter NumRemaining;
+		FEvent* Event;
+		bool bExited;
+		bool bTriggered;
+
+		TAdaptiveParallelForData(int32 InNum, int32 InMinBatchSize, int32 InMaxRanges, RangeBodyType InBody)
+			: Body(InBody)
+			, MinBatchSize(InMinBatchSize)
+			, MaxRanges(InMaxRanges)
+			, Ranges(new FRangeSlot[InMaxRanges])
+			, NumReservedRanges(1)
+			, NumRemaining(InNum)
+			, Event(FPlatformProcess::GetSynchEventFromPool(false))
+			, bExited(false)
+			, bTriggered(false)
+		{
+			check(MinBatchSize > 0 && MaxRanges > 0);
+			for (int32 Index = 0; Index < MaxRanges; Index++)
+			{
+				Ranges[Index].State = Unpublished;
+			}
+			// the root range is claimed by the calling thread
+			Ranges[0].Begin = 0;
+			Ranges[0].End = InNum;
+			Ranges[0].State = Claimed;
+		}
+		~TAdaptiveParallelForData()
+		{
+			check(NumRemaining.GetValue() == 0);
+			check(bExited);
+			FPlatformProcess::ReturnSynchEventToPool(Event);
+		}
+
+		int32 GetNumRanges() const
+		{
+			return FMath::Min<int32>(NumReservedRanges.GetValue(), MaxRanges);
+		}
+
+		/** Runs a claimed range, splitting it while other threads are hungry. @return true if this completed the last item of the loop. */
+		bool ProcessRange(int32 RangeIndex, TSharedRef<TAdaptiveParallelForData, ESPMode::ThreadSafe>& Data);
+
+		/** Claims and runs ranges nobody has picked up yet, this is what makes nesting and blocking waits deadlock free. @return true if this completed the last item of the loop. */
+		bool ProcessUnclaimedRanges(TSharedRef<TAdaptiveParallelForData, ESPMode::ThreadSafe>& Data)
+		{
+			bool bFoundAny = true;
+			while (bFoundAny)
+			{
+				bFoundAny = false;
+				const int32 LocalNumRanges = GetNumRanges();
+				for (int32 Index = 1; Index < LocalNumRanges; Index++)
+				{
+					if (FPlatformAtomics::AtomicRead(&Ranges[Index].State) == Unclaimed &&
+						FPlatformAtomics::InterlockedCompareExchange(&Ranges[Index].State, Claimed, Unclaimed) == Unclaimed)
+					{
+						bFoundAny = true;
+						if (ProcessRange(Index, Data))
+						{
+							return true;
+						}
+					}
+				}
+			}
+			return false;
+		}
+	};
+
+	template<typename RangeBodyType>
+	class TAdaptiveParallelForTask
+	{
+		TSharedRef<TAdaptiveParallelForData<RangeBodyType>, ESPMode::ThreadSafe> Data;
+		int32 RangeIndex;
+	public:
+		TAdaptiveParallelForTask(TSharedRef<TAdaptiveParallelForData<RangeBodyType>, ESPMode::ThreadSafe>& InData, int32 InRangeIndex)
+			: Data(InData)
+			, RangeIndex(InRangeIndex)
+		{
+		}
+		static FORCEINLINE TStatId GetStatId()
+		{
+			return GET_STATID(STAT_ParallelForTask);
+		}
+		static FORCEINLINE ENamedThreads::Type GetDesiredThread()
+		{
+			return ENamedThreads::AnyHiPriThreadHiPriTask;
+		}
+		static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+		{
+			return ESubsequentsMode::FireAndForget;
+		}
+		void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+		{
+			// a thread picked up the split, so as far as the other loops are concerned somebody was idle
+			GAdaptiveUnclaimedSplits.Decrement();
+
+			FMemMark Mark(FMemStack::Get());
+			auto& Range = Data->Ranges[RangeIndex];
+			bool bCompletedLast = false;
+			if (FPlatformAtomics::InterlockedCompareExchange(&Range.State, TAdaptiveParallelForData<RangeBodyType>::Claimed, TAdaptiveParallelForData<RangeBodyType>::Unclaimed) == TAdaptiveParallelForData<RangeBodyType>::Unclaimed)
+			{
+				bCompletedLast = Data->ProcessRange(RangeIndex, Data) || Data->ProcessUnclaimedRanges(Data);
+			}
+			if (bCompletedLast)
+			{
+				checkSlow(!Data->bTriggered);
+				Data->bTriggered = true;
+				Data->Event->Trigger();
+			}
+		}
+	};
+
+	template<typename RangeBodyType>
+	inline bool TAdaptiveParallelForData<RangeBodyType>::ProcessRange(int32 RangeIndex, TSharedRef<TAdaptiveParallelForData<RangeBodyType>, ESPMode::ThreadSafe>& Data)
+	{
+		FRangeSlot& Range = Ranges[RangeIndex];
+		int32 Begin = Range.Begin;
+		int32 NumDone = 0;
+		while (Begin < Range.End)
+		{
+			// split in half if every previous split has been picked up, which means some thread is idle
+			if (Range.End - Begin >= 2 * MinBatchSize && GAdaptiveUnclaimedSplits.GetValue() == 0)
+			{
+				const int32 NewIndex = NumReservedRanges.Increment() - 1;
+				if (NewIndex < MaxRanges)
+				{
+					const int32 Mid = Begin + (Range.End - Begin) / 2;
+					Ranges[NewIndex].Begin = Mid;
+					Ranges[NewIndex].End = Range.End;
+					Range.End = Mid;
+					GAdaptiveUnclaimedSplits.Increment();
+					FPlatformAtomics::InterlockedExchange(&Ranges[NewIndex].State, Unclaimed);
+					TGraphTask<TAdaptiveParallelForTask<RangeBodyType>>::CreateTask().ConstructAndDispatchWhenReady(Data, NewIndex);
+					continue;
+				}
+			}
+			const int32 BatchEnd = FMath::Min<int32>(Begin + MinBatchSize, Range.End);
+			Body(RangeIndex, Begin, BatchEnd);
+			NumDone += BatchEnd - Begin;
+			Begin = BatchEnd;
+		}
+		checkSlow(!bExited);
+		return NumDone && NumRemaining.Subtract(NumDone) == NumDone;
+	}
+
+	/**
+		*	Core of the adaptive loops; Body(RangeIndex, Begin, End) is called for consecutive batches of each range.
+		*	@param Num; number of items
+		*	@param MinBatchSize; ranges smaller than two batches are never split
+		*	@param MaxRanges; capacity for split ranges, RangeIndex is always less than this
+		*	@param Body; Function to call from multiple threads
+		*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+		*	@param OutPartition; If not null, receives the ranges in order, they cover [0, Num) without overlapping.
+	**/
+	template<typename RangeBodyType>
+	inline void ParallelForAdaptiveInternal(int32 Num, int32 MinBatchSize, int32 MaxRanges, RangeBodyType Body, EParallelForFlags Flags, TArray<FAdaptiveRange>* OutPartition = nullptr)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+		check(Num >= 0);
+
+		if (OutPartition)
+		{
+			OutPartition->Reset();
+		}
+		if (Num == 0)
+		{
+			return;
+		}
+
+		if (Num < 2 * MinBatchSize || MaxRanges < 2 || (Flags & EParallelForFlags::ForceSingleThread) != EParallelForFlags::None || !FApp::ShouldUseThreadingForPerformance())
+		{
+			// no threads, just do it and return
+			Body(0, 0, Num);
+			if (OutPartition)
+			{
+				OutPartition->Add(FAdaptiveRange{ 0, Num, 0 });
+			}
+			return;
+		}
+
+		TAdaptiveParallelForData<RangeBodyType>* DataPtr = new TAdaptiveParallelForData<RangeBodyType>(Num, MinBatchSize, MaxRanges, Body);
+		TSharedRef<TAdaptiveParallelForData<RangeBodyType>, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
+		// this thread takes the root range, and then helps with anything nobody picked up, which is important to prevent deadlock on recursion
+		if (!Data->ProcessRange(0, Data) && !Data->ProcessUnclaimedRanges(Data))
+		{
+			// only ranges that are actively being worked on remain
+			if (IsInActualRenderingThread() && (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None)
+			{
+				while (!Data->Event->Wait(1))
+				{
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GetRenderThread_Local());
+				}
+			}
+			else
+			{
+				Data->Event->Wait();
+			}
+			check(Data->bTriggered);
+		}
+		else
+		{
+			check(!Data->bTriggered);
+		}
+		check(Data->NumRemaining.GetValue() == 0);
+
+		if (OutPartition)
+		{
+			const int32 NumRanges = Data->GetNumRanges();
+			OutPartition->Reserve(NumRanges);
+			for (int32 Index = 0; Index < NumRanges; Index++)
+			{
+				OutPartition->Add(FAdaptiveRange{ Data->Ranges[Index].Begin, Data->Ranges[Index].End, Index });
+			}
+			OutPartition->Sort([](const FAdaptiveRange& A, const FAdaptiveRange& B) { return A.Begin < B.Begin; });
+		}
+		Data->bExited = true;
+		// Data must live on until all of the tasks are cleared which might be long after this function exits
+	}
+
 	template<typename FunctionType>
 	inline void ParallelForInternal(int32 Num, FunctionType Body, EParallelForFlags Flags)
 	{
+		if ((Flags & EParallelForFlags::AdaptiveSplitting) != EParallelForFlags::None)
+		{
+			const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+			const int32 MinBatchSize = GetAdaptiveMinBatchSize(Num, NumWorkers);
+			ParallelForAdaptiveInternal(Num, MinBatchSize, GetAdaptiveMaxRanges(Num, MinBatchSize, NumWorkers),
+				[&Body](int32 RangeIndex, int32 Begin, int32 End)
+				{
+					for (int32 Index = Begin; Index < End; Index++)
+					{
+						Body(Index);
+					}
+				},
+				Flags);
+			return;
+		}
+
 		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
 		check(Num >= 0);
 
@@ -237,6 +598,76 @@ namespace ParallelForImpl
 		// Data must live on until all of the tasks are cleared which might be long after this function exits
 	}
 	
+	template<typename ContextType, typename FunctionType>
+	inline void ParallelForWithTaskContextInternal(TArray<ContextType>& OutContexts, int32 Num, const FunctionType& Body, EParallelForFlags Flags)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
+		check(Num >= 0);
+
+		OutContexts.Reset();
+		if (Num == 0)
+		{
+			return;
+		}
+
+		int32 AnyThreadTasks = 0;
+		if (Num > 1 && (Flags & EParallelForFlags::ForceSingleThread) == EParallelForFlags::None && FApp::ShouldUseThreadingForPerformance())
+		{
+			AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), Num - 1);
+		}
+		if (!AnyThreadTasks)
+		{
+			// no threads, just do it and return
+			ContextType& Context = OutContexts.Emplace_GetRef();
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				Body(Context, Index);
+			}
+			return;
+		}
+
+		// one context for each task and one for this thread, the tasks that find no work left don't take theirs
+		TArray<TTaskContextSlot<ContextType>, TAlignedHeapAllocator<alignof(TTaskContextSlot<ContextType>)>> Contexts;
+		Contexts.SetNum(AnyThreadTasks + 1);
+
+		typedef TTaskContextBody<ContextType, FunctionType> FContextBody;
+		const bool bPumpRenderingThread = (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None;
+		TParallelForData<FContextBody>* DataPtr = new TParallelForData<FContextBody>(Num, AnyThreadTasks + 1, (Num > AnyThreadTasks + 1) && bPumpRenderingThread, FContextBody(Contexts.GetData(), Contexts.Num(), Body), Flags);
+		TSharedRef<TParallelForData<FContextBody>, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
+		TGraphTask<TParallelForTask<FContextBody>>::CreateTask().ConstructAndDispatchWhenReady(Data, AnyThreadTasks - 1);
+		// this thread can help too and this is important to prevent deadlock on recursion
+		if (!Data->Process(0, Data, true))
+		{
+			if (bPumpRenderingThread && IsInActualRenderingThread())
+			{
+				while (!Data->Event->Wait(1))
+				{
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GetRenderThread_Local());
+				}
+			}
+			else
+			{
+				Data->Event->Wait();
+			}
+			check(Data->bTriggered);
+		}
+		else
+		{
+			check(!Data->bTriggered);
+		}
+		check(Data->NumCompleted.GetValue() == Data->Num);
+		Data->bExited = true;
+
+		// tasks that outlive this call find no items left, so they never touch the contexts
+		const int32 NumContexts = Data->Body.NumContexts.GetValue();
+		check(NumContexts > 0 && NumContexts <= Contexts.Num());
+		OutContexts.Reserve(NumContexts);
+		for (int32 Index = 0; Index < NumContexts; Index++)
+		{
+			OutContexts.Add(MoveTemp(Contexts[Index].Context));
+		}
+	}
+
 	/** 
 		*	General purpose parallel for that uses the taskgraph
 		*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
@@ -366,3 +797,121 @@ inline void ParallelForWithPreWork(int32 Num, TFunctionRef<void(int32)> Body, TF
 {
 	ParallelForImpl::ParallelForWithPreWorkInternal(Num, Body, CurrentThreadWorkToDoBeforeHelping, Flags);
 }
+
+/**
+	*	Parallel for that gives every participating thread a context of its own, for reductions such as histograms, bounds or
+	*	sums without atomics or false sharing. Contexts are value initialized and kept on separate cache lines while the loop
+	*	runs. Which items a context sees depends on the scheduling, so merging them must not depend on their order.
+	*
+	*	@param OutContexts; Receives the contexts that were used, at least one unless Num is zero, for the caller to merge
+	*	@param Num; number of calls of Body; Body(Context, 0), Body(Context, 1)....Body(Context, Num - 1)
+	*	@param Body; void(ContextType&, int32) function to call from multiple threads, with the context of the calling thread
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed, AdaptiveSplitting is not supported.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+template<typename ContextType, typename FunctionType>
+inline void ParallelForWithTaskContext(TArray<ContextType>& OutContexts, int32 Num, const FunctionType& Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	checkf((Flags & EParallelForFlags::AdaptiveSplitting) == EParallelForFlags::None, TEXT("Adaptive loops split into ranges rather than workers, use ParallelReduce for per range partial results."));
+	ParallelForImpl::ParallelForWithTaskContextInternal(OutContexts, Num, Body, Flags);
+}
+
+/**
+	*	Parallel reduction built on the adaptive ParallelFor; the result is Reduce(...Reduce(Reduce(Identity, Map(0)), Map(1))..., Map(Num - 1))
+	*	up to association, Reduce must be associative but need not be commutative. Each split off range accumulates its own partial
+	*	result and the partials are combined in index order on the calling thread, so the result doesn't depend on the scheduling.
+	*
+	*	@param Num; number of calls of Map; Map(0), Map(1)....Map(Num - 1)
+	*	@param Identity; Identity element of Reduce, also the result when Num is zero
+	*	@param Map; ResultType(int32) function to call from multiple threads
+	*	@param Reduce; ResultType(const ResultType&, const ResultType&) function to call from multiple threads
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed, AdaptiveSplitting is implied.
+	*	@param MinBatchSize; Ranges smaller than twice this are never split, 0 picks a default.
+**/
+template<typename ResultType, typename MapType, typename ReduceType>
+inline ResultType ParallelReduce(int32 Num, const ResultType& Identity, MapType Map, ReduceType Reduce, EParallelForFlags Flags = EParallelForFlags::None, int32 MinBatchSize = 0)
+{
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+	MinBatchSize = MinBatchSize > 0 ? MinBatchSize : ParallelForImpl::GetAdaptiveMinBatchSize(Num, NumWorkers);
+	const int32 MaxRanges = ParallelForImpl::GetAdaptiveMaxRanges(Num, MinBatchSize, NumWorkers);
+
+	TArray<ResultType> Partials;
+	Partials.Init(Identity, MaxRanges);
+	TArray<ParallelForImpl::FAdaptiveRange> Partition;
+	ParallelForImpl::ParallelForAdaptiveInternal(Num, MinBatchSize, MaxRanges,
+		[&Partials, &Map, &Reduce](int32 RangeIndex, int32 Begin, int32 End)
+		{
+			ResultType& Partial = Partials[RangeIndex];
+			for (int32 Index = Begin; Index < End; Index++)
+			{
+				Partial = Reduce(Partial, Map(Index));
+			}
+		},
+		Flags, &Partition);
+
+	ResultType Result = Identity;
+	for (const ParallelForImpl::FAdaptiveRange& Range : Partition)
+	{
+		Result = Reduce(Result, Partials[Range.RangeIndex]);
+	}
+	return Result;
+}
+
+/**
+	*	Parallel inclusive scan built on the adaptive ParallelFor; Out[i] = Reduce(...Reduce(Reduce(Identity, In[0]), In[1])..., In[i]).
+	*	Runs in two passes over the same partition: the first reduces each range, then the range offsets are scanned serially
+	*	and the second pass writes the outputs. Reduce must be associative but need not be commutative.
+	*	In and Out may be the same array.
+	*
+	*	@param In; Input elements
+	*	@param Out; Output elements, must have as many elements as In
+	*	@param Identity; Identity element of Reduce
+	*	@param Reduce; T(const T&, const T&) function to call from multiple threads
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed, AdaptiveSplitting is implied.
+	*	@param MinBatchSize; Ranges smaller than twice this are never split, 0 picks a default.
+**/
+template<typename T, typename ReduceType>
+inline void ParallelScan(TArrayView<const T> In, TArrayView<T> Out, const T& Identity, ReduceType Reduce, EParallelForFlags Flags = EParallelForFlags::None, int32 MinBatchSize = 0)
+{
+	check(In.Num() == Out.Num());
+	const int32 Num = In.Num();
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+	MinBatchSize = MinBatchSize > 0 ? MinBatchSize : ParallelForImpl::GetAdaptiveMinBatchSize(Num, NumWorkers);
+	const int32 MaxRanges = ParallelForImpl::GetAdaptiveMaxRanges(Num, MinBatchSize, NumWorkers);
+
+	TArray<T> Partials;
+	Partials.Init(Identity, MaxRanges);
+	TArray<ParallelForImpl::FAdaptiveRange> Partition;
+	ParallelForImpl::ParallelForAdaptiveInternal(Num, MinBatchSize, MaxRanges,
+		[&Partials, &In, &Reduce](int32 RangeIndex, int32 Begin, int32 End)
+		{
+			T& Partial = Partials[RangeIndex];
+			for (int32 Index = Begin; Index < End; Index++)
+			{
+				Partial = Reduce(Partial, In[Index]);
+			}
+		},
+		Flags, &Partition);
+
+	// turn the partials into the exclusive prefix of each range
+	T Carry = Identity;
+	for (const ParallelForImpl::FAdaptiveRange& Range : Partition)
+	{
+		T RangeTotal = MoveTemp(Partials[Range.RangeIndex]);
+		Partials[Range.RangeIndex] = Carry;
+		Carry = Reduce(Carry, RangeTotal);
+	}
+
+	ParallelForImpl::ParallelForInternal(Partition.Num(),
+		[&Partition, &Partials, &In, &Out, &Reduce](int32 PartitionIndex)
+		{
+			const ParallelForImpl::FAdaptiveRange& Range = Partition[PartitionIndex];
+			T Running = Partials[Range.RangeIndex];
+			for (int32 Index = Range.Begin; Index < Range.End; Index++)
+			{
+				Running = Reduce(Running, In[Index]);
+				Out[Index] = Running;
+			}
+		},
+		Flags & ~EParallelForFlags::AdaptiveSplitting);
+}
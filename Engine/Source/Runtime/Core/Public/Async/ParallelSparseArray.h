@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	ParallelSparseArray.h: ParallelFor based operations on TSparseArray
+=============================================================================*/
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Containers/Array.h"
+#include "Containers/SparseArray.h"
+#include "Async/ParallelFor.h"
+
+/** Implements the operations below, which need access to the internals of TSparseArray */
+struct FSparseArrayParallel
+{
+	/** Number of indices handled by each batch, a multiple of the bit array word size so batches don't share words */
+	static int32 GetBatchSize(int32 MinBatchSize)
+	{
+		return FMath::Max(NumBitsPerDWORD, (MinBatchSize + NumBitsPerDWORD - 1) & ~(NumBitsPerDWORD - 1));
+	}
+
+	template <typename ElementType, typename Allocator>
+	static bool Compact(TSparseArray<ElementType, Allocator>& Array, int32 MinBatchSize, EParallelForFlags Flags)
+	{
+		typedef typename TSparseArray<ElementType, Allocator>::FElementOrFreeListLink FElementOrFreeListLink;
+
+		const int32 NumFree = Array.NumFreeIndices;
+		if (NumFree == 0)
+		{
+			return false;
+		}
+
+		// The holes below TargetIndex are filled with the elements above it, in index order on both sides so each
+		// batch of holes can find its first element from the number of holes in the batches before it
+		const int32 MaxIndex = Array.Data.Num();
+		const int32 TargetIndex = MaxIndex - NumFree;
+		const int32 BatchSize = GetBatchSize(MinBatchSize);
+		const int32 NumHoleBatches = FMath::DivideAndRoundUp(TargetIndex, BatchSize);
+		const int32 NumElementBatches = FMath::DivideAndRoundUp(MaxIndex - TargetIndex, BatchSize);
+
+		TArray<int32> FirstHoles;
+		TArray<int32> FirstElements;
+		FirstHoles.SetNumUninitialized(NumHoleBatches + 1);
+		FirstElements.SetNumUninitialized(NumElementBatches + 1);
+		ParallelFor(NumHoleBatches + NumElementBatches, [&Array, &FirstHoles, &FirstElements, TargetIndex, MaxIndex, BatchSize, NumHoleBatches](int32 BatchIndex)
+		{
+			if (BatchIndex < NumHoleBatches)
+			{
+				const int32 StartIndex = BatchIndex * BatchSize;
+				const int32 EndIndex = FMath::Min(StartIndex + BatchSize, TargetIndex);
+				FirstHoles[BatchIndex + 1] = (EndIndex - StartIndex) - Array.AllocationFlags.CountSetBits(StartIndex, EndIndex);
+			}
+			else
+			{
+				const int32 StartIndex = TargetIndex + (BatchIndex - NumHoleBatches) * BatchSize;
+				const int32 EndIndex = FMath::Min(StartIndex + BatchSize, MaxIndex);
+				FirstElements[BatchIndex - NumHoleBatches + 1] = Array.AllocationFlags.CountSetBits(StartIndex, EndIndex);
+			}
+		}, Flags);
+
+		FirstHoles[0] = 0;
+		for (int32 BatchIndex = 0; BatchIndex < NumHoleBatches; ++BatchIndex)
+		{
+			FirstHoles[BatchIndex + 1] += FirstHoles[BatchIndex];
+		}
+		FirstElements[0] = 0;
+		for (int32 BatchIndex = 0; BatchIndex < NumElementBatches; ++BatchIndex)
+		{
+			FirstElements[BatchIndex + 1] += FirstElements[BatchIndex];
+		}
+
+		const int32 NumHoles = FirstHoles[NumHoleBatches];
+		checkSlow(NumHoles == FirstElements[NumElementBatches]);
+		if (NumHoles > 0)
+		{
+			FElementOrFreeListLink* ElementData = Array.Data.GetData();
+			ParallelFor(NumHoleBatches, [&Array, &FirstHoles, &FirstElements, ElementData, TargetIndex, BatchSize](int32 BatchIndex)
+			{
+				if (FirstHoles[BatchIndex] == FirstHoles[BatchIndex + 1])
+				{
+					return;
+				}
+
+				// Find the element batch holding the first element to move here, then that element within the batch
+				const int32 FirstElement = FirstHoles[BatchIndex];
+				int32 ElementBatch = 0;
+				int32 NumElementBatchesLeft = FirstElements.Num() - 1;
+				while (NumElementBatchesLeft > 0)
+				{
+					const int32 Half = NumElementBatchesLeft / 2;
+					if (FirstElements[ElementBatch + Half + 1] <= FirstElement)
+					{
+						ElementBatch += Half + 1;
+						NumElementBatchesLeft -= Half + 1;
+					}
+					else
+					{
+						NumElementBatchesLeft = Half;
+					}
+				}
+
+				int32 ElementIndex = Array.AllocationFlags.FindFrom(true, TargetIndex + ElementBatch * BatchSize);
+				for (int32 Skip = FirstElements[ElementBatch]; Skip < FirstElement; ++Skip)
+				{
+					ElementIndex = Array.AllocationFlags.FindFrom(true, ElementIndex + 1);
+				}
+
+				// Holes are only flagged as allocated once all batches are done, as the last hole batch may share a word with the first elements
+				const int32 EndIndex = FMath::Min((BatchIndex + 1) * BatchSize, TargetIndex);
+				for (int32 FreeIndex = Array.AllocationFlags.FindFrom(false, BatchIndex * BatchSize); FreeIndex != INDEX_NONE && FreeIndex < EndIndex; FreeIndex = Array.AllocationFlags.FindFrom(false, FreeIndex + 1))
+				{
+					checkSlow(ElementIndex != INDEX_NONE);
+					RelocateConstructItems<FElementOrFreeListLink>(ElementData + FreeIndex, ElementData + ElementIndex, 1);
+					ElementIndex = Array.AllocationFlags.FindFrom(true, ElementIndex + 1);
+				}
+			}, Flags);
+		}
+
+		Array.AllocationFlags.SetRange(0, TargetIndex, true);
+		Array.Data           .RemoveAt(TargetIndex, NumFree);
+		Array.AllocationFlags.RemoveAt(TargetIndex, NumFree);
+
+		Array.NumFreeIndices = 0;
+		Array.FirstFreeIndex = -1;
+
+		return NumHoles > 0;
+	}
+};
+
+/**
+ * Calls Func(Index, Element) for each allocated element of a sparse array, splitting its index range over the
+ * batches of a ParallelFor. Elements within a batch are visited in index order.
+ *
+ * @param MinBatchSize - Minimum number of indices, allocated or not, handled by each batch.
+ */
+template <typename ElementType, typename Allocator, typename FuncType>
+void ParallelForEachAllocated(TSparseArray<ElementType, Allocator>& Array, const FuncType& Func, int32 MinBatchSize = 4096, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	const int32 MaxIndex = Array.GetMaxIndex();
+	const int32 BatchSize = FSparseArrayParallel::GetBatchSize(MinBatchSize);
+	ParallelFor(FMath::DivideAndRoundUp(MaxIndex, BatchSize), [&Array, &Func, MaxIndex, BatchSize](int32 BatchIndex)
+	{
+		const int32 StartIndex = BatchIndex * BatchSize;
+		Array.ForEachAllocatedInRange(StartIndex, FMath::Min(StartIndex + BatchSize, MaxIndex), Func);
+	}, Flags);
+}
+
+/**
+ * Same as TSparseArray::Compact, with the holes and the elements moved into them split over the batches of a ParallelFor.
+ * Returns true if any elements were relocated, false otherwise.
+ *
+ * @param MinBatchSize - Minimum number of indices handled by each batch.
+ */
+template <typename ElementType, typename Allocator>
+bool ParallelCompact(TSparseArray<ElementType, Allocator>& Array, int32 MinBatchSize = 16384, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	return FSparseArrayParallel::Compact(Array, MinBatchSize, Flags);
+}
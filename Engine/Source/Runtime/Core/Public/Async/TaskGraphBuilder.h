@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Templates/Function.h"
+#include "Stats/Stats.h"
+#include "Async/TaskGraphInterfaces.h"
+
+/**
+ * Describes a graph of tasks up front and dispatches it as a whole:
+ *
+ *	FTaskGraphBuilder Builder(GET_STATID(STAT_MyFrameGraph));
+ *	const int32 Cull = Builder.AddNode([]() { ... });
+ *	const int32 Sort = Builder.AddNode([]() { ... });
+ *	const int32 Submit = Builder.AddNode([]() { ... }, ENamedThreads::GetRenderThread());
+ *	Builder.AddEdge(Cull, Sort);
+ *	Builder.AddEdge(Sort, Submit);
+ *	FGraphEventRef Done = Builder.Dispatch();
+ *
+ * The nodes do not use graph events to wait for each other. Dispatch counts the predecessors of every node in
+ * one pass, a node that finishes counts down its successors itself and the ones that became ready are queued
+ * together with a single wake up of the threads, as are the nodes without predecessors at the start.
+ * Only the graph as a whole has a completion event.
+ */
+class CORE_API FTaskGraphBuilder
+{
+public:
+
+	explicit FTaskGraphBuilder(TStatId InStatId = TStatId())
+		: StatId(InStatId)
+	{
+	}
+
+	/**
+	 * Adds a node to the graph.
+	 * @param Function; what the node does
+	 * @param DesiredThread; thread and priority to run the node with
+	 * @return the index of the node, for AddEdge
+	 */
+	int32 AddNode(TUniqueFunction<void()>&& Function, ENamedThreads::Type DesiredThread = ENamedThreads::AnyThread)
+	{
+		return Nodes.Add({ MoveTemp(Function), DesiredThread });
+	}
+
+	/** Makes After wait for Before to finish. Edges may be added more than once, the graph must not have cycles. */
+	void AddEdge(int32 Before, int32 After)
+	{
+		check(Nodes.IsValidIndex(Before) && Nodes.IsValidIndex(After) && Before != After);
+		Edges.Add({ Before, After });
+	}
+
+	/** Reserves memory for the nodes and edges that are going to be added */
+	void Reserve(int32 NumNodes, int32 NumEdges)
+	{
+		Nodes.Reserve(NumNodes);
+		Edges.Reserve(NumEdges);
+	}
+
+	int32 NumNodes() const
+	{
+		return Nodes.Num();
+	}
+
+	/**
+	 * Starts the graph, the builder is empty afterwards and may be reused.
+	 * @param Prerequisites; events that have to complete before any node starts
+	 * @param CurrentThreadIfKnown; the current thread if it is known
+	 * @return an event that completes once every node finished
+	 */
+	FGraphEventRef Dispatch(const FGraphEventArray* Prerequisites = nullptr, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread);
+
+private:
+
+	struct FNode
+	{
+		TUniqueFunction<void()> Function;
+		ENamedThreads::Type DesiredThread;
+	};
+
+	struct FEdge
+	{
+		int32 Before;
+		int32 After;
+	};
+
+	TStatId StatId;
+	TArray<FNode> Nodes;
+	TArray<FEdge> Edges;
+};
@@ -10,6 +10,7 @@
 #include "Misc/AssertionMacros.h"
 #include "Containers/ContainerAllocationPolicies.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Containers/UnrealString.h"
 #include "Templates/Function.h"
 #include "Delegates/Delegate.h"
@@ -290,6 +291,12 @@ class FTaskGraphInterface
 	 *	@param	CurrentThreadIfKnown; This should be the current thread if it is known, or otherwise use ENamedThreads::AnyThread and the current thread will be determined.
 	**/
 	virtual void QueueTask(class FBaseGraphTask* Task, ENamedThreads::Type ThreadToExecuteOn, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread) = 0;
+	/** 
+	 *	Internal function to queue tasks in one go, the threads they need are woken once all of them are queued
+	 *	@param	Tasks; the tasks to queue, each on the thread it was set up to execute on
+	 *	@param	CurrentThreadIfKnown; This should be the current thread if it is known, or otherwise use ENamedThreads::AnyThread and the current thread will be determined.
+	**/
+	virtual void QueueTasks(TArrayView<class FBaseGraphTask* const> Tasks, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread) = 0;
 
 public:
 
@@ -418,13 +425,18 @@ class FBaseGraphTask
 {
 public:
 
-	// Allocator for small tasks.
+	// Allocators for small tasks.
 	enum
 	{
 		/** Total size in bytes for a small task that will use the custom allocator **/
-		SMALL_TASK_SIZE = 256
+		SMALL_TASK_SIZE = 256,
+		/** Tasks up to these sizes use the next pools, only larger tasks are allocated on the heap **/
+		MEDIUM_TASK_SIZE = 512,
+		LARGE_TASK_SIZE = 1024
 	};
 	typedef TLockFreeFixedSizeAllocator_TLSCache<SMALL_TASK_SIZE, PLATFORM_CACHE_LINE_SIZE, FNoopCounter, true> TSmallTaskAllocator;
+	typedef TLockFreeFixedSizeAllocator_TLSCache<MEDIUM_TASK_SIZE, PLATFORM_CACHE_LINE_SIZE, FNoopCounter, true> TMediumTaskAllocator;
+	typedef TLockFreeFixedSizeAllocator_TLSCache<LARGE_TASK_SIZE, PLATFORM_CACHE_LINE_SIZE, FNoopCounter, true> TLargeTaskAllocator;
 protected:
 	/** 
 	 *	Constructor
@@ -433,6 +445,7 @@ protected:
 	FBaseGraphTask(int32 InNumberOfPrerequistitesOutstanding)
 		: ThreadToExecuteOn(ENamedThreads::AnyThread)
 		, NumberOfPrerequistitesOutstanding(InNumberOfPrerequistitesOutstanding + 1) // + 1 is not a prerequisite, it is a lock to prevent it from executing while it is getting prerequisites, one it is safe to execute, call PrerequisitesComplete
+		, QueuedCycles(0)
 	{
 		checkThreadGraph(LifeStage.Increment() == int32(LS_Contructed));
 		LLM(InheritedLLMTag = FLowLevelMemTracker::bIsDisabled ? ELLMTag::Untagged : (ELLMTag)FLowLevelMemTracker::Get().GetActiveTag(ELLMTracker::Default));
@@ -474,6 +487,59 @@ protected:
 
 	/** Singleton to retrieve the small task allocator **/
 	static CORE_API TSmallTaskAllocator& GetSmallTaskAllocator();
+	static CORE_API TMediumTaskAllocator& GetMediumTaskAllocator();
+	static CORE_API TLargeTaskAllocator& GetLargeTaskAllocator();
+
+	/** Counts tasks too large for the pools, which is what the TaskGraph/HeapAllocatedTasks trace counter shows **/
+	static CORE_API void OnHeapTaskAllocated(SIZE_T TaskSize);
+	static CORE_API void OnHeapTaskFreed(SIZE_T TaskSize);
+
+	/** 
+	 *	Allocates the memory for a task of the given size from the smallest pool it fits in, or from the heap.
+	 *	The size is a compile time constant, so this compiles down to one of the paths.
+	 **/
+	template<SIZE_T TaskSize>
+	static void* AllocateTaskMemory()
+	{
+		LLM_SCOPE(ELLMTag::TaskGraphTasksMisc);
+		if (TaskSize <= SMALL_TASK_SIZE)
+		{
+			return GetSmallTaskAllocator().Allocate();
+		}
+		else if (TaskSize <= MEDIUM_TASK_SIZE)
+		{
+			return GetMediumTaskAllocator().Allocate();
+		}
+		else if (TaskSize <= LARGE_TASK_SIZE)
+		{
+			return GetLargeTaskAllocator().Allocate();
+		}
+		OnHeapTaskAllocated(TaskSize);
+		return FMemory::Malloc(TaskSize);
+	}
+
+	/** Returns memory from AllocateTaskMemory with the same size **/
+	template<SIZE_T TaskSize>
+	static void FreeTaskMemory(void* Memory)
+	{
+		if (TaskSize <= SMALL_TASK_SIZE)
+		{
+			GetSmallTaskAllocator().Free(Memory);
+		}
+		else if (TaskSize <= MEDIUM_TASK_SIZE)
+		{
+			GetMediumTaskAllocator().Free(Memory);
+		}
+		else if (TaskSize <= LARGE_TASK_SIZE)
+		{
+			GetLargeTaskAllocator().Free(Memory);
+		}
+		else
+		{
+			OnHeapTaskFreed(TaskSize);
+			FMemory::Free(Memory);
+		}
+	}
 
 	/** 
 	 *	An indication that a prerequisite has been completed. Reduces the number of prerequisites by one and if no prerequisites are outstanding, it queues the task for execution.
@@ -487,6 +553,33 @@ protected:
 		}
 	}
 
+	/** 
+	 *	ConditionalQueueTask for many tasks at once. The tasks that become ready are queued together, which wakes the threads for them only once all are queued.
+	 *	@param Tasks; tasks that each had one prerequisite completed
+	 *	@param CurrentThread; provides the index of the thread we are running on. Can be ENamedThreads::AnyThread if the current thread is unknown.
+	 **/
+	static void ConditionalQueueTasks(TArrayView<FBaseGraphTask* const> Tasks, ENamedThreads::Type CurrentThread)
+	{
+		TArray<FBaseGraphTask*, TInlineAllocator<16>> ReadyTasks;
+		for (FBaseGraphTask* Task : Tasks)
+		{
+			checkThreadGraph(Task);
+			if (Task->NumberOfPrerequistitesOutstanding.Decrement() == 0)
+			{
+				checkThreadGraph(Task->LifeStage.Increment() == int32(LS_Queued));
+				ReadyTasks.Add(Task);
+			}
+		}
+		if (ReadyTasks.Num() == 1)
+		{
+			FTaskGraphInterface::Get().QueueTask(ReadyTasks[0], ReadyTasks[0]->ThreadToExecuteOn, CurrentThread);
+		}
+		else if (ReadyTasks.Num() > 1)
+		{
+			FTaskGraphInterface::Get().QueueTasks(ReadyTasks, CurrentThread);
+		}
+	}
+
 private:
 	friend class FNamedTaskThread;
 	friend class FTaskThreadBase;
@@ -532,6 +625,8 @@ private:
 	ENamedThreads::Type			ThreadToExecuteOn;
 	/**	Number of prerequisites outstanding. When this drops to zero, the thread is queued for execution.  **/
 	FThreadSafeCounter			NumberOfPrerequistitesOutstanding; 
+	/**	Time the task was queued at if its queue latency is sampled, see TaskGraph.QueueLatencySampleRate, 0 otherwise **/
+	uint64						QueuedCycles;
 
 
 #if !UE_BUILD_SHIPPING
@@ -798,12 +893,8 @@ public:
 	static FConstructor CreateTask(const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
 	{
 		int32 NumPrereq = Prerequisites ? Prerequisites->Num() : 0;
-		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
-		{
-			void *Mem = FBaseGraphTask::GetSmallTaskAllocator().Allocate();
-			return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), NumPrereq), Prerequisites, CurrentThreadIfKnown);
-		}
-		return FConstructor(new TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), NumPrereq), Prerequisites, CurrentThreadIfKnown);
+		void *Mem = FBaseGraphTask::AllocateTaskMemory<sizeof(TGraphTask)>();
+		return FConstructor(new (Mem) TGraphTask(TTask::GetSubsequentsMode() == ESubsequentsMode::FireAndForget ? NULL : FGraphEvent::CreateGraphEvent(), NumPrereq), Prerequisites, CurrentThreadIfKnown);
 	}
 
 	void Unlock(ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
@@ -859,15 +950,8 @@ private:
 			Subsequents->DispatchSubsequents(NewTasks, CurrentThread);
 		}
 
-		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
-		{
-			this->TGraphTask::~TGraphTask();
-			FBaseGraphTask::GetSmallTaskAllocator().Free(this);
-		}
-		else
-		{
-			delete this;
-		}
+		this->TGraphTask::~TGraphTask();
+		FBaseGraphTask::FreeTaskMemory<sizeof(TGraphTask)>(this);
 	}
 
 	// Internals 
@@ -968,12 +1052,8 @@ private:
 	**/
 	static FConstructor CreateTask(FGraphEventRef SubsequentsToAssume, const FGraphEventArray* Prerequisites = NULL, ENamedThreads::Type CurrentThreadIfKnown = ENamedThreads::AnyThread)
 	{
-		if (sizeof(TGraphTask) <= FBaseGraphTask::SMALL_TASK_SIZE)
-		{
-			void *Mem = FBaseGraphTask::GetSmallTaskAllocator().Allocate();
-			return FConstructor(new (Mem) TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
-		}
-		return FConstructor(new TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
+		void *Mem = FBaseGraphTask::AllocateTaskMemory<sizeof(TGraphTask)>();
+		return FConstructor(new (Mem) TGraphTask(SubsequentsToAssume, Prerequisites ? Prerequisites->Num() : 0), Prerequisites, CurrentThreadIfKnown);
 	}
 
 	/** An aligned bit of storage to hold the embedded task **/
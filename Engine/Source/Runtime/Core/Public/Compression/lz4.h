@@ -244,6 +244,15 @@ LZ4LIB_API int LZ4_compress_destSize (const char* src, char* dst, int* srcSizePt
  */
 LZ4LIB_API int LZ4_decompress_safe_partial (const char* src, char* dst, int srcSize, int targetOutputSize, int dstCapacity);
 
+/*! LZ4_decompress_safe_multi() : UE addition
+ *  Decompresses `numBlocks` independent blocks, as LZ4_decompress_safe() would decompress each of them.
+ *  Blocks are decoded two at a time, interleaving their sequences so the latency of one block's loads overlaps
+ *  with the other block's copies, which is faster on one core than decoding them one after the other.
+ *  `results[i]` receives the value LZ4_decompress_safe() returns for block `i`.
+ * @return : the number of blocks that failed to decompress
+ */
+LZ4LIB_API int LZ4_decompress_safe_multi (int numBlocks, const char* const* srcs, char* const* dsts, const int* srcSizes, const int* dstCapacities, int* results);
+
 
 /*-*********************************************
 *  Streaming Compression Functions
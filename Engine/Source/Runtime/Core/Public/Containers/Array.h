@@ -7,6 +7,7 @@
 #include "HAL/UnrealMemory.h"
 #include "Templates/AreTypesEqual.h"
 #include "Templates/IsSigned.h"
+#include "Templates/IsEnumClass.h"
 #include "Templates/UnrealTypeTraits.h"
 #include "Templates/UnrealTemplate.h"
 #include "Containers/ContainerAllocationPolicies.h"
@@ -17,6 +18,7 @@
 #include "Algo/HeapSort.h"
 #include "Algo/IsHeap.h"
 #include "Algo/Impl/BinaryHeap.h"
+#include "Algo/Impl/VectorizedFind.h"
 #include "Templates/AndOrNot.h"
 #include "Templates/IdentityFunctor.h"
 #include "Templates/Less.h"
@@ -31,10 +33,12 @@
 	#define TARRAY_RANGED_FOR_CHECKS 1
 #endif
 
-template <typename T> struct TCanBulkSerialize { enum { Value = false }; };
-template<> struct TCanBulkSerialize<unsigned int> { enum { Value = true }; };
-template<> struct TCanBulkSerialize<unsigned short> { enum { Value = true }; };
-template<> struct TCanBulkSerialize<int> { enum { Value = true }; };
+/**
+ * Traits class which tells whether the serialized form of a type is the same as its memory, so containers of it can be
+ * serialized in one call when the archive does not byte swap. Arithmetic and enum class types are detected, other types
+ * serializing all of their members in memory order and without padding can specialize it.
+ */
+template <typename T> struct TCanBulkSerialize { enum { Value = TIsArithmetic<T>::Value || TIsEnumClass<T>::Value }; };
 
 
 /**
@@ -856,15 +860,10 @@ public:
 	 */
 	SizeType Find(const ElementType& Item) const
 	{
+		// Integers, enums and pointers are compared 16 bytes at a time
 		const ElementType* RESTRICT Start = GetData();
-		for (const ElementType* RESTRICT Data = Start, *RESTRICT DataEnd = Data + ArrayNum; Data != DataEnd; ++Data)
-		{
-			if (*Data == Item)
-			{
-				return static_cast<SizeType>(Data - Start);
-			}
-		}
-		return INDEX_NONE;
+		const ElementType* RESTRICT Found = AlgoImpl::FindValue(Start, ArrayNum, Item);
+		return Found ? static_cast<SizeType>(Found - Start) : INDEX_NONE;
 	}
 
 	/**
@@ -1075,14 +1074,8 @@ public:
 	template <typename ComparisonType>
 	bool Contains(const ComparisonType& Item) const
 	{
-		for (const ElementType* RESTRICT Data = GetData(), *RESTRICT DataEnd = Data + ArrayNum; Data != DataEnd; ++Data)
-		{
-			if (*Data == Item)
-			{
-				return true;
-			}
-		}
-		return false;
+		// Integers, enums and pointers are compared 16 bytes at a time
+		return AlgoImpl::ContainsValue(GetData(), ArrayNum, Item);
 	}
 
 	/**
@@ -1154,7 +1147,7 @@ public:
 		if (!Ar.IsError() && SerializeNum > 0 && ensure(!Ar.IsNetArchive() || SerializeNum <= MaxNetArraySerialize))
 		{
 			// if we don't need to perform per-item serialization, just read it in bulk
-			if (sizeof(ElementType) == 1 || TCanBulkSerialize<ElementType>::Value)
+			if (sizeof(ElementType) == 1 || (TCanBulkSerialize<ElementType>::Value && !Ar.IsByteSwapping()))
 			{
 				A.ArrayNum = SerializeNum;
 
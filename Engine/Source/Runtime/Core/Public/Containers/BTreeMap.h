@@ -0,0 +1,325 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Containers/Map.h"
+#include "Containers/BTreeSet.h"
+#include <initializer_list>
+
+/**
+ * An ordered map of keys to values, usable in place of TSortedMap for maps too large to insert or remove in O(n),
+ * or in place of TMap where the pairs must be visited in key order or searched by key range.
+ * Implemented using a TBTreeSet of key-value pairs, see TBTreeSet for how it's laid out.
+ *
+ * Adding or removing a pair may move the others and invalidates iterators and references to keys and values.
+ * Duplicate keys are not supported.
+ **/
+template<typename KeyType, typename ValueType, typename SortPredicate = TLess<KeyType>, typename Allocator = FDefaultBTreeAllocator, typename KeyFuncs = TDefaultMapKeyFuncs<KeyType, ValueType, false> >
+class TBTreeMap
+{
+public:
+	typedef typename TTypeTraits<KeyType  >::ConstPointerType KeyConstPointerType;
+	typedef typename TTypeTraits<KeyType  >::ConstInitType    KeyInitType;
+	typedef typename TTypeTraits<ValueType>::ConstInitType    ValueInitType;
+	typedef TPair<KeyType, ValueType> ElementType;
+
+	TBTreeMap() = default;
+	TBTreeMap(TBTreeMap&&) = default;
+	TBTreeMap(const TBTreeMap&) = default;
+	TBTreeMap& operator=(TBTreeMap&&) = default;
+	TBTreeMap& operator=(const TBTreeMap&) = default;
+
+	/** Initializer list constructor. */
+	TBTreeMap(std::initializer_list<TPairInitializer<const KeyType&, const ValueType&>> InitList)
+	{
+		for (const TPairInitializer<const KeyType&, const ValueType&>& Element : InitList)
+		{
+			Add(Element.Key, Element.Value);
+		}
+	}
+
+	/** @return The number of elements in the map. */
+	FORCEINLINE int32 Num() const
+	{
+		return Pairs.Num();
+	}
+
+	/** Removes all elements from the map and releases the nodes. */
+	FORCEINLINE void Empty()
+	{
+		Pairs.Empty();
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return Pairs.GetAllocatedSize();
+	}
+
+	/**
+	 * Sets the value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @param InValue The value to associate with the key.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next pair is added or removed.
+	 */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey, const ValueType&  InValue) { return Emplace(InKey, InValue); }
+	FORCEINLINE ValueType& Add(const KeyType&  InKey,		ValueType&& InValue) { return Emplace(InKey, MoveTempIfPossible(InValue)); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey, const ValueType&  InValue) { return Emplace(MoveTempIfPossible(InKey), InValue); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey,		ValueType&& InValue) { return Emplace(MoveTempIfPossible(InKey), MoveTempIfPossible(InValue)); }
+
+	/**
+	 * Sets a default value associated with a key.
+	 *
+	 * @param InKey The key to associate a new value with.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next pair is added or removed.
+	 */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey) { return Emplace(InKey); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey) { return Emplace(MoveTempIfPossible(InKey)); }
+
+	/**
+	 * Sets the value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @param InValue The value to associate with the key.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next pair is added or removed.
+	 */
+	template <typename InitKeyType, typename InitValueType>
+	ValueType& Emplace(InitKeyType&& InKey, InitValueType&& InValue)
+	{
+		return Pairs.Emplace(TPairInitializer<InitKeyType&&, InitValueType&&>(Forward<InitKeyType>(InKey), Forward<InitValueType>(InValue))).Value;
+	}
+
+	/**
+	 * Set a default value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next pair is added or removed.
+	 */
+	template <typename InitKeyType>
+	ValueType& Emplace(InitKeyType&& InKey)
+	{
+		return Pairs.Emplace(TKeyInitializer<InitKeyType&&>(Forward<InitKeyType>(InKey))).Value;
+	}
+
+	/**
+	 * Remove the value association for a key.
+	 *
+	 * @param InKey The key to remove the associated value for.
+	 * @return The number of values that were associated with the key.
+	 */
+	FORCEINLINE int32 Remove(KeyConstPointerType InKey)
+	{
+		return Pairs.Remove(InKey);
+	}
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return A pointer to the value associated with the specified key, or nullptr if the key isn't contained in this map. The pointer
+	 *			is only valid until the next pair is added or removed.
+	 */
+	FORCEINLINE ValueType* Find(KeyConstPointerType Key)
+	{
+		ElementType* Pair = Pairs.Find(Key);
+		return Pair ? &Pair->Value : nullptr;
+	}
+
+	FORCEINLINE const ValueType* Find(KeyConstPointerType Key) const
+	{
+		return const_cast<TBTreeMap*>(this)->Find(Key);
+	}
+
+	/**
+	 * Find the value associated with a specified key, or if none exists,
+	 * adds a value using the default constructor.
+	 *
+	 * @param Key The key to search for.
+	 * @return A reference to the value associated with the specified key.
+	 */
+	FORCEINLINE ValueType& FindOrAdd(const KeyType&  Key) { return FindOrAddImpl(                   Key); }
+	FORCEINLINE ValueType& FindOrAdd(      KeyType&& Key) { return FindOrAddImpl(MoveTempIfPossible(Key)); }
+
+	/**
+	 * Find a reference to the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or triggers an assertion if the key does not exist.
+	 */
+	FORCEINLINE ValueType& FindChecked(KeyConstPointerType Key)
+	{
+		ElementType* Pair = Pairs.Find(Key);
+		check(Pair != nullptr);
+		return Pair->Value;
+	}
+
+	FORCEINLINE const ValueType& FindChecked(KeyConstPointerType Key) const
+	{
+		return const_cast<TBTreeMap*>(this)->FindChecked(Key);
+	}
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or the default value for the ValueType if the key isn't contained in this map.
+	 */
+	FORCEINLINE ValueType FindRef(KeyConstPointerType Key) const
+	{
+		const ElementType* Pair = Pairs.Find(Key);
+		return Pair ? Pair->Value : ValueType();
+	}
+
+	/**
+	 * Check if map contains the specified key.
+	 *
+	 * @param Key The key to check for.
+	 * @return true if the map contains the key.
+	 */
+	FORCEINLINE bool Contains(KeyConstPointerType Key) const
+	{
+		return Pairs.Contains(Key);
+	}
+
+	/**
+	 * Replaces the pairs of the map by already sorted pairs, building full nodes from the bottom up in O(n).
+	 *
+	 * @param SortedPairs The pairs in increasing order of their keys, without duplicate keys. Left empty.
+	 */
+	template <typename OtherAllocator>
+	FORCEINLINE void BulkLoad(TArray<ElementType, OtherAllocator>&& SortedPairs)
+	{
+		Pairs.BulkLoad(MoveTemp(SortedPairs));
+	}
+
+	/** Same as FindChecked */
+	FORCEINLINE       ValueType& operator[](KeyConstPointerType Key)       { return FindChecked(Key); }
+	FORCEINLINE const ValueType& operator[](KeyConstPointerType Key) const { return FindChecked(Key); }
+
+private:
+	typedef TBTreeSet<ElementType, SortPredicate, Allocator, KeyFuncs> ElementSetType;
+
+	/** The base of TBTreeMap iterators, visiting the pairs in key order. */
+	template<bool bConst>
+	class TBaseIterator
+	{
+	public:
+		typedef typename TChooseClass<bConst, typename ElementSetType::TConstIterator, typename ElementSetType::TIterator>::Result PairItType;
+	private:
+		typedef typename TChooseClass<bConst, const KeyType, KeyType>::Result ItKeyType;
+		typedef typename TChooseClass<bConst, const ValueType, ValueType>::Result ItValueType;
+		typedef typename TChooseClass<bConst, const ElementType, ElementType>::Result PairType;
+
+	public:
+		FORCEINLINE TBaseIterator(const PairItType& InElementIt)
+			: PairIt(InElementIt)
+		{
+		}
+
+		FORCEINLINE TBaseIterator& operator++()
+		{
+			++PairIt;
+			return *this;
+		}
+
+		/** conversion to "bool" returning true if the iterator is valid. */
+		FORCEINLINE explicit operator bool() const
+		{
+			return !!PairIt;
+		}
+		/** inverse of the "bool" operator */
+		FORCEINLINE bool operator !() const
+		{
+			return !(bool)*this;
+		}
+
+		FORCEINLINE friend bool operator==(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.PairIt == Rhs.PairIt; }
+		FORCEINLINE friend bool operator!=(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.PairIt != Rhs.PairIt; }
+
+		FORCEINLINE ItKeyType&   Key()   const { return PairIt->Key; }
+		FORCEINLINE ItValueType& Value() const { return PairIt->Value; }
+
+		FORCEINLINE PairType& operator* () const { return  *PairIt; }
+		FORCEINLINE PairType* operator->() const { return &*PairIt; }
+
+	protected:
+		PairItType PairIt;
+	};
+
+public:
+	/** Map iterator. Keys must not be changed. */
+	class TIterator : public TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE TIterator(const typename ElementSetType::TIterator& InPairIt)
+			: TBaseIterator<false>(InPairIt)
+		{
+		}
+	};
+
+	/** Const map iterator. */
+	class TConstIterator : public TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE TConstIterator(const typename ElementSetType::TConstIterator& InPairIt)
+			: TBaseIterator<true>(InPairIt)
+		{
+		}
+	};
+
+	/** Creates an iterator over all the pairs in this map, from the smallest key up */
+	FORCEINLINE TIterator CreateIterator()
+	{
+		return TIterator(Pairs.CreateIterator());
+	}
+
+	/** Creates a const iterator over all the pairs in this map, from the smallest key up */
+	FORCEINLINE TConstIterator CreateConstIterator() const
+	{
+		return TConstIterator(Pairs.CreateConstIterator());
+	}
+
+	/**
+	 * Finds the first pair with a key not less than Key, the start of a range query. Iterating from there until a
+	 * key that is not less than the end of a range visits the pairs in [Key, End).
+	 *
+	 * @return An iterator to the pair, or an invalid iterator if every key is less than Key.
+	 */
+	FORCEINLINE TIterator      LowerBound(KeyConstPointerType Key)       { return TIterator(Pairs.LowerBound(Key)); }
+	FORCEINLINE TConstIterator LowerBound(KeyConstPointerType Key) const { return TConstIterator(Pairs.LowerBound(Key)); }
+
+	/**
+	 * Finds the first pair with a key greater than Key.
+	 *
+	 * @return An iterator to the pair, or an invalid iterator if no key is greater than Key.
+	 */
+	FORCEINLINE TIterator      UpperBound(KeyConstPointerType Key)       { return TIterator(Pairs.UpperBound(Key)); }
+	FORCEINLINE TConstIterator UpperBound(KeyConstPointerType Key) const { return TConstIterator(Pairs.UpperBound(Key)); }
+
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE TIterator      begin()       { return TIterator(Pairs.begin()); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(Pairs.begin()); }
+	FORCEINLINE TIterator      end()         { return TIterator(Pairs.end()); }
+	FORCEINLINE TConstIterator end() const   { return TConstIterator(Pairs.end()); }
+
+private:
+	template <typename InitKeyType>
+	ValueType& FindOrAddImpl(InitKeyType&& Key)
+	{
+		if (ElementType* Pair = Pairs.Find(Key))
+		{
+			return Pair->Value;
+		}
+
+		return Pairs.Emplace(TKeyInitializer<InitKeyType&&>(Forward<InitKeyType>(Key))).Value;
+	}
+
+	/** A set of the key-value pairs in the map. */
+	ElementSetType Pairs;
+};
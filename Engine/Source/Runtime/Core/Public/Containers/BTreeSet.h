@@ -0,0 +1,1065 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/MemoryOps.h"
+#include "Templates/IdentityFunctor.h"
+#include "Templates/Less.h"
+#include "Math/UnrealMathUtility.h"
+#include "Algo/BinarySearch.h"
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/Set.h"
+
+/** Allocates every node of a TBTreeSet or TBTreeMap separately from the heap. */
+class FDefaultBTreeAllocator
+{
+public:
+	class ForNodes
+	{
+	public:
+		FORCEINLINE void* Allocate(SIZE_T Size, uint32 Alignment)
+		{
+			return FMemory::Malloc(Size, Alignment);
+		}
+
+		FORCEINLINE void Free(void* Node, SIZE_T Size)
+		{
+			FMemory::Free(Node);
+		}
+
+		/** Releases the memory of the freed nodes, only called once every node has been freed. */
+		FORCEINLINE void Empty()
+		{
+		}
+
+		/** Takes the memory of another allocator, only called once every node of this one has been freed. */
+		FORCEINLINE void MoveToEmpty(ForNodes& Other)
+		{
+		}
+
+		/** @return The memory allocated for nodes taking NumNodeBytes bytes in total. */
+		FORCEINLINE SIZE_T GetAllocatedSize(SIZE_T NumNodeBytes) const
+		{
+			return NumNodeBytes;
+		}
+	};
+};
+
+/**
+ * Allocates the nodes of a TBTreeSet or TBTreeMap from blocks of BlockSize bytes owned by the container.
+ *
+ * Neighbouring nodes end up next to each other in memory, freed nodes are reused by the next nodes of the same size,
+ * and the blocks are only released when the container is emptied or destroyed. This makes filling and destroying
+ * large trees much cheaper than allocating every node, at the cost of keeping the memory of removed elements.
+ */
+template <uint32 BlockSize = 64 * 1024>
+class TArenaBTreeAllocator
+{
+public:
+	class ForNodes
+	{
+	public:
+		ForNodes() = default;
+		ForNodes(const ForNodes&) = delete;
+		ForNodes& operator=(const ForNodes&) = delete;
+
+		~ForNodes()
+		{
+			Empty();
+		}
+
+		void* Allocate(SIZE_T Size, uint32 Alignment)
+		{
+			FFreeList& FreeList = GetFreeList(Size);
+			if (FFreeNode* Node = FreeList.Head)
+			{
+				FreeList.Head = Node->Next;
+				return Node;
+			}
+
+			uint8* Node = Align(Cursor, Alignment);
+			if (!Cursor || Node + Size > End)
+			{
+				// Nodes larger than a block get a block of their own
+				const SIZE_T NewBlockSize = FMath::Max<SIZE_T>(BlockSize, Align(sizeof(FBlock), Alignment) + Size);
+				FBlock* Block = (FBlock*)FMemory::Malloc(NewBlockSize, FMath::Max<uint32>(Alignment, alignof(FBlock)));
+				Block->Next = Blocks;
+				Blocks = Block;
+				TotalBlockSize += NewBlockSize;
+				End = (uint8*)Block + NewBlockSize;
+				Node = Align((uint8*)(Block + 1), Alignment);
+			}
+			Cursor = Node + Size;
+			return Node;
+		}
+
+		FORCEINLINE void Free(void* Node, SIZE_T Size)
+		{
+			FFreeList& FreeList = GetFreeList(Size);
+			FFreeNode* FreeNode = (FFreeNode*)Node;
+			FreeNode->Next = FreeList.Head;
+			FreeList.Head = FreeNode;
+		}
+
+		/** Releases the blocks, only called once every node has been freed. */
+		void Empty()
+		{
+			while (FBlock* Block = Blocks)
+			{
+				Blocks = Block->Next;
+				FMemory::Free(Block);
+			}
+			for (FFreeList& FreeList : FreeLists)
+			{
+				FreeList = FFreeList();
+			}
+			Cursor = nullptr;
+			End = nullptr;
+			TotalBlockSize = 0;
+		}
+
+		/** Takes the blocks of another allocator, only called once every node of this one has been freed. */
+		void MoveToEmpty(ForNodes& Other)
+		{
+			checkSlow(this != &Other);
+			Empty();
+			Blocks = Other.Blocks;
+			Cursor = Other.Cursor;
+			End = Other.End;
+			TotalBlockSize = Other.TotalBlockSize;
+			for (int32 Index = 0; Index < NumSizeClasses; ++Index)
+			{
+				FreeLists[Index] = Other.FreeLists[Index];
+				Other.FreeLists[Index] = FFreeList();
+			}
+			Other.Blocks = nullptr;
+			Other.Cursor = nullptr;
+			Other.End = nullptr;
+			Other.TotalBlockSize = 0;
+		}
+
+		/** @return The size of the blocks, which hold the nodes and the memory of the freed ones. */
+		FORCEINLINE SIZE_T GetAllocatedSize(SIZE_T NumNodeBytes) const
+		{
+			return TotalBlockSize;
+		}
+
+	private:
+		struct FBlock
+		{
+			FBlock* Next;
+		};
+
+		struct FFreeNode
+		{
+			FFreeNode* Next;
+		};
+
+		struct FFreeList
+		{
+			SIZE_T Size = 0;
+			FFreeNode* Head = nullptr;
+		};
+
+		/** Trees have leaf nodes and inner nodes, which are all of one of two sizes */
+		enum { NumSizeClasses = 2 };
+
+		FORCEINLINE FFreeList& GetFreeList(SIZE_T Size)
+		{
+			for (FFreeList& FreeList : FreeLists)
+			{
+				if (FreeList.Size == Size || FreeList.Size == 0)
+				{
+					FreeList.Size = Size;
+					return FreeList;
+				}
+			}
+			checkf(false, TEXT("TArenaBTreeAllocator only supports nodes of %d different sizes"), (int32)NumSizeClasses);
+			return FreeLists[0];
+		}
+
+		static FORCEINLINE uint8* Align(uint8* Ptr, uint32 Alignment)
+		{
+			return (uint8*)(((UPTRINT)Ptr + Alignment - 1) & ~(UPTRINT)(Alignment - 1));
+		}
+
+		static FORCEINLINE SIZE_T Align(SIZE_T Size, uint32 Alignment)
+		{
+			return (Size + Alignment - 1) & ~(SIZE_T)(Alignment - 1);
+		}
+
+		FBlock* Blocks = nullptr;
+		uint8* Cursor = nullptr;
+		uint8* End = nullptr;
+		SIZE_T TotalBlockSize = 0;
+		FFreeList FreeLists[NumSizeClasses];
+	};
+};
+
+/**
+ * An ordered set, usable in place of TSortedMap's sorted array where there are too many elements to insert or remove
+ * in O(n), or in place of TSet where the elements must be visited in order or searched by range.
+ *
+ * Implemented as a B+ tree: the elements are stored in order in leaf nodes of about TargetNodeSize bytes, which are
+ * linked to each other for iteration, and copies of the keys that split the leaves are stored in inner nodes. Adding,
+ * removing and finding an element take O(Log n) and only read a few nodes, each of them with a binary search of
+ * contiguous memory. Adding or removing an element may move the others and invalidates iterators and references.
+ * KeyFuncs only provides the key of the elements, which are ordered by SortPredicate. Duplicate keys are not supported.
+ **/
+template<typename InElementType, typename SortPredicate = TLess<typename DefaultKeyFuncs<InElementType>::KeyType>, typename Allocator = FDefaultBTreeAllocator, typename KeyFuncs = DefaultKeyFuncs<InElementType>>
+class TBTreeSet
+{
+public:
+	typedef InElementType ElementType;
+	typedef typename KeyFuncs::KeyType KeyType;
+	typedef typename KeyFuncs::KeyInitType KeyInitType;
+
+private:
+	struct FLeaf;
+	struct FInner;
+
+	/** The size the nodes are made to fill, a few cache lines */
+	enum { TargetNodeSize = 256 };
+
+	/** The capacities of the nodes, at least 4 for the nodes of large elements so that the tree stays a tree */
+	enum { LeafCapacity = (TargetNodeSize - 3 * sizeof(void*)) / sizeof(ElementType) > 4 ? (TargetNodeSize - 3 * sizeof(void*)) / sizeof(ElementType) : 4 };
+	enum { InnerCapacity = (TargetNodeSize - 2 * sizeof(void*)) / (sizeof(KeyType) + sizeof(void*)) > 4 ? (TargetNodeSize - 2 * sizeof(void*)) / (sizeof(KeyType) + sizeof(void*)) : 4 };
+
+	/** Nodes with fewer elements or keys than this are merged with or take some from a sibling after a removal */
+	enum { MinLeafNum = LeafCapacity / 2 };
+	enum { MinInnerNum = InnerCapacity / 2 };
+
+	struct FLeaf
+	{
+		int32 Num = 0;
+		FLeaf* Prev = nullptr;
+		FLeaf* Next = nullptr;
+		TTypeCompatibleBytes<ElementType> Elements[LeafCapacity];
+
+		FORCEINLINE ElementType* GetElements()
+		{
+			return (ElementType*)Elements;
+		}
+		FORCEINLINE const ElementType* GetElements() const
+		{
+			return (const ElementType*)Elements;
+		}
+	};
+
+	/** Child I holds the keys from Keys[I - 1] included to Keys[I] excluded */
+	struct FInner
+	{
+		int32 Num = 0;
+		TTypeCompatibleBytes<KeyType> Keys[InnerCapacity];
+		void* Children[InnerCapacity + 1];
+
+		FORCEINLINE KeyType* GetKeys()
+		{
+			return (KeyType*)Keys;
+		}
+		FORCEINLINE const KeyType* GetKeys() const
+		{
+			return (const KeyType*)Keys;
+		}
+	};
+
+	/** An inner node on the way down to a leaf and the index of the child that was taken */
+	struct FPathEntry
+	{
+		FInner* Inner;
+		int32 ChildIndex;
+	};
+	typedef TArray<FPathEntry, TInlineAllocator<16>> FPath;
+
+	/** Projects an element to its key for the binary searches of the leaves */
+	struct FElementKey
+	{
+		FORCEINLINE KeyInitType operator()(const ElementType& Element) const
+		{
+			return KeyFuncs::GetSetKey(Element);
+		}
+	};
+
+public:
+	TBTreeSet() = default;
+
+	TBTreeSet(TBTreeSet&& Other)
+	{
+		MoveToEmpty(Other);
+	}
+
+	TBTreeSet(const TBTreeSet& Other)
+	{
+		CopyFrom(Other);
+	}
+
+	TBTreeSet& operator=(TBTreeSet&& Other)
+	{
+		if (this != &Other)
+		{
+			Empty();
+			MoveToEmpty(Other);
+		}
+		return *this;
+	}
+
+	TBTreeSet& operator=(const TBTreeSet& Other)
+	{
+		if (this != &Other)
+		{
+			Empty();
+			CopyFrom(Other);
+		}
+		return *this;
+	}
+
+	~TBTreeSet()
+	{
+		Empty();
+	}
+
+	/** @return The number of elements in the set. */
+	FORCEINLINE int32 Num() const
+	{
+		return NumElements;
+	}
+
+	/** Removes all elements from the set and releases the nodes. */
+	void Empty()
+	{
+		if (Root)
+		{
+			FreeSubtree(Root, Height);
+			Root = nullptr;
+		}
+		Height = 0;
+		NumElements = 0;
+		NodeAllocator.Empty();
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return NodeAllocator.GetAllocatedSize(NumLeaves * sizeof(FLeaf) + NumInners * sizeof(FInner));
+	}
+
+	/**
+	 * Replaces the elements of the set by already sorted elements, building full nodes from the bottom up in O(n).
+	 *
+	 * @param SortedElements The elements in increasing order of their keys, without duplicate keys. Left empty.
+	 */
+	template <typename OtherAllocator>
+	void BulkLoad(TArray<ElementType, OtherAllocator>&& SortedElements)
+	{
+		Empty();
+
+		const int32 Count = SortedElements.Num();
+		if (Count == 0)
+		{
+			return;
+		}
+
+		// The elements and children are spread evenly over each level so that only the root can be nearly empty
+		TArray<void*> Level;
+		TArray<const ElementType*> LevelFirstElements;
+		const int32 NumLevelLeaves = FMath::DivideAndRoundUp<int32>(Count, LeafCapacity);
+		Level.Reserve(NumLevelLeaves);
+		LevelFirstElements.Reserve(NumLevelLeaves);
+		FLeaf* PrevLeaf = nullptr;
+		for (int32 LeafIndex = 0, First = 0; LeafIndex < NumLevelLeaves; ++LeafIndex)
+		{
+			const int32 Last = int32((int64)Count * (LeafIndex + 1) / NumLevelLeaves);
+			FLeaf* Leaf = NewLeaf();
+			for (int32 Index = First; Index < Last; ++Index)
+			{
+				checkSlow(Index + 1 == Count || SortPredicate()(KeyFuncs::GetSetKey(SortedElements[Index]), KeyFuncs::GetSetKey(SortedElements[Index + 1])));
+				new(Leaf->GetElements() + Leaf->Num++) ElementType(MoveTemp(SortedElements[Index]));
+			}
+			Leaf->Prev = PrevLeaf;
+			if (PrevLeaf)
+			{
+				PrevLeaf->Next = Leaf;
+			}
+			PrevLeaf = Leaf;
+			Level.Add(Leaf);
+			LevelFirstElements.Add(Leaf->GetElements());
+			First = Last;
+		}
+		SortedElements.Empty();
+		NumElements = Count;
+
+		while (Level.Num() > 1)
+		{
+			const int32 NumLevelNodes = FMath::DivideAndRoundUp<int32>(Level.Num(), InnerCapacity + 1);
+			TArray<void*> NextLevel;
+			TArray<const ElementType*> NextLevelFirstElements;
+			NextLevel.Reserve(NumLevelNodes);
+			NextLevelFirstElements.Reserve(NumLevelNodes);
+			for (int32 NodeIndex = 0, First = 0; NodeIndex < NumLevelNodes; ++NodeIndex)
+			{
+				const int32 Last = int32((int64)Level.Num() * (NodeIndex + 1) / NumLevelNodes);
+				FInner* Inner = NewInner();
+				Inner->Children[0] = Level[First];
+				for (int32 Index = First + 1; Index < Last; ++Index)
+				{
+					new(Inner->GetKeys() + Inner->Num) KeyType(KeyFuncs::GetSetKey(*LevelFirstElements[Index]));
+					Inner->Children[++Inner->Num] = Level[Index];
+				}
+				NextLevel.Add(Inner);
+				NextLevelFirstElements.Add(LevelFirstElements[First]);
+				First = Last;
+			}
+			Level = MoveTemp(NextLevel);
+			LevelFirstElements = MoveTemp(NextLevelFirstElements);
+			++Height;
+		}
+		Root = Level[0];
+	}
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	InElement			Element to add to set
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added or removed.
+	 */
+	FORCEINLINE ElementType& Add(const ElementType&  InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(InElement, bIsAlreadyInSetPtr); }
+	FORCEINLINE ElementType& Add(      ElementType&& InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(MoveTempIfPossible(InElement), bIsAlreadyInSetPtr); }
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	Args				The argument(s) to be forwarded to the set element's constructor.
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added or removed.
+	 */
+	template <typename ArgsType>
+	ElementType& Emplace(ArgsType&& Args, bool* bIsAlreadyInSetPtr = nullptr)
+	{
+		TTypeCompatibleBytes<ElementType> NewElementBytes;
+		ElementType& NewElement = *new(&NewElementBytes) ElementType(Forward<ArgsType>(Args));
+
+		if (!Root)
+		{
+			Root = NewLeaf();
+		}
+
+		FPath Path;
+		FLeaf* Leaf = FindLeaf(KeyFuncs::GetSetKey(NewElement), &Path);
+		const int32 Index = LeafLowerBound(Leaf, KeyFuncs::GetSetKey(NewElement));
+		const bool bIsAlreadyInSet = Index < Leaf->Num && !SortPredicate()(KeyFuncs::GetSetKey(NewElement), KeyFuncs::GetSetKey(Leaf->GetElements()[Index]));
+		if (bIsAlreadyInSetPtr)
+		{
+			*bIsAlreadyInSetPtr = bIsAlreadyInSet;
+		}
+
+		if (bIsAlreadyInSet)
+		{
+			// If there's an existing element with the same key as the new element, replace the existing element with the new element.
+			ElementType& Existing = Leaf->GetElements()[Index];
+			MoveByRelocate(Existing, NewElement);
+			return Existing;
+		}
+
+		++NumElements;
+		if (Leaf->Num < LeafCapacity)
+		{
+			return InsertIntoLeaf(Leaf, Index, NewElement);
+		}
+		return SplitLeafAndInsert(Leaf, Index, NewElement, Path);
+	}
+
+	/**
+	 * Removes the element with the given key.
+	 * @return The number of elements removed.
+	 */
+	int32 Remove(KeyInitType Key)
+	{
+		if (!Root)
+		{
+			return 0;
+		}
+
+		FPath Path;
+		FLeaf* Leaf = FindLeaf(Key, &Path);
+		const int32 Index = LeafLowerBound(Leaf, Key);
+		if (Index == Leaf->Num || SortPredicate()(Key, KeyFuncs::GetSetKey(Leaf->GetElements()[Index])))
+		{
+			return 0;
+		}
+
+		ElementType* Element = Leaf->GetElements() + Index;
+		DestructItem(Element);
+		RelocateConstructItems<ElementType>(Element, Element + 1, Leaf->Num - Index - 1);
+		--Leaf->Num;
+		--NumElements;
+
+		if (Path.Num() == 0)
+		{
+			if (Leaf->Num == 0)
+			{
+				FreeLeaf(Leaf);
+				Root = nullptr;
+			}
+		}
+		else if (Leaf->Num < MinLeafNum)
+		{
+			RebalanceLeaf(Leaf, Path);
+		}
+		return 1;
+	}
+
+	/**
+	 * Finds an element with the given key in the set.
+	 * @return A pointer to the element, or nullptr if the set doesn't contain one with this key.
+	 */
+	FORCEINLINE ElementType* Find(KeyInitType Key)
+	{
+		if (!Root)
+		{
+			return nullptr;
+		}
+
+		FLeaf* Leaf = FindLeaf(Key, nullptr);
+		const int32 Index = LeafLowerBound(Leaf, Key);
+		if (Index < Leaf->Num && !SortPredicate()(Key, KeyFuncs::GetSetKey(Leaf->GetElements()[Index])))
+		{
+			return Leaf->GetElements() + Index;
+		}
+		return nullptr;
+	}
+
+	FORCEINLINE const ElementType* Find(KeyInitType Key) const
+	{
+		return const_cast<TBTreeSet*>(this)->Find(Key);
+	}
+
+	/** @return Whether the set contains an element with the given key. */
+	FORCEINLINE bool Contains(KeyInitType Key) const
+	{
+		return Find(Key) != nullptr;
+	}
+
+	/** The base type of set iterators, visiting the elements in order of their keys. */
+	template<bool bConst>
+	class TBaseIterator
+	{
+	public:
+		typedef typename TChooseClass<bConst, const ElementType, ElementType>::Result ItElementType;
+		typedef typename TChooseClass<bConst, const FLeaf, FLeaf>::Result LeafType;
+
+		FORCEINLINE TBaseIterator(LeafType* InLeaf, int32 InIndex)
+			: Leaf(InLeaf)
+			, Index(InIndex)
+		{
+		}
+
+		/** Advances the iterator to the next element. */
+		FORCEINLINE TBaseIterator& operator++()
+		{
+			if (++Index == Leaf->Num)
+			{
+				Leaf = Leaf->Next;
+				Index = 0;
+			}
+			return *this;
+		}
+
+		/** conversion to "bool" returning true if the iterator is valid. */
+		FORCEINLINE explicit operator bool() const
+		{
+			return Leaf != nullptr;
+		}
+		/** inverse of the "bool" operator */
+		FORCEINLINE bool operator !() const
+		{
+			return !(bool)*this;
+		}
+
+		// Accessors.
+		FORCEINLINE ItElementType& operator*() const
+		{
+			return Leaf->GetElements()[Index];
+		}
+		FORCEINLINE ItElementType* operator->() const
+		{
+			return Leaf->GetElements() + Index;
+		}
+
+		FORCEINLINE friend bool operator==(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.Leaf == Rhs.Leaf && Lhs.Index == Rhs.Index; }
+		FORCEINLINE friend bool operator!=(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return !(Lhs == Rhs); }
+
+	protected:
+		LeafType* Leaf;
+		int32 Index;
+	};
+
+	/** Used to iterate over the elements of a const TBTreeSet. */
+	class TConstIterator : public TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE TConstIterator(const FLeaf* InLeaf, int32 InIndex)
+			: TBaseIterator<true>(InLeaf, InIndex)
+		{
+		}
+	};
+
+	/** Used to iterate over the elements of a TBTreeSet. Keys must not be changed. */
+	class TIterator : public TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE TIterator(FLeaf* InLeaf, int32 InIndex)
+			: TBaseIterator<false>(InLeaf, InIndex)
+		{
+		}
+	};
+
+	/** Creates an iterator for the contents of this set, from the smallest key up */
+	FORCEINLINE TIterator CreateIterator()
+	{
+		return TIterator(FirstLeaf(), 0);
+	}
+
+	/** Creates a const iterator for the contents of this set, from the smallest key up */
+	FORCEINLINE TConstIterator CreateConstIterator() const
+	{
+		return TConstIterator(FirstLeaf(), 0);
+	}
+
+	/**
+	 * Finds the first element with a key not less than Key, the start of a range query. Iterating from there until a
+	 * key that is not less than the end of a range visits the elements in [Key, End).
+	 *
+	 * @return An iterator to the element, or an invalid iterator if every key is less than Key.
+	 */
+	FORCEINLINE TIterator LowerBound(KeyInitType Key)
+	{
+		int32 Index;
+		FLeaf* Leaf = FindBound<false>(Key, Index);
+		return TIterator(Leaf, Index);
+	}
+
+	FORCEINLINE TConstIterator LowerBound(KeyInitType Key) const
+	{
+		int32 Index;
+		const FLeaf* Leaf = FindBound<false>(Key, Index);
+		return TConstIterator(Leaf, Index);
+	}
+
+	/**
+	 * Finds the first element with a key greater than Key.
+	 *
+	 * @return An iterator to the element, or an invalid iterator if no key is greater than Key.
+	 */
+	FORCEINLINE TIterator UpperBound(KeyInitType Key)
+	{
+		int32 Index;
+		FLeaf* Leaf = FindBound<true>(Key, Index);
+		return TIterator(Leaf, Index);
+	}
+
+	FORCEINLINE TConstIterator UpperBound(KeyInitType Key) const
+	{
+		int32 Index;
+		const FLeaf* Leaf = FindBound<true>(Key, Index);
+		return TConstIterator(Leaf, Index);
+	}
+
+public:
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE TIterator      begin()       { return CreateIterator(); }
+	FORCEINLINE TConstIterator begin() const { return CreateConstIterator(); }
+	FORCEINLINE TIterator      end()         { return TIterator(nullptr, 0); }
+	FORCEINLINE TConstIterator end() const   { return TConstIterator(nullptr, 0); }
+
+private:
+	template<typename ComparableKey>
+	static FORCEINLINE int32 LeafLowerBound(const FLeaf* Leaf, const ComparableKey& Key)
+	{
+		return AlgoImpl::LowerBoundInternal(Leaf->GetElements(), Leaf->Num, Key, FElementKey(), SortPredicate());
+	}
+
+	template<typename ComparableKey>
+	static FORCEINLINE int32 LeafUpperBound(const FLeaf* Leaf, const ComparableKey& Key)
+	{
+		return AlgoImpl::UpperBoundInternal(Leaf->GetElements(), Leaf->Num, Key, FElementKey(), SortPredicate());
+	}
+
+	/** Walks down to the leaf that holds or would hold Key, optionally recording the inner nodes on the way */
+	template<typename ComparableKey>
+	FORCEINLINE FLeaf* FindLeaf(const ComparableKey& Key, FPath* OutPath) const
+	{
+		void* Node = Root;
+		for (int32 Level = Height; Level > 0; --Level)
+		{
+			FInner* Inner = (FInner*)Node;
+			const int32 ChildIndex = AlgoImpl::UpperBoundInternal(Inner->GetKeys(), Inner->Num, Key, FIdentityFunctor(), SortPredicate());
+			if (OutPath)
+			{
+				OutPath->Add(FPathEntry{ Inner, ChildIndex });
+			}
+			Node = Inner->Children[ChildIndex];
+		}
+		return (FLeaf*)Node;
+	}
+
+	FLeaf* FirstLeaf() const
+	{
+		void* Node = Root;
+		if (Node)
+		{
+			for (int32 Level = Height; Level > 0; --Level)
+			{
+				Node = ((FInner*)Node)->Children[0];
+			}
+		}
+		return (FLeaf*)Node;
+	}
+
+	/** Finds the leaf and index of the lower or upper bound of Key, or nullptr past the last element */
+	template<bool bUpper>
+	FLeaf* FindBound(KeyInitType Key, int32& OutIndex) const
+	{
+		OutIndex = 0;
+		if (!Root)
+		{
+			return nullptr;
+		}
+
+		FLeaf* Leaf = FindLeaf(Key, nullptr);
+		const int32 Index = bUpper ? LeafUpperBound(Leaf, Key) : LeafLowerBound(Leaf, Key);
+		if (Index == Leaf->Num)
+		{
+			// The next leaf only holds keys not less than its separator, which is greater than Key
+			return Leaf->Next;
+		}
+		OutIndex = Index;
+		return Leaf;
+	}
+
+	FLeaf* NewLeaf()
+	{
+		++NumLeaves;
+		return new(NodeAllocator.Allocate(sizeof(FLeaf), alignof(FLeaf))) FLeaf();
+	}
+
+	FInner* NewInner()
+	{
+		++NumInners;
+		return new(NodeAllocator.Allocate(sizeof(FInner), alignof(FInner))) FInner();
+	}
+
+	void FreeLeaf(FLeaf* Leaf)
+	{
+		DestructItems(Leaf->GetElements(), Leaf->Num);
+		NodeAllocator.Free(Leaf, sizeof(FLeaf));
+		--NumLeaves;
+	}
+
+	void FreeInner(FInner* Inner)
+	{
+		DestructItems(Inner->GetKeys(), Inner->Num);
+		NodeAllocator.Free(Inner, sizeof(FInner));
+		--NumInners;
+	}
+
+	void FreeSubtree(void* Node, int32 Level)
+	{
+		if (Level == 0)
+		{
+			FreeLeaf((FLeaf*)Node);
+			return;
+		}
+
+		FInner* Inner = (FInner*)Node;
+		for (int32 Index = 0; Index <= Inner->Num; ++Index)
+		{
+			FreeSubtree(Inner->Children[Index], Level - 1);
+		}
+		FreeInner(Inner);
+	}
+
+	void MoveToEmpty(TBTreeSet& Other)
+	{
+		NodeAllocator.MoveToEmpty(Other.NodeAllocator);
+		Root = Other.Root;
+		Height = Other.Height;
+		NumElements = Other.NumElements;
+		NumLeaves = Other.NumLeaves;
+		NumInners = Other.NumInners;
+		Other.Root = nullptr;
+		Other.Height = 0;
+		Other.NumElements = 0;
+		Other.NumLeaves = 0;
+		Other.NumInners = 0;
+	}
+
+	void CopyFrom(const TBTreeSet& Other)
+	{
+		TArray<ElementType> SortedElements;
+		SortedElements.Reserve(Other.Num());
+		for (const ElementType& Element : Other)
+		{
+			SortedElements.Add(Element);
+		}
+		BulkLoad(MoveTemp(SortedElements));
+	}
+
+	/** Moves NewElement to Index in a leaf with room for it */
+	ElementType& InsertIntoLeaf(FLeaf* Leaf, int32 Index, ElementType& NewElement)
+	{
+		checkSlow(Leaf->Num < LeafCapacity);
+		ElementType* Slot = Leaf->GetElements() + Index;
+		FMemory::Memmove(Slot + 1, Slot, (Leaf->Num - Index) * sizeof(ElementType));
+		RelocateConstructItems<ElementType>(Slot, &NewElement, 1);
+		++Leaf->Num;
+		return *Slot;
+	}
+
+	ElementType& SplitLeafAndInsert(FLeaf* Leaf, int32 Index, ElementType& NewElement, FPath& Path)
+	{
+		// Appending to the last leaf leaves it full and starts a new one, so that adding in order fills every leaf
+		const bool bAppend = Leaf->Next == nullptr && Index == Leaf->Num;
+		const int32 NumLeft = bAppend ? (int32)LeafCapacity : (LeafCapacity + 1) / 2;
+
+		FLeaf* Right = NewLeaf();
+		Right->Prev = Leaf;
+		Right->Next = Leaf->Next;
+		if (Leaf->Next)
+		{
+			Leaf->Next->Prev = Right;
+		}
+		Leaf->Next = Right;
+
+		ElementType* Result;
+		if (Index < NumLeft)
+		{
+			Right->Num = LeafCapacity - (NumLeft - 1);
+			Leaf->Num = NumLeft - 1;
+			RelocateConstructItems<ElementType>(Right->GetElements(), Leaf->GetElements() + Leaf->Num, Right->Num);
+			Result = &InsertIntoLeaf(Leaf, Index, NewElement);
+		}
+		else
+		{
+			Right->Num = LeafCapacity - NumLeft;
+			Leaf->Num = NumLeft;
+			RelocateConstructItems<ElementType>(Right->GetElements(), Leaf->GetElements() + Leaf->Num, Right->Num);
+			Result = &InsertIntoLeaf(Right, Index - NumLeft, NewElement);
+		}
+
+		TTypeCompatibleBytes<KeyType> SeparatorBytes;
+		new(&SeparatorBytes) KeyType(KeyFuncs::GetSetKey(Right->GetElements()[0]));
+		InsertIntoParents(Path, *(KeyType*)&SeparatorBytes, Right);
+		return *Result;
+	}
+
+	/** Moves Separator and the node to its right into the parent of the last node of Path, splitting full nodes up to the root */
+	void InsertIntoParents(FPath& Path, KeyType& Separator, void* RightChild)
+	{
+		for (int32 PathIndex = Path.Num() - 1; PathIndex >= 0; --PathIndex)
+		{
+			FInner* Inner = Path[PathIndex].Inner;
+			const int32 KeyIndex = Path[PathIndex].ChildIndex;
+			if (Inner->Num < InnerCapacity)
+			{
+				KeyType* Keys = Inner->GetKeys();
+				FMemory::Memmove(Keys + KeyIndex + 1, Keys + KeyIndex, (Inner->Num - KeyIndex) * sizeof(KeyType));
+				RelocateConstructItems<KeyType>(Keys + KeyIndex, &Separator, 1);
+				FMemory::Memmove(Inner->Children + KeyIndex + 2, Inner->Children + KeyIndex + 1, (Inner->Num - KeyIndex) * sizeof(void*));
+				Inner->Children[KeyIndex + 1] = RightChild;
+				++Inner->Num;
+				return;
+			}
+
+			// Lay out all the keys and children with the new ones in order, then give the first half to the node, the
+			// middle key to the parent and the rest to a new node
+			TTypeCompatibleBytes<KeyType> AllKeyBytes[InnerCapacity + 1];
+			void* AllChildren[InnerCapacity + 2];
+			KeyType* AllKeys = (KeyType*)AllKeyBytes;
+			RelocateConstructItems<KeyType>(AllKeys, Inner->GetKeys(), KeyIndex);
+			RelocateConstructItems<KeyType>(AllKeys + KeyIndex, &Separator, 1);
+			RelocateConstructItems<KeyType>(AllKeys + KeyIndex + 1, Inner->GetKeys() + KeyIndex, InnerCapacity - KeyIndex);
+			FMemory::Memcpy(AllChildren, Inner->Children, (KeyIndex + 1) * sizeof(void*));
+			AllChildren[KeyIndex + 1] = RightChild;
+			FMemory::Memcpy(AllChildren + KeyIndex + 2, Inner->Children + KeyIndex + 1, (InnerCapacity - KeyIndex) * sizeof(void*));
+
+			const int32 MiddleIndex = (InnerCapacity + 1) / 2;
+			FInner* NewRight = NewInner();
+			Inner->Num = MiddleIndex;
+			NewRight->Num = InnerCapacity - MiddleIndex;
+			RelocateConstructItems<KeyType>(Inner->GetKeys(), AllKeys, Inner->Num);
+			RelocateConstructItems<KeyType>(NewRight->GetKeys(), AllKeys + MiddleIndex + 1, NewRight->Num);
+			FMemory::Memcpy(Inner->Children, AllChildren, (Inner->Num + 1) * sizeof(void*));
+			FMemory::Memcpy(NewRight->Children, AllChildren + MiddleIndex + 1, (NewRight->Num + 1) * sizeof(void*));
+			RelocateConstructItems<KeyType>(&Separator, AllKeys + MiddleIndex, 1);
+			RightChild = NewRight;
+		}
+
+		// The root was split
+		FInner* NewRoot = NewInner();
+		RelocateConstructItems<KeyType>(NewRoot->GetKeys(), &Separator, 1);
+		NewRoot->Num = 1;
+		NewRoot->Children[0] = Root;
+		NewRoot->Children[1] = RightChild;
+		Root = NewRoot;
+		++Height;
+	}
+
+	/** Takes an element from a sibling of a leaf that has too few, or merges them when the sibling has few too */
+	void RebalanceLeaf(FLeaf* Leaf, FPath& Path)
+	{
+		FInner* Parent = Path.Last().Inner;
+		const int32 ChildIndex = Path.Last().ChildIndex;
+		if (ChildIndex > 0)
+		{
+			FLeaf* Left = (FLeaf*)Parent->Children[ChildIndex - 1];
+			if (Left->Num > MinLeafNum)
+			{
+				FMemory::Memmove(Leaf->GetElements() + 1, Leaf->GetElements(), Leaf->Num * sizeof(ElementType));
+				RelocateConstructItems<ElementType>(Leaf->GetElements(), Left->GetElements() + --Left->Num, 1);
+				++Leaf->Num;
+				Parent->GetKeys()[ChildIndex - 1] = KeyFuncs::GetSetKey(Leaf->GetElements()[0]);
+				return;
+			}
+
+			MergeLeaves(Left, Leaf);
+			RemoveFromInner(Parent, ChildIndex - 1, true, Path);
+		}
+		else
+		{
+			FLeaf* Right = (FLeaf*)Parent->Children[1];
+			if (Right->Num > MinLeafNum)
+			{
+				RelocateConstructItems<ElementType>(Leaf->GetElements() + Leaf->Num++, Right->GetElements(), 1);
+				RelocateConstructItems<ElementType>(Right->GetElements(), Right->GetElements() + 1, --Right->Num);
+				Parent->GetKeys()[0] = KeyFuncs::GetSetKey(Right->GetElements()[0]);
+				return;
+			}
+
+			MergeLeaves(Leaf, Right);
+			RemoveFromInner(Parent, 0, true, Path);
+		}
+	}
+
+	void MergeLeaves(FLeaf* Left, FLeaf* Right)
+	{
+		checkSlow(Left->Num + Right->Num <= LeafCapacity);
+		RelocateConstructItems<ElementType>(Left->GetElements() + Left->Num, Right->GetElements(), Right->Num);
+		Left->Num += Right->Num;
+		Right->Num = 0;
+		Left->Next = Right->Next;
+		if (Right->Next)
+		{
+			Right->Next->Prev = Left;
+		}
+		FreeLeaf(Right);
+	}
+
+	/**
+	 * Removes the key at KeyIndex and the child to its right, whose nodes were merged into the child to its left,
+	 * from the last inner node of Path, then rebalances that node.
+	 */
+	void RemoveFromInner(FInner* Inner, int32 KeyIndex, bool bDestructKey, FPath& Path)
+	{
+		KeyType* Keys = Inner->GetKeys();
+		if (bDestructKey)
+		{
+			DestructItem(Keys + KeyIndex);
+		}
+		RelocateConstructItems<KeyType>(Keys + KeyIndex, Keys + KeyIndex + 1, Inner->Num - KeyIndex - 1);
+		FMemory::Memmove(Inner->Children + KeyIndex + 1, Inner->Children + KeyIndex + 2, (Inner->Num - KeyIndex - 1) * sizeof(void*));
+		--Inner->Num;
+
+		Path.Pop(false);
+		if (Path.Num() == 0)
+		{
+			if (Inner->Num == 0)
+			{
+				// The root is left with a single child, which becomes the root
+				Root = Inner->Children[0];
+				FreeInner(Inner);
+				--Height;
+			}
+		}
+		else if (Inner->Num < MinInnerNum)
+		{
+			RebalanceInner(Inner, Path);
+		}
+	}
+
+	/** Rotates a key through the parent from a sibling of an inner node that has too few, or merges them when the sibling has few too */
+	void RebalanceInner(FInner* Inner, FPath& Path)
+	{
+		FInner* Parent = Path.Last().Inner;
+		const int32 ChildIndex = Path.Last().ChildIndex;
+		KeyType* ParentKeys = Parent->GetKeys();
+		if (ChildIndex > 0)
+		{
+			FInner* Left = (FInner*)Parent->Children[ChildIndex - 1];
+			if (Left->Num > MinInnerNum)
+			{
+				FMemory::Memmove(Inner->GetKeys() + 1, Inner->GetKeys(), Inner->Num * sizeof(KeyType));
+				FMemory::Memmove(Inner->Children + 1, Inner->Children, (Inner->Num + 1) * sizeof(void*));
+				RelocateConstructItems<KeyType>(Inner->GetKeys(), ParentKeys + ChildIndex - 1, 1);
+				Inner->Children[0] = Left->Children[Left->Num];
+				++Inner->Num;
+				RelocateConstructItems<KeyType>(ParentKeys + ChildIndex - 1, Left->GetKeys() + --Left->Num, 1);
+				return;
+			}
+
+			MergeInners(Left, ParentKeys + ChildIndex - 1, Inner);
+			RemoveFromInner(Parent, ChildIndex - 1, false, Path);
+		}
+		else
+		{
+			FInner* Right = (FInner*)Parent->Children[1];
+			if (Right->Num > MinInnerNum)
+			{
+				RelocateConstructItems<KeyType>(Inner->GetKeys() + Inner->Num, ParentKeys, 1);
+				Inner->Children[++Inner->Num] = Right->Children[0];
+				RelocateConstructItems<KeyType>(ParentKeys, Right->GetKeys(), 1);
+				--Right->Num;
+				RelocateConstructItems<KeyType>(Right->GetKeys(), Right->GetKeys() + 1, Right->Num);
+				FMemory::Memmove(Right->Children, Right->Children + 1, (Right->Num + 1) * sizeof(void*));
+				return;
+			}
+
+			MergeInners(Inner, ParentKeys, Right);
+			RemoveFromInner(Parent, 0, false, Path);
+		}
+	}
+
+	/** Moves the separator from the parent and the keys and children of Right into Left, then frees Right */
+	void MergeInners(FInner* Left, KeyType* Separator, FInner* Right)
+	{
+		checkSlow(Left->Num + 1 + Right->Num <= InnerCapacity);
+		RelocateConstructItems<KeyType>(Left->GetKeys() + Left->Num, Separator, 1);
+		RelocateConstructItems<KeyType>(Left->GetKeys() + Left->Num + 1, Right->GetKeys(), Right->Num);
+		FMemory::Memcpy(Left->Children + Left->Num + 1, Right->Children, (Right->Num + 1) * sizeof(void*));
+		Left->Num += 1 + Right->Num;
+		Right->Num = 0;
+		FreeInner(Right);
+	}
+
+	/** The root node, a leaf when Height is 0, or nullptr when the set is empty */
+	void* Root = nullptr;
+
+	/** The number of inner node levels above the leaves */
+	int32 Height = 0;
+
+	int32 NumElements = 0;
+	int32 NumLeaves = 0;
+	int32 NumInners = 0;
+
+	typename Allocator::ForNodes NodeAllocator;
+};
@@ -739,6 +739,113 @@ public:
 		return Result;
 	}
 
+	/**
+	 * Finds the first true/false bit in the array at or after StartIndex, and returns the bit index.
+	 * If there is none, INDEX_NONE is returned.
+	 */
+	int32 FindFrom(bool bValue, int32 StartIndex) const
+	{
+		check(StartIndex >= 0);
+
+		const int32 LocalNumBits = NumBits;
+		if (StartIndex >= LocalNumBits)
+		{
+			return INDEX_NONE;
+		}
+
+		// If we're looking for a false, then we flip the bits - then we only need to find the first one bit
+		const uint32* RESTRICT DwordArray = GetData();
+		const uint32 Flip = bValue ? 0u : ~0u;
+		const int32 DwordCount = FBitSet::CalculateNumWords(LocalNumBits);
+		int32 DwordIndex = StartIndex >> NumBitsPerDWORDLogTwo;
+		uint32 Bits = (DwordArray[DwordIndex] ^ Flip) & (~0u << (StartIndex & (NumBitsPerDWORD - 1)));
+		while (!Bits)
+		{
+			if (++DwordIndex == DwordCount)
+			{
+				return INDEX_NONE;
+			}
+			Bits = DwordArray[DwordIndex] ^ Flip;
+		}
+
+		const int32 LowestBitIndex = FMath::CountTrailingZeros(Bits) + (DwordIndex << NumBitsPerDWORDLogTwo);
+		return LowestBitIndex < LocalNumBits ? LowestBitIndex : INDEX_NONE;
+	}
+
+	/**
+	 * Counts the set bits in the range [FromIndex, ToIndex), a word at a time.
+	 * @param ToIndex - One past the last bit to count, INDEX_NONE for the end of the array.
+	 */
+	int32 CountSetBits(int32 FromIndex = 0, int32 ToIndex = INDEX_NONE) const
+	{
+		if (ToIndex == INDEX_NONE)
+		{
+			ToIndex = NumBits;
+		}
+		check(FromIndex >= 0 && FromIndex <= ToIndex && ToIndex <= NumBits);
+		if (FromIndex == ToIndex)
+		{
+			return 0;
+		}
+
+		const uint32* RESTRICT DwordArray = GetData();
+		const int32 FirstDwordIndex = FromIndex >> NumBitsPerDWORDLogTwo;
+		const int32 LastDwordIndex = (ToIndex - 1) >> NumBitsPerDWORDLogTwo;
+		const uint32 FirstMask = ~0u << (FromIndex & (NumBitsPerDWORD - 1));
+		const uint32 LastMask = ~0u >> ((NumBitsPerDWORD - ToIndex) & (NumBitsPerDWORD - 1));
+		if (FirstDwordIndex == LastDwordIndex)
+		{
+			return FPlatformMath::CountBits(DwordArray[FirstDwordIndex] & FirstMask & LastMask);
+		}
+
+		int32 Count = FPlatformMath::CountBits(DwordArray[FirstDwordIndex] & FirstMask);
+		for (int32 DwordIndex = FirstDwordIndex + 1; DwordIndex < LastDwordIndex; ++DwordIndex)
+		{
+			Count += FPlatformMath::CountBits(DwordArray[DwordIndex]);
+		}
+		return Count + FPlatformMath::CountBits(DwordArray[LastDwordIndex] & LastMask);
+	}
+
+	/**
+	 * Calls Func(BitIndex) for each set bit in the range [FromIndex, ToIndex), in order.
+	 * Faster than a TConstSetBitIterator for tight loops, as the whole scan stays in registers.
+	 */
+	template <typename FuncType>
+	void ForEachSetBit(int32 FromIndex, int32 ToIndex, FuncType&& Func) const
+	{
+		check(FromIndex >= 0 && FromIndex <= ToIndex && ToIndex <= NumBits);
+		if (FromIndex == ToIndex)
+		{
+			return;
+		}
+
+		const uint32* RESTRICT DwordArray = GetData();
+		const int32 LastDwordIndex = (ToIndex - 1) >> NumBitsPerDWORDLogTwo;
+		const uint32 LastMask = ~0u >> ((NumBitsPerDWORD - ToIndex) & (NumBitsPerDWORD - 1));
+		int32 DwordIndex = FromIndex >> NumBitsPerDWORDLogTwo;
+		uint32 Bits = DwordArray[DwordIndex] & (~0u << (FromIndex & (NumBitsPerDWORD - 1)));
+		for (;;)
+		{
+			if (DwordIndex == LastDwordIndex)
+			{
+				Bits &= LastMask;
+			}
+
+			const int32 BaseBitIndex = DwordIndex << NumBitsPerDWORDLogTwo;
+			while (Bits)
+			{
+				Func(BaseBitIndex + (int32)FMath::CountTrailingZeros(Bits));
+				Bits &= Bits - 1;
+			}
+
+			if (DwordIndex == LastDwordIndex)
+			{
+				return;
+			}
+			Bits = DwordArray[++DwordIndex];
+		}
+	}
+
 	FORCEINLINE bool Contains(bool bValue) const
 	{
 		return Find(bValue) != INDEX_NONE;
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/Atomic.h"
+#include "Templates/MemoryOps.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UnrealTemplate.h"
+
+/**
+ * Implements a lock-free bounded first-in first-out queue using a circular array.
+ *
+ * This class is thread safe with any number of producers and consumers. Unlike TQueue it doesn't allocate when
+ * elements are added, the slots are allocated once by the constructor, and Enqueue fails when they are all used.
+ *
+ * Each slot has a sequence number telling whether it's waiting for the producer or the consumer of the current
+ * lap around the array, so producers and consumers only contend on their own end of the queue, and the two ends
+ * live on separate cache lines. Batches of elements claim their slots with a single compare exchange.
+ *
+ * @param ElementType The type of elements held in the queue.
+ */
+template<typename ElementType>
+class TBoundedMpmcQueue
+{
+public:
+
+	/**
+	 * Constructor.
+	 *
+	 * @param InCapacity The number of elements that the queue can hold (will be rounded up to the next power of 2).
+	 */
+	explicit TBoundedMpmcQueue(uint32 InCapacity)
+		: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u)))
+		, IndexMask(Capacity - 1)
+		, EnqueuePos(0)
+		, DequeuePos(0)
+	{
+		Cells = (FCell*)FMemory::Malloc(Capacity * sizeof(FCell), alignof(FCell));
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			new(&Cells[Index]) FCell(Index);
+		}
+	}
+
+	/** Destructor, destroys the elements still in the queue. */
+	~TBoundedMpmcQueue()
+	{
+		const uint64 EndPos = EnqueuePos.Load(EMemoryOrder::Relaxed);
+		for (uint64 Pos = DequeuePos.Load(EMemoryOrder::Relaxed); Pos < EndPos; ++Pos)
+		{
+			DestructItem(Cells[Pos & IndexMask].Element.GetTypedPtr());
+		}
+		DestructItems(Cells, Capacity);
+		FMemory::Free(Cells);
+	}
+
+public:
+
+	/** @return The number of elements that the queue can hold. */
+	FORCEINLINE uint32 GetCapacity() const
+	{
+		return Capacity;
+	}
+
+	/**
+	 * Gets the number of elements in the queue.
+	 *
+	 * Can be called from any thread. Since no locking is used, the result may already be outdated when returned.
+	 *
+	 * @return Number of queued elements.
+	 */
+	uint32 Count() const
+	{
+		const uint64 CurrentDequeuePos = DequeuePos.Load(EMemoryOrder::Relaxed);
+		const uint64 CurrentEnqueuePos = EnqueuePos.Load(EMemoryOrder::Relaxed);
+		return CurrentEnqueuePos > CurrentDequeuePos ? uint32(FMath::Min<uint64>(CurrentEnqueuePos - CurrentDequeuePos, Capacity)) : 0;
+	}
+
+	/**
+	 * Checks whether the queue is empty.
+	 *
+	 * Can be called from any thread. The result may already be outdated when returned.
+	 *
+	 * @return true if the queue is empty, false otherwise.
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Count() == 0;
+	}
+
+	/**
+	 * Adds an item to the end of the queue.
+	 *
+	 * @param Element The element to add.
+	 * @return true if the item was added, false if the queue was full.
+	 */
+	FORCEINLINE bool Enqueue(const ElementType& Element)
+	{
+		return Emplace(Element);
+	}
+
+	FORCEINLINE bool Enqueue(ElementType&& Element)
+	{
+		return Emplace(MoveTemp(Element));
+	}
+
+	/**
+	 * Constructs an item at the end of the queue.
+	 *
+	 * @param Args The arguments forwarded to the element's constructor.
+	 * @return true if the item was added, false if the queue was full, in which case nothing is constructed.
+	 */
+	template <typename... ArgTypes>
+	bool Emplace(ArgTypes&&... Args)
+	{
+		uint64 Pos;
+		if (ClaimEnqueueCells(1, Pos) == 0)
+		{
+			return false;
+		}
+
+		FCell& Cell = Cells[Pos & IndexMask];
+		new(&Cell.Element) ElementType(Forward<ArgTypes>(Args)...);
+		Cell.Sequence.Store(Pos + 1);
+		return true;
+	}
+
+	/**
+	 * Adds as many of the given items as there is room for to the end of the queue. The items added are consecutive
+	 * in the queue, no other producer's item can end up between them.
+	 *
+	 * @param Elements The elements to add, the ones added are moved from.
+	 * @param NumElements The number of elements to add.
+	 * @return The number of elements added, from the start of the given ones.
+	 */
+	uint32 EnqueueBatch(ElementType* Elements, uint32 NumElements)
+	{
+		uint64 Pos;
+		const uint32 NumClaimed = ClaimEnqueueCells(NumElements, Pos);
+		for (uint32 Index = 0; Index < NumClaimed; ++Index)
+		{
+			FCell& Cell = Cells[(Pos + Index) & IndexMask];
+			new(&Cell.Element) ElementType(MoveTemp(Elements[Index]));
+			Cell.Sequence.Store(Pos + Index + 1);
+		}
+		return NumClaimed;
+	}
+
+	/**
+	 * Removes an item from the front of the queue.
+	 *
+	 * @param OutElement Will contain the element if the queue is not empty.
+	 * @return true if an element has been returned, false if the queue was empty.
+	 */
+	bool Dequeue(ElementType& OutElement)
+	{
+		uint64 Pos;
+		if (ClaimDequeueCells(1, Pos) == 0)
+		{
+			return false;
+		}
+
+		ReleaseCell(Pos, OutElement);
+		return true;
+	}
+
+	/**
+	 * Removes up to MaxElements items from the front of the queue. The items removed are consecutive in the queue.
+	 *
+	 * @param OutElements Receives the elements removed, needs room for MaxElements.
+	 * @param MaxElements The maximum number of elements to remove.
+	 * @return The number of elements removed.
+	 */
+	uint32 DequeueBatch(ElementType* OutElements, uint32 MaxElements)
+	{
+		uint64 Pos;
+		const uint32 NumClaimed = ClaimDequeueCells(MaxElements, Pos);
+		for (uint32 Index = 0; Index < NumClaimed; ++Index)
+		{
+			ReleaseCell(Pos + Index, OutElements[Index]);
+		}
+		return NumClaimed;
+	}
+
+private:
+
+	struct FCell
+	{
+		explicit FCell(uint64 InSequence)
+			: Sequence(InSequence)
+		{
+		}
+
+		/**
+		 * Equals the position of the lap when waiting for a producer, and the position plus one once the element is
+		 * constructed and waiting for a consumer.
+		 */
+		TAtomic<uint64> Sequence;
+		TTypeCompatibleBytes<ElementType> Element;
+	};
+
+	/**
+	 * Claims up to MaxCells consecutive cells ready for producers, returning how many were claimed and the position of the first.
+	 * Cells need to be filled and published in order by the caller.
+	 */
+	uint32 ClaimEnqueueCells(uint32 MaxCells, uint64& OutPos)
+	{
+		uint64 Pos = EnqueuePos.Load(EMemoryOrder::Relaxed);
+		for (;;)
+		{
+			uint32 NumReady = 0;
+			while (NumReady < MaxCells && Cells[(Pos + NumReady) & IndexMask].Sequence.Load() == Pos + NumReady)
+			{
+				++NumReady;
+			}
+
+			if (NumReady == 0)
+			{
+				// The first cell is either still used by the previous lap, which means the queue is full, or already claimed by another producer
+				if (Cells[Pos & IndexMask].Sequence.Load() < Pos)
+				{
+					return 0;
+				}
+				Pos = EnqueuePos.Load(EMemoryOrder::Relaxed);
+			}
+			else if (EnqueuePos.CompareExchange(Pos, Pos + NumReady))
+			{
+				OutPos = Pos;
+				return NumReady;
+			}
+		}
+	}
+
+	/** Same as ClaimEnqueueCells, for cells ready for consumers */
+	uint32 ClaimDequeueCells(uint32 MaxCells, uint64& OutPos)
+	{
+		uint64 Pos = DequeuePos.Load(EMemoryOrder::Relaxed);
+		for (;;)
+		{
+			uint32 NumReady = 0;
+			while (NumReady < MaxCells && Cells[(Pos + NumReady) & IndexMask].Sequence.Load() == Pos + NumReady + 1)
+			{
+				++NumReady;
+			}
+
+			if (NumReady == 0)
+			{
+				// The first cell is either not filled yet, which means the queue is empty, or already claimed by another consumer
+				if (Cells[Pos & IndexMask].Sequence.Load() < Pos + 1)
+				{
+					return 0;
+				}
+				Pos = DequeuePos.Load(EMemoryOrder::Relaxed);
+			}
+			else if (DequeuePos.CompareExchange(Pos, Pos + NumReady))
+			{
+				OutPos = Pos;
+				return NumReady;
+			}
+		}
+	}
+
+	/** Moves the element out of a claimed cell and hands the cell over to the producer of the next lap */
+	FORCEINLINE void ReleaseCell(uint64 Pos, ElementType& OutElement)
+	{
+		FCell& Cell = Cells[Pos & IndexMask];
+		ElementType* Element = Cell.Element.GetTypedPtr();
+		OutElement = MoveTemp(*Element);
+		DestructItem(Element);
+		Cell.Sequence.Store(Pos + Capacity);
+	}
+
+	const uint32 Capacity;
+	const uint32 IndexMask;
+	FCell* Cells;
+
+	/** Producers and consumers each have their own cache line, the alignment also pads the end of the queue. */
+	alignas(PLATFORM_CACHE_LINE_SIZE) TAtomic<uint64> EnqueuePos;
+	alignas(PLATFORM_CACHE_LINE_SIZE) TAtomic<uint64> DequeuePos;
+
+	UE_NONCOPYABLE(TBoundedMpmcQueue);
+};
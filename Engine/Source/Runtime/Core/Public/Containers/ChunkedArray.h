@@ -6,6 +6,9 @@
 #include "Misc/AssertionMacros.h"
 #include "Templates/UnrealTypeTraits.h"
 #include "Containers/IndirectArray.h"
+#include "Containers/ArrayView.h"
+#include "Templates/Atomic.h"
+#include "Templates/MemoryOps.h"
 
 
 namespace UE4ChunkedArray_Private
@@ -44,6 +47,24 @@ namespace UE4ChunkedArray_Private
 			return Lhs.Elem != Rhs.Elem;
 		}
 	};
+
+	template <uint32 N>
+	struct TFloorLog2
+	{
+		enum { Value = 1 + TFloorLog2<N / 2>::Value };
+	};
+
+	template <>
+	struct TFloorLog2<1>
+	{
+		enum { Value = 0 };
+	};
+
+	template <>
+	struct TFloorLog2<0>
+	{
+		enum { Value = 0 };
+	};
 }
 
 /** An array that uses multiple allocations to avoid allocation failure due to fragmentation. */
@@ -330,3 +351,216 @@ template <typename T,uint32 TargetBytesPerChunk> void* operator new( size_t Size
 	const int32 Index = ChunkedArray.Add(1);
 	return &ChunkedArray(Index);
 }
+
+
+/**
+ * A chunked array that any number of threads can append to at once without locking, for gathering the results of
+ * parallel tasks.
+ *
+ * Adding elements reserves a range of indices with a single atomic add. Each chunk is twice the size of the previous
+ * one so a fixed table of chunk pointers covers every index, and the first thread needing a chunk allocates it with
+ * a compare exchange. Like TChunkedArray, elements never move once added and are default constructed when their
+ * chunk is allocated.
+ *
+ * Adding is the only thread safe operation. Elements added by other threads should only be read once the adding
+ * threads have been synchronized with, e.g. after waiting for their tasks. The chunks can then be processed in
+ * parallel through GetChunk, or the elements through operator[].
+ */
+template<typename InElementType, uint32 TargetBytesPerChunk = 16384>
+class TConcurrentChunkedArray
+{
+	using ElementType = InElementType;
+
+public:
+
+	TConcurrentChunkedArray()
+		: NumElements(0)
+	{
+		for (uint32 ChunkIndex = 0; ChunkIndex < MaxChunks; ++ChunkIndex)
+		{
+			Chunks[ChunkIndex].Store(nullptr, EMemoryOrder::Relaxed);
+		}
+	}
+
+	~TConcurrentChunkedArray()
+	{
+		Empty();
+	}
+
+	UE_NONCOPYABLE(TConcurrentChunkedArray);
+
+	/** @return The number of elements added, including the ones other threads may still be writing. */
+	FORCEINLINE int32 Num() const
+	{
+		return NumElements.Load(EMemoryOrder::Relaxed);
+	}
+
+	FORCEINLINE bool IsValidIndex(int32 Index) const
+	{
+		return Index >= 0 && Index < Num();
+	}
+
+	FORCEINLINE ElementType& operator[](int32 Index)
+	{
+		checkSlow(IsValidIndex(Index));
+		const uint32 ChunkIndex = GetChunkIndex(Index);
+		return Chunks[ChunkIndex].Load(EMemoryOrder::Relaxed)[Index - GetChunkStart(ChunkIndex)];
+	}
+
+	FORCEINLINE const ElementType& operator[](int32 Index) const
+	{
+		checkSlow(IsValidIndex(Index));
+		const uint32 ChunkIndex = GetChunkIndex(Index);
+		return Chunks[ChunkIndex].Load(EMemoryOrder::Relaxed)[Index - GetChunkStart(ChunkIndex)];
+	}
+
+	/**
+	 * Adds a new item to the end of the array, can be called from any thread.
+	 *
+	 * @param Item	The item to add
+	 * @return		Index to the new item
+	 */
+	int32 AddElement(const ElementType& Item)
+	{
+		const int32 Index = AddRange(1);
+		(*this)[Index] = Item;
+		return Index;
+	}
+
+	int32 AddElement(ElementType&& Item)
+	{
+		const int32 Index = AddRange(1);
+		(*this)[Index] = MoveTemp(Item);
+		return Index;
+	}
+
+	/**
+	 * Adds Count consecutive default constructed elements to the array, can be called from any thread.
+	 * The calling thread owns the new elements and can fill them without further synchronization.
+	 *
+	 * @return The index of the first new element.
+	 */
+	int32 AddRange(int32 Count)
+	{
+		check(Count >= 0);
+		const int32 FirstIndex = NumElements.AddExchange(Count);
+		checkf(int64(FirstIndex) + Count <= MAX_int32, TEXT("TConcurrentChunkedArray can't hold more than MAX_int32 elements"));
+
+		if (Count)
+		{
+			const uint32 LastChunkIndex = GetChunkIndex(FirstIndex + Count - 1);
+			for (uint32 ChunkIndex = GetChunkIndex(FirstIndex); ChunkIndex <= LastChunkIndex; ++ChunkIndex)
+			{
+				AllocateChunk(ChunkIndex);
+			}
+		}
+		return FirstIndex;
+	}
+
+	/** @return The number of chunks holding the elements. */
+	int32 GetNumChunks() const
+	{
+		const int32 Num = this->Num();
+		return Num ? int32(GetChunkIndex(Num - 1)) + 1 : 0;
+	}
+
+	/** @return A view of the elements of the given chunk, chunks can be processed in parallel. */
+	TArrayView<ElementType> GetChunk(int32 ChunkIndex)
+	{
+		checkSlow(ChunkIndex >= 0 && ChunkIndex < GetNumChunks());
+		const int32 ChunkStart = int32(GetChunkStart(ChunkIndex));
+		return TArrayView<ElementType>(Chunks[ChunkIndex].Load(EMemoryOrder::Relaxed), FMath::Min<int32>(GetChunkSize(ChunkIndex), Num() - ChunkStart));
+	}
+
+	TArrayView<const ElementType> GetChunk(int32 ChunkIndex) const
+	{
+		return const_cast<TConcurrentChunkedArray*>(this)->GetChunk(ChunkIndex);
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = 0;
+		for (uint32 ChunkIndex = 0; ChunkIndex < MaxChunks; ++ChunkIndex)
+		{
+			if (Chunks[ChunkIndex].Load(EMemoryOrder::Relaxed))
+			{
+				Size += GetChunkSize(ChunkIndex) * sizeof(ElementType);
+			}
+		}
+		return Size;
+	}
+
+	/** Appends copies of the elements to a linear array, not thread safe. */
+	template<typename OtherAllocator>
+	void CopyToLinearArray(TArray<ElementType, OtherAllocator>& DestinationArray) const
+	{
+		DestinationArray.Reserve(DestinationArray.Num() + Num());
+		for (int32 ChunkIndex = 0, NumChunks = GetNumChunks(); ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			TArrayView<const ElementType> Chunk = GetChunk(ChunkIndex);
+			DestinationArray.Append(Chunk.GetData(), Chunk.Num());
+		}
+	}
+
+	/** Destroys all the elements and frees the chunks, not thread safe. */
+	void Empty()
+	{
+		for (uint32 ChunkIndex = 0; ChunkIndex < MaxChunks; ++ChunkIndex)
+		{
+			if (ElementType* Chunk = Chunks[ChunkIndex].Load(EMemoryOrder::Relaxed))
+			{
+				DestructItems(Chunk, GetChunkSize(ChunkIndex));
+				FMemory::Free(Chunk);
+				Chunks[ChunkIndex].Store(nullptr, EMemoryOrder::Relaxed);
+			}
+		}
+		NumElements.Store(0, EMemoryOrder::Relaxed);
+	}
+
+private:
+
+	/** The first chunk holds a power of two number of elements, the next ones double in size */
+	enum { FirstChunkShift = UE4ChunkedArray_Private::TFloorLog2<TargetBytesPerChunk / sizeof(ElementType)>::Value };
+	enum { FirstChunkSize = 1u << FirstChunkShift };
+
+	/** Enough chunks to hold MAX_int32 elements */
+	enum { MaxChunks = 32 - FirstChunkShift };
+
+	/** Chunk k starts at index FirstChunkSize * (2^k - 1) */
+	static FORCEINLINE uint32 GetChunkIndex(int32 Index)
+	{
+		return FPlatformMath::FloorLog2((uint32(Index) >> FirstChunkShift) + 1);
+	}
+
+	static FORCEINLINE uint32 GetChunkStart(uint32 ChunkIndex)
+	{
+		return (uint32(FirstChunkSize) << ChunkIndex) - FirstChunkSize;
+	}
+
+	static FORCEINLINE uint32 GetChunkSize(uint32 ChunkIndex)
+	{
+		return uint32(FirstChunkSize) << ChunkIndex;
+	}
+
+	/** Makes sure the chunk is allocated, the threads racing to allocate it free their chunk if another thread won */
+	void AllocateChunk(uint32 ChunkIndex)
+	{
+		ElementType* Chunk = Chunks[ChunkIndex].Load();
+		if (!Chunk)
+		{
+			const uint32 ChunkSize = GetChunkSize(ChunkIndex);
+			ElementType* NewChunk = (ElementType*)FMemory::Malloc(ChunkSize * sizeof(ElementType), alignof(ElementType));
+			DefaultConstructItems<ElementType>(NewChunk, ChunkSize);
+			if (!Chunks[ChunkIndex].CompareExchange(Chunk, NewChunk))
+			{
+				DestructItems(NewChunk, ChunkSize);
+				FMemory::Free(NewChunk);
+			}
+		}
+	}
+
+	TAtomic<ElementType*> Chunks[MaxChunks];
+
+	/** Separate cache line for the counter all the adding threads update */
+	alignas(PLATFORM_CACHE_LINE_SIZE) TAtomic<int32> NumElements;
+};
@@ -0,0 +1,350 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/Optional.h"
+#include "Containers/FlatMap.h"
+#include "Containers/SparseArray.h"
+#include "Containers/UnrealString.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/Atomic.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+/** Statistics of a TConcurrentLruCache, see GetStats. */
+struct FConcurrentLruCacheStats
+{
+	/** The number of lookups that found their key */
+	uint64 NumHits = 0;
+
+	/** The number of lookups that didn't find their key */
+	uint64 NumMisses = 0;
+
+	/** The number of entries removed to stay within the budgets */
+	uint64 NumEvictions = 0;
+
+	/** The number of entries in the cache */
+	int32 NumEntries = 0;
+
+	/** The sum of the costs of the entries */
+	uint64 TotalCost = 0;
+
+	/** @return The fraction of lookups that found their key. */
+	double GetHitRate() const
+	{
+		const uint64 NumLookups = NumHits + NumMisses;
+		return NumLookups ? double(NumHits) / double(NumLookups) : 0.0;
+	}
+};
+
+/**
+ * A cache that can be used from many threads at once, bounded by both a number of entries and a total cost such as
+ * the size in bytes of the values.
+ *
+ * Like TConcurrentMap, the keys are spread over 2^NumShardsLog2 shards, each behind its own read/write lock on its
+ * own cache line, and values are returned by copy. The least recently used entries are approximated with the CLOCK
+ * algorithm: a lookup only marks its entry as referenced with a relaxed atomic store, so lookups only take the read
+ * lock and run in parallel, instead of moving the entry to the front of a list as TLruCache does. When an entry is
+ * added to a full shard, a hand sweeps the shard's entries, evicting the first one that wasn't referenced since the
+ * previous sweep and clearing the mark of the ones that were.
+ *
+ * The budgets are split evenly between the shards, so a shard holding more keys than the others can start evicting
+ * before the cache as a whole is full.
+ */
+template<typename KeyType, typename ValueType, uint32 NumShardsLog2 = 4, typename KeyFuncs = TDefaultMapHashableKeyFuncs<KeyType, int32, false> >
+class TConcurrentLruCache
+{
+	static_assert(NumShardsLog2 > 0 && NumShardsLog2 <= 10, "TConcurrentLruCache needs between 2 and 1024 shards");
+
+public:
+	typedef typename TTypeTraits<KeyType>::ConstPointerType KeyConstPointerType;
+
+	/** Called with the key and value of entries evicted to stay within the budgets, with the shard locked. It mustn't access the cache. */
+	typedef TFunction<void(const KeyType& /*Key*/, ValueType& /*Value*/)> FOnEvicted;
+
+	/**
+	 * Creates and initializes a new instance.
+	 *
+	 * @param InMaxNumEntries The maximum number of entries in the cache.
+	 * @param InMaxTotalCost The maximum sum of the costs of the entries.
+	 * @param InOnEvicted Optional callback for the entries evicted to stay within the budgets.
+	 */
+	explicit TConcurrentLruCache(int32 InMaxNumEntries, uint64 InMaxTotalCost = MAX_uint64, FOnEvicted InOnEvicted = FOnEvicted())
+		: MaxNumEntriesPerShard(FMath::Max(1, (InMaxNumEntries + NumShards - 1) / NumShards))
+		, MaxCostPerShard(InMaxTotalCost == MAX_uint64 ? MAX_uint64 : FMath::Max<uint64>(1, InMaxTotalCost / NumShards))
+		, OnEvicted(MoveTemp(InOnEvicted))
+	{
+	}
+
+	/**
+	 * Find the value associated with a key and mark it as recently used.
+	 *
+	 * @param Key The key to search for.
+	 * @return A copy of the value associated with the key, or an unset optional if the key isn't in the cache.
+	 */
+	TOptional<ValueType> FindAndTouch(KeyConstPointerType Key)
+	{
+		FShard& Shard = GetShard(KeyFuncs::GetKeyHash(Key));
+		FReadScopeLock ReadLock(Shard.Lock);
+		if (const int32* EntryIndex = Shard.Index.Find(Key))
+		{
+			const FEntry& Entry = Shard.Entries[*EntryIndex];
+			// Avoid writing to the entry's cache line when it's already marked
+			if (!Entry.bReferenced.Load(EMemoryOrder::Relaxed))
+			{
+				Entry.bReferenced.Store(true, EMemoryOrder::Relaxed);
+			}
+			Shard.NumHits.IncrementExchange();
+			return Entry.Value;
+		}
+		Shard.NumMisses.IncrementExchange();
+		return TOptional<ValueType>();
+	}
+
+	/** @return true if the cache contains the key, doesn't mark it as recently used and isn't counted in the statistics. */
+	bool Contains(KeyConstPointerType Key) const
+	{
+		const FShard& Shard = GetShard(KeyFuncs::GetKeyHash(Key));
+		FReadScopeLock ReadLock(Shard.Lock);
+		return Shard.Index.Contains(Key);
+	}
+
+	/**
+	 * Adds an entry to the cache, replacing the value of an existing one, then evicts entries of the shard that
+	 * aren't recently used until it's within the budgets. The added entry is never evicted by its own Add.
+	 *
+	 * @param Key The entry's key.
+	 * @param Value The entry's value.
+	 * @param Cost The entry's share of the total cost budget, such as the size of the value in bytes.
+	 */
+	template <typename InitValueType>
+	void Add(const KeyType& Key, InitValueType&& Value, uint64 Cost = 0)
+	{
+		FShard& Shard = GetShard(KeyFuncs::GetKeyHash(Key));
+		FWriteScopeLock WriteLock(Shard.Lock);
+
+		int32 EntryIndex;
+		if (const int32* ExistingIndex = Shard.Index.Find(Key))
+		{
+			EntryIndex = *ExistingIndex;
+			FEntry& Entry = Shard.Entries[EntryIndex];
+			Entry.Value = Forward<InitValueType>(Value);
+			Shard.TotalCost += Cost - Entry.Cost;
+			Entry.Cost = Cost;
+			Entry.bReferenced.Store(true, EMemoryOrder::Relaxed);
+		}
+		else
+		{
+			FSparseArrayAllocationInfo Allocation = Shard.Entries.AddUninitialized();
+			new(Allocation) FEntry(Key, Forward<InitValueType>(Value), Cost);
+			EntryIndex = Allocation.Index;
+			Shard.Index.Add(Key, EntryIndex);
+			Shard.TotalCost += Cost;
+		}
+
+		Evict(Shard, EntryIndex);
+	}
+
+	/**
+	 * Removes the entry with the given key, without calling the eviction callback.
+	 *
+	 * @return true if the key was in the cache.
+	 */
+	bool Remove(KeyConstPointerType Key)
+	{
+		FShard& Shard = GetShard(KeyFuncs::GetKeyHash(Key));
+		FWriteScopeLock WriteLock(Shard.Lock);
+		if (const int32* EntryIndex = Shard.Index.Find(Key))
+		{
+			const int32 RemovedIndex = *EntryIndex;
+			Shard.TotalCost -= Shard.Entries[RemovedIndex].Cost;
+			Shard.Entries.RemoveAt(RemovedIndex);
+			Shard.Index.Remove(Key);
+			return true;
+		}
+		return false;
+	}
+
+	/** Removes all the entries without calling the eviction callback, the statistics are kept. */
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FWriteScopeLock WriteLock(Shard.Lock);
+			Shard.Entries.Empty();
+			Shard.Index.Empty();
+			Shard.TotalCost = 0;
+			Shard.ClockHand = 0;
+		}
+	}
+
+	/** @return The number of entries in the cache, which may already be outdated if other threads are using it. */
+	int32 Num() const
+	{
+		int32 Result = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			Result += Shard.Entries.Num();
+		}
+		return Result;
+	}
+
+	/** @return The statistics summed over all the shards. */
+	FConcurrentLruCacheStats GetStats() const
+	{
+		FConcurrentLruCacheStats Stats;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			Stats.NumHits += Shard.NumHits.Load(EMemoryOrder::Relaxed);
+			Stats.NumMisses += Shard.NumMisses.Load(EMemoryOrder::Relaxed);
+			Stats.NumEvictions += Shard.NumEvictions;
+			Stats.NumEntries += Shard.Entries.Num();
+			Stats.TotalCost += Shard.TotalCost;
+		}
+		return Stats;
+	}
+
+	/**
+	 * Reports the statistics as CountersTrace counters named after the cache, e.g. "AssetCache/HitRate".
+	 * Not thread safe, call it from a single thread, for instance once per frame.
+	 */
+	void TraceStats(const TCHAR* CacheName)
+	{
+#if COUNTERSTRACE_ENABLED
+		if (!TraceCounters.IsValid())
+		{
+			TraceCounters = MakeUnique<FTraceCounters>(CacheName);
+		}
+
+		const FConcurrentLruCacheStats Stats = GetStats();
+		TraceCounters->HitRate.Set(Stats.GetHitRate());
+		TraceCounters->NumEvictions.Set(int64(Stats.NumEvictions));
+		TraceCounters->NumEntries.Set(Stats.NumEntries);
+		TraceCounters->TotalCost.Set(int64(Stats.TotalCost));
+#endif
+	}
+
+private:
+	enum { NumShards = 1 << NumShardsLog2 };
+
+	struct FEntry
+	{
+		template <typename InitValueType>
+		FEntry(const KeyType& InKey, InitValueType&& InValue, uint64 InCost)
+			: Key(InKey)
+			, Value(Forward<InitValueType>(InValue))
+			, Cost(InCost)
+			, bReferenced(false)
+		{
+		}
+
+		KeyType Key;
+		ValueType Value;
+		uint64 Cost;
+
+		/** Set by lookups, cleared by the clock hand passing over the entry */
+		mutable TAtomic<bool> bReferenced;
+	};
+
+	/** Each shard is on its own cache line so locking one doesn't slow down threads using the neighboring ones */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TFlatMap<KeyType, int32, FDefaultAllocator, KeyFuncs> Index;
+		TSparseArray<FEntry> Entries;
+		uint64 TotalCost = 0;
+		int32 ClockHand = 0;
+		uint64 NumEvictions = 0;
+
+		/** Updated by lookups, which only hold the read lock */
+		TAtomic<uint64> NumHits { 0 };
+		TAtomic<uint64> NumMisses { 0 };
+	};
+
+	/** Sweeps the clock hand over the shard until it's within the budgets, never evicting KeepIndex */
+	void Evict(FShard& Shard, int32 KeepIndex)
+	{
+		while ((Shard.Entries.Num() > MaxNumEntriesPerShard || Shard.TotalCost > MaxCostPerShard) && Shard.Entries.Num() > 1)
+		{
+			if (Shard.ClockHand >= Shard.Entries.GetMaxIndex())
+			{
+				Shard.ClockHand = 0;
+			}
+
+			const int32 EntryIndex = Shard.ClockHand++;
+			if (!Shard.Entries.IsAllocated(EntryIndex) || EntryIndex == KeepIndex)
+			{
+				continue;
+			}
+
+			FEntry& Entry = Shard.Entries[EntryIndex];
+			if (Entry.bReferenced.Load(EMemoryOrder::Relaxed))
+			{
+				Entry.bReferenced.Store(false, EMemoryOrder::Relaxed);
+				continue;
+			}
+
+			if (OnEvicted)
+			{
+				OnEvicted(Entry.Key, Entry.Value);
+			}
+			Shard.TotalCost -= Entry.Cost;
+			Shard.Index.Remove(Entry.Key);
+			Shard.Entries.RemoveAt(EntryIndex);
+			++Shard.NumEvictions;
+		}
+	}
+
+	FORCEINLINE FShard& GetShard(uint32 KeyHash)
+	{
+		// Same shard selection as TConcurrentMap, keeping the low bits for the shard's own hash table
+		return Shards[(KeyHash * 0x9E3779B1u) >> (32 - NumShardsLog2)];
+	}
+
+	FORCEINLINE const FShard& GetShard(uint32 KeyHash) const
+	{
+		return const_cast<TConcurrentLruCache*>(this)->GetShard(KeyHash);
+	}
+
+	const int32 MaxNumEntriesPerShard;
+	const uint64 MaxCostPerShard;
+	FOnEvicted OnEvicted;
+	FShard Shards[NumShards];
+
+#if COUNTERSTRACE_ENABLED
+	struct FTraceCounters
+	{
+		explicit FTraceCounters(const TCHAR* CacheName)
+			: HitRateName(FString(CacheName) + TEXT("/HitRate"))
+			, NumEvictionsName(FString(CacheName) + TEXT("/Evictions"))
+			, NumEntriesName(FString(CacheName) + TEXT("/Entries"))
+			, TotalCostName(FString(CacheName) + TEXT("/Cost"))
+			, HitRate(*HitRateName, TraceCounterDisplayHint_None)
+			, NumEvictions(*NumEvictionsName, TraceCounterDisplayHint_None)
+			, NumEntries(*NumEntriesName, TraceCounterDisplayHint_None)
+			, TotalCost(*TotalCostName, TraceCounterDisplayHint_Memory)
+		{
+		}
+
+		// The counters keep pointers to their names
+		FString HitRateName;
+		FString NumEvictionsName;
+		FString NumEntriesName;
+		FString TotalCostName;
+		FCountersTrace::FCounterFloat HitRate;
+		FCountersTrace::FCounterInt NumEvictions;
+		FCountersTrace::FCounterInt NumEntries;
+		FCountersTrace::FCounterInt TotalCost;
+	};
+
+	TUniquePtr<FTraceCounters> TraceCounters;
+#endif
+
+	UE_NONCOPYABLE(TConcurrentLruCache);
+};
@@ -0,0 +1,254 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/Optional.h"
+#include "Containers/Map.h"
+#include "Containers/FlatSet.h"
+
+/**
+ * A hash map that can be used from many threads at once without an external lock, for caches shared between threads.
+ *
+ * The keys are spread over 2^NumShardsLog2 shards, each a TFlatSet of pairs behind its own read/write lock on its own cache line.
+ * Lookups only read lock the shard of their key, so they run in parallel with each other and only wait for writes to
+ * the same shard, and writes to different shards don't contend either.
+ *
+ * As other threads can change the map at any time, values are returned by copy rather than by reference, so this is
+ * best suited to small values such as pointers or shared references. FindOrProduce only calls the producer when the
+ * key is missing, for values that are expensive to create.
+ **/
+template<typename KeyType, typename ValueType, uint32 NumShardsLog2 = 4, typename KeyFuncs = TDefaultMapHashableKeyFuncs<KeyType, ValueType, false> >
+class TConcurrentMap
+{
+	static_assert(NumShardsLog2 > 0 && NumShardsLog2 <= 10, "TConcurrentMap needs between 2 and 1024 shards");
+
+public:
+	typedef typename TTypeTraits<KeyType>::ConstPointerType KeyConstPointerType;
+
+	TConcurrentMap() = default;
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return A copy of the value associated with the key, or an unset optional if the key isn't contained in the map.
+	 */
+	TOptional<ValueType> Find(KeyConstPointerType Key) const
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		const FShard& Shard = GetShard(KeyHash);
+		FReadScopeLock ReadLock(Shard.Lock);
+		if (const TPair<KeyType, ValueType>* Pair = Shard.Pairs.FindByHash(KeyHash, Key))
+		{
+			return Pair->Value;
+		}
+		return TOptional<ValueType>();
+	}
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return A copy of the value associated with the key, or the default value for the ValueType if the key isn't contained in the map.
+	 */
+	ValueType FindRef(KeyConstPointerType Key) const
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		const FShard& Shard = GetShard(KeyHash);
+		FReadScopeLock ReadLock(Shard.Lock);
+		const TPair<KeyType, ValueType>* Pair = Shard.Pairs.FindByHash(KeyHash, Key);
+		return Pair ? Pair->Value : ValueType();
+	}
+
+	/** @return true if the map contains the key. */
+	bool Contains(KeyConstPointerType Key) const
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		const FShard& Shard = GetShard(KeyHash);
+		FReadScopeLock ReadLock(Shard.Lock);
+		return Shard.Pairs.ContainsByHash(KeyHash, Key);
+	}
+
+	/**
+	 * Sets the value associated with a key, replacing the existing one.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @param InValue The value to associate with the key.
+	 */
+	template <typename InitKeyType, typename InitValueType>
+	void Emplace(InitKeyType&& InKey, InitValueType&& InValue)
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(InKey);
+		FShard& Shard = GetShard(KeyHash);
+		FWriteScopeLock WriteLock(Shard.Lock);
+		Shard.Pairs.EmplaceByHash(KeyHash, TPairInitializer<InitKeyType&&, InitValueType&&>(Forward<InitKeyType>(InKey), Forward<InitValueType>(InValue)));
+	}
+
+	FORCEINLINE void Add(const KeyType&  InKey, const ValueType&  InValue) { Emplace(InKey, InValue); }
+	FORCEINLINE void Add(const KeyType&  InKey,		  ValueType&& InValue) { Emplace(InKey, MoveTempIfPossible(InValue)); }
+	FORCEINLINE void Add(		KeyType&& InKey, const ValueType&  InValue) { Emplace(MoveTempIfPossible(InKey), InValue); }
+	FORCEINLINE void Add(		KeyType&& InKey,		  ValueType&& InValue) { Emplace(MoveTempIfPossible(InKey), MoveTempIfPossible(InValue)); }
+
+	/**
+	 * Find the value associated with a specified key, or if none exists, adds the given value.
+	 *
+	 * @param Key The key to search for.
+	 * @param Value The value to add if the key isn't in the map.
+	 * @return A copy of the value associated with the key, which is the one from another thread if it added the key first.
+	 */
+	ValueType FindOrAdd(const KeyType& Key, const ValueType& Value)
+	{
+		return FindOrProduce(Key, [&Value]() { return Value; });
+	}
+
+	/** Find the value associated with a specified key, or if none exists, adds a value using the default constructor. */
+	ValueType FindOrAdd(const KeyType& Key)
+	{
+		return FindOrProduce(Key, []() { return ValueType(); });
+	}
+
+	/**
+	 * Find the value associated with a specified key, or if none exists, adds the value returned by Producer.
+	 *
+	 * Producer is called with the shard write locked, so concurrent callers missing the same key don't both produce
+	 * a value. It mustn't access the map itself.
+	 *
+	 * @param Key The key to search for.
+	 * @param Producer Callable returning the value to add.
+	 * @return A copy of the value associated with the key.
+	 */
+	template <typename ProducerType>
+	ValueType FindOrProduce(const KeyType& Key, ProducerType&& Producer)
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		FShard& Shard = GetShard(KeyHash);
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			if (const TPair<KeyType, ValueType>* Pair = Shard.Pairs.FindByHash(KeyHash, Key))
+			{
+				return Pair->Value;
+			}
+		}
+
+		// Another thread may have added the key since the read lock was released
+		FWriteScopeLock WriteLock(Shard.Lock);
+		if (const TPair<KeyType, ValueType>* Pair = Shard.Pairs.FindByHash(KeyHash, Key))
+		{
+			return Pair->Value;
+		}
+		return Shard.Pairs.EmplaceByHash(KeyHash, TPairInitializer<const KeyType&, ValueType&&>(Key, Producer())).Value;
+	}
+
+	/**
+	 * Remove the value association for a key.
+	 *
+	 * @param Key The key to remove the associated value for.
+	 * @return The number of values that were associated with the key.
+	 */
+	int32 Remove(KeyConstPointerType Key)
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		FShard& Shard = GetShard(KeyHash);
+		FWriteScopeLock WriteLock(Shard.Lock);
+		return Shard.Pairs.RemoveByHash(KeyHash, Key);
+	}
+
+	/**
+	 * Removes the value association for a key, copying the value out first.
+	 *
+	 * @param Key The key to remove the associated value for.
+	 * @param OutRemovedValue If the key was found, the value is copied here.
+	 * @return true if the key was found.
+	 */
+	bool RemoveAndCopyValue(KeyConstPointerType Key, ValueType& OutRemovedValue)
+	{
+		const uint32 KeyHash = KeyFuncs::GetKeyHash(Key);
+		FShard& Shard = GetShard(KeyHash);
+		FWriteScopeLock WriteLock(Shard.Lock);
+		TPair<KeyType, ValueType>* Pair = Shard.Pairs.FindByHash(KeyHash, Key);
+		if (!Pair)
+		{
+			return false;
+		}
+		OutRemovedValue = MoveTempIfPossible(Pair->Value);
+		Shard.Pairs.RemoveByHash(KeyHash, Key);
+		return true;
+	}
+
+	/** Removes all elements from the map. */
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FWriteScopeLock WriteLock(Shard.Lock);
+			Shard.Pairs.Empty();
+		}
+	}
+
+	/** @return The number of elements in the map, which may already be outdated if other threads are adding or removing keys. */
+	int32 Num() const
+	{
+		int32 Result = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			Result += Shard.Pairs.Num();
+		}
+		return Result;
+	}
+
+	/**
+	 * Calls Func with each key and value, read locking one shard at a time. Pairs added or removed by other threads
+	 * during the call may or may not be visited. Func mustn't access the map itself.
+	 */
+	template <typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			for (const TPair<KeyType, ValueType>& Pair : Shard.Pairs)
+			{
+				Func(Pair.Key, Pair.Value);
+			}
+		}
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Result = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			Result += Shard.Pairs.GetAllocatedSize();
+		}
+		return Result;
+	}
+
+private:
+	/** Each shard is on its own cache line so locking one doesn't slow down threads using the neighboring ones */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TFlatSet<TPair<KeyType, ValueType>, KeyFuncs> Pairs;
+	};
+
+	FORCEINLINE FShard& GetShard(uint32 KeyHash)
+	{
+		// Uses the top bits of a different multiplier than TFlatSet so the keys of a shard are still spread over its slots
+		return Shards[(KeyHash * 0x9E3779B1u) >> (32 - NumShardsLog2)];
+	}
+
+	FORCEINLINE const FShard& GetShard(uint32 KeyHash) const
+	{
+		return const_cast<TConcurrentMap*>(this)->GetShard(KeyHash);
+	}
+
+	FShard Shards[1 << NumShardsLog2];
+
+	UE_NONCOPYABLE(TConcurrentMap);
+};
@@ -0,0 +1,329 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Containers/Map.h"
+#include "Containers/FlatSet.h"
+#include <initializer_list>
+
+/**
+ * An open addressing hash map, usable in place of TMap where lookup speed matters more than stable element ids.
+ * Implemented using a TFlatSet of key-value pairs with the same KeyFuncs as TMap, see TFlatSet for how it's laid out.
+ *
+ * Removing a pair doesn't move any other pair, but adding one may rehash the map and invalidate references to its
+ * keys and values. Duplicate keys are not supported.
+ **/
+template<typename KeyType, typename ValueType, typename Allocator = FDefaultAllocator, typename KeyFuncs = TDefaultMapHashableKeyFuncs<KeyType, ValueType, false> >
+class TFlatMap
+{
+public:
+	typedef typename TTypeTraits<KeyType  >::ConstPointerType KeyConstPointerType;
+	typedef typename TTypeTraits<KeyType  >::ConstInitType    KeyInitType;
+	typedef typename TTypeTraits<ValueType>::ConstInitType    ValueInitType;
+	typedef TPair<KeyType, ValueType> ElementType;
+
+	TFlatMap() = default;
+	TFlatMap(TFlatMap&&) = default;
+	TFlatMap(const TFlatMap&) = default;
+	TFlatMap& operator=(TFlatMap&&) = default;
+	TFlatMap& operator=(const TFlatMap&) = default;
+
+	/** Initializer list constructor. */
+	TFlatMap(std::initializer_list<TPairInitializer<const KeyType&, const ValueType&>> InitList)
+	{
+		Pairs.Reserve((int32)InitList.size());
+		for (const TPairInitializer<const KeyType&, const ValueType&>& Element : InitList)
+		{
+			Add(Element.Key, Element.Value);
+		}
+	}
+
+	/** @return The number of elements in the map. */
+	FORCEINLINE int32 Num() const
+	{
+		return Pairs.Num();
+	}
+
+	/**
+	 * Removes all elements from the map, potentially leaving space allocated for an expected number of elements about to be added.
+	 * @param ExpectedNumElements - The number of elements about to be added to the map.
+	 */
+	FORCEINLINE void Empty(int32 ExpectedNumElements = 0)
+	{
+		Pairs.Empty(ExpectedNumElements);
+	}
+
+	/** Efficiently empties out the map but preserves all allocations and capacities */
+	FORCEINLINE void Reset()
+	{
+		Pairs.Reset();
+	}
+
+	/** Preallocates enough memory to contain Number elements */
+	FORCEINLINE void Reserve(int32 Number)
+	{
+		Pairs.Reserve(Number);
+	}
+
+	/** Shrinks the allocations to fit the elements in the map. */
+	FORCEINLINE void Shrink()
+	{
+		Pairs.Shrink();
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return Pairs.GetAllocatedSize();
+	}
+
+	/**
+	 * Sets the value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @param InValue The value to associate with the key.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next element is added to the map.
+	 */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey, const ValueType&  InValue) { return Emplace(InKey, InValue); }
+	FORCEINLINE ValueType& Add(const KeyType&  InKey,		ValueType&& InValue) { return Emplace(InKey, MoveTempIfPossible(InValue)); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey, const ValueType&  InValue) { return Emplace(MoveTempIfPossible(InKey), InValue); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey,		ValueType&& InValue) { return Emplace(MoveTempIfPossible(InKey), MoveTempIfPossible(InValue)); }
+
+	/**
+	 * Sets a default value associated with a key.
+	 *
+	 * @param InKey The key to associate a new value with.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next element is added to the map.
+	 */
+	FORCEINLINE ValueType& Add(const KeyType&  InKey) { return Emplace(InKey); }
+	FORCEINLINE ValueType& Add(		 KeyType&& InKey) { return Emplace(MoveTempIfPossible(InKey)); }
+
+	/**
+	 * Sets the value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @param InValue The value to associate with the key.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next element is added to the map.
+	 */
+	template <typename InitKeyType, typename InitValueType>
+	ValueType& Emplace(InitKeyType&& InKey, InitValueType&& InValue)
+	{
+		return Pairs.Emplace(TPairInitializer<InitKeyType&&, InitValueType&&>(Forward<InitKeyType>(InKey), Forward<InitValueType>(InValue))).Value;
+	}
+
+	/**
+	 * Set a default value associated with a key.
+	 *
+	 * @param InKey The key to associate the value with.
+	 * @return A reference to the value as stored in the map. The reference is only valid until the next element is added to the map.
+	 */
+	template <typename InitKeyType>
+	ValueType& Emplace(InitKeyType&& InKey)
+	{
+		return Pairs.Emplace(TKeyInitializer<InitKeyType&&>(Forward<InitKeyType>(InKey))).Value;
+	}
+
+	/**
+	 * Remove the value association for a key.
+	 *
+	 * @param InKey The key to remove the associated value for.
+	 * @return The number of values that were associated with the key.
+	 */
+	FORCEINLINE int32 Remove(KeyConstPointerType InKey)
+	{
+		return Pairs.Remove(InKey);
+	}
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return A pointer to the value associated with the specified key, or nullptr if the key isn't contained in this map. The pointer
+	 *			is only valid until the next element is added to the map.
+	 */
+	FORCEINLINE ValueType* Find(KeyConstPointerType Key)
+	{
+		ElementType* Pair = Pairs.Find(Key);
+		return Pair ? &Pair->Value : nullptr;
+	}
+
+	FORCEINLINE const ValueType* Find(KeyConstPointerType Key) const
+	{
+		return const_cast<TFlatMap*>(this)->Find(Key);
+	}
+
+	/**
+	 * Find the value associated with a specified key, or if none exists,
+	 * adds a value using the default constructor.
+	 *
+	 * @param Key The key to search for.
+	 * @return A reference to the value associated with the specified key.
+	 */
+	FORCEINLINE ValueType& FindOrAdd(const KeyType&  Key) { return FindOrAddImpl(HashKey(Key),					  Key); }
+	FORCEINLINE ValueType& FindOrAdd(      KeyType&& Key) { return FindOrAddImpl(HashKey(Key), MoveTempIfPossible(Key)); }
+
+	/**
+	 * Find a reference to the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or triggers an assertion if the key does not exist.
+	 */
+	FORCEINLINE ValueType& FindChecked(KeyConstPointerType Key)
+	{
+		ElementType* Pair = Pairs.Find(Key);
+		check(Pair != nullptr);
+		return Pair->Value;
+	}
+
+	FORCEINLINE const ValueType& FindChecked(KeyConstPointerType Key) const
+	{
+		return const_cast<TFlatMap*>(this)->FindChecked(Key);
+	}
+
+	/**
+	 * Find the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or the default value for the ValueType if the key isn't contained in this map.
+	 */
+	FORCEINLINE ValueType FindRef(KeyConstPointerType Key) const
+	{
+		const ElementType* Pair = Pairs.Find(Key);
+		return Pair ? Pair->Value : ValueType();
+	}
+
+	/**
+	 * Check if map contains the specified key.
+	 *
+	 * @param Key The key to check for.
+	 * @return true if the map contains the key.
+	 */
+	FORCEINLINE bool Contains(KeyConstPointerType Key) const
+	{
+		return Pairs.Contains(Key);
+	}
+
+	/** Same as FindChecked */
+	FORCEINLINE       ValueType& operator[](KeyConstPointerType Key)       { return FindChecked(Key); }
+	FORCEINLINE const ValueType& operator[](KeyConstPointerType Key) const { return FindChecked(Key); }
+
+private:
+	typedef TFlatSet<ElementType, KeyFuncs, Allocator> ElementSetType;
+
+	/** The base of TFlatMap iterators. */
+	template<bool bConst>
+	class TBaseIterator
+	{
+	public:
+		typedef typename TChooseClass<bConst, typename ElementSetType::TConstIterator, typename ElementSetType::TIterator>::Result PairItType;
+	private:
+		typedef typename TChooseClass<bConst, const KeyType, KeyType>::Result ItKeyType;
+		typedef typename TChooseClass<bConst, const ValueType, ValueType>::Result ItValueType;
+		typedef typename TChooseClass<bConst, const ElementType, ElementType>::Result PairType;
+
+	public:
+		FORCEINLINE TBaseIterator(const PairItType& InElementIt)
+			: PairIt(InElementIt)
+		{
+		}
+
+		FORCEINLINE TBaseIterator& operator++()
+		{
+			++PairIt;
+			return *this;
+		}
+
+		/** conversion to "bool" returning true if the iterator is valid. */
+		FORCEINLINE explicit operator bool() const
+		{
+			return !!PairIt;
+		}
+		/** inverse of the "bool" operator */
+		FORCEINLINE bool operator !() const
+		{
+			return !(bool)*this;
+		}
+
+		FORCEINLINE friend bool operator==(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.PairIt == Rhs.PairIt; }
+		FORCEINLINE friend bool operator!=(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.PairIt != Rhs.PairIt; }
+
+		FORCEINLINE ItKeyType&   Key()   const { return PairIt->Key; }
+		FORCEINLINE ItValueType& Value() const { return PairIt->Value; }
+
+		FORCEINLINE PairType& operator* () const { return  *PairIt; }
+		FORCEINLINE PairType* operator->() const { return &*PairIt; }
+
+	protected:
+		PairItType PairIt;
+	};
+
+public:
+	/** Map iterator. */
+	class TIterator : public TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE TIterator(TFlatMap& InMap, int32 StartIndex = 0)
+			: TBaseIterator<false>(typename ElementSetType::TIterator(InMap.Pairs, StartIndex))
+		{
+		}
+
+		/** Removes the current pair from the map, the iterator can still be advanced afterwards. */
+		FORCEINLINE void RemoveCurrent()
+		{
+			this->PairIt.RemoveCurrent();
+		}
+	};
+
+	/** Const map iterator. */
+	class TConstIterator : public TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE TConstIterator(const TFlatMap& InMap, int32 StartIndex = 0)
+			: TBaseIterator<true>(typename ElementSetType::TConstIterator(InMap.Pairs, StartIndex))
+		{
+		}
+	};
+
+	/** Creates an iterator over all the pairs in this map */
+	FORCEINLINE TIterator CreateIterator()
+	{
+		return TIterator(*this);
+	}
+
+	/** Creates a const iterator over all the pairs in this map */
+	FORCEINLINE TConstIterator CreateConstIterator() const
+	{
+		return TConstIterator(*this);
+	}
+
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE TIterator      begin()       { return TIterator(*this); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(*this); }
+	FORCEINLINE TIterator      end()         { return TIterator(*this, Pairs.Max()); }
+	FORCEINLINE TConstIterator end() const   { return TConstIterator(*this, Pairs.Max()); }
+
+private:
+	FORCEINLINE static uint32 HashKey(const KeyType& Key)
+	{
+		return KeyFuncs::GetKeyHash(Key);
+	}
+
+	template <typename InitKeyType>
+	ValueType& FindOrAddImpl(uint32 KeyHash, InitKeyType&& Key)
+	{
+		if (ElementType* Pair = Pairs.FindByHash(KeyHash, Key))
+		{
+			return Pair->Value;
+		}
+
+		return Pairs.EmplaceByHash(KeyHash, TKeyInitializer<InitKeyType&&>(Forward<InitKeyType>(Key))).Value;
+	}
+
+	/** A set of the key-value pairs in the map. */
+	ElementSetType Pairs;
+};
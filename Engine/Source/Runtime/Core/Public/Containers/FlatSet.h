@@ -0,0 +1,783 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/Set.h"
+#include "Math/UnrealMathUtility.h"
+#include <initializer_list>
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_FLATSET_USE_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define UE_FLATSET_USE_SSE2 0
+#endif
+
+namespace UE4FlatSet_Private
+{
+	/**
+	 * Each slot has a control byte: the top bit is set for empty and deleted slots, full slots store 7 bits of the
+	 * element's hash so most mismatching slots can be skipped without touching the elements.
+	 */
+	enum : uint8
+	{
+		EmptyControl = 0x80,
+		DeletedControl = 0xFE,
+	};
+
+	/** Number of slots whose control bytes are matched at once */
+	enum { GroupSize = 16 };
+
+	/** One bit per slot of a group, iterated from the lowest slot */
+	struct FGroupMask
+	{
+		uint32 Bits;
+
+		FORCEINLINE explicit FGroupMask(uint32 InBits)
+			: Bits(InBits)
+		{
+		}
+
+		FORCEINLINE explicit operator bool() const
+		{
+			return Bits != 0;
+		}
+
+		FORCEINLINE int32 GetLowestIndex() const
+		{
+			return int32(FMath::CountTrailingZeros(Bits));
+		}
+
+		FORCEINLINE void ClearLowest()
+		{
+			Bits &= Bits - 1;
+		}
+	};
+
+	/** The control bytes of a group, matched with a single SSE2 compare when available */
+	struct FGroup
+	{
+		FORCEINLINE explicit FGroup(const uint8* Control)
+		{
+#if UE_FLATSET_USE_SSE2
+			Data = _mm_loadu_si128((const __m128i*)Control);
+#else
+			FMemory::Memcpy(Data, Control, GroupSize);
+#endif
+		}
+
+		/** @return The full slots whose control byte matches HashBits */
+		FORCEINLINE FGroupMask Match(uint8 HashBits) const
+		{
+#if UE_FLATSET_USE_SSE2
+			return FGroupMask(uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(Data, _mm_set1_epi8(char(HashBits))))));
+#else
+			uint32 Bits = 0;
+			for (int32 Index = 0; Index < GroupSize; ++Index)
+			{
+				Bits |= uint32(Data[Index] == HashBits) << Index;
+			}
+			return FGroupMask(Bits);
+#endif
+		}
+
+		FORCEINLINE FGroupMask MatchEmpty() const
+		{
+			return Match(EmptyControl);
+		}
+
+		FORCEINLINE FGroupMask MatchEmptyOrDeleted() const
+		{
+#if UE_FLATSET_USE_SSE2
+			return FGroupMask(uint32(_mm_movemask_epi8(Data)));
+#else
+			uint32 Bits = 0;
+			for (int32 Index = 0; Index < GroupSize; ++Index)
+			{
+				Bits |= uint32(Data[Index] >> 7) << Index;
+			}
+			return FGroupMask(Bits);
+#endif
+		}
+
+		FORCEINLINE FGroupMask MatchFull() const
+		{
+			return FGroupMask(~MatchEmptyOrDeleted().Bits & ((1u << GroupSize) - 1));
+		}
+
+	private:
+#if UE_FLATSET_USE_SSE2
+		__m128i Data;
+#else
+		uint8 Data[GroupSize];
+#endif
+	};
+
+	/** Spreads the bits of a key hash, as the hash of integer keys is often the key itself */
+	FORCEINLINE uint64 MixHash(uint32 KeyHash)
+	{
+		return uint64(KeyHash) * 0x9E3779B97F4A7C15ull;
+	}
+
+	/** @return The bits selecting the first group probed */
+	FORCEINLINE uint32 GetGroupHash(uint64 MixedHash)
+	{
+		return uint32(MixedHash >> 32);
+	}
+
+	/** @return The bits stored in the control byte */
+	FORCEINLINE uint8 GetControlHash(uint64 MixedHash)
+	{
+		return uint8(MixedHash >> 25) & 0x7F;
+	}
+}
+
+/**
+ * An open addressing hash set, usable in place of TSet where lookup speed matters more than stable element ids.
+ *
+ * Elements are stored in a flat array next to an array of control bytes, one per element slot. A lookup loads
+ * the control bytes of a group of 16 slots at once and only compares the elements whose stored hash bits match,
+ * so it usually costs a single cache miss in the control bytes and one in the elements, where TSet needs to go
+ * through its hash buckets and element links.
+ *
+ * Removing an element doesn't move any other element, so it is safe while iterating, but adding one may rehash
+ * the set and invalidate pointers to its elements. Duplicate keys are not supported.
+ *
+ * The allocator is a container allocation policy like the ones used by TArray, with the element slots and the
+ * control bytes each getting their own allocation.
+ **/
+template<typename InElementType, typename KeyFuncs = DefaultKeyFuncs<InElementType>, typename Allocator = FDefaultAllocator>
+class TFlatSet
+{
+	static_assert(!KeyFuncs::bAllowDuplicateKeys, "TFlatSet doesn't support duplicate keys");
+
+public:
+	typedef InElementType ElementType;
+	typedef typename KeyFuncs::KeyInitType KeyInitType;
+	typedef typename KeyFuncs::ElementInitType ElementInitType;
+
+	/** Default constructor. */
+	FORCEINLINE TFlatSet()
+		: NumElements(0)
+		, NumDeleted(0)
+		, NumGroups(0)
+	{
+	}
+
+	/** Copy constructor. */
+	FORCEINLINE TFlatSet(const TFlatSet& Copy)
+		: TFlatSet()
+	{
+		*this = Copy;
+	}
+
+	/** Move constructor. */
+	FORCEINLINE TFlatSet(TFlatSet&& Other)
+		: TFlatSet()
+	{
+		MoveFrom(Other);
+	}
+
+	/** Initializer list constructor. */
+	TFlatSet(std::initializer_list<ElementType> InitList)
+		: TFlatSet()
+	{
+		Reserve((int32)InitList.size());
+		for (const ElementType& Element : InitList)
+		{
+			Add(Element);
+		}
+	}
+
+	/** Destructor. */
+	FORCEINLINE ~TFlatSet()
+	{
+		DestructElements();
+	}
+
+	/** Assignment operator. */
+	TFlatSet& operator=(const TFlatSet& Copy)
+	{
+		if (this != &Copy)
+		{
+			DestructElements();
+			ResizeAllocations(Copy.NumGroups);
+
+			// The copy uses the same slots so nothing needs rehashing
+			const int32 NumSlots = GetNumSlots();
+			if (NumSlots)
+			{
+				FMemory::Memcpy(Control.GetAllocation(), Copy.Control.GetAllocation(), NumSlots);
+				for (int32 Index = Copy.FindNextFull(0); Index < NumSlots; Index = Copy.FindNextFull(Index + 1))
+				{
+					new(GetSlot(Index)) ElementType(*Copy.GetSlot(Index));
+				}
+			}
+			NumElements = Copy.NumElements;
+			NumDeleted = Copy.NumDeleted;
+		}
+		return *this;
+	}
+
+	/** Move assignment operator. */
+	TFlatSet& operator=(TFlatSet&& Other)
+	{
+		if (this != &Other)
+		{
+			DestructElements();
+			ResizeAllocations(0);
+			MoveFrom(Other);
+		}
+		return *this;
+	}
+
+	/** @return The number of elements in the set. */
+	FORCEINLINE int32 Num() const
+	{
+		return NumElements;
+	}
+
+	/** @return The number of element slots allocated, some of which always stay free. */
+	FORCEINLINE int32 Max() const
+	{
+		return GetNumSlots();
+	}
+
+	/**
+	 * Removes all elements from the set, potentially leaving space allocated for an expected number of elements about to be added.
+	 * @param ExpectedNumElements - The number of elements about to be added to the set.
+	 */
+	void Empty(int32 ExpectedNumElements = 0)
+	{
+		DestructElements();
+		const uint32 NewNumGroups = ExpectedNumElements > 0 ? GetNumGroupsForElements(ExpectedNumElements) : 0;
+		if (NewNumGroups != NumGroups)
+		{
+			ResizeAllocations(NewNumGroups);
+		}
+		else
+		{
+			ResetControl();
+		}
+		NumElements = 0;
+		NumDeleted = 0;
+	}
+
+	/** Efficiently empties out the set but preserves all allocations and capacities */
+	void Reset()
+	{
+		DestructElements();
+		ResetControl();
+		NumElements = 0;
+		NumDeleted = 0;
+	}
+
+	/** Preallocates enough memory to contain Number elements */
+	void Reserve(int32 Number)
+	{
+		const uint32 NewNumGroups = GetNumGroupsForElements(Number);
+		if (NewNumGroups > NumGroups)
+		{
+			Rehash(NewNumGroups);
+		}
+	}
+
+	/** Shrinks the allocations to fit the elements in the set, dropping the deleted slots. */
+	void Shrink()
+	{
+		const uint32 NewNumGroups = NumElements > 0 ? GetNumGroupsForElements(NumElements) : 0;
+		if (NewNumGroups == 0)
+		{
+			ResizeAllocations(0);
+			NumDeleted = 0;
+		}
+		else if (NewNumGroups < NumGroups || NumDeleted > 0)
+		{
+			Rehash(NewNumGroups);
+		}
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return Elements.GetAllocatedSize(GetNumSlots(), sizeof(ElementType)) + Control.GetAllocatedSize(GetNumSlots(), sizeof(uint8));
+	}
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	InElement			Element to add to set
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added.
+	 */
+	FORCEINLINE ElementType& Add(const ElementType&  InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(InElement, bIsAlreadyInSetPtr); }
+	FORCEINLINE ElementType& Add(      ElementType&& InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(MoveTempIfPossible(InElement), bIsAlreadyInSetPtr); }
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	Args				The argument(s) to be forwarded to the set element's constructor.
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added.
+	 */
+	template <typename ArgsType>
+	ElementType& Emplace(ArgsType&& Args, bool* bIsAlreadyInSetPtr = nullptr)
+	{
+		TTypeCompatibleBytes<ElementType> NewElement;
+		new(&NewElement) ElementType(Forward<ArgsType>(Args));
+		return AddConstructed(*NewElement.GetTypedPtr(), KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(*NewElement.GetTypedPtr())), bIsAlreadyInSetPtr);
+	}
+
+	/** Same as Emplace, taking the precomputed hash of the element's key. */
+	template <typename ArgsType>
+	ElementType& EmplaceByHash(uint32 KeyHash, ArgsType&& Args, bool* bIsAlreadyInSetPtr = nullptr)
+	{
+		TTypeCompatibleBytes<ElementType> NewElement;
+		new(&NewElement) ElementType(Forward<ArgsType>(Args));
+		return AddConstructed(*NewElement.GetTypedPtr(), KeyHash, bIsAlreadyInSetPtr);
+	}
+
+	/**
+	 * Removes the element with the given key.
+	 * @return The number of elements removed.
+	 */
+	FORCEINLINE int32 Remove(KeyInitType Key)
+	{
+		return RemoveByHash(KeyFuncs::GetKeyHash(Key), Key);
+	}
+
+	/** Same as Remove, taking the precomputed hash of the key. */
+	template<typename ComparableKey>
+	int32 RemoveByHash(uint32 KeyHash, const ComparableKey& Key)
+	{
+		const int32 Index = FindIndexByHash(KeyHash, Key);
+		if (Index == INDEX_NONE)
+		{
+			return 0;
+		}
+		RemoveAt(Index);
+		return 1;
+	}
+
+	/**
+	 * Finds an element with the given key in the set.
+	 * @return A pointer to the element, or nullptr if the set doesn't contain one with this key.
+	 */
+	FORCEINLINE ElementType* Find(KeyInitType Key)
+	{
+		return FindByHash(KeyFuncs::GetKeyHash(Key), Key);
+	}
+
+	FORCEINLINE const ElementType* Find(KeyInitType Key) const
+	{
+		return const_cast<TFlatSet*>(this)->Find(Key);
+	}
+
+	/** Same as Find, taking the precomputed hash of the key. */
+	template<typename ComparableKey>
+	FORCEINLINE ElementType* FindByHash(uint32 KeyHash, const ComparableKey& Key)
+	{
+		const int32 Index = FindIndexByHash(KeyHash, Key);
+		return Index != INDEX_NONE ? GetSlot(Index) : nullptr;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE const ElementType* FindByHash(uint32 KeyHash, const ComparableKey& Key) const
+	{
+		return const_cast<TFlatSet*>(this)->FindByHash(KeyHash, Key);
+	}
+
+	/** @return Whether the set contains an element with the given key. */
+	FORCEINLINE bool Contains(KeyInitType Key) const
+	{
+		return FindIndexByHash(KeyFuncs::GetKeyHash(Key), Key) != INDEX_NONE;
+	}
+
+	template<typename ComparableKey>
+	FORCEINLINE bool ContainsByHash(uint32 KeyHash, const ComparableKey& Key) const
+	{
+		return FindIndexByHash(KeyHash, Key) != INDEX_NONE;
+	}
+
+	/** The base type of set iterators, visiting the elements in slot order. */
+	template<bool bConst>
+	class TBaseIterator
+	{
+	public:
+		typedef typename TChooseClass<bConst, const TFlatSet, TFlatSet>::Result SetType;
+		typedef typename TChooseClass<bConst, const ElementType, ElementType>::Result ItElementType;
+
+		FORCEINLINE TBaseIterator(SetType& InSet, int32 StartIndex)
+			: Set(InSet)
+			, Index(InSet.FindNextFull(StartIndex))
+		{
+		}
+
+		/** Advances the iterator to the next element. */
+		FORCEINLINE TBaseIterator& operator++()
+		{
+			Index = Set.FindNextFull(Index + 1);
+			return *this;
+		}
+
+		/** conversion to "bool" returning true if the iterator is valid. */
+		FORCEINLINE explicit operator bool() const
+		{
+			return Index < Set.GetNumSlots();
+		}
+		/** inverse of the "bool" operator */
+		FORCEINLINE bool operator !() const
+		{
+			return !(bool)*this;
+		}
+
+		// Accessors.
+		FORCEINLINE ItElementType& operator*() const
+		{
+			return *Set.GetSlot(Index);
+		}
+		FORCEINLINE ItElementType* operator->() const
+		{
+			return Set.GetSlot(Index);
+		}
+
+		FORCEINLINE friend bool operator==(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return &Lhs.Set == &Rhs.Set && Lhs.Index == Rhs.Index; }
+		FORCEINLINE friend bool operator!=(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return &Lhs.Set != &Rhs.Set || Lhs.Index != Rhs.Index; }
+
+	protected:
+		SetType& Set;
+		int32 Index;
+	};
+
+	/** Used to iterate over the elements of a const TFlatSet. */
+	class TConstIterator : public TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE TConstIterator(const TFlatSet& InSet, int32 StartIndex = 0)
+			: TBaseIterator<true>(InSet, StartIndex)
+		{
+		}
+	};
+
+	/** Used to iterate over the elements of a TFlatSet. */
+	class TIterator : public TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE TIterator(TFlatSet& InSet, int32 StartIndex = 0)
+			: TBaseIterator<false>(InSet, StartIndex)
+		{
+		}
+
+		/** Removes the current element from the set, the iterator can still be advanced afterwards. */
+		FORCEINLINE void RemoveCurrent()
+		{
+			this->Set.RemoveAt(this->Index);
+		}
+	};
+
+	/** Creates an iterator for the contents of this set */
+	FORCEINLINE TIterator CreateIterator()
+	{
+		return TIterator(*this);
+	}
+
+	/** Creates a const iterator for the contents of this set */
+	FORCEINLINE TConstIterator CreateConstIterator() const
+	{
+		return TConstIterator(*this);
+	}
+
+public:
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE TIterator      begin()       { return TIterator(*this); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(*this); }
+	FORCEINLINE TIterator      end()         { return TIterator(*this, GetNumSlots()); }
+	FORCEINLINE TConstIterator end() const   { return TConstIterator(*this, GetNumSlots()); }
+
+private:
+	FORCEINLINE int32 GetNumSlots() const
+	{
+		return int32(NumGroups) * UE4FlatSet_Private::GroupSize;
+	}
+
+	FORCEINLINE ElementType* GetSlot(int32 Index) const
+	{
+		return Elements.GetAllocation() + Index;
+	}
+
+	/** @return The number of groups needed to hold NumToHold elements without exceeding the maximum load */
+	static uint32 GetNumGroupsForElements(int32 NumToHold)
+	{
+		const uint32 NumSlots = uint32((uint64(NumToHold) * 8 + 6) / 7);
+		return FMath::RoundUpToPowerOfTwo(FMath::Max(1u, (NumSlots + UE4FlatSet_Private::GroupSize - 1) / UE4FlatSet_Private::GroupSize));
+	}
+
+	/** At most 7/8 of the slots are used, so lookups quickly find a group with an empty slot to stop at */
+	FORCEINLINE int32 GetMaxLoad() const
+	{
+		return GetNumSlots() - GetNumSlots() / 8;
+	}
+
+	/** @return The index of the first full slot starting at StartIndex, or the number of slots if there is none */
+	int32 FindNextFull(int32 StartIndex) const
+	{
+		using namespace UE4FlatSet_Private;
+
+		const int32 NumSlots = GetNumSlots();
+		if (StartIndex >= NumSlots)
+		{
+			return NumSlots;
+		}
+
+		const uint8* ControlData = Control.GetAllocation();
+		int32 GroupStart = StartIndex & ~(GroupSize - 1);
+		FGroupMask Full = FGroup(ControlData + GroupStart).MatchFull();
+		Full.Bits &= ~0u << (StartIndex - GroupStart);
+		while (!Full)
+		{
+			GroupStart += GroupSize;
+			if (GroupStart >= NumSlots)
+			{
+				return NumSlots;
+			}
+			Full = FGroup(ControlData + GroupStart).MatchFull();
+		}
+		return GroupStart + Full.GetLowestIndex();
+	}
+
+	template<typename ComparableKey>
+	int32 FindIndexByHash(uint32 KeyHash, const ComparableKey& Key) const
+	{
+		using namespace UE4FlatSet_Private;
+
+		if (NumElements == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const uint64 MixedHash = MixHash(KeyHash);
+		const uint8 ControlHash = GetControlHash(MixedHash);
+		const uint8* ControlData = Control.GetAllocation();
+		const uint32 GroupMask = NumGroups - 1;
+		uint32 GroupIndex = GetGroupHash(MixedHash) & GroupMask;
+
+		// Triangular probing visits every group once as the number of groups is a power of two
+		for (uint32 Step = 1; Step <= NumGroups; ++Step)
+		{
+			const int32 GroupStart = int32(GroupIndex) * GroupSize;
+			const FGroup Group(ControlData + GroupStart);
+			for (FGroupMask Match = Group.Match(ControlHash); Match; Match.ClearLowest())
+			{
+				const int32 Index = GroupStart + Match.GetLowestIndex();
+				if (KeyFuncs::Matches(KeyFuncs::GetSetKey(*GetSlot(Index)), Key))
+				{
+					return Index;
+				}
+			}
+
+			if (Group.MatchEmpty())
+			{
+				break;
+			}
+			GroupIndex = (GroupIndex + Step) & GroupMask;
+		}
+		return INDEX_NONE;
+	}
+
+	/** @return The first empty or deleted slot along the probe sequence of the hash, there always is one below the maximum load */
+	int32 FindInsertIndex(uint64 MixedHash) const
+	{
+		using namespace UE4FlatSet_Private;
+
+		const uint8* ControlData = Control.GetAllocation();
+		const uint32 GroupMask = NumGroups - 1;
+		uint32 GroupIndex = GetGroupHash(MixedHash) & GroupMask;
+		for (uint32 Step = 1; ; ++Step)
+		{
+			const int32 GroupStart = int32(GroupIndex) * GroupSize;
+			const FGroupMask Free = FGroup(ControlData + GroupStart).MatchEmptyOrDeleted();
+			if (Free)
+			{
+				return GroupStart + Free.GetLowestIndex();
+			}
+			checkSlow(Step < NumGroups);
+			GroupIndex = (GroupIndex + Step) & GroupMask;
+		}
+	}
+
+	/** Adds an element constructed by the caller, relocating it into the set */
+	ElementType& AddConstructed(ElementType& NewElement, uint32 KeyHash, bool* bIsAlreadyInSetPtr)
+	{
+		const int32 ExistingIndex = FindIndexByHash(KeyHash, KeyFuncs::GetSetKey(NewElement));
+		if (bIsAlreadyInSetPtr)
+		{
+			*bIsAlreadyInSetPtr = ExistingIndex != INDEX_NONE;
+		}
+
+		if (ExistingIndex != INDEX_NONE)
+		{
+			// If there's an existing element with the same key as the new element, replace the existing element with the new element.
+			ElementType& Existing = *GetSlot(ExistingIndex);
+			MoveByRelocate(Existing, NewElement);
+			return Existing;
+		}
+
+		ElementType* Slot = AllocateSlot(KeyHash);
+		RelocateConstructItems<ElementType>(Slot, &NewElement, 1);
+		return *Slot;
+	}
+
+	/** Claims a slot for a new element with the given hash, growing the set if needed. The slot is left unconstructed. */
+	ElementType* AllocateSlot(uint32 KeyHash)
+	{
+		if (NumElements + NumDeleted >= GetMaxLoad())
+		{
+			// Rehashing at the same size is enough when most of the used slots are deleted ones
+			const bool bCanReclaimDeleted = NumGroups > 0 && NumElements < GetMaxLoad() / 2;
+			Rehash(NumGroups == 0 ? 1 : bCanReclaimDeleted ? NumGroups : NumGroups * 2);
+		}
+
+		const uint64 MixedHash = UE4FlatSet_Private::MixHash(KeyHash);
+		const int32 Index = FindInsertIndex(MixedHash);
+		uint8& SlotControl = Control.GetAllocation()[Index];
+		if (SlotControl == UE4FlatSet_Private::DeletedControl)
+		{
+			--NumDeleted;
+		}
+		SlotControl = UE4FlatSet_Private::GetControlHash(MixedHash);
+		++NumElements;
+		return GetSlot(Index);
+	}
+
+	void RemoveAt(int32 Index)
+	{
+		using namespace UE4FlatSet_Private;
+
+		DestructItem(GetSlot(Index));
+		--NumElements;
+
+		// Lookups stop at groups with an empty slot, so none went past this group if it already has one and the
+		// slot can be made empty again. Otherwise it's marked deleted to keep the probe sequences going through it.
+		uint8* ControlData = Control.GetAllocation();
+		const int32 GroupStart = Index & ~(GroupSize - 1);
+		if (FGroup(ControlData + GroupStart).MatchEmpty())
+		{
+			ControlData[Index] = EmptyControl;
+		}
+		else
+		{
+			ControlData[Index] = DeletedControl;
+			++NumDeleted;
+		}
+	}
+
+	/** Moves the elements to allocations of NewNumGroups groups, dropping the deleted slots */
+	void Rehash(uint32 NewNumGroups)
+	{
+		using namespace UE4FlatSet_Private;
+
+		checkSlow(FMath::IsPowerOfTwo(NewNumGroups) && int32(NewNumGroups) * GroupSize - int32(NewNumGroups) * GroupSize / 8 >= NumElements);
+
+		typename Allocator::template ForElementType<ElementType> NewElements;
+		typename Allocator::template ForElementType<uint8> NewControl;
+		const int32 NewNumSlots = int32(NewNumGroups) * GroupSize;
+		NewElements.ResizeAllocation(0, NewNumSlots, sizeof(ElementType));
+		NewControl.ResizeAllocation(0, NewNumSlots, sizeof(uint8));
+		FMemory::Memset(NewControl.GetAllocation(), EmptyControl, NewNumSlots);
+
+		const int32 OldNumSlots = GetNumSlots();
+		const int32 OldNumElements = NumElements;
+		if (OldNumElements > 0)
+		{
+			ElementType* OldElementData = Elements.GetAllocation();
+			for (int32 OldIndex = FindNextFull(0); OldIndex < OldNumSlots; OldIndex = FindNextFull(OldIndex + 1))
+			{
+				ElementType& Element = OldElementData[OldIndex];
+				const uint64 MixedHash = MixHash(KeyFuncs::GetKeyHash(KeyFuncs::GetSetKey(Element)));
+
+				// The probe sequence is the same as in FindInsertIndex, on the new allocations
+				uint32 GroupIndex = GetGroupHash(MixedHash) & (NewNumGroups - 1);
+				for (uint32 Step = 1; ; ++Step)
+				{
+					const int32 GroupStart = int32(GroupIndex) * GroupSize;
+					const FGroupMask Free = FGroup(NewControl.GetAllocation() + GroupStart).MatchEmpty();
+					if (Free)
+					{
+						const int32 NewIndex = GroupStart + Free.GetLowestIndex();
+						NewControl.GetAllocation()[NewIndex] = GetControlHash(MixedHash);
+						RelocateConstructItems<ElementType>(NewElements.GetAllocation() + NewIndex, &Element, 1);
+						break;
+					}
+					GroupIndex = (GroupIndex + Step) & (NewNumGroups - 1);
+				}
+			}
+		}
+
+		// The old elements were all relocated so the old allocations only need freeing
+		Elements.MoveToEmpty(NewElements);
+		Control.MoveToEmpty(NewControl);
+		NumGroups = NewNumGroups;
+		NumElements = OldNumElements;
+		NumDeleted = 0;
+	}
+
+	/** Frees or reallocates the allocations for NewNumGroups groups, the elements must have been destructed */
+	void ResizeAllocations(uint32 NewNumGroups)
+	{
+		const int32 NewNumSlots = int32(NewNumGroups) * UE4FlatSet_Private::GroupSize;
+		Elements.ResizeAllocation(0, NewNumSlots, sizeof(ElementType));
+		Control.ResizeAllocation(0, NewNumSlots, sizeof(uint8));
+		NumGroups = NewNumGroups;
+		ResetControl();
+	}
+
+	FORCEINLINE void ResetControl()
+	{
+		if (NumGroups > 0)
+		{
+			FMemory::Memset(Control.GetAllocation(), UE4FlatSet_Private::EmptyControl, GetNumSlots());
+		}
+	}
+
+	void DestructElements()
+	{
+		if (!TIsTriviallyDestructible<ElementType>::Value && NumElements > 0)
+		{
+			const int32 NumSlots = GetNumSlots();
+			for (int32 Index = FindNextFull(0); Index < NumSlots; Index = FindNextFull(Index + 1))
+			{
+				DestructItem(GetSlot(Index));
+			}
+		}
+		NumElements = 0;
+	}
+
+	void MoveFrom(TFlatSet& Other)
+	{
+		checkSlow(NumElements == 0);
+		Elements.MoveToEmpty(Other.Elements);
+		Control.MoveToEmpty(Other.Control);
+		NumElements = Other.NumElements;
+		NumDeleted = Other.NumDeleted;
+		NumGroups = Other.NumGroups;
+		Other.NumElements = 0;
+		Other.NumDeleted = 0;
+		Other.NumGroups = 0;
+	}
+
+	typename Allocator::template ForElementType<ElementType> Elements;
+	typename Allocator::template ForElementType<uint8> Control;
+	int32 NumElements;
+	int32 NumDeleted;
+	uint32 NumGroups;
+};
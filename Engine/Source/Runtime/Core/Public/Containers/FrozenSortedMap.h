@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Containers/Array.h"
+#include "Containers/SortedMap.h"
+#include "Algo/EytzingerSearch.h"
+#include "Algo/StableSort.h"
+
+/**
+ * A read-only map of keys to values for large tables that are built once and searched often.
+ *
+ * The pairs are sorted like in TSortedMap and then rearranged into the Eytzinger layout, see Algo::EytzingerLayout().
+ * Finding is O(Log n) like in TSortedMap, but reads the pairs in memory order and prefetches the next levels of the
+ * search, so it is several times faster once the pairs don't fit in the cache. Pairs can't be added or removed, and
+ * iterating visits them in the layout order, not in key order.
+ */
+template <typename KeyType, typename ValueType, typename ArrayAllocator = FDefaultAllocator, typename SortPredicate = TLess<typename TTypeTraits<KeyType>::ConstPointerType> >
+class TFrozenSortedMap
+{
+public:
+	typedef typename TTypeTraits<KeyType  >::ConstPointerType KeyConstPointerType;
+	typedef TPair<KeyType, ValueType> ElementType;
+
+	TFrozenSortedMap() = default;
+	TFrozenSortedMap(TFrozenSortedMap&&) = default;
+	TFrozenSortedMap(const TFrozenSortedMap&) = default;
+	TFrozenSortedMap& operator=(TFrozenSortedMap&&) = default;
+	TFrozenSortedMap& operator=(const TFrozenSortedMap&) = default;
+
+	/** Constructor taking the pairs of a TSortedMap, which are already sorted. The sorted map is left empty. */
+	template <typename OtherArrayAllocator>
+	explicit TFrozenSortedMap(TSortedMap<KeyType, ValueType, OtherArrayAllocator, SortPredicate>&& SortedMap)
+	{
+		Pairs.Reserve(SortedMap.Num());
+		for (ElementType& Pair : SortedMap)
+		{
+			Pairs.Add(MoveTemp(Pair));
+		}
+		SortedMap.Reset();
+		Algo::EytzingerLayout(Pairs);
+	}
+
+	/** Constructor taking pairs in any order. Of the pairs with the same key, the last one is kept, as if they were added to a map in order. */
+	explicit TFrozenSortedMap(TArray<ElementType, ArrayAllocator>&& InPairs)
+		: Pairs(MoveTemp(InPairs))
+	{
+		Algo::StableSortBy(Pairs, FKeyForward(), SortPredicate());
+
+		int32 NumUnique = 0;
+		for (int32 Index = 0; Index < Pairs.Num(); ++Index)
+		{
+			const bool bLastWithKey = Index + 1 == Pairs.Num() || SortPredicate()(Pairs[Index].Key, Pairs[Index + 1].Key);
+			if (bLastWithKey)
+			{
+				if (NumUnique != Index)
+				{
+					Pairs[NumUnique] = MoveTemp(Pairs[Index]);
+				}
+				++NumUnique;
+			}
+		}
+		Pairs.RemoveAt(NumUnique, Pairs.Num() - NumUnique);
+		Algo::EytzingerLayout(Pairs);
+	}
+
+	/** @return The number of elements in the map. */
+	FORCEINLINE int32 Num() const
+	{
+		return Pairs.Num();
+	}
+
+	/**
+	 * Helper function to return the amount of memory allocated by this container.
+	 * Only returns the size of allocations made directly by the container, not the elements themselves.
+	 *
+	 * @return number of bytes allocated by this container.
+	 */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return Pairs.GetAllocatedSize();
+	}
+
+	/**
+	 * Returns the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return A pointer to the value associated with the specified key, or nullptr if the key isn't contained in this map.
+	 */
+	FORCEINLINE ValueType* Find(KeyConstPointerType Key)
+	{
+		int32 FoundIndex = Algo::EytzingerBinarySearchBy(Pairs, Key, FKeyForward(), SortPredicate());
+
+		if (FoundIndex != INDEX_NONE)
+		{
+			return &Pairs[FoundIndex].Value;
+		}
+
+		return nullptr;
+	}
+
+	FORCEINLINE const ValueType* Find(KeyConstPointerType Key) const
+	{
+		return const_cast<TFrozenSortedMap*>(this)->Find(Key);
+	}
+
+	/**
+	 * Returns a reference to the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or triggers an assertion if the key does not exist.
+	 */
+	FORCEINLINE ValueType& FindChecked(KeyConstPointerType Key)
+	{
+		ValueType* Value = Find(Key);
+		check(Value != nullptr);
+		return *Value;
+	}
+
+	FORCEINLINE const ValueType& FindChecked(KeyConstPointerType Key) const
+	{
+		const ValueType* Value = Find(Key);
+		check(Value != nullptr);
+		return *Value;
+	}
+
+	/**
+	 * Returns the value associated with a specified key.
+	 *
+	 * @param Key The key to search for.
+	 * @return The value associated with the specified key, or the default value for the ValueType if the key isn't contained in this map.
+	 */
+	FORCEINLINE ValueType FindRef(KeyConstPointerType Key) const
+	{
+		if (const ValueType* Value = Find(Key))
+		{
+			return *Value;
+		}
+
+		return ValueType();
+	}
+
+	/**
+	 * Checks if map contains the specified key.
+	 *
+	 * @param Key The key to check for.
+	 * @return true if the map contains the key.
+	 */
+	FORCEINLINE bool Contains(KeyConstPointerType Key) const
+	{
+		return Find(Key) != nullptr;
+	}
+
+	FORCEINLINE       ValueType& operator[](KeyConstPointerType Key)       { return this->FindChecked(Key); }
+	FORCEINLINE const ValueType& operator[](KeyConstPointerType Key) const { return this->FindChecked(Key); }
+
+private:
+	typedef TArray<ElementType, ArrayAllocator> ElementArrayType;
+
+	/** Forwards sorting into Key of pair */
+	struct FKeyForward
+	{
+		FORCEINLINE const KeyType& operator()(const ElementType& Pair) const
+		{
+			return Pair.Key;
+		}
+	};
+
+	/** The key-value pairs in the Eytzinger layout of their key order */
+	ElementArrayType Pairs;
+
+public:
+	/** Ranged For iterators, visiting the pairs in the layout order. Keys must not be changed. */
+	typedef typename ElementArrayType::RangedForIteratorType RangedForIteratorType;
+	typedef typename ElementArrayType::RangedForConstIteratorType RangedForConstIteratorType;
+
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE RangedForIteratorType		begin()	      { return Pairs.begin(); }
+	FORCEINLINE RangedForConstIteratorType	begin() const { return Pairs.begin(); }
+	FORCEINLINE RangedForIteratorType		end()         { return Pairs.end(); }
+	FORCEINLINE RangedForConstIteratorType	end() const   { return Pairs.end(); }
+};
@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Misc/CString.h"
+#include "Misc/Crc.h"
+#include "Misc/StringBuilder.h"
+
+/**
+ * A string storing up to NumInlineChars characters, including the terminator, inside the object itself before
+ * falling back to a heap allocation.
+ *
+ * Unlike TStringBuilder this is a value type that can be copied, moved and stored in containers, so it suits
+ * temporary strings passing through hot code, such as paths from FPaths::CombineTo or names from FName::ToString,
+ * which would otherwise allocate even when short. It converts to FStringView, can be appended to string builders,
+ * and ToString makes an FString when one is needed. Comparisons and hashing ignore case to match FString.
+ */
+template <int32 NumInlineChars>
+class TInlineString
+{
+	static_assert(NumInlineChars > 0, "TInlineString needs room for the terminator");
+
+public:
+	using ElementType = TCHAR;
+	using DataType = TArray<TCHAR, TInlineAllocator<NumInlineChars>>;
+
+	TInlineString() = default;
+	TInlineString(TInlineString&&) = default;
+	TInlineString(const TInlineString&) = default;
+	TInlineString& operator=(TInlineString&&) = default;
+	TInlineString& operator=(const TInlineString&) = default;
+
+	TInlineString(const TCHAR* Str)
+	{
+		Append(FStringView(Str));
+	}
+
+	explicit TInlineString(const FStringView& Str)
+	{
+		Append(Str);
+	}
+
+	explicit TInlineString(const FString& Str)
+	{
+		Append(FStringView(Str));
+	}
+
+	TInlineString& operator=(const FStringView& Str)
+	{
+		if (IsInside(Str.GetData()))
+		{
+			return *this = TInlineString(Str);
+		}
+		Reset(Str.Len() + 1);
+		Append(Str);
+		return *this;
+	}
+
+	TInlineString& operator=(const TCHAR* Str)
+	{
+		return *this = FStringView(Str);
+	}
+
+	/** @return The string's length, not including the terminator. */
+	FORCEINLINE int32 Len() const
+	{
+		return Data.Num() ? Data.Num() - 1 : 0;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Data.Num() <= 1;
+	}
+
+	/** @return Whether the string fits the inline storage, in which case it doesn't hold an allocation. */
+	FORCEINLINE bool IsInline() const
+	{
+		return Data.Max() <= NumInlineChars;
+	}
+
+	/** @return The null terminated string, never null. */
+	FORCEINLINE const TCHAR* operator*() const
+	{
+		return Data.Num() ? Data.GetData() : TEXT("");
+	}
+
+	/** @return The characters including the terminator, an empty string has no characters. */
+	FORCEINLINE DataType& GetCharArray()
+	{
+		return Data;
+	}
+
+	FORCEINLINE const DataType& GetCharArray() const
+	{
+		return Data;
+	}
+
+	/** Removes the characters, keeping an allocation large enough for NewReservedSize characters. */
+	FORCEINLINE void Reset(int32 NewReservedSize = 0)
+	{
+		Data.Reset(NewReservedSize);
+	}
+
+	/** Removes the characters and frees any allocation. */
+	FORCEINLINE void Empty()
+	{
+		Data.Empty();
+	}
+
+	/** Makes room for CharacterCount characters, not including the terminator. */
+	FORCEINLINE void Reserve(int32 CharacterCount)
+	{
+		Data.Reserve(CharacterCount + 1);
+	}
+
+	TInlineString& Append(const TCHAR* Str, int32 Count)
+	{
+		checkSlow(Count >= 0);
+		if (Count && IsInside(Str))
+		{
+			// Appending part of the string to itself, the characters could move when growing
+			const TInlineString Copy(FStringView(Str, Count));
+			return Append(*Copy, Count);
+		}
+		if (Count)
+		{
+			const int32 OldLen = Len();
+			Data.SetNumUninitialized(OldLen + Count + 1, false);
+			FMemory::Memcpy(Data.GetData() + OldLen, Str, Count * sizeof(TCHAR));
+			Data[OldLen + Count] = TEXT('\0');
+		}
+		return *this;
+	}
+
+	FORCEINLINE TInlineString& Append(const FStringView& Str)
+	{
+		return Append(Str.GetData(), Str.Len());
+	}
+
+	FORCEINLINE TInlineString& operator+=(const FStringView& Str)
+	{
+		return Append(Str);
+	}
+
+	FORCEINLINE TInlineString& operator+=(const TCHAR* Str)
+	{
+		return Append(FStringView(Str));
+	}
+
+	FORCEINLINE TInlineString& operator+=(TCHAR Char)
+	{
+		return Append(&Char, 1);
+	}
+
+	/** Appends a path component with a separator, with the same rules as FString::PathAppend. */
+	TInlineString& PathAppend(const TCHAR* Str, int32 StrLength)
+	{
+		const int32 OldLen = Len();
+		const bool bEndsWithSeparator = OldLen == 0 || Data[OldLen - 1] == TEXT('/') || Data[OldLen - 1] == TEXT('\\');
+		if (StrLength == 0)
+		{
+			if (!bEndsWithSeparator)
+			{
+				Append(TEXT("/"), 1);
+			}
+		}
+		else
+		{
+			if (!bEndsWithSeparator && *Str != TEXT('/'))
+			{
+				Reserve(OldLen + 1 + StrLength);
+				Append(TEXT("/"), 1);
+			}
+			Append(Str, StrLength);
+		}
+		return *this;
+	}
+
+	FORCEINLINE TInlineString& operator/=(const FStringView& Str)
+	{
+		return PathAppend(Str.GetData(), Str.Len());
+	}
+
+	FORCEINLINE TInlineString& operator/=(const TCHAR* Str)
+	{
+		return *this /= FStringView(Str);
+	}
+
+	/** @return A copy of the string as an FString. */
+	FString ToString() const
+	{
+		return FString(Len(), **this);
+	}
+
+	FORCEINLINE bool Equals(const FStringView& Other, ESearchCase::Type SearchCase = ESearchCase::CaseSensitive) const
+	{
+		return FStringView(*this).Equals(Other, SearchCase);
+	}
+
+	FORCEINLINE friend bool operator==(const TInlineString& Lhs, const FStringView& Rhs)
+	{
+		return Lhs.Equals(Rhs, ESearchCase::IgnoreCase);
+	}
+
+	FORCEINLINE friend bool operator!=(const TInlineString& Lhs, const FStringView& Rhs)
+	{
+		return !Lhs.Equals(Rhs, ESearchCase::IgnoreCase);
+	}
+
+	FORCEINLINE friend bool operator==(const TInlineString& Lhs, const TCHAR* Rhs)
+	{
+		return Lhs.Equals(FStringView(Rhs), ESearchCase::IgnoreCase);
+	}
+
+	FORCEINLINE friend bool operator!=(const TInlineString& Lhs, const TCHAR* Rhs)
+	{
+		return !Lhs.Equals(FStringView(Rhs), ESearchCase::IgnoreCase);
+	}
+
+	FORCEINLINE friend bool operator==(const TInlineString& Lhs, const TInlineString& Rhs)
+	{
+		return Lhs.Equals(FStringView(Rhs), ESearchCase::IgnoreCase);
+	}
+
+	FORCEINLINE friend bool operator!=(const TInlineString& Lhs, const TInlineString& Rhs)
+	{
+		return !Lhs.Equals(FStringView(Rhs), ESearchCase::IgnoreCase);
+	}
+
+	/** This must match the GetTypeHash behavior of FString and FStringView */
+	FORCEINLINE friend uint32 GetTypeHash(const TInlineString& S)
+	{
+		return FCrc::Strihash_DEPRECATED(S.Len(), *S);
+	}
+
+	FORCEINLINE friend const TCHAR* GetData(const TInlineString& S)
+	{
+		return *S;
+	}
+
+	FORCEINLINE friend int32 GetNum(const TInlineString& S)
+	{
+		return S.Len();
+	}
+
+	FORCEINLINE friend FStringBuilderBase& operator<<(FStringBuilderBase& Builder, const TInlineString& S)
+	{
+		return Builder.Append(*S, S.Len());
+	}
+
+private:
+	FORCEINLINE bool IsInside(const TCHAR* Str) const
+	{
+		return Str >= Data.GetData() && Str < Data.GetData() + Data.Num();
+	}
+
+	DataType Data;
+};
+
+template <int32 NumInlineChars>
+struct TIsContiguousContainer<TInlineString<NumInlineChars>>
+{
+	enum { Value = true };
+};
+
+/** Holds most file names and short paths without allocating */
+using FInlineString = TInlineString<24>;
@@ -50,6 +50,12 @@ CORE_API void LockFreeFreeLinks(SIZE_T AllocSize, void* Ptr);
 #define MAX_LOCK_FREE_LINKS_AS_BITS (26)
 #define MAX_LOCK_FREE_LINKS (1 << 26)
 
+// Links point straight at each other with a 64 bit ABA tag next to the pointer where 128 bit compare and exchange is available,
+// which removes the indirection through the indexed allocator and its limit of MAX_LOCK_FREE_LINKS links.
+#ifndef LOCK_FREE_LINKS_USE_128BIT_ATOMICS
+	#define LOCK_FREE_LINKS_USE_128BIT_ATOMICS (PLATFORM_HAS_128BIT_ATOMICS && PLATFORM_64BITS)
+#endif
+
 template<int TPaddingForCacheContention>
 struct FPaddingForCacheContention
 {
@@ -136,6 +142,157 @@ private:
 };
 
 
+#if LOCK_FREE_LINKS_USE_128BIT_ATOMICS
+
+#define MAX_TagBitsValue MAX_uint64
+struct FPointerLockFreeLink;
+
+MS_ALIGN(16)
+struct FTaggedLinkPointer
+{
+	// no constructor, intentionally. We need to keep the ABA double counter in tact
+
+	// This should only be used for FTaggedLinkPointer's with no outstanding concurrency.
+	// Not recycled links, for example.
+	void Init()
+	{
+		Ptr = nullptr;
+		CounterAndState = 0;
+	}
+	FORCEINLINE void SetAll(FPointerLockFreeLink* InPtr, uint64 InCounterAndState)
+	{
+		Ptr = InPtr;
+		CounterAndState = InCounterAndState;
+	}
+
+	FORCEINLINE FPointerLockFreeLink* GetPtr() const
+	{
+		return Ptr;
+	}
+
+	FORCEINLINE void SetPtr(FPointerLockFreeLink* To)
+	{
+		Ptr = To;
+	}
+
+	FORCEINLINE uint64 GetCounterAndState() const
+	{
+		return CounterAndState;
+	}
+
+	FORCEINLINE void SetCounterAndState(uint64 To)
+	{
+		CounterAndState = To;
+	}
+
+	FORCEINLINE void AdvanceCounterAndState(const FTaggedLinkPointer &From, uint64 TABAInc)
+	{
+		SetCounterAndState(From.GetCounterAndState() + TABAInc);
+		if (UNLIKELY(GetCounterAndState() < From.GetCounterAndState()))
+		{
+			// this is not expected to be a problem and it is not expected to happen very often. When it does happen, we will sleep as an extra precaution.
+			LockFreeTagCounterHasOverflowed();
+		}
+	}
+
+	template<uint64 TABAInc>
+	FORCEINLINE uint64 GetState() const
+	{
+		return GetCounterAndState() & (TABAInc - 1);
+	}
+
+	template<uint64 TABAInc>
+	FORCEINLINE void SetState(uint64 Value)
+	{
+		checkLockFreePointerList(Value < TABAInc);
+		SetCounterAndState((GetCounterAndState() & ~(TABAInc - 1)) | Value);
+	}
+
+	FORCEINLINE void AtomicRead(const FTaggedLinkPointer& Other)
+	{
+		checkLockFreePointerList(IsAligned(this, 16) && IsAligned(&Other, 16));
+		FPlatformAtomics::AtomicRead128((const volatile FInt128*)&Other, (FInt128*)this);
+		TestCriticalStall();
+	}
+
+	FORCEINLINE bool InterlockedCompareExchange(const FTaggedLinkPointer& Exchange, const FTaggedLinkPointer& Comparand)
+	{
+		TestCriticalStall();
+		FTaggedLinkPointer LocalComparand = Comparand;
+		return FPlatformAtomics::InterlockedCompareExchange128((volatile FInt128*)this, *(const FInt128*)&Exchange, (FInt128*)&LocalComparand);
+	}
+
+	FORCEINLINE bool operator==(const FTaggedLinkPointer& Other) const
+	{
+		return Ptr == Other.Ptr && CounterAndState == Other.CounterAndState;
+	}
+	FORCEINLINE bool operator!=(const FTaggedLinkPointer& Other) const
+	{
+		return !(*this == Other);
+	}
+
+private:
+	// In the order of the low and high halves of FInt128
+	FPointerLockFreeLink* Ptr;
+	uint64 CounterAndState;
+
+} GCC_ALIGN(16);
+
+MS_ALIGN(16)
+struct FPointerLockFreeLink
+{
+	FTaggedLinkPointer DoubleNext;
+	void *Payload;
+	FPointerLockFreeLink* SingleNext;
+} GCC_ALIGN(16);
+
+/** Allocates blocks of links that are never freed, as a link may still be read by a thread that lost the race for it */
+class FLockFreeLinkBlockAllocator
+{
+public:
+	FORCEINLINE FPointerLockFreeLink* Alloc(uint32 Count = 1)
+	{
+		FPointerLockFreeLink* Links = (FPointerLockFreeLink*)LockFreeAllocLinks(Count * sizeof(FPointerLockFreeLink));
+		checkLockFreePointerList(IsAligned(Links, alignof(FPointerLockFreeLink)));
+		for (uint32 Index = 0; Index < Count; Index++)
+		{
+			new (Links + Index) FPointerLockFreeLink();
+		}
+		return Links;
+	}
+};
+
+struct FLockFreeLinkPolicy
+{
+	enum
+	{
+		MAX_BITS_IN_TLinkPtr = 64
+	};
+	typedef FTaggedLinkPointer TDoublePtr;
+	typedef FPointerLockFreeLink TLink;
+	typedef FPointerLockFreeLink* TLinkPtr;
+	typedef FLockFreeLinkBlockAllocator TAllocator;
+
+	static FORCEINLINE FPointerLockFreeLink* DerefLink(FPointerLockFreeLink* Ptr)
+	{
+		return Ptr;
+	}
+	static FORCEINLINE FPointerLockFreeLink* IndexToLink(FPointerLockFreeLink* Index)
+	{
+		return Index;
+	}
+	static FORCEINLINE FPointerLockFreeLink* IndexToPtr(FPointerLockFreeLink* Index)
+	{
+		return Index;
+	}
+
+	CORE_API static FPointerLockFreeLink* AllocLockFreeLink();
+	CORE_API static void FreeLockFreeLink(FPointerLockFreeLink* Item);
+	CORE_API static TAllocator LinkAllocator;
+};
+
+#else
+
 #define MAX_TagBitsValue (uint64(1) << (64 - MAX_LOCK_FREE_LINKS_AS_BITS))
 struct FIndexedLockFreeLink;
 
@@ -235,7 +392,7 @@ struct FIndexedLockFreeLink
 	uint32 SingleNext;
 };
 
-// there is a version of this code that uses 128 bit atomics to avoid the indirection, that is why we have this policy class at all.
+// the version of this code that uses 128 bit atomics to avoid the indirection is above, that is why we have this policy class at all.
 struct FLockFreeLinkPolicy
 {
 	enum
@@ -265,6 +422,8 @@ struct FLockFreeLinkPolicy
 	CORE_API static TAllocator LinkAllocator;
 };
 
+#endif // LOCK_FREE_LINKS_USE_128BIT_ATOMICS
+
 template<int TPaddingForCacheContention, uint64 TABAInc = 1>
 class FLockFreePointerListLIFORoot : public FNoncopyable
 {
@@ -725,7 +884,44 @@ public:
 		return ThreadToWake;
 	}
 
+	/**
+	*	Announces that work became available somewhere other than this queue, e.g. in a per thread work stealing deque.
+	*	Advances the state so that a thread which is about to stall will retry, and wakes a stalled thread if there is one.
+	*	@return Index of the thread to wake, or -1 if no thread is stalled.
+	*/
+	int32 Signal()
+	{
+		TDoublePtr LocalMasterState;
+		int32 ThreadToWake;
+		while (true)
+		{
+			LocalMasterState.AtomicRead(MasterState);
+			TDoublePtr NewMasterState;
+			NewMasterState.AdvanceCounterAndState(LocalMasterState, 1);
+			ThreadToWake = FindThreadToWake(LocalMasterState.GetPtr());
+			NewMasterState.SetPtr(ThreadToWake >= 0 ? TurnOffBit(LocalMasterState.GetPtr(), ThreadToWake) : LocalMasterState.GetPtr());
+			if (MasterState.InterlockedCompareExchange(NewMasterState, LocalMasterState))
+			{
+				break;
+			}
+		}
+		return ThreadToWake;
+	}
+
 	T* Pop(int32 MyThread, bool bAllowStall)
+	{
+		return PopOrSteal(MyThread, bAllowStall, []() -> T* { return nullptr; });
+	}
+
+	/**
+	*	Pops from the priority queues and, if they are empty, gives the caller a chance to find work elsewhere before stalling.
+	*	Anything that makes work visible to Steal must call Signal afterwards, that way a thread can't stall while work is pending.
+	*	@param MyThread, index of the calling thread
+	*	@param bAllowStall, if true the calling thread is marked as stalled when no work was found
+	*	@param Steal, callable returning a T* found somewhere else, or nullptr
+	*/
+	template<typename StealType>
+	T* PopOrSteal(int32 MyThread, bool bAllowStall, StealType&& Steal)
 	{
 		check(MyThread >= 0 && MyThread < FLockFreeLinkPolicy::MAX_BITS_IN_TLinkPtr);
 
@@ -753,6 +949,10 @@ public:
 					}
 				}
 			}
+			if (T* Stolen = Steal())
+			{
+				return Stolen;
+			}
 			if (!bAllowStall)
 			{
 				break; // if we aren't stalling, we are done, the queues are empty
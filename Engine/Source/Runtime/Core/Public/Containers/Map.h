@@ -20,6 +20,13 @@
 template <typename KeyType, typename ValueType>
 using TPair = TTuple<KeyType, ValueType>;
 
+/** Pairs are bulk serializable when both of their members are and there is no padding between them. */
+template <typename KeyType, typename ValueType>
+struct TCanBulkSerialize<TTuple<KeyType, ValueType>>
+{
+	enum { Value = TCanBulkSerialize<KeyType>::Value && TCanBulkSerialize<ValueType>::Value && sizeof(TTuple<KeyType, ValueType>) == sizeof(KeyType) + sizeof(ValueType) };
+};
+
 /** An initializer type for pairs that's passed to the pair set when adding a new pair. */
 template <typename KeyInitType, typename ValueInitType>
 class TPairInitializer
@@ -124,6 +131,7 @@ struct TDefaultMapHashableKeyFuncs : TDefaultMapKeyFuncs<KeyType, ValueType, bIn
  *	  You must ensure the hash is calculated in the same way as ElementType is hashed.
  *    If possible put both ComparableKey and ElementType hash functions next to each other in the same header
  *    to avoid bugs when the ElementType hash function is changed.
+ *    FindByKey() and ContainsByKey() do the hashing for keys that TKeyLookup knows how to look up.
  * -- Reducing contention around hash tables protected by a lock. It is often important to incur
  *    the cache misses of reading key data and doing the hashing *before* acquiring the lock.
  **/
@@ -481,6 +489,23 @@ public:
 		return const_cast<TMapBase*>(this)->FindByHash(KeyHash, Key);
 	}
 
+	/** See Find() and TSet::FindByKey() */
+	template<typename ComparableKey>
+	FORCEINLINE ValueType* FindByKey(const ComparableKey& Key)
+	{
+		if (auto* Pair = Pairs.FindByKey(Key))
+		{
+			return &Pair->Value;
+		}
+
+		return nullptr;
+	}
+	template<typename ComparableKey>
+	FORCEINLINE const ValueType* FindByKey(const ComparableKey& Key) const
+	{
+		return const_cast<TMapBase*>(this)->FindByKey(Key);
+	}
+
 private:
 	FORCEINLINE static uint32 HashKey(const KeyType& Key)
 	{
@@ -619,6 +644,13 @@ public:
 		return Pairs.ContainsByHash(KeyHash, Key);
 	}
 
+	/** See Contains() and TSet::FindByKey() */
+	template<typename ComparableKey>
+	FORCEINLINE bool ContainsByKey(const ComparableKey& Key) const
+	{
+		return Pairs.ContainsByKey(Key);
+	}
+
 	/**
 	 * Generate an array from the keys in this map.
 	 *
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/UnrealMemory.h"
+#include <type_traits>
+
+/**
+ * Template for sequence locks.
+ *
+ * A sequence lock holds a small trivially copyable value that many threads read and few threads write, such as a
+ * transform, a set of tuning values or the bounds of a region. Readers never write to shared memory: they read the
+ * sequence number, copy the value and read the sequence number again, and copy again if a writer got in between.
+ * Writers take turns by making the sequence number odd while they write.
+ *
+ * Reads are wait free while nothing is written and never block writers, so a value that is written constantly can
+ * starve readers. For larger values or ones that hold pointers, see TSharedSnapshot.
+ *
+ * @param ValueType The type of the value, trivially copyable.
+ */
+template<typename ValueType>
+class TSeqLock
+{
+	static_assert(std::is_trivially_copyable<ValueType>::value, "TSeqLock values are copied while they may be written, they must be trivially copyable");
+
+	enum
+	{
+		NumWords = (sizeof(ValueType) + sizeof(int32) - 1) / sizeof(int32)
+	};
+
+public:
+
+	/** Default constructor, zero initializes the value. */
+	TSeqLock()
+		: Sequence(0)
+	{
+		FMemory::Memzero((void*)Words, sizeof(Words));
+	}
+
+	/** Creates and initializes a new instance with the given value. */
+	explicit TSeqLock(const ValueType& InValue)
+		: Sequence(0)
+	{
+		FMemory::Memzero((void*)Words, sizeof(Words));
+		FMemory::Memcpy((void*)Words, &InValue, sizeof(ValueType));
+	}
+
+	TSeqLock(const TSeqLock&) = delete;
+	TSeqLock& operator=(const TSeqLock&) = delete;
+
+public:
+
+	/**
+	 * Reads a copy of the value, from any thread.
+	 *
+	 * @return The value as of the last completed Write.
+	 */
+	ValueType Read() const
+	{
+		int32 LocalWords[NumWords];
+		for (int32 SpinCount = 0; ; ++SpinCount)
+		{
+			const int32 StartSequence = FPlatformAtomics::AtomicRead(&Sequence);
+			if (StartSequence & 1)
+			{
+				// A writer is copying the value in, it only takes a few stores
+				Backoff(SpinCount);
+				continue;
+			}
+
+			for (int32 Index = 0; Index < NumWords; ++Index)
+			{
+				LocalWords[Index] = FPlatformAtomics::AtomicRead_Relaxed(&Words[Index]);
+			}
+
+			// The copy must be complete before the sequence number is checked again
+			FPlatformMisc::MemoryBarrier();
+			if (FPlatformAtomics::AtomicRead_Relaxed(&Sequence) == StartSequence)
+			{
+				break;
+			}
+		}
+
+		ValueType Result;
+		FMemory::Memcpy(&Result, LocalWords, sizeof(ValueType));
+		return Result;
+	}
+
+	/**
+	 * Replaces the value, from any thread. Concurrent writers take turns.
+	 *
+	 * @param InValue The new value.
+	 */
+	void Write(const ValueType& InValue)
+	{
+		int32 LocalWords[NumWords];
+		LocalWords[NumWords - 1] = 0;
+		FMemory::Memcpy(LocalWords, &InValue, sizeof(ValueType));
+
+		int32 StartSequence;
+		for (int32 SpinCount = 0; ; ++SpinCount)
+		{
+			StartSequence = FPlatformAtomics::AtomicRead_Relaxed(&Sequence);
+			if (!(StartSequence & 1) && FPlatformAtomics::InterlockedCompareExchange(&Sequence, StartSequence + 1, StartSequence) == StartSequence)
+			{
+				break;
+			}
+			Backoff(SpinCount);
+		}
+
+		for (int32 Index = 0; Index < NumWords; ++Index)
+		{
+			FPlatformAtomics::AtomicStore_Relaxed(&Words[Index], LocalWords[Index]);
+		}
+
+		// Publishes the words written above along with the even sequence number
+		FPlatformAtomics::AtomicStore(&Sequence, StartSequence + 2);
+	}
+
+private:
+
+	static FORCEINLINE void Backoff(int32 SpinCount)
+	{
+		// Writers are only preempted rarely while they hold the sequence odd, give them the core once spinning didn't help
+		if (SpinCount >= 64)
+		{
+			FPlatformProcess::SleepNoStats(0.0f);
+		}
+	}
+
+	/** Odd while a writer is copying the value in */
+	volatile int32 Sequence;
+
+	/** The value, copied in and out a word at a time so that racing reads are only retried and not torn inside a word */
+	alignas(alignof(ValueType) > alignof(int32) ? alignof(ValueType) : alignof(int32)) volatile int32 Words[NumWords];
+};
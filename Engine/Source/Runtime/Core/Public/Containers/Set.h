@@ -17,6 +17,7 @@
 #include "Containers/SparseArray.h"
 #include "Templates/AreTypesEqual.h"
 #include "Templates/Decay.h"
+#include "Templates/TypeCompatibleBytes.h"
 #include "Serialization/StructuredArchive.h"
 #include "Serialization/MemoryImageWriter.h"
 #include "ContainersFwd.h"
@@ -270,6 +271,7 @@ public:
  *	  You must ensure the hash is calculated in the same way as ElementType is hashed.
  *    If possible put both ComparableKey and ElementType hash functions next to each other in the same header
  *    to avoid bugs when the ElementType hash function is changed.
+ *    FindByKey() and ContainsByKey() do the hashing for keys that TKeyLookup knows how to look up.
  * -- Reducing contention around hash tables protected by a lock. It is often important to incur
  *    the cache misses of reading key data and doing the hashing *before* acquiring the lock.
  *
@@ -866,6 +868,26 @@ public:
 		return const_cast<TSet*>(this)->FindByHash(KeyHash, Key);
 	}
 
+	/**
+	 * Finds an element by a key of another type without creating a KeyType, e.g. an FString by FStringView or an FName
+	 * by FStringView without adding the name. The hash is calculated from the key, see TKeyLookup.
+	 * @return A pointer to the contained element or nullptr.
+	 */
+	template<typename ComparableKey>
+	ElementType* FindByKey(const ComparableKey& Key)
+	{
+		return TKeyLookup<typename KeyFuncs::KeyType, typename TDecay<ComparableKey>::Type>::Lookup(Key, [this](const auto& LookupKey)
+		{
+			return FindByHash(KeyFuncs::GetKeyHash(LookupKey), LookupKey);
+		});
+	}
+
+	template<typename ComparableKey>
+	const ElementType* FindByKey(const ComparableKey& Key) const
+	{
+		return const_cast<TSet*>(this)->FindByKey(Key);
+	}
+
 private:
 	template<typename ComparableKey>
 	FORCEINLINE int32 RemoveImpl(uint32 KeyHash, const ComparableKey& Key)
@@ -955,6 +977,16 @@ public:
 		return FindIdByHash(KeyHash, Key).IsValidId();
 	}
 
+	/**
+	 * Checks if the set contains an element with a key of another type, without creating a KeyType.
+	 * @see FindByKey()
+	 */
+	template<typename ComparableKey>
+	FORCEINLINE bool ContainsByKey(const ComparableKey& Key) const
+	{
+		return FindByKey(Key) != nullptr;
+	}
+
 	/**
 	 * Sorts the set's elements using the provided comparison class.
 	 */
@@ -985,7 +1017,10 @@ public:
 	friend FArchive& operator<<(FArchive& Ar,TSet& Set)
 	{
 		// Load the set's new elements.
-		Ar << Set.Elements;
+		if (!Set.TryBulkSerializeElements(Ar))
+		{
+			Ar << Set.Elements;
+		}
 
 		if(Ar.IsLoading())
 		{
@@ -1000,6 +1035,68 @@ public:
 		return Ar;
 	}
 
+private:
+	/**
+	 * Serializes the elements in the same format as the sparse array serializer, but gathers their values into chunks
+	 * which are serialized in one call each rather than one call per element. Returns false if the elements need to be
+	 * serialized one at a time.
+	 */
+	template <typename SerializedType = InElementType>
+	typename TEnableIf<TCanBulkSerialize<SerializedType>::Value, bool>::Type TryBulkSerializeElements(FArchive& Ar)
+	{
+		if ((sizeof(InElementType) > 1 && Ar.IsByteSwapping()) || !(Ar.IsLoading() || Ar.IsSaving()))
+		{
+			return false;
+		}
+
+		constexpr int32 ChunkNum = FMath::Max<int32>(1, 4096 / sizeof(InElementType));
+		TTypeCompatibleBytes<InElementType> Chunk[ChunkNum];
+
+		Elements.CountBytes(Ar);
+		if (Ar.IsLoading())
+		{
+			int32 NewNumElements = 0;
+			Ar << NewNumElements;
+			Elements.Empty(NewNumElements);
+			for (int32 ElementIndex = 0; ElementIndex < NewNumElements && !Ar.IsError(); ElementIndex += ChunkNum)
+			{
+				const int32 NumInChunk = FMath::Min(NewNumElements - ElementIndex, ChunkNum);
+				Ar.Serialize(Chunk, NumInChunk * sizeof(InElementType));
+				for (int32 Index = 0; Index < NumInChunk; ++Index)
+				{
+					::new(Elements.AddUninitialized()) SetElementType(*Chunk[Index].GetTypedPtr());
+				}
+			}
+		}
+		else
+		{
+			int32 NewNumElements = Elements.Num();
+			Ar << NewNumElements;
+			int32 NumInChunk = 0;
+			for (const SetElementType& Element : Elements)
+			{
+				FMemory::Memcpy(Chunk + NumInChunk, &Element.Value, sizeof(InElementType));
+				if (++NumInChunk == ChunkNum)
+				{
+					Ar.Serialize(Chunk, NumInChunk * sizeof(InElementType));
+					NumInChunk = 0;
+				}
+			}
+			if (NumInChunk)
+			{
+				Ar.Serialize(Chunk, NumInChunk * sizeof(InElementType));
+			}
+		}
+		return true;
+	}
+
+	template <typename SerializedType = InElementType>
+	FORCEINLINE typename TEnableIf<!TCanBulkSerialize<SerializedType>::Value, bool>::Type TryBulkSerializeElements(FArchive& Ar)
+	{
+		return false;
+	}
+
+public:
 	/** Structured archive serializer. */
  	friend void operator<<(FStructuredArchive::FSlot Slot, TSet& Set)
  	{
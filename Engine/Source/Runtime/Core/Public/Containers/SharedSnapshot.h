@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformAtomics.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UnrealTemplate.h"
+
+/**
+ * Epochs that decide when values replaced in a TSharedSnapshot can be deleted.
+ *
+ * Each reading thread owns a slot that holds the epoch it started reading in, so that entering and leaving a read
+ * only stores to memory no other thread writes. Replaced values are retired with the epoch they were replaced in and
+ * deleted once no slot holds that epoch or an older one.
+ */
+class CORE_API FSharedSnapshotEpochs
+{
+public:
+	/** Marks the calling thread as reading until the matching ExitRead. Reads can nest. */
+	static void EnterRead();
+
+	/** Ends the read started by the matching EnterRead. */
+	static void ExitRead();
+
+	/**
+	 * Deletes an object once every read that may still be using it has ended.
+	 *
+	 * @param Object The object, already unreachable for new reads.
+	 * @param Deleter Function that deletes the object, called from any thread.
+	 */
+	static void Retire(void* Object, void (*Deleter)(void*));
+
+	/** Deletes the retired objects that no read can be using anymore. */
+	static void Reclaim();
+};
+
+/**
+ * Template for values that many threads read and few threads replace, read-copy-update style.
+ *
+ * Readers get the current value without locks or atomic read-modify-writes and keep using it for as long as their
+ * FReadScope lives, even when a writer publishes a new value in the meantime. Writers publish copies, and the values
+ * they replace are deleted once the readers that were using them are done.
+ *
+ * For small trivially copyable values, TSeqLock is cheaper.
+ *
+ * @param ValueType The type of the value.
+ */
+template<typename ValueType>
+class TSharedSnapshot
+{
+public:
+
+	/** Scope in which a reader can use the value that was current when the scope started. */
+	class FReadScope
+	{
+	public:
+		explicit FReadScope(const TSharedSnapshot& Snapshot)
+		{
+			FSharedSnapshotEpochs::EnterRead();
+			Value = Snapshot.Current;
+		}
+
+		~FReadScope()
+		{
+			FSharedSnapshotEpochs::ExitRead();
+		}
+
+		FReadScope(const FReadScope&) = delete;
+		FReadScope& operator=(const FReadScope&) = delete;
+
+		const ValueType* Get() const
+		{
+			return Value;
+		}
+
+		const ValueType* operator->() const
+		{
+			return Value;
+		}
+
+		const ValueType& operator*() const
+		{
+			return *Value;
+		}
+
+	private:
+		const ValueType* Value;
+	};
+
+public:
+
+	/** Default constructor, default constructs the value. */
+	TSharedSnapshot()
+		: Current(new ValueType())
+	{
+	}
+
+	/** Creates and initializes a new instance with a copy of the given value. */
+	explicit TSharedSnapshot(const ValueType& InValue)
+		: Current(new ValueType(InValue))
+	{
+	}
+
+	/** Creates and initializes a new instance by moving the given value. */
+	explicit TSharedSnapshot(ValueType&& InValue)
+		: Current(new ValueType(MoveTemp(InValue)))
+	{
+	}
+
+	/** Destructor, no reads may start anymore but the ones in progress can end later. */
+	~TSharedSnapshot()
+	{
+		FSharedSnapshotEpochs::Retire(Current, &DeleteValue);
+	}
+
+	TSharedSnapshot(const TSharedSnapshot&) = delete;
+	TSharedSnapshot& operator=(const TSharedSnapshot&) = delete;
+
+public:
+
+	/**
+	 * Calls a function with the current value, from any thread.
+	 *
+	 * @param Func The function, called with a const reference to the value that must not be kept after it returns.
+	 * @return Whatever the function returns.
+	 */
+	template<typename FuncType>
+	auto Read(FuncType&& Func) const -> decltype(Func(DeclVal<const ValueType&>()))
+	{
+		FReadScope Scope(*this);
+		return Func(*Scope);
+	}
+
+	/**
+	 * Replaces the value, from any thread.
+	 *
+	 * @param InValue The new value.
+	 */
+	void Publish(const ValueType& InValue)
+	{
+		FScopeLock Lock(&WriteCritical);
+		PublishValue(new ValueType(InValue));
+	}
+
+	/**
+	 * Replaces the value, from any thread.
+	 *
+	 * @param InValue The new value.
+	 */
+	void Publish(ValueType&& InValue)
+	{
+		FScopeLock Lock(&WriteCritical);
+		PublishValue(new ValueType(MoveTemp(InValue)));
+	}
+
+	/**
+	 * Replaces the value with a modified copy, from any thread. Concurrent updates take turns so none is lost.
+	 *
+	 * @param Func The function that modifies the copy, called with a reference to it.
+	 */
+	template<typename FuncType>
+	void Update(FuncType&& Func)
+	{
+		FScopeLock Lock(&WriteCritical);
+		ValueType* NewValue = new ValueType(*Current);
+		Func(*NewValue);
+		PublishValue(NewValue);
+	}
+
+private:
+
+	void PublishValue(ValueType* NewValue)
+	{
+		ValueType* OldValue = (ValueType*)FPlatformAtomics::InterlockedExchangePtr((void*volatile*)&Current, NewValue);
+		FSharedSnapshotEpochs::Retire(OldValue, &DeleteValue);
+	}
+
+	static void DeleteValue(void* Value)
+	{
+		delete (ValueType*)Value;
+	}
+
+	/** The current value, replaced as a whole by writers */
+	ValueType* volatile Current;
+
+	/** Serializes writers so that updates copy the latest value */
+	FCriticalSection WriteCritical;
+};
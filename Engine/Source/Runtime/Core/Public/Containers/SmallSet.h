@@ -0,0 +1,356 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/FlatSet.h"
+#include <initializer_list>
+
+/**
+ * A set for few elements, usable in place of TSet where most instances hold a handful of elements.
+ *
+ * Up to NumInlineElements elements are stored inline in the set and found by comparing every key, so small sets
+ * never allocate or hash. Adding more moves the elements to a TFlatSet, which the set keeps using until it is
+ * emptied or shrunk back to NumInlineElements elements or fewer. Adding an element may move the others and
+ * invalidate pointers to them, removing one keeps the order of the others. Duplicate keys are not supported.
+ **/
+template<typename InElementType, int32 NumInlineElements = 8, typename KeyFuncs = DefaultKeyFuncs<InElementType>>
+class TSmallSet
+{
+	static_assert(NumInlineElements > 0, "TSmallSet needs room for at least one inline element");
+
+public:
+	typedef InElementType ElementType;
+	typedef typename KeyFuncs::KeyInitType KeyInitType;
+	typedef typename KeyFuncs::ElementInitType ElementInitType;
+
+	TSmallSet() = default;
+	TSmallSet(TSmallSet&&) = default;
+	TSmallSet(const TSmallSet&) = default;
+	TSmallSet& operator=(TSmallSet&&) = default;
+	TSmallSet& operator=(const TSmallSet&) = default;
+
+	/** Initializer list constructor. */
+	TSmallSet(std::initializer_list<ElementType> InitList)
+	{
+		Reserve((int32)InitList.size());
+		for (const ElementType& Element : InitList)
+		{
+			Add(Element);
+		}
+	}
+
+	/** @return The number of elements in the set. */
+	FORCEINLINE int32 Num() const
+	{
+		return InlineElements.Num() + HashedElements.Num();
+	}
+
+	/**
+	 * Removes all elements from the set, potentially leaving space allocated for an expected number of elements about to be added.
+	 * @param ExpectedNumElements - The number of elements about to be added to the set.
+	 */
+	void Empty(int32 ExpectedNumElements = 0)
+	{
+		InlineElements.Reset();
+		HashedElements.Empty(ExpectedNumElements > NumInlineElements ? ExpectedNumElements : 0);
+	}
+
+	/** Efficiently empties out the set but preserves all allocations and capacities */
+	void Reset()
+	{
+		InlineElements.Reset();
+		HashedElements.Reset();
+	}
+
+	/** Preallocates enough memory to contain Number elements */
+	void Reserve(int32 Number)
+	{
+		if (Number > NumInlineElements)
+		{
+			HashedElements.Reserve(Number);
+		}
+	}
+
+	/** Shrinks the allocations to fit the elements in the set, moving them back inline when they fit. */
+	void Shrink()
+	{
+		if (HashedElements.Num() <= NumInlineElements)
+		{
+			for (ElementType& Element : HashedElements)
+			{
+				InlineElements.Add(MoveTemp(Element));
+			}
+			HashedElements.Empty();
+		}
+		else
+		{
+			HashedElements.Shrink();
+		}
+	}
+
+	/** @return The amount of memory allocated by this container, not including sub-objects. */
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return HashedElements.GetAllocatedSize();
+	}
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	InElement			Element to add to set
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added or removed.
+	 */
+	FORCEINLINE ElementType& Add(const ElementType&  InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(InElement, bIsAlreadyInSetPtr); }
+	FORCEINLINE ElementType& Add(      ElementType&& InElement, bool* bIsAlreadyInSetPtr = nullptr) { return Emplace(MoveTempIfPossible(InElement), bIsAlreadyInSetPtr); }
+
+	/**
+	 * Adds an element to the set, replacing an existing element with the same key.
+	 *
+	 * @param	Args				The argument(s) to be forwarded to the set element's constructor.
+	 * @param	bIsAlreadyInSetPtr	[out]	Optional pointer to bool that will be set depending on whether element is already in set
+	 * @return	The element in the set, valid until the next element is added or removed.
+	 */
+	template <typename ArgsType>
+	ElementType& Emplace(ArgsType&& Args, bool* bIsAlreadyInSetPtr = nullptr)
+	{
+		if (HashedElements.Num() > 0)
+		{
+			return HashedElements.Emplace(Forward<ArgsType>(Args), bIsAlreadyInSetPtr);
+		}
+
+		TTypeCompatibleBytes<ElementType> NewElementBytes;
+		ElementType& NewElement = *new(&NewElementBytes) ElementType(Forward<ArgsType>(Args));
+		const int32 ExistingIndex = FindInlineIndex(KeyFuncs::GetSetKey(NewElement));
+		if (bIsAlreadyInSetPtr)
+		{
+			*bIsAlreadyInSetPtr = ExistingIndex != INDEX_NONE;
+		}
+
+		if (ExistingIndex != INDEX_NONE)
+		{
+			// If there's an existing element with the same key as the new element, replace the existing element with the new element.
+			ElementType& Existing = InlineElements[ExistingIndex];
+			MoveByRelocate(Existing, NewElement);
+			return Existing;
+		}
+
+		if (InlineElements.Num() < NumInlineElements)
+		{
+			ElementType* Slot = InlineElements.GetData() + InlineElements.AddUninitialized();
+			RelocateConstructItems<ElementType>(Slot, &NewElement, 1);
+			return *Slot;
+		}
+
+		// One element too many to keep searching linearly
+		HashedElements.Reserve(NumInlineElements * 2);
+		for (ElementType& Element : InlineElements)
+		{
+			HashedElements.Add(MoveTemp(Element));
+		}
+		InlineElements.Reset();
+		ElementType& Added = HashedElements.Add(MoveTemp(NewElement));
+		DestructItem(&NewElement);
+		return Added;
+	}
+
+	/**
+	 * Removes the element with the given key.
+	 * @return The number of elements removed.
+	 */
+	int32 Remove(KeyInitType Key)
+	{
+		if (HashedElements.Num() > 0)
+		{
+			return HashedElements.Remove(Key);
+		}
+
+		const int32 Index = FindInlineIndex(Key);
+		if (Index == INDEX_NONE)
+		{
+			return 0;
+		}
+		InlineElements.RemoveAt(Index, 1, false);
+		return 1;
+	}
+
+	/**
+	 * Finds an element with the given key in the set.
+	 * @return A pointer to the element, or nullptr if the set doesn't contain one with this key.
+	 */
+	FORCEINLINE ElementType* Find(KeyInitType Key)
+	{
+		if (HashedElements.Num() > 0)
+		{
+			return HashedElements.Find(Key);
+		}
+
+		const int32 Index = FindInlineIndex(Key);
+		return Index != INDEX_NONE ? InlineElements.GetData() + Index : nullptr;
+	}
+
+	FORCEINLINE const ElementType* Find(KeyInitType Key) const
+	{
+		return const_cast<TSmallSet*>(this)->Find(Key);
+	}
+
+	/** @return Whether the set contains an element with the given key. */
+	FORCEINLINE bool Contains(KeyInitType Key) const
+	{
+		return Find(Key) != nullptr;
+	}
+
+	/** @return Whether the elements are stored inline and searched linearly. */
+	FORCEINLINE bool IsInline() const
+	{
+		return HashedElements.Num() == 0;
+	}
+
+	/** The base type of set iterators, visiting the inline elements in order or the hashed ones in slot order. */
+	template<bool bConst>
+	class TBaseIterator
+	{
+	public:
+		typedef typename TChooseClass<bConst, const TSmallSet, TSmallSet>::Result SetType;
+		typedef typename TChooseClass<bConst, const ElementType, ElementType>::Result ItElementType;
+		typedef typename TChooseClass<bConst, typename TFlatSet<ElementType, KeyFuncs>::TConstIterator, typename TFlatSet<ElementType, KeyFuncs>::TIterator>::Result HashedItType;
+
+		FORCEINLINE TBaseIterator(SetType& InSet, bool bEnd)
+			: Set(InSet)
+			, InlineIndex(bEnd ? InSet.InlineElements.Num() : 0)
+			, HashedIt(InSet.HashedElements, bEnd ? InSet.HashedElements.Max() : 0)
+			, bInline(InSet.IsInline())
+		{
+		}
+
+		/** Advances the iterator to the next element. */
+		FORCEINLINE TBaseIterator& operator++()
+		{
+			if (bInline)
+			{
+				++InlineIndex;
+			}
+			else
+			{
+				++HashedIt;
+			}
+			return *this;
+		}
+
+		/** conversion to "bool" returning true if the iterator is valid. */
+		FORCEINLINE explicit operator bool() const
+		{
+			return bInline ? InlineIndex < Set.InlineElements.Num() : !!HashedIt;
+		}
+		/** inverse of the "bool" operator */
+		FORCEINLINE bool operator !() const
+		{
+			return !(bool)*this;
+		}
+
+		// Accessors.
+		FORCEINLINE ItElementType& operator*() const
+		{
+			return bInline ? Set.InlineElements[InlineIndex] : *HashedIt;
+		}
+		FORCEINLINE ItElementType* operator->() const
+		{
+			return &**this;
+		}
+
+		FORCEINLINE friend bool operator==(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return Lhs.InlineIndex == Rhs.InlineIndex && Lhs.HashedIt == Rhs.HashedIt; }
+		FORCEINLINE friend bool operator!=(const TBaseIterator& Lhs, const TBaseIterator& Rhs) { return !(Lhs == Rhs); }
+
+	protected:
+		SetType& Set;
+		int32 InlineIndex;
+		HashedItType HashedIt;
+
+		/** Removing elements never moves them out of the inline storage, so this can't change while iterating */
+		bool bInline;
+	};
+
+	/** Used to iterate over the elements of a const TSmallSet. */
+	class TConstIterator : public TBaseIterator<true>
+	{
+	public:
+		FORCEINLINE TConstIterator(const TSmallSet& InSet, bool bEnd = false)
+			: TBaseIterator<true>(InSet, bEnd)
+		{
+		}
+	};
+
+	/** Used to iterate over the elements of a TSmallSet. */
+	class TIterator : public TBaseIterator<false>
+	{
+	public:
+		FORCEINLINE TIterator(TSmallSet& InSet, bool bEnd = false)
+			: TBaseIterator<false>(InSet, bEnd)
+		{
+		}
+
+		/** Removes the current element from the set, the iterator can still be advanced afterwards. */
+		FORCEINLINE void RemoveCurrent()
+		{
+			if (this->bInline)
+			{
+				this->Set.InlineElements.RemoveAt(this->InlineIndex--, 1, false);
+			}
+			else
+			{
+				this->HashedIt.RemoveCurrent();
+			}
+		}
+	};
+
+	/** Creates an iterator for the contents of this set */
+	FORCEINLINE TIterator CreateIterator()
+	{
+		return TIterator(*this);
+	}
+
+	/** Creates a const iterator for the contents of this set */
+	FORCEINLINE TConstIterator CreateConstIterator() const
+	{
+		return TConstIterator(*this);
+	}
+
+public:
+	/**
+	 * DO NOT USE DIRECTLY
+	 * STL-like iterators to enable range-based for loop support.
+	 */
+	FORCEINLINE TIterator      begin()       { return TIterator(*this); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(*this); }
+	FORCEINLINE TIterator      end()         { return TIterator(*this, true); }
+	FORCEINLINE TConstIterator end() const   { return TConstIterator(*this, true); }
+
+private:
+	/** Compares every inline key, which beats hashing the key for this few elements */
+	template<typename ComparableKey>
+	FORCEINLINE int32 FindInlineIndex(const ComparableKey& Key) const
+	{
+		const ElementType* Data = InlineElements.GetData();
+		for (int32 Index = 0, Count = InlineElements.Num(); Index < Count; ++Index)
+		{
+			if (KeyFuncs::Matches(KeyFuncs::GetSetKey(Data[Index]), Key))
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/** The elements while there are at most NumInlineElements, empty otherwise */
+	TArray<ElementType, TInlineAllocator<NumInlineElements>> InlineElements;
+
+	/** The elements once there were more than NumInlineElements, empty otherwise */
+	TFlatSet<ElementType, KeyFuncs> HashedElements;
+};
@@ -77,6 +77,8 @@ class TSparseArray
 	template <typename, typename>
 	friend class TScriptSparseArray;
 
+	friend struct FSparseArrayParallel;
+
 public:
 	static const bool SupportsFreezeMemoryImage = TAllocatorTraits<Allocator>::SupportsFreezeMemoryImage && THasTypeLayout<InElementType>::Value;
 
@@ -441,28 +443,20 @@ public:
 
 		FElementOrFreeListLink* ElementData = Data.GetData();
 
-		int32 EndIndex    = Data.Num();
-		int32 TargetIndex = EndIndex - NumFree;
-		int32 FreeIndex   = FirstFreeIndex;
-		while (FreeIndex != -1)
+		// Move the elements past the target range into its holes, scanning the allocation flags a word at a time
+		// rather than following the free list
+		int32 TargetIndex = Data.Num() - NumFree;
+		int32 ElementIndex = TargetIndex;
+		for (int32 FreeIndex = AllocationFlags.FindFrom(false, 0); FreeIndex != INDEX_NONE && FreeIndex < TargetIndex; FreeIndex = AllocationFlags.FindFrom(false, FreeIndex + 1))
 		{
-			int32 NextFreeIndex = GetData(FreeIndex).NextFreeIndex;
-			if (FreeIndex < TargetIndex)
-			{
-				// We need an element here
-				do
-				{
-					--EndIndex;
-				}
-				while (!AllocationFlags[EndIndex]);
-
-				RelocateConstructItems<FElementOrFreeListLink>(ElementData + FreeIndex, ElementData + EndIndex, 1);
-				AllocationFlags[FreeIndex] = true;
+			ElementIndex = AllocationFlags.FindFrom(true, ElementIndex);
+			checkSlow(ElementIndex != INDEX_NONE);
 
-				bResult = true;
-			}
+			RelocateConstructItems<FElementOrFreeListLink>(ElementData + FreeIndex, ElementData + ElementIndex, 1);
+			AllocationFlags[FreeIndex] = true;
+			++ElementIndex;
 
-			FreeIndex = NextFreeIndex;
+			bResult = true;
 		}
 
 		Data           .RemoveAt(TargetIndex, NumFree);
@@ -787,6 +781,34 @@ public:
 	int32 GetMaxIndex() const { return Data.Num(); }
 	int32 Num() const { return Data.Num() - NumFreeIndices; }
 
+	/**
+	 * Calls Func(Index, Element) for each allocated element with an index in [StartIndex, EndIndex), in index order.
+	 * Different ranges can be visited from different threads, e.g. to split the array over the batches of a ParallelFor.
+	 */
+	template <typename FuncType>
+	void ForEachAllocatedInRange(int32 StartIndex, int32 EndIndex, FuncType&& Func)
+	{
+		AllocationFlags.ForEachSetBit(StartIndex, EndIndex, [this, &Func](int32 Index)
+		{
+			Func(Index, (*this)[Index]);
+		});
+	}
+
+	template <typename FuncType>
+	void ForEachAllocatedInRange(int32 StartIndex, int32 EndIndex, FuncType&& Func) const
+	{
+		AllocationFlags.ForEachSetBit(StartIndex, EndIndex, [this, &Func](int32 Index)
+		{
+			Func(Index, (*this)[Index]);
+		});
+	}
+
+	/** @return The number of allocated elements with an index in [StartIndex, EndIndex). */
+	int32 NumAllocatedInRange(int32 StartIndex, int32 EndIndex) const
+	{
+		return AllocationFlags.CountSetBits(StartIndex, EndIndex);
+	}
+
 	/**
 	 * Checks that the specified address is not part of an element within the container.  Used for implementations
 	 * to check that reference arguments aren't going to be invalidated by possible reallocation.
@@ -11,6 +11,19 @@
 #include "Containers/Array.h"
 #include "Misc/CString.h"
 
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#define UE_STRINGCONV_SSE2 1
+	#define UE_STRINGCONV_NEON 0
+	#include <emmintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#define UE_STRINGCONV_SSE2 0
+	#define UE_STRINGCONV_NEON 1
+	#include <arm_neon.h>
+#else
+	#define UE_STRINGCONV_SSE2 0
+	#define UE_STRINGCONV_NEON 0
+#endif
+
 #define DEFAULT_STRING_CONVERSION_SIZE 128u
 #define UNICODE_BOGUS_CHAR_CODEPOINT '?'
 static_assert(sizeof(UNICODE_BOGUS_CHAR_CODEPOINT) <= sizeof(ANSICHAR) && (UNICODE_BOGUS_CHAR_CODEPOINT) >= 32 && (UNICODE_BOGUS_CHAR_CODEPOINT) <= 127, "The Unicode Bogus character point is expected to fit in a single ANSICHAR here");
@@ -187,6 +200,157 @@ namespace UE4StringConv_Private
 	private:
 		int32 Counter;
 	};
+
+	/** Number of characters the ASCII fast paths of the UTF-8 converters check and copy at once */
+	constexpr int32 AsciiBlockSize = 16;
+
+	/** @return Whether the AsciiBlockSize characters starting at Source are all 7 bit ASCII */
+	FORCEINLINE bool IsAsciiBlock(const ANSICHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)Source)) == 0;
+#elif UE_STRINGCONV_NEON
+		const uint64x2_t Block = vreinterpretq_u64_u8(vld1q_u8((const uint8*)Source));
+		return ((vgetq_lane_u64(Block, 0) | vgetq_lane_u64(Block, 1)) & 0x8080808080808080ull) == 0;
+#else
+		uint64 Bits[2];
+		FMemory::Memcpy(Bits, Source, sizeof(Bits));
+		return ((Bits[0] | Bits[1]) & 0x8080808080808080ull) == 0;
+#endif
+	}
+
+	FORCEINLINE bool IsAsciiBlock(const TCHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i* Blocks = (const __m128i*)Source;
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const __m128i Combined = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1)), _mm_or_si128(_mm_loadu_si128(Blocks + 2), _mm_loadu_si128(Blocks + 3)));
+		const __m128i NonAsciiBits = _mm_set1_epi32(~0x7F);
+	#else
+		const __m128i Combined = _mm_or_si128(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1));
+		const __m128i NonAsciiBits = _mm_set1_epi16(~0x7F);
+	#endif
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Combined, NonAsciiBits), _mm_setzero_si128())) == 0xFFFF;
+#elif UE_STRINGCONV_NEON
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const uint32* Blocks = (const uint32*)Source;
+		const uint32x4_t Combined = vorrq_u32(vorrq_u32(vld1q_u32(Blocks), vld1q_u32(Blocks + 4)), vorrq_u32(vld1q_u32(Blocks + 8), vld1q_u32(Blocks + 12)));
+		const uint64x2_t Block = vreinterpretq_u64_u32(vandq_u32(Combined, vdupq_n_u32(~0x7Fu)));
+	#else
+		const uint16* Blocks = (const uint16*)Source;
+		const uint16x8_t Combined = vorrq_u16(vld1q_u16(Blocks), vld1q_u16(Blocks + 8));
+		const uint64x2_t Block = vreinterpretq_u64_u16(vandq_u16(Combined, vdupq_n_u16(uint16(~0x7Fu))));
+	#endif
+		return (vgetq_lane_u64(Block, 0) | vgetq_lane_u64(Block, 1)) == 0;
+#else
+		uint32 Combined = 0;
+		for (int32 Index = 0; Index < AsciiBlockSize; ++Index)
+		{
+			Combined |= (uint32)Source[Index];
+		}
+		return Combined < 0x80;
+#endif
+	}
+
+	/** Writes a block checked by IsAsciiBlock to Dest as UTF-16 or UTF-32 and moves Dest past it */
+	FORCEINLINE void CopyAsciiBlock(TCHAR*& Dest, const ANSICHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i Block = _mm_loadu_si128((const __m128i*)Source);
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i Low = _mm_unpacklo_epi8(Block, Zero);
+		const __m128i High = _mm_unpackhi_epi8(Block, Zero);
+		__m128i* Out = (__m128i*)Dest;
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		_mm_storeu_si128(Out,     _mm_unpacklo_epi16(Low, Zero));
+		_mm_storeu_si128(Out + 1, _mm_unpackhi_epi16(Low, Zero));
+		_mm_storeu_si128(Out + 2, _mm_unpacklo_epi16(High, Zero));
+		_mm_storeu_si128(Out + 3, _mm_unpackhi_epi16(High, Zero));
+	#else
+		_mm_storeu_si128(Out,     Low);
+		_mm_storeu_si128(Out + 1, High);
+	#endif
+#elif UE_STRINGCONV_NEON
+		const uint8x16_t Block = vld1q_u8((const uint8*)Source);
+		const uint16x8_t Low = vmovl_u8(vget_low_u8(Block));
+		const uint16x8_t High = vmovl_u8(vget_high_u8(Block));
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		uint32* Out = (uint32*)Dest;
+		vst1q_u32(Out,      vmovl_u16(vget_low_u16(Low)));
+		vst1q_u32(Out + 4,  vmovl_u16(vget_high_u16(Low)));
+		vst1q_u32(Out + 8,  vmovl_u16(vget_low_u16(High)));
+		vst1q_u32(Out + 12, vmovl_u16(vget_high_u16(High)));
+	#else
+		uint16* Out = (uint16*)Dest;
+		vst1q_u16(Out,     Low);
+		vst1q_u16(Out + 8, High);
+	#endif
+#else
+		for (int32 Index = 0; Index < AsciiBlockSize; ++Index)
+		{
+			Dest[Index] = (TCHAR)Source[Index];
+		}
+#endif
+		Dest += AsciiBlockSize;
+	}
+
+	/** Writes a block checked by IsAsciiBlock to Dest as UTF-8 and moves Dest past it */
+	FORCEINLINE void CopyAsciiBlock(ANSICHAR*& Dest, const TCHAR* Source)
+	{
+#if UE_STRINGCONV_SSE2
+		const __m128i* Blocks = (const __m128i*)Source;
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		// The values are below 0x80 so the saturating packs can't change them
+		const __m128i Low = _mm_packs_epi32(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1));
+		const __m128i High = _mm_packs_epi32(_mm_loadu_si128(Blocks + 2), _mm_loadu_si128(Blocks + 3));
+		_mm_storeu_si128((__m128i*)Dest, _mm_packus_epi16(Low, High));
+	#else
+		_mm_storeu_si128((__m128i*)Dest, _mm_packus_epi16(_mm_loadu_si128(Blocks), _mm_loadu_si128(Blocks + 1)));
+	#endif
+#elif UE_STRINGCONV_NEON
+	#if PLATFORM_TCHAR_IS_4_BYTES
+		const uint32* Blocks = (const uint32*)Source;
+		const uint16x8_t Low = vcombine_u16(vmovn_u32(vld1q_u32(Blocks)), vmovn_u32(vld1q_u32(Blocks + 4)));
+		const uint16x8_t High = vcombine_u16(vmovn_u32(vld1q_u32(Blocks + 8)), vmovn_u32(vld1q_u32(Blocks + 12)));
+	#else
+		const uint16* Blocks = (const uint16*)Source;
+		const uint16x8_t Low = vld1q_u16(Blocks);
+		const uint16x8_t High = vld1q_u16(Blocks + 8);
+	#endif
+		vst1q_u8((uint8*)Dest, vcombine_u8(vmovn_u16(Low), vmovn_u16(High)));
+#else
+		for (int32 Index = 0; Index < AsciiBlockSize; ++Index)
+		{
+			Dest[Index] = (ANSICHAR)Source[Index];
+		}
+#endif
+		Dest += AsciiBlockSize;
+	}
+
+	/** Only counts the block when measuring the converted length */
+	template <typename FromType>
+	FORCEINLINE void CopyAsciiBlock(FCountingOutputIterator& Dest, const FromType* Source)
+	{
+		Dest += AsciiBlockSize;
+	}
+
+	/**
+	 * Copies whole blocks of ASCII characters from the start of Source, which are the same in every encoding, stopping before
+	 * the first block holding anything else or when fewer than AsciiBlockSize of MaxLen characters remain.
+	 *
+	 * @return The number of characters copied, the caller converts the rest one codepoint at a time
+	 */
+	template <typename DestBufferType, typename FromType>
+	FORCEINLINE int32 CopyAsciiBlocks(DestBufferType& Dest, const FromType* Source, int32 MaxLen)
+	{
+		int32 NumCopied = 0;
+		while (NumCopied + AsciiBlockSize <= MaxLen && IsAsciiBlock(Source + NumCopied))
+		{
+			CopyAsciiBlock(Dest, Source + NumCopied);
+			NumCopied += AsciiBlockSize;
+		}
+		return NumCopied;
+	}
 }
 
 // This should be replaced with Platform stuff when FPlatformString starts to know about UTF-8.
@@ -305,6 +469,17 @@ private:
 		{
 			uint32 Codepoint = static_cast<uint32>(Source[i]);
 
+			if (Codepoint < 0x80)
+			{
+				const int32 NumAscii = UE4StringConv_Private::CopyAsciiBlocks(Dest, Source + i, FMath::Min(SourceLen - i, DestLen));
+				if (NumAscii)
+				{
+					DestLen -= NumAscii;
+					i += NumAscii - 1;
+					continue;
+				}
+			}
+
 			if (!WriteCodepointToBuffer(Codepoint, Dest, DestLen))
 			{
 				// Could not write data, bail out
@@ -319,6 +494,18 @@ private:
 			const bool bHighSurrogateIsSet = HighSurrogate != MAX_uint32;
 			uint32 Codepoint = static_cast<uint32>(Source[i]);
 
+			// Runs of ASCII are copied a block at a time, unless a lone high-surrogate has to be written first
+			if (Codepoint < 0x80 && !bHighSurrogateIsSet)
+			{
+				const int32 NumAscii = UE4StringConv_Private::CopyAsciiBlocks(Dest, Source + i, FMath::Min(SourceLen - i, DestLen));
+				if (NumAscii)
+				{
+					DestLen -= NumAscii;
+					i += NumAscii - 1;
+					continue;
+				}
+			}
+
 			// Check if this character is a high-surrogate
 			if (StringConv::IsHighSurrogate(Codepoint))
 			{
@@ -656,6 +843,18 @@ private:
 		const ANSICHAR* SourceEnd = Source + SourceLen;
 		while (Source < SourceEnd && DestLen > 0)
 		{
+			// Runs of ASCII are copied a block at a time
+			if ((uint8)*Source < 0x80)
+			{
+				const int32 NumAscii = UE4StringConv_Private::CopyAsciiBlocks(ConvertedBuffer, Source, FMath::Min(UE_PTRDIFF_TO_INT32(SourceEnd - Source), DestLen));
+				if (NumAscii)
+				{
+					Source += NumAscii;
+					DestLen -= NumAscii;
+					continue;
+				}
+			}
+
 			// Read our codepoint, advancing the source pointer
 			uint32 Codepoint = CodepointFromUtf8(Source, UE_PTRDIFF_TO_UINT32(SourceEnd - Source));
 
@@ -12,6 +12,10 @@ class TStringBuilder;
 template <int32 N>
 class TAnsiStringBuilder;
 
+// String with inline storage
+template <int32 NumInlineChars>
+class TInlineString;
+
 // String View
 class FStringView;
 class FAnsiStringView;
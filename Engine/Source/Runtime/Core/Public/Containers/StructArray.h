@@ -0,0 +1,579 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Containers/ArrayView.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Delegates/IntegerSequence.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/ChooseClass.h"
+#include "Templates/MemoryOps.h"
+#include "Templates/UnrealTemplate.h"
+#include "Templates/UnrealTypeTraits.h"
+
+namespace UE4StructArray_Private
+{
+	template <typename... Types>
+	struct TMaxAlignOf;
+
+	template <typename T, typename... OtherTypes>
+	struct TMaxAlignOf<T, OtherTypes...>
+	{
+		enum { Value = alignof(T) > (SIZE_T)TMaxAlignOf<OtherTypes...>::Value ? alignof(T) : (SIZE_T)TMaxAlignOf<OtherTypes...>::Value };
+	};
+
+	template <>
+	struct TMaxAlignOf<>
+	{
+		enum { Value = PLATFORM_CACHE_LINE_SIZE };
+	};
+
+	template <typename... Types>
+	struct TSumSizeOf;
+
+	template <typename T, typename... OtherTypes>
+	struct TSumSizeOf<T, OtherTypes...>
+	{
+		enum { Value = sizeof(T) + TSumSizeOf<OtherTypes...>::Value };
+	};
+
+	template <>
+	struct TSumSizeOf<>
+	{
+		enum { Value = 0 };
+	};
+}
+
+/**
+ * A dynamically sized array of structs whose fields are stored as separate columns (structure of arrays).
+ *
+ * Each field of the struct is a template argument and gets its own contiguous column, every column starting on a
+ * cache line in a single allocation. Loops that only read a couple of fields of every element then only fetch
+ * those fields' cache lines, and the columns can be handed to ParallelFor or vectorized code as TArrayViews:
+ *
+ *     TStructArray<FVector, FVector, float> Particles; // Position, velocity, lifetime
+ *     TArrayView<FVector> Positions = Particles.GetColumn<0>();
+ *     TArrayView<const FVector> Velocities = Particles.GetConstColumn<1>();
+ *     ParallelFor(Particles.Num(), [&](int32 Index) { Positions[Index] += Velocities[Index] * DeltaTime; });
+ *
+ * Elements are accessed through lightweight proxies referencing a row, Array[Index].Get<FieldIndex>().
+ * Like TArray, elements are assumed to be bitwise relocatable, and adding or removing elements invalidates
+ * the column views.
+ */
+template <typename... FieldTypes>
+class TStructArray
+{
+	static_assert(sizeof...(FieldTypes) > 0, "TStructArray needs at least one field");
+
+	typedef TMakeIntegerSequence<int32, sizeof...(FieldTypes)> FFieldIndices;
+
+public:
+	enum { NumFields = sizeof...(FieldTypes) };
+
+	/** The type of the field with the given index */
+	template <int32 FieldIndex>
+	using TFieldType = typename TNthTypeFromParameterPack<FieldIndex, FieldTypes...>::Type;
+
+	/** Proxy for the fields of one element, invalidated like the column views */
+	template <bool bConst>
+	class TElementRef
+	{
+		typedef typename TChooseClass<bConst, const TStructArray, TStructArray>::Result ArrayType;
+
+	public:
+		FORCEINLINE TElementRef(ArrayType& InArray, int32 InIndex)
+			: Array(InArray)
+			, Index(InIndex)
+		{
+		}
+
+		/** @return The index of the element in the array. */
+		FORCEINLINE int32 GetIndex() const
+		{
+			return Index;
+		}
+
+		/** @return A reference to the given field of the element. */
+		template <int32 FieldIndex>
+		FORCEINLINE typename TChooseClass<bConst, const TFieldType<FieldIndex>, TFieldType<FieldIndex>>::Result& Get() const
+		{
+			return Array.template GetColumnData<FieldIndex>()[Index];
+		}
+
+		/** Assigns all the fields of the element. */
+		template <typename... ArgTypes>
+		void Set(ArgTypes&&... Args) const
+		{
+			static_assert(!bConst, "Can't assign the fields of a const element");
+			static_assert(sizeof...(ArgTypes) == NumFields, "Set needs a value for every field");
+			Array.SetFields(FFieldIndices(), Index, Forward<ArgTypes>(Args)...);
+		}
+
+	private:
+		ArrayType& Array;
+		int32 Index;
+	};
+
+	typedef TElementRef<false> FElementRef;
+	typedef TElementRef<true> FConstElementRef;
+
+	TStructArray()
+		: ArrayNum(0)
+		, ArrayMax(0)
+	{
+		ResetColumns();
+	}
+
+	TStructArray(const TStructArray& Other)
+		: ArrayNum(0)
+		, ArrayMax(0)
+	{
+		ResetColumns();
+		Append(Other);
+	}
+
+	TStructArray(TStructArray&& Other)
+		: ArrayNum(Other.ArrayNum)
+		, ArrayMax(Other.ArrayMax)
+	{
+		FMemory::Memcpy(Columns, Other.Columns, sizeof(Columns));
+		Other.ArrayNum = 0;
+		Other.ArrayMax = 0;
+		Other.ResetColumns();
+	}
+
+	~TStructArray()
+	{
+		DestructFields(FFieldIndices(), 0, ArrayNum);
+		FMemory::Free(Columns[0]);
+	}
+
+	TStructArray& operator=(const TStructArray& Other)
+	{
+		if (this != &Other)
+		{
+			Reset(Other.ArrayNum);
+			Append(Other);
+		}
+		return *this;
+	}
+
+	TStructArray& operator=(TStructArray&& Other)
+	{
+		if (this != &Other)
+		{
+			DestructFields(FFieldIndices(), 0, ArrayNum);
+			FMemory::Free(Columns[0]);
+
+			ArrayNum = Other.ArrayNum;
+			ArrayMax = Other.ArrayMax;
+			FMemory::Memcpy(Columns, Other.Columns, sizeof(Columns));
+			Other.ArrayNum = 0;
+			Other.ArrayMax = 0;
+			Other.ResetColumns();
+		}
+		return *this;
+	}
+
+	/** @return Number of elements in the array. */
+	FORCEINLINE int32 Num() const
+	{
+		return ArrayNum;
+	}
+
+	/** @return Number of elements the array can hold without reallocating. */
+	FORCEINLINE int32 Max() const
+	{
+		return ArrayMax;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return ArrayNum == 0;
+	}
+
+	FORCEINLINE bool IsValidIndex(int32 Index) const
+	{
+		return Index >= 0 && Index < ArrayNum;
+	}
+
+	/** @return The amount of memory allocated by the columns. */
+	SIZE_T GetAllocatedSize() const
+	{
+		return ArrayMax ? GetColumnOffsets(ArrayMax, nullptr) : 0;
+	}
+
+	FORCEINLINE FElementRef operator[](int32 Index)
+	{
+		RangeCheck(Index);
+		return FElementRef(*this, Index);
+	}
+
+	FORCEINLINE FConstElementRef operator[](int32 Index) const
+	{
+		RangeCheck(Index);
+		return FConstElementRef(*this, Index);
+	}
+
+	/** @return A pointer to the first element of the given column, only valid until the array is resized. */
+	template <int32 FieldIndex>
+	FORCEINLINE TFieldType<FieldIndex>* GetColumnData()
+	{
+		return (TFieldType<FieldIndex>*)Columns[FieldIndex];
+	}
+
+	template <int32 FieldIndex>
+	FORCEINLINE const TFieldType<FieldIndex>* GetColumnData() const
+	{
+		return (const TFieldType<FieldIndex>*)Columns[FieldIndex];
+	}
+
+	/** @return A view of the given field of every element, only valid until the array is resized. */
+	template <int32 FieldIndex>
+	FORCEINLINE TArrayView<TFieldType<FieldIndex>> GetColumn()
+	{
+		return TArrayView<TFieldType<FieldIndex>>(GetColumnData<FieldIndex>(), ArrayNum);
+	}
+
+	template <int32 FieldIndex>
+	FORCEINLINE TArrayView<const TFieldType<FieldIndex>> GetColumn() const
+	{
+		return TArrayView<const TFieldType<FieldIndex>>(GetColumnData<FieldIndex>(), ArrayNum);
+	}
+
+	template <int32 FieldIndex>
+	FORCEINLINE TArrayView<const TFieldType<FieldIndex>> GetConstColumn() const
+	{
+		return GetColumn<FieldIndex>();
+	}
+
+	/**
+	 * Adds an element at the end of the array.
+	 *
+	 * @param Args The values of each field, forwarded to the fields' constructors.
+	 * @return The index of the new element.
+	 */
+	template <typename... ArgTypes>
+	int32 Add(ArgTypes&&... Args)
+	{
+		static_assert(sizeof...(ArgTypes) == NumFields, "Add needs a value for every field");
+		const int32 Index = AddUninitialized(1);
+		ConstructFields(FFieldIndices(), Index, Forward<ArgTypes>(Args)...);
+		return Index;
+	}
+
+	/**
+	 * Adds elements at the end of the array without constructing their fields, the caller has to construct
+	 * every field of the new elements through the columns.
+	 *
+	 * @return The index of the first new element.
+	 */
+	int32 AddUninitialized(int32 Count = 1)
+	{
+		checkSlow(Count >= 0);
+		const int32 OldNum = ArrayNum;
+		if (OldNum + Count > ArrayMax)
+		{
+			ResizeTo(DefaultCalculateSlackGrow(OldNum + Count, ArrayMax, BytesPerElement, false, ColumnAlignment));
+		}
+		ArrayNum = OldNum + Count;
+		return OldNum;
+	}
+
+	/**
+	 * Adds default constructed elements at the end of the array.
+	 *
+	 * @return The index of the first new element.
+	 */
+	int32 AddDefaulted(int32 Count = 1)
+	{
+		const int32 Index = AddUninitialized(Count);
+		DefaultConstructFields(FFieldIndices(), Index, Count);
+		return Index;
+	}
+
+	/** Appends copies of the elements of another array. */
+	void Append(const TStructArray& Other)
+	{
+		checkSlow(this != &Other);
+		if (Other.ArrayNum)
+		{
+			const int32 Index = AddUninitialized(Other.ArrayNum);
+			CopyFields(FFieldIndices(), Index, Other, 0, Other.ArrayNum);
+		}
+	}
+
+	/**
+	 * Removes elements, moving the following ones down to keep the order.
+	 *
+	 * @param Index The index of the first element to remove.
+	 * @param Count The number of elements to remove.
+	 * @param bAllowShrinking Tells if this call can shrink the allocation.
+	 */
+	void RemoveAt(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+	{
+		if (Count)
+		{
+			checkSlow((Count >= 0) & (Index >= 0) & (Index + Count <= ArrayNum));
+			DestructFields(FFieldIndices(), Index, Count);
+			MoveFields(FFieldIndices(), Index, Index + Count, ArrayNum - Index - Count);
+			ArrayNum -= Count;
+
+			if (bAllowShrinking)
+			{
+				ResizeShrink();
+			}
+		}
+	}
+
+	/**
+	 * Removes elements, filling the hole with the last elements so the order isn't kept, which moves at most Count elements.
+	 *
+	 * @param Index The index of the first element to remove.
+	 * @param Count The number of elements to remove.
+	 * @param bAllowShrinking Tells if this call can shrink the allocation.
+	 */
+	void RemoveAtSwap(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+	{
+		if (Count)
+		{
+			checkSlow((Count >= 0) & (Index >= 0) & (Index + Count <= ArrayNum));
+			DestructFields(FFieldIndices(), Index, Count);
+
+			const int32 NumElementsAfterHole = ArrayNum - (Index + Count);
+			const int32 NumElementsToMoveIntoHole = FMath::Min(Count, NumElementsAfterHole);
+			MoveFields(FFieldIndices(), Index, ArrayNum - NumElementsToMoveIntoHole, NumElementsToMoveIntoHole);
+			ArrayNum -= Count;
+
+			if (bAllowShrinking)
+			{
+				ResizeShrink();
+			}
+		}
+	}
+
+	/**
+	 * Removes all the elements matching a predicate, keeping the order of the others.
+	 *
+	 * @param Predicate Called with a FConstElementRef for each element, returns true for the ones to remove.
+	 * @return The number of elements removed.
+	 */
+	template <typename PredicateType>
+	int32 RemoveAll(PredicateType Predicate)
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < ArrayNum; ++ReadIndex)
+		{
+			if (Predicate(FConstElementRef(*this, ReadIndex)))
+			{
+				DestructFields(FFieldIndices(), ReadIndex, 1);
+			}
+			else
+			{
+				if (WriteIndex != ReadIndex)
+				{
+					MoveFields(FFieldIndices(), WriteIndex, ReadIndex, 1);
+				}
+				++WriteIndex;
+			}
+		}
+
+		const int32 NumRemoved = ArrayNum - WriteIndex;
+		ArrayNum = WriteIndex;
+		return NumRemoved;
+	}
+
+	/**
+	 * Resizes the array, default constructing new elements.
+	 *
+	 * @param NewNum The new number of elements.
+	 * @param bAllowShrinking Tells if this call can shrink the allocation.
+	 */
+	void SetNum(int32 NewNum, bool bAllowShrinking = true)
+	{
+		if (NewNum > ArrayNum)
+		{
+			AddDefaulted(NewNum - ArrayNum);
+		}
+		else if (NewNum < ArrayNum)
+		{
+			RemoveAt(NewNum, ArrayNum - NewNum, bAllowShrinking);
+		}
+	}
+
+	/** Reserves memory such that the array can contain at least Number elements. */
+	void Reserve(int32 Number)
+	{
+		if (Number > ArrayMax)
+		{
+			ResizeTo(Number);
+		}
+	}
+
+	/** Removes all the elements, keeping the given slack. */
+	void Empty(int32 Slack = 0)
+	{
+		DestructFields(FFieldIndices(), 0, ArrayNum);
+		ArrayNum = 0;
+		if (ArrayMax != Slack)
+		{
+			ResizeTo(Slack);
+		}
+	}
+
+	/** Removes all the elements, keeping the allocation unless it's smaller than NewSize. */
+	void Reset(int32 NewSize = 0)
+	{
+		DestructFields(FFieldIndices(), 0, ArrayNum);
+		ArrayNum = 0;
+		if (NewSize > ArrayMax)
+		{
+			ResizeTo(NewSize);
+		}
+	}
+
+	/** Shrinks the allocation to fit the elements. */
+	void Shrink()
+	{
+		if (ArrayMax != ArrayNum)
+		{
+			ResizeTo(ArrayNum);
+		}
+	}
+
+private:
+	/** Columns start on a cache line boundary, so per-field loops can use aligned vector loads */
+	enum { ColumnAlignment = UE4StructArray_Private::TMaxAlignOf<FieldTypes...>::Value };
+	enum { BytesPerElement = UE4StructArray_Private::TSumSizeOf<FieldTypes...>::Value };
+
+	FORCEINLINE void RangeCheck(int32 Index) const
+	{
+		checkf((Index >= 0) & (Index < ArrayNum), TEXT("Array index out of bounds: %i from an array of size %i"), Index, ArrayNum);
+	}
+
+	void ResetColumns()
+	{
+		for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+		{
+			Columns[FieldIndex] = nullptr;
+		}
+	}
+
+	/** Computes where each column starts in an allocation for MaxElements elements, returning the size of the allocation */
+	static SIZE_T GetColumnOffsets(int32 MaxElements, SIZE_T* OutOffsets)
+	{
+		const SIZE_T FieldSizes[] = { sizeof(FieldTypes)... };
+		SIZE_T Offset = 0;
+		for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+		{
+			Offset = Align(Offset, ColumnAlignment);
+			if (OutOffsets)
+			{
+				OutOffsets[FieldIndex] = Offset;
+			}
+			Offset += FieldSizes[FieldIndex] * MaxElements;
+		}
+		return Offset;
+	}
+
+	/** Moves the elements to a new allocation for NewMax elements */
+	void ResizeTo(int32 NewMax)
+	{
+		checkSlow(NewMax >= ArrayNum);
+
+		void* NewColumns[NumFields];
+		if (NewMax)
+		{
+			SIZE_T Offsets[NumFields];
+			uint8* NewData = (uint8*)FMemory::Malloc(GetColumnOffsets(NewMax, Offsets), ColumnAlignment);
+			for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+			{
+				NewColumns[FieldIndex] = NewData + Offsets[FieldIndex];
+			}
+			RelocateFields(FFieldIndices(), NewColumns);
+		}
+		else
+		{
+			for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+			{
+				NewColumns[FieldIndex] = nullptr;
+			}
+		}
+
+		FMemory::Free(Columns[0]);
+		FMemory::Memcpy(Columns, NewColumns, sizeof(Columns));
+		ArrayMax = NewMax;
+	}
+
+	void ResizeShrink()
+	{
+		const int32 NewMax = DefaultCalculateSlackShrink(ArrayNum, ArrayMax, BytesPerElement, false, ColumnAlignment);
+		if (NewMax != ArrayMax)
+		{
+			ResizeTo(NewMax);
+		}
+	}
+
+	// Per-field operations, applied to every column. These should be implemented with fold expressions when our compilers support them.
+
+	template <int32... Indices>
+	FORCEINLINE void RelocateFields(TIntegerSequence<int32, Indices...>, void* (&NewColumns)[NumFields])
+	{
+		int Temp[] = { 0, (RelocateConstructItems<TFieldType<Indices>>(NewColumns[Indices], GetColumnData<Indices>(), ArrayNum), 0)... };
+		(void)Temp;
+	}
+
+	template <int32... Indices, typename... ArgTypes>
+	FORCEINLINE void ConstructFields(TIntegerSequence<int32, Indices...>, int32 Index, ArgTypes&&... Args)
+	{
+		int Temp[] = { 0, (new(GetColumnData<Indices>() + Index) TFieldType<Indices>(Forward<ArgTypes>(Args)), 0)... };
+		(void)Temp;
+	}
+
+	template <int32... Indices, typename... ArgTypes>
+	FORCEINLINE void SetFields(TIntegerSequence<int32, Indices...>, int32 Index, ArgTypes&&... Args)
+	{
+		int Temp[] = { 0, (GetColumnData<Indices>()[Index] = Forward<ArgTypes>(Args), 0)... };
+		(void)Temp;
+	}
+
+	template <int32... Indices>
+	FORCEINLINE void DefaultConstructFields(TIntegerSequence<int32, Indices...>, int32 Index, int32 Count)
+	{
+		int Temp[] = { 0, (DefaultConstructItems<TFieldType<Indices>>(GetColumnData<Indices>() + Index, Count), 0)... };
+		(void)Temp;
+	}
+
+	template <int32... Indices>
+	FORCEINLINE void CopyFields(TIntegerSequence<int32, Indices...>, int32 Index, const TStructArray& Source, int32 SourceIndex, int32 Count)
+	{
+		int Temp[] = { 0, (ConstructItems<TFieldType<Indices>>(GetColumnData<Indices>() + Index, Source.template GetColumnData<Indices>() + SourceIndex, Count), 0)... };
+		(void)Temp;
+	}
+
+	template <int32... Indices>
+	FORCEINLINE void DestructFields(TIntegerSequence<int32, Indices...>, int32 Index, int32 Count)
+	{
+		int Temp[] = { 0, (DestructItems(GetColumnData<Indices>() + Index, Count), 0)... };
+		(void)Temp;
+	}
+
+	/** Bitwise moves Count elements within every column, the destination must be destructed or uninitialized */
+	template <int32... Indices>
+	FORCEINLINE void MoveFields(TIntegerSequence<int32, Indices...>, int32 DestIndex, int32 SourceIndex, int32 Count)
+	{
+		if (Count)
+		{
+			int Temp[] = { 0, (FMemory::Memmove(GetColumnData<Indices>() + DestIndex, GetColumnData<Indices>() + SourceIndex, Count * sizeof(TFieldType<Indices>)), 0)... };
+			(void)Temp;
+		}
+	}
+
+	/** The columns live in a single allocation starting with the first column */
+	void* Columns[NumFields];
+	int32 ArrayNum;
+	int32 ArrayMax;
+};
@@ -4,6 +4,8 @@
 
 #include "CoreTypes.h"
 #include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "HAL/CriticalSection.h"
 #include "Delegates/IDelegateInstance.h"
 #include "Delegates/Delegate.h"
 
@@ -18,6 +20,9 @@ DECLARE_DELEGATE_RetVal_OneParam(bool, FTickerDelegate, float);
 
 /**
  * Ticker class. Fires delegates after a delay.
+ *
+ * Delegates are kept in a hierarchical timer wheel, so that adding, removing and expiring them doesn't depend on how many there are.
+ * Delegates can be added from any thread, they are scheduled by the next Tick. Removing and ticking must happen on the thread that owns the ticker.
  * 
  * Note: Do not try to add the same delegate instance twice, as there is no way to remove only a single instance (see member RemoveTicker).
  */
@@ -33,7 +38,7 @@ public:
 	CORE_API ~FTicker();
 
 	/**
-	 * Add a new ticker with a given delay / interval
+	 * Add a new ticker with a given delay / interval, can be called from any thread
 	 * 
 	 * @param InDelegate Delegate to fire after the delay
 	 * @param InDelay Delay until next fire; 0 means "next frame"
@@ -74,7 +79,7 @@ public:
 
 protected:
 	/**
-	 * Element of the priority queue
+	 * Element of the timer wheel
 	 */
 	struct FElement
 	{
@@ -84,8 +89,13 @@ protected:
 		float DelayTime;
 		/** Delegate to fire **/
 		FTickerDelegate Delegate;
+		/** Links to the other elements of the wheel slot or list this element is in, or to the next free element **/
+		int32 PrevIndex;
+		int32 NextIndex;
+		/** Wheel slot or list this element is in **/
+		int32 ListIndex;
 
-		/** Default ctor is only required to implement CurrentElement handling without making it a pointer. */
+		/** Default ctor is only required to grow the element array. */
 		CORE_API FElement();
 		/** This is the ctor that the code will generally use. */
 		CORE_API FElement(double InFireTime, float InDelayTime, const FTickerDelegate& InDelegate);
@@ -94,14 +104,51 @@ protected:
 		CORE_API bool Fire(float DeltaTime);
 	};
 
+	/** Delegate added since the last Tick, possibly from another thread */
+	struct FPendingElement
+	{
+		float DelayTime;
+		FTickerDelegate Delegate;
+	};
+
+	enum
+	{
+		/** Each level of the wheel has 64 slots, a slot of a level spans all the slots of the level below */
+		WheelSlotBits = 6,
+		NumWheelSlots = 1 << WheelSlotBits,
+		NumWheelLevels = 5,
+		/** Lists the elements can be in besides the wheel slots */
+		FireList = NumWheelSlots * NumWheelLevels,
+		RearmList,
+		NumLists
+	};
+
+	CORE_API void DrainPendingElements();
+	CORE_API void ScheduleElement(int32 Index);
+	CORE_API void CollectExpiredElements();
+	CORE_API void LinkElement(int32 Index, int32 ListIndex);
+	CORE_API void UnlinkElement(int32 Index);
+	CORE_API void FreeElement(int32 Index);
+
 	/** Current time of the ticker **/
 	double CurrentTime;
-	/** Future delegates to fire **/
-	TArray<FElement, TInlineAllocator<1>> Elements;
-	/** List of delegates that have been considered during Tick. Either they been fired or are not yet ready.*/
-	TArray<FElement, TInlineAllocator<1>> TickedElements;
-	/** Current element being ticked (only valid during tick). */
-	FElement CurrentElement;
+	/** Last tick of the wheel that was expired, its slot may still hold delegates that were not due yet **/
+	uint64 WheelTick;
+	/** Elements by index, which stays the same while an element is rescheduled, free elements are chained through NextIndex **/
+	TArray<FElement> Elements;
+	int32 FirstFreeElement;
+	int32 NumUsedElements;
+	/** First element of each wheel slot and list, which are doubly linked through the elements **/
+	int32 ListHeads[NumLists];
+	/** Bit per slot of each level of the wheel that holds elements **/
+	uint64 WheelOccupancy[NumWheelLevels];
+	/** Elements of each delegate handle, as removing a handle removes all of them **/
+	TMultiMap<FDelegateHandle, int32> HandleToElements;
+	/** Delegates to schedule on the next Tick **/
+	FCriticalSection PendingElementsCritical;
+	TArray<FPendingElement> PendingElements;
+	/** Index of the element being ticked (only valid during tick). */
+	int32 CurrentElementIndex;
 	/** State to track whether CurrentElement is valid. */
 	bool bInTick;
 	/** State to track whether the CurrentElement removed itself during its own delegate execution. */
@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Implements a bounded Chase-Lev work stealing deque of pointers.
+ *
+ * The owning thread pushes and pops items at the bottom end in LIFO order, which keeps recently spawned work hot in its cache.
+ * Any other thread may steal items from the top end in FIFO order. Steals only contend with each other and with the owner
+ * when the deque is about to become empty.
+ *
+ * The queue has a fixed capacity and never allocates after construction; Push fails when it is full, so callers need a fallback.
+ *
+ * Like TCircularQueue we're using the simpler sequentially consistent model for the indices, the implications of finer grained
+ * fences for all of our target platforms need further analysis.
+ *
+ * @param ItemType The type of items pointed to by the queue.
+ * @param CapacityLog2 The log2 of the number of items the queue can hold.
+ */
+template<typename ItemType, uint32 CapacityLog2 = 10>
+class TWorkStealingQueue
+{
+public:
+
+	enum
+	{
+		Capacity = 1 << CapacityLog2,
+		IndexMask = Capacity - 1
+	};
+
+	TWorkStealingQueue()
+		: Top(0)
+		, Bottom(0)
+	{
+		for (TAtomic<ItemType*>& Item : Items)
+		{
+			Item.Store(nullptr, EMemoryOrder::Relaxed);
+		}
+	}
+
+	/**
+	 * Adds an item to the bottom of the queue. Must only be called from the owning thread.
+	 *
+	 * @param Item The item to add.
+	 * @return true if the item was added, false if the queue is full.
+	 */
+	bool Push(ItemType* Item)
+	{
+		checkSlow(Item);
+		const int64 LocalBottom = Bottom.Load(EMemoryOrder::Relaxed);
+		const int64 LocalTop = Top.Load();
+		if (LocalBottom - LocalTop >= Capacity)
+		{
+			return false;
+		}
+		Items[LocalBottom & IndexMask].Store(Item, EMemoryOrder::Relaxed);
+		Bottom.Store(LocalBottom + 1);
+		return true;
+	}
+
+	/**
+	 * Removes the most recently pushed item from the bottom of the queue. Must only be called from the owning thread.
+	 *
+	 * @return The item, or nullptr if the queue is empty or the last item was stolen concurrently.
+	 */
+	ItemType* Pop()
+	{
+		const int64 LocalBottom = Bottom.Load(EMemoryOrder::Relaxed) - 1;
+		Bottom.Store(LocalBottom);
+		int64 LocalTop = Top.Load();
+		if (LocalTop > LocalBottom)
+		{
+			// empty, restore the canonical state
+			Bottom.Store(LocalBottom + 1);
+			return nullptr;
+		}
+
+		ItemType* Result = Items[LocalBottom & IndexMask].Load(EMemoryOrder::Relaxed);
+		if (LocalTop == LocalBottom)
+		{
+			// last item, race against thieves for it
+			if (!Top.CompareExchange(LocalTop, LocalTop + 1))
+			{
+				Result = nullptr;
+			}
+			Bottom.Store(LocalBottom + 1);
+		}
+		return Result;
+	}
+
+	/**
+	 * Removes the oldest item from the top of the queue. May be called from any thread.
+	 *
+	 * @param bOutLostRace Set to true if the queue was not empty but another thread won the item, in which case it is worth retrying.
+	 * @return The item, or nullptr if nothing was stolen.
+	 */
+	ItemType* Steal(bool& bOutLostRace)
+	{
+		bOutLostRace = false;
+		int64 LocalTop = Top.Load();
+		const int64 LocalBottom = Bottom.Load();
+		if (LocalTop >= LocalBottom)
+		{
+			return nullptr;
+		}
+
+		ItemType* Result = Items[LocalTop & IndexMask].Load(EMemoryOrder::Relaxed);
+		if (!Top.CompareExchange(LocalTop, LocalTop + 1))
+		{
+			bOutLostRace = true;
+			return nullptr;
+		}
+		return Result;
+	}
+
+	/**
+	 * Removes the oldest item from the top of the queue, retrying while other threads are contending for it.
+	 *
+	 * @return The item, or nullptr if the queue was observed empty.
+	 */
+	ItemType* Steal()
+	{
+		bool bLostRace;
+		do
+		{
+			if (ItemType* Result = Steal(bLostRace))
+			{
+				return Result;
+			}
+		} while (bLostRace);
+		return nullptr;
+	}
+
+	/**
+	 * Checks whether the queue is empty. This is only a guess when called from a thread other than the owner.
+	 *
+	 * @return true if the queue appears to be empty.
+	 */
+	bool IsEmpty() const
+	{
+		return Top.Load(EMemoryOrder::Relaxed) >= Bottom.Load(EMemoryOrder::Relaxed);
+	}
+
+	/**
+	 * Gets the number of items in the queue. This is only a guess when called from a thread other than the owner.
+	 *
+	 * @return Number of queued items.
+	 */
+	int32 Num() const
+	{
+		const int64 Count = Bottom.Load(EMemoryOrder::Relaxed) - Top.Load(EMemoryOrder::Relaxed);
+		return Count > 0 ? int32(Count) : 0;
+	}
+
+private:
+
+	/** Index of the oldest item, advanced by thieves. Padded onto its own cache line since it is written by other threads. */
+	TAtomic<int64> Top;
+	uint8 PadToAvoidContention1[PLATFORM_CACHE_LINE_SIZE - sizeof(TAtomic<int64>)];
+
+	/** Index one past the newest item, only written by the owner. */
+	TAtomic<int64> Bottom;
+	uint8 PadToAvoidContention2[PLATFORM_CACHE_LINE_SIZE - sizeof(TAtomic<int64>)];
+
+	/** Ring of queued items. */
+	TAtomic<ItemType*> Items[Capacity];
+};
@@ -961,7 +961,7 @@ protected:
 		{
 			Super::Clear();
 
-			for (const FDelegateBase& OtherDelegateRef : Other.GetInvocationList())
+			auto CopyDelegate = [this](const FDelegateBase& OtherDelegateRef)
 			{
 				if (IDelegateInstance* OtherInstance = Super::GetDelegateInstanceProtectedHelper(OtherDelegateRef))
 				{
@@ -969,6 +969,15 @@ protected:
 					((TDelegateInstanceInterface*)OtherInstance)->CreateCopy(TempDelegate);
 					Super::AddInternal(MoveTemp(TempDelegate));
 				}
+			};
+
+			for (const FDelegateBase& OtherDelegateRef : Other.GetInvocationList())
+			{
+				CopyDelegate(OtherDelegateRef);
+			}
+			for (const FDelegateBase& OtherDelegateRef : Other.GetPendingInvocationList())
+			{
+				CopyDelegate(OtherDelegateRef);
 			}
 		}
 
@@ -1018,7 +1027,8 @@ public:
 		}
 		Super::UnlockInvocationList();
 
-		if (NeedsCompaction)
+		// callees may have added delegates, which are only added to the invocation list once it's unlocked
+		if (NeedsCompaction || Super::GetPendingInvocationList().Num() > 0)
 		{
 			const_cast<TBaseMulticastDelegate*>(this)->CompactInvocationList();
 		}
@@ -1050,7 +1060,7 @@ protected:
 			}
 		}
 
-		return false;
+		return Super::RemovePendingInternal(Handle);
 	}
 };
 
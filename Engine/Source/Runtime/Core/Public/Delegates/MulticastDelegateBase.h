@@ -38,6 +38,7 @@ public:
 		{
 			DelegateBaseRef.Unbind();
 		}
+		PendingInvocationList.Empty();
 
 		CompactInvocationList(false);
 	}
@@ -56,6 +57,13 @@ public:
 				return true;
 			}
 		}
+		for (const FDelegateBase& DelegateBaseRef : PendingInvocationList)
+		{
+			if (DelegateBaseRef.GetDelegateInstanceProtected())
+			{
+				return true;
+			}
+		}
 		return false;
 	}
 
@@ -74,6 +82,14 @@ public:
 				return true;
 			}
 		}
+		for (const FDelegateBase& DelegateBaseRef : PendingInvocationList)
+		{
+			IDelegateInstance* DelegateInstance = DelegateBaseRef.GetDelegateInstanceProtected();
+			if ((DelegateInstance != nullptr) && DelegateInstance->HasSameObject(InUserObject))
+			{
+				return true;
+			}
+		}
 
 		return false;
 	}
@@ -106,6 +122,21 @@ public:
 			{
 				CompactionThreshold = 0;
 			}
+
+			// the pending delegates aren't being broadcast, so they can be removed right away
+			for (int32 PendingIndex = 0; PendingIndex < PendingInvocationList.Num();)
+			{
+				IDelegateInstance* DelegateInstance = PendingInvocationList[PendingIndex].GetDelegateInstanceProtected();
+				if ((DelegateInstance != nullptr) && DelegateInstance->HasSameObject(InUserObject))
+				{
+					PendingInvocationList.RemoveAtSwap(PendingIndex, 1, false);
+					++Result;
+				}
+				else
+				{
+					++PendingIndex;
+				}
+			}
 		}
 		else
 		{
@@ -153,13 +184,42 @@ protected:
 	 */
 	inline FDelegateHandle AddInternal(FDelegateBase&& NewDelegateBaseRef)
 	{
-		// compact but obey threshold of when this will trigger
-		CompactInvocationList(true);
 		FDelegateHandle Result = NewDelegateBaseRef.GetHandle();
-		InvocationList.Add(MoveTemp(NewDelegateBaseRef));
+		if (InvocationListLockCount > 0)
+		{
+			// growing the list while it's broadcast would move the instances its entries hold inline, including the one executing,
+			// so the delegate is added once the broadcast is done (which wouldn't have called it anyway)
+			PendingInvocationList.Add(MoveTemp(NewDelegateBaseRef));
+		}
+		else
+		{
+			// compact but obey threshold of when this will trigger
+			CompactInvocationList(true);
+			InvocationList.Add(MoveTemp(NewDelegateBaseRef));
+		}
 		return Result;
 	}
 
+	/**
+	 * Removes the delegate of the given handle if it was added while the invocation list was locked.
+	 *
+	 * @return true if the delegate was found and removed.
+	 */
+	bool RemovePendingInternal(FDelegateHandle Handle)
+	{
+		for (int32 PendingIndex = 0; PendingIndex < PendingInvocationList.Num(); ++PendingIndex)
+		{
+			IDelegateInstance* DelegateInstance = PendingInvocationList[PendingIndex].GetDelegateInstanceProtected();
+			if ((DelegateInstance != nullptr) && DelegateInstance->GetHandle() == Handle)
+			{
+				PendingInvocationList.RemoveAtSwap(PendingIndex, 1, false);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	/**
 	 * Removes any expired or deleted functions from the invocation list.
 	 *
@@ -173,6 +233,16 @@ protected:
 			return;
 		}
 
+		// add the delegates that were bound while the list was locked
+		if (PendingInvocationList.Num() > 0)
+		{
+			for (FDelegateBase& PendingDelegateBaseRef : PendingInvocationList)
+			{
+				InvocationList.Add(MoveTemp(PendingDelegateBaseRef));
+			}
+			PendingInvocationList.Empty();
+		}
+
 		// if checking threshold, obey but decay. This is to ensure that even infrequently called delegates will
 		// eventually compact during an Add()
 		if (CheckThreshold 	&& --CompactionThreshold > InvocationList.Num())
@@ -217,6 +287,16 @@ protected:
 		return InvocationList;
 	}
 
+	/**
+	 * Gets a read-only reference to the delegates added while the invocation list was locked, which are added to it once unlocked.
+	 *
+	 * @return The pending invocation list.
+	 */
+	inline const TArray<FDelegateBase>& GetPendingInvocationList( ) const
+	{
+		return PendingInvocationList;
+	}
+
 	/** Increments the lock counter for the invocation list. */
 	inline void LockInvocationList( ) const
 	{
@@ -243,6 +323,9 @@ private:
 	/** Holds the collection of delegate instances to invoke. */
 	TInvocationList InvocationList;
 
+	/** Holds the delegate instances added while the invocation list was locked, rarely used so not inline. */
+	TArray<FDelegateBase> PendingInvocationList;
+
 	/** Used to determine when a compaction should happen. */
 	int32 CompactionThreshold;
 
@@ -22,8 +22,11 @@ struct FFileCachePreloadEntry
  * Of course you can create several IFileCacheHandle's on separate threads if needed. And obviously Internally threading
  * will also be used to do async IO and cache management.
  * 
- * Also note, if you create several IFileCacheHandle's to the same file on separate threads these will be considered
- * as individual separate files from the cache point of view and thus each will have their own cache data allocated.
+ * Handles created from the same filename share their cache data (unless fc.ShareFileCacheHandles is 0), so lines
+ * requested through one of them while they are being read for another are not read again. This includes the preloaded
+ * regions, releasing a region through one handle releases it for all of them.
+ * Handles created from a IAsyncReadFileHandle are considered as individual separate files from the cache point of view
+ * and thus each will have their own cache data allocated.
  */
 class IFileCacheHandle
 {
@@ -63,6 +66,13 @@ public:
 
 	virtual void ReleasePreloadedData(const FFileCachePreloadEntry* PreloadEntries, int32 NumEntries, int64 InOffset) = 0;
 
+	/**
+	 * Start reading a byte range into the cache without waiting for it or keeping it resident.
+	 * Lines that are already cached or being read are skipped, the others are read with the given priority and become
+	 * regular cache lines once they land, so a later ReadData of the range is likely to find them.
+	 */
+	virtual void PrefetchData(int64 Offset, int64 BytesToRead, EAsyncIOPriorityAndFlags Priority) = 0;
+
 	/**
 	 * Wait until all outstanding read requests complete. 
 	 */
@@ -14,6 +14,7 @@
 #include "Misc/EnumClassFlags.h"
 
 class IAsyncReadFileHandle;
+class IAsyncWriteFileHandle;
 class IMappedFileHandle;
 
 /**
@@ -64,6 +65,16 @@ enum class EPlatformFileWrite : uint8
 
 ENUM_CLASS_FLAGS(EPlatformFileWrite);
 
+/**
+ * When an async write file handle makes sure its data reached the disk, and not only the OS
+ */
+enum class EAsyncWriteSyncPolicy : uint8
+{
+	Never,			// leave it to the OS
+	OnClose,		// once, when the handle is deleted
+	AfterEachWrite	// after each write the handle issues, which may cover several combined Write calls
+};
+
 /** 
  * File handle interface. 
 **/
@@ -355,6 +366,30 @@ public:
 	/** File and directory visitor function that takes all the stat data */
 	typedef TFunctionRef<bool(const TCHAR*, const FFileStatData&)> FDirectoryStatVisitorFunc;
 
+	/** Base class for visitors of IterateDirectoryStatRecursivelyParallel, which are handed the contents of a directory at a time. **/
+	class FDirectoryStatBatchVisitor
+	{
+	public:
+		virtual ~FDirectoryStatBatchVisitor() { }
+
+		/**
+		 * Callback for the files and directories of one directory. Called from task graph workers, but never for two batches at once.
+		 * @param FilenamesOrDirectories	The paths of the files and directories (with no trailing path delimiter).
+		 * @param StatData					The stat data of each, in the same order.
+		 * @return							true if the iteration should continue.
+		**/
+		virtual bool Visit(const TArray<FString>& FilenamesOrDirectories, const TArray<FFileStatData>& StatData) = 0;
+
+		/**
+		 * Whether to enumerate a directory that was handed to Visit. Called concurrently from task graph workers.
+		 * @param Directory					The directory, with no trailing path delimiter.
+		**/
+		virtual bool ShouldRecurse(const TCHAR* Directory) const
+		{
+			return true;
+		}
+	};
+
 	/** 
 	 * Call the Visit function of the visitor once for each file or directory in a single directory. This function does not explore subdirectories.
 	 * @param Directory		The directory to iterate the contents of.
@@ -384,6 +419,15 @@ public:
 	*/
 	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename);
 
+	/** Open a file for async writing. Writes are done in order on a background thread, and small consecutive writes are combined.
+	*
+	* @param Filename file to be opened
+	* @param bAppend if true, writes go to the end of the existing file
+	* @param SyncPolicy when to make sure the written data reached the disk
+	* @return Close the file by delete'ing the handle, which waits for the outstanding writes. Null if the file couldn't be opened.
+	*/
+	virtual IAsyncWriteFileHandle* OpenAsyncWrite(const TCHAR* Filename, bool bAppend = false, EAsyncWriteSyncPolicy SyncPolicy = EAsyncWriteSyncPolicy::Never);
+
 	/** Controls if the pak precacher should process precache requests.
 	* Requests below this threshold will not get precached. Without this throttle, quite a lot of memory
 	* can be consumed if the disk races ahead of the CPU.
@@ -458,6 +502,16 @@ public:
 	 * @return				false if the directory did not exist or if the visitor returned false.
 	**/
 	virtual bool IterateDirectoryStatRecursively(const TCHAR* Directory, FDirectoryStatVisitorFunc Visitor);
+
+	/**
+	 * Enumerates a directory tree on task graph workers, a level of the tree at a time, and hands the contents of each directory to the visitor.
+	 * The order of the batches is undefined.
+	 * @param Directory		The directory to iterate the contents of, recursively.
+	 * @param Visitor		Visitor to call for the elements of each directory, see FDirectoryStatBatchVisitor.
+	 * @param ChangedSince	If set, only files modified after it are handed to the visitor. Directories are always handed to it and explored.
+	 * @return				false if the directory did not exist or if the visitor returned false.
+	**/
+	virtual bool IterateDirectoryStatRecursivelyParallel(const TCHAR* Directory, FDirectoryStatBatchVisitor& Visitor, const FDateTime& ChangedSince = FDateTime::MinValue());
 		
 	/**
 	 * Finds all the files within the given directory, with optional file extension filter
@@ -14,6 +14,17 @@
 
 struct FPlatformMemoryStats;
 
+/**
+ * Opt-in NUMA aware allocation: the OS page caches of the binned allocators are kept per NUMA node, fresh pages are bound to the
+ * node of the allocating thread and task graph workers are spread over the nodes. Only has an effect on machines with several nodes.
+ */
+#ifndef UE_NUMA_AWARE_ALLOCATION
+	#define UE_NUMA_AWARE_ALLOCATION 0
+#endif
+
+/** Maximum number of NUMA nodes that are told apart, any further nodes are folded into the last one. */
+#define PLATFORM_MAX_NUMA_NODES 8
+
 /** Holds generic memory stats, internally implemented as a map. */
 struct FGenericMemoryStats;
 
@@ -135,6 +146,12 @@ struct CORE_API FGenericPlatformMemoryStats : public FPlatformMemoryConstants
 
 	/** The peak amount of virtual memory used by the process. */
 	uint64 PeakUsedVirtual;
+
+	/** The number of NUMA nodes, 1 on platforms or machines without NUMA. */
+	uint32 NumaNodeCount;
+
+	/** The amount of memory the binned allocators requested from the OS on each NUMA node, in bytes. Only tracked with UE_NUMA_AWARE_ALLOCATION. */
+	uint64 NumaNodeUsedPhysical[PLATFORM_MAX_NUMA_NODES];
 	
 	/** Default constructor, clears all variables. */
 	FGenericPlatformMemoryStats();
@@ -343,6 +360,54 @@ struct CORE_API FGenericPlatformMemory
 	 */
 	static void BinnedFreeToOS( void* Ptr, SIZE_T Size );
 
+	/**
+	 * @return the number of NUMA nodes, at most PLATFORM_MAX_NUMA_NODES.
+	 */
+	static int32 GetNumaNodeCount()
+	{
+		return 1;
+	}
+
+	/**
+	 * @return the NUMA node of the processor the calling thread is running on.
+	 */
+	static int32 GetCurrentNumaNode()
+	{
+		return 0;
+	}
+
+	/**
+	 * @return the mask of the processors that belong to the NUMA node, in the format used by FPlatformAffinity. 0 if unknown.
+	 */
+	static uint64 GetNumaNodeProcessorMask(int32 Node)
+	{
+		return 0;
+	}
+
+	/**
+	 * Sets the NUMA node that the pages of a range are taken from when they are first touched.
+	 *
+	 * @param Ptr Start of the range, aligned to the page size
+	 * @param Size Size of the range
+	 * @param Node The preferred node
+	 * @return true if the platform supports binding memory to a node
+	 */
+	static bool BindToNumaNode(void* Ptr, SIZE_T Size, int32 Node)
+	{
+		return false;
+	}
+
+	/**
+	 * @return the NUMA node a range was bound to with BindToNumaNode, 0 if it wasn't bound.
+	 */
+	static int32 GetNumaNodeForAddress(const void* Ptr)
+	{
+		return 0;
+	}
+
+	/** Tracks the memory the binned allocators hold from the OS per NUMA node, reported in FGenericPlatformMemoryStats. */
+	static void UpdateNumaNodeUsage(int32 Node, int64 Delta);
+
 	class FBasicVirtualMemoryBlock
 	{
 	protected:
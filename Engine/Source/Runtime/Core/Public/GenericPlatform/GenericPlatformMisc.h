@@ -297,6 +297,47 @@ struct CORE_API FSHA256Signature
 	FString ToString() const;
 };
 
+/**
+ * The physical cores of the CPU and the L3 caches they share, for placing threads. Masks use the bits of thread
+ * affinity masks, so only the first 64 logical processors are described.
+ */
+struct CORE_API FCPUTopology
+{
+	enum { MaxCores = 64 };
+
+	/** Physical cores, ordered by the lowest logical processor of each */
+	int32 NumCores = 0;
+	/** The logical processors of each core, more than one bit with SMT */
+	uint64 CoreMasks[MaxCores];
+	/** Index into CacheDomainMasks of the L3 each core uses */
+	int32 CoreCacheDomains[MaxCores];
+	/** Relative performance of each core, higher is faster. The same for every core unless the CPU is hybrid. */
+	int32 CorePerformanceClasses[MaxCores];
+
+	/** Groups of cores sharing an L3 (a CCX on some CPUs), a single one if the platform does not say */
+	int32 NumCacheDomains = 0;
+	uint64 CacheDomainMasks[MaxCores];
+
+	/** @return true if the cores do not all perform the same, big.LITTLE or performance + efficiency cores */
+	bool IsHybrid() const
+	{
+		for (int32 Index = 1; Index < NumCores; ++Index)
+		{
+			if (CorePerformanceClasses[Index] != CorePerformanceClasses[0])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * For the platforms filling this in: orders the cores, puts cores no L3 was reported for in the first cache
+	 * domain, or in a new one if none was reported at all, and sets CoreCacheDomains.
+	 */
+	void Finalize();
+};
+
 enum class EMobileHapticsType : uint8
 {
 	// these are IOS UIFeedbackGenerator types
@@ -859,6 +900,12 @@ public:
 	 */
 	static int32 NumberOfCoresIncludingHyperthreads();
 
+	/**
+	 * Returns the cores and shared caches of the CPU, computed once. Platforms that can not tell report every
+	 * logical processor as its own core and one cache domain.
+	 */
+	static const FCPUTopology& GetCPUTopology();
+
 	/**
 	 * Return the number of worker threads we should spawn, based on number of cores
 	 */
@@ -183,6 +183,16 @@ struct CORE_API FGenericPlatformStackWalk
 	 */
 	static uint32 CaptureStackBackTrace( uint64* BackTrace, uint32 MaxDepth, void* Context = nullptr );
 
+	/**
+	 * Capture a stack backtrace of the calling thread as fast as the platform allows, for profilers that take one
+	 * for every sample. This gives the same frames as CaptureStackBackTrace, from frame pointers where the platform
+	 * has a walker for them, so it can stop short in code built without them.
+	 *
+	 * @param	BackTrace			[out] Pointer to array to take backtrace
+	 * @param	MaxDepth			Entries in BackTrace array
+	 */
+	static uint32 CaptureStackBackTraceFast( uint64* BackTrace, uint32 MaxDepth );
+
 	/**
 	 * Capture a stack backtrace for a specific thread.
 	 *
@@ -159,6 +159,14 @@ struct CORE_API FGenericPlatformTime
 		return GetSecondsPerCycle64() * double(Cycles);
 	}
 
+	/**
+	 * @return Whether Cycles64 reads the timestamp counter of the CPU directly.
+	 */
+	static bool IsUsingTimestampCounter()
+	{
+		return false;
+	}
+
 protected:
 
 	static double SecondsPerCycle;
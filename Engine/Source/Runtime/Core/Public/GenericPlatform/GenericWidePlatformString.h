@@ -116,41 +116,8 @@ public:
 	}
 #endif
 
-	CORE_API static const WIDECHAR* Strstr( const WIDECHAR* String, const WIDECHAR* Find)
-	{
-		WIDECHAR Char1, Char2;
-		if ((Char1 = *Find++) != 0)
-		{
-			size_t Length = Strlen(Find);
-			
-			do
-			{
-				do
-				{
-					if ((Char2 = *String++) == 0)
-					{
-						return nullptr;
-					}
-				}
-				while (Char1 != Char2);
-			}
-			while (Strncmp(String, Find, Length) != 0);
-			
-			String--;
-		}
-		
-		return String;
-	}
-
-	CORE_API static const WIDECHAR* Strchr( const WIDECHAR* String, WIDECHAR C)
-	{
-		while (*String != C && *String != 0)
-		{
-			String++;
-		}
-		
-		return (*String == C) ? String : nullptr;
-	}
+	CORE_API static const WIDECHAR* Strstr( const WIDECHAR* String, const WIDECHAR* Find);
+	CORE_API static const WIDECHAR* Strchr( const WIDECHAR* String, WIDECHAR C);
 
 	CORE_API static const WIDECHAR* Strrchr( const WIDECHAR* String, WIDECHAR C)
 	{
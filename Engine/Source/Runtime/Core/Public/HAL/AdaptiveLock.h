@@ -0,0 +1,300 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/PlatformAtomics.h"
+#include "Misc/ScopeRWLock.h"
+
+/** Counts how often adaptive locks were contended, spun and parked. Only the slow paths count, the uncontended ones stay a single atomic. */
+#ifndef ADAPTIVE_LOCK_STATS
+	#define ADAPTIVE_LOCK_STATS !UE_BUILD_SHIPPING
+#endif
+
+/** Totals over all adaptive locks since startup, all zero with ADAPTIVE_LOCK_STATS off */
+struct CORE_API FAdaptiveLockStats
+{
+	/** Acquires that did not get the lock right away */
+	int64 NumContendedAcquires = 0;
+	/** Contended acquires that got the lock while spinning */
+	int64 NumSpinAcquires = 0;
+	/** Times a thread parked waiting for a lock */
+	int64 NumParks = 0;
+
+	static FAdaptiveLockStats Get();
+};
+
+/**
+ * A one byte, non-recursive mutex. An uncontended lock and unlock are one atomic each. A contended lock spins for
+ * a while with backoff, then parks the thread through FAddressWait. Can replace FCriticalSection where the lock is
+ * not held recursively, FAdaptiveScopeLock replaces FScopeLock.
+ */
+class FAdaptiveMutex
+{
+public:
+
+	FAdaptiveMutex()
+		: State(Unlocked)
+	{
+	}
+
+	FORCEINLINE bool TryLock()
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(&State, Locked, Unlocked) == Unlocked;
+	}
+
+	FORCEINLINE void Lock()
+	{
+		if (!TryLock())
+		{
+			LockSlow();
+		}
+	}
+
+	FORCEINLINE void Unlock()
+	{
+		if (FPlatformAtomics::InterlockedExchange(&State, Unlocked) == LockedWithWaiters)
+		{
+			UnlockSlow();
+		}
+	}
+
+	/** Only a snapshot unless the calling thread holds the lock */
+	bool IsLocked() const
+	{
+		return FPlatformAtomics::AtomicRead(&State) != Unlocked;
+	}
+
+private:
+
+	enum : int8
+	{
+		Unlocked = 0,
+		Locked = 1,
+		/** Threads may be parked, unlocking has to wake one */
+		LockedWithWaiters = 2,
+	};
+
+	CORE_API void LockSlow();
+	CORE_API void UnlockSlow();
+
+	volatile int8 State;
+
+	UE_NONCOPYABLE(FAdaptiveMutex);
+};
+
+/**
+ * A four byte, non-recursive reader-writer lock that prefers writers: once a writer waits, new readers wait
+ * too. Uncontended locks and unlocks are one atomic each, contended ones spin with backoff, then park through
+ * FAddressWait. Can replace FRWLock, FAdaptiveReadScopeLock, FAdaptiveWriteScopeLock and FAdaptiveRWScopeLock
+ * replace the FRWLock scopes.
+ */
+class FAdaptiveRWLock
+{
+public:
+
+	FAdaptiveRWLock()
+		: State(0)
+	{
+	}
+
+	FORCEINLINE bool TryReadLock()
+	{
+		const int32 Current = FPlatformAtomics::AtomicRead(&State);
+		return !(Current & (WriterBit | WriterWaitingBit)) && FPlatformAtomics::InterlockedCompareExchange(&State, Current + ReaderUnit, Current) == Current;
+	}
+
+	FORCEINLINE void ReadLock()
+	{
+		if (!TryReadLock())
+		{
+			ReadLockSlow();
+		}
+	}
+
+	FORCEINLINE void ReadUnlock()
+	{
+		const int32 Previous = FPlatformAtomics::InterlockedAdd(&State, -ReaderUnit);
+		checkSlow(Previous & ReaderMask);
+		if ((Previous & ReaderMask) == ReaderUnit && (Previous & WaitingBits))
+		{
+			ReadUnlockSlow();
+		}
+	}
+
+	FORCEINLINE bool TryWriteLock()
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(&State, WriterBit, 0) == 0;
+	}
+
+	FORCEINLINE void WriteLock()
+	{
+		if (!TryWriteLock())
+		{
+			WriteLockSlow();
+		}
+	}
+
+	FORCEINLINE void WriteUnlock()
+	{
+		const int32 Previous = FPlatformAtomics::InterlockedExchange(&State, 0);
+		checkSlow(Previous & WriterBit);
+		if (Previous & WaitingBits)
+		{
+			WriteUnlockSlow();
+		}
+	}
+
+private:
+
+	enum : int32
+	{
+		WriterBit = 1 << 0,
+		/** A writer may be parked, new readers wait and the last reader out wakes everyone */
+		WriterWaitingBit = 1 << 1,
+		/** A reader may be parked, the writer wakes everyone when it is done */
+		ReaderWaitingBit = 1 << 2,
+		WaitingBits = WriterWaitingBit | ReaderWaitingBit,
+		ReaderUnit = 1 << 3,
+		ReaderMask = ~(ReaderUnit - 1),
+	};
+
+	CORE_API void ReadLockSlow();
+	CORE_API void ReadUnlockSlow();
+	CORE_API void WriteLockSlow();
+	CORE_API void WriteUnlockSlow();
+
+	volatile int32 State;
+
+	UE_NONCOPYABLE(FAdaptiveRWLock);
+};
+
+/** FScopeLock for a FAdaptiveMutex */
+class FAdaptiveScopeLock
+{
+public:
+
+	explicit FAdaptiveScopeLock(FAdaptiveMutex* InMutex)
+		: Mutex(InMutex)
+	{
+		check(Mutex);
+		Mutex->Lock();
+	}
+
+	~FAdaptiveScopeLock()
+	{
+		Unlock();
+	}
+
+	void Unlock()
+	{
+		if (Mutex)
+		{
+			Mutex->Unlock();
+			Mutex = nullptr;
+		}
+	}
+
+private:
+
+	FAdaptiveMutex* Mutex;
+
+	UE_NONCOPYABLE(FAdaptiveScopeLock);
+};
+
+/** Keeps a FAdaptiveRWLock read-locked while this scope lives */
+class FAdaptiveReadScopeLock
+{
+public:
+
+	explicit FAdaptiveReadScopeLock(FAdaptiveRWLock& InLock)
+		: Lock(InLock)
+	{
+		Lock.ReadLock();
+	}
+
+	~FAdaptiveReadScopeLock()
+	{
+		Lock.ReadUnlock();
+	}
+
+private:
+
+	FAdaptiveRWLock& Lock;
+
+	UE_NONCOPYABLE(FAdaptiveReadScopeLock);
+};
+
+/** Keeps a FAdaptiveRWLock write-locked while this scope lives */
+class FAdaptiveWriteScopeLock
+{
+public:
+
+	explicit FAdaptiveWriteScopeLock(FAdaptiveRWLock& InLock)
+		: Lock(InLock)
+	{
+		Lock.WriteLock();
+	}
+
+	~FAdaptiveWriteScopeLock()
+	{
+		Lock.WriteUnlock();
+	}
+
+private:
+
+	FAdaptiveRWLock& Lock;
+
+	UE_NONCOPYABLE(FAdaptiveWriteScopeLock);
+};
+
+/** FRWScopeLock for a FAdaptiveRWLock */
+class FAdaptiveRWScopeLock
+{
+public:
+
+	explicit FAdaptiveRWScopeLock(FAdaptiveRWLock& InLock, FRWScopeLockType InLockType)
+		: Lock(InLock)
+		, LockType(InLockType)
+	{
+		if (LockType != SLT_ReadOnly)
+		{
+			Lock.WriteLock();
+		}
+		else
+		{
+			Lock.ReadLock();
+		}
+	}
+
+	/** Not atomic, like FRWScopeLock the read lock is released before the write lock is taken */
+	void ReleaseReadOnlyLockAndAcquireWriteLock_USE_WITH_CAUTION()
+	{
+		if (LockType == SLT_ReadOnly)
+		{
+			Lock.ReadUnlock();
+			Lock.WriteLock();
+			LockType = SLT_Write;
+		}
+	}
+
+	~FAdaptiveRWScopeLock()
+	{
+		if (LockType == SLT_ReadOnly)
+		{
+			Lock.ReadUnlock();
+		}
+		else
+		{
+			Lock.WriteUnlock();
+		}
+	}
+
+private:
+
+	FAdaptiveRWLock& Lock;
+	FRWScopeLockType LockType;
+
+	UE_NONCOPYABLE(FAdaptiveRWScopeLock);
+};
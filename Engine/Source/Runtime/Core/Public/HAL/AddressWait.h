@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+/**
+ * Blocks threads on a memory location until another thread changes it and wakes them, which is what compact
+ * locks park with. Uses futexes on Linux and Android and WaitOnAddress on Windows 8 and later. Everywhere else,
+ * and for the cases the OS primitive does not cover, threads park on pooled events in a table of wait lists
+ * keyed by the address.
+ *
+ * The usual pattern is to publish the intent to wait in the value, Wait while it is still there, and have
+ * whoever changes the value call WakeOne or WakeAll after the change.
+ */
+struct CORE_API FAddressWait
+{
+	/**
+	 * Blocks while the Size bytes at Address equal the ones at CompareAddress. May return spuriously, callers
+	 * check their condition again once this returns.
+	 * @param Address; the value to wait on, aligned to Size
+	 * @param CompareAddress; the value Address has to hold for the thread to block
+	 * @param Size; 1, 2 or 4
+	 */
+	static void Wait(const volatile void* Address, const void* CompareAddress, int32 Size);
+
+	/**
+	 * Wakes at least one thread waiting on Address, if any. For values smaller than 4 bytes this can wake all
+	 * of them, futexes only wait on whole words.
+	 */
+	static void WakeOne(const volatile void* Address);
+
+	/** Wakes all threads waiting on Address */
+	static void WakeAll(const volatile void* Address);
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "HAL/PlatformMath.h"
+#include "HAL/PlatformMemory.h"
 
 struct FCachedOSPageAllocator
 {
@@ -57,3 +59,78 @@ private:
 	SIZE_T         CachedTotal;
 	uint32         FreedPageBlocksNum;
 };
+
+/**
+ * One TCachedOSPageAllocator per NUMA node. Allocations are served from the cache of the calling thread's node and fresh pages are
+ * bound to it, frees go back to the cache of the node the pages were bound to. Each node caches up to CachedByteLimit.
+ */
+template <uint32 NumCacheBlocks, uint32 CachedByteLimit>
+struct TNumaCachedOSPageAllocator
+{
+	TNumaCachedOSPageAllocator()
+		: NumaNodeCount(FPlatformMath::Min<int32>(FPlatformMemory::GetNumaNodeCount(), PLATFORM_MAX_NUMA_NODES))
+	{
+	}
+
+	FORCEINLINE void* Allocate(SIZE_T Size)
+	{
+		if (NumaNodeCount <= 1)
+		{
+			return Caches[0].Allocate(Size);
+		}
+		const int32 Node = FPlatformMath::Min(FPlatformMemory::GetCurrentNumaNode(), NumaNodeCount - 1);
+		const uint64 CachedBefore = Caches[Node].GetCachedFreeTotal();
+		void* Ptr = Caches[Node].Allocate(Size);
+		if (Ptr && Caches[Node].GetCachedFreeTotal() == CachedBefore)
+		{
+			// not served from the cache, so these pages haven't been touched yet
+			FPlatformMemory::BindToNumaNode(Ptr, Size, Node);
+		}
+		if (Ptr)
+		{
+			FPlatformMemory::UpdateNumaNodeUsage(Node, int64(Size));
+		}
+		return Ptr;
+	}
+
+	void Free(void* Ptr, SIZE_T Size)
+	{
+		if (NumaNodeCount <= 1)
+		{
+			return Caches[0].Free(Ptr, Size);
+		}
+		const int32 Node = FPlatformMath::Min(FPlatformMemory::GetNumaNodeForAddress(Ptr), NumaNodeCount - 1);
+		FPlatformMemory::UpdateNumaNodeUsage(Node, -int64(Size));
+		return Caches[Node].Free(Ptr, Size);
+	}
+
+	void FreeAll()
+	{
+		for (int32 Node = 0; Node < NumaNodeCount; ++Node)
+		{
+			Caches[Node].FreeAll();
+		}
+	}
+
+	uint64 GetCachedFreeTotal()
+	{
+		uint64 Result = 0;
+		for (int32 Node = 0; Node < NumaNodeCount; ++Node)
+		{
+			Result += Caches[Node].GetCachedFreeTotal();
+		}
+		return Result;
+	}
+
+private:
+	TCachedOSPageAllocator<NumCacheBlocks, CachedByteLimit> Caches[PLATFORM_MAX_NUMA_NODES];
+	int32 NumaNodeCount;
+};
+
+#if UE_NUMA_AWARE_ALLOCATION
+	template <uint32 NumCacheBlocks, uint32 CachedByteLimit>
+	using TBinnedCachedOSPageAllocator = TNumaCachedOSPageAllocator<NumCacheBlocks, CachedByteLimit>;
+#else
+	template <uint32 NumCacheBlocks, uint32 CachedByteLimit>
+	using TBinnedCachedOSPageAllocator = TCachedOSPageAllocator<NumCacheBlocks, CachedByteLimit>;
+#endif
@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/EnumClassFlags.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/PlatformAtomics.h"
+
+/** Instruction set extensions that code can pick an implementation for at runtime */
+enum class ECPUFeatures : uint32
+{
+	None		= 0,
+
+	// x86
+	SSE3		= 1 << 0,
+	SSSE3		= 1 << 1,
+	SSE41		= 1 << 2,
+	SSE42		= 1 << 3,
+	POPCNT		= 1 << 4,
+	AES			= 1 << 5,
+	SHA			= 1 << 6,
+	AVX			= 1 << 7,
+	AVX2		= 1 << 8,
+	FMA3		= 1 << 9,
+	F16C		= 1 << 10,
+	BMI1		= 1 << 11,
+	BMI2		= 1 << 12,
+	AVX512F		= 1 << 13,
+
+	// ARM
+	NEON		= 1 << 16,
+	ARMCRC32	= 1 << 17,
+	ARMCrypto	= 1 << 18,
+};
+ENUM_CLASS_FLAGS(ECPUFeatures);
+
+/**
+ * Runtime detection of the instruction sets of the processor the program runs on, so that a single binary can use the
+ * extensions that the platform defines (PLATFORM_ALWAYS_HAS_*) cannot assume.
+ *
+ * On x86 the features come from cpuid on first use, the AVX ones also require the OS to save the registers (xgetbv).
+ * ARM features come from the compile target, which is how they are shipped on the platforms we support.
+ */
+struct CORE_API FCPUFeatures
+{
+	/** Features of this processor, detected once */
+	static ECPUFeatures Get();
+
+	/** @return true if this processor has all of Features */
+	static FORCEINLINE bool Has(ECPUFeatures Features)
+	{
+		return EnumHasAllFlags(Get(), Features);
+	}
+
+	/** Writes the detected features to the log */
+	static void LogFeatures();
+};
+
+/**
+ * Compiles one function for an instruction set the translation unit is not compiled for, on the compilers that need it.
+ * MSVC always allows the intrinsics. The function must only be called once FCPUFeatures says the processor has them.
+ *
+ *	UE_CPU_TARGET("avx2,fma") static void SumAVX2(...)
+ */
+#if defined(__clang__) || defined(__GNUC__)
+	#define UE_CPU_TARGET(Features) __attribute__((target(Features)))
+#else
+	#define UE_CPU_TARGET(Features)
+#endif
+
+template <typename FunctionType>
+class TMultiVersionFunction;
+
+/**
+ * A function with several implementations for different instruction sets, resolved to the best one the processor supports
+ * on the first call and called through a pointer afterwards.
+ *
+ * Implementations are tried in registration order, so register the most demanding first. Register them during static
+ * initialization or before the first call, the choice is not revisited.
+ *
+ *	static TMultiVersionFunction<uint32(const uint8*, int32)> Checksum(&ChecksumGeneric);
+ *	static bool bRegistered = (Checksum.Register(ECPUFeatures::AVX2, &ChecksumAVX2), Checksum.Register(ECPUFeatures::SSE42, &ChecksumSSE42), true);
+ *	...
+ *	Checksum(Data, Size);
+ */
+template <typename ReturnType, typename... ArgTypes>
+class TMultiVersionFunction<ReturnType(ArgTypes...)>
+{
+public:
+	typedef ReturnType (*FunctionPointer)(ArgTypes...);
+
+	/** Creates the function with the implementation that runs everywhere */
+	explicit constexpr TMultiVersionFunction(FunctionPointer InFallback)
+		: Fallback(InFallback)
+		, Resolved(nullptr)
+		, NumVersions(0)
+	{
+	}
+
+	/** Adds an implementation for processors that have all of RequiredFeatures */
+	TMultiVersionFunction& Register(ECPUFeatures RequiredFeatures, FunctionPointer Function)
+	{
+		checkf(Resolved == nullptr, TEXT("Implementations must be registered before the first call"));
+		check(NumVersions < MaxVersions);
+		Versions[NumVersions++] = { RequiredFeatures, Function };
+		return *this;
+	}
+
+	/** @return The implementation that calls go to on this processor */
+	FunctionPointer Get() const
+	{
+		// Racing threads resolve to the same pointer, so an aligned pointer read and an atomic store are enough
+		FunctionPointer Function = *(FunctionPointer volatile*)&Resolved;
+		if (!Function)
+		{
+			Function = Fallback;
+			const ECPUFeatures Features = FCPUFeatures::Get();
+			for (int32 Index = 0; Index < NumVersions; ++Index)
+			{
+				if (EnumHasAllFlags(Features, Versions[Index].RequiredFeatures))
+				{
+					Function = Versions[Index].Function;
+					break;
+				}
+			}
+			FPlatformAtomics::InterlockedExchangePtr((void**)&Resolved, (void*)Function);
+		}
+		return Function;
+	}
+
+	FORCEINLINE ReturnType operator()(ArgTypes... Args) const
+	{
+		return Get()(Args...);
+	}
+
+private:
+	static constexpr int32 MaxVersions = 8;
+
+	struct FVersion
+	{
+		ECPUFeatures RequiredFeatures;
+		FunctionPointer Function;
+	};
+
+	FunctionPointer Fallback;
+	mutable FunctionPointer Resolved;
+	FVersion Versions[MaxVersions] = {};
+	int32 NumVersions;
+};
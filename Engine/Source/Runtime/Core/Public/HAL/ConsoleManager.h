@@ -17,12 +17,16 @@ public:
 		, ThreadPropagationCallback(0)
 		, ThreadPropagationThreadId(0)
 		, bCallAllConsoleVariableSinks(true)
+		, LookupTable(nullptr)
+		, NumStaleLookups(0)
 	{
 	}
 
 	/** destructor */
 	~FConsoleManager()
 	{
+		InvalidateLookupTable();
+
 		for(TMap<FString, IConsoleObject*>::TConstIterator PairIt(ConsoleObjects); PairIt; ++PairIt)
 		{
 			IConsoleObject* Var = PairIt.Value();
@@ -104,6 +108,19 @@ private: // ----------------------------------------------------
 	**/
 	mutable FCriticalSection ConsoleObjectsSynchronizationObject;
 
+	/** Immutable open addressing copy of ConsoleObjects, defined in ConsoleManager.cpp */
+	struct FLookupTable;
+
+	/**
+	 * Published copy of ConsoleObjects that finds read without taking ConsoleObjectsSynchronizationObject, or null while
+	 * ConsoleObjects has changed since it was built. Replaced tables are deleted through FSharedSnapshotEpochs once the
+	 * finds that may still be reading them are done.
+	 */
+	mutable FLookupTable* volatile LookupTable;
+
+	/** Finds that went through the locked path since ConsoleObjects last changed, the table is built once there are enough */
+	mutable int32 NumStaleLookups;
+
 	/** 
 	 * @param Name must not be 0, must not be empty
 	 * @param Obj must not be 0
@@ -126,6 +143,9 @@ private: // ----------------------------------------------------
 	 */
 	static FString GetTextSection(const TCHAR* &It);
 
+	/** Unpublishes the lookup table after a change to ConsoleObjects, ConsoleObjectsSynchronizationObject must be held */
+	void InvalidateLookupTable();
+
 	/** same as FindConsoleObject() but ECVF_CreatedFromIni are not filtered out (for internal use) */
 	IConsoleObject* FindConsoleObjectUnfiltered(const TCHAR* Name) const;
 
@@ -19,7 +19,8 @@ enum EFileWrite
 	FILEWRITE_EvenIfReadOnly    = 0x04,
 	FILEWRITE_Append			= 0x08,
 	FILEWRITE_AllowRead			= 0x10,
-	FILEWRITE_Silent			= 0x20
+	FILEWRITE_Silent			= 0x20,
+	FILEWRITE_BackgroundFlush	= 0x40, // Write full buffers on a background thread while serialization continues, closing waits for the data to be durable
 };
 
 
@@ -29,6 +30,7 @@ enum EFileRead
 	FILEREAD_NoFail             = 0x01,
 	FILEREAD_Silent				= 0x02,
 	FILEREAD_AllowWrite			= 0x04,
+	FILEREAD_Readahead			= 0x08, // Read ahead of the archive position on a background thread, for large sequential loads
 };
 
 
@@ -224,7 +224,7 @@ private:
 class CORE_API FArchiveFileReaderGeneric : public FArchive
 {
 public:
-	FArchiveFileReaderGeneric( IFileHandle* InHandle, const TCHAR* InFilename, int64 InSize, uint32 InBufferSize = PLATFORM_FILE_READER_BUFFER_SIZE );
+	FArchiveFileReaderGeneric( IFileHandle* InHandle, const TCHAR* InFilename, int64 InSize, uint32 InBufferSize = PLATFORM_FILE_READER_BUFFER_SIZE, uint32 InFlags = FILEREAD_None );
 	~FArchiveFileReaderGeneric();
 
 	virtual void Seek( int64 InPos ) final;
@@ -269,6 +269,23 @@ protected:
 	TUniquePtr<IFileHandle> Handle;
 	TArray64<uint8> BufferArray;
 	int64 BufferSize;
+
+private:
+	/**
+	 * With FILEREAD_Readahead, the bytes following the buffer are read on a background thread while the buffer is consumed.
+	 * The handle is then only used by those reads, so ReadLowLevel must be safe to call from another thread.
+	 */
+	struct FReadahead;
+	TUniquePtr<FReadahead> Readahead;
+
+	/** Keeps reads of the bytes following the buffer in flight, each one starting where the handle will be once the previous one is done */
+	void IssueReadaheads();
+	/** Makes the oldest read ahead the buffer, returns false if it failed */
+	bool ConsumeReadahead();
+	/** Moves the buffer to the read ahead holding the given position, if there is one */
+	bool SeekWithinReadaheads( int64 InPos );
+	/** Waits for the reads in flight and discards them */
+	void CancelReadaheads();
 };
 
 
@@ -345,4 +362,19 @@ protected:
 	TArray64<uint8> BufferArray;
 	int64 BufferSize;
 	bool bLoggingError;
+
+private:
+	/**
+	 * With FILEWRITE_BackgroundFlush, full buffers are handed to background writes and serialization carries on in the next buffer
+	 * of a ring, blocking only when all of them are being written. WriteLowLevel must then be safe to call from another thread.
+	 */
+	struct FBackgroundWrites;
+	TUniquePtr<FBackgroundWrites> BackgroundWrites;
+
+	/** Hands the buffer to a background write, waiting for the oldest one if the ring is full */
+	bool FlushBufferInBackground();
+	/** Waits for the oldest background write, returns false if it failed */
+	bool RetireBackgroundWrite();
+	/** Waits for all background writes, returns false if any of them failed */
+	bool WaitForBackgroundWrites();
 };
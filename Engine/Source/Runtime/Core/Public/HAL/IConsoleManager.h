@@ -21,6 +21,7 @@
 #endif
 
 template <class T> class TConsoleVariableData;
+template <class T> class TConsoleVariableSnapshot;
 
 /**
  * Console variable usage guide:
@@ -1239,6 +1240,68 @@ public:
 #endif // NO_CVARS
 
 
+/**
+ * Copy of the game and render thread values of a bool, int32 or float console variable that any thread can read without
+ * virtual calls or checking which thread it is on, for task code that reads many console variables.
+ *
+ * Get one with GetSnapshot() on the game thread, it stays valid as long as the console variable. The game thread value
+ * is updated right after the variable changed, the render thread value in order with the render commands like the
+ * value GetValueOnRenderThread() returns. The snapshot has a cache line to itself so reading it never contends with
+ * writes to other data. Compare FConsoleVariableSnapshotEpoch with the epoch a cached value was read at to skip reading
+ * the snapshots again.
+ */
+template <class T>
+class alignas(PLATFORM_CACHE_LINE_SIZE) TConsoleVariableSnapshot
+{
+public:
+	TConsoleVariableSnapshot(const T& InGameThreadValue, const T& InRenderThreadValue)
+		: GameThreadValue(InGameThreadValue)
+		, RenderThreadValue(InRenderThreadValue)
+	{
+	}
+
+	FORCEINLINE T GetGameThreadValue() const
+	{
+		return *(const volatile T*)&GameThreadValue;
+	}
+
+	FORCEINLINE T GetRenderThreadValue() const
+	{
+		return *(const volatile T*)&RenderThreadValue;
+	}
+
+private:
+	T GameThreadValue;
+	T RenderThreadValue;
+
+	template<class T2> friend class FConsoleVariable;
+};
+
+/**
+ * Epochs of console variable changes, each is incremented after the matching value of a TConsoleVariableSnapshot changed.
+ * Code that derives state from many console variables can store the epoch and only read the snapshots again when it moved.
+ */
+struct CORE_API FConsoleVariableSnapshotEpoch
+{
+	static FORCEINLINE uint32 GetGameThreadEpoch()
+	{
+		return (uint32)FPlatformAtomics::AtomicRead(&GameThreadEpoch);
+	}
+
+	static FORCEINLINE uint32 GetRenderThreadEpoch()
+	{
+		return (uint32)FPlatformAtomics::AtomicRead(&RenderThreadEpoch);
+	}
+
+private:
+	static int32 GameThreadEpoch;
+	static int32 RenderThreadEpoch;
+	/** Render thread epoch the last queued change will publish, only touched on the game thread */
+	static int32 QueuedRenderThreadEpoch;
+
+	template<class T2> friend class FConsoleVariable;
+};
+
 // currently only supports main and render thread
 // optimized for read access speed (no virtual function call and no thread handling if using the right functions)
 // T: int32, float
@@ -1248,6 +1311,7 @@ class TConsoleVariableData
 public:
 	// constructor
 	TConsoleVariableData(const T DefaultValue)
+		: Snapshot(nullptr)
 	{
 		for(uint32 i = 0; i < UE_ARRAY_COUNT(ShadowedValue); ++i)
 		{
@@ -1255,6 +1319,30 @@ public:
 		}
 	}
 
+	~TConsoleVariableData()
+	{
+		if (Snapshot)
+		{
+			Snapshot->~TConsoleVariableSnapshot<T>();
+			FMemory::Free(Snapshot);
+		}
+	}
+
+	TConsoleVariableData(const TConsoleVariableData&) = delete;
+	TConsoleVariableData& operator=(const TConsoleVariableData&) = delete;
+
+	/** Returns the snapshot of this variable for reading it from any thread, creates it on first use. Call on the game thread. */
+	const TConsoleVariableSnapshot<T>& GetSnapshot()
+	{
+		static_assert(TIsArithmetic<T>::Value, "Console variable snapshots only support bool, int32 and float.");
+		check(IsInGameThread());
+		if (!Snapshot)
+		{
+			Snapshot = new(FMemory::Malloc(sizeof(TConsoleVariableSnapshot<T>), alignof(TConsoleVariableSnapshot<T>))) TConsoleVariableSnapshot<T>(ShadowedValue[0], ShadowedValue[1]);
+		}
+		return *Snapshot;
+	}
+
 	// faster than GetValueOnAnyThread()
 	T GetValueOnGameThread() const
 	{
@@ -1284,6 +1372,9 @@ private: // ----------------------------------------------------
 	// [0]:main thread, [1]: render thread, having them both in the same cache line should only hurt on write which happens rarely for cvars
 	T ShadowedValue[2];
 
+	// created by GetSnapshot(), updated by FConsoleVariable
+	TConsoleVariableSnapshot<T>* Snapshot;
+
 	// @return 0:main thread, 1: render thread, later more
 	static uint32 GetShadowIndex(bool bForceGameThread = false)
 	{	
@@ -1335,6 +1426,12 @@ public:
 	{
 		return Ref->GetValueOnAnyThread(bForceGameThread);
 	}
+
+	/** @see TConsoleVariableSnapshot, call on the game thread */
+	const TConsoleVariableSnapshot<T>& GetSnapshot()
+	{
+		return Ref->GetSnapshot();
+	}
 	
 	/** Dereference back to a variable**/
 	FORCEINLINE IConsoleVariable& operator*()
@@ -1409,6 +1506,11 @@ public:
 	{
 		return Value.GetValueOnAnyThread(bForceGameThread);
 	}
+
+	const TConsoleVariableSnapshot<T>& GetSnapshot()
+	{
+		return Value.GetSnapshot();
+	}
 	
 	IConsoleVariable& operator*()
 	{
@@ -15,13 +15,20 @@
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/IPlatformFileLogWrapper.h"
 #include "Templates/UniquePtr.h"
+#include "Async/AsyncFileHandle.h"
 
-class IAsyncReadFileHandle;
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached File Readahead Hits"), STAT_CachedFileReadaheadHits, STATGROUP_AsyncIO, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached File Readahead Waits"), STAT_CachedFileReadaheadWaits, STATGROUP_AsyncIO, CORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached File Readahead Wasted"), STAT_CachedFileReadaheadWasted, STATGROUP_AsyncIO, CORE_API);
 
 class CORE_API FCachedFileHandle : public IFileHandle
 {
 public:
-	FCachedFileHandle(IFileHandle* InFileHandle, bool bInReadable, bool bInWritable)
+	/**
+	 * @param InReadaheadPlatformFile	If set, the file at InFilename is opened with OpenAsyncRead on it once the handle is read sequentially,
+	 *									and the regions after the read position are read ahead. Only valid for handles that don't write.
+	 */
+	FCachedFileHandle(IFileHandle* InFileHandle, bool bInReadable, bool bInWritable, IPlatformFile* InReadaheadPlatformFile = nullptr, const TCHAR* InFilename = nullptr)
 		: FileHandle(InFileHandle)
 		, FilePos(InFileHandle->Tell())
 		, TellPos(FilePos)
@@ -29,13 +36,19 @@ public:
 		, bWritable(bInWritable)
 		, bReadable(bInReadable)
 		, CurrentCache(0)
-	{
+		, ReadaheadPlatformFile(InReadaheadPlatformFile)
+		, Filename(InFilename)
+		, FirstReadahead(0)
+		, NumReadaheads(0)
+		, ReadaheadWindow(1)
+		, NextSequentialPos(-1)
+		, NumSequentialMisses(0)
+	{
+		check(!ReadaheadPlatformFile || (bReadable && !bWritable && InFilename));
 		FlushCache();
 	}
 	
-	virtual ~FCachedFileHandle()
-	{
-	}
+	virtual ~FCachedFileHandle();
 
 	
 	virtual int64		Tell() override
@@ -105,8 +118,15 @@ public:
 					// need to update the cache
 					uint64 AlignedFilePos=FilePos&BufferSizeMask; // Aligned Version
 					uint64 SizeToRead=FMath::Min<uint64>(BufferCacheSize, FileSize-AlignedFilePos);
-					InnerSeek(AlignedFilePos);
-					Result = InnerRead(BufferCache[CurrentCache], SizeToRead);
+					if (ReadaheadPlatformFile)
+					{
+						Result = ReadRegion(AlignedFilePos, SizeToRead, BufferCache[CurrentCache]);
+					}
+					else
+					{
+						InnerSeek(AlignedFilePos);
+						Result = InnerRead(BufferCache[CurrentCache], SizeToRead);
+					}
 
 					if (Result)
 					{
@@ -193,6 +213,27 @@ private:
 	static const uint32 BufferCacheSize = 64 * 1024; // Seems to be the magic number for best perf
 	static const uint64 BufferSizeMask  = ~((uint64)BufferCacheSize-1);
 	static const uint32	CacheCount		= 2;
+	/** Most regions read ahead at once, the window grows to this while the reader keeps catching up with the reads in flight */
+	static const uint32 MaxReadaheadCount = 4;
+	/** Consecutive cache misses on adjacent regions before the handle starts reading ahead */
+	static const uint32 SequentialMissesBeforeReadahead = 2;
+
+	struct FReadahead
+	{
+		IAsyncReadRequest* Request = nullptr;
+		uint8* Buffer = nullptr;
+		int64 Start = 0;
+		int64 Size = 0;
+	};
+
+	/** Fills Dest with the region at AlignedPos, from a readahead if there is one for it, and keeps the readahead window ahead of sequential readers */
+	bool ReadRegion(int64 AlignedPos, int64 SizeToRead, uint8* Dest);
+	/** Issues readaheads for the regions after the last one read or in flight until the window is full */
+	void StartReadaheads();
+	/** Waits for the oldest readahead, if it is for the region at Pos copies it to Dest and returns true, otherwise drops all readaheads */
+	bool FinishReadahead(int64 Pos, int64 SizeToRead, uint8* Dest);
+	/** Cancels and waits for all readaheads */
+	void CancelReadaheads();
 
 	bool InnerSeek(uint64 Pos)
 	{
@@ -245,6 +286,20 @@ private:
 	int64					CacheStart[CacheCount];
 	int64					CacheEnd[CacheCount];
 	int32					CurrentCache;
+
+	IPlatformFile*			ReadaheadPlatformFile;
+	FString					Filename;
+	/** Opened the first time the handle is read sequentially */
+	TUniquePtr<IAsyncReadFileHandle> AsyncFileHandle;
+	/** Ring of readaheads in flight, in file order starting at FirstReadahead. Buffers stay with their slot once allocated */
+	FReadahead				Readaheads[MaxReadaheadCount];
+	uint32					FirstReadahead;
+	uint32					NumReadaheads;
+	/** Number of regions kept in flight, doubles when the reader has to wait for a readahead and halves when readaheads are wasted */
+	uint32					ReadaheadWindow;
+	/** End of the last region filled, a miss there continues a sequential run */
+	int64					NextSequentialPos;
+	uint32					NumSequentialMisses;
 };
 
 class CORE_API FCachedReadPlatformFile : public IPlatformFile
@@ -356,7 +411,7 @@ public:
 		{
 			return nullptr;
 		}
-		return new FCachedFileHandle(InnerHandle, true, false);
+		return new FCachedFileHandle(InnerHandle, true, false, LowerLevel, Filename);
 	}
 	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
 	{
@@ -0,0 +1,238 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Containers/Map.h"
+#include "Misc/Parse.h"
+#include "Misc/DateTime.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+struct FLocalCacheEntry;
+
+/**
+ * Wrapper that keeps the blocks read from slow, usually network mounted, files in a cache on a local disk that survives restarts.
+ *
+ * Every version of a file has its own sparse cache file, named by a hash of its path, size and modification time, so a file that
+ * changed is never read from a stale copy. Blocks are written at their offset in the file as they are first read and an index records
+ * which ones are there. When the cache outgrows its budget, the files that were least recently opened are deleted first.
+ *
+ * Enabled with -LocalCache, which also installs the wrapper on top of the platform file chain once the file system is ready.
+ * -LocalCacheDir=Path sets where the cache lives, -LocalCacheSizeMB=N its budget, -LocalCacheBlockKB=N the size of the blocks,
+ * and -LocalCachePaths=PathA+PathB limits it to files under these paths. Only one process can use a cache directory at a time.
+ */
+class CORE_API FLocalCachePlatformFile : public IPlatformFile
+{
+public:
+	static const TCHAR* GetTypeName()
+	{
+		return TEXT("LocalCache");
+	}
+
+	FLocalCachePlatformFile();
+	virtual ~FLocalCachePlatformFile();
+
+	/**
+	 * Reads a range of a file opened through the wrapper, the blocks that are in the cache from there and the others from the file
+	 * itself, which are then added to the cache. Used by the file handles of the wrapper, from any thread.
+	 *
+	 * @param Entry The cache entry of the file.
+	 * @param GetSourceHandle Returns the handle of the file itself, opened on the first block that isn't cached.
+	 * @return false if the range goes past the end of the file or a block can't be read.
+	 */
+	bool ReadCached(FLocalCacheEntry& Entry, TFunctionRef<IFileHandle*()> GetSourceHandle, int64 Offset, uint8* Destination, int64 BytesToRead);
+
+	/** Size of the file the entry caches */
+	static int64 GetCachedFileSize(const FLocalCacheEntry& Entry);
+
+	/** Called when a file handle of the wrapper closes */
+	void ReleaseEntry(FLocalCacheEntry& Entry);
+
+	/** Writes the index if blocks were added or files opened since it was last written */
+	void SaveIndexIfDirty();
+
+	//~ For visibility of overloads we don't override
+	using IPlatformFile::IterateDirectory;
+	using IPlatformFile::IterateDirectoryRecursively;
+	using IPlatformFile::IterateDirectoryStat;
+	using IPlatformFile::IterateDirectoryStatRecursively;
+
+	virtual bool ShouldBeUsed(IPlatformFile* Inner, const TCHAR* CmdLine) const override
+	{
+		return FParse::Param(CmdLine, TEXT("LocalCache"));
+	}
+	virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CmdLine) override;
+	virtual IPlatformFile* GetLowerLevel() override
+	{
+		return LowerLevel;
+	}
+	virtual void SetLowerLevel(IPlatformFile* NewLowerLevel) override
+	{
+		LowerLevel = NewLowerLevel;
+	}
+	virtual const TCHAR* GetName() const override
+	{
+		return GetTypeName();
+	}
+	virtual bool		FileExists(const TCHAR* Filename) override
+	{
+		return LowerLevel->FileExists(Filename);
+	}
+	virtual int64		FileSize(const TCHAR* Filename) override
+	{
+		return LowerLevel->FileSize(Filename);
+	}
+	virtual bool		DeleteFile(const TCHAR* Filename) override
+	{
+		return LowerLevel->DeleteFile(Filename);
+	}
+	virtual bool		IsReadOnly(const TCHAR* Filename) override
+	{
+		return LowerLevel->IsReadOnly(Filename);
+	}
+	virtual bool		MoveFile(const TCHAR* To, const TCHAR* From) override
+	{
+		return LowerLevel->MoveFile(To, From);
+	}
+	virtual bool		SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override
+	{
+		return LowerLevel->SetReadOnly(Filename, bNewReadOnlyValue);
+	}
+	virtual FDateTime	GetTimeStamp(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetTimeStamp(Filename);
+	}
+	virtual void		SetTimeStamp(const TCHAR* Filename, FDateTime DateTime) override
+	{
+		LowerLevel->SetTimeStamp(Filename, DateTime);
+	}
+	virtual FDateTime	GetAccessTimeStamp(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetAccessTimeStamp(Filename);
+	}
+	virtual FString	GetFilenameOnDisk(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetFilenameOnDisk(Filename);
+	}
+	virtual IFileHandle*	OpenRead(const TCHAR* Filename, bool bAllowWrite) override;
+	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
+	{
+		return LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
+	}
+	virtual bool		DirectoryExists(const TCHAR* Directory) override
+	{
+		return LowerLevel->DirectoryExists(Directory);
+	}
+	virtual bool		CreateDirectory(const TCHAR* Directory) override
+	{
+		return LowerLevel->CreateDirectory(Directory);
+	}
+	virtual bool		DeleteDirectory(const TCHAR* Directory) override
+	{
+		return LowerLevel->DeleteDirectory(Directory);
+	}
+	virtual FFileStatData GetStatData(const TCHAR* FilenameOrDirectory) override
+	{
+		return LowerLevel->GetStatData(FilenameOrDirectory);
+	}
+	virtual bool		IterateDirectory(const TCHAR* Directory, IPlatformFile::FDirectoryVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectory(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryRecursively(const TCHAR* Directory, IPlatformFile::FDirectoryVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryRecursively(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryStat(const TCHAR* Directory, IPlatformFile::FDirectoryStatVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryStat(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryStatRecursively(const TCHAR* Directory, IPlatformFile::FDirectoryStatVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryStatRecursively(Directory, Visitor);
+	}
+	virtual bool		DeleteDirectoryRecursively(const TCHAR* Directory) override
+	{
+		return LowerLevel->DeleteDirectoryRecursively(Directory);
+	}
+	virtual bool		CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags = EPlatformFileRead::None, EPlatformFileWrite WriteFlags = EPlatformFileWrite::None) override
+	{
+		return LowerLevel->CopyFile(To, From, ReadFlags, WriteFlags);
+	}
+	virtual bool		CreateDirectoryTree(const TCHAR* Directory) override
+	{
+		return LowerLevel->CreateDirectoryTree(Directory);
+	}
+	virtual bool		CopyDirectoryTree(const TCHAR* DestinationDirectory, const TCHAR* Source, bool bOverwriteAllExisting) override
+	{
+		return LowerLevel->CopyDirectoryTree(DestinationDirectory, Source, bOverwriteAllExisting);
+	}
+	virtual FString		ConvertToAbsolutePathForExternalAppForRead(const TCHAR* Filename) override
+	{
+		return LowerLevel->ConvertToAbsolutePathForExternalAppForRead(Filename);
+	}
+	virtual FString		ConvertToAbsolutePathForExternalAppForWrite(const TCHAR* Filename) override
+	{
+		return LowerLevel->ConvertToAbsolutePathForExternalAppForWrite(Filename);
+	}
+	virtual bool		SendMessageToServer(const TCHAR* Message, IFileServerMessageHandler* Handler) override
+	{
+		return LowerLevel->SendMessageToServer(Message, Handler);
+	}
+	// OpenAsyncRead isn't forwarded, the generic async handle reads through OpenRead and so through the cache
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenMapped(Filename);
+	}
+	virtual void SetAsyncMinimumPriority(EAsyncIOPriorityAndFlags MinPriority) override
+	{
+		LowerLevel->SetAsyncMinimumPriority(MinPriority);
+	}
+
+private:
+	/** Whether reads of the file go through the cache */
+	bool ShouldCache(const TCHAR* Filename) const;
+
+	/** Finds or adds the entry of the version of the file described by StatData, and counts a handle using it */
+	FLocalCacheEntry* AcquireEntry(const TCHAR* Filename, const FFileStatData& StatData);
+
+	/** Adds a block read from the file to the cache file of the entry */
+	void StoreBlock(FLocalCacheEntry& Entry, int32 BlockIndex, const uint8* Data, int64 Size);
+
+	/** Opens the cache file of the entry for reading and writing, Entry.Critical must be held */
+	IFileHandle* GetCacheHandle(FLocalCacheEntry& Entry);
+
+	/** Deletes the least recently opened entries that aren't in use until the cache fits its budget, IndexCritical must be held */
+	void TrimToBudget();
+
+	/** Deletes the entry and its cache file, the entry must not be in use and IndexCritical must be held */
+	void RemoveEntry(const FString& Name);
+
+	FString GetCacheFilename(const FString& Name) const;
+	void LoadIndex();
+	void SaveIndex();
+
+	IPlatformFile* LowerLevel;
+	FString CacheDir;
+	TArray<FString> CachedPaths;
+	int64 MaxCacheSize;
+	int64 BlockSize;
+
+	/** Held for as long as the wrapper uses the cache directory, the cache is disabled if another process has it */
+	TUniquePtr<IFileHandle> LockHandle;
+	bool bEnabled;
+
+	/** Guards the entries, their handle counts and the totals */
+	FCriticalSection IndexCritical;
+	/** By the name of their cache file */
+	TMap<FString, TUniquePtr<FLocalCacheEntry>> Entries;
+	int64 TotalCachedSize;
+	uint64 AccessSequence;
+	bool bIndexDirty;
+	double LastIndexSaveTime;
+};
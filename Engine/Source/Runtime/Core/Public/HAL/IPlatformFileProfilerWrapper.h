@@ -17,6 +17,7 @@
 #include "Templates/UniquePtr.h"
 
 class IAsyncReadFileHandle;
+class FOutputDevice;
 
 #if !UE_BUILD_SHIPPING
 
@@ -35,6 +36,49 @@ extern bool bSuppressProfiledFileLog;
 		bSuppressProfiledFileLog = false; \
 	}
 
+/**
+ * Names the code issuing the file operations on this thread while in scope, so the profiler wrapper can attribute their latency to it.
+ * Name must outlive the operations, it is meant to be a string literal.
+ */
+class CORE_API FScopedProfiledFileCallSite
+{
+public:
+	explicit FScopedProfiledFileCallSite(const TCHAR* Name);
+	~FScopedProfiledFileCallSite();
+
+	/** @return the innermost call site of this thread, or "Unknown" */
+	static const TCHAR* Get();
+
+private:
+	const TCHAR* PreviousName;
+};
+
+#define PROFILEDFILE_CALLSITE_SCOPE(Name) FScopedProfiledFileCallSite PREPROCESSOR_JOIN(ProfiledFileCallSite, __LINE__)(Name);
+
+/**
+ * Distribution of the latencies of file operations, with power of two buckets from 1us up.
+ */
+struct CORE_API FProfiledFileLatencyHistogram
+{
+	enum { NumBuckets = 32 };
+
+	uint32 Buckets[NumBuckets];
+	uint32 Count;
+	double MaxMs;
+	int64 Bytes;
+
+	FProfiledFileLatencyHistogram()
+	{
+		Reset();
+	}
+
+	void Reset();
+	void Add(double DurationMs, int64 InBytes);
+
+	/** @return the upper bound of the bucket the percentile falls in, capped to MaxMs. Percentile is in [0, 1] */
+	double GetPercentileMs(double Percentile) const;
+};
+
 struct FProfiledFileStatsBase
 {
 	/** Start time (ms) */
@@ -104,6 +148,10 @@ struct FProfiledFileStatsFileBase : public FProfiledFileStatsBase
 	/** Child stats */
 	TArray< TSharedPtr< FProfiledFileStatsOp > > Children;
 	FCriticalSection SynchronizationObject;
+	/** Latencies of the reads and writes, guarded by FProfiledPlatformFile's LatencyCritical */
+	FProfiledFileLatencyHistogram Latency;
+	/** Same, since the last interval was traced */
+	FProfiledFileLatencyHistogram IntervalLatency;
 
 	FProfiledFileStatsFileBase( const TCHAR* Filename )
 	: Name( Filename )
@@ -151,19 +199,23 @@ struct FProfiledFileStatsFileSimple : public FProfiledFileStatsFileBase
 	}
 };
 
+class FProfiledPlatformFile;
+
 template< typename StatType >
 class TProfiledFileHandle : public IFileHandle
 {
 	TUniquePtr<IFileHandle> FileHandle;
 	FString Filename;
 	StatType* FileStats;
+	FProfiledPlatformFile* Owner;
 
 public:
 
-	TProfiledFileHandle(IFileHandle* InFileHandle, const TCHAR* InFilename, StatType* InStats)
+	TProfiledFileHandle(IFileHandle* InFileHandle, const TCHAR* InFilename, StatType* InStats, FProfiledPlatformFile* InOwner = nullptr)
 		: FileHandle(InFileHandle)
 		, Filename(InFilename)
 		, FileStats(InStats)
+		, Owner(InOwner)
 	{
 	}
 
@@ -188,22 +240,8 @@ public:
 		Stat->Duration += FPlatformTime::Seconds() * 1000.0 - Stat->LastOpTime;
 		return Result;
 	}
-	virtual bool		Read(uint8* Destination, int64 BytesToRead) override
-	{
-		FProfiledFileStatsOp* Stat( FileStats->CreateOpStat( FProfiledFileStatsOp::EOpType::Read ) );
-		bool Result = FileHandle->Read(Destination, BytesToRead);
-		Stat->Duration += FPlatformTime::Seconds() * 1000.0 - Stat->LastOpTime;
-		Stat->Bytes += BytesToRead;
-		return Result;
-	}
-	virtual bool		Write(const uint8* Source, int64 BytesToWrite) override
-	{
-		FProfiledFileStatsOp* Stat( FileStats->CreateOpStat( FProfiledFileStatsOp::EOpType::Write ) );
-		bool Result = FileHandle->Write(Source, BytesToWrite);
-		Stat->Duration += FPlatformTime::Seconds() * 1000.0 - Stat->LastOpTime;
-		Stat->Bytes += BytesToWrite;
-		return Result;
-	}
+	virtual bool		Read(uint8* Destination, int64 BytesToRead) override;
+	virtual bool		Write(const uint8* Source, int64 BytesToWrite) override;
 	virtual int64		Size() override
 	{
 		FProfiledFileStatsOp* Stat( FileStats->CreateOpStat( FProfiledFileStatsOp::EOpType::Size ) );
@@ -236,12 +274,32 @@ protected:
 	double StartTime;
 	FCriticalSection SynchronizationObject;
 
+	/** Guards the latency histograms, of the call sites and of the files */
+	FCriticalSection LatencyCritical;
+	TMap< const TCHAR*, FProfiledFileLatencyHistogram > CallSiteLatency;
+	TMap< const TCHAR*, FProfiledFileLatencyHistogram > CallSiteIntervalLatency;
+	/** Files with reads or writes since the last interval was traced */
+	TArray< FProfiledFileStatsFileBase* > IntervalFiles;
+	double IntervalStartTime;
+	int64 IntervalBytes;
+
+	/** Reads and writes in flight, and the most there were since the last interval was traced */
+	volatile int32 NumOpsInFlight;
+	volatile int32 MaxOpsInFlight;
+
 	FProfiledPlatformFile()
 		: LowerLevel(nullptr)
 		, StartTime(0.0)
+		, IntervalStartTime(0.0)
+		, IntervalBytes(0)
+		, NumOpsInFlight(0)
+		, MaxOpsInFlight(0)
 	{
 	}
 
+	/** Wraps an async read handle to record the latency of its reads */
+	IAsyncReadFileHandle* CreateProfiledAsyncReadHandle(IAsyncReadFileHandle* FileHandle, FProfiledFileStatsFileBase* FileStats);
+
 public:
 
 	virtual ~FProfiledPlatformFile()
@@ -253,14 +311,18 @@ public:
 		return FParse::Param( CmdLine, GetName() );
 	}
 
-	virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CommandLineParam) override
-	{
-		// Inner is required.
-		check(Inner != nullptr);
-		LowerLevel = Inner;
-		StartTime = FPlatformTime::Seconds() * 1000.0;
-		return !!LowerLevel;
-	}
+	virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CommandLineParam) override;
+
+	/** Called when a read or write starts */
+	void BeginLatencyOp();
+	/** Called when a read or write started with BeginLatencyOp is done, adds it to the histograms of the file and of the call site */
+	void EndLatencyOp(FProfiledFileStatsFileBase* FileStats, const TCHAR* CallSite, double DurationMs, int64 Bytes);
+
+	/** Traces the latencies, queue depth and throughput since the last interval */
+	bool TickLatency(float DeltaTime);
+
+	/** Logs p50, p99 and max latency of each call site, and of the NumFiles files with the worst p99 */
+	void DumpLatency(FOutputDevice& Ar, int32 NumFiles = 20);
 
 	virtual IPlatformFile* GetLowerLevel() override
 	{
@@ -414,7 +476,7 @@ public:
 		FProfiledFileStatsOp* OpStat = FileStat->CreateOpStat( FProfiledFileStatsOp::EOpType::OpenRead );
 		IFileHandle* Result = LowerLevel->OpenRead(Filename, bAllowWrite);
 		OpStat->Duration += FPlatformTime::Seconds() * 1000.0 - OpStat->LastOpTime;
-		return Result ? (new TProfiledFileHandle< StatsType >( Result, Filename, FileStat )) : Result;
+		return Result ? (new TProfiledFileHandle< StatsType >( Result, Filename, FileStat, this )) : Result;
 	}
 	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
 	{
@@ -422,7 +484,7 @@ public:
 		FProfiledFileStatsOp* OpStat = FileStat->CreateOpStat( FProfiledFileStatsOp::EOpType::OpenWrite );
 		IFileHandle* Result = LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
 		OpStat->Duration += FPlatformTime::Seconds() * 1000.0 - OpStat->LastOpTime;
-		return Result ? (new TProfiledFileHandle< StatsType >( Result, Filename, FileStat )) : Result;
+		return Result ? (new TProfiledFileHandle< StatsType >( Result, Filename, FileStat, this )) : Result;
 	}
 
 	virtual bool		DirectoryExists(const TCHAR* Directory) override
@@ -511,7 +573,8 @@ public:
 	}
 	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename) override
 	{
-		return LowerLevel->OpenAsyncRead(Filename);
+		IAsyncReadFileHandle* Result = LowerLevel->OpenAsyncRead(Filename);
+		return Result ? CreateProfiledAsyncReadHandle(Result, CreateStat(Filename)) : Result;
 	}
 	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override
 	{
@@ -525,6 +588,46 @@ public:
 	//static void CreateProfileVisualizer
 };
 
+template< typename StatType >
+bool TProfiledFileHandle< StatType >::Read(uint8* Destination, int64 BytesToRead)
+{
+	FProfiledFileStatsOp* Stat( FileStats->CreateOpStat( FProfiledFileStatsOp::EOpType::Read ) );
+	const double OpStartTime = FPlatformTime::Seconds() * 1000.0;
+	if (Owner)
+	{
+		Owner->BeginLatencyOp();
+	}
+	bool Result = FileHandle->Read(Destination, BytesToRead);
+	const double OpEndTime = FPlatformTime::Seconds() * 1000.0;
+	if (Owner)
+	{
+		Owner->EndLatencyOp(FileStats, FScopedProfiledFileCallSite::Get(), OpEndTime - OpStartTime, BytesToRead);
+	}
+	Stat->Duration += OpEndTime - Stat->LastOpTime;
+	Stat->Bytes += BytesToRead;
+	return Result;
+}
+
+template< typename StatType >
+bool TProfiledFileHandle< StatType >::Write(const uint8* Source, int64 BytesToWrite)
+{
+	FProfiledFileStatsOp* Stat( FileStats->CreateOpStat( FProfiledFileStatsOp::EOpType::Write ) );
+	const double OpStartTime = FPlatformTime::Seconds() * 1000.0;
+	if (Owner)
+	{
+		Owner->BeginLatencyOp();
+	}
+	bool Result = FileHandle->Write(Source, BytesToWrite);
+	const double OpEndTime = FPlatformTime::Seconds() * 1000.0;
+	if (Owner)
+	{
+		Owner->EndLatencyOp(FileStats, FScopedProfiledFileCallSite::Get(), OpEndTime - OpStartTime, BytesToWrite);
+	}
+	Stat->Duration += OpEndTime - Stat->LastOpTime;
+	Stat->Bytes += BytesToWrite;
+	return Result;
+}
+
 template<>
 inline const TCHAR* TProfiledPlatformFile<FProfiledFileStatsFileDetailed>::GetTypeName()
 {
@@ -750,4 +853,8 @@ public:
 };
 
 
+#else
+
+#define PROFILEDFILE_CALLSITE_SCOPE(Name)
+
 #endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,235 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Containers/Map.h"
+#include "Misc/Parse.h"
+#include "Misc/DateTime.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+
+class FRunnableThread;
+class FStartupPrefetchReplay;
+
+/**
+ * Byte range of a file read during startup.
+ */
+struct FStartupPrefetchRange
+{
+	int64 Offset;
+	int64 Size;
+
+	friend FArchive& operator<<(FArchive& Ar, FStartupPrefetchRange& Range)
+	{
+		return Ar << Range.Offset << Range.Size;
+	}
+};
+
+/**
+ * A file read during startup, and the ranges that were read from it.
+ */
+struct FStartupPrefetchFile
+{
+	FString Filename;
+	int64 FileSize = -1;
+	TArray<FStartupPrefetchRange> Ranges;
+
+	friend FArchive& operator<<(FArchive& Ar, FStartupPrefetchFile& File)
+	{
+		return Ar << File.Filename << File.FileSize << File.Ranges;
+	}
+};
+
+/**
+ * Wrapper that records the files and byte ranges read during the first seconds of a run into a manifest. On the following runs
+ * it reads them again, in file order and offset order, on a background thread as soon as the file system is up, so they are
+ * in the OS file cache by the time the code that needs them asks for them.
+ *
+ * Enabled with -StartupPrefetch, which also installs the wrapper on top of the platform file chain once the file system is ready.
+ * A run without a manifest records one, -StartupPrefetchRecord records a new one even if there is one.
+ * -StartupPrefetchSeconds=N sets how long to record for, -StartupPrefetchManifest=Path where the manifest lives.
+ */
+class CORE_API FStartupPrefetchPlatformFile : public IPlatformFile
+{
+public:
+	static const TCHAR* GetTypeName()
+	{
+		return TEXT("StartupPrefetch");
+	}
+
+	FStartupPrefetchPlatformFile();
+	virtual ~FStartupPrefetchPlatformFile();
+
+	/** Records the read of a range of a file opened through the wrapper, FileIndex is from AddRecordedFile */
+	void RecordRead(int32 FileIndex, int64 Offset, int64 Size);
+
+	/** Stops recording and writes the manifest. Called by the first read after the recording time is up, can be called earlier */
+	void StopRecording();
+
+	bool IsRecording() const
+	{
+		return bRecording;
+	}
+
+	//~ For visibility of overloads we don't override
+	using IPlatformFile::IterateDirectory;
+	using IPlatformFile::IterateDirectoryRecursively;
+	using IPlatformFile::IterateDirectoryStat;
+	using IPlatformFile::IterateDirectoryStatRecursively;
+
+	virtual bool ShouldBeUsed(IPlatformFile* Inner, const TCHAR* CmdLine) const override
+	{
+		return FParse::Param(CmdLine, TEXT("StartupPrefetch"));
+	}
+	virtual bool Initialize(IPlatformFile* Inner, const TCHAR* CmdLine) override;
+	virtual IPlatformFile* GetLowerLevel() override
+	{
+		return LowerLevel;
+	}
+	virtual void SetLowerLevel(IPlatformFile* NewLowerLevel) override
+	{
+		LowerLevel = NewLowerLevel;
+	}
+	virtual const TCHAR* GetName() const override
+	{
+		return GetTypeName();
+	}
+	virtual bool		FileExists(const TCHAR* Filename) override
+	{
+		return LowerLevel->FileExists(Filename);
+	}
+	virtual int64		FileSize(const TCHAR* Filename) override
+	{
+		return LowerLevel->FileSize(Filename);
+	}
+	virtual bool		DeleteFile(const TCHAR* Filename) override
+	{
+		return LowerLevel->DeleteFile(Filename);
+	}
+	virtual bool		IsReadOnly(const TCHAR* Filename) override
+	{
+		return LowerLevel->IsReadOnly(Filename);
+	}
+	virtual bool		MoveFile(const TCHAR* To, const TCHAR* From) override
+	{
+		return LowerLevel->MoveFile(To, From);
+	}
+	virtual bool		SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override
+	{
+		return LowerLevel->SetReadOnly(Filename, bNewReadOnlyValue);
+	}
+	virtual FDateTime	GetTimeStamp(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetTimeStamp(Filename);
+	}
+	virtual void		SetTimeStamp(const TCHAR* Filename, FDateTime DateTime) override
+	{
+		LowerLevel->SetTimeStamp(Filename, DateTime);
+	}
+	virtual FDateTime	GetAccessTimeStamp(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetAccessTimeStamp(Filename);
+	}
+	virtual FString	GetFilenameOnDisk(const TCHAR* Filename) override
+	{
+		return LowerLevel->GetFilenameOnDisk(Filename);
+	}
+	virtual IFileHandle*	OpenRead(const TCHAR* Filename, bool bAllowWrite) override;
+	virtual IFileHandle*	OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override
+	{
+		return LowerLevel->OpenWrite(Filename, bAppend, bAllowRead);
+	}
+	virtual bool		DirectoryExists(const TCHAR* Directory) override
+	{
+		return LowerLevel->DirectoryExists(Directory);
+	}
+	virtual bool		CreateDirectory(const TCHAR* Directory) override
+	{
+		return LowerLevel->CreateDirectory(Directory);
+	}
+	virtual bool		DeleteDirectory(const TCHAR* Directory) override
+	{
+		return LowerLevel->DeleteDirectory(Directory);
+	}
+	virtual FFileStatData GetStatData(const TCHAR* FilenameOrDirectory) override
+	{
+		return LowerLevel->GetStatData(FilenameOrDirectory);
+	}
+	virtual bool		IterateDirectory(const TCHAR* Directory, IPlatformFile::FDirectoryVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectory(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryRecursively(const TCHAR* Directory, IPlatformFile::FDirectoryVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryRecursively(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryStat(const TCHAR* Directory, IPlatformFile::FDirectoryStatVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryStat(Directory, Visitor);
+	}
+	virtual bool		IterateDirectoryStatRecursively(const TCHAR* Directory, IPlatformFile::FDirectoryStatVisitor& Visitor) override
+	{
+		return LowerLevel->IterateDirectoryStatRecursively(Directory, Visitor);
+	}
+	virtual bool		DeleteDirectoryRecursively(const TCHAR* Directory) override
+	{
+		return LowerLevel->DeleteDirectoryRecursively(Directory);
+	}
+	virtual bool		CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags = EPlatformFileRead::None, EPlatformFileWrite WriteFlags = EPlatformFileWrite::None) override
+	{
+		return LowerLevel->CopyFile(To, From, ReadFlags, WriteFlags);
+	}
+	virtual bool		CreateDirectoryTree(const TCHAR* Directory) override
+	{
+		return LowerLevel->CreateDirectoryTree(Directory);
+	}
+	virtual bool		CopyDirectoryTree(const TCHAR* DestinationDirectory, const TCHAR* Source, bool bOverwriteAllExisting) override
+	{
+		return LowerLevel->CopyDirectoryTree(DestinationDirectory, Source, bOverwriteAllExisting);
+	}
+	virtual FString		ConvertToAbsolutePathForExternalAppForRead(const TCHAR* Filename) override
+	{
+		return LowerLevel->ConvertToAbsolutePathForExternalAppForRead(Filename);
+	}
+	virtual FString		ConvertToAbsolutePathForExternalAppForWrite(const TCHAR* Filename) override
+	{
+		return LowerLevel->ConvertToAbsolutePathForExternalAppForWrite(Filename);
+	}
+	virtual bool		SendMessageToServer(const TCHAR* Message, IFileServerMessageHandler* Handler) override
+	{
+		return LowerLevel->SendMessageToServer(Message, Handler);
+	}
+	virtual IAsyncReadFileHandle* OpenAsyncRead(const TCHAR* Filename) override;
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override
+	{
+		return LowerLevel->OpenMapped(Filename);
+	}
+	virtual void SetAsyncMinimumPriority(EAsyncIOPriorityAndFlags MinPriority) override
+	{
+		LowerLevel->SetAsyncMinimumPriority(MinPriority);
+	}
+
+private:
+	/** Returns the index of the file in RecordedFiles, adding it if it wasn't read yet */
+	int32 AddRecordedFile(const TCHAR* Filename, int64 FileSize);
+
+	/** Sorts and merges the ranges of the recorded files, and writes them to the manifest */
+	void SaveManifest();
+
+	IPlatformFile* LowerLevel;
+	FString ManifestPath;
+
+	TAtomic<bool> bRecording;
+	double RecordEndTime;
+	FCriticalSection RecordCritical;
+	TMap<FString, int32> RecordedFileIndices;
+	/** In the order they were first read */
+	TArray<FStartupPrefetchFile> RecordedFiles;
+
+	FStartupPrefetchReplay* Replay;
+	FRunnableThread* ReplayThread;
+};
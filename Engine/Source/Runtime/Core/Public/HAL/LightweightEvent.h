@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/AddressWait.h"
+
+/**
+ * A manual reset event in four bytes that needs no OS object. Triggering it with nobody waiting is one atomic,
+ * waiters park through FAddressWait, which falls back to pooled FEvents where the platform can not wait on an
+ * address. Trigger does not touch the event once it woke the waiters, so it can live on the stack of the thread
+ * waiting for it.
+ */
+class FLightweightEvent
+{
+public:
+
+	FLightweightEvent()
+		: State(NotTriggered)
+	{
+	}
+
+	/** Wakes every waiter, the event stays triggered until Reset */
+	FORCEINLINE void Trigger()
+	{
+		if (FPlatformAtomics::InterlockedExchange(&State, Triggered) == NotTriggeredWithWaiters)
+		{
+			FAddressWait::WakeAll(&State);
+		}
+	}
+
+	/** Untriggers the event, does nothing unless it is triggered so it can not strand a waiter */
+	FORCEINLINE void Reset()
+	{
+		FPlatformAtomics::InterlockedCompareExchange(&State, NotTriggered, Triggered);
+	}
+
+	/** Blocks until the event is triggered */
+	FORCEINLINE void Wait()
+	{
+		if (!IsTriggered())
+		{
+			WaitSlow();
+		}
+	}
+
+	bool IsTriggered() const
+	{
+		return FPlatformAtomics::AtomicRead(&State) == Triggered;
+	}
+
+private:
+
+	enum : int32
+	{
+		NotTriggered = 0,
+		/** Threads may be parked, triggering has to wake them */
+		NotTriggeredWithWaiters = 1,
+		Triggered = 2,
+	};
+
+	CORE_API void WaitSlow();
+
+	volatile int32 State;
+
+	UE_NONCOPYABLE(FLightweightEvent);
+};
+
+/**
+ * Blocks waiters until it was counted down a given number of times, in four bytes and with no OS object. Counting
+ * down is one atomic, the last one wakes the waiters. Like FLightweightEvent it is not touched after the wake.
+ */
+class FLightweightLatch
+{
+public:
+
+	explicit FLightweightLatch(int32 InCount)
+		: State(InCount * CountUnit)
+	{
+		checkSlow(InCount >= 0);
+	}
+
+	/** Counts down by Num, the count must not go below zero */
+	FORCEINLINE void CountDown(int32 Num = 1)
+	{
+		const int32 Previous = FPlatformAtomics::InterlockedAdd(&State, -Num * CountUnit);
+		checkSlow(Previous / CountUnit >= Num);
+		if (Previous / CountUnit == Num && (Previous & WaitersBit))
+		{
+			FAddressWait::WakeAll(&State);
+		}
+	}
+
+	/** Blocks until the count reached zero */
+	FORCEINLINE void Wait()
+	{
+		if (!IsDone())
+		{
+			WaitSlow();
+		}
+	}
+
+	bool IsDone() const
+	{
+		return FPlatformAtomics::AtomicRead(&State) < CountUnit;
+	}
+
+	/** Only a snapshot */
+	int32 GetCount() const
+	{
+		return FPlatformAtomics::AtomicRead(&State) / CountUnit;
+	}
+
+private:
+
+	enum : int32
+	{
+		/** Threads may be parked, the last count down has to wake them */
+		WaitersBit = 1,
+		CountUnit = 2,
+	};
+
+	CORE_API void WaitSlow();
+
+	volatile int32 State;
+
+	UE_NONCOPYABLE(FLightweightLatch);
+};
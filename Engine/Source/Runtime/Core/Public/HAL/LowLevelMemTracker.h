@@ -221,8 +221,11 @@ enum class ELLMTagSet : uint8
 	macro(MediaStreaming,						"MediaStreaming",				GET_STATFNAME(STAT_MediaStreamingLLM),						GET_STATFNAME(STAT_MediaStreamingSummaryLLM),	-1)\
 	macro(ElectraPlayer,						"ElectraPlayer",				GET_STATFNAME(STAT_ElectraPlayerLLM),						GET_STATFNAME(STAT_MediaStreamingSummaryLLM),	ELLMTag::MediaStreaming)\
 	macro(WMFPlayer,							"WMFPlayer",					GET_STATFNAME(STAT_WMFPlayerLLM),							GET_STATFNAME(STAT_MediaStreamingSummaryLLM),	ELLMTag::MediaStreaming)\
+	macro(Compression,							"Compression",					GET_STATFNAME(STAT_CompressionLLM),							GET_STATFNAME(STAT_EngineSummaryLLM),			-1)\
 	macro(PlatformMMIO,							"MMIO",							GET_STATFNAME(STAT_PlatformMMIOLLM),						NAME_None,										-1)\
 	macro(PlatformVM,							"Virtual Memory",				GET_STATFNAME(STAT_PlatformVMLLM),							NAME_None,										-1)\
+	macro(PlatformHugePages,					"Huge Pages",					GET_STATFNAME(STAT_PlatformHugePagesLLM),					NAME_None,										-1)\
+	macro(PlatformHugePagesMissed,				"Huge Pages Missed",			GET_STATFNAME(STAT_PlatformHugePagesMissedLLM),				NAME_None,										-1)\
 
 /*
  * Enum values to be passed in to LLM_SCOPE() macro
@@ -249,7 +249,7 @@ class CORE_API FMallocBinned2 final : public FMalloc
 	uint64 NumPoolsPerPage;
 
 #if !PLATFORM_UNIX
-	TCachedOSPageAllocator<BINNED2_MAX_CACHED_OS_FREES, BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT> CachedOSPageAllocator;
+	TBinnedCachedOSPageAllocator<BINNED2_MAX_CACHED_OS_FREES, BINNED2_MAX_CACHED_OS_FREES_BYTE_LIMIT> CachedOSPageAllocator;
 #else
 	FPooledVirtualMemoryAllocator CachedOSPageAllocator;
 #endif
@@ -359,7 +359,11 @@ class CORE_API FMallocBinned2 final : public FMalloc
 	{
 		FORCEINLINE static FPerThreadFreeBlockLists* Get()
 		{
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+			return FMallocBinned2::ThreadFreeBlockLists;
+#else
 			return FMallocBinned2::Binned2TlsSlot ? (FPerThreadFreeBlockLists*)FPlatformTLS::GetTlsValue(FMallocBinned2::Binned2TlsSlot) : nullptr;
+#endif
 		}
 		static void SetTLS();
 		static void ClearTLS();
@@ -694,6 +698,10 @@ public:
 	static uint16 SmallBlockSizesReversed[BINNED2_SMALL_POOL_COUNT]; // this is reversed to get the smallest elements on our main cache line
 	static FMallocBinned2* MallocBinned2;
 	static uint32 Binned2TlsSlot;
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+	// Same as the value in Binned2TlsSlot, malloc and free read it without calling into the OS
+	static thread_local FPerThreadFreeBlockLists* ThreadFreeBlockLists TLS_INITIAL_EXEC;
+#endif
 	static uint32 PageSize;
 	static uint32 OsAllocationGranularity;
 	// Mapping of sizes to small table indices
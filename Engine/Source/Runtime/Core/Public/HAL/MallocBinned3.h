@@ -46,6 +46,8 @@
 #define DEFAULT_GMallocBinned3BundleCount 64
 #define DEFAULT_GMallocBinned3AllocExtra 32
 #define BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle 8
+#define DEFAULT_GMallocBinned3MagazineDepth 4
+#define BINNED3_MAX_GMallocBinned3MagazineDepth 8
 
 #if !defined(AGGRESSIVE_MEMORY_SAVING)
 	#error "AGGRESSIVE_MEMORY_SAVING must be defined"
@@ -64,12 +66,14 @@
 	extern CORE_API int32 GMallocBinned3BundleCount = DEFAULT_GMallocBinned3BundleCount;
 	extern CORE_API int32 GMallocBinned3MaxBundlesBeforeRecycle = BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle;
 	extern CORE_API int32 GMallocBinned3AllocExtra = DEFAULT_GMallocBinned3AllocExtra;
+	extern CORE_API int32 GMallocBinned3MagazineDepth = DEFAULT_GMallocBinned3MagazineDepth;
 #else
 	#define GMallocBinned3PerThreadCaches DEFAULT_GMallocBinned3PerThreadCaches
 	#define GMallocBinned3BundleSize DEFAULT_GMallocBinned3BundleSize
 	#define GMallocBinned3BundleCount DEFAULT_GMallocBinned3BundleCount
 	#define GMallocBinned3MaxBundlesBeforeRecycle BINNED3_MAX_GMallocBinned3MaxBundlesBeforeRecycle
 	#define GMallocBinned3AllocExtra DEFAULT_GMallocBinned3AllocExtra
+	#define GMallocBinned3MagazineDepth DEFAULT_GMallocBinned3MagazineDepth
 #endif
 
 
@@ -341,14 +345,33 @@ class CORE_API FMallocBinned3 final : public FMalloc
 		}
 
 		// tries to recycle the full bundle, if that fails, it is returned for freeing
-		FBundleNode* RecyleFull(uint32 InPoolIndex);
-		bool ObtainPartial(uint32 InPoolIndex);
+		FBundleNode* RecyleFull(uint32 InPoolIndex, FPerThreadFreeBlockLists* InOwner);
+		bool ObtainPartial(uint32 InPoolIndex, FBundleInbox& InInbox);
 		FBundleNode* PopBundles(uint32 InPoolIndex);
 	private:
 		FBundle PartialBundle;
 		FBundle FullBundle;
 	};
 
+	// Magazine of bundles that other threads freed on behalf of the thread that keeps allocating from a pool.
+	// Producer/consumer workloads hand their freed blocks straight back to the producer this way instead of going through the global lock.
+	struct FBundleInbox
+	{
+		FBundleInbox()
+		{
+			FMemory::Memzero(Slots, sizeof(Slots));
+		}
+
+		// may be called from any thread, the bundle head must have its count set. returns false if the inbox is full or closed
+		bool Push(FBundleNode* InBundle);
+		// owning thread only
+		FBundleNode* Pop();
+		// owning thread only, returns every bundle linked through NextBundle and optionally closes the inbox for good
+		FBundleNode* PopAll(bool bClose);
+	private:
+		FBundleNode* Slots[BINNED3_MAX_GMallocBinned3MagazineDepth];
+	};
+
 	struct FPerThreadFreeBlockLists
 	{
 		FORCEINLINE static FPerThreadFreeBlockLists* Get()
@@ -381,16 +404,16 @@ class CORE_API FMallocBinned3 final : public FMalloc
 		// returns a bundle that needs to be freed if it can't be recycled
 		FBundleNode* RecycleFullBundle(uint32 InPoolIndex)
 		{
-			return FreeLists[InPoolIndex].RecyleFull(InPoolIndex);
+			return FreeLists[InPoolIndex].RecyleFull(InPoolIndex, this);
 		}
 		// returns true if we have anything to pop
-		bool ObtainRecycledPartial(uint32 InPoolIndex)
-		{
-			return FreeLists[InPoolIndex].ObtainPartial(InPoolIndex);
-		}
-		FBundleNode* PopBundles(uint32 InPoolIndex)
+		bool ObtainRecycledPartial(uint32 InPoolIndex);
+		// returns the cached bundles and the ones waiting in the inbox, closing the inbox if the thread is going away
+		FBundleNode* PopBundles(uint32 InPoolIndex, bool bCloseInbox = false);
+		// may be called from any thread
+		bool PushToInbox(uint32 InPoolIndex, FBundleNode* InBundle)
 		{
-			return FreeLists[InPoolIndex].PopBundles(InPoolIndex);
+			return Inboxes[InPoolIndex].Push(InBundle);
 		}
 #if BINNED3_ALLOCATOR_STATS
 	public:
@@ -399,6 +422,7 @@ class CORE_API FMallocBinned3 final : public FMalloc
 #endif
 	private:
 		FFreeBlockList FreeLists[BINNED3_SMALL_POOL_COUNT];
+		FBundleInbox Inboxes[BINNED3_SMALL_POOL_COUNT];
 	};
 
 #if !BINNED3_USE_SEPARATE_VM_PER_POOL
@@ -664,7 +688,7 @@ public:
 	virtual const TCHAR* GetDescriptiveName() override;
 	// End FMalloc interface.
 
-	void FlushCurrentThreadCache();
+	void FlushCurrentThreadCache(bool bCloseInboxes = false);
 	void* MallocExternal(SIZE_T Size, uint32 Alignment);
 	void* ReallocExternal(void* Ptr, SIZE_T NewSize, uint32 Alignment);
 	void FreeExternal(void *Ptr);
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/MemoryBase.h"
+
+/** Allocations made by one thread, see FMallocCountingProxy::GetThreadCounts */
+struct FMallocThreadCounts
+{
+	/** Mallocs, and Reallocs from nullptr */
+	uint64 NumAllocations = 0;
+	/** Reallocs that did not allocate or free */
+	uint64 NumReallocations = 0;
+	uint64 NumFrees = 0;
+	/** Requested bytes of the allocations, plus what reallocations grew blocks by over their allocated size */
+	uint64 AllocatedBytes = 0;
+
+	FMallocThreadCounts operator-(const FMallocThreadCounts& Other) const
+	{
+		FMallocThreadCounts Result;
+		Result.NumAllocations = NumAllocations - Other.NumAllocations;
+		Result.NumReallocations = NumReallocations - Other.NumReallocations;
+		Result.NumFrees = NumFrees - Other.NumFrees;
+		Result.AllocatedBytes = AllocatedBytes - Other.AllocatedBytes;
+		return Result;
+	}
+};
+
+/**
+ * FMalloc proxy that counts the allocations of every thread, for tests that check how much a piece of code allocates.
+ * Counts are kept per thread so that what other threads do meanwhile doesn't show up. The proxy doesn't own any block,
+ * so it can be installed over GMalloc at any time, by the first call to Enable.
+ */
+class CORE_API FMallocCountingProxy final : public FMalloc
+{
+public:
+	explicit FMallocCountingProxy(FMalloc* InMalloc)
+		: UsedMalloc(InMalloc)
+	{
+		checkf(UsedMalloc, TEXT("FMallocCountingProxy is used without a valid malloc!"));
+	}
+
+	/**
+	 * Installs the proxy over GMalloc if it isn't yet.
+	 * @return false if this platform's GMalloc can't be wrapped
+	 */
+	static bool Enable();
+
+	static bool IsEnabled();
+
+	/** @return the counts of the calling thread since the proxy was installed */
+	static FMallocThreadCounts GetThreadCounts();
+
+	// FMalloc interface begin
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override;
+	virtual void Free(void* Ptr) override;
+
+	virtual void InitializeStatsMetadata() override
+	{
+		UsedMalloc->InitializeStatsMetadata();
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return UsedMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual void UpdateStats() override
+	{
+		UsedMalloc->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& out_Stats) override
+	{
+		UsedMalloc->GetAllocatorStats(out_Stats);
+	}
+
+	virtual void DumpAllocatorStats(class FOutputDevice& Ar) override
+	{
+		UsedMalloc->DumpAllocatorStats(Ar);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return UsedMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return UsedMalloc->ValidateHeap();
+	}
+
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+	{
+		return UsedMalloc->Exec(InWorld, Cmd, Ar);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return UsedMalloc->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return UsedMalloc->GetDescriptiveName();
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		UsedMalloc->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	// FMalloc interface end
+
+private:
+	/** Malloc we're based on, aka using under the hood */
+	FMalloc* UsedMalloc;
+};
@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformMemory.h"
+
+class FString;
+
+/**
+ * FMalloc proxy that puts a small random sample of allocations on pages of their own between inaccessible guard pages,
+ * cheap enough to leave on in production builds to catch the memory errors that FMallocStomp catches in debug ones.
+ *
+ * Every thread counts down a random number of allocations, one in SampleRate on average, before the next one is sampled.
+ * A sampled allocation gets a slot of a fixed pool. It is placed against the start or the end of its page at random, so
+ * that reads and writes past either end fault on the guard page next to it, and the page is made inaccessible once freed
+ * so that a use after free faults as well, until the slot is handed out again. Slots are reused oldest freed first.
+ * Allocations that are not sampled cost a decrement on the way in and a range check on the way out.
+ *
+ * The stacks of the allocation and of the free of every slot are kept, the crash handlers describe faults on the pool
+ * with DescribeAddress, and double or invalid frees of sampled allocations are fatal errors with the same report.
+ *
+ * Use -guardedmalloc or -guardedmalloc=<rate> to install the proxy, or Memory.UseGuardedSampling at runtime.
+ */
+class CORE_API FMallocGuardedSamplingProxy final : public FMalloc
+{
+public:
+	/** Default mean number of allocations between two samples. */
+	static const uint32 DefaultSampleRate = 5000;
+
+	/** Default number of allocations that can be guarded at a time, each one takes a page and a guard page. */
+	static const uint32 DefaultNumSlots = 256;
+
+	/** Maximum number of frames kept per allocation and per free. */
+	static const uint32 MaxCallStackDepth = 32;
+
+	FMallocGuardedSamplingProxy(FMalloc* InMalloc, uint32 InSampleRate, uint32 InNumSlots = DefaultNumSlots);
+	virtual ~FMallocGuardedSamplingProxy();
+
+	/** Wraps the allocator in a guarded sampling proxy if enabled with -guardedmalloc, returns the allocator to use. */
+	static FMalloc* OverrideIfEnabled(FMalloc* InUsedAlloc);
+
+	/**
+	 * Describes an access to Address if it is in the pool of the installed proxy, with the kind of error, the allocation
+	 * it is closest to, and where that allocation was made and freed. Meant for crash handlers, does not take any lock.
+	 *
+	 * @return False if there is no proxy or Address is not one of its pages
+	 */
+	static bool DescribeAddress(const void* Address, FString& OutDescription);
+
+	// FMalloc interface begin
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override;
+	virtual void Free(void* Ptr) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void DumpAllocatorStats(class FOutputDevice& Ar) override;
+
+	virtual void InitializeStatsMetadata() override
+	{
+		UsedMalloc->InitializeStatsMetadata();
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return UsedMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual void UpdateStats() override
+	{
+		UsedMalloc->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& out_Stats) override
+	{
+		UsedMalloc->GetAllocatorStats(out_Stats);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return UsedMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return UsedMalloc->ValidateHeap();
+	}
+
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+	{
+		return UsedMalloc->Exec(InWorld, Cmd, Ar);
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return UsedMalloc->GetDescriptiveName();
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		UsedMalloc->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	// FMalloc interface end
+
+private:
+	/** What the proxy knows of the allocation in a slot, kept after it is freed for the reports. */
+	struct FSlot
+	{
+		UPTRINT Address;
+		SIZE_T Size;
+		uint32 AllocThreadId;
+		uint32 FreeThreadId;
+		uint32 NumAllocFrames;
+		uint32 NumFreeFrames;
+		bool bFreed;
+		uint64 AllocCallStack[MaxCallStackDepth];
+		uint64 FreeCallStack[MaxCallStackDepth];
+	};
+
+	FORCEINLINE bool IsInPool(const void* Ptr) const
+	{
+		return UPTRINT(Ptr) - PoolBegin < PoolSize;
+	}
+
+	/** Draws the next sampling point of the current thread and returns a guarded allocation, or null to use UsedMalloc. */
+	FORCENOINLINE void* SampleAllocation(SIZE_T Size, uint32 Alignment);
+
+	/** Frees an allocation of the pool, raising a fatal error for a pointer that is not a live guarded allocation. */
+	FORCENOINLINE void GuardedFree(void* Ptr);
+
+	/** Index of the slot whose page holds Address, or of the slot closest to it on a guard page, INDEX_NONE for the guard before the first slot. */
+	int32 GetSlotIndex(UPTRINT Address) const;
+
+	FORCEINLINE UPTRINT GetSlotPage(int32 SlotIndex) const
+	{
+		return PoolBegin + (2 * SIZE_T(SlotIndex) + 1) * PageSize;
+	}
+
+	void Describe(UPTRINT Address, const TCHAR* Error, FString& OutDescription) const;
+
+	/** Malloc we're based on, aka using under the hood */
+	FMalloc* UsedMalloc;
+
+	/** Mean number of allocations between two samples. */
+	uint32 SampleRate;
+
+	uint32 NumSlots;
+
+	/** Size of a slot and of a guard page, the commit granularity of the platform. */
+	SIZE_T PageSize;
+
+	/** A guard page before every slot and one after the last, none of the pages is accessible unless its slot is in use. */
+	FPlatformMemory::FPlatformVirtualMemoryBlock Pool;
+	UPTRINT PoolBegin;
+	SIZE_T PoolSize;
+
+	/** Allocated from the OS, not from UsedMalloc, so that heap corruption cannot reach it. */
+	FSlot* Slots;
+
+	/** Ring of the freed slots, the oldest ones first. */
+	int32* FreedSlots;
+
+	FCriticalSection SlotsCritical;
+	uint32 NumNeverUsedSlots;
+	uint32 FreedSlotsHead;
+	uint32 NumFreedSlots;
+	uint64 NumSampled;
+	uint64 NumPoolFull;
+};
+
+/** Set by the platform from the command line before GMalloc is created, zero leaves the proxy off. */
+extern CORE_API uint32 GMallocGuardedSamplingRate;
@@ -4,6 +4,8 @@
 #include "CoreTypes.h"
 #include "HAL/PlatformMemory.h"
 #include "HAL/MemoryBase.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/Optional.h"
 
 #if !defined(PLATFORM_SUPPORTS_MIMALLOC)
 #	define PLATFORM_SUPPORTS_MIMALLOC 0
@@ -47,4 +49,89 @@ protected:
 	}
 };
 
+struct mi_heap_s;
+
+/**
+ * A mimalloc heap of its own, for the allocations of a subsystem that all go away together, such as the data of a level
+ * or of a request. Its blocks are kept apart from the rest of the heap, and they can all be released at once with
+ * Reset, whatever their number, instead of freeing them one by one.
+ *
+ * mimalloc heaps belong to a thread: a heap has to be created, allocated from, reset and destroyed on the same thread,
+ * its blocks can be freed from any thread. Blocks are freed with Free, or with FMemory::Free when GMalloc is mimalloc.
+ */
+class CORE_API FMimallocHeap
+{
+public:
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	/** @param InLLMTag Tag the allocations of the heap are tracked under, Untagged to use the tag in scope */
+	explicit FMimallocHeap(const TCHAR* InName, ELLMTag InLLMTag = ELLMTag::Untagged);
+#else
+	explicit FMimallocHeap(const TCHAR* InName);
+#endif
+
+	/** The blocks still allocated are not freed, they move to the default heap of the thread */
+	~FMimallocHeap();
+
+	FMimallocHeap(const FMimallocHeap&) = delete;
+	FMimallocHeap& operator=(const FMimallocHeap&) = delete;
+
+	/** @return Whether GMalloc is mimalloc, FMimallocHeapScope does not change anything otherwise */
+	static bool IsGMallocMimalloc();
+
+	void* Malloc(SIZE_T Size, uint32 Alignment = DEFAULT_ALIGNMENT);
+	void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment = DEFAULT_ALIGNMENT);
+	static void Free(void* Ptr);
+
+	/**
+	 * Frees all the blocks of the heap at once, without running any destructor. No pointer to them may be used after
+	 * this, nor be tracked by anything but LLM, such as a GMalloc proxy: the blocks are not freed through GMalloc.
+	 * Not allowed within a FMimallocHeapScope of the heap.
+	 */
+	void Reset();
+
+	/** @return Whether Ptr is a block of this heap */
+	bool Contains(const void* Ptr) const;
+
+	/** Adds up the bytes of the blocks in use and of the pages the heap holds, walks the pages of the heap */
+	void GetStats(SIZE_T& OutUsedSize, SIZE_T& OutCommittedSize) const;
+
+	const TCHAR* GetName() const
+	{
+		return Name;
+	}
+
+private:
+	friend class FMimallocHeapScope;
+
+	void CheckOwnerThread() const;
+
+	mi_heap_s* Heap;
+	const TCHAR* Name;
+	uint32 OwnerThreadId;
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	ELLMTag LLMTag;
+#endif
+};
+
+/**
+ * Makes Heap the heap the FMallocMimalloc allocations of this thread go to while in scope, so that containers and other
+ * code that allocate with FMemory fill it, and tags them with the LLM tag of the heap. Scopes nest. Has no effect on
+ * allocations if GMalloc is not mimalloc, which IsGMallocMimalloc tells.
+ */
+class CORE_API FMimallocHeapScope
+{
+public:
+	explicit FMimallocHeapScope(FMimallocHeap& Heap);
+	~FMimallocHeapScope();
+
+	FMimallocHeapScope(const FMimallocHeapScope&) = delete;
+	FMimallocHeapScope& operator=(const FMimallocHeapScope&) = delete;
+
+private:
+	mi_heap_s* PreviousHeap;
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	TOptional<FLLMScope> LLMScope;
+#endif
+};
+
 #endif
@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/Set.h"
+
+/**
+ * FMalloc proxy that samples allocations for heap profiling, cheap enough to leave on in production builds.
+ *
+ * Allocations are sampled by bytes rather than by count: every thread draws the number of bytes until its next sample from
+ * an exponential distribution, so on average one sample is taken per SampleInterval bytes allocated and large allocations
+ * are proportionally more likely to be picked. The call stacks of sampled allocations are captured with FPlatformStackWalk
+ * and sent over the HeapSampling trace channel together with an estimate of how many bytes each sample stands for, frees
+ * of sampled allocations are sent as well so that the live heap can be rebuilt.
+ *
+ * Use -heapsampling or -heapsampling=<bytes> to install the proxy, and -trace=heapsampling to record the samples.
+ */
+class CORE_API FMallocSamplingProxy final : public FMalloc
+{
+public:
+	/** Default mean number of bytes allocated between two samples. */
+	static const uint64 DefaultSampleInterval = 512 * 1024;
+
+	/** Maximum number of frames captured per sample. */
+	static const uint32 MaxCallStackDepth = 64;
+
+	FMallocSamplingProxy(FMalloc* InMalloc, uint64 InSampleInterval);
+
+	/** Wraps the allocator in a sampling proxy if enabled with -heapsampling, returns the allocator to use. */
+	static FMalloc* OverrideIfEnabled(FMalloc* InUsedAlloc);
+
+	// FMalloc interface begin
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override;
+	virtual void Free(void* Ptr) override;
+
+	virtual void InitializeStatsMetadata() override
+	{
+		UsedMalloc->InitializeStatsMetadata();
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return UsedMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual void UpdateStats() override
+	{
+		UsedMalloc->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& out_Stats) override
+	{
+		UsedMalloc->GetAllocatorStats(out_Stats);
+	}
+
+	virtual void DumpAllocatorStats(class FOutputDevice& Ar) override
+	{
+		UsedMalloc->DumpAllocatorStats(Ar);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return UsedMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return UsedMalloc->ValidateHeap();
+	}
+
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+	{
+		return UsedMalloc->Exec(InWorld, Cmd, Ar);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return UsedMalloc->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return UsedMalloc->GetDescriptiveName();
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		UsedMalloc->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	// FMalloc interface end
+
+private:
+	/** Number of counters in the filter that tells frees whether their pointer might have been sampled. */
+	static const uint32 NumFilterCounters = 16384;
+
+	/** Takes a sample of an allocation that made the current thread cross its sampling point. */
+	FORCENOINLINE void SampleAllocation(void* Ptr, SIZE_T Size, uint32 Alignment);
+
+	/** Reports the free of an allocation if it was sampled. */
+	FORCENOINLINE void OnSampledFree(void* Ptr);
+
+	/** Returns the next distance in bytes to sample at for the current thread. */
+	int64 DrawSampleDistance();
+
+	FORCEINLINE static uint32 GetFilterIndex(const void* Ptr)
+	{
+		return uint32(((uint64)(UPTRINT)Ptr * 0x9E3779B97F4A7C15ull) >> 50);
+	}
+
+	FORCEINLINE bool MightBeSampled(const void* Ptr) const
+	{
+		return SampledFilter[GetFilterIndex(Ptr)] != 0;
+	}
+
+	/** Malloc we're based on, aka using under the hood */
+	FMalloc* UsedMalloc;
+
+	/** Mean number of bytes between two samples. */
+	uint64 SampleInterval;
+
+	/** Counting filter over the addresses of live samples, a zero counter means the pointer was not sampled. */
+	volatile int32 SampledFilter[NumFilterCounters];
+
+	/** Live samples, only looked up when the filter hits. */
+	FCriticalSection SampledAllocationsCritical;
+	TSet<const void*> SampledAllocations;
+};
+
+/** Set by the platform from the command line before GMalloc is created, zero leaves sampling off. */
+extern CORE_API uint64 GMallocSamplingProxyInterval;
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/PlatformAffinity.h"
+#include "Templates/Atomic.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+class FEvent;
+
+/**
+ * System threads that park instead of exiting when their function returns, so that FThread, AsyncThread and
+ * Async(EAsyncExecution::Thread) don't pay for creating a thread and its stack for every short lived job.
+ * A parked thread is only reused for a function that asks for the same stack size. Its name, priority and
+ * affinity are changed to the requested ones before that function is called.
+ * Threads that stayed parked for ParkedThreadPool.IdleSeconds exit, and at most ParkedThreadPool.MaxThreads of them
+ * are parked at a time, 0 to never reuse threads.
+ *
+ * Thread local state that a function leaves behind is seen by the next function to run on that thread,
+ * FTlsAutoCleanup objects included, as it is only cleaned up when the thread exits.
+ */
+class CORE_API FParkedThreadPool
+{
+public:
+	/** A function given to Launch, to find out when it returned */
+	class CORE_API FTask
+	{
+	public:
+		FTask();
+		~FTask();
+
+		FTask(const FTask&) = delete;
+		FTask& operator=(const FTask&) = delete;
+
+		/** Blocks until the function returned */
+		void Wait();
+
+		/** @return true once the function returned */
+		bool IsDone() const
+		{
+			return bDone;
+		}
+
+		/** @return ID of the thread running the function */
+		uint32 GetThreadId() const
+		{
+			return ThreadId;
+		}
+
+	private:
+		friend class FParkedThreadPool;
+		friend class FParkedThread;
+
+		FEvent* DoneEvent;
+		TAtomic<bool> bDone;
+		uint32 ThreadId;
+	};
+
+	/**
+	 * Runs a function on a parked thread, or a new one when none can be reused.
+	 *
+	 * @param ThreadName Name of the thread
+	 * @param Function The function to call on the thread
+	 * @param StackSize The size of the stack to create. 0 means use the current thread's stack size
+	 * @param ThreadPriority The priority to run the function at
+	 * @param ThreadAffinityMask The cores the function can run on
+	 * @return The task of the function, or an invalid pointer if no thread could be started, like when multithreading is disabled
+	 */
+	static TSharedPtr<FTask, ESPMode::ThreadSafe> Launch(
+		const TCHAR* ThreadName,
+		TUniqueFunction<void()>&& Function,
+		uint32 StackSize = 0,
+		EThreadPriority ThreadPriority = TPri_Normal,
+		uint64 ThreadAffinityMask = FPlatformAffinity::GetNoAffinityMask()
+	);
+
+	/** @return How many threads are parked right now */
+	static int32 GetNumParkedThreads();
+};
@@ -177,11 +177,32 @@
 #ifndef PLATFORM_ALWAYS_HAS_SSE4_1
 	#define PLATFORM_ALWAYS_HAS_SSE4_1			0
 #endif
+#ifndef PLATFORM_ALWAYS_HAS_AVX
+	// Set when the target is compiled for AVX, e.g. with -mavx or /arch:AVX
+	#if defined(__AVX__)
+		#define PLATFORM_ALWAYS_HAS_AVX			1
+	#else
+		#define PLATFORM_ALWAYS_HAS_AVX			0
+	#endif
+#endif
 #ifndef PLATFORM_MAYBE_HAS_AVX
-	#define PLATFORM_MAYBE_HAS_AVX				0
+	#define PLATFORM_MAYBE_HAS_AVX				PLATFORM_ALWAYS_HAS_AVX
 #endif
-#ifndef PLATFORM_ALWAYS_HAS_AVX
-	#define PLATFORM_ALWAYS_HAS_AVX				0
+#ifndef PLATFORM_ALWAYS_HAS_FMA3
+	// Set when the target is compiled for FMA3, e.g. with -mfma or /arch:AVX2
+	#if PLATFORM_ALWAYS_HAS_AVX && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define PLATFORM_ALWAYS_HAS_FMA3		1
+	#else
+		#define PLATFORM_ALWAYS_HAS_FMA3		0
+	#endif
+#endif
+#ifndef PLATFORM_ALWAYS_HAS_F16C
+	// Set when the target is compiled for F16C half conversions, e.g. with -mf16c or /arch:AVX2
+	#if PLATFORM_ALWAYS_HAS_AVX && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+		#define PLATFORM_ALWAYS_HAS_F16C		1
+	#else
+		#define PLATFORM_ALWAYS_HAS_F16C		0
+	#endif
 #endif
 
 
@@ -243,6 +264,13 @@
 #ifndef PLATFORM_COMPILER_HAS_FOLD_EXPRESSIONS
 	#define PLATFORM_COMPILER_HAS_FOLD_EXPRESSIONS 0
 #endif
+#ifndef PLATFORM_COMPILER_HAS_COROUTINES
+	#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+		#define PLATFORM_COMPILER_HAS_COROUTINES 1
+	#else
+		#define PLATFORM_COMPILER_HAS_COROUTINES 0
+	#endif
+#endif
 #ifndef PLATFORM_TCHAR_IS_1_BYTE
 	#define PLATFORM_TCHAR_IS_1_BYTE			0
 #endif
@@ -270,6 +298,11 @@
 #ifndef PLATFORM_USE_PTHREADS
 	#define PLATFORM_USE_PTHREADS				1
 #endif
+// Whether per thread data reached from inline code can live in thread_local variables instead of FPlatformTLS slots,
+// which needs every module in one binary so that they all share one variable that is reached without a call
+#ifndef PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+	#define PLATFORM_USES_THREAD_LOCAL_FOR_TLS	(IS_MONOLITHIC && (PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC))
+#endif
 #ifndef PLATFORM_MAX_FILEPATH_LENGTH_DEPRECATED
 	#define PLATFORM_MAX_FILEPATH_LENGTH_DEPRECATED		128			// Deprecated - prefer FPlatformMisc::GetMaxPathLength() instead.
 #endif
@@ -620,6 +653,9 @@
 #ifndef RESTRICT
 	#define RESTRICT __restrict						/* no alias hint */
 #endif
+#ifndef TLS_INITIAL_EXEC
+	#define TLS_INITIAL_EXEC						/* Reach a thread_local variable at a fixed offset from the thread pointer */
+#endif
 
 /* Wrap a function signature in these to warn that callers should not ignore the return value */
 #ifndef FUNCTION_CHECK_RETURN_START
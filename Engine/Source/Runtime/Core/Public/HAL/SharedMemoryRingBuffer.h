@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+
+/**
+ * Queue of messages between processes in a named shared memory region, so that messages are copied once into the
+ * region and once out of it instead of through the kernel as with FPlatformNamedPipe.
+ *
+ * One process creates the ring and any number of processes open it by name. Any number of threads of those processes
+ * can write messages, they take turns through a lock in the region, and one thread at a time reads them in order.
+ * Readers and writers only block once the ring is empty or full, and are woken through a futex on Linux and Android,
+ * named semaphores on Windows, and by polling with short sleeps elsewhere.
+ */
+class CORE_API FSharedMemoryRingBuffer
+{
+public:
+	/**
+	 * Creates the shared memory region of a ring.
+	 *
+	 * @param Name Name of the ring, unique on the machine and without slashes.
+	 * @param Capacity Bytes of messages the ring can hold, rounded up to a power of two.
+	 * @return The ring, or nullptr if the region can't be created.
+	 */
+	static FSharedMemoryRingBuffer* Create(const FString& Name, uint32 Capacity);
+
+	/**
+	 * Opens a ring created by another process, or by this one.
+	 *
+	 * @param Name Name of the ring.
+	 * @param Capacity Capacity that the ring was created with.
+	 * @return The ring, or nullptr if there is no such ring or it was created with another capacity.
+	 */
+	static FSharedMemoryRingBuffer* Open(const FString& Name, uint32 Capacity);
+
+	~FSharedMemoryRingBuffer();
+
+	/**
+	 * Copies a message into the ring, waiting for a reader to make room for it if the ring is full.
+	 *
+	 * @param Data The message.
+	 * @param Size Bytes in the message, at most GetMaxMessageSize.
+	 * @param WaitTimeMs How long to wait for room, MAX_uint32 to wait as long as it takes.
+	 * @return false if the message is too large or there was no room in time.
+	 */
+	bool Write(const void* Data, uint32 Size, uint32 WaitTimeMs = MAX_uint32);
+
+	/**
+	 * Copies the oldest message out of the ring, waiting for a writer if the ring is empty. Only one thread at a time may read.
+	 *
+	 * @param OutData Receives the message.
+	 * @param WaitTimeMs How long to wait for a message, MAX_uint32 to wait as long as it takes.
+	 * @return false if there was no message in time.
+	 */
+	bool Read(TArray<uint8>& OutData, uint32 WaitTimeMs = MAX_uint32);
+
+	/** Returns the size of the largest message the ring takes */
+	uint32 GetMaxMessageSize() const;
+
+private:
+	struct FHeader;
+
+	FSharedMemoryRingBuffer(FPlatformMemory::FSharedMemoryRegion* InRegion, uint32 InCapacity);
+
+	static FSharedMemoryRingBuffer* MapRing(const FString& Name, uint32 Capacity, bool bCreate);
+
+	/** Blocks until the value changes from Expected or the time runs out, returns false on timeout */
+	bool WaitForChange(volatile int32* Value, int32 Expected, volatile int32* NumWaiters, volatile int32* bWakePending, FPlatformProcess::FSemaphore* Semaphore, uint32 WaitTimeMs);
+	void WakeWaiters(volatile int32* Value, volatile int32* NumWaiters, volatile int32* bWakePending, FPlatformProcess::FSemaphore* Semaphore);
+
+	/** Offset of the messages in the region, after the header */
+	static SIZE_T GetDataOffset();
+	FHeader& GetHeader() const;
+	uint8* GetData() const;
+
+	FPlatformMemory::FSharedMemoryRegion* Region;
+	uint32 Capacity;
+
+	/** Wake readers and writers on platforms without futexes on shared memory */
+	FPlatformProcess::FSemaphore* DataSemaphore;
+	FPlatformProcess::FSemaphore* SpaceSemaphore;
+};
@@ -19,6 +19,7 @@
  *		// ... continue in the caller thread
  *		Thread.Join();
  * For more verbose example check `TestTypicalUseCase` in `ThreadTest.cpp`
+ * The system thread comes from FParkedThreadPool, it can have run other functions before, its thread local state included.
  */
 class CORE_API FThread final
 {
@@ -97,5 +98,5 @@ public:
 #endif
 
 private:
-	TSharedPtr<class FThreadImpl, ESPMode::ThreadSafe> Impl; // "shared" with `FThreadImpl::Self`
+	TSharedPtr<class FThreadImpl, ESPMode::ThreadSafe> Impl;
 };
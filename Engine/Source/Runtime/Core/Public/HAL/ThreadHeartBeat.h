@@ -219,6 +219,12 @@ class CORE_API FGameThreadHitchHeartBeatThreaded : public FRunnable
 
 	bool bWalkStackOnHitch;
 
+	/** Whether to write a hitch bundle with the trace flight recorder and the stacks of all threads on hitches */
+	bool bWriteBundleOnHitch;
+	/** When the last hitch bundle was written, bundles are rate limited */
+	double LastBundleTime;
+	int32 NumBundlesWritten;
+
 	double FirstStartTime;
 	double FrameStartTime;
 
@@ -236,6 +242,9 @@ class CORE_API FGameThreadHitchHeartBeatThreaded : public FRunnable
 
 	void InitSettings();
 
+	/** Writes a hitch bundle to the Hitches directory of the project log directory, unless one was written too recently */
+	void WriteHitchBundle(double HitchSeconds);
+
 	FGameThreadHitchHeartBeatThreaded();
 	virtual ~FGameThreadHitchHeartBeatThreaded();
 
@@ -73,6 +73,17 @@ protected:
 	/** Thread ID of this thread singleton. */
 	const uint32 ThreadId;
 
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+	/**
+	 * @return the instance of the current thread once it has been found in its TLS slot, so later accesses don't call into the OS.
+	 */
+	FORCEINLINE static T*& GetThreadInstance()
+	{
+		static thread_local T* ThreadInstance TLS_INITIAL_EXEC = nullptr;
+		return ThreadInstance;
+	}
+#endif
+
 public:
 
 	/**
@@ -80,7 +91,16 @@ public:
 	 */
 	FORCEINLINE static T& Get()
 	{
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+		T*& ThreadInstance = GetThreadInstance();
+		if (!ThreadInstance)
+		{
+			ThreadInstance = (T*)FThreadSingletonInitializer::Get( [](){ return (FTlsAutoCleanup*)new T(); }, T::GetTlsSlot() ); //-V572
+		}
+		return *ThreadInstance;
+#else
 		return *(T*)FThreadSingletonInitializer::Get( [](){ return (FTlsAutoCleanup*)new T(); }, T::GetTlsSlot() ); //-V572
+#endif
 	}
 
 	/**
@@ -89,7 +109,16 @@ public:
 	 */
 	FORCEINLINE static T& Get(TFunctionRef<FTlsAutoCleanup*()> CreateInstance)
 	{
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+		T*& ThreadInstance = GetThreadInstance();
+		if (!ThreadInstance)
+		{
+			ThreadInstance = (T*)FThreadSingletonInitializer::Get(CreateInstance, T::GetTlsSlot()); //-V572
+		}
+		return *ThreadInstance;
+#else
 		return *(T*)FThreadSingletonInitializer::Get(CreateInstance, T::GetTlsSlot()); //-V572
+#endif
 	}
 
 	/**
@@ -97,6 +126,15 @@ public:
 	 */
 	FORCEINLINE static T* TryGet()
 	{
+#if PLATFORM_USES_THREAD_LOCAL_FOR_TLS
+		T*& ThreadInstance = GetThreadInstance();
+		if (!ThreadInstance)
+		{
+			ThreadInstance = (T*)FThreadSingletonInitializer::TryGet( T::GetTlsSlot() );
+		}
+		return ThreadInstance;
+#else
 		return (T*)FThreadSingletonInitializer::TryGet( T::GetTlsSlot() );
+#endif
 	}
 };
\ No newline at end of file
@@ -141,6 +141,24 @@ struct CORE_API FMemory
 		return FPlatformMemory::StreamingMemcpy(Dest,Src,Count);
 	}
 
+	/**
+	 * Copies a block too large to stay in the caches with stores that bypass them, AVX ones when the processor has them,
+	 * so that the copy neither evicts what other code is using nor reads the destination in first. Blocks smaller than
+	 * memory.NonTemporalThreshold and processors without such stores get a plain Memcpy.
+	 * The copy is only ordered with the stores that follow it on the calling thread, other threads need a barrier.
+	 */
+	static void* NonTemporalMemcpy(void* Dest, const void* Src, SIZE_T Count);
+
+	/** Same as NonTemporalMemcpy, to fill a block with Char */
+	static void* NonTemporalMemset(void* Dest, uint8 Char, SIZE_T Count);
+
+	/**
+	 * Copies a block of at least memory.ParallelMemcpyThreshold on the task graph workers as well as on this thread, each
+	 * one copying a contiguous range of whole destination pages with NonTemporalMemcpy. Smaller blocks, or copies made while
+	 * the task graph is not running, are a NonTemporalMemcpy on this thread. Returns once the whole block is copied.
+	 */
+	static void* ParallelMemcpy(void* Dest, const void* Src, SIZE_T Count);
+
 	static FORCEINLINE void Memswap( void* Ptr1, void* Ptr2, SIZE_T Size )
 	{
 		FPlatformMemory::Memswap(Ptr1,Ptr2,Size);
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+/**
+ * XXH3, the 64 and 128 bit hashes of the xxHash family by Yann Collet, see https://github.com/Cyan4973/xxHash.
+ *
+ * They produce the same values as the reference XXH3_64bits and XXH3_128bits with the default secret and no seed,
+ * so hashes can be compared with other tools. On large inputs they process 64 bytes at a time with SSE2 or NEON, several
+ * times faster than FCrc::MemCrc32, and short inputs take a handful of multiplies.
+ * They are not cryptographic hashes.
+ */
+struct FXxHash64
+{
+	uint64 Hash = 0;
+
+	/** Hashes a buffer in one go, use FXxHash64Builder when the data arrives in parts */
+	CORE_API static FXxHash64 HashBuffer(const void* Data, uint64 Size);
+
+	inline bool operator==(const FXxHash64& Other) const
+	{
+		return Hash == Other.Hash;
+	}
+
+	inline bool operator!=(const FXxHash64& Other) const
+	{
+		return Hash != Other.Hash;
+	}
+
+	friend inline uint32 GetTypeHash(const FXxHash64& InHash)
+	{
+		return (uint32)InHash.Hash;
+	}
+};
+
+struct FXxHash128
+{
+	uint64 HashLow = 0;
+	uint64 HashHigh = 0;
+
+	/** Hashes a buffer in one go, use FXxHash128Builder when the data arrives in parts */
+	CORE_API static FXxHash128 HashBuffer(const void* Data, uint64 Size);
+
+	inline bool operator==(const FXxHash128& Other) const
+	{
+		return HashLow == Other.HashLow && HashHigh == Other.HashHigh;
+	}
+
+	inline bool operator!=(const FXxHash128& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend inline uint32 GetTypeHash(const FXxHash128& InHash)
+	{
+		return (uint32)InHash.HashLow;
+	}
+};
+
+namespace UE4XxHash_Private
+{
+	/** The XXH3 streaming state shared by the 64 and 128 bit builders */
+	struct CORE_API FStreamState
+	{
+		static constexpr uint32 BufferSize = 256;
+
+		alignas(16) uint64 Acc[8];
+		alignas(16) uint8 Buffer[BufferSize];
+		uint64 TotalSize;
+		uint32 BufferedSize;
+		uint32 NumStripesInBlock;
+
+		void Reset();
+		void Update(const void* Data, uint64 Size);
+
+		/** Accumulates the buffered data over a copy of the state, for inputs longer than the short hash paths */
+		void FinalizeAcc(uint64 (&OutAcc)[8]) const;
+	};
+}
+
+/** Computes the hash of data passed in parts, giving the same value as FXxHash64::HashBuffer on the whole data */
+class CORE_API FXxHash64Builder
+{
+public:
+	FXxHash64Builder()
+	{
+		Reset();
+	}
+
+	inline void Reset()
+	{
+		State.Reset();
+	}
+
+	inline void Update(const void* Data, uint64 Size)
+	{
+		State.Update(Data, Size);
+	}
+
+	/** @return The hash of the data so far, more data can still be added afterwards */
+	FXxHash64 Finalize() const;
+
+private:
+	UE4XxHash_Private::FStreamState State;
+};
+
+/** Computes the hash of data passed in parts, giving the same value as FXxHash128::HashBuffer on the whole data */
+class CORE_API FXxHash128Builder
+{
+public:
+	FXxHash128Builder()
+	{
+		Reset();
+	}
+
+	inline void Reset()
+	{
+		State.Reset();
+	}
+
+	inline void Update(const void* Data, uint64 Size)
+	{
+		State.Update(Data, Size);
+	}
+
+	/** @return The hash of the data so far, more data can still be added afterwards */
+	FXxHash128 Finalize() const;
+
+private:
+	UE4XxHash_Private::FStreamState State;
+};
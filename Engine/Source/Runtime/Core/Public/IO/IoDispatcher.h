@@ -10,6 +10,8 @@
 #include "Templates/UnrealTemplate.h"
 #include "Templates/TypeCompatibleBytes.h"
 #include "HAL/PlatformAtomics.h"
+#include "Misc/EnumClassFlags.h"
+#include "UObject/NameTypes.h"
 
 #if __cplusplus >= 201703L
 #	define UE_NODISCARD		[[nodiscard]]
@@ -46,7 +48,8 @@ enum class EIoErrorCode
 	NotFound,
 	CorruptToc,
 	UnknownChunkID,
-	InvalidParameter
+	InvalidParameter,
+	ReadError
 };
 
 /**
@@ -374,6 +377,8 @@ TIoStatusOr<T>& TIoStatusOr<T>::operator=(const TIoStatusOr<U>& Other)
 	return *this;
 }
 
+class IMappedFileRegion;
+
 /** Reference to buffer data used by I/O dispatcher APIs
   */
 class FIoBuffer
@@ -391,6 +396,9 @@ public:
 	CORE_API			FIoBuffer(ECloneTag,			const void* Data, uint64 InSize);
 	CORE_API			FIoBuffer(EWrapTag,				const void* Data, uint64 InSize);
 
+	/** Read-only buffer of a mapped file region, the region is deleted (unmapped) with the last reference to the buffer or its views */
+	CORE_API			FIoBuffer(EAssumeOwnershipTag,	IMappedFileRegion* MappedRegion);
+
 	// Note: we currently rely on implicit move constructor, thus we do not declare any
 	//		 destructor or copy/assignment operators or copy constructors
 
@@ -400,6 +408,13 @@ public:
 
 	inline void			SetSize(uint64 InSize)	{ return CorePtr->SetSize(InSize); }
 
+	/** View of part of the buffer that shares ownership of it, nothing is copied and the buffer lives as long as its views */
+	inline FIoBuffer	Slice(uint64 Offset, uint64 InSize) const
+	{
+		check(Offset <= DataSize() && InSize <= DataSize() - Offset);
+		return FIoBuffer(Data() + Offset, InSize, *this);
+	}
+
 	inline bool			IsAvailable() const;
 	inline bool			IsMemoryOwned() const	{ return CorePtr->IsMemoryOwned(); }
 
@@ -421,6 +436,7 @@ private:
 					BufCore(const uint8* InData, uint64 InSize, bool InOwnsMemory);
 					BufCore(const uint8* InData, uint64 InSize, const BufCore* InOuter);
 					BufCore(ECloneTag, uint8* InData, uint64 InSize);
+		explicit	BufCore(IMappedFileRegion* InMappedRegion);
 
 					BufCore(const BufCore& Rhs) = delete;
 		
@@ -488,6 +504,9 @@ private:
 		// Ultimately this should probably just be an index into a pool
 		TRefCountPtr<const BufCore>	OuterCore;
 
+		// Mapped file region backing DataPtr, owned by this instance
+		IMappedFileRegion*			MappedRegion = nullptr;
+
 		// TODO: These two could be packed in the MSB of DataPtr on x64
 		uint8		DataSizeHigh = 0;	// High 8 bits of size (40 bits total)
 		uint8		Flags = 0;
@@ -639,6 +658,26 @@ static FIoChunkId CreateBulkdataChunkId(int32 GlobalPackageId, int64 BulkDataChu
 
 //////////////////////////////////////////////////////////////////////////
 
+enum class EIoReadOptionsFlags : uint32
+{
+	None			= 0,
+	/** Return a read-only view into a memory mapping of the container instead of copying the chunk, when the platform supports it */
+	MemoryMapped	= 1 << 0,
+};
+ENUM_CLASS_FLAGS(EIoReadOptionsFlags);
+
+/** Quality of service classes, the dispatcher shares the bandwidth between them by the s.IoDispatcherQos console variables */
+enum class EIoQosClass : uint8
+{
+	/** Loads something is blocked on, never held back */
+	Critical,
+	/** Regular streaming */
+	Normal,
+	/** Prefetching and other reads that nothing waits for yet */
+	Background,
+	Count
+};
+
 class FIoReadOptions
 {
 public:
@@ -677,11 +716,61 @@ public:
 		return TargetVa;
 	}
 
+	void SetFlags(EIoReadOptionsFlags InFlags)
+	{
+		Flags = InFlags;
+	}
+
+	EIoReadOptionsFlags GetFlags() const
+	{
+		return Flags;
+	}
+
+	/** Higher priority reads are issued first when the dispatcher submits several reads at once */
+	void SetPriority(int32 InPriority)
+	{
+		Priority = InPriority;
+	}
+
+	int32 GetPriority() const
+	{
+		return Priority;
+	}
+
+	/** Reads of equal priority are dispatched earliest deadline first, in FPlatformTime::Cycles64. Reads without one go last. */
+	void SetDeadline(uint64 InDeadlineCycles)
+	{
+		Deadline = InDeadlineCycles;
+	}
+
+	uint64 GetDeadline() const
+	{
+		return Deadline;
+	}
+
+	bool HasDeadline() const
+	{
+		return Deadline != MAX_uint64;
+	}
+
+	void SetQosClass(EIoQosClass InQosClass)
+	{
+		QosClass = InQosClass;
+	}
+
+	EIoQosClass GetQosClass() const
+	{
+		return QosClass;
+	}
+
 private:
 	uint64	RequestedOffset = 0;
 	uint64	RequestedSize = ~uint64(0);
 	void* TargetVa = nullptr;
-	uint32	Flags = 0;
+	EIoReadOptionsFlags	Flags = EIoReadOptionsFlags::None;
+	int32	Priority = 0;
+	EIoQosClass QosClass = EIoQosClass::Normal;
+	uint64	Deadline = MAX_uint64;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -732,6 +821,8 @@ public:
 
 	CORE_API void Issue();
 	CORE_API void Wait();
+
+	/** Completes the requests that the dispatcher hasn't started reading yet with EIoErrorCode::Cancelled, the others complete as usual */
 	CORE_API void Cancel();
 
 private:
@@ -796,6 +887,24 @@ private:
 
 //////////////////////////////////////////////////////////////////////////
 
+struct FIoStoreWriterSettings
+{
+	/** Compression method of the container, NAME_None stores the chunks as is */
+	FName CompressionMethod = NAME_None;
+
+	/** Size of the blocks chunks are split into and compressed independently, must be less than 16MB */
+	uint64 CompressionBlockSize = 64 << 10;
+
+	/** Maximum number of blocks being compressed or waiting to be written, Append waits while this many are in flight */
+	int32 MaxPendingBlocks = 256;
+
+	/**
+	 * Dictionary every block is compressed against, trained by FCompression::TrainDictionary on samples of the chunks.
+	 * It is stored in the TOC and loaded with the container. Empty to compress the blocks on their own.
+	 */
+	TArray<uint8> CompressionDictionary;
+};
+
 class FIoStoreWriter
 {
 public:
@@ -806,7 +915,15 @@ public:
 	FIoStoreWriter& operator=(const FIoStoreWriter&) = delete;
 
 	CORE_API FIoStatus	Initialize();
+	CORE_API FIoStatus	Initialize(const FIoStoreWriterSettings& Settings);
 	CORE_API FIoStatus	EnableCsvOutput();
+
+	/**
+	 * Appends a chunk to the container. May be called from several threads at once.
+	 *
+	 * Chunks are laid out in the order the calls are made, blocks of compressed containers are compressed on
+	 * the task graph and written in that same order, so the output only depends on the order of the calls.
+	 */
 	CORE_API FIoStatus	Append(FIoChunkId ChunkId, FIoBuffer Chunk, const TCHAR* Name);
 
 	/**
@@ -4,6 +4,8 @@
 
 #include "CoreTypes.h"
 #include "Containers/UnrealString.h"
+#include "Containers/StringFwd.h"
+#include "Internationalization/CulturePointer.h"
 #include "Internationalization/Text.h"
 
 /** Rules used to format or parse a decimal number */
@@ -50,7 +52,7 @@ struct FDecimalNumberFormattingRules
  * You would call FastDecimalFormat::NumberToString to convert a number to the correct decimal representation based on the given formatting rules and options.
  * You would call FastDecimalFormat::StringToNumber to convert a string containing a culture correct decimal representation of a number into an actual number.
  * The primary consumer of this is FText, however you can use it for other things. GetCultureAgnosticFormattingRules can provide formatting rules for cases where you don't care about culture.
- * @note If you use the version of FastDecimalFormat::NumberToString that takes an output string, the formatted number will be appended to the existing contents of the string.
+ * @note If you use the version of FastDecimalFormat::NumberToString that takes an output string or string builder, the formatted number will be appended to the existing contents of it.
  */
 namespace FastDecimalFormat
 {
@@ -60,6 +62,8 @@ namespace Internal
 
 CORE_API void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString);
 CORE_API void FractionalToString(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FString& OutString);
+CORE_API void IntegralToString(const bool bIsNegative, const uint64 InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FStringBuilderBase& OutString);
+CORE_API void FractionalToString(const double InVal, const FDecimalNumberFormattingRules& InFormattingRules, FNumberFormattingOptions InFormattingOptions, FStringBuilderBase& OutString);
 
 CORE_API bool StringToIntegral(const TCHAR* InStr, const int32 InStrLen, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberParsingOptions& InParsingOptions, bool& OutIsNegative, uint64& OutVal, int32* OutParsedLen);
 CORE_API bool StringToFractional(const TCHAR* InStr, const int32 InStrLen, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberParsingOptions& InParsingOptions, double& OutVal, int32* OutParsedLen);
@@ -72,6 +76,11 @@ CORE_API bool StringToFractional(const TCHAR* InStr, const int32 InStrLen, const
 		const bool bIsNegative = InVal < 0;																																							\
 		Internal::IntegralToString(bIsNegative, (bIsNegative) ? -static_cast<uint64>(InVal) : static_cast<uint64>(InVal), InFormattingRules, InFormattingOptions, OutString);						\
 	}																																																\
+	FORCEINLINE void NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions, FStringBuilderBase& OutString)	\
+	{																																																\
+		const bool bIsNegative = InVal < 0;																																							\
+		Internal::IntegralToString(bIsNegative, (bIsNegative) ? -static_cast<uint64>(InVal) : static_cast<uint64>(InVal), InFormattingRules, InFormattingOptions, OutString);						\
+	}																																																\
 	FORCEINLINE FString NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions)						\
 	{																																																\
 		FString Result;																																												\
@@ -84,6 +93,10 @@ CORE_API bool StringToFractional(const TCHAR* InStr, const int32 InStrLen, const
 	{																																																\
 		Internal::IntegralToString(false, static_cast<uint64>(InVal), InFormattingRules, InFormattingOptions, OutString);																			\
 	}																																																\
+	FORCEINLINE void NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions, FStringBuilderBase& OutString)	\
+	{																																																\
+		Internal::IntegralToString(false, static_cast<uint64>(InVal), InFormattingRules, InFormattingOptions, OutString);																			\
+	}																																																\
 	FORCEINLINE FString NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions)						\
 	{																																																\
 		FString Result;																																												\
@@ -96,6 +109,10 @@ CORE_API bool StringToFractional(const TCHAR* InStr, const int32 InStrLen, const
 	{																																																\
 		Internal::FractionalToString(static_cast<double>(InVal), InFormattingRules, InFormattingOptions, OutString);																				\
 	}																																																\
+	FORCEINLINE void NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions, FStringBuilderBase& OutString)	\
+	{																																																\
+		Internal::FractionalToString(static_cast<double>(InVal), InFormattingRules, InFormattingOptions, OutString);																				\
+	}																																																\
 	FORCEINLINE FString NumberToString(const NUMBER_TYPE InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions)						\
 	{																																																\
 		FString Result;																																												\
@@ -176,3 +193,47 @@ FAST_DECIMAL_PARSE_FRACTIONAL_IMPL(double)
 CORE_API const FDecimalNumberFormattingRules& GetCultureAgnosticFormattingRules();
 
 } // namespace FastDecimalFormat
+
+/**
+ * Formats numbers for a culture straight into string builders, for code that formats many numbers and only needs their strings.
+ * This is what FText::AsNumber, AsPercent and AsCurrency do, without the FString and FTextHistory they create for every number:
+ * the culture and its formatting rules are resolved once, when the formatter is created, rather than for every number.
+ * @note The formatter keeps its culture alive, but won't follow changes to the current culture made after it was created.
+ */
+class CORE_API FCultureNumberFormatter
+{
+public:
+	/** Formats for the given culture, or for the current locale when none is given */
+	explicit FCultureNumberFormatter(const FCulturePtr& InTargetCulture = nullptr);
+
+	template <typename T>
+	void AppendNumber(FStringBuilderBase& OutString, const T InVal, const FNumberFormattingOptions* const InOptions = nullptr) const
+	{
+		FastDecimalFormat::NumberToString(InVal, *NumberFormattingRules, InOptions ? *InOptions : NumberFormattingRules->CultureDefaultFormattingOptions, OutString);
+	}
+
+	template <typename T>
+	void AppendPercent(FStringBuilderBase& OutString, const T InVal, const FNumberFormattingOptions* const InOptions = nullptr) const
+	{
+		FastDecimalFormat::NumberToString(InVal * static_cast<T>(100), *PercentFormattingRules, InOptions ? *InOptions : PercentFormattingRules->CultureDefaultFormattingOptions, OutString);
+	}
+
+	template <typename T>
+	void AppendCurrency(FStringBuilderBase& OutString, const T InVal, const FString& InCurrencyCode, const FNumberFormattingOptions* const InOptions = nullptr) const
+	{
+		const FDecimalNumberFormattingRules& CurrencyFormattingRules = GetCurrencyFormattingRules(InCurrencyCode);
+		FastDecimalFormat::NumberToString(InVal, CurrencyFormattingRules, InOptions ? *InOptions : CurrencyFormattingRules.CultureDefaultFormattingOptions, OutString);
+	}
+
+	const FCultureRef& GetCulture() const
+	{
+		return Culture;
+	}
+
+private:
+	const FDecimalNumberFormattingRules& GetCurrencyFormattingRules(const FString& InCurrencyCode) const;
+
+	FCultureRef Culture;
+	const FDecimalNumberFormattingRules* NumberFormattingRules;
+	const FDecimalNumberFormattingRules* PercentFormattingRules;
+};
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Internationalization/TextKey.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+
+class FTextLocalizationResource;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FMappedTextLocalizationHeader;
+struct FMappedTextLocalizationSlot;
+
+/**
+ * Read-only LocMap file, the strings of a LocRes laid out to be memory mapped: a perfect hash index over namespace and key, and
+ * null terminated strings in the TCHAR format of the platform that are used in place. Mapped pages are shared through the page cache
+ * by every process that maps the same file, and the file is only read as strings are looked up.
+ *
+ * LocMap files are written next to their LocRes by SaveToFile, and FTextLocalizationResource::LoadFromFile maps them instead of
+ * loading the LocRes when Localization.UseMappedLocRes is set.
+ */
+class CORE_API FMappedTextLocalizationResource
+{
+public:
+	/** A string of the mapped file, valid while the resource is */
+	struct FMappedString
+	{
+		const TCHAR* Chars = nullptr;
+		int32 Len = 0;
+	};
+
+	struct FEntry
+	{
+		FMappedString LocalizedString;
+		uint32 SourceStringHash = 0;
+	};
+
+	~FMappedTextLocalizationResource();
+
+	/** Maps the given LocMap file, returns null if it's missing or invalid */
+	static TSharedPtr<FMappedTextLocalizationResource, ESPMode::ThreadSafe> Open(const FString& FilePath, const int32 Priority);
+
+	/** Writes the entries of the given resource to a LocMap file */
+	static bool SaveToFile(const FTextLocalizationResource& Resource, const FString& FilePath);
+
+	/** @return the LocMap file that goes with the given LocRes file */
+	static FString GetFilePathForLocRes(const FString& LocResFilePath);
+
+	/** Finds the entry of the given identity, the index only touches the pages of one bucket, one slot, and the compared strings */
+	bool Find(const FTextKey& Namespace, const FTextKey& Key, FEntry& OutEntry) const;
+
+	int32 GetNum() const;
+
+	int32 GetPriority() const
+	{
+		return Priority;
+	}
+
+	const FString& GetFilePath() const
+	{
+		return FilePath;
+	}
+
+	/** Identifies the file to the entries copied out of it */
+	const FTextKey& GetLocResID() const
+	{
+		return LocResID;
+	}
+
+private:
+	FMappedTextLocalizationResource();
+
+	FString FilePath;
+	FTextKey LocResID;
+	int32 Priority = 0;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const FMappedTextLocalizationHeader* Header = nullptr;
+	const uint32* BucketSeeds = nullptr;
+	const FMappedTextLocalizationSlot* Slots = nullptr;
+	const TCHAR* Strings = nullptr;
+};
+
+typedef TSharedRef<FMappedTextLocalizationResource, ESPMode::ThreadSafe> FMappedTextLocalizationResourceRef;
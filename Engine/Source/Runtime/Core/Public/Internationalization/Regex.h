@@ -2,6 +2,8 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
 #include "Containers/UnrealString.h"
 #include "Templates/SharedPointer.h"
 
@@ -10,6 +12,8 @@ class FRegexMatcherImplementation;
 
 /**
  * Implements a regular expression pattern.
+ * Compiled patterns are cached by their source string (see Regex.PatternCacheSize), so building the same pattern again is cheap,
+ * and a pattern can be used to make matchers from any thread.
  * @note DO NOT use this class as a file-level variable as its construction relies on the internationalization system being initialized!
  */
 class CORE_API FRegexPattern
@@ -20,7 +24,7 @@ public:
 	FRegexPattern(const FString& SourceString);
 
 private:
-	TSharedRef<FRegexPatternImplementation> Implementation;
+	TSharedRef<FRegexPatternImplementation, ESPMode::ThreadSafe> Implementation;
 };
 
 /**
@@ -31,6 +35,19 @@ class CORE_API FRegexMatcher
 {
 public:
 	FRegexMatcher(const FRegexPattern& Pattern, const FString& Input);
+	FRegexMatcher(const FRegexPattern& Pattern, FString&& Input);
+
+	/** Creates a matcher without input, to match many strings one after the other through Reset */
+	explicit FRegexMatcher(const FRegexPattern& Pattern);
+
+	/**
+	 * Starts matching the given input from its beginning, reusing this matcher rather than creating one per string.
+	 * The input isn't copied so it must outlive the matching, and where TCHAR is UTF-16 it isn't converted for ICU either.
+	 */
+	void Reset(const FStringView& Input);
+
+	/** @return the indices of the inputs the pattern is found in, matched with one matcher */
+	static TArray<int32> FindMatchingInputs(const FRegexPattern& Pattern, TArrayView<const FString> Inputs);
 
 	bool FindNext();
 
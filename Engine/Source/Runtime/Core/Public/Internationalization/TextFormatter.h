@@ -4,6 +4,7 @@
 
 #include "CoreTypes.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Containers/UnrealString.h"
 #include "Templates/Function.h"
 #include "Containers/Map.h"
@@ -94,6 +95,9 @@ public:
 	/** Incredibly low-level version of format. You should only be calling this if you're implementing a custom argument modifier type that itself needs to format using the private arguments */
 	static FString Format(const FTextFormat& InFmt, const FPrivateTextFormatArguments& InFormatArgs);
 
+	/** Version of the above that appends to OutResult rather than returning a new string */
+	static void FormatInto(const FTextFormat& InFmt, const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult);
+
 	/** Incredibly low-level version of FFormatArgumentValue::ToFormattedString. You should only be calling this if you're implementing a custom argument modifier type that itself needs to convert the argument to a string */
 	static void ArgumentValueToFormattedString(const FFormatArgumentValue& InValue, const FPrivateTextFormatArguments& InFormatArgs, FString& OutResult);
 
@@ -108,3 +112,37 @@ private:
 	/** Critical section protecting the argument modifiers map from being modified concurrently */
 	mutable FCriticalSection TextArgumentModifiersCS;
 };
+
+/**
+ * A format pattern with its named arguments bound to slots up front, for code that formats the same pattern many times a second.
+ * Values are passed by slot, so no FFormatNamedArguments map is built, and FormatToString writes into a buffer kept per thread,
+ * so nothing is allocated once that buffer has grown. Only FormatText makes an FText, with the history that rebuilds it on culture changes.
+ *
+ *	static const FPreparedTextFormat Prepared(LOCTEXT("Score", "{Player} scored {Points}"), { TEXT("Player"), TEXT("Points") });
+ *	const FString& Display = Prepared.FormatToString({ FFormatArgumentValue(PlayerName), FFormatArgumentValue(Points) });
+ */
+class CORE_API FPreparedTextFormat
+{
+public:
+	FPreparedTextFormat(FTextFormat InFmt, TArray<FString> InArgumentNames);
+
+	/**
+	 * Formats with InValues in the order of the argument names given on construction.
+	 * @return the formatted string, valid until the next call of FormatToString on this thread
+	 */
+	const FString& FormatToString(TArrayView<const FFormatArgumentValue> InValues) const;
+
+	/** Formats into a new text that can be rebuilt, which costs what FText::Format does */
+	FText FormatText(TArrayView<const FFormatArgumentValue> InValues) const;
+
+	const FTextFormat& GetFormat() const
+	{
+		return Fmt;
+	}
+
+private:
+	FTextFormat Fmt;
+	TArray<FString> ArgumentNames;
+	/** Slot of each top-level argument of the pattern in the order they appear, guessed once and checked by name when formatting */
+	TArray<int32> SlotsByArgumentNumber;
+};
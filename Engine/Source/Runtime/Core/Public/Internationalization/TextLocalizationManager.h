@@ -16,6 +16,7 @@
 #include "Internationalization/LocTesting.h"
 #include "Internationalization/LocKeyFuncs.h"
 #include "Internationalization/LocalizedTextSourceTypes.h"
+#include "Internationalization/MappedTextLocalizationResource.h"
 
 struct FPolyglotTextData;
 class ILocalizedTextSource;
@@ -73,6 +74,10 @@ private:
 	TMap<FTextDisplayStringRef, uint16> LocalTextRevisions;
 	uint16 TextRevisionCounter;
 
+	/** LocMap files of the current culture, sorted by priority. Display strings are only copied out of them as they are used. */
+	TArray<FMappedTextLocalizationResourceRef> NativeMappedResources;
+	TArray<FMappedTextLocalizationResourceRef> LocalizedMappedResources;
+
 #if WITH_EDITOR
 	uint8 GameLocalizationPreviewAutoEnableCount;
 	bool bIsGameLocalizationPreviewEnabled;
@@ -246,6 +251,12 @@ private:
 	/** Updates display string entries and adds new display string entries based on provided localizations. */
 	void UpdateFromLocalizations(FTextLocalizationResource&& TextLocalizationResource, const bool bDirtyTextRevision = true);
 
+	/** Updates the display string entries that exist from the given LocMap files, and keeps the files to look up the entries that don't yet */
+	void UpdateFromMapped(TArray<FMappedTextLocalizationResourceRef>&& MappedResources, TArray<FMappedTextLocalizationResourceRef>& OutCultureMappedResources);
+
+	/** Adds the display string entry of the given identity from the LocMap files of the current culture, if they have one for the source string (when given) */
+	FTextDisplayStringPtr AddDisplayStringFromMapped(const FTextId& TextId, const FString* const SourceString, const uint32 SourceStringHash);
+
 	/** Dirties the local revision counter for the given display string by incrementing it (or adding it) */
 	void DirtyLocalRevisionForDisplayString(const FTextDisplayStringRef& InDisplayString);
 
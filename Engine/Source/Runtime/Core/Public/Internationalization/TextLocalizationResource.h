@@ -6,6 +6,7 @@
 #include "Containers/SortedMap.h"
 #include "Internationalization/TextKey.h"
 #include "Internationalization/LocalizedTextSourceTypes.h"
+#include "Internationalization/MappedTextLocalizationResource.h"
 
 /** Utility class for working with Localization MetaData Resource (LocMeta) files. */
 class CORE_API FTextLocalizationMetaDataResource
@@ -59,6 +60,12 @@ public:
 	typedef TMap<FTextId, FEntry> FEntriesTable;
 	FEntriesTable Entries;
 
+	/**
+	 * LocMap files that LoadFromFile mapped instead of loading their LocRes into Entries, sorted by priority. Their entries are
+	 * looked up as they are used (@see FTextLocalizationManager), and come after Entries when both have one for an identity.
+	 */
+	TArray<FMappedTextLocalizationResourceRef> MappedResources;
+
 	/** Utility to produce a hash for a string (as used by SourceStringHash) */
 	static FORCEINLINE uint32 HashString(const TCHAR* InStr, const uint32 InBaseHash = 0)
 	{
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Logging/LogVerbosity.h"
+#include "UObject/NameTypes.h"
+
+/**
+ * A log message that hasn't been formatted yet. It is made of the format string and its arguments encoded in
+ * binary form by FFormatArgsTrace::EncodeVarArgs, the text is only produced when an output device asks for it.
+ *
+ * Messages are logged with UE_LOG_DEFERRED and passed to output devices through FOutputDevice::SerializeDeferred,
+ * the format string has to outlive the message, which is the case for the string literals used with UE_LOG.
+ */
+class CORE_API FDeferredLogMessage
+{
+public:
+	FDeferredLogMessage(const TCHAR* InFormat, const uint8* InEncodedArgs, uint16 InEncodedArgsSize, ELogVerbosity::Type InVerbosity, const FName& InCategory, double InTime = -1.0)
+		: Format(InFormat)
+		, EncodedArgs(InEncodedArgs)
+		, EncodedArgsSize(InEncodedArgsSize)
+		, Verbosity(InVerbosity)
+		, bFormatted(false)
+		, Category(InCategory)
+		, Time(InTime)
+	{
+	}
+
+	/** Noncopyable, the text is cached in the message */
+	FDeferredLogMessage(const FDeferredLogMessage&) = delete;
+	FDeferredLogMessage& operator=(const FDeferredLogMessage&) = delete;
+
+	const TCHAR* GetFormat() const
+	{
+		return Format;
+	}
+
+	const uint8* GetEncodedArgs() const
+	{
+		return EncodedArgs;
+	}
+
+	uint16 GetEncodedArgsSize() const
+	{
+		return EncodedArgsSize;
+	}
+
+	ELogVerbosity::Type GetVerbosity() const
+	{
+		return Verbosity;
+	}
+
+	const FName& GetCategory() const
+	{
+		return Category;
+	}
+
+	/** Time the message was logged at, -1 if it wasn't set */
+	double GetTime() const
+	{
+		return Time;
+	}
+
+	/** Formats the message the first time it is called, the text stays valid as long as the message. */
+	const TCHAR* GetText() const
+	{
+		if (!bFormatted)
+		{
+			FormatMessage(Text, Format, EncodedArgs);
+			bFormatted = true;
+		}
+		return *Text;
+	}
+
+	/**
+	 * Formats a printf style string with arguments encoded by FFormatArgsTrace::EncodeVarArgs.
+	 *
+	 * @param Out			String to append the formatted message to
+	 * @param InFormat		Format string the arguments were captured for
+	 * @param InEncodedArgs	Encoded arguments
+	 */
+	static void FormatMessage(FString& Out, const TCHAR* InFormat, const uint8* InEncodedArgs);
+
+private:
+	const TCHAR* Format;
+	const uint8* EncodedArgs;
+	uint16 EncodedArgsSize;
+	ELogVerbosity::Type Verbosity;
+	mutable bool bFormatted;
+	FName Category;
+	double Time;
+	mutable FString Text;
+};
@@ -9,6 +9,7 @@
 #include "Logging/LogCategory.h"
 #include "Logging/LogScopedCategoryAndVerbosityOverride.h"
 #include "Logging/LogTrace.h"
+#include "ProfilingDebugging/FormatArgsTrace.h"
 #include "Templates/IsValidVariadicFunctionArg.h"
 #include "Templates/AndOrNot.h"
 #include "Templates/IsArrayOrRefOfType.h"
@@ -60,10 +61,34 @@ struct CORE_API FMsg
 		Logf_InternalImpl(File, Line, Category, Verbosity, Fmt, Args...);
 	}
 
+	/**
+	 * Log function that defers formatting. The arguments are encoded in binary form and the message is only formatted
+	 * when an output device needs its text. Should be used only in UE_LOG_DEFERRED, it can't handle fatal errors.
+	 */
+	template <typename FmtType, typename... Types>
+	static void LogDeferred(const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const FmtType& Fmt, Types... Args)
+	{
+		static_assert(TIsArrayOrRefOfType<FmtType, TCHAR>::Value, "Formatting string must be a TCHAR array.");
+		static_assert(TAnd<TIsValidVariadicFunctionArg<Types>...>::Value, "Invalid argument(s) passed to FMsg::LogDeferred");
+
+		uint8 EncodedArgs[1024];
+		const uint16 EncodedArgsSize = FFormatArgsTrace::EncodeVarArgs(EncodedArgs, Args...);
+		if (EncodedArgsSize)
+		{
+			LogDeferredImpl(Category, Verbosity, Fmt, EncodedArgs, EncodedArgsSize);
+		}
+		else
+		{
+			// Too many arguments or strings too long to be encoded
+			Logf_InternalImpl(nullptr, 0, Category, Verbosity, Fmt, Args...);
+		}
+	}
+
 private:
 	static void VARARGS LogfImpl(const ANSICHAR* File, int32 Line, const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ...);
 	static void VARARGS Logf_InternalImpl(const ANSICHAR* File, int32 Line, const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, ...);
 	static void VARARGS SendNotificationStringfImpl(const TCHAR* Fmt, ...);
+	static void LogDeferredImpl(const FLogCategoryName& Category, ELogVerbosity::Type Verbosity, const TCHAR* Fmt, const uint8* EncodedArgs, uint16 EncodedArgsSize);
 };
 
 /*----------------------------------------------------------------------------
@@ -115,6 +140,8 @@ private:
 
 	#define UE_LOG_CLINKAGE(CategoryName, Verbosity, Format, ...) UE_LOG(CategoryName, Verbosity, Format, __VA_ARGS__ )
 
+	#define UE_LOG_DEFERRED(CategoryName, Verbosity, Format, ...) {}
+
 	// Conditional logging (fatal errors only).
 	#define UE_CLOG(Condition, CategoryName, Verbosity, Format, ...) \
 	{ \
@@ -217,6 +244,33 @@ private:
 		} \
 	}
 
+	/** 
+	 * Same as UE_LOG, except that the arguments are captured in binary form and the message is only formatted when
+	 * an output device needs its text. Lines logged by secondary threads are formatted by the master thread when
+	 * it flushes them. The format string must be a literal and fatal messages can't be deferred.
+	 * @param CategoryName name of the logging category
+	 * @param Verbosity, verbosity level to test against
+	 * @param Format, format text
+	 ***/
+	#define UE_LOG_DEFERRED(CategoryName, Verbosity, Format, ...) \
+	{ \
+		static_assert(TIsArrayOrRefOfType<decltype(Format), TCHAR>::Value, "Formatting string must be a TCHAR array."); \
+		static_assert((ELogVerbosity::Verbosity & ELogVerbosity::VerbosityMask) < ELogVerbosity::NumVerbosity && ELogVerbosity::Verbosity > 0, "Verbosity must be constant and in range."); \
+		static_assert(ELogVerbosity::Verbosity != ELogVerbosity::Fatal, "Fatal errors can't be deferred, use UE_LOG."); \
+		CA_CONSTANT_IF((ELogVerbosity::Verbosity & ELogVerbosity::VerbosityMask) <= ELogVerbosity::COMPILED_IN_MINIMUM_VERBOSITY && (ELogVerbosity::Warning & ELogVerbosity::VerbosityMask) <= FLogCategory##CategoryName::CompileTimeVerbosity) \
+		{ \
+			if (!CategoryName.IsSuppressed(ELogVerbosity::Verbosity)) \
+			{ \
+				auto UE_LOG_noinline_lambda = [](const auto& LCategoryName, const auto& LFormat, const auto&... UE_LOG_Args) FORCENOINLINE \
+				{ \
+					TRACE_LOG_MESSAGE(LCategoryName, Verbosity, LFormat, UE_LOG_Args...) \
+					FMsg::LogDeferred(LCategoryName.GetCategoryName(), ELogVerbosity::Verbosity, LFormat, UE_LOG_Args...); \
+				}; \
+				UE_LOG_noinline_lambda(CategoryName, Format, ##__VA_ARGS__); \
+			} \
+		} \
+	}
+
 	/** 
 	 * A  macro that outputs a formatted message to log if a given logging category is active at a given verbosity level
 	 * @param CategoryName name of the logging category
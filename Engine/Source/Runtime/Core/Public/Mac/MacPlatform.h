@@ -96,6 +96,7 @@ typedef FMacPlatformTypes FPlatformTypes;
 #endif
 
 #define FORCENOINLINE __attribute__((noinline))							/* Force code to NOT be inline */
+#define TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))		/* Reach a thread_local variable at a fixed offset from the thread pointer */
 #define FUNCTION_CHECK_RETURN_END __attribute__ ((warn_unused_result))	/* Warn that callers should not ignore the return value. */
 #define FUNCTION_NO_RETURN_END __attribute__ ((noreturn))				/* Indicate that the function never returns. */
 
@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
+#include "Math/InterpCurve.h"
+
+/**
+ * An FInterpCurve resampled at evenly spaced input values, for evaluating many times with a lerp between the
+ * two nearest samples instead of a search and a cubic. This is only as accurate as the number of samples allows
+ * and inputs outside the baked range get the first or last sample. Float curves evaluate four inputs at a time
+ * with vector instructions in EvalMany.
+ *
+ * @see FInterpCurve
+ */
+template<class T>
+class TBakedInterpCurve
+{
+public:
+
+	/** Default constructor, an empty curve. */
+	TBakedInterpCurve()
+		: MinInVal(0.f)
+		, SamplesPerInVal(0.f)
+	{
+	}
+
+	/** Bake a curve, see Bake. */
+	TBakedInterpCurve( const FInterpCurve<T>& Curve, int32 NumSamples )
+	{
+		Bake(Curve, NumSamples);
+	}
+
+	/**
+	 * Resample a curve from its first point to its last, or to its loop key when it loops.
+	 *
+	 * @param Curve The curve to sample.
+	 * @param NumSamples How many samples to take, at least two unless all the points have the same input value.
+	 */
+	void Bake( const FInterpCurve<T>& Curve, int32 NumSamples );
+
+	/** Evaluate the output for an arbitrary input value. */
+	T Eval( const float InVal, const T& Default = T(ForceInit) ) const;
+
+	/** Evaluate the output for each of an array of input values, the same as calling Eval for each of them. */
+	void EvalMany( TArrayView<const float> InVals, TArrayView<T> OutVals, const T& Default = T(ForceInit) ) const;
+
+	/** Get the samples, evenly spaced from the first point's input value. */
+	const TArray<T>& GetSamples() const
+	{
+		return Samples;
+	}
+
+private:
+
+	/** Samples[0] is the output at MinInVal */
+	TArray<T> Samples;
+
+	float MinInVal;
+
+	/** Reciprocal of the input value spacing between samples */
+	float SamplesPerInVal;
+};
+
+
+/* TBakedInterpCurve inline functions
+ *****************************************************************************/
+
+template< class T >
+void TBakedInterpCurve<T>::Bake(const FInterpCurve<T>& Curve, int32 NumSamples)
+{
+	Samples.Reset();
+	MinInVal = 0.f;
+	SamplesPerInVal = 0.f;
+
+	const int32 NumPoints = Curve.Points.Num();
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	MinInVal = Curve.Points[0].InVal;
+	const float MaxInVal = Curve.Points.Last().InVal + (Curve.bIsLooped ? Curve.LoopKeyOffset : 0.f);
+	if (MaxInVal <= MinInVal)
+	{
+		Samples.Add(Curve.Points[0].OutVal);
+		return;
+	}
+
+	check(NumSamples >= 2);
+	const float InValPerSample = (MaxInVal - MinInVal) / float(NumSamples - 1);
+	SamplesPerInVal = 1.f / InValPerSample;
+
+	// The samples are in order, so each is found from the segment of the one before
+	TInterpCurveEvaluator<T> Evaluator(Curve);
+	Samples.Reserve(NumSamples);
+	for (int32 Index = 0; Index < NumSamples - 1; ++Index)
+	{
+		Samples.Add(Evaluator.Eval(MinInVal + float(Index) * InValPerSample));
+	}
+	Samples.Add(Evaluator.Eval(MaxInVal));
+}
+
+
+template< class T >
+T TBakedInterpCurve<T>::Eval(const float InVal, const T& Default) const
+{
+	const int32 NumSamples = Samples.Num();
+	if (NumSamples < 2)
+	{
+		return NumSamples ? Samples[0] : Default;
+	}
+
+	const float Position = FMath::Min(FMath::Max((InVal - MinInVal) * SamplesPerInVal, 0.f), float(NumSamples - 1));
+	const int32 Index = FMath::Min(int32(Position), NumSamples - 2);
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - float(Index));
+}
+
+
+template< class T >
+void TBakedInterpCurve<T>::EvalMany(TArrayView<const float> InVals, TArrayView<T> OutVals, const T& Default) const
+{
+	check(InVals.Num() == OutVals.Num());
+
+	for (int32 Index = 0; Index < InVals.Num(); ++Index)
+	{
+		OutVals[Index] = Eval(InVals[Index], Default);
+	}
+}
+
+
+template<>
+inline void TBakedInterpCurve<float>::EvalMany(TArrayView<const float> InVals, TArrayView<float> OutVals, const float& Default) const
+{
+	check(InVals.Num() == OutVals.Num());
+
+	const int32 NumSamples = Samples.Num();
+	const int32 NumInVals = InVals.Num();
+	int32 InIndex = 0;
+	if (NumSamples >= 2)
+	{
+		const VectorRegister VecMinInVal = VectorSetFloat1(MinInVal);
+		const VectorRegister VecSamplesPerInVal = VectorSetFloat1(SamplesPerInVal);
+		const VectorRegister VecLastPosition = VectorSetFloat1(float(NumSamples - 1));
+		const VectorRegister VecLastSegment = VectorSetFloat1(float(NumSamples - 2));
+		const float* SampleData = Samples.GetData();
+
+		// The position and blend weight are computed four at a time, only loading the samples is scalar
+		MS_ALIGN(16) int32 Indices[4] GCC_ALIGN(16);
+		MS_ALIGN(16) float Lower[4] GCC_ALIGN(16);
+		MS_ALIGN(16) float Upper[4] GCC_ALIGN(16);
+		for (; InIndex + 4 <= NumInVals; InIndex += 4)
+		{
+			const VectorRegister Offset = VectorSubtract(VectorLoad(&InVals[InIndex]), VecMinInVal);
+			const VectorRegister Position = VectorMin(VectorMax(VectorMultiply(Offset, VecSamplesPerInVal), GlobalVectorConstants::FloatZero), VecLastPosition);
+			const VectorRegisterInt SegmentIndex = VectorFloatToInt(VectorMin(Position, VecLastSegment));
+			const VectorRegister Alpha = VectorSubtract(Position, VectorIntToFloat(SegmentIndex));
+
+			VectorIntStoreAligned(SegmentIndex, Indices);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				// Only a NaN input can give an index outside the samples
+				const int32 Segment = int32(FMath::Min(uint32(Indices[Lane]), uint32(NumSamples - 2)));
+				Lower[Lane] = SampleData[Segment];
+				Upper[Lane] = SampleData[Segment + 1];
+			}
+
+			const VectorRegister VecLower = VectorLoadAligned(Lower);
+			const VectorRegister Result = VectorMultiplyAdd(Alpha, VectorSubtract(VectorLoadAligned(Upper), VecLower), VecLower);
+			VectorStore(Result, &OutVals[InIndex]);
+		}
+	}
+
+	for (; InIndex < NumInVals; ++InIndex)
+	{
+		OutVals[InIndex] = Eval(InVals[InIndex], Default);
+	}
+}
@@ -6,6 +6,7 @@
 #include "Misc/AssertionMacros.h"
 #include "HAL/UnrealMemory.h"
 #include "Containers/UnrealString.h"
+#include "Containers/ArrayView.h"
 
 /**
  * n-bit integer. @todo: optimize
@@ -1041,6 +1042,238 @@ typedef TBigInt<256> int256;
 typedef TBigInt<512> int512;
 typedef TBigInt<512> TEncryptionInt;
 
+namespace UE4BigInt_Private
+{
+	/** Returns the low 64 bits of A * B + C + D and stores the high 64 bits in OutHigh, which can't overflow. */
+	FORCEINLINE uint64 MultiplyAdd(uint64 A, uint64 B, uint64 C, uint64 D, uint64& OutHigh)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Result = (unsigned __int128)A * B + C + D;
+		OutHigh = (uint64)(Result >> 64);
+		return (uint64)Result;
+#else
+		uint64 Low;
+		uint64 High;
+#if defined(_MSC_VER) && defined(_M_X64)
+		Low = _umul128(A, B, &High);
+#else
+		const uint64 LoLo = (A & 0xFFFFFFFF) * (B & 0xFFFFFFFF);
+		const uint64 HiLo = (A >> 32) * (B & 0xFFFFFFFF);
+		const uint64 LoHi = (A & 0xFFFFFFFF) * (B >> 32);
+		const uint64 HiHi = (A >> 32) * (B >> 32);
+		const uint64 Cross = (LoLo >> 32) + (HiLo & 0xFFFFFFFF) + LoHi;
+		High = (HiLo >> 32) + (Cross >> 32) + HiHi;
+		Low = (Cross << 32) | (LoLo & 0xFFFFFFFF);
+#endif
+		Low += C;
+		High += Low < C;
+		Low += D;
+		High += Low < D;
+		OutHigh = High;
+		return Low;
+#endif
+	}
+}
+
+/**
+ * An odd modulus prepared for Montgomery multiplication, which replaces the divisions of Modulo with
+ * multiplications. Modular powers work on 64-bit limbs, only as many of them as the modulus needs,
+ * so reuse one of these for all the powers with the same modulus, like all the signatures of a key.
+ */
+template <int32 NumBits, bool bSigned = true>
+class TMontgomeryModulus
+{
+public:
+
+	typedef TBigInt<NumBits, bSigned> BigInt;
+
+	explicit TMontgomeryModulus(const BigInt& InModulus)
+		: Modulus(InModulus)
+	{
+		checkf(Modulus.IsFirstBitSet() && !Modulus.IsNegative(), TEXT("Montgomery multiplication needs a positive odd modulus"));
+
+		ToLimbs(Modulus, ModulusLimbs);
+		NumLimbs = MaxLimbs;
+		while (NumLimbs > 1 && ModulusLimbs[NumLimbs - 1] == 0)
+		{
+			--NumLimbs;
+		}
+
+		// Newton's iteration doubles the correct low bits of the inverse each step, starting from the three of M * M = 1 mod 8
+		uint64 Inverse = ModulusLimbs[0];
+		for (int32 Step = 0; Step < 5; ++Step)
+		{
+			Inverse *= 2 - ModulusLimbs[0] * Inverse;
+		}
+		NegativeInverse = 0 - Inverse;
+
+		// R^2 mod M with R = 2^(64 * NumLimbs). Doubling the highest power of two below M gets to 2^Odd * R mod M, which is
+		// 2^Odd in the Montgomery form, then each Montgomery squaring doubles the power of two until it is 2^(64 * NumLimbs).
+		const int32 RBits = 64 * NumLimbs;
+		int32 Squarings = 0;
+		int32 Odd = RBits;
+		while ((Odd & 1) == 0)
+		{
+			Odd >>= 1;
+			++Squarings;
+		}
+
+		const int32 ModulusBits = Modulus.GetHighestNonZeroBit();
+		FMemory::Memzero(RSquared, sizeof(RSquared));
+		RSquared[ModulusBits / 64] = uint64(1) << (ModulusBits % 64);
+		for (int32 Bit = ModulusBits; Bit < RBits + Odd; ++Bit)
+		{
+			DoubleModulo(RSquared);
+		}
+		for (int32 Squaring = 0; Squaring < Squarings; ++Squaring)
+		{
+			Multiply(RSquared, RSquared, RSquared);
+		}
+	}
+
+	/** Returns Base to the power of Exponent modulo this. Base and Exponent must not be negative. */
+	BigInt Pow(BigInt Base, const BigInt& Exponent) const
+	{
+		check(!Base.IsNegative() && !Exponent.IsNegative());
+
+		// Converting to the Montgomery form reduces anything that fits in the limbs of the modulus
+		if (Base.GetHighestNonZeroWord() >= 2 * NumLimbs)
+		{
+			Base %= Modulus;
+		}
+
+		uint64 One[MaxLimbs] = { 1 };
+		uint64 MontgomeryBase[MaxLimbs];
+		ToLimbs(Base, MontgomeryBase);
+		Multiply(MontgomeryBase, RSquared, MontgomeryBase);
+
+		// Left to right square and multiply, starting from 1 in the Montgomery form
+		uint64 Result[MaxLimbs];
+		Multiply(RSquared, One, Result);
+		for (int32 Bit = Exponent.GetHighestNonZeroBit(); Bit >= 0; --Bit)
+		{
+			Multiply(Result, Result, Result);
+			if (Exponent.GetBit(Bit))
+			{
+				Multiply(Result, MontgomeryBase, Result);
+			}
+		}
+		Multiply(Result, One, Result);
+
+		return FromLimbs(Result);
+	}
+
+	const BigInt& GetModulus() const
+	{
+		return Modulus;
+	}
+
+private:
+
+	static_assert(NumBits % 64 == 0, "TMontgomeryModulus needs a whole number of 64-bit limbs.");
+
+	enum { MaxLimbs = NumBits / 64 };
+
+	static void ToLimbs(const BigInt& Value, uint64* OutLimbs)
+	{
+		const uint32* Words = Value.GetBits();
+		for (int32 Index = 0; Index < MaxLimbs; ++Index)
+		{
+			OutLimbs[Index] = uint64(Words[2 * Index]) | (uint64(Words[2 * Index + 1]) << 32);
+		}
+	}
+
+	BigInt FromLimbs(const uint64* Limbs) const
+	{
+		uint32 Words[NumBits / 32] = {};
+		for (int32 Index = 0; Index < NumLimbs; ++Index)
+		{
+			Words[2 * Index] = uint32(Limbs[Index]);
+			Words[2 * Index + 1] = uint32(Limbs[Index] >> 32);
+		}
+		return BigInt(Words);
+	}
+
+	/** Subtracts the modulus from Value when Value has its top bit in Carry or is at least the modulus. */
+	void ReduceOnce(uint64* Value, uint64 Carry) const
+	{
+		if (!Carry)
+		{
+			int32 Index = NumLimbs - 1;
+			while (Index > 0 && Value[Index] == ModulusLimbs[Index])
+			{
+				--Index;
+			}
+			if (Value[Index] < ModulusLimbs[Index])
+			{
+				return;
+			}
+		}
+
+		uint64 Borrow = 0;
+		for (int32 Index = 0; Index < NumLimbs; ++Index)
+		{
+			const uint64 Difference = Value[Index] - ModulusLimbs[Index];
+			const uint64 NextBorrow = (Value[Index] < ModulusLimbs[Index]) | (Difference < Borrow);
+			Value[Index] = Difference - Borrow;
+			Borrow = NextBorrow;
+		}
+	}
+
+	/** Value = 2 * Value mod M, for Value below M */
+	void DoubleModulo(uint64* Value) const
+	{
+		const uint64 Carry = Value[NumLimbs - 1] >> 63;
+		for (int32 Index = NumLimbs - 1; Index > 0; --Index)
+		{
+			Value[Index] = (Value[Index] << 1) | (Value[Index - 1] >> 63);
+		}
+		Value[0] <<= 1;
+		ReduceOnce(Value, Carry);
+	}
+
+	/** Out = A * B / R mod M, interleaving the multiplication and the reduction one limb of B at a time. Out can be A or B. */
+	void Multiply(const uint64* A, const uint64* B, uint64* Out) const
+	{
+		using namespace UE4BigInt_Private;
+
+		uint64 Product[MaxLimbs + 2];
+		FMemory::Memzero(Product, (NumLimbs + 2) * sizeof(uint64));
+		for (int32 IndexB = 0; IndexB < NumLimbs; ++IndexB)
+		{
+			uint64 Carry = 0;
+			for (int32 IndexA = 0; IndexA < NumLimbs; ++IndexA)
+			{
+				Product[IndexA] = MultiplyAdd(A[IndexA], B[IndexB], Product[IndexA], Carry, Carry);
+			}
+			Product[NumLimbs] += Carry;
+			Product[NumLimbs + 1] = Product[NumLimbs] < Carry;
+
+			// Adding a multiple of the modulus that zeroes the lowest limb, then dropping it, divides by 2^64
+			const uint64 Factor = Product[0] * NegativeInverse;
+			MultiplyAdd(Factor, ModulusLimbs[0], Product[0], 0, Carry);
+			for (int32 Index = 1; Index < NumLimbs; ++Index)
+			{
+				Product[Index - 1] = MultiplyAdd(Factor, ModulusLimbs[Index], Product[Index], Carry, Carry);
+			}
+			Product[NumLimbs - 1] = Product[NumLimbs] + Carry;
+			Product[NumLimbs] = Product[NumLimbs + 1] + (Product[NumLimbs - 1] < Carry);
+		}
+
+		// The result is below 2M
+		ReduceOnce(Product, Product[NumLimbs]);
+		FMemory::Memcpy(Out, Product, NumLimbs * sizeof(uint64));
+	}
+
+	BigInt Modulus;
+	uint64 ModulusLimbs[MaxLimbs];
+	/** R^2 mod M, for converting to the Montgomery form */
+	uint64 RSquared[MaxLimbs];
+	/** -M^-1 mod 2^64 */
+	uint64 NegativeInverse;
+	int32 NumLimbs;
+};
+
 /**
  * Encryption key - exponent and modulus pair
  */
@@ -1227,8 +1460,14 @@ namespace FEncryption
  * Specialization for int type used in encryption (performance). Avoids using temporary results and most of the operations are inplace.
  */
 template <>
-TEncryptionInt FEncryption::ModularPow(TEncryptionInt Base, TEncryptionInt Exponent, TEncryptionInt Modulus)
+inline TEncryptionInt FEncryption::ModularPow(TEncryptionInt Base, TEncryptionInt Exponent, TEncryptionInt Modulus)
 {
+	// RSA moduli are odd
+	if (Modulus.IsFirstBitSet() && Modulus.IsGreaterThanZero())
+	{
+		return TMontgomeryModulus<512>(Modulus).Pow(Base, Exponent);
+	}
+
 	TEncryptionInt Result(1LL);
 	while (Exponent.IsGreaterThanZero())
 	{
@@ -1314,5 +1553,18 @@ namespace FEncryption
 	{
 		OutUnencryptedSignature.Data = (FDecryptedSignature::DataType)FEncryption::ModularPow(TEncryptionInt(InEncryptedSignature.Data), EncryptionKey.Exponent, EncryptionKey.Modulus).ToInt();
 	}
+
+	/**
+	 * Decrypts many signatures made with the same key, in parallel on the task graph.
+	 */
+	CORE_API void DecryptSignatures(TArrayView<const FEncryptedSignature> InEncryptedSignatures, TArrayView<FDecryptedSignature> OutUnencryptedSignatures, const FEncryptionKey& EncryptionKey);
+
+	/**
+	 * Checks many signatures made with the same key against the values they should decrypt to, in parallel on the task graph.
+	 *
+	 * @param OutFailedIndices If not null, receives the indices of the signatures that don't match, in order.
+	 * @return Whether all the signatures match.
+	 */
+	CORE_API bool VerifySignatures(TArrayView<const FEncryptedSignature> InEncryptedSignatures, TArrayView<const FDecryptedSignature> InExpectedSignatures, const FEncryptionKey& EncryptionKey, TArray<int32>* OutFailedIndices = nullptr);
 }
 
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Async/ParallelFor.h"
+#include "Math/Vector.h"
+#include "Math/Box.h"
+#include "Math/BoxSphereBounds.h"
+#include "Math/Plane.h"
+
+/**
+ * Bounds stored as separate arrays of their box centers and extents, so that the culling kernels load 4 of them per
+ * vector register. Kept up to date by the code that owns the objects, next to its FBoxSphereBounds.
+ */
+struct CORE_API FBoundsSoA
+{
+	TArray<float> CenterX;
+	TArray<float> CenterY;
+	TArray<float> CenterZ;
+	TArray<float> ExtentX;
+	TArray<float> ExtentY;
+	TArray<float> ExtentZ;
+
+	/** @return Number of bounds */
+	int32 Num() const
+	{
+		return CenterX.Num();
+	}
+
+	void Reset()
+	{
+		CenterX.Reset(); CenterY.Reset(); CenterZ.Reset();
+		ExtentX.Reset(); ExtentY.Reset(); ExtentZ.Reset();
+	}
+
+	void Reserve(int32 Number)
+	{
+		CenterX.Reserve(Number); CenterY.Reserve(Number); CenterZ.Reserve(Number);
+		ExtentX.Reserve(Number); ExtentY.Reserve(Number); ExtentZ.Reserve(Number);
+	}
+
+	/** @return Index of the new bounds */
+	int32 Add(const FVector& Center, const FVector& Extent)
+	{
+		CenterX.Add(Center.X); CenterY.Add(Center.Y); CenterZ.Add(Center.Z);
+		ExtentX.Add(Extent.X); ExtentY.Add(Extent.Y);
+		return ExtentZ.Add(Extent.Z);
+	}
+
+	int32 Add(const FBoxSphereBounds& Bounds)
+	{
+		return Add(Bounds.Origin, Bounds.BoxExtent);
+	}
+
+	int32 Add(const FBox& Box)
+	{
+		return Add(Box.GetCenter(), Box.GetExtent());
+	}
+
+	void Set(int32 Index, const FVector& Center, const FVector& Extent)
+	{
+		CenterX[Index] = Center.X; CenterY[Index] = Center.Y; CenterZ[Index] = Center.Z;
+		ExtentX[Index] = Extent.X; ExtentY[Index] = Extent.Y; ExtentZ[Index] = Extent.Z;
+	}
+
+	void Set(int32 Index, const FBoxSphereBounds& Bounds)
+	{
+		Set(Index, Bounds.Origin, Bounds.BoxExtent);
+	}
+};
+
+/**
+ * Tests many bounds at a time against a set of planes, such as a view frustum, or against a box, 4 bounds per
+ * iteration on the vector registers. Results are either the indices of the bounds that pass, in increasing order, or
+ * a bitmask with bit (Index % 32) of word (Index / 32) set for each one.
+ *
+ * Large batches are split in chunks run with ParallelFor, unless Flags has ForceSingleThread.
+ */
+struct CORE_API FBoundsCulling
+{
+	/**
+	 * Finds the bounds whose box is not entirely in front of any of the planes, the same test as
+	 * FConvexVolume::IntersectBox: planes point out of the volume, and points with a positive PlaneDot are outside.
+	 *
+	 * @return Number of indices added to OutIndices, which is reset first
+	 */
+	static int32 CullAgainstPlanes(const FBoundsSoA& Bounds, TArrayView<const FPlane> Planes, TArray<int32>& OutIndices, EParallelForFlags Flags = EParallelForFlags::None);
+
+	/** Same as above, setting the bits of the bounds that pass in OutMask, which is resized to (Num + 31) / 32 words */
+	static void CullAgainstPlanes(const FBoundsSoA& Bounds, TArrayView<const FPlane> Planes, TArray<uint32>& OutMask, EParallelForFlags Flags = EParallelForFlags::None);
+
+	/**
+	 * Finds the bounds whose box overlaps a box, touching included like FBox::Intersect.
+	 *
+	 * @return Number of indices added to OutIndices, which is reset first
+	 */
+	static int32 OverlapBox(const FBoundsSoA& Bounds, const FBox& Box, TArray<int32>& OutIndices, EParallelForFlags Flags = EParallelForFlags::None);
+
+	/** Same as above, setting the bits of the bounds that overlap in OutMask, which is resized to (Num + 31) / 32 words */
+	static void OverlapBox(const FBoundsSoA& Bounds, const FBox& Box, TArray<uint32>& OutMask, EParallelForFlags Flags = EParallelForFlags::None);
+};
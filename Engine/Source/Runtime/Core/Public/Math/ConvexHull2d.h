@@ -8,6 +8,81 @@
 
 namespace ConvexHull2D
 {
+	/** Point count above which ComputeConvexHull culls the points inside the quadrilateral of the extreme points before sorting */
+	static const int32 MinPointsToCull = 256;
+
+	/**
+	 * Appends to OutIndices the index of every point that is not strictly inside the quadrilateral formed by the points with the
+	 * smallest and largest X and Y. Those points cannot be on the hull. The in-out tests run on 4 points at a time, and points
+	 * within a small margin of an edge are kept so float error never removes a hull vertex.
+	 */
+	template<typename VectorType, typename Allocator, typename IndexType>
+	void CullInteriorPoints(const TArray<VectorType, Allocator>& Points, TArray<IndexType, Allocator>& OutIndices)
+	{
+		const VectorType* P = Points.GetData();
+		const int32 PointsNum = Points.Num();
+		if (PointsNum == 0)
+		{
+			return;
+		}
+
+		int32 MinX = 0, MaxX = 0, MinY = 0, MaxY = 0;
+		for (int32 Index = 1; Index < PointsNum; ++Index)
+		{
+			MinX = P[Index].X < P[MinX].X ? Index : MinX;
+			MaxX = P[Index].X > P[MaxX].X ? Index : MaxX;
+			MinY = P[Index].Y < P[MinY].Y ? Index : MinY;
+			MaxY = P[Index].Y > P[MaxY].Y ? Index : MaxY;
+		}
+
+		// Counter clockwise, so the cross product of each edge with a point inside is positive
+		const int32 Corners[4] = { MinX, MinY, MaxX, MaxY };
+		const float Extent = (P[MaxX].X - P[MinX].X) + (P[MaxY].Y - P[MinY].Y);
+		const VectorRegister Margin = VectorSetFloat1(Extent * Extent * 1e-5f);
+		VectorRegister EdgeX[4], EdgeY[4], CornerX[4], CornerY[4];
+		for (int32 Edge = 0; Edge < 4; ++Edge)
+		{
+			const VectorType& A = P[Corners[Edge]];
+			const VectorType& B = P[Corners[(Edge + 1) & 3]];
+			EdgeX[Edge] = VectorSetFloat1(B.X - A.X);
+			EdgeY[Edge] = VectorSetFloat1(B.Y - A.Y);
+			CornerX[Edge] = VectorSetFloat1(A.X);
+			CornerY[Edge] = VectorSetFloat1(A.Y);
+		}
+
+		OutIndices.Reserve(OutIndices.Num() + FMath::Max(PointsNum / 8, 16));
+		int32 Index = 0;
+		for (; Index < PointsNum; Index += 4)
+		{
+			// The last group repeats its final point, only the real ones are added
+			const int32 Last = PointsNum - 1;
+			const VectorType& P0 = P[Index];
+			const VectorType& P1 = P[FMath::Min(Index + 1, Last)];
+			const VectorType& P2 = P[FMath::Min(Index + 2, Last)];
+			const VectorType& P3 = P[FMath::Min(Index + 3, Last)];
+			const VectorRegister X = MakeVectorRegister(float(P0.X), float(P1.X), float(P2.X), float(P3.X));
+			const VectorRegister Y = MakeVectorRegister(float(P0.Y), float(P1.Y), float(P2.Y), float(P3.Y));
+
+			VectorRegister Inside = VectorCompareGT(VectorOne(), VectorZero());
+			for (int32 Edge = 0; Edge < 4; ++Edge)
+			{
+				const VectorRegister Cross = VectorSubtract(
+					VectorMultiply(EdgeX[Edge], VectorSubtract(Y, CornerY[Edge])),
+					VectorMultiply(EdgeY[Edge], VectorSubtract(X, CornerX[Edge])));
+				Inside = VectorBitwiseAnd(Inside, VectorCompareGT(Cross, Margin));
+			}
+
+			const int32 InsideMask = VectorMaskBits(Inside);
+			for (int32 Lane = 0; Lane < 4 && Index + Lane < PointsNum; ++Lane)
+			{
+				if ((InsideMask & (1 << Lane)) == 0)
+				{
+					OutIndices.Add(IndexType(Index + Lane));
+				}
+			}
+		}
+	}
+
 	/**
 	 * Andrew's monotone chain convex hull algorithm for 2-dimensional points. O(N log N).
 	 *
@@ -36,11 +111,20 @@ namespace ConvexHull2D
 		}
 
 		// Simple sorted index lookup table into immutable Points array.
+		// Large sets drop the points that cannot be on the hull first, which leaves far fewer to sort.
 		TArray<uint32, Allocator> SortedIndices;
-		SortedIndices.SetNumUninitialized(PointsNum);
-		for (int32 Index = 0; Index < PointsNum; ++Index)
+		if (PointsNum >= MinPointsToCull)
+		{
+			CullInteriorPoints(Points, SortedIndices);
+			PointsNum = SortedIndices.Num();
+		}
+		else
 		{
-			SortedIndices[Index] = Index;
+			SortedIndices.SetNumUninitialized(PointsNum);
+			for (int32 Index = 0; Index < PointsNum; ++Index)
+			{
+				SortedIndices[Index] = Index;
+			}
 		}
 	
 		// Get rid of costly RangeCheck during sort by using pointer directly
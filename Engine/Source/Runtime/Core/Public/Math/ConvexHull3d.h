@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+
+namespace ConvexHull3D
+{
+	/**
+	 * Quickhull for 3-dimensional points. O(N log H) expected, where H is the number of hull vertices.
+	 *
+	 * 1 - Find a starting tetrahedron from the extreme points
+	 * 2 - Give every point outside it to the face it is furthest in front of, points inside are dropped for good
+	 * 3 - Repeatedly take the furthest point of a face, replace the faces it sees with a fan to their horizon, and hand the
+	 *     points of the removed faces to the new ones
+	 *
+	 * Steps 1 and 2, which see every point, and the redistribution of large point sets run on the task graph in fixed size
+	 * chunks that are merged in order, so the result does not depend on the number of threads.
+	 * Points closer to a face than a tolerance scaled to the size of the input count as on the face, they never create
+	 * slivers and do not end up as hull vertices.
+	 *
+	 * @param Points - The points to enclose.
+	 * @param OutTriangles - Receives three indices into Points per hull triangle, counter clockwise seen from outside
+	 *                       (the normal (B - A) ^ (C - A) points out).
+	 * @param OutVertices - Optionally receives the index of every hull vertex, in increasing order.
+	 * @return false if the points are all near one plane and span no volume, or in the rare case that round-off left the hull
+	 *         inconsistent. The outputs are then empty.
+	 */
+	CORE_API bool ComputeConvexHull(TArrayView<const FVector> Points, TArray<int32>& OutTriangles, TArray<int32>* OutVertices = nullptr);
+}
@@ -4,6 +4,7 @@
 
 #include "CoreTypes.h"
 #include "Logging/LogMacros.h"
+#include "Containers/ArrayView.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogFloatPacker, Log, All);
 
@@ -128,6 +129,30 @@ public:
 
 		return FloatInfo::ToFloatType( (Sign << FloatInfo::SignShift) | (Exponent << FloatInfo::MantissaBits) | (Mantissa) );
 	}
+
+	/** Encode every value of Values into OutPacked, which must have the same size */
+	void EncodeBatch(TArrayView<const FloatType> Values, TArrayView<PackedType> OutPacked) const
+	{
+		check(Values.Num() == OutPacked.Num());
+		const FloatType* RESTRICT Source = Values.GetData();
+		PackedType* RESTRICT Dest = OutPacked.GetData();
+		for (int32 Index = 0, Num = Values.Num(); Index < Num; ++Index)
+		{
+			Dest[Index] = Encode(Source[Index]);
+		}
+	}
+
+	/** Decode every value of Packed into OutValues, which must have the same size */
+	void DecodeBatch(TArrayView<const PackedType> Packed, TArrayView<FloatType> OutValues) const
+	{
+		check(Packed.Num() == OutValues.Num());
+		const PackedType* RESTRICT Source = Packed.GetData();
+		FloatType* RESTRICT Dest = OutValues.GetData();
+		for (int32 Index = 0, Num = Packed.Num(); Index < Num; ++Index)
+		{
+			Dest[Index] = Decode(Source[Index]);
+		}
+	}
 #if 0
 	PackedType EncodeNoSign(FloatType Value)
 	{
@@ -9,6 +9,7 @@
 #include "CoreMinimal.h"
 #include "GenericOctreePublic.h"
 #include "Templates/Models.h"
+#include "Async/ParallelFor.h"
 
 /** A concise iteration over the children of an octree node. */
 #define FOREACH_OCTREE_CHILD_NODE(ChildRef) \
@@ -797,5 +798,537 @@ protected:
 	}
 };
 
+/**
+ * An octree with its nodes and their elements in flat arrays instead of separately allocated nodes, so traversals and updates
+ * walk contiguous memory and element ids are indices that stay valid across reallocations. The 8 children of a node are
+ * allocated together and addressed by the index of the first one; the blocks of collapsed nodes are reused.
+ *
+ * Uses the same semantics as TOctree, with SetElementId taking an FOctreeElementId2:
+ *		static void SetElementId(const ElementType& Element, FOctreeElementId2 Id);
+ *	or	static void SetElementId(TOctree2<ElementType, Semantics>& Octree, const ElementType& Element, FOctreeElementId2 Id);
+ *
+ * Nodes have the same loose bounds as TOctree. UpdateElement relies on them: an element that moves stays in its node for as
+ * long as its new bounds are inside the node's loose bounds, rather than being removed and added again.
+ */
+template<typename ElementType,typename OctreeSemantics>
+class TOctree2
+{
+public:
+
+	typedef TArray<ElementType, typename OctreeSemantics::ElementAllocator> ElementArrayType;
+	typedef uint32 FNodeIndex;
+
+	/** Initialization constructor. */
+	TOctree2(const FVector& InOrigin,float InExtent)
+	:	RootNodeContext(FBoxCenterAndExtent(InOrigin,FVector(InExtent,InExtent,InExtent)),0,0)
+	,	MinLeafExtent(InExtent * FMath::Pow((1.0f + 1.0f / (float)FOctreeNodeContext::LoosenessDenominator) / 2.0f,OctreeSemantics::MaxNodeDepth))
+	{
+		TreeNodes.AddDefaulted();
+		TreeElements.AddDefaulted();
+	}
+
+	/**
+	 * Adds an element to the octree.
+	 * @param Element - The element to add.
+	 */
+	void AddElement(typename TTypeTraits<ElementType>::ConstInitType Element)
+	{
+		AddElementToNode(Element,FBoxCenterAndExtent(OctreeSemantics::GetBoundingBox(Element)),RootNodeIndex,RootNodeContext);
+	}
+
+	/**
+	 * Adds elements to the octree. They are inserted in the Morton order of their centers, so consecutive inserts go down
+	 * mostly the same nodes and the elements that end up in a node were added close together.
+	 */
+	void AddElements(TArrayView<const ElementType> Elements)
+	{
+		const FVector RootMin = RootNodeContext.Bounds.Center - RootNodeContext.Bounds.Extent;
+		const float CellScale = 1023.0f / FMath::Max(2.0f * RootNodeContext.Bounds.Extent.X,SMALL_NUMBER);
+
+		TArray<TPair<uint32,int32>> Order;
+		Order.Reserve(Elements.Num());
+		for(int32 ElementIndex = 0;ElementIndex < Elements.Num();ElementIndex++)
+		{
+			const FVector Cell = (FBoxCenterAndExtent(OctreeSemantics::GetBoundingBox(Elements[ElementIndex])).Center - RootMin) * CellScale;
+			const uint32 MortonCode = SpreadMortonBits(Cell.X) | (SpreadMortonBits(Cell.Y) << 1) | (SpreadMortonBits(Cell.Z) << 2);
+			Order.Emplace(MortonCode,ElementIndex);
+		}
+		Order.Sort([](const TPair<uint32,int32>& A,const TPair<uint32,int32>& B) { return A.Key < B.Key; });
+
+		for(const TPair<uint32,int32>& Entry : Order)
+		{
+			AddElement(Elements[Entry.Value]);
+		}
+	}
+
+	/**
+	 * Removes an element from the octree.
+	 * @param ElementId - The element to remove from the octree.
+	 */
+	void RemoveElement(FOctreeElementId2 ElementId)
+	{
+		// Collapse the largest node that was pushed below the threshold for collapse by the removal.
+		const FNodeIndex CollapseNodeIndex = RemoveElementFromNode(ElementId);
+		if(CollapseNodeIndex != INDEX_NONE && !TreeNodes[CollapseNodeIndex].IsLeaf())
+		{
+			CollapseNode(CollapseNodeIndex);
+		}
+	}
+
+	/**
+	 * Removes elements from the octree. Nodes are only collapsed once all of them are removed, so the ids don't change while
+	 * the batch is processed. The ids must be distinct.
+	 */
+	void RemoveElements(TArrayView<const FOctreeElementId2> ElementIds)
+	{
+		// From the last element of each node to the first, so the element swapped into a removed slot is never one to remove
+		TArray<FOctreeElementId2> SortedIds(ElementIds.GetData(),ElementIds.Num());
+		SortedIds.Sort([](const FOctreeElementId2& A,const FOctreeElementId2& B)
+		{
+			return A.NodeIndex != B.NodeIndex ? A.NodeIndex < B.NodeIndex : A.ElementIndex > B.ElementIndex;
+		});
+
+		for(const FOctreeElementId2& ElementId : SortedIds)
+		{
+			RemoveElementFromNode(ElementId);
+		}
+		CollapseNodesBelowThreshold(RootNodeIndex);
+	}
+
+	/**
+	 * Replaces an element with a new version of it, e.g. after it moved. The element stays in its node when its new bounds are
+	 * still inside the node's loose bounds, otherwise it is removed and added again.
+	 * @return true if the element kept its id.
+	 */
+	bool UpdateElement(FOctreeElementId2 ElementId,typename TTypeTraits<ElementType>::ConstInitType NewElement)
+	{
+		check(IsValidElementId(ElementId));
+
+		const FBoxCenterAndExtent NewBounds(OctreeSemantics::GetBoundingBox(NewElement));
+		const FOctreeNodeContext Context = GetNodeContext(ElementId.NodeIndex);
+		const VectorRegister Distance = VectorAdd(VectorAbs(VectorSubtract(VectorLoadAligned(&NewBounds.Center),VectorLoadAligned(&Context.Bounds.Center))),VectorLoadAligned(&NewBounds.Extent));
+		if(ElementId.NodeIndex == RootNodeIndex || !VectorAnyGreaterThan(Distance,VectorLoadAligned(&Context.Bounds.Extent)))
+		{
+			TreeElements[ElementId.NodeIndex][ElementId.ElementIndex] = NewElement;
+			SetElementId(TreeElements[ElementId.NodeIndex][ElementId.ElementIndex],ElementId);
+			return true;
+		}
+
+		RemoveElement(ElementId);
+		AddElement(NewElement);
+		return false;
+	}
+
+	void Destroy()
+	{
+		TreeNodes.Reset(1);
+		TreeNodes.AddDefaulted();
+		TreeElements.Reset(1);
+		TreeElements.AddDefaulted();
+		ParentLinks.Reset();
+		FreeList.Reset();
+	}
+
+	/** Accesses an octree element by ID. */
+	ElementType& GetElementById(FOctreeElementId2 ElementId)
+	{
+		check(ElementId.IsValidId());
+		return TreeElements[ElementId.NodeIndex][ElementId.ElementIndex];
+	}
+
+	/** Accesses an octree element by ID. */
+	const ElementType& GetElementById(FOctreeElementId2 ElementId) const
+	{
+		check(ElementId.IsValidId());
+		return TreeElements[ElementId.NodeIndex][ElementId.ElementIndex];
+	}
+
+	/** Checks if given ElementId represents a valid Octree element */
+	bool IsValidElementId(FOctreeElementId2 ElementId) const
+	{
+		return ElementId.IsValidId()
+			&& ElementId.NodeIndex < (uint32)TreeElements.Num()
+			&& ElementId.ElementIndex != INDEX_NONE
+			&& ElementId.ElementIndex < TreeElements[ElementId.NodeIndex].Num();
+	}
+
+	/** Calls Func on every element of the octree, in the order they are stored. */
+	template<typename IterateAllElementsFunc>
+	void FindAllElements(const IterateAllElementsFunc& Func) const
+	{
+		for(const ElementArrayType& Elements : TreeElements)
+		{
+			for(const ElementType& Element : Elements)
+			{
+				Func(Element);
+			}
+		}
+	}
+
+	/** Calls Func on every element whose bounding box intersects BoxBounds. */
+	template<typename IterateBoundsFunc>
+	void FindElementsWithBoundsTest(const FBoxCenterAndExtent& BoxBounds,const IterateBoundsFunc& Func) const
+	{
+		if(TreeNodes[RootNodeIndex].InclusiveNumElements > 0)
+		{
+			FindElementsWithBoundsTestInternal(RootNodeIndex,RootNodeContext,BoxBounds,Func);
+		}
+	}
+
+	/**
+	 * Runs FindElementsWithBoundsTest for each of Queries with ParallelFor, and calls Func(QueryIndex, Element) for every
+	 * element it finds. Func is called from several threads at once, and the octree must not be modified meanwhile.
+	 */
+	template<typename IterateBoundsFunc>
+	void ParallelFindElementsWithBoundsTest(TArrayView<const FBoxCenterAndExtent> Queries,const IterateBoundsFunc& Func) const
+	{
+		ParallelFor(Queries.Num(),[this,&Queries,&Func](int32 QueryIndex)
+		{
+			FindElementsWithBoundsTest(Queries[QueryIndex],[QueryIndex,&Func](const ElementType& Element)
+			{
+				Func(QueryIndex,Element);
+			});
+		});
+	}
+
+	/** @return The number of elements in the octree. */
+	int32 GetNumElements() const
+	{
+		return TreeNodes[RootNodeIndex].InclusiveNumElements;
+	}
+
+	/** @return The number of nodes that are in use, including the root. */
+	int32 GetNumNodes() const
+	{
+		return TreeNodes.Num() - FreeList.Num() * 8;
+	}
+
+	SIZE_T GetSizeBytes() const
+	{
+		SIZE_T TotalSizeBytes = TreeNodes.GetAllocatedSize() + TreeElements.GetAllocatedSize() + ParentLinks.GetAllocatedSize() + FreeList.GetAllocatedSize();
+		for(const ElementArrayType& Elements : TreeElements)
+		{
+			TotalSizeBytes += Elements.GetAllocatedSize();
+		}
+		return TotalSizeBytes;
+	}
+
+	float GetNodeLevelExtent(int32 Level) const
+	{
+		const int32 ClampedLevel = FMath::Clamp<uint32>(Level, 0, OctreeSemantics::MaxNodeDepth);
+		return RootNodeContext.Bounds.Extent.X * FMath::Pow((1.0f + 1.0f / (float)FOctreeNodeContext::LoosenessDenominator) / 2.0f, ClampedLevel);
+	}
+
+	FBoxCenterAndExtent GetRootBounds() const
+	{
+		return RootNodeContext.Bounds;
+	}
+
+	void ShrinkElements()
+	{
+		for(ElementArrayType& Elements : TreeElements)
+		{
+			Elements.Shrink();
+		}
+	}
+
+private:
+
+	/** A node in the octree, its elements are in TreeElements at the same index. */
+	struct FNode
+	{
+		/** The index of the first of the node's 8 children, or INDEX_NONE for a leaf. */
+		FNodeIndex ChildNodes;
+
+		/** The number of elements contained by the node and its child nodes. */
+		uint32 InclusiveNumElements;
+
+		FNode()
+		:	ChildNodes(INDEX_NONE)
+		,	InclusiveNumElements(0)
+		{}
+
+		bool IsLeaf() const
+		{
+			return ChildNodes == INDEX_NONE;
+		}
+	};
+
+	enum { RootNodeIndex = 0 };
+
+	/** The octree's root node's context. */
+	FOctreeNodeContext RootNodeContext;
+
+	/** The root, then the children of the nodes in blocks of 8. */
+	TArray<FNode> TreeNodes;
+
+	/** The elements of each node. */
+	TArray<ElementArrayType> TreeElements;
+
+	/** The parent of each block of children, INDEX_NONE for the free blocks. */
+	TArray<FNodeIndex> ParentLinks;
+
+	/** The blocks of children that were freed by collapsing nodes. */
+	TArray<FNodeIndex> FreeList;
+
+	/** The extent of a leaf at the maximum allowed depth of the tree. */
+	float MinLeafExtent;
+
+	/** Spreads the low 10 bits of a grid coordinate to every third bit, clamping it to the grid. */
+	static uint32 SpreadMortonBits(float Coordinate)
+	{
+		uint32 Bits = (uint32)FMath::Clamp(Coordinate,0.0f,1023.0f);
+		Bits = (Bits | (Bits << 16)) & 0x030000FF;
+		Bits = (Bits | (Bits << 8)) & 0x0300F00F;
+		Bits = (Bits | (Bits << 4)) & 0x030C30C3;
+		Bits = (Bits | (Bits << 2)) & 0x09249249;
+		return Bits;
+	}
+
+	static FNodeIndex GetBlockIndex(FNodeIndex NodeIndex)
+	{
+		return (NodeIndex - 1) / 8;
+	}
+
+	FNodeIndex GetParentIndex(FNodeIndex NodeIndex) const
+	{
+		return ParentLinks[GetBlockIndex(NodeIndex)];
+	}
+
+	/** Rebuilds the context of a node from the path to the root, nodes don't store their bounds. */
+	FOctreeNodeContext GetNodeContext(FNodeIndex NodeIndex) const
+	{
+		TArray<uint8,TInlineAllocator<OctreeSemantics::MaxNodeDepth + 1>> ChildPath;
+		for(FNodeIndex Index = NodeIndex;Index != RootNodeIndex;Index = GetParentIndex(Index))
+		{
+			ChildPath.Add((uint8)((Index - 1) % 8));
+		}
+
+		FOctreeNodeContext Context = RootNodeContext;
+		for(int32 PathIndex = ChildPath.Num() - 1;PathIndex >= 0;PathIndex--)
+		{
+			Context = Context.GetChildContext(FOctreeChildNodeRef(ChildPath[PathIndex]));
+		}
+		return Context;
+	}
+
+	/** Allocates the 8 children of a node, from the free list if there are any. */
+	FNodeIndex AllocateChildren(FNodeIndex ParentIndex)
+	{
+		FNodeIndex ChildNodes;
+		if(FreeList.Num())
+		{
+			ChildNodes = FreeList.Pop(false);
+		}
+		else
+		{
+			ChildNodes = (FNodeIndex)TreeNodes.Num();
+			TreeNodes.AddDefaulted(8);
+			TreeElements.AddDefaulted(8);
+			ParentLinks.Add(INDEX_NONE);
+		}
+		ParentLinks[GetBlockIndex(ChildNodes)] = ParentIndex;
+		return ChildNodes;
+	}
+
+	/** Frees the children of a node and their own children. Their elements must have been moved out. */
+	void FreeChildren(FNodeIndex NodeIndex)
+	{
+		const FNodeIndex ChildNodes = TreeNodes[NodeIndex].ChildNodes;
+		for(FNodeIndex ChildIndex = ChildNodes;ChildIndex < ChildNodes + 8;ChildIndex++)
+		{
+			if(!TreeNodes[ChildIndex].IsLeaf())
+			{
+				FreeChildren(ChildIndex);
+			}
+			checkSlow(TreeElements[ChildIndex].Num() == 0);
+			TreeNodes[ChildIndex] = FNode();
+		}
+		ParentLinks[GetBlockIndex(ChildNodes)] = INDEX_NONE;
+		FreeList.Add(ChildNodes);
+		TreeNodes[NodeIndex].ChildNodes = INDEX_NONE;
+	}
+
+	/** Adds an element to a node or its children. */
+	void AddElementToNode(typename TTypeTraits<ElementType>::ConstInitType Element,const FBoxCenterAndExtent& ElementBounds,FNodeIndex NodeIndex,const FOctreeNodeContext& Context)
+	{
+		// Increment the number of elements included in this node and its children.
+		TreeNodes[NodeIndex].InclusiveNumElements++;
+
+		if(TreeNodes[NodeIndex].IsLeaf())
+		{
+			// If this is a leaf, check if adding this element would turn it into a node by overflowing its element list.
+			if(TreeElements[NodeIndex].Num() + 1 > OctreeSemantics::MaxElementsPerLeaf && Context.Bounds.Extent.X > MinLeafExtent)
+			{
+				// Copy the leaf's elements, remove them from the leaf, and turn it into a node.
+				ElementArrayType ChildElements = MoveTemp(TreeElements[NodeIndex]);
+				const FNodeIndex ChildNodes = AllocateChildren(NodeIndex);
+				TreeNodes[NodeIndex].ChildNodes = ChildNodes;
+				TreeNodes[NodeIndex].InclusiveNumElements = 0;
+
+				// Re-add all of the node's child elements, potentially creating children of this node for them.
+				for(const ElementType& ChildElement : ChildElements)
+				{
+					AddElementToNode(ChildElement,FBoxCenterAndExtent(OctreeSemantics::GetBoundingBox(ChildElement)),NodeIndex,Context);
+				}
+
+				// Add the element to this node.
+				AddElementToNode(Element,ElementBounds,NodeIndex,Context);
+				return;
+			}
+		}
+		else
+		{
+			// If this isn't a leaf, find a child that entirely contains the element.
+			const FOctreeChildNodeRef ChildRef = Context.GetContainingChild(ElementBounds);
+			if(!ChildRef.IsNULL())
+			{
+				AddElementToNode(Element,ElementBounds,TreeNodes[NodeIndex].ChildNodes + ChildRef.Index,Context.GetChildContext(ChildRef));
+				return;
+			}
+		}
+
+		// Add the element to this node.
+		const int32 ElementIndex = TreeElements[NodeIndex].Emplace(Element);
+		SetElementId(TreeElements[NodeIndex][ElementIndex],FOctreeElementId2(NodeIndex,ElementIndex));
+	}
+
+	/**
+	 * Removes an element from its node and updates the inclusive element counts up to the root.
+	 * @return The largest node that the removal pushed below the threshold for collapse, or INDEX_NONE.
+	 */
+	FNodeIndex RemoveElementFromNode(FOctreeElementId2 ElementId)
+	{
+		check(IsValidElementId(ElementId));
+
+		// Remove the element from the node's element list.
+		ElementArrayType& Elements = TreeElements[ElementId.NodeIndex];
+		Elements.RemoveAtSwap(ElementId.ElementIndex);
+		if(ElementId.ElementIndex < Elements.Num())
+		{
+			// Update the external element id for the element that was swapped into the vacated element index.
+			SetElementId(Elements[ElementId.ElementIndex],ElementId);
+		}
+
+		FNodeIndex CollapseNodeIndex = INDEX_NONE;
+		for(FNodeIndex NodeIndex = ElementId.NodeIndex;;NodeIndex = GetParentIndex(NodeIndex))
+		{
+			FNode& Node = TreeNodes[NodeIndex];
+			--Node.InclusiveNumElements;
+			if(Node.InclusiveNumElements < OctreeSemantics::MinInclusiveElementsPerNode)
+			{
+				CollapseNodeIndex = NodeIndex;
+			}
+			if(NodeIndex == RootNodeIndex)
+			{
+				break;
+			}
+		}
+		return CollapseNodeIndex;
+	}
+
+	/** Moves the elements of the children of a node into it and frees the children. */
+	void CollapseNode(FNodeIndex NodeIndex)
+	{
+		ElementArrayType& CollapsedElements = TreeElements[NodeIndex];
+		CollapsedElements.Reserve(TreeNodes[NodeIndex].InclusiveNumElements);
+		MoveChildElements(NodeIndex,NodeIndex);
+		FreeChildren(NodeIndex);
+	}
+
+	void MoveChildElements(FNodeIndex NodeIndex,FNodeIndex CollapseNodeIndex)
+	{
+		const FNodeIndex ChildNodes = TreeNodes[NodeIndex].ChildNodes;
+		for(FNodeIndex ChildIndex = ChildNodes;ChildIndex < ChildNodes + 8;ChildIndex++)
+		{
+			for(ElementType& Element : TreeElements[ChildIndex])
+			{
+				const int32 NewElementIndex = TreeElements[CollapseNodeIndex].Add(MoveTemp(Element));
+
+				// Update the external element id for the element that's being collapsed.
+				SetElementId(TreeElements[CollapseNodeIndex][NewElementIndex],FOctreeElementId2(CollapseNodeIndex,NewElementIndex));
+			}
+			TreeElements[ChildIndex].Empty();
+
+			if(!TreeNodes[ChildIndex].IsLeaf())
+			{
+				MoveChildElements(ChildIndex,CollapseNodeIndex);
+			}
+		}
+	}
+
+	/** Collapses the largest nodes below the threshold for collapse, after a batch of removals. */
+	void CollapseNodesBelowThreshold(FNodeIndex NodeIndex)
+	{
+		if(TreeNodes[NodeIndex].IsLeaf())
+		{
+			return;
+		}
+
+		if(TreeNodes[NodeIndex].InclusiveNumElements < OctreeSemantics::MinInclusiveElementsPerNode)
+		{
+			CollapseNode(NodeIndex);
+			return;
+		}
+
+		const FNodeIndex ChildNodes = TreeNodes[NodeIndex].ChildNodes;
+		for(FNodeIndex ChildIndex = ChildNodes;ChildIndex < ChildNodes + 8;ChildIndex++)
+		{
+			CollapseNodesBelowThreshold(ChildIndex);
+		}
+	}
+
+	template<typename IterateBoundsFunc>
+	void FindElementsWithBoundsTestInternal(FNodeIndex NodeIndex,const FOctreeNodeContext& Context,const FBoxCenterAndExtent& BoxBounds,const IterateBoundsFunc& Func) const
+	{
+		for(const ElementType& Element : TreeElements[NodeIndex])
+		{
+			if(Intersect(OctreeSemantics::GetBoundingBox(Element),BoxBounds))
+			{
+				Func(Element);
+			}
+		}
+
+		if(!TreeNodes[NodeIndex].IsLeaf())
+		{
+			const FNodeIndex ChildNodes = TreeNodes[NodeIndex].ChildNodes;
+			const FOctreeChildNodeSubset IntersectingChildSubset = Context.GetIntersectingChildren(BoxBounds);
+			FOREACH_OCTREE_CHILD_NODE(ChildRef)
+			{
+				if(IntersectingChildSubset.Contains(ChildRef) && TreeNodes[ChildNodes + ChildRef.Index].InclusiveNumElements > 0)
+				{
+					FindElementsWithBoundsTestInternal(ChildNodes + ChildRef.Index,Context.GetChildContext(ChildRef),BoxBounds,Func);
+				}
+			}
+		}
+	}
+
+	// Concept definition for the semantics that take the octree, see TOctree
+	struct COctreeSemanticsV2
+	{
+		template<typename Semantics>
+		auto Requires(typename Semantics::FOctree& OctreeInstance, const ElementType& Element, FOctreeElementId2 Id)
+			-> decltype(Semantics::SetElementId(OctreeInstance, Element, Id));
+	};
+
+	template <typename Semantics>
+	typename TEnableIf<!TModels<COctreeSemanticsV2, Semantics>::Value>::Type SetOctreeSemanticsElementId(const ElementType& Element, FOctreeElementId2 Id)
+	{
+		Semantics::SetElementId(Element, Id);
+	}
+	template <typename Semantics>
+	typename TEnableIf<TModels<COctreeSemanticsV2, Semantics>::Value>::Type SetOctreeSemanticsElementId(const ElementType& Element, FOctreeElementId2 Id)
+	{
+		Semantics::SetElementId(*this, Element, Id);
+	}
+
+protected:
+	// redirects SetElementId call to the proper implementation
+	void SetElementId(const ElementType& Element, FOctreeElementId2 Id)
+	{
+		SetOctreeSemanticsElementId<OctreeSemantics>(Element, Id);
+	}
+};
+
 #include "GenericOctree.inl"
 
@@ -50,3 +50,51 @@ private:
 		return ElementIndex;
 	}
 };
+
+/**
+ *	An identifier for an element in a TOctree2, the index of its node instead of a pointer to it.
+ */
+class FOctreeElementId2
+{
+public:
+
+	template<typename,typename>
+	friend class TOctree2;
+
+	/** Default constructor. */
+	FOctreeElementId2()
+		:	NodeIndex(INDEX_NONE)
+		,	ElementIndex(INDEX_NONE)
+	{}
+
+	/** @return a boolean value representing whether the id is NULL. */
+	bool IsValidId() const
+	{
+		return NodeIndex != INDEX_NONE;
+	}
+
+	uint32 GetNodeIndex() const
+	{
+		return NodeIndex;
+	}
+
+private:
+
+	/** The index of the node the element is in. */
+	uint32 NodeIndex;
+
+	/** The index of the element in the node's element array. */
+	int32 ElementIndex;
+
+	/** Initialization constructor. */
+	FOctreeElementId2(uint32 InNodeIndex,int32 InElementIndex)
+		:	NodeIndex(InNodeIndex)
+		,	ElementIndex(InElementIndex)
+	{}
+
+	/** Implicit conversion to the element index. */
+	operator int32() const
+	{
+		return ElementIndex;
+	}
+};
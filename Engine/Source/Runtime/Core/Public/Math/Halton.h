@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/ArrayView.h"
 
 
 /** [ Halton 1964, "Radical-inverse quasi-random point sequence" ] */
@@ -19,3 +20,15 @@ inline float Halton(int32 Index, int32 Base)
 	}
 	return Result;
 }
+
+/**
+ * Evaluate a block of consecutive multi-dimensional Halton points, point major, with the first NumDims primes as bases:
+ * OutValues[Point * NumDims + Dim] is the radical inverse of FirstIndex + Point in the Dim-th prime.
+ * The digits are updated incrementally in fixed point, so there is no accumulated rounding error and the
+ * result is the same however the batch is split over the task graph. It can differ from Halton() in the last bit.
+ *
+ * @param FirstIndex - The index of the first point.
+ * @param NumDims - The number of dimensions per point (1-16).
+ * @param OutValues - Receives the points, its size must be a multiple of NumDims.
+ */
+CORE_API void HaltonBatch(int32 FirstIndex, int32 NumDims, TArrayView<float> OutValues);
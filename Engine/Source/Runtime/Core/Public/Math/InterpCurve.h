@@ -5,6 +5,7 @@
 #include "CoreTypes.h"
 #include "Misc/AssertionMacros.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Math/UnrealMathUtility.h"
 #include "Math/Color.h"
 #include "Math/Vector2D.h"
@@ -79,6 +80,18 @@ public:
 	 */
 	T Eval( const float InVal, const T& Default = T(ForceInit) ) const;
 
+	/**
+	 *	Evaluate the output for each of an array of input values, the same as calling Eval for each of them.
+	 *	Sorted inputs step from one segment to the next instead of searching for each.
+	 */
+	void EvalMany( TArrayView<const float> InVals, TArrayView<T> OutVals, const T& Default = T(ForceInit) ) const;
+
+	/**
+	 *	Evaluate the output for an input value on a curve with points, given the index GetPointIndexForInputValue
+	 *	returns for it. Eval is a search for the index followed by this.
+	 */
+	T EvalForPointIndex( const int32 Index, const float InVal ) const;
+
 	/** 
 	 *	Evaluate the derivative at a point on the curve.
 	 */
@@ -288,17 +301,22 @@ int32 FInterpCurve<T>::GetPointIndexForInputValue(const float InValue) const
 template< class T >
 T FInterpCurve<T>::Eval(const float InVal, const T& Default) const
 {
-	const int32 NumPoints = Points.Num();
-	const int32 LastPoint = NumPoints - 1;
-
 	// If no point in curve, return the Default value we passed in.
-	if (NumPoints == 0)
+	if (Points.Num() == 0)
 	{
 		return Default;
 	}
 
 	// Binary search to find index of lower bound of input value
-	const int32 Index = GetPointIndexForInputValue(InVal);
+	return EvalForPointIndex(GetPointIndexForInputValue(InVal), InVal);
+}
+
+
+template< class T >
+T FInterpCurve<T>::EvalForPointIndex(const int32 Index, const float InVal) const
+{
+	const int32 NumPoints = Points.Num();
+	const int32 LastPoint = NumPoints - 1;
 
 	// If before the first point, return its value
 	if (Index == -1)
@@ -714,6 +732,90 @@ void FInterpCurve<T>::CalcBounds(T& OutMin, T& OutMax, const T& Default) const
 
 
 
+/**
+ * Evaluates an FInterpCurve the same as FInterpCurve::Eval, remembering the segment the last input fell in.
+ * Inputs that stay in that segment or move on by a few segments are found without a binary search, which
+ * makes evaluating at increasing times, like once per tick, constant time.
+ *
+ * The curve must outlive the evaluator. Call Reset when its points change.
+ */
+template<class T>
+class TInterpCurveEvaluator
+{
+public:
+
+	explicit TInterpCurveEvaluator( const FInterpCurve<T>& InCurve )
+		: Curve(InCurve)
+		, CachedIndex(-1)
+	{
+	}
+
+	/** Evaluate the output for an arbitrary input value, see FInterpCurve::Eval. */
+	T Eval( const float InVal, const T& Default = T(ForceInit) )
+	{
+		if (Curve.Points.Num() == 0)
+		{
+			return Default;
+		}
+
+		return Curve.EvalForPointIndex(FindPointIndex(InVal), InVal);
+	}
+
+	/** Forget the remembered segment. */
+	void Reset()
+	{
+		CachedIndex = -1;
+	}
+
+private:
+
+	/** How many segments to step forward before falling back to a binary search */
+	enum { MaxForwardSteps = 4 };
+
+	/** Same as FInterpCurve::GetPointIndexForInputValue */
+	int32 FindPointIndex( const float InVal )
+	{
+		const TArray<FInterpCurvePoint<T>>& Points = Curve.Points;
+		const int32 LastPoint = Points.Num() - 1;
+
+		int32 Index = CachedIndex;
+		if (Index <= LastPoint && (Index == -1 || Points[Index].InVal <= InVal))
+		{
+			for (int32 Step = 0; Step < MaxForwardSteps; ++Step, ++Index)
+			{
+				if (Index == LastPoint || InVal < Points[Index + 1].InVal)
+				{
+					CachedIndex = Index;
+					return Index;
+				}
+			}
+		}
+
+		CachedIndex = Curve.GetPointIndexForInputValue(InVal);
+		return CachedIndex;
+	}
+
+	const FInterpCurve<T>& Curve;
+
+	/** Index GetPointIndexForInputValue returned for the last input */
+	int32 CachedIndex;
+};
+
+
+template< class T >
+void FInterpCurve<T>::EvalMany(TArrayView<const float> InVals, TArrayView<T> OutVals, const T& Default) const
+{
+	check(InVals.Num() == OutVals.Num());
+
+	TInterpCurveEvaluator<T> Evaluator(*this);
+	for (int32 Index = 0; Index < InVals.Num(); ++Index)
+	{
+		OutVals[Index] = Evaluator.Eval(InVals[Index], Default);
+	}
+}
+
+
+
 /* Common type definitions
  *****************************************************************************/
 
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Math/Float16.h"
+
+/**
+ * Bulk conversions between float arrays and the compact formats used for vertex streams, replication and storage.
+ *
+ * The half conversions use F16C on x64 targets compiled for it and the AArch64 conversion instructions on NEON, and a loop
+ * over FFloat16 everywhere else. The hardware paths follow FFloat16::Set and GetFloat: values are truncated, out of range
+ * values, infinities and NaNs become +-65504. Only values that land on half denormals can differ in the last bit.
+ *
+ * The normalized formats are FFixedRGBASigned8 style: SNorm scales by the largest positive integer and clamps, UNorm scales
+ * by the largest integer and clamps at zero, both round to nearest. Packed vertex normals (8 bit SNorm) and 16 bit tangent
+ * frames (16 bit SNorm) use the same encodings, so they can be filled component-wise from these.
+ *
+ * Input and output views must have the same number of elements.
+ */
+struct CORE_API FQuantizeBatch
+{
+	/** Out[i] = FFloat16(In[i]) */
+	static void FloatToHalf(TArrayView<const float> In, TArrayView<FFloat16> Out);
+
+	/** Out[i] = In[i].GetFloat() */
+	static void HalfToFloat(TArrayView<const FFloat16> In, TArrayView<float> Out);
+
+	/** Out[i] = round(clamp(In[i], -1, 1) * 127) */
+	static void QuantizeSNorm8(TArrayView<const float> In, TArrayView<int8> Out);
+
+	/** Out[i] = In[i] / 127 */
+	static void DequantizeSNorm8(TArrayView<const int8> In, TArrayView<float> Out);
+
+	/** Out[i] = round(clamp(In[i], 0, 1) * 255) */
+	static void QuantizeUNorm8(TArrayView<const float> In, TArrayView<uint8> Out);
+
+	/** Out[i] = In[i] / 255 */
+	static void DequantizeUNorm8(TArrayView<const uint8> In, TArrayView<float> Out);
+
+	/** Out[i] = round(clamp(In[i], -1, 1) * 32767) */
+	static void QuantizeSNorm16(TArrayView<const float> In, TArrayView<int16> Out);
+
+	/** Out[i] = In[i] / 32767 */
+	static void DequantizeSNorm16(TArrayView<const int16> In, TArrayView<float> Out);
+
+	/** Out[i] = round(clamp(In[i], 0, 1) * 65535) */
+	static void QuantizeUNorm16(TArrayView<const float> In, TArrayView<uint16> Out);
+
+	/** Out[i] = In[i] / 65535 */
+	static void DequantizeUNorm16(TArrayView<const uint16> In, TArrayView<float> Out);
+};
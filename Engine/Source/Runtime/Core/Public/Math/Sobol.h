@@ -5,6 +5,7 @@
 #include "CoreTypes.h"
 #include "Math/Vector2D.h"
 #include "Math/Vector.h"
+#include "Containers/ArrayView.h"
 
 /**
  * Support for Sobol quasi-random numbers
@@ -63,6 +64,28 @@ public:
 	*/
 	static float Next(int32 Index, int32 Dim, float Value);
 
+	/**
+	 * Evaluate a block of consecutive multi-dimensional Sobol points, point major:
+	 * OutValues[Point * NumDims + Dim] == Evaluate(FirstIndex + Point, Dim, Seeds[Dim]).
+	 * After the first point of each chunk every point is one Gray code update per four dimensions, and large batches are
+	 * split into chunks over the task graph. Each chunk restarts from Evaluate, so the result is bit exact however it is split.
+	 *
+	 * @param FirstIndex - The index of the first point.
+	 * @param NumDims - The number of dimensions per point (1-16), starting at dimension 0.
+	 * @param OutValues - Receives the points, its size must be a multiple of NumDims.
+	 * @param Seeds - A 24-bit seed per dimension, or empty for the unscrambled sequence. See ComputeScrambleSeeds.
+	 */
+	static void EvaluateBatch(int32 FirstIndex, int32 NumDims, TArrayView<float> OutValues, TArrayView<const int32> Seeds = TArrayView<const int32>());
+
+	/**
+	 * Derive independent 24-bit seeds for each dimension from one seed, for EvaluateBatch.
+	 * Dimensions that share a seed are shifted by the same amount, so one seed for all of them keeps their correlation.
+	 *
+	 * @param Seed - The seed for the whole point set.
+	 * @param OutSeeds - Receives a seed per dimension.
+	 */
+	static void ComputeScrambleSeeds(uint32 Seed, TArrayView<int32> OutSeeds);
+
 
 	/**
 	* Evaluate Sobol number from within a 2D cell at given index
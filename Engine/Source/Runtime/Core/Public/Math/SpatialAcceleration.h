@@ -0,0 +1,932 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/SparseArray.h"
+#include "Math/Vector.h"
+#include "Math/IntVector.h"
+#include "Math/Box.h"
+#include "Math/Sphere.h"
+#include "Math/Ray.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * General spatial indices for elements with box bounds:
+ *
+ * TBoundingVolumeHierarchy, a binary tree of boxes built over a set of elements with the surface area heuristic. For elements
+ * that are added all at once and move little; Refit updates the bounds after they moved without rebuilding the tree.
+ * TSpatialHashGrid, a uniform grid of cells in a hash map, for elements that are added, removed and moved all the time and
+ * have about the same size.
+ *
+ * Both take the semantics of their elements as a template parameter, like TOctree:
+ *		static FBox GetBoundingBox(const ElementType& Element);
+ *
+ * and have the same box, sphere and ray queries. Queries are const and don't write to any shared state, so any number of them
+ * can run at the same time from different threads, as long as nothing modifies the structure meanwhile.
+ *
+ * The box and sphere queries call Func(const ElementType&) once for every element whose bounds intersect the shape. The ray
+ * queries call Func(const ElementType&, float EntryDistance) for every element whose bounds the ray hits within MaxDistance,
+ * with the distance where the ray enters the bounds, 0 if it starts inside them. Func returns the distance the query
+ * continues to: MaxDistance to find every element, or the distance of its own hit on the element to find the closest one.
+ * The elements aren't visited in order of distance.
+ */
+
+namespace UE4SpatialAcceleration_Private
+{
+	/** A box with two spare ints in the W lanes, so it loads as two registers. */
+	struct FPackedBox
+	{
+		FVector Min;
+		int32 FirstIndex;
+		FVector Max;
+		int32 NumElements;
+
+		FPackedBox()
+		:	Min(ForceInitToZero)
+		,	FirstIndex(0)
+		,	Max(ForceInitToZero)
+		,	NumElements(0)
+		{}
+
+		explicit FPackedBox(const FBox& Box)
+		:	Min(Box.Min)
+		,	FirstIndex(0)
+		,	Max(Box.Max)
+		,	NumElements(0)
+		{}
+
+		FORCEINLINE VectorRegister LoadMin() const { return VectorLoad(&Min); }
+		FORCEINLINE VectorRegister LoadMax() const { return VectorLoad(&Max); }
+
+		/** Stores the XYZ of the bounds, leaving the ints in W alone */
+		FORCEINLINE void StoreBounds(const VectorRegister& InMin, const VectorRegister& InMax)
+		{
+			VectorStoreFloat3(InMin, &Min);
+			VectorStoreFloat3(InMax, &Max);
+		}
+	};
+
+	/** Boxes touching on a face count as intersecting, like FBox::Intersect. The W lanes are ignored. */
+	FORCEINLINE bool BoxesIntersect(const VectorRegister& MinA, const VectorRegister& MaxA, const VectorRegister& MinB, const VectorRegister& MaxB)
+	{
+		return (VectorMaskBits(VectorBitwiseOr(VectorCompareGT(MinA, MaxB), VectorCompareGT(MinB, MaxA))) & 7) == 0;
+	}
+
+	FORCEINLINE bool SphereIntersectsBox(const VectorRegister& Center, float RadiusSquared, const VectorRegister& Min, const VectorRegister& Max)
+	{
+		// Distance from the center to the closest point of the box, per axis
+		const VectorRegister Distance = VectorMax(VectorMax(VectorSubtract(Min, Center), VectorSubtract(Center, Max)), VectorZero());
+		const VectorRegister DistanceXYZ = VectorSet_W0(Distance);
+		return VectorGetComponent(VectorDot3(DistanceXYZ, DistanceXYZ), 0) <= RadiusSquared;
+	}
+
+	/** The slab test of a ray against boxes. */
+	struct FRayBoxTest
+	{
+		VectorRegister Origin;
+		VectorRegister InvDirection;
+
+		explicit FRayBoxTest(const FRay& Ray)
+		:	Origin(VectorLoadFloat3_W0(&Ray.Origin))
+		{
+			// Reciprocal gives BIG_NUMBER for 0, which keeps the axis parallel to the ray out of the NaNs
+			const FVector Reciprocal = Ray.Direction.Reciprocal();
+			InvDirection = VectorLoadFloat3_W0(&Reciprocal);
+		}
+
+		/** @return true if the ray hits the box before MaxDistance, with the distance where it enters it. */
+		FORCEINLINE bool Intersect(const VectorRegister& Min, const VectorRegister& Max, float MaxDistance, float& OutEntryDistance) const
+		{
+			const VectorRegister T0 = VectorMultiply(VectorSubtract(Min, Origin), InvDirection);
+			const VectorRegister T1 = VectorMultiply(VectorSubtract(Max, Origin), InvDirection);
+			const VectorRegister Near = VectorMin(T0, T1);
+			const VectorRegister Far = VectorMax(T0, T1);
+			const VectorRegister Entry = VectorMax(VectorMax(VectorReplicate(Near, 0), VectorReplicate(Near, 1)), VectorMax(VectorReplicate(Near, 2), VectorZero()));
+			const VectorRegister Exit = VectorMin(VectorMin(VectorReplicate(Far, 0), VectorReplicate(Far, 1)), VectorMin(VectorReplicate(Far, 2), VectorSetFloat1(MaxDistance)));
+			VectorStoreFloat1(Entry, &OutEntryDistance);
+			return !VectorAnyGreaterThan(Entry, Exit);
+		}
+	};
+
+	/** Below this many elements the work isn't worth spreading over the task graph */
+	enum { MinParallelElements = 4096 };
+}
+
+/**
+ * A bounding volume hierarchy over a set of elements, see SpatialAcceleration.h. The nodes are in one array, in depth first
+ * order, and the elements are copied in the order of the leaves, so a query reads contiguous memory.
+ */
+template<typename ElementType, typename Semantics>
+class TBoundingVolumeHierarchy
+{
+public:
+
+	/** @param InMaxElementsPerLeaf - Nodes with more elements than this are always split. */
+	explicit TBoundingVolumeHierarchy(int32 InMaxElementsPerLeaf = 4)
+	:	MaxElementsPerLeaf(FMath::Max(InMaxElementsPerLeaf, 1))
+	{}
+
+	/**
+	 * Builds the hierarchy over a copy of the elements, replacing the previous one. The splits are chosen with the surface
+	 * area heuristic on binned centroids, and the subtrees below the first levels are built in parallel.
+	 */
+	void Build(TArrayView<const ElementType> InElements)
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		Nodes.Reset();
+		Elements.Reset();
+		ElementBounds.Reset();
+		BuildIndexToPosition.Reset();
+
+		const int32 NumElements = InElements.Num();
+		if (NumElements == 0)
+		{
+			return;
+		}
+
+		const EParallelForFlags ParallelFlags = NumElements < MinParallelElements ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+		FBuildContext Context;
+		Context.Bounds.SetNumUninitialized(NumElements);
+		Context.Centroids.SetNumUninitialized(NumElements);
+		Context.Indices.SetNumUninitialized(NumElements);
+		ParallelFor(NumElements, [&Context, &InElements](int32 Index)
+		{
+			const FBox Box = Semantics::GetBoundingBox(InElements[Index]);
+			Context.Bounds[Index] = FPackedBox(Box);
+			Context.Centroids[Index] = Box.GetCenter();
+			Context.Indices[Index] = Index;
+		}, ParallelFlags);
+
+		// The first levels here, the subtrees below them on the task graph
+		TArray<FSubtree> Subtrees;
+		Nodes.AddDefaulted();
+		BuildNode(Context, Nodes, 0, 0, NumElements, 0, NumElements >= MinParallelElements ? &Subtrees : nullptr);
+
+		TArray<TArray<FPackedBox>> SubtreeNodes;
+		SubtreeNodes.SetNum(Subtrees.Num());
+		ParallelFor(Subtrees.Num(), [this, &Context, &Subtrees, &SubtreeNodes](int32 SubtreeIndex)
+		{
+			const FSubtree& Subtree = Subtrees[SubtreeIndex];
+			SubtreeNodes[SubtreeIndex].AddDefaulted();
+			BuildNode(Context, SubtreeNodes[SubtreeIndex], 0, Subtree.Begin, Subtree.End, 0, nullptr);
+		});
+
+		// The root of a subtree replaces the node it was built for, the rest is appended with the child indices offset
+		for (int32 SubtreeIndex = 0; SubtreeIndex < Subtrees.Num(); ++SubtreeIndex)
+		{
+			const TArray<FPackedBox>& LocalNodes = SubtreeNodes[SubtreeIndex];
+			const int32 Offset = Nodes.Num() - 1;
+			for (int32 LocalIndex = 0; LocalIndex < LocalNodes.Num(); ++LocalIndex)
+			{
+				FPackedBox Node = LocalNodes[LocalIndex];
+				if (Node.NumElements == 0)
+				{
+					Node.FirstIndex += Offset;
+				}
+
+				if (LocalIndex == 0)
+				{
+					Nodes[Subtrees[SubtreeIndex].NodeIndex] = Node;
+				}
+				else
+				{
+					Nodes.Add(Node);
+				}
+			}
+		}
+
+		Elements.Reserve(NumElements);
+		ElementBounds.SetNumUninitialized(NumElements);
+		BuildIndexToPosition.SetNumUninitialized(NumElements);
+		for (int32 Position = 0; Position < NumElements; ++Position)
+		{
+			const int32 BuildIndex = Context.Indices[Position];
+			Elements.Add(InElements[BuildIndex]);
+			ElementBounds[Position] = Context.Bounds[BuildIndex];
+			BuildIndexToPosition[BuildIndex] = Position;
+		}
+	}
+
+	/** Recomputes the bounds of the elements and the nodes after elements moved, keeping the structure of the tree. */
+	void Refit()
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		ParallelFor(Elements.Num(), [this](int32 Position)
+		{
+			ElementBounds[Position] = FPackedBox(Semantics::GetBoundingBox(Elements[Position]));
+		}, Elements.Num() < MinParallelElements ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		// Children are always after their parent
+		for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+		{
+			FPackedBox& Node = Nodes[NodeIndex];
+			const FPackedBox* Children = Node.NumElements ? &ElementBounds[Node.FirstIndex] : &Nodes[Node.FirstIndex];
+			const int32 NumChildren = Node.NumElements ? Node.NumElements : 2;
+
+			VectorRegister Min = Children[0].LoadMin();
+			VectorRegister Max = Children[0].LoadMax();
+			for (int32 ChildIndex = 1; ChildIndex < NumChildren; ++ChildIndex)
+			{
+				Min = VectorMin(Min, Children[ChildIndex].LoadMin());
+				Max = VectorMax(Max, Children[ChildIndex].LoadMax());
+			}
+			Node.StoreBounds(Min, Max);
+		}
+	}
+
+	/** Accesses an element by its index in the array given to Build, e.g. to move it before Refit. */
+	ElementType& GetElement(int32 BuildIndex)
+	{
+		return Elements[BuildIndexToPosition[BuildIndex]];
+	}
+
+	const ElementType& GetElement(int32 BuildIndex) const
+	{
+		return Elements[BuildIndexToPosition[BuildIndex]];
+	}
+
+	int32 Num() const
+	{
+		return Elements.Num();
+	}
+
+	/** @return The bounds of all the elements, as of the last Build or Refit. */
+	FBox GetBounds() const
+	{
+		return Nodes.Num() ? FBox(Nodes[0].Min, Nodes[0].Max) : FBox(ForceInit);
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Nodes.GetAllocatedSize() + Elements.GetAllocatedSize() + ElementBounds.GetAllocatedSize() + BuildIndexToPosition.GetAllocatedSize();
+	}
+
+	template<typename ElementFunc>
+	void FindElementsInBox(const FBox& Box, const ElementFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		const VectorRegister QueryMin = VectorLoadFloat3_W0(&Box.Min);
+		const VectorRegister QueryMax = VectorLoadFloat3_W0(&Box.Max);
+		Traverse(
+			[&QueryMin, &QueryMax](const FPackedBox& Bounds) { return BoxesIntersect(Bounds.LoadMin(), Bounds.LoadMax(), QueryMin, QueryMax); },
+			Func);
+	}
+
+	template<typename ElementFunc>
+	void FindElementsInSphere(const FSphere& Sphere, const ElementFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		const VectorRegister Center = VectorLoadFloat3_W0(&Sphere.Center);
+		const float RadiusSquared = FMath::Square(Sphere.W);
+		Traverse(
+			[&Center, RadiusSquared](const FPackedBox& Bounds) { return SphereIntersectsBox(Center, RadiusSquared, Bounds.LoadMin(), Bounds.LoadMax()); },
+			Func);
+	}
+
+	template<typename RayFunc>
+	void FindElementsAlongRay(const FRay& Ray, float MaxDistance, const RayFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		if (Nodes.Num() == 0)
+		{
+			return;
+		}
+
+		const FRayBoxTest RayTest(Ray);
+		float EntryDistance;
+		TArray<TPair<int32, float>, TInlineAllocator<64>> Stack;
+		if (RayTest.Intersect(Nodes[0].LoadMin(), Nodes[0].LoadMax(), MaxDistance, EntryDistance))
+		{
+			Stack.Emplace(0, EntryDistance);
+		}
+
+		while (Stack.Num())
+		{
+			const TPair<int32, float> Entry = Stack.Pop(false);
+			if (Entry.Value > MaxDistance)
+			{
+				continue;
+			}
+
+			const FPackedBox& Node = Nodes[Entry.Key];
+			if (Node.NumElements)
+			{
+				for (int32 Position = Node.FirstIndex; Position < Node.FirstIndex + Node.NumElements; ++Position)
+				{
+					if (RayTest.Intersect(ElementBounds[Position].LoadMin(), ElementBounds[Position].LoadMax(), MaxDistance, EntryDistance))
+					{
+						MaxDistance = FMath::Min(MaxDistance, (float)Func(Elements[Position], EntryDistance));
+					}
+				}
+				continue;
+			}
+
+			// The nearer child goes on top of the stack, so closest hit queries shorten the ray early
+			float EntryDistance0, EntryDistance1;
+			const bool bHit0 = RayTest.Intersect(Nodes[Node.FirstIndex].LoadMin(), Nodes[Node.FirstIndex].LoadMax(), MaxDistance, EntryDistance0);
+			const bool bHit1 = RayTest.Intersect(Nodes[Node.FirstIndex + 1].LoadMin(), Nodes[Node.FirstIndex + 1].LoadMax(), MaxDistance, EntryDistance1);
+			if (bHit0 && bHit1)
+			{
+				const bool bFirstIsNearer = EntryDistance0 <= EntryDistance1;
+				Stack.Emplace(bFirstIsNearer ? Node.FirstIndex + 1 : Node.FirstIndex, bFirstIsNearer ? EntryDistance1 : EntryDistance0);
+				Stack.Emplace(bFirstIsNearer ? Node.FirstIndex : Node.FirstIndex + 1, bFirstIsNearer ? EntryDistance0 : EntryDistance1);
+			}
+			else if (bHit0 || bHit1)
+			{
+				Stack.Emplace(bHit0 ? Node.FirstIndex : Node.FirstIndex + 1, bHit0 ? EntryDistance0 : EntryDistance1);
+			}
+		}
+	}
+
+private:
+
+	typedef UE4SpatialAcceleration_Private::FPackedBox FPackedBox;
+
+	enum { NumBins = 16 };
+
+	/** The node is split if each of its children will be built as a task, in the levels above this */
+	enum { ParallelBuildDepth = 4 };
+
+	struct FBuildContext
+	{
+		TArray<FPackedBox> Bounds;
+		TArray<FVector> Centroids;
+		/** The element indices, partitioned in place as the nodes are split */
+		TArray<int32> Indices;
+	};
+
+	struct FSubtree
+	{
+		int32 NodeIndex;
+		int32 Begin;
+		int32 End;
+	};
+
+	/** Interior nodes have no elements and their two children at FirstIndex, leaves have their elements at FirstIndex. */
+	TArray<FPackedBox> Nodes;
+	TArray<ElementType> Elements;
+	TArray<FPackedBox> ElementBounds;
+	TArray<int32> BuildIndexToPosition;
+	int32 MaxElementsPerLeaf;
+
+	static float HalfSurfaceArea(const VectorRegister& Min, const VectorRegister& Max)
+	{
+		FVector Size;
+		VectorStoreFloat3(VectorSubtract(Max, Min), &Size);
+		return Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X;
+	}
+
+	/** Builds the node for Indices[Begin, End), or records it as a subtree to build later once Depth is deep enough. */
+	void BuildNode(FBuildContext& Context, TArray<FPackedBox>& OutNodes, int32 NodeIndex, int32 Begin, int32 End, int32 Depth, TArray<FSubtree>* OutSubtrees) const
+	{
+		const int32 Count = End - Begin;
+		if (OutSubtrees && Depth >= ParallelBuildDepth)
+		{
+			OutSubtrees->Add({ NodeIndex, Begin, End });
+			return;
+		}
+
+		VectorRegister Min = Context.Bounds[Context.Indices[Begin]].LoadMin();
+		VectorRegister Max = Context.Bounds[Context.Indices[Begin]].LoadMax();
+		VectorRegister CentroidMin = VectorLoadFloat3_W0(&Context.Centroids[Context.Indices[Begin]]);
+		VectorRegister CentroidMax = CentroidMin;
+		for (int32 Position = Begin + 1; Position < End; ++Position)
+		{
+			const int32 Index = Context.Indices[Position];
+			Min = VectorMin(Min, Context.Bounds[Index].LoadMin());
+			Max = VectorMax(Max, Context.Bounds[Index].LoadMax());
+			const VectorRegister Centroid = VectorLoadFloat3_W0(&Context.Centroids[Index]);
+			CentroidMin = VectorMin(CentroidMin, Centroid);
+			CentroidMax = VectorMax(CentroidMax, Centroid);
+		}
+		OutNodes[NodeIndex].StoreBounds(Min, Max);
+
+		if (Count <= MaxElementsPerLeaf)
+		{
+			OutNodes[NodeIndex].FirstIndex = Begin;
+			OutNodes[NodeIndex].NumElements = Count;
+			return;
+		}
+
+		// Split on the axis the centroids are spread the most over
+		FVector CentroidLow, CentroidSize;
+		VectorStoreFloat3(CentroidMin, &CentroidLow);
+		VectorStoreFloat3(VectorSubtract(CentroidMax, CentroidMin), &CentroidSize);
+		const int32 Axis = CentroidSize.X >= CentroidSize.Y && CentroidSize.X >= CentroidSize.Z ? 0 : (CentroidSize.Y >= CentroidSize.Z ? 1 : 2);
+
+		int32 Mid = Begin + Count / 2;
+		if (CentroidSize[Axis] > 0.0f)
+		{
+			// Bin the centroids, then pick the bin boundary with the lowest cost, count times area on each side
+			const float BinScale = NumBins / CentroidSize[Axis];
+			auto GetBin = [&Context, Axis, BinScale, &CentroidLow](int32 Index)
+			{
+				return FMath::Min((int32)((Context.Centroids[Index][Axis] - CentroidLow[Axis]) * BinScale), (int32)NumBins - 1);
+			};
+
+			int32 BinCounts[NumBins] = {};
+			VectorRegister BinMin[NumBins];
+			VectorRegister BinMax[NumBins];
+			for (int32 Bin = 0; Bin < NumBins; ++Bin)
+			{
+				BinMin[Bin] = VectorSetFloat1(BIG_NUMBER);
+				BinMax[Bin] = VectorSetFloat1(-BIG_NUMBER);
+			}
+			for (int32 Position = Begin; Position < End; ++Position)
+			{
+				const int32 Index = Context.Indices[Position];
+				const int32 Bin = GetBin(Index);
+				BinCounts[Bin]++;
+				BinMin[Bin] = VectorMin(BinMin[Bin], Context.Bounds[Index].LoadMin());
+				BinMax[Bin] = VectorMax(BinMax[Bin], Context.Bounds[Index].LoadMax());
+			}
+
+			float RightCosts[NumBins];
+			{
+				VectorRegister RightMin = BinMin[NumBins - 1];
+				VectorRegister RightMax = BinMax[NumBins - 1];
+				int32 RightCount = BinCounts[NumBins - 1];
+				for (int32 Bin = NumBins - 1; Bin > 0; --Bin)
+				{
+					RightCosts[Bin] = RightCount ? RightCount * HalfSurfaceArea(RightMin, RightMax) : 0.0f;
+					RightMin = VectorMin(RightMin, BinMin[Bin - 1]);
+					RightMax = VectorMax(RightMax, BinMax[Bin - 1]);
+					RightCount += BinCounts[Bin - 1];
+				}
+			}
+
+			VectorRegister LeftMin = BinMin[0];
+			VectorRegister LeftMax = BinMax[0];
+			int32 LeftCount = BinCounts[0];
+			float BestCost = MAX_flt;
+			int32 BestSplit = 1;
+			for (int32 Split = 1; Split < NumBins; ++Split)
+			{
+				const float Cost = (LeftCount ? LeftCount * HalfSurfaceArea(LeftMin, LeftMax) : 0.0f) + RightCosts[Split];
+				if (Cost < BestCost && LeftCount > 0 && LeftCount < Count)
+				{
+					BestCost = Cost;
+					BestSplit = Split;
+				}
+				LeftMin = VectorMin(LeftMin, BinMin[Split]);
+				LeftMax = VectorMax(LeftMax, BinMax[Split]);
+				LeftCount += BinCounts[Split];
+			}
+
+			// Partition the indices on the split
+			int32* First = Context.Indices.GetData() + Begin;
+			int32* Last = Context.Indices.GetData() + End;
+			while (First < Last)
+			{
+				if (GetBin(*First) < BestSplit)
+				{
+					++First;
+				}
+				else
+				{
+					Swap(*First, *--Last);
+				}
+			}
+			const int32 Partition = (int32)(First - Context.Indices.GetData());
+			if (Partition > Begin && Partition < End)
+			{
+				Mid = Partition;
+			}
+		}
+
+		const int32 FirstChild = OutNodes.AddDefaulted(2);
+		OutNodes[NodeIndex].FirstIndex = FirstChild;
+		OutNodes[NodeIndex].NumElements = 0;
+		BuildNode(Context, OutNodes, FirstChild, Begin, Mid, Depth + 1, OutSubtrees);
+		BuildNode(Context, OutNodes, FirstChild + 1, Mid, End, Depth + 1, OutSubtrees);
+	}
+
+	/** Calls Func on the elements of every leaf reached through the nodes for which Test passes, and that pass it themselves. */
+	template<typename TestFunc, typename ElementFunc>
+	void Traverse(const TestFunc& Test, const ElementFunc& Func) const
+	{
+		if (Nodes.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(0);
+		while (Stack.Num())
+		{
+			const FPackedBox& Node = Nodes[Stack.Pop(false)];
+			if (!Test(Node))
+			{
+				continue;
+			}
+
+			if (Node.NumElements)
+			{
+				for (int32 Position = Node.FirstIndex; Position < Node.FirstIndex + Node.NumElements; ++Position)
+				{
+					if (Test(ElementBounds[Position]))
+					{
+						Func(Elements[Position]);
+					}
+				}
+			}
+			else
+			{
+				Stack.Add(Node.FirstIndex + 1);
+				Stack.Add(Node.FirstIndex);
+			}
+		}
+	}
+};
+
+/**
+ * A uniform grid of cubic cells over unbounded space, see SpatialAcceleration.h. Only the cells that have elements are stored,
+ * in a hash map, and each element is listed in all the cells its bounds overlap. Elements that overlap more than
+ * MaxCellsPerElement cells are kept in a separate list that every query tests instead, so a few large elements don't fill the
+ * map. The ray query walks the cells along the ray, its cost grows with the length of the ray in cells.
+ */
+template<typename ElementType, typename Semantics>
+class TSpatialHashGrid
+{
+public:
+
+	enum { MaxCellsPerElement = 64 };
+
+	/** @param InCellSize - The size of the cells, about the size of the typical element or query. */
+	explicit TSpatialHashGrid(float InCellSize)
+	:	CellSize(InCellSize)
+	,	InvCellSize(1.0f / InCellSize)
+	,	OccupiedMinCell(MAX_int32)
+	,	OccupiedMaxCell(MIN_int32)
+	{
+		check(InCellSize > 0.0f);
+	}
+
+	/**
+	 * Adds an element to the grid.
+	 * @return The id of the element, it doesn't change until the element is removed.
+	 */
+	int32 AddElement(typename TTypeTraits<ElementType>::ConstInitType Element)
+	{
+		const FBox Box = Semantics::GetBoundingBox(Element);
+		const int32 ElementId = Entries.Add(FEntry(Element, Box, GetCell(Box.Min), GetCell(Box.Max)));
+		LinkElement(ElementId);
+		return ElementId;
+	}
+
+	/** Adds elements to the grid, their bounds are computed in parallel. */
+	void AddElements(TArrayView<const ElementType> Elements, TArray<int32>* OutElementIds = nullptr)
+	{
+		TArray<FBox> Boxes;
+		Boxes.SetNumUninitialized(Elements.Num());
+		ParallelFor(Elements.Num(), [&Boxes, &Elements](int32 Index)
+		{
+			Boxes[Index] = Semantics::GetBoundingBox(Elements[Index]);
+		}, Elements.Num() < UE4SpatialAcceleration_Private::MinParallelElements ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		Entries.Reserve(Entries.Num() + Elements.Num());
+		if (OutElementIds)
+		{
+			OutElementIds->Reset(Elements.Num());
+		}
+		for (int32 Index = 0; Index < Elements.Num(); ++Index)
+		{
+			const int32 ElementId = Entries.Add(FEntry(Elements[Index], Boxes[Index], GetCell(Boxes[Index].Min), GetCell(Boxes[Index].Max)));
+			LinkElement(ElementId);
+			if (OutElementIds)
+			{
+				OutElementIds->Add(ElementId);
+			}
+		}
+	}
+
+	void RemoveElement(int32 ElementId)
+	{
+		check(IsValidElementId(ElementId));
+		UnlinkElement(ElementId);
+		Entries.RemoveAt(ElementId);
+	}
+
+	/** Replaces an element with a new version of it, e.g. after it moved. The cells are only updated if that changed them. */
+	void UpdateElement(int32 ElementId, typename TTypeTraits<ElementType>::ConstInitType NewElement)
+	{
+		check(IsValidElementId(ElementId));
+
+		const FBox Box = Semantics::GetBoundingBox(NewElement);
+		const FIntVector MinCell = GetCell(Box.Min);
+		const FIntVector MaxCell = GetCell(Box.Max);
+		FEntry& Entry = Entries[ElementId];
+		const bool bCellsChanged = MinCell != Entry.MinCell || MaxCell != Entry.MaxCell;
+		if (bCellsChanged)
+		{
+			UnlinkElement(ElementId);
+		}
+
+		Entry.Element = NewElement;
+		Entry.Bounds = UE4SpatialAcceleration_Private::FPackedBox(Box);
+		Entry.MinCell = MinCell;
+		Entry.MaxCell = MaxCell;
+
+		if (bCellsChanged)
+		{
+			LinkElement(ElementId);
+		}
+	}
+
+	void Reset()
+	{
+		Entries.Empty();
+		Cells.Empty();
+		LargeElements.Empty();
+		OccupiedMinCell = FIntVector(MAX_int32);
+		OccupiedMaxCell = FIntVector(MIN_int32);
+	}
+
+	bool IsValidElementId(int32 ElementId) const
+	{
+		return Entries.IsValidIndex(ElementId);
+	}
+
+	const ElementType& GetElement(int32 ElementId) const
+	{
+		return Entries[ElementId].Element;
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	int32 GetNumCells() const
+	{
+		return Cells.Num();
+	}
+
+	template<typename ElementFunc>
+	void FindElementsInBox(const FBox& Box, const ElementFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		const VectorRegister QueryMin = VectorLoadFloat3_W0(&Box.Min);
+		const VectorRegister QueryMax = VectorLoadFloat3_W0(&Box.Max);
+		ForEachCandidate(GetCell(Box.Min), GetCell(Box.Max), [&QueryMin, &QueryMax, &Func](const FEntry& Entry)
+		{
+			if (BoxesIntersect(Entry.Bounds.LoadMin(), Entry.Bounds.LoadMax(), QueryMin, QueryMax))
+			{
+				Func(Entry.Element);
+			}
+		});
+	}
+
+	template<typename ElementFunc>
+	void FindElementsInSphere(const FSphere& Sphere, const ElementFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		const VectorRegister Center = VectorLoadFloat3_W0(&Sphere.Center);
+		const float RadiusSquared = FMath::Square(Sphere.W);
+		ForEachCandidate(GetCell(Sphere.Center - FVector(Sphere.W)), GetCell(Sphere.Center + FVector(Sphere.W)), [&Center, RadiusSquared, &Func](const FEntry& Entry)
+		{
+			if (SphereIntersectsBox(Center, RadiusSquared, Entry.Bounds.LoadMin(), Entry.Bounds.LoadMax()))
+			{
+				Func(Entry.Element);
+			}
+		});
+	}
+
+	template<typename RayFunc>
+	void FindElementsAlongRay(const FRay& Ray, float MaxDistance, const RayFunc& Func) const
+	{
+		using namespace UE4SpatialAcceleration_Private;
+
+		const FRayBoxTest RayTest(Ray);
+		float EntryDistance;
+		for (int32 ElementId : LargeElements)
+		{
+			const FEntry& Entry = Entries[ElementId];
+			if (RayTest.Intersect(Entry.Bounds.LoadMin(), Entry.Bounds.LoadMax(), MaxDistance, EntryDistance))
+			{
+				MaxDistance = FMath::Min(MaxDistance, (float)Func(Entry.Element, EntryDistance));
+			}
+		}
+
+		// Only walk the part of the ray inside the cells that have ever been occupied
+		if (OccupiedMinCell.X > OccupiedMaxCell.X)
+		{
+			return;
+		}
+		const FVector OccupiedMin = FVector(OccupiedMinCell) * CellSize;
+		const FVector OccupiedMax = FVector(OccupiedMaxCell + FIntVector(1)) * CellSize;
+		float Distance;
+		if (!RayTest.Intersect(VectorLoadFloat3_W0(&OccupiedMin), VectorLoadFloat3_W0(&OccupiedMax), MaxDistance, Distance))
+		{
+			return;
+		}
+
+		// Amanatides and Woo, step to whichever cell boundary along the ray is crossed first
+		FIntVector Cell = GetCell(Ray.PointAt(Distance));
+		FIntVector Step;
+		FVector NextCrossing;
+		FVector CrossingDelta;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Direction = Ray.Direction[Axis];
+			if (Direction == 0.0f)
+			{
+				Step[Axis] = 0;
+				NextCrossing[Axis] = MAX_flt;
+				CrossingDelta[Axis] = MAX_flt;
+				continue;
+			}
+
+			Step[Axis] = Direction > 0.0f ? 1 : -1;
+			const float Boundary = (Cell[Axis] + (Direction > 0.0f ? 1 : 0)) * CellSize;
+			NextCrossing[Axis] = FMath::Max((Boundary - Ray.Origin[Axis]) / Direction, Distance);
+			CrossingDelta[Axis] = CellSize / FMath::Abs(Direction);
+		}
+
+		// Elements in several cells are tested once
+		TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<64>> TestedElements;
+		while (Distance <= MaxDistance)
+		{
+			if (const TArray<int32>* CellElements = Cells.Find(Cell))
+			{
+				for (int32 ElementId : *CellElements)
+				{
+					bool bAlreadyTested = false;
+					TestedElements.Add(ElementId, &bAlreadyTested);
+					const FEntry& Entry = Entries[ElementId];
+					if (!bAlreadyTested && RayTest.Intersect(Entry.Bounds.LoadMin(), Entry.Bounds.LoadMax(), MaxDistance, EntryDistance))
+					{
+						MaxDistance = FMath::Min(MaxDistance, (float)Func(Entry.Element, EntryDistance));
+					}
+				}
+			}
+
+			const int32 Axis = NextCrossing.X <= NextCrossing.Y && NextCrossing.X <= NextCrossing.Z ? 0 : (NextCrossing.Y <= NextCrossing.Z ? 1 : 2);
+			Distance = NextCrossing[Axis];
+			Cell[Axis] += Step[Axis];
+			NextCrossing[Axis] += CrossingDelta[Axis];
+			if (Cell[Axis] < OccupiedMinCell[Axis] || Cell[Axis] > OccupiedMaxCell[Axis])
+			{
+				break;
+			}
+		}
+	}
+
+private:
+
+	struct FEntry
+	{
+		ElementType Element;
+		UE4SpatialAcceleration_Private::FPackedBox Bounds;
+		FIntVector MinCell;
+		FIntVector MaxCell;
+
+		FEntry(typename TTypeTraits<ElementType>::ConstInitType InElement, const FBox& Box, const FIntVector& InMinCell, const FIntVector& InMaxCell)
+		:	Element(InElement)
+		,	Bounds(Box)
+		,	MinCell(InMinCell)
+		,	MaxCell(InMaxCell)
+		{}
+
+		int64 GetNumCells() const
+		{
+			return (int64)(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+		}
+	};
+
+	TSparseArray<FEntry> Entries;
+	TMap<FIntVector, TArray<int32>> Cells;
+	TArray<int32> LargeElements;
+	float CellSize;
+	float InvCellSize;
+
+	/** The range of cells that have had elements, it only grows until Reset */
+	FIntVector OccupiedMinCell;
+	FIntVector OccupiedMaxCell;
+
+	FIntVector GetCell(const FVector& Position) const
+	{
+		return FIntVector(FMath::FloorToInt(Position.X * InvCellSize), FMath::FloorToInt(Position.Y * InvCellSize), FMath::FloorToInt(Position.Z * InvCellSize));
+	}
+
+	void LinkElement(int32 ElementId)
+	{
+		const FEntry& Entry = Entries[ElementId];
+		if (Entry.GetNumCells() > MaxCellsPerElement)
+		{
+			LargeElements.Add(ElementId);
+			return;
+		}
+
+		for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+		{
+			for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+			{
+				for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+				{
+					Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(ElementId);
+				}
+			}
+		}
+
+		OccupiedMinCell = FIntVector(FMath::Min(OccupiedMinCell.X, Entry.MinCell.X), FMath::Min(OccupiedMinCell.Y, Entry.MinCell.Y), FMath::Min(OccupiedMinCell.Z, Entry.MinCell.Z));
+		OccupiedMaxCell = FIntVector(FMath::Max(OccupiedMaxCell.X, Entry.MaxCell.X), FMath::Max(OccupiedMaxCell.Y, Entry.MaxCell.Y), FMath::Max(OccupiedMaxCell.Z, Entry.MaxCell.Z));
+	}
+
+	void UnlinkElement(int32 ElementId)
+	{
+		const FEntry& Entry = Entries[ElementId];
+		if (Entry.GetNumCells() > MaxCellsPerElement)
+		{
+			LargeElements.RemoveSingleSwap(ElementId);
+			return;
+		}
+
+		for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+		{
+			for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+			{
+				for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+				{
+					const FIntVector Cell(X, Y, Z);
+					TArray<int32>& CellElements = Cells.FindChecked(Cell);
+					CellElements.RemoveSingleSwap(ElementId);
+					if (CellElements.Num() == 0)
+					{
+						Cells.Remove(Cell);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Calls Func once for each element that may overlap the cells [QueryMinCell, QueryMaxCell]. An element in several of the
+	 * cells is only reported from the first of them, the cell at the larger of its and the query's min corners.
+	 */
+	template<typename EntryFunc>
+	void ForEachCandidate(const FIntVector& QueryMinCell, const FIntVector& QueryMaxCell, const EntryFunc& Func) const
+	{
+		for (int32 ElementId : LargeElements)
+		{
+			Func(Entries[ElementId]);
+		}
+
+		auto VisitCell = [this, &QueryMinCell, &Func](const FIntVector& Cell, const TArray<int32>& CellElements)
+		{
+			for (int32 ElementId : CellElements)
+			{
+				const FEntry& Entry = Entries[ElementId];
+				const FIntVector FirstCell(FMath::Max(Entry.MinCell.X, QueryMinCell.X), FMath::Max(Entry.MinCell.Y, QueryMinCell.Y), FMath::Max(Entry.MinCell.Z, QueryMinCell.Z));
+				if (FirstCell == Cell)
+				{
+					Func(Entry);
+				}
+			}
+		};
+
+		const int64 NumQueryCells = (int64)(QueryMaxCell.X - QueryMinCell.X + 1) * (QueryMaxCell.Y - QueryMinCell.Y + 1) * (QueryMaxCell.Z - QueryMinCell.Z + 1);
+		if (NumQueryCells > Cells.Num())
+		{
+			// The query covers more cells than are occupied, go through the occupied ones instead
+			for (const TPair<FIntVector, TArray<int32>>& Pair : Cells)
+			{
+				const FIntVector& Cell = Pair.Key;
+				if (Cell.X >= QueryMinCell.X && Cell.Y >= QueryMinCell.Y && Cell.Z >= QueryMinCell.Z && Cell.X <= QueryMaxCell.X && Cell.Y <= QueryMaxCell.Y && Cell.Z <= QueryMaxCell.Z)
+				{
+					VisitCell(Cell, Pair.Value);
+				}
+			}
+			return;
+		}
+
+		for (int32 Z = QueryMinCell.Z; Z <= QueryMaxCell.Z; ++Z)
+		{
+			for (int32 Y = QueryMinCell.Y; Y <= QueryMaxCell.Y; ++Y)
+			{
+				for (int32 X = QueryMinCell.X; X <= QueryMaxCell.X; ++X)
+				{
+					const FIntVector Cell(X, Y, Z);
+					if (const TArray<int32>* CellElements = Cells.Find(Cell))
+					{
+						VisitCell(Cell, *CellElements);
+					}
+				}
+			}
+		}
+	}
+};
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Math/Vector.h"
+#include "Math/Quat.h"
+#include "Math/Matrix.h"
+#include "Math/Transform.h"
+
+/**
+ * Batch versions of the FTransform, FMatrix and FQuat operations, for code that processes many of them at a time such as
+ * animation and physics. The per call setup, like building the matrix of a transform, is done once for the whole batch, and
+ * the loops run on the vector registers; the SoA versions 8 elements at a time with VectorRegister8.
+ *
+ * Input and output views must have the same number of elements. An output may be the same array as an input of the same type.
+ * Results match the single element functions to float precision, not bit for bit.
+ */
+struct CORE_API FTransformBatch
+{
+	/** OutPositions[i] = Transform.TransformPosition(Positions[i]) */
+	static void TransformPositions(const FTransform& Transform, TArrayView<const FVector> Positions, TArrayView<FVector> OutPositions);
+
+	/** OutVectors[i] = Transform.TransformVector(Vectors[i]), scale included */
+	static void TransformVectors(const FTransform& Transform, TArrayView<const FVector> Vectors, TArrayView<FVector> OutVectors);
+
+	/** OutPositions[i] = Matrix.TransformPosition(Positions[i]) */
+	static void TransformPositions(const FMatrix& Matrix, TArrayView<const FVector> Positions, TArrayView<FVector> OutPositions);
+
+	/** OutVectors[i] = Matrix.TransformVector(Vectors[i]) */
+	static void TransformVectors(const FMatrix& Matrix, TArrayView<const FVector> Vectors, TArrayView<FVector> OutVectors);
+
+	/** TransformPositions on Num positions stored as separate X, Y and Z arrays */
+	static void TransformPositionsSoA(const FTransform& Transform, int32 Num, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ);
+
+	/** TransformVectors on Num vectors stored as separate X, Y and Z arrays */
+	static void TransformVectorsSoA(const FTransform& Transform, int32 Num, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ);
+
+	/** OutTransforms[i] = A[i] * B[i], see FTransform::Multiply */
+	static void MultiplyTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, TArrayView<FTransform> OutTransforms);
+
+	/** OutTransforms[i] = A[i] * B, e.g. local transforms to the space of a shared parent */
+	static void MultiplyTransforms(TArrayView<const FTransform> A, const FTransform& B, TArrayView<FTransform> OutTransforms);
+
+	/** OutMatrices[i] = A[i] * B[i] */
+	static void MultiplyMatrices(TArrayView<const FMatrix> A, TArrayView<const FMatrix> B, TArrayView<FMatrix> OutMatrices);
+
+	/** OutTransforms[i].Blend(A[i], B[i], Alpha) */
+	static void BlendTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, float Alpha, TArrayView<FTransform> OutTransforms);
+
+	/** OutTransforms[i].Blend(A[i], B[i], Alphas[i]) */
+	static void BlendTransforms(TArrayView<const FTransform> A, TArrayView<const FTransform> B, TArrayView<const float> Alphas, TArrayView<FTransform> OutTransforms);
+
+	/** OutMatrices[i] = FQuatRotationMatrix(Quats[i]), the quaternions must be normalized */
+	static void QuatsToMatrices(TArrayView<const FQuat> Quats, TArrayView<FMatrix> OutMatrices);
+};
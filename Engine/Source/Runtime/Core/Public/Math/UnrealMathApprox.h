@@ -0,0 +1,281 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Approximate transcendental functions on VectorRegisters, built on the platform vector ops so they are the same on every
+ * backend. Each comes in two precision tiers. The error bounds below were measured against double precision over the
+ * documented input ranges on SSE, with and without FMA3. Errors are absolute where the result has zeros inside the range, and
+ * in ULPs of the float result elsewhere; the Log error is absolute for results within [-1, 1] and relative beyond.
+ *
+ *                          Fast                          Accurate
+ *   Sin, Cos, SinCos       1.3e-5 absolute               1e-7 absolute           |X| <= 8192
+ *   Atan2                  1.2e-5 absolute               3e-7 absolute, 4 ULP    any X and Y
+ *   Exp                    70 ULP                        1 ULP                   X in [-87.3, 88]
+ *   Log                    2.1e-5                        1e-7                    positive normal X
+ *   Pow                    from Exp(Y * Log(X)), the Log error is scaled by |Y * Log(X)|, 13 ULP for Accurate X^2.2
+ *   Sqrt, ReciprocalSqrt   3 ULP (SSE) / 2^-16 (NEON)    3 ULP
+ *
+ * Beyond |X| = 8192 the sin and cos range reduction starts losing bits, at 1e5 the error is 1e-6. Outside of the other ranges
+ * the results are not specified, except Exp which clamps X to its range. NaNs and infinities aren't handled. FApproxMath has
+ * batch versions over float arrays.
+ */
+enum class EApproxMathPrecision : uint8
+{
+	/** Fewest operations, about 16 correct bits */
+	Fast,
+	/** A few ULP from the correctly rounded result, close to the C library float functions */
+	Accurate,
+};
+
+namespace UE4MathApprox_Private
+{
+	/** Rounds to the nearest integer, halfway cases away from zero */
+	FORCEINLINE VectorRegister VectorRoundNearest(const VectorRegister& X)
+	{
+		const VectorRegister HalfWithSign = VectorBitwiseOr(VectorBitwiseAnd(X, GlobalVectorConstants::SignBit), GlobalVectorConstants::FloatOneHalf);
+		return VectorTruncate(VectorAdd(X, HalfWithSign));
+	}
+
+	FORCEINLINE VectorRegister VectorIntMaskToFloat(const VectorRegisterInt& Value, const VectorRegisterInt& Bits)
+	{
+		return VectorCastIntToFloat(VectorIntCompareEQ(VectorIntAnd(Value, Bits), Bits));
+	}
+}
+
+/**
+ * Sine and cosine of X in radians, with a single range reduction for both.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE void VectorApproxSinCos(const VectorRegister& X, VectorRegister& OutSin, VectorRegister& OutCos)
+{
+	using namespace UE4MathApprox_Private;
+
+	// X = Quadrant * Pi/2 + R with R in [-Pi/4, Pi/4]. Pi/2 is split in three so the products are exact for large quadrants
+	const VectorRegister Quadrant = VectorRoundNearest(VectorMultiply(X, VectorSetFloat1(0.636619772367581343f)));
+	VectorRegister R = VectorMultiplyAdd(Quadrant, VectorSetFloat1(-1.5703125f), X);
+	R = VectorMultiplyAdd(Quadrant, VectorSetFloat1(-4.837512969970703125e-4f), R);
+	R = VectorMultiplyAdd(Quadrant, VectorSetFloat1(-7.54978995489188216e-8f), R);
+	const VectorRegister R2 = VectorMultiply(R, R);
+
+	VectorRegister SinR;
+	VectorRegister CosR;
+	if (Precision == EApproxMathPrecision::Fast)
+	{
+		SinR = VectorMultiplyAdd(VectorMultiply(R, R2), VectorMultiplyAdd(R2, VectorSetFloat1(8.16328115e-3f), VectorSetFloat1(-1.66633903e-1f)), R);
+		CosR = VectorMultiplyAdd(R2, VectorMultiplyAdd(R2, VectorSetFloat1(4.04889304e-2f), VectorSetFloat1(-4.99776304e-1f)), GlobalVectorConstants::FloatOne);
+	}
+	else
+	{
+		VectorRegister SinPoly = VectorMultiplyAdd(R2, VectorSetFloat1(-1.9515295891e-4f), VectorSetFloat1(8.3321608736e-3f));
+		SinPoly = VectorMultiplyAdd(R2, SinPoly, VectorSetFloat1(-1.6666654611e-1f));
+		SinR = VectorMultiplyAdd(VectorMultiply(R, R2), SinPoly, R);
+
+		VectorRegister CosPoly = VectorMultiplyAdd(R2, VectorSetFloat1(2.443315711809948e-5f), VectorSetFloat1(-1.388731625493765e-3f));
+		CosPoly = VectorMultiplyAdd(R2, CosPoly, VectorSetFloat1(4.166664568298827e-2f));
+		CosR = VectorMultiplyAdd(VectorMultiply(R2, R2), CosPoly, VectorMultiplyAdd(R2, GlobalVectorConstants::FloatMinusOneHalf, GlobalVectorConstants::FloatOne));
+	}
+
+	// Odd quadrants swap sin and cos, quadrants 2 and 3 negate sin, 1 and 2 negate cos
+	const VectorRegisterInt IntTwo = MakeVectorRegisterInt(2, 2, 2, 2);
+	const VectorRegisterInt IntQuadrant = VectorFloatToInt(Quadrant);
+	const VectorRegister Swap = VectorIntMaskToFloat(IntQuadrant, GlobalVectorConstants::IntOne);
+	const VectorRegister SinSign = VectorBitwiseAnd(VectorIntMaskToFloat(IntQuadrant, IntTwo), GlobalVectorConstants::SignBit);
+	const VectorRegister CosSign = VectorBitwiseAnd(VectorIntMaskToFloat(VectorIntAdd(IntQuadrant, GlobalVectorConstants::IntOne), IntTwo), GlobalVectorConstants::SignBit);
+	OutSin = VectorBitwiseXor(VectorSelect(Swap, CosR, SinR), SinSign);
+	OutCos = VectorBitwiseXor(VectorSelect(Swap, SinR, CosR), CosSign);
+}
+
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxSin(const VectorRegister& X)
+{
+	VectorRegister Sin, Cos;
+	VectorApproxSinCos<Precision>(X, Sin, Cos);
+	return Sin;
+}
+
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxCos(const VectorRegister& X)
+{
+	VectorRegister Sin, Cos;
+	VectorApproxSinCos<Precision>(X, Sin, Cos);
+	return Cos;
+}
+
+/**
+ * Angle of (X, Y) in radians, in [-Pi, Pi]. Atan2(0, 0) is 0.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxAtan2(const VectorRegister& Y, const VectorRegister& X)
+{
+	const VectorRegister AbsX = VectorAbs(X);
+	const VectorRegister AbsY = VectorAbs(Y);
+	const VectorRegister Max = VectorMax(AbsX, AbsY);
+	const VectorRegister NonZero = VectorCompareGT(Max, GlobalVectorConstants::FloatZero);
+
+	// Atan of T in [0, 1], the rest from the octant
+	VectorRegister T = VectorBitwiseAnd(VectorDivide(VectorMin(AbsX, AbsY), Max), NonZero);
+	VectorRegister Atan;
+	if (Precision == EApproxMathPrecision::Fast)
+	{
+		const VectorRegister T2 = VectorMultiply(T, T);
+		VectorRegister Poly = VectorMultiplyAdd(T2, VectorSetFloat1(0.0208351f), VectorSetFloat1(-0.0851330f));
+		Poly = VectorMultiplyAdd(T2, Poly, VectorSetFloat1(0.1801410f));
+		Poly = VectorMultiplyAdd(T2, Poly, VectorSetFloat1(-0.3302995f));
+		Poly = VectorMultiplyAdd(T2, Poly, VectorSetFloat1(0.9998660f));
+		Atan = VectorMultiply(T, Poly);
+	}
+	else
+	{
+		// Down to [0, tan(Pi/8)] with Atan(T) = Pi/4 + Atan((T - 1) / (T + 1))
+		const VectorRegister Large = VectorCompareGT(T, VectorSetFloat1(0.414213562373095f));
+		const VectorRegister Offset = VectorBitwiseAnd(Large, GlobalVectorConstants::PiByFour);
+		T = VectorSelect(Large, VectorDivide(VectorSubtract(T, GlobalVectorConstants::FloatOne), VectorAdd(T, GlobalVectorConstants::FloatOne)), T);
+
+		const VectorRegister T2 = VectorMultiply(T, T);
+		VectorRegister Poly = VectorMultiplyAdd(T2, VectorSetFloat1(8.05374449538e-2f), VectorSetFloat1(-1.38776856032e-1f));
+		Poly = VectorMultiplyAdd(T2, Poly, VectorSetFloat1(1.99777106478e-1f));
+		Poly = VectorMultiplyAdd(T2, Poly, VectorSetFloat1(-3.33329491539e-1f));
+		Atan = VectorAdd(Offset, VectorMultiplyAdd(VectorMultiply(T2, T), Poly, T));
+	}
+
+	Atan = VectorSelect(VectorCompareGT(AbsY, AbsX), VectorSubtract(GlobalVectorConstants::PiByTwo, Atan), Atan);
+	Atan = VectorSelect(VectorCompareLT(X, GlobalVectorConstants::FloatZero), VectorSubtract(GlobalVectorConstants::Pi, Atan), Atan);
+	// Atan is positive here, it takes the sign of Y
+	return VectorBitwiseOr(Atan, VectorBitwiseAnd(Y, GlobalVectorConstants::SignBit));
+}
+
+/**
+ * e^X, X is clamped to [-87.3, 88] so the result is always a normal float.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxExp(const VectorRegister& X)
+{
+	using namespace UE4MathApprox_Private;
+
+	// X = N * ln(2) + R with R in [-ln(2)/2, ln(2)/2], then e^X = 2^N * e^R
+	const VectorRegister Clamped = VectorMin(VectorMax(X, VectorSetFloat1(-87.3365447f)), VectorSetFloat1(88.0f));
+	const VectorRegister N = VectorRoundNearest(VectorMultiply(Clamped, VectorSetFloat1(1.44269504088896341f)));
+	VectorRegister R = VectorMultiplyAdd(N, VectorSetFloat1(-0.693359375f), Clamped);
+	R = VectorMultiplyAdd(N, VectorSetFloat1(2.12194440e-4f), R);
+	const VectorRegister R2 = VectorMultiply(R, R);
+
+	VectorRegister Poly;
+	if (Precision == EApproxMathPrecision::Fast)
+	{
+		Poly = VectorMultiplyAdd(R, VectorSetFloat1(4.12777353e-2f), VectorSetFloat1(1.67535144e-1f));
+		Poly = VectorMultiplyAdd(R, Poly, VectorSetFloat1(5.00051162e-1f));
+	}
+	else
+	{
+		Poly = VectorMultiplyAdd(R, VectorSetFloat1(1.9875691500e-4f), VectorSetFloat1(1.3981999507e-3f));
+		Poly = VectorMultiplyAdd(R, Poly, VectorSetFloat1(8.3334519073e-3f));
+		Poly = VectorMultiplyAdd(R, Poly, VectorSetFloat1(4.1665795894e-2f));
+		Poly = VectorMultiplyAdd(R, Poly, VectorSetFloat1(1.6666665459e-1f));
+		Poly = VectorMultiplyAdd(R, Poly, VectorSetFloat1(5.0000001201e-1f));
+	}
+	const VectorRegister ExpR = VectorAdd(VectorMultiplyAdd(R2, Poly, R), GlobalVectorConstants::FloatOne);
+
+	// 2^N from its exponent bits, (N + 127) << 23 computed in float where it is exact
+	const VectorRegister Pow2N = VectorCastIntToFloat(VectorFloatToInt(VectorMultiply(VectorAdd(N, GlobalVectorConstants::Float127), VectorSetFloat1(8388608.0f))));
+	return VectorMultiply(ExpR, Pow2N);
+}
+
+/**
+ * Natural logarithm, X must be a positive normal float.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxLog(const VectorRegister& X)
+{
+	// X = M * 2^E with M in [0.5, 1), read from the bits. The exponent bits are converted in place, the int has 8 significant bits
+	const VectorRegisterInt Bits = VectorCastFloatToInt(X);
+	const VectorRegister ExponentBits = VectorIntToFloat(VectorIntAnd(Bits, MakeVectorRegisterInt(0x7F800000, 0x7F800000, 0x7F800000, 0x7F800000)));
+	VectorRegister E = VectorMultiplyAdd(ExponentBits, VectorSetFloat1(1.0f / 8388608.0f), VectorSetFloat1(-126.0f));
+	VectorRegister M = VectorCastIntToFloat(VectorIntOr(VectorIntAnd(Bits, MakeVectorRegisterInt(0x007FFFFF, 0x007FFFFF, 0x007FFFFF, 0x007FFFFF)), MakeVectorRegisterInt(0x3F000000, 0x3F000000, 0x3F000000, 0x3F000000)));
+
+	// Move M to [sqrt(0.5), sqrt(2)) and take 1 off, so the polynomial is of Log(1 + M) around 0
+	const VectorRegister Small = VectorCompareLT(M, VectorSetFloat1(0.707106781186547524f));
+	E = VectorSubtract(E, VectorBitwiseAnd(Small, GlobalVectorConstants::FloatOne));
+	M = VectorSubtract(VectorAdd(M, VectorBitwiseAnd(Small, M)), GlobalVectorConstants::FloatOne);
+	const VectorRegister M2 = VectorMultiply(M, M);
+
+	if (Precision == EApproxMathPrecision::Fast)
+	{
+		VectorRegister Poly = VectorMultiplyAdd(M, VectorSetFloat1(1.78404727e-1f), VectorSetFloat1(-2.69914005e-1f));
+		Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(3.35707327e-1f));
+		Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(-4.99535947e-1f));
+		return VectorMultiplyAdd(E, VectorSetFloat1(0.693147180559945309f), VectorMultiplyAdd(M2, Poly, M));
+	}
+
+	VectorRegister Poly = VectorMultiplyAdd(M, VectorSetFloat1(7.0376836292e-2f), VectorSetFloat1(-1.1514610310e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(1.1676998740e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(-1.2420140846e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(1.4249322787e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(-1.6668057665e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(2.0000714765e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(-2.4999993993e-1f));
+	Poly = VectorMultiplyAdd(M, Poly, VectorSetFloat1(3.3333331174e-1f));
+
+	// ln(2) is split in two so E * ln(2) adds no error of its own
+	VectorRegister Y = VectorMultiply(VectorMultiply(Poly, M), M2);
+	Y = VectorMultiplyAdd(E, VectorSetFloat1(-2.12194440e-4f), Y);
+	Y = VectorMultiplyAdd(M2, GlobalVectorConstants::FloatMinusOneHalf, Y);
+	return VectorMultiplyAdd(E, VectorSetFloat1(0.693359375f), VectorAdd(M, Y));
+}
+
+/**
+ * X^Y as e^(Y * Log(X)), X must be positive.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxPow(const VectorRegister& X, const VectorRegister& Y)
+{
+	return VectorApproxExp<Precision>(VectorMultiply(Y, VectorApproxLog<Precision>(X)));
+}
+
+/**
+ * 1 / sqrt(X), X must be positive. Fast is the hardware estimate with one Newton-Raphson step.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxReciprocalSqrt(const VectorRegister& X)
+{
+	if (Precision == EApproxMathPrecision::Fast)
+	{
+		const VectorRegister Estimate = VectorReciprocalSqrt(X);
+		const VectorRegister HalfX = VectorMultiply(X, GlobalVectorConstants::FloatOneHalf);
+		const VectorRegister Step = VectorSubtract(GlobalVectorConstants::FloatOneHalf, VectorMultiply(HalfX, VectorMultiply(Estimate, Estimate)));
+		return VectorMultiplyAdd(Estimate, Step, Estimate);
+	}
+	return VectorReciprocalSqrtAccurate(X);
+}
+
+/**
+ * Square root, X must be positive or zero.
+ */
+template <EApproxMathPrecision Precision = EApproxMathPrecision::Accurate>
+FORCEINLINE VectorRegister VectorApproxSqrt(const VectorRegister& X)
+{
+	// X * 1/sqrt(X) is NaN for 0
+	const VectorRegister NonZero = VectorCompareGT(X, GlobalVectorConstants::FloatZero);
+	return VectorBitwiseAnd(VectorMultiply(X, VectorApproxReciprocalSqrt<Precision>(X)), NonZero);
+}
+
+/**
+ * Batch versions of the VectorApprox functions over float arrays, 4 at a time. The output arrays must be the same size as the
+ * inputs, and may be the same array as one of them.
+ */
+struct CORE_API FApproxMath
+{
+	static void Sin(TArrayView<const float> X, TArrayView<float> OutSin, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Cos(TArrayView<const float> X, TArrayView<float> OutCos, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void SinCos(TArrayView<const float> X, TArrayView<float> OutSin, TArrayView<float> OutCos, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Atan2(TArrayView<const float> Y, TArrayView<const float> X, TArrayView<float> OutAtan2, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Exp(TArrayView<const float> X, TArrayView<float> OutExp, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Log(TArrayView<const float> X, TArrayView<float> OutLog, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Pow(TArrayView<const float> X, TArrayView<const float> Y, TArrayView<float> OutPow, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void Sqrt(TArrayView<const float> X, TArrayView<float> OutSqrt, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+	static void ReciprocalSqrt(TArrayView<const float> X, TArrayView<float> OutReciprocalSqrt, EApproxMathPrecision Precision = EApproxMathPrecision::Accurate);
+};
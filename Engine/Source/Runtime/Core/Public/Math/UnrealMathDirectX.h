@@ -1153,6 +1153,10 @@ FORCEINLINE VectorRegisterInt VectorIntAbs(const VectorRegisterInt& A)
 #define VectorIntToFloat(A) _mm_cvtepi32_ps(A)
 #define VectorFloatToInt(A) _mm_cvttps_epi32(A)
 
+// Reinterpret the bits, no conversion
+#define VectorCastIntToFloat(A) _mm_castsi128_ps(A)
+#define VectorCastFloatToInt(A) _mm_castps_si128(A)
+
 //Loads and stores
 
 /**
@@ -1580,6 +1580,21 @@ FORCEINLINE VectorRegisterInt VectorFloatToInt(const VectorRegister& A)
 		(int32)A.V[3]);
 }
 
+// Reinterpret the bits, no conversion
+FORCEINLINE VectorRegister VectorCastIntToFloat(const VectorRegisterInt& A)
+{
+	VectorRegister Result;
+	FMemory::Memcpy(&Result, &A, sizeof(Result));
+	return Result;
+}
+
+FORCEINLINE VectorRegisterInt VectorCastFloatToInt(const VectorRegister& A)
+{
+	VectorRegisterInt Result;
+	FMemory::Memcpy(&Result, &A, sizeof(Result));
+	return Result;
+}
+
 //Loads and stores
 
 /**
@@ -1618,6 +1618,10 @@ FORCEINLINE VectorRegisterInt VectorIntSelect(const VectorRegisterInt& Mask, con
 #define VectorIntToFloat(A) vcvtq_f32_s32(A)
 #define VectorFloatToInt(A) vcvtq_s32_f32(A)
 
+// Reinterpret the bits, no conversion
+#define VectorCastIntToFloat(A) vreinterpretq_f32_s32(A)
+#define VectorCastFloatToInt(A) vreinterpretq_s32_f32(A)
+
 //Loads and stores
 
 /**
@@ -1660,6 +1664,160 @@ FORCEINLINE VectorRegisterInt VectorIntSelect(const VectorRegisterInt& Mask, con
 */
 #define VectorIntLoad1( Ptr )	vld1q_dup_s32((int32*)(Ptr))
 
+/*=============================================================================
+ *	8-wide float operations for batch kernels, on a pair of NEON registers
+ *============================================================================*/
+
+#define VECTOR_REGISTER8_DEFINED 1
+
+// vfmaq_f32 and vaddvq_f32 are AArch64 only
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VECTOR_REGISTER8_NEON_A64 1
+#else
+#define VECTOR_REGISTER8_NEON_A64 0
+#endif
+
+/**
+ *	float8 vector register type, the first 4 floats in val[0] and the last 4 in val[1].
+ */
+typedef float32x4x2_t	VectorRegister8;
+
+/**
+ * Returns a vector with all zeros.
+ */
+FORCEINLINE VectorRegister8 VectorZero8()
+{
+	VectorRegister8 Result;
+	Result.val[0] = vdupq_n_f32(0.0f);
+	Result.val[1] = Result.val[0];
+	return Result;
+}
+
+/**
+ * Returns a vector with the same float in all 8 components.
+ */
+FORCEINLINE VectorRegister8 VectorSetFloat8( float F )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vdupq_n_f32(F);
+	Result.val[1] = Result.val[0];
+	return Result;
+}
+
+/**
+ * Loads 8 floats from unaligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoad8( const float* Ptr )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vld1q_f32(Ptr);
+	Result.val[1] = vld1q_f32(Ptr + 4);
+	return Result;
+}
+
+/**
+ * Loads 8 floats from 32 byte aligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoadAligned8( const float* Ptr )
+{
+	return VectorLoad8(Ptr);
+}
+
+/**
+ * Stores 8 floats to unaligned memory.
+ */
+FORCEINLINE void VectorStore8( const VectorRegister8& Vec, float* Ptr )
+{
+	vst1q_f32(Ptr, Vec.val[0]);
+	vst1q_f32(Ptr + 4, Vec.val[1]);
+}
+
+/**
+ * Stores 8 floats to 32 byte aligned memory.
+ */
+FORCEINLINE void VectorStoreAligned8( const VectorRegister8& Vec, float* Ptr )
+{
+	VectorStore8(Vec, Ptr);
+}
+
+FORCEINLINE VectorRegister8 VectorAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vaddq_f32(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vaddq_f32(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+FORCEINLINE VectorRegister8 VectorSubtract8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vsubq_f32(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vsubq_f32(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+FORCEINLINE VectorRegister8 VectorMultiply8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vmulq_f32(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vmulq_f32(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+FORCEINLINE VectorRegister8 VectorDivide8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = VectorDivide(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = VectorDivide(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+/**
+ * Multiplies two vectors (component-wise) and adds in the third vector, fused into one instruction on AArch64.
+ */
+FORCEINLINE VectorRegister8 VectorMultiplyAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2, const VectorRegister8& Vec3 )
+{
+	VectorRegister8 Result;
+#if VECTOR_REGISTER8_NEON_A64
+	Result.val[0] = vfmaq_f32(Vec3.val[0], Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vfmaq_f32(Vec3.val[1], Vec1.val[1], Vec2.val[1]);
+#else
+	Result.val[0] = vmlaq_f32(Vec3.val[0], Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vmlaq_f32(Vec3.val[1], Vec1.val[1], Vec2.val[1]);
+#endif
+	return Result;
+}
+
+FORCEINLINE VectorRegister8 VectorMin8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vminq_f32(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vminq_f32(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+FORCEINLINE VectorRegister8 VectorMax8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	VectorRegister8 Result;
+	Result.val[0] = vmaxq_f32(Vec1.val[0], Vec2.val[0]);
+	Result.val[1] = vmaxq_f32(Vec1.val[1], Vec2.val[1]);
+	return Result;
+}
+
+/**
+ * Returns the sum of the 8 components.
+ */
+FORCEINLINE float VectorHorizontalSum8( const VectorRegister8& Vec )
+{
+	const float32x4_t Sum = vaddq_f32(Vec.val[0], Vec.val[1]);
+#if VECTOR_REGISTER8_NEON_A64
+	return vaddvq_f32(Sum);
+#else
+	const float32x2_t Pairs = vadd_f32(vget_low_f32(Sum), vget_high_f32(Sum));
+	return vget_lane_f32(vpadd_f32(Pairs, Pairs), 0);
+#endif
+}
+
 // To be continued...
 
 PRAGMA_ENABLE_SHADOW_VARIABLE_WARNINGS
@@ -10,6 +10,11 @@
 // We require SSE2
 #include <emmintrin.h>
 
+// AVX and FMA3 are used when the target is compiled for them, see PLATFORM_ALWAYS_HAS_AVX and PLATFORM_ALWAYS_HAS_FMA3
+#if PLATFORM_ALWAYS_HAS_AVX || PLATFORM_ALWAYS_HAS_FMA3
+#include <immintrin.h>
+#endif
+
 #include "Math/sse_mathfun.h"
 
 // We suppress static analysis warnings for the cast from (double*) to (float*) in VectorLoadFloat2 below:
@@ -339,7 +344,11 @@ FORCEINLINE VectorRegister VectorMultiply( const VectorRegister& Vec1, const Vec
  * @param Vec3	3rd vector
  * @return		VectorRegister( Vec1.x*Vec2.x + Vec3.x, Vec1.y*Vec2.y + Vec3.y, Vec1.z*Vec2.z + Vec3.z, Vec1.w*Vec2.w + Vec3.w )
  */
+#if PLATFORM_ALWAYS_HAS_FMA3
+#define VectorMultiplyAdd( Vec1, Vec2, Vec3 )	_mm_fmadd_ps( Vec1, Vec2, Vec3 )
+#else
 #define VectorMultiplyAdd( Vec1, Vec2, Vec3 )	_mm_add_ps( _mm_mul_ps(Vec1, Vec2), Vec3 )
+#endif
 
 /**
  * Calculates the dot3 product of two vectors and returns a vector with the result in all 4 components.
@@ -1449,6 +1458,10 @@ FORCEINLINE VectorRegisterInt VectorIntAbs(const VectorRegisterInt& A)
 #define VectorIntToFloat(A) _mm_cvtepi32_ps(A)
 #define VectorFloatToInt(A) _mm_cvttps_epi32(A)
 
+// Reinterpret the bits, no conversion
+#define VectorCastIntToFloat(A) _mm_castsi128_ps(A)
+#define VectorCastFloatToInt(A) _mm_castps_si128(A)
+
 //Loads and stores
 
 /**
@@ -1490,5 +1503,122 @@ FORCEINLINE VectorRegisterInt VectorIntAbs(const VectorRegisterInt& A)
 * @return		VectorRegisterInt(*Ptr, *Ptr, *Ptr, *Ptr)
 */
 #define VectorIntLoad1( Ptr )	_mm_shuffle_epi32(_mm_loadu_si128((VectorRegisterInt*)(Ptr)),_MM_SHUFFLE(0,0,0,0))
+
+/*=============================================================================
+ *	8-wide float operations for batch kernels, see UnrealMathVectorCommon.h for the versions built on two VectorRegisters
+ *============================================================================*/
+
+#if PLATFORM_ALWAYS_HAS_AVX
+
+#define VECTOR_REGISTER8_DEFINED 1
+
+/**
+ *	float8 vector register type, where the first float is stored in the lowest 32 bits, and so on.
+ */
+typedef __m256	VectorRegister8;
+
+/**
+ * Returns a vector with all zeros.
+ */
+FORCEINLINE VectorRegister8 VectorZero8()
+{
+	return _mm256_setzero_ps();
+}
+
+/**
+ * Returns a vector with the same float in all 8 components.
+ */
+FORCEINLINE VectorRegister8 VectorSetFloat8( float F )
+{
+	return _mm256_set1_ps(F);
+}
+
+/**
+ * Loads 8 floats from unaligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoad8( const float* Ptr )
+{
+	return _mm256_loadu_ps(Ptr);
+}
+
+/**
+ * Loads 8 floats from 32 byte aligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoadAligned8( const float* Ptr )
+{
+	return _mm256_load_ps(Ptr);
+}
+
+/**
+ * Stores 8 floats to unaligned memory.
+ */
+FORCEINLINE void VectorStore8( const VectorRegister8& Vec, float* Ptr )
+{
+	_mm256_storeu_ps(Ptr, Vec);
+}
+
+/**
+ * Stores 8 floats to 32 byte aligned memory.
+ */
+FORCEINLINE void VectorStoreAligned8( const VectorRegister8& Vec, float* Ptr )
+{
+	_mm256_store_ps(Ptr, Vec);
+}
+
+FORCEINLINE VectorRegister8 VectorAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_add_ps(Vec1, Vec2);
+}
+
+FORCEINLINE VectorRegister8 VectorSubtract8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_sub_ps(Vec1, Vec2);
+}
+
+FORCEINLINE VectorRegister8 VectorMultiply8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_mul_ps(Vec1, Vec2);
+}
+
+FORCEINLINE VectorRegister8 VectorDivide8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_div_ps(Vec1, Vec2);
+}
+
+/**
+ * Multiplies two vectors (component-wise) and adds in the third vector, fused into one instruction when FMA3 is available.
+ */
+FORCEINLINE VectorRegister8 VectorMultiplyAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2, const VectorRegister8& Vec3 )
+{
+#if PLATFORM_ALWAYS_HAS_FMA3
+	return _mm256_fmadd_ps(Vec1, Vec2, Vec3);
+#else
+	return _mm256_add_ps(_mm256_mul_ps(Vec1, Vec2), Vec3);
+#endif
+}
+
+FORCEINLINE VectorRegister8 VectorMin8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_min_ps(Vec1, Vec2);
+}
+
+FORCEINLINE VectorRegister8 VectorMax8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return _mm256_max_ps(Vec1, Vec2);
+}
+
+/**
+ * Returns the sum of the 8 components.
+ */
+FORCEINLINE float VectorHorizontalSum8( const VectorRegister8& Vec )
+{
+	VectorRegister Sum = _mm_add_ps(_mm256_castps256_ps128(Vec), _mm256_extractf128_ps(Vec, 1));
+	Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+	Sum = _mm_add_ss(Sum, _mm_shuffle_ps(Sum, Sum, SHUFFLEMASK(1, 1, 1, 1)));
+	return _mm_cvtss_f32(Sum);
+}
+
+#endif // PLATFORM_ALWAYS_HAS_AVX
+
 #endif
 
@@ -274,3 +274,121 @@ FORCEINLINE uint32 appCountTrailingZeros(uint32 Value)
 	return __builtin_ffs(Value) - 1;
 }
 #endif // _MSC_VER
+
+/*=============================================================================
+ *	8-wide float operations for batch kernels. Backends with native versions (AVX, NEON) define VECTOR_REGISTER8_DEFINED,
+ *	the others get these, built on two VectorRegisters.
+ *============================================================================*/
+
+#ifndef VECTOR_REGISTER8_DEFINED
+
+#define VECTOR_REGISTER8_DEFINED 1
+
+/**
+ *	float8 vector register type, the first 4 floats in Lo and the last 4 in Hi.
+ */
+struct VectorRegister8
+{
+	VectorRegister Lo;
+	VectorRegister Hi;
+};
+
+/**
+ * Returns a vector with all zeros.
+ */
+FORCEINLINE VectorRegister8 VectorZero8()
+{
+	return VectorRegister8{ VectorZero(), VectorZero() };
+}
+
+/**
+ * Returns a vector with the same float in all 8 components.
+ */
+FORCEINLINE VectorRegister8 VectorSetFloat8( float F )
+{
+	const VectorRegister Vec = VectorSetFloat1(F);
+	return VectorRegister8{ Vec, Vec };
+}
+
+/**
+ * Loads 8 floats from unaligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoad8( const float* Ptr )
+{
+	return VectorRegister8{ VectorLoad(Ptr), VectorLoad(Ptr + 4) };
+}
+
+/**
+ * Loads 8 floats from 32 byte aligned memory.
+ */
+FORCEINLINE VectorRegister8 VectorLoadAligned8( const float* Ptr )
+{
+	return VectorRegister8{ VectorLoadAligned(Ptr), VectorLoadAligned(Ptr + 4) };
+}
+
+/**
+ * Stores 8 floats to unaligned memory.
+ */
+FORCEINLINE void VectorStore8( const VectorRegister8& Vec, float* Ptr )
+{
+	VectorStore(Vec.Lo, Ptr);
+	VectorStore(Vec.Hi, Ptr + 4);
+}
+
+/**
+ * Stores 8 floats to 32 byte aligned memory.
+ */
+FORCEINLINE void VectorStoreAligned8( const VectorRegister8& Vec, float* Ptr )
+{
+	VectorStoreAligned(Vec.Lo, Ptr);
+	VectorStoreAligned(Vec.Hi, Ptr + 4);
+}
+
+FORCEINLINE VectorRegister8 VectorAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorAdd(Vec1.Lo, Vec2.Lo), VectorAdd(Vec1.Hi, Vec2.Hi) };
+}
+
+FORCEINLINE VectorRegister8 VectorSubtract8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorSubtract(Vec1.Lo, Vec2.Lo), VectorSubtract(Vec1.Hi, Vec2.Hi) };
+}
+
+FORCEINLINE VectorRegister8 VectorMultiply8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorMultiply(Vec1.Lo, Vec2.Lo), VectorMultiply(Vec1.Hi, Vec2.Hi) };
+}
+
+FORCEINLINE VectorRegister8 VectorDivide8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorDivide(Vec1.Lo, Vec2.Lo), VectorDivide(Vec1.Hi, Vec2.Hi) };
+}
+
+/**
+ * Multiplies two vectors (component-wise) and adds in the third vector.
+ */
+FORCEINLINE VectorRegister8 VectorMultiplyAdd8( const VectorRegister8& Vec1, const VectorRegister8& Vec2, const VectorRegister8& Vec3 )
+{
+	return VectorRegister8{ VectorMultiplyAdd(Vec1.Lo, Vec2.Lo, Vec3.Lo), VectorMultiplyAdd(Vec1.Hi, Vec2.Hi, Vec3.Hi) };
+}
+
+FORCEINLINE VectorRegister8 VectorMin8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorMin(Vec1.Lo, Vec2.Lo), VectorMin(Vec1.Hi, Vec2.Hi) };
+}
+
+FORCEINLINE VectorRegister8 VectorMax8( const VectorRegister8& Vec1, const VectorRegister8& Vec2 )
+{
+	return VectorRegister8{ VectorMax(Vec1.Lo, Vec2.Lo), VectorMax(Vec1.Hi, Vec2.Hi) };
+}
+
+/**
+ * Returns the sum of the 8 components.
+ */
+FORCEINLINE float VectorHorizontalSum8( const VectorRegister8& Vec )
+{
+	const VectorRegister Sum = VectorAdd(Vec.Lo, Vec.Hi);
+	return VectorGetComponent(Sum, 0) + VectorGetComponent(Sum, 1) + VectorGetComponent(Sum, 2) + VectorGetComponent(Sum, 3);
+}
+
+#endif // VECTOR_REGISTER8_DEFINED
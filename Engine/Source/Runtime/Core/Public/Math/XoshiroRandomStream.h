@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AssertionMacros.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/Vector.h"
+
+/**
+ * xoshiro128** random number generator [ Blackman and Vigna 2018, "Scrambled Linear Pseudorandom Number Generators" ].
+ *
+ * Much better statistical quality than FRandomStream, all the bits can be used, at about the same cost per number.
+ * The period is 2^128 - 1 and the stream can jump ahead by 2^64 and 2^96 numbers, which gives independent substreams for
+ * parallel work: GetSubstream(Index) never overlaps another substream for fewer than 2^96 numbers each, so every task can
+ * own its generator and the results do not depend on the scheduling.
+ *
+ * The Fill functions generate many numbers at a time on four interleaved lanes, lane L being this stream jumped L times
+ * by 2^64. Consecutive fills continue the same lanes, so filling N then M numbers gives the same numbers as filling N + M
+ * when N is a multiple of 4. They do not produce the same numbers as the single value functions.
+ */
+struct CORE_API FXoshiroRandomStream
+{
+public:
+	/** Creates a stream from seed 0 */
+	FXoshiroRandomStream()
+	{
+		Initialize(0);
+	}
+
+	/** Creates a stream from the specified seed */
+	explicit FXoshiroRandomStream(uint64 InSeed)
+	{
+		Initialize(InSeed);
+	}
+
+	/** Initializes the state from the specified seed, expanded with SplitMix64 so that nearby seeds give unrelated streams */
+	void Initialize(uint64 InSeed);
+
+	/** Returns a random number between 0 and MAXUINT */
+	FORCEINLINE uint32 GetUnsignedInt()
+	{
+		const uint32 Result = RotateLeft(State[1] * 5, 7) * 9;
+		const uint32 Shifted = State[1] << 9;
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= Shifted;
+		State[3] = RotateLeft(State[3], 11);
+		return Result;
+	}
+
+	/** Returns a random float number in the range [0, 1), with the full 24 bits of precision */
+	FORCEINLINE float GetFraction()
+	{
+		return float(GetUnsignedInt() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/** Mirrors the random number API in FMath */
+	FORCEINLINE float FRand()
+	{
+		return GetFraction();
+	}
+
+	/** @return A random number in [0..A) */
+	FORCEINLINE int32 RandHelper(int32 A)
+	{
+		// Multiply and shift instead of the modulus, which has no bias for powers of two and a tiny one otherwise
+		return A > 0 ? int32((uint64(GetUnsignedInt()) * uint64(A)) >> 32) : 0;
+	}
+
+	/** @return A random number >= Min and <= Max */
+	FORCEINLINE int32 RandRange(int32 Min, int32 Max)
+	{
+		return Min + RandHelper((Max - Min) + 1);
+	}
+
+	/** @return A random number >= Min and < Max */
+	FORCEINLINE float FRandRange(float InMin, float InMax)
+	{
+		return InMin + (InMax - InMin) * FRand();
+	}
+
+	/** @return A random vector of unit size */
+	FVector GetUnitVector();
+
+	/** Mirrors the random number API in FMath */
+	FORCEINLINE FVector VRand()
+	{
+		return GetUnitVector();
+	}
+
+	/** Advances the stream by 2^64 numbers */
+	void Jump();
+
+	/** Advances the stream by 2^96 numbers */
+	void LongJump();
+
+	/**
+	 * Returns the independent substream Index of this stream, which is this stream advanced by (Index + 1) * 2^96 numbers.
+	 * Costs a few hundred numbers per index, get each substream once per task rather than per use.
+	 */
+	FXoshiroRandomStream GetSubstream(int32 Index) const;
+
+	/** Fills Out with random numbers between 0 and MAXUINT */
+	void FillUnsignedInts(TArrayView<uint32> Out);
+
+	/** Fills Out with random numbers in [0, 1) */
+	void FillFractions(TArrayView<float> Out);
+
+	/** Fills Out with random numbers in [InMin, InMax) */
+	void FillRange(TArrayView<float> Out, float InMin, float InMax);
+
+	/** Gets the current state, for example to save and restore the stream */
+	void GetState(uint32 (&OutState)[4]) const
+	{
+		FMemory::Memcpy(OutState, State, sizeof(State));
+	}
+
+	/** Sets the state saved with GetState, it must not be all zeros */
+	void SetState(const uint32 (&InState)[4])
+	{
+		check(InState[0] | InState[1] | InState[2] | InState[3]);
+		FMemory::Memcpy(State, InState, sizeof(State));
+	}
+
+private:
+	static FORCEINLINE uint32 RotateLeft(uint32 Value, uint32 Shift)
+	{
+		return (Value << Shift) | (Value >> (32 - Shift));
+	}
+
+	/** Applies a jump polynomial, see Jump and LongJump */
+	void ApplyJump(const uint32 (&Polynomial)[4]);
+
+	/** Generates Num numbers, Num / 4 rounded up per lane, and hands each to Output(Index, Value) */
+	template <typename OutputFunction>
+	void Fill(int32 Num, OutputFunction Output);
+
+	uint32 State[4];
+};
@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Math/UnrealMathUtility.h"
+#include "Memory/MemoryArena.h"
+
+/** Arena scope
+
+	Makes an arena the active one for the current thread for the lifetime of
+	the scope. Containers using TArenaAllocator that are constructed while the
+	scope is active allocate from the arena, even once the scope is gone.
+
+	Scopes can be nested, the previously active arena is restored on exit.
+
+  */
+template<typename ArenaType>
+class TArenaScope
+{
+public:
+	explicit TArenaScope(ArenaType& Arena)
+	: PreviousArena(SetActiveMemoryArena(&Arena))
+	{
+	}
+
+	~TArenaScope()
+	{
+		SetActiveMemoryArena(PreviousArena);
+	}
+
+	TArenaScope(const TArenaScope&) = delete;
+	TArenaScope& operator=(const TArenaScope&) = delete;
+
+private:
+	FMemoryArena* PreviousArena;
+};
+
+/** Arena container allocator
+
+	Allocates container storage from the arena that was active when the
+	container was constructed, see TArenaScope. The arena is recorded in the
+	otherwise unused bits of the data pointer so the policy costs no memory over
+	the heap allocator on 64-bit platforms. Containers constructed outside of
+	any scope fall back to the heap.
+
+	The active arena must be an ArenaType. The containers must be destroyed
+	before their arena, destroying them is cheap with arenas that don't free
+	individual blocks such as FLinearArena.
+
+  */
+template<typename ArenaType = FMemoryArena>
+class TArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		/** Default constructor, binds to the active arena if there is one. */
+		ForElementType()
+		{
+			if (FMemoryArena* Arena = GetActiveMemoryArena())
+			{
+				Data.SetPointerAndArena(nullptr, Arena->ArenaId);
+			}
+		}
+
+		/** Destructor. */
+		FORCEINLINE ~ForElementType()
+		{
+			FreeData();
+		}
+
+		/**
+		 * Moves the state of another allocator into this one.
+		 * Assumes that the allocator is currently empty, i.e. memory may be allocated but any existing elements have already been destructed (if necessary).
+		 * @param Other - The allocator to move the state from.  This allocator should be left in a valid empty state.
+		 */
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			// the memory stays in the arena it came from, so take the arena along with it
+			FreeData();
+			Data = Other.Data;
+			Other.Data.SetPointerAndArena(nullptr, Other.Data.ArenaIndex());
+		}
+
+		// FContainerAllocatorInterface
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return (ElementType*)Data.Pointer();
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			const uint16 ArenaIndex = Data.ArenaIndex();
+			void* OldData = Data.Pointer();
+
+			if (ArenaIndex == FArenaPointer::NoTag)
+			{
+				// Avoid calling FMemory::Realloc( nullptr, 0 ) as ANSI C mandates returning a valid pointer which is not what we want.
+				if (OldData || NumElements)
+				{
+					Data.SetPointerAndArena(FMemory::Realloc(OldData, NumElements * NumBytesPerElement, (uint32)GetAlignment()), FArenaPointer::NoTag);
+				}
+			}
+			else if (NumElements)
+			{
+				// only the live elements need to be copied, arenas that can grow the block in place won't copy at all
+				void* NewData = GetArena().Realloc(OldData, PreviousNumElements * NumBytesPerElement, NumElements * NumBytesPerElement, GetAlignment());
+				Data.SetPointerAndArena(NewData, ArenaIndex);
+			}
+			else
+			{
+				FreeData();
+			}
+		}
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return !!Data;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		ForElementType(const ForElementType&);
+		ForElementType& operator=(const ForElementType&);
+
+		static constexpr SIZE_T GetAlignment()
+		{
+			return alignof(ElementType) > sizeof(void*) ? alignof(ElementType) : sizeof(void*);
+		}
+
+		FORCEINLINE ArenaType& GetArena() const
+		{
+			return static_cast<ArenaType&>(Data.Arena());
+		}
+
+		void FreeData()
+		{
+			if (void* OldData = Data.Pointer())
+			{
+				const uint16 ArenaIndex = Data.ArenaIndex();
+				if (ArenaIndex == FArenaPointer::NoTag)
+				{
+					FMemory::Free(OldData);
+				}
+				else
+				{
+					GetArena().Free(OldData);
+				}
+				Data.SetPointerAndArena(nullptr, ArenaIndex);
+			}
+		}
+
+		/** A pointer to the container's elements, tagged with the arena they were allocated from. */
+		FArenaPointer Data;
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+template <typename ArenaType>
+struct TAllocatorTraits<TArenaAllocator<ArenaType>> : TAllocatorTraitsBase<TArenaAllocator<ArenaType>>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = false };
+};
+
+/** Allocators for building TSparseArray, TSet and TMap storage in an arena. */
+template<typename ArenaType = FMemoryArena>
+using TArenaSparseArrayAllocator = TSparseArrayAllocator<TArenaAllocator<ArenaType>, TArenaAllocator<ArenaType>>;
+
+template<typename ArenaType = FMemoryArena>
+using TArenaSetAllocator = TSetAllocator<TArenaSparseArrayAllocator<ArenaType>, TArenaAllocator<ArenaType>>;
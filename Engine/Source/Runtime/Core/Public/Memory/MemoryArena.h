@@ -111,6 +111,7 @@ public:
 
 	CORE_API UE_RESTRICT UE_NOALIAS void*	Alloc(SIZE_T Size, SIZE_T Alignment);
 	CORE_API UE_NOALIAS void				Free(const void* MemoryBlock);
+	CORE_API void*							Realloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment);
 
 	CORE_API SIZE_T				BlockSize(const void* MemoryBlock) const;
 	CORE_API const TCHAR*		GetDebugName() const;
@@ -120,6 +121,9 @@ private:
 	CORE_API virtual void		InternalFree(const void* MemoryBlock, SIZE_T MemoryBlockSize);
 	CORE_API virtual SIZE_T		InternalBlockSize(const void* MemoryBlock) const = 0;
 
+	// Default implementation allocates a new block and copies OldSize bytes over
+	CORE_API virtual void*		InternalRealloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment);
+
 	CORE_API virtual const TCHAR* InternalGetDebugName() const;
 
 	enum { FlagNoFree = 1 << 0 };
@@ -140,6 +144,10 @@ inline void FArenaPointer::Free() const
 CORE_API FArenaPointer ArenaRealloc(FArenaPointer InPtr, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment);
 CORE_API FArenaPointer ArenaRealloc(FMemoryArena* Arena, void* InPtr, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment);
 
+// Arena that arena-based containers constructed on the current thread allocate from, see TArenaScope
+CORE_API FMemoryArena* GetActiveMemoryArena();
+CORE_API FMemoryArena* SetActiveMemoryArena(FMemoryArena* Arena);
+
 /** Heap arena
 
 	Manages a dedicated area of memory, and allows user to allocate blocks from
@@ -181,6 +189,48 @@ private:
 	CORE_API virtual const TCHAR*	InternalGetDebugName() const override;
 };
 
+/** Linear arena
+
+	Bump allocates from chunks of heap memory. Freeing individual blocks is a
+	no-op, except for the most recent one which is rolled back, and the most
+	recent block can also be grown in place. Everything is released at once when
+	the arena is reset or destroyed, which makes it a good fit for building a
+	graph of short lived containers and throwing it away as a whole.
+
+	Not thread safe, an arena should only be used by one thread at a time.
+
+  */
+class FLinearArena final : public FMemoryArena
+{
+public:
+	CORE_API explicit	FLinearArena(SIZE_T InChunkSize = 64 * 1024);
+	CORE_API			~FLinearArena();
+
+	/** Releases every block allocated from the arena, keeping the current chunk around for reuse. */
+	CORE_API void		Reset();
+
+private:
+	CORE_API virtual void*			InternalAlloc(SIZE_T Size, SIZE_T Alignment) override;
+	CORE_API virtual void			InternalFree(const void* MemoryBlock, SIZE_T MemoryBlockSize) override;
+	CORE_API virtual SIZE_T			InternalBlockSize(const void* MemoryBlock) const override;
+	CORE_API virtual void*			InternalRealloc(void* MemoryBlock, SIZE_T OldSize, SIZE_T NewSize, SIZE_T Alignment) override;
+	CORE_API virtual const TCHAR*	InternalGetDebugName() const override;
+
+	void AllocateChunk(SIZE_T MinSize);
+
+	struct FChunk
+	{
+		FChunk*	Next;
+		SIZE_T	Size;
+	};
+
+	FChunk*	Chunks		= nullptr;
+	uint8*	Cursor		= nullptr;
+	uint8*	End			= nullptr;
+	uint8*	LastBlock	= nullptr;
+	SIZE_T	ChunkSize;
+};
+
 /** CRT heap allocator
 
 	All allocations are passed through to CRT memory allocation functions
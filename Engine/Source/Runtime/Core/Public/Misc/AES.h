@@ -103,4 +103,24 @@ struct CORE_API FAES
 	* @param Key a byte array that is a 32 byte multiple length
 	*/
 	static void DecryptData(uint8* Contents, uint32 NumBytes, const uint8* KeyBytes, uint32 NumKeyBytes);
+
+	/**
+	 * Encrypts or decrypts a chunk of data in counter mode, which xors the data with the encrypted counter blocks.
+	 *
+	 * Unlike EncryptData identical blocks don't encrypt identically and the data can be any size. Every block is
+	 * independent of the others, so they are processed in parallel and any part of the data can be decrypted on its
+	 * own in place, such as a single read out of a larger encrypted file.
+	 *
+	 * @param Contents the buffer to encrypt or decrypt in place
+	 * @param NumBytes the size of the buffer
+	 * @param Key An FAESKey object containing the encryption key
+	 * @param InitialCounter the counter block for the start of the data, which must never be used twice with the same key
+	 * @param Offset the position of Contents from the start of the data, in bytes
+	 */
+	static void CryptDataCTR(uint8* Contents, uint64 NumBytes, const FAESKey& Key, const uint8 (&InitialCounter)[AESBlockSize], uint64 Offset = 0);
+
+	/**
+	 * @return whether encryption runs on the CPU's AES instructions rather than lookup tables
+	 */
+	static bool IsHardwareAccelerated();
 };
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Templates/Function.h"
+
+/** What a measured block of code cost, per run */
+struct FAutomationPerformanceMetrics
+{
+	/** Median over the runs */
+	double Seconds = 0.0;
+	/** Median absolute deviation of the run times, the noise the time thresholds allow for */
+	double DeviationSeconds = 0.0;
+	/** Allocations and allocated bytes of the test thread, from FMallocCountingProxy. Both are deterministic for most code. */
+	uint64 NumAllocations = 0;
+	uint64 AllocatedBytes = 0;
+};
+
+/**
+ * Base for tests that fail when code gets slower or allocates more, declared with
+ * IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST(FMyTest, FAutomationPerformanceTestBase, "...", ... | EAutomationTestFlags::PerfFilter)
+ * and calling MeasurePerformance from RunTest.
+ *
+ * Metrics are compared with the baselines in Build/PerformanceBaselines/<Platform>.txt of the project, Automation.Performance.BaselineFile
+ * to override. A time regresses when its median is more than Automation.Performance.TimeTolerance slower than the baseline plus three
+ * deviations of whichever run was noisier, allocations and bytes when they exceed the baseline by more than Automation.Performance.AllocationTolerance.
+ * Metrics without a baseline only warn. Running with -updateperformancebaselines, or Automation.Performance.UpdateBaselines 1, records the
+ * measured metrics as the new baselines instead.
+ */
+class CORE_API FAutomationPerformanceTestBase : public FAutomationTestBase
+{
+public:
+	FAutomationPerformanceTestBase(const FString& InName, const bool bInComplexTask)
+		: FAutomationTestBase(InName, bInComplexTask)
+	{
+	}
+
+protected:
+	/**
+	 * Runs Body once to warm up and then NumRuns times, and checks what it cost against the baseline.
+	 * @param MetricName; identifies the measure within the test, so that a test can have several
+	 * @return false if a metric regressed, errors are added to the test
+	 */
+	bool MeasurePerformance(const FString& MetricName, TFunctionRef<void()> Body, int32 NumRuns = 9);
+
+	/** Checks metrics measured some other way against the baseline */
+	bool CheckPerformance(const FString& MetricName, const FAutomationPerformanceMetrics& Metrics);
+};
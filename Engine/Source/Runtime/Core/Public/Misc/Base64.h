@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/StringFwd.h"
 #include "Containers/UnrealString.h"
 #include "Misc/Timespan.h"
 
@@ -50,6 +51,16 @@ struct CORE_API FBase64
 	 */
 	template<typename CharType> static uint32 Encode(const uint8* Source, uint32 Length, CharType* Dest);
 
+	/**
+	 * Encodes the source into a Base64 string, appending it to a string builder.
+	 *
+	 * @param Source The binary data to encode
+	 * @param Length Length of the binary data to be encoded
+	 * @param Builder Builder to append the encoded data to
+	 */
+	static void Encode(const uint8* Source, uint32 Length, FStringBuilderBase& Builder);
+	static void Encode(const uint8* Source, uint32 Length, FAnsiStringBuilderBase& Builder);
+
 	/**
 	* Get the encoded data size for the given number of bytes.
 	*
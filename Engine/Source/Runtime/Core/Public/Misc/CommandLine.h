@@ -97,7 +97,28 @@ struct CORE_API FCommandLine
 	*/
 	static FString BuildFromArgV(const TCHAR* Prefix, int32 ArgC, TCHAR* ArgV[], const TCHAR* Suffix);
 
+	/**
+	 * Finds Match in Stream the same as FCString::Strifind, from an index of the words of the command line instead
+	 * of a search through all of it. The index is built by Set and Append, so this only works when Stream is the
+	 * string returned by Get and Match starts with a word followed by a separator, like "-Key=".
+	 *
+	 * @param OutFound Set to the first match or nullptr when this returns true
+	 * @return Whether the index could be used, FCString::Strifind has to be called instead otherwise
+	 */
+	static bool FindIndexed(const TCHAR* Stream, const TCHAR* Match, bool bSkipQuotedChars, const TCHAR*& OutFound);
+
+	/**
+	 * Checks for a switch the same as FParse::Param, from the index of the command line, see FindIndexed.
+	 *
+	 * @param bOutFound Set to whether Param is on the command line when this returns true
+	 * @return Whether the index could be used
+	 */
+	static bool ParamIndexed(const TCHAR* Stream, const TCHAR* Param, bool& bOutFound);
+
 private:
+	/** Builds the index of the words of the current command line for FindIndexed and ParamIndexed */
+	static void BuildIndex();
+
 #if WANTS_COMMANDLINE_WHITELIST
 	/** Filters both the original and current command line list for approved only args */
 	static void WhitelistCommandLines();
@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Tuple.h"
+
+/**
+ * A wild card pattern compiled once to be matched against many strings, with the same semantics as
+ * FWildcardString::IsMatch: '?' matches exactly one character and '*' matches any sequence of characters.
+ *
+ * The characters before the first '*' and after the last '*' are compared directly against the start and end of
+ * the input. The rest of the pattern runs as a bit parallel automaton over the remaining characters, so matching
+ * takes time linear in the input length however many '*' the pattern holds, where IsMatch backtracks. Only very
+ * long patterns, with more than 63 characters between their first and last '*', fall back to searching for each
+ * part in turn.
+ */
+class CORE_API FCompiledWildcard
+{
+public:
+	/** Creates a pattern that only matches the empty string. */
+	FCompiledWildcard()
+		: FCompiledWildcard(FStringView())
+	{
+	}
+
+	/**
+	 * Compiles the pattern.
+	 *
+	 * @param InPattern The pattern to match.
+	 * @param InSearchCase Whether characters are compared case sensitively, which FWildcardString::IsMatch does.
+	 */
+	explicit FCompiledWildcard(const FStringView& InPattern, ESearchCase::Type InSearchCase = ESearchCase::CaseSensitive);
+
+	/** @return The pattern this was compiled from. */
+	FORCEINLINE const FString& GetPattern() const
+	{
+		return Pattern;
+	}
+
+	/** @return Whether the pattern contains any wild card, otherwise it only matches one string. */
+	FORCEINLINE bool ContainsWildcards() const
+	{
+		return bContainsWildcards;
+	}
+
+	/**
+	 * Matches the input string to the pattern.
+	 *
+	 * @param Input The string to match.
+	 * @return true if the whole input matches the pattern, false otherwise.
+	 */
+	bool IsMatch(const FStringView& Input) const;
+
+	/**
+	 * Matches each string of a range to the pattern.
+	 *
+	 * @param Inputs A range of strings convertible to FStringView, such as TArray<FString>.
+	 * @param OutMatches Receives one bit per input, set when it matches the pattern.
+	 * @return The number of inputs matching the pattern.
+	 */
+	template <typename RangeType>
+	int32 IsMatch(const RangeType& Inputs, TBitArray<>& OutMatches) const
+	{
+		int32 NumMatches = 0;
+		OutMatches.Reset();
+		for (const auto& Input : Inputs)
+		{
+			const bool bMatch = IsMatch(FStringView(Input));
+			OutMatches.Add(bMatch);
+			NumMatches += bMatch;
+		}
+		return NumMatches;
+	}
+
+private:
+	/** The largest number of characters between the first and last '*' the automaton can track */
+	static constexpr int32 MaxAutomatonChars = 63;
+
+	bool MatchesChars(const TCHAR* PatternChars, const TCHAR* InputChars, int32 Len) const;
+	bool IsMiddleMatchAutomaton(const TCHAR* Input, int32 Len) const;
+	bool IsMiddleMatchSearch(const TCHAR* Input, int32 Len) const;
+
+	FORCEINLINE uint64 GetCharMask(TCHAR Char) const
+	{
+		if (uint32(Char) < UE_ARRAY_COUNT(AsciiMasks))
+		{
+			return AsciiMasks[Char];
+		}
+
+		uint64 Mask = AnyCharMask;
+		for (const TTuple<TCHAR, uint64>& OtherMask : OtherMasks)
+		{
+			if (OtherMask.Get<0>() == Char)
+			{
+				Mask |= OtherMask.Get<1>();
+				break;
+			}
+		}
+		return Mask;
+	}
+
+	/** The original pattern */
+	FString Pattern;
+
+	/** The pattern without repeated '*', lower cased when ignoring case */
+	FString Compiled;
+
+	/** The number of compiled characters before the first '*', the whole pattern when it has none */
+	int32 PrefixLen;
+
+	/** The number of compiled characters after the last '*' */
+	int32 SuffixLen;
+
+	/** The number of characters an input needs at least, discounting '*' */
+	int32 MinInputLen;
+
+	ESearchCase::Type SearchCase;
+	bool bContainsWildcards;
+	bool bContainsSequenceWildcard;
+	bool bUseAutomaton;
+
+	/**
+	 * The automaton for the characters between the first and last '*'. State 0 is the start and bit N is set once the
+	 * first N characters that aren't '*' matched, each state followed by a '*' keeps itself on any character.
+	 */
+	uint64 LoopMask;
+	uint64 AcceptMask;
+	uint64 AnyCharMask;
+	uint64 AsciiMasks[128];
+	TArray<TTuple<TCHAR, uint64>> OtherMasks;
+};
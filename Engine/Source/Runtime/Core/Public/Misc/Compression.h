@@ -7,8 +7,17 @@
 #include "Templates/Atomic.h"
 #include "Misc/CompressionFlags.h"
 #include "HAL/CriticalSection.h"
+#include "Containers/ConcurrentMap.h"
+#include "Containers/ArrayView.h"
+#include "Templates/UniquePtr.h"
 
 class IMemoryReadStream;
+struct ICompressionDictionary;
+
+/** Whether the Zstd library is linked so NAME_Zstd is a built in format, otherwise it can still come from a compression format module */
+#ifndef WITH_ZSTD
+	#define WITH_ZSTD 0
+#endif
 
 // Define global current platform default to current platform.  
 // DEPRECATED, USE NAME_Zlib
@@ -59,7 +68,7 @@ struct FCompression
 	 * @param	CompressedSize	[in/out]	Size of CompressedBuffer, at exit will be size of compressed data
 	 * @param	UncompressedBuffer			Buffer containing uncompressed data
 	 * @param	UncompressedSize			Size of uncompressed data in bytes
-	 * @param	BitWindow					Bit window to use in compression
+	 * @param	BitWindow					Bit window to use in compression, or the compression level for NAME_Zstd
 	 * @return true if compression succeeds, false if it fails because CompressedBuffer was too small or other reasons
 	 */
 	CORE_API static bool CompressMemory(FName FormatName, void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize, ECompressionFlags Flags=COMPRESS_NoFlags, int32 CompressionData=0);
@@ -79,6 +88,28 @@ struct FCompression
 	CORE_API static bool UncompressMemory(FName FormatName, void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize, ECompressionFlags Flags=COMPRESS_NoFlags, int32 CompressionData=0);
 
 	CORE_API static bool UncompressMemoryStream(FName FormatName, void* UncompressedBuffer, int32 UncompressedSize, IMemoryReadStream* Stream, int64 StreamOffset, int32 CompressedSize, ECompressionFlags Flags = COMPRESS_NoFlags, int32 CompressionData = 0);
+
+	/** One of the blocks to uncompress with UncompressMemoryBatch */
+	struct FUncompressBlock
+	{
+		void* UncompressedBuffer;
+		int32 UncompressedSize;
+		const void* CompressedBuffer;
+		int32 CompressedSize;
+		/** Set by UncompressMemoryBatch */
+		bool bSucceeded;
+	};
+
+	/**
+	 * Thread-safe abstract decompression routine for several independent blocks of the same format, with the same results
+	 * as calling UncompressMemory for each of them. LZ4 blocks are decoded two at a time with their sequences interleaved,
+	 * which hides memory latency and is faster on one core than decoding them one after the other.
+	 *
+	 * @param	FormatName					Name of the compression format
+	 * @param	Blocks						The blocks to uncompress, bSucceeded is set for each of them
+	 * @return true if all blocks were uncompressed
+	 */
+	CORE_API static bool UncompressMemoryBatch(FName FormatName, TArrayView<FUncompressBlock> Blocks, ECompressionFlags Flags=COMPRESS_NoFlags, int32 CompressionData=0);
 	/**
 	 * Returns a string which can be used to identify if a format has become out of date
 	 *
@@ -102,6 +133,44 @@ struct FCompression
 
 	CORE_API static FName GetCompressionFormatFromDeprecatedFlags(ECompressionFlags DeprecatedFlags);
 
+	/**
+	 * Trains a dictionary from samples of the data to compress, for formats supporting them. Dictionaries improve the ratio of small
+	 * buffers the most, such as the blocks of a container or network payloads of a few kilobytes.
+	 *
+	 * @param	FormatName					Compressor format name, NAME_Zstd or a format module supporting dictionaries
+	 * @param	Samples						Buffers representative of the data to compress, a few hundred or more
+	 * @param	MaxDictionarySize			Maximum size of the dictionary in bytes, around 100 times smaller than the samples is typical
+	 * @param	OutDictionary				The trained dictionary
+	 * @return true if the format supports dictionaries and the training succeeded
+	 */
+	CORE_API static bool TrainDictionary(FName FormatName, TArrayView<const TArrayView<const uint8>> Samples, int32 MaxDictionarySize, TArray<uint8>& OutDictionary);
+
+	/**
+	 * Loads a dictionary trained by TrainDictionary, which keeps the state needed to compress and uncompress against it so that
+	 * calls don't rebuild it. Data compressed with a dictionary can only be uncompressed with the same one.
+	 * Include Misc/ICompressionFormat.h to use the result.
+	 *
+	 * @param	FormatName					Compressor format name the dictionary was trained for
+	 * @param	Dictionary					The dictionary
+	 * @param	CompressionData				Format specific, the compression level for NAME_Zstd
+	 * @return the loaded dictionary, or null if the format does not support dictionaries or could not load it
+	 */
+	CORE_API static TUniquePtr<ICompressionDictionary> CreateDictionary(FName FormatName, TArrayView<const uint8> Dictionary, int32 CompressionData = 0);
+
+#if WITH_ZSTD
+	/**
+	 * Registers a dictionary for NAME_Zstd. Zstd frames record the id of the dictionary they were compressed with, so uncompressing
+	 * any frame which needs this dictionary uses it from now on. Dictionaries stay registered until exit.
+	 *
+	 * @param	Dictionary				Dictionary trained with zstd --train, raw content dictionaries have no id and are rejected
+	 * @param	DictionarySize			Size of the dictionary in bytes
+	 * @param	CompressionLevel		Level to compress with when this dictionary is used, 0 for the default level
+	 * @param	bUseForCompression		Whether to compress with this dictionary from now on, replacing the previous one
+	 * @return	The id of the dictionary, or 0 if it could not be loaded
+	 */
+	CORE_API static uint32 RegisterZstdDictionary(const void* Dictionary, int32 DictionarySize, int32 CompressionLevel, bool bUseForCompression);
+#endif
+
 private:
 	
 	/**
@@ -109,9 +178,8 @@ private:
 	 */
 	static struct ICompressionFormat* GetCompressionFormat(FName Method, bool bErrorOnFailure=true);
 
-	/** Mapping of Compression FNames to their compressor objects */
-	static TMap<FName, struct ICompressionFormat*> CompressionFormats;
-	static FCriticalSection CompressionFormatsCriticalSection;
+	/** Mapping of Compression FNames to their compressor objects, looked up from any thread */
+	static TConcurrentMap<FName, struct ICompressionFormat*> CompressionFormats;
 
 };
 
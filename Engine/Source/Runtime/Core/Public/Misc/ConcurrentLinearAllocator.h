@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Math/UnrealMathUtility.h"
+
+/**
+ * Linear allocator for short lived temporaries that may be freed on any thread.
+ *
+ * Unlike FMemStack there are no marks: every allocation is released individually with Free, from whichever thread ends up
+ * owning it, which makes it safe for memory that crosses a task boundary. Each thread bump allocates from its own page taken
+ * from the lock-free FPageAllocator pool, and a page goes back to the pool once the thread has moved on from it and every
+ * allocation made from it has been freed. Memory of freed allocations is not reused before that, so this is only a good fit
+ * for allocations that die young, e.g. the temporaries of a task graph job.
+ *
+ * Allocations too large for a page fall back to FMemory.
+ */
+class CORE_API FConcurrentLinearAllocator
+{
+public:
+	/**
+	 * Allocates memory from the current thread's page.
+	 *
+	 * @param Size Number of bytes to allocate.
+	 * @param Alignment Alignment of the allocation, must be a power of two.
+	 * @return The allocation, never nullptr.
+	 */
+	static void* Malloc(SIZE_T Size, uint32 Alignment = DEFAULT_ALIGNMENT);
+
+	/**
+	 * Releases an allocation made with Malloc. May be called from any thread.
+	 *
+	 * @param Ptr The allocation to release, may be nullptr.
+	 */
+	static void Free(void* Ptr);
+
+	/** Retires the current thread's page so that it can go back to the pool as soon as its allocations are freed. */
+	static void FlushCurrentThreadCache();
+};
+
+
+/** A container allocator that allocates from the concurrent linear allocator, containers using it may be moved to and destroyed on other threads. */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TConcurrentLinearArrayAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		/** Default constructor. */
+		ForElementType():
+			Data(nullptr)
+		{}
+
+		/** Destructor. */
+		FORCEINLINE ~ForElementType()
+		{
+			FConcurrentLinearAllocator::Free(Data);
+		}
+
+		/**
+		 * Moves the state of another allocator into this one.
+		 * Assumes that the allocator is currently empty, i.e. memory may be allocated but any existing elements have already been destructed (if necessary).
+		 * @param Other - The allocator to move the state from.  This allocator should be left in a valid empty state.
+		 */
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			FConcurrentLinearAllocator::Free(Data);
+			Data       = Other.Data;
+			Other.Data = nullptr;
+		}
+
+		// FContainerAllocatorInterface
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			ElementType* OldData = Data;
+			Data = nullptr;
+			if (NumElements)
+			{
+				Data = (ElementType*)FConcurrentLinearAllocator::Malloc(NumElements * NumBytesPerElement, FMath::Max(Alignment, (uint32)alignof(ElementType)));
+
+				// If the container previously held elements, copy them into the new allocation.
+				if (OldData && PreviousNumElements)
+				{
+					const SizeType NumCopiedElements = FMath::Min(NumElements, PreviousNumElements);
+					FMemory::Memcpy(Data, OldData, NumCopiedElements * NumBytesPerElement);
+				}
+			}
+			FConcurrentLinearAllocator::Free(OldData);
+		}
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return !!Data;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		ForElementType(const ForElementType&);
+		ForElementType& operator=(const ForElementType&);
+
+		/** A pointer to the container's elements. */
+		ElementType* Data;
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TConcurrentLinearArrayAllocator<Alignment>> : TAllocatorTraitsBase<TConcurrentLinearArrayAllocator<Alignment>>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = true };
+};
+
+/** Sparse array and set allocators for TSparseArray, TSet and TMap temporaries. */
+typedef TSparseArrayAllocator<TConcurrentLinearArrayAllocator<>, TConcurrentLinearArrayAllocator<>> FConcurrentLinearSparseArrayAllocator;
+typedef TSetAllocator<FConcurrentLinearSparseArrayAllocator, TConcurrentLinearArrayAllocator<>> FConcurrentLinearSetAllocator;
@@ -20,6 +20,9 @@
 #include "Math/Rotator.h"
 #include "Misc/Paths.h"
 #include "Serialization/StructuredArchive.h"
+#include "Templates/Atomic.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
 
 CORE_API DECLARE_LOG_CATEGORY_EXTERN(LogConfig, Log, All);
 
@@ -448,6 +451,10 @@ public:
 
 	friend FArchive& operator<<(FArchive& Ar, FConfigFile& ConfigFile);
 private:
+	friend class FConfigCacheIni;
+
+	/** Generates the text Write saves, and hands it to Save, which returns whether the file was saved */
+	bool WriteInternal(const FString& Filename, bool bDoRemoteWrite, TMap<FString, FString>& InOutSectionTexts, const TArray<FString>& InSectionOrder, TFunctionRef<bool(const FString&)> Save);
 
 	// This holds per-object config class names, with their ArrayOfStructKeys. Since the POC sections are all unique,
 	// we can't track it just in that section. This is expected to be empty/small
@@ -585,6 +592,14 @@ public:
 
 	void Flush( bool Read, const FString& Filename=TEXT("") );
 
+	/**
+	 * Writes the dirty files like Flush without reading them back, but on a background thread, once ini.AsyncFlushDelay
+	 * seconds have passed so that the flushes asked for in the meantime are written along with this one. Every file is
+	 * written to a temporary file that is then renamed over it. The text of the files is still generated on this thread.
+	 * Flush, which ini.AsyncFlush makes call this when not reading back, writes what is still waiting and waits for it.
+	 */
+	void FlushAsync( const FString& Filename=TEXT("") );
+
 	void LoadFile( const FString& InFilename, const FConfigFile* Fallback = NULL, const TCHAR* PlatformString = NULL );
 	void SetFile( const FString& InFilename, const FConfigFile* NewConfigFile );
 	void UnloadFile( const FString& Filename );
@@ -923,8 +938,26 @@ public:
 	 */
 	void SaveCurrentStateForBootstrap(const TCHAR* Filename);
 
+	/**
+	 * Returns a counter that changes whenever config files are loaded, unloaded or modified through the config API.
+	 * TConfigValueHandle uses it to know when to look its value up again.
+	 */
+	static uint32 GetGeneration()
+	{
+		return Generation.Load(EMemoryOrder::Relaxed);
+	}
+
+	/** Invalidates all TConfigValueHandles, for code that modifies an FConfigFile or FConfigSection directly */
+	static void IncrementGeneration()
+	{
+		Generation.IncrementExchange();
+	}
+
 	friend FArchive& operator<<(FArchive& Ar, FConfigCacheIni& ConfigCacheIni);
 private:
+	/** See GetGeneration() */
+	static TAtomic<uint32> Generation;
+
 	/** Serialize a bootstrapping state into or from an archive */
 	void SerializeStateForBootstrap_Impl(FArchive& Ar);
 
@@ -936,10 +969,109 @@ private:
 	
 	/** The type of the cache (basically, do we call Flush in the destructor) */
 	EConfigCacheType Type;
+
+	/** Writes the files FlushAsync was asked for once the delay is over */
+	bool TickAsyncFlush(float DeltaTime);
+
+	/** Writes the files FlushAsync was asked for now, and waits for all the background writes to be done */
+	void FinishAsyncFlushes();
+
+	/** Marks the files whose background write failed as dirty again, so that the next flush writes them */
+	void RedirtyFailedAsyncWrites();
+
+	/** Writes files in the background one at a time, created by the first FlushAsync */
+	class FAsyncWriter;
+	TUniquePtr<FAsyncWriter> AsyncWriter;
+
+	/** The files FlushAsync was asked for since the last write, all of them if bPendingAsyncFlushAll */
+	TSet<FString> PendingAsyncFlushes;
+	bool bPendingAsyncFlushAll;
+	FDelegateHandle AsyncFlushTickerHandle;
+	FDelegateHandle AsyncFlushExitHandle;
 };
 
 FArchive& operator<<(FArchive& Ar, FConfigCacheIni& ConfigCacheIni);
 
+/**
+ * A (file, section, key) lookup in GConfig that is resolved once and only looked up again after the config changed,
+ * for code that reads a setting every frame. The filename is copied, so construct handles once the config system is
+ * initialized, e.g. as function statics or members.
+ *
+ *		static TConfigValueHandle<float> MaxDistance(TEXT("/Script/Engine.Foo"), TEXT("MaxDistance"), GEngineIni);
+ *		const float Distance = MaxDistance.Get(1000.0f);
+ */
+class CORE_API FConfigValueHandle
+{
+public:
+	FConfigValueHandle(const TCHAR* InSection, const TCHAR* InKey, const FString& InFilename);
+
+	/** Whether the value was looked up since the config last changed */
+	FORCEINLINE bool IsUpToDate() const
+	{
+		return Generation == FConfigCacheIni::GetGeneration();
+	}
+
+protected:
+	/** Looks the value up in GConfig, returns false if it isn't set */
+	bool Resolve(FString& OutValue);
+
+private:
+	FString Section;
+	FString Key;
+	FString Filename;
+	uint32 Generation;
+};
+
+/** FConfigValueHandle parsing the value as T with LexFromString, like the typed FConfigCacheIni getters */
+template<typename T>
+class TConfigValueHandle : public FConfigValueHandle
+{
+public:
+	TConfigValueHandle(const TCHAR* InSection, const TCHAR* InKey, const FString& InFilename)
+		: FConfigValueHandle(InSection, InKey, InFilename)
+	{
+	}
+
+	/** Returns true and sets OutValue if the key is set */
+	FORCEINLINE bool TryGet(T& OutValue)
+	{
+		if (!IsUpToDate())
+		{
+			Update();
+		}
+		if (bIsSet)
+		{
+			OutValue = Value;
+		}
+		return bIsSet;
+	}
+
+	/** Returns the value, or Default if the key isn't set */
+	FORCEINLINE T Get(const T& Default)
+	{
+		if (!IsUpToDate())
+		{
+			Update();
+		}
+		return bIsSet ? Value : Default;
+	}
+
+private:
+	FORCENOINLINE void Update()
+	{
+		FString Text;
+		bIsSet = Resolve(Text);
+		Value = T();
+		if (bIsSet)
+		{
+			LexFromString(Value, *Text);
+		}
+	}
+
+	T Value = T();
+	bool bIsSet = false;
+};
+
 UE_DEPRECATED(4.24, "This functionality to generate Scalability@Level section string has been moved to Scalability.cpp. Explictly construct section you need manually.")
 CORE_API void ApplyCVarSettingsGroupFromIni(const TCHAR* InSectionBaseName, int32 InGroupNumber, const TCHAR* InIniFilename, uint32 SetBy);
 
@@ -40,7 +40,12 @@ Can be overridden by setting to 1 or 0 in the project's .Target.cs files.
 	#error USE_SMALL_DELEGATES has been removed - please use NUM_DELEGATE_INLINE_BYTES instead
 #else
 	#ifndef NUM_DELEGATE_INLINE_BYTES
-		#define NUM_DELEGATE_INLINE_BYTES 0
+		// Fits UObject and raw method bindings, and lambdas capturing up to three pointers, so binding them doesn't allocate
+		#if PLATFORM_64BITS
+			#define NUM_DELEGATE_INLINE_BYTES 48
+		#else
+			#define NUM_DELEGATE_INLINE_BYTES 0
+		#endif
 	#endif
 #endif
 
@@ -49,7 +54,12 @@ Can be overridden by setting to 1 or 0 in the project's .Target.cs files.
 	#error USE_SMALL_MULTICAST_DELEGATES has been removed - please use NUM_MULTICAST_DELEGATE_INLINE_ENTRIES instead
 #else
 	#ifndef NUM_MULTICAST_DELEGATE_INLINE_ENTRIES
-		#define NUM_MULTICAST_DELEGATE_INLINE_ENTRIES 0
+		// Most multicast delegates have one or two listeners
+		#if PLATFORM_64BITS
+			#define NUM_MULTICAST_DELEGATE_INLINE_ENTRIES 2
+		#else
+			#define NUM_MULTICAST_DELEGATE_INLINE_ENTRIES 0
+		#endif
 	#endif
 #endif
 
@@ -4,6 +4,9 @@
 
 #include "CoreTypes.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Templates/Function.h"
 #include "Templates/ValueOrError.h"
 #include "Misc/ExpressionParserTypes.h"
 
@@ -21,6 +24,25 @@ namespace ExpressionParser
 	typedef TValueOrError< TArray<FExpressionToken>, FExpressionError > LexResultType;
 	typedef TValueOrError< TArray<FCompiledToken>, FExpressionError > CompileResultType;
 
+	/**
+	 * Working memory of an evaluation. Operands and intermediate results of ordinary expressions fit in its inline storage,
+	 * and one stack can be reused across evaluations so that it only allocates once it has grown to fit the largest expression.
+	 */
+	struct FEvaluationStack : FNoncopyable
+	{
+		/** Indices of the operands, into the compiled tokens or past them into the runtime generated tokens */
+		TArray<int32, TInlineAllocator<16>> OperandStack;
+
+		/** Results of the operators executed so far */
+		TArray<FExpressionToken, TInlineAllocator<8>> RuntimeGeneratedTokens;
+
+		void Reset()
+		{
+			OperandStack.Reset();
+			RuntimeGeneratedTokens.Reset();
+		}
+	};
+
 	/** Lex the specified string, using the specified grammar */
 	CORE_API LexResultType Lex(const TCHAR* InExpression, const FTokenDefinitions& TokenDefinitions);
 	
@@ -36,6 +58,9 @@ namespace ExpressionParser
 	/** Evaluate the specified pre-compiled tokens using an evaluation environment */
 	CORE_API FExpressionResult Evaluate(const TArray<FCompiledToken>& CompiledTokens, const IOperatorEvaluationEnvironment& InEnvironment);
 
+	/** Evaluate the specified pre-compiled tokens using an evaluation environment, and the given stack for working memory */
+	CORE_API FExpressionResult Evaluate(const TArray<FCompiledToken>& CompiledTokens, const IOperatorEvaluationEnvironment& InEnvironment, FEvaluationStack& Stack);
+
 	/** Templated versions of evaluation functions used when passing a specific jump table and context */
 	template<typename ContextType>
 	FExpressionResult Evaluate(const TCHAR* InExpression, const FTokenDefinitions& InTokenDefinitions, const FExpressionGrammar& InGrammar,	const TOperatorJumpTable<ContextType>& InJumpTable, const ContextType* InContext = nullptr)
@@ -50,4 +75,19 @@ namespace ExpressionParser
 		TOperatorEvaluationEnvironment<ContextType> Env(InJumpTable, InContext);
 		return Evaluate(CompiledTokens, Env);
 	}
+
+	/**
+	 * Evaluate the specified pre-compiled tokens once per context, as filters run over many items do, passing each result to the callback.
+	 * The expression is only compiled once by the caller, and all the evaluations share one stack.
+	 */
+	template<typename ContextType>
+	void EvaluateBatch(const TArray<FCompiledToken>& CompiledTokens, const TOperatorJumpTable<ContextType>& InJumpTable, TArrayView<const ContextType* const> InContexts, TFunctionRef<void(int32, FExpressionResult&&)> InResultCallback)
+	{
+		FEvaluationStack Stack;
+		for (int32 ContextIndex = 0; ContextIndex < InContexts.Num(); ++ContextIndex)
+		{
+			TOperatorEvaluationEnvironment<ContextType> Env(InJumpTable, InContexts[ContextIndex]);
+			InResultCallback(ContextIndex, Evaluate(CompiledTokens, Env, Stack));
+		}
+	}
 }
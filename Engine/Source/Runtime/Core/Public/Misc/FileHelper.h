@@ -6,8 +6,56 @@
 #include "Containers/UnrealString.h"
 #include "HAL/FileManager.h"
 #include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
 #include "Misc/EnumClassFlags.h"
 #include "Math/Color.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Read only view of the whole contents of a file, see FFileHelper::LoadFileToMappedView.
+ * The file is mapped into memory when the platform file can map it, and loaded into memory otherwise.
+ */
+class CORE_API FMappedFileView
+{
+public:
+	FMappedFileView();
+	~FMappedFileView();
+
+	FMappedFileView(const FMappedFileView&) = delete;
+	FMappedFileView& operator=(const FMappedFileView&) = delete;
+
+	/** Unmaps or frees the contents */
+	void Reset();
+
+	/** True if the contents are mapped from the file rather than loaded into memory */
+	bool IsMapped() const
+	{
+		return MappedRegion.IsValid();
+	}
+
+	const uint8* GetData() const
+	{
+		return Data;
+	}
+
+	int64 Num() const
+	{
+		return Size;
+	}
+
+private:
+	friend struct FFileHelper;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** The contents when the file couldn't be mapped */
+	TArray64<uint8> LoadedData;
+	const uint8* Data;
+	int64 Size;
+};
 
 /*-----------------------------------------------------------------------------
 	FFileHelper
@@ -65,6 +113,28 @@ struct CORE_API FFileHelper
 	*/
 	static bool LoadFileToArray( TArray64<uint8>& Result, const TCHAR* Filename, uint32 Flags = 0 );
 
+	/**
+	 * Map a whole file into memory as a read only view. Unlike LoadFileToArray, the pages of a mapped file are only read when
+	 * touched and are shared with the OS file cache. Files the platform file can't map, such as files in pak files, are loaded
+	 * into memory instead.
+	 *
+	 * @param Result    Receives the view of the file
+	 * @param Filename  The file to map
+	 * @param Flags     Flags to pass to IFileManager::CreateFileReader when the file can't be mapped
+	 */
+	static bool LoadFileToMappedView( FMappedFileView& Result, const TCHAR* Filename, uint32 Flags = 0 );
+
+	/**
+	 * Calls Visitor for each line of a UTF-8 or ANSI text file, without converting the file to TCHAR. Lines are split on \n, \r\n
+	 * and \r like LoadFileToStringArray, and don't include the line terminator. The file is mapped when it can be, and read in
+	 * blocks otherwise, so only the current line is ever held in memory. UTF-16 files are converted line by line.
+	 *
+	 * @param Filename  The file to read
+	 * @param Visitor   Called with each line in UTF-8, the view is only valid during the call
+	 * @param Flags     Flags to pass to IFileManager::CreateFileReader
+	 */
+	static bool LoadFileToUTF8LineVisitor( const TCHAR* Filename, TFunctionRef<void(FAnsiStringView Line)> Visitor, uint32 Flags = 0 );
+
 	/**
 	 * Load a text file to an FString. Supports all combination of ANSI/Unicode files and platforms.
 	 *
@@ -6,6 +6,7 @@
 #include "Misc/AssertionMacros.h"
 #include "Misc/Crc.h"
 #include "Containers/UnrealString.h"
+#include "Containers/StringView.h"
 #include "Serialization/StructuredArchive.h"
 #include "Serialization/MemoryLayout.h"
 #include "Hash/CityHash.h"
@@ -291,6 +292,14 @@ public:
 	 */
 	CORE_API FString ToString(EGuidFormats Format) const;
 
+	/**
+	 * Appends the string representation of this GUID in the specified format to a string builder, without allocating.
+	 *
+	 * @param Builder The string builder to append to.
+	 * @param Format The string format to use.
+	 */
+	CORE_API void AppendString(FStringBuilderBase& Builder, EGuidFormats Format = EGuidFormats::Digits) const;
+
 public:
 
 	/**
@@ -307,7 +316,10 @@ public:
 public:
 
 	/**
-	 * Returns a new GUID.
+	 * Returns a new random (version 4) GUID.
+	 *
+	 * GUIDs are drawn from a generator of the calling thread, keyed with FPlatformMisc::CreateGuid when the thread makes
+	 * its first one and again every so often, so that making one takes no system call nor lock.
 	 *
 	 * @return A new GUID.
 	 */
@@ -321,7 +333,17 @@ public:
 	 * @return true if the string was converted successfully, false otherwise.
 	 * @see ParseExact, ToString
 	 */
-	static CORE_API bool Parse(const FString& GuidString, FGuid& OutGuid);
+	static CORE_API bool Parse(const FStringView& GuidString, FGuid& OutGuid);
+
+	static bool Parse(const FString& GuidString, FGuid& OutGuid)
+	{
+		return Parse(FStringView(GuidString), OutGuid);
+	}
+
+	static bool Parse(const TCHAR* GuidString, FGuid& OutGuid)
+	{
+		return Parse(FStringView(GuidString), OutGuid);
+	}
 
 	/**
 	 * Converts a string with the specified format to a GUID.
@@ -332,7 +354,17 @@ public:
 	 * @return true if the string was converted successfully, false otherwise.
 	 * @see Parse, ToString
 	 */
-	static CORE_API bool ParseExact(const FString& GuidString, EGuidFormats Format, FGuid& OutGuid);
+	static CORE_API bool ParseExact(const FStringView& GuidString, EGuidFormats Format, FGuid& OutGuid);
+
+	static bool ParseExact(const FString& GuidString, EGuidFormats Format, FGuid& OutGuid)
+	{
+		return ParseExact(FStringView(GuidString), Format, OutGuid);
+	}
+
+	static bool ParseExact(const TCHAR* GuidString, EGuidFormats Format, FGuid& OutGuid)
+	{
+		return ParseExact(FStringView(GuidString), Format, OutGuid);
+	}
 
 //private:
 public:
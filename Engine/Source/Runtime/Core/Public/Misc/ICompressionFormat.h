@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Features/IModularFeatures.h"
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
@@ -11,6 +13,17 @@
 
 #define COMPRESSION_FORMAT_FEATURE_NAME "CompressionFormat"
 
+/**
+ * A dictionary loaded by a compression format, which compresses and uncompresses against it without rebuilding any
+ * per call state. Used from several threads at once.
+ */
+struct ICompressionDictionary
+{
+	virtual ~ICompressionDictionary() {}
+	virtual bool Compress(void* CompressedBuffer, int32& CompressedSize, const void* UncompressedBuffer, int32 UncompressedSize) = 0;
+	virtual bool Uncompress(void* UncompressedBuffer, int32 UncompressedSize, const void* CompressedBuffer, int32 CompressedSize) = 0;
+};
+
 struct ICompressionFormat : public IModularFeature, public IModuleInterface
 {
 	virtual FName GetCompressionFormatName() = 0;
@@ -19,4 +32,16 @@ struct ICompressionFormat : public IModularFeature, public IModuleInterface
 	virtual int32 GetCompressedBufferSize(int32 UncompressedSize, int32 CompressionData) = 0;
 	virtual uint32 GetVersion() = 0;
 	virtual FString GetDDCKeySuffix() = 0;
+
+	/** Formats supporting dictionaries train one from samples of the data they will compress, returning false otherwise */
+	virtual bool TrainDictionary(TArrayView<const TArrayView<const uint8>> Samples, int32 MaxDictionarySize, TArray<uint8>& OutDictionary)
+	{
+		return false;
+	}
+
+	/** Formats supporting dictionaries load one trained by TrainDictionary, returning null otherwise. The caller owns the result. */
+	virtual ICompressionDictionary* CreateDictionary(TArrayView<const uint8> Dictionary, int32 CompressionData)
+	{
+		return nullptr;
+	}
 };
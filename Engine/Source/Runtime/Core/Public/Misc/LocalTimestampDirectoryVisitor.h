@@ -36,8 +36,21 @@ public:
 
 	virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory);
 
+	/**
+	 * Gathers the files under a directory like iterating it with this visitor, but enumerates the tree on task graph workers
+	 * with IterateDirectoryStatRecursivelyParallel, which also saves getting the timestamp of each file separately.
+	 *
+	 * @param Directory - The directory to gather the files of.
+	 * @param ChangedSince - If set, only the files modified after it are added or updated, for refreshing the times of an earlier scan.
+	 *                       Files deleted since are not removed.
+	 */
+	void VisitParallel(const TCHAR* Directory, const FDateTime& ChangedSince = FDateTime::MinValue());
+
 private:
 
+	/** Whether to iterate the directory, given its standardized path. */
+	bool ShouldRecurse(const FString& RelativeDirectory) const;
+
 	// true if we want directories in this list. */
 	bool bCacheDirectories;
 
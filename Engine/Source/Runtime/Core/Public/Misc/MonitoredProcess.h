@@ -32,6 +32,8 @@ DECLARE_DELEGATE_OneParam(FOnMonitoredProcessOutput, FString)
 class CORE_API FMonitoredProcess
 	: public FRunnable, FSingleThreadRunnable
 {
+	friend class FMonitoredProcessSharedThread;
+
 public:
 
 	/**
@@ -108,6 +110,18 @@ public:
 		SleepInterval = InSleepInterval;
 	}
 
+	/**
+	 * Sets whether the process is monitored by one thread shared with the other processes that use it, instead of a thread of its own.
+	 * The shared thread doesn't use the sleep interval, it checks again right away while there is output and waits longer while there is none.
+	 * Delegates of processes on the shared thread hold up all of them, so they should not block. Must be called before Launch.
+	 *
+	 * @param bInUseSharedThread Whether to use the shared thread.
+	 */
+	void SetUseSharedThread( bool bInUseSharedThread )
+	{
+		bUseSharedThread = bInUseSharedThread;
+	}
+
 public:
 
 	/**
@@ -188,7 +202,8 @@ protected:
 	void ProcessOutput( const FString& Output );
 
 private:
-	void TickInternal();
+	/** Reads the output and checks whether the process completed or is canceled, returns whether there was output */
+	bool TickInternal();
 
 
 	// Whether the process is being canceled. */
@@ -239,6 +254,9 @@ private:
 	// Sleep interval to use
 	float SleepInterval;
 
+	// Whether the process is monitored by the shared thread
+	bool bUseSharedThread;
+
 	// Buffered output text which does not contain a newline
 	FString OutputBuffer;
 
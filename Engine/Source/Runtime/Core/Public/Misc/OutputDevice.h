@@ -115,6 +115,7 @@ namespace ELogTimes
 }
 
 class FName;
+class FDeferredLogMessage;
 
 // An output device.
 class CORE_API FOutputDevice
@@ -139,6 +140,12 @@ public:
 		Serialize( V, Verbosity, Category );
 	}
 
+	/**
+	 * Serializes a message logged with UE_LOG_DEFERRED. The default implementation formats the message and passes
+	 * the text to Serialize, devices that can store or filter messages without their text can override it.
+	 */
+	virtual void SerializeDeferred(const FDeferredLogMessage& Message);
+
 	virtual void Flush()
 	{
 	}
@@ -49,6 +49,12 @@ class CORE_API FAsyncWriter : public FRunnable, public FArchive
 	/** [WRITER THREAD] Last time the archive was flushed. used in threaded situations to flush the underlying archive at a certain maximum rate. */
 	double LastArchiveFlushTime;
 
+	/** Minimum time between two periodic flushes of the archive, the log.flushInterval console variable is used if it is longer */
+	double MinArchiveFlushIntervalSec;
+
+	/** [WRITER THREAD] Time between two periodic flushes of the archive */
+	double GetArchiveFlushIntervalSec() const;
+
 	/** [WRITER THREAD] Flushes the archive and reset the flush timer. */
 	void FlushArchiveAndResetTimer();
 
@@ -60,7 +66,7 @@ class CORE_API FAsyncWriter : public FRunnable, public FArchive
 
 public:
 
-	FAsyncWriter(FArchive& InAr);
+	FAsyncWriter(FArchive& InAr, double InMinArchiveFlushIntervalSec = 0.0);
 
 	virtual ~FAsyncWriter();
 
@@ -83,6 +89,39 @@ enum class EByteOrderMark : int8
 	Unspecified,
 };
 
+/**
+* Options controlling how FOutputDeviceFile writes to disk, the defaults write every line as soon as the async writer gets it.
+*
+* Compressed logs are a sequence of independent frames, each made of an FOutputDeviceFile::FCompressedFrameHeader followed
+* by a block compressed with LZ4. Frames store the offset of their block in the uncompressed log so a reader can seek to a
+* given position by walking the headers and only decompress the block it needs.
+*/
+struct CORE_API FOutputDeviceFileWriteOptions
+{
+	/** Size of the blocks output is batched into before being written, 0 writes output as it comes. Uncompressed blocks are aligned to this size in the file. */
+	int32 BlockSize = 0;
+	/** If true, blocks are compressed with LZ4 and ".lz4" is appended to the filename */
+	bool bCompress = false;
+	/** Size in bytes after which the log file is moved to a backup and a new one is started, 0 to disable */
+	int64 RotateSize = 0;
+	/** Age in seconds after which the log file is moved to a backup and a new one is started, 0 to disable */
+	double RotateInterval = 0.0;
+	/** Partially filled blocks are written when the log is flushed explicitly, or periodically at this interval in seconds if it is longer than log.flushInterval */
+	double BlockFlushInterval = 5.0;
+
+	/** Block size used when compression is enabled without an explicit block size */
+	static constexpr int32 DefaultBlockSize = 256 * 1024;
+
+	/** Returns true if output needs to go through the batching writer rather than straight to the file */
+	bool IsBatched() const
+	{
+		return BlockSize > 0 || bCompress || RotateSize > 0 || RotateInterval > 0.0;
+	}
+
+	/** Reads -LogBlockSize=<KB>, -LogCompress, -LogRotateSizeMB=<MB> and -LogRotateMinutes=<Minutes> from the command line */
+	static FOutputDeviceFileWriteOptions FromCommandLine();
+};
+
 /**
 * File output device (Note: Only works if ALLOW_LOG_FILE && !NO_LOGGING is true, otherwise Serialize does nothing).
 */
@@ -134,6 +173,39 @@ public:
 	/** Checks if the filename represents a backup copy of a log file */
 	static bool IsBackupCopy(const TCHAR* Filename);
 
+	/**
+	* Sets how the log file is written, has to be called before the file is opened by the first log line to take effect.
+	* Rotation and compression happen on the async writer thread.
+	*/
+	void SetWriteOptions(const FOutputDeviceFileWriteOptions& InWriteOptions)
+	{
+		WriteOptions = InWriteOptions;
+	}
+
+	/** Header preceding each compressed block of a log written with FOutputDeviceFileWriteOptions::bCompress */
+	struct FCompressedFrameHeader
+	{
+		enum { ExpectedMagic = 0x5A4C4755 }; // "UGLZ"
+
+		uint32 Magic;
+		/** Size of the compressed block following the header */
+		uint32 CompressedSize;
+		/** Size of the block once decompressed */
+		uint32 UncompressedSize;
+		uint32 Padding;
+		/** Offset of the block in the uncompressed log file */
+		uint64 UncompressedOffset;
+	};
+
+	/**
+	* Decompresses the content of a log file written with FOutputDeviceFileWriteOptions::bCompress.
+	*
+	* @param CompressedData		Content of the compressed log file
+	* @param OutData			Receives the uncompressed log
+	* @return false if the data is corrupted or truncated, OutData still contains the frames read until then
+	*/
+	static bool DecompressLog(const TArray<uint8>& CompressedData, TArray<uint8>& OutData);
+
 	/** Add a category name to our inclusion filter. As soon as one inclusion exists, all others will be ignored */
 	void IncludeCategory(const class FName& InCategoryName);
 
@@ -159,6 +231,9 @@ private:
 	/** If true, existing files will not be backed up */
 	bool		bDisableBackup;
 
+	/** How the file is written */
+	FOutputDeviceFileWriteOptions WriteOptions;
+
 	void WriteRaw(const TCHAR* C);
 
 	/** Creates the async writer and its archive. Returns true if successful.  */
@@ -13,6 +13,7 @@ FOutputDeviceRedirector.
 -----------------------------------------------------------------------------*/
 
 class FLogAllocator;
+class FThreadLogRing;
 
 /** The type of lines buffered by secondary threads. */
 struct CORE_API FBufferedLine
@@ -80,9 +81,19 @@ private:
 
 	FLogAllocator* BufferedLinesAllocator;
 
+	/** Intrusive list of the rings secondary threads log to without taking a lock. Rings are only ever added. */
+	FThreadLogRing* volatile ThreadLogRings;
+
+	/** Whether the rings are being drained, records logged while output devices are called are drained by the next flush. */
+	bool bDrainingThreadLogRings;
+
+	/** Non zero while the output device arrays are being modified, readers then fall back to OutputDevicesMutex. */
+	volatile int32 OutputDevicesWriting;
+
 	/** Objects used for synchronization via a scoped lock */
 	FCriticalSection	SynchronizationObject;
 	FCriticalSection	BufferSynchronizationObject;
+	FCriticalSection	ThreadLogRingsMutex;
 	FCriticalSection	OutputDevicesMutex;
 	FThreadSafeCounter	OutputDevicesLockCounter;
 
@@ -100,6 +111,25 @@ private:
 	/** Unlocks OutputDevices arrays */
 	void UnlockOutputDevices();
 
+	/** Waits until no thread has the OutputDevices arrays locked and calls Modify while holding OutputDevicesMutex. */
+	template<typename FuncType>
+	void ModifyOutputDevices(FuncType Modify);
+
+	/**
+	* Appends a line to the calling thread's ring without taking a lock.
+	* @return false if the ring is full or the line doesn't fit, the line then has to be buffered in BufferedLines.
+	*/
+	bool TryBufferLineInThreadRing(const TCHAR* Data, ELogVerbosity::Type Verbosity, const FLazyName& Category, double Time);
+
+	/** Same as TryBufferLineInThreadRing for a message that hasn't been formatted yet. */
+	bool TryBufferMessageInThreadRing(const FDeferredLogMessage& Message, double Time);
+
+	/** Returns the calling thread's ring, or null if it belongs to a different redirector. */
+	FThreadLogRing* GetThreadLogRing();
+
+	/** Whether any of the thread rings has records that haven't been drained yet. */
+	bool HasThreadLogRecords() const;
+
 	friend struct FOutputDevicesLock;
 
 	/** Helper struct for scope locking OutputDevices arrays */
@@ -196,6 +226,14 @@ public:
 	* @param	Event	Event name used for suppression purposes
 	*/
 	virtual void Serialize(const TCHAR* Data, ELogVerbosity::Type Verbosity, const class FName& Category) override;
+
+	/**
+	* Passes a message that hasn't been formatted yet to all current output devices. Messages logged
+	* by secondary threads are buffered as they are and formatted by the master thread.
+	*
+	* @param	Message	Message to log
+	*/
+	virtual void SerializeDeferred(const FDeferredLogMessage& Message) override;
 	
 	/** Same as Serialize() but FName creation. Only needed to support 
 	*
@@ -4,6 +4,8 @@
 
 #include "CoreTypes.h"
 #include "Containers/StringFwd.h"
+#include "Containers/StringView.h"
+#include "Templates/UnrealTemplate.h"
 
 class CORE_API FPathViews
 {
@@ -133,4 +135,62 @@ public:
 	 * @param Suffix A possibly-empty suffix that does not start with a separator.
 	 */
 	static void Append(FStringBuilderBase& Builder, const FStringView& Suffix);
+
+	/** Appends each suffix to the path in the builder in turn, ensuring that there is a separator between them. */
+	template <typename... SuffixTypes>
+	static void Append(FStringBuilderBase& Builder, const FStringView& Suffix, const FStringView& NextSuffix, SuffixTypes&&... Suffixes)
+	{
+		Append(Builder, Suffix);
+		Append(Builder, NextSuffix, Forward<SuffixTypes>(Suffixes)...);
+	}
+
+	/**
+	 * The functions below match their FPaths counterparts, but read views and write their result to a string builder
+	 * provided by the caller, which avoids any allocation when it has an inline buffer large enough for the result.
+	 */
+
+	/** Returns whether the path is relative, the same as FPaths::IsRelative. */
+	static bool IsRelative(const FStringView& InPath);
+
+	/**
+	 * Appends the path to the builder with its extension replaced, or unchanged if it has no extension.
+	 *
+	 * Examples:
+	 * ("A/B.C", "D")  -> "A/B.D"
+	 * ("A/B.C", ".D") -> "A/B.D"
+	 * ("A/B.C", "")   -> "A/B"
+	 * ("A.B/C", "D")  -> "A.B/C"
+	 */
+	static void ChangeExtension(FStringBuilderBase& Builder, const FStringView& InPath, const FStringView& InNewExtension);
+
+	/** Appends the path to the builder with its extension replaced, or added if it has no extension. */
+	static void SetExtension(FStringBuilderBase& Builder, const FStringView& InPath, const FStringView& InNewExtension);
+
+	/** Converts the path in the builder to use forward slashes, the same as FPaths::NormalizeFilename. */
+	static void NormalizeFilename(FStringBuilderBase& InOutPath);
+
+	/** Normalizes the path in the builder and removes a trailing slash, the same as FPaths::NormalizeDirectoryName. */
+	static void NormalizeDirectoryName(FStringBuilderBase& InOutPath);
+
+	/**
+	 * Removes "/.." and the directory before it, then removes "./", from the path in the builder, the same as
+	 * FPaths::CollapseRelativeDirectories.
+	 *
+	 * @return false if the path would go above its root, in which case it is left partially collapsed.
+	 */
+	static bool CollapseRelativeDirectories(FStringBuilderBase& InOutPath);
+
+	/** Replaces each run of slashes in the path in the builder with a single slash. */
+	static void RemoveDuplicateSlashes(FStringBuilderBase& InOutPath);
+
+	/**
+	 * Replaces the contents of the builder with the absolute, normalized and collapsed form of the path, the same as
+	 * FPaths::ConvertRelativePathToFull.
+	 *
+	 * @param OutPath  Receives the full path.
+	 * @param BasePath The directory a relative InPath is relative to, the base directory of the process if not given.
+	 * @param InPath   The path to convert, which must not alias the builder.
+	 */
+	static void ConvertRelativePathToFull(FStringBuilderBase& OutPath, const FStringView& InPath);
+	static void ConvertRelativePathToFull(FStringBuilderBase& OutPath, const FStringView& BasePath, const FStringView& InPath);
 };
@@ -583,6 +583,24 @@ public:
 		return Out;
 	}
 
+	/**
+	 * Same as Combine, into a string with inline storage so short paths don't allocate.
+	 *
+	 * @param OutPath Receives the combined path, requires Containers/InlineString.h.
+	 */
+	template <int32 NumInlineChars, typename... PathTypes>
+	FORCEINLINE static void CombineTo(TInlineString<NumInlineChars>& OutPath, PathTypes&&... InPaths)
+	{
+		const TCHAR* Paths[] = { GetTCharPtr(Forward<PathTypes>(InPaths))... };
+
+		OutPath.Reset();
+		OutPath += Paths[0];
+		for (int32 Index = 1; Index < int32(UE_ARRAY_COUNT(Paths)); ++Index)
+		{
+			OutPath /= Paths[Index];
+		}
+	}
+
 	/**
 	 * Frees any memory retained by FPaths.
 	 */
@@ -605,6 +623,12 @@ private:
 		return *Str;
 	}
 
+	template <int32 NumInlineChars>
+	FORCEINLINE static const TCHAR* GetTCharPtr(const TInlineString<NumInlineChars>& Str)
+	{
+		return *Str;
+	}
+
 	/** Returns, if any, the value of the -userdir command line argument. This can be used to sandbox artifacts to a desired location */
 	static const FString& CustomUserDirArgument();
 
@@ -7,6 +7,34 @@
 
 class IQueuedWork;
 
+/** Order in which a pool starts its queued work. Work of the same priority starts in the order it was added. */
+enum class EQueuedWorkPriority : uint8
+{
+	Highest,
+	High,
+	Normal,
+	Low,
+	Lowest,
+
+	Count
+};
+
+/** Limits for a pool whose number of threads follows its load, see FQueuedThreadPool::AllocateElastic */
+struct FElasticThreadPoolSettings
+{
+	/** The pool never retires threads below this many */
+	uint32 MinThreads = 1;
+
+	/** The pool never grows beyond this many threads */
+	uint32 MaxThreads = 16;
+
+	/** A thread is added when no thread took queued work for this long, and at most this often */
+	float GrowAfterWaitSeconds = 0.01f;
+
+	/** A thread above MinThreads retires after it was idle for this long */
+	float RetireAfterIdleSeconds = 10.0f;
+};
+
 /**
  * Interface for queued thread pools.
  *
@@ -35,9 +63,10 @@ public:
 	 * it queues the work for later. Otherwise it is immediately dispatched.
 	 *
 	 * @param InQueuedWork The work that needs to be done asynchronously
+	 * @param InQueuedWorkPriority Work of a higher priority is started before any queued work of a lower priority
 	 * @see RetractQueuedWork
 	 */
-	virtual void AddQueuedWork( IQueuedWork* InQueuedWork ) = 0;
+	virtual void AddQueuedWork( IQueuedWork* InQueuedWork, EQueuedWorkPriority InQueuedWorkPriority = EQueuedWorkPriority::Normal ) = 0;
 
 	/**
 	 * Attempts to retract a previously queued task.
@@ -67,6 +96,16 @@ public:
 	 */
 	static FQueuedThreadPool* Allocate();
 
+	/**
+	 * Allocates a thread pool that adds threads while its work waits or all of its threads are blocked,
+	 * and retires threads that stay idle. The thread count passed to Create is clamped to the settings.
+	 *
+	 * @param Settings The limits of the pool
+	 * @return A new thread pool.
+	 * @see FQueuedThreadPoolBlockingScope
+	 */
+	static FQueuedThreadPool* AllocateElastic(const FElasticThreadPoolSettings& Settings);
+
 	/**
 	 *	Stack size for threads created for the thread pool. 
 	 *	Can be overridden by other projects.
@@ -76,6 +115,24 @@ public:
 };
 
 
+/**
+ * Tells the pool of the current thread that the thread is blocked, e.g. on I/O, while this is in scope.
+ * An elastic pool adds a thread when all of its threads are blocked and work is waiting.
+ * Does nothing on threads that are not pool threads.
+ */
+class CORE_API FQueuedThreadPoolBlockingScope
+{
+public:
+	UE_NONCOPYABLE(FQueuedThreadPoolBlockingScope);
+
+	FQueuedThreadPoolBlockingScope();
+	~FQueuedThreadPoolBlockingScope();
+
+private:
+	class FQueuedThreadPoolBase* Pool;
+};
+
+
 /**
  *  Global thread pool for shared async operations
  */
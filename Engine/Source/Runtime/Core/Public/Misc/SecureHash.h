@@ -5,6 +5,7 @@
 #include "CoreTypes.h"
 #include "HAL/UnrealMemory.h"
 #include "Containers/UnrealString.h"
+#include "Containers/ArrayView.h"
 #include "Containers/Map.h"
 #include "Containers/StringConv.h"
 #include "Containers/StringFwd.h"
@@ -159,6 +160,15 @@ struct FMD5Hash
 	CORE_API static FMD5Hash HashFile(const TCHAR* InFilename, TArray<uint8>* Buffer = nullptr);
 	CORE_API static FMD5Hash HashFileFromArchive(FArchive* Ar, TArray<uint8>* ScratchPad = nullptr);
 
+	/**
+	 * Hash many files at once, spread over the task graph. Each file is read in parts with IAsyncReadFileHandle,
+	 * the next part being read while the previous one is hashed.
+	 *
+	 * @param Filenames The files to hash
+	 * @param OutHashes Receives the hash of each file, which is left invalid if the file could not be read. Must be as long as Filenames.
+	 */
+	CORE_API static void HashFiles(TArrayView<const FString> Filenames, TArrayView<FMD5Hash> OutHashes);
+
 	const uint8* GetBytes() const { return Bytes; }
 	const int32 GetSize() const { return sizeof(Bytes); }
 
@@ -291,6 +301,37 @@ public:
 	 */
 	static void HashBuffer(const void* Data, uint64 DataSize, uint8* OutHash);
 
+	/**
+	 * Calculate the hashes of many independent buffers at once. Buffers of similar sizes are hashed together
+	 * in the lanes of vector registers unless the CPU has SHA instructions, and the work is spread over the task graph.
+	 *
+	 * @param Buffers The buffers to hash
+	 * @param OutHashes Receives the hash of each buffer, must be as long as Buffers
+	 */
+	static void HashBuffers(TArrayView<const TArrayView<const uint8>> Buffers, TArrayView<FSHAHash> OutHashes);
+
+	/**
+	 * Hash a file, reading it in parts with IAsyncReadFileHandle so the next part is read while the previous one is hashed.
+	 *
+	 * @param Filename The file to hash
+	 * @param OutHash Receives the hash of the file
+	 * @return true if the file could be read
+	 */
+	static bool HashFile(const TCHAR* Filename, FSHAHash& OutHash);
+
+	/**
+	 * Hash many files at once, spread over the task graph, each of them read as HashFile does.
+	 *
+	 * @param Filenames The files to hash
+	 * @param OutHashes Receives the hash of each file, or zeroes if the file could not be read. Must be as long as Filenames.
+	 * @param OutFailedIndices If not null, receives the indices of the files that could not be read
+	 * @return true if all the files could be read
+	 */
+	static bool HashFiles(TArrayView<const FString> Filenames, TArrayView<FSHAHash> OutHashes, TArray<int32>* OutFailedIndices = nullptr);
+
+	/** @return Whether Update uses the SHA instructions of the CPU */
+	static bool IsHardwareAccelerated();
+
 	/**
 	 * Generate the HMAC (Hash-based Message Authentication Code) for a block of data.
 	 * https://en.wikipedia.org/wiki/Hash-based_message_authentication_code
@@ -329,6 +370,9 @@ private:
 	// Private SHA-1 transformation
 	void Transform(uint32 *state, const uint8 *buffer);
 
+	// Transforms consecutive 64 byte blocks, with the SHA instructions when the CPU has them
+	void TransformBlocks(uint32 *state, const uint8 *blocks, uint64 numBlocks);
+
 	// Member variables
 	uint8 m_workspace[64];
 	SHA1_WORKSPACE_BLOCK *m_block; // SHA1 pointer to the byte array above
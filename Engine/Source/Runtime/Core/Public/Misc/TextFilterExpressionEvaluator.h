@@ -3,6 +3,8 @@
 
 #include "CoreTypes.h"
 #include "Containers/UnrealString.h"
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
 #include "Containers/Map.h"
 #include "Delegates/Delegate.h"
 #include "Misc/Optional.h"
@@ -191,6 +193,16 @@ public:
 	/** Test our compiled filter using the given context */
 	bool TestTextFilter(const ITextFilterExpressionContext& InContext) const;
 
+	/** Test our compiled filter against each of the given contexts, setting the bit of each context that passes */
+	void TestTextFilters(TArrayView<const ITextFilterExpressionContext* const> InContexts, TBitArray<>& OutResults) const;
+
+	/**
+	 * Test our compiled filter against each string of the given column, setting the bit of each string that passes.
+	 * Large columns are tested in chunks across the task graph, unless the filter uses function tokens as their callbacks needn't be thread-safe.
+	 * The strings only match basic string terms, key->value terms need a context for the item they test.
+	 */
+	void TestTextFilterColumn(const FTextFilterStringColumn& InColumn, TBitArray<>& OutResults) const;
+
 	/** Helper function to add callbacks for function tokens */
 	void AddFunctionTokenCallback(FString InFunctionName, FTokenFunctionHandler InCallback);
 
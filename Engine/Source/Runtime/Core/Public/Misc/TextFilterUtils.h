@@ -3,6 +3,8 @@
 
 #include "CoreTypes.h"
 #include "Containers/UnrealString.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
 #include "UObject/NameTypes.h"
 
 /** Defines the comparison operators that can be used for a complex (key->value) comparison */
@@ -97,6 +99,45 @@ private:
 	TArray<ANSICHAR> InternalStringAnsi;
 };
 
+/**
+ * Uppercase strings of a list of items, such as the names of the assets of a browser, laid out contiguously.
+ * The column is built once per dataset so that testing filters against it doesn't convert the strings of every item each time the filter changes.
+ */
+class CORE_API FTextFilterStringColumn
+{
+public:
+	FTextFilterStringColumn() = default;
+	explicit FTextFilterStringColumn(TArrayView<const FString> InStrings);
+
+	/** Reserve space for the given number of strings, and the total number of their characters */
+	void Reserve(const int32 InNumStrings, const int32 InNumChars);
+
+	/** Add a string to the end of the column, returning its index */
+	int32 Add(const FStringView& InString);
+
+	void Empty();
+
+	FORCEINLINE int32 Num() const
+	{
+		return StringStarts.Num();
+	}
+
+	/** Get the uppercase string at the given index */
+	FORCEINLINE FStringView GetString(const int32 InIndex) const
+	{
+		const int32 Start = StringStarts[InIndex];
+		const int32 End = InIndex + 1 < StringStarts.Num() ? StringStarts[InIndex + 1] : Chars.Num();
+		return FStringView(Chars.GetData() + Start, End - Start);
+	}
+
+	/** Compare the string at the given index against the given filter string, using the text comparison mode provided */
+	bool CompareText(const int32 InIndex, const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const;
+
+private:
+	TArray<TCHAR> Chars;
+	TArray<int32> StringStarts;
+};
+
 namespace TextFilterUtils
 {
 	template <typename CharType>
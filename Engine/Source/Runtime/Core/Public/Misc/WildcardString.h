@@ -82,6 +82,7 @@ public:
 
 	/**
 	 * Non-recursive wild card string matching algorithm.
+	 * Use FCompiledWildcard when matching the same pattern against many strings.
 	 *
 	 * @param Pattern The pattern to match.
 	 * @param Input The input string to check.
@@ -8,6 +8,7 @@
 #include "Containers/Array.h"
 #include "Containers/UnrealString.h"
 #include "Containers/Map.h"
+#include "Containers/ArrayView.h"
 #include "UObject/NameTypes.h"
 #include "Templates/SharedPointer.h"
 #include "Templates/UniquePtr.h"
@@ -200,6 +201,17 @@ public:
 	 */
 	IModuleInterface* LoadModuleWithFailureReason( const FName InModuleName, EModuleLoadResult& OutFailureReason );
 
+	/**
+	 * Reads the files of the specified modules on worker threads, so that loading them afterwards doesn't wait on the disk.
+	 *
+	 * Modules that are already loaded or statically linked are skipped. This doesn't load any module, they still have to be
+	 * loaded one by one on the game thread as their static initialization and StartupModule aren't safe to run concurrently.
+	 *
+	 * @param InModuleNames The base names of the module files about to be loaded.
+	 * @see LoadModule
+	 */
+	void PrefetchModules( TArrayView<const FName> InModuleNames );
+
 	/**
 	 * Queries information about a specific module name.
 	 *
@@ -65,13 +65,22 @@ private:
 	void Stop();
 
 	const TCHAR* SwitchTest(int32 Index);
-	
-	
+
+	/** Logs the per-arm percentiles and a Welch's t-test of the samples in the history */
+	void LogStatistics() const;
+
+	/** Writes the history as CSV, one row per sample, or the statistics and histograms as JSON for a .json file */
+	bool WriteReport(const FString& Filename) const;
+
+	/** Gets the frame times in the history of each arm in milliseconds, oldest first */
+	void GetArmMilliseconds(TArray<double> (&OutMilliseconds)[2]) const;
+
 
 	FRandomStream Stream;
 	bool bABTestActive;
 	bool bABScopeTestActive; //whether we are doing abtesting on the scope macro rather than a CVAR.	
 	bool bFrameLog;
+	bool bRandomizeArms; //whether the arm for each trial is picked at random rather than alternating.
 	FString ABTestCmds[2];
 	int32 ABTestNumSamples;
 	int32 RemainingCoolDown;
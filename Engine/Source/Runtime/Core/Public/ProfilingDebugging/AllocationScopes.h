@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/MallocCountingProxy.h"
+#include "HAL/PreprocessorHelpers.h"
+#include "UObject/NameTypes.h"
+
+#if !defined(ALLOCATIONSCOPES_ENABLED)
+#define ALLOCATIONSCOPES_ENABLED (!UE_BUILD_SHIPPING)
+#endif
+
+#if ALLOCATIONSCOPES_ENABLED
+
+/**
+ * Counts the allocations, frees and allocated bytes of named scopes, finer grained than LLM tags. A scope counts what its
+ * thread does until it ends, including in nested scopes, and a scope already on the stack of the thread is not counted again
+ * when re-entered. Totals are reported once a frame as CSV stats of the AllocationScopes category and as trace counters,
+ * <Name>_Allocs, <Name>_Frees and <Name>_Bytes.
+ *
+ * Counting uses FMallocCountingProxy and is off until started with -allocationscopes or AllocationScopes.Enable 1.
+ */
+struct FAllocationScopes
+{
+	static bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	CORE_API static void SetEnabled(bool bInEnabled);
+
+	/** Reports and resets the totals of every scope, done at the end of every frame while enabled */
+	CORE_API static void ReportFrame();
+
+private:
+	CORE_API static bool bEnabled;
+};
+
+/** A named scope in the code, kept in a static that sums what all its instances counted this frame */
+struct FAllocationScopeSite
+{
+	CORE_API explicit FAllocationScopeSite(const TCHAR* InName);
+
+	const TCHAR* Name;
+	volatile int64 NumAllocations = 0;
+	volatile int64 NumFrees = 0;
+	volatile int64 AllocatedBytes = 0;
+
+	/** All sites, for the reports */
+	FAllocationScopeSite* Next = nullptr;
+	/** <Name>_Allocs, <Name>_Frees and <Name>_Bytes */
+	FName StatNames[3];
+	uint16 TraceCounterIds[3] = { 0, 0, 0 };
+};
+
+class FAllocationScope
+{
+public:
+	explicit FAllocationScope(FAllocationScopeSite& InSite)
+	{
+		if (FAllocationScopes::IsEnabled())
+		{
+			Begin(InSite);
+		}
+	}
+
+	~FAllocationScope()
+	{
+		if (Site)
+		{
+			End();
+		}
+	}
+
+private:
+	CORE_API void Begin(FAllocationScopeSite& InSite);
+	CORE_API void End();
+
+	FAllocationScopeSite* Site = nullptr;
+	/** The scope this one is nested in on the thread */
+	FAllocationScope* Parent = nullptr;
+	FMallocThreadCounts StartCounts;
+};
+
+#define ALLOCATION_SCOPE(Name) \
+	static FAllocationScopeSite PREPROCESSOR_JOIN(AllocationScopeSite, __LINE__)(TEXT(#Name)); \
+	FAllocationScope PREPROCESSOR_JOIN(AllocationScope, __LINE__)(PREPROCESSOR_JOIN(AllocationScopeSite, __LINE__));
+
+#else
+
+#define ALLOCATION_SCOPE(Name)
+
+#endif
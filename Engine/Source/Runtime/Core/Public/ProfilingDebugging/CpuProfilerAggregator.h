@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#if CPUPROFILERTRACE_ENABLED
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+
+/**
+ * Aggregates the CPU profiler scopes in process, so a profile can be looked at without capturing a trace, e.g. on
+ * headless servers. While running, each thread sums the time spent in every scope path into one second slots, and
+ * reports merge the slots of the last CpuProfiler.Aggregate.WindowSeconds. Works whether the CPU trace channel is on
+ * or not. Started with -cpuprofileraggregate or "CpuProfiler.Aggregate.Start", and printed with "CpuProfiler.Aggregate.Print"
+ * or written as JSON with "CpuProfiler.Aggregate.DumpJson".
+ */
+struct FCpuProfilerAggregator
+{
+	/** Time spent in a scope path of a thread, or in a scope over all paths and threads for flat reports */
+	struct FScopeTimes
+	{
+		/** Thread name, empty for flat reports */
+		FString ThreadName;
+		/** Scope names from the root of the thread separated by '/', or the scope name for flat reports */
+		FString Path;
+		uint64 Count = 0;
+		/** Cycles spent in the scope and its children. In flat reports recursive scopes are counted at every level. */
+		uint64 InclusiveCycles = 0;
+		/** Cycles spent in the scope itself */
+		uint64 ExclusiveCycles = 0;
+	};
+
+	CORE_API static void Start();
+	CORE_API static void Stop();
+
+	static bool IsRunning()
+	{
+		return GCpuProfilerAggregating;
+	}
+
+	/**
+	 * @param bFlat; whether to merge every path of a scope on every thread into one entry
+	 * @param OutScopes; what happened in the window, by exclusive time, most first
+	 * @param OutWindowSeconds; how long the window was, shorter than configured while it fills
+	 */
+	CORE_API static void GetScopeTimes(bool bFlat, TArray<FScopeTimes>& OutScopes, double& OutWindowSeconds);
+
+	/** @return {"windowSeconds":..,"scopes":[{"thread":..,"path":..,"count":..,"inclusiveMs":..,"exclusiveMs":..}, ..]}, for tools and status endpoints */
+	CORE_API static FString ToJsonString(bool bFlat);
+
+	/** Called by FCpuProfilerTrace when a scope type is created */
+	static void RegisterScopeName(uint32 SpecId, const ANSICHAR* Name);
+	static void RegisterScopeName(uint32 SpecId, const TCHAR* Name);
+
+	/** Called by FCpuProfilerTrace for scopes while running */
+	static void BeginScope(uint32 SpecId, uint64 Cycle);
+	static void EndScope(uint64 Cycle);
+};
+
+#endif
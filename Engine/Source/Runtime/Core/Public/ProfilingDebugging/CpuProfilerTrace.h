@@ -19,7 +19,10 @@
 
 // @note Cannot use the declare macros in this header since including
 // Trace.h will result in a circular dependency.
-CORE_API extern Trace::FChannel CpuChannel;
+CORE_API extern TRACE_PRIVATE_CHANNEL_TYPE(CpuChannel) CpuChannel;
+
+/** Whether FCpuProfilerAggregator is running, scopes are entered for it even when their channel is off */
+CORE_API extern bool GCpuProfilerAggregating;
 
 struct FCpuProfilerTrace
 {
@@ -34,8 +37,9 @@ struct FCpuProfilerTrace
 
 	struct FEventScope
 	{
-		FEventScope(uint32 InSpecId, const Trace::FChannel& Channel)
-			: bEnabled(Channel | CpuChannel)
+		template <typename ChannelType>
+		FEventScope(uint32 InSpecId, const ChannelType& Channel)
+			: bEnabled((Channel | CpuChannel) || GCpuProfilerAggregating)
 		{
 			if (bEnabled)
 			{
@@ -56,8 +60,9 @@ struct FCpuProfilerTrace
 
 	struct FDynamicEventScope
 	{
-		FDynamicEventScope(const ANSICHAR* InEventName, const Trace::FChannel& Channel)
-			: bEnabled(Channel | CpuChannel)
+		template <typename ChannelType>
+		FDynamicEventScope(const ANSICHAR* InEventName, const ChannelType& Channel)
+			: bEnabled((Channel | CpuChannel) || GCpuProfilerAggregating)
 		{
 			if (bEnabled)
 			{
@@ -65,8 +70,9 @@ struct FCpuProfilerTrace
 			}
 		}
 
-		FDynamicEventScope(const TCHAR* InEventName, const Trace::FChannel& Channel)
-			: bEnabled(Channel | CpuChannel)
+		template <typename ChannelType>
+		FDynamicEventScope(const TCHAR* InEventName, const ChannelType& Channel)
+			: bEnabled((Channel | CpuChannel) || GCpuProfilerAggregating)
 		{
 			if (bEnabled)
 			{
@@ -94,7 +100,7 @@ struct FCpuProfilerTrace
 
 #define TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(NameStr, Channel) \
 	static uint32 PREPROCESSOR_JOIN(__CpuProfilerEventSpecId, __LINE__); \
-	if (bool(Channel) && PREPROCESSOR_JOIN(__CpuProfilerEventSpecId, __LINE__) == 0) { \
+	if ((bool(Channel) || GCpuProfilerAggregating) && PREPROCESSOR_JOIN(__CpuProfilerEventSpecId, __LINE__) == 0) { \
 		PREPROCESSOR_JOIN(__CpuProfilerEventSpecId, __LINE__) = FCpuProfilerTrace::OutputEventType(NameStr); \
 	} \
 	FCpuProfilerTrace::FEventScope PREPROCESSOR_JOIN(__CpuProfilerEventScope, __LINE__)(PREPROCESSOR_JOIN(__CpuProfilerEventSpecId, __LINE__), Channel);
@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Trace/Config.h"
+
+#if !defined(CPUSAMPLER_ENABLED)
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING && (PLATFORM_WINDOWS || PLATFORM_UNIX || PLATFORM_MAC)
+#define CPUSAMPLER_ENABLED 1
+#else
+#define CPUSAMPLER_ENABLED 0
+#endif
+#endif
+
+#if CPUSAMPLER_ENABLED
+
+/**
+ * Statistical CPU profiler for code that has no scopes. A thread of its own captures the call stacks of the game
+ * thread and the task graph, render and RHI threads CpuSampler.RateHz times a second, with
+ * FPlatformStackWalk::CaptureThreadStackBackTrace: SuspendThread and GetThreadContext on Windows, a signal on Unix.
+ * Samples are traced as raw program counters on the CpuSampler channel, along with the loaded modules so that they
+ * can be symbolicated later. The innermost frames are also counted in process, and "CpuSampler.PrintHotspots"
+ * symbolicates the most sampled ones.
+ *
+ * Started with -cpusampler[=<Hz>] or "CpuSampler.Start [Hz]".
+ */
+struct FCpuSampler
+{
+	CORE_API static void Start(float RateHz = 0.0f);
+	CORE_API static void Stop();
+	CORE_API static bool IsRunning();
+
+	/** Logs the NumHotspots functions the most samples were taken in, symbolicated now */
+	CORE_API static void PrintHotspots(int32 NumHotspots);
+};
+
+#endif
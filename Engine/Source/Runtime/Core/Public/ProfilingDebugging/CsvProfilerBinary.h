@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/**
+*
+* Binary columnar alternative to the text CSV files written by the CSV profiler.
+*
+* The file is a sequence of chunks, each holding a range of rows. A chunk starts with the definitions of the columns added
+* since the previous chunk and a table of its blocks, followed by the blocks themselves, each compressed on its own:
+*  - the row block lists the frame numbers of the chunk's rows,
+*  - the event block lists the events of these rows,
+*  - a column block per stat with values in the chunk lists the frames it has values for and the values.
+* Frame numbers are delta encoded. Zero values are not stored as they read the same as missing ones in a CSV file.
+* Metadata follows the last chunk. Only the block tables need to be read to find a column's blocks, so reading a single
+* column doesn't decode the whole file, and files cut short by a crash can still be read up to their last complete chunk.
+*/
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+
+class FArchive;
+
+namespace CsvBinary
+{
+	enum : uint32
+	{
+		FileMagic = 0x42565343,		// "CSVB"
+		ChunkMagic = 0x4B4E4843,	// "CHNK"
+		MetadataMagic = 0x4154454D,	// "META"
+		Version = 1,
+	};
+
+	/** Block index used in the block tables for the row and event blocks, column blocks use the column index */
+	enum : int32
+	{
+		RowBlockIndex = -1,
+		EventBlockIndex = -2,
+	};
+
+	/** Formats a value the way the text CSV files do, returns the length of the string written to Buffer */
+	CORE_API int32 FormatValue(ANSICHAR* Buffer, int32 BufferSize, double Value);
+}
+
+/** Streams rows to a binary CSV file, compressing them a chunk at a time */
+class CORE_API FCsvBinaryWriter
+{
+public:
+	FCsvBinaryWriter(const TSharedRef<FArchive>& InOutputFile, int32 InRowsPerChunk = 256);
+	~FCsvBinaryWriter();
+
+	/** Adds a column, returning its index. Columns need to be added before the rows with values for them */
+	int32 AddColumn(const FString& Name, bool bIsInteger);
+
+	/** Rows have to be added in increasing frame order, between BeginRow and EndRow */
+	void BeginRow(int64 FrameNumber);
+	void AddEvent(const FString& EventText);
+	void AddValue(int32 ColumnIndex, int32 Value);
+	void AddValue(int32 ColumnIndex, float Value);
+	void EndRow();
+
+	/** Writes the rows still buffered and the metadata. Nothing can be added afterwards */
+	void Finalize(const TMap<FString, FString>& Metadata);
+
+	uint64 GetAllocatedSize() const;
+
+private:
+	struct FColumn
+	{
+		FString Name;
+		bool bIsInteger;
+		TArray<uint8> Data;
+		int64 LastFrameNumber;
+	};
+
+	void WriteChunk();
+	void WriteBlock(int32 BlockIndex, const TArray<uint8>& Data, TArray<uint8>& OutBlockTable, TArray<uint8>& OutBlocks);
+
+	TSharedRef<FArchive> OutputFile;
+	const int32 RowsPerChunk;
+
+	TArray<FColumn> Columns;
+	int32 NumColumnsWritten;
+
+	TArray<uint8> RowData;
+	TArray<uint8> EventData;
+	int32 NumRows;
+	int64 CurrentFrameNumber;
+	int64 LastRowFrameNumber;
+	int64 LastEventFrameNumber;
+
+	TArray<uint8> CompressionBuffer;
+	bool bFinalized;
+};
+
+/** Reads binary CSV files, a column at a time or converted back to text */
+class CORE_API FCsvBinaryReader
+{
+public:
+	FCsvBinaryReader();
+	~FCsvBinaryReader();
+
+	/** Reads the column definitions and block tables. Returns false if this isn't a binary CSV file */
+	bool Open(const TCHAR* Filename);
+	bool Open(TUniquePtr<FArchive>&& InArchive);
+
+	int32 GetNumColumns() const { return Columns.Num(); }
+	const FString& GetColumnName(int32 ColumnIndex) const { return Columns[ColumnIndex].Name; }
+	bool IsIntegerColumn(int32 ColumnIndex) const { return Columns[ColumnIndex].bIsInteger; }
+	int32 FindColumn(const FString& Name) const;
+
+	/** Metadata in the order it was written, empty if the file was cut short */
+	const TArray<TPair<FString, FString>>& GetMetadata() const { return Metadata; }
+
+	/** Reads the frame numbers of all rows */
+	bool ReadRows(TArray<int64>& OutFrameNumbers);
+
+	/** Reads the frames a column has non-zero values for and these values, only decompressing the column's blocks */
+	bool ReadColumn(int32 ColumnIndex, TArray<int64>& OutFrameNumbers, TArray<double>& OutValues);
+
+	/** Reads the events and the frames they happened on */
+	bool ReadEvents(TArray<int64>& OutFrameNumbers, TArray<FString>& OutEvents);
+
+	/** Writes the file in the text format of the CSV profiler */
+	bool WriteCsv(FArchive& OutCsv);
+
+	/** Converts a binary CSV file to a text one */
+	static bool ConvertToCsv(const TCHAR* BinaryFilename, const TCHAR* CsvFilename);
+
+private:
+	struct FBlock
+	{
+		int32 BlockIndex;
+		int64 Offset;
+		uint32 CompressedSize;
+		uint32 UncompressedSize;
+	};
+
+	struct FChunk
+	{
+		TArray<FBlock> Blocks;
+	};
+
+	struct FColumn
+	{
+		FString Name;
+		bool bIsInteger;
+	};
+
+	bool ReadBlock(const FBlock& Block, TArray<uint8>& OutData);
+	const FBlock* FindBlock(const FChunk& Chunk, int32 BlockIndex) const;
+
+	TUniquePtr<FArchive> Archive;
+	TArray<FColumn> Columns;
+	TArray<FChunk> Chunks;
+	TArray<TPair<FString, FString>> Metadata;
+};
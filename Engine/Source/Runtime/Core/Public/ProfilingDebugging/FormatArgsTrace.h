@@ -4,7 +4,9 @@
 
 #include "CoreTypes.h"
 #include "Misc/CString.h"
+#include "Templates/IsEnum.h"
 #include "Templates/IsFloatingPoint.h"
+#include "Templates/IsIntegral.h"
 #include "Templates/UnrealTypeTraits.h"
 #include "Templates/UnrealTemplate.h"
 
@@ -44,7 +46,30 @@ struct FFormatArgsTrace
 		return (uint16)FormatArgsSize;
 	}
 
+	/**
+	 * Same as EncodeArguments with the arguments promoted the way they are passed through varargs, integers smaller
+	 * than int are widened to int and floats to double. Used when the arguments are formatted with printf rules
+	 * later on, as the encoding doesn't keep the signedness of integers.
+	 */
+	template <int BufferSize, typename... Types>
+	static uint16 EncodeVarArgs(uint8(&Buffer)[BufferSize], Types... FormatArgs)
+	{
+		return EncodeArguments(Buffer, typename TVarArgPromotion<Types>::Type(FormatArgs)...);
+	}
+
 private:
+	template <typename T, bool bPromoteToInt = (TIsIntegral<T>::Value || TIsEnum<T>::Value) && sizeof(T) < sizeof(int)>
+	struct TVarArgPromotion
+	{
+		typedef typename TChooseClass<TIsSame<T, float>::Value, double, T>::Result Type;
+	};
+
+	template <typename T>
+	struct TVarArgPromotion<T, true>
+	{
+		typedef int Type;
+	};
+
 	template <typename T>
 	struct TIsStringArgument
 	{
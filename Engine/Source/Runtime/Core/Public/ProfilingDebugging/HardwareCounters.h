@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PreprocessorHelpers.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Config.h"
+#include "UObject/NameTypes.h"
+
+#if !defined(HARDWARECOUNTERS_ENABLED)
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING
+#define HARDWARECOUNTERS_ENABLED 1
+#else
+#define HARDWARECOUNTERS_ENABLED 0
+#endif
+#endif
+
+#if HARDWARECOUNTERS_ENABLED
+
+/** Counts of the CPU performance monitoring unit for the calling thread, user mode only */
+struct FHardwareCounterValues
+{
+	uint64 Cycles = 0;
+	uint64 Instructions = 0;
+	/** Last level cache misses */
+	uint64 CacheMisses = 0;
+	uint64 BranchMisses = 0;
+
+	FHardwareCounterValues operator-(const FHardwareCounterValues& Other) const
+	{
+		FHardwareCounterValues Result;
+		Result.Cycles = Cycles - Other.Cycles;
+		Result.Instructions = Instructions - Other.Instructions;
+		Result.CacheMisses = CacheMisses - Other.CacheMisses;
+		Result.BranchMisses = BranchMisses - Other.BranchMisses;
+		return Result;
+	}
+};
+
+/**
+ * Hardware performance counters, to tell whether a scope is bound by cache misses, branch misses or compute.
+ * Implemented with perf_event_open on Linux, where kernel.perf_event_paranoid must allow per-thread user counting.
+ * Other platforms give no access to the counters without a driver, and IsEnabled() stays false there.
+ *
+ * Enabled with -hardwarecounters or HardwareCounters.Enable. Counted scopes are traced on the HardwareCounters
+ * channel, and those from CSV_HARDWARE_COUNTERS_SCOPE are also summed per frame into CSV stats.
+ */
+struct FHardwareCounters
+{
+	static bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	CORE_API static void SetEnabled(bool bInEnabled);
+
+	/**
+	 * Reads the counters of the calling thread, opening them on the first call from the thread.
+	 * @return false if they could not be opened
+	 */
+	CORE_API static bool ReadThreadCounters(FHardwareCounterValues& OutValues);
+
+private:
+	CORE_API static bool bEnabled;
+};
+
+/** Where a counted scope is in the code, kept in a static so its names are built once */
+struct FHardwareCountersSite
+{
+	CORE_API explicit FHardwareCountersSite(const TCHAR* InName, int32 InCsvCategoryIndex = -1);
+
+	const TCHAR* Name;
+	int32 CsvCategoryIndex;
+	/** <Name>_Cycles, <Name>_Instructions, <Name>_CacheMisses and <Name>_BranchMisses */
+	FName CsvStatNames[4];
+};
+
+/** Reads the counters when constructed and destroyed, and reports the difference */
+class FHardwareCountersScope
+{
+public:
+	explicit FHardwareCountersScope(const FHardwareCountersSite& InSite)
+	{
+		if (FHardwareCounters::IsEnabled() && FHardwareCounters::ReadThreadCounters(StartValues))
+		{
+			Site = &InSite;
+			StartCycle = FPlatformTime::Cycles64();
+		}
+	}
+
+	~FHardwareCountersScope()
+	{
+		if (Site)
+		{
+			EndScope();
+		}
+	}
+
+private:
+	CORE_API void EndScope();
+
+	const FHardwareCountersSite* Site = nullptr;
+	FHardwareCounterValues StartValues;
+	uint64 StartCycle = 0;
+};
+
+#define TRACE_HARDWARE_COUNTERS_SCOPE(Name) \
+	static FHardwareCountersSite PREPROCESSOR_JOIN(HardwareCountersSite, __LINE__)(TEXT(#Name)); \
+	FHardwareCountersScope PREPROCESSOR_JOIN(HardwareCountersScope, __LINE__)(PREPROCESSOR_JOIN(HardwareCountersSite, __LINE__));
+
+#if CSV_PROFILER
+#define CSV_HARDWARE_COUNTERS_SCOPE(Category, Name) \
+	static FHardwareCountersSite PREPROCESSOR_JOIN(HardwareCountersSite, __LINE__)(TEXT(#Name), CSV_CATEGORY_INDEX(Category)); \
+	FHardwareCountersScope PREPROCESSOR_JOIN(HardwareCountersScope, __LINE__)(PREPROCESSOR_JOIN(HardwareCountersSite, __LINE__));
+#else
+#define CSV_HARDWARE_COUNTERS_SCOPE(Category, Name) TRACE_HARDWARE_COUNTERS_SCOPE(Name)
+#endif
+
+#else
+
+#define TRACE_HARDWARE_COUNTERS_SCOPE(Name)
+#define CSV_HARDWARE_COUNTERS_SCOPE(Category, Name)
+
+#endif
@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformMath.h"
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+class FArchive;
+
+/**
+ * Bucketing of FLogLinearHistogram, after HdrHistogram: values below 2 * SubBucketCount have a bucket each, above
+ * that every power of two is split into SubBucketCount equal buckets. Finding the bucket of a value is a count of
+ * leading zeros and two shifts, and a bucket's bounds are within 1 / SubBucketCount of any value in it.
+ */
+struct FLogLinearHistogramBuckets
+{
+	enum
+	{
+		SubBucketBits = 5,
+		SubBucketCount = 1 << SubBucketBits,
+		/** Enough for every uint64 */
+		NumBuckets = (64 - SubBucketBits + 1) * SubBucketCount,
+	};
+
+	static FORCEINLINE int32 GetIndex(uint64 Value)
+	{
+		// Values below 2 * SubBucketCount get shift 0, so they map to themselves
+		const uint32 Shift = uint32(63 - FPlatformMath::CountLeadingZeros64(Value | (2 * SubBucketCount - 1))) - SubBucketBits;
+		return int32((uint64(Shift) << SubBucketBits) + (Value >> Shift));
+	}
+
+	/** @return the smallest value that goes into the bucket */
+	static FORCEINLINE uint64 GetLowerBound(int32 Index)
+	{
+		const uint32 Shift = FPlatformMath::Max(uint32(Index) >> SubBucketBits, 1u) - 1;
+		return (uint64(Index) - (uint64(Shift) << SubBucketBits)) << Shift;
+	}
+
+	/** @return the largest value that goes into the bucket */
+	static FORCEINLINE uint64 GetUpperBound(int32 Index)
+	{
+		const uint32 Shift = FPlatformMath::Max(uint32(Index) >> SubBucketBits, 1u) - 1;
+		return GetLowerBound(Index) + ((uint64(1) << Shift) - 1);
+	}
+};
+
+/** A merged copy of a FLogLinearHistogram, for queries and serialization from one thread */
+struct CORE_API FLogLinearHistogramSnapshot
+{
+	/** Observations per bucket, see FLogLinearHistogramBuckets */
+	TArray<uint64> Counts;
+	uint64 TotalCount = 0;
+	/** Sum of all values, wraps around if they add up past 2^64 */
+	uint64 Sum = 0;
+	uint64 Min = MAX_uint64;
+	uint64 Max = 0;
+
+	FLogLinearHistogramSnapshot();
+
+	/**
+	 * @param Percentile; 0 to 100
+	 * @return the largest value in the bucket holding the value at Percentile, within the histogram precision of
+	 * the real one, and never more than Max. 0 if nothing was recorded.
+	 */
+	uint64 GetValueAtPercentile(double Percentile) const;
+
+	double GetMean() const
+	{
+		return TotalCount ? double(Sum) / double(TotalCount) : 0.0;
+	}
+
+	/** Adds the observations of another snapshot, e.g. of a previous session or another machine */
+	void Merge(const FLogLinearHistogramSnapshot& Other);
+
+	/** @return "LowerBound,UpperBound,Count" lines for the buckets that have observations, under a header line */
+	FString ToCsvString() const;
+
+	/** Stores the buckets that have observations, not all of them */
+	friend CORE_API FArchive& operator<<(FArchive& Ar, FLogLinearHistogramSnapshot& Snapshot);
+};
+
+/**
+ * A log-linear histogram of uint64 values, e.g. latencies in cycles or microseconds, that any number of threads can
+ * record into at once. Threads record into one of a few shards picked per thread, which are allocated on first use
+ * and merged by Snapshot. A record is a handful of atomics on memory the thread mostly has to itself.
+ */
+class CORE_API FLogLinearHistogram
+{
+public:
+
+	enum
+	{
+		MaxShards = 64,
+	};
+
+	/** @param InNumShards; how many shards threads are spread over, each is about 15KB once used */
+	explicit FLogLinearHistogram(int32 InNumShards = 8);
+	~FLogLinearHistogram();
+
+	/** Records Count observations of Value */
+	FORCEINLINE void Record(uint64 Value, uint64 Count = 1)
+	{
+		FShard& Shard = GetShard();
+		FPlatformAtomics::InterlockedAdd(&Shard.Counts[FLogLinearHistogramBuckets::GetIndex(Value)], (int64)Count);
+		FPlatformAtomics::InterlockedAdd(&Shard.Sum, int64(Value * Count));
+		if (Value < (uint64)FPlatformAtomics::AtomicRead(&Shard.Min))
+		{
+			UpdateMin(Shard, Value);
+		}
+		if (Value > (uint64)FPlatformAtomics::AtomicRead(&Shard.Max))
+		{
+			UpdateMax(Shard, Value);
+		}
+	}
+
+	/** Merges the shards. Observations recorded while this runs may or may not be in the result. */
+	FLogLinearHistogramSnapshot Snapshot() const;
+
+	/** Clears all observations. Observations recorded while this runs may or may not be kept. */
+	void Reset();
+
+private:
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		volatile int64 Counts[FLogLinearHistogramBuckets::NumBuckets];
+		volatile int64 Sum;
+		volatile int64 Min;
+		volatile int64 Max;
+
+		FShard();
+	};
+
+	FORCEINLINE FShard& GetShard()
+	{
+		const int32 Slot = GetThreadSlot() % NumShards;
+		// Published with a full barrier by CreateShard, what it points to is only reached through it
+		FShard* Shard = Shards[Slot];
+		return Shard ? *Shard : CreateShard(Slot);
+	}
+
+	/** @return a number that is different for each thread, assigned on first use */
+	static int32 GetThreadSlot();
+
+	FShard& CreateShard(int32 Slot);
+	static void UpdateMin(FShard& Shard, uint64 Value);
+	static void UpdateMax(FShard& Shard, uint64 Value);
+
+	int32 NumShards;
+	FShard* volatile Shards[MaxShards];
+
+	UE_NONCOPYABLE(FLogLinearHistogram);
+};
+
+#if COUNTERSTRACE_ENABLED
+
+/** Traces the count and the 50th, 90th, 99th, 99.9th percentiles and maximum of histograms as counters Name/P50 and so on */
+class CORE_API FLogLinearHistogramTraceCounters
+{
+public:
+
+	explicit FLogLinearHistogramTraceCounters(const TCHAR* InName);
+
+	/** Not thread safe, like the other trace counters */
+	void Set(const FLogLinearHistogramSnapshot& Snapshot);
+
+private:
+
+	enum { NumCounters = 6 };
+
+	FString Names[NumCounters];
+	uint16 CounterIds[NumCounters];
+};
+
+#endif
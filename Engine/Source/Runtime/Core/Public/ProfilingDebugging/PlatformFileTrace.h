@@ -5,7 +5,7 @@
 #include "CoreTypes.h"
 #include "Trace/Config.h"
 
-#if UE_TRACE_ENABLED && PLATFORM_WINDOWS && !UE_BUILD_SHIPPING
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING
 #define PLATFORMFILETRACE_ENABLED 1
 #else
 #define PLATFORMFILETRACE_ENABLED 0
@@ -25,6 +25,8 @@ struct FPlatformFileTrace
 	static void EndRead(uint64 ReadHandle, uint64 SizeRead);
 	static void BeginWrite(uint64 WriteHandle, uint64 FileHandle, uint64 Offset, uint64 Size);
 	static void EndWrite(uint64 WriteHandle, uint64 SizeWritten);
+	CORE_API static void Activity(uint32 QueueDepth, uint32 MaxQueueDepth, uint64 BytesPerSecond);
+	CORE_API static void LatencySummary(const TCHAR* Name, bool bIsCallSite, uint32 Count, uint64 Bytes, float P50Ms, float P99Ms, float MaxMs);
 };
 
 #define TRACE_PLATFORMFILE_INIT(CmdLine) \
@@ -54,6 +56,12 @@ struct FPlatformFileTrace
 #define TRACE_PLATFORMFILE_END_WRITE(WriteHandle, SizeWritten) \
 	FPlatformFileTrace::EndWrite(uint64(WriteHandle), SizeWritten);
 
+#define TRACE_PLATFORMFILE_ACTIVITY(QueueDepth, MaxQueueDepth, BytesPerSecond) \
+	FPlatformFileTrace::Activity(QueueDepth, MaxQueueDepth, BytesPerSecond);
+
+#define TRACE_PLATFORMFILE_LATENCY_SUMMARY(Name, bIsCallSite, Count, Bytes, P50Ms, P99Ms, MaxMs) \
+	FPlatformFileTrace::LatencySummary(Name, bIsCallSite, Count, Bytes, P50Ms, P99Ms, MaxMs);
+
 #else
 
 #define TRACE_PLATFORMFILE_INIT(CmdLine)
@@ -65,5 +73,7 @@ struct FPlatformFileTrace
 #define TRACE_PLATFORMFILE_END_READ(ReadHandle, SizeRead)
 #define TRACE_PLATFORMFILE_BEGIN_WRITE(WriteHandle, FileHandle, Offset, Size)
 #define TRACE_PLATFORMFILE_END_WRITE(WriteHandle, SizeWritten)
+#define TRACE_PLATFORMFILE_ACTIVITY(QueueDepth, MaxQueueDepth, BytesPerSecond)
+#define TRACE_PLATFORMFILE_LATENCY_SUMMARY(Name, bIsCallSite, Count, Bytes, P50Ms, P99Ms, MaxMs)
 
 #endif
\ No newline at end of file
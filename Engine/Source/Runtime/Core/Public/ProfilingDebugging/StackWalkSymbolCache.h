@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "GenericPlatform/GenericPlatformStackWalk.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+
+template <typename ResultType> class TFuture;
+
+/**
+ * Symbol info of the program counters of many callstacks, each one looked up once however many callstacks it is in.
+ * FPlatformStackWalk::ProgramCounterToSymbolInfo takes from microseconds to milliseconds, too slow for each frame of
+ * each sample of a profiler, so program counters are added as they are captured and symbolicated later in batches,
+ * on the calling thread with Symbolicate or on a background thread with SymbolicateAsync.
+ *
+ * All the functions can be called from any thread.
+ */
+class CORE_API FStackWalkSymbolCache
+{
+public:
+	FStackWalkSymbolCache();
+	~FStackWalkSymbolCache();
+
+	FStackWalkSymbolCache(const FStackWalkSymbolCache&) = delete;
+	FStackWalkSymbolCache& operator=(const FStackWalkSymbolCache&) = delete;
+
+	/** Adds the program counters of a callstack, those that were not added before are queued to be symbolicated */
+	void Add(const uint64* ProgramCounters, int32 NumProgramCounters);
+
+	/** Symbolicates all the queued program counters before returning */
+	void Symbolicate();
+
+	/**
+	 * Symbolicates all the queued program counters on a background thread. The cache can still be used meanwhile,
+	 * and has to outlive the returned future.
+	 */
+	TFuture<void> SymbolicateAsync();
+
+	/**
+	 * Copies the symbol info of a program counter if it was symbolicated.
+	 *
+	 * @return false if the program counter was never added or is still queued
+	 */
+	bool Find(uint64 ProgramCounter, FProgramCounterSymbolInfo& OutSymbolInfo) const;
+
+	/** Gets the symbol info of a program counter, symbolicating it now if it was not yet */
+	FProgramCounterSymbolInfo Get(uint64 ProgramCounter);
+
+	/** Number of distinct program counters added, symbolicated or not */
+	int32 Num() const;
+
+	/** Number of program counters queued to be symbolicated */
+	int32 NumPending() const;
+
+	/** Forgets every program counter, waiting for a symbolication that is running */
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		FProgramCounterSymbolInfo SymbolInfo;
+		bool bSymbolicated = false;
+	};
+
+	/** Symbolicates the queued program counters, one batch at a time */
+	void SymbolicatePending();
+
+	/** Entries are never moved so that symbolication can fill them in without holding EntriesCritical */
+	TMap<uint64, TUniquePtr<FEntry>> Entries;
+	TArray<uint64> Pending;
+	mutable FCriticalSection EntriesCritical;
+
+	/** Held for the whole of a batch, the platform symbol lookups are not all thread safe */
+	FCriticalSection SymbolicateCritical;
+};
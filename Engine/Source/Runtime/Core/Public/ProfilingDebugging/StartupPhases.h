@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Trace/Config.h"
+#include <initializer_list>
+
+#if !defined(STARTUPPHASES_ENABLED)
+#if !UE_BUILD_SHIPPING
+#define STARTUPPHASES_ENABLED 1
+#else
+#define STARTUPPHASES_ENABLED 0
+#endif
+#endif
+
+#if STARTUPPHASES_ENABLED
+
+/**
+ * Timeline of the well-defined phases of process startup, such as config loading or FName initialization.
+ *
+ * Each phase names the phases it needs to have completed before it can run. Once engine init completes the phases
+ * are written as trace events on the StartupPhases channel, and a summary of the critical path through the dependencies
+ * and of the phases that started later than their dependencies allowed is logged.
+ *
+ * Phase names must be string literals or otherwise outlive startup, as both phases and dependencies are kept by pointer.
+ * Phases can begin during static initialization.
+ */
+struct FStartupPhases
+{
+	/** Begins the phase on the calling thread, a phase that runs more than once is recorded for each run */
+	CORE_API static void BeginPhase(const TCHAR* PhaseName, std::initializer_list<const TCHAR*> Dependencies);
+
+	/** Ends the most recent run of the phase that was begun on the calling thread */
+	CORE_API static void EndPhase(const TCHAR* PhaseName);
+
+	/** Writes the recorded phases as trace events and logs the critical path summary, called once engine init completes */
+	CORE_API static void DumpSummary();
+
+	struct FScope
+	{
+		FScope(const TCHAR* InPhaseName, std::initializer_list<const TCHAR*> InDependencies)
+			: PhaseName(InPhaseName)
+		{
+			BeginPhase(PhaseName, InDependencies);
+		}
+
+		~FScope()
+		{
+			EndPhase(PhaseName);
+		}
+
+	private:
+		const TCHAR* PhaseName;
+	};
+};
+
+/** Records the enclosing scope as a startup phase, followed by the names of the phases it depends on */
+#define SCOPED_STARTUP_PHASE(PhaseName, ...) \
+	FStartupPhases::FScope PREPROCESSOR_JOIN(__StartupPhaseScope, __LINE__)(PhaseName, { __VA_ARGS__ });
+
+#else
+
+#define SCOPED_STARTUP_PHASE(PhaseName, ...)
+
+#endif
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Trace/Config.h"
+
+#if !defined(TRACEFLIGHTRECORDER_ENABLED)
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING
+#define TRACEFLIGHTRECORDER_ENABLED 1
+#else
+#define TRACEFLIGHTRECORDER_ENABLED 0
+#endif
+#endif
+
+#if TRACEFLIGHTRECORDER_ENABLED
+
+/**
+ * Keeps the last events traced in memory while no trace is being recorded so they can be written to disk when something
+ * goes wrong. Enabled with -traceflightrecorder=<MB>, optionally limited to the last events with -traceflightrecorderseconds=<Seconds>.
+ * The ring is written to the project log directory on crashes and ensures, or on demand with "Trace.FlightRecorder.Dump [Path]".
+ */
+struct FTraceFlightRecorder
+{
+	/** Has to be called before anything else is traced as the trace buffers are only configured once */
+	CORE_API static void Init(const TCHAR* CmdLine);
+
+	/** Writes the events held by the flight recorder to Path, or to a timestamped file in the project log directory if null */
+	CORE_API static bool Dump(const TCHAR* Path = nullptr);
+
+	/** @return whether the flight recorder was enabled on the command line */
+	CORE_API static bool IsEnabled();
+};
+
+#define TRACE_FLIGHTRECORDER_INIT(CmdLine) \
+	FTraceFlightRecorder::Init(CmdLine);
+
+#else
+
+#define TRACE_FLIGHTRECORDER_INIT(CmdLine)
+
+#endif
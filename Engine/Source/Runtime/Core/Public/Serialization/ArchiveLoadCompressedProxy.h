@@ -6,6 +6,7 @@
 #include "UObject/NameTypes.h"
 #include "Serialization/Archive.h"
 #include "Misc/Compression.h"
+#include "Async/Future.h"
 
 /*----------------------------------------------------------------------------
 	FArchiveLoadCompressedProxy.
@@ -17,7 +18,16 @@
 class CORE_API FArchiveLoadCompressedProxy : public FArchive
 {
 public:
-	FArchiveLoadCompressedProxy(const TArray<uint8>& InCompressedData, FName CompressionFormat, ECompressionFlags InCompressionFlags=COMPRESS_NoFlags);
+	/**
+	 * Constructor, initializing all member variables and allocating temp memory.
+	 *
+	 * @param	InCompressedData	Array of bytes holding the compressed data
+	 * @param	CompressionFormat	Compression format the data was compressed with
+	 * @param	InCompressionFlags	Flags the data was compressed with
+	 * @param	InNumAsyncBlocks	Number of blocks that may be decompressed ahead on the task graph while the current one
+	 *								is read, 0 decompresses each block on the calling thread when it is reached.
+	 */
+	FArchiveLoadCompressedProxy(const TArray<uint8>& InCompressedData, FName CompressionFormat, ECompressionFlags InCompressionFlags=COMPRESS_NoFlags, int32 InNumAsyncBlocks=0);
 
 	/** Destructor, freeing temporary memory. */
 	virtual ~FArchiveLoadCompressedProxy();
@@ -48,9 +58,23 @@ private:
 	 */
 	void DecompressMoreData();
 
+	/** A block decompressed ahead on the task graph. */
+	struct FAsyncBlock
+	{
+		/** Uncompressed data, traded with the tmp buffer when the block is reached. */
+		uint8* UncompressedData = nullptr;
+		/** Number of bytes in UncompressedData. */
+		int64 UncompressedSize = 0;
+		/** Decompression task, valid while the block is queued. */
+		TFuture<void> Task;
+	};
+
+	/** Starts decompressing the blocks following CurrentIndex until they are all in use or one can't be read ahead. */
+	void QueueAsyncBlocks();
+
 	/** Array to write compressed data to.						*/
 	const TArray<uint8>&	CompressedData;
-	/** Current index into compressed data array.				*/
+	/** Current index into compressed data array, past the queued blocks if there are any. */
 	int32			CurrentIndex;
 	/** Pointer to start of temporary buffer.					*/
 	uint8*			TmpDataStart;
@@ -66,4 +90,10 @@ private:
 	FName			CompressionFormat;
 	/** Flags used for compression.								*/
 	ECompressionFlags CompressionFlags;
+	/** Blocks decompressed asynchronously, used as a ring.		*/
+	TArray<FAsyncBlock> AsyncBlocks;
+	/** Index of the oldest queued block.						*/
+	int32			OldestAsyncBlock;
+	/** Number of blocks queued.								*/
+	int32			NumQueuedAsyncBlocks;
 };
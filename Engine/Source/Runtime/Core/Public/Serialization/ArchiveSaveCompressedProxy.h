@@ -6,6 +6,7 @@
 #include "UObject/NameTypes.h"
 #include "Serialization/Archive.h"
 #include "Misc/Compression.h"
+#include "Async/Future.h"
 
 /*----------------------------------------------------------------------------
 	FArchiveSaveCompressedProxy.
@@ -32,19 +33,22 @@ public:
 	 *
 	 * @param	InCompressedData [ref]	Array of bytes that is going to hold compressed data
 	 * @param	InCompressionFormat		Compression format to use
+	 * @param	InCompressionFlags		Flags to use for compression
+	 * @param	InNumAsyncBlocks		Number of blocks that may be compressed on the task graph while the next ones are filled,
+	 *									0 compresses each block on the calling thread. The data written is the same either way.
 	 */
 	UE_DEPRECATED(4.21, "Use the FName version of FArchiveSaveCompressedProxy constructor")
 	FArchiveSaveCompressedProxy(TArray<uint8>& InCompressedData, ECompressionFlags InCompressionFlags)
 		// Make sure to remove the EVS2015Redirector constructor when this constructor is removed
 		: FArchiveSaveCompressedProxy(EVS2015Redirector::Redirect, InCompressedData, InCompressionFlags)
 	{}
-	FArchiveSaveCompressedProxy( TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags=COMPRESS_None);
+	FArchiveSaveCompressedProxy( TArray<uint8>& InCompressedData, FName InCompressionFormat, ECompressionFlags InCompressionFlags=COMPRESS_None, int32 InNumAsyncBlocks=0);
 
 	/** Destructor, flushing array if needed. Also frees temporary memory. */
 	virtual ~FArchiveSaveCompressedProxy();
 
 	/**
-	 * Flushes tmp data to array.
+	 * Flushes tmp data to array, waiting for the blocks being compressed asynchronously.
 	 */
 	virtual void Flush();
 
@@ -70,6 +74,25 @@ public:
 	virtual int64 Tell();
 
 private:
+	/** A block of tmp data being compressed on the task graph. */
+	struct FAsyncBlock
+	{
+		/** Uncompressed data, traded with the tmp buffer when the block is queued. */
+		uint8* UncompressedData = nullptr;
+		/** Number of bytes in UncompressedData. */
+		int64 UncompressedSize = 0;
+		/** The block as SerializeCompressed writes it. */
+		TArray<uint8> CompressedData;
+		/** Compression task, valid while the block is queued. */
+		TFuture<void> Task;
+	};
+
+	/** Starts compressing the tmp data on the task graph, retiring the oldest block if they are all in use. */
+	void QueueAsyncBlock();
+
+	/** Waits for the oldest queued block and writes it to the array. */
+	void RetireOldestAsyncBlock();
+
 	/** Array to write compressed data to.					*/
 	TArray<uint8>&	CompressedData;
 	/** Current index in array.								*/
@@ -88,5 +111,11 @@ private:
 	FName  CompressionFormat;
 	/** Flags to use for compression.						*/
 	ECompressionFlags CompressionFlags;
+	/** Blocks compressed asynchronously, used as a ring.	*/
+	TArray<FAsyncBlock> AsyncBlocks;
+	/** Index of the oldest queued block.					*/
+	int32			OldestAsyncBlock;
+	/** Number of blocks queued.							*/
+	int32			NumQueuedAsyncBlocks;
 };
 
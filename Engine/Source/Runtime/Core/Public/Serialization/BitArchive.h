@@ -5,6 +5,8 @@
 #include "CoreTypes.h"
 #include "Serialization/Archive.h"
 #include "HAL/IConsoleManager.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
 
 /** CVar specifying the maximum serialization size for strings sent/received by the netcode */
 extern CORE_API TAutoConsoleVariable<int32> CVarMaxNetStringSize;
@@ -24,4 +26,82 @@ public:
 	}
 
 	virtual void SerializeBitsWithOffset( void* Src, int32 SourceBit, int64 LengthBits ) PURE_VIRTUAL(FBitArchive::SerializeBitsWithOffset,);
-};
\ No newline at end of file
+};
+
+namespace UE4BitArchive_Private
+{
+	/** Largest number of bits PeekBits and PokeBits handle, the most a 64 bit word holds at any bit offset within a byte */
+	static constexpr int32 MaxWordBits = 57;
+
+	/** Returns LengthBits <= MaxWordBits bits of a buffer of NumBytes starting at BitPos, with a single load when 8 bytes are left */
+	FORCEINLINE uint64 PeekBits(const uint8* Data, int64 NumBytes, int64 BitPos, int32 LengthBits)
+	{
+		const int64 ByteIndex = BitPos >> 3;
+		const int32 Shift = int32(BitPos & 7);
+		uint64 Word = 0;
+#if PLATFORM_LITTLE_ENDIAN
+		if (ByteIndex + 8 <= NumBytes)
+		{
+			FMemory::Memcpy(&Word, Data + ByteIndex, sizeof(Word));
+		}
+		else
+#endif
+		{
+			const int64 EndByte = FMath::Min<int64>(NumBytes, ByteIndex + ((Shift + LengthBits + 7) >> 3));
+			for (int64 Index = ByteIndex; Index < EndByte; ++Index)
+			{
+				Word |= uint64(Data[Index]) << ((Index - ByteIndex) * 8);
+			}
+		}
+		return (Word >> Shift) & ((uint64(1) << LengthBits) - 1);
+	}
+
+	/** Overwrites LengthBits <= MaxWordBits bits of a buffer of NumBytes starting at BitPos with the lowest bits of Value, which the bytes must hold */
+	FORCEINLINE void PokeBits(uint8* Data, int64 NumBytes, int64 BitPos, uint64 Value, int32 LengthBits)
+	{
+		const int64 ByteIndex = BitPos >> 3;
+		const int32 Shift = int32(BitPos & 7);
+		const uint64 Mask = ((uint64(1) << LengthBits) - 1) << Shift;
+		const uint64 Bits = (Value << Shift) & Mask;
+#if PLATFORM_LITTLE_ENDIAN
+		if (ByteIndex + 8 <= NumBytes)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Data + ByteIndex, sizeof(Word));
+			Word = (Word & ~Mask) | Bits;
+			FMemory::Memcpy(Data + ByteIndex, &Word, sizeof(Word));
+			return;
+		}
+#endif
+		const int64 EndByte = ByteIndex + ((Shift + LengthBits + 7) >> 3);
+		for (int64 Index = ByteIndex; Index < EndByte; ++Index)
+		{
+			const int32 ByteShift = int32(Index - ByteIndex) * 8;
+			const uint8 ByteMask = uint8(Mask >> ByteShift);
+			Data[Index] = uint8((Data[Index] & ~ByteMask) | uint8(Bits >> ByteShift));
+		}
+	}
+
+	/**
+	 * Returns the part of Bits that SerializeInt stores for a value below ValueMax, and the number of bits that takes.
+	 * Bits are stored from the lowest one and the upper ones are skipped once the value could only reach ValueMax with them set.
+	 */
+	FORCEINLINE uint32 TruncateIntToMax(uint32 Bits, uint32 ValueMax, int32& OutLengthBits)
+	{
+		if ((ValueMax & (ValueMax - 1)) == 0)
+		{
+			// A power of two maximum, the common case, always takes the same number of bits
+			OutLengthBits = ValueMax ? FMath::FloorLog2(ValueMax) : 0;
+			return ValueMax ? Bits & (ValueMax - 1) : 0;
+		}
+
+		uint32 Value = 0;
+		int32 LengthBits = 0;
+		for (uint32 Mask = 1; (Value + Mask) < ValueMax && Mask; Mask *= 2, ++LengthBits)
+		{
+			Value |= Bits & Mask;
+		}
+		OutLengthBits = LengthBits;
+		return Value;
+	}
+}
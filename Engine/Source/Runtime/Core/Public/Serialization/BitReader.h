@@ -7,14 +7,17 @@
 #include "HAL/UnrealMemory.h"
 #include "Serialization/BitArchive.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 
-CORE_API void appBitsCpy( uint8* Dest, int32 DestBit, uint8* Src, int32 SrcBit, int32 BitCount );
+struct FVector;
+
+CORE_API void appBitsCpy( uint8* Dest, int64 DestBit, uint8* Src, int64 SrcBit, int64 BitCount );
 
 /*-----------------------------------------------------------------------------
 	FBitReader.
 -----------------------------------------------------------------------------*/
 
-//@TODO: FLOATPRECISION: Public API assumes it can have > 2 GB of bits, but internally uses int32 based TArray for bytes and also has uint32 clamping on bit counts in various places
+// Bit positions and counts are 64 bit, the bytes are held in an int32 based TArray so streams are limited to 2 GB (16 Gbits)
 
 //
 // Reads bitstreams.
@@ -37,7 +40,6 @@ public:
 
 	FORCEINLINE_DEBUGGABLE void SerializeBits( void* Dest, int64 LengthBits )
 	{
-		//@TODO: FLOATPRECISION: This function/class pretends it is 64-bit aware, e.g., in the type of LengthBits and the Pos member, but it is not as appBitsCpy is only 32 bits, the inner Buffer is a 32 bit TArray, etc...
 		if ( IsError() || Pos+LengthBits > Num)
 		{
 			if (!IsError())
@@ -58,10 +60,20 @@ public:
 				((uint8*)Dest)[0] |= 0x01;
 			Pos++;
 		}
-		else if (LengthBits != 0)
+		else if (LengthBits <= UE4BitArchive_Private::MaxWordBits)
+		{
+			// Small fields are read as one word, the bits of the last byte past LengthBits are zero as appBitsCpy leaves them
+			uint64 Value = UE4BitArchive_Private::PeekBits(Buffer.GetData(), Buffer.Num(), Pos, (int32)LengthBits);
+			for (int64 ByteIndex = 0, NumBytes = (LengthBits+7)>>3; ByteIndex < NumBytes; ++ByteIndex, Value >>= 8)
+			{
+				((uint8*)Dest)[ByteIndex] = (uint8)Value;
+			}
+			Pos += LengthBits;
+		}
+		else
 		{
 			((uint8*)Dest)[((LengthBits+7)>>3) - 1] = 0;
-			appBitsCpy((uint8*)Dest, 0, Buffer.GetData(), (int32)Pos, (int32)LengthBits);
+			appBitsCpy((uint8*)Dest, 0, Buffer.GetData(), Pos, LengthBits);
 			Pos += LengthBits;
 		}
 	}
@@ -73,6 +85,16 @@ public:
 	{
 		if (!IsError())
 		{
+			const int64 MaxLengthBits = FMath::CeilLogTwo(ValueMax);
+			if (Pos + MaxLengthBits <= Num)
+			{
+				// All the bits the value can take are there, read them at once and keep the ones it used
+				int32 LengthBits;
+				OutValue = UE4BitArchive_Private::TruncateIntToMax((uint32)UE4BitArchive_Private::PeekBits(Buffer.GetData(), Buffer.Num(), Pos, (int32)MaxLengthBits), ValueMax, LengthBits);
+				Pos += LengthBits;
+				return;
+			}
+
 			// Use local variable to avoid Load-Hit-Store
 			uint32 Value = 0;
 			int64 LocalPos = Pos;
@@ -109,6 +131,35 @@ public:
 		return Value;
 	}
 
+	/**
+	 * Reads a field of up to 57 bits, stored from its lowest bit as SerializeBits and FBitWriter::WriteBits do, without going through memory.
+	 * Returns 0 and marks the reader as overflowed if the field is past the end.
+	 */
+	FORCEINLINE_DEBUGGABLE uint64 ReadBits(int32 LengthBits)
+	{
+		check(LengthBits >= 0 && LengthBits <= UE4BitArchive_Private::MaxWordBits);
+		if (IsError() || Pos + LengthBits > Num)
+		{
+			if (!IsError())
+			{
+				SetOverflowed(LengthBits);
+			}
+			return 0;
+		}
+		const uint64 Value = UE4BitArchive_Private::PeekBits(Buffer.GetData(), Buffer.Num(), Pos, LengthBits);
+		Pos += LengthBits;
+		return Value;
+	}
+
+	/**
+	 * Reads values written by FBitWriter::WriteQuantizedFloats with the same range and number of bits.
+	 * The values are zeroed and the reader is marked as overflowed if they are past the end.
+	 */
+	void ReadQuantizedFloats(TArrayView<float> OutValues, float MinValue, float MaxValue, int32 NumBits);
+
+	/** Reads vectors written by FBitWriter::WriteQuantizedVectors, each component as ReadQuantizedFloats does */
+	void ReadQuantizedVectors(TArrayView<FVector> OutValues, float MinValue, float MaxValue, int32 NumBits);
+
 	FORCEINLINE_DEBUGGABLE uint8 ReadBit()
 	{
 		uint8 Bit=0;
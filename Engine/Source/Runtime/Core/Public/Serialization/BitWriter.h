@@ -6,8 +6,11 @@
 #include "Misc/AssertionMacros.h"
 #include "Serialization/BitArchive.h"
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Math/UnrealMathUtility.h"
 
+struct FVector;
+
 /*-----------------------------------------------------------------------------
 	FBitWriter.
 -----------------------------------------------------------------------------*/
@@ -56,6 +59,18 @@ public:
 	 */
 	void WriteIntWrapped(uint32 Value, uint32 ValueMax);
 
+	/** Writes the lowest LengthBits (up to 57) of Value as SerializeBits would, without going through memory. */
+	void WriteBits(uint64 Value, int32 LengthBits);
+
+	/**
+	 * Writes each value clamped to [MinValue, MaxValue] and quantized to NumBits (1 to 24) bits, packed back to back.
+	 * FBitReader::ReadQuantizedFloats reads them back with a precision of (MaxValue - MinValue) / (2^NumBits - 1).
+	 */
+	void WriteQuantizedFloats(TArrayView<const float> Values, float MinValue, float MaxValue, int32 NumBits);
+
+	/** Writes the components of each vector as WriteQuantizedFloats does */
+	void WriteQuantizedVectors(TArrayView<const FVector> Values, float MinValue, float MaxValue, int32 NumBits);
+
 	void WriteBit( uint8 In );
 	virtual void Serialize( void* Src, int64 LengthBytes ) override;
 
@@ -133,7 +148,7 @@ public:
 
 	FORCEINLINE bool AllowAppend(int64 LengthBits)
 	{
-		//@TODO: FLOATPRECISION: This class pretends it is 64-bit aware, e.g., in the type of LengthBits and the Num/Max members, but it is not as the inner Buffer is a 32 bit TArray, etc...
+		// Bit positions and counts are 64 bit, the bytes are held in an int32 based TArray so streams are limited to 2 GB (16 Gbits)
 
 		if (Num+LengthBits > Max)
 		{
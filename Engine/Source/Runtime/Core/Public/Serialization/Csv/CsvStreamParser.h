@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
+#include "Templates/Function.h"
+
+/**
+ * A csv parser for UTF-8 text that neither copies nor modifies it, for inputs too large to hold as one FString.
+ *
+ * Rows are passed to a callback as they are parsed, as views of their cells which point into the source text.
+ * Only quoted cells containing escaped quotes are unescaped, into a buffer owned by the parser, so the views are only
+ * valid during the callback. The cells are split in the same way as FCsvParser does, and a UTF-8 byte order mark
+ * at the start of the text is skipped.
+ */
+struct FCsvStreamParser
+{
+	/** Called with the cells of each row, return false to stop parsing */
+	typedef TFunctionRef<bool(TArrayView<const FAnsiStringView> Cells)> FRowCallback;
+
+	/** Called with the cells of each row of a part, from as many threads as there are parts. Return false to stop parsing. */
+	typedef TFunctionRef<bool(int32 PartIndex, TArrayView<const FAnsiStringView> Cells)> FPartRowCallback;
+
+	/**
+	 * Parse the rows of text held in memory.
+	 *
+	 * @param Text		The UTF-8 text to parse
+	 * @param Size		The size of the text in bytes
+	 * @param OnRow		Called with the cells of each row, in order
+	 * @return false if OnRow stopped the parsing
+	 */
+	CORE_API static bool ParseBuffer(const UTF8CHAR* Text, int64 Size, FRowCallback OnRow);
+
+	/**
+	 * Parse the rows of text held in memory on several threads. The text is split into parts at row boundaries,
+	 * found by scanning it for new lines outside of quoted cells, then the parts are parsed in parallel.
+	 *
+	 * @param Text		The UTF-8 text to parse
+	 * @param Size		The size of the text in bytes
+	 * @param NumParts	The number of parts to split the text into, fewer are used if the text has fewer rows
+	 * @param OnRow		Called with the cells of each row and the index of its part. The rows of a part are passed in order.
+	 * @return false if OnRow stopped the parsing
+	 */
+	CORE_API static bool ParseBufferParallel(const UTF8CHAR* Text, int64 Size, int32 NumParts, FPartRowCallback OnRow);
+
+	/**
+	 * Parse the rows of a file. The file is memory mapped when the platform supports it, otherwise it is read in parts
+	 * with IAsyncReadFileHandle, the next part being read while the previous one is parsed.
+	 *
+	 * @param Filename	The UTF-8 file to parse
+	 * @param OnRow		Called with the cells of each row, in order
+	 * @return false if the file could not be read or OnRow stopped the parsing
+	 */
+	CORE_API static bool ParseFile(const TCHAR* Filename, FRowCallback OnRow);
+
+	/**
+	 * Parse the rows of a file on several threads, as ParseBufferParallel does. The file is memory mapped when the
+	 * platform supports it, otherwise it is loaded in one go.
+	 *
+	 * @param Filename	The UTF-8 file to parse
+	 * @param NumParts	The number of parts to split the file into, fewer are used if the file has fewer rows
+	 * @param OnRow		Called with the cells of each row and the index of its part. The rows of a part are passed in order.
+	 * @return false if the file could not be read or OnRow stopped the parsing
+	 */
+	CORE_API static bool ParseFileParallel(const TCHAR* Filename, int32 NumParts, FPartRowCallback OnRow);
+};
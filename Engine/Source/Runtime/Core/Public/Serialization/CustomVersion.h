@@ -7,6 +7,7 @@
 #include "Misc/Crc.h"
 #include "Containers/UnrealString.h"
 #include "Containers/Set.h"
+#include "Containers/Map.h"
 #include "UObject/NameTypes.h"
 #include "Misc/Guid.h"
 #include "Serialization/StructuredArchive.h"
@@ -125,6 +126,14 @@ public:
 	 */
 	void SetVersion(FGuid CustomKey, int32 Version, FName FriendlyName);
 
+	/**
+	 * Sets the currently registered version of a custom key in the container. The registered version is only looked up
+	 * the first time, as a registration can't change while the container uses it.
+	 *
+	 * @param CustomKey Custom key, which must have been registered with FCustomVersionRegistration.
+	 */
+	void SetCurrentVersion(FGuid CustomKey);
+
 	/** Serialization. */
 	void Serialize(FArchive& Ar, ECustomVersionSerializationFormat::Type Format = ECustomVersionSerializationFormat::Latest);
 	void Serialize(FStructuredArchive::FSlot Slot, ECustomVersionSerializationFormat::Type Format = ECustomVersionSerializationFormat::Latest);
@@ -152,9 +161,25 @@ public:
 
 private:
 
+	/** Position of a custom version in the array */
+	struct FVersionIndex
+	{
+		int32 Index;
+		/** Whether the version was set from the registered one by SetCurrentVersion */
+		bool bIsCurrent;
+	};
+
+	FCustomVersion* FindVersion(FGuid CustomKey);
+	void AddVersion(const FCustomVersion& Version);
+	void RemoveVersionAtSwap(int32 Index);
+	void RebuildIndices();
+
 	/** Array containing custom versions. */
 	FCustomVersionArray Versions;
 
+	/** Custom version array indices by key, so that lookups don't depend on how many versions the container holds */
+	TMap<FGuid, FVersionIndex> VersionIndices;
+
 };
 
 enum class ECustomVersionDifference { Missing, Newer, Older };
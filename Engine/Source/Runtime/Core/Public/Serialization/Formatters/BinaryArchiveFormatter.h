@@ -13,6 +13,7 @@ public:
 	virtual ~FBinaryArchiveFormatter();
 
 	virtual bool HasDocumentTree() const override;
+	virtual FBinaryArchiveFormatter* AsBinaryFormatter() override;
 	virtual FArchive& GetUnderlyingArchive() override;
 
 	virtual void EnterRecord() override;
@@ -77,6 +78,11 @@ private:
 	FArchive& Inner;
 };
 
+inline FBinaryArchiveFormatter* FBinaryArchiveFormatter::AsBinaryFormatter()
+{
+	return this;
+}
+
 inline FArchive& FBinaryArchiveFormatter::GetUnderlyingArchive()
 {
 	return Inner;
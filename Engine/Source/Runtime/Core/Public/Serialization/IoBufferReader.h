@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "HAL/UnrealMemory.h"
+#include "Containers/UnrealString.h"
+#include "Serialization/MemoryArchive.h"
+#include "IO/IoDispatcher.h"
+
+/**
+ * Archive for reading from an FIoBuffer. The reader holds a reference to the buffer, so the result of an I/O request can be
+ * deserialized as it is, without being copied into an array first, and the data stays alive for as long as the reader does.
+ */
+class FIoBufferReader : public FMemoryArchive
+{
+public:
+	/**
+  	 * Returns the name of the Archive.  Useful for getting the name of the package a struct or object
+	 * is in when a loading error occurs.
+	 *
+	 * This is overridden for the specific Archive Types
+	 **/
+	virtual FString GetArchiveName() const override
+	{
+		return TEXT("FIoBufferReader");
+	}
+
+	int64 TotalSize() final
+	{
+		return (int64)Buffer.DataSize();
+	}
+
+	/** Final so that calls made through this type are inlined, and the size lookup in them too */
+	void Serialize( void* Data, int64 Num ) final
+	{
+		if (Num && !ArIsError)
+		{
+			// Only serialize if we have the requested amount of data
+			if (Offset + Num <= TotalSize())
+			{
+				FMemory::Memcpy( Data, Buffer.Data() + Offset, Num );
+				Offset += Num;
+			}
+			else
+			{
+				ArIsError = true;
+			}
+		}
+	}
+
+	explicit FIoBufferReader( FIoBuffer InBuffer, bool bIsPersistent = false )
+		: Buffer(MoveTemp(InBuffer))
+	{
+		this->SetIsLoading(true);
+		this->SetIsPersistent(bIsPersistent);
+	}
+
+	/**
+	 * Returns the next Num bytes as a view that shares ownership of the buffer, and skips them. Use it for bulk data
+	 * that is kept after the load rather than serializing it into a copy.
+	 * Sets the error like Serialize when there isn't that much data left, and returns an empty buffer.
+	 */
+	FIoBuffer ReadSlice( int64 Num )
+	{
+		if (ArIsError || Num < 0 || Offset + Num > TotalSize())
+		{
+			ArIsError = true;
+			return FIoBuffer();
+		}
+
+		FIoBuffer Slice = Buffer.Slice(Offset, Num);
+		Offset += Num;
+		return Slice;
+	}
+
+	const FIoBuffer& GetBuffer() const
+	{
+		return Buffer;
+	}
+
+private:
+	FIoBuffer Buffer;
+};
@@ -3,15 +3,25 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/Array.h"
+
+class FIoBuffer;
+class IFileHandle;
 
 /**
 * Data storage for the large memory reader and writer.
+*
+* The data is kept in pages, so growing never copies what was written so far. The pages are only coalesced into
+* one block when GetData or ReleaseOwnership need a contiguous pointer; WriteToFile and ReleaseToIoBuffer do not.
 */
 
 class CORE_API FLargeMemoryData
 {
 public:
 
+	/** Size of the pages added once the first one is full. The first page is at least as large as the preallocation. */
+	static constexpr int64 PageSize = 1024 * 1024;
+
 	explicit FLargeMemoryData(const int64 PreAllocateBytes = 0);
 	~FLargeMemoryData();
 
@@ -33,25 +43,31 @@ public:
 		return NumBytes;
 	}
 
-	/** Returns the written data.  */
-	FORCEINLINE uint8* GetData()
-	{
-		return Data;
-	}
+	/** Returns the written data, coalescing the pages into one block if there are several. */
+	uint8* GetData();
 
-	/** Returns the written data.  */
+	/** Returns the written data, coalescing the pages into one block if there are several. */
 	FORCEINLINE const uint8* GetData() const
 	{
-		return Data;
+		return const_cast<FLargeMemoryData*>(this)->GetData();
 	}
 
-	/** Releases ownership of the written data. */
+	/** Releases ownership of the written data, coalescing the pages into one block if there are several. */
 	uint8* ReleaseOwnership();
 
+	/**
+	 * Releases ownership of the written data as an FIoBuffer. The pages are copied into the buffer one at a time and freed
+	 * as they are, so memory use does not double when there are several pages, and there is no copy at all if there is one.
+	 */
+	FIoBuffer ReleaseToIoBuffer();
+
+	/** Writes the data to a file handle one page at a time, without coalescing the pages. Returns true if all of it was written. */
+	bool WriteToFile(IFileHandle& FileHandle) const;
+
 	/** Check whether data is allocated or if the ownership was released. */
-	bool HasData() const 
+	bool HasData() const
 	{
-		return Data != nullptr;
+		return Pages.Num() > 0;
 	}
 
 	void Reserve(int64 Size);
@@ -62,15 +78,25 @@ private:
 	FLargeMemoryData(const FLargeMemoryData&) = delete;
 	FLargeMemoryData& operator=(const FLargeMemoryData&) = delete;
 
-	/** Memory owned by this archive. Ownership can be released by calling ReleaseOwnership() */
-	uint8* Data;
+	/** Memory owned by this archive, the first page holds FirstPageSize bytes and the others PageSize. Ownership can be released by calling ReleaseOwnership() */
+	TArray<uint8*> Pages;
+
+	/** Number of bytes allocated for the first page */
+	int64 FirstPageSize;
 
-	/** Number of bytes currently written to our data buffer */
+	/** Number of bytes currently written to our pages */
 	int64 NumBytes;
 
-	/** Number of bytes currently allocated for our data buffer */
-	int64 MaxBytes;
+	/** Number of bytes currently allocated for our pages */
+	FORCEINLINE int64 GetMaxBytes() const
+	{
+		return Pages.Num() ? FirstPageSize + (Pages.Num() - 1) * PageSize : 0;
+	}
+
+	/** Adds pages until there is room for at least NewMax bytes */
+	void AddPages(int64 NewMax);
 
-	/** Resizes the data buffer to at least NumBytes with some slack */
-	void GrowBuffer();
+	/** Calls Func with each page holding data between InOffset and InOffset + InNum, and the part of it to use */
+	template <typename FuncType>
+	void ForEachPageInRange(int64 InOffset, int64 InNum, FuncType&& Func) const;
 };
@@ -36,7 +36,7 @@ public:
 	}
 	
 	/**
-	 * Returns the written data. To release this archive's ownership of the data, call ReleaseOwnership()
+	 * Returns the written data, which is made contiguous first if it spans several pages. To release this archive's ownership of the data, call ReleaseOwnership()
 	 */
 	uint8* GetData() const;
 
@@ -51,6 +51,15 @@ public:
 		return Data.ReleaseOwnership();
 	}
 
+	/**
+	 * Releases ownership of the written data as an FIoBuffer, without holding the data twice in memory
+	 * as calling GetData first would when it spans several pages
+	 */
+	FIoBuffer ReleaseToIoBuffer();
+
+	/** Writes the data to a file handle without coalescing it first. Returns true if all of it was written. */
+	bool WriteToFile(IFileHandle& FileHandle) const;
+
 private:
 
 	FLargeMemoryData Data;
@@ -11,6 +11,7 @@
 #include "Serialization/MemoryLayout.h"
 #include "Serialization/MemoryImageWriter.h"
 #include "Templates/RefCounting.h"
+#include "Templates/UniquePtr.h"
 
 #if defined(WITH_RTTI) || defined(_CPPRTTI) || defined(__GXX_RTTI) || WITH_EDITOR
 #include <typeinfo>
@@ -72,9 +73,51 @@ struct FMemoryImageResult
 	TArray<FMemoryImageVTablePointer> VTables;
 	TArray<FMemoryImageNamePointer> Names;
 
+	/** Alignment of the frozen bytes in files written by SaveToMappableArchive, a multiple of the page size and mapping granularity of all platforms */
+	static constexpr uint32 MappableAlignment = 64u * 1024u;
+
 	CORE_API void SaveToArchive(FArchive& Ar) const;
 	CORE_API void ApplyPatches(void* FrozenObject) const;
 	CORE_API static void ApplyPatchesFromArchive(void* FrozenObject, FArchive& Ar);
+
+	/**
+	 * Writes the image in the format loaded by FMappedMemoryImage: a header and the patch tables, followed by the frozen bytes at a
+	 * file offset aligned to MappableAlignment. Must be written at the start of the file.
+	 */
+	CORE_API void SaveToMappableArchive(FArchive& Ar) const;
+};
+
+/**
+ * A frozen image written by FMemoryImageResult::SaveToMappableArchive, loaded by mapping the file instead of reading it.
+ *
+ * Only the header and patch tables are read up front. An image without vtables or names is mapped read only and used as is;
+ * otherwise it is mapped copy-on-write and patched in place, so only the pages holding patches become private to the process.
+ * Either way the other pages load lazily and are shared with the other processes mapping the same file.
+ * If the platform can't map the file the image is read into memory and patched there, as ApplyPatchesFromArchive would.
+ *
+ * The frozen objects must be destroyed before the image is.
+ */
+class CORE_API FMappedMemoryImage
+{
+public:
+	/** Returns null if the file can't be opened or wasn't written by SaveToMappableArchive */
+	static FMappedMemoryImage* Load(const TCHAR* Filename);
+
+	~FMappedMemoryImage();
+
+	void* GetFrozenObject() const { return FrozenObject; }
+	uint32 GetFrozenSize() const { return FrozenSize; }
+
+	/** True if the image is backed by a mapping of the file rather than a copy in memory */
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+private:
+	FMappedMemoryImage() = default;
+
+	TUniquePtr<class IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<class IMappedFileRegion> MappedRegion;
+	void* FrozenObject = nullptr;
+	uint32 FrozenSize = 0u;
 };
 
 class CORE_API FMemoryImageSection : public FRefCountedObject
@@ -165,8 +208,9 @@ public:
 
 	/** Merging duplicate sections will make the resulting memory image smaller.
 	 * This will only work for data that is expected to be read-only after freezing.  Merging sections will break any manual fix-ups applied to the frozen data
+	 * Grouping patched sections places the sections holding vtables or names right after the root, so patching the image touches as few pages as possible.
 	 */
-	void Flatten(FMemoryImageResult& OutResult, bool bMergeDuplicateSections = false);
+	void Flatten(FMemoryImageResult& OutResult, bool bMergeDuplicateSections = false, bool bGroupPatchedSections = false);
 
 	TArray<TRefCountPtr<FMemoryImageSection>> Sections;
 	TArray<const FTypeLayoutDesc*> TypeDependencies;
@@ -26,12 +26,13 @@ public:
 		return TEXT("FMemoryReader");
 	}
 
-	virtual int64 TotalSize() override
+	int64 TotalSize() final
 	{
 		return FMath::Min((int64)Bytes.Num(), LimitSize);
 	}
 
-	void Serialize( void* Data, int64 Num )
+	/** Final so that calls made through this type are inlined, and the size lookup in them too */
+	void Serialize( void* Data, int64 Num ) final
 	{
 		if (Num && !ArIsError)
 		{
@@ -84,12 +85,13 @@ public:
 		return TEXT("FMemoryReaderView");
 	}
 
-	virtual int64 TotalSize() override
+	int64 TotalSize() final
 	{
 		return FMath::Min((int64)Bytes.Num(), LimitSize);
 	}
 
-	void Serialize( void* Data, int64 Num )
+	/** Final so that calls made through this type are inlined, and the size lookup in them too */
+	void Serialize( void* Data, int64 Num ) final
 	{
 		if (Num && !ArIsError)
 		{
@@ -31,7 +31,8 @@ public:
 		}
 	}
 
-	virtual void Serialize(void* Data, int64 Num) override
+	/** Final so that calls made through this type are inlined */
+	void Serialize(void* Data, int64 Num) final
 	{
 		const int64 NumBytesToAdd = Offset + Num - Bytes.Num();
 		if( NumBytesToAdd > 0 )
@@ -61,7 +62,7 @@ public:
 	 **/
 	virtual FString GetArchiveName() const override { return TEXT("FMemoryWriter"); }
 
-	int64 TotalSize() override
+	int64 TotalSize() final
 	{
 		return Bytes.Num();
 	}
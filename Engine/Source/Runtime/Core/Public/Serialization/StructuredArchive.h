@@ -464,6 +464,12 @@ private:
 	FArchiveFormatterType& Formatter;
 
 #if WITH_TEXT_ARCHIVE_SUPPORT
+	/**
+	 * Set if the formatter is an FBinaryArchiveFormatter and the container checks are off. Slots then call it directly, without
+	 * virtual dispatch or tracking scopes, the way they do in builds without text archive support.
+	 */
+	FBinaryArchiveFormatter* const BinaryFormatter;
+
 	/**
 	 * Whether the formatter requires structural metadata. This allows optimizing the path for binary archives in editor builds.
 	 */
@@ -564,7 +570,7 @@ FORCEINLINE const FArchiveState& UE4StructuredArchive_Private::FSlotBase::GetArc
 FORCEINLINE bool FStructuredArchiveSlot::IsFilled() const
 {
 #if WITH_TEXT_ARCHIVE_SUPPORT
-	return Ar.CurrentSlotElementId != ElementId;
+	return Ar.BinaryFormatter || Ar.CurrentSlotElementId != ElementId;
 #else
 	return true;
 #endif
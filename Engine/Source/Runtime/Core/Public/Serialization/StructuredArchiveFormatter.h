@@ -22,6 +22,8 @@ struct FArchiveFieldName
 
 #define SA_FIELD_NAME(x) FArchiveFieldName(x)
 
+class FBinaryArchiveFormatter;
+
 /**
  * Specifies the type of a value in a slot. Used by FContextFreeArchiveFormatter for introspection.
  */
@@ -75,6 +77,9 @@ public:
 
 	virtual bool HasDocumentTree() const = 0;
 
+	/** Returns this formatter if it is an FBinaryArchiveFormatter, which structured archives call without virtual dispatch */
+	virtual FBinaryArchiveFormatter* AsBinaryFormatter() { return nullptr; }
+
 	virtual void EnterRecord() = 0;
 	virtual void EnterRecord_TextOnly(TArray<FString>& OutFieldNames) = 0;
 	virtual void LeaveRecord() = 0;
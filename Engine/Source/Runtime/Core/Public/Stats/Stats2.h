@@ -1325,6 +1325,14 @@ public:
 
 	FORCEINLINE_STATS void AddStatMessage( const FStatMessage& StatMessage )
 	{
+		// While the current chunk has room nothing is allocated, so the message is copied in without the LLM scope
+		// and the memory message lock, which only matter when a new chunk comes from the allocator.
+		if (Packet.StatMessages.Num() % (int32)((uint32)EStatMessagesArrayConstants::MESSAGES_CHUNK_SIZE / sizeof(FStatMessage)) != 0)
+		{
+			Packet.StatMessages.AddElement(StatMessage);
+			return;
+		}
+
 		LLM_SCOPE(ELLMTag::Stats);
 		FStatMessageLock MessageLock(MemoryMessageScope);
 		Packet.StatMessages.AddElement(StatMessage);
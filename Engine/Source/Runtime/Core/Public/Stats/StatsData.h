@@ -522,6 +522,12 @@ private:
 	/** Internal method to accumulate any non-frame stats. **/
 	void ProcessNonFrameStats( FStatMessagesArray& Data, TSet<FName>* NonFrameStatsFound );
 
+	/** Accumulates the non-frame stats at NonFrameIndices, found by FindNonFrameStats, in order. **/
+	void ProcessNonFrameStats( FStatMessagesArray& Data, const TArray<int32>& NonFrameIndices, TSet<FName>* NonFrameStatsFound );
+
+	/** Collects the indices of the messages that are not cleared every frame, touches no state so packets can be scanned in parallel. **/
+	static void FindNonFrameStats( const FStatMessagesArray& Data, TArray<int32>& OutNonFrameIndices );
+
 	/** Internal method to place the data into the history, discard and broadcast any new frames to anyone who cares. **/
 	void AddToHistoryAndEmpty( FStatPacketArray& NewData );
 
@@ -71,8 +71,15 @@ enum EStatMagicWithHeader : uint32
 	*/
 	VERSION_6 = 6,
 
+	/**
+	*	Added frame table checkpoints written periodically into regular stats files,
+	*	so files that were not finalized can still be read up to the last checkpoint.
+	*/
+	VERSION_7 = 7,
+	HAS_FRAME_TABLE_CHECKPOINTS_VER = VERSION_7,
+
 	/** Latest version. */
-	VERSION_LATEST = VERSION_6,
+	VERSION_LATEST = VERSION_7,
 };
 
 struct EStatsFileConstants
@@ -92,6 +99,9 @@ struct EStatsFileConstants
 
 		/** Indicates that the compression is disabled for the data. */
 		NO_COMPRESSION = 0,
+
+		/** Indicates a frame table checkpoint in place of the compressed size, followed by the size of the checkpoint. */
+		FRAME_TABLE_CHECKPOINT = 0xE0F0DA4B,
 	};
 };
 
@@ -177,6 +187,12 @@ protected:
 		{
 			bEndOfCompressedData = true;
 		}
+		// Frame table checkpoints are only read through the header, skip them like empty data.
+		else if( CompressedSize == EStatsFileConstants::FRAME_TABLE_CHECKPOINT )
+		{
+			DestData.Reset();
+			Reader.Seek( Reader.Tell() + UncompressedSize );
+		}
 		// This chunk is not compressed.
 		else if( CompressedSize == 0 )
 		{
@@ -233,6 +249,7 @@ struct FStatsStreamHeader
 		, MetadataMessagesOffset( 0 )
 		, NumMetadataMessages( 0 )
 		, bRawStatsFile( false )
+		, FrameTableCheckpointOffset( 0 )
 	{}
 
 	/**
@@ -264,6 +281,12 @@ struct FStatsStreamHeader
 	/** Whether this stats file uses raw data, required for thread view/memory profiling/advanced profiling. */
 	bool bRawStatsFile;
 
+	/**
+	 *	Offset in the file for the last frame table checkpoint, 0 if there is none. Only for regular stats files.
+	 *	Updated while the file is written, each checkpoint links to the one before it. @see FStatsWriteFile::WriteFrameTableCheckpoint
+	 */
+	uint64	FrameTableCheckpointOffset;
+
 	/** Whether this stats file has all names stored at the end of file. */
 	bool IsFinalized() const
 	{
@@ -276,6 +299,12 @@ struct FStatsStreamHeader
 		return Version >= EStatMagicWithHeader::HAS_COMPRESSED_DATA_VER;
 	}
 
+	/** Whether this stats file can be read up to its last frame table checkpoint even if it was not finalized. */
+	bool HasFrameTableCheckpoint() const
+	{
+		return Version >= EStatMagicWithHeader::HAS_FRAME_TABLE_CHECKPOINTS_VER && FrameTableCheckpointOffset > 0 && !bRawStatsFile;
+	}
+
 	/** Serialization operator. */
 	friend FArchive& operator << (FArchive& Ar, FStatsStreamHeader& Header)
 	{
@@ -300,6 +329,11 @@ struct FStatsStreamHeader
 
 		Ar << Header.bRawStatsFile;
 
+		if( Header.Version >= EStatMagicWithHeader::HAS_FRAME_TABLE_CHECKPOINTS_VER )
+		{
+			Ar << Header.FrameTableCheckpointOffset;
+		}
+
 		return Ar;
 	}
 };
@@ -520,9 +554,24 @@ protected:
 	/** Thread cycles for the last frame. */
 	TMap<uint32, int64> ThreadCycles;
 
+	/** FNames and metadata for the next frame table checkpoint, written by the stats thread and consumed by the async write thread. */
+	TArray<uint8> CheckpointData;
+
+	/** Frames written since the last frame table checkpoint. */
+	int32 NumFramesSinceCheckpoint;
+
+	/**
+	 *  Index in FramesInfo of the first frame that is not in a checkpoint yet.
+	 *  !!CAUTION!!
+	 *  Only used in the async write thread.
+	 */
+	int32 FirstFrameSinceCheckpoint;
+
 public:
 	/** Default constructor, set bRawStatsFile to false. */
 	FStatsWriteFile()
+		: NumFramesSinceCheckpoint( 0 )
+		, FirstFrameSinceCheckpoint( 0 )
 	{
 		Header.bRawStatsFile = false;
 	}
@@ -532,6 +581,13 @@ protected:
 
 	virtual void FinalizeSavingData( int64 FrameFileOffset ) override;
 
+	/**
+	 *	Appends a frame table checkpoint with the frames since the last one and the FNames and metadata in CheckpointData, and
+	 *	points the header at it. Called from the async write thread. A checkpoint starts with FRAME_TABLE_CHECKPOINT and its size,
+	 *	followed by the offset of the previous checkpoint, the new frames info, the FNames and the metadata messages.
+	 */
+	void WriteFrameTableCheckpoint( FArchive& Ar );
+
 	/**
 	 *	Grabs a frame from the local FStatsThreadState and adds it to the output.
 	 *	Called from the stats thread, but the data is saved using the the FAsyncStatsWrite. 
@@ -792,6 +848,62 @@ public:
 		Ar << FramesInfo;
 	}
 
+	/**
+	 *	Reads stats frames info, FNames and metadata messages from the frame table checkpoints, for regular stats files that were not finalized.
+	 *	The FNames and metadata come from the last checkpoint, which has all that were seen until then.
+	 *	@return false if a checkpoint is invalid
+	 */
+	bool ReadFrameTableCheckpoints( FArchive& Ar, TArray<FStatMessage>& out_MetadataMessages )
+	{
+		TArray<TArray<FStatsFrameInfo>> CheckpointFramesInfo;
+		uint64 CheckpointOffset = Header.FrameTableCheckpointOffset;
+		while( CheckpointOffset > 0 )
+		{
+			Ar.Seek( CheckpointOffset );
+			int32 Marker = 0;
+			int32 CheckpointSize = 0;
+			Ar << Marker << CheckpointSize;
+			if( Marker != EStatsFileConstants::FRAME_TABLE_CHECKPOINT || Ar.IsError() )
+			{
+				return false;
+			}
+
+			const bool bLastCheckpoint = CheckpointFramesInfo.Num() == 0;
+			const uint64 ThisCheckpointOffset = CheckpointOffset;
+			Ar << CheckpointOffset;
+			if( CheckpointOffset >= ThisCheckpointOffset )
+			{
+				return false;
+			}
+			Ar << CheckpointFramesInfo.AddDefaulted_GetRef();
+
+			if( bLastCheckpoint )
+			{
+				uint64 NumFNames = 0;
+				Ar << NumFNames;
+				for( uint64 Index = 0; Index < NumFNames && !Ar.IsError(); Index++ )
+				{
+					ReadFName( Ar, false );
+				}
+
+				uint64 NumMetadataMessages = 0;
+				Ar << NumMetadataMessages;
+				for( uint64 Index = 0; Index < NumMetadataMessages && !Ar.IsError(); Index++ )
+				{
+					new(out_MetadataMessages)FStatMessage( ReadMessage( Ar, true ) );
+				}
+			}
+		}
+
+		// Checkpoints were read from the last one.
+		FramesInfo.Reset();
+		for( int32 Index = CheckpointFramesInfo.Num() - 1; Index >= 0; Index-- )
+		{
+			FramesInfo.Append( MoveTemp( CheckpointFramesInfo[Index] ) );
+		}
+		return !Ar.IsError();
+	}
+
 	/**
 	 *	Reads FNames and metadata messages from the specified archive, only valid for finalized stats files.
 	 *	Allow unordered file access.
@@ -970,6 +1082,18 @@ public:
 		return NumFrames;
 	}
 
+	/**
+	 * Reads the condensed messages of a range of frames of a regular stats file, without reading the frames before them.
+	 * The frames are read from the file in order, then decompressed and decoded in parallel on the task threads.
+	 * Must not be called while the file is read and processed asynchronously.
+	 *
+	 * @param FirstFrameIndex - index of the first frame to read, between 0 and GetNumFrames
+	 * @param NumFramesToRead - number of frames to read
+	 * @param OutFrameMessages - condensed messages of each frame read, as they were written
+	 * @return false if the range is not in the file or the file is not a regular stats file
+	 */
+	bool ReadFrameRange( int32 FirstFrameIndex, int32 NumFramesToRead, TArray<TArray<FStatMessage>>& OutFrameMessages );
+
 protected:
 	/** Initialization constructor. */
 	FStatsReadFile( const TCHAR* InFilename, bool bInRawStatsFile );
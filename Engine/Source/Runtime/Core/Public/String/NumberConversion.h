@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/StringFwd.h"
+
+namespace UE
+{
+namespace String
+{
+	/**
+	 * Parse a number from the start of a string, like std::from_chars: no locale, no leading whitespace and no
+	 * allocation. Integers are an optional sign followed by decimal digits and are clamped to the range of the type.
+	 * Floating point numbers are an optional sign, decimal digits with an optional '.' and exponent, or inf, infinity
+	 * and nan in any case, and are always rounded to the nearest value like strtod in the "C" locale.
+	 *
+	 * @param String String starting with the number to parse.
+	 * @param OutValue [out] The parsed number, left unchanged if the string doesn't start with a number.
+	 *
+	 * @return Number of characters parsed, or 0 if the string doesn't start with a number.
+	 */
+	CORE_API int32 ParseNumber(const FStringView& String, int8& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, int16& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, int32& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, int64& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, uint8& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, uint16& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, uint32& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, uint64& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, float& OutValue);
+	CORE_API int32 ParseNumber(const FStringView& String, double& OutValue);
+
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, int8& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, int16& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, int32& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, int64& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, uint8& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, uint16& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, uint32& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, uint64& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, float& OutValue);
+	CORE_API int32 ParseNumber(const FAnsiStringView& String, double& OutValue);
+
+	/**
+	 * Append the shortest decimal string that ParseNumber reads back as exactly the same value, like std::to_chars.
+	 * Numbers from 1e-6 to 1e21 are written out in full, like 0.1 or 100, the others with an exponent, like 1.5e-7.
+	 * Infinities and NaNs are written as inf, -inf and nan.
+	 *
+	 * @param Builder The builder to append to.
+	 * @param Value The number to append.
+	 */
+	CORE_API void AppendShortest(FStringBuilderBase& Builder, float Value);
+	CORE_API void AppendShortest(FStringBuilderBase& Builder, double Value);
+	CORE_API void AppendShortest(FAnsiStringBuilderBase& Builder, float Value);
+	CORE_API void AppendShortest(FAnsiStringBuilderBase& Builder, double Value);
+}
+}
@@ -127,3 +127,20 @@ FORCEINLINE  typename TEnableIf<TIsEnum<EnumType>::Value, uint32>::Type GetTypeH
 {
 	return GetTypeHash((__underlying_type(EnumType))E);
 }
+
+/**
+ * Finds keys of KeyType by a key of another type for the ByKey() functions of TSet and TMap.
+ *
+ * By default the other key is used as is, so it must hash like KeyType and compare equal to it with ==, as FStringView
+ * and const TCHAR* do with FString. Specialize it for key types the other key has to be converted to first.
+ * Lookup() returns a default constructed result when no key of KeyType can match.
+ */
+template <typename KeyType, typename ComparableKey>
+struct TKeyLookup
+{
+	template <typename FindType>
+	static FORCEINLINE auto Lookup(const ComparableKey& Key, const FindType& Find) -> decltype(Find(Key))
+	{
+		return Find(Key);
+	}
+};
@@ -22,4 +22,14 @@ CORE_API void ReserveNameBatch(uint32 NameDataBytes, uint32 HashDataBytes);
 // Names are rehased if hash algorithm version doesn't match.
 //
 // @param NameData, HashData must be 8-byte aligned.
-CORE_API void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData);
\ No newline at end of file
+CORE_API void LoadNameBatch(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData);
+
+// Load a name blob like LoadNameBatch, with the entries of its names in shared memory instead of in this process.
+//
+// The first process to load a given batch writes the entries to a named shared memory region, the others map
+// it read-only, so they only allocate names created afterwards. A region is only shared between processes built
+// with the same name entry format. Builds with case preserving names load the batch privately.
+//
+// @param SharedMemoryName Prefix of the region name, the hash of the batch is appended to it.
+// @return Whether the entries are shared, otherwise the batch was loaded privately. Only one batch can be shared.
+CORE_API bool LoadNameBatchShared(TArray<FNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData, const TCHAR* SharedMemoryName);
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Math/NumericLimits.h"
+#include "UObject/NameTypes.h"
+
+namespace UE4NameLiteral_Private
+{
+	// constexpr port of CityHash64, must produce the same hashes as CityHash64() in Hash/CityHash.cpp.
+	// Bytes are read in little endian order and optionally lowercased on the fly like FNameHash does.
+
+	constexpr uint64 K0 = 0xc3a5c85c97cb3127ULL;
+	constexpr uint64 K1 = 0xb492b66fbe98f273ULL;
+	constexpr uint64 K2 = 0x9ae16a3b2f90404fULL;
+
+	struct FUint128
+	{
+		uint64 Lo;
+		uint64 Hi;
+	};
+
+	constexpr uint8 Byte(const ANSICHAR* Str, uint32 Index, bool bLowerCase)
+	{
+		// same as TChar<ANSICHAR>::ToLower, only ASCII is converted
+		return (bLowerCase && uint32(uint8(Str[Index])) - 'A' < 26u) ? uint8(uint8(Str[Index]) + 32) : uint8(Str[Index]);
+	}
+
+	constexpr uint64 Fetch64(const ANSICHAR* Str, uint32 Index, bool bLowerCase)
+	{
+		uint64 Result = 0;
+		for (uint32 ByteIndex = 0; ByteIndex < 8; ++ByteIndex)
+		{
+			Result |= uint64(Byte(Str, Index + ByteIndex, bLowerCase)) << (ByteIndex * 8);
+		}
+		return Result;
+	}
+
+	constexpr uint32 Fetch32(const ANSICHAR* Str, uint32 Index, bool bLowerCase)
+	{
+		uint32 Result = 0;
+		for (uint32 ByteIndex = 0; ByteIndex < 4; ++ByteIndex)
+		{
+			Result |= uint32(Byte(Str, Index + ByteIndex, bLowerCase)) << (ByteIndex * 8);
+		}
+		return Result;
+	}
+
+	constexpr uint64 ByteSwap64(uint64 Value)
+	{
+		uint64 Result = 0;
+		for (uint32 ByteIndex = 0; ByteIndex < 8; ++ByteIndex)
+		{
+			Result = (Result << 8) | ((Value >> (ByteIndex * 8)) & 0xff);
+		}
+		return Result;
+	}
+
+	constexpr uint64 Rotate(uint64 Value, int32 Shift)
+	{
+		return Shift == 0 ? Value : ((Value >> Shift) | (Value << (64 - Shift)));
+	}
+
+	constexpr uint64 ShiftMix(uint64 Value)
+	{
+		return Value ^ (Value >> 47);
+	}
+
+	constexpr uint64 HashLen16(uint64 U, uint64 V, uint64 Mul)
+	{
+		uint64 A = (U ^ V) * Mul;
+		A ^= (A >> 47);
+		uint64 B = (V ^ A) * Mul;
+		B ^= (B >> 47);
+		B *= Mul;
+		return B;
+	}
+
+	constexpr uint64 HashLen16(uint64 U, uint64 V)
+	{
+		return HashLen16(U, V, 0x9ddfea08eb382d69ULL);
+	}
+
+	constexpr uint64 HashLen0to16(const ANSICHAR* Str, uint32 Len, bool bLowerCase)
+	{
+		if (Len >= 8)
+		{
+			const uint64 Mul = K2 + Len * 2;
+			const uint64 A = Fetch64(Str, 0, bLowerCase) + K2;
+			const uint64 B = Fetch64(Str, Len - 8, bLowerCase);
+			const uint64 C = Rotate(B, 37) * Mul + A;
+			const uint64 D = (Rotate(A, 25) + B) * Mul;
+			return HashLen16(C, D, Mul);
+		}
+		if (Len >= 4)
+		{
+			const uint64 Mul = K2 + Len * 2;
+			const uint64 A = Fetch32(Str, 0, bLowerCase);
+			return HashLen16(Len + (A << 3), Fetch32(Str, Len - 4, bLowerCase), Mul);
+		}
+		if (Len > 0)
+		{
+			const uint8 A = Byte(Str, 0, bLowerCase);
+			const uint8 B = Byte(Str, Len >> 1, bLowerCase);
+			const uint8 C = Byte(Str, Len - 1, bLowerCase);
+			const uint32 Y = uint32(A) + (uint32(B) << 8);
+			const uint32 Z = Len + (uint32(C) << 2);
+			return ShiftMix(Y * K2 ^ Z * K0) * K2;
+		}
+		return K2;
+	}
+
+	constexpr uint64 HashLen17to32(const ANSICHAR* Str, uint32 Len, bool bLowerCase)
+	{
+		const uint64 Mul = K2 + Len * 2;
+		const uint64 A = Fetch64(Str, 0, bLowerCase) * K1;
+		const uint64 B = Fetch64(Str, 8, bLowerCase);
+		const uint64 C = Fetch64(Str, Len - 8, bLowerCase) * Mul;
+		const uint64 D = Fetch64(Str, Len - 16, bLowerCase) * K2;
+		return HashLen16(Rotate(A + B, 43) + Rotate(C, 30) + D, A + Rotate(B + K2, 18) + C, Mul);
+	}
+
+	constexpr FUint128 WeakHashLen32WithSeeds(uint64 W, uint64 X, uint64 Y, uint64 Z, uint64 A, uint64 B)
+	{
+		A += W;
+		B = Rotate(B + A + Z, 21);
+		const uint64 C = A;
+		A += X;
+		A += Y;
+		B += Rotate(A, 44);
+		return FUint128{ A + Z, B + C };
+	}
+
+	constexpr FUint128 WeakHashLen32WithSeeds(const ANSICHAR* Str, uint32 Index, uint64 A, uint64 B, bool bLowerCase)
+	{
+		return WeakHashLen32WithSeeds(Fetch64(Str, Index, bLowerCase), Fetch64(Str, Index + 8, bLowerCase), Fetch64(Str, Index + 16, bLowerCase), Fetch64(Str, Index + 24, bLowerCase), A, B);
+	}
+
+	constexpr uint64 HashLen33to64(const ANSICHAR* Str, uint32 Len, bool bLowerCase)
+	{
+		const uint64 Mul = K2 + Len * 2;
+		uint64 A = Fetch64(Str, 0, bLowerCase) * K2;
+		uint64 B = Fetch64(Str, 8, bLowerCase);
+		const uint64 C = Fetch64(Str, Len - 24, bLowerCase);
+		const uint64 D = Fetch64(Str, Len - 32, bLowerCase);
+		const uint64 E = Fetch64(Str, 16, bLowerCase) * K2;
+		const uint64 F = Fetch64(Str, 24, bLowerCase) * 9;
+		const uint64 G = Fetch64(Str, Len - 8, bLowerCase);
+		const uint64 H = Fetch64(Str, Len - 16, bLowerCase) * Mul;
+		const uint64 U = Rotate(A + G, 43) + (Rotate(B, 30) + C) * 9;
+		const uint64 V = ((A + G) ^ D) + F + 1;
+		const uint64 W = ByteSwap64((U + V) * Mul) + H;
+		const uint64 X = Rotate(E + F, 42) + C;
+		const uint64 Y = (ByteSwap64((V + W) * Mul) + G) * Mul;
+		const uint64 Z = E + F + C;
+		A = ByteSwap64((X + Z) * Mul + Y) + B;
+		B = ShiftMix((Z + A) * Mul + D + H) * Mul;
+		return B + X;
+	}
+
+	constexpr uint64 CityHash64(const ANSICHAR* Str, uint32 Len, bool bLowerCase)
+	{
+		if (Len <= 32)
+		{
+			return Len <= 16 ? HashLen0to16(Str, Len, bLowerCase) : HashLen17to32(Str, Len, bLowerCase);
+		}
+		else if (Len <= 64)
+		{
+			return HashLen33to64(Str, Len, bLowerCase);
+		}
+
+		uint64 X = Fetch64(Str, Len - 40, bLowerCase);
+		uint64 Y = Fetch64(Str, Len - 16, bLowerCase) + Fetch64(Str, Len - 56, bLowerCase);
+		uint64 Z = HashLen16(Fetch64(Str, Len - 48, bLowerCase) + Len, Fetch64(Str, Len - 24, bLowerCase));
+		FUint128 V = WeakHashLen32WithSeeds(Str, Len - 64, Len, Z, bLowerCase);
+		FUint128 W = WeakHashLen32WithSeeds(Str, Len - 32, Y + K1, X, bLowerCase);
+		X = X * K1 + Fetch64(Str, 0, bLowerCase);
+
+		uint32 Remaining = (Len - 1) & ~uint32(63);
+		uint32 Offset = 0;
+		do
+		{
+			X = Rotate(X + Y + V.Lo + Fetch64(Str, Offset + 8, bLowerCase), 37) * K1;
+			Y = Rotate(Y + V.Hi + Fetch64(Str, Offset + 48, bLowerCase), 42) * K1;
+			X ^= W.Hi;
+			Y += V.Lo + Fetch64(Str, Offset + 40, bLowerCase);
+			Z = Rotate(Z + W.Lo, 33) * K1;
+			V = WeakHashLen32WithSeeds(Str, Offset, V.Hi * K1, X + W.Lo, bLowerCase);
+			W = WeakHashLen32WithSeeds(Str, Offset + 32, Z + W.Hi, Y + Fetch64(Str, Offset + 16, bLowerCase), bLowerCase);
+			const uint64 Swap = Z;
+			Z = X;
+			X = Swap;
+			Offset += 64;
+			Remaining -= 64;
+		}
+		while (Remaining != 0);
+
+		return HashLen16(HashLen16(V.Lo, W.Lo) + ShiftMix(Y) * K1 + Z, HashLen16(V.Hi, W.Hi) + X);
+	}
+}
+
+/**
+ * An ANSI string literal with everything FName needs to look it up computed at compile time: the number suffix
+ * is split off the same way FName does it and the string is hashed both case-sensitively and case-insensitively.
+ * Constructing an FName from it skips hashing and case folding and goes straight to probing the name pool.
+ *
+ * Use UE_FNAME_LITERAL("Name") to make sure it is evaluated at compile time.
+ */
+struct FNameLiteral
+{
+	/** Name without number suffix, not null terminated when it has one */
+	const ANSICHAR* Str;
+	int32 Len;
+	/** Internal number, NAME_NO_NUMBER_INTERNAL when the literal has no number suffix */
+	int32 Number;
+	/** Hash of the lowercase name, FName comparisons are case-insensitive */
+	uint64 ComparisonHash;
+	/** Hash of the name as written, only used WITH_CASE_PRESERVING_NAME */
+	uint64 DisplayHash;
+
+	template<int32 N>
+	static constexpr FNameLiteral Make(const ANSICHAR (&Literal)[N])
+	{
+		FNameLiteral Result = { Literal, N - 1, NAME_NO_NUMBER_INTERNAL, 0, 0 };
+
+		// same rules as the runtime number parsing, "Name_12" is Name with number 12 but "Name_012" is not split
+		int32 Digits = 0;
+		while (Digits < Result.Len && Literal[Result.Len - 1 - Digits] >= '0' && Literal[Result.Len - 1 - Digits] <= '9')
+		{
+			++Digits;
+		}
+
+		const int32 FirstDigit = Result.Len - Digits;
+		if (Digits && Digits < Result.Len && Literal[FirstDigit - 1] == '_' && Digits <= 10 && (Digits == 1 || Literal[FirstDigit] != '0'))
+		{
+			int64 Value = 0;
+			for (int32 Index = FirstDigit; Index < Result.Len; ++Index)
+			{
+				Value = Value * 10 + (Literal[Index] - '0');
+			}
+
+			if (Value < MAX_int32)
+			{
+				Result.Number = NAME_EXTERNAL_TO_INTERNAL(int32(Value));
+				Result.Len = FirstDigit - 1;
+			}
+		}
+
+		Result.ComparisonHash = UE4NameLiteral_Private::CityHash64(Literal, Result.Len, true);
+		Result.DisplayHash = UE4NameLiteral_Private::CityHash64(Literal, Result.Len, false);
+		return Result;
+	}
+};
+
+/**
+ * Makes an FName from an ANSI string literal, with the hashing done at compile time. Equivalent to FName(TEXT(Literal)).
+ *
+ *		static const FName NAME_Foo = UE_FNAME_LITERAL("Foo");
+ *		Actor->Tags.Contains(UE_FNAME_LITERAL("Foo"));
+ */
+#define UE_FNAME_LITERAL(Literal) FName([]() { constexpr FNameLiteral UE_NameLiteral = FNameLiteral::Make(Literal); return UE_NameLiteral; }())
@@ -237,6 +237,9 @@ public:
 	/** Appends name to string builder. Entry must not be wide. */
 	CORE_API void AppendAnsiNameToString(FAnsiStringBuilderBase& OutString) const;
 
+	/** Appends name to string builder as UTF-8, encoded straight from the stored characters. */
+	CORE_API void AppendUtf8NameToString(FAnsiStringBuilderBase& OutString) const;
+
 	/** Appends name to string with path separator using FString::PathAppend(). */
 	CORE_API void AppendNameToPathString(FString& OutString) const;
 
@@ -388,6 +391,8 @@ struct FScriptName
 	uint32			Number = NAME_NO_NUMBER_INTERNAL;
 };
 
+struct FNameLiteral;
+
 /**
  * Public name, available to the world.  Names are stored as a combination of
  * an index into a table of unique strings and an instance number.
@@ -455,6 +460,19 @@ public:
 	 */
 	void ToString(FStringBuilderBase& Out) const;
 
+	/**
+	 * Converts an FName to a readable format, in place, only allocating if the name doesn't fit the inline storage
+	 *
+	 * @param Out String to fill with the string representation of the name
+	 */
+	template <int32 NumInlineChars>
+	void ToString(TInlineString<NumInlineChars>& Out) const
+	{
+		const int32 Len = int32(GetStringLength());
+		Out.GetCharArray().SetNumUninitialized(Len + 1, false);
+		ToString(Out.GetCharArray().GetData(), uint32(Len + 1));
+	}
+
 	/**
 	 * Get the number of characters, excluding null-terminator, that ToString() would yield
 	 */
@@ -503,6 +521,13 @@ public:
 	 */
 	bool TryAppendAnsiString(FAnsiStringBuilderBase& Out) const;
 
+	/**
+	 * Converts an FName to UTF-8 appended to the string builder, for network and file output without a TCHAR copy.
+	 *
+	 * @param Out A string builder to write the UTF-8 representation of the name into.
+	 */
+	void AppendUtf8String(FAnsiStringBuilderBase& Out) const;
+
 	/**
 	 * Check to see if this FName matches the other FName, potentially also checking for any case variations
 	 */
@@ -770,6 +795,12 @@ public:
 	explicit FName(const FStringView& Name, EFindName FindType=FNAME_Add);
 	explicit FName(const FAnsiStringView& Name, EFindName FindType=FNAME_Add);
 
+	/** Create FName from non-null UTF-8 with known length, ASCII names are stored without any conversion */
+	FName(int32 Len, const UTF8CHAR* Name, EFindName FindType=FNAME_Add);
+
+	/** Create FName from a literal hashed at compile time, see UE_FNAME_LITERAL in UObject/NameLiteral.h */
+	explicit FName(const FNameLiteral& Literal, EFindName FindType=FNAME_Add);
+
 	/**
 	 * Create an FName. If FindType is FNAME_Find, and the string part of the name 
 	 * doesn't already exist, then the name will be NAME_None
@@ -785,6 +816,7 @@ public:
 	FName(int32 Len, const ANSICHAR* Name, int32 InNumber, EFindName FindType = FNAME_Add);
 	FName(const FStringView& Name, int32 InNumber, EFindName FindType=FNAME_Add);
 	FName(const FAnsiStringView& Name, int32 InNumber, EFindName FindType=FNAME_Add);
+	FName(int32 Len, const UTF8CHAR* Name, int32 InNumber, EFindName FindType=FNAME_Add);
 
 	/**
 	 * Create an FName. If FindType is FNAME_Find, and the string part of the name 
@@ -804,6 +836,17 @@ public:
 	 */
 	FName(const FNameEntrySerialized& LoadedEntry);
 
+	/**
+	 * Finds the name of a string without adding it. Unlike FNAME_Find this tells a missing name from NAME_None.
+	 *
+	 * @param Name			Value for the string portion of the name, with an optional trailing number
+	 * @param OutName		The name that was found, NAME_None otherwise
+	 * @return true if the name exists
+	 */
+	static bool FindExisting(const FStringView& Name, FName& OutName);
+	static bool FindExisting(const FAnsiStringView& Name, FName& OutName);
+	static bool FindExisting(const TCHAR* Name, FName& OutName);
+
 	/**
 	 * Equality operator.
 	 *
@@ -934,6 +977,27 @@ FORCEINLINE uint32 GetTypeHash(FName Name)
 	return GetTypeHash(Name.GetComparisonIndex()) + Name.GetNumber();
 }
 
+/** Finds FName keys of TSet and TMap by string, see TSet::FindByKey(). Strings that aren't a name never create one. */
+template <typename StringType>
+struct TNameKeyLookup
+{
+	template <typename FindType>
+	static FORCEINLINE auto Lookup(const StringType& Key, const FindType& Find) -> decltype(Find(FName()))
+	{
+		FName Name;
+		if (FName::FindExisting(Key, Name))
+		{
+			return Find(Name);
+		}
+		return decltype(Find(Name))();
+	}
+};
+
+template <> struct TKeyLookup<FName, FStringView> : TNameKeyLookup<FStringView> {};
+template <> struct TKeyLookup<FName, FAnsiStringView> : TNameKeyLookup<FAnsiStringView> {};
+template <> struct TKeyLookup<FName, const TCHAR*> : TNameKeyLookup<const TCHAR*> {};
+template <> struct TKeyLookup<FName, TCHAR*> : TNameKeyLookup<const TCHAR*> {};
+
 FORCEINLINE FString LexToString(const FName& Name)
 {
 	return Name.ToString();
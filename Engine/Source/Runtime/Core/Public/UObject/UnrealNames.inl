@@ -138,6 +138,7 @@ REGISTER_NAME(256,Voice)
 REGISTER_NAME(257, Zlib)
 REGISTER_NAME(258, Gzip)
 REGISTER_NAME(259, LZ4)
+REGISTER_NAME(260, Zstd)
 
 // Online
 REGISTER_NAME(280,DGram)
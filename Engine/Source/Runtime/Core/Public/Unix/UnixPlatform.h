@@ -74,8 +74,20 @@ typedef FUnixPlatformTypes FPlatformTypes;
 
 #define PLATFORM_CODE_SECTION(Name)						__attribute__((section(Name)))
 
+// The IoDispatcher file backend uses io_uring when the toolchain has its kernel headers, see UnixPlatformIoDispatcher.h
+#if (PLATFORM_LINUX || PLATFORM_LINUXAARCH64) && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+		#define PLATFORM_IMPLEMENTS_IO						1
+	#endif
+#endif
+
 #define PLATFORM_ENABLE_POPCNT_INTRINSIC				1
 
+// Whether FPlatformTime::Cycles64 and trace timestamps read the CPU's timestamp counter when the kernel trusts it as its clock source
+#ifndef PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	#define PLATFORM_TIME_USES_TIMESTAMP_COUNTER		0
+#endif
+
 #if __has_feature(cxx_decltype_auto)
 	#define PLATFORM_COMPILER_HAS_DECLTYPE_AUTO 1
 #else
@@ -118,6 +130,7 @@ typedef FUnixPlatformTypes FPlatformTypes;
 	#define FORCEINLINE inline __attribute__ ((always_inline))			/* Force code to be inline */
 #endif // UE_BUILD_DEBUG
 #define FORCENOINLINE __attribute__((noinline))							/* Force code to NOT be inline */
+#define TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))		/* Reach a thread_local variable at a fixed offset from the thread pointer */
 #define FUNCTION_CHECK_RETURN_END __attribute__ ((warn_unused_result))	/* Wrap a function signature in this to warn that callers should not ignore the return value. */
 #define FUNCTION_NO_RETURN_END __attribute__ ((noreturn))				/* Wrap a function signature in this to indicate that the function never returns. */
 
@@ -31,6 +31,7 @@ public:
 	virtual bool DeleteFile(const TCHAR* Filename) override;
 	virtual bool IsReadOnly(const TCHAR* Filename) override;
 	virtual bool MoveFile(const TCHAR* To, const TCHAR* From) override;
+	virtual bool CopyFile(const TCHAR* To, const TCHAR* From, EPlatformFileRead ReadFlags = EPlatformFileRead::None, EPlatformFileWrite WriteFlags = EPlatformFileWrite::None) override;
 	virtual bool SetReadOnly(const TCHAR* Filename, bool bNewReadOnlyValue) override;
 
 
@@ -43,6 +44,7 @@ public:
 
 	virtual IFileHandle* OpenRead(const TCHAR* Filename, bool bAllowWrite = false) override;
 	virtual IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false) override;
+	virtual IMappedFileHandle* OpenMapped(const TCHAR* Filename) override;
 	virtual bool DirectoryExists(const TCHAR* Directory) override;
 	virtual bool CreateDirectory(const TCHAR* Directory) override;
 	virtual bool DeleteDirectory(const TCHAR* Directory) override;
@@ -55,7 +57,8 @@ public:
 	virtual bool IterateDirectoryStat(const TCHAR* Directory, FDirectoryStatVisitor& Visitor) override;
 
 protected:
-	bool IterateDirectoryCommon(const TCHAR* Directory, const TFunctionRef<bool(struct dirent*)>& Visitor);
+	/** Calls Visitor for each entry of the directory, with the descriptor of the open directory so entries can be stat'ed with fstatat */
+	bool IterateDirectoryCommon(const TCHAR* Directory, const TFunctionRef<bool(struct dirent*, int)>& Visitor);
 
 	/** We're logging an error message. */
 	bool bLoggingError = false;
@@ -75,6 +75,11 @@ struct CORE_API FUnixPlatformMemory : public FGenericPlatformMemory
 	static bool PageProtect(void* const Ptr, const SIZE_T Size, const bool bCanRead, const bool bCanWrite);
 	static void* BinnedAllocFromOS(SIZE_T Size);
 	static void BinnedFreeToOS(void* Ptr, SIZE_T Size);
+	static int32 GetNumaNodeCount();
+	static int32 GetCurrentNumaNode();
+	static uint64 GetNumaNodeProcessorMask(int32 Node);
+	static bool BindToNumaNode(void* Ptr, SIZE_T Size, int32 Node);
+	static int32 GetNumaNodeForAddress(const void* Ptr);
 
 	class FPlatformVirtualMemoryBlock : public FBasicVirtualMemoryBlock
 	{
@@ -130,7 +135,14 @@ struct CORE_API FUnixPlatformMemory : public FGenericPlatformMemory
 	static bool UnmapNamedSharedMemoryRegion(FSharedMemoryRegion * MemoryRegion);
 	static bool GetLLMAllocFunctions(void*(*&OutAllocFunction)(size_t), void(*&OutFreeFunction)(void*, size_t), int32& OutAlignment);
 	static CA_NO_RETURN void OnOutOfMemory(uint64 Size, uint32 Alignment);
+	static void UpdateCustomLLMTags();
 	//~ End FGenericPlatformMemory Interface
+
+	/**
+	 * Reads the stats from the OS right now. GetStats returns the values it read in the last memory.StatsCacheSeconds
+	 * instead, which is what per frame telemetry wants, this is for when they have to be exact like when running out of memory.
+	 */
+	static FPlatformMemoryStats GetStatsUncached();
 };
 
 typedef FUnixPlatformMemory FPlatformMemory;
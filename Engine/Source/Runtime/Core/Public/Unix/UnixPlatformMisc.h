@@ -80,6 +80,7 @@ struct CORE_API FUnixPlatformMisc : public FGenericPlatformMisc
 
 	static int32 NumberOfCores();
 	static int32 NumberOfCoresIncludingHyperthreads();
+	static const FCPUTopology& GetCPUTopology();
 	static FString GetOperatingSystemId();
 	static bool GetDiskTotalAndFreeSpace(const FString& InPath, uint64& TotalNumberOfBytes, uint64& NumberOfFreeBytes);
 
@@ -25,6 +25,20 @@ struct FUnixPlatformString : public
 		if(!String)
 			return 0;
 
+		// The C library scans many characters at a time, and so does Strlen16 for the TCHAR strings it has no function for
+		if (sizeof(CHAR) == 1)
+		{
+			return (int32)strlen((const ANSICHAR*)String);
+		}
+		else if (sizeof(CHAR) == 2)
+		{
+			return Strlen16((const UTF16CHAR*)String);
+		}
+		else if (sizeof(CHAR) == sizeof(wchar_t))
+		{
+			return (int32)wcslen((const wchar_t*)String);
+		}
+
 		int Len = 0;
 		while(String[Len])
 		{
@@ -33,6 +47,9 @@ struct FUnixPlatformString : public
 
 		return Len;
 	}
+
+	/** Length of a null terminated string of 16 bit characters, 16 bytes at a time */
+	CORE_API static int32 Strlen16(const UTF16CHAR* String);
 };
 
 typedef FUnixPlatformString FPlatformString;
@@ -8,6 +8,9 @@
 
 #include "CoreTypes.h"
 #include "GenericPlatform/GenericPlatformTime.h"
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER && PLATFORM_CPU_X86_FAMILY
+	#include <x86intrin.h>
+#endif
 
 /**
  * Unix implementation of the Time OS functions
@@ -32,6 +35,12 @@ struct CORE_API FUnixTime : public FGenericPlatformTime
 
 	static FORCEINLINE uint64 Cycles64()
 	{
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+		if (bUseTimestampCounter)
+		{
+			return ReadTimestampCounter();
+		}
+#endif
 		struct timespec ts;
 		clock_gettime(CLOCK_MONOTONIC, &ts);
 		return static_cast<uint64>(static_cast<uint64>(ts.tv_sec) * 1000000ULL + static_cast<uint64>(ts.tv_nsec) / 1000ULL);
@@ -39,6 +48,37 @@ struct CORE_API FUnixTime : public FGenericPlatformTime
 
 	static FCPUTime GetCPUTime();	
 
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	/**
+	 * Reads the timestamp counter of the CPU, which ticks at a constant rate on every core.
+	 * Only meaningful when IsUsingTimestampCounter.
+	 */
+	static FORCEINLINE uint64 ReadTimestampCounter()
+	{
+#if PLATFORM_CPU_X86_FAMILY
+		return __rdtsc();
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+		uint64 Value;
+		__asm__ volatile("mrs %0, cntvct_el0" : "=r"(Value));
+		return Value;
+#else
+		return 0;
+#endif
+	}
+#endif
+
+	/**
+	 * @return Whether Cycles64 counts ticks of the timestamp counter instead of microseconds.
+	 */
+	static FORCEINLINE bool IsUsingTimestampCounter()
+	{
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+		return bUseTimestampCounter;
+#else
+		return false;
+#endif
+	}
+
 	/**
 	 * Calibration log to be printed at later time
 	 */
@@ -49,6 +89,19 @@ private:
 	/** Clock source to use */
 	static int ClockSource;
 
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	/** Whether Cycles64 reads the timestamp counter, decided once by InitTiming */
+	static bool bUseTimestampCounter;
+
+	/**
+	 * Measures the rate of the timestamp counter if the kernel keeps it in step across cores and sockets.
+	 * Unix-specific.
+	 *
+	 * @return Ticks per second, or 0 if the counter can't be used.
+	 */
+	static uint64 CalibrateTimestampCounter();
+#endif
+
 	/** Log information about calibrating the clock. */
 	static char CalibrationLog[4096];
 
@@ -77,6 +77,7 @@ struct CORE_API FWindowsPlatformMisc
 	static bool IsValidAbsolutePathFormat(const FString& Path);
 	static int32 NumberOfCores();
 	static int32 NumberOfCoresIncludingHyperthreads();
+	static const FCPUTopology& GetCPUTopology();
 	static int32 NumberOfWorkerThreadsToSpawn();
 
 	static const TCHAR* GetPlatformFeaturesModuleName();
@@ -15,6 +15,7 @@ namespace Private {
 ////////////////////////////////////////////////////////////////////////////////
 bool	Writer_SendTo(const ANSICHAR*, uint32);
 bool	Writer_WriteTo(const ANSICHAR*);
+bool	Writer_ShareTo(const ANSICHAR*, uint32);
 
 
 
@@ -278,6 +279,18 @@ void Writer_InitializeControl()
 		}
 	);
 
+	Writer_ControlAddCommand("ShareTo", nullptr,
+		[] (void*, uint32 ArgC, ANSICHAR const* const* ArgV)
+		{
+			if (ArgC > 0)
+			{
+				// Optional second argument is the size of the ring in megabytes
+				uint32 RingSize = (ArgC > 1) ? uint32(FCStringAnsi::Atoi(ArgV[1])) << 20 : 0;
+				Writer_ShareTo(ArgV[0], RingSize);
+			}
+		}
+	);
+
 	Writer_ControlAddCommand("ToggleChannels", nullptr, 
 		[] (void*, uint32 ArgC, ANSICHAR const* const* ArgV) 
 		{
@@ -249,6 +249,36 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out + 1);
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Bionic has no shm_open() nor named semaphores, local traces use a socket
+UPTRINT SharedMemoryCreate(const ANSICHAR* Name, uint32 Size, void*& OutBase)
+{
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedMemoryClose(UPTRINT Handle, const ANSICHAR* Name, void* Base, uint32 Size)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedEventCreate(const ANSICHAR* Name)
+{
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventSignal(UPTRINT Handle)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventClose(UPTRINT Handle, const ANSICHAR* Name)
+{
+}
+
 } // namespace Private
 } // namespace Trace
 
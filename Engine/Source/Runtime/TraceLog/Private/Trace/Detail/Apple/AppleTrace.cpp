@@ -11,6 +11,7 @@
 #include <mach/mach_time.h>
 #include <netdb.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <sys/select.h>
@@ -281,6 +282,87 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out + 1);
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void SharedObjectPath(ANSICHAR (&Out)[128], const ANSICHAR* Name, const ANSICHAR* Suffix)
+{
+	ANSICHAR* __restrict Cursor = Out;
+	ANSICHAR* End = Out + sizeof(Out) - 1;
+	*Cursor++ = '/';
+	for (; *Name && Cursor < End; *Cursor++ = *Name++);
+	for (; *Suffix && Cursor < End; *Cursor++ = *Suffix++);
+	*Cursor = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedMemoryCreate(const ANSICHAR* Name, uint32 Size, void*& OutBase)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+
+	// A previous process may have left the object behind if it crashed
+	shm_unlink(Path);
+	int Fd = shm_open(Path, O_CREAT|O_EXCL|O_RDWR, S_IRUSR|S_IWUSR);
+	if (Fd < 0)
+	{
+		return 0;
+	}
+
+	void* Ptr = MAP_FAILED;
+	if (ftruncate(Fd, Size) == 0)
+	{
+		Ptr = mmap(nullptr, Size, PROT_READ|PROT_WRITE, MAP_SHARED, Fd, 0);
+	}
+
+	if (Ptr == MAP_FAILED)
+	{
+		close(Fd);
+		shm_unlink(Path);
+		return 0;
+	}
+
+	OutBase = Ptr;
+	return UPTRINT(Fd + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedMemoryClose(UPTRINT Handle, const ANSICHAR* Name, void* Base, uint32 Size)
+{
+	// Readers that have it mapped keep their mapping
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+	munmap(Base, Size);
+	close(int(Handle) - 1);
+	shm_unlink(Path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedEventCreate(const ANSICHAR* Name)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+
+	sem_unlink(Path);
+	sem_t* Semaphore = sem_open(Path, O_CREAT|O_EXCL, S_IRUSR|S_IWUSR, 0);
+	return (Semaphore != SEM_FAILED) ? UPTRINT(Semaphore) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventSignal(UPTRINT Handle)
+{
+	sem_post((sem_t*)Handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventClose(UPTRINT Handle, const ANSICHAR* Name)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+	sem_close((sem_t*)Handle);
+	sem_unlink(Path);
+}
+
 } // namespace Private
 } // namespace Trace
 
@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -16,6 +17,10 @@
 #if defined(_GNU_SOURCE)
 	#include <sys/syscall.h>
 #endif // _GNU_SOURCE
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER && PLATFORM_CPU_X86_FAMILY
+	#include <cpuid.h>
+	#include <x86intrin.h>
+#endif
 
 namespace Trace {
 namespace Private {
@@ -84,9 +89,96 @@ void ThreadDestroy(UPTRINT Handle)
 
 
 
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+////////////////////////////////////////////////////////////////////////////////
+static uint64 TimeReadTimestampCounter()
+{
+#if PLATFORM_CPU_X86_FAMILY
+	return __rdtsc();
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	uint64 Value;
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(Value));
+	return Value;
+#else
+	return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static uint64 TimeCalibrateTimestampCounter()
+{
+	// should decide like FUnixTime::CalibrateTimestampCounter() whether to use the counter, only the rates may differ a little
+#if PLATFORM_CPU_X86_FAMILY
+	const char* CounterSource = "tsc";
+#else
+	const char* CounterSource = "arch_sys_counter";
+#endif
+	char Source[64] = {};
+	int File = open("/sys/devices/system/clocksource/clocksource0/current_clocksource", O_RDONLY);
+	if (File == -1)
+	{
+		return 0;
+	}
+	ssize_t Size = read(File, Source, sizeof(Source) - 1);
+	close(File);
+	for (; Size > 0 && (Source[Size - 1] == '\n' || Source[Size - 1] == ' '); --Size)
+	{
+		Source[Size - 1] = 0;
+	}
+	for (const char *Lhs = Source, *Rhs = CounterSource; *Lhs || *Rhs; ++Lhs, ++Rhs)
+	{
+		if (*Lhs != *Rhs)
+		{
+			return 0;
+		}
+	}
+
+#if PLATFORM_CPU_X86_FAMILY
+	uint32 Eax = 0, Ebx = 0, Ecx = 0, Edx = 0;
+	if (!__get_cpuid(0x80000007, &Eax, &Ebx, &Ecx, &Edx) || !(Edx & (1 << 8)))
+	{
+		return 0;
+	}
+
+	struct timespec TimeSpec;
+	uint64 StartCounter = TimeReadTimestampCounter();
+	clock_gettime(CLOCK_MONOTONIC_RAW, &TimeSpec);
+	uint64 StartNs = uint64(TimeSpec.tv_sec) * 1000000000ull + uint64(TimeSpec.tv_nsec);
+	uint64 EndCounter, EndNs;
+	do
+	{
+		EndCounter = TimeReadTimestampCounter();
+		clock_gettime(CLOCK_MONOTONIC_RAW, &TimeSpec);
+		EndNs = uint64(TimeSpec.tv_sec) * 1000000000ull + uint64(TimeSpec.tv_nsec);
+	}
+	while (EndNs - StartNs < 20000000ull);
+	return uint64(double(EndCounter - StartCounter) * 1e9 / double(EndNs - StartNs));
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+	uint64 Frequency;
+	__asm__ volatile("mrs %0, cntfrq_el0" : "=r"(Frequency));
+	return Frequency;
+#else
+	return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static uint64 TimeGetTimestampCounterFrequency()
+{
+	static const uint64 Frequency = TimeCalibrateTimestampCounter();
+	return Frequency;
+}
+#endif // PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+
 ////////////////////////////////////////////////////////////////////////////////
 uint64 TimeGetFrequency()
 {
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	if (uint64 Frequency = TimeGetTimestampCounterFrequency())
+	{
+		return Frequency;
+	}
+#endif
 	return 1000000ull;
 }
 
@@ -94,6 +186,12 @@ uint64 TimeGetFrequency()
 uint64 TimeGetTimestamp()
 {
 	// should stay in sync with FPlatformTime::Cycles64() or the timeline will be broken!
+#if PLATFORM_TIME_USES_TIMESTAMP_COUNTER
+	if (TimeGetTimestampCounterFrequency())
+	{
+		return TimeReadTimestampCounter();
+	}
+#endif
 	struct timespec TimeSpec;
 	clock_gettime(CLOCK_MONOTONIC, &TimeSpec);
 	return static_cast<uint64>(static_cast<uint64>(TimeSpec.tv_sec) * 1000000ULL + static_cast<uint64>(TimeSpec.tv_nsec) / 1000ULL);
@@ -273,6 +371,87 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out + 1);
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void SharedObjectPath(ANSICHAR (&Out)[128], const ANSICHAR* Name, const ANSICHAR* Suffix)
+{
+	ANSICHAR* __restrict Cursor = Out;
+	ANSICHAR* End = Out + sizeof(Out) - 1;
+	*Cursor++ = '/';
+	for (; *Name && Cursor < End; *Cursor++ = *Name++);
+	for (; *Suffix && Cursor < End; *Cursor++ = *Suffix++);
+	*Cursor = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedMemoryCreate(const ANSICHAR* Name, uint32 Size, void*& OutBase)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+
+	// A previous process may have left the object behind if it crashed
+	shm_unlink(Path);
+	int Fd = shm_open(Path, O_CREAT|O_EXCL|O_RDWR, S_IRUSR|S_IWUSR);
+	if (Fd < 0)
+	{
+		return 0;
+	}
+
+	void* Ptr = MAP_FAILED;
+	if (ftruncate(Fd, Size) == 0)
+	{
+		Ptr = mmap(nullptr, Size, PROT_READ|PROT_WRITE, MAP_SHARED, Fd, 0);
+	}
+
+	if (Ptr == MAP_FAILED)
+	{
+		close(Fd);
+		shm_unlink(Path);
+		return 0;
+	}
+
+	OutBase = Ptr;
+	return UPTRINT(Fd + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedMemoryClose(UPTRINT Handle, const ANSICHAR* Name, void* Base, uint32 Size)
+{
+	// Readers that have it mapped keep their mapping
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+	munmap(Base, Size);
+	close(int(Handle) - 1);
+	shm_unlink(Path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedEventCreate(const ANSICHAR* Name)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+
+	sem_unlink(Path);
+	sem_t* Semaphore = sem_open(Path, O_CREAT|O_EXCL, S_IRUSR|S_IWUSR, 0);
+	return (Semaphore != SEM_FAILED) ? UPTRINT(Semaphore) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventSignal(UPTRINT Handle)
+{
+	sem_post((sem_t*)Handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventClose(UPTRINT Handle, const ANSICHAR* Name)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name, "");
+	sem_close((sem_t*)Handle);
+	sem_unlink(Path);
+}
+
 } // namespace Private
 } // namespace Trace
 
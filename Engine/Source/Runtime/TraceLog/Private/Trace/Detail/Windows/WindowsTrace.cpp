@@ -295,6 +295,79 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out) + 1;
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void SharedObjectPath(ANSICHAR (&Out)[128], const ANSICHAR* Name)
+{
+	const ANSICHAR* Prefix = "Local\\";
+	ANSICHAR* __restrict Cursor = Out;
+	ANSICHAR* End = Out + sizeof(Out) - 1;
+	for (; *Prefix; *Cursor++ = *Prefix++);
+	for (; *Name && Cursor < End; *Cursor++ = *Name++);
+	*Cursor = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedMemoryCreate(const ANSICHAR* Name, uint32 Size, void*& OutBase)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name);
+
+	HANDLE Mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, Size, Path);
+	if (Mapping == nullptr)
+	{
+		return 0;
+	}
+
+	// A reader still has the mapping of a previous trace open, it may be too small
+	if (GetLastError() == ERROR_ALREADY_EXISTS)
+	{
+		CloseHandle(Mapping);
+		return 0;
+	}
+
+	void* Ptr = MapViewOfFile(Mapping, FILE_MAP_ALL_ACCESS, 0, 0, Size);
+	if (Ptr == nullptr)
+	{
+		CloseHandle(Mapping);
+		return 0;
+	}
+
+	OutBase = Ptr;
+	return UPTRINT(Mapping) + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedMemoryClose(UPTRINT Handle, const ANSICHAR* Name, void* Base, uint32 Size)
+{
+	// Readers that have it mapped keep the mapping alive
+	UnmapViewOfFile(Base);
+	CloseHandle(HANDLE(Handle - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedEventCreate(const ANSICHAR* Name)
+{
+	ANSICHAR Path[128];
+	SharedObjectPath(Path, Name);
+
+	HANDLE Event = CreateEventA(nullptr, FALSE, FALSE, Path);
+	return (Event != nullptr) ? UPTRINT(Event) + 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventSignal(UPTRINT Handle)
+{
+	SetEvent(HANDLE(Handle - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedEventClose(UPTRINT Handle, const ANSICHAR* Name)
+{
+	CloseHandle(HANDLE(Handle - 1));
+}
+
 } // namespace Private
 } // namespace Trace
 
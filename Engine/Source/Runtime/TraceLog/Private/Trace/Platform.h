@@ -39,6 +39,13 @@ void	IoClose(UPTRINT Handle);
 ////////////////////////////////////////////////////////////////////////////////
 UPTRINT	FileOpen(const ANSICHAR* Path);
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT	SharedMemoryCreate(const ANSICHAR* Name, uint32 Size, void*& OutBase);
+void	SharedMemoryClose(UPTRINT Handle, const ANSICHAR* Name, void* Base, uint32 Size);
+UPTRINT	SharedEventCreate(const ANSICHAR* Name);
+void	SharedEventSignal(UPTRINT Handle);
+void	SharedEventClose(UPTRINT Handle, const ANSICHAR* Name);
+
 } // namespace Private
 } // namespace Trace
 
@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Trace/Config.h"
+
+#if UE_TRACE_ENABLED
+
+#include "Trace/Detail/Atomic.h"
+#include "Trace/Detail/SharedRing.h"
+#include "Trace/Platform.h"
+
+#include "Misc/CString.h"
+
+#include <string.h>
+
+namespace Trace {
+namespace Private {
+
+////////////////////////////////////////////////////////////////////////////////
+static const UPTRINT	GSharedRingHandle		= UPTRINT(1) << (sizeof(UPTRINT) * 8 - 1); // never a platform IO handle
+static const uint32		GSharedRingHeaderSize	= 4 << 10; // keeps the ring page aligned
+static const uint32		GSharedRingMinSize		= 1 << 20;
+static const uint32		GSharedRingMaxSize		= 1 << 30;
+static const uint32		GSharedRingDefaultSize	= 64 << 20;
+static const uint32		GSharedRingTimeoutMs	= 10 * 1000; // a full ring that isn't read for this long means the reader is gone
+
+////////////////////////////////////////////////////////////////////////////////
+static struct FSharedRing
+{
+	FSharedRingHeader*	Header;				// = nullptr while there is no ring
+	uint8*				Data;
+	UPTRINT				Memory;
+	UPTRINT				Event;
+	uint32				RingSize;
+	uint64				WritePos;			// a copy of Header->WritePos, the reader can't change it
+	uint64				SignalledPos;		// Header->WritePos when the event was last signalled
+	ANSICHAR			Name[64];
+	ANSICHAR			EventName[72];
+} GSharedRing;
+
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SharedRingOpen(const ANSICHAR* Name, uint32 RingSize)
+{
+	FSharedRing& Ring = GSharedRing;
+	if (Ring.Header != nullptr || !Name[0])
+	{
+		return 0;
+	}
+
+	RingSize = RingSize ? RingSize : GSharedRingDefaultSize;
+	RingSize = (RingSize < GSharedRingMinSize) ? GSharedRingMinSize : RingSize;
+	RingSize = (RingSize > GSharedRingMaxSize) ? GSharedRingMaxSize : RingSize;
+	for (; RingSize & (RingSize - 1); RingSize &= RingSize - 1); // down to a power of two
+
+	FCStringAnsi::Strncpy(Ring.Name, Name, sizeof(Ring.Name));
+	FCStringAnsi::Strncpy(Ring.EventName, Ring.Name, sizeof(Ring.Name));
+	FCStringAnsi::Strcat(Ring.EventName, ".Event");
+
+	void* Base = nullptr;
+	Ring.Memory = SharedMemoryCreate(Ring.Name, GSharedRingHeaderSize + RingSize, Base);
+	if (!Ring.Memory)
+	{
+		return 0;
+	}
+
+	Ring.Event = SharedEventCreate(Ring.EventName);
+	if (!Ring.Event)
+	{
+		SharedMemoryClose(Ring.Memory, Ring.Name, Base, GSharedRingHeaderSize + RingSize);
+		Ring.Memory = 0;
+		return 0;
+	}
+
+	FSharedRingHeader* Header = (FSharedRingHeader*)Base;
+	Header->Version = FSharedRingHeader::VersionValue;
+	Header->HeaderSize = GSharedRingHeaderSize;
+	Header->RingSize = RingSize;
+	Header->WritePos = 0;
+	Header->ReadPos = 0;
+	Header->bClosed = 0;
+
+	// Readers know the header is valid once they see the magic
+	AtomicStoreRelease(&Header->Magic, uint32(FSharedRingHeader::MagicValue));
+
+	Ring.Header = Header;
+	Ring.Data = (uint8*)Base + GSharedRingHeaderSize;
+	Ring.RingSize = RingSize;
+	Ring.WritePos = 0;
+	Ring.SignalledPos = 0;
+	return GSharedRingHandle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SharedRingIsHandle(UPTRINT Handle)
+{
+	return Handle == GSharedRingHandle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SharedRingWrite(UPTRINT Handle, const void* Data, uint32 Size)
+{
+	FSharedRing& Ring = GSharedRing;
+	if (Ring.Header == nullptr)
+	{
+		return false;
+	}
+
+	const uint8* __restrict Cursor = (const uint8*)Data;
+	for (uint32 WaitMs = 0; Size;)
+	{
+		uint64 ReadPos = AtomicLoadAcquire(&Ring.Header->ReadPos);
+		uint64 Used = Ring.WritePos - ReadPos;
+		if (Used > Ring.RingSize)
+		{
+			// The reader stored a position that was never written, it is broken
+			return false;
+		}
+
+		uint32 Free = Ring.RingSize - uint32(Used);
+		if (Free == 0)
+		{
+			if (WaitMs >= GSharedRingTimeoutMs)
+			{
+				return false;
+			}
+
+			// Like a blocking socket, wait for the reader to make some space
+			if (WaitMs == 0)
+			{
+				Ring.SignalledPos = Ring.WritePos;
+				SharedEventSignal(Ring.Event);
+			}
+			ThreadSleep(1);
+			++WaitMs;
+			continue;
+		}
+
+		uint32 Offset = uint32(Ring.WritePos) & (Ring.RingSize - 1);
+		uint32 ChunkSize = (Size < Free) ? Size : Free;
+		uint32 HeadSize = Ring.RingSize - Offset;
+		HeadSize = (ChunkSize < HeadSize) ? ChunkSize : HeadSize;
+		memcpy(Ring.Data + Offset, Cursor, HeadSize);
+		memcpy(Ring.Data, Cursor + HeadSize, ChunkSize - HeadSize);
+
+		Cursor += ChunkSize;
+		Size -= ChunkSize;
+		Ring.WritePos += ChunkSize;
+		AtomicStoreRelease(&Ring.Header->WritePos, Ring.WritePos);
+		WaitMs = 0;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedRingFlush(UPTRINT Handle)
+{
+	// Signalled once per batch of writes rather than once per packet
+	FSharedRing& Ring = GSharedRing;
+	if (Ring.Header != nullptr && Ring.SignalledPos != Ring.WritePos)
+	{
+		Ring.SignalledPos = Ring.WritePos;
+		SharedEventSignal(Ring.Event);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SharedRingClose(UPTRINT Handle)
+{
+	FSharedRing& Ring = GSharedRing;
+	if (Ring.Header == nullptr)
+	{
+		return;
+	}
+
+	AtomicStoreRelease(&Ring.Header->bClosed, 1u);
+	SharedEventSignal(Ring.Event);
+
+	SharedEventClose(Ring.Event, Ring.EventName);
+	SharedMemoryClose(Ring.Memory, Ring.Name, Ring.Header, GSharedRingHeaderSize + Ring.RingSize);
+
+	Ring.Header = nullptr;
+	Ring.Data = nullptr;
+	Ring.Memory = 0;
+	Ring.Event = 0;
+}
+
+} // namespace Private
+} // namespace Trace
+
+#endif // UE_TRACE_ENABLED
@@ -15,6 +15,9 @@ namespace Private
 ////////////////////////////////////////////////////////////////////////////////
 bool	Writer_SendTo(const ANSICHAR*, uint32);
 bool	Writer_WriteTo(const ANSICHAR*);
+bool	Writer_ShareTo(const ANSICHAR*, uint32);
+bool	Writer_WriteSnapshotTo(const ANSICHAR*);
+bool	Writer_Configure(const FInitializeDesc&);
 
 } // namespace Private
 
@@ -42,6 +45,13 @@ bool Initialize()
 	return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Initialize(const FInitializeDesc& Desc)
+{
+	FChannel::ToggleAll(false);
+	return Private::Writer_Configure(Desc);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool SendTo(const TCHAR* InHost, uint32 Port)
 {
@@ -58,6 +68,22 @@ bool WriteTo(const TCHAR* InPath)
 	return Private::Writer_WriteTo(Path);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ShareTo(const TCHAR* InName, uint32 RingSize)
+{
+	char Name[64];
+	ToAnsiCheap(Name, InName);
+	return Private::Writer_ShareTo(Name, RingSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WriteSnapshotTo(const TCHAR* InPath)
+{
+	char Path[512];
+	ToAnsiCheap(Path, InPath);
+	return Private::Writer_WriteSnapshotTo(Path);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool ToggleChannel(const TCHAR* ChannelName, bool bEnabled)
 {
@@ -18,18 +18,36 @@ int32	Encode(const void*, int32, void*, int32);
 void	Writer_UpdateControl();
 void	Writer_InitializeControl();
 void	Writer_ShutdownControl();
+UPTRINT	SharedRingOpen(const ANSICHAR*, uint32);
+bool	SharedRingIsHandle(UPTRINT);
+bool	SharedRingWrite(UPTRINT, const void*, uint32);
+void	SharedRingFlush(UPTRINT);
+void	SharedRingClose(UPTRINT);
+
+////////////////////////////////////////////////////////////////////////////////
+// Data handles are platform IO handles or the shared memory ring of ShareTo()
+static bool Writer_IoWrite(UPTRINT Handle, const void* Data, uint32 Size)
+{
+	return SharedRingIsHandle(Handle) ? SharedRingWrite(Handle, Data, Size) : IoWrite(Handle, Data, Size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_IoClose(UPTRINT Handle)
+{
+	if (SharedRingIsHandle(Handle))
+	{
+		SharedRingClose(Handle);
+		return;
+	}
+
+	IoClose(Handle);
+}
 
 
 
 ////////////////////////////////////////////////////////////////////////////////
 #define TRACE_PRIVATE_PERF 0
 #if TRACE_PRIVATE_PERF
-UE_TRACE_EVENT_BEGIN($Trace, WorkerThread)
-	UE_TRACE_EVENT_FIELD(uint32, Cycles)
-	UE_TRACE_EVENT_FIELD(uint32, BytesReaped)
-	UE_TRACE_EVENT_FIELD(uint32, BytesSent)
-UE_TRACE_EVENT_END()
-
 UE_TRACE_EVENT_BEGIN($Trace, Memory)
 	UE_TRACE_EVENT_FIELD(uint32, AllocSize)
 UE_TRACE_EVENT_END()
@@ -44,6 +62,13 @@ inline uint64 Writer_GetTimestamp()
 	return TimeGetTimestamp() - GStartCycle;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+inline uint32 Writer_GetTimeMs()
+{
+	static const uint64 CyclesPerMs = TimeGetFrequency() / 1000;
+	return uint32(Writer_GetTimestamp() / CyclesPerMs);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Writer_InitializeTiming()
 {
@@ -72,21 +97,39 @@ TRACELOG_API uint32 volatile	GLogSerial;			// = 0;
 ////////////////////////////////////////////////////////////////////////////////
 struct FWriteTlsContext
 {
-				~FWriteTlsContext();
-	uint32		GetThreadId();
+					~FWriteTlsContext();
+	uint32			GetThreadId();
+	FWriteBuffer*	BufferReserve = nullptr; // buffers taken from the pool ahead of being written to
 
 private:
-	uint32		ThreadId = 0;
+	uint32			ThreadId = 0;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_FreeBuffers(FWriteBuffer* Head, FWriteBuffer* Tail);
+
 ////////////////////////////////////////////////////////////////////////////////
 FWriteTlsContext::~FWriteTlsContext()
 {
-	if (GInitialized && GTlsWriteBuffer != &GNullWriteBuffer)
+	if (!GInitialized)
+	{
+		return;
+	}
+
+	if (GTlsWriteBuffer != &GNullWriteBuffer)
 	{
 		UPTRINT EtxOffset = UPTRINT((uint8*)GTlsWriteBuffer - GTlsWriteBuffer->Cursor);
 		AtomicStoreRelaxed(&(GTlsWriteBuffer->EtxOffset), EtxOffset);
 	}
+
+	// Give the buffers this thread didn't get to use back to the pool
+	if (BufferReserve != nullptr)
+	{
+		FWriteBuffer* Tail = BufferReserve;
+		for (; Tail->NextBuffer != nullptr; Tail = Tail->NextBuffer);
+		Writer_FreeBuffers(BufferReserve, Tail);
+		BufferReserve = nullptr;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,15 +152,67 @@ thread_local FWriteTlsContext	GTlsContext;
 
 ////////////////////////////////////////////////////////////////////////////////
 #define T_ALIGN alignas(PLATFORM_CACHE_LINE_SIZE)
-static const uint32						GPoolSize			= 384 << 20; // 384MB ought to be enough
-static const uint32						GPoolBlockSize		= 4 << 10;
-static const uint32						GPoolPageGrowth		= GPoolBlockSize << 5;
-static const uint32						GPoolInitPageSize	= GPoolBlockSize << 5;
+static const uint32						GPoolMinBlockSize	= 4 << 10;
+static const uint32						GPoolMaxBlockSize	= 16 << 10;
+static const uint32						GPoolBatchSize		= 8; // buffers per batch on the free list
+static uint32							GPoolSize			= 384 << 20; // see Writer_Configure()
+static uint32							GPoolBlockSize		= GPoolMinBlockSize;
+static uint32							GPoolPageGrowth		= GPoolMinBlockSize << 5;
+static EPoolOverflow					GPoolOverflow		= EPoolOverflow::Block;
+static const uint32						GCompressMaxThreads	= 8;
+static uint32							GCompressThreadCount; // = 0, see Writer_Configure()
+static uint32							GFlightRecorderSize;	// = 0
+static uint32							GFlightRecorderSeconds;	// = 0
 static uint8*							GPoolBase;			// = nullptr;
 T_ALIGN static uint8* volatile			GPoolPageCursor;	// = nullptr;
 T_ALIGN static FWriteBuffer* volatile	GPoolFreeList;		// = nullptr;
 T_ALIGN static FWriteBuffer* volatile	GNewThreadList;		// = nullptr;
+T_ALIGN static uint32 volatile			GDroppedEventCount;	// = 0
+T_ALIGN static bool volatile			GDropOldestRequest;	// = false
 #undef T_ALIGN
+static thread_local bool				GTlsIsWorkerThread;	// = false
+
+////////////////////////////////////////////////////////////////////////////////
+// Events that don't fit in the pool are written here when they are dropped. Its
+// cursor is never moved so each dropped event goes through Writer_NextBuffer().
+static struct FDropBuffer
+{
+	uint8			Data[GPoolMaxBlockSize];
+	FWriteBuffer	Buffer;
+} GDropBuffer = { {}, { 0, 0, nullptr, nullptr, (uint8*)&GDropBuffer.Buffer } };
+
+////////////////////////////////////////////////////////////////////////////////
+bool Writer_Configure(const FInitializeDesc& Desc)
+{
+	uint32 BlockSize = GPoolMinBlockSize;
+	while (BlockSize < Desc.BlockSize && BlockSize < GPoolMaxBlockSize)
+	{
+		BlockSize <<= 1;
+	}
+
+	// The pool grows a page at a time and always has room for one
+	uint32 PageGrowth = BlockSize << 5;
+	uint32 PoolSize = (Desc.PoolSizeLimit / PageGrowth) * PageGrowth;
+	PoolSize = (PoolSize > PageGrowth) ? PoolSize : PageGrowth;
+
+	uint32 CompressThreadCount = (Desc.CompressionThreadCount < GCompressMaxThreads) ? Desc.CompressionThreadCount : GCompressMaxThreads;
+
+	// The pool is reserved on the first traced event, after which it can't change
+	if (GInitialized)
+	{
+		return BlockSize == GPoolBlockSize && PoolSize == GPoolSize && Desc.Overflow == GPoolOverflow && CompressThreadCount == GCompressThreadCount
+			&& Desc.FlightRecorderSize == GFlightRecorderSize && Desc.FlightRecorderSeconds == GFlightRecorderSeconds;
+	}
+
+	GPoolBlockSize = BlockSize;
+	GPoolPageGrowth = PageGrowth;
+	GPoolSize = PoolSize;
+	GPoolOverflow = Desc.Overflow;
+	GCompressThreadCount = CompressThreadCount;
+	GFlightRecorderSize = Desc.FlightRecorderSize;
+	GFlightRecorderSeconds = Desc.FlightRecorderSeconds;
+	return true;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 #if !IS_MONOLITHIC
@@ -130,32 +225,48 @@ TRACELOG_API FWriteBuffer* Writer_GetBuffer()
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
-static FWriteBuffer* Writer_NextBufferInternal(uint32 PageGrowth)
+static void Writer_FreeBuffers(FWriteBuffer* Head, FWriteBuffer* Tail)
+{
+	// The pool's free list is a list of batches linked by NextThread, each batch
+	// being a list of buffers linked by NextBuffer. Head..Tail becomes one batch.
+	Tail->NextBuffer = nullptr;
+	for (;; Private::PlatformYield())
+	{
+		Head->NextThread = AtomicLoadRelaxed(&GPoolFreeList);
+		if (AtomicCompareExchangeRelease(&GPoolFreeList, Head, Head->NextThread))
+		{
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static FWriteBuffer* Writer_RefillReserve(uint32 PageGrowth)
 {
-	// Fetch a new buffer
-	FWriteBuffer* NextBuffer;
+	// Threads take whole batches of buffers from the pool at a time so that at
+	// high event rates they only contend on the pool once every few buffers.
 	while (true)
 	{
-		// First we'll try one from the free list
+		// First we'll try a batch from the free list
 		FWriteBuffer* Owned = AtomicLoadRelaxed(&GPoolFreeList);
 		if (Owned != nullptr)
 		{
-			if (!AtomicCompareExchangeRelaxed(&GPoolFreeList, Owned->NextBuffer, Owned))
+			if (!AtomicCompareExchangeAcquire(&GPoolFreeList, Owned->NextThread, Owned))
 			{
 				Private::PlatformYield();
 				continue;
 			}
+
+			return Owned;
 		}
 
-		// If we didn't fetch the sentinal then we've taken a block we can use
-		if (Owned != nullptr)
+		// The free list is empty. Map some more memory if the pool isn't full.
+		uint8* PageBase = (uint8*)AtomicLoadRelaxed(&GPoolPageCursor);
+		if (PageBase + PageGrowth > GPoolBase + GPoolSize)
 		{
-			NextBuffer = (FWriteBuffer*)Owned;
-			break;
+			return nullptr;
 		}
 
-		// The free list is empty. Map some more memory.
-		uint8* PageBase = (uint8*)AtomicLoadRelaxed(&GPoolPageCursor);
 		if (!AtomicCompareExchangeAcquire(&GPoolPageCursor, PageBase + PageGrowth, PageBase))
 		{
 			// Someone else is mapping memory so we'll briefly yield and try the
@@ -164,38 +275,42 @@ static FWriteBuffer* Writer_NextBufferInternal(uint32 PageGrowth)
 			continue;
 		}
 
-		// We claimed the pool cursor so it is now our job to map memory and add
-		// it to the free list.
+		// We claimed the pool cursor so it is now our job to map memory. The whole
+		// page becomes this thread's reserve. Note that the buffer objects are at
+		// the _end_ of their blocks.
 		MemoryMap(PageBase, PageGrowth);
 
-		// The first block in the page we'll use for the next buffer. Note that the
-		// buffer objects are at the _end_ of their blocks.
-		PageBase += GPoolBlockSize - sizeof(FWriteBuffer);
-		NextBuffer = (FWriteBuffer*)PageBase;
-		uint8* FirstBlock = PageBase + GPoolBlockSize;
-
-		// Link subsequent blocks together
-		uint8* Block = FirstBlock;
-		for (int i = 2, n = PageGrowth / GPoolBlockSize; i < n; ++i)
+		uint8* Block = PageBase + GPoolBlockSize - sizeof(FWriteBuffer);
+		auto* FirstBuffer = (FWriteBuffer*)Block;
+		for (int i = 1, n = PageGrowth / GPoolBlockSize; i < n; ++i)
 		{
 			auto* Buffer = (FWriteBuffer*)Block;
 			Buffer->NextBuffer = (FWriteBuffer*)(Block + GPoolBlockSize);
 			Block += GPoolBlockSize;
 		}
+		((FWriteBuffer*)Block)->NextBuffer = nullptr;
+
+		return FirstBuffer;
+	}
+}
 
-		// And insert the block list into the freelist. 'Block' is now the last block
-		for (auto* ListNode = (FWriteBuffer*)Block;; Private::PlatformYield())
+////////////////////////////////////////////////////////////////////////////////
+static FWriteBuffer* Writer_NextBufferInternal(uint32 PageGrowth)
+{
+	// Fetch a new buffer from this thread's reserve, refilling it if needed
+	FWriteTlsContext& TlsContext = GTlsContext;
+	if (TlsContext.BufferReserve == nullptr)
+	{
+		TlsContext.BufferReserve = Writer_RefillReserve(PageGrowth);
+		if (TlsContext.BufferReserve == nullptr)
 		{
-			ListNode->NextBuffer = AtomicLoadRelaxed(&GPoolFreeList);
-			if (AtomicCompareExchangeRelease(&GPoolFreeList, (FWriteBuffer*)FirstBlock, ListNode->NextBuffer))
-			{
-				break;
-			}
+			return nullptr;
 		}
-
-		break;
 	}
 
+	FWriteBuffer* NextBuffer = TlsContext.BufferReserve;
+	TlsContext.BufferReserve = NextBuffer->NextBuffer;
+
 	NextBuffer->Cursor = ((uint8*)NextBuffer - GPoolBlockSize + sizeof(FWriteBuffer));
 	NextBuffer->Cursor += sizeof(uint32); // this is so we can preceed event data with a small header when sending.
 	NextBuffer->Committed = NextBuffer->Cursor;
@@ -248,10 +363,29 @@ TRACELOG_API FWriteBuffer* Writer_NextBuffer(int32 Size)
 		CurrentBuffer->Cursor -= Size;
 	}
 
-	FWriteBuffer* NextBuffer = Writer_NextBufferInternal(GPoolPageGrowth);
+	while (true)
+	{
+		if (FWriteBuffer* NextBuffer = Writer_NextBufferInternal(GPoolPageGrowth))
+		{
+			NextBuffer->Cursor += Size;
+			return NextBuffer;
+		}
+
+		// The pool is exhausted. The worker thread can't wait on itself to free
+		// buffers so it always drops its events.
+		if (GPoolOverflow == EPoolOverflow::DropNewest || GTlsIsWorkerThread)
+		{
+			AtomicIncrementRelaxed(&GDroppedEventCount);
+			return &GDropBuffer.Buffer;
+		}
 
-	NextBuffer->Cursor += Size;
-	return NextBuffer;
+		if (GPoolOverflow == EPoolOverflow::DropOldest)
+		{
+			AtomicStoreRelaxed(&GDropOldestRequest, true);
+		}
+
+		Private::PlatformYield();
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -260,10 +394,9 @@ static void Writer_InitializeBuffers()
 	GPoolBase = MemoryReserve(GPoolSize);
 	AtomicStoreRelaxed(&GPoolPageCursor, GPoolBase);
 
-	Writer_NextBufferInternal(GPoolInitPageSize);
+	Writer_NextBufferInternal(GPoolPageGrowth);
 
-	static_assert(GPoolPageGrowth >= 0x10000, "Page growth must be >= 64KB");
-	static_assert(GPoolInitPageSize >= 0x10000, "Initial page size must be >= 64KB");
+	static_assert((GPoolMinBlockSize << 5) >= 0x10000, "Page growth must be >= 64KB");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -293,13 +426,29 @@ class FHoldBufferImpl
 {
 public:
 	void				Init();
+	void				InitRing(uint32 Size, uint32 MaxAgeMs);
 	void				Shutdown();
 	void				Write(const void* Data, uint32 Size);
+	bool				WriteTo(UPTRINT Handle) const;
 	bool				IsFull() const	{ return bFull; }
+	bool				IsRing() const	{ return RingSize != 0; }
 	const uint8*		GetData() const { return Base; }
 	uint32				GetSize() const { return Used; }
 
 private:
+	// In ring mode the buffer is a sequence of packets framed by these records,
+	// the oldest ones being overwritten by new ones.
+	struct FRingRecord
+	{
+		uint32			PacketSize;		// RingPadding if the rest of the ring is unused
+		uint32			TimeMs;
+	};
+	static const uint32	RingPadding = ~0u;
+
+	void				RingWrite(const void* Data, uint32 Size);
+	void				RingEvict();
+	FRingRecord*		RingRecordAt(uint64 Position) const { return (FRingRecord*)(Base + (Position % RingSize)); }
+
 	static const uint32	PageShift = 16;
 	static const uint32	PageSize = 1 << PageShift;
 	static const uint32	MaxPages = (4 * 1024 * 1024) >> PageShift;
@@ -307,6 +456,10 @@ private:
 	int32				Used;
 	uint16				MappedPageCount;
 	bool				bFull;
+	uint32				RingSize;		// = 0 unless in ring mode
+	uint32				RingMaxAgeMs;	// = 0 to only bound the ring by size
+	uint64				RingHead;		// position of the oldest record
+	uint64				RingTail;		// position the next record is written at
 };
 
 typedef TSafeStatic<FHoldBufferImpl> FHoldBuffer;
@@ -318,6 +471,23 @@ void FHoldBufferImpl::Init()
 	Used = 0;
 	MappedPageCount = 0;
 	bFull = false;
+	RingSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FHoldBufferImpl::InitRing(uint32 Size, uint32 MaxAgeMs)
+{
+	// The whole ring is mapped up front, it is a fixed cost paid for the trace
+	// to be available at any time.
+	RingSize = (Size + FHoldBufferImpl::PageSize - 1) & ~(FHoldBufferImpl::PageSize - 1);
+	RingMaxAgeMs = MaxAgeMs;
+	RingHead = 0;
+	RingTail = 0;
+	Base = MemoryReserve(RingSize);
+	MemoryMap(Base, RingSize);
+	Used = 0;
+	MappedPageCount = 0;
+	bFull = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -328,15 +498,22 @@ void FHoldBufferImpl::Shutdown()
 		return;
 	}
 
-	MemoryFree(Base, FHoldBufferImpl::PageSize * FHoldBufferImpl::MaxPages);
+	MemoryFree(Base, IsRing() ? RingSize : FHoldBufferImpl::PageSize * FHoldBufferImpl::MaxPages);
 	Base = nullptr;
 	MappedPageCount = 0;
 	Used = 0;
+	RingSize = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void FHoldBufferImpl::Write(const void* Data, uint32 Size)
 {
+	if (IsRing())
+	{
+		RingWrite(Data, Size);
+		return;
+	}
+
 	int32 NextUsed = Used + Size;
 
 	uint16 HotPageCount = uint16((NextUsed + (FHoldBufferImpl::PageSize - 1)) >> FHoldBufferImpl::PageShift);
@@ -360,6 +537,98 @@ void FHoldBufferImpl::Write(const void* Data, uint32 Size)
 	Used = NextUsed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FHoldBufferImpl::RingEvict()
+{
+	const FRingRecord* Record = RingRecordAt(RingHead);
+	if (Record->PacketSize == RingPadding)
+	{
+		RingHead += RingSize - (RingHead % RingSize);
+	}
+	else
+	{
+		RingHead += (sizeof(FRingRecord) + Record->PacketSize + 7) & ~7u;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FHoldBufferImpl::RingWrite(const void* Data, uint32 Size)
+{
+	uint32 RecordSize = (sizeof(FRingRecord) + Size + 7) & ~7u;
+	if (RecordSize > RingSize)
+	{
+		return;
+	}
+
+	// Data that's gotten too old goes first
+	uint32 NowMs = Writer_GetTimeMs();
+	while (RingMaxAgeMs != 0 && RingHead != RingTail)
+	{
+		const FRingRecord* Record = RingRecordAt(RingHead);
+		if (Record->PacketSize != RingPadding && uint32(NowMs - Record->TimeMs) <= RingMaxAgeMs)
+		{
+			break;
+		}
+		RingEvict();
+	}
+
+	// Then as much of the oldest data as needed to make room. Records don't
+	// straddle the end of the ring, the space left there is padded out instead.
+	uint32 PadSize;
+	while (true)
+	{
+		if (RingHead == RingTail)
+		{
+			RingHead = RingTail = 0;
+		}
+
+		uint32 Offset = uint32(RingTail % RingSize);
+		PadSize = (Offset + RecordSize > RingSize) ? (RingSize - Offset) : 0;
+		if (RingTail + PadSize + RecordSize - RingHead <= RingSize)
+		{
+			break;
+		}
+
+		RingEvict();
+	}
+
+	if (PadSize)
+	{
+		RingRecordAt(RingTail)->PacketSize = RingPadding;
+		RingTail += PadSize;
+	}
+
+	FRingRecord* Record = RingRecordAt(RingTail);
+	Record->PacketSize = Size;
+	Record->TimeMs = NowMs;
+	memcpy(Record + 1, Data, Size);
+	RingTail += RecordSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FHoldBufferImpl::WriteTo(UPTRINT Handle) const
+{
+	if (!IsRing())
+	{
+		return (Used == 0) || Writer_IoWrite(Handle, Base, Used);
+	}
+
+	bool bOk = true;
+	for (uint64 Position = RingHead; Position != RingTail && bOk;)
+	{
+		const FRingRecord* Record = RingRecordAt(Position);
+		if (Record->PacketSize == RingPadding)
+		{
+			Position += RingSize - (Position % RingSize);
+			continue;
+		}
+
+		bOk = Writer_IoWrite(Handle, Record + 1, Record->PacketSize);
+		Position += (sizeof(FRingRecord) + Record->PacketSize + 7) & ~7u;
+	}
+	return bOk;
+}
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -370,47 +639,89 @@ enum class EDataState : uint8
 	Sending,			// Events are being sent to an IO handle
 };
 static FHoldBuffer				GHoldBuffer;		// will init to zero.
+static FHoldBuffer				GImportantBuffer;	// events needed to read the ring, see Writer_CacheImportantEvent()
+static uint32 volatile			GHoldBufferLock;	// = 0
+static uint32 volatile			GImportantLock;		// = 0
 static UPTRINT					GDataHandle;		// = 0
 static EDataState				GDataState;			// = EDataState::Passive
 UPTRINT							GPendingDataHandle;	// = 0
 static FWriteBuffer* __restrict GActiveThreadList;	// = nullptr;
 
 ////////////////////////////////////////////////////////////////////////////////
-static uint32 Writer_SendData(uint32 ThreadId, uint8* __restrict Data, uint32 Size)
+struct FPacketBase
+{
+	uint16 PacketSize;
+	uint16 ThreadId;
+};
+
+struct FPacketEncoded
+	: public FPacketBase
 {
-	auto SendInner = [] (uint8* __restrict SendData, uint32 SendSize)
+	uint16	DecodedSize;
+};
+
+struct FPacket
+	: public FPacketEncoded
+{
+	uint8 Data[GPoolMaxBlockSize + (GPoolMaxBlockSize / 128) + 64];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+static bool Writer_Lock(uint32 volatile& Lock, uint32 MaxWaitMs=~0u)
+{
+	for (uint32 WaitMs = 0; !AtomicCompareExchangeAcquire(&Lock, 1u, 0u); ++WaitMs)
 	{
-		if (GDataState == EDataState::Sending)
+		if (WaitMs >= MaxWaitMs)
 		{
-			// Transmit data to the io handle
-			if (GDataHandle)
-			{
-				if (!IoWrite(GDataHandle, SendData, SendSize))
-				{
-					IoClose(GDataHandle);
-					GDataHandle = 0;
-				}
-			}
+			return false;
 		}
-		else
-		{
-			GHoldBuffer->Write(SendData, SendSize);
+		ThreadSleep(WaitMs ? 1 : 0);
+	}
+	return true;
+}
 
-			// Did we overflow? Enter partial mode.
-			bool bOverflown = GHoldBuffer->IsFull();
-			if (bOverflown && GDataState != EDataState::Partial)
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_Unlock(uint32 volatile& Lock)
+{
+	AtomicStoreRelease(&Lock, 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_SendPacket(uint8* __restrict SendData, uint32 SendSize)
+{
+	if (GDataState == EDataState::Sending)
+	{
+		// Transmit data to the io handle
+		if (GDataHandle)
+		{
+			if (!Writer_IoWrite(GDataHandle, SendData, SendSize))
 			{
-				GDataState = EDataState::Partial;
+				Writer_IoClose(GDataHandle);
+				GDataHandle = 0;
 			}
 		}
-	};
-
-	struct FPacketBase
+	}
+	else
 	{
-		uint16 PacketSize;
-		uint16 ThreadId;
-	};
+		// The hold buffer can be written to a snapshot from other threads
+		Writer_Lock(GHoldBufferLock);
+		GHoldBuffer->Write(SendData, SendSize);
+		Writer_Unlock(GHoldBufferLock);
+
+		// Did we overflow? Enter partial mode.
+		bool bOverflown = GHoldBuffer->IsFull();
+		if (bOverflown && GDataState != EDataState::Partial)
+		{
+			GDataState = EDataState::Partial;
+		}
+	}
+}
 
+////////////////////////////////////////////////////////////////////////////////
+// Frames a thread's events into a packet, compressing them into Packet if it is
+// worth it. Returns the start of the packet to send, OutSize being its size.
+static uint8* Writer_PackData(uint32 ThreadId, uint8* __restrict Data, uint32 Size, FPacket& Packet, uint32& OutSize)
+{
 	// Smaller buffers usually aren't redundant enough to benefit from being
 	// compressed. They often end up being larger.
 	if (Size <= 384)
@@ -418,57 +729,293 @@ static uint32 Writer_SendData(uint32 ThreadId, uint8* __restrict Data, uint32 Si
 		static_assert(sizeof(FPacketBase) == sizeof(uint32), "");
 		Data -= sizeof(FPacketBase);
 		Size += sizeof(FPacketBase);
-		auto* Packet = (FPacketBase*)Data;
-		Packet->ThreadId = uint16(ThreadId & 0x7fff);
-		Packet->PacketSize = uint16(Size);
+		auto* PacketBase = (FPacketBase*)Data;
+		PacketBase->ThreadId = uint16(ThreadId & 0x7fff);
+		PacketBase->PacketSize = uint16(Size);
 
-		SendInner(Data, Size);
-		return Size;
+		OutSize = Size;
+		return Data;
 	}
 
-	struct FPacketEncoded
-		: public FPacketBase
-	{
-		uint16	DecodedSize;
-	};
-
-	struct FPacket
-		: public FPacketEncoded
-	{
-		uint8 Data[GPoolBlockSize + 64];
-	};
-
-	FPacket Packet;
 	Packet.ThreadId = 0x8000 | uint16(ThreadId & 0x7fff);
 	Packet.DecodedSize = uint16(Size);
 	Packet.PacketSize = Encode(Data, Packet.DecodedSize, Packet.Data, sizeof(Packet.Data));
 	Packet.PacketSize += sizeof(FPacketEncoded);
 
-	SendInner((uint8*)&Packet, Packet.PacketSize);
-	return Packet.PacketSize;
+	OutSize = Packet.PacketSize;
+	return (uint8*)&Packet;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// When compression threads are enabled the worker thread doesn't pack the data
+// it reaps straight away. It queues it as jobs that it and the compression
+// threads claim, then sends the packets in the order the data was reaped in so
+// each thread's events still arrive in sequence.
+struct FCompressJob
+{
+	static const uint32			Idle	= 0;
+	static const uint32			Pending	= 1;
+	static const uint32			Claimed	= 2;
+	static const uint32			Done	= 3;
+
+	uint32 volatile				State;
+	uint32						ThreadId;
+	uint8* __restrict			Data;
+	uint32						Size;
+	uint32						PacketSize;
+	uint8*						PacketData;
+	FPacket						Packet;
+};
+
+static const uint32				GCompressJobCapacity	= 64;
+static UPTRINT					GCompressThreads[GCompressMaxThreads];
+static FCompressJob*			GCompressJobs;			// = nullptr
+static uint32 volatile			GCompressJobCount;		// = 0
+static uint32					GCompressJobsQueued;	// = 0, only used by the worker thread
+
+////////////////////////////////////////////////////////////////////////////////
+static bool Writer_TryRunCompressJob(FCompressJob& Job)
+{
+	if (!AtomicCompareExchangeAcquire(&Job.State, FCompressJob::Claimed, FCompressJob::Pending))
+	{
+		return false;
+	}
+
+	Job.PacketData = Writer_PackData(Job.ThreadId, Job.Data, Job.Size, Job.Packet, Job.PacketSize);
+	AtomicStoreRelease(&Job.State, FCompressJob::Done);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static volatile bool GWorkerThreadQuit = false;
+
+static void Writer_CompressThread()
+{
+	while (!GWorkerThreadQuit)
+	{
+		bool bRanJob = false;
+		for (uint32 i = 0, n = AtomicLoadAcquire(&GCompressJobCount); i < n; ++i)
+		{
+			bRanJob |= Writer_TryRunCompressJob(GCompressJobs[i]);
+		}
+
+		if (!bRanJob)
+		{
+			ThreadSleep(1);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+struct FWorkerStats
+{
+	uint64	ReapCycles		= 0;
+	uint64	CompressCycles	= 0;
+	uint64	SendCycles		= 0;
+	uint32	BytesReaped		= 0;
+	uint32	BytesSent		= 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_FlushCompressJobs(FWorkerStats& Stats)
+{
+	uint32 JobCount = GCompressJobsQueued;
+	if (JobCount == 0)
+	{
+		return;
+	}
+
+	// Let the compression threads at the jobs and help out
+	uint64 StartTsc = TimeGetTimestamp();
+	AtomicStoreRelease(&GCompressJobCount, JobCount);
+	for (uint32 i = 0; i < JobCount; ++i)
+	{
+		Writer_TryRunCompressJob(GCompressJobs[i]);
+	}
+
+	// Send the packets in order as they get done
+	uint64 SendCycles = 0;
+	for (uint32 i = 0; i < JobCount; ++i)
+	{
+		FCompressJob& Job = GCompressJobs[i];
+		while (AtomicLoadAcquire(&Job.State) != FCompressJob::Done)
+		{
+			Private::PlatformYield();
+		}
+
+		uint64 SendTsc = TimeGetTimestamp();
+		Writer_SendPacket(Job.PacketData, Job.PacketSize);
+		SendCycles += TimeGetTimestamp() - SendTsc;
+
+		Stats.BytesSent += Job.PacketSize;
+		AtomicStoreRelaxed(&Job.State, FCompressJob::Idle);
+	}
+
+	AtomicStoreRelease(&GCompressJobCount, uint32(0));
+	GCompressJobsQueued = 0;
+
+	Stats.SendCycles += SendCycles;
+	Stats.CompressCycles += TimeGetTimestamp() - StartTsc - SendCycles;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_QueueData(uint32 ThreadId, uint8* __restrict Data, uint32 Size, FWorkerStats& Stats)
+{
+	Stats.BytesReaped += Size;
+
+	if (GCompressJobs == nullptr)
+	{
+		FPacket Packet;
+		uint32 PacketSize;
+		uint64 StartTsc = TimeGetTimestamp();
+		uint8* PacketData = Writer_PackData(ThreadId, Data, Size, Packet, PacketSize);
+		uint64 SendTsc = TimeGetTimestamp();
+		Writer_SendPacket(PacketData, PacketSize);
+		Stats.CompressCycles += SendTsc - StartTsc;
+		Stats.SendCycles += TimeGetTimestamp() - SendTsc;
+		Stats.BytesSent += PacketSize;
+		return;
+	}
+
+	if (GCompressJobsQueued == GCompressJobCapacity)
+	{
+		Writer_FlushCompressJobs(Stats);
+	}
+
+	FCompressJob& Job = GCompressJobs[GCompressJobsQueued++];
+	Job.ThreadId = ThreadId;
+	Job.Data = Data;
+	Job.Size = Size;
+	AtomicStoreRelease(&Job.State, FCompressJob::Pending);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_LogWorkerStats(const FWorkerStats& Stats)
+{
+	UE_TRACE_EVENT_BEGIN($Trace, WorkerThread)
+		UE_TRACE_EVENT_FIELD(uint64, ReapCycles)
+		UE_TRACE_EVENT_FIELD(uint64, CompressCycles)
+		UE_TRACE_EVENT_FIELD(uint64, SendCycles)
+		UE_TRACE_EVENT_FIELD(uint32, BytesReaped)
+		UE_TRACE_EVENT_FIELD(uint32, BytesSent)
+	UE_TRACE_EVENT_END()
+
+	UE_TRACE_LOG($Trace, WorkerThread, TraceLogChannel)
+		<< WorkerThread.ReapCycles(Stats.ReapCycles)
+		<< WorkerThread.CompressCycles(Stats.CompressCycles)
+		<< WorkerThread.SendCycles(Stats.SendCycles)
+		<< WorkerThread.BytesReaped(Stats.BytesReaped)
+		<< WorkerThread.BytesSent(Stats.BytesSent);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_InitializeCompression()
+{
+	if (GCompressThreadCount == 0)
+	{
+		return;
+	}
+
+	SIZE_T JobsSize = sizeof(FCompressJob) * GCompressJobCapacity;
+	GCompressJobs = (FCompressJob*)MemoryReserve(JobsSize);
+	MemoryMap(GCompressJobs, JobsSize);
+	for (uint32 i = 0; i < GCompressJobCapacity; ++i)
+	{
+		GCompressJobs[i].State = FCompressJob::Idle;
+	}
+
+	for (uint32 i = 0; i < GCompressThreadCount; ++i)
+	{
+		GCompressThreads[i] = ThreadCreate("TraceCompress", Writer_CompressThread);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_ShutdownCompression()
+{
+	if (GCompressJobs == nullptr)
+	{
+		return;
+	}
+
+	// GWorkerThreadQuit is set and the worker has sent everything by now
+	for (uint32 i = 0; i < GCompressThreadCount; ++i)
+	{
+		ThreadJoin(GCompressThreads[i]);
+		ThreadDestroy(GCompressThreads[i]);
+	}
+
+	MemoryFree(GCompressJobs, sizeof(FCompressJob) * GCompressJobCapacity);
+	GCompressJobs = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static uint64 GDroppedByteCount; // = 0, only used by the worker thread
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_LogDroppedEvents()
+{
+	UE_TRACE_EVENT_BEGIN($Trace, PoolOverflow, Important)
+		UE_TRACE_EVENT_FIELD(uint32, DroppedEventCount)
+		UE_TRACE_EVENT_FIELD(uint64, DroppedByteCount)
+	UE_TRACE_EVENT_END()
+
+	// Counts are totals since the trace started so a report that is itself
+	// dropped is caught up by the next one.
+	static uint32 LastDroppedEventCount;
+	static uint64 LastDroppedByteCount;
+
+	uint32 DroppedEventCount = AtomicLoadRelaxed(&GDroppedEventCount);
+	if (DroppedEventCount == LastDroppedEventCount && GDroppedByteCount == LastDroppedByteCount)
+	{
+		return;
+	}
+
+	UE_TRACE_LOG($Trace, PoolOverflow, TraceLogChannel)
+		<< PoolOverflow.DroppedEventCount(DroppedEventCount)
+		<< PoolOverflow.DroppedByteCount(GDroppedByteCount);
+
+	LastDroppedEventCount = DroppedEventCount;
+	LastDroppedByteCount = GDroppedByteCount;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 static void Writer_ConsumeEvents()
 {
+	// Retired buffers are grouped in batches the size of a thread's reserve refill,
+	// see Writer_RefillReserve().
 	struct FRetireList
 	{
 		FWriteBuffer* __restrict Head = nullptr;
 		FWriteBuffer* __restrict Tail = nullptr;
+		uint32 HeadBatchSize = 0;
 
 		void Insert(FWriteBuffer* __restrict Buffer)
 		{
-			Buffer->NextBuffer = Head;
+			if (Head == nullptr || HeadBatchSize == GPoolBatchSize)
+			{
+				// Start a new batch
+				Buffer->NextBuffer = nullptr;
+				Buffer->NextThread = Head;
+				Tail = (Tail != nullptr) ? Tail : Buffer;
+				HeadBatchSize = 0;
+			}
+			else
+			{
+				Buffer->NextBuffer = Head;
+				Buffer->NextThread = Head->NextThread;
+				Tail = (Tail != Head) ? Tail : Buffer;
+			}
+
 			Head = Buffer;
-			Tail = (Tail != nullptr) ? Tail : Head;
+			++HeadBatchSize;
 		}
 	};
 
-#if TRACE_PRIVATE_PERF
 	uint64 StartTsc = TimeGetTimestamp();
-	uint32 BytesReaped = 0;
-	uint32 BytesSent = 0;
-#endif
+	FWorkerStats Stats;
 
 	// Claim ownership of any new thread buffer lists
 	FWriteBuffer* __restrict NewThreadList;
@@ -483,6 +1030,13 @@ static void Writer_ConsumeEvents()
 
 	FRetireList RetireList;
 
+	// Threads are waiting on an exhausted pool and asked for events that weren't sent yet to be dropped
+	bool bDropOldest = AtomicLoadRelaxed(&GDropOldestRequest);
+	if (bDropOldest)
+	{
+		AtomicStoreRelaxed(&GDropOldestRequest, false);
+	}
+
 	FWriteBuffer* __restrict ActiveThreadList = GActiveThreadList;
 	GActiveThreadList = nullptr;
 
@@ -504,11 +1058,14 @@ static void Writer_ConsumeEvents()
 				// Send as much as we can.
 				if (uint32 SizeToReap = uint32(Committed - Buffer->Reaped))
 				{
-#if TRACE_PRIVATE_PERF
-					BytesReaped += SizeToReap;
-					BytesSent += /*...*/
-#endif
-					Writer_SendData(ThreadId, Buffer->Reaped, SizeToReap);
+					if (bDropOldest)
+					{
+						GDroppedByteCount += SizeToReap;
+					}
+					else
+					{
+						Writer_QueueData(ThreadId, Buffer->Reaped, SizeToReap, Stats);
+					}
 					Buffer->Reaped = Committed;
 				}
 
@@ -532,12 +1089,16 @@ static void Writer_ConsumeEvents()
 		}
 	}
 
-#if TRACE_PRIVATE_PERF
-	UE_TRACE_LOG($Trace, WorkerThread, TraceLogChannel)
-		<< WorkerThread.Cycles(uint32(TimeGetTimestamp() - StartTsc))
-		<< WorkerThread.BytesReaped(BytesReaped);
-		<< WorkerThread.BytesSent(BytesSent);
+	// Everything reaped has to be sent before the buffers can be reused
+	Writer_FlushCompressJobs(Stats);
+
+	if (Stats.BytesReaped != 0)
+	{
+		Stats.ReapCycles = TimeGetTimestamp() - StartTsc - Stats.CompressCycles - Stats.SendCycles;
+		Writer_LogWorkerStats(Stats);
+	}
 
+#if TRACE_PRIVATE_PERF
 	UE_TRACE_LOG($Trace, Memory, TraceLogChannel)
 		<< Memory.AllocSize(uint32(GPoolPageCursor - GPoolBase));
 #endif // TRACE_PRIVATE_PERF
@@ -547,8 +1108,8 @@ static void Writer_ConsumeEvents()
 	{
 		for (FWriteBuffer* ListNode = RetireList.Tail;; Private::PlatformYield())
 		{
-			ListNode->NextBuffer = AtomicLoadRelaxed(&GPoolFreeList);
-			if (AtomicCompareExchangeRelease(&GPoolFreeList, RetireList.Head, ListNode->NextBuffer))
+			ListNode->NextThread = AtomicLoadRelaxed(&GPoolFreeList);
+			if (AtomicCompareExchangeRelease(&GPoolFreeList, RetireList.Head, ListNode->NextThread))
 			{
 				break;
 			}
@@ -556,6 +1117,112 @@ static void Writer_ConsumeEvents()
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////
+static bool Writer_WriteStreamHeader(UPTRINT Handle)
+{
+	// Handshake.
+	const uint32 Magic = 'TRCE';
+	bool bOk = Writer_IoWrite(Handle, &Magic, sizeof(Magic));
+
+	// Stream header
+	const struct {
+		uint8 TransportVersion	= ETransport::TidPacket;
+		uint8 ProtocolVersion	= EProtocol::Id;
+	} TransportHeader;
+	bOk &= Writer_IoWrite(Handle, &TransportHeader, sizeof(TransportHeader));
+
+	return bOk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static thread_local bool GTlsCapturingPrologue; // = false
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_CacheImportantEvent(const uint8* Data, uint32 Size)
+{
+	// Once the flight recorder ring has wrapped around, the events describing
+	// the trace and its event types are gone with the oldest data. A copy of
+	// them is kept to be written ahead of the ring.
+	if (GFlightRecorderSize == 0 || GTlsCapturingPrologue)
+	{
+		return;
+	}
+
+	Writer_Lock(GImportantLock);
+	GImportantBuffer->Write(Data, Size);
+	Writer_Unlock(GImportantLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool Writer_WriteImportantEvents(UPTRINT Handle)
+{
+	// Events are sent as uncompressed packets from a thread of their own
+	const uint8* Data = GImportantBuffer->GetData();
+	uint32 Size = GImportantBuffer->GetSize();
+
+	bool bOk = true;
+	while (Size && bOk)
+	{
+		uint32 PacketDataSize = (Size < GPoolMaxBlockSize) ? Size : GPoolMaxBlockSize;
+		FPacketBase Packet;
+		Packet.ThreadId = 0;
+		Packet.PacketSize = uint16(sizeof(Packet) + PacketDataSize);
+
+		bOk &= Writer_IoWrite(Handle, &Packet, sizeof(Packet));
+		bOk &= Writer_IoWrite(Handle, Data, PacketDataSize);
+		Data += PacketDataSize;
+		Size -= PacketDataSize;
+	}
+	return bOk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes the data collected while no trace was being sent. Must be called with
+// the hold buffer locked.
+static bool Writer_WriteHeldData(UPTRINT Handle)
+{
+	bool bOk = Writer_WriteStreamHeader(Handle);
+
+	if (GHoldBuffer->IsRing())
+	{
+		Writer_Lock(GImportantLock);
+		bOk &= Writer_WriteImportantEvents(Handle);
+		Writer_Unlock(GImportantLock);
+	}
+
+	bOk &= GHoldBuffer->WriteTo(Handle);
+	return bOk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Writer_WriteSnapshotTo(const ANSICHAR* Path)
+{
+	if (!GInitialized)
+	{
+		return false;
+	}
+
+	// This may be called while crashing with the worker thread stopped in the
+	// middle of writing to the ring so don't wait for it forever.
+	bool bLocked = Writer_Lock(GHoldBufferLock, 1000);
+
+	bool bOk = false;
+	if (GDataState != EDataState::Sending)
+	{
+		if (UPTRINT Handle = FileOpen(Path))
+		{
+			bOk = Writer_WriteHeldData(Handle);
+			Writer_IoClose(Handle);
+		}
+	}
+
+	if (bLocked)
+	{
+		Writer_Unlock(GHoldBufferLock);
+	}
+	return bOk;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 static void Writer_UpdateData()
 {
@@ -564,7 +1231,7 @@ static void Writer_UpdateData()
 		// Reject the pending connection if we've already got a connection
 		if (GDataHandle)
 		{
-			IoClose(GPendingDataHandle);
+			Writer_IoClose(GPendingDataHandle);
 			GPendingDataHandle = 0;
 			return;
 		}
@@ -572,47 +1239,40 @@ static void Writer_UpdateData()
 		GDataHandle = GPendingDataHandle;
 		GPendingDataHandle = 0;
 
-		// Handshake.
-		const uint32 Magic = 'TRCE';
-		bool bOk = IoWrite(GDataHandle, &Magic, sizeof(Magic));
-
-		// Stream header
-		const struct {
-			uint8 TransportVersion	= ETransport::TidPacket;
-			uint8 ProtocolVersion	= EProtocol::Id;
-		} TransportHeader;
-		bOk &= IoWrite(GDataHandle, &TransportHeader, sizeof(TransportHeader));
-
-		// Passively collected data
-		if (GHoldBuffer->GetSize())
-		{
-			bOk &= IoWrite(GDataHandle, GHoldBuffer->GetData(), GHoldBuffer->GetSize());
-		}
-
+		Writer_Lock(GHoldBufferLock);
+		bool bOk = Writer_WriteHeldData(GDataHandle);
 		if (bOk)
 		{
 			GDataState = EDataState::Sending;
 			GHoldBuffer->Shutdown();
 		}
-		else
+		Writer_Unlock(GHoldBufferLock);
+
+		if (!bOk)
 		{
-			IoClose(GDataHandle);
+			Writer_IoClose(GDataHandle);
 			GDataHandle = 0;
 		}
 	}
 
 	Writer_ConsumeEvents();
+
+	if (GDataHandle && SharedRingIsHandle(GDataHandle))
+	{
+		SharedRingFlush(GDataHandle);
+	}
 }
 
 
 
 ////////////////////////////////////////////////////////////////////////////////
 static UPTRINT			GWorkerThread		= 0;
-static volatile bool	GWorkerThreadQuit	= false;
 
 ////////////////////////////////////////////////////////////////////////////////
 static void Writer_WorkerThread()
 {
+	GTlsIsWorkerThread = true;
+
 	while (!GWorkerThreadQuit)
 	{
 		const uint32 SleepMs = 24;
@@ -620,6 +1280,7 @@ static void Writer_WorkerThread()
 
 		Writer_UpdateControl();
 		Writer_UpdateData();
+		Writer_LogDroppedEvents();
 	}
 
 	Writer_ConsumeEvents();
@@ -652,14 +1313,35 @@ static void Writer_InternalInitialize()
 	GInitialized = true;
 
 	Writer_InitializeBuffers();
+
+	// The first events describe the trace, they're kept for the flight recorder
+	GTlsCapturingPrologue = true;
+	FWriteBuffer* PrologueBuffer = GTlsWriteBuffer;
+	uint8* PrologueStart = PrologueBuffer->Cursor;
+
 	Writer_LogHeader();
 
-	GHoldBuffer->Init();
+	if (GFlightRecorderSize != 0)
+	{
+		GHoldBuffer->InitRing(GFlightRecorderSize, GFlightRecorderSeconds * 1000);
+		GImportantBuffer->Init();
+	}
+	else
+	{
+		GHoldBuffer->Init();
+	}
 
+	Writer_InitializeCompression();
 	GWorkerThread = ThreadCreate("TraceWorker", Writer_WorkerThread);
 
 	Writer_InitializeControl();
 	Writer_InitializeTiming();
+
+	if (GFlightRecorderSize != 0 && GTlsWriteBuffer == PrologueBuffer)
+	{
+		GImportantBuffer->Write(PrologueStart, uint32(PrologueBuffer->Cursor - PrologueStart));
+	}
+	GTlsCapturingPrologue = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -673,10 +1355,19 @@ static void Writer_Shutdown()
 	GWorkerThreadQuit = true;
 	ThreadJoin(GWorkerThread);
 	ThreadDestroy(GWorkerThread);
+	Writer_ShutdownCompression();
 
 	Writer_ShutdownControl();
 
+	// Shared memory outlives the process on some platforms, unlike sockets and files
+	if (GDataHandle && SharedRingIsHandle(GDataHandle))
+	{
+		Writer_IoClose(GDataHandle);
+		GDataHandle = 0;
+	}
+
 	GHoldBuffer->Shutdown();
+	GImportantBuffer->Shutdown();
 	Writer_ShutdownBuffers();
 
 	GInitialized = false;
@@ -747,6 +1438,28 @@ bool Writer_WriteTo(const ANSICHAR* Path)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+bool Writer_ShareTo(const ANSICHAR* Name, uint32 RingSize)
+{
+	if (GPendingDataHandle || GDataHandle)
+	{
+		return false;
+	}
+
+	Writer_Initialize();
+
+	UPTRINT DataHandle = SharedRingOpen(Name, RingSize);
+	if (!DataHandle)
+	{
+		return false;
+	}
+
+	GPendingDataHandle = DataHandle;
+	return true;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 static uint32 volatile GEventUidCounter; // = 0;
 
@@ -841,6 +1554,8 @@ void Writer_EventCreate(
 	}
 
 	Writer_EndLog(LogInstance);
+
+	Writer_CacheImportantEvent(LogInstance.Ptr - sizeof(FEventHeaderSync), sizeof(FEventHeaderSync) + EventSize);
 }
 
 } // namespace Private
@@ -15,3 +15,20 @@
 #if !defined(UE_TRACE_ENABLED)
 #	define UE_TRACE_ENABLED 0
 #endif
+
+/*
+	Channels can be compiled out by listing them in UE_TRACE_CHANNELS_COMPILED_OUT
+	separated by '|', for example from build rules;
+
+	```
+	PublicDefinitions.Add("UE_TRACE_CHANNELS_COMPILED_OUT=FooChannel|BarChannel");
+	```
+
+	Checking a compiled out channel is a constant so events logged on it and CPU
+	profiler scopes using it are removed by the compiler. A channel declared in a
+	header for other modules to use has to be compiled out for all of them, which
+	is done with the target's global definitions.
+*/
+#if !defined(UE_TRACE_CHANNELS_COMPILED_OUT)
+#	define UE_TRACE_CHANNELS_COMPILED_OUT
+#endif
@@ -9,6 +9,8 @@
 namespace Trace
 {
 
+struct FDisabledChannel;
+
 /*
 	A named channel which can be used to filter trace events. Channels can be 
 	combined using the '|' operator which allows expressions like
@@ -32,12 +34,64 @@ struct FChannel
 	bool IsEnabled() const;
 	explicit operator bool() const;
 	bool operator|(const FChannel& Rhs) const;
+	constexpr bool operator|(const FDisabledChannel& Rhs) const { return false; }
 
 	void*			Handle;
 	uint32			ChannelNameHash;
 	bool			bDisabled;
 };
 
+/*
+	The type of channels listed in UE_TRACE_CHANNELS_COMPILED_OUT. They are never
+	enabled, aren't registered and can't be toggled.
+*/
+struct FDisabledChannel
+{
+	static void Register(FDisabledChannel& Channel, const ANSICHAR* ChannelName) {}
+	constexpr bool IsEnabled() const { return false; }
+	constexpr explicit operator bool() const { return false; }
+	constexpr bool operator|(const FChannel& Rhs) const { return false; }
+	constexpr bool operator|(const FDisabledChannel& Rhs) const { return false; }
+};
+
+namespace Private
+{
+
+////////////////////////////////////////////////////////////////////////////////
+constexpr bool IsChannelCompiledOut(
+	const ANSICHAR* ChannelName,
+	const ANSICHAR* List=PREPROCESSOR_TO_STRING(UE_TRACE_CHANNELS_COMPILED_OUT))
+{
+	while (*List)
+	{
+		while (*List == '|' || *List == ' ')
+		{
+			++List;
+		}
+
+		const ANSICHAR* Name = ChannelName;
+		for (; *Name && *Name == *List; ++Name, ++List);
+
+		if (*Name == '\0' && (*List == '\0' || *List == '|' || *List == ' '))
+		{
+			return true;
+		}
+
+		for (; *List && *List != '|'; ++List);
+	}
+
+	return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+template <bool bCompiledOut> struct TChannelType			{ typedef FChannel Type; };
+template <> struct TChannelType<true>						{ typedef FDisabledChannel Type; };
+
+} // namespace Private
+
+}
+
+#define TRACE_PRIVATE_CHANNEL_TYPE(ChannelName) \
+	Trace::Private::TChannelType<Trace::Private::IsChannelCompiledOut(#ChannelName)>::Type
+
 #endif //UE_TRACE_ENABLED
\ No newline at end of file
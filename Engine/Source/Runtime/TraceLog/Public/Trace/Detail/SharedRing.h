@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+namespace Trace
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Layout of the shared memory a trace is written to by ShareTo(), for analysis
+// processes running on the same machine. The mapping is named after the name
+// given to ShareTo() ("/<Name>" for shm_open(), "Local\<Name>" on Windows) and
+// starts with this header, the ring follows at HeaderSize. The ring carries the
+// same bytes a socket would, the 'TRCE' magic, the transport header and then
+// the packets.
+//
+// Positions only grow, the byte at a position is at Position % RingSize in the
+// ring. The reader consumes [ReadPos, WritePos) in place and then stores the
+// new ReadPos, the writer waits for space when the ring is full. A second named
+// object "<Name>.Event" (a semaphore on POSIX platforms, an auto reset event on
+// Windows) is signalled once per batch of writes, when the writer runs out of
+// space and when it closes the ring.
+struct FSharedRingHeader
+{
+	enum : uint32
+	{
+		MagicValue		= 'TRSR',
+		VersionValue	= 1,
+	};
+
+	uint32					Magic;			// MagicValue once the header is initialized
+	uint32					Version;
+	uint32					HeaderSize;		// offset of the ring from the start of the mapping
+	uint32					RingSize;		// a power of two
+	alignas(64) uint64 volatile	WritePos;	// stored by the writer with release semantics after the data
+	alignas(64) uint64 volatile	ReadPos;	// stored by the reader with release semantics once it is done with the data
+	alignas(64) uint32 volatile	bClosed;	// set by the writer once WritePos won't move anymore
+};
+
+} // namespace Trace
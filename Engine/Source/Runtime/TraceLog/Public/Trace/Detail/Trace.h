@@ -9,14 +9,14 @@
 #include "CoreTypes.h"
 
 #define TRACE_PRIVATE_CHANNEL_DECLARE(LinkageType, ChannelName) \
-	LinkageType Trace::FChannel ChannelName;
+	LinkageType TRACE_PRIVATE_CHANNEL_TYPE(ChannelName) ChannelName;
 
 #define TRACE_PRIVATE_CHANNEL_IMPL(ChannelName) \
 	struct F##ChannelName##Registrator \
 	{ \
 		F##ChannelName##Registrator() \
 		{ \
-			Trace::FChannel::Register(ChannelName, PREPROCESSOR_TO_STRING(ChannelName)); \
+			decltype(ChannelName)::Register(ChannelName, PREPROCESSOR_TO_STRING(ChannelName)); \
 		} \
 	}; \
 	static F##ChannelName##Registrator ChannelName##Reg = F##ChannelName##Registrator();
@@ -35,7 +35,7 @@ TRACELOG_API FWriteBuffer*			Writer_GetBuffer();
 
 ////////////////////////////////////////////////////////////////////////////////
 #if IS_MONOLITHIC
-extern thread_local FWriteBuffer* GTlsWriteBuffer;
+extern thread_local FWriteBuffer* GTlsWriteBuffer TLS_INITIAL_EXEC;
 inline FWriteBuffer* Writer_GetBuffer()
 {
 	return GTlsWriteBuffer;
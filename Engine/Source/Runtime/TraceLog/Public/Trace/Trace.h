@@ -18,11 +18,33 @@
 namespace Trace
 {
 
+/** What threads do when all the memory the trace buffer pool may use is taken by events not sent yet */
+enum class EPoolOverflow : uint8
+{
+	Block,			// wait until the worker thread has sent events and returned their buffers to the pool
+	DropNewest,		// discard the event being written
+	DropOldest,		// make the worker thread discard the events waiting to be sent, then wait for their buffers
+};
+
+struct FInitializeDesc
+{
+	uint32			PoolSizeLimit	= 384 << 20;	// most memory the buffers events are written to may use
+	uint32			BlockSize		= 4 << 10;		// size of these buffers, a power of two between 4KB and 16KB
+	EPoolOverflow	Overflow		= EPoolOverflow::Block;
+	uint32			CompressionThreadCount = 0;		// threads helping the worker thread compress events, up to 8
+	uint32			FlightRecorderSize = 0;			// if set, the last events are kept in a ring this big while no trace is sent, see WriteSnapshotTo()
+	uint32			FlightRecorderSeconds = 0;		// if set, the ring only keeps the events of the last so many seconds
+};
+
 UE_TRACE_API bool	Initialize() UE_TRACE_IMPL(false);
+UE_TRACE_API bool	Initialize(const FInitializeDesc& Desc) UE_TRACE_IMPL(false); // false if events were already traced with another configuration
 UE_TRACE_API bool	SendTo(const TCHAR* Host, uint32 Port=1980) UE_TRACE_IMPL(false);
 UE_TRACE_API bool	WriteTo(const TCHAR* Path) UE_TRACE_IMPL(false);
+UE_TRACE_API bool	ShareTo(const TCHAR* Name, uint32 RingSize=0) UE_TRACE_IMPL(false); // a shared memory ring for a local analyzer, see Detail/SharedRing.h
+UE_TRACE_API bool	WriteSnapshotTo(const TCHAR* Path) UE_TRACE_IMPL(false); // writes the events held while no trace is sent
 UE_TRACE_API bool	ToggleChannel(const TCHAR* ChannelName, bool bEnabled) UE_TRACE_IMPL(false);
 UE_TRACE_API bool	ToggleChannel(struct FChannel& Channel, bool bEnabled) UE_TRACE_IMPL(false);
+inline bool			ToggleChannel(struct FDisabledChannel& Channel, bool bEnabled) { return false; }
 
 } // namespace Trace
 